@@ -0,0 +1,63 @@
+/**
+ * Tests that authentication works when the number of concurrent authentication steps is limited
+ * with maxConcurrentAuthenticationSteps, and that serverStatus reports the steps which waited.
+ *
+ * @tags: [requires_fcv_49]
+ */
+(function() {
+"use strict";
+
+const conn =
+    MongoRunner.runMongod({auth: "", setParameter: {maxConcurrentAuthenticationSteps: 5}});
+const admin = conn.getDB("admin");
+admin.createUser({user: "admin", pwd: "pwd", roles: ["root"]});
+assert(admin.auth("admin", "pwd"));
+const test = conn.getDB("test");
+test.createUser({user: "user", pwd: "pwd", roles: ["readWrite"]});
+
+function concurrentSteps() {
+    return assert.commandWorked(admin.serverStatus()).security.authentication.concurrentSteps;
+}
+
+let stats = concurrentSteps();
+assert.eq(5, stats.limit, tojson(stats));
+assert.eq(5, stats.out + stats.available, tojson(stats));
+
+// Only 0 or a limit of at least 5 are accepted.
+for (let limit of [-1, 1, 4]) {
+    assert.commandFailedWithCode(
+        admin.runCommand({setParameter: 1, maxConcurrentAuthenticationSteps: limit}),
+        ErrorCodes.BadValue);
+}
+
+// Many clients authenticate at the same time, and all of them succeed.
+const kNumClients = 20;
+const kAuthsPerClient = 20;
+const clients = [];
+for (let i = 0; i < kNumClients; i++) {
+    clients.push(startParallelShell(funWithArgs(function(numAuths) {
+        const test = db.getSiblingDB("test");
+        for (let j = 0; j < numAuths; j++) {
+            assert(test.auth({user: "user", pwd: "pwd", mechanism: "SCRAM-SHA-256"}));
+            assert.commandWorked(test.runCommand({find: "coll"}));
+            test.logout();
+        }
+    }, kAuthsPerClient), conn.port));
+}
+for (let client of clients) {
+    client();
+}
+
+// Every step returned its ticket.
+stats = concurrentSteps();
+assert.eq(0, stats.out, tojson(stats));
+assert.eq(5, stats.available, tojson(stats));
+assert.eq(0, stats.queues.interactive.currentlyQueued, tojson(stats));
+
+// Without a limit, the authentication steps do not take tickets.
+assert.commandWorked(admin.runCommand({setParameter: 1, maxConcurrentAuthenticationSteps: 0}));
+assert(test.auth("user", "pwd"));
+assert.eq(0, concurrentSteps().limit);
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,57 @@
+/**
+ * Tests that the keys of a batch of documents inserted at once are all indexed, including when the
+ * batch makes an index multikey or violates a unique index.
+ *
+ * @tags: [assumes_unsharded_collection]
+ */
+(function() {
+"use strict";
+
+const coll = db.bulk_insert_indexes;
+coll.drop();
+
+assert.commandWorked(coll.createIndexes([
+    {a: 1},
+    {b: -1},
+    {a: 1, b: 1},
+    {arr: 1},
+    {"sub.x": 1},
+    {u: 1},
+    {"$**": 1},
+    {p: 1},
+]));
+assert.commandWorked(coll.createIndex({u: 1, a: 1}, {unique: true}));
+assert.commandWorked(coll.createIndex({p: 1, b: 1}, {partialFilterExpression: {p: {$gt: 500}}}));
+
+const batchSize = 1000;
+let docs = [];
+for (let i = 0; i < batchSize; i++) {
+    // Insert the documents out of key order for every index.
+    const k = (i * 7919) % batchSize;
+    docs.push({_id: i, a: k, b: i % 10, arr: [k, -k], sub: {x: "s" + k}, u: i, p: i});
+}
+assert.commandWorked(coll.insert(docs));
+assert.eq(batchSize, coll.find().itcount());
+
+assert.eq(1, coll.find({a: 17}).hint({a: 1}).itcount());
+assert.eq(batchSize / 10, coll.find({b: 3}).hint({b: -1}).itcount());
+assert.eq(1, coll.find({arr: -17}).hint({arr: 1}).itcount());
+assert.eq(1, coll.find({"sub.x": "s17"}).hint({"sub.x": 1}).itcount());
+assert.eq(1, coll.find({arr: 17}).hint({"$**": 1}).itcount());
+assert.eq(batchSize - 501, coll.find({p: {$gt: 500}}).hint({p: 1, b: 1}).itcount());
+
+// A duplicate inside a batch is still reported against the right document.
+docs = [];
+for (let i = 0; i < 10; i++) {
+    docs.push({_id: batchSize + i, a: batchSize + i, u: batchSize + i});
+}
+docs.push({_id: 2 * batchSize, a: batchSize + 3, u: batchSize + 3});
+const res = coll.insert(docs, {ordered: false});
+assert.eq(1, res.getWriteErrors().length, tojson(res));
+assert.eq(ErrorCodes.DuplicateKey, res.getWriteErrors()[0].code, tojson(res));
+assert.eq(10, res.getWriteErrors()[0].index, tojson(res));
+assert.eq(batchSize + 10, coll.find().itcount());
+
+const validateRes = assert.commandWorked(coll.validate({full: true}));
+assert(validateRes.valid, tojson(validateRes));
+}());
@@ -363,4 +363,15 @@ for (const command of [updateCommand, findAndModifyCommand]) {
         assert.docEq(errorInfo, expectedError, tojson(res));
     }
 }
+
+// Updates which do not change the size of the document, and so are applied in place, are also
+// validated.
+coll.drop();
+assert.commandWorked(db.createCollection(collName, {validator: {a: {$lte: 5}}}));
+assert.commandWorked(coll.insert({_id: 0, a: NumberInt(4), b: NumberInt(0)}));
+assert.commandWorked(coll.update({_id: 0}, {$inc: {a: NumberInt(1), b: NumberInt(1)}}));
+assertDocumentValidationFailure(coll.update({_id: 0}, {$inc: {a: NumberInt(1)}}), coll);
+assertDocumentValidationFailure(findAndModifyCommand(coll, {_id: 0}, {$set: {a: NumberInt(6)}}),
+                                coll);
+assert.docEq({_id: 0, a: 5, b: 1}, coll.findOne());
 })();
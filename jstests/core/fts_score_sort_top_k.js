@@ -0,0 +1,51 @@
+/**
+ * Tests that a $text query which is only sorted by text score, with a limit, fetches just the best
+ * scored documents, and returns the same documents as the unlimited query.
+ *
+ * @tags: [
+ *   assumes_unsharded_collection,
+ *   assumes_read_concern_local,
+ *   # The TEXT_OR stage and its fetch count only exist in the classic engine.
+ *   sbe_incompatible,
+ * ]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");  // For getPlanStage.
+
+const coll = db.fts_score_sort_top_k;
+coll.drop();
+
+assert.commandWorked(coll.createIndex({content: "text"}, {default_language: "none"}));
+let docs = [];
+for (let i = 0; i < 100; i++) {
+    // Documents with more repetitions of "coffee" get higher scores.
+    docs.push({_id: i, content: "coffee ".repeat(1 + i % 17) + "cake ".repeat(i % 3)});
+}
+assert.commandWorked(coll.insert(docs));
+
+const kLimit = 5;
+const projection = {score: {$meta: "textScore"}};
+const sort = {score: {$meta: "textScore"}};
+
+function checkTopK(search, expectedFetches) {
+    const query = {$text: {$search: search}};
+    const expected = coll.find(query, projection).sort(sort).toArray().slice(0, kLimit);
+    const actual = coll.find(query, projection).sort(sort).limit(kLimit).toArray();
+    assert.eq(expected.map(doc => doc.score), actual.map(doc => doc.score), tojson(actual));
+
+    const explain =
+        coll.find(query, projection).sort(sort).limit(kLimit).explain("executionStats");
+    const textOr = getPlanStage(explain.executionStats.executionStages, "TEXT_OR");
+    assert.neq(null, textOr, tojson(explain));
+    assert.eq(expectedFetches, textOr.fetches, tojson(explain));
+}
+
+checkTopK("coffee cake", kLimit);
+
+// Negations and phrases are checked against the fetched documents, so every matching document is
+// still fetched.
+checkTopK("coffee -tea", 100);
+checkTopK("\"coffee coffee\" cake", 100);
+}());
@@ -0,0 +1,58 @@
+/**
+ * Tests that a limited near search over a 2dsphere index returns the same documents as the
+ * unlimited search, and stops searching once it has returned enough of them.
+ *
+ * @tags: [
+ *   assumes_unsharded_collection,
+ *   assumes_read_concern_local,
+ *   # The GEO_NEAR_2DSPHERE stage and its search intervals only exist in the classic engine.
+ *   sbe_incompatible,
+ * ]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");  // For getPlanStage.
+
+const coll = db.geo_s2near_limit;
+coll.drop();
+
+assert.commandWorked(coll.createIndex({geo: "2dsphere"}));
+let docs = [];
+// A dense cluster of points around the origin, each at a distinct distance from it.
+for (let i = 0; i < 2000; i++) {
+    const angle = i * 0.1;
+    const radius = 0.0001 + i * 0.00001;
+    docs.push({
+        _id: i,
+        geo: {type: "Point", coordinates: [radius * Math.cos(angle), radius * Math.sin(angle)]}
+    });
+}
+// A few lines, which can be found again by later search intervals.
+for (let i = 0; i < 20; i++) {
+    docs.push({
+        _id: "line" + i,
+        geo: {type: "LineString", coordinates: [[0.001 * i, 0.0005], [0.001 * i + 0.5, 0.5]]}
+    });
+}
+assert.commandWorked(coll.insert(docs));
+
+const query = {geo: {$near: {$geometry: {type: "Point", coordinates: [0, 0]}}}};
+
+function checkLimit(skip, limit) {
+    const expected = coll.find(query).toArray().slice(skip, skip + limit);
+    const actual = coll.find(query).skip(skip).limit(limit).toArray();
+    assert.eq(expected.map(doc => doc._id), actual.map(doc => doc._id), tojson(actual));
+
+    const explain = coll.find(query).skip(skip).limit(limit).explain("executionStats");
+    const nearStage = getPlanStage(explain.executionStats.executionStages, "GEO_NEAR_2DSPHERE");
+    assert.neq(null, nearStage, tojson(explain));
+    assert.eq(skip + limit, nearStage.nReturned, tojson(explain));
+}
+
+checkLimit(0, 1);
+checkLimit(0, 10);
+checkLimit(5, 10);
+checkLimit(0, 1500);
+checkLimit(1990, 25);
+}());
@@ -0,0 +1,68 @@
+/**
+ * Tests hashed indexes with the 'hashVersion' option, which selects the hash function of the index.
+ * Cannot implicitly shard accessed collections because of extra shard key index in sharded
+ * collection.
+ * @tags: [
+ *   assumes_no_implicit_index_creation,
+ *   sbe_incompatible,
+ *   requires_fcv_49,
+ * ]
+ */
+(function() {
+"use strict";
+load("jstests/libs/analyze_plan.js");  // For isIxscan().
+
+const t = db.hashed_index_hash_version;
+t.drop();
+
+assert.commandWorked(db.createCollection(t.getName()));
+
+// Only the known hash versions are accepted, and only for hashed indexes.
+assert.commandFailedWithCode(t.createIndex({a: "hashed"}, {hashVersion: 2}),
+                             ErrorCodes.CannotCreateIndex);
+assert.commandFailedWithCode(t.createIndex({a: "hashed"}, {hashVersion: "1"}),
+                             ErrorCodes.TypeMismatch);
+assert.commandFailedWithCode(t.createIndex({a: 1}, {hashVersion: 1}), ErrorCodes.BadValue);
+
+assert.commandWorked(t.createIndex({a: "hashed"}, {hashVersion: 1, name: "a_murmur"}));
+assert.commandWorked(t.createIndex({a: "hashed", b: 1}, {name: "a_md5"}));
+
+for (let i = 0; i < 10; i++) {
+    assert.commandWorked(t.insert({a: i, b: i}));
+}
+assert.commandWorked(t.insert([{a: 3.1}, {a: null}, {b: 11}, {a: "str"}, {a: {x: [1, 2]}}]));
+
+// Both hash versions find the same documents, whether they are looked up by value, by null or by
+// the absence of the field.
+const predicates = [
+    {a: 3},
+    {a: 3.1},
+    {a: null},
+    {a: {$exists: false}},
+    {a: "str"},
+    {a: {x: [1, 2]}},
+    {a: {$in: [1, 2, "str", null]}},
+];
+for (let predicate of predicates) {
+    const expected = t.find(predicate).hint({_id: 1}).sort({_id: 1}).toArray();
+    for (let hint of ["a_murmur", "a_md5"]) {
+        const explain = t.find(predicate).hint(hint).explain();
+        assert(isIxscan(db, getWinningPlan(explain.queryPlanner)), tojson(explain));
+        assert.eq(expected,
+                  t.find(predicate).hint(hint).sort({_id: 1}).toArray(),
+                  tojson({predicate: predicate, hint: hint}));
+    }
+}
+
+// Updates and deletes maintain the keys of the index.
+assert.commandWorked(t.update({a: 3}, {$set: {a: 30}}));
+assert.commandWorked(t.remove({a: 4}));
+assert.eq(0, t.find({a: 3}).hint("a_murmur").itcount());
+assert.eq(1, t.find({a: 30}).hint("a_murmur").itcount());
+assert.eq(0, t.find({a: 4}).hint("a_murmur").itcount());
+assert.commandWorked(t.validate({full: true}));
+
+// The index spec reports the hash version.
+const spec = t.getIndexes().find(index => index.name === "a_murmur");
+assert.eq(1, spec.hashVersion, tojson(spec));
+})();
@@ -41,6 +41,25 @@ histogramTypes.forEach(function(key) {
     assert(stats.latencyStats[key].hasOwnProperty("latency"));
 });
 
+// Test that the percentiles are reported along with the histograms.
+commandResult = testDB.runCommand({
+    aggregate: testColl.getName(),
+    pipeline: [{$collStats: {latencyStats: {histograms: true}}}],
+    cursor: {}
+});
+assert.commandWorked(commandResult);
+stats = commandResult.cursor.firstBatch[0];
+histogramTypes.forEach(function(key) {
+    assert(stats.latencyStats[key].hasOwnProperty("histogram"), tojson(stats));
+    const percentiles = stats.latencyStats[key].percentiles;
+    ["p50", "p90", "p99", "p999"].forEach(function(name) {
+        assert(percentiles.hasOwnProperty(name), tojson(stats));
+    });
+    assert.lte(percentiles.p50, percentiles.p90, tojson(stats));
+    assert.lte(percentiles.p90, percentiles.p99, tojson(stats));
+    assert.lte(percentiles.p99, percentiles.p999, tojson(stats));
+});
+
 var lastHistogram = getHistogramStats(testColl);
 
 // Insert
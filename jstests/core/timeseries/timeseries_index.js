@@ -14,6 +14,7 @@
 "use strict";
 
 load("jstests/core/timeseries/libs/timeseries.js");
+load("jstests/libs/analyze_plan.js");
 
 if (!TimeseriesTest.timeseriesCollectionsEnabled(db.getMongo())) {
     jsTestLog("Skipping test because the time-series collection feature flag is disabled");
@@ -29,7 +30,8 @@ const metaFieldName = 'mm';
 const doc = {
     _id: 0,
     [timeFieldName]: ISODate(),
-    [metaFieldName]: {tag1: 'a', tag2: 'b'}
+    [metaFieldName]: {tag1: 'a', tag2: 'b'},
+    x: 5
 };
 
 /**
@@ -88,6 +90,10 @@ runTest({[timeFieldName]: -1},
 runTest(
     {[metaFieldName + '.tag1']: 1, [timeFieldName]: -1},
     {'meta.tag1': 1, ['control.max.' + timeFieldName]: -1, ['control.min.' + timeFieldName]: -1});
+runTest({x: 1}, {'control.min.x': 1, 'control.max.x': 1});
+runTest({x: -1}, {'control.max.x': -1, 'control.min.x': -1});
+runTest({[metaFieldName + '.tag1']: 1, x: 1},
+        {'meta.tag1': 1, 'control.min.x': 1, 'control.max.x': 1});
 runTest({[metaFieldName + '.tag1']: -1, [metaFieldName + '.tag2']: 1, [timeFieldName]: 1}, {
     'meta.tag1': -1,
     'meta.tag2': 1,
@@ -105,9 +111,17 @@ assert.commandWorked(db.createCollection(
     coll.getName(), {timeseries: {timeField: timeFieldName, metaField: metaFieldName}}));
 assert.commandWorked(coll.insert(doc, {ordered: false}), 'failed to insert doc: ' + tojson(doc));
 
-// Reject index keys that do not include the metadata field.
-assert.commandFailedWithCode(coll.createIndex({not_metadata: 1}), ErrorCodes.CannotCreateIndex);
-assert.commandFailedWithCode(coll.dropIndex({not_metadata: 1}), ErrorCodes.IndexNotFound);
+// Reject index keys on measurement fields that are not ascending or descending.
+assert.commandFailedWithCode(coll.createIndex({not_metadata: 'hashed'}),
+                             ErrorCodes.CannotCreateIndex);
+assert.commandFailedWithCode(coll.dropIndex({not_metadata: 'hashed'}), ErrorCodes.IndexNotFound);
+
+// Queries on an indexed measurement field use the index on the control field to skip buckets.
+assert.commandWorked(coll.createIndex({x: 1}));
+const explain = coll.explain().aggregate([{$match: {x: {$lt: 10}}}]);
+assert(aggPlanHasStage(explain, 'IXSCAN'), tojson(explain));
+assert.eq(1, coll.find({x: {$lt: 10}}).itcount());
+assert.eq(0, coll.find({x: {$lt: 5}}).itcount());
 
 // Index names are not transformed. dropIndexes passes the request along to the buckets collection,
 // which in this case does not possess the index by that name.
@@ -0,0 +1,73 @@
+/**
+ * Tests that a change stream on a single collection sees every event on it, including after it is
+ * resumed, when its oplog scan seeks past the seconds of the oplog which hold no entries for it.
+ *
+ * @tags: [requires_replication, requires_majority_read_concern, requires_wiredtiger,
+ * requires_fcv_49]
+ */
+(function() {
+"use strict";
+
+const rst =
+    new ReplSetTest({nodes: 1, nodeOptions: {setParameter: {oplogNamespaceIndexEnabled: true}}});
+rst.startSet();
+rst.initiate();
+const db = rst.getPrimary().getDB("test");
+
+const watched = db.watched;
+const busy = db.busy;
+assert.commandWorked(watched.insert({_id: "first"}));
+const stream = watched.watch();
+
+// Spread the writes to the busy collection over several seconds, with a few writes to the watched
+// collection, and a command which is relevant to every stream, in between.
+const expected = [];
+for (let round = 0; round < 4; round++) {
+    const bulk = busy.initializeUnorderedBulkOp();
+    for (let i = 0; i < 500; i++) {
+        bulk.insert({round: round, i: i});
+    }
+    assert.commandWorked(bulk.execute());
+    sleep(1100);
+
+    assert.commandWorked(watched.insert({_id: round}));
+    assert.commandWorked(watched.update({_id: round}, {$set: {updated: true}}));
+    expected.push({operationType: "insert", _id: round});
+    expected.push({operationType: "update", _id: round});
+    if (round == 1) {
+        assert.commandWorked(db.createCollection("other"));
+    }
+}
+
+let resumeToken;
+for (let event of expected) {
+    assert.soon(() => stream.hasNext());
+    const next = stream.next();
+    assert.eq(event.operationType, next.operationType, tojson(next));
+    assert.eq(event._id, next.documentKey._id, tojson(next));
+    if (!resumeToken) {
+        resumeToken = next._id;
+    }
+}
+stream.close();
+
+// Resuming the stream skips ahead just the same.
+const resumed = watched.watch([], {resumeAfter: resumeToken});
+for (let event of expected.slice(1)) {
+    assert.soon(() => resumed.hasNext());
+    const next = resumed.next();
+    assert.eq(event.operationType, next.operationType, tojson(next));
+    assert.eq(event._id, next.documentKey._id, tojson(next));
+}
+
+// Events written after the stream reaches the end of the oplog are seen too.
+assert.commandWorked(busy.insert({last: true}));
+assert.commandWorked(watched.remove({_id: 0}));
+assert.soon(() => resumed.hasNext());
+const last = resumed.next();
+assert.eq("delete", last.operationType, tojson(last));
+assert.eq(0, last.documentKey._id, tojson(last));
+resumed.close();
+
+rst.stopSet();
+})();
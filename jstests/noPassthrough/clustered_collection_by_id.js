@@ -0,0 +1,80 @@
+/**
+ * Tests creating and querying a collection clustered by _id: the collection has no separate _id
+ * index, rejects duplicate and non-ObjectId _id values, and bounds collection scans with _id
+ * predicates.
+ *
+ * @tags: [requires_wiredtiger]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+
+const testDb = conn.getDB("test");
+const isSBEEnabled = (() => {
+    const getParam = testDb.adminCommand({getParameter: 1, featureFlagSBE: 1});
+    return getParam.hasOwnProperty("featureFlagSBE") && getParam.featureFlagSBE.value;
+})();
+const coll = testDb.clustered_collection_by_id;
+coll.drop();
+
+assert.commandWorked(testDb.createCollection(coll.getName(), {clusteredIndex: {}}));
+
+// Clustered collections cannot be capped, have an _id index or expire documents.
+assert.commandFailedWithCode(
+    testDb.createCollection("capped", {clusteredIndex: {}, capped: true, size: 4096}),
+    ErrorCodes.InvalidOptions);
+assert.commandFailedWithCode(
+    testDb.createCollection("idIndex",
+                            {clusteredIndex: {}, idIndex: {key: {_id: 1}, name: "_id_"}}),
+    ErrorCodes.InvalidOptions);
+assert.commandFailedWithCode(
+    testDb.createCollection("expire", {clusteredIndex: {expireAfterSeconds: 10}}),
+    ErrorCodes.InvalidOptions);
+
+const listColls = testDb.runCommand({listCollections: 1, filter: {name: coll.getName()}});
+assert.commandWorked(listColls);
+assert(listColls.cursor.firstBatch[0].options.hasOwnProperty("clusteredIndex"), listColls);
+assert.eq(0, coll.getIndexes().length, coll.getIndexes());
+
+const ids = [];
+for (let i = 0; i < 100; ++i) {
+    ids.push(ObjectId());
+}
+assert.commandWorked(coll.insert(ids.map((id, i) => ({_id: id, i: i}))));
+
+// Inserting an existing _id fails and leaves the original document in place.
+assert.commandFailedWithCode(coll.insert({_id: ids[10], i: -1}), ErrorCodes.DuplicateKey);
+assert.eq(10, coll.findOne({_id: ids[10]}).i);
+assert.eq(100, coll.find().itcount());
+
+// Collections clustered by _id require ObjectId _id values.
+assert.commandFailedWithCode(coll.insert({_id: 1}), ErrorCodes.BadValue);
+
+// Range predicates on _id return the right documents and bound the collection scan.
+const query = {_id: {$gt: ids[20], $lte: ids[30]}};
+assert.eq(10, coll.find(query).itcount());
+assert.eq([21, 30],
+          [coll.find(query).sort({i: 1}).limit(1).next().i,
+           coll.find(query).sort({i: -1}).limit(1).next().i]);
+
+if (!isSBEEnabled) {
+    const explain = coll.find(query).explain("executionStats");
+    const collScan = getPlanStage(getWinningPlan(explain.queryPlanner), "COLLSCAN");
+    assert.neq(null, collScan, explain);
+    assert(collScan.hasOwnProperty("minRecord") && collScan.hasOwnProperty("maxRecord"), explain);
+    assert.lt(explain.executionStats.totalDocsExamined, 100, explain);
+}
+
+// Updates and deletes by _id find their documents.
+assert.commandWorked(coll.update({_id: ids[50]}, {$set: {updated: true}}));
+assert.eq(true, coll.findOne({_id: ids[50]}).updated);
+assert.commandWorked(coll.remove({_id: ids[50]}));
+assert.eq(null, coll.findOne({_id: ids[50]}));
+assert.eq(99, coll.find().itcount());
+
+MongoRunner.stopMongod(conn);
+}());
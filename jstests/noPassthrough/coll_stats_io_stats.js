@@ -0,0 +1,63 @@
+/**
+ * Tests that $collStats and $indexStats report the cache and disk I/O of a collection and of each
+ * of its indexes.
+ *
+ * @tags: [requires_persistence, requires_wiredtiger]
+ */
+(function() {
+"use strict";
+
+let conn = MongoRunner.runMongod();
+let db = conn.getDB("test");
+let coll = db.coll_stats_io_stats;
+
+assert.commandWorked(coll.createIndex({a: 1}));
+const bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 1000; i++) {
+    bulk.insert({_id: i, a: i, padding: "x".repeat(1024)});
+}
+assert.commandWorked(bulk.execute());
+
+// Restart the server, so that reading the collection and the index reads them from disk.
+const dbpath = conn.dbpath;
+MongoRunner.stopMongod(conn);
+conn = MongoRunner.runMongod({dbpath: dbpath, noCleanData: true});
+db = conn.getDB("test");
+coll = db.coll_stats_io_stats;
+
+function getIOStats() {
+    const stats = coll.aggregate([{$collStats: {ioStats: {}}}]).next();
+    assert(stats.hasOwnProperty("ioStats"), tojson(stats));
+    return stats.ioStats;
+}
+
+assert.eq(1000, coll.find().itcount());
+assert.eq(1, coll.find({a: 500}).hint({a: 1}).itcount());
+
+let ioStats = getIOStats();
+jsTestLog("ioStats after the first reads: " + tojson(ioStats));
+assert.gt(ioStats.collection.bytesReadFromDisk, 0, tojson(ioStats));
+assert.gt(ioStats.collection.pagesReadFromDisk, 0, tojson(ioStats));
+assert.gt(ioStats.collection.bytesInCache, 0, tojson(ioStats));
+assert.gt(ioStats.indexes.a_1.pagesRequestedFromCache, 0, tojson(ioStats));
+assert(ioStats.indexes.hasOwnProperty("_id_"), tojson(ioStats));
+
+// Reading the collection again finds its pages in the cache.
+const pagesReadFromCache = ioStats.collection.pagesReadFromCache;
+const pagesReadFromDisk = ioStats.collection.pagesReadFromDisk;
+assert.eq(1000, coll.find().itcount());
+ioStats = getIOStats();
+assert.gt(ioStats.collection.pagesReadFromCache, pagesReadFromCache, tojson(ioStats));
+assert.eq(ioStats.collection.pagesReadFromDisk, pagesReadFromDisk, tojson(ioStats));
+
+// $indexStats reports the I/O of each index.
+const indexStats = coll.aggregate([{$indexStats: {}}, {$match: {name: "a_1"}}]).toArray();
+assert.eq(1, indexStats.length, tojson(indexStats));
+assert.gt(indexStats[0].io.pagesRequestedFromCache, 0, tojson(indexStats));
+
+const badSpec = {$collStats: {ioStats: {x: 1}}};
+assert.commandFailedWithCode(
+    db.runCommand({aggregate: coll.getName(), pipeline: [badSpec], cursor: {}}), 5591700);
+
+MongoRunner.stopMongod(conn);
+})();
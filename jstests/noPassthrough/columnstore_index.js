@@ -0,0 +1,139 @@
+/**
+ * Tests that a columnstore index is maintained on writes, and that queries which only need the
+ * fields it stores reconstruct their documents from its columns with the same results as a
+ * collection scan.
+ *
+ * @tags: [requires_wiredtiger]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+
+const testDb = conn.getDB("test");
+const isSBEEnabled = (() => {
+    const getParam = testDb.adminCommand({getParameter: 1, featureFlagSBE: 1});
+    return getParam.hasOwnProperty("featureFlagSBE") && getParam.featureFlagSBE.value;
+})();
+const coll = testDb.columnstore_index;
+coll.drop();
+
+// Columnstore indexes only store top-level fields and do not support the options which restrict
+// or constrain the set of indexed documents.
+assert.commandFailedWithCode(coll.createIndex({"a.b": "columnstore"}),
+                             ErrorCodes.CannotCreateIndex);
+assert.commandFailedWithCode(coll.createIndex({a: "columnstore", b: 1}),
+                             ErrorCodes.CannotCreateIndex);
+assert.commandFailedWithCode(coll.createIndex({a: "columnstore"}, {unique: true}),
+                             ErrorCodes.CannotCreateIndex);
+assert.commandFailedWithCode(coll.createIndex({a: "columnstore"}, {sparse: true}),
+                             ErrorCodes.CannotCreateIndex);
+assert.commandFailedWithCode(
+    coll.createIndex({a: "columnstore"}, {partialFilterExpression: {a: {$gt: 0}}}),
+    ErrorCodes.CannotCreateIndex);
+
+let docs = [];
+for (let i = 0; i < 200; ++i) {
+    let doc = {_id: i, wide: "x".repeat(100)};
+    if (i % 5 != 0) {
+        doc.a = i % 7;
+    }
+    doc.b = {c: i, d: [i, "str" + i]};
+    if (i % 3 == 0) {
+        doc.c = NumberLong(i);
+    }
+    docs.push(doc);
+}
+assert.commandWorked(coll.insert(docs.slice(0, 100)));
+assert.commandWorked(coll.createIndex({a: "columnstore", b: "columnstore", c: "columnstore"}));
+assert.commandWorked(coll.insert(docs.slice(100)));
+
+const setColumnScan = function(enabled) {
+    assert.commandWorked(
+        testDb.adminCommand({setParameter: 1, internalQueryEnableColumnScan: enabled}));
+};
+
+const queries = [
+    {filter: {}, projection: {a: 1, c: 1}},
+    {filter: {}, projection: {_id: 0, c: 1, a: 1}},
+    {filter: {a: {$gte: 3}}, projection: {b: 1}},
+    {filter: {"b.c": {$lt: 50}, c: {$exists: true}}, projection: {a: 1, "b.d": 1}},
+    {
+        filter: {$or: [{a: 1}, {c: {$gt: 150}}]},
+        projection: {_id: 0, a: 1, total: {$add: ["$a", 1]}}
+    },
+];
+
+const runQueries = function() {
+    return queries.map(query => coll.find(query.filter, query.projection).toArray());
+};
+
+const checkColumnScan = function(expectColumnScan) {
+    if (isSBEEnabled) {
+        return;
+    }
+    for (let query of queries) {
+        const explain = coll.find(query.filter, query.projection).explain("executionStats");
+        const columnScan = getPlanStage(getWinningPlan(explain.queryPlanner), "COLUMN_SCAN");
+        if (expectColumnScan) {
+            assert.neq(null, columnScan, explain);
+        } else {
+            assert.eq(null, columnScan, explain);
+        }
+    }
+};
+
+setColumnScan(false);
+const expected = runQueries();
+checkColumnScan(false);
+
+setColumnScan(true);
+assert.eq(expected, runQueries());
+checkColumnScan(true);
+
+// Queries which need fields outside of the index, or whose filter an index can serve, do not use
+// a column scan.
+if (!isSBEEnabled) {
+    let explain = coll.find({}, {a: 1, wide: 1}).explain();
+    assert.eq(null, getPlanStage(getWinningPlan(explain.queryPlanner), "COLUMN_SCAN"), explain);
+    explain = coll.find({_id: 5}, {a: 1}).explain();
+    assert.eq(null, getPlanStage(getWinningPlan(explain.queryPlanner), "COLUMN_SCAN"), explain);
+    explain = coll.find({}, {a: 1}).sort({a: 1}).explain();
+    assert.eq(null, getPlanStage(getWinningPlan(explain.queryPlanner), "COLUMN_SCAN"), explain);
+}
+
+// Aggregations which only depend on indexed fields read them from the columns.
+const pipeline = [{$group: {_id: "$a", total: {$sum: "$b.c"}}}, {$sort: {_id: 1}}];
+setColumnScan(false);
+const expectedAgg = coll.aggregate(pipeline).toArray();
+setColumnScan(true);
+assert.eq(expectedAgg, coll.aggregate(pipeline).toArray());
+
+// Updates and deletes keep the columns in sync with the documents.
+assert.commandWorked(coll.update({_id: 10}, {$set: {a: "updated"}, $unset: {c: 1}}));
+assert.commandWorked(coll.update({_id: 11}, {$unset: {wide: 1}, $set: {c: 11}}));
+assert.commandWorked(coll.update({_id: 12}, {_id: 12, c: 1, a: 2}));
+assert.commandWorked(coll.remove({a: 4}));
+setColumnScan(false);
+const expectedAfterWrites = runQueries();
+setColumnScan(true);
+assert.eq(expectedAfterWrites, runQueries());
+// The reconstructed documents keep the indexed fields in their original order.
+assert.eq([{_id: 12, c: 1, a: 2}], coll.find({c: 1, a: 2}, {a: 1, c: 1}).toArray());
+
+// Results stay correct when the column scan yields.
+assert.commandWorked(
+    testDb.adminCommand({setParameter: 1, internalQueryExecYieldIterations: 1}));
+assert.eq(expectedAfterWrites, runQueries());
+assert.commandWorked(
+    testDb.adminCommand({setParameter: 1, internalQueryExecYieldIterations: 1000}));
+
+const validateRes = coll.validate({full: true});
+assert.commandWorked(validateRes);
+assert(validateRes.valid, validateRes);
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,48 @@
+/**
+ * Tests that the compaction monitor compacts collections with reusable space in the background,
+ * and reports its work in serverStatus.
+ *
+ * @tags: [requires_persistence, requires_wiredtiger, requires_fcv_49]
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({
+    setParameter: {
+        compactionMonitorEnabled: false,
+        compactionMonitorSleepSecs: 1,
+        compactionMonitorMinFreeBytes: 0,
+        compactionMonitorMaxDutyCyclePercent: 100
+    }
+});
+const db = conn.getDB("test");
+const coll = db.compaction_monitor;
+
+const bulk = coll.initializeUnorderedBulkOp();
+const padding = "x".repeat(1024);
+for (let i = 0; i < 20 * 1000; i++) {
+    bulk.insert({_id: i, padding: padding});
+}
+assert.commandWorked(bulk.execute());
+assert.commandWorked(coll.deleteMany({_id: {$gte: 1000}}));
+
+// The space freed by the deletes becomes reusable once it is checkpointed.
+assert.commandWorked(db.adminCommand({fsync: 1}));
+
+assert.commandWorked(db.adminCommand({setParameter: 1, compactionMonitorEnabled: true}));
+assert.soon(() => {
+    const metrics = assert.commandWorked(db.serverStatus()).metrics.compaction;
+    return metrics.collectionsCompacted > 0;
+});
+
+const metrics = assert.commandWorked(db.serverStatus()).metrics.compaction;
+assert.gt(metrics.passes, 0, tojson(metrics));
+assert.gte(metrics.bytesFreed, 0, tojson(metrics));
+assert.eq(1000, coll.find().itcount());
+
+// Writes carry on while the monitor runs.
+assert.commandWorked(coll.insert({_id: "after"}));
+assert.commandWorked(db.adminCommand({setParameter: 1, compactionMonitorEnabled: false}));
+
+MongoRunner.stopMongod(conn);
+})();
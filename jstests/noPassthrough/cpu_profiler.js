@@ -0,0 +1,33 @@
+/**
+ * Tests that the sampling CPU profiler reports samples by thread role and stack in serverStatus.
+ */
+(function() {
+"use strict";
+
+if (getBuildInfo().buildEnvironment.target_os != "linux") {
+    jsTestLog("Skipping test: the CPU profiler is only available on Linux");
+    return;
+}
+
+const conn = MongoRunner.runMongod({setParameter: {cpuProfilingEnabled: true}});
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+
+// Burn some CPU in a connection thread.
+assert.soon(() => {
+    assert.commandWorked(db.c.insert({a: "x".repeat(1000)}));
+    db.c.find({$where: "return this.a.length > 0"}).itcount();
+    return db.serverStatus().cpuProfile.stats.samples > 0;
+});
+
+const cpuProfile = db.serverStatus().cpuProfile;
+assert.gt(cpuProfile.stats.numStacks, 0, tojson(cpuProfile));
+assert.gt(Object.keys(cpuProfile.stacks).length, 0, tojson(cpuProfile));
+let roleSamples = 0;
+for (let role in cpuProfile.roles) {
+    roleSamples += cpuProfile.roles[role];
+}
+assert.eq(roleSamples, cpuProfile.stats.samples, tojson(cpuProfile));
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,65 @@
+/**
+ * Tests that a getMore spools the remaining results of a cursor which is open for longer than
+ * 'cursorSpoolPinTimeBudgetMillis' to a temporary table, from which later getMores return them.
+ *
+ * @tags: [requires_wiredtiger]
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({setParameter: {cursorSpoolPinTimeBudgetMillis: 1}});
+const db = conn.getDB("test");
+const coll = db.cursor_spooling;
+
+const bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 100; i++) {
+    bulk.insert({_id: i, padding: "x".repeat(100)});
+}
+assert.commandWorked(bulk.execute());
+
+function getNumSpooled() {
+    return db.serverStatus().metrics.cursor.spooled;
+}
+
+// The first getMore spools the remaining results, which are all returned in order.
+let numSpooled = getNumSpooled();
+let cursor = coll.find().sort({_id: 1}).batchSize(10);
+assert.eq(10, cursor.objsLeftInBatch());
+sleep(10);
+const ids = cursor.toArray().map((doc) => doc._id);
+assert.eq(Array.from({length: 100}, (_, i) => i), ids);
+assert.eq(numSpooled + 1, getNumSpooled());
+
+// A spooled cursor can be killed.
+numSpooled = getNumSpooled();
+let res = assert.commandWorked(
+    db.runCommand({find: coll.getName(), filter: {_id: {$gte: 50}}, batchSize: 5}));
+sleep(10);
+assert.commandWorked(
+    db.runCommand({getMore: res.cursor.id, collection: coll.getName(), batchSize: 5}));
+assert.eq(numSpooled + 1, getNumSpooled());
+res = assert.commandWorked(db.runCommand({killCursors: coll.getName(), cursors: [res.cursor.id]}));
+assert.eq(1, res.cursorsKilled.length, tojson(res));
+
+// Cursors whose remaining results exceed the memory budget are not spooled, and still return all
+// of their results.
+assert.commandWorked(db.adminCommand({setParameter: 1, cursorSpoolMemoryBudgetBytes: 1024}));
+numSpooled = getNumSpooled();
+cursor = coll.find().batchSize(10);
+assert.eq(10, cursor.objsLeftInBatch());
+sleep(10);
+assert.eq(100, cursor.itcount());
+assert.eq(numSpooled, getNumSpooled());
+
+// Tailable cursors are never spooled.
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, cursorSpoolMemoryBudgetBytes: 16 * 1024 * 1024}));
+assert.commandWorked(db.createCollection("capped", {capped: true, size: 1024 * 1024}));
+assert.commandWorked(db.capped.insert([{_id: 0}, {_id: 1}, {_id: 2}]));
+res = assert.commandWorked(db.runCommand({find: "capped", tailable: true, batchSize: 1}));
+sleep(10);
+assert.commandWorked(db.runCommand({getMore: res.cursor.id, collection: "capped"}));
+assert.eq(numSpooled, getNumSpooled());
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,45 @@
+/**
+ * Tests that internalQueryExhaustGetMoreMaxBatchBytes limits the size of the batches streamed for
+ * an exhaust cursor, and that the cursor still returns every document.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+const db = conn.getDB("test");
+const coll = db.exhaust_getmore_max_batch_bytes;
+
+const numDocs = 200;
+const padding = "x".repeat(1000);
+let docs = [];
+for (let i = 0; i < numDocs; ++i) {
+    docs.push({_id: i, padding: padding});
+}
+assert.commandWorked(coll.insert(docs));
+
+const getNumGetMores = () =>
+    assert.commandWorked(db.adminCommand({serverStatus: 1})).metrics.commands.getMore.total;
+
+const countExhaustGetMores = function() {
+    const before = getNumGetMores();
+    assert.eq(numDocs, coll.find().addOption(DBQuery.Option.exhaust).itcount());
+    return getNumGetMores() - before;
+};
+
+// The first batch holds the default of 101 documents. By default each getMore batch holds up to
+// 16MB, so the rest of the documents fit in one.
+const numRemaining = numDocs - 101;
+assert.lte(countExhaustGetMores(), 2);
+
+// With room for about ten documents per batch, the server streams the rest in many batches.
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalQueryExhaustGetMoreMaxBatchBytes: 10 * 1024}));
+assert.gte(countExhaustGetMores(), numRemaining / 10);
+
+// A single document larger than the limit is still returned.
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalQueryExhaustGetMoreMaxBatchBytes: 1}));
+assert.gte(countExhaustGetMores(), numRemaining);
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,77 @@
+/**
+ * Tests that a FETCH stage which reads ahead of its index scan, and hints the records it will
+ * fetch to the storage engine, returns the same results as one that fetches each record as its
+ * index entry is produced, including when the query yields.
+ *
+ * @tags: [requires_wiredtiger]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+
+const testDb = conn.getDB("test");
+const isSBEEnabled = (() => {
+    const getParam = testDb.adminCommand({getParameter: 1, featureFlagSBE: 1});
+    return getParam.hasOwnProperty("featureFlagSBE") && getParam.featureFlagSBE.value;
+})();
+const coll = testDb.fetch_read_ahead;
+coll.drop();
+
+let docs = [];
+for (let i = 0; i < 500; ++i) {
+    docs.push({_id: i, a: i % 50, b: i, pad: "x".repeat(200)});
+}
+assert.commandWorked(coll.insert(docs));
+assert.commandWorked(coll.createIndex({a: 1}));
+
+const setReadAheadWindow = function(window) {
+    assert.commandWorked(
+        testDb.adminCommand({setParameter: 1, internalQueryFetchReadAheadWindow: window}));
+};
+
+const queries = [
+    {filter: {a: {$gte: 10, $lt: 30}}, sort: {b: 1}, limit: 0},
+    {filter: {a: {$gte: 10, $lt: 30}, b: {$mod: [3, 0]}}, sort: {b: -1}, limit: 0},
+    {filter: {a: {$in: [1, 7, 49]}}, sort: {b: 1}, limit: 5},
+    {filter: {a: 100}, sort: {b: 1}, limit: 0},
+];
+
+const runQueries = function() {
+    return queries.map(
+        query => coll.find(query.filter).sort(query.sort).limit(query.limit).toArray());
+};
+
+setReadAheadWindow(0);
+const expected = runQueries();
+
+for (let window of [1, 16, 1000]) {
+    setReadAheadWindow(window);
+    assert.eq(expected, runQueries(), "window: " + window);
+}
+
+// Results stay correct when the query yields with members in the read-ahead window.
+setReadAheadWindow(16);
+assert.commandWorked(testDb.adminCommand({setParameter: 1, internalQueryExecYieldIterations: 1}));
+assert.eq(expected, runQueries());
+assert.commandWorked(
+    testDb.adminCommand({setParameter: 1, internalQueryExecYieldIterations: 1000}));
+
+if (!isSBEEnabled) {
+    const explain = coll.find({a: {$gte: 10, $lt: 30}}).explain("executionStats");
+    const fetch = getPlanStage(explain.executionStats.executionStages, "FETCH");
+    assert.neq(null, fetch, explain);
+    assert.eq(200, fetch.prefetchedRecords, explain);
+
+    setReadAheadWindow(0);
+    const explainNoReadAhead = coll.find({a: {$gte: 10, $lt: 30}}).explain("executionStats");
+    assert(!getPlanStage(explainNoReadAhead.executionStats.executionStages, "FETCH")
+                .hasOwnProperty("prefetchedRecords"),
+           explainNoReadAhead);
+}
+
+MongoRunner.stopMongod(conn);
+}());
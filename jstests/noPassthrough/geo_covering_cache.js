@@ -0,0 +1,49 @@
+/**
+ * Tests that repeated 2dsphere queries over the same geometry return the same results whether their
+ * covering comes from the covering cache or not, including when the coverer parameters change.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+const db = conn.getDB("test");
+const coll = db.geo_covering_cache;
+
+assert.commandWorked(coll.createIndex({loc: "2dsphere"}));
+
+const docs = [];
+for (let x = -10; x <= 10; ++x) {
+    for (let y = -10; y <= 10; ++y) {
+        docs.push({loc: {type: "Point", coordinates: [x, y]}});
+    }
+}
+assert.commandWorked(coll.insert(docs));
+
+const zone = {
+    type: "Polygon",
+    coordinates: [[[-5.5, -5.5], [5.5, -5.5], [5.5, 2.5], [-5.5, 2.5], [-5.5, -5.5]]]
+};
+const countWithin = () => coll.find({loc: {$geoWithin: {$geometry: zone}}}).itcount();
+const countIntersects = () => coll.find({loc: {$geoIntersects: {$geometry: zone}}}).itcount();
+
+const expected = 11 * 8;
+for (let i = 0; i < 3; ++i) {
+    assert.eq(expected, countWithin());
+    assert.eq(expected, countIntersects());
+}
+
+// Cached coverings are not reused once the coverer parameters change.
+assert.commandWorked(db.adminCommand({setParameter: 1, internalQueryS2GeoFinestLevel: 10}));
+assert.eq(expected, countWithin());
+assert.commandWorked(db.adminCommand({setParameter: 1, internalQueryS2GeoMaxCells: 4}));
+assert.eq(expected, countWithin());
+
+// Disabling the cache does not change the results.
+assert.commandWorked(db.adminCommand({setParameter: 1, internalQueryS2GeoCoveringCacheSize: 0}));
+assert.eq(expected, countWithin());
+assert.eq(expected, countIntersects());
+
+assert.commandFailed(db.adminCommand({setParameter: 1, internalQueryS2GeoCoveringCacheSize: -1}));
+
+MongoRunner.stopMongod(conn);
+}());
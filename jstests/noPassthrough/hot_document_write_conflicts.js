@@ -0,0 +1,60 @@
+/**
+ * Tests that write conflicts are counted per namespace and per document in
+ * serverStatus.writeConflicts, and that writers to a document which keeps conflicting still all
+ * apply their updates when they take turns retrying.
+ *
+ * @tags: [requires_wiredtiger]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/parallelTester.js");  // For Thread.
+
+const conn = MongoRunner.runMongod({setParameter: {hotDocumentWriteConflictThreshold: 2}});
+assert.neq(null, conn, "mongod was unable to start up");
+
+const testDb = conn.getDB("test");
+const coll = testDb.hot_document_write_conflicts;
+coll.drop();
+assert.commandWorked(coll.insert([{_id: "hot", count: 0}, {_id: "cold", count: 0}]));
+
+// The writeConflicts section is not reported by default.
+assert(!testDb.serverStatus().hasOwnProperty("writeConflicts"));
+
+// Make half of the document writes conflict.
+assert.commandWorked(testDb.adminCommand({
+    configureFailPoint: "WTWriteConflictException",
+    mode: {activationProbability: 0.5},
+}));
+
+const kNumThreads = 4;
+const kNumUpdates = 25;
+let threads = [];
+for (let i = 0; i < kNumThreads; ++i) {
+    threads.push(new Thread(function(host, collName, numUpdates) {
+        const coll = new Mongo(host).getDB("test")[collName];
+        for (let j = 0; j < numUpdates; ++j) {
+            assert.commandWorked(coll.update({_id: "hot"}, {$inc: {count: 1}}));
+        }
+    }, conn.host, coll.getName(), kNumUpdates));
+    threads[i].start();
+}
+threads.forEach(thread => thread.join());
+assert.commandWorked(coll.update({_id: "cold"}, {$inc: {count: 1}}));
+
+assert.commandWorked(
+    testDb.adminCommand({configureFailPoint: "WTWriteConflictException", mode: "off"}));
+
+assert.eq(kNumThreads * kNumUpdates, coll.findOne({_id: "hot"}).count);
+assert.eq(1, coll.findOne({_id: "cold"}).count);
+
+const stats = testDb.serverStatus({writeConflicts: {documents: 1}}).writeConflicts;
+assert.gt(stats.namespaces[coll.getFullName()], 0, stats);
+assert.eq(1, stats.documents.length, stats);
+const hot = stats.documents[0];
+assert.eq(coll.getFullName(), hot.ns, stats);
+assert.gte(stats.namespaces[coll.getFullName()], hot.writeConflicts, stats);
+assert.gte(hot.writeConflicts, 2, stats);
+
+MongoRunner.stopMongod(conn);
+}());
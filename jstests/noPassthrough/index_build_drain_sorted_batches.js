@@ -0,0 +1,70 @@
+/**
+ * Tests that an index build which drains its side writes in batches sorted by key builds the same
+ * index entries as applying the writes in the order they were made, including repeated writes to
+ * the same key and unique keys which move between documents.
+ *
+ * @tags: [requires_replication]
+ */
+(function() {
+"use strict";
+
+load("jstests/noPassthrough/libs/index_build.js");
+
+const rst = new ReplSetTest({nodes: 1});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const testDb = primary.getDB("test");
+const coll = testDb.index_build_drain_sorted_batches;
+coll.drop();
+
+assert.commandWorked(
+    testDb.adminCommand({setParameter: 1, maxIndexBuildDrainBatchSize: 100}));
+
+let docs = [];
+for (let i = 0; i < 500; ++i) {
+    docs.push({_id: i, a: i % 17, u: i});
+}
+assert.commandWorked(coll.insert(docs));
+
+IndexBuildTest.pauseIndexBuilds(primary);
+const awaitIndexBuild = IndexBuildTest.startIndexBuild(
+    primary, coll.getFullName(), [{a: 1}, {u: 1}], {unique: true});
+IndexBuildTest.waitForIndexBuildToScanCollection(testDb, coll.getName(), "a_1");
+
+// Make the side writes: new documents, deletes, documents whose keys change several times and a
+// document which is inserted and then removed again.
+for (let i = 500; i < 800; ++i) {
+    assert.commandWorked(coll.insert({_id: i, a: i % 13, u: i}));
+}
+assert.commandWorked(coll.remove({_id: {$lt: 50}}));
+for (let round = 0; round < 3; ++round) {
+    assert.commandWorked(coll.update({_id: {$gte: 100, $lt: 200}}, {$inc: {a: 1}}, {multi: true}));
+}
+assert.commandWorked(coll.insert({_id: "transient", a: 1000, u: -1}));
+assert.commandWorked(coll.remove({_id: "transient"}));
+
+// Move a unique key from one document to another.
+assert.commandWorked(coll.update({_id: 300}, {$set: {u: -300}}));
+assert.commandWorked(coll.update({_id: 301}, {$set: {u: 300}}));
+
+IndexBuildTest.resumeIndexBuilds(primary);
+awaitIndexBuild();
+
+const checkIndex = function(hint, filter) {
+    assert.eq(coll.find(filter).hint({$natural: 1}).itcount(),
+              coll.find(filter).hint(hint).itcount(),
+              hint);
+};
+checkIndex({a: 1}, {a: {$gte: 0}});
+checkIndex({a: 1}, {a: 1000});
+checkIndex({u: 1}, {u: {$gte: -1000}});
+assert.eq(301, coll.find({u: 300}).hint({u: 1}).next()._id);
+
+const validateRes = coll.validate({full: true});
+assert.commandWorked(validateRes);
+assert(validateRes.valid, validateRes);
+
+rst.stopSet();
+}());
@@ -0,0 +1,51 @@
+/**
+ * Tests that index builds which generate the keys of the scanned documents on several threads build
+ * the same indexes as a single-threaded scan, including multikey, partial and unique indexes.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod(
+    {setParameter: {maxIndexBuildScanThreads: 4, internalIndexBuildScanBatchSize: 37}});
+assert.neq(null, conn, "mongod was unable to start up");
+
+const testDb = conn.getDB("test");
+const coll = testDb.index_build_scan_threads;
+coll.drop();
+
+let docs = [];
+for (let i = 0; i < 1000; ++i) {
+    let doc = {_id: i, a: i % 13, b: "str" + i, u: i};
+    if (i % 10 == 0) {
+        doc.arr = [i, i + 1, {c: i}];
+    }
+    docs.push(doc);
+}
+assert.commandWorked(coll.insert(docs));
+
+// Build the indexes with the same builder, so that they are fed from the same batches.
+assert.commandWorked(coll.createIndexes([{a: 1, b: -1}, {arr: 1}, {"arr.c": 1}, {u: 1}]));
+assert.commandWorked(coll.createIndex({b: 1}, {partialFilterExpression: {a: {$gt: 6}}}));
+
+const checkIndex = function(hint, filter, expectedCount) {
+    assert.eq(expectedCount, coll.find(filter).hint(hint).itcount(), hint);
+};
+checkIndex({a: 1, b: -1}, {a: 3}, docs.filter(doc => doc.a == 3).length);
+checkIndex({arr: 1}, {arr: {$gte: 0}}, 100);
+checkIndex({"arr.c": 1}, {"arr.c": {$gte: 500}}, 50);
+checkIndex({u: 1}, {u: {$lt: 250}}, 250);
+checkIndex({b: 1}, {a: {$gt: 6}, b: {$gte: ""}}, docs.filter(doc => doc.a > 6).length);
+
+// Key generation errors on the worker threads fail the build.
+assert.commandWorked(coll.insert({_id: "dup", u: 5}));
+assert.commandFailedWithCode(coll.createIndex({u: 1}, {unique: true, name: "u_unique"}),
+                             ErrorCodes.DuplicateKey);
+assert.commandWorked(coll.insert({_id: "geo", loc: "not a point"}));
+assert.commandFailed(coll.createIndex({loc: "2dsphere"}));
+
+const validateRes = coll.validate({full: true});
+assert.commandWorked(validateRes);
+assert(validateRes.valid, validateRes);
+
+MongoRunner.stopMongod(conn);
+}());
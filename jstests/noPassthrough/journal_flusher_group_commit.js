@@ -0,0 +1,55 @@
+/**
+ * Tests that concurrent {j: true} writes complete when the journal flusher groups their flushes,
+ * and that serverStatus reports the rounds of the journal flusher.
+ *
+ * @tags: [requires_journaling, requires_persistence, requires_wiredtiger, requires_fcv_49]
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({
+    setParameter: {journalFlusherMaxGroupCommitDelayMicros: 10 * 1000, journalCommitInterval: 500}
+});
+const db = conn.getDB("test");
+
+function sumCounts(histogram) {
+    return histogram.reduce((sum, bucket) => sum + bucket.count, 0);
+}
+
+const kNumWriters = 8;
+const kWritesPerWriter = 200;
+const writers = [];
+for (let i = 0; i < kNumWriters; i++) {
+    writers.push(startParallelShell(
+        funWithArgs(function(writer, numWrites) {
+            const coll = db.getSiblingDB("test").group_commit;
+            for (let j = 0; j < numWrites; j++) {
+                assert.commandWorked(
+                    coll.insert({writer: writer, j: j}, {writeConcern: {w: 1, j: true}}));
+            }
+        }, i, kWritesPerWriter), conn.port));
+}
+for (let writer of writers) {
+    writer();
+}
+assert.eq(kNumWriters * kWritesPerWriter, db.group_commit.find().itcount());
+
+const stats = assert.commandWorked(db.serverStatus()).journalFlusher;
+assert.gte(stats.waiters, kNumWriters * kWritesPerWriter, tojson(stats));
+assert.gt(stats.rounds, 0, tojson(stats));
+assert.gte(stats.rounds, stats.heldBackRounds, tojson(stats));
+assert.gt(stats.averageFlushMicros, 0, tojson(stats));
+
+// Every round is counted in the histogram of waiters per round, and every completed wait in the
+// histogram of wait times. The histograms are reported after the counts, so they may include more.
+assert.lte(stats.rounds, sumCounts(stats.waitersPerRound), tojson(stats));
+assert.gte(stats.waiters, sumCounts(stats.waitMicros), tojson(stats));
+assert.gte(sumCounts(stats.waitMicros), kNumWriters * kWritesPerWriter, tojson(stats));
+
+// Without a delay, the journal is flushed as soon as a flush is requested.
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, journalFlusherMaxGroupCommitDelayMicros: 0}));
+assert.commandWorked(db.group_commit.insert({last: true}, {writeConcern: {w: 1, j: true}}));
+
+MongoRunner.stopMongod(conn);
+})();
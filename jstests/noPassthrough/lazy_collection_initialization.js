@@ -0,0 +1,52 @@
+/**
+ * Tests that with lazyCollectionInitialization, the collections of user databases are initialized
+ * on first use after a restart, and discard their index catalog again once idle.
+ *
+ * @tags: [requires_persistence]
+ */
+(function() {
+"use strict";
+
+const kNumColls = 3;
+const options = {
+    setParameter: {lazyCollectionInitialization: true, lazyCollectionIdleTimeoutSecs: 1}
+};
+
+let conn = MongoRunner.runMongod(options);
+let db = conn.getDB("test");
+for (let i = 0; i < kNumColls; i++) {
+    const coll = db["coll" + i];
+    assert.commandWorked(coll.insert({_id: i, a: i}));
+    assert.commandWorked(coll.createIndex({a: 1}));
+}
+assert.commandWorked(db.ttl.createIndex({t: 1}, {expireAfterSeconds: 3600}));
+
+const dbpath = conn.dbpath;
+MongoRunner.stopMongod(conn);
+conn = MongoRunner.runMongod(Object.merge({dbpath: dbpath, noCleanData: true}, options));
+db = conn.getDB("test");
+
+// The collection with a TTL index is initialized at startup.
+checkLog.containsJson(conn, 5591702, {numDeferred: kNumColls});
+
+function checkCollections() {
+    for (let i = 0; i < kNumColls; i++) {
+        const coll = db["coll" + i];
+        assert.eq(1, coll.find({a: i}).hint({a: 1}).itcount());
+        assert.eq(2, coll.getIndexes().length, tojson(coll.getIndexes()));
+        const indexStats = coll.aggregate([{$indexStats: {}}]).toArray();
+        assert.eq(2, indexStats.length, tojson(indexStats));
+    }
+}
+checkCollections();
+
+// Once idle, the collections discard their index catalog, and build it again when next used.
+checkLog.containsJson(conn, 5591705);
+checkCollections();
+
+assert.commandWorked(db.coll0.createIndex({b: 1}));
+assert.commandWorked(db.coll0.insert({_id: 10, a: 10, b: 10}));
+assert.eq(1, db.coll0.find({b: 10}).hint({b: 1}).itcount());
+
+MongoRunner.stopMongod(conn);
+})();
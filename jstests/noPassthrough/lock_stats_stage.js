@@ -0,0 +1,51 @@
+/**
+ * Tests that the $lockStats aggregation stage reports the resources which operations waited for,
+ * and that it may only be run against the admin database.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+
+const testDb = conn.getDB("test");
+const adminDb = conn.getDB("admin");
+const coll = testDb.lock_stats_stage;
+coll.drop();
+assert.commandWorked(coll.insert({_id: 0}));
+
+assert.commandFailedWithCode(
+    testDb.runCommand({aggregate: 1, pipeline: [{$lockStats: {}}], cursor: {}}),
+    ErrorCodes.InvalidNamespace);
+assert.commandFailedWithCode(
+    adminDb.runCommand({aggregate: 1, pipeline: [{$lockStats: {limit: 1}}], cursor: {}}),
+    ErrorCodes.FailedToParse);
+
+// Hold the collection lock exclusively so that a write has to wait for it.
+const awaitSleep = startParallelShell(
+    `assert.commandWorked(db.adminCommand(
+         {sleep: 1, millis: 1000, lock: "w", lockTarget: "${coll.getFullName()}"}));`,
+    conn.port);
+assert.soon(() => adminDb.aggregate([{$currentOp: {}}, {$match: {"command.sleep": 1}}])
+                      .toArray()
+                      .length > 0);
+assert.commandWorked(coll.insert({_id: 1}));
+awaitSleep();
+
+const stats = adminDb.aggregate([{$lockStats: {}}]).toArray();
+const collStats = stats.find(entry => entry.name === coll.getFullName());
+assert.neq(undefined, collStats, stats);
+assert.eq("Collection", collStats.type, collStats);
+assert.gte(collStats.numWaits, 1, collStats);
+assert.gt(collStats.totalWaitMicros, 0, collStats);
+assert.eq(collStats.numWaits,
+          Object.values(collStats.waitMicrosHistogram).reduce((total, n) => total + n, 0),
+          collStats);
+
+// The resources are returned from the longest total wait time to the shortest.
+for (let i = 1; i < stats.length; ++i) {
+    assert.gte(stats[i - 1].totalWaitMicros, stats[i].totalWaitMicros, stats);
+}
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,78 @@
+/**
+ * Tests that $lookup pushes a projection of the fields of the joined documents which the later
+ * stages depend on into its foreign pipeline, and that the results are the same as without it.
+ *
+ * @tags: [requires_fcv_49]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");  // For getAggPlanStage().
+
+const conn = MongoRunner.runMongod();
+const db = conn.getDB("test");
+const local = db.local;
+const foreign = db.foreign;
+
+for (let i = 0; i < 20; i++) {
+    assert.commandWorked(local.insert({_id: i, key: i % 5}));
+    assert.commandWorked(
+        foreign.insert({_id: i, key: i % 5, x: i, y: {a: i, b: -i}, padding: "x".repeat(1000)}));
+}
+assert.commandWorked(foreign.createIndex({key: 1, x: 1}));
+
+function setPushDown(enabled) {
+    assert.commandWorked(
+        db.adminCommand({setParameter: 1, internalQueryLookupPushDownProjection: enabled}));
+}
+
+function projecting(pipeline) {
+    const stage = getAggPlanStage(local.explain().aggregate(pipeline), "$lookup");
+    assert.neq(null, stage, tojson(pipeline));
+    return stage.$lookup.projecting;
+}
+
+const lookup = {
+    $lookup: {from: foreign.getName(), localField: "key", foreignField: "key", as: "j"}
+};
+const lookupWithPipeline = {
+    $lookup: {
+        from: foreign.getName(),
+        let: {key: "$key"},
+        pipeline: [{$match: {$expr: {$eq: ["$key", "$$key"]}}}],
+        as: "j"
+    }
+};
+const pipelines = [
+    [lookup, {$unwind: "$j"}, {$group: {_id: "$j.x", n: {$sum: 1}}}, {$sort: {_id: 1}}],
+    [lookup, {$unwind: "$j"}, {$match: {"j.y.a": {$gt: 5}}}, {$project: {_id: 1, "j.x": 1}}],
+    [lookup, {$unwind: "$j"}, {$count: "n"}],
+    [lookupWithPipeline, {$unwind: "$j"}, {$project: {_id: 0, local: "$_id", "j.y.b": 1}}],
+    [lookupWithPipeline, {$unwind: "$j"}, {$count: "n"}],
+];
+
+for (let pipeline of pipelines) {
+    setPushDown(false);
+    const expected = local.aggregate(pipeline).toArray();
+    assert.eq(undefined, projecting(pipeline), tojson(pipeline));
+
+    setPushDown(true);
+    assert.sameMembers(expected, local.aggregate(pipeline).toArray(), tojson(pipeline));
+}
+
+// Only the fields used later are fetched, along with the foreign field.
+assert.eq({key: 1, x: 1, _id: 0}, projecting(pipelines[0]));
+assert.eq({key: 1, x: 1, "y.a": 1, _id: 0}, projecting(pipelines[1]));
+assert.eq({key: 1, _id: 0}, projecting(pipelines[2]));
+assert.eq({"y.b": 1, _id: 0}, projecting(pipelines[3]));
+
+// When no field of the joined documents is used, only their number is kept.
+assert.eq({_id: 1}, projecting(pipelines[4]));
+
+// Nothing is pushed down when the joined documents are returned or used as they are.
+assert.eq(undefined, projecting([lookup, {$unwind: "$j"}]));
+assert.eq(undefined, projecting([lookup, {$project: {j: 1}}]));
+assert.eq(undefined, projecting([lookup, {$project: {n: {$size: "$j"}}}]));
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,34 @@
+/**
+ * Tests that replSetGetStatus on a secondary reports metrics about the oplog batches it has fetched
+ * from its sync source.
+ *
+ * @tags: [requires_replication]
+ */
+(function() {
+"use strict";
+
+const rst = new ReplSetTest({nodes: [{}, {rsConfig: {priority: 0, votes: 0}}]});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const secondary = rst.getSecondary();
+const coll = primary.getDB("test").oplog_fetcher_metrics;
+
+let docs = [];
+for (let i = 0; i < 100; ++i) {
+    docs.push({_id: i, payload: "x".repeat(1024)});
+}
+assert.commandWorked(coll.insert(docs, {writeConcern: {w: 2}}));
+
+const status = assert.commandWorked(secondary.adminCommand({replSetGetStatus: 1}));
+assert(status.hasOwnProperty("oplogFetcherMetrics"), status);
+const metrics = status.oplogFetcherMetrics;
+assert.gt(metrics.numBatches, 0, metrics);
+assert.gt(metrics.numBytes, 100 * 1024, metrics);
+assert.gt(metrics.recentBytesPerSecond, 0, metrics);
+assert.gte(metrics.numBufferWaits, 0, metrics);
+assert.gte(metrics.totalBufferWaitMillis, 0, metrics);
+
+rst.stopSet();
+}());
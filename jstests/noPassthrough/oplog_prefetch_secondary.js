@@ -0,0 +1,53 @@
+/**
+ * Tests that a secondary with oplog prefetching enabled reads the documents targeted by replicated
+ * updates and deletes ahead of applying them, and still ends up with the same data as the primary.
+ *
+ * @tags: [requires_replication]
+ */
+(function() {
+"use strict";
+
+const rst = new ReplSetTest({
+    nodes: [
+        {},
+        {
+            rsConfig: {priority: 0, votes: 0},
+            setParameter: {replOplogPrefetchThreadCount: 4},
+        },
+    ]
+});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const secondary = rst.getSecondary();
+const coll = primary.getDB("test").oplog_prefetch_secondary;
+
+const numDocs = 1000;
+let docs = [];
+for (let i = 0; i < numDocs; ++i) {
+    docs.push({_id: i, x: 0});
+}
+assert.commandWorked(coll.insert(docs, {writeConcern: {w: 2}}));
+
+const getPrefetchMetrics = () =>
+    assert.commandWorked(secondary.adminCommand({serverStatus: 1})).metrics.repl.prefetch;
+
+// Replicate batches of updates and deletes until the secondary has prefetched some of their
+// documents. A batch is skipped while the previous one is still being prefetched.
+let round = 0;
+assert.soon(() => {
+    ++round;
+    let bulk = coll.initializeUnorderedBulkOp();
+    for (let i = 0; i < numDocs; i += 2) {
+        bulk.find({_id: i}).updateOne({$set: {x: round}});
+    }
+    bulk.find({_id: numDocs - round}).removeOne();
+    assert.commandWorked(bulk.execute({w: 2}));
+    return getPrefetchMetrics().documents > 0;
+}, () => tojson(getPrefetchMetrics()));
+
+rst.awaitReplication();
+rst.checkReplicatedDataHashes();
+rst.stopSet();
+}());
@@ -0,0 +1,53 @@
+/**
+ * Tests that $out produces the same collection and indexes when the secondary indexes of its
+ * target are built after the results have been written, and that unique index violations are
+ * still reported.
+ */
+(function() {
+"use strict";
+
+load("jstests/aggregation/extras/utils.js");  // For assertErrorCode.
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+
+const testDb = conn.getDB("test");
+const source = testDb.out_deferred_index_builds_source;
+const target = testDb.out_deferred_index_builds_target;
+source.drop();
+target.drop();
+
+assert.commandWorked(
+    testDb.adminCommand({setParameter: 1, internalQueryOutDeferIndexBuilds: true}));
+
+let docs = [];
+for (let i = 0; i < 1000; ++i) {
+    docs.push({_id: i, a: i % 10, b: i, s: "str" + i});
+}
+assert.commandWorked(source.insert(docs));
+
+assert.commandWorked(target.createIndex({a: 1}));
+assert.commandWorked(target.createIndex({b: 1}, {unique: true}));
+assert.commandWorked(target.createIndex({s: "text"}));
+const indexesBefore = target.getIndexes().sort((x, y) => x.name < y.name ? -1 : 1);
+
+const pipeline = [{$match: {}}, {$out: target.getName()}];
+source.aggregate(pipeline);
+
+assert.eq(1000, target.find().itcount());
+assert.eq(indexesBefore, target.getIndexes().sort((x, y) => x.name < y.name ? -1 : 1));
+assert.eq(100, target.find({a: 3}).hint({a: 1}).itcount());
+assert.eq(1, target.find({b: 7}).hint({b: 1}).itcount());
+assert.eq(1, target.find({$text: {$search: "str42"}}).itcount());
+
+// A duplicate key on a unique index fails the $out and leaves the target collection untouched.
+assert.commandWorked(source.insert({_id: 1000, a: 0, b: 0}));
+assertErrorCode(source, pipeline, ErrorCodes.DuplicateKey);
+assert.eq(1000, target.find().itcount());
+
+// No temporary collections are left behind.
+assert.eq(0,
+          testDb.getCollectionNames().filter((name) => name.startsWith("tmp.agg_out")).length);
+
+MongoRunner.stopMongod(conn);
+}());
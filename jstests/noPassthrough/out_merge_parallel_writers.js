@@ -0,0 +1,84 @@
+/**
+ * Tests that $out and $merge produce the same output when their writes are partitioned among
+ * several writer threads, and that the documents with the same $merge 'on' fields are still merged
+ * in order.
+ *
+ * @tags: [requires_replication, requires_fcv_49]
+ */
+(function() {
+"use strict";
+
+const rst = new ReplSetTest({nodes: 1});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const db = primary.getDB("test");
+const source = db.source;
+
+assert.commandWorked(db.adminCommand({setParameter: 1, logComponentVerbosity: {query: 2}}));
+
+// Large enough documents for every partition of the output to fill more than one batch.
+const kNumDocs = 2000;
+const kNumKeys = 500;
+const padding = "x".repeat(40 * 1024);
+let bulk = source.initializeUnorderedBulkOp();
+for (let i = 0; i < kNumDocs; i++) {
+    bulk.insert({_id: i, k: i % kNumKeys, seq: i, padding: padding});
+}
+assert.commandWorked(bulk.execute());
+
+function setWriterThreads(numThreads) {
+    assert.commandWorked(db.adminCommand(
+        {setParameter: 1, internalQueryDocumentSourceWriterMaxThreads: numThreads}));
+}
+
+function runMerge(targetName) {
+    const target = db[targetName];
+    target.drop();
+    assert.commandWorked(target.createIndex({k: 1}, {unique: true}));
+    source.aggregate(
+        [
+            {$sort: {seq: 1}},
+            {$project: {_id: 0}},
+            {$merge: {into: targetName, on: "k", whenMatched: "replace", whenNotMatched: "insert"}}
+        ],
+        {writeConcern: {w: "majority"}});
+    return target.find({}, {_id: 0, k: 1, seq: 1}).sort({k: 1}).toArray();
+}
+
+setWriterThreads(1);
+source.aggregate([{$out: "out_serial"}]);
+const serialMerge = runMerge("merge_serial");
+
+setWriterThreads(4);
+source.aggregate([{$out: "out_parallel"}]);
+checkLog.containsJson(primary, 5591715, {numWriters: 4});
+const parallelMerge = runMerge("merge_parallel");
+
+// $out copies the source collection whatever the number of writers.
+assert.eq(kNumDocs, db.out_parallel.find().itcount());
+assert.eq(source.find({}, {padding: 0}).sort({_id: 1}).toArray(),
+          db.out_parallel.find({}, {padding: 0}).sort({_id: 1}).toArray());
+assert.eq(db.out_serial.find({}, {padding: 0}).sort({_id: 1}).toArray(),
+          db.out_parallel.find({}, {padding: 0}).sort({_id: 1}).toArray());
+
+// The last document of each key replaced the earlier ones.
+assert.eq(kNumKeys, parallelMerge.length);
+for (let doc of parallelMerge) {
+    assert.eq(doc.seq, kNumDocs - kNumKeys + doc.k, tojson(doc));
+}
+assert.eq(serialMerge, parallelMerge);
+
+// A write error fails the aggregation.
+assert.commandWorked(db.dup_target.createIndex({seq: 1}, {unique: true}));
+assert.commandWorked(db.dup_target.insert({_id: "dup", seq: kNumDocs - 1}));
+const res = db.runCommand({
+    aggregate: source.getName(),
+    pipeline: [{$merge: {into: "dup_target", whenMatched: "fail", whenNotMatched: "insert"}}],
+    cursor: {}
+});
+assert.commandFailedWithCode(res, ErrorCodes.DuplicateKey);
+
+rst.stopSet();
+})();
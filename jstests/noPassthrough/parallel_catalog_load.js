@@ -0,0 +1,41 @@
+/**
+ * Tests that the collections and indexes of several databases are loaded from a pool of threads
+ * at startup, and that they are all usable after a restart.
+ *
+ * @tags: [requires_persistence]
+ */
+(function() {
+"use strict";
+
+const kNumDbs = 4;
+const kNumCollsPerDb = 5;
+
+let conn = MongoRunner.runMongod({setParameter: {catalogLoadThreads: 3}});
+for (let i = 0; i < kNumDbs; i++) {
+    const db = conn.getDB("parallel_catalog_load_" + i);
+    for (let j = 0; j < kNumCollsPerDb; j++) {
+        const coll = db["coll" + j];
+        assert.commandWorked(coll.insert({_id: j, a: j}));
+        assert.commandWorked(coll.createIndex({a: 1}));
+    }
+}
+
+const dbpath = conn.dbpath;
+MongoRunner.stopMongod(conn);
+conn = MongoRunner.runMongod(
+    {dbpath: dbpath, noCleanData: true, setParameter: {catalogLoadThreads: 3}});
+
+checkLog.containsJson(conn, 5591701, {numThreads: 3});
+checkLog.containsJson(conn, 5591702, {numCollections: (n) => n >= kNumDbs * kNumCollsPerDb});
+
+for (let i = 0; i < kNumDbs; i++) {
+    const db = conn.getDB("parallel_catalog_load_" + i);
+    for (let j = 0; j < kNumCollsPerDb; j++) {
+        const coll = db["coll" + j];
+        assert.eq(1, coll.find({a: j}).hint({a: 1}).itcount());
+        assert.eq(2, coll.getIndexes().length, tojson(coll.getIndexes()));
+    }
+}
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,70 @@
+/**
+ * Tests that the blocking $group and $sort stages spill to disk before reaching their own memory
+ * limit when the blocking stages of the server hold more than
+ * 'internalQueryMaxServerBlockingMemoryUsageBytes', and only if they are allowed to use disk.
+ *
+ * @tags: [requires_fcv_49]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");  // For getAggPlanStage().
+
+const conn = MongoRunner.runMongod();
+const db = conn.getDB("test");
+const coll = db.query_memory_governor;
+
+const kNumDocs = 1000;
+const padding = "x".repeat(10 * 1024);
+const bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < kNumDocs; i++) {
+    bulk.insert({_id: i, padding: padding});
+}
+assert.commandWorked(bulk.execute());
+
+function setServerLimit(bytes) {
+    assert.commandWorked(
+        db.adminCommand({setParameter: 1, internalQueryMaxServerBlockingMemoryUsageBytes: bytes}));
+}
+
+// The stages are kept out of the find layer so that they run as $group and $sort.
+const pipelines = {
+    $group: [
+        {$_internalInhibitOptimization: {}},
+        {$group: {_id: "$_id", padding: {$first: "$padding"}}},
+        {$sort: {_id: 1}}
+    ],
+    $sort: [{$_internalInhibitOptimization: {}}, {$sort: {_id: -1}}],
+};
+
+function usedDisk(stageName, allowDiskUse) {
+    const explain = coll.explain("executionStats")
+                        .aggregate(pipelines[stageName], {allowDiskUse: allowDiskUse});
+    const stage = getAggPlanStage(explain, stageName);
+    assert.neq(null, stage, tojson(explain));
+    return stage.usedDisk;
+}
+
+const expected = {};
+for (let stageName of Object.keys(pipelines)) {
+    setServerLimit(0);
+    expected[stageName] = coll.aggregate(pipelines[stageName], {allowDiskUse: true}).toArray();
+    assert.eq(kNumDocs, expected[stageName].length);
+    assert(!usedDisk(stageName, true), stageName);
+
+    // Well below the memory limit of the stage, but above that of the server.
+    setServerLimit(2 * 1024 * 1024);
+    assert(usedDisk(stageName, true), stageName);
+    assert.eq(expected[stageName],
+              coll.aggregate(pipelines[stageName], {allowDiskUse: true}).toArray(),
+              stageName);
+
+    // A stage which may not use disk keeps to its own limit.
+    assert(!usedDisk(stageName, false), stageName);
+    assert.eq(expected[stageName],
+              coll.aggregate(pipelines[stageName], {allowDiskUse: false}).toArray(),
+              stageName);
+}
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,54 @@
+/**
+ * Tests that the results of repeated aggregations on the collections listed in
+ * 'internalQueryResultCacheNamespaces' are served from the query result cache until the collection
+ * is written to.
+ *
+ * @tags: [requires_fcv_49]
+ */
+(function() {
+"use strict";
+
+const conn =
+    MongoRunner.runMongod({setParameter: {internalQueryResultCacheNamespaces: "test.cached"}});
+const db = conn.getDB("test");
+
+function cacheStats() {
+    return assert.commandWorked(db.serverStatus()).metrics.queryResultCache;
+}
+
+assert.commandWorked(db.cached.insert([{x: 1}, {x: 2}, {x: 2}]));
+assert.commandWorked(db.notCached.insert([{x: 1}]));
+
+const pipeline = [{$group: {_id: "$x", n: {$sum: 1}}}, {$sort: {_id: 1}}];
+const expected = [{_id: 1, n: 1}, {_id: 2, n: 2}];
+
+let stats = cacheStats();
+assert.eq(expected, db.cached.aggregate(pipeline).toArray());
+assert.eq(expected, db.cached.aggregate(pipeline).toArray());
+let newStats = cacheStats();
+assert.eq(stats.misses + 1, newStats.misses, tojson(newStats));
+assert.eq(stats.hits + 1, newStats.hits, tojson(newStats));
+assert.eq(1, newStats.size.entries, tojson(newStats));
+
+// A write to the collection invalidates its cached results.
+assert.commandWorked(db.cached.insert({x: 1}));
+assert.eq([{_id: 1, n: 2}, {_id: 2, n: 2}], db.cached.aggregate(pipeline).toArray());
+stats = newStats;
+newStats = cacheStats();
+assert.eq(stats.misses + 1, newStats.misses, tojson(newStats));
+assert.eq(stats.hits, newStats.hits, tojson(newStats));
+
+// Aggregations which are not deterministic, which return more than a batch, or which are on
+// other collections are not cached.
+stats = cacheStats();
+db.cached.aggregate([{$project: {r: {$rand: {}}}}]).itcount();
+db.cached.aggregate([{$project: {r: {$rand: {}}}}]).itcount();
+assert.eq(4, db.cached.aggregate([], {cursor: {batchSize: 1}}).itcount());
+assert.eq(4, db.cached.aggregate([], {cursor: {batchSize: 1}}).itcount());
+assert.eq(1, db.notCached.aggregate(pipeline).itcount());
+assert.eq(1, db.notCached.aggregate(pipeline).itcount());
+newStats = cacheStats();
+assert.eq(stats.hits, newStats.hits, tojson(newStats));
+
+MongoRunner.stopMongod(conn);
+})();
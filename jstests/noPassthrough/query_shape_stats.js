@@ -0,0 +1,71 @@
+/**
+ * Tests that $queryShapeStats reports the statistics aggregated for each query shape run against a
+ * collection.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({});
+assert.neq(null, conn, "mongod was unable to start up");
+
+const testDb = conn.getDB("test");
+const coll = testDb.query_shape_stats;
+coll.drop();
+
+let docs = [];
+for (let i = 0; i < 100; ++i) {
+    docs.push({_id: i, a: i % 10, b: i});
+}
+assert.commandWorked(coll.insert(docs));
+assert.commandWorked(coll.createIndex({a: 1}));
+
+// Two shapes: equality on 'a' with different constants, and a range on 'b'.
+for (let i = 0; i < 5; ++i) {
+    assert.eq(10, coll.find({a: i}).itcount());
+}
+for (let i = 0; i < 3; ++i) {
+    assert.eq(50, coll.find({b: {$gte: 50}}).itcount());
+}
+
+const getShapeStats = function() {
+    return coll.aggregate([{$queryShapeStats: {}}, {$match: {ns: coll.getFullName()}}]).toArray();
+};
+
+const queryHashOf = function(filter) {
+    return assert.commandWorked(coll.find(filter).explain()).queryPlanner.queryHash;
+};
+
+const stats = getShapeStats();
+assert.eq(2, stats.length, stats);
+
+const byHash = {};
+for (let entry of stats) {
+    byHash[entry.queryHash] = entry;
+    assert(entry.hasOwnProperty("host"), entry);
+}
+
+const equalityStats = byHash[queryHashOf({a: 1})];
+assert.eq(5, equalityStats.count, stats);
+assert.eq(50, equalityStats.nreturned, stats);
+assert.eq(50, equalityStats.keysExamined, stats);
+assert.gt(equalityStats.bytesReturned, 0, stats);
+assert.eq(5, equalityStats.latency.histogram.reduce((sum, bucket) => sum + bucket.count, 0));
+
+const rangeStats = byHash[queryHashOf({b: {$gte: 1}})];
+assert.eq(3, rangeStats.count, stats);
+assert.eq(150, rangeStats.nreturned, stats);
+assert.eq(300, rangeStats.docsExamined, stats);
+
+// The stage rejects a non-empty specification.
+assert.commandFailedWithCode(
+    testDb.runCommand(
+        {aggregate: coll.getName(), pipeline: [{$queryShapeStats: {a: 1}}], cursor: {}}),
+    ErrorCodes.FailedToParse);
+
+// No shapes are recorded once the store is disabled.
+assert.commandWorked(testDb.adminCommand({setParameter: 1, internalQueryShapeStatsMaxEntries: 0}));
+assert.eq(10, coll.find({a: 1, b: {$exists: true}}).itcount());
+assert.eq(2, getShapeStats().length);
+
+MongoRunner.stopMongod(conn);
+})();
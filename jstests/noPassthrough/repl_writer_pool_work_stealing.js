@@ -0,0 +1,39 @@
+/**
+ * Tests that a secondary whose oplog application thread pools use work stealing applies the oplog
+ * correctly.
+ *
+ * @tags: [requires_replication]
+ */
+(function() {
+"use strict";
+
+const rst = new ReplSetTest({
+    nodes: [
+        {},
+        {
+            rsConfig: {priority: 0, votes: 0},
+            setParameter: {replWriterPoolWorkStealing: true, replWriterThreadCount: 4},
+        },
+    ]
+});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const db = primary.getDB("test");
+
+for (let round = 0; round < 5; ++round) {
+    for (let c = 0; c < 4; ++c) {
+        let bulk = db["repl_writer_pool_work_stealing_" + c].initializeUnorderedBulkOp();
+        for (let i = 0; i < 500; ++i) {
+            bulk.find({_id: i}).upsert().updateOne({$inc: {x: 1}});
+        }
+        bulk.find({_id: round}).removeOne();
+        assert.commandWorked(bulk.execute());
+    }
+}
+
+rst.awaitReplication();
+rst.checkReplicatedDataHashes();
+rst.stopSet();
+}());
@@ -0,0 +1,69 @@
+/**
+ * Tests that an SBE collection scan split across several producer threads returns the same set of
+ * documents as a regular scan, and that scans which need the natural order are not parallelized.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({});
+assert.neq(null, conn, "mongod was unable to start up");
+
+const testDb = conn.getDB("test");
+const isSBEEnabled = (() => {
+    const getParam = testDb.adminCommand({getParameter: 1, featureFlagSBE: 1});
+    return getParam.hasOwnProperty("featureFlagSBE") && getParam.featureFlagSBE.value;
+})();
+if (!isSBEEnabled) {
+    jsTestLog("Skipping test because the SBE feature flag is disabled");
+    MongoRunner.stopMongod(conn);
+    return;
+}
+
+const coll = testDb.sbe_parallel_coll_scan;
+coll.drop();
+
+// Enough documents for the parallel scan to split the collection into several ranges.
+const kNumDocs = 50000;
+let bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < kNumDocs; ++i) {
+    bulk.insert({_id: i, a: i % 17, b: "str" + i});
+}
+assert.commandWorked(bulk.execute());
+
+const setDegree = function(degree) {
+    assert.commandWorked(testDb.adminCommand(
+        {setParameter: 1, internalQuerySlotBasedExecutionParallelScanDegree: degree}));
+};
+
+const sortById = (docs) => docs.sort((lhs, rhs) => lhs._id - rhs._id);
+const runQueries = function() {
+    return {
+        all: sortById(coll.find().toArray()),
+        filtered: sortById(coll.find({a: {$lt: 5}}, {_id: 1, b: 1}).toArray()),
+        count: coll.find({b: {$gte: "str5"}}).itcount(),
+        limited: coll.find({a: 3}).limit(10).itcount(),
+    };
+};
+
+setDegree(1);
+const expected = runQueries();
+assert.eq(kNumDocs, expected.all.length);
+
+for (let degree of [2, 4, 8]) {
+    setDegree(degree);
+    assert.eq(expected, runQueries(), "unexpected results with degree " + degree);
+
+    const explain = coll.find({a: 1}).explain("executionStats");
+    assert.commandWorked(explain);
+    assert.eq(expected.all.filter((doc) => doc.a === 1).length,
+              explain.executionStats.nReturned,
+              explain);
+}
+
+// A scan in natural order must return the documents in the order of their RecordIds.
+setDegree(4);
+assert.eq(expected.all, coll.find().sort({$natural: 1}).toArray());
+assert.eq(expected.all, coll.find().hint({$natural: 1}).toArray());
+
+MongoRunner.stopMongod(conn);
+})();
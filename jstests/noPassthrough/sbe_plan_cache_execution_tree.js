@@ -0,0 +1,62 @@
+/**
+ * Tests that SBE plan stage trees kept with plan cache entries are only reused by queries with
+ * identical parameters, and that reused trees return the same results as freshly built ones.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod(
+    {setParameter: {internalQuerySlotBasedExecutionCacheExecutionTrees: true}});
+assert.neq(null, conn, "mongod was unable to start up");
+
+const testDb = conn.getDB("test");
+const isSBEEnabled = (() => {
+    const getParam = testDb.adminCommand({getParameter: 1, featureFlagSBE: 1});
+    return getParam.hasOwnProperty("featureFlagSBE") && getParam.featureFlagSBE.value;
+})();
+if (!isSBEEnabled) {
+    jsTestLog("Skipping test because the SBE feature flag is disabled");
+    MongoRunner.stopMongod(conn);
+    return;
+}
+
+const coll = testDb.sbe_plan_cache_execution_tree;
+coll.drop();
+
+let docs = [];
+for (let i = 0; i < 200; ++i) {
+    docs.push({_id: i, a: i % 10, b: i % 7});
+}
+assert.commandWorked(coll.insert(docs));
+assert.commandWorked(coll.createIndex({a: 1}));
+assert.commandWorked(coll.createIndex({b: 1}));
+
+const getHits = function() {
+    return testDb.serverStatus().metrics.query.planCache.sbeExecutionTreeHits;
+};
+
+const runQuery = function(a, b) {
+    return coll.find({a: a, b: b}, {_id: 1}).sort({_id: 1}).toArray();
+};
+
+// Run the query enough times for its plan cache entry to become active.
+const expected = runQuery(3, 4);
+for (let i = 0; i < 3; ++i) {
+    assert.eq(expected, runQuery(3, 4));
+}
+
+// Identical queries are answered by cloning the tree kept with the cache entry.
+const hitsBefore = getHits();
+for (let i = 0; i < 5; ++i) {
+    assert.eq(expected, runQuery(3, 4));
+}
+assert.gt(getHits(), hitsBefore);
+
+// A query with different constants shares the cache entry but must not reuse the tree.
+const hitsBeforeOtherConstants = getHits();
+const other = runQuery(5, 5);
+assert.eq(coll.find({a: 5, b: 5}, {_id: 1}).sort({_id: 1}).hint({$natural: 1}).toArray(), other);
+assert.eq(hitsBeforeOtherConstants, getHits());
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,62 @@
+/**
+ * Tests that an SBE collection scan running in block mode returns the same results as a scan
+ * which reads one record at a time, including when the scan yields in the middle of a block.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({setParameter: {internalQueryExecYieldIterations: 7}});
+assert.neq(null, conn, "mongod was unable to start up");
+
+const testDb = conn.getDB("test");
+const isSBEEnabled = (() => {
+    const getParam = testDb.adminCommand({getParameter: 1, featureFlagSBE: 1});
+    return getParam.hasOwnProperty("featureFlagSBE") && getParam.featureFlagSBE.value;
+})();
+if (!isSBEEnabled) {
+    jsTestLog("Skipping test because the SBE feature flag is disabled");
+    MongoRunner.stopMongod(conn);
+    return;
+}
+
+const coll = testDb.sbe_scan_block_mode;
+coll.drop();
+
+const kNumDocs = 1000;
+let docs = [];
+for (let i = 0; i < kNumDocs; ++i) {
+    docs.push({_id: i, a: i % 13, b: "str" + i});
+}
+assert.commandWorked(coll.insert(docs));
+
+const setBlockSize = function(blockSize) {
+    assert.commandWorked(testDb.adminCommand(
+        {setParameter: 1, internalQuerySlotBasedExecutionScanBlockSize: blockSize}));
+};
+
+const runQueries = function() {
+    return {
+        all: coll.find().sort({$natural: 1}).toArray(),
+        filtered: coll.find({a: {$lt: 5}}, {_id: 1, b: 1}).sort({$natural: 1}).toArray(),
+        limited: coll.find({a: 3}).limit(10).toArray(),
+        count: coll.find({b: {$gte: "str5"}}).itcount(),
+    };
+};
+
+setBlockSize(1);
+const expected = runQueries();
+assert.eq(kNumDocs, expected.all.length);
+
+for (let blockSize of [2, 7, 128, 1024, 4096]) {
+    setBlockSize(blockSize);
+    assert.eq(expected, runQueries(), "unexpected results with block size " + blockSize);
+}
+
+// Execution stats must stay accurate when the scan runs in block mode.
+setBlockSize(64);
+const explain = coll.find({a: 1}).explain("executionStats");
+assert.commandWorked(explain);
+assert.eq(explain.executionStats.nReturned, coll.find({a: 1}).itcount(), explain);
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,55 @@
+/**
+ * Tests that connPoolStats on mongos reports the demand and target number of connections chosen by
+ * the ShardingTaskExecutorPoolController for each host, and that the target keeps the requested
+ * headroom above the demand.
+ *
+ * @tags: [requires_replication, requires_sharding]
+ */
+(function() {
+"use strict";
+
+const minConns = 2;
+const st = new ShardingTest({
+    config: {nodes: 1},
+    shards: 1,
+    rs0: {nodes: 1},
+    mongos: [{
+        setParameter: {
+            ShardingTaskExecutorPoolMinSize: minConns,
+            ShardingTaskExecutorPoolTargetHeadroomPercent: 50,
+            ShardingTaskExecutorPoolTargetDecayPercent: 10,
+            ShardingTaskExecutorPoolReplicaSetMatching: "disabled",
+        }
+    }],
+});
+const primary = st.rs0.getPrimary();
+const coll = st.s.getDB("test").sharding_task_executor_pool_target;
+
+assert.commandWorked(coll.insert({x: 1}));
+assert.eq(1, coll.find().itcount());
+
+const getHostStats = () =>
+    assert.commandWorked(st.s.adminCommand({connPoolStats: 1})).hosts[primary.host];
+
+assert.soon(() => {
+    const hostStats = getHostStats();
+    return hostStats && hostStats.hasOwnProperty("targetConnections");
+}, () => tojson(getHostStats()));
+
+const hostStats = getHostStats();
+assert(hostStats.hasOwnProperty("demand"), tojson(hostStats));
+assert.gte(hostStats.targetConnections, minConns, tojson(hostStats));
+assert.gte(hostStats.targetConnections,
+           hostStats.demand + Math.ceil(hostStats.demand / 2),
+           tojson(hostStats));
+
+// The new parameters can be changed at runtime and are range checked.
+assert.commandWorked(
+    st.s.adminCommand({setParameter: 1, ShardingTaskExecutorPoolTargetDecayPercent: 100}));
+assert.commandFailed(
+    st.s.adminCommand({setParameter: 1, ShardingTaskExecutorPoolTargetDecayPercent: 0}));
+assert.commandFailed(
+    st.s.adminCommand({setParameter: 1, ShardingTaskExecutorPoolTargetHeadroomPercent: -1}));
+
+st.stop();
+}());
@@ -0,0 +1,66 @@
+/**
+ * Tests that the time an operation spends waiting for locks and for its write concern is broken
+ * down in the profiler and the slow query log.
+ *
+ * @tags: [requires_fsync, requires_profiling]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/fail_point_util.js");
+
+const conn = MongoRunner.runMongod();
+const db = conn.getDB("test");
+const coll = db.slow_op_wait_times;
+assert.commandWorked(db.createCollection(coll.getName()));
+assert.commandWorked(db.setProfilingLevel(2, {slowms: 0}));
+
+function getWaitTimes(comment) {
+    const entry = db.system.profile.findOne({"command.comment": comment});
+    assert.neq(null, entry, comment);
+    assert(entry.hasOwnProperty("waitTimesMicros"), tojson(entry));
+    return entry.waitTimesMicros;
+}
+
+// An insert blocked behind fsyncLock waits for its locks.
+assert.commandWorked(db.fsyncLock());
+const awaitLockedInsert = startParallelShell(() => {
+    assert.commandWorked(db.getSiblingDB("test").runCommand(
+        {insert: "slow_op_wait_times", documents: [{_id: 0}], comment: "lockWait"}));
+}, conn.port);
+assert.soon(() => db.getSiblingDB("admin")
+                      .aggregate([
+                          {$currentOp: {}},
+                          {$match: {"command.comment": "lockWait", waitingForLock: true}}
+                      ])
+                      .itcount() === 1);
+sleep(100);
+assert.commandWorked(db.fsyncUnlock());
+awaitLockedInsert();
+
+assert.gte(getWaitTimes("lockWait").lockWait, 100 * 1000);
+
+// An insert held up before waiting for its write concern reports the time in the write concern.
+const fp = configureFailPoint(conn, "hangBeforeWaitingForWriteConcern");
+const awaitWriteConcernInsert = startParallelShell(() => {
+    assert.commandWorked(db.getSiblingDB("test").runCommand({
+        insert: "slow_op_wait_times",
+        documents: [{_id: 1}],
+        writeConcern: {w: 1},
+        comment: "writeConcernWait"
+    }));
+}, conn.port);
+fp.wait();
+sleep(100);
+fp.off();
+awaitWriteConcernInsert();
+
+assert.gte(getWaitTimes("writeConcernWait").writeConcern, 100 * 1000);
+
+checkLog.containsJson(conn, 51803, {
+    command: (cmd) => cmd.comment === "writeConcernWait",
+    waitTimesMicros: (waitTimes) => waitTimes && waitTimes.writeConcern >= 100 * 1000
+});
+
+MongoRunner.stopMongod(conn);
+})();
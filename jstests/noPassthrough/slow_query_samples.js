@@ -0,0 +1,50 @@
+/**
+ * Tests that the $slowQuerySamples aggregation stage returns the execution statistics of a limited
+ * number of slow operations per query shape, without profiling them.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod(
+    {setParameter: {internalQuerySlowQuerySamplesPerShapePerMinute: 2}, slowms: 0});
+assert.neq(null, conn, "mongod was unable to start up");
+
+const testDb = conn.getDB("test");
+const adminDb = conn.getDB("admin");
+const coll = testDb.slow_query_samples;
+coll.drop();
+assert.commandWorked(coll.createIndex({a: 1}));
+assert.commandWorked(coll.insert([{_id: 0, a: 1}, {_id: 1, a: 2}, {_id: 2, a: 3}]));
+
+assert.commandFailedWithCode(
+    testDb.runCommand({aggregate: 1, pipeline: [{$slowQuerySamples: {}}], cursor: {}}),
+    ErrorCodes.InvalidNamespace);
+assert.commandFailedWithCode(
+    adminDb.runCommand({aggregate: 1, pipeline: [{$slowQuerySamples: {limit: 1}}], cursor: {}}),
+    ErrorCodes.FailedToParse);
+
+// Run the same query shape several times; only two of them are sampled within the minute.
+for (let i = 0; i < 5; ++i) {
+    assert.eq(1, coll.find({a: i % 3 + 1}).itcount());
+}
+assert.eq(2, coll.find({_id: {$gte: 1}}).itcount());
+
+const samples =
+    adminDb.aggregate([{$slowQuerySamples: {}}, {$match: {ns: coll.getFullName()}}]).toArray();
+const findSamples = samples.filter(sample => sample.command.filter.hasOwnProperty("a"));
+assert.eq(2, findSamples.length, samples);
+for (let sample of findSamples) {
+    assert.eq("query", sample.op, sample);
+    assert.eq("IXSCAN { a: 1 }", sample.planSummary, sample);
+    assert.eq("FETCH", sample.execStats.stage, sample);
+    assert.eq("IXSCAN", sample.execStats.inputStage.stage, sample);
+}
+assert.eq(1,
+          samples.filter(sample => sample.command.filter.hasOwnProperty("_id")).length,
+          samples);
+
+// Nothing was written to the profiler.
+assert.eq(0, testDb.system.profile.find().itcount());
+
+MongoRunner.stopMongod(conn);
+}());
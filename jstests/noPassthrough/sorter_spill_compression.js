@@ -0,0 +1,67 @@
+/**
+ * Tests that sorts which spill to disk return the same results with each spill compressor, and
+ * report the size of their spilled data before and after compression in explain and serverStatus.
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+
+const testDb = conn.getDB("test");
+const isSBEEnabled = (() => {
+    const getParam = testDb.adminCommand({getParameter: 1, featureFlagSBE: 1});
+    return getParam.hasOwnProperty("featureFlagSBE") && getParam.featureFlagSBE.value;
+})();
+const coll = testDb.sorter_spill_compression;
+coll.drop();
+
+let docs = [];
+for (let i = 0; i < 2000; ++i) {
+    docs.push({_id: i, a: i % 100, pad: "x".repeat(1000)});
+}
+assert.commandWorked(coll.insert(docs));
+assert.commandWorked(testDb.adminCommand(
+    {setParameter: 1, internalQueryMaxBlockingSortMemoryUsageBytes: 100 * 1024}));
+
+assert.commandFailed(testDb.adminCommand({setParameter: 1, sorterSpillCompressor: "lz4"}));
+
+const spillMetrics = () => testDb.serverStatus().metrics.sorter;
+
+let expected = null;
+for (let compressor of ["none", "snappy", "zstd"]) {
+    assert.commandWorked(testDb.adminCommand({setParameter: 1, sorterSpillCompressor: compressor}));
+
+    const before = spillMetrics();
+    const results = coll.find().sort({a: 1, _id: 1}).allowDiskUse().toArray();
+    const after = spillMetrics();
+    if (expected === null) {
+        expected = results;
+    }
+    assert.eq(expected, results, compressor);
+
+    const dataSize = after.spilledDataSizeBytes - before.spilledDataSizeBytes;
+    const storageSize = after.spilledStorageSizeBytes - before.spilledStorageSizeBytes;
+    assert.gt(dataSize, 0, after);
+    if (compressor === "none") {
+        assert.gt(storageSize, dataSize, after);
+    } else {
+        assert.lt(storageSize, dataSize / 10, after);
+    }
+
+    if (!isSBEEnabled) {
+        const explain = coll.find().sort({a: 1, _id: 1}).allowDiskUse().explain("executionStats");
+        const sortStage = getPlanStage(explain.executionStats.executionStages, "SORT");
+        assert.neq(null, sortStage, explain);
+        assert(sortStage.usedDisk, explain);
+        assert.gt(sortStage.spilledDataSizeBytes, 0, explain);
+        if (compressor !== "none") {
+            assert.lt(sortStage.spilledStorageSizeBytes, sortStage.spilledDataSizeBytes, explain);
+        }
+    }
+}
+
+MongoRunner.stopMongod(conn);
+}());
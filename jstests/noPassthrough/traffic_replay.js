@@ -0,0 +1,55 @@
+/**
+ * Tests that mongotrafficreplay replays a traffic recording against another server, including the
+ * getMores of the recorded cursors, and reports the latencies of the replayed commands.
+ */
+(function() {
+"use strict";
+
+const recordingDir = MongoRunner.toRealDir("$dataDir/traffic_replay/");
+const recordingFilePath = MongoRunner.toRealDir(recordingDir + "/recording.txt");
+const reportFilePath = MongoRunner.toRealDir(recordingDir + "/report.json");
+mkdir(recordingDir);
+
+const source = MongoRunner.runMongod({setParameter: "trafficRecordingDirectory=" + recordingDir});
+const target = MongoRunner.runMongod();
+
+const sourceDB = source.getDB("test");
+assert.commandWorked(sourceDB.runCommand({startRecordingTraffic: 1, filename: "recording.txt"}));
+
+const coll = sourceDB.traffic_replay;
+for (let i = 0; i < 10; i++) {
+    assert.commandWorked(coll.insert({_id: i}));
+}
+assert.eq(10, coll.find().batchSize(2).itcount());
+assert.commandWorked(coll.remove({_id: 0}));
+
+assert.commandWorked(sourceDB.runCommand({stopRecordingTraffic: 1}));
+MongoRunner.stopMongod(source);
+
+assert.eq(0,
+          runMongoProgram("mongotrafficreplay",
+                          "--input",
+                          recordingFilePath,
+                          "--output",
+                          reportFilePath,
+                          "--uri",
+                          "mongodb://localhost:" + target.port,
+                          "--speed",
+                          "10"));
+
+const targetColl = target.getDB("test").traffic_replay;
+assert.eq(9, targetColl.find().itcount());
+assert.eq(null, targetColl.findOne({_id: 0}));
+
+const report = JSON.parse(cat(reportFilePath));
+jsTestLog("Replay report: " + tojson(report));
+assert.eq(1, report.sessions, tojson(report));
+assert.eq(10, report.commands.insert.count, tojson(report));
+assert.eq(1, report.commands.find.count, tojson(report));
+assert.gte(report.commands.getMore.count, 4, tojson(report));
+assert.eq(0, report.commands.getMore.errors, tojson(report));
+assert.eq(1, report.commands.delete.count, tojson(report));
+assert.gte(report.commands.insert.latencyMicros.max, report.commands.insert.latencyMicros.p50);
+
+MongoRunner.stopMongod(target);
+})();
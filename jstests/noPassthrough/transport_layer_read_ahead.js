@@ -0,0 +1,24 @@
+/**
+ * Tests that a server with transportLayerReadAheadBytes set sources messages both smaller and
+ * larger than its read ahead buffer correctly, including fire-and-forget writes which the shell
+ * pipelines ahead of the command that follows them.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({setParameter: {transportLayerReadAheadBytes: 512}});
+const coll = conn.getDB("test").transport_layer_read_ahead;
+
+for (let size of [1, 100, 400, 600, 4096, 1024 * 1024]) {
+    assert.commandWorked(coll.insert({_id: size, s: "x".repeat(size)}));
+    assert.eq(size, coll.findOne({_id: size}).s.length);
+}
+
+// Unacknowledged writes are not answered, so several of them reach the server back to back.
+for (let i = 0; i < 100; ++i) {
+    coll.insert({_id: "w0_" + i}, {writeConcern: {w: 0}});
+}
+assert.soon(() => coll.find({_id: /^w0_/}).itcount() == 100);
+
+MongoRunner.stopMongod(conn);
+}());
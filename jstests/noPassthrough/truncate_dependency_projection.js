@@ -0,0 +1,55 @@
+/**
+ * Tests that an aggregation whose dependency projection is truncated to top-level fields returns
+ * the same results as one that pushes down the dotted dependency paths, and that the truncated
+ * projection runs on the simple projection fast path in the classic engine.
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+
+const testDb = conn.getDB("test");
+const isSBEEnabled = (() => {
+    const getParam = testDb.adminCommand({getParameter: 1, featureFlagSBE: 1});
+    return getParam.hasOwnProperty("featureFlagSBE") && getParam.featureFlagSBE.value;
+})();
+
+const coll = testDb.truncate_dependency_projection;
+coll.drop();
+
+let docs = [];
+for (let i = 0; i < 100; ++i) {
+    let doc = {_id: i, a: {b: i % 7, c: "str" + i}, d: [{e: i}, {e: i + 1}, i]};
+    for (let j = 0; j < 50; ++j) {
+        doc["f" + j] = j;
+    }
+    docs.push(doc);
+}
+assert.commandWorked(coll.insert(docs));
+
+const pipeline = [
+    {$group: {_id: "$a.b", total: {$sum: "$f3"}, es: {$push: "$d.e"}}},
+    {$sort: {_id: 1}}
+];
+
+const setTruncation = function(enabled) {
+    assert.commandWorked(testDb.adminCommand(
+        {setParameter: 1, internalQueryTruncateDependencyProjectionToRootLevel: enabled}));
+};
+
+setTruncation(false);
+const expected = coll.aggregate(pipeline).toArray();
+
+setTruncation(true);
+assert.eq(expected, coll.aggregate(pipeline).toArray());
+
+if (!isSBEEnabled) {
+    const explain = coll.explain().aggregate(pipeline);
+    assert.neq(null, getAggPlanStage(explain, "PROJECTION_SIMPLE"), explain);
+}
+
+MongoRunner.stopMongod(conn);
+}());
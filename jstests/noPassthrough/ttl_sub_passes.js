@@ -0,0 +1,46 @@
+/**
+ * Tests that a TTL pass deletes at most ttlMonitorSubPassTargetDocs documents through one TTL index
+ * before moving on to the next one, and revisits the indexes with expired documents left in further
+ * sub-passes until they are all deleted.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({
+    setParameter: {
+        ttlMonitorSleepSecs: 1,
+        ttlMonitorEnabled: false,
+        ttlMonitorSubPassTargetDocs: 10,
+        internalBatchedDeletesTargetBatchDocs: 4,
+    }
+});
+const db = conn.getDB("test");
+const large = db.ttl_sub_passes_large;
+const small = db.ttl_sub_passes_small;
+
+assert.commandWorked(large.createIndex({x: 1}, {expireAfterSeconds: 0}));
+assert.commandWorked(small.createIndex({x: 1}, {expireAfterSeconds: 0}));
+
+const past = new Date(Date.now() - 60 * 1000);
+let docs = [];
+for (let i = 0; i < 55; i++) {
+    docs.push({x: past});
+}
+assert.commandWorked(large.insert(docs));
+assert.commandWorked(small.insert([{x: past}, {x: past}, {x: past}]));
+
+const getTTLMetrics = () => assert.commandWorked(db.serverStatus()).metrics.ttl;
+const metricsBefore = getTTLMetrics();
+
+assert.commandWorked(db.adminCommand({setParameter: 1, ttlMonitorEnabled: true}));
+assert.soon(() => large.find().itcount() == 0 && small.find().itcount() == 0,
+            () => tojson(getTTLMetrics()));
+
+// The large collection needs six sub-passes, the last of which deletes the remaining five.
+const metrics = getTTLMetrics();
+assert.eq(metricsBefore.deletedDocuments + 58, metrics.deletedDocuments, tojson(metrics));
+assert.gte(metrics.subPasses - metricsBefore.subPasses, 6, tojson(metrics));
+assert.soon(() => bsonWoCompare({}, getTTLMetrics().backlog) == 0, () => tojson(getTTLMetrics()));
+
+MongoRunner.stopMongod(conn);
+})();
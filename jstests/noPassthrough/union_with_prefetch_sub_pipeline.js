@@ -0,0 +1,77 @@
+/**
+ * Tests that $unionWith returns the same documents when its sub-pipelines are prefetched on
+ * separate threads, across getMores, when the output is cut short, and that errors of a prefetched
+ * sub-pipeline fail the aggregation.
+ *
+ * @tags: [requires_fcv_49]
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({setParameter: {logComponentVerbosity: tojson({query: 1})}});
+const db = conn.getDB("test");
+
+const kNumMonths = 12;
+const kDocsPerMonth = 300;
+for (let month = 0; month < kNumMonths; month++) {
+    const bulk = db["archive_" + month].initializeUnorderedBulkOp();
+    for (let i = 0; i < kDocsPerMonth; i++) {
+        bulk.insert({_id: i, month: month, x: i % 10});
+    }
+    assert.commandWorked(bulk.execute());
+}
+
+const pipeline = [];
+for (let month = 1; month < kNumMonths; month++) {
+    pipeline.push({$unionWith: {coll: "archive_" + month, pipeline: [{$match: {x: {$lt: 5}}}]}});
+}
+
+function setPrefetch(enabled, maxBufferBytes) {
+    assert.commandWorked(db.adminCommand({
+        setParameter: 1,
+        internalQueryUnionWithPrefetchSubPipeline: enabled,
+        internalQueryUnionWithPrefetchMaxBufferBytes: maxBufferBytes
+    }));
+}
+
+function sortedResults(batchSize) {
+    return db.archive_0.aggregate(pipeline, {cursor: {batchSize: batchSize}})
+        .toArray()
+        .sort((a, b) => a.month - b.month || a._id - b._id);
+}
+
+setPrefetch(false, 16 * 1024 * 1024);
+const expected = sortedResults(101);
+assert.eq(kDocsPerMonth + (kNumMonths - 1) * kDocsPerMonth / 2, expected.length);
+
+// With a buffer which only holds a few documents, the threads of the sub-pipelines wait for the
+// main pipeline, including in between getMores.
+for (let maxBufferBytes of [16 * 1024 * 1024, 256]) {
+    setPrefetch(true, maxBufferBytes);
+    assert.eq(expected, sortedResults(101), tojson({maxBufferBytes: maxBufferBytes}));
+    assert.eq(expected, sortedResults(7), tojson({maxBufferBytes: maxBufferBytes}));
+}
+checkLog.containsJson(conn, 5591716);
+
+// Stopping early interrupts the threads which are still running.
+assert.eq(10, db.archive_0.aggregate(pipeline.concat([{$limit: 10}])).itcount());
+const cursor = db.archive_0.aggregate(pipeline, {cursor: {batchSize: 2}});
+assert(cursor.hasNext());
+cursor.close();
+
+// Explain does not prefetch, and still reports the sub-pipelines.
+const explain = db.archive_0.explain("executionStats").aggregate(pipeline);
+assert.commandWorked(explain);
+
+// An error in a sub-pipeline fails the aggregation.
+const res = db.runCommand({
+    aggregate: "archive_0",
+    pipeline: [{
+        $unionWith: {coll: "archive_1", pipeline: [{$project: {y: {$divide: ["$x", 0]}}}]}
+    }],
+    cursor: {}
+});
+assert.commandFailedWithCode(res, [16608, ErrorCodes.BadValue]);
+
+MongoRunner.stopMongod(conn);
+})();
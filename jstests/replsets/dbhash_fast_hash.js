@@ -0,0 +1,58 @@
+/**
+ * Tests that the "dbHash" command with {fastHash: true} returns the same hashes on the primary and
+ * on the secondary, whatever the number of threads which hash the _id ranges of a collection, and
+ * that the hashes change with the data.
+ *
+ * @tags: [requires_fcv_49]
+ */
+(function() {
+"use strict";
+
+const rst = new ReplSetTest({nodes: 2});
+rst.startSet();
+
+const replSetConfig = rst.getReplSetConfig();
+replSetConfig.members[1].priority = 0;
+rst.initiate(replSetConfig);
+
+const primary = rst.getPrimary();
+const secondary = rst.getSecondary();
+const db = primary.getDB("test");
+
+// Large enough for the collection to be split into several _id ranges.
+const bulk = db.dbhash_fast_hash.initializeUnorderedBulkOp();
+for (let i = 0; i < 20000; i++) {
+    bulk.insert({_id: i, x: i % 7});
+}
+assert.commandWorked(bulk.execute());
+assert.commandWorked(db.small.insert([{_id: "a"}, {_id: "b"}]));
+rst.awaitReplication();
+
+assert.commandWorked(primary.adminCommand({setParameter: 1, dbHashMaxThreads: 8}));
+assert.commandWorked(secondary.adminCommand({setParameter: 1, dbHashMaxThreads: 1}));
+
+function fastHash(conn) {
+    return assert.commandWorked(conn.getDB("test").runCommand({dbHash: 1, fastHash: true}));
+}
+
+let primaryRes = fastHash(primary);
+let secondaryRes = fastHash(secondary);
+assert.eq(primaryRes.collections, secondaryRes.collections, tojson([primaryRes, secondaryRes]));
+assert.eq(primaryRes.md5, secondaryRes.md5, tojson([primaryRes, secondaryRes]));
+
+// The fast hashes differ from the MD5 hashes of the collections.
+const md5Res = assert.commandWorked(db.runCommand({dbHash: 1}));
+assert.neq(md5Res.collections.dbhash_fast_hash, primaryRes.collections.dbhash_fast_hash);
+
+// Changing a document changes the hash of its collection only.
+assert.commandWorked(db.dbhash_fast_hash.update({_id: 12345}, {$set: {x: -1}}));
+rst.awaitReplication();
+const updatedRes = fastHash(primary);
+assert.neq(primaryRes.collections.dbhash_fast_hash, updatedRes.collections.dbhash_fast_hash);
+assert.eq(primaryRes.collections.small, updatedRes.collections.small);
+
+secondaryRes = fastHash(secondary);
+assert.eq(updatedRes.collections, secondaryRes.collections, tojson([updatedRes, secondaryRes]));
+
+rst.stopSet();
+})();
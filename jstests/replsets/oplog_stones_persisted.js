@@ -0,0 +1,46 @@
+/**
+ * Tests that the oplog truncation points are loaded on startup from where they were persisted, along
+ * with the size of the oplog, rather than recomputed by scanning or sampling the oplog.
+ * @tags: [requires_wiredtiger, requires_persistence, requires_fcv_49]
+ */
+(function() {
+"use strict";
+
+const replSet = new ReplSetTest({nodes: 1, oplogSize: 40});
+replSet.startSet();
+replSet.initiate();
+
+let primary = replSet.getPrimary();
+let coll = primary.getDB("test").getCollection("testcoll");
+
+// Write enough to the oplog for several truncation points to be placed.
+const padding = "x".repeat(100 * 1024);
+for (let i = 0; i < 200; i++) {
+    assert.commandWorked(coll.insert({_id: i, padding: padding}));
+}
+
+replSet.stopSet(null /* signal */, true /* forRestart */);
+replSet.startSet({restart: true});
+primary = replSet.getPrimary();
+
+let res = assert.commandWorked(primary.getDB("test").serverStatus());
+assert.eq(res.oplogTruncation.processingMethod, "persisted", tojson(res.oplogTruncation));
+// After a clean shutdown, no oplog entry needs to be scanned.
+checkLog.containsJson(primary, 5591721, {numRecordsScanned: 0});
+
+// The loaded truncation points keep being maintained, and persisted again, as the oplog grows.
+coll = primary.getDB("test").getCollection("testcoll");
+for (let i = 200; i < 400; i++) {
+    assert.commandWorked(coll.insert({_id: i, padding: padding}));
+}
+
+replSet.stopSet(null /* signal */, true /* forRestart */);
+replSet.startSet({restart: true});
+primary = replSet.getPrimary();
+
+res = assert.commandWorked(primary.getDB("test").serverStatus());
+assert.eq(res.oplogTruncation.processingMethod, "persisted", tojson(res.oplogTruncation));
+assert.eq(400, primary.getDB("test").testcoll.find().itcount());
+
+replSet.stopSet();
+})();
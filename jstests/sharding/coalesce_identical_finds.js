@@ -0,0 +1,77 @@
+/**
+ * Tests that when internalQueryCoalesceIdenticalFinds is enabled, identical finds which run at the
+ * same time on mongos send a single find to the shards, and all return the same results.
+ *
+ * @tags: [requires_fcv_49]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/fail_point_util.js");
+
+const st = new ShardingTest({
+    shards: 1,
+    mongos: 1,
+    other: {mongosOptions: {setParameter: {internalQueryCoalesceIdenticalFinds: true}}}
+});
+const db = st.s.getDB("test");
+const coll = db.coalesce_identical_finds;
+
+const bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 100; i++) {
+    bulk.insert({_id: i, x: i % 10});
+}
+assert.commandWorked(bulk.execute());
+
+const filter = {x: {$lt: 5}};
+const expected = coll.find(filter).sort({_id: 1}).toArray();
+assert.eq(50, expected.length);
+
+function coalescedFinds() {
+    return assert.commandWorked(db.serverStatus()).metrics.mongos.find.coalesced;
+}
+
+function countFinds(conn) {
+    return conn.getDB("admin")
+        .aggregate([
+            {$currentOp: {localOps: true}},
+            {$match: {"command.find": coll.getName(), "command.filter": filter}}
+        ])
+        .itcount();
+}
+
+const initialCoalescedFinds = coalescedFinds();
+
+// Hold the first find on the shard while the others arrive on mongos.
+const kNumFinds = 5;
+const fp = configureFailPoint(st.shard0, "waitInFindBeforeMakingBatch", {nss: coll.getFullName()});
+const finds = [];
+for (let i = 0; i < kNumFinds; i++) {
+    finds.push(startParallelShell(funWithArgs(function(filter, expected) {
+        const coll = db.getSiblingDB("test").coalesce_identical_finds;
+        assert.eq(expected, coll.find(filter).sort({_id: 1}).toArray());
+    }, filter, expected), st.s.port));
+}
+fp.wait();
+assert.soon(() => countFinds(st.s) === kNumFinds);
+assert.eq(1, countFinds(st.shard0));
+
+fp.off();
+for (let find of finds) {
+    find();
+}
+assert.gte(coalescedFinds() - initialCoalescedFinds, 1);
+
+// Finds which run one after the other do not share results, so they see the latest writes.
+assert.commandWorked(coll.insert({_id: 100, x: 0}));
+assert.eq(51, coll.find(filter).itcount());
+
+// Finds in transactions run on their own.
+const session = st.s.startSession();
+session.startTransaction();
+assert.eq(51, session.getDatabase("test").coalesce_identical_finds.find(filter).itcount());
+assert.commandWorked(session.commitTransaction_forTesting());
+session.endSession();
+
+st.stop();
+})();
@@ -0,0 +1,73 @@
+/**
+ * Tests that a shard leaves the SHARDING_FILTER stage out of a query plan when the bounds of its
+ * index scans on the shard key only cover chunks owned by the shard, and keeps filtering orphans
+ * otherwise.
+ *
+ * @tags: [requires_fcv_49]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");
+
+// Deliberately inserts orphans outside of migration.
+TestData.skipCheckOrphans = true;
+const st = new ShardingTest({shards: 2});
+const collName = "test.elide_shard_filter";
+const mongosDb = st.s.getDB("test");
+const mongosColl = st.s.getCollection(collName);
+
+assert.commandWorked(st.s.adminCommand({enableSharding: "test"}));
+st.ensurePrimaryShard("test", st.shard0.shardName);
+assert.commandWorked(st.s.adminCommand({shardCollection: collName, key: {a: 1}}));
+assert.commandWorked(st.s.adminCommand({split: collName, middle: {a: 0}}));
+assert.commandWorked(
+    st.s.adminCommand({moveChunk: collName, find: {a: 0}, to: st.shard1.shardName}));
+
+for (let i = -20; i < 20; i++) {
+    assert.commandWorked(mongosColl.insert({_id: i, a: i, b: i % 3}));
+}
+assert.commandWorked(mongosColl.createIndex({a: 1, b: 1}));
+
+// An orphan on shard1, within the chunk owned by shard0.
+assert.commandWorked(st.shard1.getCollection(collName).insert({_id: "orphan", a: -5, b: 0}));
+
+for (let shard of [st.shard0, st.shard1]) {
+    assert.commandWorked(shard.adminCommand(
+        {setParameter: 1, internalQueryElideShardFilterForOwnedIndexBounds: true}));
+}
+
+function assertQuery(filter, projection, expectShardFilter) {
+    const explain = mongosColl.find(filter, projection).hint({a: 1, b: 1}).explain();
+    assert.eq(expectShardFilter,
+              planHasStage(mongosDb, explain.queryPlanner.winningPlan, "SHARDING_FILTER"),
+              explain);
+
+    const expected = [];
+    for (let i = -20; i < 20; i++) {
+        const doc = {_id: i, a: i, b: i % 3};
+        if ((filter.a.$gte === undefined || i >= filter.a.$gte) && i < filter.a.$lt) {
+            expected.push(projection ? {a: doc.a, b: doc.b} : doc);
+        }
+    }
+    assert.sameMembers(expected, mongosColl.find(filter, projection).toArray());
+}
+
+// The bounds only cover chunks owned by the targeted shard.
+assertQuery({a: {$gte: 5, $lt: 10}}, null, false);
+assertQuery({a: {$gte: -10, $lt: -5}}, null, false);
+assertQuery({a: {$gte: 5, $lt: 10}}, {_id: 0, a: 1, b: 1}, false);
+
+// On shard1, the bounds also cover the chunk owned by shard0, which holds the orphan.
+assertQuery({a: {$gte: -10, $lt: 10}}, null, true);
+assertQuery({a: {$lt: 10}}, {_id: 0, a: 1, b: 1}, true);
+
+// The shard filter is kept when the optimization is disabled.
+for (let shard of [st.shard0, st.shard1]) {
+    assert.commandWorked(shard.adminCommand(
+        {setParameter: 1, internalQueryElideShardFilterForOwnedIndexBounds: false}));
+}
+assertQuery({a: {$gte: 5, $lt: 10}}, null, true);
+
+st.stop();
+})();
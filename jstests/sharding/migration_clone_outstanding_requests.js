@@ -0,0 +1,59 @@
+/**
+ * Tests that a migration whose recipient keeps several _migrateClone requests outstanding against
+ * the donor clones every document of the chunk exactly once, including documents written during
+ * the clone.
+ *
+ * @tags: [requires_sharding]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/chunk_manipulation_util.js");
+
+const st = new ShardingTest({
+    shards: 2,
+    other: {shardOptions: {setParameter: {migrateCloneMaxOutstandingRequests: 4}}}
+});
+
+const dbName = "test";
+const ns = dbName + ".migration_clone_outstanding_requests";
+const coll = st.s.getCollection(ns);
+
+assert.commandWorked(st.s.adminCommand({enableSharding: dbName}));
+st.ensurePrimaryShard(dbName, st.shard0.shardName);
+assert.commandWorked(st.s.adminCommand({shardCollection: ns, key: {_id: 1}}));
+
+// Enough data for the clone to take several batches, but less than the maximum chunk size.
+const numDocs = 3000;
+const padding = "x".repeat(8 * 1024);
+let bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < numDocs; i++) {
+    bulk.insert({_id: i, padding: padding});
+}
+assert.commandWorked(bulk.execute());
+
+const staticMongod = MongoRunner.runMongod({});
+
+pauseMoveChunkAtStep(st.shard0, moveChunkStepNames.startedMoveChunk);
+const joinMoveChunk = moveChunkParallel(
+    staticMongod, st.s.host, {_id: 0}, null, ns, st.shard1.shardName, true /* expectSuccess */);
+waitForMoveChunkStep(st.shard0, moveChunkStepNames.startedMoveChunk);
+
+// Writes made during the migration are sent to the recipient as modifications.
+assert.commandWorked(coll.insert({_id: numDocs, padding: padding}));
+assert.commandWorked(coll.update({_id: 1}, {$set: {updated: true}}));
+assert.commandWorked(coll.remove({_id: 2}));
+
+unpauseMoveChunkAtStep(st.shard0, moveChunkStepNames.startedMoveChunk);
+joinMoveChunk();
+
+const recipientColl = st.shard1.getCollection(ns);
+assert.eq(numDocs, recipientColl.find().itcount());
+assert.eq(numDocs, recipientColl.aggregate([{$group: {_id: "$_id"}}]).itcount());
+assert(recipientColl.findOne({_id: 1}).updated);
+assert.eq(null, recipientColl.findOne({_id: 2}));
+assert.eq(0, st.shard0.getCollection(ns).find().itcount());
+
+st.stop();
+MongoRunner.stopMongod(staticMongod);
+}());
@@ -0,0 +1,64 @@
+/**
+ * Tests that when internalQueryGroupMergeExchangeConsumers is set, the partial results of a $group
+ * are hash-partitioned by _id among several shards which merge them in parallel, and that this
+ * returns the same results as merging all of the groups on mongos.
+ *
+ * @tags: [requires_sharding]
+ */
+(function() {
+"use strict";
+
+const st = new ShardingTest({shards: 3, rs: {nodes: 1}});
+
+const mongosDB = st.s.getDB("test_db");
+const coll = mongosDB.group_merge_exchange;
+
+st.shardColl(coll, {a: "hashed"}, false, false, mongosDB.getName());
+
+const numDocs = 2000;
+let bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < numDocs; i++) {
+    bulk.insert({a: i, g: i % 397, v: i % 13});
+}
+assert.commandWorked(bulk.execute());
+
+const setConsumers = function(numConsumers) {
+    assert.commandWorked(st.s.adminCommand(
+        {setParameter: 1, internalQueryGroupMergeExchangeConsumers: numConsumers}));
+};
+
+const groupStage = {$group: {_id: "$g", total: {$sum: "$v"}, avg: {$avg: "$v"}, n: {$sum: 1}}};
+const unsortedPipeline = [groupStage, {$match: {total: {$gt: 10}}}, {$project: {n: 0}}];
+const sortedPipeline = [groupStage, {$sort: {total: -1, _id: 1}}, {$limit: 50}];
+
+setConsumers(0);
+const expectedUnsorted = coll.aggregate(unsortedPipeline).toArray();
+const expectedSorted = coll.aggregate(sortedPipeline).toArray();
+assert.eq(50, expectedSorted.length);
+
+let explain = coll.explain().aggregate(unsortedPipeline);
+assert(!explain.splitPipeline.hasOwnProperty("exchange"), tojson(explain));
+
+setConsumers(3);
+
+// The partial groups from every shard are partitioned by the hash of their _id among the shards.
+explain = coll.explain().aggregate(sortedPipeline);
+assert(explain.splitPipeline.hasOwnProperty("exchange"), tojson(explain));
+assert.eq({_id: "hashed"}, explain.splitPipeline.exchange.key, tojson(explain));
+assert.eq(3, explain.splitPipeline.exchange.consumers, tojson(explain));
+assert.eq(3, explain.splitPipeline.exchange.consumerShards.length, tojson(explain));
+
+assert.sameMembers(expectedUnsorted, coll.aggregate(unsortedPipeline).toArray());
+assert.eq(expectedSorted, coll.aggregate(sortedPipeline).toArray());
+
+// Small batches force the consumers to be drained over several getMores.
+assert.sameMembers(expectedUnsorted,
+                   coll.aggregate(unsortedPipeline, {cursor: {batchSize: 2}}).toArray());
+
+// Group keys which are equal under a collation may hash differently, so this is not partitioned.
+explain = coll.explain().aggregate(sortedPipeline, {collation: {locale: "en_US", strength: 2}});
+assert(!explain.splitPipeline.hasOwnProperty("exchange"), tojson(explain));
+
+setConsumers(0);
+st.stop();
+}());
@@ -0,0 +1,62 @@
+/**
+ * Tests that a mongos with routingTableChangePollIntervalMS set refreshes its cached routing table
+ * after a chunk migration or split done through another mongos, without having to be told that it
+ * is stale by a shard.
+ *
+ * @tags: [requires_sharding]
+ */
+(function() {
+"use strict";
+
+const st = new ShardingTest({
+    shards: 2,
+    mongos: [{}, {setParameter: {routingTableChangePollIntervalMS: 100}}],
+});
+
+const dbName = "test";
+const ns = dbName + ".routing_table_change_poller";
+
+assert.commandWorked(st.s0.adminCommand({enableSharding: dbName}));
+st.ensurePrimaryShard(dbName, st.shard0.shardName);
+assert.commandWorked(st.s0.adminCommand({shardCollection: ns, key: {x: 1}}));
+assert.commandWorked(st.s0.adminCommand({split: ns, middle: {x: 0}}));
+
+// Make the polling mongos cache the routing table.
+assert.commandWorked(st.s1.getCollection(ns).insert([{x: -1}, {x: 1}]));
+
+const getCollVersion = (mongos) => assert.commandWorked(mongos.adminCommand({getShardVersion: ns}));
+const getRefreshCount = () =>
+    assert.commandWorked(st.s1.adminCommand({serverStatus: 1}))
+        .shardingStatistics.catalogCache.countRoutingTableChangeRefreshes;
+
+const checkPollingMongosCatchesUp = function() {
+    assert.commandWorked(st.s0.adminCommand({flushRouterConfig: ns}));
+    const expected = getCollVersion(st.s0);
+    assert.soon(() => bsonWoCompare(getCollVersion(st.s1).version, expected.version) == 0,
+                () => tojson({expected: expected, actual: getCollVersion(st.s1)}));
+};
+
+const refreshCountBefore = getRefreshCount();
+
+assert.commandWorked(st.s0.adminCommand({moveChunk: ns, find: {x: 1}, to: st.shard1.shardName}));
+checkPollingMongosCatchesUp();
+
+assert.commandWorked(st.s0.adminCommand({split: ns, middle: {x: 10}}));
+checkPollingMongosCatchesUp();
+
+assert.gte(getRefreshCount(), refreshCountBefore + 2);
+
+// The refreshed routing table targets the writes correctly.
+assert.commandWorked(st.s1.getCollection(ns).insert([{x: -2}, {x: 2}, {x: 20}]));
+assert.eq(5, st.s1.getCollection(ns).find().itcount());
+
+// Polling can be turned off at runtime, in which case the mongos stays stale until a shard tells
+// it otherwise.
+assert.commandWorked(st.s1.adminCommand({setParameter: 1, routingTableChangePollIntervalMS: 0}));
+const staleVersion = getCollVersion(st.s1).version;
+assert.commandWorked(st.s0.adminCommand({moveChunk: ns, find: {x: 20}, to: st.shard0.shardName}));
+sleep(1000);
+assert.eq(0, bsonWoCompare(staleVersion, getCollVersion(st.s1).version));
+
+st.stop();
+}());
@@ -35,6 +35,7 @@
 
 #include "mongo/bson/bson_validate.h"
 #include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/bson/json.h"
 #include "mongo/logv2/log.h"
 
 namespace mongo {
@@ -112,8 +113,44 @@ void BM_validate(benchmark::State& state) {
     state.SetBytesProcessed(totalSize);
 }
 
+// Validates an object with many fields and no nesting, for which most of the time goes to finding
+// the ends of the field names.
+void BM_validateWideObject(benchmark::State& state) {
+    BSONObjBuilder builder;
+    for (auto j = 0; j < state.range(0); j++)
+        builder.append(fmt::format("someFieldName_{}", j), j);
+    BSONObj obj = builder.obj();
+    invariant(validateBSON(obj.objdata(), obj.objsize()).isOK());
+
+    size_t totalSize = 0;
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        benchmark::DoNotOptimize(validateBSON(obj.objdata(), obj.objsize()));
+        totalSize += obj.objsize();
+    }
+    state.SetBytesProcessed(totalSize);
+}
+
+void BM_fromjson(benchmark::State& state) {
+    BSONArrayBuilder builder;
+    for (auto j = 0; j < state.range(0); j++)
+        builder.append(buildSampleObj(j));
+    const std::string json =
+        tojson(BSON("a" << builder.arr()), JsonStringFormat::ExtendedRelaxedV2_0_0);
+
+    size_t totalSize = 0;
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        benchmark::DoNotOptimize(fromjson(json));
+        totalSize += json.size();
+    }
+    state.SetBytesProcessed(totalSize);
+}
+
 BENCHMARK(BM_arrayBuilder)->Ranges({{{1}, {100'000}}});
 BENCHMARK(BM_arrayLookup)->Ranges({{{1}, {100'000}}});
 BENCHMARK(BM_validate)->Ranges({{{1}, {1'000}}});
+BENCHMARK(BM_validateWideObject)->Ranges({{{1}, {10'000}}});
+BENCHMARK(BM_fromjson)->Ranges({{{1}, {1'000}}});
 
 }  // namespace mongo
@@ -0,0 +1,70 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <absl/container/flat_hash_map.h>
+
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonelement.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+
+/**
+ * An index from the names of the top-level fields of a BSONObj to their elements, for consumers
+ * which look up many different fields of the same wide object. Building the index takes one pass
+ * over the object, after which each lookup is a hash probe rather than a scan.
+ *
+ * The index points into the object's buffer, so the object must outlive it.
+ */
+class BSONObjFieldIndex {
+public:
+    explicit BSONObjFieldIndex(const BSONObj& obj);
+
+    /**
+     * Returns the same element as obj().getField(name): the first field named 'name', or EOO if
+     * there is none.
+     */
+    BSONElement getField(StringData name) const {
+        auto it = _elements.find(name);
+        return it == _elements.end() ? BSONElement() : it->second;
+    }
+
+    const BSONObj& obj() const {
+        return _obj;
+    }
+
+private:
+    BSONObj _obj;
+    absl::flat_hash_map<StringData, BSONElement, StringMapHasher, StringMapEq> _elements;
+};
+
+}  // namespace mongo
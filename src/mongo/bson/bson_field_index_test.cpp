@@ -0,0 +1,68 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/bson_field_index.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(BSONObjFieldIndexTest, FindsTheSameElementsAsGetField) {
+    BSONObjBuilder bob;
+    for (int i = 0; i < 300; ++i) {
+        bob.append("field" + std::to_string(i), i);
+    }
+    BSONObj obj = bob.obj();
+    BSONObjFieldIndex index(obj);
+
+    for (int i = 0; i < 300; ++i) {
+        const auto name = "field" + std::to_string(i);
+        ASSERT_EQ(obj.getField(name).rawdata(), index.getField(name).rawdata());
+    }
+    ASSERT(index.getField("missing").eoo());
+    ASSERT(index.getField("").eoo());
+}
+
+TEST(BSONObjFieldIndexTest, FindsTheFirstOfDuplicateFields) {
+    BSONObj obj = BSON("a" << 1 << "b" << 2 << "a" << 3);
+    BSONObjFieldIndex index(obj);
+    ASSERT_EQ(1, index.getField("a").numberInt());
+    ASSERT_EQ(2, index.getField("b").numberInt());
+}
+
+TEST(BSONObjFieldIndexTest, EmptyObject) {
+    BSONObjFieldIndex index(BSONObj{});
+    ASSERT(index.getField("a").eoo());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -147,12 +147,11 @@ private:
         }
 
         size_t strlen() const {
-            // This is actually by far the hottest code in all of BSON validation.
+            // This is actually by far the hottest code in all of BSON validation. The C library
+            // version scans a word or vector register at a time, without ever reading across a
+            // page boundary. It is safe because the buffer is known to end with a NUL.
             dassert(ptr < end);
-            size_t len = 0;
-            while (ptr[len])
-                ++len;
-            return len;
+            return std::strlen(ptr);
         }
 
         const char* ptr;
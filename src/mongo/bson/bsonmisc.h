@@ -31,6 +31,7 @@
 
 #include "mongo/bson/bsonelement.h"
 #include "mongo/bson/bsonobj.h"
+#include "mongo/platform/atomic_word.h"
 
 namespace mongo {
 
@@ -250,20 +251,21 @@ private:
 /**
    used in conjuction with BSONObjBuilder, allows for proper buffer size to prevent crazy memory
    usage
+
+   A tracker may be shared by the builders of several threads, for instance as a static at the
+   call site which builds objects of a similar size each time.
  */
 class BSONSizeTracker {
 public:
     BSONSizeTracker() {
-        _pos = 0;
         for (int i = 0; i < SIZE; i++)
-            _sizes[i] = 512;  // this is the default, so just be consistent
+            _sizes[i].store(512);  // this is the default, so just be consistent
     }
 
     ~BSONSizeTracker() {}
 
     void got(int size) {
-        _sizes[_pos] = size;
-        _pos = (_pos + 1) % SIZE;  // thread safe at least on certain compilers
+        _sizes[_pos.fetchAndAddRelaxed(1) % SIZE].store(size);
     }
 
     /**
@@ -272,16 +274,15 @@ public:
     int getSize() const {
         int x = 16;  // sane min
         for (int i = 0; i < SIZE; i++) {
-            if (_sizes[i] > x)
-                x = _sizes[i];
+            x = std::max(x, _sizes[i].loadRelaxed());
         }
         return x;
     }
 
 private:
     enum { SIZE = 10 };
-    int _pos;
-    int _sizes[SIZE];
+    AtomicWord<unsigned> _pos{0};
+    AtomicWord<int> _sizes[SIZE];
 };
 
 // considers order
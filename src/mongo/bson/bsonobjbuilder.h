@@ -134,6 +134,14 @@ public:
         return _offset;
     }
 
+    /**
+     * Grows the underlying buffer, if needed, to hold an object of 'objSize' bytes built by this
+     * builder without reallocating. Call with an estimate of the final size before appending.
+     */
+    void reserveCapacity(size_t objSize) {
+        _b.reserveCapacity(_offset + objSize);
+    }
+
     /** add all the fields from the object specified to this object */
     Derived& appendElements(const BSONObj& x);
 
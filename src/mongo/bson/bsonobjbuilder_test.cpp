@@ -579,5 +579,44 @@ TEST(BSONObjBuilderTest, UniqueArrayBuilderReleaseToBuffer) {
         auto tmp = UniqueBuffer::reclaim(rawData);
     }
 }
+
+TEST(BSONObjBuilderTest, ReserveCapacityAvoidsReallocation) {
+    const std::string value(100, 'x');
+    BSONObjBuilder bob;
+    bob.reserveCapacity(100 * 1024);
+    const char* buf = bob.bb().buf();
+    ASSERT_GTE(bob.bb().getSize(), 100 * 1024);
+
+    {
+        // A sub-builder reserves for its object after the bytes already in the buffer.
+        BSONObjBuilder sub(bob.subobjStart("sub"));
+        sub.reserveCapacity(50 * 1024);
+        for (int i = 0; i < 400; ++i) {
+            sub.append(std::to_string(i), value);
+        }
+    }
+    for (int i = 0; i < 400; ++i) {
+        bob.append(std::to_string(i), value);
+    }
+    ASSERT_LTE(bob.len(), 100 * 1024);
+    ASSERT_EQ(buf, bob.bb().buf());
+
+    // Reserving less than the buffer already holds has no effect.
+    bob.reserveCapacity(16);
+    ASSERT_EQ(buf, bob.bb().buf());
+    ASSERT_EQ(401, bob.obj().nFields());
+}
+
+TEST(BSONObjBuilderTest, SizeTrackerSizesLaterBuilders) {
+    BSONSizeTracker tracker;
+    {
+        BSONObjBuilder bob(tracker);
+        bob.append("x", std::string(2000, 'x'));
+        bob.done();
+    }
+    BSONObjBuilder bob(tracker);
+    ASSERT_GTE(bob.bb().getSize(), 2000);
+}
+
 }  // namespace
 }  // namespace mongo
@@ -110,7 +110,22 @@ Status JParse::parseError(StringData msg) {
 
 Status JParse::value(StringData fieldName, BSONObjBuilder& builder) {
     MONGO_JSON_DEBUG("fieldName: " << fieldName);
-    if (peekToken(LBRACE)) {
+    // Strings and plain numbers are the most common values, and none of the other tokens begin
+    // with a quote or a digit, so check for them first.
+    if (peekToken(DOUBLEQUOTE) || peekToken(SINGLEQUOTE)) {
+        std::string valueString;
+        valueString.reserve(STRINGVAL_RESERVE_SIZE);
+        Status ret = quotedString(&valueString);
+        if (ret != Status::OK()) {
+            return ret;
+        }
+        builder.append(fieldName, valueString);
+    } else if (peekDigit()) {
+        Status ret = number(fieldName, builder);
+        if (ret != Status::OK()) {
+            return ret;
+        }
+    } else if (peekToken(LBRACE)) {
         Status ret = object(fieldName, builder);
         if (ret != Status::OK()) {
             return ret;
@@ -165,14 +180,6 @@ Status JParse::value(StringData fieldName, BSONObjBuilder& builder) {
         if (ret != Status::OK()) {
             return ret;
         }
-    } else if (peekToken(DOUBLEQUOTE) || peekToken(SINGLEQUOTE)) {
-        std::string valueString;
-        valueString.reserve(STRINGVAL_RESERVE_SIZE);
-        Status ret = quotedString(&valueString);
-        if (ret != Status::OK()) {
-            return ret;
-        }
-        builder.append(fieldName, valueString);
     } else if (readToken("true")) {
         builder.append(fieldName, true);
     } else if (readToken("false")) {
@@ -1248,8 +1255,23 @@ Status JParse::chars(std::string* result, const char* terminalSet, const char* a
         return parseError("Unexpected end of input");
     }
     const char* q = _input;
+    // Quoted strings end at a single terminal character and allow anything else. For them, the
+    // characters up to the next terminal, escape or control character are copied in one go.
+    const bool singleTerminal =
+        allowedSet == nullptr && terminalSet[0] != '\0' && terminalSet[1] == '\0';
     while (q < _input_end && !match(*q, terminalSet)) {
         MONGO_JSON_DEBUG("q: " << q);
+        if (singleTerminal) {
+            const char* run = q;
+            while (q < _input_end && *q != *terminalSet && *q != '\\' &&
+                   !(0x00 <= *q && *q <= 0x1F)) {
+                ++q;
+            }
+            if (q != run) {
+                result->append(run, q - run);
+                continue;
+            }
+        }
         if (allowedSet != nullptr) {
             if (!match(*q, allowedSet)) {
                 _input = q;
@@ -1388,6 +1410,14 @@ bool JParse::readTokenImpl(const char* token, bool advance) {
     return true;
 }
 
+bool JParse::peekDigit() const {
+    const char* check = _input;
+    while (check < _input_end && ctype::isSpace(*check)) {
+        ++check;
+    }
+    return check < _input_end && ctype::isDigit(*check);
+}
+
 bool JParse::readField(StringData expectedField) {
     MONGO_JSON_DEBUG("expectedField: " << expectedField);
     std::string nextField;
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cfloat>
 #include <cinttypes>
 #include <cstdint>
@@ -423,6 +424,17 @@ public:
         reservedBytes += bytes;
     }
 
+    /**
+     * Grows the buffer, if it is smaller, to hold 'totalBytes' bytes in all plus any reserved
+     * bytes. A builder whose final size is known or can be estimated then fills up without being
+     * reallocated as it goes. The size is capped at the most that a builder may grow to.
+     */
+    void reserveCapacity(size_t totalBytes) {
+        size_t minSize = std::min(totalBytes + reservedBytes, static_cast<size_t>(BufferMaxSize));
+        if (minSize > _buf.capacity())
+            _buf.realloc(minSize);
+    }
+
     /**
      * Claim an earlier reservation of some number of bytes. These bytes must already have been
      * reserved. Appends of up to this many bytes immediately following a claim are
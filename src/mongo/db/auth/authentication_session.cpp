@@ -33,8 +33,13 @@
 
 #include "mongo/client/authenticate.h"
 #include "mongo/db/audit.h"
+#include "mongo/db/auth/authentication_session_gen.h"
 #include "mongo/db/client.h"
 #include "mongo/logv2/log.h"
+#include "mongo/transport/session.h"
+#include "mongo/util/concurrency/ticketholder.h"
+#include "mongo/util/scopeguard.h"
+#include "mongo/util/str.h"
 
 namespace mongo {
 namespace {
@@ -70,6 +75,26 @@ Status crossVerifyUserNames(const UserName& oldUser, const UserName& newUser) no
 const auto getAuthenticationSession =
     Client::declareDecoration<boost::optional<AuthenticationSession>>();
 
+/**
+ * The tickets of the concurrent authentication steps. Only used when
+ * maxConcurrentAuthenticationSteps is set, at which point they are resized to the limit.
+ */
+TicketHolder& getConcurrentStepTickets() {
+    static TicketHolder tickets(0);
+    return tickets;
+}
+
+/**
+ * The steps of internal cluster connections are admitted first, so that a storm of client
+ * connections does not hold back the cluster's own traffic.
+ */
+TicketPriority getStepPriority(Client* client) {
+    auto session = client->session();
+    return session && (session->getTags() & transport::Session::kInternalClient)
+        ? TicketPriority::kInternal
+        : TicketPriority::kInteractive;
+}
+
 class AuthenticationClientObserver final : public ServiceContext::ClientObserver {
 public:
     void onCreateClient(Client* client) override {}
@@ -97,6 +122,17 @@ AuthenticationSession::StepGuard::StepGuard(OperationContext* opCtx, StepType cu
     : _opCtx(opCtx), _currentStep(currentStep) {
     auto client = _opCtx->getClient();
 
+    if (_currentStep != StepType::kSaslSupportedMechanisms &&
+        gMaxConcurrentAuthenticationSteps.load() > 0) {
+        getConcurrentStepTickets().waitForTicket(_opCtx, getStepPriority(client));
+        _holdsTicket = true;
+    }
+    auto releaseTicketGuard = makeGuard([&] {
+        if (_holdsTicket) {
+            getConcurrentStepTickets().release();
+        }
+    });
+
     LOGV2_DEBUG(
         5286300, kDiagnosticLogLevel, "Starting authentication step", "step"_attr = _currentStep);
 
@@ -152,9 +188,15 @@ AuthenticationSession::StepGuard::StepGuard(OperationContext* opCtx, StepType cu
                     maybeSession->_mech);
         } break;
     }
+
+    releaseTicketGuard.dismiss();
 }
 
 AuthenticationSession::StepGuard::~StepGuard() {
+    if (_holdsTicket) {
+        getConcurrentStepTickets().release();
+    }
+
     auto& maybeSession = getAuthenticationSession(_opCtx->getClient());
     if (maybeSession) {
         LOGV2_DEBUG(5286301,
@@ -170,6 +212,32 @@ AuthenticationSession::StepGuard::~StepGuard() {
     }
 }
 
+Status AuthenticationSession::validateMaxConcurrentSteps(const int& maxConcurrentSteps) {
+    if (maxConcurrentSteps != 0 && maxConcurrentSteps < 5) {
+        return {ErrorCodes::BadValue,
+                str::stream() << "maxConcurrentAuthenticationSteps must be 0 or at least 5, got "
+                              << maxConcurrentSteps};
+    }
+    return Status::OK();
+}
+
+Status AuthenticationSession::onUpdateMaxConcurrentSteps(const int& maxConcurrentSteps) {
+    if (maxConcurrentSteps == 0) {
+        // The steps stop taking tickets, and the steps which hold one return it when they finish.
+        return Status::OK();
+    }
+    return getConcurrentStepTickets().resize(maxConcurrentSteps);
+}
+
+void AuthenticationSession::appendConcurrentStepStats(BSONObjBuilder* builder) {
+    BSONObjBuilder stepsBuilder(builder->subobjStart("concurrentSteps"));
+    stepsBuilder.append("limit", gMaxConcurrentAuthenticationSteps.load());
+    auto& tickets = getConcurrentStepTickets();
+    stepsBuilder.append("out", tickets.used());
+    stepsBuilder.append("available", tickets.available());
+    tickets.appendStats(&stepsBuilder);
+}
+
 AuthenticationSession* AuthenticationSession::get(Client* client) {
     auto& maybeSession = getAuthenticationSession(client);
     tassert(5286302, "Unable to retrieve authentication session", static_cast<bool>(maybeSession));
@@ -65,7 +65,9 @@ public:
     AuthenticationSession(Client* client) : _client(client) {}
 
     /**
-     * This guard creates and destroys the session as appropriate for the currentStep.
+     * This guard creates and destroys the session as appropriate for the currentStep. Unless the
+     * step is saslSupportedMechanisms, the guard also holds one of the tickets which bound the
+     * number of concurrent authentication steps, waiting for it if needed.
      */
     class StepGuard {
     public:
@@ -81,8 +83,26 @@ public:
         const StepType _currentStep;
 
         AuthenticationSession* _session = nullptr;
+        bool _holdsTicket = false;
     };
 
+    /**
+     * Accepts 0, meaning no limit on the concurrent authentication steps, or a limit of at least 5.
+     */
+    static Status validateMaxConcurrentSteps(const int& maxConcurrentSteps);
+
+    /**
+     * Resizes the tickets of the concurrent authentication steps when the
+     * maxConcurrentAuthenticationSteps server parameter changes.
+     */
+    static Status onUpdateMaxConcurrentSteps(const int& maxConcurrentSteps);
+
+    /**
+     * Appends the limit on the concurrent authentication steps and the statistics of the steps
+     * which waited for a ticket.
+     */
+    static void appendConcurrentStepStats(BSONObjBuilder* builder);
+
     /**
      * Gets the authentication session for the given "client".
      *
@@ -282,6 +282,33 @@ public:
         return false;
     }
 
+    /**
+     * Defers init() until initIfDeferred() is next called, which the CollectionCatalog does when
+     * this instance is looked up. If this instance is initialized, the state built by init() is
+     * discarded, leaving only what is needed to look up and lock the collection. Requires an
+     * exclusive collection lock, or that there are no concurrent readers.
+     */
+    virtual void deferInit(OperationContext* opCtx) {}
+
+    /**
+     * Runs the init() deferred by deferInit(), if any. Also records the time of the access for a
+     * collection whose init() was ever deferred. Safe to call concurrently, as an operation looking
+     * up the collection may not hold a collection lock.
+     */
+    virtual void initIfDeferred(OperationContext* opCtx) {}
+
+    virtual bool isInitDeferred() const {
+        return false;
+    }
+
+    /**
+     * Returns when initIfDeferred() was last called on an instance of this collection, or
+     * boost::none if the init() of this collection was never deferred.
+     */
+    virtual boost::optional<Date_t> getLastAccessTime() const {
+        return boost::none;
+    }
+
     virtual const NamespaceString& ns() const = 0;
 
     /**
@@ -423,6 +450,7 @@ public:
     /**
      * Not allowed to modify indexes.
      * Illegal to call if updateWithDamagesSupported() returns false.
+     * Throws, without writing, if the updated document does not pass validation.
      * Sets 'args.updatedDoc' to the updated version of the document with damages applied, on
      * success.
      * @return the contents of the updated record.
@@ -47,10 +47,29 @@ namespace mongo {
 namespace {
 struct LatestCollectionCatalog {
     std::shared_ptr<CollectionCatalog> catalog = std::make_shared<CollectionCatalog>();
+
+    // Incremented after every store to 'catalog', so readers can tell whether the instance they
+    // last loaded is still the latest one without going through atomic_load.
+    AtomicWord<uint64_t> version{0};
 };
 const ServiceContext::Decoration<LatestCollectionCatalog> getCatalog =
     ServiceContext::declareDecoration<LatestCollectionCatalog>();
 
+/**
+ * The latest catalog this thread has loaded, along with the version it was loaded at.
+ *
+ * atomic_load() on a shared_ptr serializes every reader on a lock shared by all threads. As the
+ * latest catalog only changes on DDL, readers instead check the version and take a new reference from
+ * their cached weak_ptr. A weak_ptr is cached so that idle threads do not keep old catalogs, and
+ * the Collections they own, alive.
+ */
+struct CachedCollectionCatalog {
+    const ServiceContext* svcCtx = nullptr;
+    uint64_t version = 0;
+    std::weak_ptr<CollectionCatalog> catalog;
+};
+thread_local CachedCollectionCatalog cachedCatalog;
+
 /**
  * Decoration on OperationContext to store cloned Collections until they are committed or rolled
  * back TODO SERVER-51236: This should be merged with UncommittedCollections
@@ -337,13 +356,15 @@ CollectionCatalog::iterator::value_type CollectionCatalog::iterator::operator*()
         return CollectionPtr();
     }
 
+    _mapIter->second->initIfDeferred(_opCtx);
     return {_opCtx, _mapIter->second.get(), LookupCollectionForYieldRestore()};
 }
 
 Collection* CollectionCatalog::iterator::getWritableCollection(OperationContext* opCtx,
                                                                LifetimeMode mode) {
+    invariant(!_exhausted());
     return CollectionCatalog::get(opCtx)->lookupCollectionByUUIDForMetadataWrite(
-        opCtx, mode, operator*()->uuid());
+        opCtx, mode, _mapIter->second->uuid());
 }
 
 boost::optional<CollectionUUID> CollectionCatalog::iterator::uuid() {
@@ -394,7 +415,20 @@ bool CollectionCatalog::iterator::_exhausted() {
 }
 
 std::shared_ptr<const CollectionCatalog> CollectionCatalog::get(ServiceContext* svcCtx) {
-    return atomic_load(&getCatalog(svcCtx).catalog);
+    auto& storage = getCatalog(svcCtx);
+    auto version = storage.version.load();
+    if (cachedCatalog.svcCtx == svcCtx && cachedCatalog.version == version) {
+        // The cached catalog can only have expired if a newer one was stored after we read the
+        // version, in which case we fall through and load that one.
+        if (auto catalog = cachedCatalog.catalog.lock()) {
+            return catalog;
+        }
+    }
+
+    // Read the version before loading so that a concurrent store only makes our cache stale.
+    auto catalog = atomic_load(&storage.catalog);
+    cachedCatalog = {svcCtx, version, catalog};
+    return catalog;
 }
 
 std::shared_ptr<const CollectionCatalog> CollectionCatalog::get(OperationContext* opCtx) {
@@ -507,6 +541,7 @@ void CollectionCatalog::write(ServiceContext* svcCtx, CatalogWriteFn job) {
         if (queue.empty()) {
             // Queue is empty, store catalog and relinquish responsibility of being worker thread
             atomic_store(&storage.catalog, std::move(clone));
+            storage.version.fetchAndAdd(1);
             workerExists = false;
             break;
         }
@@ -607,14 +642,20 @@ std::shared_ptr<const Collection> CollectionCatalog::lookupCollectionByUUIDForRe
     }
 
     auto coll = _lookupCollectionByUUID(uuid);
-    return (coll && coll->isCommitted()) ? coll : nullptr;
+    if (!coll || !coll->isCommitted()) {
+        return nullptr;
+    }
+
+    coll->initIfDeferred(opCtx);
+    return coll;
 }
 
 Collection* CollectionCatalog::lookupCollectionByUUIDForMetadataWrite(OperationContext* opCtx,
                                                                       LifetimeMode mode,
                                                                       CollectionUUID uuid) const {
     if (mode == LifetimeMode::kInplace) {
-        return const_cast<Collection*>(lookupCollectionByUUID(opCtx, uuid).get());
+        return const_cast<Collection*>(
+            _lookupCollectionByUUID(opCtx, uuid, false /* initIfDeferred */).get());
     }
 
     auto& uncommittedCatalogUpdates = getUncommittedCatalogUpdates(opCtx);
@@ -640,6 +681,7 @@ Collection* CollectionCatalog::lookupCollectionByUUIDForMetadataWrite(OperationC
         return coll.get();
 
     invariant(opCtx->lockState()->isCollectionLockedForMode(coll->ns(), MODE_X));
+    coll->initIfDeferred(opCtx);
     auto cloned = coll->clone();
     auto ptr = cloned.get();
     uncommittedCatalogUpdates.writable(std::move(cloned));
@@ -651,6 +693,12 @@ Collection* CollectionCatalog::lookupCollectionByUUIDForMetadataWrite(OperationC
 
 CollectionPtr CollectionCatalog::lookupCollectionByUUID(OperationContext* opCtx,
                                                         CollectionUUID uuid) const {
+    return _lookupCollectionByUUID(opCtx, uuid, true /* initIfDeferred */);
+}
+
+CollectionPtr CollectionCatalog::_lookupCollectionByUUID(OperationContext* opCtx,
+                                                         CollectionUUID uuid,
+                                                         bool initIfDeferred) const {
     auto& uncommittedCatalogUpdates = getUncommittedCatalogUpdates(opCtx);
     auto [found, uncommittedPtr] = uncommittedCatalogUpdates.lookup(uuid);
     // If UUID is managed by uncommittedCatalogUpdates return the pointer which will be nullptr in
@@ -665,9 +713,14 @@ CollectionPtr CollectionCatalog::lookupCollectionByUUID(OperationContext* opCtx,
     }
 
     auto coll = _lookupCollectionByUUID(uuid);
-    return (coll && coll->isCommitted())
-        ? CollectionPtr(opCtx, coll.get(), LookupCollectionForYieldRestore())
-        : CollectionPtr();
+    if (!coll || !coll->isCommitted()) {
+        return CollectionPtr();
+    }
+
+    if (initIfDeferred) {
+        coll->initIfDeferred(opCtx);
+    }
+    return CollectionPtr(opCtx, coll.get(), LookupCollectionForYieldRestore());
 }
 
 bool CollectionCatalog::isCollectionAwaitingVisibility(CollectionUUID uuid) const {
@@ -688,13 +741,19 @@ std::shared_ptr<const Collection> CollectionCatalog::lookupCollectionByNamespace
 
     auto it = _collections.find(nss);
     auto coll = (it == _collections.end() ? nullptr : it->second);
-    return (coll && coll->isCommitted()) ? coll : nullptr;
+    if (!coll || !coll->isCommitted()) {
+        return nullptr;
+    }
+
+    coll->initIfDeferred(opCtx);
+    return coll;
 }
 
 Collection* CollectionCatalog::lookupCollectionByNamespaceForMetadataWrite(
     OperationContext* opCtx, LifetimeMode mode, const NamespaceString& nss) const {
     if (mode == LifetimeMode::kInplace || nss.isOplog()) {
-        return const_cast<Collection*>(lookupCollectionByNamespace(opCtx, nss).get());
+        return const_cast<Collection*>(
+            _lookupCollectionByNamespace(opCtx, nss, mode != LifetimeMode::kInplace).get());
     }
 
     auto& uncommittedCatalogUpdates = getUncommittedCatalogUpdates(opCtx);
@@ -724,6 +783,7 @@ Collection* CollectionCatalog::lookupCollectionByNamespaceForMetadataWrite(
         return nullptr;
 
     invariant(opCtx->lockState()->isCollectionLockedForMode(nss, MODE_X));
+    coll->initIfDeferred(opCtx);
     auto cloned = coll->clone();
     auto ptr = cloned.get();
     uncommittedCatalogUpdates.writable(std::move(cloned));
@@ -735,6 +795,12 @@ Collection* CollectionCatalog::lookupCollectionByNamespaceForMetadataWrite(
 
 CollectionPtr CollectionCatalog::lookupCollectionByNamespace(OperationContext* opCtx,
                                                              const NamespaceString& nss) const {
+    return _lookupCollectionByNamespace(opCtx, nss, true /* initIfDeferred */);
+}
+
+CollectionPtr CollectionCatalog::_lookupCollectionByNamespace(OperationContext* opCtx,
+                                                              const NamespaceString& nss,
+                                                              bool initIfDeferred) const {
     auto& uncommittedCatalogUpdates = getUncommittedCatalogUpdates(opCtx);
     auto [found, uncommittedPtr] = uncommittedCatalogUpdates.lookup(nss);
     // If uncommittedPtr is valid, found is always true. Return the pointer as the collection still
@@ -756,9 +822,14 @@ CollectionPtr CollectionCatalog::lookupCollectionByNamespace(OperationContext* o
 
     auto it = _collections.find(nss);
     auto coll = (it == _collections.end() ? nullptr : it->second);
-    return (coll && coll->isCommitted())
-        ? CollectionPtr(opCtx, coll.get(), LookupCollectionForYieldRestore())
-        : nullptr;
+    if (!coll || !coll->isCommitted()) {
+        return nullptr;
+    }
+
+    if (initIfDeferred) {
+        coll->initIfDeferred(opCtx);
+    }
+    return CollectionPtr(opCtx, coll.get(), LookupCollectionForYieldRestore());
 }
 
 boost::optional<NamespaceString> CollectionCatalog::lookupNSSByUUID(OperationContext* opCtx,
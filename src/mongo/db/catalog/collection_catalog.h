@@ -65,7 +65,8 @@ public:
 
         // Inplace writable access to the Collection currently installed in the catalog. This is
         // only safe when the server is in a state where there can be no concurrent readers. Does
-        // not require an active write unit of work.
+        // not require an active write unit of work. Unlike other lookups, this does not run the
+        // deferred init() of the Collection.
         kInplace
     };
 
@@ -365,6 +366,17 @@ private:
 
     std::shared_ptr<Collection> _lookupCollectionByUUID(CollectionUUID uuid) const;
 
+    /**
+     * Implement lookupCollectionByUUID() and lookupCollectionByNamespace(), and only run the
+     * deferred init() of the Collection found in the catalog if 'initIfDeferred' is true.
+     */
+    CollectionPtr _lookupCollectionByUUID(OperationContext* opCtx,
+                                          CollectionUUID uuid,
+                                          bool initIfDeferred) const;
+    CollectionPtr _lookupCollectionByNamespace(OperationContext* opCtx,
+                                               const NamespaceString& nss,
+                                               bool initIfDeferred) const;
+
     /**
      * When present, indicates that the catalog is in closed state, and contains a map from UUID
      * to pre-close NSS. See also onCloseCatalog.
@@ -506,6 +506,24 @@ TEST_F(CollectionCatalogTest, CollectionCatalogEpoch) {
     ASSERT_EQ(originalEpoch + 1, incrementedEpoch);
 }
 
+TEST_F(CollectionCatalogTest, GetReturnsLatestCatalogAfterWrite) {
+    auto svcCtx = getServiceContext();
+    auto before = CollectionCatalog::get(svcCtx);
+    ASSERT_EQ(before, CollectionCatalog::get(svcCtx));
+
+    NamespaceString newNss(nss.db(), "newcol");
+    auto newUUID = CollectionUUID::gen();
+    CollectionCatalog::write(svcCtx, [&](CollectionCatalog& writable) {
+        writable.registerCollection(&opCtx, newUUID, std::make_shared<CollectionMock>(newNss));
+    });
+
+    auto after = CollectionCatalog::get(svcCtx);
+    ASSERT_NE(before, after);
+    ASSERT_EQ(after, CollectionCatalog::get(svcCtx));
+    ASSERT_EQ(*after->lookupNSSByUUID(&opCtx, newUUID), newNss);
+    ASSERT_EQ(before->lookupNSSByUUID(&opCtx, newUUID), boost::none);
+}
+
 DEATH_TEST_F(CollectionCatalogResourceTest, AddInvalidResourceType, "invariant") {
     auto rid = ResourceId(RESOURCE_GLOBAL, 0);
     catalog.addResource(rid, "");
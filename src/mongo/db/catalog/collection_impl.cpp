@@ -45,9 +45,11 @@
 #include "mongo/db/catalog/index_catalog_impl.h"
 #include "mongo/db/catalog/index_consistency.h"
 #include "mongo/db/catalog/index_key_validate.h"
+#include "mongo/db/client.h"
 #include "mongo/db/clientcursor.h"
 #include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/concurrency/d_concurrency.h"
+#include "mongo/db/concurrency/hot_document_tracker.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/index/index_access_method.h"
@@ -61,8 +63,10 @@
 #include "mongo/db/ops/update_request.h"
 #include "mongo/db/query/collation/collator_factory_interface.h"
 #include "mongo/db/query/collation/collator_interface.h"
+#include "mongo/db/query/collection_index_usage_tracker_decoration.h"
 #include "mongo/db/query/collection_query_info.h"
 #include "mongo/db/query/internal_plans.h"
+#include "mongo/db/record_id_helpers.h"
 #include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/server_options.h"
@@ -299,7 +303,9 @@ SharedCollectionDecorations* CollectionImpl::getSharedDecorations() const {
 void CollectionImpl::init(OperationContext* opCtx) {
     auto collectionOptions =
         DurableCatalog::get(opCtx)->getCollectionOptions(opCtx, getCatalogId());
-    _shared->_collator = parseCollation(opCtx, _ns, collectionOptions.collation);
+    if (!_initDiscarded) {
+        _shared->_collator = parseCollation(opCtx, _ns, collectionOptions.collation);
+    }
     auto validatorDoc = collectionOptions.validator.getOwned();
 
     // Enforce that the validator can be used on this namespace.
@@ -334,11 +340,92 @@ void CollectionImpl::init(OperationContext* opCtx) {
     }
 
     getIndexCatalog()->init(opCtx).transitional_ignore();
-    _initialized = true;
+    if (_discardedIndexMinVisibleSnapshot) {
+        const bool includeUnfinishedIndexes = true;
+        auto it = getIndexCatalog()->getIndexIterator(opCtx, includeUnfinishedIndexes);
+        while (it->more()) {
+            auto entry = const_cast<IndexCatalogEntry*>(it->next());
+            if (!entry->descriptor()->isIdIndex()) {
+                entry->setMinimumVisibleSnapshot(*_discardedIndexMinVisibleSnapshot);
+            }
+        }
+    }
+    _initState.store(InitState::kInitialized);
 }
 
 bool CollectionImpl::isInitialized() const {
-    return _initialized;
+    return _initState.load() == InitState::kInitialized;
+}
+
+void CollectionImpl::deferInit(OperationContext* opCtx) {
+    if (_initState.load() == InitState::kInitialized) {
+        auto& indexUsageTracker =
+            CollectionIndexUsageTrackerDecoration::get(getSharedDecorations());
+        const bool includeUnfinishedIndexes = true;
+        auto it = _indexCatalog->getIndexIterator(opCtx, includeUnfinishedIndexes);
+        while (it->more()) {
+            auto entry = it->next();
+            indexUsageTracker.unregisterIndex(entry->descriptor()->indexName());
+            auto minVisible = entry->getMinimumVisibleSnapshot();
+            if (minVisible && (!_discardedIndexMinVisibleSnapshot ||
+                               *minVisible > *_discardedIndexMinVisibleSnapshot)) {
+                _discardedIndexMinVisibleSnapshot = minVisible;
+            }
+        }
+
+        _indexCatalog = std::make_unique<IndexCatalogImpl>(this);
+        CollectionQueryInfo::get(this) = CollectionQueryInfo();
+        _initDiscarded = true;
+    }
+
+    auto now = opCtx->getServiceContext()->getFastClockSource()->now();
+    _shared->_lastAccessMillis.store(now.toMillisSinceEpoch());
+    _initState.store(InitState::kDeferred);
+}
+
+void CollectionImpl::initIfDeferred(OperationContext* opCtx) {
+    auto lastAccessMillis = _shared->_lastAccessMillis.load();
+    if (!lastAccessMillis) {
+        return;
+    }
+
+    // The access time is only used to find idle collections, so it is not updated more than once a
+    // second.
+    auto now = opCtx->getServiceContext()->getFastClockSource()->now().toMillisSinceEpoch();
+    if (now - lastAccessMillis >= 1000) {
+        _shared->_lastAccessMillis.store(now);
+    }
+
+    if (_initState.load() != InitState::kDeferred) {
+        return;
+    }
+
+    stdx::lock_guard<Latch> lk(_shared->_deferredInitMutex);
+    if (_initState.load() != InitState::kDeferred) {
+        return;
+    }
+
+    // Initialize from a separate operation, so the catalog is read at the latest data rather than
+    // at the snapshot of the operation looking up the collection, which may be in a write unit of
+    // work or reading at an older timestamp.
+    auto client = opCtx->getServiceContext()->makeClient("DeferredCollectionInit");
+    AlternativeClientRegion acr(client);
+    auto initOpCtx = cc().makeOperationContext();
+    init(initOpCtx.get());
+
+    LOGV2_DEBUG(5591704, 1, "Ran the deferred initialization of a collection", logAttrs(*this));
+}
+
+bool CollectionImpl::isInitDeferred() const {
+    return _initState.load() == InitState::kDeferred;
+}
+
+boost::optional<Date_t> CollectionImpl::getLastAccessTime() const {
+    auto lastAccessMillis = _shared->_lastAccessMillis.load();
+    if (!lastAccessMillis) {
+        return boost::none;
+    }
+    return Date_t::fromMillisSinceEpoch(lastAccessMillis);
 }
 
 bool CollectionImpl::isCommitted() const {
@@ -652,14 +739,8 @@ Status CollectionImpl::insertDocumentForBulkLoader(
 
     RecordId recordId;
     if (isClustered()) {
-        // Collections clustered by _id require ObjectId values.
-        BSONElement oidElem;
-        bool foundId = doc.getObjectID(oidElem);
-        uassert(ErrorCodes::BadValue,
-                str::stream() << "Document " << redact(doc) << " is missing the '_id' field",
-                foundId);
         invariant(_shared->_recordStore->keyFormat() == KeyFormat::String);
-        recordId = RecordId(oidElem.OID().view().view(), OID::kOIDSize);
+        recordId = uassertStatusOK(record_id_helpers::keyForDoc(doc));
     }
 
     // Using timestamp 0 for these inserts, which are non-oplog so we don't have an appropriate
@@ -733,15 +814,8 @@ Status CollectionImpl::_insertDocuments(OperationContext* opCtx,
 
         RecordId recordId;
         if (isClustered()) {
-            // Collections clustered by _id require ObjectId values.
-            BSONElement oidElem;
-            bool foundId = doc.getObjectID(oidElem);
-            uassert(ErrorCodes::BadValue,
-                    str::stream() << "Document " << redact(doc) << " is missing the '_id' field",
-                    foundId);
-
             invariant(_shared->_recordStore->keyFormat() == KeyFormat::String);
-            recordId = RecordId(oidElem.OID().view().view(), OID::kOIDSize);
+            recordId = uassertStatusOK(record_id_helpers::keyForDoc(doc));
         }
 
         if (MONGO_unlikely(corruptDocumentOnInsert.shouldFail())) {
@@ -853,10 +927,14 @@ void CollectionImpl::deleteDocument(OperationContext* opCtx,
         deletedDoc.emplace(doc.value().getOwned());
     }
 
+    HotDocumentTracker::noteWriteTarget(opCtx, _uuid, loc);
+
     int64_t keysDeleted;
     _indexCatalog->unindexRecord(opCtx, doc.value(), loc, noWarn, &keysDeleted);
     _shared->_recordStore->deleteRecord(opCtx, loc);
 
+    HotDocumentTracker::clearWriteTarget(opCtx);
+
     getGlobalServiceContext()->getOpObserver()->onDelete(
         opCtx, ns(), uuid(), stmtId, fromMigrate, deletedDoc);
 
@@ -875,21 +953,7 @@ RecordId CollectionImpl::updateDocument(OperationContext* opCtx,
                                         bool indexesAffected,
                                         OpDebug* opDebug,
                                         CollectionUpdateArgs* args) const {
-    {
-        auto status = checkValidation(opCtx, newDoc);
-        if (!status.isOK()) {
-            if (validationLevelOrDefault(_validationLevel) == ValidationLevelEnum::strict) {
-                uassertStatusOK(status);
-            }
-            // moderate means we have to check the old doc
-            auto oldDocStatus = checkValidation(opCtx, oldDoc.value());
-            if (oldDocStatus.isOK()) {
-                // transitioning from good -> bad is not ok
-                uassertStatusOK(status);
-            }
-            // bad -> bad is ok in moderate mode
-        }
-    }
+    _checkValidationForUpdate(opCtx, oldDoc.value(), newDoc);
 
     dassert(opCtx->lockState()->isCollectionLockedForMode(ns(), MODE_IX));
     invariant(oldDoc.snapshotId() == opCtx->recoveryUnit()->getSnapshotId());
@@ -930,6 +994,7 @@ RecordId CollectionImpl::updateDocument(OperationContext* opCtx,
     }
     args->preImageRecordingEnabledForCollection = getRecordPreImages();
 
+    HotDocumentTracker::noteWriteTarget(opCtx, _uuid, oldLocation);
     uassertStatusOK(_shared->_recordStore->updateRecord(
         opCtx, oldLocation, newDoc.objdata(), newDoc.objsize()));
 
@@ -950,6 +1015,8 @@ RecordId CollectionImpl::updateDocument(OperationContext* opCtx,
         }
     }
 
+    HotDocumentTracker::clearWriteTarget(opCtx);
+
     invariant(sid == opCtx->recoveryUnit()->getSnapshotId());
     args->updatedDoc = newDoc;
 
@@ -959,8 +1026,26 @@ RecordId CollectionImpl::updateDocument(OperationContext* opCtx,
     return {oldLocation};
 }
 
+void CollectionImpl::_checkValidationForUpdate(OperationContext* opCtx,
+                                               const BSONObj& oldDoc,
+                                               const BSONObj& newDoc) const {
+    auto status = checkValidation(opCtx, newDoc);
+    if (!status.isOK()) {
+        if (validationLevelOrDefault(_validationLevel) == ValidationLevelEnum::strict) {
+            uassertStatusOK(status);
+        }
+        // moderate means we have to check the old doc
+        auto oldDocStatus = checkValidation(opCtx, oldDoc);
+        if (oldDocStatus.isOK()) {
+            // transitioning from good -> bad is not ok
+            uassertStatusOK(status);
+        }
+        // bad -> bad is ok in moderate mode
+    }
+}
+
 bool CollectionImpl::updateWithDamagesSupported() const {
-    if (!_validator.isOK() || _validator.filter.getValue() != nullptr)
+    if (!_validator.isOK())
         return false;
 
     return _shared->_recordStore->updateWithDamagesSupported();
@@ -984,8 +1069,25 @@ StatusWith<RecordData> CollectionImpl::updateDocumentWithDamages(
         args->preImageDoc = oldRec.value().toBson().getOwned();
     }
 
+    if (_validator.filter.getValue()) {
+        // Damages only overwrite values with others of the same size, so applying them to a copy
+        // of the old record gives the new document to validate before anything is written.
+        const auto oldSize = oldRec.value().size();
+        auto newDocBuffer = SharedBuffer::allocate(oldSize);
+        std::memcpy(newDocBuffer.get(), oldRec.value().data(), oldSize);
+        for (auto&& damage : damages) {
+            invariant(damage.targetOffset + damage.size <= static_cast<size_t>(oldSize));
+            std::memcpy(newDocBuffer.get() + damage.targetOffset,
+                        damageSource + damage.sourceOffset,
+                        damage.size);
+        }
+        _checkValidationForUpdate(opCtx, oldRec.value().toBson(), BSONObj(newDocBuffer));
+    }
+
+    HotDocumentTracker::noteWriteTarget(opCtx, _uuid, loc);
     auto newRecStatus =
         _shared->_recordStore->updateWithDamages(opCtx, loc, oldRec.value(), damageSource, damages);
+    HotDocumentTracker::clearWriteTarget(opCtx);
 
     if (newRecStatus.isOK()) {
         args->updatedDoc = newRecStatus.getValue().toBson();
@@ -34,6 +34,7 @@
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/commands/create_gen.h"
 #include "mongo/db/concurrency/d_concurrency.h"
+#include "mongo/platform/mutex.h"
 
 namespace mongo {
 class IndexConsistency;
@@ -63,6 +64,10 @@ public:
 
     void init(OperationContext* opCtx) final;
     bool isInitialized() const final;
+    void deferInit(OperationContext* opCtx) final;
+    void initIfDeferred(OperationContext* opCtx) final;
+    bool isInitDeferred() const final;
+    boost::optional<Date_t> getLastAccessTime() const final;
     bool isCommitted() const final;
     void setCommitted(bool val) final;
 
@@ -222,6 +227,7 @@ public:
     /**
      * Not allowed to modify indexes.
      * Illegal to call if updateWithDamagesSupported() returns false.
+     * Throws, without writing, if the updated document does not pass validation.
      * Sets 'args.updatedDoc' to the updated version of the document with damages applied, on
      * success.
      * @return the contents of the updated record.
@@ -387,6 +393,14 @@ private:
      */
     Status checkValidation(OperationContext* opCtx, const BSONObj& document) const;
 
+    /**
+     * Throws if updating 'oldDoc' to 'newDoc' is not permitted by this collection's validator and
+     * validation level.
+     */
+    void _checkValidationForUpdate(OperationContext* opCtx,
+                                   const BSONObj& oldDoc,
+                                   const BSONObj& newDoc) const;
+
     /**
      * same semantics as insertDocument, but doesn't do:
      *  - some user error checks
@@ -455,6 +469,42 @@ private:
         const bool _needCappedLock;
 
         AtomicWord<bool> _committed{true};
+
+        // Serializes running the deferred init() of the instances of this collection.
+        Mutex _deferredInitMutex =
+            MONGO_MAKE_LATCH("CollectionImpl::SharedState::_deferredInitMutex");
+
+        // When an instance of this collection was last looked up, in milliseconds since the epoch.
+        // Only tracked once the init() of this collection has been deferred, zero until then.
+        AtomicWord<long long> _lastAccessMillis{0};
+    };
+
+    /**
+     * The initialization state of a CollectionImpl instance. It is copied when the instance is
+     * cloned, and atomic as the deferred init() of an instance is run by the first operation that
+     * looks it up, which may not hold a collection lock.
+     */
+    class InitState {
+    public:
+        enum Value { kUninitialized, kDeferred, kInitialized };
+
+        InitState() = default;
+        InitState(const InitState& other) : _value(other._value.load()) {}
+        InitState& operator=(const InitState& other) {
+            _value.store(other._value.load());
+            return *this;
+        }
+
+        Value load() const {
+            return static_cast<Value>(_value.load());
+        }
+
+        void store(Value value) {
+            _value.store(value);
+        }
+
+    private:
+        AtomicWord<int> _value{kUninitialized};
     };
 
     NamespaceString _ns;
@@ -479,6 +529,14 @@ private:
     // The earliest snapshot that is allowed to use this collection.
     boost::optional<Timestamp> _minVisibleSnapshot;
 
-    bool _initialized = false;
+    InitState _initState;
+
+    // Set when the state built by init() was discarded by deferInit(). The default collator is
+    // then kept, as it is shared with the instances which may still be in use.
+    bool _initDiscarded = false;
+
+    // The latest minimum visible snapshot of the indexes of this collection when the state built by
+    // init() was discarded, which the indexes are given again when initialized.
+    boost::optional<Timestamp> _discardedIndexMinVisibleSnapshot;
 };
 }  // namespace mongo
@@ -0,0 +1,203 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kStorage
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/catalog/collection_lazy_init.h"
+
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/collection_catalog.h"
+#include "mongo/db/catalog_raii.h"
+#include "mongo/db/client.h"
+#include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/storage/durable_catalog.h"
+#include "mongo/db/storage/storage_options.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
+#include "mongo/logv2/log.h"
+#include "mongo/util/periodic_runner.h"
+
+namespace mongo {
+namespace {
+
+struct IdleCollectionDehydrator {
+    PeriodicJobAnchor job;
+
+    // Only accessed by the job.
+    Date_t nextPass;
+};
+
+const auto getIdleCollectionDehydrator =
+    ServiceContext::declareDecoration<IdleCollectionDehydrator>();
+
+/**
+ * Returns whether the index catalog of 'collection' can be discarded. Index builds in progress and
+ * TTL indexes are registered with other components, which are not notified when it is.
+ */
+bool canDeferInit(OperationContext* opCtx, const CollectionPtr& collection) {
+    auto indexCatalog = collection->getIndexCatalog();
+    if (indexCatalog->numIndexesInProgress(opCtx) > 0) {
+        return false;
+    }
+
+    auto it = indexCatalog->getIndexIterator(opCtx, false /* includeUnfinishedIndexes */);
+    while (it->more()) {
+        if (it->next()->descriptor()->infoObj().hasField(
+                IndexDescriptor::kExpireAfterSecondsFieldName)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void dehydrateIdleCollections(OperationContext* opCtx, Milliseconds idleTimeout) {
+    auto now = opCtx->getServiceContext()->getFastClockSource()->now();
+
+    // Find the candidates without locks, then lock each one in turn to discard its index catalog.
+    std::vector<NamespaceStringOrUUID> idleCollections;
+    auto catalog = CollectionCatalog::get(opCtx);
+    for (const auto& dbName : catalog->getAllDbNames()) {
+        for (const auto& uuid : catalog->getAllCollectionUUIDsFromDb(dbName)) {
+            auto isIdle = [&](const CollectionPtr& collection) {
+                auto lastAccess = collection->getLastAccessTime();
+                return collection->isInitialized() && lastAccess &&
+                    now - *lastAccess >= idleTimeout;
+            };
+            if (catalog->checkIfCollectionSatisfiable(uuid, isIdle)) {
+                idleCollections.emplace_back(dbName, uuid);
+            }
+        }
+    }
+
+    size_t numCollections = 0;
+    for (const auto& nsOrUUID : idleCollections) {
+        try {
+            AutoGetCollection collection(opCtx, nsOrUUID, MODE_X);
+            if (!collection || !canDeferInit(opCtx, collection.getCollection())) {
+                continue;
+            }
+
+            WriteUnitOfWork wuow(opCtx);
+            collection.getWritableCollection()->deferInit(opCtx);
+            wuow.commit();
+            ++numCollections;
+        } catch (const ExceptionFor<ErrorCodes::LockTimeout>&) {
+            // The collection is in use, so it is not idle anymore.
+        } catch (const ExceptionFor<ErrorCodes::NamespaceNotFound>&) {
+            // The collection was dropped.
+        } catch (const WriteConflictException&) {
+            // The collection will be considered again on the next pass.
+        }
+    }
+
+    if (numCollections > 0) {
+        LOGV2(5591705,
+              "Discarded the index catalog of idle collections",
+              "numCollections"_attr = numCollections,
+              "idleTimeoutMillis"_attr = idleTimeout);
+    }
+}
+
+}  // namespace
+
+bool shouldDeferCollectionInit(OperationContext* opCtx, const Collection* collection) {
+    if (!gLazyCollectionInitialization || storageGlobalParams.repair) {
+        return false;
+    }
+
+    // The collections of the internal databases and the system collections are used by the server
+    // itself, and would be initialized soon after startup anyway.
+    const auto& nss = collection->ns();
+    if (nss.isOnInternalDb() || nss.isSystem()) {
+        return false;
+    }
+
+    auto md = DurableCatalog::get(opCtx)->getMetaData(opCtx, collection->getCatalogId());
+    for (const auto& index : md.indexes) {
+        // Unfinished index builds are resumed or restarted, and TTL indexes are registered with the
+        // TTL monitor, when the collection is initialized.
+        if (!index.ready || index.spec.hasField(IndexDescriptor::kExpireAfterSecondsFieldName)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void startIdleCollectionDehydrator(ServiceContext* serviceContext) {
+    if (!gLazyCollectionInitialization) {
+        return;
+    }
+
+    PeriodicRunner::PeriodicJob job(
+        "idleCollectionDehydrator",
+        [](Client* client) {
+            auto idleTimeoutSecs = gLazyCollectionIdleTimeoutSecs.load();
+            if (idleTimeoutSecs <= 0) {
+                return;
+            }
+
+            // Look for idle collections about twice per timeout, and at least once a minute.
+            auto& dehydrator = getIdleCollectionDehydrator(client->getServiceContext());
+            auto now = client->getServiceContext()->getFastClockSource()->now();
+            if (now < dehydrator.nextPass) {
+                return;
+            }
+            Milliseconds idleTimeout = Seconds(idleTimeoutSecs);
+            dehydrator.nextPass = now + std::min(Milliseconds(Seconds(60)), idleTimeout / 2);
+
+            auto opCtx = client->makeOperationContext();
+
+            // Do not wait for the locks of a collection, as one in use is not idle.
+            opCtx->lockState()->setMaxLockTimeout(Milliseconds(0));
+
+            try {
+                dehydrateIdleCollections(opCtx.get(), idleTimeout);
+            } catch (ExceptionForCat<ErrorCategory::CancelationError>& ex) {
+                LOGV2_DEBUG(5591706, 2, "Periodic job canceled", "reason"_attr = ex.reason());
+            }
+        },
+        Seconds(1));
+
+    auto& dehydrator = getIdleCollectionDehydrator(serviceContext);
+    dehydrator.job = serviceContext->getPeriodicRunner()->makeJob(std::move(job));
+    dehydrator.job.start();
+}
+
+void stopIdleCollectionDehydrator(ServiceContext* serviceContext) {
+    auto& dehydrator = getIdleCollectionDehydrator(serviceContext);
+    if (dehydrator.job.isValid()) {
+        dehydrator.job.stop();
+    }
+}
+
+}  // namespace mongo
@@ -39,12 +39,19 @@
 #include "mongo/db/catalog/database_holder.h"
 #include "mongo/db/catalog/index_consistency.h"
 #include "mongo/db/catalog/validate_adaptor.h"
+#include "mongo/db/catalog/validate_gen.h"
+#include "mongo/db/client.h"
+#include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/index/index_access_method.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/storage/durable_catalog.h"
 #include "mongo/db/views/view_catalog.h"
 #include "mongo/logv2/log.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/stdx/unordered_map.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/scopeguard.h"
 
@@ -62,6 +69,10 @@ namespace {
 // Indicates whether the failpoint turned on by testing has been reached.
 AtomicWord<bool> _validationIsPausedForTest{false};
 
+// How long a thread which traverses indexes in parallel waits for the global lock, before it leaves
+// its indexes to the thread of the validation.
+const Milliseconds kIndexTraversalLockTimeout{100};
+
 /**
  * Validates the internal structure of each index in the Index Catalog 'indexCatalog', ensuring that
  * the index files have not been corrupted or compromised.
@@ -105,6 +116,176 @@ void _validateIndexesInternalStructure(OperationContext* opCtx,
     }
 }
 
+/**
+ * Traverses the index entries of the indexes in parallel, on up to
+ * 'maxValidateIndexTraversalThreads' threads, for the first phase of index validation. Each thread
+ * has its own operation context and index cursors, which read the same data as the cursors of the
+ * validation: either the collection is exclusively locked, or they read at the timestamp of the
+ * background validation.
+ *
+ * Returns the number of index entries traversed for each index which was traversed. The other
+ * indexes are left to the thread of the validation, e.g. when a thread could not get the global
+ * lock in time or when parallel traversal is not possible.
+ */
+stdx::unordered_map<std::string, int64_t> _traverseIndexesInParallel(
+    OperationContext* opCtx,
+    ValidateState* validateState,
+    ValidateAdaptor* indexValidator,
+    ValidateResults* results) {
+    stdx::unordered_map<std::string, int64_t> numTraversedKeys;
+
+    const auto& indexes = validateState->getIndexes();
+    const size_t numThreads =
+        std::min(static_cast<size_t>(gMaxValidateIndexTraversalThreads.load()), indexes.size());
+    if (numThreads <= 1 || validateState->fixErrors() ||
+        (validateState->isBackground() && !validateState->getValidateTimestamp())) {
+        return numTraversedKeys;
+    }
+
+    struct IndexTraversal {
+        bool done = false;
+        int64_t numKeys = 0;
+        ValidateResults results;
+    };
+    std::vector<IndexTraversal> traversals(indexes.size());
+    AtomicWord<size_t> nextIndex{0};
+
+    // Tracks the threads, so that an interruption of the validation can interrupt them as well.
+    auto mutex = MONGO_MAKE_LATCH("CollectionValidation::traverseIndexesInParallel");
+    stdx::condition_variable threadsDone;
+    size_t numRunningThreads = numThreads;
+    std::vector<OperationContext*> threadOpCtxs;
+    Status threadStatus = Status::OK();
+
+    const auto readTimestamp = validateState->getValidateTimestamp();
+    auto serviceContext = opCtx->getServiceContext();
+    auto traverseIndexes = [&] {
+        ThreadClient tc("ValidateIndexTraversal", serviceContext);
+        auto threadOpCtx = cc().makeOperationContext();
+        {
+            stdx::lock_guard<Latch> lk(mutex);
+            threadOpCtxs.push_back(threadOpCtx.get());
+        }
+
+        Status status = Status::OK();
+        try {
+            // Only the global lock is needed, as the validation holds its collection lock until
+            // all the threads are done.
+            ShouldNotConflictWithSecondaryBatchApplicationBlock noPBWM(threadOpCtx->lockState());
+            boost::optional<Lock::GlobalLock> globalLock;
+            try {
+                globalLock.emplace(threadOpCtx.get(),
+                                   MODE_IS,
+                                   Date_t::now() + kIndexTraversalLockTimeout,
+                                   Lock::InterruptBehavior::kThrow,
+                                   true /* skipRSTLLock */);
+            } catch (const ExceptionFor<ErrorCodes::LockTimeout>&) {
+                // Leave the indexes to the other threads, or to the thread of the validation.
+            }
+
+            if (globalLock) {
+                if (readTimestamp) {
+                    threadOpCtx->recoveryUnit()->setTimestampReadSource(
+                        RecoveryUnit::ReadSource::kProvided, readTimestamp);
+                } else {
+                    threadOpCtx->recoveryUnit()->setPrepareConflictBehavior(
+                        PrepareConflictBehavior::kIgnoreConflicts);
+                }
+
+                for (size_t i = nextIndex.fetchAndAdd(1); i < indexes.size();
+                     i = nextIndex.fetchAndAdd(1)) {
+                    const IndexCatalogEntry* index = indexes[i].get();
+                    SortedDataInterfaceThrottleCursor indexCursor(
+                        threadOpCtx.get(), index->accessMethod(), validateState->getDataThrottle());
+
+                    auto& traversal = traversals[i];
+                    traversal.numKeys =
+                        indexValidator->traverseIndexKeys(threadOpCtx.get(),
+                                                          index,
+                                                          &indexCursor,
+                                                          false /* onValidateThread */,
+                                                          &traversal.results);
+                    traversal.done = true;
+                }
+            }
+        } catch (const DBException& ex) {
+            // An index which was partially traversed cannot be traversed again, so this fails the
+            // validation.
+            status = ex.toStatus();
+        }
+
+        stdx::lock_guard<Latch> lk(mutex);
+        threadOpCtxs.erase(std::find(threadOpCtxs.begin(), threadOpCtxs.end(), threadOpCtx.get()));
+        if (!status.isOK() && threadStatus.isOK()) {
+            threadStatus = std::move(status);
+        }
+        if (--numRunningThreads == 0) {
+            threadsDone.notify_all();
+        }
+    };
+
+    LOGV2_OPTIONS(5591712,
+                  {LogComponent::kIndex},
+                  "Traversing indexes in parallel",
+                  "namespace"_attr = validateState->nss(),
+                  "numThreads"_attr = numThreads);
+
+    std::vector<stdx::thread> threads;
+    for (size_t i = 0; i < numThreads; ++i) {
+        threads.emplace_back(traverseIndexes);
+    }
+    ON_BLOCK_EXIT([&] {
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    });
+
+    {
+        stdx::unique_lock<Latch> lk(mutex);
+        try {
+            opCtx->waitForConditionOrInterrupt(
+                threadsDone, lk, [&] { return numRunningThreads == 0; });
+        } catch (const DBException& ex) {
+            for (auto threadOpCtx : threadOpCtxs) {
+                stdx::lock_guard<Client> clientLock(*threadOpCtx->getClient());
+                serviceContext->killOperation(clientLock, threadOpCtx, ex.code());
+            }
+            throw;
+        }
+        uassertStatusOK(threadStatus);
+    }
+
+    for (size_t i = 0; i < indexes.size(); ++i) {
+        auto& traversal = traversals[i];
+        if (!traversal.done) {
+            continue;
+        }
+
+        const auto& indexName = indexes[i]->descriptor()->indexName();
+        numTraversedKeys[indexName] = traversal.numKeys;
+
+        // Merge the results of the traversal into the results of the validation.
+        auto& threadIndexResults = traversal.results.indexResultsMap[indexName];
+        auto& curIndexResults = results->indexResultsMap[indexName];
+        curIndexResults.valid = curIndexResults.valid && threadIndexResults.valid;
+        curIndexResults.errors.insert(curIndexResults.errors.end(),
+                                      threadIndexResults.errors.begin(),
+                                      threadIndexResults.errors.end());
+        curIndexResults.warnings.insert(curIndexResults.warnings.end(),
+                                        threadIndexResults.warnings.begin(),
+                                        threadIndexResults.warnings.end());
+        results->valid = results->valid && traversal.results.valid;
+        results->errors.insert(results->errors.end(),
+                               traversal.results.errors.begin(),
+                               traversal.results.errors.end());
+        results->warnings.insert(results->warnings.end(),
+                                 traversal.results.warnings.begin(),
+                                 traversal.results.warnings.end());
+    }
+
+    return numTraversedKeys;
+}
+
 /**
  * Validates each index in the Index Catalog using the cursors in 'indexCursors'.
  *
@@ -115,6 +296,9 @@ void _validateIndexes(OperationContext* opCtx,
                       ValidateState* validateState,
                       ValidateAdaptor* indexValidator,
                       ValidateResults* results) {
+    const auto traversedInParallel =
+        _traverseIndexesInParallel(opCtx, validateState, indexValidator, results);
+
     // Validate Indexes, checking for mismatch between index entries and collection records.
     for (const auto& index : validateState->getIndexes()) {
         opCtx->checkForInterrupt();
@@ -128,7 +312,13 @@ void _validateIndexes(OperationContext* opCtx,
                       "namespace"_attr = validateState->nss());
 
         int64_t numTraversedKeys;
-        indexValidator->traverseIndex(opCtx, index.get(), &numTraversedKeys, results);
+        if (auto it = traversedInParallel.find(descriptor->indexName());
+            it != traversedInParallel.end()) {
+            numTraversedKeys = it->second;
+            indexValidator->finishIndexTraversal(opCtx, index.get(), results);
+        } else {
+            indexValidator->traverseIndex(opCtx, index.get(), &numTraversedKeys, results);
+        }
 
         auto& curIndexResults = (results->indexResultsMap)[descriptor->indexName()];
         curIndexResults.keysTraversed = numTraversedKeys;
@@ -33,10 +33,13 @@
 
 #include "mongo/db/catalog/catalog_test_fixture.h"
 #include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/validate_gen.h"
 #include "mongo/db/db_raii.h"
+#include "mongo/db/index/index_descriptor.h"
 #include "mongo/stdx/thread.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -266,6 +269,36 @@ TEST_F(CollectionValidationTest, ValidateEnforceFastCount) {
                        {CollectionValidation::ValidateMode::kForegroundFullEnforceFastCount});
 }
 
+/**
+ * Creates the indexes {<field>: 1} on the empty collection kNss, for each field in 'fields'.
+ */
+void createIndexes(OperationContext* opCtx, std::initializer_list<std::string> fields) {
+    AutoGetCollection coll(opCtx, kNss, MODE_X);
+    WriteUnitOfWork wuow(opCtx);
+    auto indexCatalog = coll.getWritableCollection()->getIndexCatalog();
+    for (const auto& field : fields) {
+        auto spec = BSON("v" << int(IndexDescriptor::kLatestIndexVersion) << "key"
+                             << BSON(field << 1) << "name" << field + "_1");
+        ASSERT_OK(indexCatalog->createIndexOnEmptyCollection(opCtx, spec).getStatus());
+    }
+    wuow.commit();
+}
+
+// Verify calling validate() with the indexes traversed by several threads.
+TEST_F(CollectionValidationTest, ValidateIndexesInParallel) {
+    auto opCtx = operationContext();
+    const auto originalThreads = gMaxValidateIndexTraversalThreads.load();
+    gMaxValidateIndexTraversalThreads.store(4);
+    ON_BLOCK_EXIT([&] { gMaxValidateIndexTraversalThreads.store(originalThreads); });
+
+    createIndexes(opCtx, {"a", "b", "c"});
+    foregroundValidate(opCtx,
+                       /*valid*/ true,
+                       /*numRecords*/ insertDataRange(opCtx, 0, 100),
+                       /*numInvalidDocuments*/ 0,
+                       /*numErrors*/ 0);
+}
+
 /**
  * Waits for a parallel running collection validation operation to start and then hang at a
  * failpoint.
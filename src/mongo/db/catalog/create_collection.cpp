@@ -51,6 +51,7 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/ops/insert.h"
 #include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/storage/storage_engine.h"
 #include "mongo/db/views/view_catalog.h"
 #include "mongo/idl/command_generic_argument.h"
 #include "mongo/logv2/log.h"
@@ -362,6 +363,37 @@ Status _createCollection(OperationContext* opCtx,
     });
 }
 
+/**
+ * Checks that a collection clustered by _id can be created with 'options'. Clustered collections
+ * store their documents in a table keyed by _id, so they cannot be capped, have no separate _id
+ * index and, outside of time-series buckets, do not support expiring documents.
+ */
+Status _validateClusteredCollectionOptions(OperationContext* opCtx,
+                                           const NamespaceString& nss,
+                                           const CollectionOptions& options,
+                                           const boost::optional<BSONObj>& idIndex) {
+    if (!opCtx->getServiceContext()->getStorageEngine()->supportsClusteredIdIndex()) {
+        return Status(ErrorCodes::InvalidOptions,
+                      "The storage engine does not support clustered collections");
+    }
+    if (options.capped) {
+        return Status(ErrorCodes::InvalidOptions,
+                      str::stream() << "A clustered collection cannot be capped. NS: " << nss);
+    }
+    if (idIndex && !idIndex->isEmpty()) {
+        return Status(ErrorCodes::InvalidOptions,
+                      str::stream() << "A clustered collection cannot have an _id index. NS: "
+                                    << nss);
+    }
+    if (options.clusteredIndex->getExpireAfterSeconds() && !nss.isTimeseriesBucketsCollection()) {
+        return Status(ErrorCodes::InvalidOptions,
+                      str::stream() << "'expireAfterSeconds' is only supported on clustered "
+                                       "time-series buckets collections. NS: "
+                                    << nss);
+    }
+    return Status::OK();
+}
+
 /**
  * Creates the collection or the view as described by 'options'.
  */
@@ -391,6 +423,12 @@ Status createCollection(OperationContext* opCtx,
                 str::stream() << "Cannot create system collection " << ns
                               << " within a transaction.",
                 !opCtx->inMultiDocumentTransaction() || !ns.isSystem());
+        if (options.clusteredIndex) {
+            status = _validateClusteredCollectionOptions(opCtx, ns, options, idIndex);
+            if (!status.isOK()) {
+                return status;
+            }
+        }
         return _createCollection(opCtx, ns, std::move(options), idIndex);
     }
 }
@@ -44,6 +44,7 @@
 #include "mongo/db/catalog/collection_catalog.h"
 #include "mongo/db/catalog/collection_catalog_helper.h"
 #include "mongo/db/catalog/collection_impl.h"
+#include "mongo/db/catalog/collection_lazy_init.h"
 #include "mongo/db/catalog/collection_options.h"
 #include "mongo/db/catalog/database_holder.h"
 #include "mongo/db/catalog/drop_indexes.h"
@@ -180,7 +181,12 @@ void DatabaseImpl::init(OperationContext* const opCtx) const {
                                       : CollectionCatalog::LifetimeMode::kManagedInWriteUnitOfWork);
         invariant(collection);
         // If this is called from the repair path, the collection is already initialized.
-        if (!collection->isInitialized()) {
+        if (collection->isInitialized() || collection->isInitDeferred()) {
+            continue;
+        }
+        if (shouldDeferCollectionInit(opCtx, collection.get())) {
+            collection.getWritableCollection()->deferInit(opCtx);
+        } else {
             collection.getWritableCollection()->init(opCtx);
         }
     }
@@ -840,12 +846,21 @@ void DatabaseImpl::checkForIdIndexesAndDropPendingCollections(OperationContext*
         if (nss.isSystem())
             continue;
 
-        const CollectionPtr& coll = catalog->lookupCollectionByNamespace(opCtx, nss);
+        // Look the collection up without initializing it, as its index catalog is not needed when
+        // its initialization is deferred.
+        const Collection* coll = catalog->lookupCollectionByNamespaceForMetadataWrite(
+            opCtx, CollectionCatalog::LifetimeMode::kInplace, nss);
         if (!coll)
             continue;
 
-        if (coll->getIndexCatalog()->findIdIndex(opCtx))
+        if (coll->isInitDeferred()) {
+            std::vector<std::string> indexNames;
+            DurableCatalog::get(opCtx)->getAllIndexes(opCtx, coll->getCatalogId(), &indexNames);
+            if (std::find(indexNames.begin(), indexNames.end(), "_id_") != indexNames.end())
+                continue;
+        } else if (coll->getIndexCatalog()->findIdIndex(opCtx)) {
             continue;
+        }
 
         LOGV2_OPTIONS(
             20322,
@@ -32,8 +32,12 @@
 #include <boost/optional.hpp>
 #include <functional>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "mongo/base/owned_pointer_vector.h"
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobj.h"
 #include "mongo/bson/ordering.h"
 #include "mongo/bson/timestamp.h"
 #include "mongo/db/index/multikey_paths.h"
@@ -56,6 +60,35 @@ class IndexDescriptor;
 class MatchExpression;
 class OperationContext;
 
+/**
+ * The results of the predicates of partial filter expressions on one document, which the indexes
+ * whose filters have predicates in common share while they are maintained for that document.
+ * Predicates are identified by keys which the index catalog entries derive from them.
+ */
+class PartialFilterResults {
+public:
+    boost::optional<bool> find(size_t keyHash, StringData key) const {
+        for (const auto& result : _results) {
+            if (result.keyHash == keyHash && result.key == key) {
+                return result.matches;
+            }
+        }
+        return boost::none;
+    }
+
+    void record(size_t keyHash, StringData key, bool matches) {
+        _results.push_back({keyHash, key, matches});
+    }
+
+private:
+    struct Result {
+        size_t keyHash;
+        StringData key;
+        bool matches;
+    };
+    std::vector<Result> _results;
+};
+
 class IndexCatalogEntry : public std::enable_shared_from_this<IndexCatalogEntry> {
 public:
     IndexCatalogEntry() = default;
@@ -87,6 +120,14 @@ public:
 
     virtual const MatchExpression* getFilterExpression() const = 0;
 
+    /**
+     * Returns whether 'doc' matches the partial filter expression of this index, or true if the
+     * index is not partial. When 'sharedResults' is given, the results of the predicates of the
+     * filter are looked up in it and recorded into it, for the other indexes of the document.
+     */
+    virtual bool matchesFilter(const BSONObj& doc,
+                               PartialFilterResults* sharedResults = nullptr) const = 0;
+
     virtual const CollatorInterface* getCollator() const = 0;
 
     /**
@@ -34,6 +34,7 @@
 #include "mongo/db/catalog/index_catalog_entry_impl.h"
 
 #include <algorithm>
+#include <functional>
 #include <memory>
 
 #include "mongo/base/init.h"
@@ -58,6 +59,31 @@
 
 namespace mongo {
 
+namespace {
+
+/**
+ * Returns whether the predicate 'expr' of a partial filter expression can be evaluated on the
+ * element of the top-level field it compares, rather than through the path traversal of the
+ * matcher. That holds for the leaf predicates allowed in partial filter expressions on a non-dotted
+ * path, as long as the element is not an array, whose elements the traversal would also match.
+ */
+bool isTopLevelFieldPredicate(const MatchExpression* expr) {
+    switch (expr->matchType()) {
+        case MatchExpression::EQ:
+        case MatchExpression::LTE:
+        case MatchExpression::LT:
+        case MatchExpression::GT:
+        case MatchExpression::GTE:
+        case MatchExpression::EXISTS:
+        case MatchExpression::TYPE_OPERATOR:
+            return !expr->path().empty() && expr->path().find('.') == std::string::npos;
+        default:
+            return false;
+    }
+}
+
+}  // namespace
+
 using std::string;
 
 IndexCatalogEntryImpl::IndexCatalogEntryImpl(OperationContext* const opCtx,
@@ -115,6 +141,31 @@ IndexCatalogEntryImpl::IndexCatalogEntryImpl(OperationContext* const opCtx,
                     "namespace"_attr = nss,
                     "indexName"_attr = _descriptor->indexName(),
                     "filter"_attr = redact(filter));
+
+        auto addPredicate = [&](const MatchExpression* expr) {
+            // The key includes the collation, as the same predicate can match differently under
+            // the collations of different indexes.
+            BSONObjBuilder keyBuilder;
+            keyBuilder.append("collation", _descriptor->collation());
+            BSONObjBuilder predicateBuilder(keyBuilder.subobjStart("predicate"));
+            expr->serialize(&predicateBuilder);
+            predicateBuilder.doneFast();
+            const BSONObj keyObj = keyBuilder.obj();
+
+            FilterPredicate predicate{expr,
+                                      isTopLevelFieldPredicate(expr) ? expr->path() : StringData(),
+                                      std::string(keyObj.objdata(), keyObj.objsize()),
+                                      0};
+            predicate.keyHash = std::hash<std::string>()(predicate.key);
+            _filterPredicates.push_back(std::move(predicate));
+        };
+        if (_filterExpression->matchType() == MatchExpression::AND) {
+            for (size_t i = 0; i < _filterExpression->numChildren(); ++i) {
+                addPredicate(_filterExpression->getChild(i));
+            }
+        } else {
+            addPredicate(_filterExpression.get());
+        }
     }
 }
 
@@ -141,6 +192,34 @@ bool IndexCatalogEntryImpl::isReady(OperationContext* opCtx) const {
     return _isReady;
 }
 
+bool IndexCatalogEntryImpl::matchesFilter(const BSONObj& doc,
+                                          PartialFilterResults* sharedResults) const {
+    for (const auto& predicate : _filterPredicates) {
+        boost::optional<bool> matches;
+        if (sharedResults) {
+            matches = sharedResults->find(predicate.keyHash, predicate.key);
+        }
+
+        if (!matches) {
+            BSONElement elem;
+            if (!predicate.field.empty() && (elem = doc[predicate.field]).type() != Array) {
+                matches = predicate.expr->matchesSingleElement(elem);
+            } else {
+                matches = predicate.expr->matchesBSON(doc);
+            }
+
+            if (sharedResults) {
+                sharedResults->record(predicate.keyHash, predicate.key, *matches);
+            }
+        }
+
+        if (!*matches) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool IndexCatalogEntryImpl::isFrozen() const {
     invariant(!_isFrozen || !_isReady);
     return _isFrozen;
@@ -104,6 +104,9 @@ public:
         return _filterExpression.get();
     }
 
+    bool matchesFilter(const BSONObj& doc,
+                       PartialFilterResults* sharedResults = nullptr) const final;
+
     const CollatorInterface* getCollator() const final {
         return _collator.get();
     }
@@ -225,6 +228,19 @@ private:
     // Special ExpressionContext used to evaluate the partial filter expression.
     boost::intrusive_ptr<ExpressionContext> _expCtxForFilter;
 
+    // The top-level conjuncts of the partial filter expression, which matchesFilter() evaluates in
+    // turn.
+    struct FilterPredicate {
+        const MatchExpression* expr;
+        // The top-level field which the predicate compares, when it can be evaluated on the
+        // element of that field rather than through the path traversal of the matcher.
+        StringData field;
+        // Identifies the predicate, under the collation of the index, in PartialFilterResults.
+        std::string key;
+        size_t keyHash;
+    };
+    std::vector<FilterPredicate> _filterPredicates;
+
     // cached stuff
 
     const RecordId _catalogId;  // Location in the durable catalog of the collection entry
@@ -33,6 +33,7 @@
 
 #include "mongo/db/catalog/index_catalog_impl.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "mongo/base/init.h"
@@ -50,6 +51,7 @@
 #include "mongo/db/curop.h"
 #include "mongo/db/field_ref.h"
 #include "mongo/db/fts/fts_spec.h"
+#include "mongo/db/hasher.h"
 #include "mongo/db/index/index_access_method.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/index/s2_access_method.h"
@@ -688,7 +690,7 @@ Status IndexCatalogImpl::_isSpecOk(OperationContext* opCtx, const BSONObj& spec)
 
     const bool isSparse = spec["sparse"].trueValue();
 
-    if (pluginName == IndexNames::WILDCARD) {
+    if (pluginName == IndexNames::WILDCARD || pluginName == IndexNames::COLUMN) {
         if (isSparse) {
             return Status(ErrorCodes::CannotCreateIndex,
                           str::stream() << "Index type '" << pluginName
@@ -708,6 +710,21 @@ Status IndexCatalogImpl::_isSpecOk(OperationContext* opCtx, const BSONObj& spec)
         }
     }
 
+    if (pluginName == IndexNames::COLUMN) {
+        if (spec.getField("partialFilterExpression")) {
+            return Status(ErrorCodes::CannotCreateIndex,
+                          str::stream() << "Index type '" << pluginName
+                                        << "' does not support the partialFilterExpression option");
+        }
+
+        // Columns are ordered by RecordId, which must be a 64-bit integer.
+        if (_collection->isClustered()) {
+            return Status(ErrorCodes::CannotCreateIndex,
+                          str::stream() << "Index type '" << pluginName
+                                        << "' is not supported on clustered collections");
+        }
+    }
+
     // Create an ExpressionContext, used to parse the match expression and to house the collator for
     // the remaining checks.
     boost::intrusive_ptr<ExpressionContext> expCtx(
@@ -1214,6 +1231,13 @@ const IndexDescriptor* IndexCatalogImpl::findShardKeyPrefixedIndex(OperationCont
         if (desc->isPartial() || desc->isSparse())
             continue;
 
+        // Hashed shard keys are hashed with the default hash version, so the keys of hashed
+        // indexes with other hash versions do not order the documents by their shard key.
+        if (desc->getIndexType() == INDEX_HASHED &&
+            desc->infoObj()[IndexDescriptor::kHashVersionFieldName].numberInt() !=
+                BSONElementHasher::kDefaultHashVersion)
+            continue;
+
         if (!shardKey.isPrefixOf(desc->keyPattern(), SimpleBSONElementComparator::kInstance))
             continue;
 
@@ -1320,10 +1344,8 @@ Status IndexCatalogImpl::_indexKeys(OperationContext* opCtx,
         // index.
         // For non-hybrid builds, the decision to use the filter for the partial index is left to
         // the IndexAccessMethod. See SERVER-28975 for details.
-        if (auto filter = index->getFilterExpression()) {
-            if (!filter->matchesBSON(obj)) {
-                return Status::OK();
-            }
+        if (!index->matchesFilter(obj)) {
+            return Status::OK();
         }
 
         int64_t inserted;
@@ -1367,6 +1389,16 @@ Status IndexCatalogImpl::_indexFilteredRecords(OperationContext* opCtx,
     InsertDeleteOptions options;
     prepareInsertDeleteOptions(opCtx, coll->ns(), index->descriptor(), &options);
 
+    // Each timestamped record has to be indexed at its own timestamp, so the keys of a batch can
+    // only be sorted across records when none of them carries one.
+    if (bsonRecords.size() > 1 && !index->isHybridBuilding() &&
+        std::all_of(bsonRecords.begin(), bsonRecords.end(), [](const BsonRecord& bsonRecord) {
+            return bsonRecord.ts.isNull();
+        })) {
+        return _indexFilteredRecordsInKeyOrder(
+            opCtx, coll, index, bsonRecords, options, keysInsertedOut);
+    }
+
     for (auto bsonRecord : bsonRecords) {
         invariant(bsonRecord.id != RecordId());
 
@@ -1408,10 +1440,63 @@ Status IndexCatalogImpl::_indexFilteredRecords(OperationContext* opCtx,
     return Status::OK();
 }
 
+Status IndexCatalogImpl::_indexFilteredRecordsInKeyOrder(OperationContext* opCtx,
+                                                         const CollectionPtr& coll,
+                                                         IndexCatalogEntry* index,
+                                                         const std::vector<BsonRecord>& bsonRecords,
+                                                         const InsertDeleteOptions& options,
+                                                         int64_t* keysInsertedOut) {
+    auto& executionCtx = StorageExecutionContext::get(opCtx);
+    auto accessMethod = index->accessMethod();
+
+    // The RecordId of each key is encoded in its KeyString, so keys of different records never
+    // compare equal and can all be gathered into a single sorted set.
+    std::vector<KeyString::Value> batchKeys;
+    int64_t numMultikeyMetadataKeys = 0;
+    for (const auto& bsonRecord : bsonRecords) {
+        invariant(bsonRecord.id != RecordId());
+
+        auto keys = executionCtx.keys();
+        auto multikeyMetadataKeys = executionCtx.multikeyMetadataKeys();
+        auto multikeyPaths = executionCtx.multikeyPaths();
+
+        accessMethod->getKeys(executionCtx.pooledBufferBuilder(),
+                              *bsonRecord.docPtr,
+                              options.getKeysMode,
+                              IndexAccessMethod::GetKeysContext::kAddingKeys,
+                              keys.get(),
+                              multikeyMetadataKeys.get(),
+                              multikeyPaths.get(),
+                              bsonRecord.id,
+                              IndexAccessMethod::kNoopOnSuppressedErrorFn);
+
+        if (accessMethod->shouldMarkIndexAsMultikey(
+                keys->size(), *multikeyMetadataKeys, *multikeyPaths)) {
+            index->setMultikey(opCtx, coll, *multikeyMetadataKeys, *multikeyPaths);
+        }
+        numMultikeyMetadataKeys += multikeyMetadataKeys->size();
+        batchKeys.insert(batchKeys.end(), keys->begin(), keys->end());
+    }
+
+    const KeyStringSet sortedKeys(batchKeys.begin(), batchKeys.end());
+    int64_t numInserted;
+    Status status = accessMethod->insertKeys(
+        opCtx, coll, sortedKeys, RecordId(), options, nullptr, &numInserted);
+    if (!status.isOK()) {
+        return status;
+    }
+
+    if (keysInsertedOut) {
+        *keysInsertedOut += numInserted + numMultikeyMetadataKeys;
+    }
+    return Status::OK();
+}
+
 Status IndexCatalogImpl::_indexRecords(OperationContext* opCtx,
                                        const CollectionPtr& coll,
                                        IndexCatalogEntry* index,
                                        const std::vector<BsonRecord>& bsonRecords,
+                                       std::vector<PartialFilterResults>* sharedFilterResults,
                                        int64_t* keysInsertedOut) {
     if (MONGO_unlikely(skipIndexNewRecords.shouldFail())) {
         return Status::OK();
@@ -1421,10 +1506,12 @@ Status IndexCatalogImpl::_indexRecords(OperationContext* opCtx,
     if (!filter)
         return _indexFilteredRecords(opCtx, coll, index, bsonRecords, keysInsertedOut);
 
+    // Predicates common to the filters of several partial indexes are evaluated once per
+    // document, with their results shared through 'sharedFilterResults'.
     std::vector<BsonRecord> filteredBsonRecords;
-    for (auto bsonRecord : bsonRecords) {
-        if (filter->matchesBSON(*(bsonRecord.docPtr)))
-            filteredBsonRecords.push_back(bsonRecord);
+    for (size_t i = 0; i < bsonRecords.size(); ++i) {
+        if (index->matchesFilter(*(bsonRecords[i].docPtr), &(*sharedFilterResults)[i]))
+            filteredBsonRecords.push_back(bsonRecords[i]);
     }
 
     return _indexFilteredRecords(opCtx, coll, index, filteredBsonRecords, keysInsertedOut);
@@ -1494,10 +1581,8 @@ void IndexCatalogImpl::_unindexKeys(OperationContext* opCtx,
         // index.
         // For non-hybrid builds, the decision to use the filter for the partial index is left to
         // the IndexAccessMethod. See SERVER-28975 for details.
-        if (auto filter = index->getFilterExpression()) {
-            if (!filter->matchesBSON(obj)) {
-                return;
-            }
+        if (!index->matchesFilter(obj)) {
+            return;
         }
 
         int64_t removed;
@@ -1579,14 +1664,18 @@ Status IndexCatalogImpl::indexRecords(OperationContext* opCtx,
         *keysInsertedOut = 0;
     }
 
+    std::vector<PartialFilterResults> sharedFilterResults(bsonRecords.size());
+
     for (auto&& it : _readyIndexes) {
-        Status s = _indexRecords(opCtx, coll, it.get(), bsonRecords, keysInsertedOut);
+        Status s = _indexRecords(
+            opCtx, coll, it.get(), bsonRecords, &sharedFilterResults, keysInsertedOut);
         if (!s.isOK())
             return s;
     }
 
     for (auto&& it : _buildingIndexes) {
-        Status s = _indexRecords(opCtx, coll, it.get(), bsonRecords, keysInsertedOut);
+        Status s = _indexRecords(
+            opCtx, coll, it.get(), bsonRecords, &sharedFilterResults, keysInsertedOut);
         if (!s.isOK())
             return s;
     }
@@ -329,10 +329,23 @@ private:
                                  const std::vector<BsonRecord>& bsonRecords,
                                  int64_t* keysInsertedOut);
 
+    /**
+     * Generates the keys of every record in 'bsonRecords' up front and inserts them into the index
+     * in key order, rather than one record at a time. The records must not carry timestamps of
+     * their own, and the index must not be in the middle of a hybrid build.
+     */
+    Status _indexFilteredRecordsInKeyOrder(OperationContext* opCtx,
+                                           const CollectionPtr& coll,
+                                           IndexCatalogEntry* index,
+                                           const std::vector<BsonRecord>& bsonRecords,
+                                           const InsertDeleteOptions& options,
+                                           int64_t* keysInsertedOut);
+
     Status _indexRecords(OperationContext* opCtx,
                          const CollectionPtr& coll,
                          IndexCatalogEntry* index,
                          const std::vector<BsonRecord>& bsonRecords,
+                         std::vector<PartialFilterResults>* sharedFilterResults,
                          int64_t* keysInsertedOut);
 
     Status _updateRecord(OperationContext* const opCtx,
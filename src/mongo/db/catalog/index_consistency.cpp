@@ -93,9 +93,7 @@ IndexEntryInfo::IndexEntryInfo(const IndexInfo& indexInfo,
 
 IndexConsistency::IndexConsistency(OperationContext* opCtx,
                                    CollectionValidation::ValidateState* validateState)
-    : _validateState(validateState), _firstPhase(true) {
-    _indexKeyBuckets.resize(kNumHashBuckets);
-
+    : _validateState(validateState), _indexKeyBuckets(kNumHashBuckets), _firstPhase(true) {
     for (const auto& index : _validateState->getIndexes()) {
         const IndexDescriptor* descriptor = index->descriptor();
         IndexAccessMethod* accessMethod = const_cast<IndexAccessMethod*>(index->accessMethod());
@@ -117,9 +115,10 @@ size_t IndexConsistency::getMultikeyMetadataPathCount(IndexInfo* indexInfo) {
 }
 
 bool IndexConsistency::haveEntryMismatch() const {
-    return std::any_of(_indexKeyBuckets.begin(),
-                       _indexKeyBuckets.end(),
-                       [](const IndexKeyBucket& bucket) -> bool { return bucket.indexKeyCount; });
+    return std::any_of(
+        _indexKeyBuckets.begin(), _indexKeyBuckets.end(), [](const IndexKeyBucket& bucket) -> bool {
+            return bucket.indexKeyCount.load();
+        });
 }
 
 void IndexConsistency::setSecondPhase() {
@@ -311,8 +310,8 @@ void IndexConsistency::addDocKey(OperationContext* opCtx,
     if (_firstPhase) {
         // During the first phase of validation we only keep track of the count for the document
         // keys encountered.
-        _indexKeyBuckets[hash].indexKeyCount++;
-        _indexKeyBuckets[hash].bucketSizeBytes += ks.getSize();
+        _indexKeyBuckets[hash].indexKeyCount.fetchAndAdd(1);
+        _indexKeyBuckets[hash].bucketSizeBytes.fetchAndAdd(ks.getSize());
         indexInfo->numRecords++;
 
         if (MONGO_unlikely(_validateState->extraLoggingForTest())) {
@@ -323,7 +322,7 @@ void IndexConsistency::addDocKey(OperationContext* opCtx,
             StorageDebugUtil::printKeyString(
                 recordId, ks, keyPatternBson, keyStringBson, "[validate](record)");
         }
-    } else if (_indexKeyBuckets[hash].indexKeyCount) {
+    } else if (_indexKeyBuckets[hash].indexKeyCount.load()) {
         // Found a document key for a hash bucket that had mismatches.
 
         // Get the documents _id index key.
@@ -355,8 +354,8 @@ void IndexConsistency::addIndexKey(OperationContext* opCtx,
     if (_firstPhase) {
         // During the first phase of validation we only keep track of the count for the index entry
         // keys encountered.
-        _indexKeyBuckets[hash].indexKeyCount--;
-        _indexKeyBuckets[hash].bucketSizeBytes += ks.getSize();
+        _indexKeyBuckets[hash].indexKeyCount.fetchAndSubtract(1);
+        _indexKeyBuckets[hash].bucketSizeBytes.fetchAndAdd(ks.getSize());
         indexInfo->numKeys++;
 
         if (MONGO_unlikely(_validateState->extraLoggingForTest())) {
@@ -367,7 +366,7 @@ void IndexConsistency::addIndexKey(OperationContext* opCtx,
             StorageDebugUtil::printKeyString(
                 recordId, ks, keyPatternBson, keyStringBson, "[validate](index)");
         }
-    } else if (_indexKeyBuckets[hash].indexKeyCount) {
+    } else if (_indexKeyBuckets[hash].indexKeyCount.load()) {
         // Found an index key for a bucket that has inconsistencies.
         // If there is a corresponding document key for the index entry key, we remove the key from
         // the '_missingIndexEntries' map. However if there was no document key for the index entry
@@ -422,7 +421,9 @@ bool IndexConsistency::limitMemoryUsageForSecondPhase(ValidateResults* result) {
                         _indexKeyBuckets.end(),
                         0,
                         [](uint64_t bytes, const IndexKeyBucket& bucket) {
-                            return bucket.indexKeyCount ? bytes + bucket.bucketSizeBytes : bytes;
+                            return bucket.indexKeyCount.load()
+                                ? bytes + bucket.bucketSizeBytes.load()
+                                : bytes;
                         });
 
     if (totalMemoryNeededBytes <= maxMemoryUsageBytes) {
@@ -435,18 +436,19 @@ bool IndexConsistency::limitMemoryUsageForSecondPhase(ValidateResults* result) {
     uint32_t smallestBucketBytes = std::numeric_limits<uint32_t>::max();
     // Zero out any nonzero buckets that would put us over maxMemoryUsageBytes.
     std::for_each(_indexKeyBuckets.begin(), _indexKeyBuckets.end(), [&](IndexKeyBucket& bucket) {
-        if (bucket.indexKeyCount == 0) {
+        if (bucket.indexKeyCount.load() == 0) {
             return;
         }
 
-        smallestBucketBytes = std::min(smallestBucketBytes, bucket.bucketSizeBytes);
-        if (bucket.bucketSizeBytes + memoryUsedSoFarBytes > maxMemoryUsageBytes) {
+        const uint32_t bucketSizeBytes = bucket.bucketSizeBytes.load();
+        smallestBucketBytes = std::min(smallestBucketBytes, bucketSizeBytes);
+        if (bucketSizeBytes + memoryUsedSoFarBytes > maxMemoryUsageBytes) {
             // Including this bucket would put us over the memory limit, so zero
             // this bucket.
-            bucket.indexKeyCount = 0;
+            bucket.indexKeyCount.store(0);
             return;
         }
-        memoryUsedSoFarBytes += bucket.bucketSizeBytes;
+        memoryUsedSoFarBytes += bucketSizeBytes;
         hasNonZeroBucket = true;
     });
 
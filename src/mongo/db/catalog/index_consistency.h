@@ -32,6 +32,7 @@
 #include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/catalog/validate_state.h"
 #include "mongo/db/storage/key_string.h"
+#include "mongo/platform/atomic_word.h"
 
 namespace mongo {
 
@@ -112,7 +113,8 @@ public:
 
     /**
      * During the first phase of validation, given the index entry's KeyString, decrement the
-     * corresponding `_indexKeyCount` by hashing it.
+     * corresponding `_indexKeyCount` by hashing it. In that phase, it may be called concurrently
+     * for index entries of different indexes.
      * For the second phase of validation, try to match the index entry keys that hashed to
      * inconsistent hash buckets during the first phase of validation to document keys.
      */
@@ -178,9 +180,11 @@ public:
     bool limitMemoryUsageForSecondPhase(ValidateResults* result);
 
 private:
+    // The counters are atomic because several threads may traverse different indexes at once
+    // during the first phase of validation.
     struct IndexKeyBucket {
-        uint32_t indexKeyCount;
-        uint32_t bucketSizeBytes;
+        AtomicWord<uint32_t> indexKeyCount;
+        AtomicWord<uint32_t> bucketSizeBytes;
     };
 
     IndexConsistency() = delete;
@@ -41,6 +41,7 @@
 #include "mongo/base/status.h"
 #include "mongo/base/status_with.h"
 #include "mongo/db/field_ref.h"
+#include "mongo/db/hasher.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/index/wildcard_key_generator.h"
 #include "mongo/db/index_names.h"
@@ -83,6 +84,7 @@ static std::set<StringData> allowedFieldNames = {
     IndexDescriptor::kDropDuplicatesFieldName,
     IndexDescriptor::kExpireAfterSecondsFieldName,
     IndexDescriptor::kGeoHaystackBucketSize,
+    IndexDescriptor::kHashVersionFieldName,
     IndexDescriptor::kHiddenFieldName,
     IndexDescriptor::kIndexNameFieldName,
     IndexDescriptor::kIndexVersionFieldName,
@@ -137,7 +139,7 @@ Status validateKeyPattern(const BSONObj& key, IndexDescriptor::IndexVersion inde
                                           << static_cast<int>(indexVersion)};
                 }
 
-                if (pluginName == IndexNames::WILDCARD) {
+                if (pluginName == IndexNames::WILDCARD || pluginName == IndexNames::COLUMN) {
                     return {code,
                             str::stream() << "'" << pluginName
                                           << "' index plugin is not allowed with index version v:"
@@ -184,6 +186,24 @@ Status validateKeyPattern(const BSONObj& key, IndexDescriptor::IndexVersion inde
             return Status(code, "wildcard indexes do not allow compounding");
         }
 
+        // Every field of a columnstore index is stored as its own column, keyed by the top-level
+        // field name, so the fields can neither be mixed with ascending or descending fields nor
+        // be dotted paths.
+        if (pluginName == IndexNames::COLUMN) {
+            if (keyElement.type() != String) {
+                return Status(code,
+                              str::stream() << "Every field of a '" << IndexNames::COLUMN
+                                            << "' index must have the value '"
+                                            << IndexNames::COLUMN << "'");
+            }
+            if (keyElement.fieldNameStringData().find('.') != std::string::npos) {
+                return Status(code,
+                              str::stream() << "'" << IndexNames::COLUMN
+                                            << "' indexes only support top-level fields, not '"
+                                            << keyElement.fieldNameStringData() << "'");
+            }
+        }
+
         // Ensure that the fields on which we are building the index are valid: a field must not
         // begin with a '$' unless it is part of a wildcard, DBRef or text index, and a field path
         // cannot contain an empty field. If a field cannot be created or updated, it should not be
@@ -452,6 +472,40 @@ StatusWith<BSONObj> validateIndexSpec(
                 return ex.toStatus(str::stream() << "Failed to parse: "
                                                  << IndexDescriptor::kPathProjectionFieldName);
             }
+        } else if (IndexDescriptor::kHashVersionFieldName == indexSpecElemFieldName) {
+            const auto key = indexSpec.getObjectField(IndexDescriptor::kKeyPatternFieldName);
+            if (IndexNames::findPluginName(key) != IndexNames::HASHED) {
+                return {ErrorCodes::BadValue,
+                        str::stream()
+                            << "The field '" << IndexDescriptor::kHashVersionFieldName
+                            << "' is only allowed in a '" << IndexNames::HASHED << "' index"};
+            }
+            if (!indexSpecElem.isNumber()) {
+                return {ErrorCodes::TypeMismatch,
+                        str::stream()
+                            << "The field '" << IndexDescriptor::kHashVersionFieldName
+                            << "' must be a number, but got " << typeName(indexSpecElem.type())};
+            }
+
+            auto hashVersion = representAs<int>(indexSpecElem.number());
+            if (!hashVersion || !BSONElementHasher::isValidHashVersion(*hashVersion)) {
+                return {ErrorCodes::CannotCreateIndex,
+                        str::stream() << "Invalid hash version "
+                                      << indexSpecElem.toString(false, false) << "; expected "
+                                      << BSONElementHasher::kMD5HashVersion << " or "
+                                      << BSONElementHasher::kMurmurHashVersion};
+            }
+
+            // Nodes of earlier versions cannot compute the keys of the newer hash versions.
+            if (*hashVersion != BSONElementHasher::kMD5HashVersion &&
+                featureCompatibility.isVersionInitialized() &&
+                !featureCompatibility.isGreaterThanOrEqualTo(
+                    ServerGlobalParams::FeatureCompatibility::Version::kVersion49)) {
+                return {ErrorCodes::CannotCreateIndex,
+                        str::stream()
+                            << "Hash version " << *hashVersion
+                            << " requires the feature compatibility version to be at least 4.9"};
+            }
         } else if (IndexDescriptor::kGeoHaystackBucketSize == indexSpecElemFieldName) {
             return {ErrorCodes::CannotCreateIndex,
                     str::stream()
@@ -438,6 +438,14 @@ Status MultiIndexBlock::insertAllDocumentsInCollection(
                   IndexBuildPhase_serializer(_phase).toString());
         _phase = IndexBuildPhaseEnum::kCollectionScan;
 
+        // With more than one scan thread, the documents are buffered and their keys generated a
+        // batch at a time. The buffered documents are owned so that they survive yields, and are
+        // scanned again when resuming the build as the scan position only covers inserted ones.
+        const size_t numScanThreads = maxIndexBuildScanThreads.load();
+        const size_t scanBatchSize = internalIndexBuildScanBatchSize.load();
+        std::vector<BSONObj> batchObjs;
+        std::vector<RecordId> batchLocs;
+
         BSONObj objToIndex;
         RecordId loc;
         PlanExecutor::ExecState state;
@@ -460,7 +468,17 @@ Status MultiIndexBlock::insertAllDocumentsInCollection(
 
             // The external sorter is not part of the storage engine and therefore does not need a
             // WriteUnitOfWork to write keys.
-            uassertStatusOK(_insert(opCtx, objToIndex, loc));
+            if (numScanThreads > 1) {
+                batchObjs.push_back(objToIndex.getOwned());
+                batchLocs.push_back(loc);
+                if (batchObjs.size() >= scanBatchSize) {
+                    uassertStatusOK(_insertBatch(opCtx, batchObjs, batchLocs, numScanThreads));
+                    batchObjs.clear();
+                    batchLocs.clear();
+                }
+            } else {
+                uassertStatusOK(_insert(opCtx, objToIndex, loc));
+            }
 
             _failPointHangDuringBuild(opCtx,
                                       &hangIndexBuildDuringCollectionScanPhaseAfterInsertion,
@@ -473,6 +491,8 @@ Status MultiIndexBlock::insertAllDocumentsInCollection(
             progress->hit();
             n++;
         }
+
+        uassertStatusOK(_insertBatch(opCtx, batchObjs, batchLocs, numScanThreads));
     } catch (DBException& ex) {
         if (ex.isA<ErrorCategory::Interruption>() || ex.isA<ErrorCategory::ShutdownError>() ||
             ErrorCodes::IndexBuildAborted == ex.code()) {
@@ -558,6 +578,14 @@ Status MultiIndexBlock::insertSingleDocumentForInitialSyncOrRecovery(OperationCo
     return _insert(opCtx, doc, loc);
 }
 
+Status MultiIndexBlock::insertDocumentsForInitialSyncOrRecovery(OperationContext* opCtx,
+                                                                const std::vector<BSONObj>& docs,
+                                                                const std::vector<RecordId>& locs,
+                                                                size_t numThreads) {
+    invariant(docs.size() == locs.size());
+    return _insertBatch(opCtx, docs, locs, numThreads);
+}
+
 Status MultiIndexBlock::_insert(OperationContext* opCtx, const BSONObj& doc, const RecordId& loc) {
     invariant(!_buildIsCleanedUp);
     for (size_t i = 0; i < _indexes.size(); i++) {
@@ -584,6 +612,53 @@ Status MultiIndexBlock::_insert(OperationContext* opCtx, const BSONObj& doc, con
     return Status::OK();
 }
 
+Status MultiIndexBlock::_insertBatch(OperationContext* opCtx,
+                                     const std::vector<BSONObj>& objs,
+                                     const std::vector<RecordId>& locs,
+                                     size_t numThreads) {
+    invariant(!_buildIsCleanedUp);
+    if (objs.empty()) {
+        return Status::OK();
+    }
+
+    std::vector<BSONObj> filteredObjs;
+    std::vector<RecordId> filteredLocs;
+    for (size_t i = 0; i < _indexes.size(); i++) {
+        const std::vector<BSONObj>* indexObjs = &objs;
+        const std::vector<RecordId>* indexLocs = &locs;
+        if (_indexes[i].filterExpression) {
+            filteredObjs.clear();
+            filteredLocs.clear();
+            for (size_t j = 0; j < objs.size(); j++) {
+                if (_indexes[i].filterExpression->matchesBSON(objs[j])) {
+                    filteredObjs.push_back(objs[j]);
+                    filteredLocs.push_back(locs[j]);
+                }
+            }
+            indexObjs = &filteredObjs;
+            indexLocs = &filteredLocs;
+        }
+
+        Status idxStatus = Status::OK();
+
+        // When calling insertBatch, BulkBuilderImpl's Sorter performs file I/O that may result in
+        // an exception.
+        try {
+            idxStatus = _indexes[i].bulk->insertBatch(
+                opCtx, *indexObjs, *indexLocs, _indexes[i].options, numThreads);
+        } catch (...) {
+            return exceptionToStatus();
+        }
+
+        if (!idxStatus.isOK())
+            return idxStatus;
+    }
+
+    _lastRecordIdInserted = locs.back();
+
+    return Status::OK();
+}
+
 Status MultiIndexBlock::dumpInsertsFromBulk(OperationContext* opCtx,
                                             const CollectionPtr& collection) {
     return dumpInsertsFromBulk(opCtx, collection, nullptr);
@@ -168,6 +168,16 @@ public:
                                                         const BSONObj& wholeDocument,
                                                         const RecordId& loc);
 
+    /**
+     * Like insertSingleDocumentForInitialSyncOrRecovery() for each of 'docs' in order, but
+     * generates their keys on up to 'numThreads' threads. 'docs' must stay valid until this
+     * returns.
+     */
+    Status insertDocumentsForInitialSyncOrRecovery(OperationContext* opCtx,
+                                                   const std::vector<BSONObj>& docs,
+                                                   const std::vector<RecordId>& locs,
+                                                   size_t numThreads);
+
     /**
      * Call this after the last insertSingleDocumentForInitialSyncOrRecovery(). This gives the index
      * builder a chance to do any long-running operations in separate units of work from commit().
@@ -312,6 +322,16 @@ private:
 
     Status _insert(OperationContext* opCtx, const BSONObj& wholeDocument, const RecordId& loc);
 
+    /**
+     * Inserts a batch of owned documents read by the collection scan, generating their keys on up
+     * to 'numThreads' threads. Like _insert(), advances the collection scan position only once all
+     * of the documents have been inserted.
+     */
+    Status _insertBatch(OperationContext* opCtx,
+                        const std::vector<BSONObj>& objs,
+                        const std::vector<RecordId>& locs,
+                        size_t numThreads);
+
     // Is set during init() and ensures subsequent function calls act on the same Collection.
     boost::optional<UUID> _collectionUUID;
 
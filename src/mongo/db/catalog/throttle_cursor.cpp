@@ -125,59 +125,70 @@ void DataThrottle::awaitIfNeeded(OperationContext* opCtx, const int64_t dataSize
     int64_t currentMillis =
         opCtx->getServiceContext()->getFastClockSource()->now().toMillisSinceEpoch();
 
-    // Reset the tracked information as the second has rolled over the starting point.
-    if (currentMillis >= _startMillis + 1000) {
-        float elapsedTimeSec = static_cast<float>(currentMillis - _startMillis) / 1000;
-        float mbProcessed = static_cast<float>(_bytesProcessed + dataSize) / 1024 / 1024;
-
-        // Update how much data we've seen in the last second for CurOp.
-        CurOp::get(opCtx)->debug().dataThroughputLastSecond = mbProcessed / elapsedTimeSec;
-
-        _totalMBProcessed += mbProcessed;
-        _totalElapsedTimeSec += elapsedTimeSec;
-
-        // Update how much data we've seen throughout the lifetime of the DataThrottle for CurOp.
-        CurOp::get(opCtx)->debug().dataThroughputAverage = _totalMBProcessed / _totalElapsedTimeSec;
-
-        _startMillis = currentMillis;
-        _bytesProcessed = 0;
+    // The point in time until which this thread has to wait, computed under the mutex. The sleep
+    // itself happens outside of it, so that the other threads which share this throttle are not
+    // serialized behind a sleeping one.
+    int64_t startMillis;
+    int64_t maxWaitMs;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+
+        // Reset the tracked information as the second has rolled over the starting point.
+        if (currentMillis >= _startMillis + 1000) {
+            float elapsedTimeSec = static_cast<float>(currentMillis - _startMillis) / 1000;
+            float mbProcessed = static_cast<float>(_bytesProcessed + dataSize) / 1024 / 1024;
+
+            // Update how much data we've seen in the last second for CurOp.
+            CurOp::get(opCtx)->debug().dataThroughputLastSecond = mbProcessed / elapsedTimeSec;
+
+            _totalMBProcessed += mbProcessed;
+            _totalElapsedTimeSec += elapsedTimeSec;
+
+            // Update how much data we've seen throughout the lifetime of the DataThrottle for
+            // CurOp.
+            CurOp::get(opCtx)->debug().dataThroughputAverage =
+                _totalMBProcessed / _totalElapsedTimeSec;
+
+            _startMillis = currentMillis;
+            _bytesProcessed = 0;
+        }
+
+        if (MONGO_unlikely(fixedCursorDataSizeOf512KBForDataThrottle.shouldFail())) {
+            _bytesProcessed += /* 512KB */ 1024 * 512;
+        } else if (MONGO_unlikely(fixedCursorDataSizeOf2MBForDataThrottle.shouldFail())) {
+            _bytesProcessed += /* 2MB */ 2 * 1024 * 1024;
+        } else {
+            _bytesProcessed += dataSize;
+        }
+
+        if (_shouldNotThrottle) {
+            return;
+        }
+
+        // No throttling should take place if 'gMaxValidateMBperSec' is zero.
+        uint64_t maxValidateBytesPerSec = gMaxValidateMBperSec.load() * 1024 * 1024;
+        if (maxValidateBytesPerSec == 0) {
+            return;
+        }
+
+        if (_bytesProcessed < maxValidateBytesPerSec) {
+            return;
+        }
+
+        // Wait a period of time proportional to how much extra data we have read. For example, if
+        // we read one 5 MB document and maxValidateBytesPerSec is 1, we should not be waiting until
+        // the next 1 second period. We should wait 5 seconds to maintain proper throughput.
+        startMillis = _startMillis;
+        maxWaitMs = 1000 * std::max(1.0, double(_bytesProcessed) / maxValidateBytesPerSec);
     }
 
-    if (MONGO_unlikely(fixedCursorDataSizeOf512KBForDataThrottle.shouldFail())) {
-        _bytesProcessed += /* 512KB */ 1024 * 512;
-    } else if (MONGO_unlikely(fixedCursorDataSizeOf2MBForDataThrottle.shouldFail())) {
-        _bytesProcessed += /* 2MB */ 2 * 1024 * 1024;
-    } else {
-        _bytesProcessed += dataSize;
-    }
-
-    if (_shouldNotThrottle) {
-        return;
-    }
-
-    // No throttling should take place if 'gMaxValidateMBperSec' is zero.
-    uint64_t maxValidateBytesPerSec = gMaxValidateMBperSec.load() * 1024 * 1024;
-    if (maxValidateBytesPerSec == 0) {
-        return;
-    }
-
-    if (_bytesProcessed < maxValidateBytesPerSec) {
-        return;
-    }
-
-    // Wait a period of time proportional to how much extra data we have read. For example, if we
-    // read one 5 MB document and maxValidateBytesPerSec is 1, we should not be waiting until the
-    // next 1 second period. We should wait 5 seconds to maintain proper throughput.
-    int64_t maxWaitMs = 1000 * std::max(1.0, double(_bytesProcessed) / maxValidateBytesPerSec);
-
     do {
-        int64_t millisToSleep = maxWaitMs - (currentMillis - _startMillis);
-        invariant(millisToSleep >= 0);
+        int64_t millisToSleep = std::max(int64_t(0), maxWaitMs - (currentMillis - startMillis));
 
         opCtx->sleepFor(Milliseconds(millisToSleep));
         currentMillis =
             opCtx->getServiceContext()->getFastClockSource()->now().toMillisSinceEpoch();
-    } while (currentMillis < _startMillis + maxWaitMs);
+    } while (currentMillis < startMillis + maxWaitMs);
 }
 
 }  // namespace mongo
@@ -34,6 +34,7 @@
 
 #include "mongo/db/storage/record_store.h"
 #include "mongo/db/storage/sorted_data_interface.h"
+#include "mongo/platform/mutex.h"
 #include "mongo/util/fail_point.h"
 
 namespace mongo {
@@ -120,6 +121,9 @@ private:
  * Throttles the amount of data processed within a unit of time. Puts the thread to sleep via an
  * opCtx -- so it is interruptible -- whenever the data limit set by the 'maxValidateMBperSec'
  * server parameter is exceeded before the time unit is done.
+ *
+ * A DataThrottle may be shared by the cursors of several threads, which are then throttled
+ * together.
  */
 class DataThrottle {
 public:
@@ -149,6 +153,9 @@ public:
     }
 
 private:
+    // Protects the tracked information below.
+    Mutex _mutex = MONGO_MAKE_LATCH("DataThrottle::_mutex");
+
     // Point-in-time (milliseconds) when tracking for the current second has started.
     int64_t _startMillis;
 
@@ -257,14 +257,6 @@ void ValidateAdaptor::traverseIndex(OperationContext* opCtx,
                                     const IndexCatalogEntry* index,
                                     int64_t* numTraversedKeys,
                                     ValidateResults* results) {
-    const IndexDescriptor* descriptor = index->descriptor();
-    auto indexName = descriptor->indexName();
-    auto& indexResults = results->indexResultsMap[indexName];
-    IndexInfo& indexInfo = _indexConsistency->getIndexInfo(indexName);
-    int64_t numKeys = 0;
-
-    bool isFirstEntry = true;
-
     // The progress meter will be inactive after traversing the record store to allow the message
     // and the total to be set to different values.
     if (!_progress->isActive()) {
@@ -273,6 +265,33 @@ void ValidateAdaptor::traverseIndex(OperationContext* opCtx,
         _progress.set(CurOp::get(opCtx)->setProgress_inlock(curopMessage, _totalIndexKeys));
     }
 
+    // Ensure that this index has an open index cursor.
+    const auto indexCursorIt =
+        _validateState->getIndexCursors().find(index->descriptor()->indexName());
+    invariant(indexCursorIt != _validateState->getIndexCursors().end());
+
+    const int64_t numKeys = traverseIndexKeys(
+        opCtx, index, indexCursorIt->second.get(), true /* onValidateThread */, results);
+    finishIndexTraversal(opCtx, index, results);
+
+    if (numTraversedKeys) {
+        *numTraversedKeys = numKeys;
+    }
+}
+
+int64_t ValidateAdaptor::traverseIndexKeys(OperationContext* opCtx,
+                                           const IndexCatalogEntry* index,
+                                           SortedDataInterfaceThrottleCursor* indexCursor,
+                                           bool onValidateThread,
+                                           ValidateResults* results) {
+    const IndexDescriptor* descriptor = index->descriptor();
+    auto indexName = descriptor->indexName();
+    auto& indexResults = results->indexResultsMap[indexName];
+    IndexInfo& indexInfo = _indexConsistency->getIndexInfo(indexName);
+    int64_t numKeys = 0;
+
+    bool isFirstEntry = true;
+
     const KeyString::Version version =
         index->accessMethod()->getSortedDataInterface()->getKeyStringVersion();
 
@@ -285,11 +304,6 @@ void ValidateAdaptor::traverseIndex(OperationContext* opCtx,
 
     KeyString::Value prevIndexKeyStringValue;
 
-    // Ensure that this index has an open index cursor.
-    const auto indexCursorIt = _validateState->getIndexCursors().find(indexName);
-    invariant(indexCursorIt != _validateState->getIndexCursors().end());
-
-    const std::unique_ptr<SortedDataInterfaceThrottleCursor>& indexCursor = indexCursorIt->second;
     for (auto indexEntry = indexCursor->seekForKeyString(opCtx, firstKeyString.release());
          indexEntry;
          indexEntry = indexCursor->nextKeyString(opCtx)) {
@@ -314,7 +328,9 @@ void ValidateAdaptor::traverseIndex(OperationContext* opCtx,
         if (descriptor->getIndexType() == IndexType::INDEX_WILDCARD &&
             indexEntry->loc == kWildcardMultikeyMetadataRecordId) {
             _indexConsistency->removeMultikeyMetadataPath(indexEntry->keyString, &indexInfo);
-            _progress->hit();
+            if (onValidateThread) {
+                _progress->hit();
+            }
             numKeys++;
             continue;
         }
@@ -330,18 +346,32 @@ void ValidateAdaptor::traverseIndex(OperationContext* opCtx,
             continue;
         }
 
-        _progress->hit();
+        if (onValidateThread) {
+            _progress->hit();
+        }
         numKeys++;
         isFirstEntry = false;
         prevIndexKeyStringValue = indexEntry->keyString;
 
         if (numKeys % kInterruptIntervalNumRecords == 0) {
-            // Periodically checks for interrupts and yields.
+            // Periodically checks for interrupts and yields. The cursors of other threads are not
+            // part of the validate state, and read from a snapshot which does not need refreshing.
             opCtx->checkForInterrupt();
-            _validateState->yield(opCtx);
+            if (onValidateThread) {
+                _validateState->yield(opCtx);
+            }
         }
     }
 
+    return numKeys;
+}
+
+void ValidateAdaptor::finishIndexTraversal(OperationContext* opCtx,
+                                           const IndexCatalogEntry* index,
+                                           ValidateResults* results) {
+    const IndexDescriptor* descriptor = index->descriptor();
+    IndexInfo& indexInfo = _indexConsistency->getIndexInfo(descriptor->indexName());
+
     if (results && _indexConsistency->getMultikeyMetadataPathCount(&indexInfo) > 0) {
         results->errors.push_back(str::stream()
                                   << "Index '" << descriptor->indexName()
@@ -414,10 +444,6 @@ void ValidateAdaptor::traverseIndex(OperationContext* opCtx,
             }
         }
     }
-
-    if (numTraversedKeys) {
-        *numTraversedKeys = numKeys;
-    }
 }
 
 void ValidateAdaptor::traverseRecordStore(OperationContext* opCtx,
@@ -607,10 +633,11 @@ void ValidateAdaptor::validateIndexKeyCount(const IndexCatalogEntry* index,
 
     // Confirm that the number of index entries is not greater than the number of documents in the
     // collection. This check is only valid for indexes that are not multikey (indexed arrays
-    // produce an index key per array entry) and not $** indexes which can produce index keys for
-    // multiple paths within a single document.
+    // produce an index key per array entry) and not $** or columnstore indexes which can produce
+    // index keys for multiple paths within a single document.
     if (results.valid && !index->isMultikey() &&
-        desc->getIndexType() != IndexType::INDEX_WILDCARD && numTotalKeys > _numRecords) {
+        desc->getIndexType() != IndexType::INDEX_WILDCARD &&
+        desc->getIndexType() != IndexType::INDEX_COLUMN && numTotalKeys > _numRecords) {
         std::string err = str::stream()
             << "index " << desc->indexName() << " is not multi-key, but has more entries ("
             << numTotalKeys << ") than documents in the index (" << _numRecords << ")";
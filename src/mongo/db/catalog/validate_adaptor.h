@@ -68,6 +68,25 @@ public:
                        int64_t* numTraversedKeys,
                        ValidateResults* results);
 
+    /**
+     * The two steps of traverseIndex(). traverseIndexKeys() goes through the index entries with
+     * 'indexCursor' and returns their number, and finishIndexTraversal() then checks the multikey
+     * state of the index against what was seen in the traversals.
+     *
+     * When 'onValidateThread' is false, traverseIndexKeys() neither yields the validate state nor
+     * reports progress, so that it can run on another thread, with its own operation context and
+     * cursor, concurrently with the traversals of other indexes. finishIndexTraversal() must run on
+     * the thread of the validation.
+     */
+    int64_t traverseIndexKeys(OperationContext* opCtx,
+                              const IndexCatalogEntry* index,
+                              SortedDataInterfaceThrottleCursor* indexCursor,
+                              bool onValidateThread,
+                              ValidateResults* results);
+    void finishIndexTraversal(OperationContext* opCtx,
+                              const IndexCatalogEntry* index,
+                              ValidateResults* results);
+
     /**
      * Traverses the record store to retrieve every record and go through its document key
      * set to keep track of the index consistency during a validation.
@@ -131,6 +131,14 @@ public:
         return _firstRecordId;
     }
 
+    /**
+     * The throttle shared by all the cursors of this validation, including the ones which other
+     * threads open for it.
+     */
+    DataThrottle* getDataThrottle() {
+        return &_dataThrottle;
+    }
+
     /**
      * Yields locks for background validation; or cursors for foreground validation. Locks are
      * yielded to allow DDL ops to run concurrently with background validation. Cursors are yielded
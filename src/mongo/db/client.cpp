@@ -43,6 +43,7 @@
 #include "mongo/db/lasterror.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/operation_cpu_timer.h"
+#include "mongo/db/operation_hardware_counters.h"
 #include "mongo/db/service_context.h"
 #include "mongo/stdx/thread.h"
 #include "mongo/util/concurrency/thread_name.h"
@@ -146,18 +147,24 @@ bool haveClient() {
 
 ServiceContext::UniqueClient Client::releaseCurrent() {
     invariant(haveClient(), "No client to release");
-    if (auto opCtx = currentClient->_opCtx)
+    if (auto opCtx = currentClient->_opCtx) {
         if (auto timer = OperationCPUTimer::get(opCtx))
             timer->onThreadDetach();
+        if (auto counters = OperationHardwareCounters::get(opCtx))
+            counters->onThreadDetach();
+    }
     return std::move(currentClient);
 }
 
 void Client::setCurrent(ServiceContext::UniqueClient client) {
     invariantNoCurrentClient();
     currentClient = std::move(client);
-    if (auto opCtx = currentClient->_opCtx)
+    if (auto opCtx = currentClient->_opCtx) {
         if (auto timer = OperationCPUTimer::get(opCtx))
             timer->onThreadAttach();
+        if (auto counters = OperationHardwareCounters::get(opCtx))
+            counters->onThreadAttach();
+    }
 }
 
 /**
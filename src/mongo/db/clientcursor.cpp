@@ -27,10 +27,13 @@
  *    it in the license file.
  */
 
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kQuery
+
 #include "mongo/platform/basic.h"
 
 #include "mongo/db/clientcursor.h"
 
+#include <algorithm>
 #include <string>
 #include <time.h>
 #include <vector>
@@ -42,16 +45,25 @@
 #include "mongo/db/auth/authorization_session.h"
 #include "mongo/db/auth/privilege.h"
 #include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog_raii.h"
 #include "mongo/db/client.h"
 #include "mongo/db/commands.h"
 #include "mongo/db/commands/server_status.h"
 #include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/concurrency/d_concurrency.h"
+#include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/cursor_manager.h"
 #include "mongo/db/cursor_server_params.h"
+#include "mongo/db/exec/cursor_spool_stage.h"
 #include "mongo/db/jsobj.h"
+#include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/query/explain.h"
+#include "mongo/db/query/plan_executor_factory.h"
 #include "mongo/db/repl/repl_client_info.h"
 #include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/storage/storage_engine.h"
+#include "mongo/db/storage/write_unit_of_work.h"
+#include "mongo/logv2/log.h"
 #include "mongo/util/background.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
 #include "mongo/util/exit.h"
@@ -67,6 +79,7 @@ static Counter64 cursorStatsOpenNoTimeout;  // gauge
 static Counter64 cursorStatsTimedOut;
 static Counter64 cursorStatsTotalOpened;
 static Counter64 cursorStatsMoreThanOneBatch;
+static Counter64 cursorStatsSpooled;
 
 static ServerStatusMetricField<Counter64> dCursorStatsOpen("cursor.open.total", &cursorStatsOpen);
 static ServerStatusMetricField<Counter64> dCursorStatsOpenPinned("cursor.open.pinned",
@@ -79,6 +92,26 @@ static ServerStatusMetricField<Counter64> dCursorStatsTotalOpened("cursor.totalO
                                                                   &cursorStatsTotalOpened);
 static ServerStatusMetricField<Counter64> dCursorStatsMoreThanOneBatch(
     "cursor.moreThanOneBatch", &cursorStatsMoreThanOneBatch);
+static ServerStatusMetricField<Counter64> dCursorStatsSpooled("cursor.spooled",
+                                                              &cursorStatsSpooled);
+
+namespace {
+
+// The number of spooled results written to the temporary record store per storage transaction.
+constexpr size_t kSpoolWriteBatchSize = 1000;
+
+/**
+ * Drops the temporary record store of a spooled cursor. The cursor is disposed of regardless of
+ * whether its operation was interrupted, so the global lock needed to drop the table is acquired
+ * uninterruptibly.
+ */
+void dropSpool(OperationContext* opCtx, TemporaryRecordStore* spool) {
+    UninterruptibleLockGuard noInterrupt(opCtx->lockState());
+    Lock::GlobalLock lk(opCtx, MODE_IS);
+    spool->finalizeTemporaryTable(opCtx, TemporaryRecordStore::FinalizationAction::kDelete);
+}
+
+}  // namespace
 
 ClientCursor::ClientCursor(ClientCursorParams params,
                            CursorId cursorId,
@@ -138,9 +171,124 @@ void ClientCursor::dispose(OperationContext* opCtx) {
     }
 
     _exec->dispose(opCtx);
+
+    if (_spool) {
+        if (opCtx) {
+            dropSpool(opCtx, _spool.get());
+        } else {
+            // The cursor manager is being destroyed at shutdown, without an operation to drop the
+            // table with. It is dropped along with the other unknown internal idents at the next
+            // startup.
+            _spool.release();
+        }
+    }
+
     _disposed = true;
 }
 
+bool ClientCursor::shouldSpoolResults(Date_t now) const {
+    const auto pinTimeBudget = getCursorSpoolPinTimeBudget();
+    if (pinTimeBudget <= Milliseconds(0) || _spoolAttempted) {
+        return false;
+    }
+    if (isTailable() || _txnNumber ||
+        _exec->lockPolicy() != PlanExecutor::LockPolicy::kLockExternally) {
+        return false;
+    }
+    return now - _createdDate >= pinTimeBudget;
+}
+
+boost::optional<std::vector<BSONObj>> ClientCursor::drainResultsForSpooling() {
+    _spoolAttempted = true;
+
+    const auto memoryBudget = getCursorSpoolMemoryBudgetBytes();
+    std::vector<BSONObj> results;
+    long long bytes = 0;
+    BSONObj obj;
+    while (_exec->getNext(&obj, nullptr) == PlanExecutor::ADVANCED) {
+        bytes += obj.objsize();
+        results.push_back(obj.getOwned());
+        if (bytes > memoryBudget) {
+            for (auto&& result : results) {
+                _exec->enqueue(result);
+            }
+            return boost::none;
+        }
+    }
+    return results;
+}
+
+void ClientCursor::spoolResults(OperationContext* opCtx, std::vector<BSONObj> results) {
+    invariant(!_spool);
+    invariant(!opCtx->lockState()->isLocked());
+
+    std::unique_ptr<TemporaryRecordStore> spool;
+    try {
+        // The results are written without a timestamp, which makes them visible to the spool
+        // reads of later getMores regardless of their read source.
+        ReadSourceScope readSourceScope(opCtx, RecoveryUnit::ReadSource::kNoTimestamp);
+        Lock::GlobalLock lk(opCtx, MODE_IX);
+
+        spool = opCtx->getServiceContext()->getStorageEngine()->makeTemporaryRecordStore(opCtx);
+        for (size_t begin = 0; begin < results.size(); begin += kSpoolWriteBatchSize) {
+            const auto end = std::min(results.size(), begin + kSpoolWriteBatchSize);
+            writeConflictRetry(opCtx, "spoolCursorResults", _nss.ns(), [&] {
+                std::vector<Record> records;
+                records.reserve(end - begin);
+                for (size_t i = begin; i < end; ++i) {
+                    records.push_back(
+                        {RecordId(), RecordData(results[i].objdata(), results[i].objsize())});
+                }
+
+                WriteUnitOfWork wuow(opCtx);
+                uassertStatusOK(spool->rs()->insertRecords(
+                    opCtx, &records, std::vector<Timestamp>(records.size(), Timestamp())));
+                wuow.commit();
+            });
+        }
+    } catch (const DBException& ex) {
+        LOGV2_WARNING(5591708,
+                      "Failed to spool the remaining results of a cursor",
+                      "cursorId"_attr = _cursorid,
+                      "error"_attr = ex.toStatus());
+        if (spool) {
+            dropSpool(opCtx, spool.get());
+        }
+        for (auto&& result : results) {
+            _exec->enqueue(result);
+        }
+        return;
+    }
+
+    auto expCtx =
+        make_intrusive<ExpressionContext>(opCtx, std::unique_ptr<CollatorInterface>(nullptr), _nss);
+    auto ws = std::make_unique<WorkingSet>();
+    auto root = std::make_unique<CursorSpoolStage>(expCtx.get(), ws.get(), spool->rs());
+    auto exec = uassertStatusOK(plan_executor_factory::make(expCtx,
+                                                            std::move(ws),
+                                                            std::move(root),
+                                                            &CollectionPtr::null,
+                                                            PlanYieldPolicy::YieldPolicy::NO_YIELD,
+                                                            false, /* plannerOptions */
+                                                            _exec->nss()));
+    // Like the original executor, the spool executor is disposed of by the cursor.
+    exec.get_deleter().dismissDisposal();
+    exec->saveState();
+    exec->detachFromOperationContext();
+
+    _exec->reattachToOperationContext(opCtx);
+    _exec->dispose(opCtx);
+    _exec = std::move(exec);
+    _spool = std::move(spool);
+    cursorStatsSpooled.increment();
+
+    LOGV2_DEBUG(5591709,
+                1,
+                "Spooled the remaining results of a cursor",
+                "cursorId"_attr = _cursorid,
+                "numResults"_attr = results.size());
+}
+
 GenericCursor ClientCursor::toGenericCursor() const {
     GenericCursor gc;
     gc.setCursorId(cursorid());
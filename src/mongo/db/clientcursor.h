@@ -31,6 +31,7 @@
 
 #include <boost/optional.hpp>
 #include <functional>
+#include <vector>
 
 #include "mongo/db/api_parameters.h"
 #include "mongo/db/auth/privilege.h"
@@ -41,6 +42,7 @@
 #include "mongo/db/query/plan_executor.h"
 #include "mongo/db/record_id.h"
 #include "mongo/db/repl/read_concern_level.h"
+#include "mongo/db/storage/temporary_record_store.h"
 
 namespace mongo {
 
@@ -179,6 +181,35 @@ public:
         return _queryOptions & QueryOption_AwaitData;
     }
 
+    /**
+     * Returns true if the remaining results of this cursor should be spooled by the getMore which
+     * has it pinned. Only non-tailable cursors whose executor reads a single collection outside of
+     * a multi-document transaction are spooled, once they have been open for longer than
+     * 'cursorSpoolPinTimeBudgetMillis', and at most once.
+     */
+    bool shouldSpoolResults(Date_t now) const;
+
+    /**
+     * Drains the remaining results of this cursor for spooling. The executor must be usable. If
+     * the results exceed 'cursorSpoolMemoryBudgetBytes', returns boost::none and queues the drained
+     * results back into the executor, which returns them first.
+     */
+    boost::optional<std::vector<BSONObj>> drainResultsForSpooling();
+
+    /**
+     * Writes 'results', the remaining results of this cursor, to a temporary record store and
+     * replaces the executor of this cursor with one which returns them from there. This releases
+     * the memory and storage engine resources held by the original executor. If the results cannot
+     * be spooled, they are queued back into the original executor instead.
+     *
+     * The cursor must be pinned, its executor saved and detached, and no locks may be held.
+     */
+    void spoolResults(OperationContext* opCtx, std::vector<BSONObj> results);
+
+    bool isSpooled() const {
+        return static_cast<bool>(_spool);
+    }
+
     /**
      * Returns the original command object which created this cursor.
      */
@@ -389,6 +420,13 @@ private:
     // Unused maxTime budget for this cursor.
     Microseconds _leftoverMaxTimeMicros = Microseconds::max();
 
+    // Whether the results of this cursor were drained for spooling, successfully or not.
+    bool _spoolAttempted = false;
+
+    // The temporary record store holding the remaining results of the cursor once they have been
+    // spooled. Declared before '_exec', which reads from it, so that it outlives the executor.
+    std::unique_ptr<TemporaryRecordStore> _spool;
+
     // The underlying query execution machinery. Must be non-null.
     std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> _exec;
 
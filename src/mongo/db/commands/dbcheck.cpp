@@ -45,8 +45,11 @@
 #include "mongo/db/repl/dbcheck.h"
 #include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/optime.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
+#include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/idl/command_generic_argument.h"
 #include "mongo/util/background.h"
+#include "mongo/util/timer.h"
 
 #include "mongo/logv2/log.h"
 
@@ -54,8 +57,12 @@ namespace mongo {
 
 namespace {
 constexpr uint64_t kBatchDocs = 5'000;
+constexpr uint64_t kMinBatchDocs = 100;
 constexpr uint64_t kBatchBytes = 20'000'000;
 
+// How often dbCheck checks the replication lag again while it waits for secondaries to catch up.
+const Milliseconds kReplicationLagCheckInterval{100};
+
 
 /**
  * All the information needed to run dbCheck on a single collection.
@@ -242,15 +249,24 @@ private:
         TimePoint lastStart = Clock::now();
         int64_t docsInCurrentInterval = 0;
 
+        // The size of the batches adapts to how long they take, see _nextBatchDocs().
+        int64_t batchDocs = kBatchDocs;
+
         do {
             using namespace std::literals::chrono_literals;
 
+            if (!_waitForReplicationLag(info.nss)) {
+                _done = true;
+                return;
+            }
+
             if (Clock::now() - lastStart > 1s) {
                 lastStart = Clock::now();
                 docsInCurrentInterval = 0;
             }
 
-            auto result = _runBatch(info, start, kBatchDocs, kBatchBytes);
+            Timer batchTimer;
+            auto result = _runBatch(info, start, batchDocs, kBatchBytes);
 
             if (_done) {
                 return;
@@ -279,6 +295,7 @@ private:
             auto stats = result.getValue();
 
             start = stats.lastKey;
+            batchDocs = _nextBatchDocs(batchDocs, batchTimer.millis());
 
             // Update our running totals.
             totalDocsSeen += stats.nDocs;
@@ -440,6 +457,62 @@ private:
         return result;
     }
 
+    /**
+     * Returns the number of documents of the next batch, given that the last batch of 'batchDocs'
+     * documents took 'batchMillis'. Batches slower than 'dbCheckBatchTargetMillis', e.g. on slow
+     * or busy storage, halve the batch size, and batches faster than half of it double it again.
+     */
+    static int64_t _nextBatchDocs(int64_t batchDocs, long long batchMillis) {
+        const long long targetMillis = repl::dbCheckBatchTargetMillis.load();
+        if (batchMillis > targetMillis) {
+            return std::max<int64_t>(batchDocs / 2, kMinBatchDocs);
+        }
+        if (batchMillis < targetMillis / 2) {
+            return std::min<int64_t>(batchDocs * 2, kBatchDocs);
+        }
+        return batchDocs;
+    }
+
+    /**
+     * Waits while the majority commit point lags behind the last applied optime of this node by
+     * more than 'dbCheckMaxMajorityLagSecs', so that the batches, which secondaries check as they
+     * apply them, do not add to their lag. Returns false if the node stepped down meanwhile.
+     */
+    bool _waitForReplicationLag(const NamespaceString& nss) {
+        auto uniqueOpCtx = Client::getCurrent()->makeOperationContext();
+        auto opCtx = uniqueOpCtx.get();
+        auto coord = repl::ReplicationCoordinator::get(opCtx);
+
+        bool loggedWait = false;
+        while (true) {
+            const Seconds maxLag{repl::dbCheckMaxMajorityLagSecs.load()};
+            if (maxLag == Seconds(0)) {
+                return true;
+            }
+
+            if (!opCtx->checkForInterruptNoAssert().isOK() ||
+                !coord->canAcceptWritesFor_UNSAFE(opCtx, nss)) {
+                return false;
+            }
+
+            const auto lag = coord->getMyLastAppliedOpTimeAndWallTime().wallTime -
+                coord->getLastCommittedOpTimeAndWallTime().wallTime;
+            if (lag <= maxLag) {
+                return true;
+            }
+
+            if (!loggedWait) {
+                LOGV2(5591714,
+                      "dbCheck waiting for the majority commit point to catch up",
+                      "namespace"_attr = nss,
+                      "lag"_attr = duration_cast<Seconds>(lag),
+                      "maxLag"_attr = maxLag);
+                loggedWait = true;
+            }
+            opCtx->sleepFor(kReplicationLagCheckInterval);
+        }
+    }
+
     /**
      * Return `true` iff the primary the check is running on has stepped down.
      */
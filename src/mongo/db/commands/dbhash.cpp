@@ -32,33 +32,161 @@
 #include "mongo/platform/basic.h"
 
 #include <boost/optional.hpp>
+#include <fmt/format.h>
 #include <map>
 #include <set>
 #include <string>
+#include <third_party/murmurhash3/MurmurHash3.h>
 
+#include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/collection_catalog_helper.h"
 #include "mongo/db/catalog/database.h"
 #include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/client.h"
 #include "mongo/db/commands.h"
 #include "mongo/db/commands/test_commands_enabled.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/query/internal_plans.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/storage/storage_engine.h"
 #include "mongo/db/transaction_participant.h"
 #include "mongo/logv2/log.h"
 #include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/md5.hpp"
 #include "mongo/util/net/socket_utils.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/timer.h"
 
 namespace mongo {
 
 namespace {
 
+// How long the threads which help the command hash a collection wait for their locks, before they
+// leave the _id ranges of the collection to the other threads.
+const Milliseconds kRangeHashLockTimeout{100};
+
+// Collections with fewer records are hashed by the thread of the command alone.
+constexpr long long kMinRecordsForParallelHash = 10'000;
+
+// Number of _id ranges per thread, so that the threads finish at about the same time even though
+// the sampled ranges are not of the same size.
+constexpr size_t kRangesPerThread = 4;
+
+// Number of sampled _id values per range, when splitting a collection into _id ranges.
+constexpr size_t kSamplesPerRange = 8;
+
+/**
+ * An order-independent hash of a set of documents: the sum of the 128-bit MurmurHash3 of each
+ * document. Disjoint ranges of a collection can therefore be hashed separately, and their hashes
+ * merged, to the same result whatever the ranges. Unlike the MD5 of dbHash, it does not tell which
+ * documents differ, only that some do.
+ */
+class FastCollectionHash {
+public:
+    void add(const BSONObj& obj) {
+        uint64_t hash[2];
+        MurmurHash3_x64_128(obj.objdata(), obj.objsize(), 0, hash);
+        _hash[0] += hash[0];
+        _hash[1] += hash[1];
+    }
+
+    void merge(const FastCollectionHash& other) {
+        _hash[0] += other._hash[0];
+        _hash[1] += other._hash[1];
+    }
+
+    std::string toString() const {
+        return fmt::format("{:016x}{:016x}", _hash[0], _hash[1]);
+    }
+
+private:
+    uint64_t _hash[2] = {0, 0};
+};
+
+/**
+ * A range of the _id index, from 'start' inclusive to 'end', which is exclusive unless
+ * 'endInclusive'.
+ */
+struct IdRange {
+    BSONObj start;
+    BSONObj end;
+    bool endInclusive;
+};
+
+/**
+ * Splits the _id index of 'collection' into up to 'numRanges' ranges which cover all of it, at
+ * _id values sampled with a random cursor. Returns a single range when the collection is small, or
+ * cannot be sampled, or has a collation, as the keys of its _id index then do not compare like the
+ * sampled values.
+ */
+std::vector<IdRange> splitIdRanges(OperationContext* opCtx,
+                                   const CollectionPtr& collection,
+                                   size_t numRanges) {
+    std::vector<BSONObj> splitKeys;
+    if (numRanges > 1 && !collection->getDefaultCollator() &&
+        collection->numRecords(opCtx) >= kMinRecordsForParallelHash) {
+        if (auto cursor = collection->getRecordStore()->getRandomCursor(opCtx)) {
+            std::vector<BSONObj> samples;
+            while (samples.size() < numRanges * kSamplesPerRange) {
+                auto record = cursor->next();
+                if (!record) {
+                    break;
+                }
+                samples.push_back(BSON("" << record->data.toBson()["_id"]));
+            }
+
+            std::sort(
+                samples.begin(), samples.end(), SimpleBSONObjComparator::kInstance.makeLessThan());
+            for (size_t i = kSamplesPerRange; i < samples.size(); i += kSamplesPerRange) {
+                if (splitKeys.empty() ||
+                    SimpleBSONObjComparator::kInstance.evaluate(splitKeys.back() < samples[i])) {
+                    splitKeys.push_back(samples[i]);
+                }
+            }
+        }
+    }
+
+    std::vector<IdRange> ranges;
+    BSONObj start = BSON("" << MINKEY);
+    for (const auto& splitKey : splitKeys) {
+        ranges.push_back({start, splitKey, false});
+        start = splitKey;
+    }
+    ranges.push_back({start, BSON("" << MAXKEY), true});
+    return ranges;
+}
+
+/**
+ * Adds the documents of 'collection' in 'range' of its _id index 'desc' to 'hash'.
+ */
+void hashIdRange(OperationContext* opCtx,
+                 const CollectionPtr& collection,
+                 const IndexDescriptor* desc,
+                 const IdRange& range,
+                 FastCollectionHash* hash) {
+    auto exec = InternalPlanner::indexScan(opCtx,
+                                           &collection,
+                                           desc,
+                                           range.start,
+                                           range.end,
+                                           range.endInclusive
+                                               ? BoundInclusion::kIncludeBothStartAndEndKeys
+                                               : BoundInclusion::kIncludeStartKeyOnly,
+                                           PlanYieldPolicy::YieldPolicy::NO_YIELD,
+                                           InternalPlanner::FORWARD,
+                                           InternalPlanner::IXSCAN_FETCH);
+    BSONObj obj;
+    while (exec->getNext(&obj, nullptr) == PlanExecutor::ADVANCED) {
+        hash->add(obj);
+    }
+}
+
 class DBHashCmd : public ErrmsgCommandDeprecated {
 public:
     DBHashCmd() : ErrmsgCommandDeprecated("dbHash", "dbhash") {}
@@ -118,6 +246,9 @@ public:
                            BSONObjBuilder& result) {
         Timer timer;
 
+        // Hash the collections with FastCollectionHash rather than MD5, in parallel _id ranges.
+        const bool fastHash = cmdObj["fastHash"].trueValue();
+
         std::set<std::string> desiredCollections;
         if (cmdObj["collections"].type() == Array) {
             BSONObjIterator i(cmdObj["collections"].Obj());
@@ -267,7 +398,7 @@ public:
                 collectionToUUIDMap.emplace(collNss.coll().toString(), collection->uuid());
 
                 // Compute the hash for this collection.
-                std::string hash = _hashCollection(opCtx, db, collNss);
+                std::string hash = _hashCollection(opCtx, db, collNss, fastHash);
 
                 collectionToHashMap[collNss.coll().toString()] = hash;
 
@@ -313,7 +444,10 @@ public:
     }
 
 private:
-    std::string _hashCollection(OperationContext* opCtx, Database* db, const NamespaceString& nss) {
+    std::string _hashCollection(OperationContext* opCtx,
+                                Database* db,
+                                const NamespaceString& nss,
+                                bool fastHash) {
 
         CollectionPtr collection =
             CollectionCatalog::get(opCtx)->lookupCollectionByNamespace(opCtx, nss);
@@ -345,6 +479,10 @@ private:
 
         auto desc = collection->getIndexCatalog()->findIdIndex(opCtx);
 
+        if (fastHash && (desc || collection->isCapped())) {
+            return _fastHashCollection(opCtx, nss, collection, desc);
+        }
+
         std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> exec;
         if (desc) {
             exec = InternalPlanner::indexScan(opCtx,
@@ -392,6 +530,147 @@ private:
         return hash;
     }
 
+    /**
+     * Hashes the collection with FastCollectionHash. The ranges of its _id index are hashed by the
+     * thread of the command and by up to 'dbHashMaxThreads' - 1 other threads, each with its own
+     * operation context, which read the same data: the locks of the command keep the collection
+     * from changing, or all the threads read at the same timestamp.
+     */
+    std::string _fastHashCollection(OperationContext* opCtx,
+                                    const NamespaceString& nss,
+                                    const CollectionPtr& collection,
+                                    const IndexDescriptor* desc) {
+        FastCollectionHash hash;
+
+        if (!desc) {
+            // Capped collections without an _id index are hashed in their natural order.
+            auto exec = InternalPlanner::collectionScan(
+                opCtx, nss.ns(), &collection, PlanYieldPolicy::YieldPolicy::NO_YIELD);
+            BSONObj obj;
+            while (exec->getNext(&obj, nullptr) == PlanExecutor::ADVANCED) {
+                hash.add(obj);
+            }
+            return hash.toString();
+        }
+
+        const size_t numThreads = repl::dbHashMaxThreads.load();
+        const auto ranges = splitIdRanges(opCtx, collection, numThreads * kRangesPerThread);
+        AtomicWord<size_t> nextRange{0};
+
+        auto mutex = MONGO_MAKE_LATCH("DBHashCmd::fastHashCollection");
+        stdx::condition_variable threadsDone;
+        size_t numRunningThreads = 0;
+        std::vector<OperationContext*> threadOpCtxs;
+        Status threadStatus = Status::OK();
+
+        // Hashes the ranges which no thread has started to hash yet.
+        auto hashRanges = [&](OperationContext* rangeOpCtx,
+                              const CollectionPtr& rangeCollection,
+                              const IndexDescriptor* rangeDesc) {
+            FastCollectionHash rangesHash;
+            for (size_t i = nextRange.fetchAndAdd(1); i < ranges.size();
+                 i = nextRange.fetchAndAdd(1)) {
+                hashIdRange(rangeOpCtx, rangeCollection, rangeDesc, ranges[i], &rangesHash);
+            }
+
+            stdx::lock_guard<Latch> lk(mutex);
+            hash.merge(rangesHash);
+        };
+
+        boost::optional<Timestamp> readTimestamp;
+        if (opCtx->recoveryUnit()->getTimestampReadSource() ==
+            RecoveryUnit::ReadSource::kProvided) {
+            readTimestamp = opCtx->recoveryUnit()->getPointInTimeReadTimestamp(opCtx);
+        }
+        const auto prepareConflictBehavior = opCtx->recoveryUnit()->getPrepareConflictBehavior();
+        auto serviceContext = opCtx->getServiceContext();
+
+        auto hashRangesOnThread = [&] {
+            ThreadClient tc("dbHash", serviceContext);
+            auto threadOpCtx = cc().makeOperationContext();
+            {
+                stdx::lock_guard<Latch> lk(mutex);
+                threadOpCtxs.push_back(threadOpCtx.get());
+            }
+
+            Status status = Status::OK();
+            try {
+                if (readTimestamp) {
+                    threadOpCtx->recoveryUnit()->setTimestampReadSource(
+                        RecoveryUnit::ReadSource::kProvided, readTimestamp);
+                }
+                threadOpCtx->recoveryUnit()->setPrepareConflictBehavior(prepareConflictBehavior);
+
+                // The command already holds the locks which keep the collection from changing, so
+                // intent locks are enough, and they must not wait for oplog application.
+                ShouldNotConflictWithSecondaryBatchApplicationBlock noPBWM(
+                    threadOpCtx->lockState());
+                const auto deadline = Date_t::now() + kRangeHashLockTimeout;
+                Lock::DBLock dbLock(threadOpCtx.get(), nss.db(), MODE_IS, deadline);
+                Lock::CollectionLock collLock(threadOpCtx.get(), nss, MODE_IS, deadline);
+
+                auto threadCollection = CollectionCatalog::get(threadOpCtx.get())
+                                            ->lookupCollectionByNamespace(threadOpCtx.get(), nss);
+                invariant(threadCollection);
+                hashRanges(threadOpCtx.get(),
+                           threadCollection,
+                           threadCollection->getIndexCatalog()->findIdIndex(threadOpCtx.get()));
+            } catch (const ExceptionFor<ErrorCodes::LockTimeout>&) {
+                // Leave the ranges to the other threads.
+            } catch (const DBException& ex) {
+                status = ex.toStatus();
+            }
+
+            stdx::lock_guard<Latch> lk(mutex);
+            threadOpCtxs.erase(
+                std::find(threadOpCtxs.begin(), threadOpCtxs.end(), threadOpCtx.get()));
+            if (!status.isOK() && threadStatus.isOK()) {
+                threadStatus = std::move(status);
+            }
+            if (--numRunningThreads == 0) {
+                threadsDone.notify_all();
+            }
+        };
+
+        std::vector<stdx::thread> threads;
+        ON_BLOCK_EXIT([&] {
+            // Stop the other threads if the command failed.
+            nextRange.store(ranges.size());
+            {
+                stdx::lock_guard<Latch> lk(mutex);
+                for (auto threadOpCtx : threadOpCtxs) {
+                    stdx::lock_guard<Client> clientLock(*threadOpCtx->getClient());
+                    serviceContext->killOperation(clientLock, threadOpCtx, ErrorCodes::Interrupted);
+                }
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+        });
+        for (size_t i = 1; i < std::min(numThreads, ranges.size()); ++i) {
+            {
+                stdx::lock_guard<Latch> lk(mutex);
+                ++numRunningThreads;
+            }
+            threads.emplace_back(hashRangesOnThread);
+        }
+
+        try {
+            hashRanges(opCtx, collection, desc);
+        } catch (DBException& exception) {
+            LOGV2_WARNING(
+                5591713, "Error while hashing, db possibly dropped", "namespace"_attr = nss);
+            exception.addContext("Plan executor error while running dbHash command");
+            throw;
+        }
+
+        stdx::unique_lock<Latch> lk(mutex);
+        opCtx->waitForConditionOrInterrupt(
+            threadsDone, lk, [&] { return numRunningThreads == 0; });
+        uassertStatusOK(threadStatus);
+        return hash.toString();
+    }
+
 } dbhashCmd;
 
 }  // namespace
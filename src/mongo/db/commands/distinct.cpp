@@ -309,7 +309,7 @@ public:
         }
         curOp->debug().setPlanSummaryMetrics(stats);
 
-        if (curOp->shouldDBProfile(opCtx)) {
+        if (curOp->shouldCaptureExecStats(opCtx)) {
             auto&& [stats, _] =
                 explainer.getWinningPlanStats(ExplainOptions::Verbosity::kExecStats);
             curOp->debug().execStats = std::move(stats);
@@ -97,40 +97,12 @@ BSONObj makeTimeseriesIndexSpecKey(const TimeseriesOptions& timeseriesOptions,
 
     BSONObjBuilder builder;
     for (const auto& elem : origKey) {
-        // Determine if the index requested on the time field is ascending or descending.
-        // The final index spec will be subjected to a more complete validation in
-        // index_key_validate::validateKeyPattern().
-        if (elem.fieldNameStringData() == timeField) {
-            uassert(
-                ErrorCodes::IndexNotFound,
-                str::stream() << "Invalid index spec for time-series collection: "
-                              << redact(origCmd.toBSON({}))  // 'origKey' is included in 'origCmd'
-                              << ". Indexes on the time field must be ascending or descending "
-                                 "(numbers only): "
-                              << elem,
-                elem.isNumber());
-            if (elem.number() >= 0) {
-                builder.appendAs(elem, str::stream() << "control.min." << timeField);
-                builder.appendAs(elem, str::stream() << "control.max." << timeField);
-            } else {
-                builder.appendAs(elem, str::stream() << "control.max." << timeField);
-                builder.appendAs(elem, str::stream() << "control.min." << timeField);
-            }
-            continue;
-        }
-
-        uassert(ErrorCodes::IndexNotFound,
-                str::stream() << "Invalid index spec for time-series collection: "
-                              << redact(origCmd.toBSON({}))  // 'origKey' is included in 'origCmd'
-                              << ". Index must be on the '" << timeField << "' field: " << elem,
-                metaField);
-
-        if (elem.fieldNameStringData() == *metaField) {
+        if (metaField && elem.fieldNameStringData() == *metaField) {
             builder.appendAs(elem, BucketUnpacker::kBucketMetaFieldName);
             continue;
         }
 
-        if (elem.fieldNameStringData().startsWith(*metaField + ".")) {
+        if (metaField && elem.fieldNameStringData().startsWith(*metaField + ".")) {
             builder.appendAs(elem,
                              str::stream()
                                  << BucketUnpacker::kBucketMetaFieldName << "."
@@ -138,11 +110,25 @@ BSONObj makeTimeseriesIndexSpecKey(const TimeseriesOptions& timeseriesOptions,
             continue;
         }
 
-        uasserted(ErrorCodes::IndexNotFound,
-                  str::stream() << "Invalid index spec for time-series collection: "
-                                << redact(origCmd.toBSON({}))  // 'origKey' is included in 'origCmd'
-                                << ". Index must be either on the '" << *metaField << "' or '"
-                                << timeField << "' fields: " << elem);
+        // The time field and measurement fields are indexed through the bounds of each bucket in
+        // its control field, which lets queries on them skip buckets without unpacking them.
+        // Determine if the index requested is ascending or descending. The final index spec will
+        // be subjected to a more complete validation in index_key_validate::validateKeyPattern().
+        auto field = elem.fieldNameStringData();
+        uassert(ErrorCodes::IndexNotFound,
+                str::stream() << "Invalid index spec for time-series collection: "
+                              << redact(origCmd.toBSON({}))  // 'origKey' is included in 'origCmd'
+                              << ". Indexes on the "
+                              << (field == timeField ? "time field" : "measurement fields")
+                              << " must be ascending or descending (numbers only): " << elem,
+                elem.isNumber());
+        if (elem.number() >= 0) {
+            builder.appendAs(elem, str::stream() << "control.min." << field);
+            builder.appendAs(elem, str::stream() << "control.max." << field);
+        } else {
+            builder.appendAs(elem, str::stream() << "control.max." << field);
+            builder.appendAs(elem, str::stream() << "control.min." << field);
+        }
     }
     return builder.obj();
 }
@@ -388,7 +388,7 @@ write_ops::FindAndModifyReply CmdFindAndModify::Invocation::writeConflictRetryRe
     // Fill out OpDebug with the number of deleted docs.
     opDebug->additiveMetrics.ndeleted = docFound ? 1 : 0;
 
-    if (curOp->shouldDBProfile(opCtx)) {
+    if (curOp->shouldCaptureExecStats(opCtx)) {
         auto&& explainer = exec->getPlanExplainer();
         auto&& [stats, _] = explainer.getWinningPlanStats(ExplainOptions::Verbosity::kExecStats);
         curOp->debug().execStats = std::move(stats);
@@ -481,7 +481,7 @@ write_ops::FindAndModifyReply CmdFindAndModify::Invocation::writeConflictRetryUp
     write_ops_exec::recordUpdateResultInOpDebug(exec->getUpdateResult(), opDebug);
     opDebug->setPlanSummaryMetrics(summaryStats);
 
-    if (curOp->shouldDBProfile(opCtx)) {
+    if (curOp->shouldCaptureExecStats(opCtx)) {
         auto&& [stats, _] = explainer.getWinningPlanStats(ExplainOptions::Verbosity::kExecStats);
         curOp->debug().execStats = std::move(stats);
     }
@@ -468,6 +468,14 @@ public:
 
             const FindCommand& originalFC = exec->getCanonicalQuery()->getFindCommand();
 
+            // Size the reply for the whole first batch up front, since growing the buffer copies
+            // everything appended so far.
+            if (auto bytes = FindCommon::estimateFirstBatchBytes(
+                    originalFC, collection->averageObjectSize(opCtx));
+                bytes > static_cast<std::size_t>(FindCommon::kInitReplyBufferSize)) {
+                result->reserveBytes(bytes);
+            }
+
             // Stream query results, adding them to a BSONArray as we go.
             CursorResponseBuilder::Options options;
             options.isInitialResponse = true;
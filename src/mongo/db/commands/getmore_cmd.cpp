@@ -51,6 +51,7 @@
 #include "mongo/db/query/getmore_request.h"
 #include "mongo/db/query/plan_executor.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/read_concern.h"
 #include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/replication_coordinator.h"
@@ -314,12 +315,20 @@ public:
             // timeout to the user.
             BSONObj obj;
             PlanExecutor::ExecState state;
+
+            // The batches of an exhaust cursor are sent without waiting for the client to ask for
+            // them, so they can be kept small to start sending documents sooner.
+            const int maxBatchBytes = opCtx->isExhaust()
+                ? std::min(internalQueryExhaustGetMoreMaxBatchBytes.load(),
+                           FindCommon::kMaxBytesToReturnToClientAtOnce)
+                : FindCommon::kMaxBytesToReturnToClientAtOnce;
             try {
                 while (!FindCommon::enoughForGetMore(request.batchSize.value_or(0), *numResults) &&
                        PlanExecutor::ADVANCED == (state = exec->getNext(&obj, nullptr))) {
                     // If adding this object will cause us to exceed the message size limit, then we
                     // stash it for later.
-                    if (!FindCommon::haveSpaceForNext(obj, *numResults, nextBatch->bytesUsed())) {
+                    if (!FindCommon::haveSpaceForNext(
+                            obj, *numResults, nextBatch->bytesUsed(), maxBatchBytes)) {
                         exec->enqueue(obj);
                         break;
                     }
@@ -365,11 +374,16 @@ public:
             return shouldSaveCursorGetMore(exec, isTailable);
         }
 
-        void acquireLocksAndIterateCursor(OperationContext* opCtx,
-                                          rpc::ReplyBuilderInterface* reply,
-                                          CursorManager* cursorManager,
-                                          ClientCursorPin& cursorPin,
-                                          CurOp* curOp) {
+        /**
+         * Generates the next batch of the cursor. Returns the remaining results of the cursor if
+         * they were drained to be spooled, which must happen after the locks are released.
+         */
+        boost::optional<std::vector<BSONObj>> acquireLocksAndIterateCursor(
+            OperationContext* opCtx,
+            rpc::ReplyBuilderInterface* reply,
+            CursorManager* cursorManager,
+            ClientCursorPin& cursorPin,
+            CurOp* curOp) {
             // Cursors come in one of two flavors:
             //
             // - Cursors which read from a single collection, such as those generated via the
@@ -634,16 +648,22 @@ public:
             // generate the stats eagerly for all operations due to cost.
             if (cursorPin->getExecutor()->lockPolicy() !=
                     PlanExecutor::LockPolicy::kLocksInternally &&
-                curOp->shouldDBProfile(opCtx)) {
+                curOp->shouldCaptureExecStats(opCtx)) {
                 auto&& explainer = exec->getPlanExplainer();
                 auto&& [stats, _] =
                     explainer.getWinningPlanStats(ExplainOptions::Verbosity::kExecStats);
                 curOp->debug().execStats = std::move(stats);
             }
 
+            boost::optional<std::vector<BSONObj>> resultsToSpool;
             if (shouldSaveCursor) {
                 respondWithId = _request.cursorid;
 
+                if (cursorPin->shouldSpoolResults(
+                        opCtx->getServiceContext()->getPreciseClockSource()->now())) {
+                    resultsToSpool = cursorPin->drainResultsForSpooling();
+                }
+
                 exec->saveState();
                 exec->detachFromOperationContext();
 
@@ -680,6 +700,8 @@ public:
                     reply->setNextInvocation(boost::none);
                 }
             }
+
+            return resultsToSpool;
         }
 
         void run(OperationContext* opCtx, rpc::ReplyBuilderInterface* reply) override {
@@ -715,7 +737,11 @@ public:
             const auto isLinearizableReadConcern = cursorPin->getReadConcernArgs().getLevel() ==
                 repl::ReadConcernLevel::kLinearizableReadConcern;
 
-            acquireLocksAndIterateCursor(opCtx, reply, cursorManager, cursorPin, curOp);
+            auto resultsToSpool =
+                acquireLocksAndIterateCursor(opCtx, reply, cursorManager, cursorPin, curOp);
+            if (resultsToSpool && !resultsToSpool->empty()) {
+                cursorPin->spoolResults(opCtx, std::move(*resultsToSpool));
+            }
 
             if (isLinearizableReadConcern) {
                 // waitForLinearizableReadConcern performs a NoOp write and waits for that write
@@ -66,6 +66,7 @@
 #include "mongo/db/query/plan_executor_factory.h"
 #include "mongo/db/query/plan_summary_stats.h"
 #include "mongo/db/query/query_planner_common.h"
+#include "mongo/db/query/query_result_cache.h"
 #include "mongo/db/read_concern.h"
 #include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/read_concern_args.h"
@@ -531,6 +532,54 @@ void performValidationChecks(const OperationContext* opCtx,
     aggregation_request_helper::validateRequestForAPIVersion(opCtx, request);
 }
 
+/**
+ * Returns true if the reply to 'request' may be served from, and stored in, the query result
+ * cache: the aggregation must run directly on a cached collection, see the latest committed data,
+ * and return the same results whenever that data is the same.
+ */
+bool canUseQueryResultCache(OperationContext* opCtx,
+                            const NamespaceString& origNss,
+                            const NamespaceString& nss,
+                            const AggregateCommand& request,
+                            const LiteParsedPipeline& liteParsedPipeline) {
+    if (origNss != nss || request.getExplain() || request.getExchange() ||
+        request.getLegacyRuntimeConstants() || opCtx->inMultiDocumentTransaction() ||
+        !liteParsedPipeline.getInvolvedNamespaces().empty() ||
+        !QueryResultCache::get(opCtx->getServiceContext())->isCachedNamespace(nss)) {
+        return false;
+    }
+
+    const auto& readConcernArgs = repl::ReadConcernArgs::get(opCtx);
+    if ((readConcernArgs.getLevel() != repl::ReadConcernLevel::kLocalReadConcern &&
+         readConcernArgs.getLevel() != repl::ReadConcernLevel::kAvailableReadConcern) ||
+        readConcernArgs.getArgsOpTime() || readConcernArgs.getArgsAfterClusterTime() ||
+        readConcernArgs.getArgsAtClusterTime()) {
+        return false;
+    }
+
+    return QueryResultCache::isDeterministic(request.getPipeline(),
+                                             request.getLet().get_value_or(BSONObj()));
+}
+
+/**
+ * Builds the key of the query result cache for an aggregation on the collection with 'uuid', from
+ * the fields of 'cmdObj' which determine its reply.
+ */
+BSONObj makeQueryResultCacheKey(const UUID& uuid, const BSONObj& cmdObj) {
+    BSONObjBuilder keyBuilder;
+    uuid.appendToBuilder(&keyBuilder, "uuid");
+    for (auto&& fieldName : {AggregateCommand::kPipelineFieldName,
+                             AggregateCommand::kCollationFieldName,
+                             AggregateCommand::kLetFieldName,
+                             AggregateCommand::kHintFieldName,
+                             AggregateCommand::kCursorFieldName}) {
+        if (auto elem = cmdObj[fieldName]) {
+            keyBuilder.append(elem);
+        }
+    }
+    return keyBuilder.obj();
+}
+
 }  // namespace
 
 Status runAggregate(OperationContext* opCtx,
@@ -568,6 +617,12 @@ Status runAggregate(OperationContext* opCtx,
     // re-running the expanded aggregation.
     boost::optional<AutoGetCollectionForReadCommandMaybeLockFree> ctx;
 
+    // The version of 'nss' in the query result cache, if the reply to this aggregation may be
+    // cached, and the key it is cached under.
+    auto queryResultCache = QueryResultCache::get(opCtx->getServiceContext());
+    boost::optional<QueryResultCache::Version> queryResultCacheVersion;
+    BSONObj queryResultCacheKey;
+
     std::vector<unique_ptr<PlanExecutor, PlanExecutor::Deleter>> execs;
     boost::intrusive_ptr<ExpressionContext> expCtx;
     auto curOp = CurOp::get(opCtx);
@@ -637,6 +692,12 @@ Status runAggregate(OperationContext* opCtx,
             collatorToUse.emplace(PipelineD::resolveCollator(
                 opCtx, request.getCollation().get_value_or(BSONObj()), nullptr));
         } else {
+            // The version must be read before the collection is locked, since a lock-free read
+            // opens its snapshot as it acquires the collection.
+            if (canUseQueryResultCache(opCtx, origNss, nss, request, liteParsedPipeline)) {
+                queryResultCacheVersion = queryResultCache->getVersion(nss);
+            }
+
             // This is a regular aggregation. Lock the collection or view.
             ctx.emplace(opCtx, nss, AutoGetCollectionViewMode::kViewsPermitted);
             collatorToUse.emplace(PipelineD::resolveCollator(
@@ -707,6 +768,16 @@ Status runAggregate(OperationContext* opCtx,
                     uuid && uuid == *request.getCollectionUUID());
         }
 
+        if (queryResultCacheVersion && uuid && !ShardingState::get(opCtx)->enabled()) {
+            queryResultCacheKey = makeQueryResultCacheKey(*uuid, cmdObj);
+            if (auto cachedReply = queryResultCache->lookup(nss, queryResultCacheKey)) {
+                result->getBodyBuilder().appendElements(*cachedReply);
+                return Status::OK();
+            }
+        } else {
+            queryResultCacheVersion = boost::none;
+        }
+
         invariant(collatorToUse);
         expCtx = makeExpressionContext(opCtx, request, std::move(*collatorToUse), uuid);
 
@@ -859,6 +930,12 @@ Status runAggregate(OperationContext* opCtx,
             opCtx, expCtx, origNss, std::move(cursors), request, cmdObj, result);
         if (keepCursor) {
             cursorFreer.dismiss();
+        } else if (queryResultCacheVersion) {
+            // The whole result fit in the first batch, so the reply can be served again as is.
+            queryResultCache->insert(nss,
+                                     queryResultCacheKey,
+                                     *queryResultCacheVersion,
+                                     result->getBodyBuilder().asTempObj().getOwned());
         }
 
         PlanSummaryStats stats;
@@ -37,6 +37,7 @@
 #include "mongo/db/commands/server_status_internal.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/stats/counters.h"
+#include "mongo/logv2/async_backend.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/net/http_client.h"
 #include "mongo/util/net/socket_utils.h"
@@ -260,6 +261,27 @@ public:
 
 } asserts;
 
+class AsyncLogging : public ServerStatusSection {
+public:
+    AsyncLogging() : ServerStatusSection("asyncLogging") {}
+
+    bool includeByDefault() const override {
+        return true;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        auto& stats = logv2::AsyncBackendStats::get();
+        BSONObjBuilder bob;
+        bob.append("queued", stats.queued.loadRelaxed());
+        bob.append("written", stats.written.loadRelaxed());
+        bob.append("dropped", stats.dropped.loadRelaxed());
+        bob.append("blocked", stats.blocked.loadRelaxed());
+        return bob.obj();
+    }
+
+} asyncLogging;
+
 class MemBase : public ServerStatusMetric {
 public:
     MemBase() : ServerStatusMetric(".mem.bits") {}
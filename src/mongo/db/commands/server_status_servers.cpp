@@ -30,6 +30,7 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/config.h"
+#include "mongo/db/auth/authentication_session.h"
 #include "mongo/db/commands/server_status.h"
 #include "mongo/transport/message_compressor_registry.h"
 #include "mongo/transport/service_entry_point.h"
@@ -122,6 +123,7 @@ public:
 
         BSONObjBuilder auth;
         authCounter.append(&auth);
+        AuthenticationSession::appendConcurrentStepStats(&auth);
         result.append("authentication", auth.obj());
 
 #ifdef MONGO_CONFIG_SSL
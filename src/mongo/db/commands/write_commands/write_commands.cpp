@@ -64,6 +64,7 @@
 #include "mongo/db/stats/counters.h"
 #include "mongo/db/storage/duplicate_key_error_info.h"
 #include "mongo/db/timeseries/bucket_catalog.h"
+#include "mongo/db/timeseries/bucket_compression.h"
 #include "mongo/db/transaction_participant.h"
 #include "mongo/db/views/view_catalog.h"
 #include "mongo/db/write_concern.h"
@@ -119,9 +120,6 @@ bool isTimeseries(OperationContext* opCtx, const NamespaceString& ns) {
     return view->timeseries().has_value();
 }
 
-// Default for control.version in time-series bucket collection.
-const int kTimeseriesControlVersion = 1;
-
 /**
  * Transforms a single time-series insert to an update request on an existing bucket.
  */
@@ -217,7 +215,7 @@ BSONArray makeTimeseriesInsertDocument(const BucketCatalog::BucketId& bucketId,
         bucketBuilder.append("_id", *bucketId);
         {
             BSONObjBuilder bucketControlBuilder(bucketBuilder.subobjStart("control"));
-            bucketControlBuilder.append("version", kTimeseriesControlVersion);
+            bucketControlBuilder.append("version", timeseries::kTimeseriesControlDefaultVersion);
             bucketControlBuilder.append("min", data.bucketMin);
             bucketControlBuilder.append("max", data.bucketMax);
         }
@@ -0,0 +1,299 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kStorage
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/compaction_monitor.h"
+
+#include <algorithm>
+
+#include "mongo/base/counter.h"
+#include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/catalog/collection_catalog.h"
+#include "mongo/db/catalog/collection_compact.h"
+#include "mongo/db/client.h"
+#include "mongo/db/commands/fsync_locked.h"
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/compaction_monitor_gen.h"
+#include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/service_context.h"
+#include "mongo/logv2/log.h"
+#include "mongo/util/background.h"
+#include "mongo/util/concurrency/idle_thread_block.h"
+#include "mongo/util/scopeguard.h"
+#include "mongo/util/timer.h"
+
+namespace mongo {
+
+class CompactionMonitor;
+
+namespace {
+
+const auto getCompactionMonitor =
+    ServiceContext::declareDecoration<std::unique_ptr<CompactionMonitor>>();
+
+Counter64 compactionPasses;
+Counter64 compactionCollectionsCompacted;
+Counter64 compactionFailures;
+Counter64 compactionBytesFreed;
+
+ServerStatusMetricField<Counter64> compactionPassesDisplay("compaction.passes", &compactionPasses);
+ServerStatusMetricField<Counter64> compactionCollectionsCompactedDisplay(
+    "compaction.collectionsCompacted", &compactionCollectionsCompacted);
+ServerStatusMetricField<Counter64> compactionFailuresDisplay("compaction.failures",
+                                                             &compactionFailures);
+ServerStatusMetricField<Counter64> compactionBytesFreedDisplay("compaction.bytesFreed",
+                                                               &compactionBytesFreed);
+
+/**
+ * Reports the progress of the current compaction pass: the collection being compacted, and how
+ * many of the collections picked for the pass are still waiting for their turn. An empty document
+ * means that no pass is in progress.
+ */
+class CompactionProgressMetric final : public ServerStatusMetric {
+public:
+    CompactionProgressMetric() : ServerStatusMetric("compaction.progress") {}
+
+    void appendAtLeaf(BSONObjBuilder& b) const final {
+        stdx::lock_guard<Latch> lk(_mutex);
+        BSONObjBuilder progressBob(b.subobjStart(_leafName));
+        if (_current) {
+            progressBob.append("namespace", _current->ns());
+            progressBob.append("remainingCollections", _remaining);
+        }
+        progressBob.done();
+    }
+
+    void update(boost::optional<NamespaceString> current, long long remaining) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _current = std::move(current);
+        _remaining = remaining;
+    }
+
+private:
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("CompactionProgressMetric::_mutex");
+    boost::optional<NamespaceString> _current;
+    long long _remaining = 0;
+} compactionProgress;
+
+}  // namespace
+
+class CompactionMonitor : public BackgroundJob {
+public:
+    CompactionMonitor() : BackgroundJob(false /* selfDelete */) {}
+
+    static CompactionMonitor* get(ServiceContext* serviceCtx) {
+        return getCompactionMonitor(serviceCtx).get();
+    }
+
+    static void set(ServiceContext* serviceCtx, std::unique_ptr<CompactionMonitor> monitor) {
+        auto& compactionMonitor = getCompactionMonitor(serviceCtx);
+        if (compactionMonitor) {
+            invariant(!compactionMonitor->running(),
+                      "Tried to reset the CompactionMonitor without shutting down the original "
+                      "instance.");
+        }
+
+        invariant(monitor);
+        compactionMonitor = std::move(monitor);
+    }
+
+    std::string name() const {
+        return "CompactionMonitor";
+    }
+
+    void run() {
+        ThreadClient tc(name(), getGlobalServiceContext());
+        AuthorizationSession::get(cc())->grantInternalAuthorization(&cc());
+
+        {
+            stdx::lock_guard<Client> lk(*tc.get());
+            tc.get()->setSystemOperationKillableByStepdown(lk);
+        }
+
+        while (_sleepFor(Seconds(compactionMonitorSleepSecs.load()))) {
+            if (!compactionMonitorEnabled.load() || lockedForWriting()) {
+                continue;
+            }
+
+            try {
+                doCompactionPass();
+            } catch (const ExceptionForCat<ErrorCategory::Interruption>& interruption) {
+                LOGV2_DEBUG(5591724,
+                            1,
+                            "CompactionMonitor was interrupted",
+                            "interruption"_attr = interruption);
+            }
+            compactionProgress.update(boost::none, 0);
+        }
+    }
+
+    /**
+     * Signals the thread to quit and then waits until it does.
+     */
+    void shutdown() {
+        LOGV2(5591725, "Shutting down the compaction monitor thread");
+        {
+            stdx::lock_guard<Latch> lk(_stateMutex);
+            _shuttingDown = true;
+            _shuttingDownCV.notify_one();
+        }
+        wait();
+        LOGV2(5591726, "Finished shutting down the compaction monitor thread");
+    }
+
+private:
+    /**
+     * Waits for 'duration', and returns false if a shutdown was requested in the meantime.
+     */
+    bool _sleepFor(Milliseconds duration) {
+        auto deadline = Date_t::now() + duration;
+        stdx::unique_lock<Latch> lk(_stateMutex);
+
+        MONGO_IDLE_THREAD_BLOCK;
+        _shuttingDownCV.wait_until(lk, deadline.toSystemTimePoint(), [&] { return _shuttingDown; });
+        return !_shuttingDown;
+    }
+
+    /**
+     * Returns the collections which the storage engine reports to have at least
+     * 'compactionMonitorMinFreeBytes' of reusable space, the ones with the most first.
+     */
+    std::vector<std::pair<int64_t, NamespaceString>> getCandidates(OperationContext* opCtx) {
+        const auto minFreeBytes = compactionMonitorMinFreeBytes.load();
+        std::vector<std::pair<int64_t, NamespaceString>> candidates;
+
+        auto collectionCatalog = CollectionCatalog::get(opCtx);
+        for (auto&& dbName : collectionCatalog->getAllDbNames()) {
+            if (dbName == NamespaceString::kLocalDb) {
+                continue;
+            }
+            for (auto&& nss : collectionCatalog->getAllCollectionNamesFromDb(opCtx, dbName)) {
+                AutoGetCollectionForRead coll(opCtx, nss);
+                if (!coll || !coll->getRecordStore()->compactSupported()) {
+                    continue;
+                }
+                auto freeBytes = coll->getRecordStore()->freeStorageSize(opCtx);
+                if (freeBytes > 0 && freeBytes >= minFreeBytes) {
+                    candidates.emplace_back(freeBytes, nss);
+                }
+            }
+        }
+
+        std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) {
+            return a.first > b.first;
+        });
+        return candidates;
+    }
+
+    /**
+     * Compacts the collections returned by getCandidates() one at a time, waiting in between so
+     * that no more than 'compactionMonitorMaxDutyCyclePercent' of the time is spent compacting.
+     */
+    void doCompactionPass() {
+        const ServiceContext::UniqueOperationContext opCtxPtr = cc().makeOperationContext();
+        OperationContext* opCtx = opCtxPtr.get();
+
+        // If part of replSet but not in a readable state (e.g. during initial sync), skip.
+        auto replCoord = repl::ReplicationCoordinator::get(opCtx);
+        if (replCoord->getReplicationMode() == repl::ReplicationCoordinator::modeReplSet &&
+            !replCoord->getMemberState().readable())
+            return;
+
+        ON_BLOCK_EXIT([&] { compactionPasses.increment(); });
+
+        auto candidates = getCandidates(opCtx);
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            const auto& nss = candidates[i].second;
+            compactionProgress.update(nss, candidates.size() - i - 1);
+
+            Timer timer;
+            StatusWith<int64_t> bytesFreed = Status::OK();
+            try {
+                bytesFreed = compactCollection(opCtx, nss);
+            } catch (const ExceptionForCat<ErrorCategory::Interruption>&) {
+                throw;
+            } catch (const DBException& ex) {
+                bytesFreed = ex.toStatus();
+            }
+
+            if (bytesFreed.isOK()) {
+                compactionCollectionsCompacted.increment();
+                compactionBytesFreed.increment(std::max(bytesFreed.getValue(), int64_t(0)));
+            } else {
+                compactionFailures.increment();
+                LOGV2_DEBUG(5591727,
+                            1,
+                            "Background compaction of collection failed",
+                            "namespace"_attr = nss,
+                            "error"_attr = bytesFreed.getStatus());
+            }
+
+            // Leave the storage engine alone for long enough to keep to the duty cycle, and stop if
+            // the monitor was disabled or is shutting down in the meantime.
+            const auto dutyCyclePercent = compactionMonitorMaxDutyCyclePercent.load();
+            const auto elapsed = Milliseconds(timer.millis());
+            if (!_sleepFor(elapsed * (100 - dutyCyclePercent) / dutyCyclePercent) ||
+                !compactionMonitorEnabled.load()) {
+                return;
+            }
+        }
+    }
+
+    // Protects the state below.
+    mutable Mutex _stateMutex = MONGO_MAKE_LATCH("CompactionMonitorStateMutex");
+
+    // Signaled to wake up the thread, if the thread is waiting. The thread will check whether
+    // _shuttingDown is set and stop accordingly.
+    mutable stdx::condition_variable _shuttingDownCV;
+
+    bool _shuttingDown = false;
+};
+
+void startCompactionMonitor(ServiceContext* serviceContext) {
+    std::unique_ptr<CompactionMonitor> compactionMonitor = std::make_unique<CompactionMonitor>();
+    compactionMonitor->go();
+    CompactionMonitor::set(serviceContext, std::move(compactionMonitor));
+}
+
+void shutdownCompactionMonitor(ServiceContext* serviceContext) {
+    CompactionMonitor* compactionMonitor = CompactionMonitor::get(serviceContext);
+    // We allow the CompactionMonitor not to be set in case shutdown occurs before the thread has
+    // been initialized.
+    if (compactionMonitor) {
+        compactionMonitor->shutdown();
+    }
+}
+
+}  // namespace mongo
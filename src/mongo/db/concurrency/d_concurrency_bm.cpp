@@ -29,18 +29,66 @@
 #define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kTest
 
 #include "mongo/platform/basic.h"
+
+#include <algorithm>
 #include <benchmark/benchmark.h>
+#include <chrono>
 
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/concurrency/lock_manager_test_help.h"
 #include "mongo/db/storage/recovery_unit_noop.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/concurrency/ticketholder.h"
 
 namespace mongo {
 namespace {
 
 const int kMaxPerfThreads = 16;  // max number of threads to use for lock perf
+const int kMaxContendedThreads = 256;  // max number of threads for the mixed workloads
+const int kTicketsPerMode = 128;       // matches the default number of read and write tickets
+const int kNumCollections = 8;
+
+/**
+ * Records the latency of each operation run by one benchmark thread, and reports the median and
+ * tail latencies in microseconds. The percentiles of each thread are averaged over all threads.
+ */
+class LatencyRecorder {
+public:
+    LatencyRecorder() {
+        _latencies.reserve(1 << 20);
+    }
+
+    void start() {
+        _start = std::chrono::steady_clock::now();
+    }
+
+    void stop() {
+        _latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                 std::chrono::steady_clock::now() - _start)
+                                 .count());
+    }
+
+    void report(benchmark::State& state) {
+        if (_latencies.empty()) {
+            return;
+        }
+        std::sort(_latencies.begin(), _latencies.end());
+        auto percentile = [&](double p) {
+            auto index = std::min(_latencies.size() - 1, size_t(p * _latencies.size()));
+            return benchmark::Counter(_latencies[index] / 1000.0,
+                                      benchmark::Counter::kAvgThreads);
+        };
+        state.counters["p50_us"] = percentile(0.5);
+        state.counters["p99_us"] = percentile(0.99);
+        state.counters["p999_us"] = percentile(0.999);
+        state.counters["max_us"] = percentile(1.0);
+    }
+
+private:
+    std::chrono::steady_clock::time_point _start;
+    std::vector<int64_t> _latencies;
+};
 
 
 class DConcurrencyTest : public benchmark::Fixture {
@@ -154,6 +202,69 @@ BENCHMARK_DEFINE_F(DConcurrencyTest, BM_CollectionExclusiveLock)(benchmark::Stat
     }
 }
 
+/**
+ * Models a mixed workload over a handful of collections: most operations read under Global,
+ * Database and Collection IS locks, one in twenty writes under IX locks, and one in a thousand
+ * takes a collection S or X lock as DDL would. Every operation acquires a read or write ticket
+ * through its global lock, so threads beyond the number of tickets queue for them.
+ */
+BENCHMARK_DEFINE_F(DConcurrencyTest, BM_MixedWorkload)(benchmark::State& state) {
+    static TicketHolder readTickets(kTicketsPerMode);
+    static TicketHolder writeTickets(kTicketsPerMode);
+    static const std::vector<NamespaceString> namespaces = [] {
+        std::vector<NamespaceString> namespaces;
+        for (int i = 0; i < kNumCollections; ++i) {
+            namespaces.emplace_back("test", "coll" + std::to_string(i));
+        }
+        return namespaces;
+    }();
+
+    if (state.thread_index == 0) {
+        makeKClientsWithLockers(state.threads);
+        Locker::setGlobalThrottling(&readTickets, &writeTickets);
+    }
+
+    LatencyRecorder latencies;
+    uint64_t iteration = state.thread_index;
+    for (auto keepRunning : state) {
+        auto opCtx = clients[state.thread_index].second.get();
+        const auto& nss = namespaces[iteration % kNumCollections];
+        const auto op = iteration++ % 1000;
+
+        latencies.start();
+        if (op == 0) {
+            Lock::DBLock dlk(opCtx, nss.db(), MODE_IX);
+            Lock::CollectionLock clk(opCtx, nss, (iteration / 1000) % 2 ? MODE_S : MODE_X);
+        } else if (op % 20 == 0) {
+            Lock::DBLock dlk(opCtx, nss.db(), MODE_IX);
+            Lock::CollectionLock clk(opCtx, nss, MODE_IX);
+        } else {
+            Lock::DBLock dlk(opCtx, nss.db(), MODE_IS);
+            Lock::CollectionLock clk(opCtx, nss, MODE_IS);
+        }
+        latencies.stop();
+    }
+    latencies.report(state);
+
+    if (state.thread_index == 0) {
+        Locker::setGlobalThrottling(nullptr, nullptr);
+        clients.clear();
+    }
+}
+
+BENCHMARK_DEFINE_F(DConcurrencyTest, BM_TicketAcquisition)(benchmark::State& state) {
+    static TicketHolder tickets(kTicketsPerMode);
+
+    LatencyRecorder latencies;
+    for (auto keepRunning : state) {
+        latencies.start();
+        tickets.waitForTicket();
+        tickets.release();
+        latencies.stop();
+    }
+    latencies.report(state);
+}
+
 BENCHMARK_REGISTER_F(DConcurrencyTest, BM_StdMutex)->ThreadRange(1, kMaxPerfThreads);
 
 BENCHMARK_REGISTER_F(DConcurrencyTest, BM_ResourceMutexShared)->ThreadRange(1, kMaxPerfThreads);
@@ -167,5 +278,12 @@ BENCHMARK_REGISTER_F(DConcurrencyTest, BM_CollectionIntentExclusiveLock)
 BENCHMARK_REGISTER_F(DConcurrencyTest, BM_CollectionSharedLock)->ThreadRange(1, kMaxPerfThreads);
 BENCHMARK_REGISTER_F(DConcurrencyTest, BM_CollectionExclusiveLock)->ThreadRange(1, kMaxPerfThreads);
 
+BENCHMARK_REGISTER_F(DConcurrencyTest, BM_MixedWorkload)
+    ->ThreadRange(1, kMaxContendedThreads)
+    ->UseRealTime();
+BENCHMARK_REGISTER_F(DConcurrencyTest, BM_TicketAcquisition)
+    ->ThreadRange(1, kMaxContendedThreads)
+    ->UseRealTime();
+
 }  // namespace
 }  // namespace mongo
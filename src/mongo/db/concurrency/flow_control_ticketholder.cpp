@@ -33,6 +33,10 @@
 
 #include "mongo/db/concurrency/flow_control_ticketholder.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 #include "mongo/db/operation_context.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/time_support.h"
@@ -87,9 +91,81 @@ void FlowControlTicketholder::refreshTo(int numTickets) {
                 "tickets"_attr = _tickets,
                 "numTickets"_attr = numTickets);
     _tickets = numTickets;
+    _ticketsPerSecond = 0;
+    _chargeExemptWrites.store(false);
+    _cv.notify_all();
+}
+
+void FlowControlTicketholder::refillAtRate(int ticketsPerSecond,
+                                           Milliseconds maxBurst,
+                                           bool chargeExemptWrites) {
+    invariant(ticketsPerSecond >= 0);
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (_ticketsPerSecond > 0) {
+        // The time since the last refill is refilled at the previous rate.
+        _refill(lk);
+    } else {
+        _lastRefillMicros = curTimeMicros64();
+        _partialTicket = 0.0;
+    }
+
+    _ticketsPerSecond = ticketsPerSecond;
+    _maxBurstTickets = static_cast<int>(std::min<std::int64_t>(
+        std::numeric_limits<int>::max(),
+        std::max<std::int64_t>(
+            1, std::int64_t{ticketsPerSecond} * durationCount<Milliseconds>(maxBurst) / 1000)));
+    _tickets = std::min(_tickets, _maxBurstTickets);
+    _chargeExemptWrites.store(chargeExemptWrites);
     _cv.notify_all();
 }
 
+void FlowControlTicketholder::_refill(WithLock) {
+    if (_ticketsPerSecond == 0) {
+        return;
+    }
+
+    const auto now = curTimeMicros64();
+    const double refilled = _partialTicket +
+        static_cast<double>(now - _lastRefillMicros) * _ticketsPerSecond / 1000 / 1000;
+    _lastRefillMicros = now;
+
+    const double wholeTickets = std::floor(refilled);
+    if (_tickets + wholeTickets >= _maxBurstTickets) {
+        _tickets = _maxBurstTickets;
+        _partialTicket = 0.0;
+    } else {
+        _tickets += static_cast<int>(wholeTickets);
+        _partialTicket = refilled - wholeTickets;
+    }
+}
+
+Milliseconds FlowControlTicketholder::_timeUntilNextTicket(WithLock) const {
+    const Milliseconds kMaxWait{500};
+    if (_ticketsPerSecond == 0) {
+        return kMaxWait;
+    }
+
+    // The tickets may be in debt, in which case more than one must be refilled.
+    const double missingTickets = 1 - _tickets - _partialTicket;
+    const auto waitMillis =
+        static_cast<std::int64_t>(std::ceil(missingTickets * 1000 / _ticketsPerSecond));
+    return std::min(kMaxWait, Milliseconds(std::max<std::int64_t>(1, waitMillis)));
+}
+
+void FlowControlTicketholder::chargeExemptTicket() {
+    if (!_chargeExemptWrites.load()) {
+        return;
+    }
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (_ticketsPerSecond == 0) {
+        return;
+    }
+    _refill(lk);
+    _tickets = std::max(_tickets - 1, -_maxBurstTickets);
+    _totalExemptAcquisitions.fetchAndAddRelaxed(1);
+}
+
 void FlowControlTicketholder::getTicket(OperationContext* opCtx,
                                         FlowControlTicketholder::CurOp* stats) {
     stdx::unique_lock<Latch> lk(_mutex);
@@ -97,9 +173,11 @@ void FlowControlTicketholder::getTicket(OperationContext* opCtx,
         return;
     }
 
+    _refill(lk);
     LOGV2_DEBUG(20519, 4, "Taking ticket.", "Available"_attr = _tickets);
-    if (_tickets == 0) {
+    if (_tickets <= 0) {
         ++stats->acquireWaitCount;
+        _totalThrottledAcquisitions.fetchAndAddRelaxed(1);
     }
 
     auto currentWaitTime = curTimeMicros64();
@@ -119,8 +197,10 @@ void FlowControlTicketholder::getTicket(OperationContext* opCtx,
     });
 
     // getTicket() should block until there are tickets or the Ticketholder is in shutdown
-    while (!opCtx->waitForConditionOrInterruptFor(
-        _cv, lk, Milliseconds(500), [&] { return _tickets > 0 || _inShutdown; })) {
+    while (!opCtx->waitForConditionOrInterruptFor(_cv, lk, _timeUntilNextTicket(lk), [&] {
+        _refill(lk);
+        return _tickets > 0 || _inShutdown;
+    })) {
         updateTotalTime();
     }
 
@@ -33,6 +33,8 @@
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
+#include "mongo/util/concurrency/with_lock.h"
+#include "mongo/util/duration.h"
 
 namespace mongo {
 
@@ -49,7 +51,8 @@ class ServiceContext;
  * In the context of flow control, clients take a ticket and do not return them to the pool. There
  * is an external service that calculates the maximum number of tickets that should be allotted for
  * the next time period (one second). The consumers will call `getTicket` and the producer will call
- * `refreshTo`.
+ * `refreshTo`. Alternatively, the producer may call `refillAtRate` to have the tickets refilled
+ * continuously over the period instead of all at once at its start.
  */
 class FlowControlTicketholder {
 public:
@@ -81,22 +84,75 @@ public:
 
     void refreshTo(int numTickets);
 
+    /**
+     * Refills the tickets continuously at 'ticketsPerSecond' until the next call to refreshTo() or
+     * refillAtRate(). At most 'maxBurst' worth of tickets accumulate while they are not taken. If
+     * 'chargeExemptWrites' is true, the writes exempt from flow control are charged to the
+     * tickets.
+     */
+    void refillAtRate(int ticketsPerSecond, Milliseconds maxBurst, bool chargeExemptWrites);
+
     void getTicket(OperationContext* opCtx, FlowControlTicketholder::CurOp* stats);
 
+    /**
+     * Charges a write which is exempt from flow control, such as an internal write or the commit
+     * of a transaction, to the tickets refilled by refillAtRate() without waiting for one. The
+     * tickets may go into debt by up to the maximum burst, which the throttled writes then wait
+     * to be refilled.
+     */
+    void chargeExemptTicket();
+
     std::int64_t totalTimeAcquiringMicros() const {
         return _totalTimeAcquiringMicros.load();
     }
 
+    /**
+     * Returns the number of tickets which were not available when they were asked for.
+     */
+    std::int64_t totalThrottledAcquisitions() const {
+        return _totalThrottledAcquisitions.load();
+    }
+
+    /**
+     * Returns the number of writes exempt from flow control which were charged to the tickets.
+     */
+    std::int64_t totalExemptAcquisitions() const {
+        return _totalExemptAcquisitions.load();
+    }
+
     void setInShutdown();
 
 private:
+    /**
+     * Adds the tickets refilled since the last refill, when refilling at a rate.
+     */
+    void _refill(WithLock);
+
+    /**
+     * Returns how long to wait for the next ticket to be available.
+     */
+    Milliseconds _timeUntilNextTicket(WithLock) const;
+
     // Use an int64_t as this is serialized to bson which does not support unsigned 64-bit numbers.
     AtomicWord<std::int64_t> _totalTimeAcquiringMicros;
+    AtomicWord<std::int64_t> _totalThrottledAcquisitions{0};
+    AtomicWord<std::int64_t> _totalExemptAcquisitions{0};
+
+    // Lets the exempt writes skip taking the mutex when they are not charged.
+    AtomicWord<bool> _chargeExemptWrites{false};
 
     Mutex _mutex = MONGO_MAKE_LATCH("FlowControlTicketHolder::_mutex");
     stdx::condition_variable _cv;
     int _tickets;
 
+    // While '_ticketsPerSecond' is positive, '_tickets' are refilled at that rate, up to
+    // '_maxBurstTickets'. '_partialTicket' holds the fraction of the next ticket refilled as of
+    // '_lastRefillMicros'.
+    int _ticketsPerSecond = 0;
+    int _maxBurstTickets = 0;
+    double _partialTicket = 0.0;
+    std::uint64_t _lastRefillMicros = 0;
+
     bool _inShutdown;  // used to synchronize shutdown of the ticket refresher job
 };
 
@@ -0,0 +1,215 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/concurrency/hot_document_tracker.h"
+
+#include <algorithm>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/concurrency/hot_document_tracker_gen.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+
+const auto getWriteTarget =
+    OperationContext::declareDecoration<boost::optional<std::pair<UUID, RecordId>>>();
+
+}  // namespace
+
+HotDocumentTracker::Turn& HotDocumentTracker::Turn::operator=(Turn&& other) {
+    release();
+    _tracker = other._tracker;
+    _document = std::move(other._document);
+    return *this;
+}
+
+HotDocumentTracker::Turn::~Turn() {
+    release();
+}
+
+void HotDocumentTracker::Turn::release() {
+    if (_document) {
+        _tracker->_releaseTurn(_document.get());
+        _document.reset();
+    }
+}
+
+HotDocumentTracker& HotDocumentTracker::get() {
+    static HotDocumentTracker tracker;
+    return tracker;
+}
+
+void HotDocumentTracker::noteWriteTarget(OperationContext* opCtx,
+                                         const UUID& uuid,
+                                         const RecordId& rid) {
+    getWriteTarget(opCtx).emplace(uuid, rid);
+}
+
+void HotDocumentTracker::clearWriteTarget(OperationContext* opCtx) {
+    getWriteTarget(opCtx).reset();
+}
+
+HotDocumentTracker::Turn HotDocumentTracker::onWriteConflict(OperationContext* opCtx,
+                                                             StringData ns,
+                                                             Turn previousTurn) {
+    previousTurn.release();
+
+    auto& target = getWriteTarget(opCtx);
+    stdx::unique_lock<Latch> lk(_mutex);
+    ++_namespaceConflicts[ns.toString()];
+    if (!target) {
+        return {};
+    }
+
+    auto key = std::move(*target);
+    target.reset();
+
+    auto it = _documents.find(key);
+    if (it == _documents.end()) {
+        if (_documents.size() >= kMaxTrackedDocuments && !_evictDocument(lk)) {
+            return {};
+        }
+        auto document = std::make_shared<Document>(
+            DocumentStats{ns.toString(), key.first, key.second, 0, 0});
+        it = _documents.emplace(std::move(key), std::move(document)).first;
+    }
+
+    auto document = it->second;
+    ++document->stats.writeConflicts;
+
+    const auto threshold = gHotDocumentWriteConflictThreshold.load();
+    if (threshold == 0 || document->stats.writeConflicts < threshold) {
+        return {};
+    }
+
+    if (document->turnTaken) {
+        ++document->stats.queuedRetries;
+        ++document->numWaiting;
+        ON_BLOCK_EXIT([&] { --document->numWaiting; });
+
+        // The holder may itself be stuck behind something this operation holds, so rather than
+        // waiting indefinitely, fall back to an ordinary retry.
+        auto deadline = Date_t::now() + Milliseconds(gHotDocumentMaxQueueWaitMillis.load());
+        if (!opCtx->waitForConditionOrInterruptUntil(
+                document->cv, lk, deadline, [&] { return !document->turnTaken; })) {
+            return {};
+        }
+    }
+
+    document->turnTaken = true;
+    return Turn(this, std::move(document));
+}
+
+void HotDocumentTracker::_releaseTurn(Document* document) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    document->turnTaken = false;
+    document->cv.notify_all();
+}
+
+bool HotDocumentTracker::_evictDocument(WithLock) {
+    auto victim = _documents.end();
+    for (auto it = _documents.begin(); it != _documents.end(); ++it) {
+        const auto& document = *it->second;
+        if (document.turnTaken || document.numWaiting > 0) {
+            continue;
+        }
+        if (victim == _documents.end() ||
+            document.stats.writeConflicts < victim->second->stats.writeConflicts) {
+            victim = it;
+        }
+    }
+
+    if (victim == _documents.end()) {
+        return false;
+    }
+    _documents.erase(victim);
+    return true;
+}
+
+std::vector<HotDocumentTracker::DocumentStats> HotDocumentTracker::getTopDocuments(
+    size_t limit) const {
+    std::vector<DocumentStats> documents;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        documents.reserve(_documents.size());
+        for (const auto& [_, document] : _documents) {
+            documents.push_back(document->stats);
+        }
+    }
+
+    auto byWriteConflicts = [](const auto& lhs, const auto& rhs) {
+        return lhs.writeConflicts > rhs.writeConflicts;
+    };
+    if (documents.size() > limit) {
+        std::partial_sort(
+            documents.begin(), documents.begin() + limit, documents.end(), byWriteConflicts);
+        documents.erase(documents.begin() + limit, documents.end());
+    } else {
+        std::sort(documents.begin(), documents.end(), byWriteConflicts);
+    }
+    return documents;
+}
+
+void HotDocumentTracker::appendStats(BSONObjBuilder* builder, size_t numDocuments) const {
+    {
+        BSONObjBuilder namespacesBuilder(builder->subobjStart("namespaces"));
+        stdx::lock_guard<Latch> lk(_mutex);
+        for (const auto& [ns, writeConflicts] : _namespaceConflicts) {
+            namespacesBuilder.append(ns, writeConflicts);
+        }
+    }
+
+    BSONArrayBuilder documentsBuilder(builder->subarrayStart("documents"));
+    for (const auto& stats : getTopDocuments(numDocuments)) {
+        BSONObjBuilder documentBuilder(documentsBuilder.subobjStart());
+        documentBuilder.append("ns", stats.ns);
+        stats.uuid.appendToBuilder(&documentBuilder, "uuid");
+        stats.recordId.serialize(&documentBuilder);
+        documentBuilder.append("writeConflicts", stats.writeConflicts);
+        documentBuilder.append("queuedRetries", stats.queuedRetries);
+    }
+}
+
+void HotDocumentTracker::clear() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _namespaceConflicts.clear();
+    for (auto it = _documents.begin(); it != _documents.end();) {
+        // Keep the documents which operations are taking turns on.
+        if (it->second->turnTaken || it->second->numWaiting > 0) {
+            ++it;
+        } else {
+            it = _documents.erase(it);
+        }
+    }
+}
+
+}  // namespace mongo
@@ -0,0 +1,163 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mongo/base/string_data.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/record_id.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/concurrency/with_lock.h"
+#include "mongo/util/uuid.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+
+/**
+ * Counts WriteConflictExceptions per namespace and per document, and keeps the operations which
+ * conflict repeatedly on the same document from retrying all at once.
+ *
+ * Collection writes note the document they are writing with noteWriteTarget() for as long as they
+ * write it, and writeConflictRetry() and the PlanExecutor attribute each WriteConflictException to
+ * the noted document. Once a
+ * document has caused hotDocumentWriteConflictThreshold conflicts, the operations retrying a write
+ * to it take turns: only the holder of the document's Turn retries, while the others wait for it
+ * to finish, for at most hotDocumentMaxQueueWaitMillis. Operations which have not conflicted never
+ * wait.
+ */
+class HotDocumentTracker {
+    HotDocumentTracker(const HotDocumentTracker&) = delete;
+    HotDocumentTracker& operator=(const HotDocumentTracker&) = delete;
+
+    struct Document;
+
+public:
+    /**
+     * The right to retry writing a hot document. Handed to the next waiting operation once
+     * released or destroyed.
+     */
+    class Turn {
+    public:
+        Turn() = default;
+        Turn(Turn&& other) = default;
+        Turn& operator=(Turn&& other);
+        ~Turn();
+
+        explicit operator bool() const {
+            return bool(_document);
+        }
+
+        void release();
+
+    private:
+        friend class HotDocumentTracker;
+
+        Turn(HotDocumentTracker* tracker, std::shared_ptr<Document> document)
+            : _tracker(tracker), _document(std::move(document)) {}
+
+        HotDocumentTracker* _tracker = nullptr;
+        std::shared_ptr<Document> _document;
+    };
+
+    struct DocumentStats {
+        std::string ns;
+        UUID uuid;
+        RecordId recordId;
+        long long writeConflicts = 0;
+        long long queuedRetries = 0;
+    };
+
+    HotDocumentTracker() = default;
+
+    /**
+     * Returns the tracker of all of the operations in the process.
+     */
+    static HotDocumentTracker& get();
+
+    /**
+     * Notes that 'opCtx' is writing the document 'rid' of collection 'uuid', so that a write
+     * conflict is attributed to it. The write clears the note once it succeeds.
+     */
+    static void noteWriteTarget(OperationContext* opCtx, const UUID& uuid, const RecordId& rid);
+    static void clearWriteTarget(OperationContext* opCtx);
+
+    /**
+     * Counts a write conflict in namespace 'ns' against the document last noted for 'opCtx'. Any
+     * turn held by the conflicting attempt is released first. If the document is hot, waits for
+     * and returns the turn to retry writing it. Otherwise, or if the wait times out, returns an
+     * empty Turn.
+     */
+    Turn onWriteConflict(OperationContext* opCtx, StringData ns, Turn previousTurn);
+
+    /**
+     * Returns the statistics of the at most 'limit' tracked documents with the most write
+     * conflicts, from the most to the fewest.
+     */
+    std::vector<DocumentStats> getTopDocuments(size_t limit) const;
+
+    /**
+     * Appends the write conflict counts of every namespace and of the most conflicted documents.
+     */
+    void appendStats(BSONObjBuilder* builder, size_t numDocuments) const;
+
+    void clear();
+
+private:
+    static constexpr size_t kMaxTrackedDocuments = 1024;
+
+    struct Document {
+        explicit Document(DocumentStats stats) : stats(std::move(stats)) {}
+
+        DocumentStats stats;
+        bool turnTaken = false;
+        int numWaiting = 0;
+        stdx::condition_variable cv;
+    };
+
+    void _releaseTurn(Document* document);
+
+    // Evicts the least conflicted document which no operation holds or waits for the turn of.
+    // Returns false if there is none.
+    bool _evictDocument(WithLock);
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("HotDocumentTracker::_mutex");
+    std::map<std::pair<UUID, RecordId>, std::shared_ptr<Document>> _documents;
+    stdx::unordered_map<std::string, long long> _namespaceConflicts;
+};
+
+}  // namespace mongo
@@ -0,0 +1,142 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/client.h"
+#include "mongo/db/concurrency/hot_document_tracker.h"
+#include "mongo/db/concurrency/hot_document_tracker_gen.h"
+#include "mongo/db/service_context_test_fixture.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+
+class HotDocumentTrackerTest : public ServiceContextTest {
+public:
+    HotDocumentTrackerTest() {
+        _originalThreshold = gHotDocumentWriteConflictThreshold.load();
+        _originalMaxWait = gHotDocumentMaxQueueWaitMillis.load();
+        gHotDocumentWriteConflictThreshold.store(2);
+    }
+
+    ~HotDocumentTrackerTest() {
+        gHotDocumentWriteConflictThreshold.store(_originalThreshold);
+        gHotDocumentMaxQueueWaitMillis.store(_originalMaxWait);
+    }
+
+protected:
+    HotDocumentTracker::Turn conflict(OperationContext* opCtx, const RecordId& rid) {
+        HotDocumentTracker::noteWriteTarget(opCtx, uuid, rid);
+        return tracker.onWriteConflict(opCtx, "db.coll"_sd, {});
+    }
+
+    HotDocumentTracker tracker;
+    const UUID uuid = UUID::gen();
+
+private:
+    long long _originalThreshold;
+    int _originalMaxWait;
+};
+
+TEST_F(HotDocumentTrackerTest, CountsConflictsPerNamespaceAndDocument) {
+    auto opCtx = makeOperationContext();
+    ASSERT_FALSE(conflict(opCtx.get(), RecordId(1)));
+    ASSERT_FALSE(conflict(opCtx.get(), RecordId(2)));
+
+    // Without a noted document, only the namespace is counted.
+    ASSERT_FALSE(tracker.onWriteConflict(opCtx.get(), "db.other"_sd, {}));
+
+    // The second conflict on a document makes it hot, and the conflicting operation gets the turn.
+    ASSERT_TRUE(conflict(opCtx.get(), RecordId(1)));
+
+    auto top = tracker.getTopDocuments(10);
+    ASSERT_EQ(2U, top.size());
+    ASSERT_EQ(RecordId(1), top[0].recordId);
+    ASSERT_EQ(uuid, top[0].uuid);
+    ASSERT_EQ("db.coll", top[0].ns);
+    ASSERT_EQ(2, top[0].writeConflicts);
+    ASSERT_EQ(RecordId(2), top[1].recordId);
+    ASSERT_EQ(1, top[1].writeConflicts);
+
+    BSONObjBuilder bob;
+    tracker.appendStats(&bob, 1);
+    auto stats = bob.obj();
+    ASSERT_BSONOBJ_EQ(BSON("db.coll" << 3 << "db.other" << 1), stats["namespaces"].Obj());
+    ASSERT_EQ(1U, stats["documents"].Array().size());
+
+    tracker.clear();
+    ASSERT(tracker.getTopDocuments(10).empty());
+}
+
+TEST_F(HotDocumentTrackerTest, WaiterTakesTurnOnceReleased) {
+    auto opCtx = makeOperationContext();
+    conflict(opCtx.get(), RecordId(1));
+    auto turn = conflict(opCtx.get(), RecordId(1));
+    ASSERT_TRUE(turn);
+
+    gHotDocumentMaxQueueWaitMillis.store(60 * 1000);
+    AtomicWord<bool> gotTurn{false};
+    stdx::thread waiter([&] {
+        ThreadClient tc("waiter", getServiceContext());
+        auto waiterOpCtx = tc->makeOperationContext();
+        gotTurn.store(bool(conflict(waiterOpCtx.get(), RecordId(1))));
+    });
+    ON_BLOCK_EXIT([&] {
+        if (waiter.joinable()) {
+            waiter.join();
+        }
+    });
+
+    while (tracker.getTopDocuments(1)[0].queuedRetries == 0) {
+        sleepmillis(1);
+    }
+    ASSERT_FALSE(gotTurn.load());
+    turn.release();
+    waiter.join();
+    ASSERT_TRUE(gotTurn.load());
+}
+
+TEST_F(HotDocumentTrackerTest, WaitForTurnTimesOut) {
+    auto opCtx = makeOperationContext();
+    conflict(opCtx.get(), RecordId(1));
+    auto turn = conflict(opCtx.get(), RecordId(1));
+    ASSERT_TRUE(turn);
+
+    gHotDocumentMaxQueueWaitMillis.store(1);
+    auto otherClient = getServiceContext()->makeClient("other");
+    auto otherOpCtx = otherClient->makeOperationContext();
+    ASSERT_FALSE(conflict(otherOpCtx.get(), RecordId(1)));
+    ASSERT_EQ(1, tracker.getTopDocuments(1)[0].queuedRetries);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -413,9 +413,11 @@ void LockHead::migratePartitionedLockHeads() {
 // Have more buckets than CPUs to reduce contention on lock and caches
 const unsigned LockManager::_numLockBuckets(128);
 
-// Balance scalability of intent locks against potential added cost of conflicting locks.
-// The exact value doesn't appear very important, but should be power of two
-const unsigned LockManager::_numPartitions = 32;
+// Balance scalability of intent locks against potential added cost of conflicting locks, which
+// have to migrate the requests from every partition that holds the resource. There should be
+// enough partitions that lockers running on different cores rarely share one, and the value
+// should be a power of two.
+const unsigned LockManager::_numPartitions = 128;
 
 // static
 std::map<LockerId, BSONObj> LockManager::getLockToClientMap(ServiceContext* serviceContext) {
@@ -37,7 +37,9 @@
 
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/bson/json.h"
+#include "mongo/db/client.h"
 #include "mongo/db/concurrency/flow_control_ticketholder.h"
+#include "mongo/db/concurrency/resource_wait_tracker.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/flow_control.h"
@@ -63,10 +65,10 @@ namespace {
  * buckets to minimize concurrent access conflicts.
  *
  * Each client has a LockerId that monotonically increases across all client instances. The
- * LockerId % 8 is used to index into one of 8 LockStats instances. These LockStats objects must be
- * atomically accessed, so maintaining 8 that are indexed by LockerId reduces client conflicts and
- * improves concurrent write access. A reader, to collect global lock statics for reporting, will
- * sum the results of all 8 disjoint 'buckets' of stats.
+ * LockerId % 64 is used to index into one of 64 LockStats instances. These LockStats objects must
+ * be atomically accessed, so maintaining 64 that are indexed by LockerId reduces client conflicts
+ * and improves concurrent write access. A reader, to collect global lock statics for reporting,
+ * will sum the results of all 64 disjoint 'buckets' of stats.
  */
 class PartitionedInstanceWideLockStats {
     PartitionedInstanceWideLockStats(const PartitionedInstanceWideLockStats&) = delete;
@@ -106,7 +108,9 @@ private:
         AtomicLockStats stats;
     };
 
-    enum { NumPartitions = 8 };
+    // Every lock acquisition increments a counter in its locker's partition, so there should be
+    // enough partitions that the lockers running on different cores rarely share one.
+    enum { NumPartitions = 64 };
 
 
     AtomicLockStats& _get(LockerId id) {
@@ -359,10 +363,22 @@ bool LockerImpl::_acquireTicket(OperationContext* opCtx, LockMode mode, Date_t d
         if (opCtx)
             invariant(!opCtx->recoveryUnit()->isTimestamped());
 
+        // Operations run by internal threads, such as replication, are admitted ahead of the user
+        // operations.
+        auto priority = TicketPriority::kInteractive;
+        if (opCtx && opCtx->getClient() && !opCtx->getClient()->isFromUserConnection()) {
+            priority = TicketPriority::kInternal;
+        } else if (_hasRestoredLockState) {
+            priority = TicketPriority::kBatch;
+        }
+
         OperationContext* interruptible = _uninterruptibleLocksRequested ? nullptr : opCtx;
+        const uint64_t startOfWaitTime = curTimeMicros64();
+        ON_BLOCK_EXIT(
+            [&] { _ticketWaitMicros.fetchAndAdd(curTimeMicros64() - startOfWaitTime); });
         if (deadline == Date_t::max()) {
-            holder->waitForTicket(interruptible);
-        } else if (!holder->waitForTicketUntil(interruptible, deadline)) {
+            holder->waitForTicket(interruptible, priority);
+        } else if (!holder->waitForTicketUntil(interruptible, deadline, priority)) {
             return false;
         }
         restoreStateOnErrorGuard.dismiss();
@@ -800,6 +816,8 @@ void LockerImpl::restoreLockState(OperationContext* opCtx, const Locker::LockSna
         getFlowControlTicket(opCtx, state.globalMode);
     }
 
+    _hasRestoredLockState = true;
+
     std::vector<OneLock>::const_iterator it = state.locks.begin();
     // If we locked the PBWM, it must be locked before the resourceIdGlobal and
     // resourceIdReplicationStateTransitionLock resources.
@@ -941,6 +959,11 @@ void LockerImpl::_lockComplete(OperationContext* opCtx,
     const uint64_t startOfTotalWaitTime = curTimeMicros64();
     uint64_t startOfCurrentWaitTime = startOfTotalWaitTime;
 
+    // Charge the whole wait to the resource, whether or not the lock is eventually granted.
+    ON_BLOCK_EXIT([&] {
+        ResourceWaitTracker::get().recordWait(resId, startOfCurrentWaitTime - startOfTotalWaitTime);
+    });
+
     while (true) {
         // It is OK if this call wakes up spuriously, because we re-evaluate the remaining
         // wait time anyways.
@@ -1010,6 +1033,10 @@ void LockerImpl::getFlowControlTicket(OperationContext* opCtx, LockMode lockMode
         // hole.
         invariant(!opCtx->recoveryUnit()->isTimestamped());
         ticketholder->getTicket(opCtx, &_flowControlStats);
+    } else if (ticketholder && lockMode == LockMode::MODE_IX && _clientState.load() == kInactive) {
+        // Writes exempt from flow control, such as internal writes and transaction commits, do not
+        // wait for a ticket but are still charged to the tickets when they are refilled at a rate.
+        ticketholder->chargeExemptTicket();
     }
 }
 
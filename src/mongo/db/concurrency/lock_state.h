@@ -212,6 +212,10 @@ public:
         return _flowControlStats;
     }
 
+    Microseconds getTicketWaitTime() const override {
+        return Microseconds{_ticketWaitMicros.load()};
+    }
+
     //
     // Below functions are for testing only.
     //
@@ -349,6 +353,10 @@ private:
     // Indicates whether the client is active reader/writer or is queued.
     AtomicWord<ClientState> _clientState{kInactive};
 
+    // Set once the Locker has restored a lock state it saved to yield. Operations which yield are
+    // long-running, so they are admitted behind the ones which have not yielded.
+    bool _hasRestoredLockState = false;
+
     // Track the thread who owns the lock for debugging purposes
     stdx::thread::id _threadId;
 
@@ -364,6 +372,9 @@ private:
     // A structure for accumulating time spent getting flow control tickets.
     FlowControlTicketholder::CurOp _flowControlStats;
 
+    // The time spent queued for tickets. Atomic because it is reported by currentOp.
+    AtomicWord<long long> _ticketWaitMicros{0};
+
     // Tracks the global lock modes ever acquired in this Locker's life. This value should only ever
     // be accessed from the thread that owns the Locker.
     unsigned char _globalLockMode = (1 << MODE_NONE);
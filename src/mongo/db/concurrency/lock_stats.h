@@ -187,6 +187,11 @@ public:
     void report(BSONObjBuilder* builder) const;
     void reset();
 
+    /**
+     * Returns the time spent waiting for locks, summed over all resources and modes.
+     */
+    int64_t getCombinedWaitTimeMicros() const;
+
 private:
     // Necessary for the append call, which accepts argument of type different than our
     // template parameter.
@@ -505,6 +505,13 @@ public:
         return FlowControlTicketholder::CurOp();
     }
 
+    /**
+     * If tracked by an implementation, returns the time spent queued for read or write tickets.
+     */
+    virtual Microseconds getTicketWaitTime() const {
+        return Microseconds{0};
+    }
+
     /**
      * This function is for unit testing only.
      */
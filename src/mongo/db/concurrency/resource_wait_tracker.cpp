@@ -0,0 +1,105 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/concurrency/resource_wait_tracker.h"
+
+#include <algorithm>
+
+#include "mongo/platform/bits.h"
+
+namespace mongo {
+
+ResourceWaitTracker& ResourceWaitTracker::get() {
+    static ResourceWaitTracker tracker;
+    return tracker;
+}
+
+void ResourceWaitTracker::recordWait(ResourceId resId, uint64_t waitMicros) {
+    auto& partition = _partitions[resId.getHashId() % kNumPartitions];
+    const size_t bucket =
+        std::min<size_t>(64 - countLeadingZeros64(waitMicros), kNumHistogramBuckets - 1);
+
+    stdx::lock_guard<Latch> lk(partition.mutex);
+    auto& resources = partition.resources;
+    auto it = std::find_if(resources.begin(), resources.end(), [&](const auto& stats) {
+        return stats.resId == resId;
+    });
+    if (it == resources.end()) {
+        if (resources.size() < kMaxResourcesPerPartition) {
+            it = resources.insert(resources.end(), ResourceWaitStats{resId});
+        } else {
+            // Replace the resource with the least wait time, which the new one inherits as the
+            // bound on how much its total may be overestimated.
+            it = std::min_element(
+                resources.begin(), resources.end(), [](const auto& lhs, const auto& rhs) {
+                    return lhs.totalWaitMicros < rhs.totalWaitMicros;
+                });
+            const auto inheritedMicros = it->totalWaitMicros;
+            *it = ResourceWaitStats{resId};
+            it->totalWaitMicros = inheritedMicros;
+            it->maxOverestimateMicros = inheritedMicros;
+        }
+    }
+
+    ++it->numWaits;
+    it->totalWaitMicros += waitMicros;
+    ++it->waitMicrosHistogram[bucket];
+}
+
+std::vector<ResourceWaitTracker::ResourceWaitStats> ResourceWaitTracker::getTopResources(
+    size_t limit) const {
+    std::vector<ResourceWaitStats> resources;
+    for (const auto& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        resources.insert(resources.end(), partition.resources.begin(), partition.resources.end());
+    }
+
+    auto byTotalWaitTime = [](const auto& lhs, const auto& rhs) {
+        return lhs.totalWaitMicros > rhs.totalWaitMicros;
+    };
+    if (resources.size() > limit) {
+        std::partial_sort(
+            resources.begin(), resources.begin() + limit, resources.end(), byTotalWaitTime);
+        resources.resize(limit);
+    } else {
+        std::sort(resources.begin(), resources.end(), byTotalWaitTime);
+    }
+    return resources;
+}
+
+void ResourceWaitTracker::clear() {
+    for (auto& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        partition.resources.clear();
+    }
+}
+
+}  // namespace mongo
@@ -0,0 +1,100 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "mongo/db/concurrency/lock_manager_defs.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/new.h"
+
+namespace mongo {
+
+/**
+ * Keeps the lock wait statistics of the resources which operations have spent the most time
+ * waiting for, so that the resource behind a pile-up can be identified after the fact. Only
+ * acquisitions which had to wait are recorded, and the Locker times those already, so uncontended
+ * acquisitions pay nothing for the tracking.
+ *
+ * The number of tracked resources is bounded using the space-saving algorithm: a wait on an
+ * untracked resource replaces the tracked resource with the least total wait time in its partition
+ * and inherits that total, which is reported as the maximum overestimate of the new resource's
+ * total.
+ */
+class ResourceWaitTracker {
+    ResourceWaitTracker(const ResourceWaitTracker&) = delete;
+    ResourceWaitTracker& operator=(const ResourceWaitTracker&) = delete;
+
+public:
+    // Bucket i of a histogram counts the waits shorter than 2^i microseconds which are not
+    // counted by a lower bucket. The last bucket also counts all of the longer waits.
+    static constexpr size_t kNumHistogramBuckets = 24;
+
+    struct ResourceWaitStats {
+        ResourceId resId;
+        long long numWaits = 0;
+        long long totalWaitMicros = 0;
+        long long maxOverestimateMicros = 0;
+        std::array<long long, kNumHistogramBuckets> waitMicrosHistogram{};
+    };
+
+    ResourceWaitTracker() = default;
+
+    /**
+     * Returns the tracker of all of the Lockers in the process.
+     */
+    static ResourceWaitTracker& get();
+
+    void recordWait(ResourceId resId, uint64_t waitMicros);
+
+    /**
+     * Returns the statistics of the at most 'limit' tracked resources with the highest total wait
+     * times, from the highest to the lowest.
+     */
+    std::vector<ResourceWaitStats> getTopResources(size_t limit) const;
+
+    void clear();
+
+private:
+    // The resources are spread over partitions by their ids, so that waits for different
+    // resources rarely contend on the same mutex.
+    static constexpr size_t kNumPartitions = 16;
+    static constexpr size_t kMaxResourcesPerPartition = 32;
+
+    struct alignas(stdx::hardware_destructive_interference_size) Partition {
+        mutable Mutex mutex = MONGO_MAKE_LATCH("ResourceWaitTracker::Partition::mutex");
+        std::vector<ResourceWaitStats> resources;
+    };
+
+    std::array<Partition, kNumPartitions> _partitions;
+};
+
+}  // namespace mongo
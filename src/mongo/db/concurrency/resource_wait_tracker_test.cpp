@@ -0,0 +1,103 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/concurrency/resource_wait_tracker.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(ResourceWaitTrackerTest, ReportsResourcesByTotalWaitTime) {
+    ResourceWaitTracker tracker;
+    const ResourceId collA(RESOURCE_COLLECTION, "db.a"_sd);
+    const ResourceId collB(RESOURCE_COLLECTION, "db.b"_sd);
+    const ResourceId dbC(RESOURCE_DATABASE, "c"_sd);
+
+    tracker.recordWait(collA, 10);
+    tracker.recordWait(collB, 3000);
+    tracker.recordWait(collA, 20);
+    tracker.recordWait(dbC, 500);
+
+    auto top = tracker.getTopResources(2);
+    ASSERT_EQ(2U, top.size());
+    ASSERT_EQ(collB, top[0].resId);
+    ASSERT_EQ(3000, top[0].totalWaitMicros);
+    ASSERT_EQ(dbC, top[1].resId);
+
+    top = tracker.getTopResources(10);
+    ASSERT_EQ(3U, top.size());
+    ASSERT_EQ(collA, top[2].resId);
+    ASSERT_EQ(2, top[2].numWaits);
+    ASSERT_EQ(30, top[2].totalWaitMicros);
+    ASSERT_EQ(0, top[2].maxOverestimateMicros);
+
+    // Waits of 10 and 20 microseconds fall into the [8, 16) and [16, 32) buckets.
+    ASSERT_EQ(1, top[2].waitMicrosHistogram[4]);
+    ASSERT_EQ(1, top[2].waitMicrosHistogram[5]);
+
+    tracker.clear();
+    ASSERT(tracker.getTopResources(10).empty());
+}
+
+TEST(ResourceWaitTrackerTest, LongWaitsFallIntoTheLastBucket) {
+    ResourceWaitTracker tracker;
+    const ResourceId coll(RESOURCE_COLLECTION, "db.a"_sd);
+
+    tracker.recordWait(coll, 0);
+    tracker.recordWait(coll, 1000ULL * 1000 * 1000);
+
+    auto top = tracker.getTopResources(1);
+    ASSERT_EQ(1, top[0].waitMicrosHistogram[0]);
+    ASSERT_EQ(1, top[0].waitMicrosHistogram[ResourceWaitTracker::kNumHistogramBuckets - 1]);
+}
+
+TEST(ResourceWaitTrackerTest, TracksABoundedNumberOfResources) {
+    ResourceWaitTracker tracker;
+    for (int i = 0; i < 10000; ++i) {
+        tracker.recordWait(ResourceId(RESOURCE_COLLECTION, "db.coll" + std::to_string(i)), 1);
+    }
+
+    // A resource which replaces a tracked one inherits its wait time, and still comes out on top
+    // once it is waited for the most.
+    const ResourceId hot(RESOURCE_COLLECTION, "db.hot"_sd);
+    for (int i = 0; i < 100; ++i) {
+        tracker.recordWait(hot, 100);
+    }
+
+    auto top = tracker.getTopResources(100000);
+    ASSERT_LT(top.size(), 10000U);
+    ASSERT_EQ(hot, top[0].resId);
+    ASSERT_GTE(top[0].totalWaitMicros, 100 * 100);
+    ASSERT_LTE(top[0].totalWaitMicros - top[0].maxOverestimateMicros, 100 * 100);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -32,6 +32,7 @@
 #include <exception>
 
 #include "mongo/base/string_data.h"
+#include "mongo/db/concurrency/hot_document_tracker.h"
 #include "mongo/db/curop.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/fail_point.h"
@@ -73,6 +74,9 @@ private:
  * error, waits a spell, cleans up, and then tries f again.  Imposes no upper limit on the number
  * of times to re-try f, so any required timeout behavior must be enforced within f.
  *
+ * Instead of waiting a spell, retries of writes to a document that keeps conflicting wait for their
+ * turn from the HotDocumentTracker, so that they do not all conflict with each other again.
+ *
  * If we are already in a WriteUnitOfWork, we assume that we are being called within a
  * WriteConflictException retry loop up the call stack. Hence, this retry loop is reduced to an
  * invocation of the argument function f without any exception handling and retry logic.
@@ -93,14 +97,20 @@ auto writeConflictRetry(OperationContext* opCtx, StringData opStr, StringData ns
     }
 
     int attempts = 0;
+    HotDocumentTracker::Turn turn;
     while (true) {
         try {
             return f();
         } catch (WriteConflictException const&) {
             CurOp::get(opCtx)->debug().additiveMetrics.incrementWriteConflicts(1);
-            WriteConflictException::logAndBackoff(attempts, opStr, ns);
-            ++attempts;
+            // Abandon the snapshot before waiting for a turn, so that the retry reads the write of
+            // whoever had the turn before us.
             opCtx->recoveryUnit()->abandonSnapshot();
+            turn = HotDocumentTracker::get().onWriteConflict(opCtx, ns, std::move(turn));
+            if (!turn) {
+                WriteConflictException::logAndBackoff(attempts, opStr, ns);
+            }
+            ++attempts;
         }
     }
 }
@@ -50,6 +50,9 @@
 #include "mongo/db/profile_filter.h"
 #include "mongo/db/query/getmore_request.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/query/query_memory_governor.h"
+#include "mongo/db/stats/query_shape_stats.h"
+#include "mongo/db/stats/slow_query_sampler.h"
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/metadata/client_metadata.h"
 #include "mongo/rpc/metadata/impersonated_user_metadata.h"
@@ -477,6 +480,15 @@ void CurOp::enter_inlock(const char* ns, int dbProfileLevel) {
     raiseDbProfileLevel(dbProfileLevel);
 }
 
+bool CurOp::shouldCaptureExecStats(OperationContext* opCtx) {
+    if (!_sampledAsSlowQuery && _debug.queryHash &&
+        elapsedTimeExcludingPauses() >= Milliseconds{serverGlobalParams.slowMS}) {
+        _sampledAsSlowQuery =
+            SlowQuerySampler::get(opCtx).shouldSample(getNSS(), *_debug.queryHash, Date_t::now());
+    }
+    return _sampledAsSlowQuery || shouldDBProfile(opCtx);
+}
+
 void CurOp::raiseDbProfileLevel(int dbProfileLevel) {
     _dbprofile = std::max(dbProfileLevel, _dbprofile);
 }
@@ -505,6 +517,31 @@ bool CurOp::completeAndLogOperation(OperationContext* opCtx,
         oplogGetMoreStats.recordMillis(executionTimeMillis);
     }
 
+    if (_debug.queryHash) {
+        QueryShapeStatsStore::OperationStats stats;
+        stats.latency = _debug.executionTime;
+        stats.keysExamined = _debug.additiveMetrics.keysExamined.value_or(0);
+        stats.docsExamined = _debug.additiveMetrics.docsExamined.value_or(0);
+        stats.nreturned = std::max(_debug.nreturned, 0LL);
+        stats.bytesReturned = std::max(_debug.responseLength, 0);
+        QueryShapeStatsStore::get(opCtx).record(getNSS(), *_debug.queryHash, stats);
+    }
+
+    if (_sampledAsSlowQuery) {
+        // The sample only goes to memory, so that capturing it costs no more than building it.
+        BSONObjBuilder sampleBuilder;
+        sampleBuilder.appendDate("ts", jsTime());
+        {
+            Locker::LockerInfo lockerInfo;
+            opCtx->lockState()->getLockerInfo(&lockerInfo, _lockStatsBase);
+            _debug.append(opCtx,
+                          lockerInfo.stats,
+                          opCtx->lockState()->getFlowControlStats(),
+                          sampleBuilder);
+        }
+        SlowQuerySampler::get(opCtx).record(sampleBuilder.obj());
+    }
+
     bool shouldLogSlowOp, shouldProfileAtLevel1;
 
     if (auto filter =
@@ -782,6 +819,10 @@ void CurOp::reportState(OperationContext* opCtx, BSONObjBuilder* builder, bool t
 
     builder->append("numYields", _numYields.load());
 
+    if (auto bytes = QueryMemoryGovernor::getOperationMemoryUsageBytes(opCtx); bytes > 0) {
+        builder->append("queryMemoryUsageBytes", bytes);
+    }
+
     if (_debug.dataThroughputLastSecond) {
         builder->append("dataThroughputLastSecond", *_debug.dataThroughputLastSecond);
     }
@@ -789,6 +830,14 @@ void CurOp::reportState(OperationContext* opCtx, BSONObjBuilder* builder, bool t
     if (_debug.dataThroughputAverage) {
         builder->append("dataThroughputAverage", *_debug.dataThroughputAverage);
     }
+
+    if (_debug.sideWritesDrainedPerSecond) {
+        builder->append("sideWritesDrainedPerSecond", *_debug.sideWritesDrainedPerSecond);
+    }
+
+    if (_debug.sideWritesBacklog) {
+        builder->append("sideWritesBacklog", *_debug.sideWritesBacklog);
+    }
 }
 
 namespace {
@@ -956,6 +1005,11 @@ string OpDebug::report(OperationContext* opCtx, const SingleThreadedLockStats* l
         s << " storage:" << storageStats->toBSON().toString();
     }
 
+    BSONObj waitTimesObj = makeWaitTimesObject(opCtx, lockStats);
+    if (waitTimesObj.nFields() > 0) {
+        s << " waitTimesMicros:" << waitTimesObj.toString();
+    }
+
     if (iscommand) {
         s << " protocol:" << getProtoString(networkOp);
     }
@@ -1127,6 +1181,11 @@ void OpDebug::report(OperationContext* opCtx,
         pAttrs->add("storage", storageStats->toBSON());
     }
 
+    BSONObj waitTimesObj = makeWaitTimesObject(opCtx, lockStats);
+    if (waitTimesObj.nFields() > 0) {
+        pAttrs->add("waitTimesMicros", waitTimesObj);
+    }
+
     if (operationMetrics) {
         BSONObjBuilder builder;
         operationMetrics->toBsonNonZeroFields(&builder);
@@ -1251,6 +1310,13 @@ void OpDebug::append(OperationContext* opCtx,
         b.append("storage", storageStats->toBSON());
     }
 
+    {
+        BSONObj waitTimesObj = makeWaitTimesObject(opCtx, &lockStats);
+        if (waitTimesObj.nFields() > 0) {
+            b.append("waitTimesMicros", waitTimesObj);
+        }
+    }
+
     if (!errInfo.isOK()) {
         b.appendNumber("ok", 0.0);
         if (!errInfo.reason().empty()) {
@@ -1507,6 +1573,15 @@ std::function<BSONObj(ProfileFilter::Args)> OpDebug::appendStaged(StringSet requ
         }
     });
 
+    addIfNeeded("waitTimesMicros", [](auto field, auto args, auto& b) {
+        auto lockerInfo = args.opCtx->lockState()->getLockerInfo(args.curop.getLockStatsBase());
+        BSONObj waitTimesObj =
+            args.op.makeWaitTimesObject(args.opCtx, lockerInfo ? &lockerInfo->stats : nullptr);
+        if (waitTimesObj.nFields() > 0) {
+            b.append(field, waitTimesObj);
+        }
+    });
+
     // Don't short-circuit: call needs() for every supported field, so that at the end we can
     // uassert that no unsupported fields were requested.
     bool needsOk = needs("ok");
@@ -1618,6 +1693,46 @@ BSONObj OpDebug::makeFlowControlObject(FlowControlTicketholder::CurOp stats) {
     return builder.obj();
 }
 
+BSONObj OpDebug::makeWaitTimesObject(OperationContext* opCtx,
+                                     const SingleThreadedLockStats* lockStats) const {
+    BSONObjBuilder builder;
+    appendLockWaitTimes(opCtx->lockState(), lockStats, &builder);
+
+    auto appendIfNonZero = [&](StringData name, Microseconds waitTime) {
+        if (waitTime > Microseconds::zero()) {
+            builder.append(name, durationCount<Microseconds>(waitTime));
+        }
+    };
+
+    appendIfNonZero("flowControl",
+                    Microseconds{opCtx->lockState()->getFlowControlStats().timeAcquiringMicros});
+    appendIfNonZero("prepareConflict", prepareConflictDurationMillis);
+    if (storageStats) {
+        appendIfNonZero("storageRead", storageStats->getTimeReading());
+        appendIfNonZero("cacheEviction", storageStats->getTimeWaitingForCache());
+    }
+    appendIfNonZero("writeConcern", writeConcernWaitTime);
+    if (remoteOpWaitTime) {
+        appendIfNonZero("remoteOps", *remoteOpWaitTime);
+    }
+
+    return builder.obj();
+}
+
+void OpDebug::appendLockWaitTimes(const Locker* locker,
+                                  const SingleThreadedLockStats* lockStats,
+                                  BSONObjBuilder* builder) {
+    if (auto ticketWaitTime = locker->getTicketWaitTime(); ticketWaitTime > Microseconds::zero()) {
+        builder->append("ticketQueue", durationCount<Microseconds>(ticketWaitTime));
+    }
+
+    if (lockStats) {
+        if (auto lockWaitMicros = lockStats->getCombinedWaitTimeMicros(); lockWaitMicros > 0) {
+            builder->append("lockWait", lockWaitMicros);
+        }
+    }
+}
+
 BSONObj OpDebug::makeMongotDebugStatsObject() const {
     BSONObjBuilder cursorBuilder;
     invariant(mongotCursorId);
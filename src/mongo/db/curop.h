@@ -195,6 +195,21 @@ public:
      */
     static BSONObj makeFlowControlObject(FlowControlTicketholder::CurOp flowControlStats);
 
+    /**
+     * Makes an object breaking down the time the operation spent waiting, in microseconds, by what
+     * it waited for. 'lockStats' may be null. The resulting object has zeros omitted.
+     */
+    BSONObj makeWaitTimesObject(OperationContext* opCtx,
+                                const SingleThreadedLockStats* lockStats) const;
+
+    /**
+     * Appends the ticket queue and lock wait times of the operation which owns 'locker'. These are
+     * the parts of the breakdown above which may be reported while the operation is running.
+     */
+    static void appendLockWaitTimes(const Locker* locker,
+                                    const SingleThreadedLockStats* lockStats,
+                                    BSONObjBuilder* builder);
+
     /**
      * Make object from $search stats with non-populated values omitted.
      */
@@ -261,9 +276,17 @@ public:
     boost::optional<float> dataThroughputLastSecond;
     boost::optional<float> dataThroughputAverage;
 
+    // Stores the rate at which an index build drains its side writes, in writes per second, and
+    // the number of side writes left to drain.
+    boost::optional<float> sideWritesDrainedPerSecond;
+    boost::optional<long long> sideWritesBacklog;
+
     // Used to track the amount of time spent waiting for a response from remote operations.
     boost::optional<Microseconds> remoteOpWaitTime;
 
+    // Stores the duration of time spent waiting for the write concern to be satisfied.
+    Microseconds writeConcernWaitTime{0};
+
     // Stores additive metrics.
     AdditiveMetrics additiveMetrics;
 
@@ -447,6 +470,13 @@ public:
         return elapsedTimeExcludingPauses() >= Milliseconds{serverGlobalParams.slowMS};
     }
 
+    /**
+     * Returns true if the execution statistics of this operation should be gathered into its
+     * OpDebug, either because it will be profiled or because it is a slow operation which the
+     * SlowQuerySampler has chosen to sample. Must be called after the queryHash is known.
+     */
+    bool shouldCaptureExecStats(OperationContext* opCtx);
+
     /**
      * Raises the profiling level for this operation to "dbProfileLevel" if it was previously
      * less than "dbProfileLevel".
@@ -800,6 +830,7 @@ private:
 
     bool _isCommand{false};
     int _dbprofile{0};  // 0=off, 1=slow, 2=all
+    bool _sampledAsSlowQuery{false};
     std::string _ns;
     BSONObj _opDescription;
     BSONObj _originatingCommand;  // Used by getMore to display original command.
@@ -47,4 +47,12 @@ Milliseconds getDefaultCursorTimeoutMillis() {
     return Milliseconds(kCursorTimeoutMillisDefault);
 }
 
+Milliseconds getCursorSpoolPinTimeBudget() {
+    return Milliseconds(gCursorSpoolPinTimeBudgetMillis.load());
+}
+
+long long getCursorSpoolMemoryBudgetBytes() {
+    return gCursorSpoolMemoryBudgetBytes.load();
+}
+
 }  // namespace mongo
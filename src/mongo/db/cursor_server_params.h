@@ -41,4 +41,12 @@ long long getCursorTimeoutMillis();
 
 Milliseconds getDefaultCursorTimeoutMillis();
 
+// Period of time after which the remaining results of eligible cursors are spooled, or zero if
+// spooling is disabled. Configurable with server parameter "cursorSpoolPinTimeBudgetMillis".
+Milliseconds getCursorSpoolPinTimeBudget();
+
+// Maximum size of the remaining results of a cursor which may be spooled. Configurable with server
+// parameter "cursorSpoolMemoryBudgetBytes".
+long long getCursorSpoolMemoryBudgetBytes();
+
 }  // namespace mongo
@@ -176,8 +176,22 @@ unique_ptr<DBClientCursor> DBDirectClient::query(const NamespaceStringOrUUID& ns
 
 write_ops::FindAndModifyReply DBDirectClient::findAndModify(
     const write_ops::FindAndModifyCommand& findAndModify) {
-    auto response = runCommand(findAndModify.serialize({}));
-    return FindAndModifyOp::parseResponse(response->getCommandReply());
+    if (findAndModify.getWriteConcern()) {
+        // Only the ServiceEntryPoint waits for write concern.
+        auto response = runCommand(findAndModify.serialize({}));
+        return FindAndModifyOp::parseResponse(response->getCommandReply());
+    }
+    return FindAndModifyOp::parseResponse(runCommandDirectly(findAndModify.serialize({})));
+}
+
+BSONObj DBDirectClient::runCommandDirectly(const OpMsgRequest& request) {
+    DirectClientScope directClientScope(_opCtx);
+    boost::swap(_lastError, LastError::get(_opCtx->getClient()));
+    ON_BLOCK_EXIT([&] { boost::swap(_lastError, LastError::get(_opCtx->getClient())); });
+
+    LastError::get(_opCtx->getClient()).startRequest();
+    IgnoreAPIParametersBlock ignoreApiParametersBlock(_opCtx);
+    return CommandHelpers::runCommandDirectly(_opCtx, request);
 }
 
 long long DBDirectClient::count(const NamespaceStringOrUUID nsOrUuid,
@@ -187,13 +201,11 @@ long long DBDirectClient::count(const NamespaceStringOrUUID nsOrUuid,
                                 int skip,
                                 boost::optional<BSONObj> readConcernObj) {
     invariant(!readConcernObj, "passing readConcern to DBDirectClient functions is not supported");
-    DirectClientScope directClientScope(_opCtx);
     BSONObj cmdObj = _countCmd(nsOrUuid, query, options, limit, skip, boost::none);
 
     auto dbName = (nsOrUuid.uuid() ? nsOrUuid.dbname() : (*nsOrUuid.nss()).db().toString());
 
-    auto result = CommandHelpers::runCommandDirectly(
-        _opCtx, OpMsgRequest::fromDBAndBody(dbName, std::move(cmdObj)));
+    auto result = runCommandDirectly(OpMsgRequest::fromDBAndBody(dbName, std::move(cmdObj)));
 
     uassertStatusOK(getStatusFromCommandResult(result));
     return static_cast<unsigned long long>(result["n"].numberLong());
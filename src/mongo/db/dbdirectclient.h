@@ -68,6 +68,16 @@ public:
     write_ops::FindAndModifyReply findAndModify(
         const write_ops::FindAndModifyCommand& findAndModify);
 
+    /**
+     * Runs 'request' on this server without encoding it into a wire message: the command parses
+     * the BSON of 'request' in place, and its reply body is returned as an owned BSONObj, with any
+     * error in it rather than thrown. Unlike runCommand(), this does not go through the
+     * ServiceEntryPoint, so it does not check auth, set up read concern or sessions, or wait for
+     * write concern: the command runs as part of the caller's operation. It suits the internal
+     * reads and writes which need none of that.
+     */
+    BSONObj runCommandDirectly(const OpMsgRequest& request);
+
     virtual bool isFailed() const;
 
     virtual bool isStillConnected();
@@ -47,6 +47,7 @@
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/query/query_planner.h"
+#include "mongo/db/record_id_helpers.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
 
@@ -140,6 +141,18 @@ bool Helpers::findById(OperationContext* opCtx,
     if (nsFound)
         *nsFound = true;
 
+    if (collection->isClustered()) {
+        // The _id of a document in a clustered collection is its RecordId.
+        if (indexFound)
+            *indexFound = 1;
+
+        RecordId loc = findById(opCtx, collection, query);
+        if (loc.isNull())
+            return false;
+        result = collection->docFor(opCtx, loc).value();
+        return true;
+    }
+
     const IndexCatalog* catalog = collection->getIndexCatalog();
     const IndexDescriptor* desc = catalog->findIdIndex(opCtx);
 
@@ -160,6 +173,15 @@ RecordId Helpers::findById(OperationContext* opCtx,
                            const CollectionPtr& collection,
                            const BSONObj& idquery) {
     verify(collection);
+    if (collection->isClustered()) {
+        auto recordId = record_id_helpers::keyForDoc(idquery);
+        if (!recordId.isOK() ||
+            !collection->getRecordStore()->findRecord(opCtx, recordId.getValue(), nullptr)) {
+            return RecordId();
+        }
+        return recordId.getValue();
+    }
+
     const IndexCatalog* catalog = collection->getIndexCatalog();
     const IndexDescriptor* desc = catalog->findIdIndex(opCtx);
     uassert(13430, "no _id index", desc);
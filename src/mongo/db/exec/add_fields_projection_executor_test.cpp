@@ -40,7 +40,9 @@
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/pipeline/dependencies.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo::projection_executor {
 namespace {
@@ -298,6 +300,30 @@ TEST(AddFieldsProjectionExecutorOptimize, ShouldOptimizeNestedExpressions) {
                        addition.serializeTransformation(ExplainOptions::Verbosity::kExecAllPlans));
 }
 
+// Verify that compiling the computed arithmetic fields does not change the result or the
+// serialization of the projection.
+TEST(AddFieldsProjectionExecutorOptimize, CompiledExpressionsProduceSameResults) {
+    internalQueryCompileProjectionExpressions.store(true);
+    ON_BLOCK_EXIT([] { internalQueryCompileProjectionExpressions.store(false); });
+
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    AddFieldsProjectionExecutor addition(expCtx);
+    addition.parse(fromjson(
+        "{c: {$multiply: [{$add: ['$a', 1]}, '$b']}, 'd.e': {$subtract: ['$a', {$add: [1, 2]}]}}"));
+    addition.optimize();
+
+    ASSERT_DOCUMENT_EQ(
+        Document(fromjson("{c: {$multiply: [{$add: ['$a', {$const: 1}]}, '$b']}, "
+                          "d: {e: {$subtract: ['$a', {$const: 3}]}}}")),
+        addition.serializeTransformation(boost::none));
+
+    auto result = addition.applyProjection(Document{{"a", 2}, {"b", 3.5}});
+    ASSERT_DOCUMENT_EQ(Document(fromjson("{a: 2, b: 3.5, c: 10.5, d: {e: -1}}")), result);
+
+    result = addition.applyProjection(Document{{"b", 2}});
+    ASSERT_DOCUMENT_EQ(Document(fromjson("{b: 2, c: null, d: {e: null}}")), result);
+}
+
 //
 // Top-level only.
 //
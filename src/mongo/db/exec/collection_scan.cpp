@@ -41,7 +41,9 @@
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/repl/optime.h"
+#include "mongo/db/storage/oplog_namespace_index.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/fail_point.h"
 
@@ -89,11 +91,22 @@ CollectionScan::CollectionScan(ExpressionContext* expCtx,
         invariant(params.direction == CollectionScanParams::FORWARD);
     }
 
+    if (params.relevantOplogNamespace) {
+        invariant(params.tailable && collection->ns().isOplog());
+        invariant(params.direction == CollectionScanParams::FORWARD);
+    }
+
     if (params.resumeAfterRecordId) {
         // The 'resumeAfterRecordId' parameter is used for resumable collection scans, which we
         // only support in the forward direction.
         invariant(params.direction == CollectionScanParams::FORWARD);
     }
+
+    // Tailable and capped scans depend on observing EOF and lost positions as soon as the cursor
+    // does, so they never read ahead.
+    if (!params.tailable && !collection->isCapped()) {
+        _batchSize = internalQueryCollectionScanBatchSize.load();
+    }
 }
 
 PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
@@ -102,6 +115,7 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
     }
 
     boost::optional<Record> record;
+    bool recordFromBatch = false;
     const bool needToMakeCursor = !_cursor;
     try {
         if (needToMakeCursor) {
@@ -177,8 +191,17 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
             record = _cursor->seekNear(*_params.maxRecord);
         }
 
+        if (!record && _params.relevantOplogNamespace && !_lastSeenId.isNull()) {
+            record = seekToNextRelevantOplogEntry();
+        }
+
         if (!record) {
-            record = _cursor->next();
+            if (_batchSize) {
+                record = nextBatchedRecord();
+                recordFromBatch = true;
+            } else {
+                record = _cursor->next();
+            }
         }
     } catch (const WriteConflictException&) {
         // Leave us in a state to try again next time.
@@ -210,12 +233,66 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
     WorkingSetID id = _workingSet->allocate();
     WorkingSetMember* member = _workingSet->get(id);
     member->recordId = record->id;
-    member->resetDocument(opCtx()->recoveryUnit()->getSnapshotId(), record->data.releaseToBson());
+    member->resetDocument(
+        recordFromBatch ? _batchSnapshotId : opCtx()->recoveryUnit()->getSnapshotId(),
+        record->data.releaseToBson());
     _workingSet->transitionToRecordIdAndObj(id);
 
     return returnIfMatches(member, id, out);
 }
 
+boost::optional<Record> CollectionScan::seekToNextRelevantOplogEntry() {
+    const Timestamp lastSeenTs(_lastSeenId.asLong());
+    if (_relevantOplogSecs && *_relevantOplogSecs == lastSeenTs.getSecs()) {
+        return boost::none;
+    }
+
+    auto bound = OplogNamespaceIndex::get(opCtx()->getServiceContext())
+                     .nextRelevantEntryBound(*_params.relevantOplogNamespace, lastSeenTs);
+    if (!bound) {
+        // The rest of this second may hold relevant entries, and always will.
+        _relevantOplogSecs = lastSeenTs.getSecs();
+        return boost::none;
+    }
+
+    // Position on the last entry before 'bound'. The seek is rounded down to the oplog visibility
+    // point, which was established before the index was consulted, so every entry up to it has
+    // already been added to the index. The entry is returned rather than skipped, so that the
+    // latest oplog timestamp of the scan moves past the skipped entries.
+    auto target = *bound == Timestamp::max() ? RecordId::maxLong() : RecordId(bound->asLL());
+    auto record = _cursor->seekNear(target);
+    if (record && record->id > _lastSeenId) {
+        return record;
+    }
+
+    // Nothing after '_lastSeenId' is visible yet, so carry on from it.
+    if (!record || record->id != _lastSeenId) {
+        if (!_cursor->seekExact(_lastSeenId)) {
+            uasserted(ErrorCodes::CappedPositionLost,
+                      str::stream() << "CollectionScan died due to failure to restore "
+                                    << "tailable cursor position. "
+                                    << "Last seen record id: " << _lastSeenId);
+        }
+    }
+    return boost::none;
+}
+
+boost::optional<Record> CollectionScan::nextBatchedRecord() {
+    if (_batchPos == _batch.size()) {
+        _batch.clear();
+        _batchPos = 0;
+        _batchSnapshotId = opCtx()->recoveryUnit()->getSnapshotId();
+
+        // If this throws a WriteConflictException, any records read before it remain in '_batch'
+        // and are handed out after the yield.
+        _cursor->nextBatch(_batchSize, &_batch);
+        if (_batch.empty()) {
+            return boost::none;
+        }
+    }
+    return std::move(_batch[_batchPos++]);
+}
+
 void CollectionScan::setLatestOplogEntryTimestamp(const Record& record) {
     auto tsElem = record.data.toBson()[repl::OpTime::kTimestampFieldName];
     uassert(ErrorCodes::Error(4382100),
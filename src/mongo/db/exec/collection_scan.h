@@ -118,6 +118,19 @@ private:
      */
     void assertTsHasNotFallenOffOplog(const Record& record);
 
+    /**
+     * Returns the next record from '_batch', refilling it from '_cursor' with up to '_batchSize'
+     * records once it has been used up. Returns boost::none at EOF.
+     */
+    boost::optional<Record> nextBatchedRecord();
+
+    /**
+     * Seeks '_cursor' past the oplog entries after '_lastSeenId' which the OplogNamespaceIndex
+     * shows cannot be relevant to '_params.relevantOplogNamespace', and returns the entry it lands
+     * on. Returns boost::none, leaving '_cursor' on '_lastSeenId', if there is nothing to skip.
+     */
+    boost::optional<Record> seekToNextRelevantOplogEntry();
+
     // WorkingSet is not owned by us.
     WorkingSet* _workingSet;
 
@@ -130,10 +143,23 @@ private:
 
     RecordId _lastSeenId;  // Null if nothing has been returned from _cursor yet.
 
+    // If non-zero, records are read from '_cursor' this many at a time with nextBatch() and handed
+    // out from '_batch'. The buffered records own their data, so they survive yields; they are
+    // tagged with the snapshot they were read in, '_batchSnapshotId', so that consumers which care
+    // can tell that they may have been read before a yield.
+    size_t _batchSize = 0;
+    std::vector<Record> _batch;
+    size_t _batchPos = 0;
+    SnapshotId _batchSnapshotId;
+
     // If _params.shouldTrackLatestOplogTimestamp is set and the collection is the oplog, the latest
     // timestamp seen in the collection.  Otherwise, this is a null timestamp.
     Timestamp _latestOplogEntryTimestamp;
 
+    // The latest second of the oplog which the OplogNamespaceIndex has shown may hold entries
+    // relevant to '_params.relevantOplogNamespace'. Entries of this second are never skipped.
+    boost::optional<unsigned> _relevantOplogSecs;
+
     // Stats
     CollectionScanStats _specificStats;
 };
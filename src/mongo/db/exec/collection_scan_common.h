@@ -30,6 +30,7 @@
 #pragma once
 
 #include "mongo/bson/timestamp.h"
+#include "mongo/db/namespace_string.h"
 #include "mongo/db/record_id.h"
 
 namespace mongo {
@@ -85,6 +86,10 @@ struct CollectionScanParams {
 
     // Whether or not to wait for oplog visibility on oplog collection scans.
     bool shouldWaitForOplogVisibility = false;
+
+    // If present on a tailable scan of the oplog, the scan consults the OplogNamespaceIndex to seek
+    // past the oplog entries which cannot be relevant to a change stream on this namespace.
+    boost::optional<NamespaceString> relevantOplogNamespace;
 };
 
 }  // namespace mongo
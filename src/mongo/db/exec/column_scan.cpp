@@ -0,0 +1,217 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/column_scan.h"
+
+#include <algorithm>
+
+#include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/exec/filter.h"
+
+namespace mongo {
+
+// static
+const char* ColumnScanStage::kStageType = "COLUMN_SCAN";
+
+ColumnScanStage::ColumnScanStage(ExpressionContext* expCtx,
+                                 WorkingSet* ws,
+                                 const CollectionPtr& collection,
+                                 const IndexDescriptor* descriptor,
+                                 std::vector<std::string> columns,
+                                 const MatchExpression* filter)
+    : RequiresIndexStage(kStageType, expCtx, collection, descriptor, ws),
+      _workingSet(ws),
+      _filter(filter) {
+    _columns.push_back({ColumnStoreAccessMethod::kIdColumn.toString()});
+    for (auto&& column : columns) {
+        if (column != ColumnStoreAccessMethod::kIdColumn) {
+            _columns.push_back({std::move(column)});
+        }
+    }
+
+    _specificStats.indexName = descriptor->indexName();
+    _specificStats.keyPattern = descriptor->keyPattern();
+    for (auto&& column : _columns) {
+        _specificStats.columns.push_back(column.name);
+    }
+}
+
+bool ColumnScanStage::isEOF() {
+    return _commonStats.isEOF;
+}
+
+void ColumnScanStage::setCell(Column* column, boost::optional<IndexKeyEntry> entry) {
+    column->entry = std::move(entry);
+    column->cell = boost::none;
+    if (column->entry) {
+        ++_specificStats.keysExamined;
+        column->cell = ColumnStoreAccessMethod::parseCell(column->entry->key, column->name);
+    }
+}
+
+void ColumnScanStage::seekColumns() {
+    const auto sdi = indexAccessMethod()->getSortedDataInterface();
+    for (auto&& column : _columns) {
+        if (!column.cursor) {
+            column.cursor = indexAccessMethod()->newCursor(opCtx(), true);
+        }
+        setCell(&column,
+                column.cursor->seek(ColumnStoreAccessMethod::makeSeekKey(sdi->getKeyStringVersion(),
+                                                                         sdi->getOrdering(),
+                                                                         column.name,
+                                                                         _lastRecordId)));
+        column.needsAdvance = false;
+    }
+}
+
+void ColumnScanStage::advanceColumn(Column* column) {
+    setCell(column, column->cursor->next());
+    column->needsAdvance = false;
+}
+
+PlanStage::StageState ColumnScanStage::doWork(WorkingSetID* out) {
+    if (isEOF()) {
+        return PlanStage::IS_EOF;
+    }
+
+    BSONObj obj;
+    try {
+        // Move the columns past the cells of the previous document. A column whose cursor fails to
+        // move keeps its 'needsAdvance' flag, so retrying after a yield picks up where this left
+        // off.
+        if (_needsSeek) {
+            seekColumns();
+            _needsSeek = false;
+        } else {
+            for (auto&& column : _columns) {
+                if (column.needsAdvance) {
+                    advanceColumn(&column);
+                }
+            }
+        }
+
+        const auto& idColumn = _columns.front();
+        if (!idColumn.cell) {
+            _commonStats.isEOF = true;
+            return PlanStage::IS_EOF;
+        }
+        const RecordId recordId = idColumn.cell->recordId;
+
+        std::vector<Column*> present;
+        for (auto&& column : _columns) {
+            // Every document has an _id, so no other column can hold cells for a document the
+            // '_id' column does not; skip any such cells defensively.
+            while (column.cell && column.cell->recordId < recordId) {
+                advanceColumn(&column);
+            }
+            if (column.cell && column.cell->recordId == recordId) {
+                present.push_back(&column);
+            }
+        }
+
+        std::sort(present.begin(), present.end(), [](const Column* lhs, const Column* rhs) {
+            return lhs->cell->position < rhs->cell->position;
+        });
+        BSONObjBuilder bob;
+        for (auto&& column : present) {
+            bob.appendAs(column->cell->value, column->name);
+            column->needsAdvance = true;
+        }
+        obj = bob.obj();
+        _lastRecordId = recordId;
+    } catch (const WriteConflictException&) {
+        *out = WorkingSet::INVALID_ID;
+        return PlanStage::NEED_YIELD;
+    }
+
+    WorkingSetID id = _workingSet->allocate();
+    WorkingSetMember* member = _workingSet->get(id);
+    member->doc = {SnapshotId(), Document{obj}};
+    member->transitionToOwnedObj();
+
+    if (!Filter::passes(member, _filter)) {
+        _workingSet->free(id);
+        return PlanStage::NEED_TIME;
+    }
+
+    *out = id;
+    return PlanStage::ADVANCED;
+}
+
+void ColumnScanStage::doSaveStateRequiresIndex() {
+    // The cells read so far may have changed by the time the stage is restored, so the columns
+    // are repositioned from scratch rather than restored to their previous positions.
+    for (auto&& column : _columns) {
+        if (column.cursor) {
+            column.cursor->saveUnpositioned();
+        }
+        column.entry = boost::none;
+        column.cell = boost::none;
+    }
+    _needsSeek = true;
+}
+
+void ColumnScanStage::doRestoreStateRequiresIndex() {
+    for (auto&& column : _columns) {
+        if (column.cursor) {
+            column.cursor->restore();
+        }
+    }
+}
+
+void ColumnScanStage::doDetachFromOperationContext() {
+    for (auto&& column : _columns) {
+        if (column.cursor) {
+            column.cursor->detachFromOperationContext();
+        }
+    }
+}
+
+void ColumnScanStage::doReattachToOperationContext() {
+    for (auto&& column : _columns) {
+        if (column.cursor) {
+            column.cursor->reattachToOperationContext(opCtx());
+        }
+    }
+}
+
+std::unique_ptr<PlanStageStats> ColumnScanStage::getStats() {
+    _commonStats.isEOF = isEOF();
+    auto ret = std::make_unique<PlanStageStats>(_commonStats, STAGE_COLUMN_SCAN);
+    ret->specific = std::make_unique<ColumnScanStats>(_specificStats);
+    return ret;
+}
+
+const SpecificStats* ColumnScanStage::getSpecificStats() const {
+    return &_specificStats;
+}
+
+}  // namespace mongo
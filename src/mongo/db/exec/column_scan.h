@@ -0,0 +1,127 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/db/exec/requires_index_stage.h"
+#include "mongo/db/index/column_store_access_method.h"
+#include "mongo/db/matcher/expression.h"
+#include "mongo/db/storage/sorted_data_interface.h"
+
+namespace mongo {
+
+/**
+ * Reconstructs documents from the columns of a columnstore index, reading only the columns the
+ * query needs. The documents are produced in RecordId order and hold their indexed fields in the
+ * relative order those fields had in the original document. The '_id' column is always read and
+ * drives the scan, since every document has exactly one cell in it.
+ *
+ * Each document is assembled from cells read within a single storage snapshot. After a yield the
+ * column cursors are repositioned past the last document returned instead of continuing from the
+ * cells they had read before the yield, so that a document is never assembled from two snapshots.
+ *
+ * The optional 'filter' is applied to the reconstructed documents and must only depend on the
+ * columns being read.
+ */
+class ColumnScanStage final : public RequiresIndexStage {
+public:
+    static const char* kStageType;
+
+    ColumnScanStage(ExpressionContext* expCtx,
+                    WorkingSet* ws,
+                    const CollectionPtr& collection,
+                    const IndexDescriptor* descriptor,
+                    std::vector<std::string> columns,
+                    const MatchExpression* filter);
+
+    bool isEOF() final;
+    StageState doWork(WorkingSetID* out) final;
+
+    StageType stageType() const final {
+        return STAGE_COLUMN_SCAN;
+    }
+
+    std::unique_ptr<PlanStageStats> getStats() final;
+
+    const SpecificStats* getSpecificStats() const final;
+
+protected:
+    void doSaveStateRequiresIndex() final;
+    void doRestoreStateRequiresIndex() final;
+    void doDetachFromOperationContext() final;
+    void doReattachToOperationContext() final;
+
+private:
+    struct Column {
+        std::string name;
+        std::unique_ptr<SortedDataInterface::Cursor> cursor;
+
+        // The index entry the cursor is positioned on, which owns the memory of 'cell'.
+        boost::optional<IndexKeyEntry> entry;
+        boost::optional<ColumnStoreAccessMethod::Cell> cell;
+
+        // Set once 'cell' has been used for a document, until the cursor has moved past it.
+        bool needsAdvance = false;
+    };
+
+    /**
+     * Positions every column on its first cell after '_lastRecordId', or on its first cell if no
+     * document has been returned yet.
+     */
+    void seekColumns();
+
+    /**
+     * Reads the cell following the current one in 'column'.
+     */
+    void advanceColumn(Column* column);
+
+    /**
+     * Updates the cell of 'column' from the index entry its cursor returned.
+     */
+    void setCell(Column* column, boost::optional<IndexKeyEntry> entry);
+
+    WorkingSet* _workingSet;
+    const MatchExpression* _filter;
+
+    // The '_id' column comes first.
+    std::vector<Column> _columns;
+
+    // Set until the columns have been positioned, and again after each yield.
+    bool _needsSeek = true;
+
+    boost::optional<RecordId> _lastRecordId;
+
+    ColumnScanStats _specificStats;
+};
+
+}  // namespace mongo
@@ -0,0 +1,103 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/cursor_spool_stage.h"
+
+namespace mongo {
+
+const char* CursorSpoolStage::kStageType = "CURSOR_SPOOL";
+
+CursorSpoolStage::CursorSpoolStage(ExpressionContext* expCtx, WorkingSet* ws, RecordStore* spool)
+    : PlanStage(kStageType, expCtx), _ws(ws), _spool(spool) {}
+
+PlanStage::StageState CursorSpoolStage::doWork(WorkingSetID* out) {
+    if (_isEOF) {
+        return PlanStage::IS_EOF;
+    }
+
+    if (!_cursor) {
+        _cursor = _spool->getCursor(opCtx());
+    }
+
+    auto record = _cursor->next();
+    if (!record) {
+        _isEOF = true;
+        _cursor.reset();
+        return PlanStage::IS_EOF;
+    }
+
+    WorkingSetID id = _ws->allocate();
+    WorkingSetMember* member = _ws->get(id);
+    member->resetDocument(SnapshotId(), record->data.toBson().getOwned());
+    member->transitionToOwnedObj();
+
+    *out = id;
+    return PlanStage::ADVANCED;
+}
+
+void CursorSpoolStage::doSaveState() {
+    if (_cursor) {
+        _cursor->save();
+    }
+}
+
+void CursorSpoolStage::doRestoreState(const RestoreContext& context) {
+    // Nothing removes records from the spool while the cursor is saved, so the position of the
+    // cursor can always be restored.
+    if (_cursor) {
+        invariant(_cursor->restore());
+    }
+}
+
+void CursorSpoolStage::doDetachFromOperationContext() {
+    if (_cursor) {
+        _cursor->detachFromOperationContext();
+    }
+}
+
+void CursorSpoolStage::doReattachToOperationContext() {
+    if (_cursor) {
+        _cursor->reattachToOperationContext(opCtx());
+    }
+}
+
+std::unique_ptr<PlanStageStats> CursorSpoolStage::getStats() {
+    _commonStats.isEOF = isEOF();
+    auto ret = std::make_unique<PlanStageStats>(_commonStats, STAGE_CURSOR_SPOOL);
+    ret->specific = std::make_unique<MockStats>(_specificStats);
+    return ret;
+}
+
+const SpecificStats* CursorSpoolStage::getSpecificStats() const {
+    return &_specificStats;
+}
+
+}  // namespace mongo
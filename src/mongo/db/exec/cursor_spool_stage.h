@@ -0,0 +1,85 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "mongo/db/exec/plan_stage.h"
+#include "mongo/db/exec/working_set.h"
+#include "mongo/db/storage/record_store.h"
+
+namespace mongo {
+
+/**
+ * CursorSpoolStage is a data-producing stage which returns, in insertion order, the documents
+ * stored in 'spool', a temporary record store into which the remaining results of a cursor were
+ * spooled. The stage does not own the record store, which must outlive it.
+ *
+ * Reading from the spool requires the caller to hold at least the global lock in MODE_IS.
+ */
+class CursorSpoolStage final : public PlanStage {
+public:
+    CursorSpoolStage(ExpressionContext* expCtx, WorkingSet* ws, RecordStore* spool);
+
+    StageState doWork(WorkingSetID* out) final;
+
+    bool isEOF() final {
+        return _isEOF;
+    }
+
+    StageType stageType() const final {
+        return STAGE_CURSOR_SPOOL;
+    }
+
+    std::unique_ptr<PlanStageStats> getStats() final;
+
+    const SpecificStats* getSpecificStats() const final;
+
+    static const char* kStageType;
+
+protected:
+    void doSaveState() final;
+    void doRestoreState(const RestoreContext& context) final;
+    void doDetachFromOperationContext() final;
+    void doReattachToOperationContext() final;
+
+private:
+    // We don't own these.
+    WorkingSet* _ws;
+    RecordStore* _spool;
+
+    std::unique_ptr<SeekableRecordCursor> _cursor;
+    bool _isEOF = false;
+
+    // Stats
+    MockStats _specificStats;
+};
+
+}  // namespace mongo
@@ -79,14 +79,27 @@ DeleteStage::DeleteStage(ExpressionContext* expCtx,
       _idRetrying(WorkingSet::INVALID_ID),
       _idReturning(WorkingSet::INVALID_ID) {
     _children.emplace_back(child);
+
+    // Deleting several documents in one WriteUnitOfWork would write all of their oplog entries in
+    // one storage transaction, so only batch the deletes which are not written to the oplog.
+    _batched = _params->isMulti && !_params->returnDeleted && !_params->removeSaver &&
+        _params->batchDocs > 1 &&
+        repl::ReplicationCoordinator::get(opCtx())->isOplogDisabledFor(opCtx(),
+                                                                       collection->ns());
+    if (_batched) {
+        _stagedDeletes.reserve(_params->batchDocs);
+    }
 }
 
 bool DeleteStage::isEOF() {
     if (!_params->isMulti && _specificStats.docsDeleted > 0) {
         return true;
     }
+    if (_params->limit && _specificStats.docsDeleted >= _params->limit) {
+        return true;
+    }
     return _idRetrying == WorkingSet::INVALID_ID && _idReturning == WorkingSet::INVALID_ID &&
-        child()->isEOF();
+        _stagedDeletes.empty() && child()->isEOF();
 }
 
 PlanStage::StageState DeleteStage::doWork(WorkingSetID* out) {
@@ -94,6 +107,10 @@ PlanStage::StageState DeleteStage::doWork(WorkingSetID* out) {
         return PlanStage::IS_EOF;
     }
 
+    if (_batched) {
+        return doBatchedWork(out);
+    }
+
     // It is possible that after a delete was executed, a WriteConflictException occurred
     // and prevented us from returning ADVANCED with the old version of the document.
     if (_idReturning != WorkingSet::INVALID_ID) {
@@ -250,6 +267,110 @@ PlanStage::StageState DeleteStage::doWork(WorkingSetID* out) {
     return PlanStage::NEED_TIME;
 }
 
+PlanStage::StageState DeleteStage::doBatchedWork(WorkingSetID* out) {
+    if (_stagedDeletes.size() >= _params->batchDocs || child()->isEOF() ||
+        (_params->limit && _specificStats.docsDeleted + _stagedDeletes.size() >= _params->limit)) {
+        return deleteStagedDocuments(out);
+    }
+
+    WorkingSetID id;
+    auto status = child()->work(&id);
+
+    switch (status) {
+        case PlanStage::ADVANCED:
+            break;
+
+        case PlanStage::NEED_TIME:
+            return status;
+
+        case PlanStage::NEED_YIELD:
+            *out = id;
+            return status;
+
+        case PlanStage::IS_EOF:
+            if (!_stagedDeletes.empty()) {
+                return deleteStagedDocuments(out);
+            }
+            return status;
+
+        default:
+            MONGO_UNREACHABLE;
+    }
+
+    WorkingSetMember* member = _ws->get(id);
+    invariant(member->hasRecordId());
+    invariant(member->hasObj());
+
+    // The document is checked against the predicate when its batch is deleted. Its BSONObj must
+    // be owned to survive the saveState() calls made until then.
+    member->makeObjOwnedIfNeeded();
+    _stagedDeletes.push_back(id);
+    return PlanStage::NEED_TIME;
+}
+
+PlanStage::StageState DeleteStage::deleteStagedDocuments(WorkingSetID* out) {
+    try {
+        child()->saveState();
+    } catch (const WriteConflictException&) {
+        std::terminate();
+    }
+
+    size_t docsDeleted = 0;
+    try {
+        boost::optional<WriteUnitOfWork> wunit;
+        if (!_params->isExplain) {
+            wunit.emplace(opCtx());
+        }
+
+        for (auto id : _stagedDeletes) {
+            // Documents may have been deleted or updated since they were staged, in particular if
+            // the plan yielded in between.
+            if (!write_stage_common::ensureStillMatches(
+                    collection(), opCtx(), _ws, id, _params->canonicalQuery)) {
+                continue;
+            }
+
+            if (!_params->isExplain) {
+                WorkingSetMember* member = _ws->get(id);
+                collection()->deleteDocument(
+                    opCtx(),
+                    Snapshotted(member->doc.snapshotId(), member->doc.value().toBson()),
+                    _params->stmtId,
+                    member->recordId,
+                    _params->opDebug,
+                    _params->fromMigrate,
+                    false,
+                    Collection::StoreDeletedDoc::Off);
+            }
+            ++docsDeleted;
+        }
+
+        if (wunit) {
+            wunit->commit();
+        }
+    } catch (const WriteConflictException&) {
+        // Nothing in the batch was deleted. Keep the staged members so the batch can be retried.
+        *out = WorkingSet::INVALID_ID;
+        return NEED_YIELD;
+    }
+
+    _specificStats.docsDeleted += docsDeleted;
+    for (auto id : _stagedDeletes) {
+        _ws->free(id);
+    }
+    _stagedDeletes.clear();
+
+    // Restore the state outside of the WriteUnitOfWork, as for a single delete.
+    try {
+        child()->restoreState(&collection());
+    } catch (const WriteConflictException&) {
+        *out = WorkingSet::INVALID_ID;
+        return NEED_YIELD;
+    }
+
+    return PlanStage::NEED_TIME;
+}
+
 void DeleteStage::doRestoreStateRequiresCollection() {
     const NamespaceString& ns = collection()->ns();
     uassert(ErrorCodes::PrimarySteppedDown,
@@ -64,6 +64,14 @@ struct DeleteStageParams {
     // Should we return the document we just deleted?
     bool returnDeleted;
 
+    // When greater than one, a multi delete which does not return the deleted documents and whose
+    // deletes are not written to the oplog removes up to this many documents in each
+    // WriteUnitOfWork rather than one at a time.
+    size_t batchDocs = 0;
+
+    // When not zero, a multi delete stops once it has deleted this many documents.
+    size_t limit = 0;
+
     // The stmtId for this particular delete.
     StmtId stmtId = kUninitializedStmtId;
 
@@ -130,6 +138,19 @@ private:
      */
     StageState prepareToRetryWSM(WorkingSetID idToRetry, WorkingSetID* out);
 
+    /**
+     * The work() implementation used when '_batched' is set. Stages the documents returned by the
+     * child until 'batchDocs' of them are staged or the child is exhausted, then deletes them.
+     */
+    StageState doBatchedWork(WorkingSetID* out);
+
+    /**
+     * Deletes every document in '_stagedDeletes' which still matches the predicate within a single
+     * WriteUnitOfWork. If the WriteUnitOfWork hits a write conflict, the staged documents are kept
+     * so that the whole batch is retried, and NEED_YIELD is returned.
+     */
+    StageState deleteStagedDocuments(WorkingSetID* out);
+
     std::unique_ptr<DeleteStageParams> _params;
 
     // Not owned by us.
@@ -141,6 +162,12 @@ private:
     // If not WorkingSet::INVALID_ID, we return this member to our caller.
     WorkingSetID _idReturning;
 
+    // Whether documents are deleted in batches of up to 'batchDocs' documents.
+    bool _batched = false;
+
+    // The members returned by the child which are yet to be deleted when '_batched' is set.
+    std::vector<WorkingSetID> _stagedDeletes;
+
     // Stats
     DeleteStats _specificStats;
 };
@@ -31,6 +31,7 @@
 
 #include "mongo/db/exec/document_value/document.h"
 
+#include <array>
 #include <boost/functional/hash.hpp>
 
 #include "mongo/bson/bson_depth.h"
@@ -46,6 +47,96 @@ using std::vector;
 
 const DocumentStorage DocumentStorage::kEmptyDoc;
 
+namespace {
+
+// Set once the calling thread's StorageBufferCache has been destroyed, so that DocumentStorage
+// objects destroyed later during thread exit go straight to the allocator.
+thread_local bool tlsStorageBufferCacheDestroyed = false;
+
+/**
+ * DocumentStorage grows its buffer in power-of-two sizes, and the documents which flow through a
+ * pipeline tend to have the same shape, so the buffer freed by one document is usually the size
+ * that the next one needs. Each thread keeps a few freed buffers of each of the smallest sizes
+ * and carves new DocumentStorage buffers from them, rather than going back to the allocator for
+ * every document. A buffer is still owned by a single DocumentStorage for its whole lifetime, so
+ * documents may outlive the batch or thread that created them.
+ */
+class StorageBufferCache {
+public:
+    StorageBufferCache() = default;
+    StorageBufferCache(const StorageBufferCache&) = delete;
+    StorageBufferCache& operator=(const StorageBufferCache&) = delete;
+
+    ~StorageBufferCache() {
+        for (auto&& sizeClass : _sizeClasses) {
+            for (size_t i = 0; i < sizeClass.numBuffers; ++i) {
+                delete[] sizeClass.buffers[i];
+            }
+        }
+        tlsStorageBufferCacheDestroyed = true;
+    }
+
+    char* allocate(size_t bytes) {
+        if (auto sizeClass = getSizeClass(bytes); sizeClass && sizeClass->numBuffers > 0) {
+            return sizeClass->buffers[--sizeClass->numBuffers];
+        }
+        return new char[bytes];
+    }
+
+    void free(char* buffer, size_t bytes) {
+        if (auto sizeClass = getSizeClass(bytes);
+            sizeClass && sizeClass->numBuffers < kMaxBuffersPerSizeClass) {
+            sizeClass->buffers[sizeClass->numBuffers++] = buffer;
+            return;
+        }
+        delete[] buffer;
+    }
+
+private:
+    // Buffers of 128, 256, 512 and 1024 bytes are cached. 128 bytes is the smallest buffer which
+    // DocumentStorage::alloc() creates.
+    static constexpr size_t kMinCachedBytes = 128;
+    static constexpr size_t kNumSizeClasses = 4;
+    static constexpr size_t kMaxBuffersPerSizeClass = 16;
+
+    struct SizeClass {
+        std::array<char*, kMaxBuffersPerSizeClass> buffers;
+        size_t numBuffers = 0;
+    };
+
+    SizeClass* getSizeClass(size_t bytes) {
+        size_t classBytes = kMinCachedBytes;
+        for (auto&& sizeClass : _sizeClasses) {
+            if (bytes == classBytes) {
+                return &sizeClass;
+            }
+            classBytes *= 2;
+        }
+        return nullptr;
+    }
+
+    std::array<SizeClass, kNumSizeClasses> _sizeClasses;
+};
+
+thread_local StorageBufferCache tlsStorageBufferCache;
+
+char* allocateStorageBuffer(size_t bytes) {
+    return tlsStorageBufferCacheDestroyed ? new char[bytes] : tlsStorageBufferCache.allocate(bytes);
+}
+
+void freeStorageBuffer(char* buffer, size_t bytes) {
+    if (!buffer) {
+        return;
+    }
+    if (tlsStorageBufferCacheDestroyed) {
+        delete[] buffer;
+        return;
+    }
+    tlsStorageBufferCache.free(buffer, bytes);
+}
+
+}  // namespace
+
 const StringDataSet Document::allMetadataFieldNames{Document::metaFieldTextScore,
                                                     Document::metaFieldRandVal,
                                                     Document::metaFieldSortKey,
@@ -242,6 +333,7 @@ void DocumentStorage::alloc(unsigned newSize) {
     const bool firstAlloc = !_cache;
     const bool doingRehash = needRehash();
     const size_t oldCapacity = _cacheEnd - _cache;
+    const size_t oldAllocatedBytes = allocatedBytes();
 
     // make new bucket count big enough
     while (needRehash() || hashTabBuckets() < HASH_TAB_INIT_SIZE)
@@ -254,13 +346,13 @@ void DocumentStorage::alloc(unsigned newSize) {
 
     uassert(16490, "Tried to make oversized document", capacity <= size_t(BufferMaxSize));
 
-    std::unique_ptr<char[]> oldBuf(_cache);
-    _cache = new char[capacity];
+    char* oldBuf = _cache;
+    _cache = allocateStorageBuffer(capacity);
     _cacheEnd = _cache + capacity - hashTabBytes();
 
     if (!firstAlloc) {
         // This just copies the elements
-        memcpy(_cache, oldBuf.get(), _usedBytes);
+        memcpy(_cache, oldBuf, _usedBytes);
 
         if (_numFields >= HASH_TAB_MIN) {
             // if we were hashing, deal with the hash table
@@ -268,10 +360,12 @@ void DocumentStorage::alloc(unsigned newSize) {
                 rehash();
             } else {
                 // no rehash needed so just slide table down to new position
-                memcpy(_hashTab, oldBuf.get() + oldCapacity, hashTabBytes());
+                memcpy(_hashTab, oldBuf + oldCapacity, hashTabBytes());
             }
         }
     }
+
+    freeStorageBuffer(oldBuf, oldAllocatedBytes);
 }
 
 void DocumentStorage::reserveFields(size_t expectedFields) {
@@ -287,7 +381,7 @@ void DocumentStorage::reserveFields(size_t expectedFields) {
 
     uassert(16491, "Tried to make oversized document", newSize <= size_t(BufferMaxSize));
 
-    _cache = new char[newSize + hashTabBytes()];
+    _cache = allocateStorageBuffer(newSize + hashTabBytes());
     _cacheEnd = _cache + newSize;
 }
 
@@ -298,7 +392,7 @@ intrusive_ptr<DocumentStorage> DocumentStorage::clone() const {
         // Make a copy of the buffer with the fields.
         // It is very important that the positions of each field are the same after cloning.
         const size_t bufferBytes = allocatedBytes();
-        out->_cache = new char[bufferBytes];
+        out->_cache = allocateStorageBuffer(bufferBytes);
         out->_cacheEnd = out->_cache + (_cacheEnd - _cache);
         memcpy(out->_cache, _cache, bufferBytes);
 
@@ -330,11 +424,11 @@ size_t DocumentStorage::getMetadataApproximateSize() const {
 }
 
 DocumentStorage::~DocumentStorage() {
-    std::unique_ptr<char[]> deleteBufferAtScopeEnd(_cache);
-
     for (auto it = iteratorCacheOnly(); !it.atEnd(); it.advance()) {
         it->val.~Value();  // explicit destructor call
     }
+
+    freeStorageBuffer(_cache, allocatedBytes());
 }
 
 void DocumentStorage::reset(const BSONObj& bson, bool stripMetadata) {
@@ -342,12 +436,14 @@ void DocumentStorage::reset(const BSONObj& bson, bool stripMetadata) {
     _stripMetadata = stripMetadata;
     _modified = false;
 
-    // Clean cache.
+    // Clean cache. The buffer is released, since the next field appended would reallocate it anyway.
     for (auto it = iteratorCacheOnly(); !it.atEnd(); it.advance()) {
         it->val.~Value();  // explicit destructor call
     }
 
-    _cacheEnd = _cache;
+    freeStorageBuffer(_cache, allocatedBytes());
+    _cache = nullptr;
+    _cacheEnd = nullptr;
     _usedBytes = 0;
     _numFields = 0;
     _hashTabMask = 0;
@@ -137,6 +137,23 @@ TEST(DocumentConstruction, FromBsonReset) {
     ASSERT_BSONOBJ_EQ(bson, toBson(newDocument));
 }
 
+TEST(DocumentConstruction, ReusesFreedStorage) {
+    // Documents built after earlier ones are destroyed may be handed their recycled buffers, which
+    // must not leak any of the earlier contents.
+    for (int i = 0; i < 100; ++i) {
+        MutableDocument md;
+        md.addField("a", Value(i));
+        md.addField("b", Value("q"_sd));
+        if (i % 2) {
+            md.addField("c", Value(BSON_ARRAY(i)));
+        }
+        auto document = md.freeze();
+        ASSERT_EQ(document["a"].getInt(), i);
+        ASSERT_VALUE_EQ(document["b"], Value("q"_sd));
+        ASSERT_EQ(document["c"].missing(), i % 2 == 0);
+    }
+}
+
 /**
  * Appends to 'builder' an object nested 'depth' levels deep.
  */
@@ -31,6 +31,7 @@
 
 #include "mongo/db/exec/fetch.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "mongo/db/catalog/collection.h"
@@ -38,6 +39,7 @@
 #include "mongo/db/exec/filter.h"
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/str.h"
 
@@ -57,7 +59,9 @@ FetchStage::FetchStage(ExpressionContext* expCtx,
     : RequiresCollectionStage(kStageType, expCtx, collection),
       _ws(ws),
       _filter((filter && !filter->isTriviallyTrue()) ? filter : nullptr),
-      _idRetrying(WorkingSet::INVALID_ID) {
+      _idRetrying(WorkingSet::INVALID_ID),
+      _readAheadWindow(internalQueryFetchReadAheadWindow.load()),
+      _prefetchBatchSize(std::max<size_t>(1, _readAheadWindow / 2)) {
     _children.emplace_back(std::move(child));
 }
 
@@ -69,7 +73,7 @@ bool FetchStage::isEOF() {
         return false;
     }
 
-    return child()->isEOF();
+    return _readAhead.empty() && child()->isEOF();
 }
 
 PlanStage::StageState FetchStage::doWork(WorkingSetID* out) {
@@ -80,12 +84,14 @@ PlanStage::StageState FetchStage::doWork(WorkingSetID* out) {
     // Either retry the last WSM we worked on or get a new one from our child.
     WorkingSetID id;
     StageState status;
-    if (_idRetrying == WorkingSet::INVALID_ID) {
-        status = child()->work(&id);
-    } else {
+    if (_idRetrying != WorkingSet::INVALID_ID) {
         status = ADVANCED;
         id = _idRetrying;
         _idRetrying = WorkingSet::INVALID_ID;
+    } else if (_readAheadWindow > 0) {
+        status = readAhead(&id);
+    } else {
+        status = child()->work(&id);
     }
 
     if (PlanStage::ADVANCED == status) {
@@ -125,10 +131,51 @@ PlanStage::StageState FetchStage::doWork(WorkingSetID* out) {
     return status;
 }
 
+PlanStage::StageState FetchStage::readAhead(WorkingSetID* out) {
+    if (_readAhead.size() < _readAheadWindow && !child()->isEOF()) {
+        WorkingSetID id = WorkingSet::INVALID_ID;
+        StageState status = child()->work(&id);
+        if (PlanStage::ADVANCED == status) {
+            _readAhead.push_back(id);
+            WorkingSetMember* member = _ws->get(id);
+            if (!member->hasObj()) {
+                _idsToPrefetch.push_back(member->recordId);
+            }
+        } else if (PlanStage::IS_EOF != status) {
+            *out = id;
+            return status;
+        }
+
+        if (_idsToPrefetch.size() >= _prefetchBatchSize ||
+            (child()->isEOF() && !_idsToPrefetch.empty())) {
+            collection()->getRecordStore()->prefetchRecords(opCtx(), _idsToPrefetch);
+            _specificStats.prefetchedRecords += _idsToPrefetch.size();
+            _idsToPrefetch.clear();
+        }
+
+        // Fill the window before fetching from it, so that the hints run ahead of the fetches.
+        if (_readAhead.size() < _readAheadWindow && !child()->isEOF()) {
+            return NEED_TIME;
+        }
+    }
+
+    if (_readAhead.empty()) {
+        return IS_EOF;
+    }
+    *out = _readAhead.front();
+    _readAhead.pop_front();
+    return ADVANCED;
+}
+
 void FetchStage::doSaveStateRequiresCollection() {
     if (_cursor) {
         _cursor->saveUnpositioned();
     }
+
+    // The members in the read-ahead window must survive the yield.
+    for (auto id : _readAhead) {
+        _ws->get(id)->makeObjOwnedIfNeeded();
+    }
 }
 
 void FetchStage::doRestoreStateRequiresCollection() {
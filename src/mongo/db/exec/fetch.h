@@ -29,7 +29,9 @@
 
 #pragma once
 
+#include <deque>
 #include <memory>
+#include <vector>
 
 #include "mongo/db/exec/requires_collection_stage.h"
 #include "mongo/db/jsobj.h"
@@ -86,6 +88,13 @@ private:
      */
     StageState returnIfMatches(WorkingSetMember* member, WorkingSetID memberID, WorkingSetID* out);
 
+    /**
+     * Tops up the read-ahead window from our child, then hands out the oldest member in the
+     * window. Returns what the child returned if it could not produce a member and the window is
+     * not full yet.
+     */
+    StageState readAhead(WorkingSetID* out);
+
     // Used to fetch Records from _collection.
     std::unique_ptr<SeekableRecordCursor> _cursor;
 
@@ -98,6 +107,14 @@ private:
     // If not Null, we use this rather than asking our child what to do next.
     WorkingSetID _idRetrying;
 
+    // The number of members we read from our child ahead of the one we fetch. The ids of the
+    // records in the window that need fetching are passed to the record store as a prefetch hint,
+    // in batches of '_prefetchBatchSize'. A window of 0 disables reading ahead.
+    const size_t _readAheadWindow;
+    const size_t _prefetchBatchSize;
+    std::deque<WorkingSetID> _readAhead;
+    std::vector<RecordId> _idsToPrefetch;
+
     // Stats
     FetchStats _specificStats;
 };
@@ -51,6 +51,7 @@
 #include "mongo/db/query/expression_index_knobs_gen.h"
 
 #include <algorithm>
+#include <cmath>
 
 namespace mongo {
 
@@ -461,7 +462,8 @@ GeoNear2DStage::GeoNear2DStage(const GeoNearParams& nearParams,
                 STAGE_GEO_NEAR_2D,
                 workingSet,
                 collection,
-                twoDIndex),
+                twoDIndex,
+                nearParams.limit),
       _nearParams(nearParams),
       _fullBounds(twoDDistanceBounds(nearParams, twoDIndex)),
       _currBounds(_fullBounds.center(), -1, _fullBounds.getInner()),
@@ -704,7 +706,8 @@ GeoNear2DSphereStage::GeoNear2DSphereStage(const GeoNearParams& nearParams,
                 STAGE_GEO_NEAR_2DSPHERE,
                 workingSet,
                 collection,
-                s2Index),
+                s2Index,
+                nearParams.limit),
       _nearParams(nearParams),
       _fullBounds(geoNearDistanceBounds(*nearParams.nearQuery)),
       _currBounds(_fullBounds.center(), -1, _fullBounds.getInner()),
@@ -931,12 +934,26 @@ std::unique_ptr<NearStage::CoveredInterval> GeoNear2DSphereStage::nextInterval(
 
     if (!_specificStats.intervalStats.empty()) {
         const IntervalStats& lastIntervalStats = _specificStats.intervalStats.back();
-
-        // TODO: Generally we want small numbers of results fast, then larger numbers later
-        if (lastIntervalStats.numResultsReturned < 300)
+        const size_t numResultsNeeded = numResultsStillNeeded();
+
+        if (numResultsNeeded && lastIntervalStats.numResultsBuffered > 0) {
+            // Only a few results are needed, so size the next annulus to hold about twice as many
+            // of them as the density of the last one suggests, treating annuli as planar. It grows
+            // no faster than it would without a limit, but shrinks right away over dense data.
+            const double inner = lastIntervalStats.minDistanceAllowed;
+            const double outer = lastIntervalStats.maxDistanceAllowed;
+            const double density =
+                lastIntervalStats.numResultsBuffered / (outer * outer - inner * inner);
+            const double nextOuter = std::sqrt(outer * outer + 2 * numResultsNeeded / density);
+            if (nextOuter > outer) {
+                _boundsIncrement = min(nextOuter - outer, 2 * _boundsIncrement);
+            }
+        } else if (lastIntervalStats.numResultsReturned < 300) {
+            // TODO: Generally we want small numbers of results fast, then larger numbers later
             _boundsIncrement *= 2;
-        else if (lastIntervalStats.numResultsReturned > 600)
+        } else if (lastIntervalStats.numResultsReturned > 600) {
             _boundsIncrement /= 2;
+        }
     }
 
     invariant(_boundsIncrement > 0.0);
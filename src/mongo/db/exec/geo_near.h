@@ -61,6 +61,9 @@ struct GeoNearParams {
     const GeoNearExpression* nearQuery;
     bool addPointMeta;
     bool addDistMeta;
+
+    // When not zero, only the 'limit' nearest results are needed.
+    size_t limit = 0;
 };
 
 /**
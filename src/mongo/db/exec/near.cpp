@@ -31,6 +31,7 @@
 
 #include "mongo/db/exec/near.h"
 
+#include <iterator>
 #include <memory>
 
 #include "mongo/db/exec/scoped_timer.h"
@@ -47,11 +48,13 @@ NearStage::NearStage(ExpressionContext* expCtx,
                      StageType type,
                      WorkingSet* workingSet,
                      const CollectionPtr& collection,
-                     const IndexDescriptor* indexDescriptor)
+                     const IndexDescriptor* indexDescriptor,
+                     size_t limit)
     : RequiresIndexStage(typeName, expCtx, collection, indexDescriptor, workingSet),
       _workingSet(workingSet),
       _searchState(SearchState_Initializing),
       _nextIntervalStats(nullptr),
+      _limit(limit),
       _stageType(type),
       _nextInterval(nullptr) {}
 
@@ -114,20 +117,14 @@ PlanStage::StageState NearStage::doWork(WorkingSetID* out) {
     return nextState;
 }
 
-/**
- * Holds a generic search result with a distance computed in some fashion.
- */
-struct NearStage::SearchResult {
-    SearchResult(WorkingSetID resultID, double distance) : resultID(resultID), distance(distance) {}
-
-    bool operator<(const SearchResult& other) const {
-        // We want increasing distance, not decreasing, so we reverse the <
-        return distance > other.distance;
+void NearStage::dropResult(std::multiset<SearchResult>::iterator it) {
+    WorkingSetMember* member = _workingSet->get(it->resultID);
+    if (member->hasRecordId()) {
+        _seenDocuments.erase(member->recordId);
     }
-
-    WorkingSetID resultID;
-    double distance;
-};
+    _workingSet->free(it->resultID);
+    _resultBuffer.erase(it);
+}
 
 // Set "toReturn" when NEED_YIELD.
 PlanStage::StageState NearStage::bufferNext(WorkingSetID* toReturn) {
@@ -185,15 +182,36 @@ PlanStage::StageState NearStage::bufferNext(WorkingSetID* toReturn) {
     // results.
     auto memberDistance = computeDistance(nextMember);
 
+    // Documents closer than the current interval are never returned, so there is no need to
+    // buffer them.
+    if (memberDistance < _nextInterval->minDistance) {
+        _workingSet->free(nextMemberID);
+        return PlanStage::NEED_TIME;
+    }
+
+    // When only the nearest results are needed, a result farther than all of the buffered ones
+    // is not needed if there are already enough of them. It is dropped without being kept track
+    // of, because a result we drop is never closer than the results returned instead of it.
+    const size_t numResultsNeeded = numResultsStillNeeded();
+    if (numResultsNeeded && _resultBuffer.size() == numResultsNeeded &&
+        memberDistance >= std::prev(_resultBuffer.end())->distance) {
+        _workingSet->free(nextMemberID);
+        return PlanStage::NEED_TIME;
+    }
+
     // Ensure that the BSONObj underlying the WorkingSetMember is owned in case we yield.
     nextMember->makeObjOwnedIfNeeded();
-    _resultBuffer.push(SearchResult(nextMemberID, memberDistance));
+    _resultBuffer.emplace(nextMemberID, memberDistance);
 
     // Store the member's RecordId, if available, for deduping.
     if (nextMember->hasRecordId()) {
         _seenDocuments.insert(std::make_pair(nextMember->recordId, nextMemberID));
     }
 
+    if (numResultsNeeded && _resultBuffer.size() > numResultsNeeded) {
+        dropResult(std::prev(_resultBuffer.end()));
+    }
+
     return PlanStage::NEED_TIME;
 }
 
@@ -207,17 +225,12 @@ PlanStage::StageState NearStage::advanceNext(WorkingSetID* toReturn) {
     // memberDistance is initialized to produce an error if used before its value is changed
     double memberDistance = std::numeric_limits<double>::lowest();
     if (!_resultBuffer.empty()) {
-        SearchResult result = _resultBuffer.top();
+        SearchResult result = *_resultBuffer.begin();
         memberDistance = result.distance;
 
         // Throw out all documents with memberDistance < minDistance
         if (memberDistance < _nextInterval->minDistance) {
-            WorkingSetMember* member = _workingSet->get(result.resultID);
-            if (member->hasRecordId()) {
-                _seenDocuments.erase(member->recordId);
-            }
-            _resultBuffer.pop();
-            _workingSet->free(result.resultID);
+            dropResult(_resultBuffer.begin());
             return PlanStage::NEED_TIME;
         }
 
@@ -241,7 +254,7 @@ PlanStage::StageState NearStage::advanceNext(WorkingSetID* toReturn) {
     }
 
     // The next document in _resultBuffer is in the search interval, so we can return it.
-    _resultBuffer.pop();
+    _resultBuffer.erase(_resultBuffer.begin());
 
     *toReturn = resultID;
 
@@ -255,6 +268,16 @@ PlanStage::StageState NearStage::advanceNext(WorkingSetID* toReturn) {
     // This value is used by nextInterval() to determine the size of the next interval.
     ++_nextIntervalStats->numResultsReturned;
 
+    // Once the limit is reached, the remaining buffered results are never returned and no further
+    // intervals need to be searched.
+    ++_numResultsReturned;
+    if (_limit && _numResultsReturned == _limit) {
+        while (!_resultBuffer.empty()) {
+            dropResult(_resultBuffer.begin());
+        }
+        _searchState = SearchState_Finished;
+    }
+
     return PlanStage::ADVANCED;
 }
 
@@ -30,7 +30,7 @@
 #pragma once
 
 #include <memory>
-#include <queue>
+#include <set>
 #include <vector>
 
 #include "mongo/base/status_with.h"
@@ -84,6 +84,10 @@ namespace mongo {
  * deduplicate. Every document in _resultBuffer is kept track of in _seenDocuments. When a document
  * is returned, it is removed from _seenDocuments.
  *
+ * If only the first 'limit' results are needed, the stage never buffers more results than are
+ * still to be returned: the farthest buffered result is dropped whenever a closer one arrives. The
+ * stage reaches EOF as soon as it has returned 'limit' results.
+ *
  * TODO: Right now the interface allows the nextCovering() to be adaptive, but doesn't allow
  * aborting and shrinking a covered range being buffered if we guess wrong.
  */
@@ -109,7 +113,8 @@ protected:
               StageType type,
               WorkingSet* workingSet,
               const CollectionPtr& collection,
-              const IndexDescriptor* indexDescriptor);
+              const IndexDescriptor* indexDescriptor,
+              size_t limit);
 
     //
     // Methods implemented for specific search functionality
@@ -145,10 +150,31 @@ protected:
 
     void doRestoreStateRequiresIndex() final {}
 
+    /**
+     * Returns the number of results which still have to be returned when the stage is limited, or
+     * 0 if it is not.
+     */
+    size_t numResultsStillNeeded() const {
+        return _limit ? _limit - _numResultsReturned : 0;
+    }
+
     // Filled in by subclasses.
     NearStats _specificStats;
 
 private:
+    // Holds a generic search result with a distance computed in some fashion.
+    struct SearchResult {
+        SearchResult(WorkingSetID resultID, double distance)
+            : resultID(resultID), distance(distance) {}
+
+        bool operator<(const SearchResult& other) const {
+            return distance < other.distance;
+        }
+
+        WorkingSetID resultID;
+        double distance;
+    };
+
     //
     // Generic methods for progressive search functionality
     //
@@ -157,6 +183,9 @@ private:
     StageState bufferNext(WorkingSetID* toReturn);
     StageState advanceNext(WorkingSetID* toReturn);
 
+    // Frees a buffered result which will not be returned.
+    void dropResult(std::multiset<SearchResult>::iterator it);
+
     //
     // Generic state for progressive near search
     //
@@ -178,9 +207,14 @@ private:
     // This is owned by _specificStats
     IntervalStats* _nextIntervalStats;
 
-    // Sorted buffered results to be returned - the current interval
-    struct SearchResult;
-    std::priority_queue<SearchResult> _resultBuffer;
+    // Sorted buffered results to be returned - the current interval. Ordered by increasing
+    // distance, so that both the nearest and, when the stage is limited, the farthest result can be
+    // taken out.
+    std::multiset<SearchResult> _resultBuffer;
+
+    // The number of results the parent needs, or 0 if it needs all of them.
+    const size_t _limit;
+    size_t _numResultsReturned = 0;
 
     // Stats
     const StageType _stageType;
@@ -254,6 +254,32 @@ struct CollectionScanStats : public SpecificStats {
     boost::optional<RecordId> maxRecord;
 };
 
+struct ColumnScanStats : public SpecificStats {
+    std::unique_ptr<SpecificStats> clone() const final {
+        auto specific = std::make_unique<ColumnScanStats>(*this);
+        specific->keyPattern = keyPattern.getOwned();
+        return specific;
+    }
+
+    uint64_t estimateObjectSizeInBytes() const {
+        return container_size_helper::estimateObjectSizeInBytes(
+                   columns,
+                   [](const auto& column) { return column.capacity(); },
+                   true) +
+            keyPattern.objsize() + indexName.capacity() + sizeof(*this);
+    }
+
+    std::string indexName;
+
+    BSONObj keyPattern;
+
+    // The columns read to reconstruct each document.
+    std::vector<std::string> columns;
+
+    // Number of cells read from the index.
+    size_t keysExamined = 0;
+};
+
 struct CountStats : public SpecificStats {
     CountStats() : nCounted(0), nSkipped(0) {}
 
@@ -428,6 +454,9 @@ struct FetchStats : public SpecificStats {
 
     // The total number of full documents touched by the fetch stage.
     size_t docsExamined = 0u;
+
+    // The number of records the fetch stage hinted to the record store ahead of fetching them.
+    size_t prefetchedRecords = 0u;
 };
 
 struct IDHackStats : public SpecificStats {
@@ -645,6 +674,11 @@ struct SortStats : public SpecificStats {
 
     // The number of times that we spilled data to disk during the execution of this query.
     uint64_t spills = 0u;
+
+    // The size of the data we spilled to disk, and the number of bytes it took up on disk after
+    // compression.
+    uint64_t spilledDataSizeBytes = 0u;
+    uint64_t spilledStorageSizeBytes = 0u;
 };
 
 struct MergeSortStats : public SpecificStats {
@@ -837,6 +871,11 @@ struct GroupStats : public SpecificStats {
 
     // Flag to specify if data was spilled to disk while grouping the data.
     bool usedDisk = false;
+
+    // The size of the data spilled to disk, and the number of bytes it took up on disk after
+    // compression.
+    uint64_t spilledDataSizeBytes = 0u;
+    uint64_t spilledStorageSizeBytes = 0u;
 };
 
 struct DocumentSourceCursorStats : public SpecificStats {
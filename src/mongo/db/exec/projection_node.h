@@ -31,6 +31,7 @@
 
 #include "mongo/db/exec/projection_executor.h"
 
+#include "mongo/db/pipeline/expression_program.h"
 #include "mongo/db/query/projection_policies.h"
 
 namespace mongo::projection_executor {
@@ -162,6 +163,9 @@ protected:
 
     stdx::unordered_map<std::string, std::unique_ptr<ProjectionNode>> _children;
     stdx::unordered_map<std::string, boost::intrusive_ptr<Expression>> _expressions;
+    // Compiled forms of the arithmetic expressions in '_expressions', built by optimize() if
+    // 'internalQueryCompileProjectionExpressions' is enabled.
+    stdx::unordered_map<std::string, ExpressionProgram> _compiledExpressions;
     stdx::unordered_set<std::string> _projectedFields;
     ProjectionPolicies _policies;
     std::string _pathToNode;
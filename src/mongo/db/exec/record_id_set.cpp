@@ -0,0 +1,124 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/record_id_set.h"
+
+#include <algorithm>
+
+namespace mongo {
+
+bool RecordIdSet::Chunk::insert(uint16_t low) {
+    if (_bitmap) {
+        auto& word = (*_bitmap)[low / 64];
+        auto bit = uint64_t{1} << (low % 64);
+        if (word & bit) {
+            return false;
+        }
+        word |= bit;
+        return true;
+    }
+
+    // RecordIds usually arrive in increasing order, which appends to the array.
+    auto it = _array.empty() || _array.back() < low
+        ? _array.end()
+        : std::lower_bound(_array.begin(), _array.end(), low);
+    if (it != _array.end() && *it == low) {
+        return false;
+    }
+
+    if (_array.size() < kMaxArraySize) {
+        _array.insert(it, low);
+        return true;
+    }
+
+    _bitmap = std::make_unique<std::array<uint64_t, kBitmapWords>>();
+    _bitmap->fill(0);
+    for (auto value : _array) {
+        (*_bitmap)[value / 64] |= uint64_t{1} << (value % 64);
+    }
+    _array.clear();
+    _array.shrink_to_fit();
+    return insert(low);
+}
+
+bool RecordIdSet::Chunk::contains(uint16_t low) const {
+    if (_bitmap) {
+        return (*_bitmap)[low / 64] & (uint64_t{1} << (low % 64));
+    }
+    return std::binary_search(_array.begin(), _array.end(), low);
+}
+
+size_t RecordIdSet::Chunk::memUsage() const {
+    return sizeof(Chunk) + (_bitmap ? sizeof(*_bitmap) : _array.capacity() * sizeof(uint16_t));
+}
+
+bool RecordIdSet::insert(const RecordId& recordId) {
+    bool inserted = recordId.withFormat(
+        [&](RecordId::Null) { return _otherRecordIds.insert(recordId).second; },
+        [&](int64_t repr) {
+            auto key = repr >> kChunkBits;
+            if (!_lastChunk || _lastChunkKey != key) {
+                _lastChunk = &_chunks[key];
+                _lastChunkKey = key;
+            }
+            return _lastChunk->insert(static_cast<uint16_t>(repr));
+        },
+        [&](const char*, int) { return _otherRecordIds.insert(recordId).second; });
+    _size += inserted;
+    return inserted;
+}
+
+bool RecordIdSet::contains(const RecordId& recordId) const {
+    return recordId.withFormat(
+        [&](RecordId::Null) { return _otherRecordIds.count(recordId) > 0; },
+        [&](int64_t repr) {
+            auto it = _chunks.find(repr >> kChunkBits);
+            return it != _chunks.end() && it->second.contains(static_cast<uint16_t>(repr));
+        },
+        [&](const char*, int) { return _otherRecordIds.count(recordId) > 0; });
+}
+
+void RecordIdSet::clear() {
+    _chunks.clear();
+    _lastChunk = nullptr;
+    _otherRecordIds.clear();
+    _size = 0;
+}
+
+size_t RecordIdSet::memUsage() const {
+    size_t usage = sizeof(RecordIdSet);
+    for (auto&& [key, chunk] : _chunks) {
+        usage += sizeof(key) + chunk.memUsage();
+    }
+    return usage + _otherRecordIds.size() * sizeof(RecordId);
+}
+
+}  // namespace mongo
@@ -0,0 +1,111 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "mongo/db/record_id.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/stdx/unordered_set.h"
+
+namespace mongo {
+
+/**
+ * A set of RecordIds which stores int64_t RecordIds compactly, for stages which need to remember
+ * every RecordId they have seen.
+ *
+ * The int64_t RecordIds are split into chunks of 2^16 consecutive values. A chunk keeps its first
+ * few RecordIds in a sorted array of their low 16 bits, and switches to a bitmap over the whole
+ * chunk once the array would outgrow it. Since record stores allocate RecordIds in mostly
+ * increasing order, the RecordIds seen by a query tend to be clustered in few chunks and take
+ * between one and sixteen bits each. RecordIds of other formats are kept in a hash set.
+ */
+class RecordIdSet {
+public:
+    /**
+     * Adds 'recordId' to the set. Returns true if it was not already in the set.
+     */
+    bool insert(const RecordId& recordId);
+
+    bool contains(const RecordId& recordId) const;
+
+    size_t size() const {
+        return _size;
+    }
+
+    bool empty() const {
+        return _size == 0;
+    }
+
+    void clear();
+
+    /**
+     * Returns an estimate of the number of bytes used by the set.
+     */
+    size_t memUsage() const;
+
+private:
+    /**
+     * The RecordIds of one chunk, by their low 16 bits.
+     */
+    class Chunk {
+    public:
+        bool insert(uint16_t low);
+        bool contains(uint16_t low) const;
+        size_t memUsage() const;
+
+    private:
+        static constexpr size_t kBitmapWords = (1 << 16) / 64;
+
+        // An array holding more values than this takes more space than the bitmap.
+        static constexpr size_t kMaxArraySize = kBitmapWords * sizeof(uint64_t) / sizeof(uint16_t);
+
+        // The sorted values, until the chunk switches to '_bitmap'.
+        std::vector<uint16_t> _array;
+        std::unique_ptr<std::array<uint64_t, kBitmapWords>> _bitmap;
+    };
+
+    static constexpr int kChunkBits = 16;
+
+    stdx::unordered_map<int64_t, Chunk> _chunks;
+
+    // The chunk inserted into last and its key, since consecutive RecordIds are usually in the same
+    // chunk. The chunks are node-based, so the pointer stays valid until the chunks are cleared.
+    Chunk* _lastChunk = nullptr;
+    int64_t _lastChunkKey = 0;
+
+    stdx::unordered_set<RecordId, RecordId::Hasher> _otherRecordIds;
+
+    size_t _size = 0;
+};
+
+}  // namespace mongo
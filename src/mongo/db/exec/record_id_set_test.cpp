@@ -0,0 +1,133 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/record_id_set.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(RecordIdSetTest, InsertReportsNewRecordIds) {
+    RecordIdSet set;
+    ASSERT_TRUE(set.empty());
+    ASSERT_TRUE(set.insert(RecordId(1)));
+    ASSERT_TRUE(set.insert(RecordId(3)));
+    ASSERT_FALSE(set.insert(RecordId(1)));
+    ASSERT_TRUE(set.insert(RecordId(2)));
+    ASSERT_EQ(set.size(), 3U);
+
+    ASSERT_TRUE(set.contains(RecordId(1)));
+    ASSERT_TRUE(set.contains(RecordId(2)));
+    ASSERT_TRUE(set.contains(RecordId(3)));
+    ASSERT_FALSE(set.contains(RecordId(4)));
+    ASSERT_FALSE(set.contains(RecordId(1 + (1 << 16))));
+}
+
+TEST(RecordIdSetTest, HandlesRecordIdsAcrossChunks) {
+    RecordIdSet set;
+    const std::vector<int64_t> values{RecordId::kMinRepr,
+                                      -(1 << 16) - 1,
+                                      -1,
+                                      0,
+                                      (1 << 16) - 1,
+                                      1 << 16,
+                                      int64_t{1} << 40,
+                                      RecordId::kMaxRepr};
+    for (auto value : values) {
+        ASSERT_TRUE(set.insert(RecordId(value)));
+    }
+    for (auto value : values) {
+        ASSERT_FALSE(set.insert(RecordId(value)));
+        ASSERT_TRUE(set.contains(RecordId(value)));
+    }
+    ASSERT_FALSE(set.contains(RecordId(-2)));
+    ASSERT_FALSE(set.contains(RecordId(1)));
+    ASSERT_EQ(set.size(), values.size());
+}
+
+TEST(RecordIdSetTest, DenseRecordIdsUseLittleMemory) {
+    RecordIdSet set;
+    const int64_t count = 100 * 1000;
+    for (int64_t i = 1; i <= count; ++i) {
+        ASSERT_TRUE(set.insert(RecordId(i)));
+    }
+    // Insert out of order into chunks which have switched to a bitmap.
+    for (int64_t i = count; i >= 1; i -= 7) {
+        ASSERT_FALSE(set.insert(RecordId(i)));
+    }
+    ASSERT_EQ(set.size(), static_cast<size_t>(count));
+    for (int64_t i = 0; i <= count + 1; ++i) {
+        ASSERT_EQ(set.contains(RecordId(i)), i >= 1 && i <= count) << i;
+    }
+
+    // The RecordIds take about one bit each.
+    ASSERT_LT(set.memUsage(), static_cast<size_t>(count / 4));
+}
+
+TEST(RecordIdSetTest, SparseRecordIdsInsertedOutOfOrder) {
+    RecordIdSet set;
+    for (int64_t i = 0; i < 5000; ++i) {
+        ASSERT_TRUE(set.insert(RecordId((i * 7919) % 5000 * 3)));
+    }
+    ASSERT_EQ(set.size(), 5000U);
+    for (int64_t i = 0; i < 15000; ++i) {
+        ASSERT_EQ(set.contains(RecordId(i)), i % 3 == 0) << i;
+    }
+}
+
+TEST(RecordIdSetTest, HandlesStringRecordIds) {
+    RecordIdSet set;
+    const char first[RecordId::kSmallStrSize] = "first";
+    const char second[RecordId::kSmallStrSize] = "second";
+    ASSERT_TRUE(set.insert(RecordId(first, sizeof(first))));
+    ASSERT_TRUE(set.insert(RecordId(1)));
+    ASSERT_FALSE(set.insert(RecordId(first, sizeof(first))));
+    ASSERT_TRUE(set.contains(RecordId(first, sizeof(first))));
+    ASSERT_FALSE(set.contains(RecordId(second, sizeof(second))));
+    ASSERT_EQ(set.size(), 2U);
+}
+
+TEST(RecordIdSetTest, ClearRemovesAllRecordIds) {
+    RecordIdSet set;
+    const char str[RecordId::kSmallStrSize] = "str";
+    set.insert(RecordId(1));
+    set.insert(RecordId(1 << 20));
+    set.insert(RecordId(str, sizeof(str)));
+    set.clear();
+    ASSERT_TRUE(set.empty());
+    ASSERT_FALSE(set.contains(RecordId(1)));
+    ASSERT_FALSE(set.contains(RecordId(1 << 20)));
+    ASSERT_FALSE(set.contains(RecordId(str, sizeof(str))));
+    ASSERT_TRUE(set.insert(RecordId(1)));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -445,6 +445,10 @@ static stdx::unordered_map<std::string, BuiltinFn> kBuiltinFunctions = {
     {"reverseArray", BuiltinFn{[](size_t n) { return n == 1; }, vm::Builtin::reverseArray, false}},
     {"dateAdd", BuiltinFn{[](size_t n) { return n == 5; }, vm::Builtin::dateAdd, false}},
     {"hasNullBytes", BuiltinFn{[](size_t n) { return n == 1; }, vm::Builtin::hasNullBytes, false}},
+    {"traverseCompare",
+     BuiltinFn{[](size_t n) { return n >= 5 && n % 2 == 1; }, vm::Builtin::traverseCompare, false}},
+    {"traverseIsMember",
+     BuiltinFn{[](size_t n) { return n == 2 || n == 3; }, vm::Builtin::traverseIsMember, false}},
 };
 
 /**
@@ -874,6 +878,28 @@ std::unique_ptr<RuntimeEnvironment> RuntimeEnvironment::makeCopy(bool isSmp) {
     return std::unique_ptr<RuntimeEnvironment>(new RuntimeEnvironment(*this));
 }
 
+std::unique_ptr<RuntimeEnvironment> RuntimeEnvironment::makeDeepCopy() const {
+    auto env = std::make_unique<RuntimeEnvironment>();
+
+    env->_state->slots = _state->slots;
+    env->_state->typeTags = _state->typeTags;
+    env->_state->vals = _state->vals;
+    env->_state->owned = _state->owned;
+    for (size_t idx = 0; idx < env->_state->vals.size(); ++idx) {
+        if (env->_state->owned[idx]) {
+            auto [tag, val] = value::copyValue(_state->typeTags[idx], _state->vals[idx]);
+            env->_state->typeTags[idx] = tag;
+            env->_state->vals[idx] = val;
+        }
+    }
+
+    for (auto&& [name, slot] : env->_state->slots) {
+        env->emplaceAccessor(slot.first, slot.second);
+    }
+
+    return env;
+}
+
 void RuntimeEnvironment::debugString(StringBuilder* builder) {
     using namespace std::literals;
 
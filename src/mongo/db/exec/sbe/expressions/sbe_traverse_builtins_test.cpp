@@ -0,0 +1,166 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include <limits>
+
+#include "mongo/db/exec/sbe/expression_test_base.h"
+#include "mongo/db/exec/sbe/values/bson.h"
+
+namespace mongo::sbe {
+
+class SBEBuiltinTraverseTest : public EExpressionTestFixture {
+protected:
+    using TypedValue = std::pair<value::TypeTags, value::Value>;
+    using Comparison = std::pair<vm::TraverseCompareOp, TypedValue>;
+
+    static std::unique_ptr<EExpression> makeConstantCopy(TypedValue value) {
+        auto [copyTag, copyVal] = value::copyValue(value.first, value.second);
+        return makeE<EConstant>(copyTag, copyVal);
+    }
+
+    void runAndAssert(std::unique_ptr<EExpression> expr, TypedValue expectedRes) {
+        auto compiledExpr = compileExpression(*expr);
+
+        auto actualValue = runCompiledExpression(compiledExpr.get());
+        value::ValueGuard actualValueGuard{actualValue};
+
+        ASSERT_EQ(actualValue.first, expectedRes.first);
+        if (expectedRes.first == value::TypeTags::Boolean) {
+            ASSERT_EQ(value::bitcastTo<bool>(actualValue.second),
+                      value::bitcastTo<bool>(expectedRes.second));
+        }
+    }
+
+    /**
+     * Assert that result of 'traverseCompare(input, elementsOnly, Nothing, comparisons...)' is
+     * equal to 'expectedRes'.
+     * NOTE: Values behind arguments of this function are owned by the caller.
+     */
+    void runAndAssertCompare(TypedValue input,
+                             bool elementsOnly,
+                             const std::vector<Comparison>& comparisons,
+                             TypedValue expectedRes) {
+        auto args = makeEs(makeConstantCopy(input),
+                           makeE<EConstant>(value::TypeTags::Boolean,
+                                            value::bitcastFrom<bool>(elementsOnly)),
+                           makeE<EConstant>(value::TypeTags::Nothing, 0));
+        for (auto&& [op, rhs] : comparisons) {
+            args.push_back(makeE<EConstant>(
+                value::TypeTags::NumberInt32,
+                value::bitcastFrom<int32_t>(static_cast<int32_t>(op))));
+            args.push_back(makeConstantCopy(rhs));
+        }
+        runAndAssert(makeE<EFunction>("traverseCompare", std::move(args)), expectedRes);
+    }
+
+    /**
+     * Assert that result of 'traverseIsMember(input, array)' is equal to 'expectedRes'.
+     * NOTE: Values behind arguments of this function are owned by the caller.
+     */
+    void runAndAssertIsMember(TypedValue input, TypedValue array, TypedValue expectedRes) {
+        runAndAssert(makeE<EFunction>("traverseIsMember",
+                                      makeEs(makeConstantCopy(input), makeConstantCopy(array))),
+                     expectedRes);
+    }
+};
+
+TEST_F(SBEBuiltinTraverseTest, CompareScalar) {
+    const auto gt5 = Comparison{vm::TraverseCompareOp::greater, makeInt32(5)};
+
+    runAndAssertCompare(makeInt32(7), false, {gt5}, makeBool(true));
+    runAndAssertCompare(makeDouble(3.5), false, {gt5}, makeBool(false));
+    runAndAssertCompare(makeNothing(), false, {gt5}, makeBool(false));
+    runAndAssertCompare(makeDouble(std::numeric_limits<double>::quiet_NaN()),
+                        false,
+                        {{vm::TraverseCompareOp::lessEq, makeInt32(5)}},
+                        makeBool(false));
+
+    // Values of other types never compare true to a number.
+    auto [strTag, strVal] = value::makeNewString("a string");
+    value::ValueGuard strGuard{strTag, strVal};
+    runAndAssertCompare({strTag, strVal}, false, {gt5}, makeBool(false));
+
+    // $elemMatch only looks at the elements of arrays.
+    runAndAssertCompare(makeInt32(7), true, {gt5}, makeNothing());
+}
+
+TEST_F(SBEBuiltinTraverseTest, CompareArray) {
+    const auto gt5 = Comparison{vm::TraverseCompareOp::greater, makeInt32(5)};
+    const auto lt10 = Comparison{vm::TraverseCompareOp::less, makeInt32(10)};
+
+    for (auto makeArrayFn : {makeBsonArray, makeArray}) {
+        auto matching = makeArrayFn(BSON_ARRAY(1 << 20 << 7));
+        value::ValueGuard matchingGuard{matching};
+        runAndAssertCompare(matching, false, {gt5}, makeBool(true));
+        runAndAssertCompare(matching, true, {gt5, lt10}, makeBool(true));
+
+        // No single element is both greater than 5 and less than 10.
+        auto notMatching = makeArrayFn(BSON_ARRAY(1 << 20 << BSON_ARRAY(7)));
+        value::ValueGuard notMatchingGuard{notMatching};
+        runAndAssertCompare(notMatching, false, {gt5}, makeBool(true));
+        runAndAssertCompare(notMatching, true, {gt5, lt10}, makeBool(false));
+
+        auto empty = makeArrayFn(BSONArray());
+        value::ValueGuard emptyGuard{empty};
+        runAndAssertCompare(empty, false, {gt5}, makeBool(false));
+        runAndAssertCompare(empty, true, {gt5}, makeNothing());
+
+        // The array itself is compared as well, unless only the elements are.
+        auto nested = makeArrayFn(BSON_ARRAY(BSON_ARRAY(1 << 2)));
+        value::ValueGuard nestedGuard{nested};
+        auto rhs = makeArrayFn(BSON_ARRAY(BSON_ARRAY(1 << 2)));
+        value::ValueGuard rhsGuard{rhs};
+        runAndAssertCompare(nested, false, {{vm::TraverseCompareOp::eq, rhs}}, makeBool(true));
+        runAndAssertCompare(nested, true, {{vm::TraverseCompareOp::eq, rhs}}, makeBool(false));
+    }
+}
+
+TEST_F(SBEBuiltinTraverseTest, IsMember) {
+    auto set = makeArraySet(BSON_ARRAY(3 << "x"));
+    value::ValueGuard setGuard{set};
+
+    runAndAssertIsMember(makeInt32(3), set, makeBool(true));
+    runAndAssertIsMember(makeInt64(4), set, makeBool(false));
+    runAndAssertIsMember(makeNothing(), set, makeBool(false));
+
+    for (auto makeArrayFn : {makeBsonArray, makeArray}) {
+        auto matching = makeArrayFn(BSON_ARRAY(1 << 2 << "x"));
+        value::ValueGuard matchingGuard{matching};
+        runAndAssertIsMember(matching, set, makeBool(true));
+
+        auto notMatching = makeArrayFn(BSON_ARRAY(1 << BSON_ARRAY(3)));
+        value::ValueGuard notMatchingGuard{notMatching};
+        runAndAssertIsMember(notMatching, set, makeBool(false));
+    }
+
+    runAndAssertIsMember(makeInt32(3), makeInt32(3), makeNothing());
+}
+
+}  // namespace mongo::sbe
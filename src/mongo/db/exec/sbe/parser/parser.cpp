@@ -35,6 +35,7 @@
 #include <charconv>
 
 #include "mongo/db/exec/sbe/stages/branch.h"
+#include "mongo/db/exec/sbe/stages/bson_scan.h"
 #include "mongo/db/exec/sbe/stages/co_scan.h"
 #include "mongo/db/exec/sbe/stages/exchange.h"
 #include "mongo/db/exec/sbe/stages/filter.h"
@@ -67,9 +68,9 @@ static constexpr auto kSyntax = R"(
 
                 PLAN_NODE_ID <- ('['([0-9])+']')
 
-                OPERATOR <- PLAN_NODE_ID? (SCAN / PSCAN / SEEK / IXSCAN / IXSEEK / PROJECT / FILTER / CFILTER /
-                            MKOBJ / MKBSON / GROUP / HJOIN / NLJOIN / LIMIT / SKIP / COSCAN / TRAVERSE /
-                            EXCHANGE / SORT / UNWIND / UNION / BRANCH / SIMPLE_PROJ / PFO /
+                OPERATOR <- PLAN_NODE_ID? (SCAN / PSCAN / SEEK / IXSCAN / IXSEEK / BSONSCAN / PROJECT / FILTER /
+                            CFILTER / MKOBJ / MKBSON / GROUP / HJOIN / NLJOIN / LIMIT / SKIP / COSCAN /
+                            TRAVERSE / EXCHANGE / SORT / UNWIND / UNION / BRANCH / SIMPLE_PROJ / PFO /
                             ESPOOL / LSPOOL / CSPOOL / SSPOOL / UNIQUE / SORTED_MERGE)
 
                 FORWARD_FLAG <- <'true'> / <'false'>
@@ -107,6 +108,10 @@ static constexpr auto kSyntax = R"(
                                    IDENT # index name to scan
                                    FORWARD_FLAG # forward seek or not
 
+                BSONSCAN <- 'bsonscan' IDENT? # optional variable name of the root object delivered by the scan
+                                       IDENT_LIST_WITH_RENAMES  # list of projected fields (may be empty)
+                                       IDENT # name of the input registered with addBSONInput()
+
                 PROJECT <- 'project' PROJECT_LIST OPERATOR
                 SIMPLE_PROJ <- '$p' IDENT # output
                                     IDENT # input
@@ -790,6 +795,35 @@ void Parser::walkIndexSeek(AstQuery& ast) {
                                       LockAcquisitionCallback{});
 }
 
+void Parser::walkBSONScan(AstQuery& ast) {
+    walkChildren(ast);
+
+    std::string recordName;
+    int projectsPos;
+
+    if (ast.nodes.size() == 3) {
+        recordName = std::move(ast.nodes[0]->identifier);
+        projectsPos = 1;
+    } else if (ast.nodes.size() == 2) {
+        projectsPos = 0;
+    } else {
+        MONGO_UNREACHABLE;
+    }
+
+    const auto& inputName = ast.nodes[projectsPos + 1]->identifier;
+    auto input = _bsonInputs.find(inputName);
+    uassert(5591500,
+            str::stream() << "Unknown BSON input [" << inputName << "]",
+            input != _bsonInputs.end());
+
+    ast.stage = makeS<BSONScanStage>(input->second.first,
+                                     input->second.second,
+                                     lookupSlot(recordName),
+                                     ast.nodes[projectsPos]->identifiers,
+                                     lookupSlots(ast.nodes[projectsPos]->renames),
+                                     getCurrentPlanNodeId());
+}
+
 void Parser::walkProject(AstQuery& ast) {
     walkChildren(ast);
 
@@ -1513,6 +1547,9 @@ void Parser::walk(AstQuery& ast) {
         case "IXSEEK"_:
             walkIndexSeek(ast);
             break;
+        case "BSONSCAN"_:
+            walkBSONScan(ast);
+            break;
         case "PROJECT"_:
             walkProject(ast);
             break;
@@ -66,6 +66,14 @@ public:
                                      StringData defaultDb,
                                      StringData line);
 
+    /**
+     * Registers a buffer of consecutive BSON objects, which 'bsonscan' stages that name 'input'
+     * read from. The buffer must outlive any plan parsed from it.
+     */
+    void addBSONInput(std::string input, const char* bsonBegin, const char* bsonEnd) {
+        _bsonInputs[std::move(input)] = {bsonBegin, bsonEnd};
+    }
+
     std::pair<boost::optional<value::SlotId>, boost::optional<value::SlotId>> getTopLevelSlots()
         const {
         return {_resultSlot, _recordIdSlot};
@@ -79,6 +87,7 @@ private:
     std::string _defaultDb;
     SymbolTable _symbolsLookupTable;
     SpoolBufferLookupTable _spoolBuffersLookupTable;
+    stdx::unordered_map<std::string, std::pair<const char*, const char*>> _bsonInputs;
     value::SlotIdGenerator _slotIdGenerator;
     value::SpoolIdGenerator _spoolIdGenerator;
     FrameId _frameId{0};
@@ -198,6 +207,7 @@ private:
     void walkSeek(AstQuery& ast);
     void walkIndexScan(AstQuery& ast);
     void walkIndexSeek(AstQuery& ast);
+    void walkBSONScan(AstQuery& ast);
     void walkProject(AstQuery& ast);
     void walkFilter(AstQuery& ast);
     void walkCFilter(AstQuery& ast);
@@ -269,5 +269,38 @@ TEST_F(SBEParserTest, TestPlanNodeIdIsParsed) {
     }
 }
 
+TEST_F(SBEParserTest, TestBSONScanReadsRegisteredInput) {
+    BufBuilder buffer;
+    for (int i = 0; i < 3; ++i) {
+        auto obj = BSON("a" << i);
+        buffer.appendBuf(obj.objdata(), obj.objsize());
+    }
+
+    sbe::Parser parser;
+    parser.addBSONInput("input", buffer.buf(), buffer.buf() + buffer.len());
+    auto stage = parser.parse(nullptr, "testDb", "bsonscan [$$RESULT = a] input");
+    auto resultSlot = parser.getTopLevelSlots().first;
+    ASSERT(resultSlot);
+
+    sbe::CompileCtx ctx{std::make_unique<sbe::RuntimeEnvironment>()};
+    stage->prepare(ctx);
+    auto accessor = stage->getAccessor(ctx, *resultSlot);
+    stage->open(false);
+    for (int i = 0; i < 3; ++i) {
+        ASSERT(stage->getNext() == sbe::PlanState::ADVANCED);
+        auto [tag, val] = accessor->getViewOfValue();
+        ASSERT(tag == sbe::value::TypeTags::NumberInt32);
+        ASSERT_EQ(sbe::value::bitcastTo<int32_t>(val), i);
+    }
+    ASSERT(stage->getNext() == sbe::PlanState::IS_EOF);
+    stage->close();
+}
+
+TEST_F(SBEParserTest, TestBSONScanOfUnknownInputFails) {
+    sbe::Parser parser;
+    ASSERT_THROWS_CODE(
+        parser.parse(nullptr, "testDb", "bsonscan [a] input"), DBException, 5591500);
+}
+
 }  // namespace
 }  // namespace mongo
@@ -0,0 +1,181 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/exec/sbe/expressions/expression.h"
+#include "mongo/db/exec/sbe/parser/parser.h"
+#include "mongo/db/query/query_test_service_context.h"
+
+namespace mongo {
+namespace sbe {
+namespace {
+
+/**
+ * Benchmarks SBE plans, written in the syntax of the SBE parser, over generated documents.
+ *
+ * Plans read the documents from two 'bsonscan' inputs:
+ *
+ * input - kNumDocuments documents of the form {_id: i, k: i % cardinality, x: i, s: "str<i>"}.
+ * keys - 'cardinality' documents of the form {k: i}.
+ *
+ * If the plan names a $$RESULT slot, its value is read for every row. The reported items per
+ * second are rows of 'input', so their inverse is the cost of the plan per input row.
+ */
+constexpr int kNumDocuments = 1000;
+
+void appendToBuffer(BufBuilder& buffer, const BSONObj& obj) {
+    buffer.appendBuf(obj.objdata(), obj.objsize());
+}
+
+void testPlan(StringData plan, benchmark::State& state) {
+    QueryTestServiceContext testServiceContext;
+    auto opContext = testServiceContext.makeOperationContext();
+
+    const int cardinality = state.range(0);
+
+    BufBuilder input;
+    for (int i = 0; i < kNumDocuments; ++i) {
+        appendToBuffer(input,
+                       BSON("_id" << i << "k" << i % cardinality << "x" << i << "s"
+                                  << "str" + std::to_string(i)));
+    }
+    BufBuilder keys;
+    for (int i = 0; i < cardinality; ++i) {
+        appendToBuffer(keys, BSON("k" << i));
+    }
+
+    Parser parser;
+    parser.addBSONInput("input", input.buf(), input.buf() + input.len());
+    parser.addBSONInput("keys", keys.buf(), keys.buf() + keys.len());
+    auto root = parser.parse(opContext.get(), "test", plan);
+
+    CompileCtx ctx{std::make_unique<RuntimeEnvironment>()};
+    root->prepare(ctx);
+    root->attachToOperationContext(opContext.get());
+    value::SlotAccessor* resultAccessor = nullptr;
+    if (auto resultSlot = parser.getTopLevelSlots().first) {
+        resultAccessor = root->getAccessor(ctx, *resultSlot);
+    }
+
+    for (auto keepRunning : state) {
+        root->open(false);
+        while (root->getNext() == PlanState::ADVANCED) {
+            if (resultAccessor) {
+                benchmark::DoNotOptimize(resultAccessor->getViewOfValue());
+            }
+        }
+        root->close();
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * kNumDocuments);
+}
+
+void BM_BSONScan(benchmark::State& state) {
+    testPlan("bsonscan $$RESULT [] input", state);
+}
+
+void BM_BSONScanFields(benchmark::State& state) {
+    testPlan("bsonscan [k, x, $$RESULT = s] input", state);
+}
+
+void BM_FilterComparison(benchmark::State& state) {
+    testPlan("filter {x >= 100 && k != 3} bsonscan $$RESULT [k, x] input", state);
+}
+
+void BM_ProjectArithmetic(benchmark::State& state) {
+    testPlan("project [$$RESULT = (x * 2 + k) / 3 - 1] bsonscan [k, x] input", state);
+}
+
+void BM_ProjectIf(benchmark::State& state) {
+    testPlan("project [$$RESULT = if(x < 500, k, fillEmpty(s, \"none\"))] "
+             "bsonscan [k, x, s] input",
+             state);
+}
+
+void BM_BuiltinConcat(benchmark::State& state) {
+    testPlan("project [$$RESULT = concat(s, \"-\", s)] bsonscan [s] input", state);
+}
+
+void BM_BuiltinToUpper(benchmark::State& state) {
+    testPlan("project [$$RESULT = toUpper(s)] bsonscan [s] input", state);
+}
+
+void BM_BuiltinNewObj(benchmark::State& state) {
+    testPlan("project [$$RESULT = newObj(\"k\", k, \"x\", x)] bsonscan [k, x] input", state);
+}
+
+void BM_HashAgg(benchmark::State& state) {
+    testPlan("project [$$RESULT = total] "
+             "group [k] [total = sum(x), largest = max(x), smallest = min(x)] "
+             "bsonscan [k, x] input",
+             state);
+}
+
+void BM_Sort(benchmark::State& state) {
+    testPlan("sort [k, x] [$$RESULT] bsonscan [k, x, $$RESULT = s] input", state);
+}
+
+void BM_LoopJoin(benchmark::State& state) {
+    testPlan("nlj [$$RESULT] [ok] "
+             "left bsonscan [ok = k, $$RESULT = s] input "
+             "right limit 1 filter {ik == ok} bsonscan [ik = k] keys",
+             state);
+}
+
+/**
+ * The argument is the number of distinct values of 'k', which the stages below group, sort or
+ * join on.
+ */
+void cardinalities(benchmark::internal::Benchmark* benchmark) {
+    benchmark->ArgName("cardinality");
+    for (int cardinality : {1, 10, 100, kNumDocuments}) {
+        benchmark->Arg(cardinality);
+    }
+}
+
+BENCHMARK(BM_BSONScan)->Arg(10);
+BENCHMARK(BM_BSONScanFields)->Arg(10);
+BENCHMARK(BM_FilterComparison)->Arg(10);
+BENCHMARK(BM_ProjectArithmetic)->Arg(10);
+BENCHMARK(BM_ProjectIf)->Arg(10);
+BENCHMARK(BM_BuiltinConcat)->Arg(10);
+BENCHMARK(BM_BuiltinToUpper)->Arg(10);
+BENCHMARK(BM_BuiltinNewObj)->Arg(10);
+BENCHMARK(BM_HashAgg)->Apply(cardinalities);
+BENCHMARK(BM_Sort)->Apply(cardinalities);
+BENCHMARK(BM_LoopJoin)->Apply(cardinalities);
+
+}  // namespace
+}  // namespace sbe
+}  // namespace mongo
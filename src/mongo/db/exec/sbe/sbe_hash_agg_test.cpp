@@ -37,7 +37,10 @@
 
 #include "mongo/db/exec/sbe/sbe_plan_stage_test.h"
 #include "mongo/db/exec/sbe/stages/hash_agg.h"
+#include "mongo/db/exec/sbe/stages/sort.h"
 #include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/db/storage/storage_options.h"
+#include "mongo/unittest/temp_dir.h"
 
 namespace mongo::sbe {
 
@@ -183,4 +186,83 @@ TEST_F(HashAggStageTest, HashAggAddToSetTest) {
     ASSERT_TRUE(resultsEnumerator.atEnd());
 }
 
+class HashAggStageSpillTest : public PlanStageTestFixture {
+protected:
+    /**
+     * Builds a HashAggStage which groups by the first scan slot and computes sum() and first() over
+     * the second scan slot, with a SortStage on top to make the order of the groups deterministic.
+     */
+    std::pair<value::SlotVector, std::unique_ptr<PlanStage>> makeGroupStage(
+        value::SlotVector scanSlots,
+        std::unique_ptr<PlanStage> scanStage,
+        bool allowDiskUse,
+        size_t memoryLimit) {
+        auto sumSlot = generateSlotId();
+        auto firstSlot = generateSlotId();
+        auto hashAggStage = makeS<HashAggStage>(
+            std::move(scanStage),
+            makeSV(scanSlots[0]),
+            makeEM(sumSlot,
+                   stage_builder::makeFunction("sum", makeE<EVariable>(scanSlots[1])),
+                   firstSlot,
+                   stage_builder::makeFunction("first", makeE<EVariable>(scanSlots[1]))),
+            kEmptyPlanNodeId,
+            allowDiskUse,
+            memoryLimit);
+
+        auto sortStage =
+            makeS<SortStage>(std::move(hashAggStage),
+                             makeSV(scanSlots[0]),
+                             std::vector<value::SortDirection>{value::SortDirection::Ascending},
+                             makeSV(sumSlot, firstSlot),
+                             std::numeric_limits<std::size_t>::max(),
+                             204857600,
+                             false,
+                             kEmptyPlanNodeId);
+
+        return {makeSV(scanSlots[0], sumSlot, firstSlot), std::move(sortStage)};
+    }
+
+    const BSONArray kInput = BSON_ARRAY(
+        BSON_ARRAY(3 << 1) << BSON_ARRAY(1 << 2) << BSON_ARRAY(2 << 3) << BSON_ARRAY(3 << 4)
+                           << BSON_ARRAY(4 << 5) << BSON_ARRAY(2 << 6) << BSON_ARRAY(4 << 7)
+                           << BSON_ARRAY(1 << 8) << BSON_ARRAY(5 << 9) << BSON_ARRAY(2 << 10));
+};
+
+TEST_F(HashAggStageSpillTest, SpillsGroupsWhenOverMemoryLimit) {
+    unittest::TempDir tempDir("HashAggStageSpillTest");
+    auto oldDbPath = storageGlobalParams.dbpath;
+    storageGlobalParams.dbpath = tempDir.path();
+    ON_BLOCK_EXIT([&] { storageGlobalParams.dbpath = oldDbPath; });
+
+    auto [inputTag, inputVal] = stage_builder::makeValue(kInput);
+    value::ValueGuard inputGuard{inputTag, inputVal};
+
+    auto [expectedTag, expectedVal] = stage_builder::makeValue(
+        BSON_ARRAY(BSON_ARRAY(1 << 10 << 2) << BSON_ARRAY(2 << 19 << 3) << BSON_ARRAY(3 << 5 << 1)
+                                            << BSON_ARRAY(4 << 12 << 5)
+                                            << BSON_ARRAY(5 << 9 << 9)));
+    value::ValueGuard expectedGuard{expectedTag, expectedVal};
+
+    // A memory limit of one byte forces all groups but the first one to be spilled.
+    auto makeStageFn = [this](value::SlotVector scanSlots, std::unique_ptr<PlanStage> scanStage) {
+        return makeGroupStage(scanSlots, std::move(scanStage), true /* allowDiskUse */, 1);
+    };
+
+    inputGuard.reset();
+    expectedGuard.reset();
+    runTestMulti(2, inputTag, inputVal, expectedTag, expectedVal, makeStageFn);
+}
+
+TEST_F(HashAggStageSpillTest, FailsWhenOverMemoryLimitWithoutDiskUse) {
+    auto [scanSlots, scanStage] = generateVirtualScanMulti(2, kInput);
+    auto [outSlots, stage] =
+        makeGroupStage(scanSlots, std::move(scanStage), false /* allowDiskUse */, 1);
+
+    auto ctx = makeCompileCtx();
+    ASSERT_THROWS_CODE(prepareTree(ctx.get(), stage.get()),
+                       DBException,
+                       ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed);
+}
+
 }  // namespace mongo::sbe
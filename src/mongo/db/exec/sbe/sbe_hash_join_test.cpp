@@ -0,0 +1,159 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+/**
+ * This file contains tests for sbe::HashJoinStage.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/sbe/sbe_plan_stage_test.h"
+#include "mongo/db/exec/sbe/stages/hash_join.h"
+#include "mongo/db/exec/sbe/stages/sort.h"
+#include "mongo/db/storage/storage_options.h"
+#include "mongo/unittest/temp_dir.h"
+
+namespace mongo::sbe {
+
+class HashJoinStageTest : public PlanStageTestFixture {
+protected:
+    /**
+     * Joins 'kOuter' and 'kInner' on their first fields and returns the pairs of their second
+     * fields, sorted so that the order of the results is deterministic.
+     */
+    std::pair<value::TypeTags, value::Value> runJoin(bool allowDiskUse, size_t memoryLimit) {
+        auto [outerSlots, outerStage] = generateVirtualScanMulti(2, kOuter);
+        auto [innerSlots, innerStage] = generateVirtualScanMulti(2, kInner);
+
+        auto hashJoinStage = makeS<HashJoinStage>(std::move(outerStage),
+                                                  std::move(innerStage),
+                                                  makeSV(outerSlots[0]),
+                                                  makeSV(outerSlots[1]),
+                                                  makeSV(innerSlots[0]),
+                                                  makeSV(innerSlots[1]),
+                                                  kEmptyPlanNodeId,
+                                                  allowDiskUse,
+                                                  memoryLimit);
+
+        auto resultSlots = makeSV(outerSlots[1], innerSlots[1]);
+        auto stage = makeS<SortStage>(std::move(hashJoinStage),
+                                      resultSlots,
+                                      std::vector<value::SortDirection>{
+                                          value::SortDirection::Ascending,
+                                          value::SortDirection::Ascending},
+                                      makeSV(),
+                                      std::numeric_limits<std::size_t>::max(),
+                                      204857600,
+                                      false,
+                                      kEmptyPlanNodeId);
+
+        auto ctx = makeCompileCtx();
+        auto resultAccessors = prepareTree(ctx.get(), stage.get(), resultSlots);
+        return getAllResultsMulti(stage.get(), resultAccessors);
+    }
+
+    void assertJoinResults(value::TypeTags resultsTag, value::Value resultsVal) {
+        value::ValueGuard resultsGuard{resultsTag, resultsVal};
+
+        auto [expectedTag, expectedVal] = stage_builder::makeValue(
+            BSON_ARRAY(BSON_ARRAY("b" << 10) << BSON_ARRAY("b" << 40) << BSON_ARRAY("c" << 20)
+                                             << BSON_ARRAY("d" << 10) << BSON_ARRAY("d" << 40)));
+        value::ValueGuard expectedGuard{expectedTag, expectedVal};
+
+        assertValuesEqual(resultsTag, resultsVal, expectedTag, expectedVal);
+    }
+
+    const BSONArray kOuter = BSON_ARRAY(BSON_ARRAY(1 << "a") << BSON_ARRAY(2 << "b")
+                                                             << BSON_ARRAY(3 << "c")
+                                                             << BSON_ARRAY(2 << "d"));
+    const BSONArray kInner = BSON_ARRAY(BSON_ARRAY(2 << 10) << BSON_ARRAY(3 << 20)
+                                                            << BSON_ARRAY(4 << 30)
+                                                            << BSON_ARRAY(2 << 40));
+};
+
+TEST_F(HashJoinStageTest, JoinsInMemory) {
+    auto [resultsTag, resultsVal] = runJoin(false, std::numeric_limits<size_t>::max());
+    assertJoinResults(resultsTag, resultsVal);
+}
+
+TEST_F(HashJoinStageTest, JoinsInMemoryWhenDiskUseAllowed) {
+    auto [resultsTag, resultsVal] = runJoin(true, std::numeric_limits<size_t>::max());
+    assertJoinResults(resultsTag, resultsVal);
+}
+
+TEST_F(HashJoinStageTest, PartitionsWhenOverMemoryLimit) {
+    unittest::TempDir tempDir("HashJoinStageTest");
+    auto oldDbPath = storageGlobalParams.dbpath;
+    storageGlobalParams.dbpath = tempDir.path();
+    ON_BLOCK_EXIT([&] { storageGlobalParams.dbpath = oldDbPath; });
+
+    // A memory limit of one byte makes the join partition both sides after the first outer row.
+    auto [resultsTag, resultsVal] = runJoin(true, 1);
+    assertJoinResults(resultsTag, resultsVal);
+}
+
+TEST_F(HashJoinStageTest, FailsWhenOverMemoryLimitWithoutDiskUse) {
+    ASSERT_THROWS_CODE(
+        runJoin(false, 1), DBException, ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed);
+}
+
+TEST_F(HashJoinStageTest, BloomFilterRejectsInnerRowsWithoutMatches) {
+    // None of the inner keys have a match on the outer side.
+    BSONArrayBuilder outer;
+    BSONArrayBuilder inner;
+    for (int i = 0; i < 100; ++i) {
+        outer.append(BSON_ARRAY(i << i));
+    }
+    for (int i = 1000; i < 2000; ++i) {
+        inner.append(BSON_ARRAY(i << i));
+    }
+
+    auto [outerSlots, outerStage] = generateVirtualScanMulti(2, outer.arr());
+    auto [innerSlots, innerStage] = generateVirtualScanMulti(2, inner.arr());
+    auto stage = makeS<HashJoinStage>(std::move(outerStage),
+                                      std::move(innerStage),
+                                      makeSV(outerSlots[0]),
+                                      makeSV(outerSlots[1]),
+                                      makeSV(innerSlots[0]),
+                                      makeSV(innerSlots[1]),
+                                      kEmptyPlanNodeId);
+
+    auto ctx = makeCompileCtx();
+    auto resultAccessors = prepareTree(ctx.get(), stage.get(), makeSV(innerSlots[1]));
+    auto [resultsTag, resultsVal] = getAllResultsMulti(stage.get(), resultAccessors);
+    value::ValueGuard resultsGuard{resultsTag, resultsVal};
+    ASSERT_EQ(value::getArrayView(resultsVal)->size(), 0U);
+
+    // The filter has a false positive rate of a few percent, so nearly all rows are rejected.
+    auto stats = static_cast<const HashJoinStats*>(stage->getSpecificStats());
+    ASSERT_GT(stats->bloomFilterRejectedRecords, 900);
+}
+
+}  // namespace mongo::sbe
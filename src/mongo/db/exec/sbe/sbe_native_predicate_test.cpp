@@ -0,0 +1,143 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/db/exec/sbe/expression_test_base.h"
+#include "mongo/db/exec/sbe/values/bson.h"
+#include "mongo/db/exec/sbe/vm/native_predicate.h"
+
+namespace mongo::sbe {
+
+class SBENativePredicateTest : public EExpressionTestFixture {
+protected:
+    /**
+     * Compiles 'expr' both to bytecode and to a native predicate, and asserts that the native
+     * predicate agrees with the interpreter on every value in 'inputs'.
+     */
+    void assertMatchesInterpreter(const EExpression& expr,
+                                  value::OwnedValueAccessor& accessor,
+                                  const BSONArray& inputs) {
+        auto code = compileExpression(expr);
+        auto native = vm::NativePredicate::compile(code.get());
+        ASSERT(native);
+
+        for (auto&& elem : inputs) {
+            auto [tag, val] = bson::convertFrom(
+                false, elem.rawdata(), elem.rawdata() + elem.size(), elem.fieldNameSize() - 1);
+            accessor.reset(tag, val);
+            ASSERT_EQ(runCompiledExpressionPredicate(code.get()), native->run()) << elem;
+        }
+    }
+
+    const BSONArray kInputs = BSON_ARRAY(1 << 5 << 10 << 5.5 << -7LL << "abc"
+                                           << "xyz" << BSONNULL << true << false << BSONObj()
+                                           << BSON_ARRAY(1 << 2));
+};
+
+TEST_F(SBENativePredicateTest, CompilesSlotToConstantComparisons) {
+    value::OwnedValueAccessor accessor;
+    auto slot = bindAccessor(&accessor);
+
+    for (auto op : {EPrimBinary::less,
+                    EPrimBinary::lessEq,
+                    EPrimBinary::greater,
+                    EPrimBinary::greaterEq,
+                    EPrimBinary::eq,
+                    EPrimBinary::neq}) {
+        auto expr = makeE<EPrimBinary>(
+            op, makeE<EVariable>(slot), makeE<EConstant>(value::TypeTags::NumberInt32, 5));
+        assertMatchesInterpreter(*expr, accessor, kInputs);
+
+        auto flipped = makeE<EPrimBinary>(
+            op, makeE<EConstant>(value::TypeTags::NumberInt32, 5), makeE<EVariable>(slot));
+        assertMatchesInterpreter(*flipped, accessor, kInputs);
+    }
+}
+
+TEST_F(SBENativePredicateTest, CompilesComparisonWrappedInFillEmptyFalse) {
+    value::OwnedValueAccessor accessor;
+    auto slot = bindAccessor(&accessor);
+
+    auto expr = makeE<EFunction>(
+        "fillEmpty",
+        makeEs(makeE<EPrimBinary>(EPrimBinary::greaterEq,
+                                  makeE<EVariable>(slot),
+                                  makeE<EConstant>(value::TypeTags::NumberDouble,
+                                                   value::bitcastFrom<double>(5.0))),
+               makeE<EConstant>(value::TypeTags::Boolean, value::bitcastFrom<bool>(false))));
+    assertMatchesInterpreter(*expr, accessor, kInputs);
+
+    // Nothing must fail the predicate.
+    auto code = compileExpression(*expr);
+    auto native = vm::NativePredicate::compile(code.get());
+    ASSERT(native);
+    accessor.reset(value::TypeTags::Nothing, 0);
+    ASSERT_FALSE(native->run());
+}
+
+TEST_F(SBENativePredicateTest, CompilesExistsAndBooleanSlot) {
+    value::OwnedValueAccessor accessor;
+    auto slot = bindAccessor(&accessor);
+
+    auto exists = makeE<EFunction>("exists", makeEs(makeE<EVariable>(slot)));
+    assertMatchesInterpreter(*exists, accessor, kInputs);
+
+    auto boolSlot = makeE<EVariable>(slot);
+    assertMatchesInterpreter(*boolSlot, accessor, kInputs);
+}
+
+TEST_F(SBENativePredicateTest, DoesNotCompileUnsupportedShapes) {
+    value::OwnedValueAccessor accessor;
+    auto slot = bindAccessor(&accessor);
+
+    // Arithmetic is not supported.
+    auto arith = makeE<EPrimBinary>(
+        EPrimBinary::less,
+        makeE<EPrimBinary>(EPrimBinary::add,
+                           makeE<EVariable>(slot),
+                           makeE<EConstant>(value::TypeTags::NumberInt32, 1)),
+        makeE<EConstant>(value::TypeTags::NumberInt32, 5));
+    ASSERT_FALSE(vm::NativePredicate::compile(compileExpression(*arith).get()));
+
+    // Filling empty with 'true' changes the outcome of the predicate.
+    auto fillTrue = makeE<EFunction>(
+        "fillEmpty",
+        makeEs(makeE<EPrimBinary>(EPrimBinary::less,
+                                  makeE<EVariable>(slot),
+                                  makeE<EConstant>(value::TypeTags::NumberInt32, 5)),
+               makeE<EConstant>(value::TypeTags::Boolean, value::bitcastFrom<bool>(true))));
+    ASSERT_FALSE(vm::NativePredicate::compile(compileExpression(*fillTrue).get()));
+
+    // Comparing two slots is not supported.
+    auto twoSlots =
+        makeE<EPrimBinary>(EPrimBinary::eq, makeE<EVariable>(slot), makeE<EVariable>(slot));
+    ASSERT_FALSE(vm::NativePredicate::compile(compileExpression(*twoSlots).get()));
+}
+
+}  // namespace mongo::sbe
@@ -232,21 +232,16 @@ void ExchangeConsumer::open(bool reOpen) {
                     lock, [this]() { return _state->consumerOpen() == _state->numOfConsumers(); });
             }
 
-            // Clone n copies of the subtree for every producer.
-
-            PlanStage* masterSubTree = _children[0].get();
-            masterSubTree->detachFromOperationContext();
+            // Clone n copies of the subtree for every producer. The master copy is kept around,
+            // outside of the children vector, so that the shape of the plan can still be reported
+            // by getStats() and debugPrint().
+            _masterSubTree = std::move(_children[0]);
+            _children.clear();
+            _masterSubTree->detachFromOperationContext();
 
             for (size_t idx = 0; idx < _state->numOfProducers(); ++idx) {
-                if (idx == 0) {
-                    _state->producerPlans().emplace_back(std::make_unique<ExchangeProducer>(
-                        std::move(_children[0]), _state, _commonStats.nodeId));
-                    // We have moved the child to the producer so clear the children vector.
-                    _children.clear();
-                } else {
-                    _state->producerPlans().emplace_back(std::make_unique<ExchangeProducer>(
-                        masterSubTree->clone(), _state, _commonStats.nodeId));
-                }
+                _state->producerPlans().emplace_back(std::make_unique<ExchangeProducer>(
+                    _masterSubTree->clone(), _state, _commonStats.nodeId));
             }
 
             // Start n producers.
@@ -367,10 +362,19 @@ void ExchangeConsumer::close() {
 
 std::unique_ptr<PlanStageStats> ExchangeConsumer::getStats(bool includeDebugInfo) const {
     auto ret = std::make_unique<PlanStageStats>(_commonStats);
-    ret->children.emplace_back(_children[0]->getStats(includeDebugInfo));
+    if (auto child = subTree()) {
+        ret->children.emplace_back(child->getStats(includeDebugInfo));
+    }
     return ret;
 }
 
+const PlanStage* ExchangeConsumer::subTree() const {
+    if (!_children.empty()) {
+        return _children[0].get();
+    }
+    return _masterSubTree.get();
+}
+
 const SpecificStats* ExchangeConsumer::getSpecificStats() const {
     return nullptr;
 }
@@ -401,7 +405,9 @@ std::vector<DebugPrinter::Block> ExchangeConsumer::debugPrint() const {
     }
 
     DebugPrinter::addNewLine(ret);
-    DebugPrinter::addBlocks(ret, _children[0]->debugPrint());
+    if (auto child = subTree()) {
+        DebugPrinter::addBlocks(ret, child->debugPrint());
+    }
 
     return ret;
 }
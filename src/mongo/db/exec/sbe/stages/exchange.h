@@ -276,9 +276,19 @@ private:
     ExchangeBuffer* getBuffer(size_t producerId);
     void putBuffer(size_t producerId);
 
+    /**
+     * Returns the subtree below this consumer, either as the child or, once the producers have
+     * been started, as the master copy which the producer plans were cloned from.
+     */
+    const PlanStage* subTree() const;
+
     std::shared_ptr<ExchangeState> _state;
     size_t _tid{0};
 
+    // The subtree the producer plans are cloned from. It is moved out of the children vector when
+    // the producers are started, as it never runs on this consumer's OperationContext.
+    std::unique_ptr<PlanStage> _masterSubTree;
+
     // Accessors for the outgoing values (from the exchange buffers).
     std::vector<ExchangeBuffer::Accessor> _outgoing;
 
@@ -31,7 +31,9 @@
 
 #include "mongo/db/exec/sbe/expressions/expression.h"
 #include "mongo/db/exec/sbe/stages/stages.h"
+#include "mongo/db/exec/sbe/vm/native_predicate.h"
 #include "mongo/db/exec/sbe/vm/vm.h"
+#include "mongo/db/query/query_knobs_gen.h"
 
 namespace mongo::sbe {
 /**
@@ -63,6 +65,15 @@ public:
 
         ctx.root = this;
         _filterCode = _filter->compile(ctx);
+
+        if (internalQuerySlotBasedExecutionEnableNativePredicates.load()) {
+            _nativeFilter = vm::NativePredicate::compile(_filterCode.get());
+            if (_nativeFilter) {
+                vm::NativePredicateCounters::compiled.increment();
+            } else {
+                vm::NativePredicateCounters::interpreted.increment();
+            }
+        }
     }
 
     value::SlotAccessor* getAccessor(CompileCtx& ctx, value::SlotId slot) final {
@@ -77,7 +88,7 @@ public:
         if constexpr (IsConst) {
             _specificStats.numTested++;
 
-            auto pass = _bytecode.runPredicate(_filterCode.get());
+            auto pass = runFilter();
             if (!pass) {
                 close();
                 return;
@@ -108,7 +119,7 @@ public:
             if (state == PlanState::ADVANCED) {
                 _specificStats.numTested++;
 
-                pass = _bytecode.runPredicate(_filterCode.get());
+                pass = runFilter();
 
                 if constexpr (IsEof) {
                     if (!pass) {
@@ -166,8 +177,14 @@ public:
     }
 
 private:
+    bool runFilter() {
+        return _nativeFilter ? _nativeFilter->run() : _bytecode.runPredicate(_filterCode.get());
+    }
+
     const std::unique_ptr<EExpression> _filter;
     std::unique_ptr<vm::CodeFragment> _filterCode;
+    // A natively compiled form of '_filterCode', if the filter has a shape that supports it.
+    std::unique_ptr<vm::NativePredicate> _nativeFilter;
 
     vm::ByteCode _bytecode;
 
@@ -31,25 +31,48 @@
 
 #include "mongo/db/exec/sbe/stages/hash_agg.h"
 
+#include "mongo/db/storage/storage_options.h"
 #include "mongo/util/str.h"
 
+namespace {
+std::string nextFileName() {
+    static mongo::AtomicWord<unsigned> hashAggFileCounter;
+    return "extsort-hash-agg-sbe." + std::to_string(hashAggFileCounter.fetchAndAdd(1));
+}
+}  // namespace
+
+#include "mongo/db/sorter/sorter.cpp"
+
 namespace mongo {
 namespace sbe {
 HashAggStage::HashAggStage(std::unique_ptr<PlanStage> input,
                            value::SlotVector gbs,
                            value::SlotMap<std::unique_ptr<EExpression>> aggs,
-                           PlanNodeId planNodeId)
-    : PlanStage("group"_sd, planNodeId), _gbs(std::move(gbs)), _aggs(std::move(aggs)) {
+                           PlanNodeId planNodeId,
+                           bool allowDiskUse,
+                           size_t memoryLimit)
+    : PlanStage("group"_sd, planNodeId),
+      _gbs(std::move(gbs)),
+      _aggs(std::move(aggs)),
+      _allowDiskUse(allowDiskUse),
+      _memoryLimit(memoryLimit),
+      _spillData({0, 0}) {
     _children.emplace_back(std::move(input));
 }
 
+HashAggStage::~HashAggStage() {}
+
 std::unique_ptr<PlanStage> HashAggStage::clone() const {
     value::SlotMap<std::unique_ptr<EExpression>> aggs;
     for (auto& [k, v] : _aggs) {
         aggs.emplace(k, v->clone());
     }
-    return std::make_unique<HashAggStage>(
-        _children[0]->clone(), _gbs, std::move(aggs), _commonStats.nodeId);
+    return std::make_unique<HashAggStage>(_children[0]->clone(),
+                                          _gbs,
+                                          std::move(aggs),
+                                          _commonStats.nodeId,
+                                          _allowDiskUse,
+                                          _memoryLimit);
 }
 
 void HashAggStage::prepare(CompileCtx& ctx) {
@@ -94,6 +117,19 @@ value::SlotAccessor* HashAggStage::getAccessor(CompileCtx& ctx, value::SlotId sl
         if (auto it = _outAccessors.find(slot); it != _outAccessors.end()) {
             return it->second;
         }
+    } else if (_allowDiskUse) {
+        // The aggregate expressions are being compiled, so hand out an accessor which can read
+        // either the current input row or a spilled row.
+        if (auto it = _aggInputSlots.find(slot); it != _aggInputSlots.end()) {
+            return _aggInputAccessors[it->second].get();
+        }
+
+        auto idx = _aggInputAccessors.size();
+        _aggInputSlots.emplace(slot, idx);
+        _inAggAccessors.emplace_back(_children[0]->getAccessor(ctx, slot));
+        _aggInputAccessors.emplace_back(std::make_unique<value::ViewOfValueAccessor>());
+        _spilledInputAccessors.emplace_back(std::make_unique<SpillAccessor>(_spillDataIt, idx));
+        return _aggInputAccessors.back().get();
     } else {
         return _children[0]->getAccessor(ctx, slot);
     }
@@ -101,6 +137,115 @@ value::SlotAccessor* HashAggStage::getAccessor(CompileCtx& ctx, value::SlotId sl
     return ctx.getAccessor(slot);
 }
 
+void HashAggStage::accumulate() {
+    for (size_t idx = 0; idx < _outAggAccessors.size(); ++idx) {
+        auto [owned, tag, val] = _bytecode.run(_aggCodes[idx].get());
+        _outAggAccessors[idx]->reset(owned, tag, val);
+    }
+}
+
+void HashAggStage::makeSorter() {
+    SortOptions opts;
+    opts.tempDir = storageGlobalParams.dbpath + "/_tmp";
+    opts.maxMemoryUsageBytes = _memoryLimit;
+    opts.extSortAllowed = true;
+
+    auto comp = [](const SpillData& lhs, const SpillData& rhs) {
+        auto size = lhs.first.size();
+        for (size_t idx = 0; idx < size; ++idx) {
+            auto [lhsTag, lhsVal] = lhs.first.getViewOfValue(idx);
+            auto [rhsTag, rhsVal] = rhs.first.getViewOfValue(idx);
+            auto [tag, val] = value::compareValue(lhsTag, lhsVal, rhsTag, rhsVal);
+
+            auto result = value::bitcastTo<int32_t>(val);
+            if (result) {
+                return result;
+            }
+        }
+
+        return 0;
+    };
+
+    _sorter.reset(Sorter<value::MaterializedRow, value::MaterializedRow>::make(opts, comp, {}));
+}
+
+void HashAggStage::spillRow(const value::MaterializedRow& key) {
+    if (!_sorter) {
+        makeSorter();
+    }
+
+    value::MaterializedRow spillKey{key.size() + 1};
+    for (size_t idx = 0; idx < key.size(); ++idx) {
+        auto [tag, val] = key.getViewOfValue(idx);
+        auto [copyTag, copyVal] = value::copyValue(tag, val);
+        spillKey.reset(idx, true, copyTag, copyVal);
+    }
+    spillKey.reset(
+        key.size(), false, value::TypeTags::NumberInt64, value::bitcastFrom<int64_t>(_spillSeq++));
+
+    value::MaterializedRow spillValue{_inAggAccessors.size()};
+    for (size_t idx = 0; idx < _inAggAccessors.size(); ++idx) {
+        auto [tag, val] = _inAggAccessors[idx]->copyOrMoveValue();
+        spillValue.reset(idx, true, tag, val);
+    }
+
+    _sorter->emplace(std::move(spillKey), std::move(spillValue));
+    ++_specificStats.spilledRecords;
+}
+
+bool HashAggStage::readSpilledGroup() {
+    if (!_hasPendingSpilledRow) {
+        if (!_spillIt || !_spillIt->more()) {
+            return false;
+        }
+        _spillData = _spillIt->next();
+    }
+    _hasPendingSpilledRow = false;
+
+    // The spilled key has a trailing sequence number, which is not a part of the group key.
+    auto groupKeySize = _spillData.first.size() - 1;
+    value::MaterializedRow key{groupKeySize};
+    for (size_t idx = 0; idx < groupKeySize; ++idx) {
+        auto [tag, val] = _spillData.first.getViewOfValue(idx);
+        key.reset(idx, false, tag, val);
+    }
+    key.makeOwned();
+
+    _ht.clear();
+    auto [it, inserted] = _ht.try_emplace(std::move(key), value::MaterializedRow{0});
+    invariant(inserted);
+    it->second.resize(_outAggAccessors.size());
+    _htIt = it;
+
+    value::MaterializedRowEq eq;
+    for (;;) {
+        for (size_t idx = 0; idx < _aggInputAccessors.size(); ++idx) {
+            auto [tag, val] = _spilledInputAccessors[idx]->getViewOfValue();
+            _aggInputAccessors[idx]->reset(tag, val);
+        }
+        accumulate();
+
+        if (!_spillIt->more()) {
+            break;
+        }
+        _spillData = _spillIt->next();
+
+        bool sameGroup = true;
+        for (size_t idx = 0; idx < groupKeySize && sameGroup; ++idx) {
+            auto [lhsTag, lhsVal] = _htIt->first.getViewOfValue(idx);
+            auto [rhsTag, rhsVal] = _spillData.first.getViewOfValue(idx);
+            auto [tag, val] = value::compareValue(lhsTag, lhsVal, rhsTag, rhsVal);
+            sameGroup = tag == value::TypeTags::NumberInt32 && value::bitcastTo<int32_t>(val) == 0;
+        }
+        if (!sameGroup) {
+            _hasPendingSpilledRow = true;
+            break;
+        }
+    }
+
+    return true;
+}
+
 void HashAggStage::open(bool reOpen) {
     auto optTimer(getOptTimer(_opCtx));
 
@@ -110,6 +255,11 @@ void HashAggStage::open(bool reOpen) {
     if (reOpen) {
         _ht.clear();
     }
+    _memoryUsage = 0;
+    _sorter.reset();
+    _spillIt.reset();
+    _hasPendingSpilledRow = false;
+    _spillSeq = 0;
 
     while (_children[0]->getNext() == PlanState::ADVANCED) {
         value::MaterializedRow key{_inKeyAccessors.size()};
@@ -120,30 +270,73 @@ void HashAggStage::open(bool reOpen) {
             key.reset(idx++, false, tag, val);
         }
 
-        auto [it, inserted] = _ht.try_emplace(std::move(key), value::MaterializedRow{0});
-        if (inserted) {
+        if (_allowDiskUse) {
+            for (size_t idx = 0; idx < _inAggAccessors.size(); ++idx) {
+                auto [tag, val] = _inAggAccessors[idx]->getViewOfValue();
+                _aggInputAccessors[idx]->reset(tag, val);
+            }
+        }
+
+        auto it = _ht.find(key);
+        if (it == _ht.end()) {
+            if (_memoryUsage > _memoryLimit) {
+                // Once the memory limit has been exceeded, rows of new groups are spilled. As no
+                // more groups are added to the hash table afterwards, all rows of a spilled group
+                // end up in the spill sorter.
+                uassert(ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed,
+                        "Exceeded memory limit for $group, but didn't allow external sort."
+                        " Pass allowDiskUse:true to opt in.",
+                        _allowDiskUse);
+                spillRow(key);
+                continue;
+            }
+
+            bool inserted;
+            std::tie(it, inserted) = _ht.try_emplace(std::move(key), value::MaterializedRow{0});
+            invariant(inserted);
             // Copy keys.
             const_cast<value::MaterializedRow&>(it->first).makeOwned();
             // Initialize accumulators.
             it->second.resize(_outAggAccessors.size());
+
+            _htIt = it;
+            accumulate();
+
+            // The memory usage is estimated when a group is created. Accumulators which grow with
+            // their input, such as $push, are therefore only partially accounted for.
+            _memoryUsage += it->first.memUsageForSorter() + it->second.memUsageForSorter();
+            continue;
         }
 
         // Accumulate.
         _htIt = it;
-        for (size_t idx = 0; idx < _outAggAccessors.size(); ++idx) {
-            auto [owned, tag, val] = _bytecode.run(_aggCodes[idx].get());
-            _outAggAccessors[idx]->reset(owned, tag, val);
-        }
+        accumulate();
     }
 
     _children[0]->close();
 
+    if (_sorter) {
+        _specificStats.usedDisk = _specificStats.usedDisk || _sorter->numSpills() > 0;
+        _spillIt.reset(_sorter->done());
+    }
+
     _htIt = _ht.end();
 }
 
 PlanState HashAggStage::getNext() {
     auto optTimer(getOptTimer(_opCtx));
 
+    // The groups which were spilled are returned after all of the in-memory groups, once the
+    // hash table has been exhausted, one group at a time.
+    if (_spillIt && _htIt != _ht.end() && std::next(_htIt) == _ht.end()) {
+        if (readSpilledGroup()) {
+            return trackPlanState(PlanState::ADVANCED);
+        }
+        _ht.clear();
+        _htIt = _ht.end();
+        return trackPlanState(PlanState::IS_EOF);
+    }
+
     if (_htIt == _ht.end()) {
         _htIt = _ht.begin();
     } else {
@@ -151,6 +344,10 @@ PlanState HashAggStage::getNext() {
     }
 
     if (_htIt == _ht.end()) {
+        // The in-memory hash table was empty, so there may only be spilled groups.
+        if (_spillIt && readSpilledGroup()) {
+            return trackPlanState(PlanState::ADVANCED);
+        }
         return trackPlanState(PlanState::IS_EOF);
     }
 
@@ -159,11 +356,16 @@ PlanState HashAggStage::getNext() {
 
 std::unique_ptr<PlanStageStats> HashAggStage::getStats(bool includeDebugInfo) const {
     auto ret = std::make_unique<PlanStageStats>(_commonStats);
+    ret->specific = std::make_unique<HashAggStats>(_specificStats);
 
     if (includeDebugInfo) {
         DebugPrinter printer;
         BSONObjBuilder bob;
         bob.append("groupBySlots", _gbs);
+        if (_allowDiskUse) {
+            bob.appendBool("usedDisk", _specificStats.usedDisk);
+            bob.appendNumber("spilledRecords", _specificStats.spilledRecords);
+        }
         if (!_aggs.empty()) {
             BSONObjBuilder childrenBob(bob.subobjStart("expressions"));
             for (auto&& [slot, expr] : _aggs) {
@@ -178,7 +380,7 @@ std::unique_ptr<PlanStageStats> HashAggStage::getStats(bool includeDebugInfo) co
 }
 
 const SpecificStats* HashAggStage::getSpecificStats() const {
-    return nullptr;
+    return &_specificStats;
 }
 
 void HashAggStage::close() {
@@ -186,6 +388,9 @@ void HashAggStage::close() {
 
     _commonStats.closes++;
     _ht.clear();
+    _spillIt.reset();
+    _sorter.reset();
+    _hasPendingSpilledRow = false;
 }
 
 std::vector<DebugPrinter::Block> HashAggStage::debugPrint() const {
@@ -36,14 +36,35 @@
 #include "mongo/db/exec/sbe/vm/vm.h"
 #include "mongo/stdx/unordered_map.h"
 
+namespace mongo {
+template <typename Key, typename Value>
+class SortIteratorInterface;
+template <typename Key, typename Value>
+class Sorter;
+}  // namespace mongo
+
 namespace mongo {
 namespace sbe {
+/**
+ * Groups its input by the values of the 'gbs' slots and computes the 'aggs' aggregate expressions
+ * for each group.
+ *
+ * Once the estimated size of the hash table exceeds 'memoryLimit', input rows with group keys that
+ * are not yet in the table are no longer aggregated in memory. If 'allowDiskUse' is true, such rows
+ * are instead handed to a Sorter, ordered by group key, which spills them to disk as needed. After
+ * the in-memory groups have been returned, the sorted rows are read back one group at a time and
+ * aggregated with the same aggregate expressions. Otherwise, exceeding the limit is an error.
+ */
 class HashAggStage final : public PlanStage {
 public:
     HashAggStage(std::unique_ptr<PlanStage> input,
                  value::SlotVector gbs,
                  value::SlotMap<std::unique_ptr<EExpression>> aggs,
-                 PlanNodeId planNodeId);
+                 PlanNodeId planNodeId,
+                 bool allowDiskUse = false,
+                 size_t memoryLimit = std::numeric_limits<size_t>::max());
+
+    ~HashAggStage();
 
     std::unique_ptr<PlanStage> clone() const final;
 
@@ -66,8 +87,33 @@ private:
     using HashKeyAccessor = value::MaterializedRowKeyAccessor<TableType::iterator>;
     using HashAggAccessor = value::MaterializedRowValueAccessor<TableType::iterator>;
 
+    using SpillIterator = SortIteratorInterface<value::MaterializedRow, value::MaterializedRow>;
+    using SpillData = std::pair<value::MaterializedRow, value::MaterializedRow>;
+    using SpillAccessor = value::MaterializedRowValueAccessor<SpillData*>;
+
+    /**
+     * Runs the aggregate expressions against the current input row for the group at '_htIt'.
+     */
+    void accumulate();
+
+    /**
+     * Hands the current input row over to the spill sorter. The sort key consists of the group key
+     * followed by a sequence number, so that rows of a group are read back in their input order.
+     */
+    void spillRow(const value::MaterializedRow& key);
+
+    /**
+     * Reads the next group from the spill sorter into a fresh hash table. Returns false once the
+     * sorter is exhausted.
+     */
+    bool readSpilledGroup();
+
+    void makeSorter();
+
     const value::SlotVector _gbs;
     const value::SlotMap<std::unique_ptr<EExpression>> _aggs;
+    const bool _allowDiskUse;
+    const size_t _memoryLimit;
 
     value::SlotAccessorMap _outAccessors;
     std::vector<value::SlotAccessor*> _inKeyAccessors;
@@ -76,13 +122,34 @@ private:
     std::vector<std::unique_ptr<HashAggAccessor>> _outAggAccessors;
     std::vector<std::unique_ptr<vm::CodeFragment>> _aggCodes;
 
+    // When spilling is allowed, the aggregate expressions don't read the child's slots directly
+    // but through these accessors, so that they can be pointed either at the current input row or
+    // at a row read back from the spill sorter.
+    std::vector<value::SlotAccessor*> _inAggAccessors;
+    std::vector<std::unique_ptr<value::ViewOfValueAccessor>> _aggInputAccessors;
+    std::vector<std::unique_ptr<SpillAccessor>> _spilledInputAccessors;
+    value::SlotMap<size_t> _aggInputSlots;
+
     // TODO SERVER-54025: Update HashAggStage so that group-bys are collation-aware.
     TableType _ht;
     TableType::iterator _htIt;
 
     vm::ByteCode _bytecode;
 
+    // The approximate amount of memory used by the keys and accumulators in '_ht'.
+    size_t _memoryUsage{0};
+
+    std::unique_ptr<Sorter<value::MaterializedRow, value::MaterializedRow>> _sorter;
+    std::unique_ptr<SpillIterator> _spillIt;
+    SpillData _spillData;
+    SpillData* _spillDataIt{&_spillData};
+    // Set when '_spillData' holds a row that was read from the sorter but not yet aggregated.
+    bool _hasPendingSpilledRow{false};
+    int64_t _spillSeq{0};
+
     bool _compiled{false};
+
+    HashAggStats _specificStats;
 };
 }  // namespace sbe
 }  // namespace mongo
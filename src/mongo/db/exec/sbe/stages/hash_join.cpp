@@ -32,8 +32,18 @@
 #include "mongo/db/exec/sbe/stages/hash_join.h"
 
 #include "mongo/db/exec/sbe/expressions/expression.h"
+#include "mongo/db/storage/storage_options.h"
 #include "mongo/util/str.h"
 
+namespace {
+std::string nextFileName() {
+    static mongo::AtomicWord<unsigned> hashJoinFileCounter;
+    return "extsort-hash-join-sbe." + std::to_string(hashJoinFileCounter.fetchAndAdd(1));
+}
+}  // namespace
+
+#include "mongo/db/sorter/sorter.cpp"
+
 namespace mongo {
 namespace sbe {
 HashJoinStage::HashJoinStage(std::unique_ptr<PlanStage> outer,
@@ -42,13 +52,19 @@ HashJoinStage::HashJoinStage(std::unique_ptr<PlanStage> outer,
                              value::SlotVector outerProjects,
                              value::SlotVector innerCond,
                              value::SlotVector innerProjects,
-                             PlanNodeId planNodeId)
+                             PlanNodeId planNodeId,
+                             bool allowDiskUse,
+                             size_t memoryLimit)
     : PlanStage("hj"_sd, planNodeId),
       _outerCond(std::move(outerCond)),
       _outerProjects(std::move(outerProjects)),
       _innerCond(std::move(innerCond)),
       _innerProjects(std::move(innerProjects)),
-      _probeKey(0) {
+      _allowDiskUse(allowDiskUse),
+      _memoryLimit(memoryLimit),
+      _probeKey(0),
+      _buildRow({0, 0}),
+      _probeRow({0, 0}) {
     if (_outerCond.size() != _innerCond.size()) {
         uasserted(4822823, "left and right size do not match");
     }
@@ -57,6 +73,8 @@ HashJoinStage::HashJoinStage(std::unique_ptr<PlanStage> outer,
     _children.emplace_back(std::move(inner));
 }
 
+HashJoinStage::~HashJoinStage() {}
+
 std::unique_ptr<PlanStage> HashJoinStage::clone() const {
     return std::make_unique<HashJoinStage>(_children[0]->clone(),
                                            _children[1]->clone(),
@@ -64,7 +82,9 @@ std::unique_ptr<PlanStage> HashJoinStage::clone() const {
                                            _outerProjects,
                                            _innerCond,
                                            _innerProjects,
-                                           _commonStats.nodeId);
+                                           _commonStats.nodeId,
+                                           _allowDiskUse,
+                                           _memoryLimit);
 }
 
 void HashJoinStage::prepare(CompileCtx& ctx) {
@@ -101,6 +121,18 @@ void HashJoinStage::prepare(CompileCtx& ctx) {
         _outOuterAccessors[slot] = _outOuterProjectAccessors.back().get();
     }
 
+    if (_allowDiskUse) {
+        // Once the join is partitioned, the inner rows are read back from the probe side sorter,
+        // so the parent stage is given accessors that can be pointed at either kind of row.
+        for (auto& slots : {&_innerCond, &_innerProjects}) {
+            for (auto& slot : *slots) {
+                _inInnerAccessors.emplace_back(_children[1]->getAccessor(ctx, slot));
+                _outInnerAccessors.emplace_back(std::make_unique<value::ViewOfValueAccessor>());
+                _outInnerAccessorMap[slot] = _outInnerAccessors.back().get();
+            }
+        }
+    }
+
     _probeKey.resize(_inInnerKeyAccessors.size());
 
     _compiled = true;
@@ -112,6 +144,10 @@ value::SlotAccessor* HashJoinStage::getAccessor(CompileCtx& ctx, value::SlotId s
             return it->second;
         }
 
+        if (auto it = _outInnerAccessorMap.find(slot); it != _outInnerAccessorMap.end()) {
+            return it->second;
+        }
+
         return _children[1]->getAccessor(ctx, slot);
     }
 
@@ -122,6 +158,17 @@ void HashJoinStage::open(bool reOpen) {
     auto optTimer(getOptTimer(_opCtx));
 
     _commonStats.opens++;
+    _ht.clear();
+    _memoryUsage = 0;
+    _partitioned = false;
+    _buildIt.reset();
+    _probeIt.reset();
+    _buildSorter.reset();
+    _probeSorter.reset();
+    _hasPendingBuildRow = false;
+    _currentPartition = -1;
+    _buildKeyHashes.clear();
+
     _children[0]->open(reOpen);
     // Insert the outer side into the hash table.
     while (_children[0]->getNext() == PlanState::ADVANCED) {
@@ -134,6 +181,7 @@ void HashJoinStage::open(bool reOpen) {
             auto [tag, val] = p->copyOrMoveValue();
             key.reset(idx++, true, tag, val);
         }
+        _buildKeyHashes.push_back(value::MaterializedRowHasher()(key));
 
         idx = 0;
         // Copy projects.
@@ -142,13 +190,33 @@ void HashJoinStage::open(bool reOpen) {
             project.reset(idx++, true, tag, val);
         }
 
+        if (_partitioned) {
+            spillRow(_buildSorter.get(), std::move(key), std::move(project));
+            ++_specificStats.spilledBuildRecords;
+            continue;
+        }
+
+        _memoryUsage += key.memUsageForSorter() + project.memUsageForSorter();
         _ht.emplace(std::move(key), std::move(project));
+
+        if (_memoryUsage > _memoryLimit) {
+            uassert(ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed,
+                    "Exceeded memory limit for a hash join, but didn't allow external sort."
+                    " Pass allowDiskUse:true to opt in.",
+                    _allowDiskUse);
+            spillHashTable();
+        }
     }
 
     _children[0]->close();
+    buildBloomFilter();
 
     _children[1]->open(reOpen);
 
+    if (_partitioned) {
+        spillProbeSide();
+    }
+
     _htIt = _ht.end();
     _htItEnd = _ht.end();
 }
@@ -162,17 +230,43 @@ PlanState HashJoinStage::getNext() {
 
     if (_htIt == _htItEnd) {
         while (_htIt == _htItEnd) {
-            auto state = _children[1]->getNext();
-            if (state == PlanState::IS_EOF) {
-                // LEFT and OUTER joins should enumerate "non-returned" rows here.
-                return trackPlanState(state);
-            }
-
-            // Copy keys in order to do the lookup.
-            size_t idx = 0;
-            for (auto& p : _inInnerKeyAccessors) {
-                auto [tag, val] = p->getViewOfValue();
-                _probeKey.reset(idx++, false, tag, val);
+            if (_partitioned) {
+                if (!nextSpilledProbeRow()) {
+                    return trackPlanState(PlanState::IS_EOF);
+                }
+
+                // The spilled row holds the inner keys followed by the inner projections.
+                for (size_t idx = 0; idx < _outInnerAccessors.size(); ++idx) {
+                    auto [tag, val] = _probeRow.second.getViewOfValue(idx);
+                    _outInnerAccessors[idx]->reset(tag, val);
+                }
+                for (size_t idx = 0; idx < _probeKey.size(); ++idx) {
+                    auto [tag, val] = _probeRow.second.getViewOfValue(idx);
+                    _probeKey.reset(idx, false, tag, val);
+                }
+            } else {
+                auto state = _children[1]->getNext();
+                if (state == PlanState::IS_EOF) {
+                    // LEFT and OUTER joins should enumerate "non-returned" rows here.
+                    return trackPlanState(state);
+                }
+
+                // Copy keys in order to do the lookup.
+                size_t idx = 0;
+                for (auto& p : _inInnerKeyAccessors) {
+                    auto [tag, val] = p->getViewOfValue();
+                    _probeKey.reset(idx++, false, tag, val);
+                }
+
+                if (!bloomFilterMayContain(value::MaterializedRowHasher()(_probeKey))) {
+                    ++_specificStats.bloomFilterRejectedRecords;
+                    continue;
+                }
+
+                for (idx = 0; idx < _inInnerAccessors.size(); ++idx) {
+                    auto [tag, val] = _inInnerAccessors[idx]->getViewOfValue();
+                    _outInnerAccessors[idx]->reset(tag, val);
+                }
             }
 
             auto [low, hi] = _ht.equal_range(_probeKey);
@@ -191,17 +285,216 @@ void HashJoinStage::close() {
 
     _commonStats.closes++;
     _children[1]->close();
+    _ht.clear();
+    _buildIt.reset();
+    _probeIt.reset();
+    _buildSorter.reset();
+    _probeSorter.reset();
+    _hasPendingBuildRow = false;
+    _bloomFilter.clear();
+}
+
+std::unique_ptr<Sorter<value::MaterializedRow, value::MaterializedRow>>
+HashJoinStage::makeSorter() {
+    SortOptions opts;
+    opts.tempDir = storageGlobalParams.dbpath + "/_tmp";
+    opts.maxMemoryUsageBytes = _memoryLimit;
+    opts.extSortAllowed = true;
+
+    // Spilled rows are only ordered by their partition.
+    auto comp = [](const SpillData& lhs, const SpillData& rhs) {
+        auto lhsPartition = value::bitcastTo<int64_t>(lhs.first.getViewOfValue(0).second);
+        auto rhsPartition = value::bitcastTo<int64_t>(rhs.first.getViewOfValue(0).second);
+        return lhsPartition < rhsPartition ? -1 : (lhsPartition > rhsPartition ? 1 : 0);
+    };
+
+    return std::unique_ptr<Sorter<value::MaterializedRow, value::MaterializedRow>>(
+        Sorter<value::MaterializedRow, value::MaterializedRow>::make(opts, comp, {}));
+}
+
+void HashJoinStage::spillHashTable() {
+    _partitioned = true;
+    _buildSorter = makeSorter();
+
+    while (!_ht.empty()) {
+        auto node = _ht.extract(_ht.begin());
+        spillRow(_buildSorter.get(), std::move(node.key()), std::move(node.mapped()));
+        ++_specificStats.spilledBuildRecords;
+    }
+    _memoryUsage = 0;
+}
+
+void HashJoinStage::spillRow(Sorter<value::MaterializedRow, value::MaterializedRow>* sorter,
+                             value::MaterializedRow key,
+                             value::MaterializedRow project) {
+    auto partition = value::MaterializedRowHasher()(key) % kNumPartitions;
+
+    value::MaterializedRow spillKey{1};
+    spillKey.reset(
+        0, false, value::TypeTags::NumberInt64, value::bitcastFrom<int64_t>(partition));
+
+    value::MaterializedRow spillValue{key.size() + project.size()};
+    for (size_t idx = 0; idx < key.size(); ++idx) {
+        auto [tag, val] = key.copyOrMoveValue(idx);
+        spillValue.reset(idx, true, tag, val);
+    }
+    for (size_t idx = 0; idx < project.size(); ++idx) {
+        auto [tag, val] = project.copyOrMoveValue(idx);
+        spillValue.reset(key.size() + idx, true, tag, val);
+    }
+
+    sorter->emplace(std::move(spillKey), std::move(spillValue));
+}
+
+void HashJoinStage::spillProbeSide() {
+    _probeSorter = makeSorter();
+
+    while (_children[1]->getNext() == PlanState::ADVANCED) {
+        size_t idx = 0;
+        for (auto& p : _inInnerKeyAccessors) {
+            auto [tag, val] = p->getViewOfValue();
+            _probeKey.reset(idx++, false, tag, val);
+        }
+
+        // Rows which cannot match are never written out.
+        if (!bloomFilterMayContain(value::MaterializedRowHasher()(_probeKey))) {
+            ++_specificStats.bloomFilterRejectedRecords;
+            continue;
+        }
+
+        value::MaterializedRow key{_inInnerKeyAccessors.size()};
+        value::MaterializedRow project{_innerProjects.size()};
+
+        idx = 0;
+        for (auto& p : _inInnerKeyAccessors) {
+            auto [tag, val] = p->getViewOfValue();
+            auto [copyTag, copyVal] = value::copyValue(tag, val);
+            key.reset(idx++, true, copyTag, copyVal);
+        }
+
+        for (idx = 0; idx < _innerProjects.size(); ++idx) {
+            auto [tag, val] = _inInnerAccessors[_innerCond.size() + idx]->getViewOfValue();
+            auto [copyTag, copyVal] = value::copyValue(tag, val);
+            project.reset(idx, true, copyTag, copyVal);
+        }
+
+        spillRow(_probeSorter.get(), std::move(key), std::move(project));
+        ++_specificStats.spilledProbeRecords;
+    }
+
+    _specificStats.usedDisk = _specificStats.usedDisk || _buildSorter->numSpills() > 0 ||
+        _probeSorter->numSpills() > 0;
+    _buildIt.reset(_buildSorter->done());
+    _probeIt.reset(_probeSorter->done());
+}
+
+void HashJoinStage::loadPartition(int64_t partition) {
+    _ht.clear();
+    _currentPartition = partition;
+
+    for (;;) {
+        if (!_hasPendingBuildRow) {
+            if (!_buildIt->more()) {
+                return;
+            }
+            _buildRow = _buildIt->next();
+        }
+        _hasPendingBuildRow = false;
+
+        auto rowPartition = value::bitcastTo<int64_t>(_buildRow.first.getViewOfValue(0).second);
+        if (rowPartition < partition) {
+            // There are no inner rows in this partition.
+            continue;
+        }
+        if (rowPartition > partition) {
+            _hasPendingBuildRow = true;
+            return;
+        }
+
+        value::MaterializedRow key{_outerCond.size()};
+        value::MaterializedRow project{_outerProjects.size()};
+        for (size_t idx = 0; idx < key.size(); ++idx) {
+            auto [tag, val] = _buildRow.second.copyOrMoveValue(idx);
+            key.reset(idx, true, tag, val);
+        }
+        for (size_t idx = 0; idx < project.size(); ++idx) {
+            auto [tag, val] = _buildRow.second.copyOrMoveValue(key.size() + idx);
+            project.reset(idx, true, tag, val);
+        }
+
+        _ht.emplace(std::move(key), std::move(project));
+    }
+}
+
+bool HashJoinStage::nextSpilledProbeRow() {
+    if (!_probeIt->more()) {
+        return false;
+    }
+    _probeRow = _probeIt->next();
+
+    // The probe side rows come out of the sorter ordered by partition, so the build side of a
+    // partition only needs to be loaded once.
+    auto partition = value::bitcastTo<int64_t>(_probeRow.first.getViewOfValue(0).second);
+    if (partition != _currentPartition) {
+        loadPartition(partition);
+    }
+    return true;
+}
+
+void HashJoinStage::buildBloomFilter() {
+    size_t numBits = 64;
+    while (numBits < _buildKeyHashes.size() * kBloomFilterBitsPerKey) {
+        numBits *= 2;
+    }
+
+    _bloomFilter.assign(numBits / 64, 0);
+    _bloomFilterMask = numBits - 1;
+    for (auto hash : _buildKeyHashes) {
+        // Derive the probe positions from the two halves of the hash (double hashing).
+        const size_t step = (hash >> 32) | 1;
+        for (size_t probe = 0; probe < kBloomFilterNumProbes; ++probe) {
+            const size_t bit = (hash + probe * step) & _bloomFilterMask;
+            _bloomFilter[bit / 64] |= uint64_t{1} << (bit % 64);
+        }
+    }
+
+    _buildKeyHashes.clear();
+    _buildKeyHashes.shrink_to_fit();
+}
+
+bool HashJoinStage::bloomFilterMayContain(size_t hash) const {
+    const size_t step = (hash >> 32) | 1;
+    for (size_t probe = 0; probe < kBloomFilterNumProbes; ++probe) {
+        const size_t bit = (hash + probe * step) & _bloomFilterMask;
+        if (!(_bloomFilter[bit / 64] & (uint64_t{1} << (bit % 64)))) {
+            return false;
+        }
+    }
+    return true;
 }
 
 std::unique_ptr<PlanStageStats> HashJoinStage::getStats(bool includeDebugInfo) const {
     auto ret = std::make_unique<PlanStageStats>(_commonStats);
+    ret->specific = std::make_unique<HashJoinStats>(_specificStats);
+
+    if (includeDebugInfo) {
+        BSONObjBuilder bob;
+        bob.appendNumber("bloomFilterRejectedRecords", _specificStats.bloomFilterRejectedRecords);
+        if (_allowDiskUse) {
+            bob.appendBool("usedDisk", _specificStats.usedDisk);
+            bob.appendNumber("spilledBuildRecords", _specificStats.spilledBuildRecords);
+            bob.appendNumber("spilledProbeRecords", _specificStats.spilledProbeRecords);
+        }
+        ret->debugInfo = bob.obj();
+    }
+
     ret->children.emplace_back(_children[0]->getStats(includeDebugInfo));
     ret->children.emplace_back(_children[1]->getStats(includeDebugInfo));
     return ret;
 }
 
 const SpecificStats* HashJoinStage::getSpecificStats() const {
-    return nullptr;
+    return &_specificStats;
 }
 
 std::vector<DebugPrinter::Block> HashJoinStage::debugPrint() const {
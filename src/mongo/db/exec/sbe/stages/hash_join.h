@@ -34,7 +34,30 @@
 #include "mongo/db/exec/sbe/stages/stages.h"
 #include "mongo/db/exec/sbe/vm/vm.h"
 
+namespace mongo {
+template <typename Key, typename Value>
+class SortIteratorInterface;
+template <typename Key, typename Value>
+class Sorter;
+}  // namespace mongo
+
 namespace mongo::sbe {
+/**
+ * Joins the rows of the 'outer' (build) side and the 'inner' (probe) side whose 'outerCond' and
+ * 'innerCond' slots are equal. The outer side is loaded into a hash table which is then probed
+ * with every row of the inner side.
+ *
+ * If 'allowDiskUse' is true and the estimated size of the hash table exceeds 'memoryLimit', the
+ * join falls back to a grace hash join: the rows of both sides are hashed into a fixed number of
+ * partitions and handed to Sorters, which spill them to disk as needed. The partitions are then
+ * joined one at a time, so that only one build partition is held in memory. In this mode only the
+ * 'innerCond' and 'innerProjects' slots of the inner side are available to the parent stage.
+ * Exceeding the limit without 'allowDiskUse' is an error.
+ *
+ * Once the outer side is loaded, a Bloom filter is built over the hashes of its keys. Inner rows
+ * whose keys are rejected by the filter cannot match, so they are skipped without probing the hash
+ * table or being handed to the probe side sorter.
+ */
 class HashJoinStage final : public PlanStage {
 public:
     HashJoinStage(std::unique_ptr<PlanStage> outer,
@@ -43,7 +66,11 @@ public:
                   value::SlotVector outerProjects,
                   value::SlotVector innerCond,
                   value::SlotVector innerProjects,
-                  PlanNodeId planNodeId);
+                  PlanNodeId planNodeId,
+                  bool allowDiskUse = false,
+                  size_t memoryLimit = std::numeric_limits<size_t>::max());
+
+    ~HashJoinStage();
 
     std::unique_ptr<PlanStage> clone() const final;
 
@@ -66,10 +93,65 @@ private:
     using HashKeyAccessor = value::MaterializedRowKeyAccessor<TableType::iterator>;
     using HashProjectAccessor = value::MaterializedRowValueAccessor<TableType::iterator>;
 
+    using SpillIterator = SortIteratorInterface<value::MaterializedRow, value::MaterializedRow>;
+    using SpillData = std::pair<value::MaterializedRow, value::MaterializedRow>;
+
+    // The number of partitions the rows of both sides are hashed into once the join spills.
+    static constexpr size_t kNumPartitions = 16;
+
+    // The number of Bloom filter bits per build side key, and the number of bits set for each key.
+    // This gives a false positive rate of about 2%.
+    static constexpr size_t kBloomFilterBitsPerKey = 10;
+    static constexpr size_t kBloomFilterNumProbes = 3;
+
+    /**
+     * Builds '_bloomFilter' from '_buildKeyHashes', which is then released.
+     */
+    void buildBloomFilter();
+
+    /**
+     * Returns false if no build side key can have the given hash.
+     */
+    bool bloomFilterMayContain(size_t hash) const;
+
+    std::unique_ptr<Sorter<value::MaterializedRow, value::MaterializedRow>> makeSorter();
+
+    /**
+     * Moves the contents of the hash table into the build side sorter and switches the join into
+     * the partitioned mode.
+     */
+    void spillHashTable();
+
+    /**
+     * Hands a row over to the given sorter. The sort key is the partition of 'key', and the value
+     * holds 'key' followed by 'project'.
+     */
+    void spillRow(Sorter<value::MaterializedRow, value::MaterializedRow>* sorter,
+                  value::MaterializedRow key,
+                  value::MaterializedRow project);
+
+    /**
+     * Drains the inner side into the probe side sorter, and opens iterators over both sorters.
+     */
+    void spillProbeSide();
+
+    /**
+     * Replaces the contents of the hash table with the build side rows of the given partition.
+     */
+    void loadPartition(int64_t partition);
+
+    /**
+     * Reads the next probe side row from the spilled partitions into '_probeRow', loading the build
+     * side of its partition if needed. Returns false once all partitions have been processed.
+     */
+    bool nextSpilledProbeRow();
+
     const value::SlotVector _outerCond;
     const value::SlotVector _outerProjects;
     const value::SlotVector _innerCond;
     const value::SlotVector _innerProjects;
+    const bool _allowDiskUse;
+    const size_t _memoryLimit;
 
     // All defined values from the outer side (i.e. they come from the hash table).
     value::SlotAccessorMap _outOuterAccessors;
@@ -89,9 +171,23 @@ private:
     // Accessors of input codition values (keys) that are being inserted into the hash table.
     std::vector<value::SlotAccessor*> _inInnerKeyAccessors;
 
+    // When spilling is allowed, the inner key and projection slots are exposed through these
+    // accessors instead of the inner child's ones, so that they can be pointed either at the current
+    // inner row or at a row read back from the probe side sorter.
+    std::vector<value::SlotAccessor*> _inInnerAccessors;
+    std::vector<std::unique_ptr<value::ViewOfValueAccessor>> _outInnerAccessors;
+    value::SlotAccessorMap _outInnerAccessorMap;
+
     // Key used to probe inside the hash table.
     value::MaterializedRow _probeKey;
 
+    // The hashes of the build side keys, collected while the outer side is loaded.
+    std::vector<size_t> _buildKeyHashes;
+
+    // The bits of the Bloom filter over the build side keys. The number of bits is a power of two.
+    std::vector<uint64_t> _bloomFilter;
+    size_t _bloomFilterMask{0};
+
     // TODO SERVER-54025: Update HashJoinStage so that it's mechanism for matching outer keys and
     // inner keys is collation-aware.
     TableType _ht;
@@ -100,6 +196,23 @@ private:
 
     vm::ByteCode _bytecode;
 
+    // The approximate amount of memory used by the rows in '_ht'.
+    size_t _memoryUsage{0};
+
+    // Set once the build side has exceeded the memory limit and both sides are partitioned.
+    bool _partitioned{false};
+    std::unique_ptr<Sorter<value::MaterializedRow, value::MaterializedRow>> _buildSorter;
+    std::unique_ptr<Sorter<value::MaterializedRow, value::MaterializedRow>> _probeSorter;
+    std::unique_ptr<SpillIterator> _buildIt;
+    std::unique_ptr<SpillIterator> _probeIt;
+    SpillData _buildRow;
+    SpillData _probeRow;
+    // Set when '_buildRow' holds a row of a partition which has not been loaded yet.
+    bool _hasPendingBuildRow{false};
+    int64_t _currentPartition{-1};
+
     bool _compiled{false};
+
+    HashJoinStats _specificStats;
 };
 }  // namespace mongo::sbe
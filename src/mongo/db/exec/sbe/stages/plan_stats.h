@@ -84,6 +84,47 @@ struct ScanStats final : public SpecificStats {
     }
 
     size_t numReads{0};
+    // The number of times a scan running in block mode refilled its buffer from the cursor.
+    size_t numBlocks{0};
+};
+
+struct HashAggStats final : public SpecificStats {
+    std::unique_ptr<SpecificStats> clone() const final {
+        return std::make_unique<HashAggStats>(*this);
+    }
+
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this);
+    }
+
+    void accumulate(PlanSummaryStats& stats) const final {
+        stats.usedDisk |= usedDisk;
+    }
+
+    bool usedDisk{false};
+    // The number of input rows that were handed to the spill sorter.
+    long long spilledRecords{0};
+};
+
+struct HashJoinStats final : public SpecificStats {
+    std::unique_ptr<SpecificStats> clone() const final {
+        return std::make_unique<HashJoinStats>(*this);
+    }
+
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this);
+    }
+
+    void accumulate(PlanSummaryStats& stats) const final {
+        stats.usedDisk |= usedDisk;
+    }
+
+    bool usedDisk{false};
+    // The number of outer and inner rows that were handed to the partition sorters.
+    long long spilledBuildRecords{0};
+    long long spilledProbeRecords{0};
+    // The number of inner rows skipped because the Bloom filter over the outer keys rejected them.
+    long long bloomFilterRejectedRecords{0};
 };
 
 struct IndexScanStats final : public SpecificStats {
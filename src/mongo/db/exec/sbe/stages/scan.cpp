@@ -47,7 +47,8 @@ ScanStage::ScanStage(const NamespaceStringOrUUID& name,
                      PlanYieldPolicy* yieldPolicy,
                      PlanNodeId nodeId,
                      LockAcquisitionCallback lockAcquisitionCallback,
-                     ScanOpenCallback openCallback)
+                     ScanOpenCallback openCallback,
+                     size_t blockSize)
     : PlanStage(seekKeySlot ? "seek"_sd : "scan"_sd, yieldPolicy, nodeId),
       _name(name),
       _recordSlot(recordSlot),
@@ -56,10 +57,13 @@ ScanStage::ScanStage(const NamespaceStringOrUUID& name,
       _vars(std::move(vars)),
       _seekKeySlot(seekKeySlot),
       _forward(forward),
+      _blockSize(blockSize),
       _lockAcquisitionCallback(std::move(lockAcquisitionCallback)),
       _openCallback(openCallback) {
     invariant(_fields.size() == _vars.size());
     invariant(!_seekKeySlot || _forward);
+    invariant(_blockSize >= 1);
+    invariant(_blockSize == 1 || (!_seekKeySlot && !_openCallback));
 }
 
 std::unique_ptr<PlanStage> ScanStage::clone() const {
@@ -73,7 +77,8 @@ std::unique_ptr<PlanStage> ScanStage::clone() const {
                                        _yieldPolicy,
                                        _commonStats.nodeId,
                                        _lockAcquisitionCallback,
-                                       _openCallback);
+                                       _openCallback,
+                                       _blockSize);
 }
 
 void ScanStage::prepare(CompileCtx& ctx) {
@@ -206,10 +211,38 @@ void ScanStage::open(bool reOpen) {
         _cursor.reset();
     }
 
+    _block.clear();
+    _blockPos = 0;
     _open = true;
     _firstGetNext = true;
 }
 
+const Record* ScanStage::nextFromBlock() {
+    if (_blockPos == _block.size()) {
+        _block.clear();
+        _blockPos = 0;
+
+        while (_block.size() < _blockSize) {
+            auto record = _cursor->next();
+            if (!record) {
+                break;
+            }
+
+            // The cursor is free to reuse the memory backing a record on the next call, so we
+            // have to make a copy of each record we buffer.
+            record->data.makeOwned();
+            _block.push_back(std::move(*record));
+        }
+
+        if (_block.empty()) {
+            return nullptr;
+        }
+        ++_specificStats.numBlocks;
+    }
+
+    return &_block[_blockPos++];
+}
+
 PlanState ScanStage::getNext() {
     auto optTimer(getOptTimer(_opCtx));
 
@@ -219,8 +252,15 @@ PlanState ScanStage::getNext() {
 
     checkForInterrupt(_opCtx);
 
-    auto nextRecord =
-        (_firstGetNext && _seekKeyAccessor) ? _cursor->seekExact(_key) : _cursor->next();
+    boost::optional<Record> cursorRecord;
+    const Record* nextRecord = nullptr;
+    if (_blockSize > 1) {
+        nextRecord = nextFromBlock();
+    } else {
+        cursorRecord =
+            (_firstGetNext && _seekKeyAccessor) ? _cursor->seekExact(_key) : _cursor->next();
+        nextRecord = cursorRecord.get_ptr();
+    }
     _firstGetNext = false;
 
     if (!nextRecord) {
@@ -280,6 +320,8 @@ void ScanStage::close() {
     _commonStats.closes++;
     _cursor.reset();
     _coll.reset();
+    _block.clear();
+    _blockPos = 0;
     _open = false;
 }
 
@@ -290,6 +332,10 @@ std::unique_ptr<PlanStageStats> ScanStage::getStats(bool includeDebugInfo) const
     if (includeDebugInfo) {
         BSONObjBuilder bob;
         bob.appendNumber("numReads", _specificStats.numReads);
+        if (_blockSize > 1) {
+            bob.appendNumber("blockSize", static_cast<long long>(_blockSize));
+            bob.appendNumber("numBlocks", static_cast<long long>(_specificStats.numBlocks));
+        }
         if (_recordSlot) {
             bob.appendIntOrLL("recordSlot", *_recordSlot);
         }
@@ -38,6 +38,13 @@ namespace mongo {
 namespace sbe {
 using ScanOpenCallback = std::function<void(OperationContext*, const CollectionPtr&, bool)>;
 
+/**
+ * Scans a collection in record id order. If 'blockSize' is greater than one the stage runs in block
+ * mode: it pulls up to 'blockSize' records from the storage cursor at a time into an owned buffer
+ * and then serves subsequent getNext() calls from that buffer. Block mode is not supported for
+ * seeks or when an open callback is provided, as both rely on observing the cursor one record at
+ * a time.
+ */
 class ScanStage final : public PlanStage {
 public:
     ScanStage(const NamespaceStringOrUUID& name,
@@ -50,7 +57,8 @@ public:
               PlanYieldPolicy* yieldPolicy,
               PlanNodeId nodeId,
               LockAcquisitionCallback lockAcquisitionCallback,
-              ScanOpenCallback openCallback = {});
+              ScanOpenCallback openCallback = {},
+              size_t blockSize = 1);
 
     std::unique_ptr<PlanStage> clone() const final;
 
@@ -73,6 +81,12 @@ protected:
     void doAttachToTrialRunTracker(TrialRunTracker* tracker) override;
 
 private:
+    /**
+     * Returns the next record to produce in block mode, refilling the block from the cursor once
+     * all of its records have been consumed. Returns nullptr when the cursor is exhausted.
+     */
+    const Record* nextFromBlock();
+
     const NamespaceStringOrUUID _name;
     const boost::optional<value::SlotId> _recordSlot;
     const boost::optional<value::SlotId> _recordIdSlot;
@@ -80,6 +94,7 @@ private:
     const value::SlotVector _vars;
     const boost::optional<value::SlotId> _seekKeySlot;
     const bool _forward;
+    const size_t _blockSize;
 
     // If provided, used during a trial run to accumulate certain execution stats. Once the trial
     // run is complete, this pointer is reset to nullptr.
@@ -102,6 +117,11 @@ private:
     RecordId _key;
     bool _firstGetNext{false};
 
+    // Owned copies of the records read ahead from '_cursor' in block mode, and the position of the
+    // next record to produce.
+    std::vector<Record> _block;
+    size_t _blockPos{0};
+
     ScanStats _specificStats;
 };
 
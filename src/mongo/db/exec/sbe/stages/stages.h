@@ -305,7 +305,7 @@ public:
     }
 
 protected:
-    PlanYieldPolicy* const _yieldPolicy{nullptr};
+    PlanYieldPolicy* _yieldPolicy{nullptr};
 
 private:
     static const int kInterruptCheckPeriod = 128;
@@ -367,6 +367,21 @@ public:
      */
     virtual void close() = 0;
 
+    /**
+     * Replaces the yield policy of every stage in this tree which was constructed with one. This is
+     * needed when a tree cloned from the plan of another query is executed under a new yield
+     * policy.
+     */
+    void attachNewYieldPolicy(PlanYieldPolicy* yieldPolicy) {
+        for (auto&& child : _children) {
+            child->attachNewYieldPolicy(yieldPolicy);
+        }
+
+        if (_yieldPolicy) {
+            _yieldPolicy = yieldPolicy;
+        }
+    }
+
     virtual std::vector<DebugPrinter::Block> debugPrint() const {
         auto stats = getCommonStats();
         std::string str = str::stream() << '[' << stats->nodeId << "] " << stats->stageType;
@@ -72,26 +72,19 @@ std::pair<TypeTags, Value> makeCopyPcreRegex(const PcreRegex& regex) {
 
 void PcreRegex::_compile() {
     const auto pcreOptions = regex_util::flagsToPcreOptions(_options.c_str(), false).all_options();
-    const char* compile_error;
-    int eoffset;
-    _pcrePtr = pcre_compile(_pattern.c_str(), pcreOptions, &compile_error, &eoffset, nullptr);
-    uassert(5073402, str::stream() << "Invalid Regex: " << compile_error, _pcrePtr != nullptr);
+    _regex = regex_util::getCompiledRegex(_pattern, pcreOptions);
+    uassert(5073402, str::stream() << "Invalid Regex: " << _regex->error(), _regex->error().empty());
 }
 
 int PcreRegex::execute(std::string_view stringView, int startPos, std::vector<int>& buf) {
-    return pcre_exec(_pcrePtr,
-                     nullptr,
-                     stringView.data(),
-                     stringView.length(),
-                     startPos,
-                     0,
-                     &(buf.front()),
-                     buf.size());
+    return _regex->exec(StringData(stringView.data(), stringView.length()),
+                        startPos,
+                        &(buf.front()),
+                        buf.size());
 }
 
 size_t PcreRegex::getNumberCaptures() const {
-    int numCaptures;
-    pcre_fullinfo(_pcrePtr, nullptr, PCRE_INFO_CAPTURECOUNT, &numCaptures);
+    int numCaptures = _regex->numCaptures();
     invariant(numCaptures >= 0);
     return static_cast<size_t>(numCaptures);
 }
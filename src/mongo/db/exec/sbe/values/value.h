@@ -34,6 +34,7 @@
 #include <array>
 #include <bitset>
 #include <cstdint>
+#include <memory>
 #include <ostream>
 #include <pcre.h>
 #include <string>
@@ -48,6 +49,7 @@
 #include "mongo/db/query/collation/collator_interface.h"
 #include "mongo/platform/decimal128.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/regex_util.h"
 #include "mongo/util/represent_as.h"
 
 namespace mongo {
@@ -587,9 +589,9 @@ private:
 
 /**
  * Implements a wrapper of PCRE regular expression.
- * Storing the pattern and the options allows for copying of the sbe::value::PcreRegex expression,
- * which includes recompilation.
- * The compiled expression pcre* allows for direct usage of the pcre C library functionality.
+ * Storing the pattern and the options allows for copying of the sbe::value::PcreRegex expression.
+ * The compiled expression comes from the process-wide cache of compiled regular expressions, and is
+ * shared between copies.
  */
 class PcreRegex {
 public:
@@ -600,21 +602,9 @@ public:
 
     PcreRegex(std::string_view pattern) : PcreRegex(pattern, "") {}
 
-    PcreRegex(const PcreRegex& other) : PcreRegex(other._pattern, other._options) {}
-
-    PcreRegex& operator=(const PcreRegex& other) {
-        if (this != &other) {
-            (*pcre_free)(_pcrePtr);
-            _pattern = other._pattern;
-            _options = other._options;
-            _compile();
-        }
-        return *this;
-    }
-
-    ~PcreRegex() {
-        (*pcre_free)(_pcrePtr);
-    }
+    // Copies share the compiled pattern, which is immutable.
+    PcreRegex(const PcreRegex& other) = default;
+    PcreRegex& operator=(const PcreRegex& other) = default;
 
     const std::string& pattern() const {
         return _pattern;
@@ -645,7 +635,7 @@ private:
     std::string _pattern;
     std::string _options;
 
-    pcre* _pcrePtr;
+    std::shared_ptr<const regex_util::CompiledRegex> _regex;
 };
 
 constexpr size_t kSmallStringMaxLength = 7;
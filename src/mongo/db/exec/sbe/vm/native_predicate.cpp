@@ -0,0 +1,217 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/sbe/vm/native_predicate.h"
+
+#include <functional>
+
+#include "mongo/db/commands/server_status_metric.h"
+
+namespace mongo {
+namespace sbe {
+namespace vm {
+
+Counter64 NativePredicateCounters::compiled;
+Counter64 NativePredicateCounters::interpreted;
+
+namespace {
+ServerStatusMetricField<Counter64> displayNativePredicatesCompiled(
+    "query.sbe.nativePredicates.compiled", &NativePredicateCounters::compiled);
+ServerStatusMetricField<Counter64> displayNativePredicatesInterpreted(
+    "query.sbe.nativePredicates.interpreted", &NativePredicateCounters::interpreted);
+
+/**
+ * A decoded VM instruction along with its immediate operands.
+ */
+struct DecodedInstruction {
+    Instruction::Tags tag;
+    value::SlotAccessor* accessor{nullptr};
+    value::TypeTags constTag{value::TypeTags::Nothing};
+    value::Value constVal{0};
+};
+
+/**
+ * Decodes the instructions in 'code'. Returns false if the fragment contains an instruction with
+ * operands that the native compiler does not know how to decode.
+ */
+bool decode(const CodeFragment* code, std::vector<DecodedInstruction>& out) {
+    auto pcPointer = code->instrs().data();
+    auto pcEnd = pcPointer + code->instrs().size();
+
+    while (pcPointer != pcEnd) {
+        Instruction i = value::readFromMemory<Instruction>(pcPointer);
+        pcPointer += sizeof(i);
+
+        DecodedInstruction decoded{static_cast<Instruction::Tags>(i.tag)};
+        switch (i.tag) {
+            case Instruction::pushConstVal:
+                decoded.constTag = value::readFromMemory<value::TypeTags>(pcPointer);
+                pcPointer += sizeof(decoded.constTag);
+                decoded.constVal = value::readFromMemory<value::Value>(pcPointer);
+                pcPointer += sizeof(decoded.constVal);
+                break;
+            case Instruction::pushAccessVal:
+                decoded.accessor = value::readFromMemory<value::SlotAccessor*>(pcPointer);
+                pcPointer += sizeof(decoded.accessor);
+                break;
+            case Instruction::less:
+            case Instruction::lessEq:
+            case Instruction::greater:
+            case Instruction::greaterEq:
+            case Instruction::eq:
+            case Instruction::neq:
+            case Instruction::exists:
+            case Instruction::fillEmpty:
+                break;
+            default:
+                return false;
+        }
+        out.push_back(decoded);
+    }
+
+    return true;
+}
+
+bool isComparison(Instruction::Tags tag) {
+    switch (tag) {
+        case Instruction::less:
+        case Instruction::lessEq:
+        case Instruction::greater:
+        case Instruction::greaterEq:
+        case Instruction::eq:
+        case Instruction::neq:
+            return true;
+        default:
+            return false;
+    }
+}
+}  // namespace
+
+template <typename Op>
+bool NativePredicate::compareSlotToConstant(const NativePredicate& pred) {
+    auto [tag, val] = pred._accessor->getViewOfValue();
+    auto [resultTag, resultVal] = genericCompare<Op>(tag, val, pred._constTag, pred._constVal);
+    return resultTag == value::TypeTags::Boolean && value::bitcastTo<bool>(resultVal);
+}
+
+template <typename Op>
+bool NativePredicate::compareConstantToSlot(const NativePredicate& pred) {
+    auto [tag, val] = pred._accessor->getViewOfValue();
+    auto [resultTag, resultVal] = genericCompare<Op>(pred._constTag, pred._constVal, tag, val);
+    return resultTag == value::TypeTags::Boolean && value::bitcastTo<bool>(resultVal);
+}
+
+bool NativePredicate::slotExists(const NativePredicate& pred) {
+    return pred._accessor->getViewOfValue().first != value::TypeTags::Nothing;
+}
+
+bool NativePredicate::slotIsTrue(const NativePredicate& pred) {
+    auto [tag, val] = pred._accessor->getViewOfValue();
+    return tag == value::TypeTags::Boolean && value::bitcastTo<bool>(val);
+}
+
+std::unique_ptr<NativePredicate> NativePredicate::compile(const CodeFragment* code) {
+    std::vector<DecodedInstruction> instrs;
+    if (!code || !decode(code, instrs)) {
+        return nullptr;
+    }
+
+    // A trailing 'fillEmpty' with a constant 'false' turns Nothing into false, but both of them
+    // fail a predicate, so it can be dropped.
+    if (instrs.size() >= 2 && instrs.back().tag == Instruction::fillEmpty) {
+        auto& fill = instrs[instrs.size() - 2];
+        if (fill.tag != Instruction::pushConstVal || fill.constTag != value::TypeTags::Boolean ||
+            value::bitcastTo<bool>(fill.constVal)) {
+            return nullptr;
+        }
+        instrs.resize(instrs.size() - 2);
+    }
+
+    auto comparisonFn = [](Instruction::Tags tag, bool slotOnLeft) -> Fn {
+        switch (tag) {
+            case Instruction::less:
+                return slotOnLeft ? &compareSlotToConstant<std::less<>>
+                                  : &compareConstantToSlot<std::less<>>;
+            case Instruction::lessEq:
+                return slotOnLeft ? &compareSlotToConstant<std::less_equal<>>
+                                  : &compareConstantToSlot<std::less_equal<>>;
+            case Instruction::greater:
+                return slotOnLeft ? &compareSlotToConstant<std::greater<>>
+                                  : &compareConstantToSlot<std::greater<>>;
+            case Instruction::greaterEq:
+                return slotOnLeft ? &compareSlotToConstant<std::greater_equal<>>
+                                  : &compareConstantToSlot<std::greater_equal<>>;
+            case Instruction::eq:
+                return slotOnLeft ? &compareSlotToConstant<std::equal_to<>>
+                                  : &compareConstantToSlot<std::equal_to<>>;
+            case Instruction::neq:
+                return slotOnLeft ? &compareSlotToConstant<std::not_equal_to<>>
+                                  : &compareConstantToSlot<std::not_equal_to<>>;
+            default:
+                MONGO_UNREACHABLE;
+        }
+    };
+
+    if (instrs.size() == 1 && instrs[0].tag == Instruction::pushAccessVal) {
+        return std::unique_ptr<NativePredicate>(new NativePredicate(&slotIsTrue, instrs[0].accessor));
+    }
+
+    if (instrs.size() == 2 && instrs[0].tag == Instruction::pushAccessVal &&
+        instrs[1].tag == Instruction::exists) {
+        return std::unique_ptr<NativePredicate>(new NativePredicate(&slotExists, instrs[0].accessor));
+    }
+
+    if (instrs.size() == 3 && isComparison(instrs[2].tag)) {
+        if (instrs[0].tag == Instruction::pushAccessVal &&
+            instrs[1].tag == Instruction::pushConstVal) {
+            return std::unique_ptr<NativePredicate>(
+                new NativePredicate(comparisonFn(instrs[2].tag, true),
+                                    instrs[0].accessor,
+                                    instrs[1].constTag,
+                                    instrs[1].constVal));
+        }
+        if (instrs[0].tag == Instruction::pushConstVal &&
+            instrs[1].tag == Instruction::pushAccessVal) {
+            return std::unique_ptr<NativePredicate>(
+                new NativePredicate(comparisonFn(instrs[2].tag, false),
+                                    instrs[1].accessor,
+                                    instrs[0].constTag,
+                                    instrs[0].constVal));
+        }
+    }
+
+    return nullptr;
+}
+
+}  // namespace vm
+}  // namespace sbe
+}  // namespace mongo
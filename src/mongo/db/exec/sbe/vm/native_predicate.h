@@ -0,0 +1,100 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "mongo/base/counter.h"
+#include "mongo/db/exec/sbe/values/slot.h"
+#include "mongo/db/exec/sbe/values/value.h"
+#include "mongo/db/exec/sbe/vm/vm.h"
+
+namespace mongo {
+namespace sbe {
+namespace vm {
+
+/**
+ * A predicate which has been translated from VM bytecode into a native C++ routine. Evaluating a
+ * native predicate yields exactly the same result as calling ByteCode::runPredicate() on the code
+ * fragment it was compiled from, but it bypasses the instruction dispatch loop entirely.
+ *
+ * Only a small number of hot predicate shapes can be compiled this way, namely a comparison of a
+ * slot against a constant, an existence check of a slot, and a boolean slot. The shapes may be
+ * wrapped in 'fillEmpty(<pred>, false)', which does not affect the outcome of a predicate.
+ *
+ * A native predicate refers to the slot accessors and constants of the code fragment it was
+ * compiled from, so it must not outlive that code fragment.
+ */
+class NativePredicate {
+public:
+    /**
+     * Attempts to compile 'code' into a native predicate. Returns nullptr if the code fragment does
+     * not match any of the supported shapes.
+     */
+    static std::unique_ptr<NativePredicate> compile(const CodeFragment* code);
+
+    bool run() const {
+        return _fn(*this);
+    }
+
+private:
+    using Fn = bool (*)(const NativePredicate&);
+
+    template <typename Op>
+    static bool compareSlotToConstant(const NativePredicate& pred);
+    template <typename Op>
+    static bool compareConstantToSlot(const NativePredicate& pred);
+    static bool slotExists(const NativePredicate& pred);
+    static bool slotIsTrue(const NativePredicate& pred);
+
+    NativePredicate(Fn fn,
+                    value::SlotAccessor* accessor,
+                    value::TypeTags constTag = value::TypeTags::Nothing,
+                    value::Value constVal = 0)
+        : _fn(fn), _accessor(accessor), _constTag(constTag), _constVal(constVal) {}
+
+    const Fn _fn;
+    value::SlotAccessor* const _accessor;
+    const value::TypeTags _constTag;
+    const value::Value _constVal;
+};
+
+/**
+ * Counters reported in serverStatus which track how many predicates were compiled to native code
+ * and how many had to fall back to the bytecode interpreter.
+ */
+struct NativePredicateCounters {
+    static Counter64 compiled;
+    static Counter64 interpreted;
+};
+
+}  // namespace vm
+}  // namespace sbe
+}  // namespace mongo
@@ -2792,6 +2792,140 @@ std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinIsArrayEmpty(Ar
     }
 }
 
+namespace {
+bool traverseCompareMatches(value::TypeTags tag,
+                            value::Value val,
+                            const StringData::ComparatorInterface* comparator,
+                            TraverseCompareOp op,
+                            value::TypeTags rhsTag,
+                            value::Value rhsVal) {
+    auto [resultTag, resultVal] = [&]() -> std::pair<value::TypeTags, value::Value> {
+        switch (op) {
+            case TraverseCompareOp::eq:
+                return genericCompare<std::equal_to<>>(tag, val, rhsTag, rhsVal, comparator);
+            case TraverseCompareOp::less:
+                return genericCompare<std::less<>>(tag, val, rhsTag, rhsVal, comparator);
+            case TraverseCompareOp::lessEq:
+                return genericCompare<std::less_equal<>>(tag, val, rhsTag, rhsVal, comparator);
+            case TraverseCompareOp::greater:
+                return genericCompare<std::greater<>>(tag, val, rhsTag, rhsVal, comparator);
+            case TraverseCompareOp::greaterEq:
+                return genericCompare<std::greater_equal<>>(tag, val, rhsTag, rhsVal, comparator);
+        }
+        MONGO_UNREACHABLE;
+    }();
+    return resultTag == value::TypeTags::Boolean && value::bitcastTo<bool>(resultVal);
+}
+}  // namespace
+
+/**
+ * traverseCompare(input, elementsOnly, collator, op1, rhs1, ..., opN, rhsN) tests whether a
+ * candidate which is not NaN compares true to all of the constants. The candidates are the elements
+ * of 'input' if it is an array, without descending into nested arrays, and 'input' itself unless
+ * 'elementsOnly' is set. When 'elementsOnly' is set and there is no candidate, the result is
+ * Nothing. This is what a TraverseStage over the path computes, in a single loop.
+ */
+std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinTraverseCompare(
+    ArityType arity) {
+    invariant(arity >= 5 && arity % 2 == 1);
+
+    auto [inputOwned, inputTag, inputVal] = getFromStack(0);
+    auto [elementsOnlyOwned, elementsOnlyTag, elementsOnlyVal] = getFromStack(1);
+    auto [collOwned, collTag, collVal] = getFromStack(2);
+    if (elementsOnlyTag != value::TypeTags::Boolean) {
+        return {false, value::TypeTags::Nothing, 0};
+    }
+    const bool elementsOnly = value::bitcastTo<bool>(elementsOnlyVal);
+    const StringData::ComparatorInterface* comparator = collTag == value::TypeTags::collator
+        ? value::getCollatorView(collVal)
+        : nullptr;
+
+    auto matches = [&](value::TypeTags tag, value::Value val) {
+        if (value::isNaN(tag, val)) {
+            return false;
+        }
+        for (ArityType idx = 3; idx < arity; idx += 2) {
+            auto [opOwned, opTag, opVal] = getFromStack(idx);
+            auto [rhsOwned, rhsTag, rhsVal] = getFromStack(idx + 1);
+            invariant(opTag == value::TypeTags::NumberInt32);
+            auto op = static_cast<TraverseCompareOp>(value::bitcastTo<int32_t>(opVal));
+            if (!traverseCompareMatches(tag, val, comparator, op, rhsTag, rhsVal)) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    if (!value::isArray(inputTag)) {
+        if (elementsOnly) {
+            return {false, value::TypeTags::Nothing, 0};
+        }
+        return {false,
+                value::TypeTags::Boolean,
+                value::bitcastFrom<bool>(matches(inputTag, inputVal))};
+    }
+
+    if (!elementsOnly && matches(inputTag, inputVal)) {
+        return {false, value::TypeTags::Boolean, value::bitcastFrom<bool>(true)};
+    }
+
+    bool hasElements = false;
+    for (value::ArrayEnumerator enumerator{inputTag, inputVal}; !enumerator.atEnd();
+         enumerator.advance()) {
+        hasElements = true;
+        auto [tag, val] = enumerator.getViewOfValue();
+        if (matches(tag, val)) {
+            return {false, value::TypeTags::Boolean, value::bitcastFrom<bool>(true)};
+        }
+    }
+    if (elementsOnly && !hasElements) {
+        return {false, value::TypeTags::Nothing, 0};
+    }
+    return {false, value::TypeTags::Boolean, value::bitcastFrom<bool>(false)};
+}
+
+/**
+ * traverseIsMember(input, arr[, collator]) tests whether 'input', or one of its elements if it is
+ * an array, is a member of 'arr'.
+ */
+std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinTraverseIsMember(
+    ArityType arity) {
+    invariant(arity == 2 || arity == 3);
+
+    auto [inputOwned, inputTag, inputVal] = getFromStack(0);
+    auto [arrOwned, arrTag, arrVal] = getFromStack(1);
+    CollatorInterface* collator = nullptr;
+    if (arity == 3) {
+        auto [collOwned, collTag, collVal] = getFromStack(2);
+        if (collTag != value::TypeTags::collator) {
+            return {false, value::TypeTags::Nothing, 0};
+        }
+        collator = value::getCollatorView(collVal);
+    }
+    if (!value::isArray(arrTag)) {
+        return {false, value::TypeTags::Nothing, 0};
+    }
+
+    auto isMember = [&](value::TypeTags tag, value::Value val) {
+        auto [resultTag, resultVal] = genericIsMember(tag, val, arrTag, arrVal, collator);
+        return resultTag == value::TypeTags::Boolean && value::bitcastTo<bool>(resultVal);
+    };
+
+    if (isMember(inputTag, inputVal)) {
+        return {false, value::TypeTags::Boolean, value::bitcastFrom<bool>(true)};
+    }
+    if (value::isArray(inputTag)) {
+        for (value::ArrayEnumerator enumerator{inputTag, inputVal}; !enumerator.atEnd();
+             enumerator.advance()) {
+            auto [tag, val] = enumerator.getViewOfValue();
+            if (isMember(tag, val)) {
+                return {false, value::TypeTags::Boolean, value::bitcastFrom<bool>(true)};
+            }
+        }
+    }
+    return {false, value::TypeTags::Boolean, value::bitcastFrom<bool>(false)};
+}
+
 std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinHasNullBytes(ArityType arity) {
     invariant(arity == 1);
     auto [strOwned, strType, strValue] = getFromStack(0);
@@ -3090,6 +3224,10 @@ std::tuple<bool, value::TypeTags, value::Value> ByteCode::dispatchBuiltin(Builti
             return builtinGetRegexPattern(arity);
         case Builtin::getRegexFlags:
             return builtinGetRegexFlags(arity);
+        case Builtin::traverseCompare:
+            return builtinTraverseCompare(arity);
+        case Builtin::traverseIsMember:
+            return builtinTraverseIsMember(arity);
     }
 
     MONGO_UNREACHABLE;
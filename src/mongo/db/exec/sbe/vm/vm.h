@@ -313,8 +313,16 @@ enum class Builtin : uint8_t {
     hasNullBytes,
     getRegexPattern,
     getRegexFlags,
+    traverseCompare,   // compare a value or the elements of an array to constants
+    traverseIsMember,  // test if a value or an element of an array is in a set
 };
 
+/**
+ * The comparisons 'traverseCompare' applies to the value or the elements of an array, passed to it
+ * as NumberInt32 constants.
+ */
+enum class TraverseCompareOp : int32_t { eq, less, lessEq, greater, greaterEq };
+
 using SmallArityType = uint8_t;
 using ArityType = uint32_t;
 
@@ -727,6 +735,8 @@ private:
     std::tuple<bool, value::TypeTags, value::Value> builtinHasNullBytes(ArityType arity);
     std::tuple<bool, value::TypeTags, value::Value> builtinGetRegexPattern(ArityType arity);
     std::tuple<bool, value::TypeTags, value::Value> builtinGetRegexFlags(ArityType arity);
+    std::tuple<bool, value::TypeTags, value::Value> builtinTraverseCompare(ArityType arity);
+    std::tuple<bool, value::TypeTags, value::Value> builtinTraverseIsMember(ArityType arity);
 
     std::tuple<bool, value::TypeTags, value::Value> dispatchBuiltin(Builtin f, ArityType arity);
 
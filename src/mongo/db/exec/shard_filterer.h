@@ -60,6 +60,17 @@ public:
      */
     virtual DocumentBelongsResult documentBelongsToMe(const BSONObj& doc) const = 0;
 
+    /**
+     * Checks if all the shard keys between 'min' and 'max' are owned by the current node, where
+     * 'isMaxInclusive' tells whether 'max' is part of the range. Filterers which cannot tell return
+     * false, so that the documents are checked one by one.
+     */
+    virtual bool rangeBelongsToMe(const BSONObj& min,
+                                  const BSONObj& max,
+                                  bool isMaxInclusive) const {
+        return false;
+    }
+
     /**
      * This method determines if the collection sharded.
      */
@@ -48,6 +48,12 @@ public:
         return _collectionFilter.keyBelongsToMe(shardKey);
     };
 
+    bool rangeBelongsToMe(const BSONObj& min,
+                          const BSONObj& max,
+                          bool isMaxInclusive) const override {
+        return _collectionFilter.rangeBelongsToMe(min, max, isMaxInclusive);
+    }
+
     bool isCollectionSharded() const override {
         return _collectionFilter.isSharded();
     }
@@ -113,7 +113,17 @@ SortStageDefault::SortStageDefault(boost::intrusive_ptr<ExpressionContext> expCt
                     limit,
                     maxMemoryUsageBytes,
                     expCtx->tempDir,
-                    expCtx->allowDiskUse) {}
+                    expCtx->allowDiskUse) {
+    _sortExecutor.attachToOperationContext(opCtx());
+}
+
+void SortStageDefault::doDetachFromOperationContext() {
+    _sortExecutor.detachFromOperationContext();
+}
+
+void SortStageDefault::doReattachToOperationContext() {
+    _sortExecutor.attachToOperationContext(opCtx());
+}
 
 void SortStageDefault::spool(WorkingSetID wsid) {
     SortableWorkingSetMember extractedMember{_ws->extract(wsid)};
@@ -149,7 +159,17 @@ SortStageSimple::SortStageSimple(boost::intrusive_ptr<ExpressionContext> expCtx,
                     limit,
                     maxMemoryUsageBytes,
                     expCtx->tempDir,
-                    expCtx->allowDiskUse) {}
+                    expCtx->allowDiskUse) {
+    _sortExecutor.attachToOperationContext(opCtx());
+}
+
+void SortStageSimple::doDetachFromOperationContext() {
+    _sortExecutor.detachFromOperationContext();
+}
+
+void SortStageSimple::doReattachToOperationContext() {
+    _sortExecutor.attachToOperationContext(opCtx());
+}
 
 void SortStageSimple::spool(WorkingSetID wsid) {
     auto member = _ws->get(wsid);
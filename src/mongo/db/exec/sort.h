@@ -132,6 +132,10 @@ public:
         return &_sortExecutor.stats();
     }
 
+protected:
+    void doDetachFromOperationContext() final;
+    void doReattachToOperationContext() final;
+
 private:
     SortExecutor<SortableWorkingSetMember> _sortExecutor;
 };
@@ -173,6 +177,10 @@ public:
         return &_sortExecutor.stats();
     }
 
+protected:
+    void doDetachFromOperationContext() final;
+    void doReattachToOperationContext() final;
+
 private:
     SortExecutor<BSONObj> _sortExecutor;
 };
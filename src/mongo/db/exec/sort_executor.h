@@ -29,13 +29,17 @@
 
 #pragma once
 
+#include "mongo/bson/ordering.h"
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/exec/plan_stats.h"
 #include "mongo/db/exec/sort_key_comparator.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/pipeline/expression.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/query/query_memory_governor.h"
 #include "mongo/db/query/sort_pattern.h"
 #include "mongo/db/sorter/sorter.h"
+#include "mongo/db/storage/key_string.h"
 
 namespace mongo {
 /**
@@ -47,6 +51,14 @@ namespace mongo {
  * The template parameter is the type of data being sorted. In DocumentSource execution, we sort
  * Document objects directly, but in the PlanStage layer we may sort WorkingSetMembers. The type of
  * the sort key, on the other hand, is always Value.
+ *
+ * When 'internalQueryUseKeyStringSortKeys' is enabled, the executor internally encodes each sort
+ * key as a KeyString whose byte order matches the order of the sort pattern, so that the sorter
+ * and the merge of any spilled runs compare keys with memcmp. The keys are decoded back into
+ * Values as they are returned by getNext().
+ *
+ * The memory held by an unlimited sort is reported to the QueryMemoryGovernor through the operation
+ * which the executor is attached to, and the sort spills early when the governor asks it to.
  */
 template <typename T>
 class SortExecutor {
@@ -64,6 +76,15 @@ public:
         SortKeyComparator _sortKeyComparator;
     };
 
+    using KeyStringSorter = Sorter<KeyString::Value, T>;
+    class KeyStringComparator {
+    public:
+        int operator()(const typename KeyStringSorter::Data& lhs,
+                       const typename KeyStringSorter::Data& rhs) const {
+            return lhs.first.compare(rhs.first);
+        }
+    };
+
     /**
      * If the passed in limit is 0, this is treated as no limit.
      */
@@ -74,7 +95,17 @@ public:
                  bool allowDiskUse)
         : _sortPattern(std::move(sortPattern)),
           _tempDir(std::move(tempDir)),
-          _diskUseAllowed(allowDiskUse) {
+          _diskUseAllowed(allowDiskUse),
+          _useKeyStringSortKeys(internalQueryUseKeyStringSortKeys.load() &&
+                                _sortPattern.size() <= Ordering::kMaxCompoundIndexKeys),
+          _memoryReservation(std::make_unique<QueryMemoryGovernor::Reservation>()) {
+        if (_useKeyStringSortKeys) {
+            BSONObjBuilder orderingBob;
+            for (auto&& part : _sortPattern) {
+                orderingBob.append("", part.isAscending ? 1 : -1);
+            }
+            _ordering = Ordering::make(orderingBob.obj());
+        }
         _stats.sortPattern =
             _sortPattern.serialize(SortPattern::SortKeySerialization::kForExplain).toBson();
         _stats.limit = limit;
@@ -85,6 +116,19 @@ public:
         return _sortPattern;
     }
 
+    /**
+     * Accounts the memory held by the sort to 'opCtx'. Must be followed by a call to
+     * 'detachFromOperationContext()' before 'opCtx' is destroyed, unless the executor is destroyed
+     * first.
+     */
+    void attachToOperationContext(OperationContext* opCtx) {
+        _memoryReservation->attach(opCtx);
+    }
+
+    void detachFromOperationContext() {
+        _memoryReservation->detach();
+    }
+
     /**
      * Absorbs 'limit', enabling a top-k sort. It is safe to call this multiple times, it will keep
      * the smallest limit.
@@ -123,6 +167,14 @@ public:
      * Should only be called before 'loadingDone()' is called.
      */
     void add(const Value& sortKey, const T& data) {
+        if (_useKeyStringSortKeys) {
+            if (!_keyStringSorter) {
+                _keyStringSorter.reset(makeKeyStringSorter());
+            }
+            _keyStringSorter->add(encodeSortKey(sortKey), data);
+            return;
+        }
+
         if (!_sorter) {
             _sorter.reset(DocumentSorter::make(makeSortOptions(), Comparator(_sortPattern)));
         }
@@ -133,6 +185,20 @@ public:
      * Signals to the sort executor that there will be no more input documents.
      */
     void loadingDone() {
+        if (_useKeyStringSortKeys) {
+            if (!_keyStringSorter) {
+                _keyStringSorter.reset(makeKeyStringSorter());
+            }
+            _keyStringOutput.reset(_keyStringSorter->done());
+            _stats.keysSorted += _keyStringSorter->numSorted();
+            _stats.spills += _keyStringSorter->numSpills();
+            _stats.totalDataSizeBytes += _keyStringSorter->totalDataSizeSorted();
+            _stats.spilledDataSizeBytes += _keyStringSorter->spilledDataSizeBytes();
+            _stats.spilledStorageSizeBytes += _keyStringSorter->spilledStorageSizeBytes();
+            _keyStringSorter.reset();
+            return;
+        }
+
         // This conditional should only pass if no documents were added to the sorter.
         if (!_sorter) {
             _sorter.reset(DocumentSorter::make(makeSortOptions(), Comparator(_sortPattern)));
@@ -141,6 +207,8 @@ public:
         _stats.keysSorted += _sorter->numSorted();
         _stats.spills += _sorter->numSpills();
         _stats.totalDataSizeBytes += _sorter->totalDataSizeSorted();
+        _stats.spilledDataSizeBytes += _sorter->spilledDataSizeBytes();
+        _stats.spilledStorageSizeBytes += _sorter->spilledStorageSizeBytes();
         _sorter.reset();
     }
 
@@ -153,8 +221,19 @@ public:
             return false;
         }
 
+        if (_useKeyStringSortKeys) {
+            if (!_keyStringOutput->more()) {
+                _keyStringOutput.reset();
+                _memoryReservation->set(0);
+                _isEOF = true;
+                return false;
+            }
+            return true;
+        }
+
         if (!_output->more()) {
             _output.reset();
+            _memoryReservation->set(0);
             _isEOF = true;
             return false;
         }
@@ -168,10 +247,55 @@ public:
      * end-of-stream must be detected with 'hasNext()'.
      */
     std::pair<Value, T> getNext() {
+        if (_useKeyStringSortKeys) {
+            auto next = _keyStringOutput->next();
+            return {decodeSortKey(next.first), std::move(next.second)};
+        }
         return _output->next();
     }
 
 private:
+    KeyStringSorter* makeKeyStringSorter() const {
+        return KeyStringSorter::make(
+            makeSortOptions(),
+            KeyStringComparator(),
+            {KeyString::Value::SorterDeserializeSettings(kKeyStringVersion),
+             typename T::SorterDeserializeSettings()});
+    }
+
+    /**
+     * Encodes 'sortKey', which holds a single value or an array with one value per component of
+     * the sort pattern, as a KeyString. The values are already collation comparison keys, so the
+     * encoding orders them just as the binary comparison in SortKeyComparator does.
+     */
+    KeyString::Value encodeSortKey(const Value& sortKey) const {
+        BSONObjBuilder bob;
+        if (_sortPattern.isSingleElementKey()) {
+            sortKey.addToBsonObj(&bob, ""_sd);
+        } else {
+            for (auto&& component : sortKey.getArray()) {
+                component.addToBsonObj(&bob, ""_sd);
+            }
+        }
+        return KeyString::HeapBuilder(kKeyStringVersion, bob.obj(), _ordering).release();
+    }
+
+    Value decodeSortKey(const KeyString::Value& keyString) const {
+        auto obj = KeyString::toBson(keyString, _ordering);
+        if (_sortPattern.isSingleElementKey()) {
+            return Value(obj.firstElement());
+        }
+
+        std::vector<Value> components;
+        components.reserve(_sortPattern.size());
+        for (auto&& elt : obj) {
+            components.emplace_back(elt);
+        }
+        return Value(std::move(components));
+    }
+
+    static constexpr auto kKeyStringVersion = KeyString::Version::kLatestVersion;
+
     SortOptions makeSortOptions() const {
         SortOptions opts;
         if (_stats.limit) {
@@ -183,6 +307,10 @@ private:
             opts.extSortAllowed = true;
             opts.tempDir = _tempDir;
         }
+        opts.shouldSpillEarly = [reservation = _memoryReservation.get()](size_t memUsed) {
+            reservation->set(memUsed);
+            return reservation->shouldSpill();
+        };
 
         return opts;
     }
@@ -190,10 +318,20 @@ private:
     const SortPattern _sortPattern;
     const std::string _tempDir;
     const bool _diskUseAllowed;
+    const bool _useKeyStringSortKeys;
+
+    // Held through a pointer so that the sorters can keep referring to it if the executor moves.
+    std::unique_ptr<QueryMemoryGovernor::Reservation> _memoryReservation;
+
+    // The ordering of the sort pattern, which is only used when sort keys are KeyStrings.
+    Ordering _ordering = Ordering::allAscending();
 
     std::unique_ptr<DocumentSorter> _sorter;
     std::unique_ptr<typename DocumentSorter::Iterator> _output;
 
+    std::unique_ptr<KeyStringSorter> _keyStringSorter;
+    std::unique_ptr<typename KeyStringSorter::Iterator> _keyStringOutput;
+
     SortStats _stats;
 
     bool _isEOF = false;
@@ -41,9 +41,11 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/query/collation/collator_factory_mock.h"
 #include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/service_context_d_test_fixture.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/clock_source_mock.h"
+#include "mongo/util/scopeguard.h"
 
 using namespace mongo;
 
@@ -304,4 +306,29 @@ TEST_F(SortStageDefaultTest, SortDescendingWithCollation) {
              "{input: [{a: 'ba'}, {a: 'aa'}, {a: 'ab'}]}",
              "{output: [{a: 'ab'}, {a: 'ba'}, {a: 'aa'}]}");
 }
+
+TEST_F(SortStageDefaultTest, SortCompoundWithKeyStringSortKeys) {
+    internalQueryUseKeyStringSortKeys.store(true);
+    ON_BLOCK_EXIT([] { internalQueryUseKeyStringSortKeys.store(false); });
+
+    testWork("{a: 1, b: -1}",
+             nullptr,
+             0,
+             "{input: [{a: 2.5, b: 'x'}, {a: 1, b: 1}, {a: null, b: 3}, {a: 1, b: 'y'},"
+             "{a: NumberLong(2), b: 0}, {b: 2}, {a: 'str', b: 1}]}",
+             "{output: [{a: null, b: 3}, {b: 2}, {a: 1, b: 'y'}, {a: 1, b: 1},"
+             "{a: NumberLong(2), b: 0}, {a: 2.5, b: 'x'}, {a: 'str', b: 1}]}");
+}
+
+TEST_F(SortStageDefaultTest, SortWithLimitAndCollationWithKeyStringSortKeys) {
+    internalQueryUseKeyStringSortKeys.store(true);
+    ON_BLOCK_EXIT([] { internalQueryUseKeyStringSortKeys.store(false); });
+
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kReverseString);
+    testWork("{a: -1}",
+             &collator,
+             2,
+             "{input: [{a: 'ba'}, {a: 'aa'}, {a: 'ab'}]}",
+             "{output: [{a: 'ab'}, {a: 'ba'}]}");
+}
 }  // namespace
@@ -128,9 +128,19 @@ unique_ptr<PlanStage> TextStage::buildTextTree(OperationContext* opCtx,
     std::unique_ptr<PlanStage> textMatchStage;
     if (wantTextScore) {
         // We use a TEXT_OR stage to get the union of the results from the index scans and then
-        // compute their text scores. This is a blocking operation.
-        auto textScorer =
-            std::make_unique<TextOrStage>(expCtx(), _params.spec, ws, filter, collection);
+        // compute their text scores. This is a blocking operation. It can return only the best
+        // scored documents if the TEXT_MATCH stage is known to accept every one of them, that is if
+        // there are no negations or phrases to check and the index keys are exact.
+        const auto& query = _params.query;
+        const bool textMatchAcceptsAll = query.getNegatedTerms().empty() &&
+            query.getPositivePhr().empty() && query.getNegatedPhr().empty() &&
+            !query.getCaseSensitive() && !query.getDiacriticSensitive();
+        auto textScorer = std::make_unique<TextOrStage>(expCtx(),
+                                                        _params.spec,
+                                                        ws,
+                                                        filter,
+                                                        collection,
+                                                        textMatchAcceptsAll ? _params.topK : 0);
 
         textScorer->addChildren(std::move(indexScanList));
 
@@ -64,6 +64,9 @@ struct TextStageParams {
     // True if we need the text score in the output, because the projection includes the 'textScore'
     // metadata field.
     bool wantTextScore = true;
+
+    // When not zero, only the 'topK' best scored documents are needed.
+    size_t topK = 0;
 };
 
 /**
@@ -29,6 +29,7 @@
 
 #include "mongo/db/exec/text_or.h"
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <vector>
@@ -56,10 +57,12 @@ TextOrStage::TextOrStage(ExpressionContext* expCtx,
                          const FTSSpec& ftsSpec,
                          WorkingSet* ws,
                          const MatchExpression* filter,
-                         const CollectionPtr& collection)
+                         const CollectionPtr& collection,
+                         size_t topK)
     : RequiresCollectionStage(kStageType, expCtx, collection),
       _ftsSpec(ftsSpec),
       _ws(ws),
+      _topK(topK),
       _scoreIterator(_scores.end()),
       _filter(filter),
       _idRetrying(WorkingSet::INVALID_ID) {}
@@ -193,6 +196,9 @@ PlanStage::StageState TextOrStage::readFromChildren(WorkingSetID* out) {
         }
 
         // If we're here we are done reading results.  Move to the next state.
+        if (_topK) {
+            rejectAllButTopK();
+        }
         _scoreIterator = _scores.begin();
         _internalState = State::kReturningResults;
 
@@ -212,22 +218,65 @@ PlanStage::StageState TextOrStage::returnResults(WorkingSetID* out) {
 
     // Retrieve the record that contains the text score.
     TextRecordData textRecordData = _scoreIterator->second;
-    ++_scoreIterator;
 
     // Ignore non-matched documents.
     if (textRecordData.score < 0) {
         invariant(textRecordData.wsid == WorkingSet::INVALID_ID);
+        ++_scoreIterator;
         return PlanStage::NEED_TIME;
     }
 
     WorkingSetMember* wsm = _ws->get(textRecordData.wsid);
 
+    if (_topK) {
+        // The document has not been fetched yet.
+        try {
+            if (!WorkingSetCommon::fetch(
+                    opCtx(), _ws, textRecordData.wsid, _recordCursor, collection()->ns())) {
+                _ws->free(textRecordData.wsid);
+                ++_scoreIterator;
+                return PlanStage::NEED_TIME;
+            }
+            ++_specificStats.fetches;
+        } catch (const WriteConflictException&) {
+            // Fetch this document again on the next call.
+            *out = WorkingSet::INVALID_ID;
+            return NEED_YIELD;
+        }
+        wsm->makeObjOwnedIfNeeded();
+    }
+    ++_scoreIterator;
+
     // Populate the working set member with the text score metadata and return it.
     wsm->metadata().setTextScore(textRecordData.score);
     *out = textRecordData.wsid;
     return PlanStage::ADVANCED;
 }
 
+void TextOrStage::rejectAllButTopK() {
+    std::vector<TextRecordData*> matched;
+    for (auto& [recordId, textRecordData] : _scores) {
+        if (textRecordData.score >= 0) {
+            matched.push_back(&textRecordData);
+        }
+    }
+    if (matched.size() <= _topK) {
+        return;
+    }
+
+    std::nth_element(matched.begin(),
+                     matched.begin() + _topK,
+                     matched.end(),
+                     [](const TextRecordData* lhs, const TextRecordData* rhs) {
+                         return lhs->score > rhs->score;
+                     });
+    for (auto it = matched.begin() + _topK; it != matched.end(); ++it) {
+        _ws->free((*it)->wsid);
+        (*it)->wsid = WorkingSet::INVALID_ID;
+        (*it)->score = -1;
+    }
+}
+
 PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out) {
     WorkingSetMember* wsm = _ws->get(wsid);
     invariant(wsm->getState() == WorkingSetMember::RID_AND_IDX);
@@ -253,19 +302,23 @@ PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out)
         }
 
         // Our parent expects RID_AND_OBJ members, so we fetch the document here if we haven't
-        // already.
-        try {
-            if (!WorkingSetCommon::fetch(opCtx(), _ws, wsid, _recordCursor, collection()->ns())) {
-                _ws->free(wsid);
-                textRecordData->score = -1;
-                return NEED_TIME;
+        // already. When only the best scored documents are returned, they are fetched once they
+        // are known instead.
+        if (!_topK) {
+            try {
+                if (!WorkingSetCommon::fetch(
+                        opCtx(), _ws, wsid, _recordCursor, collection()->ns())) {
+                    _ws->free(wsid);
+                    textRecordData->score = -1;
+                    return NEED_TIME;
+                }
+                ++_specificStats.fetches;
+            } catch (const WriteConflictException&) {
+                wsm->makeObjOwnedIfNeeded();
+                _idRetrying = wsid;
+                *out = WorkingSet::INVALID_ID;
+                return NEED_YIELD;
             }
-            ++_specificStats.fetches;
-        } catch (const WriteConflictException&) {
-            wsm->makeObjOwnedIfNeeded();
-            _idRetrying = wsid;
-            *out = WorkingSet::INVALID_ID;
-            return NEED_YIELD;
         }
 
         textRecordData->wsid = wsid;
@@ -47,6 +47,9 @@ class OperationContext;
  * the positive terms in the search query, as well as their scores.
  *
  * The WorkingSetMembers returned are fetched and in the LOC_AND_OBJ state.
+ *
+ * If 'topK' is not zero, only the 'topK' best scored documents are returned. The documents are
+ * then only fetched once all of the terms have been read, so that the others are never fetched.
  */
 class TextOrStage final : public RequiresCollectionStage {
 public:
@@ -71,7 +74,8 @@ public:
                 const FTSSpec& ftsSpec,
                 WorkingSet* ws,
                 const MatchExpression* filter,
-                const CollectionPtr& collection);
+                const CollectionPtr& collection,
+                size_t topK = 0);
 
     void addChild(std::unique_ptr<PlanStage> child);
 
@@ -123,6 +127,12 @@ private:
      */
     StageState returnResults(WorkingSetID* out);
 
+    /**
+     * Called once all of the terms have been read when '_topK' is set. Rejects every document
+     * which is not among the '_topK' best scored ones.
+     */
+    void rejectAllButTopK();
+
     // The index spec used to determine where to find the score.
     FTSSpec _ftsSpec;
 
@@ -135,6 +145,10 @@ private:
     // Which of _children are we calling work(...) on now?
     size_t _currentChild = 0;
 
+    // If not zero, the number of best scored documents to return. Until then the documents are
+    // kept as unfetched RID_AND_IDX members.
+    const size_t _topK;
+
     /**
      *  Temporary score data filled out by children.
      *  Maps from RecordID -> (aggregate score for doc, wsid).
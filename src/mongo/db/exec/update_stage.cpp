@@ -117,6 +117,16 @@ UpdateStage::UpdateStage(ExpressionContext* expCtx,
     // We should never reach here if the request is an upsert.
     invariant(!_params.request->isUpsert());
     _children.emplace_back(child);
+
+    // Updating several documents in one WriteUnitOfWork would write all of their oplog entries in
+    // one storage transaction, so only batch the updates which are not written to the oplog.
+    _batched = _params.request->isMulti() && !_params.request->shouldReturnAnyDocs() &&
+        _params.batchDocs > 1 &&
+        repl::ReplicationCoordinator::get(opCtx())->isOplogDisabledFor(opCtx(),
+                                                                       collection->ns());
+    if (_batched) {
+        _stagedUpdates.reserve(_params.batchDocs);
+    }
 }
 
 // Protected constructor.
@@ -323,9 +333,14 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
         // it again.  For an example, see the comment above near declaration of
         // updatedRecordIds.
         //
-        // This must be done after the wunit commits so we are sure we won't be rolling back.
+        // This must be done after the wunit commits so we are sure we won't be rolling back. A
+        // batched update only commits once the whole batch has been updated.
         if (_updatedRecordIds && (newRecordId != recordId || driver->modsAffectIndices())) {
-            _updatedRecordIds->insert(newRecordId);
+            if (_batched) {
+                _batchUpdatedRecordIds.push_back(newRecordId);
+            } else {
+                _updatedRecordIds->insert(newRecordId);
+            }
         }
     }
 
@@ -357,6 +372,7 @@ bool UpdateStage::isEOF() {
     // We're done updating if either the child has no more results to give us, or we've
     // already gotten a result back and we're not a multi-update.
     return _idRetrying == WorkingSet::INVALID_ID && _idReturning == WorkingSet::INVALID_ID &&
+        _stagedUpdates.empty() &&
         (child()->isEOF() || (_specificStats.nMatched > 0 && !_params.request->isMulti()));
 }
 
@@ -380,6 +396,10 @@ PlanStage::StageState UpdateStage::doWork(WorkingSetID* out) {
         return PlanStage::ADVANCED;
     }
 
+    if (_batched) {
+        return doBatchedWork(out);
+    }
+
     // Either retry the last WSM we worked on or get a new one from our child.
     WorkingSetID id;
     StageState status;
@@ -409,7 +429,7 @@ PlanStage::StageState UpdateStage::doWork(WorkingSetID* out) {
         invariant(member->hasObj());
 
         // We fill this with the new RecordIds of moved doc so we don't double-update.
-        if (_updatedRecordIds && _updatedRecordIds->count(recordId) > 0) {
+        if (_updatedRecordIds && _updatedRecordIds->contains(recordId)) {
             // Found a RecordId that refers to a document we had already updated. Note that
             // we can never remove from _updatedRecordIds because updates by other clients
             // could cause us to encounter a document again later.
@@ -519,6 +539,106 @@ PlanStage::StageState UpdateStage::doWork(WorkingSetID* out) {
     return status;
 }
 
+PlanStage::StageState UpdateStage::doBatchedWork(WorkingSetID* out) {
+    if (_stagedUpdates.size() >= _params.batchDocs || child()->isEOF()) {
+        return updateStagedDocuments(out);
+    }
+
+    WorkingSetID id;
+    auto status = child()->work(&id);
+    if (PlanStage::IS_EOF == status) {
+        return _stagedUpdates.empty() ? status : updateStagedDocuments(out);
+    } else if (PlanStage::NEED_YIELD == status) {
+        *out = id;
+        return status;
+    } else if (PlanStage::ADVANCED != status) {
+        return status;
+    }
+
+    WorkingSetMember* member = _ws->get(id);
+    invariant(member->hasRecordId());
+    invariant(member->hasObj());
+
+    if (_updatedRecordIds->contains(member->recordId)) {
+        // Found a RecordId that refers to a document updated by an earlier batch.
+        _ws->free(id);
+        return PlanStage::NEED_TIME;
+    }
+
+    // The document is checked against the predicate when its batch is updated. Its BSONObj must be
+    // owned to survive the saveState() calls made until then.
+    member->makeObjOwnedIfNeeded();
+    _stagedUpdates.push_back(id);
+    return PlanStage::NEED_TIME;
+}
+
+PlanStage::StageState UpdateStage::updateStagedDocuments(WorkingSetID* out) {
+    try {
+        child()->saveState();
+    } catch (const WriteConflictException&) {
+        std::terminate();
+    }
+
+    // Nothing in the batch is written unless its WriteUnitOfWork commits, so only count the batch
+    // once it has.
+    const auto nMatchedBefore = _specificStats.nMatched;
+    const auto nModifiedBefore = _specificStats.nModified;
+    auto restoreStats = makeGuard([&] {
+        _specificStats.nMatched = nMatchedBefore;
+        _specificStats.nModified = nModifiedBefore;
+        _batchUpdatedRecordIds.clear();
+    });
+
+    try {
+        boost::optional<WriteUnitOfWork> wunit;
+        if (!_params.request->explain()) {
+            wunit.emplace(opCtx());
+        }
+
+        for (auto id : _stagedUpdates) {
+            // Documents may have been deleted or updated since they were staged, in particular if
+            // the plan yielded in between.
+            if (!write_stage_common::ensureStillMatches(
+                    collection(), opCtx(), _ws, id, _params.canonicalQuery)) {
+                continue;
+            }
+
+            WorkingSetMember* member = _ws->get(id);
+            RecordId recordId = member->recordId;
+            transformAndUpdate({member->doc.snapshotId(), member->doc.value().toBson()}, recordId);
+            ++_specificStats.nMatched;
+        }
+
+        if (wunit) {
+            wunit->commit();
+        }
+    } catch (const WriteConflictException&) {
+        // Keep the staged members so the batch can be retried.
+        *out = WorkingSet::INVALID_ID;
+        return NEED_YIELD;
+    }
+    restoreStats.dismiss();
+
+    for (const auto& recordId : _batchUpdatedRecordIds) {
+        _updatedRecordIds->insert(recordId);
+    }
+    _batchUpdatedRecordIds.clear();
+    for (auto id : _stagedUpdates) {
+        _ws->free(id);
+    }
+    _stagedUpdates.clear();
+
+    // Restore the state outside of the WriteUnitOfWork, as for a single update.
+    try {
+        child()->restoreState(&collection());
+    } catch (const WriteConflictException&) {
+        *out = WorkingSet::INVALID_ID;
+        return NEED_YIELD;
+    }
+
+    return PlanStage::NEED_TIME;
+}
+
 void UpdateStage::_ensureIdFieldIsFirst(mb::Document* doc, bool generateOIDIfMissing) {
     mb::Element idElem = mb::findFirstChildNamed(doc->root(), idFieldName);
 
@@ -31,6 +31,7 @@
 
 
 #include "mongo/db/catalog/collection.h"
+#include "mongo/db/exec/record_id_set.h"
 #include "mongo/db/exec/requires_collection_stage.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/ops/parsed_update.h"
@@ -63,6 +64,11 @@ struct UpdateStageParams {
     // Not owned here.
     CanonicalQuery* canonicalQuery;
 
+    // When greater than one, a multi-update which neither upserts nor returns documents, and whose
+    // writes are not written to the oplog, updates up to this many documents in each
+    // WriteUnitOfWork rather than one at a time.
+    size_t batchDocs = 0;
+
 private:
     // Default constructor not allowed.
     UpdateStageParams();
@@ -147,6 +153,19 @@ private:
      */
     StageState prepareToRetryWSM(WorkingSetID idToRetry, WorkingSetID* out);
 
+    /**
+     * The doWork() implementation used when '_batched' is set. Stages the documents returned by the
+     * child until 'batchDocs' of them are staged or the child is exhausted, then updates them.
+     */
+    StageState doBatchedWork(WorkingSetID* out);
+
+    /**
+     * Updates every document in '_stagedUpdates' which still matches the predicate within a single
+     * WriteUnitOfWork. If the WriteUnitOfWork hits a write conflict, the staged documents are kept
+     * so that the whole batch is retried, and NEED_YIELD is returned.
+     */
+    StageState updateStagedDocuments(WorkingSetID* out);
+
     /**
      * Returns true if the owning shard under the current key pattern would change as a result of
      * the update, or if the destined recipient under the new shard key pattern from resharding
@@ -196,8 +215,17 @@ private:
     // document and we wouldn't want to update that.
     //
     // So, no matter what, we keep track of where the doc wound up.
-    typedef stdx::unordered_set<RecordId, RecordId::Hasher> RecordIdSet;
     const std::unique_ptr<RecordIdSet> _updatedRecordIds;
+
+    // Whether documents are updated in batches of up to 'batchDocs' documents.
+    bool _batched = false;
+
+    // The members returned by the child which are yet to be updated when '_batched' is set.
+    std::vector<WorkingSetID> _stagedUpdates;
+
+    // The RecordIds to add to '_updatedRecordIds' once the WriteUnitOfWork of the current batch
+    // commits.
+    std::vector<RecordId> _batchUpdatedRecordIds;
 };
 
 }  // namespace mongo
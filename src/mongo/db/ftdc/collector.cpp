@@ -31,6 +31,8 @@
 
 #include "mongo/db/ftdc/collector.h"
 
+#include <algorithm>
+
 #include "mongo/base/string_data.h"
 #include "mongo/bson/bsonmisc.h"
 #include "mongo/bson/bsonobjbuilder.h"
@@ -100,4 +102,62 @@ std::tuple<BSONObj, Date_t> FTDCCollectorCollection::collect(Client* client) {
     return std::tuple<BSONObj, Date_t>(builder.obj(), start);
 }
 
+void FTDCMetricsCollectorCollection::add(std::unique_ptr<FTDCMetricsCollectorInterface> collector) {
+    _collectors.emplace_back(std::move(collector));
+}
+
+bool FTDCMetricsCollectorCollection::select(const std::vector<std::string>& names) {
+    std::vector<Selected> selected;
+    for (auto& collector : _collectors) {
+        if (names.empty() ||
+            std::find(names.begin(), names.end(), collector->name()) != names.end()) {
+            selected.push_back({collector.get(), collector->metricNames()});
+        }
+    }
+
+    bool changed = selected.size() != _selected.size() ||
+        !std::equal(selected.begin(),
+                    selected.end(),
+                    _selected.begin(),
+                    [](const Selected& a, const Selected& b) { return a.collector == b.collector; });
+    _selected = std::move(selected);
+    return changed;
+}
+
+Date_t FTDCMetricsCollectorCollection::collect(Client* client, std::vector<std::uint64_t>* metrics) {
+    Date_t start = client->getServiceContext()->getPreciseClockSource()->now();
+    metrics->push_back(start.toMillisSinceEpoch());
+
+    for (auto& selected : _selected) {
+        selected.collector->collect(metrics);
+    }
+
+    metrics->push_back(
+        client->getServiceContext()->getPreciseClockSource()->now().toMillisSinceEpoch());
+
+    return start;
+}
+
+BSONObj FTDCMetricsCollectorCollection::makeDocument(
+    const std::vector<std::uint64_t>& metrics) const {
+    BSONObjBuilder builder;
+    auto metric = metrics.begin();
+
+    builder.appendDate(kFTDCCollectStartField, Date_t::fromMillisSinceEpoch(*metric++));
+
+    for (auto& selected : _selected) {
+        BSONObjBuilder subObjBuilder(builder.subobjStart(selected.collector->name()));
+        for (auto& name : selected.metricNames) {
+            invariant(metric != metrics.end());
+            subObjBuilder.append(name, static_cast<long long>(*metric++));
+        }
+    }
+
+    invariant(metric != metrics.end());
+    builder.appendDate(kFTDCCollectEndField, Date_t::fromMillisSinceEpoch(*metric++));
+    invariant(metric == metrics.end());
+
+    return builder.obj();
+}
+
 }  // namespace mongo
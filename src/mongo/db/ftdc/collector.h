@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <tuple>
@@ -115,4 +116,105 @@ private:
     std::vector<std::unique_ptr<FTDCCollectorInterface>> _collectors;
 };
 
+/**
+ * Numeric metrics collector interface
+ *
+ * Provides an interface to collect a fixed list of numeric metrics without building BSON, so that
+ * they are cheap enough to sample several times a second.
+ */
+class FTDCMetricsCollectorInterface {
+    FTDCMetricsCollectorInterface(const FTDCMetricsCollectorInterface&) = delete;
+    FTDCMetricsCollectorInterface& operator=(const FTDCMetricsCollectorInterface&) = delete;
+
+public:
+    virtual ~FTDCMetricsCollectorInterface() = default;
+
+    /**
+     * Name of the collector
+     *
+     * Used to select the collector, and as the name of its sub-document in samples.
+     */
+    virtual std::string name() const = 0;
+
+    /**
+     * Names of the metrics, in the order collect() appends their values. Must not change.
+     */
+    virtual std::vector<std::string> metricNames() const = 0;
+
+    /**
+     * Append the current value of each metric to metrics.
+     */
+    virtual void collect(std::vector<std::uint64_t>* metrics) = 0;
+
+protected:
+    FTDCMetricsCollectorInterface() = default;
+};
+
+/**
+ * Manages the set of numeric metrics collectors, and which of them are sampled.
+ *
+ * Not Thread-Safe. Locking is owner's responsibility.
+ */
+class FTDCMetricsCollectorCollection {
+    FTDCMetricsCollectorCollection(const FTDCMetricsCollectorCollection&) = delete;
+    FTDCMetricsCollectorCollection& operator=(const FTDCMetricsCollectorCollection&) = delete;
+
+public:
+    FTDCMetricsCollectorCollection() = default;
+
+    /**
+     * Add a metrics collector to the collection.
+     */
+    void add(std::unique_ptr<FTDCMetricsCollectorInterface> collector);
+
+    /**
+     * Select the collectors to sample by name. An empty list selects all of them.
+     *
+     * Returns true if the selection changed.
+     */
+    bool select(const std::vector<std::string>& names);
+
+    /**
+     * Returns true if no collector is selected.
+     */
+    bool empty() const {
+        return _selected.empty();
+    }
+
+    /**
+     * Collect a sample from the selected collectors into metrics, in the order
+     * FTDCBSONUtil::extractMetricsFromDocument extracts them from makeDocument(metrics).
+     * Returns the time at which collecting started.
+     */
+    Date_t collect(Client* client, std::vector<std::uint64_t>* metrics);
+
+    /**
+     * Build the document of a sample collected by collect().
+     *
+     * Sample schema:
+     * {
+     *    "start" : Date_t,      <- Time at which all collecting started
+     *    "name" : {             <- name is from name() in FTDCMetricsCollectorInterface
+     *       "metric" : Int64,   <- one field per name in metricNames()
+     *       ...
+     *    },
+     *    ...
+     *    "end" : Date_t,        <- Time at which all collecting ended
+     * }
+     */
+    BSONObj makeDocument(const std::vector<std::uint64_t>& metrics) const;
+
+private:
+    struct Selected {
+        FTDCMetricsCollectorInterface* collector;
+        std::vector<std::string> metricNames;
+    };
+
+    // collection of collectors
+    std::vector<std::unique_ptr<FTDCMetricsCollectorInterface>> _collectors;
+
+    // collectors which are sampled, with their metric names
+    std::vector<Selected> _selected;
+};
+
 }  // namespace mongo
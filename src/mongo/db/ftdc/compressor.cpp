@@ -83,7 +83,23 @@ FTDCCompressor::addSample(const BSONObj& sample, Date_t date) {
             std::get<1>(swCompressedSamples.getValue()))};
     }
 
+    return _addDeltas();
+}
+
+StatusWith<boost::optional<std::tuple<ConstDataRange, FTDCCompressor::CompressorState, Date_t>>>
+FTDCCompressor::addMetrics(const std::vector<std::uint64_t>& metrics,
+                           Date_t date,
+                           const std::function<BSONObj()>& makeSample) {
+    if (_referenceDoc.isEmpty() || metrics.size() != _metricsCount) {
+        return addSample(makeSample(), date);
+    }
 
+    _metrics.assign(metrics.begin(), metrics.end());
+    return _addDeltas();
+}
+
+StatusWith<boost::optional<std::tuple<ConstDataRange, FTDCCompressor::CompressorState, Date_t>>>
+FTDCCompressor::_addDeltas() {
     // Add another sample
     for (std::size_t i = 0; i < _metrics.size(); ++i) {
         // NOTE: This touches a lot of cache lines so that compression code can be more effcient.
@@ -32,6 +32,7 @@
 #include <boost/optional.hpp>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <tuple>
 #include <vector>
 
@@ -96,6 +97,22 @@ public:
     StatusWith<boost::optional<std::tuple<ConstDataRange, CompressorState, Date_t>>> addSample(
         const BSONObj& sample, Date_t date);
 
+    /**
+     * Add a sample given as its metrics, in the order FTDCBSONUtil::extractMetricsFromDocument
+     * extracts them from the document returned by makeSample.
+     *
+     * This skips building and walking a BSON document for every sample. makeSample is only called
+     * when the sample has to become the reference document, i.e. for the first sample of a chunk
+     * or when the number of metrics changes. Callers must not change the names of the metrics
+     * without changing their number, or reset the compressor when they do.
+     *
+     * Returns the same values as addSample.
+     */
+    StatusWith<boost::optional<std::tuple<ConstDataRange, CompressorState, Date_t>>> addMetrics(
+        const std::vector<std::uint64_t>& metrics,
+        Date_t date,
+        const std::function<BSONObj()>& makeSample);
+
     /**
      * Returns the number of enqueued samples.
      *
@@ -150,6 +167,12 @@ private:
      */
     void _reset(const BSONObj& referenceDoc, Date_t date);
 
+    /**
+     * Record the deltas of _metrics against the previous sample, and flush if the chunk is full.
+     */
+    StatusWith<boost::optional<std::tuple<ConstDataRange, CompressorState, Date_t>>>
+    _addDeltas();
+
 private:
     // Block Compressor
     BlockCompressor _compressor;
@@ -35,6 +35,7 @@
 #include "mongo/base/status_with.h"
 #include "mongo/bson/bsonmisc.h"
 #include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/ftdc/collector.h"
 #include "mongo/db/ftdc/compressor.h"
 #include "mongo/db/ftdc/config.h"
 #include "mongo/db/ftdc/decompressor.h"
@@ -578,4 +579,78 @@ TEST_F(FTDCCompressorTest, TestDoubleValues) {
     });
 }
 
+class FTDCMetricsCollectorMock : public FTDCMetricsCollectorInterface {
+public:
+    FTDCMetricsCollectorMock(std::string name, std::uint64_t* value)
+        : _name(std::move(name)), _value(value) {}
+
+    std::string name() const final {
+        return _name;
+    }
+
+    std::vector<std::string> metricNames() const final {
+        return {"x", "y"};
+    }
+
+    void collect(std::vector<std::uint64_t>* metrics) final {
+        metrics->push_back(*_value);
+        metrics->push_back(7);
+    }
+
+private:
+    std::string _name;
+    std::uint64_t* _value;
+};
+
+// Test that samples added as metrics round trip as their documents
+TEST_F(FTDCCompressorTest, TestAddMetrics) {
+    FTDCConfig config;
+    FTDCCompressor c(&config);
+
+    std::uint64_t value = 0;
+    FTDCMetricsCollectorCollection collectors;
+    collectors.add(std::make_unique<FTDCMetricsCollectorMock>("a", &value));
+    collectors.add(std::make_unique<FTDCMetricsCollectorMock>("b", &value));
+    ASSERT_TRUE(collectors.select({"a"}));
+    ASSERT_FALSE(collectors.select({"a"}));
+
+    std::vector<BSONObj> docs;
+    std::vector<std::uint64_t> metrics;
+    int makeSampleCalls = 0;
+    auto addMetrics = [&] {
+        metrics.clear();
+        auto date = collectors.collect(getClient(), &metrics);
+        docs.push_back(collectors.makeDocument(metrics));
+        return c.addMetrics(metrics, date, [&] {
+            ++makeSampleCalls;
+            return docs.back();
+        });
+    };
+
+    // The first sample is the reference document, and is built from the metrics.
+    auto st = addMetrics();
+    ASSERT_HAS_SPACE(st);
+    ASSERT_EQUALS(makeSampleCalls, 1);
+
+    for (value = 1; value < 10; ++value) {
+        st = addMetrics();
+        ASSERT_HAS_SPACE(st);
+    }
+    ASSERT_EQUALS(makeSampleCalls, 1);
+
+    auto swBuf = c.getCompressedSamples();
+    ASSERT_OK(swBuf);
+
+    FTDCDecompressor decompressor;
+    auto swList = decompressor.uncompress(std::get<0>(swBuf.getValue()));
+    ASSERT_OK(swList);
+    ValidateDocumentList(swList.getValue(), docs, FTDCValidationMode::kStrict);
+
+    // Selecting more collectors changes the number of metrics, and so the schema.
+    ASSERT_TRUE(collectors.select({}));
+    st = addMetrics();
+    ASSERT_SCHEMA_CHANGED(st);
+    ASSERT_EQUALS(makeSampleCalls, 2);
+}
+
 }  // namespace mongo
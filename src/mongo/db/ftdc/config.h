@@ -30,6 +30,8 @@
 #pragma once
 
 #include <cstdint>
+#include <string>
+#include <vector>
 
 #include "mongo/util/time_support.h"
 
@@ -47,7 +49,8 @@ struct FTDCConfig {
           maxFileSizeBytes(kMaxFileSizeBytesDefault),
           period(kPeriodMillisDefault),
           maxSamplesPerArchiveMetricChunk(kMaxSamplesPerArchiveMetricChunkDefault),
-          maxSamplesPerInterimMetricChunk(kMaxSamplesPerInterimMetricChunkDefault) {}
+          maxSamplesPerInterimMetricChunk(kMaxSamplesPerInterimMetricChunkDefault),
+          highResolutionPeriod(kHighResolutionPeriodMillisDefault) {}
 
     /**
      * True if FTDC is collecting data. False otherwise
@@ -84,9 +87,23 @@ struct FTDCConfig {
      */
     std::uint32_t maxSamplesPerInterimMetricChunk;
 
+    /**
+     * Period at which to sample the high resolution metrics collectors. Zero disables them.
+     *
+     * High resolution samples are written to their own series of files, in a sub-directory of the
+     * FTDC directory, so that they do not change the schema of the periodic samples.
+     */
+    Milliseconds highResolutionPeriod;
+
+    /**
+     * Names of the high resolution metrics collectors to sample. Empty samples all of them.
+     */
+    std::vector<std::string> highResolutionCollectors;
+
     static const bool kEnabledDefault = true;
 
     static const std::int64_t kPeriodMillisDefault;
+    static const std::int64_t kHighResolutionPeriodMillisDefault = 0;
     static const std::uint64_t kMaxDirectorySizeBytesDefault = 200 * 1024 * 1024;
     static const std::uint64_t kMaxFileSizeBytesDefault = 10 * 1024 * 1024;
 
@@ -50,4 +50,6 @@ extern const char kFTDCCollectEndField[];
 
 constexpr StringData kFTDCDefaultDirectory = "diagnostic.data"_sd;
 
+constexpr StringData kFTDCHighResolutionDirectory = "highResolution"_sd;
+
 }  // namespace mongo
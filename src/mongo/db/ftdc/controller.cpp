@@ -37,6 +37,7 @@
 
 #include "mongo/db/client.h"
 #include "mongo/db/ftdc/collector.h"
+#include "mongo/db/ftdc/constants.h"
 #include "mongo/db/ftdc/util.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/logv2/log.h"
@@ -94,6 +95,19 @@ void FTDCController::setMaxSamplesPerInterimMetricChunk(size_t size) {
     _condvar.notify_one();
 }
 
+void FTDCController::setHighResolutionPeriod(Milliseconds millis) {
+    stdx::lock_guard<Latch> lock(_mutex);
+    _configTemp.highResolutionPeriod = millis;
+    _condvar.notify_one();
+}
+
+void FTDCController::setHighResolutionCollectors(std::vector<std::string> names) {
+    stdx::lock_guard<Latch> lock(_mutex);
+    _configTemp.highResolutionCollectors = std::move(names);
+    _highResolutionCollectorsChanged = true;
+    _condvar.notify_one();
+}
+
 Status FTDCController::setDirectory(const boost::filesystem::path& path) {
     stdx::lock_guard<Latch> lock(_mutex);
 
@@ -129,6 +143,16 @@ void FTDCController::addOnRotateCollector(std::unique_ptr<FTDCCollectorInterface
     }
 }
 
+void FTDCController::addHighResolutionCollector(
+    std::unique_ptr<FTDCMetricsCollectorInterface> collector) {
+    {
+        stdx::lock_guard<Latch> lock(_mutex);
+        invariant(_state == State::kNotStarted);
+
+        _highResolutionCollectors.add(std::move(collector));
+    }
+}
+
 BSONObj FTDCController::getMostRecentPeriodicDocument() {
     {
         stdx::lock_guard<Latch> lock(_mutex);
@@ -178,12 +202,14 @@ void FTDCController::stop() {
 
     _state = State::kDone;
 
-    if (_mgr) {
-        auto s = _mgr->close();
-        if (!s.isOK()) {
-            LOGV2(20627,
-                  "Failed to close full-time diagnostic data capture file manager",
-                  "error"_attr = s);
+    for (auto mgr : {_mgr.get(), _highResolutionMgr.get()}) {
+        if (mgr) {
+            auto s = mgr->close();
+            if (!s.isOK()) {
+                LOGV2(20627,
+                      "Failed to close full-time diagnostic data capture file manager",
+                      "error"_attr = s);
+            }
         }
     }
 }
@@ -208,13 +234,19 @@ void FTDCController::doLoop() noexcept {
         // Get next time to run at
         auto next_time = FTDCUtil::roundTime(now, _config.period);
 
+        // High resolution samples are taken on their own period, in between the periodic ones
+        auto next_high_resolution_time = _config.highResolutionPeriod > Milliseconds(0)
+            ? FTDCUtil::roundTime(now, _config.highResolutionPeriod)
+            : Date_t::max();
+
         // Wait for the next run or signal to shutdown
         {
             stdx::unique_lock<Latch> lock(_mutex);
             MONGO_IDLE_THREAD_BLOCK;
 
             // We ignore spurious wakeups by just doing an iteration of the loop
-            auto status = _condvar.wait_until(lock, next_time.toSystemTimePoint());
+            auto status = _condvar.wait_until(
+                lock, std::min(next_time, next_high_resolution_time).toSystemTimePoint());
 
             // Are we done running?
             if (_state == State::kStopRequested) {
@@ -228,6 +260,12 @@ void FTDCController::doLoop() noexcept {
             // GetFileSystemTime for now which has ~10 ms granularity.
             _config = _configTemp;
 
+            if (_highResolutionCollectorsChanged) {
+                _highResolutionCollectorsChanged = false;
+                _highResolutionSelectionChanged |=
+                    _highResolutionCollectors.select(_config.highResolutionCollectors);
+            }
+
             // if we hit a timeout on the condvar, we need to do another collection
             // if we were signalled, then we have a config update only or were asked to stop
             if (status == stdx::cv_status::no_timeout) {
@@ -237,7 +275,16 @@ void FTDCController::doLoop() noexcept {
 
         // TODO: consider only running this thread if we are enabled
         // for now, we just keep an idle thread as it is simpler
-        if (_config.enabled) {
+        if (!_config.enabled) {
+            continue;
+        }
+
+        // Run the collections whose time we waited for
+        if (next_high_resolution_time <= next_time) {
+            collectHighResolutionSample(client);
+        }
+
+        if (next_time <= next_high_resolution_time) {
             // Delay initialization of FTDCFileManager until we are sure the user has enabled
             // FTDC
             if (!_mgr) {
@@ -262,4 +309,37 @@ void FTDCController::doLoop() noexcept {
     }
 }
 
+void FTDCController::collectHighResolutionSample(Client* client) {
+    // A new selection of collectors changes the names of the metrics, possibly without changing
+    // their number, so its samples start a new file.
+    if (_highResolutionSelectionChanged) {
+        _highResolutionSelectionChanged = false;
+        if (_highResolutionMgr) {
+            uassertStatusOK(_highResolutionMgr->close());
+            _highResolutionMgr.reset();
+        }
+    }
+
+    if (_highResolutionCollectors.empty()) {
+        return;
+    }
+
+    if (!_highResolutionMgr) {
+        auto swMgr = FTDCFileManager::create(&_config,
+                                             _path / kFTDCHighResolutionDirectory.toString(),
+                                             &_rotateCollectors,
+                                             client);
+
+        _highResolutionMgr = uassertStatusOK(std::move(swMgr));
+    }
+
+    _highResolutionMetrics.clear();
+    auto start = _highResolutionCollectors.collect(client, &_highResolutionMetrics);
+
+    uassertStatusOK(_highResolutionMgr->writeMetricsAndRotateIfNeeded(
+        client, _highResolutionMetrics, start, [&] {
+            return _highResolutionCollectors.makeDocument(_highResolutionMetrics);
+        }));
+}
+
 }  // namespace mongo
@@ -99,6 +99,16 @@ public:
      */
     void setMaxSamplesPerInterimMetricChunk(size_t size);
 
+    /**
+     * Set the period for high resolution data collection. Zero disables it.
+     */
+    void setHighResolutionPeriod(Milliseconds millis);
+
+    /**
+     * Set the names of the high resolution collectors to sample. Empty samples all of them.
+     */
+    void setHighResolutionCollectors(std::vector<std::string> names);
+
     /*
      * Set the path to store FTDC files if not already set.
      *
@@ -118,6 +128,11 @@ public:
      */
     void addOnRotateCollector(std::unique_ptr<FTDCCollectorInterface> collector);
 
+    /**
+     * Add a numeric metrics collector to collect on the high resolution period. i.e. opcounters
+     */
+    void addHighResolutionCollector(std::unique_ptr<FTDCMetricsCollectorInterface> collector);
+
     /**
      * Start the controller.
      *
@@ -148,6 +163,11 @@ private:
      */
     void doLoop() noexcept;
 
+    /**
+     * Collect a sample from the high resolution collectors, and write it to its own files.
+     */
+    void collectHighResolutionSample(Client* client);
+
 private:
     /**
      * Private enum to track state.
@@ -210,6 +230,21 @@ private:
     // File manager that manages file rotation, and logging
     std::unique_ptr<FTDCFileManager> _mgr;
 
+    // Set of high resolution collectors
+    FTDCMetricsCollectorCollection _highResolutionCollectors;
+
+    // Set by setHighResolutionCollectors until the background thread selects the collectors
+    bool _highResolutionCollectorsChanged{true};
+
+    // Set by the background thread when the high resolution samples must start a new file
+    bool _highResolutionSelectionChanged{false};
+
+    // Buffer for the metrics of a high resolution sample
+    std::vector<std::uint64_t> _highResolutionMetrics;
+
+    // File manager for the high resolution samples
+    std::unique_ptr<FTDCFileManager> _highResolutionMgr;
+
     // Background collection and writing thread
     stdx::thread _thread;
 };
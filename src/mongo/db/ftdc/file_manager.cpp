@@ -339,6 +339,23 @@ Status FTDCFileManager::writeSampleAndRotateIfNeeded(Client* client,
     return Status::OK();
 }
 
+Status FTDCFileManager::writeMetricsAndRotateIfNeeded(Client* client,
+                                                      const std::vector<std::uint64_t>& metrics,
+                                                      Date_t date,
+                                                      const std::function<BSONObj()>& makeSample) {
+    Status s = _writer.writeMetrics(metrics, date, makeSample);
+
+    if (!s.isOK()) {
+        return s;
+    }
+
+    if (_writer.getSize() > _config->maxFileSizeBytes) {
+        return rotate(client);
+    }
+
+    return Status::OK();
+}
+
 Status FTDCFileManager::close() {
     return _writer.close();
 }
@@ -85,6 +85,16 @@ public:
      */
     Status writeSampleAndRotateIfNeeded(Client* client, const BSONObj& sample, Date_t date);
 
+    /**
+     * Writes a sample given as its metrics to disk via FTDCFileWriter.
+     *
+     * Rotates files as needed.
+     */
+    Status writeMetricsAndRotateIfNeeded(Client* client,
+                                         const std::vector<std::uint64_t>& metrics,
+                                         Date_t date,
+                                         const std::function<BSONObj()>& makeSample);
+
     /**
      * Closes the current file manager down.
      */
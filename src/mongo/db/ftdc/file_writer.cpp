@@ -150,8 +150,19 @@ Status FTDCFileWriter::writeMetadata(const BSONObj& metadata, Date_t date) {
 }
 
 Status FTDCFileWriter::writeSample(const BSONObj& sample, Date_t date) {
-    auto ret = _compressor.addSample(sample, date);
+    return processAddedSample(_compressor.addSample(sample, date));
+}
+
+Status FTDCFileWriter::writeMetrics(const std::vector<std::uint64_t>& metrics,
+                                    Date_t date,
+                                    const std::function<BSONObj()>& makeSample) {
+    return processAddedSample(_compressor.addMetrics(metrics, date, makeSample));
+}
 
+Status FTDCFileWriter::processAddedSample(
+    const StatusWith<
+        boost::optional<std::tuple<ConstDataRange, FTDCCompressor::CompressorState, Date_t>>>&
+        ret) {
     if (!ret.isOK()) {
         return ret.getStatus();
     }
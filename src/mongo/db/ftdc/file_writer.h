@@ -81,6 +81,14 @@ public:
      */
     Status writeSample(const BSONObj& sample, Date_t date);
 
+    /**
+     * Write a sample given as its metrics to interim and/or archive log as needed. See
+     * FTDCCompressor::addMetrics.
+     */
+    Status writeMetrics(const std::vector<std::uint64_t>& metrics,
+                        Date_t date,
+                        const std::function<BSONObj()>& makeSample);
+
     /**
      * Close all the files and shutdown cleanly by zeroing the beginning of the interim file.
      */
@@ -102,6 +110,15 @@ public:
     void closeWithoutFlushForTest();
 
 private:
+    /**
+     * Flush the chunk the compressor returned when a sample was added, or write the samples so far
+     * to the interim file if it is time to.
+     */
+    Status processAddedSample(
+        const StatusWith<
+            boost::optional<std::tuple<ConstDataRange, FTDCCompressor::CompressorState, Date_t>>>&
+            ret);
+
     /**
      * Flush all changes to disk.
      */
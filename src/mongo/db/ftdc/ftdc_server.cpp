@@ -46,6 +46,10 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/mirror_maestro.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/stats/counters.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/transport/service_entry_point.h"
+#include "mongo/util/str.h"
 #include "mongo/util/synchronized_value.h"
 
 namespace mongo {
@@ -68,6 +72,12 @@ FTDCController* getGlobalFTDCController() {
  */
 synchronized_value<boost::filesystem::path> ftdcDirectoryPathParameter;
 
+std::vector<std::string> parseHighResolutionCollectors(const std::string& value) {
+    std::vector<std::string> names;
+    str::splitStringDelim(value, &names, ',');
+    return names;
+}
+
 }  // namespace
 
 FTDCStartupParams ftdcStartupParams;
@@ -170,6 +180,24 @@ Status onUpdateFTDCPerInterimUpdate(const std::int32_t potentialNewValue) {
     return Status::OK();
 }
 
+Status onUpdateFTDCHighResolutionPeriod(const std::int32_t potentialNewValue) {
+    auto controller = getGlobalFTDCController();
+    if (controller) {
+        controller->setHighResolutionPeriod(Milliseconds(potentialNewValue));
+    }
+
+    return Status::OK();
+}
+
+Status onUpdateFTDCHighResolutionCollectors(const std::string& value) {
+    auto controller = getGlobalFTDCController();
+    if (controller) {
+        controller->setHighResolutionCollectors(parseHighResolutionCollectors(value));
+    }
+
+    return Status::OK();
+}
+
 FTDCSimpleInternalCommandCollector::FTDCSimpleInternalCommandCollector(StringData command,
                                                                        StringData name,
                                                                        StringData ns,
@@ -235,6 +263,12 @@ public:
             commandBuilder.append("tcmalloc", 2);
         }
 
+        // "latchAnalysis" is only collected while latch timings are being sampled, since it has a
+        // field per latch.
+        if (latch_detail::gLatchAnalysisSampleInterval.loadRelaxed() > 0) {
+            commandBuilder.append("latchAnalysis", true);
+        }
+
         commandBuilder.done();
 
         auto request = OpMsgRequest::fromDBAndBody("", commandBuilder.obj());
@@ -247,6 +281,58 @@ public:
     }
 };
 
+/**
+ * A high resolution FTDC collector for a set of operation counters, which reads them directly
+ * instead of through serverStatus.
+ */
+class FTDCOpCountersMetricsCollector final : public FTDCMetricsCollectorInterface {
+public:
+    FTDCOpCountersMetricsCollector(StringData name, const OpCounters* counters)
+        : _name(name.toString()), _counters(counters) {}
+
+    std::string name() const final {
+        return _name;
+    }
+
+    std::vector<std::string> metricNames() const final {
+        return {"insert", "query", "update", "delete", "getmore", "command"};
+    }
+
+    void collect(std::vector<std::uint64_t>* metrics) final {
+        for (auto counter : {_counters->getInsert(),
+                             _counters->getQuery(),
+                             _counters->getUpdate(),
+                             _counters->getDelete(),
+                             _counters->getGetMore(),
+                             _counters->getCommand()}) {
+            metrics->push_back(counter->loadRelaxed());
+        }
+    }
+
+private:
+    const std::string _name;
+    const OpCounters* const _counters;
+};
+
+/**
+ * A high resolution FTDC collector for the number of open client connections.
+ */
+class FTDCConnectionsMetricsCollector final : public FTDCMetricsCollectorInterface {
+public:
+    std::string name() const final {
+        return "connections";
+    }
+
+    std::vector<std::string> metricNames() const final {
+        return {"current"};
+    }
+
+    void collect(std::vector<std::uint64_t>* metrics) final {
+        auto sep = getGlobalServiceContext()->getServiceEntryPoint();
+        metrics->push_back(sep ? sep->numOpenSessions() : 0);
+    }
+};
+
 // Register the FTDC system
 // Note: This must be run before the server parameters are parsed during startup
 // so that the FTDCController is initialized.
@@ -267,6 +353,9 @@ void startFTDC(boost::filesystem::path& path,
         ftdcStartupParams.maxSamplesPerArchiveMetricChunk.load();
     config.maxSamplesPerInterimMetricChunk =
         ftdcStartupParams.maxSamplesPerInterimMetricChunk.load();
+    config.highResolutionPeriod = Milliseconds(ftdcStartupParams.highResolutionPeriodMillis.load());
+    config.highResolutionCollectors =
+        parseHighResolutionCollectors(gDiagnosticDataCollectionHighResolutionCollectors.get());
 
     ftdcDirectoryPathParameter = path;
 
@@ -283,6 +372,14 @@ void startFTDC(boost::filesystem::path& path,
     // Install System Metric Collector as a periodic collector
     installSystemMetricsCollector(controller.get());
 
+    // Install high resolution collectors
+    // These are collected on the high resolution period in FTDCConfig, if it is set.
+    controller->addHighResolutionCollector(
+        std::make_unique<FTDCOpCountersMetricsCollector>("opcounters", &globalOpCounters));
+    controller->addHighResolutionCollector(
+        std::make_unique<FTDCOpCountersMetricsCollector>("opcountersRepl", &replOpCounters));
+    controller->addHighResolutionCollector(std::make_unique<FTDCConnectionsMetricsCollector>());
+
     // Install file rotation collectors
     // These are collected on each file rotation.
 
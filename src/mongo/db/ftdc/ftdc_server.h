@@ -111,6 +111,7 @@ struct FTDCStartupParams {
     AtomicWord<int> maxFileSizeMB;
     AtomicWord<int> maxSamplesPerArchiveMetricChunk;
     AtomicWord<int> maxSamplesPerInterimMetricChunk;
+    AtomicWord<int> highResolutionPeriodMillis;
 
     FTDCStartupParams()
         : enabled(FTDCConfig::kEnabledDefault),
@@ -119,7 +120,8 @@ struct FTDCStartupParams {
           maxDirectorySizeMB(FTDCConfig::kMaxDirectorySizeBytesDefault / (1024 * 1024)),
           maxFileSizeMB(FTDCConfig::kMaxFileSizeBytesDefault / (1024 * 1024)),
           maxSamplesPerArchiveMetricChunk(FTDCConfig::kMaxSamplesPerArchiveMetricChunkDefault),
-          maxSamplesPerInterimMetricChunk(FTDCConfig::kMaxSamplesPerInterimMetricChunkDefault) {}
+          maxSamplesPerInterimMetricChunk(FTDCConfig::kMaxSamplesPerInterimMetricChunkDefault),
+          highResolutionPeriodMillis(FTDCConfig::kHighResolutionPeriodMillisDefault) {}
 };
 
 extern FTDCStartupParams ftdcStartupParams;
@@ -133,6 +135,8 @@ Status onUpdateFTDCDirectorySize(const std::int32_t value);
 Status onUpdateFTDCFileSize(const std::int32_t value);
 Status onUpdateFTDCSamplesPerChunk(const std::int32_t value);
 Status onUpdateFTDCPerInterimUpdate(const std::int32_t value);
+Status onUpdateFTDCHighResolutionPeriod(const std::int32_t value);
+Status onUpdateFTDCHighResolutionCollectors(const std::string& value);
 
 /**
  * Server Parameter accessors
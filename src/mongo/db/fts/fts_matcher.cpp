@@ -29,6 +29,8 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
+
 #include "mongo/db/fts/fts_element_iterator.h"
 #include "mongo/db/fts/fts_matcher.h"
 #include "mongo/db/fts/fts_phrase_matcher.h"
@@ -122,41 +124,49 @@ bool FTSMatcher::_hasNegativeTerm_string(const FTSLanguage* language, const stri
 }
 
 bool FTSMatcher::positivePhrasesMatch(const BSONObj& obj) const {
-    for (size_t i = 0; i < _query.getPositivePhr().size(); i++) {
-        if (!_phraseMatch(_query.getPositivePhr()[i], obj)) {
-            return false;
-        }
+    if (_query.getPositivePhr().empty()) {
+        return true;
     }
 
-    return true;
+    return _phrasesMatch(_query.getPositivePhr(), obj, true);
 }
 
 bool FTSMatcher::negativePhrasesMatch(const BSONObj& obj) const {
-    for (size_t i = 0; i < _query.getNegatedPhr().size(); i++) {
-        if (_phraseMatch(_query.getNegatedPhr()[i], obj)) {
-            return false;
-        }
+    if (_query.getNegatedPhr().empty()) {
+        return true;
     }
 
-    return true;
+    return !_phrasesMatch(_query.getNegatedPhr(), obj, false);
 }
 
-bool FTSMatcher::_phraseMatch(const string& phrase, const BSONObj& obj) const {
+bool FTSMatcher::_phrasesMatch(const std::vector<string>& phrases,
+                               const BSONObj& obj,
+                               bool matchAll) const {
+    FTSPhraseMatcher::Options matcherOptions = FTSPhraseMatcher::kNone;
+
+    if (_query.getCaseSensitive()) {
+        matcherOptions |= FTSPhraseMatcher::kCaseSensitive;
+    }
+    if (_query.getDiacriticSensitive()) {
+        matcherOptions |= FTSPhraseMatcher::kDiacriticSensitive;
+    }
+
+    std::vector<bool> matched(phrases.size(), false);
     FTSElementIterator it(_spec, obj);
 
     while (it.more()) {
         FTSIteratorValue val = it.next();
 
-        FTSPhraseMatcher::Options matcherOptions = FTSPhraseMatcher::kNone;
-
-        if (_query.getCaseSensitive()) {
-            matcherOptions |= FTSPhraseMatcher::kCaseSensitive;
-        }
-        if (_query.getDiacriticSensitive()) {
-            matcherOptions |= FTSPhraseMatcher::kDiacriticSensitive;
-        }
+        // Build the haystack once per field so that the phrase matcher can prepare it (e.g. case
+        // fold it) once for all of the phrases.
+        const string text(val._text);
+        val._language->getPhraseMatcher().phrasesMatch(phrases, text, matcherOptions, &matched);
 
-        if (val._language->getPhraseMatcher().phraseMatches(phrase, val._text, matcherOptions)) {
+        if (matchAll) {
+            if (std::find(matched.begin(), matched.end(), false) == matched.end()) {
+                return true;
+            }
+        } else if (std::find(matched.begin(), matched.end(), true) != matched.end()) {
             return true;
         }
     }
@@ -106,9 +106,13 @@ private:
     bool _hasNegativeTerm_string(const FTSLanguage* language, const std::string& raw) const;
 
     /**
-     * Returns whether 'obj' contains the exact string 'phrase' in any indexed fields.
+     * If 'matchAll' is true, returns whether 'obj' contains every exact string in 'phrases' in its
+     * indexed fields. Otherwise, returns whether 'obj' contains any of them. The indexed fields are
+     * walked once for all of the phrases, and the walk stops as soon as the result is known.
      */
-    bool _phraseMatch(const std::string& phrase, const BSONObj& obj) const;
+    bool _phrasesMatch(const std::vector<std::string>& phrases,
+                       const BSONObj& obj,
+                       bool matchAll) const;
 
     /**
      * Helper method that returns the tokenizer options that this matcher should use, based on the
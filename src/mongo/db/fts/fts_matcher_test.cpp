@@ -111,6 +111,38 @@ TEST(FTSMatcher, Phrase2) {
     ASSERT(m.positivePhrasesMatch(BSON("x" << BSON_ARRAY("table top"))));
 }
 
+// Test that positive phrases may be found in different indexed fields, and that any negative
+// phrase in any indexed field rejects the document.
+TEST(FTSMatcher, PhrasesAcrossFields) {
+    FTSQueryImpl q;
+    q.setQuery("foo \"table top\" \"chair leg\" -\"sofa arm\"");
+    q.setLanguage("english");
+    q.setCaseSensitive(false);
+    q.setDiacriticSensitive(false);
+    ASSERT(q.parse(TEXT_INDEX_VERSION_3).isOK());
+    FTSMatcher m(q,
+                 FTSSpec(assertGet(FTSSpec::fixSpec(BSON("key" << BSON("x"
+                                                                       << "text"
+                                                                       << "y"
+                                                                       << "text"))))));
+    ASSERT(m.positivePhrasesMatch(BSON("x" << BSON_ARRAY("Table top"
+                                                         << "foo")
+                                           << "y"
+                                           << "a chair leg")));
+    ASSERT(!m.positivePhrasesMatch(BSON("x"
+                                        << "table top"
+                                        << "y"
+                                        << "chair")));
+    ASSERT(m.negativePhrasesMatch(BSON("x"
+                                       << "table top"
+                                       << "y"
+                                       << "chair leg")));
+    ASSERT(!m.negativePhrasesMatch(BSON("x"
+                                        << "table top"
+                                        << "y" << BSON_ARRAY("chair leg"
+                                                             << "SOFA ARM"))));
+}
+
 // Test that the matcher parses the document with the document language, not the search
 // language.
 TEST(FTSMatcher, ParsesUsingDocLanguage) {
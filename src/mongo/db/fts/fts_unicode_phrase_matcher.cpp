@@ -45,20 +45,35 @@ UnicodeFTSPhraseMatcher::UnicodeFTSPhraseMatcher(const string& language) {
     }
 }
 
-bool UnicodeFTSPhraseMatcher::phraseMatches(const string& phrase,
-                                            const string& haystack,
-                                            Options options) const {
+namespace {
+unicode::String::SubstrMatchOptions toSubstrMatchOptions(FTSPhraseMatcher::Options options) {
     unicode::String::SubstrMatchOptions matchOptions = unicode::String::kNone;
 
-    if (options & kCaseSensitive) {
+    if (options & FTSPhraseMatcher::kCaseSensitive) {
         matchOptions |= unicode::String::kCaseSensitive;
     }
 
-    if (options & kDiacriticSensitive) {
+    if (options & FTSPhraseMatcher::kDiacriticSensitive) {
         matchOptions |= unicode::String::kDiacriticSensitive;
     }
 
-    return unicode::String::substrMatch(haystack, phrase, matchOptions, _caseFoldMode);
+    return matchOptions;
+}
+}  // namespace
+
+bool UnicodeFTSPhraseMatcher::phraseMatches(const string& phrase,
+                                            const string& haystack,
+                                            Options options) const {
+    return unicode::String::substrMatch(
+        haystack, phrase, toSubstrMatchOptions(options), _caseFoldMode);
+}
+
+void UnicodeFTSPhraseMatcher::phrasesMatch(const std::vector<string>& phrases,
+                                           const string& haystack,
+                                           Options options,
+                                           std::vector<bool>* matched) const {
+    unicode::String::substrMatches(
+        haystack, phrases, toSubstrMatchOptions(options), _caseFoldMode, matched);
 }
 
 }  // namespace fts
@@ -133,6 +133,29 @@ TEST(FtsUnicodePhraseMatcher, CaseAndDiacriticInsensitiveTurkish) {
     ASSERT_FALSE(phraseMatcher.phraseMatches(nofind2, str, options));
 }
 
+// Matching several phrases at once agrees with matching them one by one, and skips the phrases
+// that are already known to match.
+TEST(FtsUnicodePhraseMatcher, PhrasesMatchMultiplePhrases) {
+    std::string str = "Pijamalı hasta yağız şoföre çabucak güvendi.";
+    std::vector<std::string> phrases = {
+        "PİJAMALI hasta", "YAGIZ sofore", "çabucak GÜVENDI", "yagiz sofore"};
+
+    UnicodeFTSPhraseMatcher phraseMatcher("turkish");
+    FTSPhraseMatcher::Options options = FTSPhraseMatcher::kNone;
+
+    std::vector<bool> matched(phrases.size(), false);
+    phraseMatcher.phrasesMatch(phrases, str, options, &matched);
+    for (size_t i = 0; i < phrases.size(); ++i) {
+        ASSERT_EQ(phraseMatcher.phraseMatches(phrases[i], str, options), matched[i]);
+    }
+
+    std::vector<bool> alreadyMatched = {false, false, true, false};
+    phraseMatcher.phrasesMatch(phrases, "unrelated", options, &alreadyMatched);
+    ASSERT_FALSE(alreadyMatched[0]);
+    ASSERT_FALSE(alreadyMatched[1]);
+    ASSERT(alreadyMatched[2]);
+    ASSERT_FALSE(alreadyMatched[3]);
+}
 
 }  // namespace fts
 }  // namespace mongo
@@ -28,15 +28,37 @@
  */
 
 #include <cstdlib>
+#include <memory>
 
 #include "mongo/db/fts/stemmer.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/lru_cache.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
 
 namespace fts {
 
-Stemmer::Stemmer(const FTSLanguage* language) {
+namespace {
+
+// The maximum number of stemmed words cached per thread and language.
+constexpr size_t kStemCacheSize = 4096;
+
+using StemCache = LRUCache<std::string, std::string>;
+
+StemCache& getStemCache(const FTSLanguage* language) {
+    thread_local stdx::unordered_map<const FTSLanguage*, std::unique_ptr<StemCache>> caches;
+
+    auto& cache = caches[language];
+    if (!cache) {
+        cache = std::make_unique<StemCache>(kStemCacheSize);
+    }
+    return *cache;
+}
+
+}  // namespace
+
+Stemmer::Stemmer(const FTSLanguage* language) : _language(language) {
     _stemmer = nullptr;
     if (language->str() != "none")
         _stemmer = sb_stemmer_new(language->str().c_str(), "UTF_8");
@@ -53,6 +75,15 @@ StringData Stemmer::stem(StringData word) const {
     if (!_stemmer)
         return word;
 
+    auto& cache = getStemCache(_language);
+    std::string key = word.toString();
+
+    auto it = cache.find(key);
+    if (it != cache.end()) {
+        _cachedStem = it->second;
+        return _cachedStem;
+    }
+
     const sb_symbol* sb_sym =
         sb_stemmer_stem(_stemmer, (const sb_symbol*)word.rawData(), word.size());
 
@@ -61,7 +92,9 @@ StringData Stemmer::stem(StringData word) const {
         MONGO_UNREACHABLE;
     }
 
-    return StringData((const char*)(sb_sym), sb_stemmer_length(_stemmer));
+    StringData stemmed((const char*)(sb_sym), sb_stemmer_length(_stemmer));
+    cache.add(std::move(key), stemmed.toString());
+    return stemmed;
 }
 }  // namespace fts
 }  // namespace mongo
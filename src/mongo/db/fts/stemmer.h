@@ -30,6 +30,8 @@
 
 #pragma once
 
+#include <string>
+
 #include "mongo/base/string_data.h"
 #include "mongo/db/fts/fts_language.h"
 #include "third_party/libstemmer_c/include/libstemmer.h"
@@ -57,11 +59,19 @@ public:
      * The returned StringData is valid until the next call to any method on this object. Since the
      * input may be returned unmodified, the output's lifetime may also expire when the input's
      * does.
+     *
+     * Stemmed words are kept in a per-thread cache for each language, so that repeated words do not
+     * go through the Snowball stemmer again.
      */
     StringData stem(StringData word) const;
 
 private:
+    const FTSLanguage* _language;
     struct sb_stemmer* _stemmer;
+
+    // Holds the last stem returned from the per-thread cache, since the cached entry may be
+    // evicted by another Stemmer on this thread before the caller is done with it.
+    mutable std::string _cachedStem;
 };
 }  // namespace fts
 }  // namespace mongo
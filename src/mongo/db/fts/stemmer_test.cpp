@@ -56,5 +56,22 @@ TEST(English, Caps) {
     ASSERT_EQUALS("unit", s.stem("united"));
     ASSERT_EQUALS("Unite", s.stem("United"));
 }
+
+TEST(English, CachedStems) {
+    Stemmer s1(languageEnglishV2());
+    Stemmer s2(languageEnglishV2());
+    ASSERT_EQUALS("run", s1.stem("running"));
+
+    // The second stemmer is served from the per-thread cache, and its result stays valid after the
+    // first stemmer is used again.
+    StringData stemmed = s2.stem("running");
+    ASSERT_EQUALS("walk", s1.stem("walking"));
+    ASSERT_EQUALS("run", stemmed);
+    ASSERT_EQUALS("walk", s2.stem("walking"));
+
+    // Each language has its own cache.
+    Stemmer porter(languagePorterV1());
+    ASSERT_EQUALS("unit", porter.stem("united"));
+}
 }  // namespace fts
 }  // namespace mongo
@@ -260,6 +260,20 @@ StringData String::caseFoldAndStripDiacritics(StackBufBuilder* buffer,
     return {buffer->buf(), size_t(buffer->len())};
 }
 
+namespace {
+// Case sensitive and diacritic sensitive.
+bool containsSubstr(StringData haystack, StringData needle) {
+#if BOOST_VERSION < 106200
+    return boost::algorithm::boyer_moore_search(
+               haystack.begin(), haystack.end(), needle.begin(), needle.end()) != haystack.end();
+#else
+    return boost::algorithm::boyer_moore_search(
+               haystack.begin(), haystack.end(), needle.begin(), needle.end()) !=
+        std::make_pair(haystack.end(), haystack.end());
+#endif
+}
+}  // namespace
+
 bool String::substrMatch(const std::string& str,
                          const std::string& find,
                          SubstrMatchOptions options,
@@ -274,15 +288,33 @@ bool String::substrMatch(const std::string& str,
     auto haystack = caseFoldAndStripDiacritics(&haystackBuf, str, options, cfMode);
     auto needle = caseFoldAndStripDiacritics(&needleBuf, find, options, cfMode);
 
-// Case sensitive and diacritic sensitive.
-#if BOOST_VERSION < 106200
-    return boost::algorithm::boyer_moore_search(
-               haystack.begin(), haystack.end(), needle.begin(), needle.end()) != haystack.end();
-#else
-    return boost::algorithm::boyer_moore_search(
-               haystack.begin(), haystack.end(), needle.begin(), needle.end()) !=
-        std::make_pair(haystack.end(), haystack.end());
-#endif
+    return containsSubstr(haystack, needle);
+}
+
+void String::substrMatches(const std::string& str,
+                           const std::vector<std::string>& finds,
+                           SubstrMatchOptions options,
+                           CaseFoldMode cfMode,
+                           std::vector<bool>* found) {
+    invariant(found->size() == finds.size());
+
+    if (cfMode == CaseFoldMode::kTurkish) {
+        // Turkish comparisons are always case insensitive due to their handling of I/i.
+        options &= ~kCaseSensitive;
+    }
+
+    StackBufBuilder haystackBuf;
+    auto haystack = caseFoldAndStripDiacritics(&haystackBuf, str, options, cfMode);
+
+    for (size_t i = 0; i < finds.size(); ++i) {
+        if ((*found)[i]) {
+            continue;
+        }
+
+        StackBufBuilder needleBuf;
+        auto needle = caseFoldAndStripDiacritics(&needleBuf, finds[i], options, cfMode);
+        (*found)[i] = containsSubstr(haystack, needle);
+    }
 }
 
 }  // namespace unicode
@@ -32,6 +32,7 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "mongo/base/string_data.h"
 #include "mongo/bson/util/builder.h"
@@ -126,6 +127,17 @@ public:
                             SubstrMatchOptions options,
                             CaseFoldMode mode = CaseFoldMode::kNormal);
 
+    /**
+     * Like substrMatch(), but searches 'str' for each of 'finds' and case folds 'str' only once.
+     * Sets '(*found)[i]' to true if 'finds[i]' exists in 'str'. The strings whose entry in 'found'
+     * is already true are not searched for again.
+     */
+    static void substrMatches(const std::string& str,
+                              const std::vector<std::string>& finds,
+                              SubstrMatchOptions options,
+                              CaseFoldMode mode,
+                              std::vector<bool>* found);
+
     /**
      * Strips diacritics and case-folds the utf8 input string, as needed to support options.
      *
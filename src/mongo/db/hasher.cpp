@@ -34,7 +34,10 @@
 #include "mongo/db/hasher.h"
 
 
+#include <third_party/murmurhash3/MurmurHash3.h>
+
 #include "mongo/db/jsobj.h"
+#include "mongo/util/assert_util.h"
 #include "mongo/util/md5.hpp"
 
 namespace mongo {
@@ -45,6 +48,7 @@ namespace {
 
 typedef unsigned char HashDigest[16];
 
+// Computes the MD5 digest of the input.
 class Hasher {
     Hasher(const Hasher&) = delete;
     Hasher& operator=(const Hasher&) = delete;
@@ -99,7 +103,46 @@ void Hasher::finish(HashDigest out) {
     md5_finish(&_md5State, out);
 }
 
-void recursiveHash(Hasher* h, const BSONElement& e, bool includeFieldName) {
+// Buffers the same input as Hasher, and computes its 128-bit MurmurHash3 on finish(). MurmurHash3
+// cannot be computed incrementally, but the input of a single value is small.
+class MurmurHasher {
+    MurmurHasher(const MurmurHasher&) = delete;
+    MurmurHasher& operator=(const MurmurHasher&) = delete;
+
+public:
+    explicit MurmurHasher(HashSeed seed) : _seed(seed) {
+        addSeed(seed);
+    }
+
+    void addData(const void* keyData, size_t numBytes) {
+        _input.appendBuf(keyData, numBytes);
+    }
+
+    void addSeed(int32_t number) {
+        addIntegerData(number);
+    }
+
+    void addNumber(int64_t number) {
+        addIntegerData(number);
+    }
+
+    void finish(HashDigest out) {
+        MurmurHash3_x64_128(_input.buf(), _input.len(), static_cast<uint32_t>(_seed), out);
+    }
+
+private:
+    template <typename T>
+    void addIntegerData(T number) {
+        const auto data = endian::nativeToLittle(number);
+        addData(&data, sizeof(data));
+    }
+
+    StackBufBuilder _input;
+    HashSeed _seed;
+};
+
+template <typename H>
+void recursiveHash(H* h, const BSONElement& e, bool includeFieldName) {
     int canonicalType = endian::nativeToLittle(e.canonicalType());
     h->addData(&canonicalType, sizeof(canonicalType));
 
@@ -136,10 +179,9 @@ void recursiveHash(Hasher* h, const BSONElement& e, bool includeFieldName) {
     }
 }
 
-}  // namespace
-
-long long int BSONElementHasher::hash64(const BSONElement& e, HashSeed seed) {
-    Hasher h(seed);
+template <typename H>
+long long int computeHash64(const BSONElement& e, HashSeed seed) {
+    H h(seed);
     recursiveHash(&h, e, false);
     HashDigest d;
     h.finish(d);
@@ -148,4 +190,20 @@ long long int BSONElementHasher::hash64(const BSONElement& e, HashSeed seed) {
     return digestView.read<LittleEndian<long long int>>();
 }
 
+}  // namespace
+
+long long int BSONElementHasher::hash64(const BSONElement& e, HashSeed seed) {
+    return computeHash64<Hasher>(e, seed);
+}
+
+long long int BSONElementHasher::hash64(const BSONElement& e, HashSeed seed, int hashVersion) {
+    switch (hashVersion) {
+        case kMD5HashVersion:
+            return computeHash64<Hasher>(e, seed);
+        case kMurmurHashVersion:
+            return computeHash64<MurmurHasher>(e, seed);
+    }
+    MONGO_UNREACHABLE;
+}
+
 }  // namespace mongo
@@ -54,6 +54,21 @@ public:
      */
     static constexpr HashSeed const DEFAULT_HASH_SEED = 0;
 
+    /* Versions of the hash function, which hashed indexes record in their 'hashVersion' field.
+     * Version 0 hashes with MD5 and is the only one which hashed shard keys use. Version 1 hashes
+     * the same input with 64 bits of the 128-bit MurmurHash3, which is much cheaper to compute.
+     *
+     * WARNING: do not change the hash function of an existing version. Indexes store the hashes
+     * which it computes.
+     */
+    static constexpr int kMD5HashVersion = 0;
+    static constexpr int kMurmurHashVersion = 1;
+    static constexpr int kDefaultHashVersion = kMD5HashVersion;
+
+    static bool isValidHashVersion(int hashVersion) {
+        return hashVersion == kMD5HashVersion || hashVersion == kMurmurHashVersion;
+    }
+
     /* This computes a 64-bit hash of the value part of BSONElement "e",
      * preceded by the seed "seed".  Squashes element (and any sub-elements)
      * of the same canonical type, so hash({a:{b:4}}) will be the same
@@ -68,6 +83,10 @@ public:
      */
     static long long int hash64(const BSONElement& e, HashSeed seed);
 
+    /* Same as above, with the hash function of 'hashVersion', which must be valid.
+     */
+    static long long int hash64(const BSONElement& e, HashSeed seed, int hashVersion);
+
 private:
     BSONElementHasher();
 };
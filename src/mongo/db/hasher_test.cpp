@@ -371,5 +371,39 @@ TEST(BSONElementHasher, HashWithNonZeroSeed) {
     ASSERT_EQUALS(hashIt(o, seed), -9222615859251096151LL);
 }
 
+long long murmurHashIt(const BSONObj& object, HashSeed seed = 0) {
+    return BSONElementHasher::hash64(
+        object.firstElement(), seed, BSONElementHasher::kMurmurHashVersion);
+}
+
+TEST(BSONElementHasher, MD5HashVersionIsTheDefault) {
+    BSONObj o = BSON("check" << 42);
+    ASSERT_EQUALS(hashIt(o),
+                  BSONElementHasher::hash64(
+                      o.firstElement(), 0, BSONElementHasher::kMD5HashVersion));
+    ASSERT_EQUALS(hashIt(o, 40513),
+                  BSONElementHasher::hash64(
+                      o.firstElement(), 40513, BSONElementHasher::kMD5HashVersion));
+}
+
+TEST(BSONElementHasher, MurmurHashVersionDiffersFromMD5) {
+    BSONObj o = BSON("check" << 42);
+    ASSERT_NOT_EQUALS(hashIt(o), murmurHashIt(o));
+    ASSERT_NOT_EQUALS(murmurHashIt(o), murmurHashIt(o, 40513));
+    ASSERT_NOT_EQUALS(murmurHashIt(o), murmurHashIt(BSON("check" << 43)));
+}
+
+TEST(BSONElementHasher, MurmurHashVersionSquashesNumericTypes) {
+    long long intHash = murmurHashIt(BSON("check" << 42));
+    ASSERT_EQUALS(intHash, murmurHashIt(BSON("check" << 42LL)));
+    ASSERT_EQUALS(intHash, murmurHashIt(BSON("check" << 42.1)));
+
+    long long objHash = murmurHashIt(BSON("check" << BSON("a" << 4 << "b" << BSON_ARRAY(1))));
+    ASSERT_EQUALS(objHash,
+                  murmurHashIt(BSON("check" << BSON("a" << 4.5 << "b" << BSON_ARRAY(1LL)))));
+    ASSERT_NOT_EQUALS(objHash,
+                      murmurHashIt(BSON("check" << BSON("c" << 4 << "b" << BSON_ARRAY(1)))));
+}
+
 }  // namespace
 }  // namespace mongo
@@ -29,6 +29,7 @@
 
 #include "mongo/db/index/btree_key_generator.h"
 
+#include <algorithm>
 #include <boost/optional.hpp>
 #include <memory>
 
@@ -162,29 +163,25 @@ BSONElement BtreeKeyGenerator::_extractNextElement(const BSONObj& obj,
     return BSONElement();
 }
 
-void BtreeKeyGenerator::_getKeysArrEltFixed(const std::vector<const char*>& fieldNames,
-                                            const std::vector<BSONElement>& fixed,
-                                            std::vector<const char*>* fieldNamesTemp,
-                                            std::vector<BSONElement>* fixedTemp,
+void BtreeKeyGenerator::_getKeysArrEltFixed(const FieldNames& fieldNames,
+                                            const FixedElements& fixed,
+                                            FieldNames* fieldNamesTemp,
+                                            FixedElements* fixedTemp,
                                             SharedBufferFragmentBuilder& pooledBufferBuilder,
                                             const BSONElement& arrEntry,
                                             KeyStringSet::sequence_type* keys,
                                             unsigned numNotFound,
                                             const BSONElement& arrObjElt,
-                                            const std::set<size_t>& arrIdxs,
+                                            const FieldIndexes& arrIdxs,
                                             bool mayExpandArrayUnembedded,
-                                            const std::vector<PositionalPathInfo>& positionalInfo,
+                                            const PositionalInfo& positionalInfo,
                                             MultikeyPaths* multikeyPaths,
                                             boost::optional<RecordId> id) const {
     // fieldNamesTemp and fixedTemp are passed in by the caller to be used as temporary data
     // structures as we need them to be mutable in the recursion. When they are stored outside we
     // can reuse their memory.
-    fieldNamesTemp->clear();
-    fixedTemp->clear();
-    fieldNamesTemp->reserve(fieldNames.size());
-    fixedTemp->reserve(fixed.size());
-    std::copy(fieldNames.begin(), fieldNames.end(), std::back_inserter(*fieldNamesTemp));
-    std::copy(fixed.begin(), fixed.end(), std::back_inserter(*fixedTemp));
+    fieldNamesTemp->assign(fieldNames.begin(), fieldNames.end());
+    fixedTemp->assign(fixed.begin(), fixed.end());
 
     // Set up any terminal array values.
     for (const auto idx : arrIdxs) {
@@ -256,8 +253,8 @@ void BtreeKeyGenerator::getKeys(SharedBufferFragmentBuilder& pooledBufferBuilder
         // inserting element by element if array
         auto seq = keys->extract_sequence();
         // '_fieldNames' and '_fixed' are mutated by _getKeysWithArray so pass in copies
-        auto fieldNamesCopy = _fieldNames;
-        auto fixedCopy = _fixed;
+        FieldNames fieldNamesCopy(_fieldNames.begin(), _fieldNames.end());
+        FixedElements fixedCopy(_fixed.begin(), _fixed.end());
         _getKeysWithArray(&fieldNamesCopy,
                           &fixedCopy,
                           pooledBufferBuilder,
@@ -310,20 +307,20 @@ void BtreeKeyGenerator::_getKeysWithoutArray(SharedBufferFragmentBuilder& pooled
     keys->insert(keyString.release());
 }
 
-void BtreeKeyGenerator::_getKeysWithArray(std::vector<const char*>* fieldNames,
-                                          std::vector<BSONElement>* fixed,
+void BtreeKeyGenerator::_getKeysWithArray(FieldNames* fieldNames,
+                                          FixedElements* fixed,
                                           SharedBufferFragmentBuilder& pooledBufferBuilder,
                                           const BSONObj& obj,
                                           KeyStringSet::sequence_type* keys,
                                           unsigned numNotFound,
-                                          const std::vector<PositionalPathInfo>& positionalInfo,
+                                          const PositionalInfo& positionalInfo,
                                           MultikeyPaths* multikeyPaths,
                                           boost::optional<RecordId> id) const {
     BSONElement arrElt;
 
-    // A set containing the position of any indexed fields in the key pattern that traverse through
-    // the 'arrElt' array value.
-    std::set<size_t> arrIdxs;
+    // The positions, in increasing order, of any indexed fields in the key pattern that traverse
+    // through the 'arrElt' array value.
+    FieldIndexes arrIdxs;
 
     // A vector with size equal to the number of elements in the index key pattern. Each element in
     // the vector, if initialized, refers to the component within the indexed field that traverses
@@ -345,7 +342,8 @@ void BtreeKeyGenerator::_getKeysWithArray(std::vector<const char*>* fieldNames,
     // path "a.b" causes the index to be multikey, but the key pattern "a.b.0" only indexes the
     // first element of the array, so we'd have a
     // std::vector<boost::optional<size_t>>{{1U}, boost::none}.
-    std::vector<boost::optional<size_t>> arrComponents(fieldNames->size());
+    boost::container::small_vector<boost::optional<size_t>, kFewFields> arrComponents(
+        fieldNames->size());
 
     bool mayExpandArrayUnembedded = true;
     for (size_t i = 0; i < fieldNames->size(); ++i) {
@@ -365,7 +363,7 @@ void BtreeKeyGenerator::_getKeysWithArray(std::vector<const char*>* fieldNames,
             (*fieldNames)[i] = "";
             numNotFound++;
         } else if (e.type() == Array) {
-            arrIdxs.insert(i);
+            arrIdxs.push_back(i);
             if (arrElt.eoo()) {
                 // we only expand arrays on a single path -- track the path here
                 arrElt = e;
@@ -419,8 +417,8 @@ void BtreeKeyGenerator::_getKeysWithArray(std::vector<const char*>* fieldNames,
         }
 
         // For an empty array, set matching fields to undefined.
-        std::vector<const char*> fieldNamesTemp;
-        std::vector<BSONElement> fixedTemp;
+        FieldNames fieldNamesTemp;
+        FixedElements fixedTemp;
         _getKeysArrEltFixed(*fieldNames,
                             *fixed,
                             &fieldNamesTemp,
@@ -442,9 +440,9 @@ void BtreeKeyGenerator::_getKeysWithArray(std::vector<const char*>* fieldNames,
         // and then traverse the remainder of the field path up front. This prevents us from
         // having to look up the indexed element again on each recursive call (i.e. once per
         // array element).
-        std::vector<PositionalPathInfo> subPositionalInfo(fixed->size());
+        PositionalInfo subPositionalInfo(fixed->size());
         for (size_t i = 0; i < fieldNames->size(); ++i) {
-            const bool fieldIsArray = arrIdxs.find(i) != arrIdxs.end();
+            const bool fieldIsArray = std::find(arrIdxs.begin(), arrIdxs.end(), i) != arrIdxs.end();
 
             if (*(*fieldNames)[i] == '\0') {
                 // We've reached the end of the path.
@@ -506,8 +504,8 @@ void BtreeKeyGenerator::_getKeysWithArray(std::vector<const char*>* fieldNames,
         }
 
         // Generate a key for each element of the indexed array.
-        std::vector<const char*> fieldNamesTemp;
-        std::vector<BSONElement> fixedTemp;
+        FieldNames fieldNamesTemp;
+        FixedElements fixedTemp;
         for (const auto& arrObjElem : arrObj) {
             _getKeysArrEltFixed(*fieldNames,
                                 *fixed,
@@ -29,8 +29,8 @@
 
 #pragma once
 
+#include <boost/container/small_vector.hpp>
 #include <memory>
-#include <set>
 #include <vector>
 
 #include "mongo/bson/bsonobj_comparator_interface.h"
@@ -95,6 +95,14 @@ private:
     bool _pathsContainPositionalComponent{false};
 
     std::vector<BSONElement> _fixed;
+
+    // Most key patterns have few fields, so the state that is copied for each document, and for
+    // each element of an indexed array, is kept inline rather than allocated on the heap.
+    static constexpr size_t kFewFields = 4;
+    using FieldNames = boost::container::small_vector<const char*, kFewFields>;
+    using FixedElements = boost::container::small_vector<BSONElement, kFewFields>;
+    using FieldIndexes = boost::container::small_vector<size_t, kFewFields>;
+
     /**
      * Stores info regarding traversal of a positional path. A path through a document is
      * considered positional if this path element names an array element. Generally this means
@@ -147,18 +155,19 @@ private:
         //   "0.c" refers to element 99 in 'dottedElt', [{c: 99}].
         const char* remainingPath;
     };
+    using PositionalInfo = boost::container::small_vector<PositionalPathInfo, kFewFields>;
 
     /**
      * This recursive method does the heavy-lifting for getKeys().
      * It will modify 'fieldNames' and 'fixed'.
      */
-    void _getKeysWithArray(std::vector<const char*>* fieldNames,
-                           std::vector<BSONElement>* fixed,
+    void _getKeysWithArray(FieldNames* fieldNames,
+                           FixedElements* fixed,
                            SharedBufferFragmentBuilder& pooledBufferBuilder,
                            const BSONObj& obj,
                            KeyStringSet::sequence_type* keys,
                            unsigned numNotFound,
-                           const std::vector<PositionalPathInfo>& positionalInfo,
+                           const PositionalInfo& positionalInfo,
                            MultikeyPaths* multikeyPaths,
                            boost::optional<RecordId> id) const;
 
@@ -216,24 +225,24 @@ private:
      *
      * Then calls _getKeysWithArray() recursively.
      */
-    void _getKeysArrEltFixed(const std::vector<const char*>& fieldNames,
-                             const std::vector<BSONElement>& fixed,
-                             std::vector<const char*>* fieldNamesTemp,
-                             std::vector<BSONElement>* fixedTemp,
+    void _getKeysArrEltFixed(const FieldNames& fieldNames,
+                             const FixedElements& fixed,
+                             FieldNames* fieldNamesTemp,
+                             FixedElements* fixedTemp,
                              SharedBufferFragmentBuilder& pooledBufferBuilder,
                              const BSONElement& arrEntry,
                              KeyStringSet::sequence_type* keys,
                              unsigned numNotFound,
                              const BSONElement& arrObjElt,
-                             const std::set<size_t>& arrIdxs,
+                             const FieldIndexes& arrIdxs,
                              bool mayExpandArrayUnembedded,
-                             const std::vector<PositionalPathInfo>& positionalInfo,
+                             const PositionalInfo& positionalInfo,
                              MultikeyPaths* multikeyPaths,
                              boost::optional<RecordId> id) const;
 
     KeyString::Value _buildNullKeyString() const;
 
-    const std::vector<PositionalPathInfo> _emptyPositionalInfo;
+    const PositionalInfo _emptyPositionalInfo;
 
     // A vector with size equal to the number of elements in the index key pattern. Each element in
     // the vector is the number of path components in the indexed field.
@@ -0,0 +1,122 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/index/column_store_access_method.h"
+
+#include <algorithm>
+
+#include "mongo/db/catalog/index_catalog_entry.h"
+#include "mongo/db/index/index_descriptor.h"
+
+namespace mongo {
+
+ColumnStoreAccessMethod::ColumnStoreAccessMethod(IndexCatalogEntry* columnState,
+                                                 std::unique_ptr<SortedDataInterface> btree)
+    : AbstractIndexAccessMethod(columnState, std::move(btree)) {
+    _columns.emplace_back(kIdColumn);
+    for (auto&& elem : columnState->descriptor()->keyPattern()) {
+        if (elem.fieldNameStringData() != kIdColumn) {
+            _columns.emplace_back(elem.fieldName());
+        }
+    }
+}
+
+void ColumnStoreAccessMethod::doGetKeys(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                                        const BSONObj& obj,
+                                        GetKeysContext context,
+                                        KeyStringSet* keys,
+                                        KeyStringSet* multikeyMetadataKeys,
+                                        MultikeyPaths* multikeyPaths,
+                                        boost::optional<RecordId> id) const {
+    invariant(id);
+    uassert(5502110,
+            "columnstore indexes require a collection with 64-bit integer RecordIds",
+            id->withFormat([](RecordId::Null) { return false; },
+                           [](int64_t) { return true; },
+                           [](const char*, int) { return false; }));
+
+    const auto sdi = getSortedDataInterface();
+    std::vector<bool> seen(_columns.size(), false);
+    int position = 0;
+    for (auto&& elem : obj) {
+        const auto it = std::find(_columns.begin(), _columns.end(), elem.fieldNameStringData());
+        if (it == _columns.end()) {
+            continue;
+        }
+
+        // Only the first occurrence of a duplicated field name is indexed, as it is the one a
+        // projection of the field would return.
+        const auto column = it - _columns.begin();
+        if (seen[column]) {
+            continue;
+        }
+        seen[column] = true;
+
+        KeyString::PooledBuilder keyString(
+            pooledBufferBuilder, sdi->getKeyStringVersion(), sdi->getOrdering());
+        keyString.appendString(*it);
+        keyString.appendNumberLong(id->asLong());
+        keyString.appendNumberLong(position++);
+        keyString.appendBSONElement(elem);
+        keyString.appendRecordId(*id);
+        keys->insert(keyString.release());
+    }
+}
+
+KeyString::Value ColumnStoreAccessMethod::makeSeekKey(KeyString::Version version,
+                                                      Ordering ordering,
+                                                      StringData column,
+                                                      boost::optional<RecordId> after) {
+    KeyString::Builder keyString(version,
+                                 ordering,
+                                 after ? KeyString::Discriminator::kExclusiveAfter
+                                       : KeyString::Discriminator::kExclusiveBefore);
+    keyString.appendString(column);
+    if (after) {
+        keyString.appendNumberLong(after->asLong());
+    }
+    return keyString.getValueCopy();
+}
+
+boost::optional<ColumnStoreAccessMethod::Cell> ColumnStoreAccessMethod::parseCell(
+    const BSONObj& key, StringData column) {
+    BSONObjIterator it(key);
+    if (it.next().valueStringData() != column) {
+        return boost::none;
+    }
+    Cell cell;
+    cell.recordId = RecordId(it.next().numberLong());
+    cell.position = it.next().numberInt();
+    cell.value = it.next();
+    return cell;
+}
+
+}  // namespace mongo
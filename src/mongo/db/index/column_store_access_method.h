@@ -0,0 +1,116 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "mongo/db/index/index_access_method.h"
+#include "mongo/db/jsobj.h"
+
+namespace mongo {
+
+/**
+ * This is the access method for "columnstore" indexes, created with a key pattern such as
+ * { a: "columnstore", b: "columnstore" }.
+ *
+ * Rather than one row-oriented key per document, a columnstore index stores one cell per indexed
+ * top-level field of each document. Each cell is keyed by the column it belongs to and the
+ * RecordId of its document, so every column is a run of cells in RecordId order:
+ *
+ *     (field name, RecordId, position, value)
+ *
+ * 'position' is the rank of the field among the indexed fields of the document, which allows the
+ * indexed fields to be reassembled in their original relative order. The '_id' column is always
+ * stored, since every document has an _id: it lets a column scan drive the reconstruction of
+ * every document, including those which have none of the other indexed fields. The storage
+ * engine prefix compresses the repeated field name of each column.
+ */
+class ColumnStoreAccessMethod final : public AbstractIndexAccessMethod {
+public:
+    static constexpr StringData kIdColumn = "_id"_sd;
+
+    /**
+     * A single cell of a column. 'value' points into the index key it was parsed from.
+     */
+    struct Cell {
+        RecordId recordId;
+        int position;
+        BSONElement value;
+    };
+
+    ColumnStoreAccessMethod(IndexCatalogEntry* columnState,
+                            std::unique_ptr<SortedDataInterface> btree);
+
+    /**
+     * Returns the columns stored by this index: '_id' followed by the fields of the key pattern.
+     */
+    const std::vector<std::string>& getColumns() const {
+        return _columns;
+    }
+
+    /**
+     * A document produces one key per indexed field, none of which lie along an array path, so
+     * the index never becomes multikey.
+     */
+    bool shouldMarkIndexAsMultikey(size_t numberOfKeys,
+                                   const KeyStringSet& multikeyMetadataKeys,
+                                   const MultikeyPaths& multikeyPaths) const final {
+        return false;
+    }
+
+    /**
+     * Returns a key to seek a cursor to the first cell of 'column' whose RecordId is greater than
+     * 'after', or to the first cell of 'column' if 'after' is not given.
+     */
+    static KeyString::Value makeSeekKey(KeyString::Version version,
+                                        Ordering ordering,
+                                        StringData column,
+                                        boost::optional<RecordId> after);
+
+    /**
+     * Parses the cell stored in the index key 'key', or returns boost::none if 'key' belongs to a
+     * column other than 'column'.
+     */
+    static boost::optional<Cell> parseCell(const BSONObj& key, StringData column);
+
+private:
+    void doGetKeys(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                   const BSONObj& obj,
+                   GetKeysContext context,
+                   KeyStringSet* keys,
+                   KeyStringSet* multikeyMetadataKeys,
+                   MultikeyPaths* multikeyPaths,
+                   boost::optional<RecordId> id) const final;
+
+    std::vector<std::string> _columns;
+};
+
+}  // namespace mongo
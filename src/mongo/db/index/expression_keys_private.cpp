@@ -442,8 +442,10 @@ void ExpressionKeysPrivate::getHashKeys(SharedBufferFragmentBuilder& pooledBuffe
 
 // static
 long long int ExpressionKeysPrivate::makeSingleHashKey(const BSONElement& e, HashSeed seed, int v) {
-    massert(16767, "Only HashVersion 0 has been defined", v == 0);
-    return BSONElementHasher::hash64(e, seed);
+    massert(16767,
+            str::stream() << "Unknown HashVersion " << v,
+            BSONElementHasher::isValidHashVersion(v));
+    return BSONElementHasher::hash64(e, seed, v);
 }
 
 // static
@@ -43,6 +43,7 @@
 #include "mongo/db/client.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/curop.h"
+#include "mongo/db/index/index_access_method_gen.h"
 #include "mongo/db/index/index_build_interceptor.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/jsobj.h"
@@ -52,8 +53,10 @@
 #include "mongo/db/repl/timestamp_block.h"
 #include "mongo/db/storage/durable_catalog.h"
 #include "mongo/db/storage/execution_context.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/logv2/log.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/progress_meter.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/stacktrace.h"
@@ -85,6 +88,7 @@ SortOptions makeSortOptions(size_t maxMemoryUsageBytes, StringData dbName) {
         .TempDir(storageGlobalParams.dbpath + "/_tmp")
         .ExtSortAllowed()
         .MaxMemoryUsageBytes(maxMemoryUsageBytes)
+        .MergeThreads(maxIndexBuildMergeThreads.load())
         .DBName(dbName.toString());
 }
 
@@ -329,6 +333,11 @@ bool AbstractIndexAccessMethod::appendCustomStats(OperationContext* opCtx,
     return _newInterface->appendCustomStats(opCtx, output, scale);
 }
 
+bool AbstractIndexAccessMethod::appendIOStats(OperationContext* opCtx,
+                                              BSONObjBuilder* output) const {
+    return _newInterface->appendIOStats(opCtx, output);
+}
+
 long long AbstractIndexAccessMethod::getSpaceUsedBytes(OperationContext* opCtx) const {
     return _newInterface->getSpaceUsedBytes(opCtx);
 }
@@ -384,8 +393,7 @@ void AbstractIndexAccessMethod::prepareUpdate(OperationContext* opCtx,
                                               const InsertDeleteOptions& options,
                                               UpdateTicket* ticket) const {
     auto& executionCtx = StorageExecutionContext::get(opCtx);
-    const MatchExpression* indexFilter = index->getFilterExpression();
-    if (!indexFilter || indexFilter->matchesBSON(from)) {
+    if (index->matchesFilter(from)) {
         // Override key constraints when generating keys for removal. This only applies to keys
         // that do not apply to a partial filter expression.
         const auto getKeysMode = index->isHybridBuilding()
@@ -406,7 +414,7 @@ void AbstractIndexAccessMethod::prepareUpdate(OperationContext* opCtx,
                 kNoopOnSuppressedErrorFn);
     }
 
-    if (!indexFilter || indexFilter->matchesBSON(to)) {
+    if (index->matchesFilter(to)) {
         getKeys(executionCtx.pooledBufferBuilder(),
                 to,
                 options.getKeysMode,
@@ -490,6 +498,12 @@ public:
                   const RecordId& loc,
                   const InsertDeleteOptions& options) final;
 
+    Status insertBatch(OperationContext* opCtx,
+                       const std::vector<BSONObj>& objs,
+                       const std::vector<RecordId>& locs,
+                       const InsertDeleteOptions& options,
+                       size_t numThreads) final;
+
     const MultikeyPaths& getMultikeyPaths() const final;
 
     bool isMultikey() const final;
@@ -505,6 +519,21 @@ public:
     Sorter::PersistedState persistDataForShutdown() final;
 
 private:
+    /**
+     * Adds the keys generated for a single document to the sorter and folds its multikey paths
+     * into the paths tracked for the whole index.
+     */
+    void _insertKeys(const KeyStringSet& keys, const MultikeyPaths& multikeyPaths);
+
+    /**
+     * Records a document whose key generation error was suppressed as "skipped" so the index
+     * builder can retry it at a point when data is consistent.
+     */
+    void _recordSuppressedError(OperationContext* opCtx,
+                                const Status& status,
+                                const BSONObj& obj,
+                                const RecordId& loc);
+
     void _insertMultikeyMetadataKeysIntoSorter();
 
     Sorter* _makeSorter(
@@ -578,47 +607,136 @@ Status AbstractIndexAccessMethod::BulkBuilderImpl::insert(OperationContext* opCt
             multikeyPaths.get(),
             loc,
             [&](Status status, const BSONObj&, boost::optional<RecordId>) {
-                // If a key generation error was suppressed, record the document as "skipped" so the
-                // index builder can retry at a point when data is consistent.
-                auto interceptor = _indexCatalogEntry->indexBuildInterceptor();
-                if (interceptor && interceptor->getSkippedRecordTracker()) {
-                    LOGV2_DEBUG(20684,
-                                1,
-                                "Recording suppressed key generation error to retry later: "
-                                "{error} on {loc}: {obj}",
-                                "error"_attr = status,
-                                "loc"_attr = loc,
-                                "obj"_attr = redact(obj));
-                    interceptor->getSkippedRecordTracker()->record(opCtx, loc);
-                }
+                _recordSuppressedError(opCtx, status, obj, loc);
             });
     } catch (...) {
         return exceptionToStatus();
     }
 
-    if (!multikeyPaths->empty()) {
+    _insertKeys(*keys, *multikeyPaths);
+    return Status::OK();
+}
+
+Status AbstractIndexAccessMethod::BulkBuilderImpl::insertBatch(OperationContext* opCtx,
+                                                               const std::vector<BSONObj>& objs,
+                                                               const std::vector<RecordId>& locs,
+                                                               const InsertDeleteOptions& options,
+                                                               size_t numThreads) {
+    invariant(objs.size() == locs.size());
+    if (objs.empty()) {
+        return Status::OK();
+    }
+
+    // The keys of each document are generated into their own slot, so that the worker threads
+    // share nothing but the read-only documents and access method.
+    struct DocumentKeys {
+        KeyStringSet keys;
+        KeyStringSet multikeyMetadataKeys;
+        MultikeyPaths multikeyPaths;
+        boost::optional<Status> suppressedError;
+        Status status = Status::OK();
+    };
+    std::vector<DocumentKeys> documentKeys(objs.size());
+
+    auto accessMethod = _indexCatalogEntry->accessMethod();
+    auto generateKeys = [&](size_t begin, size_t end) {
+        SharedBufferFragmentBuilder pooledBufferBuilder(
+            gOperationMemoryPoolBlockInitialSizeKB.loadRelaxed() * static_cast<size_t>(1024),
+            SharedBufferFragmentBuilder::DoubleGrowStrategy(
+                gOperationMemoryPoolBlockMaxSizeKB.loadRelaxed() * static_cast<size_t>(1024)));
+        for (size_t i = begin; i < end; ++i) {
+            auto& document = documentKeys[i];
+            try {
+                accessMethod->getKeys(
+                    pooledBufferBuilder,
+                    objs[i],
+                    options.getKeysMode,
+                    GetKeysContext::kAddingKeys,
+                    &document.keys,
+                    &document.multikeyMetadataKeys,
+                    &document.multikeyPaths,
+                    locs[i],
+                    [&](Status status, const BSONObj&, boost::optional<RecordId>) {
+                        document.suppressedError = std::move(status);
+                    });
+            } catch (...) {
+                document.status = exceptionToStatus();
+            }
+        }
+    };
+
+    // Generate the keys of the first slice of the batch on the calling thread.
+    numThreads = std::max<size_t>(1, std::min(numThreads, objs.size()));
+    const size_t sliceSize = (objs.size() + numThreads - 1) / numThreads;
+    std::vector<stdx::thread> workers;
+    for (size_t begin = sliceSize; begin < objs.size(); begin += sliceSize) {
+        workers.emplace_back(generateKeys, begin, std::min(begin + sliceSize, objs.size()));
+    }
+    generateKeys(0, std::min(sliceSize, objs.size()));
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    // Insert the keys in the order of the batch, stopping at the first document which failed as
+    // insert() would.
+    for (size_t i = 0; i < documentKeys.size(); ++i) {
+        auto& document = documentKeys[i];
+        if (!document.status.isOK()) {
+            return document.status;
+        }
+        if (document.suppressedError) {
+            _recordSuppressedError(opCtx, *document.suppressedError, objs[i], locs[i]);
+        }
+        _multikeyMetadataKeys.insert(document.multikeyMetadataKeys.begin(),
+                                     document.multikeyMetadataKeys.end());
+        _insertKeys(document.keys, document.multikeyPaths);
+    }
+
+    return Status::OK();
+}
+
+void AbstractIndexAccessMethod::BulkBuilderImpl::_insertKeys(const KeyStringSet& keys,
+                                                             const MultikeyPaths& multikeyPaths) {
+    if (!multikeyPaths.empty()) {
         if (_indexMultikeyPaths.empty()) {
-            _indexMultikeyPaths = *multikeyPaths;
+            _indexMultikeyPaths = multikeyPaths;
         } else {
-            invariant(_indexMultikeyPaths.size() == multikeyPaths->size());
-            for (size_t i = 0; i < multikeyPaths->size(); ++i) {
+            invariant(_indexMultikeyPaths.size() == multikeyPaths.size());
+            for (size_t i = 0; i < multikeyPaths.size(); ++i) {
                 _indexMultikeyPaths[i].insert(boost::container::ordered_unique_range_t(),
-                                              (*multikeyPaths)[i].begin(),
-                                              (*multikeyPaths)[i].end());
+                                              multikeyPaths[i].begin(),
+                                              multikeyPaths[i].end());
             }
         }
     }
 
-    for (const auto& keyString : *keys) {
+    for (const auto& keyString : keys) {
         _sorter->add(keyString, mongo::NullValue());
         ++_keysInserted;
     }
 
     _isMultiKey = _isMultiKey ||
         _indexCatalogEntry->accessMethod()->shouldMarkIndexAsMultikey(
-            keys->size(), _multikeyMetadataKeys, *multikeyPaths);
-
-    return Status::OK();
+            keys.size(), _multikeyMetadataKeys, multikeyPaths);
+}
+
+void AbstractIndexAccessMethod::BulkBuilderImpl::_recordSuppressedError(OperationContext* opCtx,
+                                                                        const Status& status,
+                                                                        const BSONObj& obj,
+                                                                        const RecordId& loc) {
+    // If a key generation error was suppressed, record the document as "skipped" so the index
+    // builder can retry at a point when data is consistent.
+    auto interceptor = _indexCatalogEntry->indexBuildInterceptor();
+    if (interceptor && interceptor->getSkippedRecordTracker()) {
+        LOGV2_DEBUG(20684,
+                    1,
+                    "Recording suppressed key generation error to retry later: "
+                    "{error} on {loc}: {obj}",
+                    "error"_attr = status,
+                    "loc"_attr = loc,
+                    "obj"_attr = redact(obj));
+        interceptor->getSkippedRecordTracker()->record(opCtx, loc);
+    }
 }
 
 const MultikeyPaths& AbstractIndexAccessMethod::BulkBuilderImpl::getMultikeyPaths() const {
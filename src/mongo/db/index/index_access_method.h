@@ -199,6 +199,13 @@ public:
                                    BSONObjBuilder* result,
                                    double scale) const = 0;
 
+    /**
+     * Add the cache and disk I/O statistics of this index to BSON object builder, for display.
+     *
+     * Returns true if stats were appended.
+     */
+    virtual bool appendIOStats(OperationContext* opCtx, BSONObjBuilder* result) const = 0;
+
     /**
      * @return The number of bytes consumed by this index.
      *         Exactly what is counted is not defined based on padding, re-use, etc...
@@ -244,6 +251,17 @@ public:
                               const RecordId& loc,
                               const InsertDeleteOptions& options) = 0;
 
+        /**
+         * Inserts a batch of documents into the BulkBuilder as-if calling insert() on each of them
+         * in order, but generates their keys on up to 'numThreads' threads. The keys are added to
+         * the underlying Sorter by the calling thread once all of them have been generated.
+         */
+        virtual Status insertBatch(OperationContext* opCtx,
+                                   const std::vector<BSONObj>& objs,
+                                   const std::vector<RecordId>& locs,
+                                   const InsertDeleteOptions& options,
+                                   size_t numThreads) = 0;
+
         virtual const MultikeyPaths& getMultikeyPaths() const = 0;
 
         virtual bool isMultikey() const = 0;
@@ -517,6 +535,8 @@ public:
                            BSONObjBuilder* result,
                            double scale) const final;
 
+    bool appendIOStats(OperationContext* opCtx, BSONObjBuilder* result) const final;
+
     long long getSpaceUsedBytes(OperationContext* opCtx) const final;
 
     long long getFreeStorageBytes(OperationContext* opCtx) const final;
@@ -33,6 +33,7 @@
 
 #include "mongo/db/index/index_build_interceptor.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "mongo/bson/bsonobj.h"
@@ -179,6 +180,9 @@ Status IndexBuildInterceptor::drainWritesIntoIndex(OperationContext* opCtx,
         // table matters.
         std::vector<RecordId> recordsAddedToIndex;
 
+        // The side writes read from the table, in the order they were recorded.
+        std::vector<SideWrite> batch;
+
         auto record = cursor->next();
         while (record) {
             opCtx->checkForInterrupt();
@@ -200,16 +204,7 @@ Status IndexBuildInterceptor::drainWritesIntoIndex(OperationContext* opCtx,
             batchSize += 1;
             batchSizeBytes += objSize;
 
-            if (auto status = _applyWrite(opCtx,
-                                          coll,
-                                          unownedDoc,
-                                          options,
-                                          trackDuplicates,
-                                          &totalInserted,
-                                          &totalDeleted);
-                !status.isOK()) {
-                return status;
-            }
+            batch.push_back(_parseSideWrite(unownedDoc));
 
             // Save the record ids of the documents inserted into the index for deletion later.
             // We can't delete records while holding a positioned cursor.
@@ -223,6 +218,33 @@ Status IndexBuildInterceptor::drainWritesIntoIndex(OperationContext* opCtx,
             record = cursor->next();
         }
 
+        // Apply the batch in key order, which keeps the index cursor moving forward instead of
+        // seeking for every write. Only the last write to a key decides whether the key ends up in
+        // the index, so the stable sort lets the earlier writes to the same key be skipped. The
+        // deletes are applied before the inserts so that a unique key moving from one document to
+        // another is not seen as a duplicate in between.
+        std::stable_sort(batch.begin(), batch.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.first < rhs.first;
+        });
+        for (auto op : {Op::kDelete, Op::kInsert}) {
+            for (size_t i = 0; i < batch.size(); ++i) {
+                if (batch[i].second != op ||
+                    (i + 1 < batch.size() && batch[i + 1].first == batch[i].first)) {
+                    continue;
+                }
+                if (auto status = _applyWrite(opCtx,
+                                              coll,
+                                              batch[i],
+                                              options,
+                                              trackDuplicates,
+                                              &totalInserted,
+                                              &totalDeleted);
+                    !status.isOK()) {
+                    return status;
+                }
+            }
+        }
+
         // Delete documents from the side table as soon as they have been inserted into the index.
         // This ensures that no key is ever inserted twice and no keys are skipped.
         for (const auto& recordId : recordsAddedToIndex) {
@@ -239,6 +261,15 @@ Status IndexBuildInterceptor::drainWritesIntoIndex(OperationContext* opCtx,
         progress->hit(batchSize);
         _numApplied += batchSize;
 
+        // Report how quickly the side writes are drained and how many remain in currentOp.
+        auto& opDebug = CurOp::get(opCtx)->debug();
+        if (auto elapsedMillis = timer.millis(); elapsedMillis > 0) {
+            opDebug.sideWritesDrainedPerSecond =
+                (_numApplied - appliedAtStart) * 1000.0 / elapsedMillis;
+        }
+        opDebug.sideWritesBacklog =
+            std::max<long long>(0, _sideWritesCounter->loadRelaxed() - _numApplied);
+
         // Lock yielding will be directed by the yield policy provided.
         // We will typically yield locks during the draining phase if we are holding intent locks.
         if (DrainYieldPolicy::kYield == drainYieldPolicy) {
@@ -280,23 +311,33 @@ Status IndexBuildInterceptor::drainWritesIntoIndex(OperationContext* opCtx,
     return Status::OK();
 }
 
-Status IndexBuildInterceptor::_applyWrite(OperationContext* opCtx,
-                                          const CollectionPtr& coll,
-                                          const BSONObj& operation,
-                                          const InsertDeleteOptions& options,
-                                          TrackDuplicates trackDups,
-                                          int64_t* const keysInserted,
-                                          int64_t* const keysDeleted) {
+IndexBuildInterceptor::SideWrite IndexBuildInterceptor::_parseSideWrite(
+    const BSONObj& operation) const {
     // Deserialize the encoded KeyString::Value.
     int keyLen;
     const char* binKey = operation["key"].binData(keyLen);
     BufReader reader(binKey, keyLen);
-    const KeyString::Value keyString = KeyString::Value::deserialize(
+    KeyString::Value keyString = KeyString::Value::deserialize(
         reader,
         _indexCatalogEntry->accessMethod()->getSortedDataInterface()->getKeyStringVersion());
 
     const Op opType =
         (strcmp(operation.getStringField("op"), "i") == 0) ? Op::kInsert : Op::kDelete;
+    if (kDebugBuild && opType == Op::kDelete)
+        invariant(strcmp(operation.getStringField("op"), "d") == 0);
+
+    return {std::move(keyString), opType};
+}
+
+Status IndexBuildInterceptor::_applyWrite(OperationContext* opCtx,
+                                          const CollectionPtr& coll,
+                                          const SideWrite& write,
+                                          const InsertDeleteOptions& options,
+                                          TrackDuplicates trackDups,
+                                          int64_t* const keysInserted,
+                                          int64_t* const keysDeleted) {
+    const KeyString::Value& keyString = write.first;
+    const Op opType = write.second;
 
     const KeyStringSet keySet{keyString};
     const RecordId opRecordId = [&]() {
@@ -335,8 +376,6 @@ Status IndexBuildInterceptor::_applyWrite(OperationContext* opCtx,
             [keysInserted, numInserted] { *keysInserted -= numInserted; });
     } else {
         invariant(opType == Op::kDelete);
-        if (kDebugBuild)
-            invariant(strcmp(operation.getStringField("op"), "d") == 0);
 
         int64_t numDeleted;
         Status s = accessMethod->removeKeys(
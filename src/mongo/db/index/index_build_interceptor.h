@@ -175,10 +175,17 @@ public:
 private:
     using SideWriteRecord = std::pair<RecordId, BSONObj>;
 
+    /**
+     * A side write decoded from the side writes table: the key to insert into or remove from the
+     * index.
+     */
+    using SideWrite = std::pair<KeyString::Value, Op>;
+
+    SideWrite _parseSideWrite(const BSONObj& operation) const;
 
     Status _applyWrite(OperationContext* opCtx,
                        const CollectionPtr& coll,
-                       const BSONObj& doc,
+                       const SideWrite& write,
                        const InsertDeleteOptions& options,
                        TrackDuplicates trackDups,
                        int64_t* const keysInserted,
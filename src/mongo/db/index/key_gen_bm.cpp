@@ -165,9 +165,73 @@ void BM_KeyGenArrayOfArray(benchmark::State& state, int32_t elements) {
     }
 }
 
+void BM_KeyGenCompound(benchmark::State& state, bool skipMultikey) {
+    BSONObj obj = BSON("a" << 1 << "b"
+                           << "string"
+                           << "c" << BSON("d" << 2.5) << "e" << OID::gen());
+    BSONObj keyPattern = BSON("a" << 1 << "b" << 1 << "c.d" << 1 << "e" << 1);
+
+    BtreeKeyGenerator generator({"a", "b", "c.d", "e"},
+                                {BSONElement{}, BSONElement{}, BSONElement{}, BSONElement{}},
+                                false,
+                                nullptr,
+                                KeyString::Version::kLatestVersion,
+                                Ordering::make(keyPattern));
+
+    SharedBufferFragmentBuilder allocator(kMemBlockSize,
+                                          SharedBufferFragmentBuilder::ConstantGrowStrategy());
+    KeyStringSet keys;
+    MultikeyPaths multikeyPaths;
+
+    for (auto _ : state) {
+        generator.getKeys(allocator, obj, skipMultikey, &keys, &multikeyPaths);
+        benchmark::ClobberMemory();
+        keys.clear();
+        multikeyPaths.clear();
+    }
+}
+
+void BM_KeyGenCompoundArrayOfObjects(benchmark::State& state, int32_t elements) {
+    std::mt19937 gen(numGen());
+
+    BSONObjBuilder builder;
+    builder.append("x", 1);
+    BSONArrayBuilder arrBuilder(builder.subarrayStart(kFieldName));
+    for (int32_t i = 0; i < elements; ++i) {
+        arrBuilder.append(BSON("b" << static_cast<int32_t>(gen()) << "c" << i));
+    }
+    arrBuilder.done();
+    BSONObj obj = builder.obj();
+
+    BtreeKeyGenerator generator({"x", "a.b", "a.c"},
+                                {BSONElement{}, BSONElement{}, BSONElement{}},
+                                false,
+                                nullptr,
+                                KeyString::Version::kLatestVersion,
+                                Ordering::make(BSON("x" << 1 << "a.b" << 1 << "a.c" << 1)));
+
+    SharedBufferFragmentBuilder allocator(kMemBlockSize,
+                                          SharedBufferFragmentBuilder::ConstantGrowStrategy());
+    KeyStringSet keys;
+    MultikeyPaths multikeyPaths;
+
+    for (auto _ : state) {
+        generator.getKeys(allocator, obj, false, &keys, &multikeyPaths);
+        benchmark::ClobberMemory();
+        keys.clear();
+        multikeyPaths.clear();
+    }
+}
+
 BENCHMARK_CAPTURE(BM_KeyGenBasic, Generic, false);
 BENCHMARK_CAPTURE(BM_KeyGenBasic, SkipMultikey, true);
 
+BENCHMARK_CAPTURE(BM_KeyGenCompound, Generic, false);
+BENCHMARK_CAPTURE(BM_KeyGenCompound, SkipMultikey, true);
+
+BENCHMARK_CAPTURE(BM_KeyGenCompoundArrayOfObjects, 10, 10);
+BENCHMARK_CAPTURE(BM_KeyGenCompoundArrayOfObjects, 1K, 1000);
+
 BENCHMARK_CAPTURE(BM_KeyGenArray, 1K, 1000);
 BENCHMARK_CAPTURE(BM_KeyGenArray, 10K, 10000);
 BENCHMARK_CAPTURE(BM_KeyGenArray, 100K, 100000);
@@ -47,33 +47,24 @@ static const BSONObj kDefaultProjection = BSON("_id"_sd << 0);
 // If the enclosing object is an array, then the current element's fieldname is the array index, so
 // we omit this when computing the full path. Otherwise, the full path is the pathPrefix plus the
 // element's fieldname.
-void pushPathComponent(BSONElement elem, bool enclosingObjIsArray, FieldRef* pathPrefix) {
+void pushPathComponent(BSONElement elem, bool enclosingObjIsArray, std::string* pathPrefix) {
     if (!enclosingObjIsArray) {
-        pathPrefix->appendPart(elem.fieldNameStringData());
-    }
-}
-
-// If the enclosing object is not an array, then the final path component should be its field name.
-// Verify that this is the case and then pop it off the FieldRef.
-void popPathComponent(BSONElement elem, bool enclosingObjIsArray, FieldRef* pathToElem) {
-    if (!enclosingObjIsArray) {
-        invariant(pathToElem->getPart(pathToElem->numParts() - 1) == elem.fieldNameStringData());
-        pathToElem->removeLastPart();
+        if (!pathPrefix->empty()) {
+            pathPrefix->push_back('.');
+        }
+        auto fieldName = elem.fieldNameStringData();
+        pathPrefix->append(fieldName.rawData(), fieldName.size());
     }
 }
-}  // namespace
-
-constexpr StringData WildcardKeyGenerator::kSubtreeSuffix;
 
-WildcardProjection WildcardKeyGenerator::createProjectionExecutor(BSONObj keyPattern,
-                                                                  BSONObj pathProjection) {
+BSONObj makeProjectionSpec(BSONObj keyPattern, BSONObj pathProjection) {
     // We should never have a key pattern that contains more than a single element.
     invariant(keyPattern.nFields() == 1);
 
     // The _keyPattern is either { "$**": ±1 } for all paths or { "path.$**": ±1 } for a single
     // subtree. If we are indexing a single subtree, then we will project just that path.
     auto indexRoot = keyPattern.firstElement().fieldNameStringData();
-    auto suffixPos = indexRoot.find(kSubtreeSuffix);
+    auto suffixPos = indexRoot.find(WildcardKeyGenerator::kSubtreeSuffix);
 
     // If we're indexing a single subtree, we can't also specify a path projection.
     invariant(suffixPos == std::string::npos || pathProjection.isEmpty());
@@ -81,9 +72,25 @@ WildcardProjection WildcardKeyGenerator::createProjectionExecutor(BSONObj keyPat
     // If this is a subtree projection, the projection spec is { "path.to.subtree": 1 }. Otherwise,
     // we use the path projection from the original command object. If the path projection is empty
     // we default to {_id: 0}, since empty projections are illegal and will be rejected when parsed.
-    auto projSpec = (suffixPos != std::string::npos
-                         ? BSON(indexRoot.substr(0, suffixPos) << 1)
-                         : pathProjection.isEmpty() ? kDefaultProjection : pathProjection);
+    return (suffixPos != std::string::npos
+                ? BSON(indexRoot.substr(0, suffixPos) << 1)
+                : pathProjection.isEmpty() ? kDefaultProjection : pathProjection);
+}
+}  // namespace
+
+constexpr StringData WildcardKeyGenerator::kSubtreeSuffix;
+
+bool WildcardKeyGenerator::TopLevelProjection::includes(StringData fieldName) const {
+    // As with the ProjectionExecutor, _id is only included when the projection asks for it.
+    if (fieldName == "_id"_sd) {
+        return includeId;
+    }
+    return isInclusion == (fields.find(fieldName) != fields.end());
+}
+
+WildcardProjection WildcardKeyGenerator::createProjectionExecutor(BSONObj keyPattern,
+                                                                  BSONObj pathProjection) {
+    auto projSpec = makeProjectionSpec(keyPattern, pathProjection);
 
     // Construct a dummy ExpressionContext for ProjectionExecutor. It's OK to set the
     // ExpressionContext's OperationContext and CollatorInterface to 'nullptr' and the namespace
@@ -105,22 +112,51 @@ WildcardKeyGenerator::WildcardKeyGenerator(BSONObj keyPattern,
       _collator(collator),
       _keyPattern(keyPattern),
       _keyStringVersion(keyStringVersion),
-      _ordering(ordering) {}
+      _ordering(ordering) {
+    // The projection spec was validated when building '_proj'. If it only includes or excludes
+    // top-level fields, it can be applied while traversing the documents.
+    TopLevelProjection topLevelProjection;
+    boost::optional<bool> isInclusion;
+    for (auto&& elem : makeProjectionSpec(keyPattern, pathProjection)) {
+        auto fieldName = elem.fieldNameStringData();
+        if (!(elem.isNumber() || elem.isBoolean()) || fieldName.find('.') != std::string::npos ||
+            fieldName.startsWith("$")) {
+            return;
+        }
+
+        if (fieldName == "_id"_sd) {
+            topLevelProjection.includeId = elem.trueValue();
+            // A projection of _id alone is an inclusion when it includes _id.
+            if (!isInclusion) {
+                topLevelProjection.isInclusion = elem.trueValue();
+            }
+            continue;
+        }
+
+        isInclusion = elem.trueValue();
+        topLevelProjection.isInclusion = *isInclusion;
+        topLevelProjection.fields.insert(fieldName.toString());
+    }
+    _topLevelProjection = std::move(topLevelProjection);
+}
 
 void WildcardKeyGenerator::generateKeys(SharedBufferFragmentBuilder& pooledBufferBuilder,
                                         BSONObj inputDoc,
                                         KeyStringSet* keys,
                                         KeyStringSet* multikeyPaths,
                                         boost::optional<RecordId> id) const {
-    FieldRef rootPath;
+    std::string rootPath;
     auto keysSequence = keys->extract_sequence();
     // multikeyPaths is allowed to be nullptr
     KeyStringSet::sequence_type multikeyPathsSequence;
     if (multikeyPaths)
         multikeyPathsSequence = multikeyPaths->extract_sequence();
     _traverseWildcard(pooledBufferBuilder,
-                      _proj.exec()->applyTransformation(Document{inputDoc}).toBson(),
+                      _topLevelProjection
+                          ? inputDoc
+                          : _proj.exec()->applyTransformation(Document{inputDoc}).toBson(),
                       false,
+                      _topLevelProjection.get_ptr(),
                       &rootPath,
                       &keysSequence,
                       multikeyPaths ? &multikeyPathsSequence : nullptr,
@@ -133,15 +169,20 @@ void WildcardKeyGenerator::generateKeys(SharedBufferFragmentBuilder& pooledBuffe
 void WildcardKeyGenerator::_traverseWildcard(SharedBufferFragmentBuilder& pooledBufferBuilder,
                                              BSONObj obj,
                                              bool objIsArray,
-                                             FieldRef* path,
+                                             const TopLevelProjection* rootProjection,
+                                             std::string* path,
                                              KeyStringSet::sequence_type* keys,
                                              KeyStringSet::sequence_type* multikeyPaths,
                                              boost::optional<RecordId> id) const {
+    const auto parentPathSize = path->size();
     for (const auto& elem : obj) {
         // If the element's fieldName contains a ".", fast-path skip it because it's not queryable.
         if (elem.fieldNameStringData().find('.', 0) != std::string::npos)
             continue;
 
+        if (rootProjection && !rootProjection->includes(elem.fieldNameStringData()))
+            continue;
+
         // Append the element's fieldname to the path, if the enclosing object is not an array.
         pushPathComponent(elem, objIsArray, path);
 
@@ -161,6 +202,7 @@ void WildcardKeyGenerator::_traverseWildcard(SharedBufferFragmentBuilder& pooled
                 _traverseWildcard(pooledBufferBuilder,
                                   elem.Obj(),
                                   elem.type() == BSONType::Array,
+                                  nullptr,
                                   path,
                                   keys,
                                   multikeyPaths,
@@ -172,13 +214,13 @@ void WildcardKeyGenerator::_traverseWildcard(SharedBufferFragmentBuilder& pooled
         }
 
         // Remove the element's fieldname from the path, if it was pushed onto it earlier.
-        popPathComponent(elem, objIsArray, path);
+        path->resize(parentPathSize);
     }
 }
 
 bool WildcardKeyGenerator::_addKeyForNestedArray(SharedBufferFragmentBuilder& pooledBufferBuilder,
                                                  BSONElement elem,
-                                                 const FieldRef& fullPath,
+                                                 StringData fullPath,
                                                  bool enclosingObjIsArray,
                                                  KeyStringSet::sequence_type* keys,
                                                  boost::optional<RecordId> id) const {
@@ -192,7 +234,7 @@ bool WildcardKeyGenerator::_addKeyForNestedArray(SharedBufferFragmentBuilder& po
 
 bool WildcardKeyGenerator::_addKeyForEmptyLeaf(SharedBufferFragmentBuilder& pooledBufferBuilder,
                                                BSONElement elem,
-                                               const FieldRef& fullPath,
+                                               StringData fullPath,
                                                KeyStringSet::sequence_type* keys,
                                                boost::optional<RecordId> id) const {
     invariant(elem.isABSONObj());
@@ -211,12 +253,12 @@ bool WildcardKeyGenerator::_addKeyForEmptyLeaf(SharedBufferFragmentBuilder& pool
 
 void WildcardKeyGenerator::_addKey(SharedBufferFragmentBuilder& pooledBufferBuilder,
                                    BSONElement elem,
-                                   const FieldRef& fullPath,
+                                   StringData fullPath,
                                    KeyStringSet::sequence_type* keys,
                                    boost::optional<RecordId> id) const {
     // Wildcard keys are of the form { "": "path.to.field", "": <collation-aware value> }.
     KeyString::PooledBuilder keyString(pooledBufferBuilder, _keyStringVersion, _ordering);
-    keyString.appendString(fullPath.dottedField());
+    keyString.appendString(fullPath);
     if (_collator && elem) {
         keyString.appendBSONElement(elem, [&](StringData stringData) {
             return _collator->getComparisonString(stringData);
@@ -234,13 +276,13 @@ void WildcardKeyGenerator::_addKey(SharedBufferFragmentBuilder& pooledBufferBuil
 }
 
 void WildcardKeyGenerator::_addMultiKey(SharedBufferFragmentBuilder& pooledBufferBuilder,
-                                        const FieldRef& fullPath,
+                                        StringData fullPath,
                                         KeyStringSet::sequence_type* multikeyPaths) const {
     // Multikey paths are denoted by a key of the form { "": 1, "": "path.to.array" }. The argument
     // 'multikeyPaths' may be nullptr if the access method is being used in an operation which does
     // not require multikey path generation.
     if (multikeyPaths) {
-        auto key = BSON("" << 1 << "" << fullPath.dottedField());
+        auto key = BSON("" << 1 << "" << fullPath);
         KeyString::PooledBuilder keyString(
             pooledBufferBuilder,
             _keyStringVersion,
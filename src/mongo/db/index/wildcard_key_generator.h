@@ -29,11 +29,15 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+#include <string>
+
 #include "mongo/db/exec/wildcard_projection.h"
 #include "mongo/db/field_ref.h"
 #include "mongo/db/query/collation/collator_interface.h"
 #include "mongo/db/storage/key_string.h"
 #include "mongo/db/storage/sorted_data_interface.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 
@@ -81,39 +85,56 @@ public:
                       boost::optional<RecordId> id = boost::none) const;
 
 private:
-    // Traverses every path of the post-projection document, adding keys to the set as it goes.
+    /**
+     * A projection which only includes or excludes top-level fields, such as the default {_id: 0}
+     * or the projection of a single top-level subtree. It is applied while traversing the input
+     * document, instead of building the post-projection document through the ProjectionExecutor.
+     */
+    struct TopLevelProjection {
+        bool includes(StringData fieldName) const;
+
+        bool isInclusion = false;
+        bool includeId = false;
+        StringSet fields;
+    };
+
+    // Traverses every path of the post-projection document, adding keys to the set as it goes. If
+    // 'rootProjection' is not null, 'obj' is the input document and the fields which the
+    // projection does not include are skipped.
     void _traverseWildcard(SharedBufferFragmentBuilder& pooledBufferBuilder,
                            BSONObj obj,
                            bool objIsArray,
-                           FieldRef* path,
+                           const TopLevelProjection* rootProjection,
+                           std::string* path,
                            KeyStringSet::sequence_type* keys,
                            KeyStringSet::sequence_type* multikeyPaths,
                            boost::optional<RecordId> id) const;
 
     // Helper functions to format the entry appropriately before adding it to the key/path tracker.
     void _addMultiKey(SharedBufferFragmentBuilder& pooledBufferBuilder,
-                      const FieldRef& fullPath,
+                      StringData fullPath,
                       KeyStringSet::sequence_type* multikeyPaths) const;
     void _addKey(SharedBufferFragmentBuilder& pooledBufferBuilder,
                  BSONElement elem,
-                 const FieldRef& fullPath,
+                 StringData fullPath,
                  KeyStringSet::sequence_type* keys,
                  boost::optional<RecordId> id) const;
 
     // Helper to check whether the element is a nested array, and conditionally add it to 'keys'.
     bool _addKeyForNestedArray(SharedBufferFragmentBuilder& pooledBufferBuilder,
                                BSONElement elem,
-                               const FieldRef& fullPath,
+                               StringData fullPath,
                                bool enclosingObjIsArray,
                                KeyStringSet::sequence_type* keys,
                                boost::optional<RecordId> id) const;
     bool _addKeyForEmptyLeaf(SharedBufferFragmentBuilder& pooledBufferBuilder,
                              BSONElement elem,
-                             const FieldRef& fullPath,
+                             StringData fullPath,
                              KeyStringSet::sequence_type* keys,
                              boost::optional<RecordId> id) const;
 
     WildcardProjection _proj;
+    boost::optional<TopLevelProjection> _topLevelProjection;
     const CollatorInterface* _collator;
     const BSONObj _keyPattern;
     const KeyString::Version _keyStringVersion;
@@ -1068,6 +1068,47 @@ TEST_F(WildcardKeyGeneratorIdTest, IncludeIdFieldIfExplicitlySpecifiedInExclusio
     ASSERT(assertKeysetsEqual(expectedMultikeyPaths, multikeyMetadataKeys));
 }
 
+TEST_F(WildcardKeyGeneratorIdTest, TopLevelProjectionGeneratesSameKeysAsProjectionExecutor) {
+    // A projection of top-level fields is applied while traversing the document, whereas a dotted
+    // path projection goes through the ProjectionExecutor. Both must produce the same keys.
+    WildcardKeyGenerator topLevelKeyGen{fromjson("{'$**': 1}"),
+                                        fromjson("{_id: 1, a: 1, g: 1}"),
+                                        nullptr,
+                                        KeyString::Version::kLatestVersion,
+                                        Ordering::make(BSONObj())};
+    WildcardKeyGenerator dottedKeyGen{fromjson("{'$**': 1}"),
+                                      fromjson("{_id: 1, a: 1, g: 1, 'z.y': 1}"),
+                                      nullptr,
+                                      KeyString::Version::kLatestVersion,
+                                      Ordering::make(BSONObj())};
+
+    auto inputDoc = fromjson(
+        "{_id: {id1: 1}, a: [1, {b: 1, e: [4]}, [6, 7, {f: 8}]], c: 2, g: {h: {i: 9, k: []}}}");
+
+    auto expectedKeys = makeKeySet({fromjson("{'': '_id.id1', '': 1}"),
+                                    fromjson("{'': 'a', '': 1}"),
+                                    fromjson("{'': 'a', '': [6, 7, {f: 8}]}"),
+                                    fromjson("{'': 'a.b', '': 1}"),
+                                    fromjson("{'': 'a.e', '': 4}"),
+                                    fromjson("{'': 'g.h.i', '': 9}"),
+                                    fromjson("{'': 'g.h.k', '': undefined}")});
+
+    auto expectedMultikeyPaths = makeKeySet(
+        {fromjson("{'': 1, '': 'a'}"),
+         fromjson("{'': 1, '': 'a.e'}"),
+         fromjson("{'': 1, '': 'g.h.k'}")},
+        RecordId::reservedIdFor<int64_t>(RecordId::Reservation::kWildcardMultikeyMetadataId));
+
+    for (auto keyGen : {&topLevelKeyGen, &dottedKeyGen}) {
+        auto outputKeys = makeKeySet();
+        auto multikeyMetadataKeys = makeKeySet();
+        keyGen->generateKeys(allocator, inputDoc, &outputKeys, &multikeyMetadataKeys);
+
+        ASSERT(assertKeysetsEqual(expectedKeys, outputKeys));
+        ASSERT(assertKeysetsEqual(expectedMultikeyPaths, multikeyMetadataKeys));
+    }
+}
+
 // Collation tests.
 struct WildcardKeyGeneratorCollationTest : public WildcardKeyGeneratorTest {};
 
@@ -363,6 +363,13 @@ MONGO_INITIALIZER_GENERAL(ServerLogRedirection,
         }
     }
 
+    if (lv2Config.fileEnabled) {
+        lv2Config.fileAsyncBufferEntries = gLogAsyncBufferEntries;
+        lv2Config.fileAsyncOverflowPolicy = gLogAsyncOverflowPolicy == "drop"
+            ? logv2::AsyncOverflowPolicy::kDrop
+            : logv2::AsyncOverflowPolicy::kBlock;
+    }
+
     lv2Config.timestampFormat = serverGlobalParams.logTimestampFormat;
     Status result = lv2Manager.getGlobalDomainInternal().configure(lv2Config);
     if (result.isOK() && writeServerRestartedAfterLogConfig) {
@@ -512,6 +519,15 @@ Status ProcessUMaskServerParameter::setFromString(const std::string& value) {
 #endif
 }
 
+Status validateLogAsyncOverflowPolicy(const std::string& policy) {
+    if (policy != "block" && policy != "drop") {
+        return {ErrorCodes::BadValue,
+                str::stream() << "'" << policy
+                              << "' is not a valid log overflow policy, expected 'block' or 'drop'"};
+    }
+    return Status::OK();
+}
+
 void ProcessUMaskServerParameter::append(OperationContext*,
                                          BSONObjBuilder& b,
                                          const std::string& name) {
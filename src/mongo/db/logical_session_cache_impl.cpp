@@ -245,6 +245,7 @@ void LogicalSessionCacheImpl::_refresh(Client* client) {
         // Clear the refresh-related stats with the beginning of our run.
         _stats.setLastSessionsCollectionJobDurationMillis(0);
         _stats.setLastSessionsCollectionJobEntriesRefreshed(0);
+        _stats.setLastSessionsCollectionJobEntriesSkipped(0);
         _stats.setLastSessionsCollectionJobEntriesEnded(0);
         _stats.setLastSessionsCollectionJobCursorsClosed(0);
 
@@ -320,12 +321,61 @@ void LogicalSessionCacheImpl::_refresh(Client* client) {
         activeSessionRecords.insert(it.second);
     }
 
+    // Skip the sessions whose record was written less than the write granularity ago. The cached
+    // ones stay in the cache and are written by a later refresh, so the lastUse of a record is
+    // never more than the write granularity behind.
+    const auto now = _service->now();
+    const auto writeGranularity = _getWriteGranularity();
+    LogicalSessionIdMap<LogicalSessionRecord> deferredSessions;
+    size_t numSkipped = 0;
+    if (writeGranularity > Milliseconds(0)) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        for (auto it = activeSessionRecords.begin(); it != activeSessionRecords.end();) {
+            auto lastWriteIt = _lastWriteTimes.find(it->getId());
+            if (lastWriteIt == _lastWriteTimes.end() ||
+                now - lastWriteIt->second >= writeGranularity) {
+                ++it;
+                continue;
+            }
+
+            auto cachedIt = activeSessions.find(it->getId());
+            if (cachedIt != activeSessions.end()) {
+                deferredSessions.emplace(*cachedIt);
+            }
+            it = activeSessionRecords.erase(it);
+            ++numSkipped;
+        }
+    }
+
     // Refresh the active sessions in the sessions collection.
     _sessionsColl->refreshSessions(opCtx, activeSessionRecords);
     activeSessionsBackSwapper.dismiss();
     {
         stdx::lock_guard<Latch> lk(_mutex);
         _stats.setLastSessionsCollectionJobEntriesRefreshed(activeSessionRecords.size());
+        _stats.setLastSessionsCollectionJobEntriesSkipped(numSkipped);
+
+        if (writeGranularity > Milliseconds(0)) {
+            // Forget the writes which are too old to defer another write.
+            for (auto it = _lastWriteTimes.begin(); it != _lastWriteTimes.end();) {
+                if (now - it->second >= writeGranularity) {
+                    it = _lastWriteTimes.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            for (const auto& record : activeSessionRecords) {
+                _lastWriteTimes[record.getId()] = now;
+            }
+
+            // Sessions used again since the refresh started are already back in the cache, with a
+            // later lastUse.
+            for (auto& deferredSession : deferredSessions) {
+                _activeSessions.emplace(std::move(deferredSession));
+            }
+        } else {
+            _lastWriteTimes.clear();
+        }
     }
 
     // Remove the ending sessions from the sessions collection.
@@ -334,6 +384,9 @@ void LogicalSessionCacheImpl::_refresh(Client* client) {
     {
         stdx::lock_guard<Latch> lk(_mutex);
         _stats.setLastSessionsCollectionJobEntriesEnded(explicitlyEndingSessions.size());
+        for (const auto& lsid : explicitlyEndingSessions) {
+            _lastWriteTimes.erase(lsid);
+        }
     }
 
     // Find which running, but not recently active sessions, are expired, and add them
@@ -379,6 +432,13 @@ void LogicalSessionCacheImpl::_refresh(Client* client) {
     }
 }
 
+Milliseconds LogicalSessionCacheImpl::_getWriteGranularity() const {
+    // Writing each record at least twice per session timeout keeps the sessions that are still in
+    // use from expiring.
+    return std::min(Milliseconds(gLogicalSessionRefreshWriteGranularityMillis.load()),
+                    duration_cast<Milliseconds>(Minutes(localLogicalSessionTimeoutMinutes)) / 2);
+}
+
 void LogicalSessionCacheImpl::endSessions(const LogicalSessionIdSet& sessions) {
     stdx::lock_guard<Latch> lk(_mutex);
     _endingSessions.insert(begin(sessions), end(sessions));
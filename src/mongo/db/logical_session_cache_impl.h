@@ -51,6 +51,11 @@ namespace mongo {
  *    every 5 minutes (300,000). If the caller is setting the sessionTimeout by hand, it is
  *    suggested that they consider also setting the refresh interval accordingly.
  *      --setParameter logicalSessionRefreshMillis=X.
+ *
+ *  - The minimum interval between two writes of the record of the same session. Refreshes skip
+ *    the sessions written more recently, which saves rewriting the records of sessions in constant
+ *    use at every refresh. Disabled (0) by default.
+ *      --setParameter logicalSessionRefreshWriteGranularityMillis=X.
  */
 class LogicalSessionCacheImpl final : public LogicalSessionCache {
 public:
@@ -103,6 +108,11 @@ private:
 
     Status _addToCacheIfNotFull(WithLock, LogicalSessionRecord record);
 
+    /**
+     * Returns the minimum interval between two writes of the record of the same session.
+     */
+    Milliseconds _getWriteGranularity() const;
+
     const std::unique_ptr<ServiceLiaison> _service;
     const std::shared_ptr<SessionsCollection> _sessionsColl;
     const ReapSessionsOlderThanFn _reapSessionsOlderThanFn;
@@ -114,6 +124,10 @@ private:
 
     LogicalSessionIdSet _endingSessions;
 
+    // When the refreshes last wrote the record of each session, for the sessions written less than
+    // the write granularity ago.
+    LogicalSessionIdMap<Date_t> _lastWriteTimes;
+
     Date_t _lastRefreshTime;
 
     LogicalSessionCacheStats _stats;
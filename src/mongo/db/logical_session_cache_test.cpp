@@ -50,6 +50,7 @@
 #include "mongo/stdx/future.h"
 #include "mongo/unittest/ensure_fcv.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -216,6 +217,43 @@ TEST_F(LogicalSessionCacheTest, ManySignedLsidsInCacheRefresh) {
     ASSERT_OK(cache()->refreshNow(opCtx()));
 }
 
+// Test that refreshes skip the sessions written less than the write granularity ago, and write
+// them once the granularity has passed
+TEST_F(LogicalSessionCacheTest, RefreshSkipsRecentlyWrittenSessions) {
+    const auto originalGranularity = gLogicalSessionRefreshWriteGranularityMillis.load();
+    gLogicalSessionRefreshWriteGranularityMillis.store(durationCount<Milliseconds>(Minutes(10)));
+    ON_BLOCK_EXIT([&] { gLogicalSessionRefreshWriteGranularityMillis.store(originalGranularity); });
+
+    auto lsid = makeLogicalSessionIdForTest();
+    ASSERT_OK(cache()->startSession(opCtx(), makeLogicalSessionRecord(lsid, service()->now())));
+
+    size_t numRefreshed = 0;
+    sessions()->setRefreshHook([&numRefreshed](const LogicalSessionRecordSet& sessions) {
+        numRefreshed = sessions.size();
+    });
+
+    // The first refresh writes the new session.
+    ASSERT_OK(cache()->refreshNow(opCtx()));
+    ASSERT_EQ(1U, numRefreshed);
+    ASSERT_EQ(0U, cache()->size());
+
+    // The session was written less than the granularity ago, so the next refresh skips it but
+    // keeps it in the cache.
+    service()->fastForward(Minutes(5));
+    ASSERT_OK(cache()->vivify(opCtx(), lsid));
+    ASSERT_OK(cache()->refreshNow(opCtx()));
+    ASSERT_EQ(0U, numRefreshed);
+    ASSERT_EQ(1U, cache()->size());
+    ASSERT_EQ(1, cache()->getStats().getLastSessionsCollectionJobEntriesSkipped());
+
+    // Once the granularity has passed, the session is written again.
+    service()->fastForward(Minutes(5));
+    ASSERT_OK(cache()->refreshNow(opCtx()));
+    ASSERT_EQ(1U, numRefreshed);
+    ASSERT_EQ(0U, cache()->size());
+    ASSERT_EQ(0, cache()->getStats().getLastSessionsCollectionJobEntriesSkipped());
+}
+
 //
 TEST_F(LogicalSessionCacheTest, RefreshMatrixSessionState) {
     const std::vector<std::vector<std::string>> stateNames = {
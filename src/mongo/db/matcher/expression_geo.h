@@ -112,6 +112,14 @@ public:
         return *_query;
     }
 
+    /**
+     * Returns the original geo specification provided by the user, from which the geometry of
+     * this expression was parsed.
+     */
+    const BSONObj& getRawObj() const {
+        return _rawObj;
+    }
+
     void acceptVisitor(MatchExpressionMutableVisitor* visitor) final {
         visitor->visit(this);
     }
@@ -221,7 +221,8 @@ RegexMatchExpression::RegexMatchExpression(StringData path,
     : LeafMatchExpression(REGEX, path, std::move(annotation)),
       _regex(regex.toString()),
       _flags(options.toString()),
-      _re(new pcrecpp::RE(_regex.c_str(), regex_util::flagsToPcreOptions(_flags, true))) {
+      _re(regex_util::getCompiledRegex(
+          _regex, regex_util::flagsToPcreOptions(_flags, true).all_options())) {
 
     uassert(ErrorCodes::BadValue,
             "Regular expression cannot contain an embedded null byte",
@@ -251,11 +252,9 @@ bool RegexMatchExpression::matchesSingleElement(const BSONElement& e, MatchDetai
     switch (e.type()) {
         case String:
         case Symbol: {
-            // String values stored in documents can contain embedded NUL bytes. We construct a
-            // pcrecpp::StringPiece instance using the full length of the string to avoid truncating
-            // 'data' early.
-            pcrecpp::StringPiece data(e.valuestr(), e.valuestrsize() - 1);
-            return _re->PartialMatch(data);
+            // String values stored in documents can contain embedded NUL bytes. We use the full
+            // length of the string to avoid truncating it early.
+            return _re->partialMatch(StringData(e.valuestr(), e.valuestrsize() - 1));
         }
         case RegEx:
             return _regex == e.regex() && _flags == e.regexFlags();
@@ -40,6 +40,7 @@
 #include "mongo/db/matcher/expression_path.h"
 #include "mongo/db/query/collation/collator_interface.h"
 #include "mongo/stdx/unordered_map.h"
+#include "mongo/util/regex_util.h"
 
 namespace pcrecpp {
 class RE;
@@ -466,7 +467,7 @@ private:
 
     std::string _regex;
     std::string _flags;
-    std::unique_ptr<pcrecpp::RE> _re;
+    std::shared_ptr<const regex_util::CompiledRegex> _re;
 };
 
 class ModMatchExpression : public LeafMatchExpression {
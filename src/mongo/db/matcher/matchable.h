@@ -29,6 +29,9 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+
+#include "mongo/bson/bson_field_index.h"
 #include "mongo/bson/bsonobj.h"
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/field_ref.h"
@@ -84,10 +87,11 @@ public:
     }
 
     virtual ElementIterator* allocateIterator(const ElementPath* path) const {
+        auto fieldIndex = _getFieldIndex();
         if (_iteratorUsed)
-            return new BSONElementIterator(path, _obj);
+            return new BSONElementIterator(path, _obj, fieldIndex);
         _iteratorUsed = true;
-        _iterator.reset(path, _obj);
+        _iterator.reset(path, _obj, fieldIndex);
         return &_iterator;
     }
 
@@ -100,9 +104,24 @@ public:
     }
 
 private:
+    // Indexing the fields of the document costs about as much as several scans for a field, so
+    // only large documents in which many paths are looked up are indexed.
+    static constexpr int kMinObjSizeToIndex = 1024;
+    static constexpr int kLookupsBeforeIndexing = 4;
+
+    const BSONObjFieldIndex* _getFieldIndex() const {
+        if (!_fieldIndex && ++_numLookups > kLookupsBeforeIndexing &&
+            _obj.objsize() >= kMinObjSizeToIndex) {
+            _fieldIndex.emplace(_obj);
+        }
+        return _fieldIndex.get_ptr();
+    }
+
     BSONObj _obj;
     mutable BSONElementIterator _iterator;
     mutable bool _iteratorUsed;
+    mutable int _numLookups = 0;
+    mutable boost::optional<BSONObjFieldIndex> _fieldIndex;
 };
 
 /**
@@ -125,6 +125,32 @@ TEST(Path, Nested1) {
     ASSERT(!cursor.more());
 }
 
+TEST(Path, FieldIndexFindsFirstPart) {
+    BSONObj doc = BSON("x" << 4 << "a" << BSON_ARRAY(BSON("b" << 5) << BSON("b" << 7)) << "c"
+                           << BSON("d" << 9));
+    BSONObjFieldIndex fieldIndex(doc);
+
+    ElementPath nested{"a.b"};
+    BSONElementIterator cursor(&nested, doc, &fieldIndex);
+    ASSERT(cursor.more());
+    ASSERT_EQUALS(5, cursor.next().element().numberInt());
+    ASSERT(cursor.more());
+    ASSERT_EQUALS(7, cursor.next().element().numberInt());
+    ASSERT(!cursor.more());
+
+    ElementPath dotted{"c.d"};
+    cursor.reset(&dotted, doc, &fieldIndex);
+    ASSERT(cursor.more());
+    ASSERT_EQUALS(9, cursor.next().element().numberInt());
+    ASSERT(!cursor.more());
+
+    ElementPath missing{"y"};
+    cursor.reset(&missing, doc, &fieldIndex);
+    ASSERT(cursor.more());
+    ASSERT(cursor.next().element().eoo());
+    ASSERT(!cursor.more());
+}
+
 TEST(Path, NestedPartialMatchScalar) {
     ElementPath p{"a.b"};
 
@@ -55,6 +55,7 @@
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/collection_catalog.h"
 #include "mongo/db/catalog/collection_impl.h"
+#include "mongo/db/catalog/collection_lazy_init.h"
 #include "mongo/db/catalog/create_collection.h"
 #include "mongo/db/catalog/database.h"
 #include "mongo/db/catalog/database_holder_impl.h"
@@ -69,6 +70,7 @@
 #include "mongo/db/commands/shutdown.h"
 #include "mongo/db/commands/test_commands.h"
 #include "mongo/db/commands/test_commands_enabled.h"
+#include "mongo/db/compaction_monitor.h"
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/concurrency/flow_control_ticketholder.h"
 #include "mongo/db/concurrency/lock_state.h"
@@ -696,6 +698,7 @@ ExitCode _initAndListen(ServiceContext* serviceContext, int listenPort) {
         } else {
             startTTLMonitor(serviceContext);
         }
+        startCompactionMonitor(serviceContext);
 
         if (replSettings.usingReplSets() || !gInternalValidateFeaturesAsPrimary) {
             serverGlobalParams.validateFeaturesAsPrimary.store(false);
@@ -704,6 +707,8 @@ ExitCode _initAndListen(ServiceContext* serviceContext, int listenPort) {
 
     startClientCursorMonitor();
 
+    startIdleCollectionDehydrator(serviceContext);
+
     PeriodicTask::startRunningPeriodicTasks();
 
     SessionKiller::set(serviceContext,
@@ -1164,6 +1169,8 @@ void shutdownTask(const ShutdownTaskArgs& shutdownArgs) {
         exec->join();
     }
 
+    stopIdleCollectionDehydrator(serviceContext);
+
     if (auto storageEngine = serviceContext->getStorageEngine()) {
         if (storageEngine->supportsReadConcernSnapshot()) {
             LOGV2(4784908, "Shutting down the PeriodicThreadToAbortExpiredTransactions");
@@ -1308,6 +1315,9 @@ void shutdownTask(const ShutdownTaskArgs& shutdownArgs) {
     LOGV2(4784928, "Shutting down the TTL monitor");
     shutdownTTLMonitor(serviceContext);
 
+    LOGV2(5591728, "Shutting down the compaction monitor");
+    shutdownCompactionMonitor(serviceContext);
+
     // We should always be able to acquire the global lock at shutdown.
     // An OperationContext is not necessary to call lockGlobal() during shutdown, as it's only used
     // to check that lockGlobal() is not called after a transaction timestamp has been set.
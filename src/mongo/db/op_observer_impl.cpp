@@ -50,6 +50,7 @@
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/op_observer_util.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/query/query_result_cache.h"
 #include "mongo/db/read_write_concern_defaults.h"
 #include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/oplog_entry_gen.h"
@@ -443,6 +444,8 @@ void OpObserverImpl::onInserts(OperationContext* opCtx,
                                std::vector<InsertStatement>::const_iterator first,
                                std::vector<InsertStatement>::const_iterator last,
                                bool fromMigrate) {
+    QueryResultCache::get(opCtx->getServiceContext())->onWrite(opCtx, nss);
+
     auto txnParticipant = TransactionParticipant::get(opCtx);
     const bool inMultiDocumentTransaction =
         txnParticipant && opCtx->writesAreReplicated() && txnParticipant.transactionIsOpen();
@@ -544,6 +547,8 @@ void OpObserverImpl::onUpdate(OperationContext* opCtx, const OplogUpdateEntryArg
             return !collElem || args.nss.ns() == collElem.String();
         });
 
+    QueryResultCache::get(opCtx->getServiceContext())->onWrite(opCtx, args.nss);
+
     // Do not log a no-op operation; see SERVER-21738
     if (args.updateArgs.update.isEmpty()) {
         return;
@@ -622,6 +627,8 @@ void OpObserverImpl::onDelete(OperationContext* opCtx,
                               StmtId stmtId,
                               bool fromMigrate,
                               const boost::optional<BSONObj>& deletedDoc) {
+    QueryResultCache::get(opCtx->getServiceContext())->onWrite(opCtx, nss);
+
     auto optDocKey = documentKeyDecoration(opCtx);
     invariant(optDocKey, nss.ns());
     auto& documentKey = optDocKey.get();
@@ -791,6 +798,8 @@ void OpObserverImpl::onDropDatabase(OperationContext* opCtx, const std::string&
     if (dbName == NamespaceString::kSessionTransactionsTableNamespace.db()) {
         MongoDSessionCatalog::invalidateAllSessions(opCtx);
     }
+
+    QueryResultCache::get(opCtx->getServiceContext())->invalidateAll();
 }
 
 repl::OpTime OpObserverImpl::onDropCollection(OperationContext* opCtx,
@@ -837,6 +846,8 @@ repl::OpTime OpObserverImpl::onDropCollection(OperationContext* opCtx,
         ReadWriteConcernDefaults::get(opCtx).invalidate();
     }
 
+    QueryResultCache::get(opCtx->getServiceContext())->onWrite(opCtx, collectionName);
+
     return {};
 }
 
@@ -892,6 +903,10 @@ void OpObserverImpl::postRenameCollection(OperationContext* const opCtx,
         DurableViewCatalog::onExternalChange(opCtx, fromCollection);
     if (toCollection.isSystemDotViews())
         DurableViewCatalog::onExternalChange(opCtx, toCollection);
+
+    auto queryResultCache = QueryResultCache::get(opCtx->getServiceContext());
+    queryResultCache->onWrite(opCtx, fromCollection);
+    queryResultCache->onWrite(opCtx, toCollection);
 }
 
 void OpObserverImpl::onRenameCollection(OperationContext* const opCtx,
@@ -922,6 +937,8 @@ void OpObserverImpl::onImportCollection(OperationContext* opCtx,
     oplogEntry.setNss(nss.getCommandNS());
     oplogEntry.setObject(importCollection.toBSON());
     logOperation(opCtx, &oplogEntry);
+
+    QueryResultCache::get(opCtx->getServiceContext())->onWrite(opCtx, nss);
 }
 
 void OpObserverImpl::onApplyOps(OperationContext* opCtx,
@@ -946,6 +963,8 @@ void OpObserverImpl::onEmptyCapped(OperationContext* opCtx,
         oplogEntry.setObject(BSON("emptycapped" << collectionName.coll()));
         logOperation(opCtx, &oplogEntry);
     }
+
+    QueryResultCache::get(opCtx->getServiceContext())->onWrite(opCtx, collectionName);
 }
 
 namespace {
@@ -1401,6 +1420,9 @@ void OpObserverImpl::onReplicationRollback(OperationContext* opCtx,
     // Force the default read/write concern cache to reload on next access in case the defaults
     // document was rolled back.
     ReadWriteConcernDefaults::get(opCtx).invalidate();
+
+    // Rollback changes the data without going through the write observers.
+    QueryResultCache::get(opCtx->getServiceContext())->invalidateAll();
 }
 
 }  // namespace mongo
@@ -0,0 +1,273 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+
+#include "mongo/platform/basic.h"
+
+#include <boost/optional.hpp>
+
+#if defined(__linux__)
+#include <array>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif  // defined(__linux__)
+
+#include "mongo/db/operation_hardware_counters.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/client.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+OperationHardwareCounters::Counts& OperationHardwareCounters::Counts::operator+=(
+    const Counts& other) {
+    cycles += other.cycles;
+    instructions += other.instructions;
+    llcMisses += other.llcMisses;
+    contextSwitches += other.contextSwitches;
+    return *this;
+}
+
+OperationHardwareCounters::Counts& OperationHardwareCounters::Counts::operator-=(
+    const Counts& other) {
+    cycles -= other.cycles;
+    instructions -= other.instructions;
+    llcMisses -= other.llcMisses;
+    contextSwitches -= other.contextSwitches;
+    return *this;
+}
+
+void OperationHardwareCounters::Counts::appendNonZero(BSONObjBuilder* builder) const {
+    auto appendNonZeroCount = [&](StringData name, long long count) {
+        if (count > 0) {
+            builder->appendNumber(name, count);
+        }
+    };
+    appendNonZeroCount("cycles", cycles);
+    appendNonZeroCount("instructions", instructions);
+    appendNonZeroCount("llcMisses", llcMisses);
+    appendNonZeroCount("contextSwitches", contextSwitches);
+}
+
+#if defined(__linux__)
+
+namespace {
+
+int openPerfEvent(perf_event_attr* attr, int groupFd) {
+    // Counts the events of the calling thread on any CPU.
+    return syscall(__NR_perf_event_open, attr, 0, -1, groupFd, PERF_FLAG_FD_CLOEXEC);
+}
+
+/**
+ * The performance counters of the current thread. They are opened on first use and stay enabled
+ * for the life of the thread, so that counting the events of an operation only takes reading them
+ * as it starts and stops. Cycles, instructions and last level cache misses are read together as a
+ * group, so that they cover the same span of time. Context switches are a software event, which
+ * remains available where the hardware counters are not, such as in many virtual machines.
+ */
+class ThreadCounters {
+public:
+    static ThreadCounters& get() {
+        thread_local ThreadCounters counters;  // NOLINT
+        return counters;
+    }
+
+    ThreadCounters(const ThreadCounters&) = delete;
+    ThreadCounters& operator=(const ThreadCounters&) = delete;
+
+    ~ThreadCounters() {
+        for (int fd : _hardwareFds) {
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+        if (_contextSwitchesFd >= 0) {
+            close(_contextSwitchesFd);
+        }
+    }
+
+    bool isOpen() const {
+        return _hardwareFds[0] >= 0 || _contextSwitchesFd >= 0;
+    }
+
+    OperationHardwareCounters::Counts read() const {
+        OperationHardwareCounters::Counts counts;
+        if (_hardwareFds[0] >= 0) {
+            struct {
+                uint64_t nr;
+                uint64_t values[kNumHardwareEvents];
+            } group;
+            if (::read(_hardwareFds[0], &group, sizeof(group)) == sizeof(group)) {
+                counts.cycles = group.values[0];
+                counts.instructions = group.values[1];
+                counts.llcMisses = group.values[2];
+            }
+        }
+        if (_contextSwitchesFd >= 0) {
+            uint64_t value;
+            if (::read(_contextSwitchesFd, &value, sizeof(value)) == sizeof(value)) {
+                counts.contextSwitches = value;
+            }
+        }
+        return counts;
+    }
+
+private:
+    static constexpr size_t kNumHardwareEvents = 3;
+
+    ThreadCounters() {
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+
+        const std::array<uint64_t, kNumHardwareEvents> events{
+            PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES};
+        for (size_t i = 0; i < events.size(); ++i) {
+            attr.config = events[i];
+            _hardwareFds[i] = openPerfEvent(&attr, i == 0 ? -1 : _hardwareFds[0]);
+            if (_hardwareFds[i] < 0) {
+                // The group is only useful if all of its events can be counted.
+                for (size_t j = 0; j < i; ++j) {
+                    close(_hardwareFds[j]);
+                    _hardwareFds[j] = -1;
+                }
+                break;
+            }
+        }
+
+        perf_event_attr contextSwitchesAttr{};
+        contextSwitchesAttr.size = sizeof(contextSwitchesAttr);
+        contextSwitchesAttr.type = PERF_TYPE_SOFTWARE;
+        contextSwitchesAttr.config = PERF_COUNT_SW_CONTEXT_SWITCHES;
+        _contextSwitchesFd = openPerfEvent(&contextSwitchesAttr, -1);
+    }
+
+    std::array<int, kNumHardwareEvents> _hardwareFds{-1, -1, -1};
+    int _contextSwitchesFd = -1;
+};
+
+class PerfEventCounters final : public OperationHardwareCounters {
+public:
+    Counts getCounts() const override;
+
+    bool isRunning() const override {
+        return _startedOn.has_value();
+    }
+
+    void start() override;
+    void stop() override;
+
+    void onThreadAttach() override;
+    void onThreadDetach() override;
+
+private:
+    bool _isAttachedToCurrentThread() const {
+        return _threadId.has_value() && _threadId.get() == stdx::this_thread::get_id();
+    }
+
+    // Holds the counts of the current thread at the time of starting/resuming the counters.
+    boost::optional<Counts> _startedOn;
+    boost::optional<stdx::thread::id> _threadId;
+    Counts _countsBeforeInterrupted;
+};
+
+OperationHardwareCounters::Counts PerfEventCounters::getCounts() const {
+    auto counts = _countsBeforeInterrupted;
+    if (isRunning() && _isAttachedToCurrentThread()) {
+        counts += ThreadCounters::get().read();
+        counts -= *_startedOn;
+    }
+    return counts;
+}
+
+void PerfEventCounters::start() {
+    invariant(!isRunning(), "Counters have already started");
+
+    _startedOn = ThreadCounters::get().read();
+    _threadId = stdx::this_thread::get_id();
+    _countsBeforeInterrupted = Counts();
+}
+
+void PerfEventCounters::stop() {
+    invariant(isRunning(), "Counters are not running");
+    invariant(_isAttachedToCurrentThread());
+
+    _countsBeforeInterrupted = getCounts();
+    _startedOn.reset();
+}
+
+void PerfEventCounters::onThreadAttach() {
+    if (!isRunning())
+        return;
+
+    invariant(!_threadId.has_value(), "Counters have already been attached");
+    _threadId = stdx::this_thread::get_id();
+    _startedOn = ThreadCounters::get().read();
+}
+
+void PerfEventCounters::onThreadDetach() {
+    if (!isRunning())
+        return;
+
+    invariant(_threadId.has_value(), "Counters are not attached");
+    _countsBeforeInterrupted = getCounts();
+    _threadId.reset();
+}
+
+const auto getPerfEventCounters = OperationContext::declareDecoration<PerfEventCounters>();
+
+}  // namespace
+
+OperationHardwareCounters* OperationHardwareCounters::get(OperationContext* opCtx) {
+    invariant(Client::getCurrent() && Client::getCurrent()->getOperationContext() == opCtx,
+              "Operation not attached to the current thread");
+
+    // Performance counters may be unavailable to the process, for instance if the kernel restricts
+    // them through 'perf_event_paranoid' or a seccomp filter.
+    static const bool areCountersSupported = ThreadCounters::get().isOpen();
+
+    if (!areCountersSupported)
+        return nullptr;
+    return &getPerfEventCounters(opCtx);
+}
+
+#else  // not defined(__linux__)
+
+OperationHardwareCounters* OperationHardwareCounters::get(OperationContext*) {
+    return nullptr;
+}
+
+#endif  // defined(__linux__)
+
+}  // namespace mongo
@@ -0,0 +1,118 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/operation_hardware_counters.h"
+
+#include "mongo/db/service_context_test_fixture.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+class OperationHardwareCountersTest : public ServiceContextTest {
+public:
+    void setUp() {
+        _opCtx = getGlobalServiceContext()->makeOperationContext(Client::getCurrent());
+    }
+
+    OperationHardwareCounters* getCounters() const {
+        return OperationHardwareCounters::get(_opCtx.get());
+    }
+
+    // Does some work which the optimizer cannot remove, to make the counters advance.
+    void spin() const {
+        volatile long long sum = 0;
+        for (int i = 0; i < 100 * 1000; ++i) {
+            sum = sum + i;
+        }
+    }
+
+private:
+    ServiceContext::UniqueOperationContext _opCtx;
+};
+
+TEST_F(OperationHardwareCountersTest, CountsOnlyWhileRunning) {
+    auto counters = getCounters();
+    if (!counters) {
+        // The counters are not available on this platform or to this process.
+        return;
+    }
+
+    counters->start();
+    spin();
+    counters->stop();
+    const auto countsAfterStop = counters->getCounts();
+
+    spin();
+    const auto countsAfterSpin = counters->getCounts();
+    ASSERT_EQ(countsAfterStop.cycles, countsAfterSpin.cycles);
+    ASSERT_EQ(countsAfterStop.instructions, countsAfterSpin.instructions);
+    ASSERT_EQ(countsAfterStop.llcMisses, countsAfterSpin.llcMisses);
+    ASSERT_EQ(countsAfterStop.contextSwitches, countsAfterSpin.contextSwitches);
+}
+
+TEST_F(OperationHardwareCountersTest, ResetsOnStart) {
+    auto counters = getCounters();
+    if (!counters) {
+        return;
+    }
+
+    counters->start();
+    spin();
+    counters->stop();
+    const auto instructions = counters->getCounts().instructions;
+
+    counters->start();
+    ASSERT_LTE(counters->getCounts().instructions, instructions);
+    counters->stop();
+}
+
+TEST_F(OperationHardwareCountersTest, KeepsCountsAcrossThreadDetachAndAttach) {
+    auto counters = getCounters();
+    if (!counters) {
+        return;
+    }
+
+    counters->start();
+    spin();
+    const auto countsBeforeDetach = counters->getCounts();
+    {
+        auto client = getGlobalServiceContext()->makeClient("AlternativeClient");
+        AlternativeClientRegion acr(client);
+    }
+    const auto countsAfterAttach = counters->getCounts();
+    counters->stop();
+
+    ASSERT_GTE(countsAfterAttach.instructions, countsBeforeDetach.instructions);
+    ASSERT_GTE(countsAfterAttach.contextSwitches, countsBeforeDetach.contextSwitches);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -432,4 +432,107 @@ private:
     MutableDocument _output;
 };
 
+/**
+ * Estimates the number of distinct values in a group using a HyperLogLog sketch. Small groups are
+ * counted exactly by keeping the set of value hashes; once that set grows past a fixed size, it is
+ * folded into a fixed-size array of registers, so the memory used by each group is bounded no
+ * matter how many distinct values it sees. Values are hashed with the expression context's value
+ * comparator, so values which compare equal, such as 1 and 1.0, are counted once.
+ */
+class AccumulatorApproxCountDistinct final : public AccumulatorState {
+public:
+    // The number of index bits taken from each hash, which determines the number of registers.
+    static constexpr int kPrecision = 14;
+    static constexpr size_t kNumRegisters = size_t{1} << kPrecision;
+
+    // The number of distinct hashes kept before the sketch switches to the register array.
+    static constexpr size_t kMaxSparseHashes = 512;
+
+    explicit AccumulatorApproxCountDistinct(ExpressionContext* const expCtx);
+
+    void processInternal(const Value& input, bool merging) final;
+    Value getValue(bool toBeMerged) final;
+    const char* getOpName() const final;
+    void reset() final;
+
+    static boost::intrusive_ptr<AccumulatorState> create(ExpressionContext* const expCtx);
+
+    bool isAssociative() const final {
+        return true;
+    }
+
+    bool isCommutative() const final {
+        return true;
+    }
+
+private:
+    void addHash(uint64_t hash);
+    void convertToDense();
+    void updateMemUsage();
+    long long estimate() const;
+
+    stdx::unordered_set<uint64_t> _sparseHashes;
+
+    // Empty until the sketch switches to the register array, after which it has 'kNumRegisters'
+    // entries, each holding the largest leading zero count (plus one) seen for that register.
+    std::vector<uint8_t> _registers;
+};
+
+/**
+ * Estimates a percentile of the numeric values in a group using a merging t-digest. The digest
+ * keeps at most a few hundred weighted centroids, which are kept small near the extremes of the
+ * distribution so that tail percentiles such as p99 stay accurate. Non-numeric values are
+ * ignored, and the result is null if the group has no numeric values.
+ */
+class AccumulatorApproxPercentile final : public AccumulatorState {
+public:
+    static constexpr StringData kName = "$approxPercentile"_sd;
+
+    // Bounds the number of centroids in the digest; larger values are more accurate.
+    static constexpr double kCompression = 100;
+
+    AccumulatorApproxPercentile(ExpressionContext* const expCtx, double percentile);
+
+    void processInternal(const Value& input, bool merging) final;
+    Value getValue(bool toBeMerged) final;
+    const char* getOpName() const final;
+    void reset() final;
+
+    Document serialize(boost::intrusive_ptr<Expression> initializer,
+                       boost::intrusive_ptr<Expression> argument,
+                       bool explain) const final;
+
+    bool isAssociative() const final {
+        return true;
+    }
+
+    bool isCommutative() const final {
+        return true;
+    }
+
+private:
+    struct Centroid {
+        double mean;
+        double weight;
+    };
+
+    void addCentroid(double mean, double weight);
+
+    /**
+     * Merges the buffered values into the centroids, combining neighbouring centroids as long as
+     * the size bound given by the t-digest scale function allows it.
+     */
+    void compress();
+
+    double quantile(double q) const;
+
+    const double _percentile;
+
+    std::vector<Centroid> _centroids;
+    std::vector<Centroid> _buffer;
+    double _totalWeight = 0;
+    double _min = 0;
+    double _max = 0;
+};
+
 }  // namespace mongo
@@ -0,0 +1,224 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/accumulator.h"
+
+#include <cmath>
+
+#include "mongo/base/data_view.h"
+#include "mongo/bson/util/builder.h"
+#include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/pipeline/accumulation_statement.h"
+#include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/pipeline/window_function/window_function_expression.h"
+
+namespace mongo {
+
+using boost::intrusive_ptr;
+
+REGISTER_ACCUMULATOR_WITH_MIN_VERSION(
+    approxCountDistinct,
+    genericParseSingleExpressionAccumulator<AccumulatorApproxCountDistinct>,
+    ServerGlobalParams::FeatureCompatibility::Version::kVersion49);
+REGISTER_WINDOW_FUNCTION(
+    approxCountDistinct,
+    window_function::ExpressionFromAccumulator<AccumulatorApproxCountDistinct>::parse);
+
+namespace {
+// The first byte of a partial result produced by getValue(true) says which of these follows it:
+// either a list of 8-byte hashes, or 'kNumRegisters' one-byte registers.
+constexpr char kSparseFormat = 0;
+constexpr char kDenseFormat = 1;
+
+// Below this estimate, linear counting over the empty registers is more accurate than the raw
+// HyperLogLog estimate. This is the threshold given for precision 14 in the HyperLogLog++ paper.
+constexpr double kLinearCountingThreshold = 11500;
+
+/**
+ * Mixes the bits of 'hash' so that every bit of the result depends on every bit of the input. The
+ * value comparator's hash is not guaranteed to spread similar values across the high bits that
+ * the sketch relies on.
+ */
+uint64_t mixHash(uint64_t hash) {
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+uint8_t countLeadingZeros(uint64_t bits) {
+    uint8_t count = 0;
+    for (uint64_t mask = uint64_t{1} << 63; mask && !(bits & mask); mask >>= 1) {
+        ++count;
+    }
+    return count;
+}
+}  // namespace
+
+const char* AccumulatorApproxCountDistinct::getOpName() const {
+    return "$approxCountDistinct";
+}
+
+void AccumulatorApproxCountDistinct::processInternal(const Value& input, bool merging) {
+    if (!merging) {
+        if (!input.missing()) {
+            addHash(mixHash(getExpressionContext()->getValueComparator().hash(input)));
+        }
+        return;
+    }
+
+    // This is what getValue(true) produced below.
+    uassert(5502100,
+            "$approxCountDistinct expected a BinData partial result to merge",
+            input.getType() == BinData);
+    auto partial = input.getBinData();
+    uassert(5502101, "$approxCountDistinct received an empty partial result", partial.length > 0);
+    const char* data = static_cast<const char*>(partial.data);
+    ConstDataView view(data + 1);
+    const size_t payloadLength = partial.length - 1;
+
+    if (data[0] == kSparseFormat) {
+        uassert(5502102,
+                "$approxCountDistinct received a malformed partial result",
+                payloadLength % sizeof(uint64_t) == 0);
+        for (size_t offset = 0; offset < payloadLength; offset += sizeof(uint64_t)) {
+            addHash(view.read<LittleEndian<uint64_t>>(offset));
+        }
+    } else {
+        uassert(5502103,
+                "$approxCountDistinct received a malformed partial result",
+                data[0] == kDenseFormat && payloadLength == kNumRegisters);
+        convertToDense();
+        for (size_t i = 0; i < kNumRegisters; ++i) {
+            _registers[i] = std::max(_registers[i], view.read<uint8_t>(i));
+        }
+    }
+    updateMemUsage();
+}
+
+void AccumulatorApproxCountDistinct::addHash(uint64_t hash) {
+    if (_registers.empty()) {
+        if (_sparseHashes.insert(hash).second && _sparseHashes.size() > kMaxSparseHashes) {
+            convertToDense();
+        }
+        updateMemUsage();
+        return;
+    }
+
+    // The top bits of the hash select a register, which records the longest run of leading zeros
+    // seen in the remaining bits. A sentinel bit keeps the run from exceeding the bits available.
+    const size_t index = hash >> (64 - kPrecision);
+    const uint64_t remaining = (hash << kPrecision) | (uint64_t{1} << (kPrecision - 1));
+    _registers[index] = std::max(_registers[index], uint8_t(countLeadingZeros(remaining) + 1));
+}
+
+void AccumulatorApproxCountDistinct::convertToDense() {
+    if (!_registers.empty()) {
+        return;
+    }
+
+    _registers.assign(kNumRegisters, 0);
+    auto hashes = std::move(_sparseHashes);
+    _sparseHashes.clear();
+    for (auto hash : hashes) {
+        addHash(hash);
+    }
+    updateMemUsage();
+}
+
+void AccumulatorApproxCountDistinct::updateMemUsage() {
+    // Each hash in the set costs roughly its own size plus that of a bucket pointer.
+    _memUsageBytes = sizeof(*this) + _registers.capacity() +
+        _sparseHashes.size() * (sizeof(uint64_t) + sizeof(void*));
+}
+
+long long AccumulatorApproxCountDistinct::estimate() const {
+    if (_registers.empty()) {
+        return _sparseHashes.size();
+    }
+
+    const double m = kNumRegisters;
+    double inverseSum = 0;
+    size_t numEmptyRegisters = 0;
+    for (auto reg : _registers) {
+        inverseSum += std::ldexp(1.0, -reg);
+        numEmptyRegisters += (reg == 0);
+    }
+
+    if (numEmptyRegisters > 0) {
+        const double linearCount = m * std::log(m / numEmptyRegisters);
+        if (linearCount <= kLinearCountingThreshold) {
+            return std::llround(linearCount);
+        }
+    }
+
+    const double alpha = 0.7213 / (1 + 1.079 / m);
+    return std::llround(alpha * m * m / inverseSum);
+}
+
+Value AccumulatorApproxCountDistinct::getValue(bool toBeMerged) {
+    if (!toBeMerged) {
+        return Value(estimate());
+    }
+
+    BufBuilder buf;
+    if (_registers.empty()) {
+        buf.appendChar(kSparseFormat);
+        for (auto hash : _sparseHashes) {
+            buf.appendNum(static_cast<unsigned long long>(hash));
+        }
+    } else {
+        buf.appendChar(kDenseFormat);
+        buf.appendBuf(_registers.data(), _registers.size());
+    }
+    return Value(BSONBinData(buf.buf(), buf.len(), BinDataGeneral));
+}
+
+AccumulatorApproxCountDistinct::AccumulatorApproxCountDistinct(ExpressionContext* const expCtx)
+    : AccumulatorState(expCtx) {
+    updateMemUsage();
+}
+
+void AccumulatorApproxCountDistinct::reset() {
+    _sparseHashes.clear();
+    _registers.clear();
+    _registers.shrink_to_fit();
+    updateMemUsage();
+}
+
+intrusive_ptr<AccumulatorState> AccumulatorApproxCountDistinct::create(
+    ExpressionContext* const expCtx) {
+    return new AccumulatorApproxCountDistinct(expCtx);
+}
+
+}  // namespace mongo
@@ -0,0 +1,347 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/accumulator.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/pipeline/accumulation_statement.h"
+#include "mongo/db/pipeline/expression.h"
+#include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/pipeline/window_function/window_function_expression.h"
+
+namespace mongo {
+
+using boost::intrusive_ptr;
+
+namespace {
+// The number of values buffered before they are merged into the centroids.
+constexpr size_t kBufferSize = 5 * static_cast<size_t>(AccumulatorApproxPercentile::kCompression);
+
+double parsePercentile(BSONElement elem) {
+    uassert(5502104,
+            str::stream() << AccumulatorApproxPercentile::kName
+                          << " requires 'p' to be a number between 0 and 1",
+            elem.isNumber() && elem.numberDouble() >= 0 && elem.numberDouble() <= 1);
+    return elem.numberDouble();
+}
+
+/**
+ * Splits the arguments of {$approxPercentile: {input: <expression>, p: <number>, ...}} into the
+ * input and the percentile. Any argument named in 'otherAllowedArgs' is left for the caller;
+ * anything else is rejected.
+ */
+std::pair<BSONElement, double> parseArguments(BSONElement elem, const StringSet& otherAllowedArgs) {
+    uassert(5502105,
+            str::stream() << AccumulatorApproxPercentile::kName
+                          << " requires an object of the form {input: <expression>, p: <number>}",
+            elem.type() == BSONType::Object);
+
+    BSONElement input;
+    boost::optional<double> percentile;
+    for (auto&& arg : elem.embeddedObject()) {
+        auto argName = arg.fieldNameStringData();
+        if (argName == "input"_sd) {
+            input = arg;
+        } else if (argName == "p"_sd) {
+            percentile = parsePercentile(arg);
+        } else {
+            uassert(5502106,
+                    str::stream() << AccumulatorApproxPercentile::kName
+                                  << " found an unknown argument: " << argName,
+                    otherAllowedArgs.find(argName) != otherAllowedArgs.end());
+        }
+    }
+    uassert(5502107,
+            str::stream() << AccumulatorApproxPercentile::kName << " requires an 'input' argument",
+            input);
+    uassert(5502108,
+            str::stream() << AccumulatorApproxPercentile::kName << " requires a 'p' argument",
+            percentile);
+    return {input, *percentile};
+}
+
+AccumulationExpression parseApproxPercentile(ExpressionContext* const expCtx,
+                                             BSONElement elem,
+                                             VariablesParseState vps) {
+    auto [inputElem, percentile] = parseArguments(elem, {});
+    auto initializer = ExpressionConstant::create(expCtx, Value(BSONNULL));
+    auto argument = Expression::parseOperand(expCtx, inputElem, vps);
+    return {initializer, argument, [expCtx, percentile = percentile]() {
+                return make_intrusive<AccumulatorApproxPercentile>(expCtx, percentile);
+            }};
+}
+
+/**
+ * The window function form of $approxPercentile, which takes the same arguments as the
+ * accumulator along with the window bounds.
+ */
+class ExpressionApproxPercentile final : public window_function::Expression {
+public:
+    static intrusive_ptr<window_function::Expression> parse(
+        BSONElement elem, const boost::optional<SortPattern>& sortBy, ExpressionContext* expCtx) {
+        static const StringSet boundsArgs = {"documents", "range", "unit"};
+        auto [inputElem, percentile] = parseArguments(elem, boundsArgs);
+        auto input =
+            ::mongo::Expression::parseOperand(expCtx, inputElem, expCtx->variablesParseState);
+        auto bounds = WindowBounds::parse(elem.embeddedObject(), sortBy, expCtx);
+        return make_intrusive<ExpressionApproxPercentile>(
+            expCtx, std::move(input), percentile, std::move(bounds));
+    }
+
+    ExpressionApproxPercentile(ExpressionContext* expCtx,
+                               intrusive_ptr<::mongo::Expression> input,
+                               double percentile,
+                               WindowBounds bounds)
+        : _expCtx(expCtx),
+          _input(std::move(input)),
+          _percentile(percentile),
+          _bounds(std::move(bounds)) {}
+
+    Value serialize(boost::optional<ExplainOptions::Verbosity> explain) const final {
+        MutableDocument args;
+        args["input"] = _input->serialize(static_cast<bool>(explain));
+        args["p"] = Value(_percentile);
+        _bounds.serialize(args);
+        return Value{Document{{AccumulatorApproxPercentile::kName, args.freezeToValue()}}};
+    }
+
+    std::string getOpName() const final {
+        return AccumulatorApproxPercentile::kName.toString();
+    }
+
+    WindowBounds bounds() const final {
+        return _bounds;
+    }
+
+    intrusive_ptr<::mongo::Expression> input() const final {
+        return _input;
+    }
+
+    intrusive_ptr<AccumulatorState> buildAccumulatorOnly() const final {
+        return make_intrusive<AccumulatorApproxPercentile>(_expCtx, _percentile);
+    }
+
+private:
+    ExpressionContext* _expCtx;
+    intrusive_ptr<::mongo::Expression> _input;
+    double _percentile;
+    WindowBounds _bounds;
+};
+
+/**
+ * The t-digest scale function k1 and its inverse. A centroid may grow until it spans one unit of
+ * k, which keeps centroids near q = 0 and q = 1 much smaller than those near the median.
+ */
+double scale(double q) {
+    return AccumulatorApproxPercentile::kCompression / (2 * M_PI) * std::asin(2 * q - 1);
+}
+
+double inverseScale(double k) {
+    if (k >= AccumulatorApproxPercentile::kCompression / 4) {
+        return 1;
+    }
+    return (std::sin(k * 2 * M_PI / AccumulatorApproxPercentile::kCompression) + 1) / 2;
+}
+}  // namespace
+
+REGISTER_ACCUMULATOR_WITH_MIN_VERSION(
+    approxPercentile,
+    parseApproxPercentile,
+    ServerGlobalParams::FeatureCompatibility::Version::kVersion49);
+REGISTER_WINDOW_FUNCTION(approxPercentile, ExpressionApproxPercentile::parse);
+
+AccumulatorApproxPercentile::AccumulatorApproxPercentile(ExpressionContext* const expCtx,
+                                                         double percentile)
+    : AccumulatorState(expCtx), _percentile(percentile) {
+    _memUsageBytes = sizeof(*this);
+}
+
+const char* AccumulatorApproxPercentile::getOpName() const {
+    return kName.rawData();
+}
+
+Document AccumulatorApproxPercentile::serialize(intrusive_ptr<Expression> initializer,
+                                                intrusive_ptr<Expression> argument,
+                                                bool explain) const {
+    return DOC(getOpName() << DOC("input" << argument->serialize(explain) << "p" << _percentile));
+}
+
+void AccumulatorApproxPercentile::processInternal(const Value& input, bool merging) {
+    if (!merging) {
+        // Non-numeric values and NaN have no place in the distribution.
+        if (!input.numeric() || std::isnan(input.coerceToDouble())) {
+            return;
+        }
+        addCentroid(input.coerceToDouble(), 1);
+        return;
+    }
+
+    // This is what getValue(true) produced below.
+    verify(input.getType() == Object);
+    const auto means = input["means"];
+    const auto weights = input["weights"];
+    uassert(5502109,
+            "$approxPercentile received a malformed partial result",
+            means.isArray() && weights.isArray() &&
+                means.getArrayLength() == weights.getArrayLength());
+    if (means.getArrayLength() == 0) {
+        return;  // This partition had no data to contribute.
+    }
+
+    const double min = input["min"].coerceToDouble();
+    const double max = input["max"].coerceToDouble();
+    const bool wasEmpty = _totalWeight == 0;
+    for (size_t i = 0; i < means.getArrayLength(); ++i) {
+        addCentroid(means[i].coerceToDouble(), weights[i].coerceToDouble());
+    }
+    _min = wasEmpty ? min : std::min(_min, min);
+    _max = wasEmpty ? max : std::max(_max, max);
+}
+
+void AccumulatorApproxPercentile::addCentroid(double mean, double weight) {
+    if (_totalWeight == 0) {
+        _min = _max = mean;
+    } else {
+        _min = std::min(_min, mean);
+        _max = std::max(_max, mean);
+    }
+    _totalWeight += weight;
+    _buffer.push_back({mean, weight});
+    if (_buffer.size() >= kBufferSize) {
+        compress();
+    }
+}
+
+void AccumulatorApproxPercentile::compress() {
+    if (_buffer.empty()) {
+        return;
+    }
+
+    std::vector<Centroid> all;
+    all.reserve(_centroids.size() + _buffer.size());
+    all.insert(all.end(), _centroids.begin(), _centroids.end());
+    all.insert(all.end(), _buffer.begin(), _buffer.end());
+    _buffer.clear();
+    std::sort(all.begin(), all.end(), [](const Centroid& lhs, const Centroid& rhs) {
+        return lhs.mean < rhs.mean;
+    });
+
+    _centroids.clear();
+    Centroid current = all.front();
+    double weightSoFar = 0;
+    double weightLimit = _totalWeight * inverseScale(scale(0) + 1);
+    for (auto it = std::next(all.begin()); it != all.end(); ++it) {
+        if (weightSoFar + current.weight + it->weight <= weightLimit) {
+            // Fold this centroid into the current one, keeping the weighted mean.
+            current.weight += it->weight;
+            current.mean += (it->mean - current.mean) * it->weight / current.weight;
+        } else {
+            weightSoFar += current.weight;
+            _centroids.push_back(current);
+            weightLimit = _totalWeight * inverseScale(scale(weightSoFar / _totalWeight) + 1);
+            current = *it;
+        }
+    }
+    _centroids.push_back(current);
+
+    _memUsageBytes =
+        sizeof(*this) + (_centroids.capacity() + _buffer.capacity()) * sizeof(Centroid);
+}
+
+double AccumulatorApproxPercentile::quantile(double q) const {
+    invariant(!_centroids.empty());
+    if (_centroids.size() == 1) {
+        return _centroids.front().mean;
+    }
+
+    // Each centroid is treated as if its weight were spread evenly around its mean, so that the
+    // rank at its mean is the weight before it plus half of its own. Ranks between the means of
+    // two neighbouring centroids are interpolated, as are ranks between the extremes and the first
+    // and last means.
+    const double targetRank = q * _totalWeight;
+    const auto& first = _centroids.front();
+    if (targetRank < first.weight / 2) {
+        return _min + (first.mean - _min) * targetRank / (first.weight / 2);
+    }
+
+    double rankAtMean = first.weight / 2;
+    for (size_t i = 1; i < _centroids.size(); ++i) {
+        const auto& previous = _centroids[i - 1];
+        const auto& next = _centroids[i];
+        const double nextRankAtMean = rankAtMean + (previous.weight + next.weight) / 2;
+        if (targetRank <= nextRankAtMean) {
+            const double fraction = (targetRank - rankAtMean) / (nextRankAtMean - rankAtMean);
+            return previous.mean + (next.mean - previous.mean) * fraction;
+        }
+        rankAtMean = nextRankAtMean;
+    }
+
+    const auto& last = _centroids.back();
+    const double remaining = _totalWeight - rankAtMean;
+    return last.mean + (_max - last.mean) * std::min(1.0, (targetRank - rankAtMean) / remaining);
+}
+
+Value AccumulatorApproxPercentile::getValue(bool toBeMerged) {
+    compress();
+
+    if (!toBeMerged) {
+        if (_centroids.empty()) {
+            return Value(BSONNULL);
+        }
+        return Value(quantile(_percentile));
+    }
+
+    std::vector<Value> means;
+    std::vector<Value> weights;
+    means.reserve(_centroids.size());
+    weights.reserve(_centroids.size());
+    for (auto&& centroid : _centroids) {
+        means.emplace_back(centroid.mean);
+        weights.emplace_back(centroid.weight);
+    }
+    return Value(DOC("min" << _min << "max" << _max << "means" << Value(std::move(means))
+                           << "weights" << Value(std::move(weights))));
+}
+
+void AccumulatorApproxPercentile::reset() {
+    _centroids.clear();
+    _buffer.clear();
+    _totalWeight = 0;
+    _min = 0;
+    _max = 0;
+    _memUsageBytes = sizeof(*this);
+}
+
+}  // namespace mongo
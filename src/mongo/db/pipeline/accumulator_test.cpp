@@ -431,6 +431,85 @@ TEST(Accumulators, PushRespectsMaxMemoryConstraint) {
         ErrorCodes::ExceededMemoryLimit);
 }
 
+TEST(Accumulators, ApproxCountDistinctIsExactForSmallGroups) {
+    auto expCtx = ExpressionContextForTest{};
+    assertExpectedResults<AccumulatorApproxCountDistinct>(
+        &expCtx,
+        {
+            {{}, Value(0LL)},
+            {{Value(1), Value(1.0), Value(1LL), Value(BSONNULL)}, Value(2LL)},
+            {{Value("a"_sd), Value("b"_sd), Value("a"_sd), Value(Document{{"a", 1}})}, Value(3LL)},
+        });
+}
+
+TEST(Accumulators, ApproxCountDistinctRespectsCollation) {
+    auto expCtx = ExpressionContextForTest{};
+    auto collator =
+        std::make_unique<CollatorInterfaceMock>(CollatorInterfaceMock::MockType::kAlwaysEqual);
+    expCtx.setCollator(std::move(collator));
+    assertExpectedResults<AccumulatorApproxCountDistinct>(
+        &expCtx, {{{Value("a"_sd), Value("b"_sd), Value("c"_sd)}, Value(1LL)}});
+}
+
+TEST(Accumulators, ApproxCountDistinctEstimatesLargeGroups) {
+    auto expCtx = ExpressionContextForTest{};
+    const long long kNumDistinct = 100000;
+
+    // Split the values between two shards, with some overlap between them.
+    auto merger = AccumulatorApproxCountDistinct::create(&expCtx);
+    auto unsharded = AccumulatorApproxCountDistinct::create(&expCtx);
+    for (int shard = 0; shard < 2; ++shard) {
+        auto accum = AccumulatorApproxCountDistinct::create(&expCtx);
+        for (long long i = shard * kNumDistinct / 4; i < (shard + 1) * kNumDistinct / 2; ++i) {
+            accum->process(Value(i), false);
+            unsharded->process(Value(i), false);
+        }
+        merger->process(accum->getValue(true), true);
+    }
+
+    // The standard error of a sketch with 2^14 registers is under 1%.
+    const auto estimate = unsharded->getValue(false).getLong();
+    ASSERT_LT(std::abs(estimate - kNumDistinct * 3 / 4), kNumDistinct / 40);
+    ASSERT_EQ(merger->getValue(false).getLong(), estimate);
+}
+
+TEST(Accumulators, ApproxPercentileEstimatesPercentiles) {
+    auto expCtx = ExpressionContextForTest{};
+    const int kNumValues = 10000;
+
+    for (double p : {0.0, 0.01, 0.5, 0.99, 1.0}) {
+        // Feed the values in a scrambled order, to one accumulator directly and to another
+        // through two shards.
+        auto unsharded = make_intrusive<AccumulatorApproxPercentile>(&expCtx, p);
+        auto merger = make_intrusive<AccumulatorApproxPercentile>(&expCtx, p);
+        auto shard0 = make_intrusive<AccumulatorApproxPercentile>(&expCtx, p);
+        auto shard1 = make_intrusive<AccumulatorApproxPercentile>(&expCtx, p);
+        for (int i = 0; i < kNumValues; ++i) {
+            auto value = Value((i * 7919) % kNumValues + 1);
+            unsharded->process(value, false);
+            (i % 2 ? shard1 : shard0)->process(value, false);
+        }
+        unsharded->process(Value("not a number"_sd), false);
+        merger->process(shard0->getValue(true), true);
+        merger->process(shard1->getValue(true), true);
+
+        const double expected = std::max(1.0, p * kNumValues);
+        ASSERT_APPROX_EQUAL(unsharded->getValue(false).getDouble(), expected, kNumValues / 100.0);
+        ASSERT_APPROX_EQUAL(merger->getValue(false).getDouble(), expected, kNumValues / 100.0);
+    }
+}
+
+TEST(Accumulators, ApproxPercentileOfNoNumericValuesIsNull) {
+    auto expCtx = ExpressionContextForTest{};
+    auto accum = make_intrusive<AccumulatorApproxPercentile>(&expCtx, 0.5);
+    accum->process(Value("a"_sd), false);
+
+    auto merger = make_intrusive<AccumulatorApproxPercentile>(&expCtx, 0.5);
+    merger->process(accum->getValue(true), true);
+    ASSERT_VALUE_EQ(accum->getValue(false), Value(BSONNULL));
+    ASSERT_VALUE_EQ(merger->getValue(false), Value(BSONNULL));
+}
+
 /* ------------------------- AccumulatorMergeObjects -------------------------- */
 
 TEST(AccumulatorMergeObjects, MergingZeroObjectsShouldReturnEmptyDocument) {
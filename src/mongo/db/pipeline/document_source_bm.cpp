@@ -0,0 +1,244 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/bson/json.h"
+#include "mongo/db/pipeline/document_source.h"
+#include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/pipeline/document_source_set_window_fields.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/pipeline/pipeline.h"
+#include "mongo/db/pipeline/process_interface/stub_mongo_process_interface.h"
+#include "mongo/db/query/query_test_service_context.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Benchmarks the throughput of individual aggregation stages fed from a DocumentSourceMock.
+ *
+ * Each benchmark takes three arguments describing the shape of the input documents:
+ *
+ * width - the number of scalar top-level fields in each document, in addition to '_id', 'key' and
+ * 'arr'.
+ * cardinality - the number of distinct values of 'key', which stages group, partition or join on.
+ * depth - the nesting depth of the subdocument in the 'nested' field.
+ *
+ * The reported items per second are documents consumed by the stage; the bytes per second are
+ * the BSON size of those documents.
+ */
+constexpr int kNumDocuments = 1000;
+constexpr int kArrayLength = 4;
+
+Document makeDocument(int i, int width, int cardinality, int depth) {
+    BSONObj nested = BSON("v" << i);
+    for (int level = 0; level < depth; ++level) {
+        nested = BSON("n" << nested);
+    }
+
+    BSONObjBuilder builder;
+    builder.append("_id", i);
+    builder.append("key", i % cardinality);
+    {
+        BSONArrayBuilder arr(builder.subarrayStart("arr"));
+        for (int j = 0; j < kArrayLength; ++j) {
+            arr.append(i * kArrayLength + j);
+        }
+    }
+    for (int field = 0; field < width; ++field) {
+        builder.append("f" + std::to_string(field), i + field);
+    }
+    builder.append("nested", nested);
+    return Document{builder.obj()};
+}
+
+/**
+ * Serves the same documents for every sub-pipeline, which the stage under test filters itself.
+ */
+class ForeignCollectionProcessInterface final : public StubMongoProcessInterface {
+public:
+    explicit ForeignCollectionProcessInterface(std::deque<DocumentSource::GetNextResult> documents)
+        : _documents(std::move(documents)) {}
+
+    bool isSharded(OperationContext* opCtx, const NamespaceString& ns) final {
+        return false;
+    }
+
+    std::unique_ptr<Pipeline, PipelineDeleter> attachCursorSourceToPipeline(
+        Pipeline* ownedPipeline, bool allowTargetingShards = true) final {
+        std::unique_ptr<Pipeline, PipelineDeleter> pipeline(
+            ownedPipeline, PipelineDeleter(ownedPipeline->getContext()->opCtx));
+        pipeline->addInitialSource(
+            DocumentSourceMock::createForTest(_documents, pipeline->getContext()));
+        return pipeline;
+    }
+
+private:
+    std::deque<DocumentSource::GetNextResult> _documents;
+};
+
+using StageFactory = std::function<std::list<boost::intrusive_ptr<DocumentSource>>(
+    const boost::intrusive_ptr<ExpressionContext>&)>;
+
+void testStage(const StageFactory& makeStages, benchmark::State& state) {
+    QueryTestServiceContext testServiceContext;
+    auto opContext = testServiceContext.makeOperationContext();
+    NamespaceString nss("test.bm");
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx =
+        new ExpressionContextForTest(opContext.get(), nss);
+
+    const int width = state.range(0);
+    const int cardinality = state.range(1);
+    const int depth = state.range(2);
+
+    std::deque<DocumentSource::GetNextResult> documents;
+    int64_t bytesPerPass = 0;
+    for (int i = 0; i < kNumDocuments; ++i) {
+        auto doc = makeDocument(i, width, cardinality, depth);
+        bytesPerPass += doc.toBson().objsize();
+        documents.emplace_back(std::move(doc));
+    }
+
+    // The foreign collection for $lookup has one document per distinct value of 'key'.
+    std::deque<DocumentSource::GetNextResult> foreignDocuments;
+    for (int i = 0; i < cardinality; ++i) {
+        foreignDocuments.emplace_back(makeDocument(i, width, cardinality, depth));
+    }
+    expCtx->mongoProcessInterface =
+        std::make_shared<ForeignCollectionProcessInterface>(std::move(foreignDocuments));
+    NamespaceString foreignNss("test", "foreign");
+    expCtx->setResolvedNamespaces(StringMap<ExpressionContext::ResolvedNamespace>{
+        {foreignNss.coll().toString(), {foreignNss, std::vector<BSONObj>()}}});
+
+    for (auto keepRunning : state) {
+        // Copying the queue only copies references to the already built documents.
+        auto stages = makeStages(expCtx);
+        boost::intrusive_ptr<DocumentSource> source =
+            DocumentSourceMock::createForTest(documents, expCtx);
+        for (auto&& stage : stages) {
+            stage->setSource(source.get());
+            source = stage;
+        }
+        for (auto next = source->getNext(); !next.isEOF(); next = source->getNext()) {
+            benchmark::DoNotOptimize(next);
+        }
+        for (auto&& stage : stages) {
+            stage->dispose();
+        }
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * kNumDocuments);
+    state.SetBytesProcessed(state.iterations() * bytesPerPass);
+}
+
+StageFactory parseStage(const char* json) {
+    return [spec = fromjson(json)](const boost::intrusive_ptr<ExpressionContext>& expCtx) {
+        return DocumentSource::parse(expCtx, spec);
+    };
+}
+
+void BM_Group(benchmark::State& state) {
+    testStage(parseStage("{$group: {_id: '$key', count: {$sum: 1}, total: {$sum: '$f0'}, "
+                         "first: {$first: '$nested'}}}"),
+              state);
+}
+
+void BM_Sort(benchmark::State& state) {
+    testStage(parseStage("{$sort: {key: 1, _id: -1}}"), state);
+}
+
+void BM_Unwind(benchmark::State& state) {
+    testStage(parseStage("{$unwind: {path: '$arr', includeArrayIndex: 'idx'}}"), state);
+}
+
+void BM_Lookup(benchmark::State& state) {
+    testStage(parseStage("{$lookup: {from: 'foreign', localField: 'key', foreignField: '_id', "
+                         "as: 'joined'}}"),
+              state);
+}
+
+void BM_SetWindowFields(benchmark::State& state) {
+    testStage(
+        [spec = fromjson("{$setWindowFields: {partitionBy: '$key', sortBy: {_id: 1}, output: "
+                         "{runningTotal: {$sum: '$f0', window: {documents: ['unbounded', "
+                         "'current']}}, movingAvg: {$avg: '$f0', window: {documents: [-5, 5]}}}}}")](
+            const boost::intrusive_ptr<ExpressionContext>& expCtx) {
+            // Created directly, since the stage is not registered unless its feature flag is
+            // enabled at startup.
+            return document_source_set_window_fields::createFromBson(spec.firstElement(), expCtx);
+        },
+        state);
+}
+
+void BM_ProjectInclusion(benchmark::State& state) {
+    testStage(parseStage("{$project: {key: 1, f0: 1, 'nested.n': 1}}"), state);
+}
+
+void BM_ProjectExclusion(benchmark::State& state) {
+    testStage(parseStage("{$project: {arr: 0, nested: 0}}"), state);
+}
+
+void BM_ProjectComputed(benchmark::State& state) {
+    testStage(parseStage("{$project: {key: 1, sum: {$add: ['$_id', '$key']}, "
+                         "size: {$size: '$arr'}}}"),
+              state);
+}
+
+/**
+ * Arguments are {width, cardinality, depth}. Each benchmark varies one of them from a baseline of
+ * narrow, flat documents with a few distinct keys.
+ */
+void documentShapes(benchmark::internal::Benchmark* benchmark) {
+    benchmark->ArgNames({"width", "cardinality", "depth"});
+    for (int width : {1, 10, 100}) {
+        benchmark->Args({width, 10, 0});
+    }
+    for (int cardinality : {1, 100, kNumDocuments}) {
+        benchmark->Args({1, cardinality, 0});
+    }
+    for (int depth : {5, 20}) {
+        benchmark->Args({1, 10, depth});
+    }
+}
+
+BENCHMARK(BM_Group)->Apply(documentShapes);
+BENCHMARK(BM_Sort)->Apply(documentShapes);
+BENCHMARK(BM_Unwind)->Apply(documentShapes);
+BENCHMARK(BM_Lookup)->Apply(documentShapes);
+BENCHMARK(BM_SetWindowFields)->Apply(documentShapes);
+BENCHMARK(BM_ProjectInclusion)->Apply(documentShapes);
+BENCHMARK(BM_ProjectExclusion)->Apply(documentShapes);
+BENCHMARK(BM_ProjectComputed)->Apply(documentShapes);
+
+}  // namespace
+}  // namespace mongo
@@ -242,6 +242,17 @@ std::string DocumentSourceChangeStream::getNsRegexForChangeStream(const Namespac
     }
 }
 
+BSONObj DocumentSourceChangeStream::getNsMatchForChangeStream(const NamespaceString& nss,
+                                                              StringData fieldName) {
+    BSONObjBuilder nsMatchBuilder;
+    if (getChangeStreamType(nss) == ChangeStreamType::kSingleCollection) {
+        nsMatchBuilder.append(fieldName, nss.ns());
+    } else {
+        nsMatchBuilder.appendRegex(fieldName, getNsRegexForChangeStream(nss));
+    }
+    return nsMatchBuilder.obj();
+}
+
 BSONObj DocumentSourceChangeStream::buildMatchFilter(
     const boost::intrusive_ptr<ExpressionContext>& expCtx,
     Timestamp startFromInclusive,
@@ -279,7 +290,7 @@ BSONObj DocumentSourceChangeStream::buildMatchFilter(
         BSON("$and" << BSON_ARRAY(cmdNsFilter << BSON("$or" << relevantCommands.arr())));
 
     // 1.2) Supported commands that have arbitrary db namespaces in "ns" field.
-    auto renameDropTarget = BSON("o.to" << BSONRegEx(getNsRegexForChangeStream(nss)));
+    auto renameDropTarget = getNsMatchForChangeStream(nss, "o.to"_sd);
 
     // 1.3) Transaction commit commands.
     auto transactionCommit = BSON("o.commitTransaction" << 1);
@@ -291,7 +302,7 @@ BSONObj DocumentSourceChangeStream::buildMatchFilter(
 
     // 2) Supported operations on the operation namespace, optionally including those from
     // migrations.
-    BSONObj opNsMatch = BSON("ns" << BSONRegEx(getNsRegexForChangeStream(nss)));
+    BSONObj opNsMatch = getNsMatchForChangeStream(nss, "ns"_sd);
 
     // 2.1) Normal CRUD ops.
     auto normalOpTypeMatch = BSON("op" << NE << "n");
@@ -166,6 +166,14 @@ public:
     static ChangeStreamType getChangeStreamType(const NamespaceString& nss);
     static std::string getNsRegexForChangeStream(const NamespaceString& nss);
 
+    /**
+     * Returns an object with a single field named 'fieldName' whose value is a $match predicate on
+     * the namespaces relevant to a change stream on 'nss'. A single-collection stream matches its
+     * namespace by equality, which every oplog entry can be checked against much more cheaply than
+     * the anchored regex from getNsRegexForChangeStream(); other streams use that regex.
+     */
+    static BSONObj getNsMatchForChangeStream(const NamespaceString& nss, StringData fieldName);
+
     /**
      * Produce the BSON object representing the filter for the $match stage to filter oplog entries
      * to only those relevant for this $changeStream stage.
@@ -41,6 +41,7 @@
 #include "mongo/db/exec/document_value/document_value_test_util.h"
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/exec/document_value/value_comparator.h"
+#include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/pipeline/aggregation_context_fixture.h"
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_change_stream.h"
@@ -577,6 +578,21 @@ TEST_F(ChangeStreamStageTest, ShowMigrationsFailsOnMongos) {
         DSChangeStream::createFromBson(spec.firstElement(), expCtx), AssertionException, 31123);
 }
 
+TEST_F(ChangeStreamStageTest, SingleCollectionFilterMatchesNamespaceExactly) {
+    auto filter = DSChangeStream::buildMatchFilter(getExpCtx(), kDefaultTs, false);
+    auto matcher = uassertStatusOK(MatchExpressionParser::parse(filter, getExpCtx()));
+
+    auto insertOn = [](const std::string& ns) {
+        return BSON("ts" << kDefaultTs << "op"
+                         << "i"
+                         << "ns" << ns << "o" << BSON("_id" << 1));
+    };
+    ASSERT_TRUE(matcher->matchesBSON(insertOn(nss.ns())));
+    ASSERT_FALSE(matcher->matchesBSON(insertOn(nss.ns() + "2")));
+    ASSERT_FALSE(matcher->matchesBSON(insertOn(nss.ns() + "\n")));
+    ASSERT_FALSE(matcher->matchesBSON(insertOn(nss.getSisterNS("other"))));
+}
+
 TEST_F(ChangeStreamStageTest, TransformInsertDocKeyXAndId) {
     auto insert = makeOplogEntry(OpTypeEnum::kInsert,           // op type
                                  nss,                           // namespace
@@ -90,6 +90,11 @@ intrusive_ptr<DocumentSource> DocumentSourceCollStats::createFromBson(
                     str::stream() << "queryExecStats argument must be an empty object, but got "
                                   << elem,
                     elem.embeddedObject().isEmpty());
+        } else if ("ioStats" == fieldName) {
+            uassert(5591700,
+                    str::stream() << "ioStats argument must be an empty object, but got " << elem
+                                  << " of type " << typeName(elem.type()),
+                    elem.type() == BSONType::Object && elem.embeddedObject().isEmpty());
         } else {
             uasserted(40168, str::stream() << "unrecognized option to $collStats: " << fieldName);
         }
@@ -151,6 +156,12 @@ DocumentSource::GetNextResult DocumentSourceCollStats::doGetNext() {
                                    "Unable to retrieve queryExecStats in $collStats stage");
     }
 
+    if (_collStatsSpec.hasField("ioStats")) {
+        uassertStatusOKWithContext(
+            pExpCtx->mongoProcessInterface->appendIOStats(pExpCtx->opCtx, pExpCtx->ns, &builder),
+            "Unable to retrieve ioStats in $collStats stage");
+    }
+
     return {Document(builder.obj())};
 }
 
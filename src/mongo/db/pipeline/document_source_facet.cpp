@@ -40,12 +40,25 @@
 #include "mongo/bson/bsontypes.h"
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/client.h"
+#include "mongo/db/pipeline/document_source_bucket_auto.h"
+#include "mongo/db/pipeline/document_source_group.h"
+#include "mongo/db/pipeline/document_source_limit.h"
+#include "mongo/db/pipeline/document_source_match.h"
+#include "mongo/db/pipeline/document_source_single_document_transformation.h"
+#include "mongo/db/pipeline/document_source_skip.h"
+#include "mongo/db/pipeline/document_source_sort.h"
 #include "mongo/db/pipeline/document_source_tee_consumer.h"
+#include "mongo/db/pipeline/document_source_unwind.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/field_path.h"
 #include "mongo/db/pipeline/pipeline.h"
 #include "mongo/db/pipeline/tee_buffer.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
@@ -107,6 +120,75 @@ vector<pair<string, vector<BSONObj>>> extractRawPipelines(const BSONElement& ele
     return rawFacetPipelines;
 }
 
+/**
+ * Returns true if 'obj' contains an operator which runs JavaScript, searching nested objects and
+ * arrays.
+ */
+bool containsJavaScript(const BSONObj& obj) {
+    for (auto&& elem : obj) {
+        auto fieldName = elem.fieldNameStringData();
+        if (fieldName == "$function"_sd || fieldName == "$accumulator"_sd ||
+            fieldName == "$where"_sd) {
+            return true;
+        }
+        if (elem.isABSONObj() && containsJavaScript(elem.embeddedObject())) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Returns true if the sub-pipelines of the $facet described by 'elem' might run concurrently, in
+ * which case each must be parsed with its own ExpressionContext. The JavaScript engine is bound
+ * to the OperationContext, and spilling to disk records metrics on it, so neither may be used.
+ */
+bool mayRunFacetsConcurrently(const BSONElement& elem, const ExpressionContext& expCtx) {
+    return internalQueryFacetMaxParallelism.load() > 1 && !expCtx.inMongos &&
+        !expCtx.allowDiskUse && !containsJavaScript(elem.embeddedObject());
+}
+
+/**
+ * Returns the thread pool on which $facet sub-pipelines run concurrently. Its size is fixed at
+ * startup by 'internalQueryFacetMaxParallelism'.
+ */
+ThreadPool* getFacetThreadPool() {
+    static const auto pool = [] {
+        ThreadPool::Options options;
+        options.poolName = "FacetThreadPool";
+        options.threadNamePrefix = "Facet";
+        options.minThreads = 0;
+        options.maxThreads = internalQueryFacetMaxParallelism.load();
+        options.onCreateThread = [](const std::string& name) { Client::initThread(name); };
+        auto pool = std::make_unique<ThreadPool>(options);
+        pool->startup();
+        return pool;
+    }();
+    return pool.get();
+}
+
+
+/**
+ * Returns the specification of 'stage' if it may be moved from the beginning of every sub-pipeline
+ * of a $facet to ahead of the $facet: a $match or a projection, which work on one document at a
+ * time without keeping any state.
+ */
+boost::optional<BSONObj> getHoistableStageSpec(const DocumentSource& stage) {
+    auto match = dynamic_cast<const DocumentSourceMatch*>(&stage);
+    if (!(match && stage.getSourceName() == DocumentSourceMatch::kStageName &&
+          !match->isTextQuery()) &&
+        !dynamic_cast<const DocumentSourceSingleDocumentTransformation*>(&stage)) {
+        return boost::none;
+    }
+
+    std::vector<Value> serialized;
+    stage.serializeToArray(serialized);
+    if (serialized.size() != 1 || serialized.front().getType() != BSONType::Object) {
+        return boost::none;
+    }
+    return serialized.front().getDocument().toBson();
+}
+
 }  // namespace
 
 std::unique_ptr<DocumentSourceFacet::LiteParsed> DocumentSourceFacet::LiteParsed::parse(
@@ -151,27 +233,31 @@ DocumentSource::GetNextResult DocumentSourceFacet::doGetNext() {
         return GetNextResult::makeEOF();
     }
 
-    const size_t maxBytes = _maxOutputDocSizeBytes;
-    auto ensureUnderMemoryLimit = [usedBytes = 0ul, &maxBytes](long long additional) mutable {
-        usedBytes += additional;
-        uassert(4031700,
-                str::stream() << "document constructed by $facet is " << usedBytes
-                              << " bytes, which exceeds the limit of " << maxBytes << " bytes",
-                usedBytes <= maxBytes);
-    };
-
     vector<vector<Value>> results(_facets.size());
-    bool allPipelinesEOF = false;
-    while (!allPipelinesEOF) {
-        allPipelinesEOF = true;  // Set this to false if any pipeline isn't EOF.
-        for (size_t facetId = 0; facetId < _facets.size(); ++facetId) {
-            const auto& pipeline = _facets[facetId].pipeline;
-            auto next = pipeline->getSources().back()->getNext();
-            for (; next.isAdvanced(); next = pipeline->getSources().back()->getNext()) {
-                ensureUnderMemoryLimit(next.getDocument().getApproximateSize());
-                results[facetId].emplace_back(next.releaseDocument());
+    if (canRunFacetsConcurrently()) {
+        runFacetsConcurrently(&results);
+    } else {
+        const size_t maxBytes = _maxOutputDocSizeBytes;
+        auto ensureUnderMemoryLimit = [usedBytes = 0ul, &maxBytes](long long additional) mutable {
+            usedBytes += additional;
+            uassert(4031700,
+                    str::stream() << "document constructed by $facet is " << usedBytes
+                                  << " bytes, which exceeds the limit of " << maxBytes << " bytes",
+                    usedBytes <= maxBytes);
+        };
+
+        bool allPipelinesEOF = false;
+        while (!allPipelinesEOF) {
+            allPipelinesEOF = true;  // Set this to false if any pipeline isn't EOF.
+            for (size_t facetId = 0; facetId < _facets.size(); ++facetId) {
+                const auto& pipeline = _facets[facetId].pipeline;
+                auto next = pipeline->getSources().back()->getNext();
+                for (; next.isAdvanced(); next = pipeline->getSources().back()->getNext()) {
+                    ensureUnderMemoryLimit(next.getDocument().getApproximateSize());
+                    results[facetId].emplace_back(next.releaseDocument());
+                }
+                allPipelinesEOF = allPipelinesEOF && next.isEOF();
             }
-            allPipelinesEOF = allPipelinesEOF && next.isEOF();
         }
     }
 
@@ -184,6 +270,107 @@ DocumentSource::GetNextResult DocumentSourceFacet::doGetNext() {
     return resultDoc.freeze();
 }
 
+bool DocumentSourceFacet::canRunFacetsConcurrently() const {
+    if (!_hasIsolatedFacetContexts || _facets.size() < 2) {
+        return false;
+    }
+
+    // Stages may have been added or swapped during optimization, so check the final pipelines.
+    for (auto&& facet : _facets) {
+        for (auto&& source : facet.pipeline->getSources()) {
+            auto stage = source.get();
+            if (!dynamic_cast<DocumentSourceTeeConsumer*>(stage) &&
+                !dynamic_cast<DocumentSourceMatch*>(stage) &&
+                !dynamic_cast<DocumentSourceSingleDocumentTransformation*>(stage) &&
+                !dynamic_cast<DocumentSourceGroup*>(stage) &&
+                !dynamic_cast<DocumentSourceSort*>(stage) &&
+                !dynamic_cast<DocumentSourceLimit*>(stage) &&
+                !dynamic_cast<DocumentSourceSkip*>(stage) &&
+                !dynamic_cast<DocumentSourceUnwind*>(stage) &&
+                !dynamic_cast<DocumentSourceBucketAuto*>(stage)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void DocumentSourceFacet::runFacetsConcurrently(std::vector<std::vector<Value>>* results) {
+    _teeBuffer->enableConcurrentConsumers();
+
+    // The limit on the size of the output document is shared by all of the sub-pipelines.
+    const long long maxBytes = _maxOutputDocSizeBytes;
+    AtomicWord<long long> usedBytes{0};
+
+    // Drains the sub-pipeline 'facetId' of the current batch of input. Returns true if the
+    // sub-pipeline has produced all of its results.
+    auto runFacet = [&](size_t facetId) {
+        const auto& pipeline = _facets[facetId].pipeline;
+        auto next = pipeline->getSources().back()->getNext();
+        for (; next.isAdvanced(); next = pipeline->getSources().back()->getNext()) {
+            auto totalBytes = usedBytes.addAndFetch(next.getDocument().getApproximateSize());
+            uassert(4031700,
+                    str::stream() << "document constructed by $facet is " << totalBytes
+                                  << " bytes, which exceeds the limit of " << maxBytes << " bytes",
+                    totalBytes <= maxBytes);
+            (*results)[facetId].emplace_back(next.releaseDocument());
+        }
+        return next.isEOF();
+    };
+
+    // The input is read on this thread, one batch at a time. Once every sub-pipeline has consumed a
+    // batch, the next one is loaded and the sub-pipelines which are not yet EOF run again. After
+    // the input is exhausted, one final round lets each sub-pipeline observe EOF and produce its
+    // results.
+    std::vector<char> facetEOF(_facets.size(), false);
+    auto pool = getFacetThreadPool();
+    bool allPipelinesEOF = false;
+    while (!allPipelinesEOF) {
+        _teeBuffer->loadNextBatchForConcurrentConsumers();
+
+        auto mutex = MONGO_MAKE_LATCH("DocumentSourceFacet::runFacetsConcurrently::mutex");
+        stdx::condition_variable allFacetsDone;
+        size_t numRunning = 0;
+        Status status = Status::OK();
+
+        for (size_t facetId = 0; facetId < _facets.size(); ++facetId) {
+            if (facetEOF[facetId]) {
+                continue;
+            }
+
+            ++numRunning;
+            pool->schedule([&, facetId](Status scheduleStatus) {
+                if (scheduleStatus.isOK()) {
+                    try {
+                        facetEOF[facetId] = runFacet(facetId);
+                    } catch (const DBException& ex) {
+                        scheduleStatus = ex.toStatus();
+                    }
+                }
+
+                stdx::lock_guard<Latch> lk(mutex);
+                if (!scheduleStatus.isOK() && status.isOK()) {
+                    status = scheduleStatus;
+                }
+                if (--numRunning == 0) {
+                    allFacetsDone.notify_all();
+                }
+            });
+        }
+
+        {
+            // The sub-pipelines refer to state on this thread's stack, so we must wait for all of
+            // them even if the operation is interrupted.
+            stdx::unique_lock<Latch> lk(mutex);
+            allFacetsDone.wait(lk, [&] { return numRunning == 0; });
+        }
+        uassertStatusOK(status);
+
+        allPipelinesEOF =
+            std::all_of(facetEOF.begin(), facetEOF.end(), [](char eof) { return eof; });
+    }
+}
+
 Value DocumentSourceFacet::serialize(boost::optional<ExplainOptions::Verbosity> explain) const {
     MutableDocument serialized;
     for (auto&& facet : _facets) {
@@ -209,6 +396,65 @@ intrusive_ptr<DocumentSource> DocumentSourceFacet::optimize() {
     return this;
 }
 
+Pipeline::SourceContainer::iterator DocumentSourceFacet::doOptimizeAt(
+    Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
+    invariant(*itr == this);
+
+    if (!internalQueryFacetHoistCommonPrefix.load() || _facets.size() < 2) {
+        return std::next(itr);
+    }
+
+    // Returns the specification of the stage at 'pos' if it is the same hoistable stage in every
+    // sub-pipeline.
+    auto getCommonStageSpec = [&](size_t pos) -> boost::optional<BSONObj> {
+        boost::optional<BSONObj> commonSpec;
+        for (auto&& facet : _facets) {
+            const auto& sources = facet.pipeline->getSources();
+            if (sources.size() <= pos) {
+                return boost::none;
+            }
+            auto spec = getHoistableStageSpec(**std::next(sources.begin(), pos));
+            if (!spec || (commonSpec && !spec->binaryEqual(*commonSpec))) {
+                return boost::none;
+            }
+            commonSpec = std::move(spec);
+        }
+        return commonSpec;
+    };
+
+    // Each sub-pipeline begins with the DocumentSourceTeeConsumer which reads from '_teeBuffer', so
+    // the common prefix starts after it.
+    std::vector<BSONObj> commonPrefix;
+    while (auto spec = getCommonStageSpec(commonPrefix.size() + 1)) {
+        commonPrefix.push_back(std::move(*spec));
+    }
+    if (commonPrefix.empty()) {
+        return std::next(itr);
+    }
+
+    for (auto&& facet : _facets) {
+        auto& sources = facet.pipeline->getSources();
+        sources.erase(std::next(sources.begin()),
+                      std::next(sources.begin(), commonPrefix.size() + 1));
+        facet.pipeline->stitch();
+    }
+
+    // The stages are parsed again rather than moved, since the sub-pipelines may have their own
+    // ExpressionContexts.
+    auto firstHoisted = itr;
+    for (auto&& spec : commonPrefix) {
+        for (auto&& stage : DocumentSource::parse(pExpCtx, spec)) {
+            auto inserted = container->insert(itr, std::move(stage));
+            if (firstHoisted == itr) {
+                firstHoisted = inserted;
+            }
+        }
+    }
+
+    // The stage preceding the hoisted ones may be able to optimize with them.
+    return firstHoisted == container->begin() ? firstHoisted : std::prev(firstHoisted);
+}
+
 void DocumentSourceFacet::detachFromOperationContext() {
     for (auto&& facet : _facets) {
         facet.pipeline->detachFromOperationContext();
@@ -305,11 +551,16 @@ intrusive_ptr<DocumentSource> DocumentSourceFacet::createFromBson(
     boost::optional<std::string> needsMongoS;
     boost::optional<std::string> needsShard;
 
+    // If the sub-pipelines may run concurrently, give each its own copy of the ExpressionContext,
+    // since evaluating expressions writes to the context's variables.
+    const bool isolateFacetContexts = mayRunFacetsConcurrently(elem, *expCtx);
+
     std::vector<FacetPipeline> facetPipelines;
     for (auto&& rawFacet : extractRawPipelines(elem)) {
         const auto facetName = rawFacet.first;
+        auto facetExpCtx = isolateFacetContexts ? expCtx->copyWith(expCtx->ns) : expCtx;
 
-        auto pipeline = Pipeline::parse(rawFacet.second, expCtx, [](const Pipeline& pipeline) {
+        auto pipeline = Pipeline::parse(rawFacet.second, facetExpCtx, [](const Pipeline& pipeline) {
             auto sources = pipeline.getSources();
             std::for_each(sources.begin(), sources.end(), [](auto& stage) {
                 auto stageConstraints = stage->constraints();
@@ -342,6 +593,8 @@ intrusive_ptr<DocumentSource> DocumentSourceFacet::createFromBson(
         facetPipelines.emplace_back(facetName, std::move(pipeline));
     }
 
-    return DocumentSourceFacet::create(std::move(facetPipelines), expCtx);
+    auto facet = DocumentSourceFacet::create(std::move(facetPipelines), expCtx);
+    facet->_hasIsolatedFacetContexts = isolateFacetContexts;
+    return facet;
 }
 }  // namespace mongo
@@ -102,6 +102,15 @@ public:
      */
     boost::intrusive_ptr<DocumentSource> optimize() final;
 
+    /**
+     * If every sub-pipeline begins with the same $match or projection stages, moves them ahead of
+     * this stage so that they run once instead of once per sub-pipeline. For example,
+     * {$facet: {a: [{$match: {x: 1}}, {$count: "n"}], b: [{$match: {x: 1}}, {$limit: 1}]}} becomes
+     * {$match: {x: 1}}, {$facet: {a: [{$count: "n"}], b: [{$limit: 1}]}}.
+     */
+    Pipeline::SourceContainer::iterator doOptimizeAt(Pipeline::SourceContainer::iterator itr,
+                                                     Pipeline::SourceContainer* container) final;
+
     /**
      * Takes a union of all sub-pipelines, and adds them to 'deps'.
      */
@@ -157,11 +166,27 @@ private:
 
     Value serialize(boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final;
 
+    /**
+     * Returns true if the sub-pipelines can run concurrently: every stage must be one which works
+     * purely on the documents it is given, without touching the OperationContext.
+     */
+    bool canRunFacetsConcurrently() const;
+
+    /**
+     * Runs the sub-pipelines on the $facet thread pool, one batch of input at a time, appending the
+     * results of each to the corresponding element of 'results'.
+     */
+    void runFacetsConcurrently(std::vector<std::vector<Value>>* results);
+
     boost::intrusive_ptr<TeeBuffer> _teeBuffer;
     std::vector<FacetPipeline> _facets;
 
     const size_t _maxOutputDocSizeBytes;
 
+    // True if each sub-pipeline was parsed with its own ExpressionContext, such that the
+    // sub-pipelines may run on separate threads without sharing any mutable state.
+    bool _hasIsolatedFacetContexts = false;
+
     bool _done = false;
 };
 }  // namespace mongo
@@ -44,8 +44,10 @@
 #include "mongo/db/pipeline/document_source_limit.h"
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/document_source_skip.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 using std::deque;
@@ -366,6 +368,53 @@ TEST_F(DocumentSourceFacetTest, MultipleFacetsShouldSeeTheSameDocuments) {
     ASSERT(facetStage->getNext().isEOF());
 }
 
+TEST_F(DocumentSourceFacetTest, ConcurrentFacetsProduceSameResultsAsSequentialFacets) {
+    const auto originalParallelism = internalQueryFacetMaxParallelism.load();
+    const auto originalBufferSize = internalQueryFacetBufferSizeBytes.load();
+    ON_BLOCK_EXIT([&] {
+        internalQueryFacetMaxParallelism.store(originalParallelism);
+        internalQueryFacetBufferSizeBytes.store(originalBufferSize);
+    });
+    // Buffer a single document at a time, so that the facets run over many batches.
+    internalQueryFacetBufferSizeBytes.store(1);
+
+    auto spec = fromjson(
+        "{$facet: {"
+        "  byKey: [{$group: {_id: '$k', n: {$sum: 1}}}, {$sort: {_id: 1}}],"
+        "  zeros: [{$match: {k: 0}}, {$project: {_id: 1}}],"
+        "  top: [{$sort: {_id: -1}}, {$limit: 2}],"
+        "  rest: [{$skip: 8}, {$addFields: {double: {$map: {input: [1, 2], in: {$multiply: "
+        "          ['$$this', '$_id']}}}}}]"
+        "}}");
+
+    auto runFacet = [&]() {
+        deque<DocumentSource::GetNextResult> inputs;
+        for (int i = 0; i < 10; ++i) {
+            inputs.emplace_back(Document{{"_id", i}, {"k", i % 3}});
+        }
+        auto mock = DocumentSourceMock::createForTest(inputs, getExpCtx());
+        auto facetStage = DocumentSourceFacet::createFromBson(spec.firstElement(), getExpCtx());
+        facetStage->setSource(mock.get());
+
+        auto output = facetStage->getNext();
+        ASSERT(output.isAdvanced());
+        ASSERT(facetStage->getNext().isEOF());
+        return output.releaseDocument();
+    };
+
+    internalQueryFacetMaxParallelism.store(1);
+    auto sequentialOutput = runFacet();
+    internalQueryFacetMaxParallelism.store(4);
+    auto concurrentOutput = runFacet();
+
+    ASSERT_DOCUMENT_EQ(sequentialOutput, concurrentOutput);
+    ASSERT_VALUE_EQ(concurrentOutput["zeros"],
+                    Value(std::vector<Value>{Value(Document{{"_id", 0}}),
+                                             Value(Document{{"_id", 3}}),
+                                             Value(Document{{"_id", 6}}),
+                                             Value(Document{{"_id", 9}})}));
+}
+
 TEST_F(DocumentSourceFacetTest, ShouldAcceptEmptyPipelines) {
     auto ctx = getExpCtx();
     auto spec = BSON("$facet" << BSON("a" << BSONArray()));
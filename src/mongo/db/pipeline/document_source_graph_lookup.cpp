@@ -31,6 +31,7 @@
 
 #include "mongo/db/pipeline/document_source_graph_lookup.h"
 
+#include <boost/filesystem/operations.hpp>
 #include <memory>
 
 #include "mongo/base/init.h"
@@ -45,10 +46,25 @@
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner_common.h"
+#include "mongo/util/destructor_guard.h"
 
 namespace mongo {
 
 namespace {
+// Upper bound on the approximate size of the values in a single frontier batch, which keeps the
+// $match built from the batch well under the maximum size of a BSON object.
+constexpr size_t kMaxFrontierBatchBytes = BSONObjMaxUserSize / 2;
+
+/**
+ * Generates a new file name on each call using a static, atomic and monotonically increasing
+ * number. See the comment on the equivalent function in document_source_group.cpp.
+ */
+std::string nextFileName() {
+    static AtomicWord<unsigned> documentSourceGraphLookupFileCounter;
+    return "extsort-doc-graph-lookup." +
+        std::to_string(documentSourceGraphLookupFileCounter.fetchAndAdd(1));
+}
+
 bool foreignShardedLookupAllowed() {
     return getTestCommandsEnabled() && internalQueryAllowShardedLookup.load();
 }
@@ -134,11 +150,9 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::doGetNext() {
     performSearch();
 
     std::vector<Value> results;
-    while (!_visited.empty()) {
+    while (hasVisited()) {
         // Remove elements one at a time to avoid consuming more memory.
-        auto it = _visited.begin();
-        results.push_back(Value(it->second));
-        _visited.erase(it);
+        results.push_back(Value(popVisited()));
     }
 
     MutableDocument output(*_input);
@@ -146,7 +160,7 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::doGetNext() {
 
     _visitedUsageBytes = 0;
 
-    invariant(_visited.empty());
+    invariant(!hasVisited());
 
     return output.freeze();
 }
@@ -157,7 +171,7 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::getNextUnwound() {
     // If the unwind is not preserving empty arrays, we might have to process multiple inputs before
     // we get one that will produce an output.
     while (true) {
-        if (_visited.empty()) {
+        if (!hasVisited()) {
             // No results are left for the current input, so we should move on to the next one and
             // perform a new search.
 
@@ -173,7 +187,7 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::getNextUnwound() {
         }
         MutableDocument unwound(*_input);
 
-        if (_visited.empty()) {
+        if (!hasVisited()) {
             if ((*_unwind)->preserveNullAndEmptyArrays()) {
                 // Since "preserveNullAndEmptyArrays" was specified, output a document even though
                 // we had no result.
@@ -187,23 +201,46 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::getNextUnwound() {
                 continue;
             }
         } else {
-            auto it = _visited.begin();
-            unwound.setNestedField(_as, Value(it->second));
+            unwound.setNestedField(_as, Value(popVisited()));
             if (indexPath) {
                 unwound.setNestedField(*indexPath, Value(_outputIndex));
                 ++_outputIndex;
             }
-            _visited.erase(it);
         }
 
         return unwound.freeze();
     }
 }
 
+Document DocumentSourceGraphLookUp::popVisited() {
+    while (!_spilledVisited.empty()) {
+        auto& spilled = _spilledVisited.front();
+        if (!_spilledVisitedSourceOpen) {
+            spilled->openSource();
+            _spilledVisitedSourceOpen = true;
+        }
+        if (spilled->more()) {
+            return spilled->next().second;
+        }
+        spilled->closeSource();
+        _spilledVisitedSourceOpen = false;
+        _spilledVisited.pop_front();
+    }
+
+    invariant(!_visited.empty());
+    auto it = _visited.begin();
+    auto result = std::move(it->second);
+    _visited.erase(it);
+    return result;
+}
+
 void DocumentSourceGraphLookUp::doDispose() {
     _cache.clear();
     _frontier.clear();
     _visited.clear();
+    _spilledVisitedIds.clear();
+    _spilledVisited.clear();
+    _spilledVisitedSourceOpen = false;
 }
 
 void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
@@ -219,11 +256,7 @@ void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
 
         // Check whether each key in the frontier exists in the cache or needs to be queried.
         auto cached = pExpCtx->getDocumentComparator().makeUnorderedDocumentSet();
-        auto matchStage = makeMatchStageFromFrontier(&cached);
-
-        ValueUnorderedSet queried = pExpCtx->getValueComparator().makeUnorderedValueSet();
-        _frontier.swap(queried);
-        _frontierUsageBytes = 0;
+        auto batches = makeFrontierBatches(&cached);
 
         // Process cached values, populating '_frontier' for the next iteration of search.
         while (!cached.empty()) {
@@ -234,12 +267,11 @@ void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
             checkMemoryUsage();
         }
 
-        if (matchStage) {
-            // Query for all keys that were in the frontier and not in the cache, populating
-            // '_frontier' for the next iteration of search.
-
+        // Query for all keys that were in the frontier and not in the cache, one bounded batch at
+        // a time, populating '_frontier' for the next iteration of search.
+        for (auto&& batch : batches) {
             // We've already allocated space for the trailing $match stage in '_fromPipeline'.
-            _fromPipeline.back() = *matchStage;
+            _fromPipeline.back() = makeMatchStageFromBatch(batch);
             MakePipelineOptions pipelineOpts;
             pipelineOpts.optimize = true;
             pipelineOpts.attachCursorSource = true;
@@ -256,7 +288,9 @@ void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
 
                 shouldPerformAnotherQuery =
                     addToVisitedAndFrontier(*next, depth) || shouldPerformAnotherQuery;
-                addToCache(std::move(*next), queried);
+                // Only cache under the values of this batch, since a document matching values in
+                // several batches is returned once by each of their queries.
+                addToCache(std::move(*next), batch);
             }
             checkMemoryUsage();
         }
@@ -267,12 +301,14 @@ void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
 
     _frontier.clear();
     _frontierUsageBytes = 0;
+    _spilledVisitedIds.clear();
 }
 
 bool DocumentSourceGraphLookUp::addToVisitedAndFrontier(Document result, long long depth) {
     auto id = result.getField("_id");
 
-    if (_visited.find(id) != _visited.end()) {
+    if (_visited.find(id) != _visited.end() ||
+        _spilledVisitedIds.find(id) != _spilledVisitedIds.end()) {
         // We've already seen this object, don't repeat any work.
         return false;
     }
@@ -319,24 +355,35 @@ void DocumentSourceGraphLookUp::addToCache(const Document& result,
         });
 }
 
-boost::optional<BSONObj> DocumentSourceGraphLookUp::makeMatchStageFromFrontier(
+std::vector<ValueUnorderedSet> DocumentSourceGraphLookUp::makeFrontierBatches(
     DocumentUnorderedSet* cached) {
-    // Add any cached values to 'cached' and remove them from '_frontier'.
-    for (auto it = _frontier.begin(); it != _frontier.end();) {
-        if (auto entry = _cache[*it]) {
+    std::vector<ValueUnorderedSet> batches;
+    const size_t maxValuesPerQuery = internalDocumentSourceGraphLookupMaxValuesPerQuery.load();
+    size_t batchBytes = 0;
+
+    // Add any cached values to 'cached', and distribute the rest among the batches.
+    for (auto&& value : _frontier) {
+        if (auto entry = _cache[value]) {
             cached->insert(entry->begin(), entry->end());
-            size_t valueSize = it->getApproximateSize();
-            _frontier.erase(it++);
+            continue;
+        }
 
-            // If the cached value increased in size while in the cache, we don't want to underflow
-            // '_frontierUsageBytes'.
-            invariant(valueSize <= _frontierUsageBytes);
-            _frontierUsageBytes -= valueSize;
-        } else {
-            ++it;
+        const size_t valueSize = value.getApproximateSize();
+        if (batches.empty() || batches.back().size() >= maxValuesPerQuery ||
+            (!batches.back().empty() && batchBytes + valueSize > kMaxFrontierBatchBytes)) {
+            batches.push_back(pExpCtx->getValueComparator().makeUnorderedValueSet());
+            batchBytes = 0;
         }
+        batches.back().insert(value);
+        batchBytes += valueSize;
     }
 
+    _frontier.clear();
+    _frontierUsageBytes = 0;
+    return batches;
+}
+
+BSONObj DocumentSourceGraphLookUp::makeMatchStageFromBatch(const ValueUnorderedSet& batch) const {
     // Create a query of the form {$and: [_additionalFilter, {_connectToField: {$in: [...]}}]}.
     //
     // We wrap the query in a $match so that it can be parsed into a DocumentSourceMatch when
@@ -356,7 +403,7 @@ boost::optional<BSONObj> DocumentSourceGraphLookUp::makeMatchStageFromFrontier(
                     BSONObjBuilder subObj(connectToObj.subobjStart(_connectToField.fullPath()));
                     {
                         BSONArrayBuilder in(subObj.subarrayStart("$in"));
-                        for (auto&& value : _frontier) {
+                        for (auto&& value : batch) {
                             in << value;
                         }
                     }
@@ -365,7 +412,7 @@ boost::optional<BSONObj> DocumentSourceGraphLookUp::makeMatchStageFromFrontier(
         }
     }
 
-    return _frontier.empty() ? boost::none : boost::optional<BSONObj>(match.obj());
+    return match.obj();
 }
 
 void DocumentSourceGraphLookUp::performSearch() {
@@ -431,13 +478,35 @@ Pipeline::SourceContainer::iterator DocumentSourceGraphLookUp::doOptimizeAt(
 }
 
 void DocumentSourceGraphLookUp::checkMemoryUsage() {
-    // TODO SERVER-23980: Implement spilling to disk if allowDiskUse is specified.
+    if ((_visitedUsageBytes + _frontierUsageBytes) >= _maxMemoryUsageBytes &&
+        !_spillFileName.empty() && !_visited.empty()) {
+        spillVisited();
+    }
+
     uassert(40099,
             "$graphLookup reached maximum memory consumption",
             (_visitedUsageBytes + _frontierUsageBytes) < _maxMemoryUsageBytes);
     _cache.evictDownTo(_maxMemoryUsageBytes - _frontierUsageBytes - _visitedUsageBytes);
 }
 
+void DocumentSourceGraphLookUp::spillVisited() {
+    SortedFileWriter<Value, Document> writer(
+        SortOptions().TempDir(pExpCtx->tempDir), _spillFileName, _nextSpillFileOffset);
+
+    // The spilled documents are only ever read back in order, so there's no need to sort them.
+    // Only the '_id' values, which move to '_spilledVisitedIds', still count against the memory
+    // limit afterwards.
+    for (auto&& [id, doc] : _visited) {
+        writer.addAlreadySorted(id, doc);
+        _visitedUsageBytes -= std::min(_visitedUsageBytes, doc.getApproximateSize());
+        _spilledVisitedIds.insert(id);
+    }
+    _visited.clear();
+
+    _spilledVisited.emplace_back(writer.done());
+    _nextSpillFileOffset = writer.getFileEndOffset();
+}
+
 void DocumentSourceGraphLookUp::serializeToArray(
     std::vector<Value>& array, boost::optional<ExplainOptions::Verbosity> explain) const {
     auto fromValue = (pExpCtx->ns.db() == _from.db())
@@ -511,6 +580,7 @@ DocumentSourceGraphLookUp::DocumentSourceGraphLookUp(
       _maxDepth(maxDepth),
       _frontier(pExpCtx->getValueComparator().makeUnorderedValueSet()),
       _visited(ValueComparator::kInstance.makeUnorderedValueMap<Document>()),
+      _spilledVisitedIds(ValueComparator::kInstance.makeUnorderedValueSet()),
       _cache(pExpCtx->getValueComparator()),
       _unwind(unwindSrc),
       _variables(expCtx->variables),
@@ -523,6 +593,17 @@ DocumentSourceGraphLookUp::DocumentSourceGraphLookUp(
     _fromPipeline = resolvedNamespace.pipeline;
     _fromPipeline.reserve(_fromPipeline.size() + 1);
     _fromPipeline.push_back(BSON("$match" << BSONObj()));
+
+    _maxMemoryUsageBytes = internalDocumentSourceGraphLookupMaxMemoryBytes.load();
+    if (pExpCtx->allowDiskUse && !pExpCtx->inMongos) {
+        _spillFileName = pExpCtx->tempDir + "/" + nextFileName();
+    }
+}
+
+DocumentSourceGraphLookUp::~DocumentSourceGraphLookUp() {
+    if (!_spillFileName.empty()) {
+        DESTRUCTOR_GUARD(boost::filesystem::remove(_spillFileName));
+    }
 }
 
 intrusive_ptr<DocumentSourceGraphLookUp> DocumentSourceGraphLookUp::create(
@@ -661,3 +742,6 @@ void DocumentSourceGraphLookUp::addInvolvedCollections(
     }
 }
 }  // namespace mongo
+
+#include "mongo/db/sorter/sorter.cpp"
+// Explicit instantiation unneeded since we aren't exposing Sorter outside of this file.
@@ -29,11 +29,14 @@
 
 #pragma once
 
+#include <deque>
+
 #include "mongo/db/exec/document_value/value_comparator.h"
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_unwind.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/lookup_set_cache.h"
+#include "mongo/db/sorter/sorter.h"
 
 namespace mongo {
 
@@ -60,6 +63,8 @@ public:
         }
     };
 
+    ~DocumentSourceGraphLookUp();
+
     const char* getSourceName() const final;
 
     const FieldPath& getConnectFromField() const {
@@ -95,7 +100,7 @@ public:
         StageConstraints constraints(StreamType::kStreaming,
                                      PositionRequirement::kNone,
                                      HostTypeRequirement::kPrimaryShard,
-                                     DiskUseRequirement::kNoDiskUse,
+                                     DiskUseRequirement::kWritesTmpData,
                                      FacetRequirement::kAllowed,
                                      TransactionRequirement::kAllowed,
                                      LookupRequirement::kAllowed,
@@ -165,15 +170,22 @@ private:
     }
 
     /**
-     * Prepares the query to execute on the 'from' collection wrapped in a $match by using the
-     * contents of '_frontier'.
+     * Splits the contents of '_frontier' which are not in the cache into batches, each of which
+     * is bounded both in its number of values and in its approximate size, and clears
+     * '_frontier'.
      *
      * Fills 'cached' with any values that were retrieved from the cache.
      *
-     * Returns boost::none if no query is necessary, i.e., all values were retrieved from the cache.
-     * Otherwise, returns a query object.
+     * Returns an empty vector if no query is necessary, i.e., all values were retrieved from the
+     * cache.
+     */
+    std::vector<ValueUnorderedSet> makeFrontierBatches(DocumentUnorderedSet* cached);
+
+    /**
+     * Prepares the query to execute on the 'from' collection wrapped in a $match, matching
+     * documents whose '_connectToField' is one of the values in 'batch'.
      */
-    boost::optional<BSONObj> makeMatchStageFromFrontier(DocumentUnorderedSet* cached);
+    BSONObj makeMatchStageFromBatch(const ValueUnorderedSet& batch) const;
 
     /**
      * If we have internalized a $unwind, getNext() dispatches to this function.
@@ -201,10 +213,31 @@ private:
 
     /**
      * Assert that '_visited' and '_frontier' have not exceeded the maximum meory usage, and then
-     * evict from '_cache' until this source is using less than '_maxMemoryUsageBytes'.
+     * evict from '_cache' until this source is using less than '_maxMemoryUsageBytes'. If disk use
+     * is allowed, the documents in '_visited' are spilled before giving up.
      */
     void checkMemoryUsage();
 
+    /**
+     * Writes the documents in '_visited' to disk, keeping only their '_id' values in memory so
+     * that the search can continue to de-duplicate against them.
+     */
+    void spillVisited();
+
+    /**
+     * Returns whether any discovered documents, whether in memory or spilled, have yet to be
+     * returned for the current input.
+     */
+    bool hasVisited() const {
+        return !_visited.empty() || !_spilledVisited.empty();
+    }
+
+    /**
+     * Removes and returns one of the discovered documents for the current input. Documents which
+     * were spilled are returned first. Must only be called if hasVisited() is true.
+     */
+    Document popVisited();
+
     /**
      * Process 'result', adding it to '_visited' with the given 'depth', and updating '_frontier'
      * with the object's 'connectTo' values.
@@ -230,7 +263,7 @@ private:
     // The aggregation pipeline to perform against the '_from' namespace.
     std::vector<BSONObj> _fromPipeline;
 
-    size_t _maxMemoryUsageBytes = 100 * 1024 * 1024;
+    size_t _maxMemoryUsageBytes;
 
     // Track memory usage to ensure we don't exceed '_maxMemoryUsageBytes'.
     size_t _visitedUsageBytes = 0;
@@ -244,6 +277,17 @@ private:
     // using the simple collation.
     ValueUnorderedMap<Document> _visited;
 
+    // When disk use is allowed and '_visited' grows too large, its documents are written to
+    // '_spillFileName' and only the '_id' values of spilled documents are kept in memory. Spilled
+    // documents are read back one at a time when building the output for the current input.
+    ValueUnorderedSet _spilledVisitedIds;
+    std::deque<std::shared_ptr<Sorter<Value, Document>::Iterator>> _spilledVisited;
+    std::string _spillFileName;
+    std::streampos _nextSpillFileOffset = 0;
+
+    // Whether the spill file has been opened for reading the front of '_spilledVisited'.
+    bool _spilledVisitedSourceOpen = false;
+
     // Caches query results to avoid repeating any work. This structure is maintained across calls
     // to getNext().
     LookupSetCache _cache;
@@ -39,8 +39,11 @@
 #include "mongo/db/pipeline/document_source_graph_lookup.h"
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/process_interface/stub_mongo_process_interface.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
@@ -69,11 +72,17 @@ public:
             ownedPipeline, PipelineDeleter(ownedPipeline->getContext()->opCtx));
         pipeline->addInitialSource(
             DocumentSourceMock::createForTest(_results, pipeline->getContext()));
+        ++_numPipelines;
         return pipeline;
     }
 
+    int getNumPipelines() const {
+        return _numPipelines;
+    }
+
 private:
     std::deque<DocumentSource::GetNextResult> _results;
+    int _numPipelines = 0;
 };
 
 // Tests that $graphLookup with special 'from' syntax from: {db: local, coll:
@@ -711,5 +720,139 @@ TEST_F(DocumentSourceGraphLookUpTest, ShouldNotExpandArraysWithinArraysAtEndOfCo
     ASSERT(graphLookupStage->getNext().isEOF());
 }
 
+TEST_F(DocumentSourceGraphLookUpTest, ShouldSplitLargeFrontierIntoSeveralQueries) {
+    auto expCtx = getExpCtx();
+
+    const auto originalMaxValues = internalDocumentSourceGraphLookupMaxValuesPerQuery.load();
+    internalDocumentSourceGraphLookupMaxValuesPerQuery.store(1);
+    ON_BLOCK_EXIT(
+        [&] { internalDocumentSourceGraphLookupMaxValuesPerQuery.store(originalMaxValues); });
+
+    std::deque<DocumentSource::GetNextResult> inputs{Document{{"_id", 0}, {"startVal", 0}}};
+    auto inputMock = DocumentSourceMock::createForTest(std::move(inputs), expCtx);
+
+    // The second level of the search has a frontier of [1, 2, 3], which takes three queries.
+    Document startDoc{{"_id", 0}, {"to", std::vector{1, 2, 3}}};
+    Document middle1{{"_id", 1}, {"to", 4}};
+    Document middle2{{"_id", 2}, {"to", 4}};
+    Document middle3{{"_id", 3}, {"to", 4}};
+    Document sinkDoc{{"_id", 4}};
+
+    std::deque<DocumentSource::GetNextResult> fromContents{Document(startDoc),
+                                                           Document(middle1),
+                                                           Document(middle2),
+                                                           Document(middle3),
+                                                           Document(sinkDoc)};
+
+    NamespaceString fromNs("test", "graph_lookup");
+    expCtx->setResolvedNamespaces(StringMap<ExpressionContext::ResolvedNamespace>{
+        {fromNs.coll().toString(), {fromNs, std::vector<BSONObj>()}}});
+    auto mongoInterface = std::make_shared<MockMongoInterface>(std::move(fromContents));
+    expCtx->mongoProcessInterface = mongoInterface;
+    auto graphLookupStage = DocumentSourceGraphLookUp::create(
+        expCtx,
+        fromNs,
+        "results",
+        "to",
+        "_id",
+        ExpressionFieldPath::deprecatedCreate(expCtx.get(), "startVal"),
+        boost::none,
+        boost::none,
+        boost::none,
+        boost::none);
+    graphLookupStage->setSource(inputMock.get());
+
+    auto next = graphLookupStage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+
+    auto resultsArray = next.getDocument().getField("results").getArray();
+    ASSERT_EQ(5U, resultsArray.size());
+    ASSERT(arrayContains(expCtx, resultsArray, Value(startDoc)));
+    ASSERT(arrayContains(expCtx, resultsArray, Value(middle1)));
+    ASSERT(arrayContains(expCtx, resultsArray, Value(middle2)));
+    ASSERT(arrayContains(expCtx, resultsArray, Value(middle3)));
+    ASSERT(arrayContains(expCtx, resultsArray, Value(sinkDoc)));
+    ASSERT(graphLookupStage->getNext().isEOF());
+
+    // One query each for [0] and [4], and one for each value of [1, 2, 3].
+    ASSERT_EQ(5, mongoInterface->getNumPipelines());
+}
+
+/**
+ * Runs a $graphLookup over a chain of large documents 0 -> 1 -> ... -> 9 with a memory limit that
+ * only allows a few of them to be held in memory at once.
+ */
+std::vector<Value> runGraphLookupOverLargeChain(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx, bool unwind) {
+    const auto originalMaxMemory = internalDocumentSourceGraphLookupMaxMemoryBytes.load();
+    internalDocumentSourceGraphLookupMaxMemoryBytes.store(4 * 1024);
+    ON_BLOCK_EXIT(
+        [&] { internalDocumentSourceGraphLookupMaxMemoryBytes.store(originalMaxMemory); });
+
+    const std::string largeStr(1024, 'x');
+    std::deque<DocumentSource::GetNextResult> fromContents;
+    for (int i = 0; i < 10; ++i) {
+        fromContents.push_back(Document{{"_id", i}, {"to", i + 1}, {"largeStr", largeStr}});
+    }
+
+    std::deque<DocumentSource::GetNextResult> inputs{Document{{"_id", 0}, {"startVal", 0}}};
+    auto inputMock = DocumentSourceMock::createForTest(std::move(inputs), expCtx);
+
+    NamespaceString fromNs("test", "graph_lookup");
+    expCtx->setResolvedNamespaces(StringMap<ExpressionContext::ResolvedNamespace>{
+        {fromNs.coll().toString(), {fromNs, std::vector<BSONObj>()}}});
+    expCtx->mongoProcessInterface = std::make_shared<MockMongoInterface>(std::move(fromContents));
+    auto graphLookupStage = DocumentSourceGraphLookUp::create(
+        expCtx,
+        fromNs,
+        "results",
+        "to",
+        "_id",
+        ExpressionFieldPath::deprecatedCreate(expCtx.get(), "startVal"),
+        boost::none,
+        boost::none,
+        boost::none,
+        unwind ? boost::make_optional(DocumentSourceUnwind::create(
+                     expCtx, "results", false, boost::optional<std::string>()))
+               : boost::none);
+    graphLookupStage->setSource(inputMock.get());
+
+    std::vector<Value> results;
+    auto next = graphLookupStage->getNext();
+    for (; next.isAdvanced(); next = graphLookupStage->getNext()) {
+        auto resultsValue = next.getDocument().getField("results");
+        if (unwind) {
+            results.push_back(resultsValue);
+        } else {
+            results = resultsValue.getArray();
+        }
+    }
+    ASSERT(next.isEOF());
+    return results;
+}
+
+TEST_F(DocumentSourceGraphLookUpTest, ShouldSpillVisitedDocumentsIfDiskUseAllowed) {
+    auto expCtx = getExpCtx();
+    unittest::TempDir tempDir("DocumentSourceGraphLookUpTest");
+    expCtx->tempDir = tempDir.path();
+    expCtx->allowDiskUse = true;
+
+    for (bool unwind : {false, true}) {
+        auto results = runGraphLookupOverLargeChain(expCtx, unwind);
+        ASSERT_EQ(10U, results.size());
+        for (int i = 0; i < 10; ++i) {
+            ASSERT(std::any_of(results.begin(), results.end(), [&](const Value& result) {
+                return result["_id"].getInt() == i;
+            }));
+        }
+    }
+}
+
+TEST_F(DocumentSourceGraphLookUpTest, ShouldFailOverMemoryLimitIfDiskUseNotAllowed) {
+    auto expCtx = getExpCtx();
+    expCtx->allowDiskUse = false;
+    ASSERT_THROWS_CODE(runGraphLookupOverLargeChain(expCtx, false), AssertionException, 40099);
+}
+
 }  // namespace
 }  // namespace mongo
@@ -41,6 +41,7 @@
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
+#include "mongo/db/query/collation/collation_index_key.h"
 #include "mongo/db/stats/resource_consumption_metrics.h"
 #include "mongo/util/destructor_guard.h"
 
@@ -134,6 +135,7 @@ const char* DocumentSourceGroup::getSourceName() const {
 }
 
 bool DocumentSourceGroup::shouldSpillWithAttemptToSaveMemory(std::function<int()> saveMemory) {
+    _memoryReservation.set(_memoryTracker.memoryUsageBytes);
     if (!_memoryTracker.allowDiskUse &&
         (_memoryTracker.memoryUsageBytes > _memoryTracker.maxMemoryUsageBytes)) {
         _memoryTracker.memoryUsageBytes -= saveMemory();
@@ -147,6 +149,11 @@ bool DocumentSourceGroup::shouldSpillWithAttemptToSaveMemory(std::function<int()
         _memoryTracker.memoryUsageBytes = 0;
         return true;
     }
+
+    if (_memoryTracker.allowDiskUse && _memoryReservation.shouldSpill()) {
+        _memoryTracker.memoryUsageBytes = 0;
+        return true;
+    }
     return false;
 }
 
@@ -246,10 +253,19 @@ DocumentSource::GetNextResult DocumentSourceGroup::getNextStandard() {
     return out;
 }
 
+void DocumentSourceGroup::detachFromOperationContext() {
+    _memoryReservation.detach();
+}
+
+void DocumentSourceGroup::reattachToOperationContext(OperationContext* opCtx) {
+    _memoryReservation.attach(opCtx);
+}
+
 void DocumentSourceGroup::doDispose() {
     // Free our resources.
     _groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
     _sorterIterator.reset();
+    _memoryReservation.set(0);
 
     // Make us look done.
     groupsIterator = _groups->end();
@@ -322,6 +338,12 @@ Value DocumentSourceGroup::serialize(boost::optional<ExplainOptions::Verbosity>
         out["totalOutputDataSizeBytes"] =
             Value(static_cast<long long>(_stats.totalOutputDataSizeBytes));
         out["usedDisk"] = Value(_stats.usedDisk);
+        if (_stats.usedDisk) {
+            out["spilledDataSizeBytes"] =
+                Value(static_cast<long long>(_stats.spilledDataSizeBytes));
+            out["spilledStorageSizeBytes"] =
+                Value(static_cast<long long>(_stats.spilledStorageSizeBytes));
+        }
     }
 
     return Value(out.freezeToValue());
@@ -411,6 +433,7 @@ DocumentSourceGroup::DocumentSourceGroup(const intrusive_ptr<ExpressionContext>&
         // We spill to disk in debug mode, regardless of allowDiskUse, to stress the system.
         _fileName = expCtx->tempDir + "/" + nextFileName();
     }
+    _memoryReservation.attach(expCtx->opCtx);
 }
 
 DocumentSourceGroup::~DocumentSourceGroup() {
@@ -537,6 +560,27 @@ public:
 private:
     ValueComparator _valueComparator;
 };
+
+/**
+ * Returns 'val' with every string in it replaced by its comparison key under 'collator', such that
+ * the results compare under the simple collation as the original values do under 'collator'.
+ */
+Value getCollationComparisonKey(const Value& val, const CollatorInterface* collator) {
+    if (!CollationIndexKey::isCollatableType(val.getType())) {
+        return val;
+    }
+
+    if (val.getType() == BSONType::String) {
+        return Value(collator->getComparisonString(val.getStringData()));
+    }
+
+    BSONObjBuilder input;
+    val.addToBsonObj(&input, ""_sd);
+
+    BSONObjBuilder output;
+    CollationIndexKey::collationAwareIndexKeyAppend(input.obj().firstElement(), collator, &output);
+    return Value(output.obj().firstElement());
+}
 }  // namespace
 
 DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
@@ -663,7 +707,25 @@ shared_ptr<Sorter<Value, Value>::Iterator> DocumentSourceGroup::spill() {
         ptrs.push_back(&*it);
     }
 
-    stable_sort(ptrs.begin(), ptrs.end(), SpillSTLComparator(pExpCtx->getValueComparator()));
+    if (const auto* collator = pExpCtx->getCollator()) {
+        // Compute the comparison key of each group once, instead of calling into the collator for
+        // every comparison the sort makes.
+        vector<pair<Value, const GroupsMap::value_type*>> keyedPtrs;
+        keyedPtrs.reserve(ptrs.size());
+        for (auto ptr : ptrs) {
+            keyedPtrs.emplace_back(getCollationComparisonKey(ptr->first, collator), ptr);
+        }
+
+        const ValueComparator simpleComparator;
+        stable_sort(keyedPtrs.begin(), keyedPtrs.end(), [&](const auto& lhs, const auto& rhs) {
+            return simpleComparator.evaluate(lhs.first < rhs.first);
+        });
+        for (size_t i = 0; i < keyedPtrs.size(); i++) {
+            ptrs[i] = keyedPtrs[i].second;
+        }
+    } else {
+        stable_sort(ptrs.begin(), ptrs.end(), SpillSTLComparator(pExpCtx->getValueComparator()));
+    }
 
     SortedFileWriter<Value, Value> writer(
         SortOptions().TempDir(pExpCtx->tempDir), _fileName, _nextSortedFileWriterOffset);
@@ -709,6 +771,8 @@ shared_ptr<Sorter<Value, Value>::Iterator> DocumentSourceGroup::spill() {
 
     Sorter<Value, Value>::Iterator* iteratorPtr = writer.done();
     _nextSortedFileWriterOffset = writer.getFileEndOffset();
+    _stats.spilledDataSizeBytes += writer.getSpilledDataSizeBytes();
+    _stats.spilledStorageSizeBytes += writer.getSpilledStorageSizeBytes();
     return shared_ptr<Sorter<Value, Value>::Iterator>(iteratorPtr);
 }
 
@@ -36,6 +36,7 @@
 #include "mongo/db/pipeline/accumulator.h"
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/transformer_interface.h"
+#include "mongo/db/query/query_memory_governor.h"
 #include "mongo/db/sorter/sorter.h"
 
 namespace mongo {
@@ -167,6 +168,10 @@ public:
         return &_stats;
     }
 
+    void detachFromOperationContext() final;
+
+    void reattachToOperationContext(OperationContext* opCtx) final;
+
     boost::optional<DistributedPlanLogic> distributedPlanLogic() final;
     bool canRunInParallelBeforeWriteStage(
         const std::set<std::string>& nameOfShardKeyFieldsUponEntryToStage) const final;
@@ -267,7 +272,8 @@ private:
      * 'maxMemoryUsageBytes' and cannot spill to disk. The 'saveMemory' function should return
      * the amount of memory saved by the cleanup.
      *
-     * Returns true, if the caller should spill to disk, false otherwise.
+     * Returns true, if the caller should spill to disk, false otherwise. A stage which may spill is
+     * also asked to spill when the QueryMemoryGovernor finds the server short of memory.
      */
     bool shouldSpillWithAttemptToSaveMemory(std::function<int()> saveMemory);
 
@@ -277,6 +283,9 @@ private:
 
     MemoryUsageTracker _memoryTracker;
 
+    // Reports the memory of the groups to the QueryMemoryGovernor.
+    QueryMemoryGovernor::Reservation _memoryReservation;
+
     GroupStats _stats;
 
     std::string _fileName;
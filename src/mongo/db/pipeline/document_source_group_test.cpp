@@ -50,11 +50,13 @@
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/query/collation/collator_interface_mock.h"
 #include "mongo/db/query/query_test_service_context.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/stdx/unordered_set.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/str.h"
 
 namespace mongo {
 
@@ -148,6 +150,56 @@ TEST_F(DocumentSourceGroupTest, ShouldBeAbleToPauseLoadingWhileSpilled) {
     ASSERT_EQ(idSet.count(2), 1UL);
 }
 
+TEST_F(DocumentSourceGroupTest, ShouldMergeGroupsEqualUnderCollationWhileSpilled) {
+    auto expCtx = getExpCtx();
+    expCtx->setCollator(
+        std::make_unique<CollatorInterfaceMock>(CollatorInterfaceMock::MockType::kToLowerString));
+
+    // Allow the $group stage to spill to disk.
+    TempDir tempDir("DocumentSourceGroupTest");
+    expCtx->tempDir = tempDir.path();
+    expCtx->allowDiskUse = true;
+    const size_t maxMemoryUsageBytes = 1000;
+
+    auto&& pushParser = AccumulationStatement::getParser("$push", boost::none);
+    auto pushArg = BSON(""
+                        << "$largeStr");
+    AccumulationStatement pushStatement{
+        "spaceHog",
+        pushParser(expCtx.get(), pushArg.firstElement(), expCtx->variablesParseState)};
+    auto&& sumParser = AccumulationStatement::getParser("$sum", boost::none);
+    auto sumArg = BSON("" << 1);
+    AccumulationStatement countStatement{
+        "count", sumParser(expCtx.get(), sumArg.firstElement(), expCtx->variablesParseState)};
+    auto groupByExpression =
+        ExpressionFieldPath::parse(expCtx.get(), "$_id", expCtx->variablesParseState);
+    auto group = DocumentSourceGroup::create(
+        expCtx, groupByExpression, {pushStatement, countStatement}, maxMemoryUsageBytes);
+
+    string largeStr(maxMemoryUsageBytes, 'x');
+    deque<DocumentSource::GetNextResult> inputs;
+    for (auto&& id : {"b", "A", "c", "a", "B", "C"}) {
+        inputs.emplace_back(Document{{"_id", id}, {"largeStr", largeStr}});
+    }
+    auto mock = DocumentSourceMock::createForTest(std::move(inputs), expCtx);
+    group->setSource(mock.get());
+
+    // Each spilled file holds a single group, and the groups which only differ in case are merged.
+    map<string, int> counts;
+    for (auto result = group->getNext(); result.isAdvanced(); result = group->getNext()) {
+        auto doc = result.releaseDocument();
+        auto id = str::toLower(doc["_id"].getStringData());
+        ASSERT_EQ(counts.count(id), 0UL);
+        counts[id] = doc["count"].coerceToInt();
+    }
+    ASSERT_TRUE(group->getNext().isEOF());
+
+    ASSERT_EQ(counts.size(), 3UL);
+    ASSERT_EQ(counts["a"], 2);
+    ASSERT_EQ(counts["b"], 2);
+    ASSERT_EQ(counts["c"], 2);
+}
+
 TEST_F(DocumentSourceGroupTest, ShouldErrorIfNotAllowedToSpillToDiskAndResultSetIsTooLarge) {
     auto expCtx = getExpCtx();
     const size_t maxMemoryUsageBytes = 1000;
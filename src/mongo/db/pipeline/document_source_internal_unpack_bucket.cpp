@@ -36,11 +36,17 @@
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/matcher/expression_algo.h"
 #include "mongo/db/matcher/expression_internal_expr_comparison.h"
+#include "mongo/db/matcher/expression_leaf.h"
+#include "mongo/db/pipeline/accumulator.h"
+#include "mongo/db/pipeline/document_source_group.h"
 #include "mongo/db/pipeline/document_source_match.h"
 #include "mongo/db/pipeline/document_source_project.h"
+#include "mongo/db/pipeline/document_source_replace_root.h"
+#include "mongo/db/pipeline/document_source_sort.h"
 #include "mongo/db/pipeline/document_source_single_document_transformation.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
+#include "mongo/db/timeseries/bucket_compression.h"
 
 namespace mongo {
 
@@ -150,6 +156,57 @@ auto extractInternalizableFieldsRemainingProjectAndType(
     }
 }
 
+/**
+ * Throws if 'bucket', which is being unpacked, holds no measurements.
+ */
+void assertBucketHasMeasurements(const BSONObj& bucket, bool hasMeasurements) {
+    uassert(5346509,
+            str::stream() << "A bucket with _id "
+                          << bucket[BucketUnpacker::kBucketIdFieldName].toString()
+                          << " contains an empty data region",
+            hasMeasurements);
+}
+
+/**
+ * Appends to 'predicates' copies of the comparisons in 'matchExpr', either a single comparison or
+ * the children of a conjunction, which can be decided from a single column value of a bucket. These
+ * are comparisons against a scalar on a top-level field other than the metaField. Every document
+ * matching 'matchExpr' satisfies each of them.
+ */
+void collectMeasurementPredicates(const MatchExpression* matchExpr,
+                                  const boost::optional<std::string>& metaField,
+                                  std::vector<std::unique_ptr<MatchExpression>>* predicates) {
+    if (matchExpr->matchType() == MatchExpression::AND) {
+        for (size_t i = 0; i < matchExpr->numChildren(); ++i) {
+            collectMeasurementPredicates(matchExpr->getChild(i), metaField, predicates);
+        }
+        return;
+    }
+    if (!ComparisonMatchExpression::isComparisonMatchExpression(matchExpr)) {
+        return;
+    }
+
+    auto comparison = static_cast<const ComparisonMatchExpression*>(matchExpr);
+    auto path = comparison->path();
+    if (path.empty() || path.find('.') != std::string::npos || (metaField && path == *metaField)) {
+        return;
+    }
+
+    // Comparisons with compound operands or with null may match values inside arrays or missing
+    // fields in ways a single column value cannot decide.
+    switch (comparison->getData().type()) {
+        case BSONType::Object:
+        case BSONType::Array:
+        case BSONType::jstNULL:
+        case BSONType::Undefined:
+        case BSONType::MinKey:
+        case BSONType::MaxKey:
+            return;
+        default:
+            predicates->push_back(comparison->shallowClone());
+    }
+}
+
 // Optimize the given pipeline after the $_internalUnpackBucket stage.
 void optimizeEndOfPipeline(Pipeline::SourceContainer::iterator itr,
                            Pipeline::SourceContainer* container) {
@@ -165,6 +222,8 @@ void optimizeEndOfPipeline(Pipeline::SourceContainer::iterator itr,
 void BucketUnpacker::reset(BSONObj&& bucket) {
     _fieldIters.clear();
     _timeFieldIter = boost::none;
+    _decompressedColumns.clear();
+    _filterColumns.clear();
 
     _bucket = std::move(bucket);
     uassert(5346510, "An empty bucket cannot be unpacked", !_bucket.isEmpty());
@@ -173,18 +232,26 @@ void BucketUnpacker::reset(BSONObj&& bucket) {
             _bucket.isOwned());
 
     auto&& dataRegion = _bucket.getField(kBucketDataFieldName).Obj();
-    if (dataRegion.isEmpty()) {
-        // If the data field of a bucket is present but it holds an empty object, there's nothing to
-        // unpack.
-        return;
-    }
+    // If the data field of a bucket is present but it holds an empty object, there's nothing to
+    // unpack.
+    assertBucketHasMeasurements(_bucket, !dataRegion.isEmpty());
 
     auto&& timeFieldElem = dataRegion.getField(_spec.timeField);
     uassert(5346700,
             "The $_internalUnpackBucket stage requires the data region to have a timeField object",
             timeFieldElem);
 
-    _timeFieldIter = BSONObjIterator{timeFieldElem.Obj()};
+    // Columns of compressed buckets have to be decompressed before they can be iterated. The
+    // decompressed columns are owned by the unpacker for as long as the iterators are in use.
+    auto columnObj = [&](const BSONElement& column) {
+        if (!timeseries::isCompressedColumn(column)) {
+            return column.Obj();
+        }
+        _decompressedColumns.push_back(timeseries::decompressColumn(column));
+        return _decompressedColumns.back();
+    };
+
+    _timeFieldIter = BSONObjIterator{columnObj(timeFieldElem)};
 
     _metaValue = _bucket[kBucketMetaFieldName];
     if (_spec.metaField) {
@@ -215,7 +282,65 @@ void BucketUnpacker::reset(BSONObj&& bucket) {
         }
         auto found = _spec.fieldSet.find(colName.toString()) != _spec.fieldSet.end();
         if ((_unpackerBehavior == Behavior::kInclude) == found) {
-            _fieldIters.push_back({colName.toString(), BSONObjIterator{elem.Obj()}});
+            _fieldIters.push_back({colName.toString(), BSONObjIterator{columnObj(elem)}});
+        }
+    }
+    assertBucketHasMeasurements(_bucket, _timeFieldIter->more());
+
+    // Each predicate of the measurement filter reads the column named by its path. A column which
+    // is not unpacked is missing from the materialized measurements as well.
+    for (auto&& predicate : _measurementFilter) {
+        auto path = predicate->path();
+        BSONObjIterator* column = nullptr;
+        if (path == _spec.timeField) {
+            column = _includeTimeField ? &*_timeFieldIter : nullptr;
+        } else if (auto it =
+                       std::find_if(_fieldIters.begin(),
+                                    _fieldIters.end(),
+                                    [&](auto&& fieldIter) { return fieldIter.first == path; });
+                   it != _fieldIters.end()) {
+            column = &it->second;
+        }
+        _filterColumns.push_back(column);
+    }
+    skipUnmatchedMeasurements();
+}
+
+bool BucketUnpacker::currentMeasurementMatchesFilter() {
+    auto&& currentIdx = (**_timeFieldIter).fieldNameStringData();
+    for (size_t i = 0; i < _measurementFilter.size(); ++i) {
+        // A measurement missing the column is evaluated against EOO, as the field is missing from
+        // the materialized measurement.
+        BSONElement elem;
+        if (auto column = _filterColumns[i]; column && column->more()) {
+            if (auto&& columnElem = **column; columnElem.fieldNameStringData() == currentIdx) {
+                elem = columnElem;
+            }
+        }
+
+        // An array matches a comparison if either the array itself or any of its elements do, so
+        // it is left for the full predicate to decide.
+        if (elem.type() != BSONType::Array && !_measurementFilter[i]->matchesSingleElement(elem)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void BucketUnpacker::skipUnmatchedMeasurements() {
+    if (_measurementFilter.empty()) {
+        return;
+    }
+
+    while (_timeFieldIter->more() && !currentMeasurementMatchesFilter()) {
+        auto&& timeElem = _timeFieldIter->next();
+        auto&& currentIdx = timeElem.fieldNameStringData();
+        for (auto&& fieldIter : _fieldIters) {
+            auto& colIter = fieldIter.second;
+            if (auto&& elem = *colIter;
+                colIter.more() && elem.fieldNameStringData() == currentIdx) {
+                colIter.advance(elem);
+            }
         }
     }
 }
@@ -247,6 +372,7 @@ Document BucketUnpacker::getNext() {
             colIter.advance(elem);
         }
     }
+    skipUnmatchedMeasurements();
 
     return measurement.freeze();
 }
@@ -344,24 +470,17 @@ Value DocumentSourceInternalUnpackBucket::serialize(
 }
 
 DocumentSource::GetNextResult DocumentSourceInternalUnpackBucket::doGetNext() {
-    if (_bucketUnpacker.hasNext()) {
-        return _bucketUnpacker.getNext();
-    }
-
-    auto nextResult = pSource->getNext();
-    if (nextResult.isAdvanced()) {
-        auto bucket = nextResult.getDocument().toBson();
-        _bucketUnpacker.reset(std::move(bucket));
-        uassert(
-            5346509,
-            str::stream() << "A bucket with _id "
-                          << _bucketUnpacker.bucket()[BucketUnpacker::kBucketIdFieldName].toString()
-                          << " contains an empty data region",
-            _bucketUnpacker.hasNext());
-        return _bucketUnpacker.getNext();
+    // Buckets none of whose measurements can match the measurement filter unpack to nothing, so
+    // keep pulling buckets until one has a measurement to return.
+    while (!_bucketUnpacker.hasNext()) {
+        auto nextResult = pSource->getNext();
+        if (!nextResult.isAdvanced()) {
+            return nextResult;
+        }
+        _bucketUnpacker.reset(nextResult.getDocument().toBson());
     }
 
-    return nextResult;
+    return _bucketUnpacker.getNext();
 }
 
 void DocumentSourceInternalUnpackBucket::internalizeProject(Pipeline::SourceContainer::iterator itr,
@@ -510,14 +629,91 @@ std::unique_ptr<MatchExpression> DocumentSourceInternalUnpackBucket::createPredi
     return nullptr;
 }
 
+bool DocumentSourceInternalUnpackBucket::optimizeLastpoint(Pipeline::SourceContainer::iterator itr,
+                                                           Pipeline::SourceContainer* container) {
+    auto&& spec = _bucketUnpacker.bucketSpec();
+    if (!spec.metaField || std::next(itr) == container->end() ||
+        std::next(itr, 2) == container->end()) {
+        return false;
+    }
+
+    // The $sort must order the measurements of each series by time, and must not have absorbed a
+    // $limit, which would apply across all series.
+    auto sortStage = dynamic_cast<DocumentSourceSort*>(std::next(itr)->get());
+    if (!sortStage || sortStage->hasLimit()) {
+        return false;
+    }
+    auto&& sortPattern = sortStage->getSortKeyPattern();
+    if (sortPattern.size() != 2 || !sortPattern[0].fieldPath || !sortPattern[1].fieldPath ||
+        sortPattern[0].fieldPath->fullPath() != *spec.metaField ||
+        sortPattern[1].fieldPath->fullPath() != spec.timeField) {
+        return false;
+    }
+
+    // The $group must group the measurements by series and only look at one document of each.
+    auto groupStage = dynamic_cast<DocumentSourceGroup*>(std::next(itr, 2)->get());
+    if (!groupStage || groupStage->doingMerge()) {
+        return false;
+    }
+    auto idFields = groupStage->getIdFields();
+    if (idFields.size() != 1) {
+        return false;
+    }
+    auto idPath = dynamic_cast<ExpressionFieldPath*>(idFields.begin()->second.get());
+    if (!idPath || !idPath->isRootFieldPath() || idPath->getFieldPath().getPathLength() != 2 ||
+        idPath->getFieldPath().tail().fullPath() != *spec.metaField) {
+        return false;
+    }
+    auto documentsNeeded = AccumulatorDocumentsNeeded::kFirstDocument;
+    auto&& accumulators = groupStage->getAccumulatedFields();
+    if (!accumulators.empty()) {
+        documentsNeeded = accumulators.front().makeAccumulator()->documentsNeeded();
+    }
+    if (documentsNeeded == AccumulatorDocumentsNeeded::kAllDocuments ||
+        std::any_of(accumulators.begin(), accumulators.end(), [&](auto&& accumulator) {
+            return accumulator.makeAccumulator()->documentsNeeded() != documentsNeeded;
+        })) {
+        return false;
+    }
+
+    // The latest measurement of a series is in the bucket with the greatest control.max time, and
+    // the earliest in the bucket with the least control.min time.
+    auto wantsLatest = sortPattern[1].isAscending ==
+        (documentsNeeded == AccumulatorDocumentsNeeded::kLastDocument);
+    auto bucketSort = BSON(BucketUnpacker::kBucketMetaFieldName
+                           << (sortPattern[0].isAscending ? 1 : -1)
+                           << (wantsLatest ? kControlMaxFieldName : kControlMinFieldName) +
+                               spec.timeField
+                           << (wantsLatest ? -1 : 1));
+    auto bucketGroup = BSON("$group" << BSON("_id" << ("$" + BucketUnpacker::kBucketMetaFieldName)
+                                                   << "bucket"
+                                                   << BSON("$first"
+                                                           << "$$ROOT")));
+    auto bucketReplaceRoot = BSON("$replaceRoot" << BSON("newRoot"
+                                                         << "$bucket"));
+
+    container->insert(itr, DocumentSourceSort::create(pExpCtx, bucketSort));
+    container->insert(itr,
+                      DocumentSourceGroup::createFromBson(bucketGroup.firstElement(), pExpCtx));
+    container->insert(
+        itr, DocumentSourceReplaceRoot::createFromBson(bucketReplaceRoot.firstElement(), pExpCtx));
+    return true;
+}
+
 Pipeline::SourceContainer::iterator DocumentSourceInternalUnpackBucket::doOptimizeAt(
     Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
     invariant(*itr == this);
 
+    // Any measurement filter is rebuilt below from the stages which now follow this one.
+    _bucketUnpacker.setMeasurementFilter({});
+
     if (std::next(itr) == container->end()) {
         return container->end();
     }
 
+    // Attempt to unpack only the bucket holding the first or last measurement of each series.
+    optimizeLastpoint(itr, container);
+
     // Attempt to map predicates on bucketed fields to predicates on the control field.
     if (auto nextMatch = dynamic_cast<DocumentSourceMatch*>((*std::next(itr)).get())) {
         if (auto match = createPredicatesOnControlField(nextMatch->getMatchExpression())) {
@@ -550,6 +746,18 @@ Pipeline::SourceContainer::iterator DocumentSourceInternalUnpackBucket::doOptimi
     // possible, and update the state of 'container' and '_bucketUnpacker' to reflect this.
     internalizeProject(itr, container);
 
+    // Skip the measurements which cannot match a $match following the $_internalUnpackBucket
+    // before they are materialized. The $match stays in the pipeline to apply the full predicate.
+    std::vector<std::unique_ptr<MatchExpression>> predicates;
+    if (std::next(itr) != container->end()) {
+        if (auto nextMatch = dynamic_cast<DocumentSourceMatch*>(std::next(itr)->get())) {
+            collectMeasurementPredicates(nextMatch->getMatchExpression(),
+                                         _bucketUnpacker.bucketSpec().metaField,
+                                         &predicates);
+        }
+    }
+    _bucketUnpacker.setMeasurementFilter(std::move(predicates));
+
     return container->end();
 }
 }  // namespace mongo
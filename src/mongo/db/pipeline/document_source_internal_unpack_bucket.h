@@ -31,6 +31,7 @@
 
 #include <set>
 
+#include "mongo/db/matcher/expression.h"
 #include "mongo/db/pipeline/document_source.h"
 
 namespace mongo {
@@ -107,7 +108,31 @@ public:
 
     void setBucketSpecAndBehavior(BucketSpec&& bucketSpec, Behavior behavior);
 
+    /**
+     * Sets the predicates on top-level measurement fields that a measurement must satisfy to be
+     * returned by getNext(). Each predicate is evaluated against a single value of the column
+     * named by its path, so measurements are rejected before they are materialized. The
+     * predicates are only a prefilter: a value which is an array is never rejected, so the
+     * measurements returned must still be filtered by the query they were taken from.
+     */
+    void setMeasurementFilter(std::vector<std::unique_ptr<MatchExpression>> predicates) {
+        _measurementFilter = std::move(predicates);
+    }
+
 private:
+    /**
+     * Returns whether the measurement at the current position of the column iterators can satisfy
+     * the measurement filter.
+     */
+    bool currentMeasurementMatchesFilter();
+
+    /**
+     * Advances the column iterators past the measurements which cannot satisfy the measurement
+     * filter.
+     */
+    void skipUnmatchedMeasurements();
+
+
     BucketSpec _spec;
     Behavior _unpackerBehavior;
 
@@ -131,6 +156,17 @@ private:
     // Iterators used to unpack the columns of the above bucket that are populated during the reset
     // phase according to the provided 'Behavior' and 'BucketSpec'.
     std::vector<std::pair<std::string, BSONObjIterator>> _fieldIters;
+
+    // The decompressed forms of the compressed columns iterated by '_timeFieldIter' and
+    // '_fieldIters'. Only the columns which are unpacked are decompressed.
+    std::vector<BSONObj> _decompressedColumns;
+
+    // Predicates on single column values used to skip measurements without materializing them.
+    std::vector<std::unique_ptr<MatchExpression>> _measurementFilter;
+
+    // The column iterator each predicate of '_measurementFilter' is evaluated against, or null if
+    // the column is missing from the bucket or is not unpacked. Populated during the reset phase.
+    std::vector<BSONObjIterator*> _filterColumns;
 };
 
 class DocumentSourceInternalUnpackBucket : public DocumentSource {
@@ -203,6 +239,29 @@ public:
     std::unique_ptr<MatchExpression> createPredicatesOnControlField(
         const MatchExpression* matchExpr) const;
 
+    /**
+     * Given a source container and an iterator pointing to the unpack stage, attempts to speed up
+     * a query for the first or last measurement of each series. If the $_internalUnpackBucket is
+     * followed by a $sort on the metaField and the timeField and a $group on the metaField whose
+     * accumulators all need only the first or only the last document of a group, inserts stages
+     * before the unpack which keep, for each metaField value, only the bucket holding the
+     * earliest or the latest measurement. For example, the pipeline
+     *
+     *     [{$_internalUnpackBucket: {...}},
+     *      {$sort: {myMeta: 1, time: -1}},
+     *      {$group: {_id: '$myMeta', last: {$first: '$a'}}}]
+     *
+     * will have the stages
+     *
+     *     [{$sort: {meta: 1, 'control.max.time': -1}},
+     *      {$group: {_id: '$meta', bucket: {$first: '$$ROOT'}}},
+     *      {$replaceRoot: {newRoot: '$bucket'}}]
+     *
+     * inserted before it. Returns whether the stages were inserted.
+     */
+    bool optimizeLastpoint(Pipeline::SourceContainer::iterator itr,
+                           Pipeline::SourceContainer* container);
+
 private:
     GetNextResult doGetNext() final;
 
@@ -0,0 +1,149 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/aggregation_context_fixture.h"
+#include "mongo/db/pipeline/document_source_internal_unpack_bucket.h"
+#include "mongo/db/pipeline/pipeline.h"
+#include "mongo/db/query/util/make_data_structure.h"
+
+namespace mongo {
+namespace {
+
+using InternalUnpackBucketOptimizeLastpointTest = AggregationContextFixture;
+
+constexpr auto kUnpackSpec =
+    "{$_internalUnpackBucket: {exclude: [], timeField: 't', metaField: 'tag'}}";
+
+/**
+ * Applies the lastpoint optimization to the pipeline of the unpack spec followed by 'sortSpec' and
+ * 'groupSpec', and checks the result. If 'expectedBucketSort' is empty, the optimization is
+ * expected not to apply.
+ */
+void assertOptimizeLastpoint(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                             const BSONObj& sortSpec,
+                             const BSONObj& groupSpec,
+                             const BSONObj& expectedBucketSort) {
+    auto pipeline = Pipeline::parse(makeVector(fromjson(kUnpackSpec), sortSpec, groupSpec), expCtx);
+    auto& container = pipeline->getSources();
+    ASSERT_EQ(container.size(), 3U);
+
+    auto applied = dynamic_cast<DocumentSourceInternalUnpackBucket*>(container.front().get())
+                       ->optimizeLastpoint(container.begin(), &container);
+    ASSERT_EQ(applied, !expectedBucketSort.isEmpty());
+    if (!applied) {
+        ASSERT_EQ(container.size(), 3U);
+        return;
+    }
+
+    auto stages = pipeline->serializeToBson();
+    ASSERT_EQ(stages.size(), 6U);
+    ASSERT_BSONOBJ_EQ(stages[0], BSON("$sort" << expectedBucketSort));
+    ASSERT_BSONOBJ_EQ(stages[1], fromjson("{$group: {_id: '$meta', bucket: {$first: '$$ROOT'}}}"));
+    ASSERT_BSONOBJ_EQ(stages[2], fromjson("{$replaceRoot: {newRoot: '$bucket'}}"));
+    ASSERT_BSONOBJ_EQ(stages[3], fromjson(kUnpackSpec));
+    ASSERT_BSONOBJ_EQ(stages[4], sortSpec);
+    ASSERT_BSONOBJ_EQ(stages[5], groupSpec);
+}
+
+TEST_F(InternalUnpackBucketOptimizeLastpointTest, LatestWithDescendingSortAndFirst) {
+    assertOptimizeLastpoint(getExpCtx(),
+                            fromjson("{$sort: {tag: 1, t: -1}}"),
+                            fromjson("{$group: {_id: '$tag', a: {$first: '$a'}}}"),
+                            fromjson("{meta: 1, 'control.max.t': -1}"));
+}
+
+TEST_F(InternalUnpackBucketOptimizeLastpointTest, LatestWithAscendingSortAndLast) {
+    assertOptimizeLastpoint(getExpCtx(),
+                            fromjson("{$sort: {tag: -1, t: 1}}"),
+                            fromjson("{$group: {_id: '$tag', a: {$last: '$a'}, b: {$last: '$b'}}}"),
+                            fromjson("{meta: -1, 'control.max.t': -1}"));
+}
+
+TEST_F(InternalUnpackBucketOptimizeLastpointTest, EarliestWithAscendingSortAndFirst) {
+    assertOptimizeLastpoint(getExpCtx(),
+                            fromjson("{$sort: {tag: 1, t: 1}}"),
+                            fromjson("{$group: {_id: '$tag', a: {$first: '$a'}}}"),
+                            fromjson("{meta: 1, 'control.min.t': 1}"));
+}
+
+TEST_F(InternalUnpackBucketOptimizeLastpointTest, DoesNotApplyToAccumulatorsNeedingAllDocuments) {
+    assertOptimizeLastpoint(getExpCtx(),
+                            fromjson("{$sort: {tag: 1, t: -1}}"),
+                            fromjson("{$group: {_id: '$tag', a: {$first: '$a'}, n: {$sum: 1}}}"),
+                            BSONObj());
+}
+
+TEST_F(InternalUnpackBucketOptimizeLastpointTest, DoesNotApplyToMixedFirstAndLast) {
+    assertOptimizeLastpoint(
+        getExpCtx(),
+        fromjson("{$sort: {tag: 1, t: -1}}"),
+        fromjson("{$group: {_id: '$tag', a: {$first: '$a'}, b: {$last: '$b'}}}"),
+        BSONObj());
+}
+
+TEST_F(InternalUnpackBucketOptimizeLastpointTest, DoesNotApplyWhenNotGroupingOnMetaField) {
+    assertOptimizeLastpoint(getExpCtx(),
+                            fromjson("{$sort: {tag: 1, t: -1}}"),
+                            fromjson("{$group: {_id: '$a', b: {$first: '$b'}}}"),
+                            BSONObj());
+    assertOptimizeLastpoint(getExpCtx(),
+                            fromjson("{$sort: {tag: 1, t: -1}}"),
+                            fromjson("{$group: {_id: '$tag.a', b: {$first: '$b'}}}"),
+                            BSONObj());
+}
+
+TEST_F(InternalUnpackBucketOptimizeLastpointTest, DoesNotApplyWhenNotSortingOnMetaFieldAndTime) {
+    assertOptimizeLastpoint(getExpCtx(),
+                            fromjson("{$sort: {t: -1}}"),
+                            fromjson("{$group: {_id: '$tag', a: {$first: '$a'}}}"),
+                            BSONObj());
+    assertOptimizeLastpoint(getExpCtx(),
+                            fromjson("{$sort: {tag: 1, a: -1}}"),
+                            fromjson("{$group: {_id: '$tag', a: {$first: '$a'}}}"),
+                            BSONObj());
+}
+
+TEST_F(InternalUnpackBucketOptimizeLastpointTest, DoesNotApplyWithoutMetaField) {
+    auto unpackSpec = fromjson("{$_internalUnpackBucket: {exclude: [], timeField: 't'}}");
+    auto pipeline =
+        Pipeline::parse(makeVector(unpackSpec,
+                                   fromjson("{$sort: {tag: 1, t: -1}}"),
+                                   fromjson("{$group: {_id: '$tag', a: {$first: '$a'}}}")),
+                        getExpCtx());
+    auto& container = pipeline->getSources();
+
+    ASSERT_FALSE(dynamic_cast<DocumentSourceInternalUnpackBucket*>(container.front().get())
+                     ->optimizeLastpoint(container.begin(), &container));
+    ASSERT_EQ(container.size(), 3U);
+}
+
+}  // namespace
+}  // namespace mongo
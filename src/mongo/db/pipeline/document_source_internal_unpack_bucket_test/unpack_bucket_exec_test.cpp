@@ -33,6 +33,9 @@
 #include "mongo/db/pipeline/aggregation_context_fixture.h"
 #include "mongo/db/pipeline/document_source_internal_unpack_bucket.h"
 #include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/pipeline/pipeline.h"
+#include "mongo/db/query/util/make_data_structure.h"
+#include "mongo/db/timeseries/bucket_compression.h"
 
 namespace mongo {
 namespace {
@@ -587,6 +590,132 @@ TEST_F(InternalUnpackBucketExecTest, BucketUnpackerHandlesNullMetadata) {
     ASSERT_TRUE(next.isEOF());
 }
 
+TEST_F(InternalUnpackBucketExecTest, UnpackCompressedBucket) {
+    auto expCtx = getExpCtx();
+    auto spec = BSON(
+        "$_internalUnpackBucket" << BSON(
+            "exclude" << BSON_ARRAY("b") << DocumentSourceInternalUnpackBucket::kTimeFieldName
+                      << kUserDefinedTimeName << DocumentSourceInternalUnpackBucket::kMetaFieldName
+                      << kUserDefinedMetaName));
+    auto unpack = DocumentSourceInternalUnpackBucket::createFromBson(spec.firstElement(), expCtx);
+
+    auto bucket = fromjson(
+        "{control: {version: 1}, meta: {m1: 999}, data: {_id: {'0': 1, '1': 2, '2': 3}, time: "
+        "{'0': {$date: 1000}, '1': {$date: 2000}, '2': {$date: 3000}}, a: {'0': 1.5, '2': 2.5}, "
+        "b: {'1': 'x'}}}");
+    auto compressed = timeseries::compressBucket(bucket);
+    ASSERT(compressed);
+    auto source = DocumentSourceMock::createForTest(Document(*compressed), expCtx);
+    unpack->setSource(source.get());
+
+    auto next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(
+        next.getDocument(),
+        Document(fromjson("{time: {$date: 1000}, myMeta: {m1: 999}, _id: 1, a: 1.5}")));
+
+    next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.getDocument(),
+                       Document(fromjson("{time: {$date: 2000}, myMeta: {m1: 999}, _id: 2}")));
+
+    next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(
+        next.getDocument(),
+        Document(fromjson("{time: {$date: 3000}, myMeta: {m1: 999}, _id: 3, a: 2.5}")));
+
+    next = unpack->getNext();
+    ASSERT_TRUE(next.isEOF());
+}
+
+/**
+ * Optimizes a pipeline of the $_internalUnpackBucket stage 'unpackSpec' followed by 'matchSpec',
+ * and returns the optimized unpack stage reading its buckets from 'source'.
+ */
+DocumentSourceInternalUnpackBucket* optimizedUnpackWithMatch(
+    std::unique_ptr<Pipeline, PipelineDeleter>& pipeline,
+    const BSONObj& unpackSpec,
+    const BSONObj& matchSpec,
+    DocumentSource* source,
+    const boost::intrusive_ptr<ExpressionContext>& expCtx) {
+    pipeline = Pipeline::parse(makeVector(unpackSpec, matchSpec), expCtx);
+    pipeline->optimizePipeline();
+    for (auto&& stage : pipeline->getSources()) {
+        if (auto unpack = dynamic_cast<DocumentSourceInternalUnpackBucket*>(stage.get())) {
+            unpack->setSource(source);
+            return unpack;
+        }
+    }
+    MONGO_UNREACHABLE;
+}
+
+TEST_F(InternalUnpackBucketExecTest, SkipsMeasurementsWhichCannotMatchFollowingMatch) {
+    auto expCtx = getExpCtx();
+    auto source = DocumentSourceMock::createForTest(
+        {"{meta: {m1: 999}, data: {_id: {'0': 1, '1': 2, '2': 3}, time: {'0': 1, '1': 2, '2': 3}, "
+         "a: {'0': 1, '1': [5], '2': 3}}}",
+         "{meta: {m1: 999}, data: {_id: {'0': 4, '1': 5}, time: {'0': 4, '1': 5}, a: {'0': 0, "
+         "'1': 1}}}",
+         "{meta: {m1: 999}, data: {_id: {'0': 6, '1': 7}, time: {'0': 6, '1': 7}, a: {'1': 4}}}"},
+        expCtx);
+    std::unique_ptr<Pipeline, PipelineDeleter> pipeline;
+    auto unpack = optimizedUnpackWithMatch(
+        pipeline,
+        fromjson("{$_internalUnpackBucket: {exclude: [], timeField: 'time', metaField: 'myMeta'}}"),
+        fromjson("{$match: {a: {$gte: 2}, time: {$gt: 0}}}"),
+        source.get(),
+        expCtx);
+
+    // An array is left for the $match to decide, and a bucket without a measurement which can match
+    // is skipped entirely.
+    auto next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.getDocument(),
+                       Document(fromjson("{time: 2, myMeta: {m1: 999}, _id: 2, a: [5]}")));
+
+    next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.getDocument(),
+                       Document(fromjson("{time: 3, myMeta: {m1: 999}, _id: 3, a: 3}")));
+
+    next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.getDocument(),
+                       Document(fromjson("{time: 7, myMeta: {m1: 999}, _id: 7, a: 4}")));
+
+    next = unpack->getNext();
+    ASSERT_TRUE(next.isEOF());
+}
+
+TEST_F(InternalUnpackBucketExecTest, DoesNotSkipMeasurementsOnMetaFieldOrDottedPathPredicates) {
+    auto expCtx = getExpCtx();
+    auto source = DocumentSourceMock::createForTest(
+        {"{meta: {m1: 999}, data: {_id: {'0': 1, '1': 2}, time: {'0': 1, '1': 2}, a: {'0': {b: 1}, "
+         "'1': [{b: 1}]}}}"},
+        expCtx);
+    std::unique_ptr<Pipeline, PipelineDeleter> pipeline;
+    auto unpack = optimizedUnpackWithMatch(
+        pipeline,
+        fromjson("{$_internalUnpackBucket: {exclude: [], timeField: 'time', metaField: 'myMeta'}}"),
+        fromjson("{$match: {'myMeta.m1': 999, 'a.b': 1}}"),
+        source.get(),
+        expCtx);
+
+    auto next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.getDocument(),
+                       Document(fromjson("{time: 1, myMeta: {m1: 999}, _id: 1, a: {b: 1}}")));
+
+    next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.getDocument(),
+                       Document(fromjson("{time: 2, myMeta: {m1: 999}, _id: 2, a: [{b: 1}]}")));
+
+    next = unpack->getNext();
+    ASSERT_TRUE(next.isEOF());
+}
+
 TEST_F(InternalUnpackBucketExecTest, ThrowsOnEmptyDataValue) {
     auto expCtx = getExpCtx();
     auto spec =
@@ -0,0 +1,109 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/document_source_lock_stats.h"
+
+#include "mongo/db/catalog/collection_catalog.h"
+#include "mongo/db/concurrency/resource_wait_tracker.h"
+
+namespace mongo {
+
+REGISTER_DOCUMENT_SOURCE(lockStats,
+                         DocumentSourceLockStats::LiteParsed::parse,
+                         DocumentSourceLockStats::createFromBson,
+                         LiteParsedDocumentSource::AllowedWithApiStrict::kNeverInVersion1);
+
+namespace {
+// The tracker bounds the number of resources it keeps, so all of them are returned.
+constexpr size_t kMaxResources = std::numeric_limits<size_t>::max();
+}  // namespace
+
+boost::intrusive_ptr<DocumentSource> DocumentSourceLockStats::createFromBson(
+    BSONElement spec, const boost::intrusive_ptr<ExpressionContext>& pExpCtx) {
+    const NamespaceString& nss = pExpCtx->ns;
+    uassert(ErrorCodes::InvalidNamespace,
+            str::stream() << kStageName
+                          << " must be run against the 'admin' database with {aggregate: 1}",
+            nss.db() == NamespaceString::kAdminDb && nss.isCollectionlessAggregateNS());
+
+    uassert(ErrorCodes::FailedToParse,
+            str::stream() << kStageName
+                          << " value must be an object. Found: " << typeName(spec.type()),
+            spec.type() == BSONType::Object);
+
+    uassert(ErrorCodes::FailedToParse,
+            str::stream() << kStageName << " parameters object must be empty",
+            spec.embeddedObject().isEmpty());
+
+    return new DocumentSourceLockStats(pExpCtx);
+}
+
+DocumentSource::GetNextResult DocumentSourceLockStats::doGetNext() {
+    if (!_haveRetrievedStats) {
+        auto catalog = CollectionCatalog::get(pExpCtx->opCtx);
+        for (const auto& stats : ResourceWaitTracker::get().getTopResources(kMaxResources)) {
+            BSONObjBuilder builder;
+            builder.append("resource", stats.resId.toString());
+            builder.append("type", resourceTypeName(stats.resId.getType()));
+            if (auto name = catalog->lookupResourceName(stats.resId)) {
+                builder.append("name", *name);
+            }
+            builder.appendNumber("numWaits", stats.numWaits);
+            builder.appendNumber("totalWaitMicros", stats.totalWaitMicros);
+            builder.appendNumber("maxOverestimateMicros", stats.maxOverestimateMicros);
+
+            BSONObjBuilder histogramBuilder(builder.subobjStart("waitMicrosHistogram"));
+            const auto& histogram = stats.waitMicrosHistogram;
+            for (size_t bucket = 0; bucket < histogram.size(); ++bucket) {
+                if (histogram[bucket] == 0) {
+                    continue;
+                }
+                const std::string name = bucket + 1 < histogram.size()
+                    ? str::stream() << "lt" << (1LL << bucket)
+                    : str::stream() << "gte" << (1LL << (bucket - 1));
+                histogramBuilder.appendNumber(name, histogram[bucket]);
+            }
+            histogramBuilder.done();
+
+            _results.push_back(builder.obj());
+        }
+        _resultsIter = _results.begin();
+        _haveRetrievedStats = true;
+    }
+
+    if (_resultsIter == _results.end()) {
+        return GetNextResult::makeEOF();
+    }
+
+    return Document{*_resultsIter++};
+}
+
+}  // namespace mongo
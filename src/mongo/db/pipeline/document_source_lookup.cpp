@@ -39,6 +39,8 @@
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression_algo.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/matcher/extensions_callback_noop.h"
 #include "mongo/db/pipeline/aggregation_request_helper.h"
 #include "mongo/db/pipeline/document_path_support.h"
 #include "mongo/db/pipeline/document_source_merge_gen.h"
@@ -48,6 +50,7 @@
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/platform/overflow_arithmetic.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/str.h"
 
 namespace mongo {
 
@@ -315,16 +318,25 @@ DocumentSource::GetNextResult DocumentSourceLookUp::doGetNext() {
     // '_unwindSrc' would be non-null, and we would not have made it here.
     invariant(!_matchSrc);
 
-    if (hasLocalFieldForeignFieldJoin()) {
-        auto matchStage =
-            makeMatchStageFromInput(inputDoc, *_localField, _foreignField->fullPath(), BSONObj());
-        // We've already allocated space for the trailing $match stage in '_resolvedPipeline'.
-        _resolvedPipeline[*_fieldMatchPipelineIdx] = matchStage;
-    }
-
     std::unique_ptr<Pipeline, PipelineDeleter> pipeline;
     try {
-        pipeline = buildPipeline(inputDoc);
+        if (_hashJoinState == HashJoinState::kNotStarted) {
+            buildHashJoinTable(inputDoc);
+        }
+
+        // If the foreign collection has been read into a hash table, we probe it below rather than
+        // running the foreign pipeline.
+        if (_hashJoinState != HashJoinState::kServing) {
+            if (hasLocalFieldForeignFieldJoin()) {
+                auto matchStage = makeMatchStageFromInput(
+                    inputDoc, *_localField, _foreignField->fullPath(), BSONObj());
+                // We've already allocated space for the trailing $match stage in
+                // '_resolvedPipeline'.
+                _resolvedPipeline[*_fieldMatchPipelineIdx] = matchStage;
+            }
+
+            pipeline = buildPipeline(inputDoc);
+        }
     } catch (const ExceptionForCat<ErrorCategory::StaleShardVersionError>& ex) {
         // If lookup on a sharded collection is disallowed and the foreign collection is sharded,
         // throw a custom exception.
@@ -341,9 +353,9 @@ DocumentSource::GetNextResult DocumentSourceLookUp::doGetNext() {
     long long objsize = 0;
     const auto maxBytes = internalLookupStageIntermediateDocumentMaxSizeBytes.load();
 
-    while (auto result = pipeline->getNext()) {
+    auto appendResult = [&](Document&& result) {
         long long safeSum = 0;
-        bool hasOverflowed = overflow::add(objsize, result->getApproximateSize(), &safeSum);
+        bool hasOverflowed = overflow::add(objsize, result.getApproximateSize(), &safeSum);
         uassert(4568,
                 str::stream() << "Total size of documents in " << _fromNs.coll()
                               << " matching pipeline's $lookup stage exceeds " << maxBytes
@@ -351,15 +363,141 @@ DocumentSource::GetNextResult DocumentSourceLookUp::doGetNext() {
 
                 !hasOverflowed && objsize <= maxBytes);
         objsize = safeSum;
-        results.emplace_back(std::move(*result));
+        results.emplace_back(std::move(result));
+    };
+
+    if (pipeline) {
+        while (auto result = pipeline->getNext()) {
+            appendResult(std::move(*result));
+        }
+        recordPlanSummaryStats(*pipeline);
+    } else {
+        for (auto&& result : probeHashJoinTable(inputDoc)) {
+            appendResult(std::move(result));
+        }
     }
 
-    recordPlanSummaryStats(*pipeline);
     MutableDocument output(std::move(inputDoc));
     output.setNestedField(_as, Value(std::move(results)));
     return output.freeze();
 }
 
+bool DocumentSourceLookUp::canUseHashJoin() const {
+    if (!internalQueryEnableLookupHashJoin.load() || !hasLocalFieldForeignFieldJoin() ||
+        hasPipeline() || _unwindSrc || _matchSrc || pExpCtx->inMongos) {
+        return false;
+    }
+
+    // The foreign pipeline must consist solely of the local/foreignField $match, and of any
+    // projection pushed down after it. If '_fromNs' is a view, the view pipeline precedes the
+    // $match and the documents it produces need not be stable across the iterations of this stage.
+    if (_resolvedPipeline.size() != (_foreignProjection ? 2U : 1U)) {
+        return false;
+    }
+
+    // The query system treats a numeric path component as either an array position or a field
+    // name, whereas document_path_support only follows it as an array position. Rather than
+    // reconcile the two, we do not hash join on such paths.
+    for (size_t i = 0; i < _foreignField->getPathLength(); ++i) {
+        if (str::parseUnsignedBase10Integer(_foreignField->getFieldName(i))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void DocumentSourceLookUp::buildHashJoinTable(const Document& inputDoc) {
+    invariant(_hashJoinState == HashJoinState::kNotStarted);
+    _hashJoinState = HashJoinState::kAbandoned;
+
+    if (!canUseHashJoin()) {
+        return;
+    }
+
+    // Read the entire foreign collection by replacing the join predicate with an empty $match.
+    _resolvedPipeline[*_fieldMatchPipelineIdx] = BSON("$match" << BSONObj());
+    auto pipeline = buildPipeline(inputDoc);
+
+    const auto maxBytes = internalQueryLookupHashJoinMaxMemoryBytes.load();
+    long long totalBytes = 0;
+    auto table = _fromExpCtx->getValueComparator().makeUnorderedValueMap<std::vector<size_t>>();
+    std::vector<Document> foreignDocs;
+
+    while (auto result = pipeline->getNext()) {
+        totalBytes += result->getApproximateSize();
+        if (totalBytes > maxBytes) {
+            // The foreign collection is too large to hold in memory. Querying it once per local
+            // document is cheaper than spilling the entire collection, so give up on the hash
+            // join.
+            recordPlanSummaryStats(*pipeline);
+            return;
+        }
+
+        const auto docIdx = foreignDocs.size();
+        document_path_support::visitAllValuesAtPath(
+            *result, *_foreignField, [&](const Value& key) {
+                // A document with an array holding the same value several times is recorded once.
+                auto& docIdxs = table[key];
+                if (docIdxs.empty() || docIdxs.back() != docIdx) {
+                    docIdxs.push_back(docIdx);
+                }
+            });
+        foreignDocs.push_back(std::move(*result));
+    }
+
+    recordPlanSummaryStats(*pipeline);
+    _hashJoinForeignDocs = std::move(foreignDocs);
+    _hashJoinTable = std::move(table);
+    _hashJoinState = HashJoinState::kServing;
+}
+
+std::vector<Document> DocumentSourceLookUp::probeHashJoinTable(const Document& inputDoc) {
+    invariant(_hashJoinState == HashJoinState::kServing);
+
+    // A local value which is missing, null or an array cannot be answered from the hash table. For
+    // example, {$eq: null} also matches foreign documents which lack '_foreignField' entirely, and
+    // {$eq: [1, 2]} matches the whole array rather than its elements. Such local documents are
+    // joined by evaluating the usual $match against every foreign document.
+    bool mustScan = false;
+    bool hasLocalValue = false;
+    std::vector<size_t> docIdxs;
+    document_path_support::visitAllValuesAtPath(inputDoc, *_localField, [&](const Value& key) {
+        hasLocalValue = true;
+        if (key.nullish() || key.isArray()) {
+            mustScan = true;
+        } else if (auto it = _hashJoinTable->find(key); it != _hashJoinTable->end()) {
+            docIdxs.insert(docIdxs.end(), it->second.begin(), it->second.end());
+        }
+    });
+
+    std::vector<Document> results;
+    if (mustScan || !hasLocalValue) {
+        auto matchStage =
+            makeMatchStageFromInput(inputDoc, *_localField, _foreignField->fullPath(), BSONObj());
+        auto expression =
+            uassertStatusOK(MatchExpressionParser::parse(matchStage.firstElement().embeddedObject(),
+                                                         _fromExpCtx,
+                                                         ExtensionsCallbackNoop(),
+                                                         Pipeline::kAllowedMatcherFeatures));
+        for (auto&& foreignDoc : _hashJoinForeignDocs) {
+            if (expression->matchesBSON(foreignDoc.toBson())) {
+                results.push_back(foreignDoc);
+            }
+        }
+        return results;
+    }
+
+    // Return each matching foreign document once, in the order they were read.
+    std::sort(docIdxs.begin(), docIdxs.end());
+    docIdxs.erase(std::unique(docIdxs.begin(), docIdxs.end()), docIdxs.end());
+    results.reserve(docIdxs.size());
+    for (auto docIdx : docIdxs) {
+        results.push_back(_hashJoinForeignDocs[docIdx]);
+    }
+    return results;
+}
+
 std::unique_ptr<Pipeline, PipelineDeleter> DocumentSourceLookUp::buildPipeline(
     const Document& inputDoc) {
     // Copy all 'let' variables into the foreign pipeline's expression context.
@@ -438,6 +576,8 @@ Pipeline::SourceContainer::iterator DocumentSourceLookUp::doOptimizeAt(
     Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
     invariant(*itr == this);
 
+    pushDownProjection(itr, container);
+
     if (std::next(itr) == container->end()) {
         return container->end();
     }
@@ -548,7 +688,9 @@ Pipeline::SourceContainer::iterator DocumentSourceLookUp::doOptimizeAt(
     // during 'doGetNext()'.
     if (hasPipeline()) {
         auto matchObj = BSON("$match" << *_additionalFilter);
-        _resolvedPipeline.push_back(matchObj);
+        _resolvedPipeline.insert(_foreignProjection ? std::prev(_resolvedPipeline.end())
+                                                    : _resolvedPipeline.end(),
+                                 matchObj);
     }
 
     // There may be further optimization between this $lookup and the new neighbor, so we return an
@@ -556,6 +698,52 @@ Pipeline::SourceContainer::iterator DocumentSourceLookUp::doOptimizeAt(
     return itr;
 }
 
+void DocumentSourceLookUp::pushDownProjection(Pipeline::SourceContainer::iterator itr,
+                                              Pipeline::SourceContainer* container) {
+    if (_foreignProjection) {
+        _resolvedPipeline.pop_back();
+        _foreignProjection = boost::none;
+    }
+
+    if (!internalQueryLookupPushDownProjection.load()) {
+        return;
+    }
+
+    auto deps = Pipeline::getDependenciesForContainer(
+        pExpCtx, Pipeline::SourceContainer(std::next(itr), container->end()), boost::none);
+    // The fields of an absorbed $match are filtered on before the projection.
+    if (_matchSrc) {
+        _matchSrc->getDependencies(&deps);
+    }
+    if (deps.needWholeDocument) {
+        return;
+    }
+
+    const auto& asPath = _as.fullPath();
+    DepsTracker foreignDeps;
+    for (auto&& field : deps.fields) {
+        if (expression::isPathPrefixOf(asPath, field)) {
+            foreignDeps.fields.insert(field.substr(asPath.size() + 1));
+        } else if (field == asPath || expression::isPathPrefixOf(field, asPath)) {
+            // A later stage depends on the joined documents as a whole.
+            return;
+        }
+    }
+
+    // A hash join looks up the foreign documents by the foreign field.
+    if (hasLocalFieldForeignFieldJoin()) {
+        foreignDeps.fields.insert(_foreignField->fullPath());
+    }
+
+    // When the later stages need no field of the joined documents, only their number matters.
+    auto projection = foreignDeps.toProjectionWithoutMetadata();
+    if (projection.isEmpty()) {
+        projection = BSON("_id" << 1);
+    }
+    _resolvedPipeline.push_back(BSON("$project" << projection));
+    _foreignProjection = projection.getOwned();
+}
+
 bool DocumentSourceLookUp::usedDisk() {
     if (_pipeline)
         _stats.planSummaryStats.usedDisk =
@@ -858,6 +1046,10 @@ void DocumentSourceLookUp::serializeToArray(
             output[getSourceName()]["matching"] = Value(*_additionalFilter);
         }
 
+        if (_foreignProjection) {
+            output[getSourceName()]["projecting"] = Value(*_foreignProjection);
+        }
+
         array.push_back(Value(output.freeze()));
     } else {
         array.push_back(Value(output.freeze()));
@@ -253,6 +253,35 @@ private:
 
     GetNextResult unwindResult();
 
+    /**
+     * Returns true if this $lookup may join by reading the foreign collection once into an
+     * in-memory hash table, rather than running the foreign pipeline for each local document.
+     */
+    bool canUseHashJoin() const;
+
+    /**
+     * Reads the entire foreign collection and builds '_hashJoinTable' keyed on the values at
+     * '_foreignField'. Abandons the hash join if the foreign documents do not fit within
+     * 'internalQueryLookupHashJoinMaxMemoryBytes', leaving this stage to fall back to running the
+     * foreign pipeline per local document.
+     */
+    void buildHashJoinTable(const Document& inputDoc);
+
+    /**
+     * Returns the foreign documents which join with 'inputDoc', in the order in which they were
+     * read from the foreign collection. May only be called once the hash table has been built.
+     */
+    std::vector<Document> probeHashJoinTable(const Document& inputDoc);
+
+    /**
+     * Appends to the foreign pipeline a projection of the fields of the joined documents which the
+     * stages following 'itr' depend on, replacing the projection pushed down by an earlier call.
+     * No projection is pushed down if the later stages may depend on the joined documents as a
+     * whole.
+     */
+    void pushDownProjection(Pipeline::SourceContainer::iterator itr,
+                            Pipeline::SourceContainer* container);
+
     /**
      * Resolves let defined variables against 'localDoc' and stores the results in 'variables'.
      */
@@ -292,6 +321,8 @@ private:
     NamespaceString _resolvedNs;
     FieldPath _as;
     boost::optional<BSONObj> _additionalFilter;
+    // The projection which ends '_resolvedPipeline', when one has been pushed down.
+    boost::optional<BSONObj> _foreignProjection;
 
     // For use when $lookup is specified with localField/foreignField syntax.
     boost::optional<FieldPath> _localField;
@@ -327,6 +358,14 @@ private:
 
     std::vector<LetVariable> _letVariables;
 
+    // State used when an uncorrelated localField/foreignField $lookup joins via an in-memory hash
+    // table built from the foreign collection. Each key of '_hashJoinTable' maps to the indexes of
+    // the documents in '_hashJoinForeignDocs' which have that value at '_foreignField'.
+    enum class HashJoinState { kNotStarted, kServing, kAbandoned };
+    HashJoinState _hashJoinState = HashJoinState::kNotStarted;
+    std::vector<Document> _hashJoinForeignDocs;
+    boost::optional<ValueUnorderedMap<std::vector<size_t>>> _hashJoinTable;
+
     boost::intrusive_ptr<DocumentSourceMatch> _matchSrc;
     boost::intrusive_ptr<DocumentSourceUnwind> _unwindSrc;
 
@@ -31,7 +31,12 @@
 
 #include "mongo/db/pipeline/document_source_lookup_change_post_image.h"
 
+#include <algorithm>
+#include <utility>
+
 #include "mongo/bson/simple_bsonelement_comparator.h"
+#include "mongo/db/query/find_common.h"
+#include "mongo/db/query/query_knobs_gen.h"
 
 namespace mongo {
 
@@ -49,22 +54,135 @@ Value assertFieldHasType(const Document& fullDoc, StringData fieldName, BSONType
             val.getType() == expectedType);
     return val;
 }
+
+bool isUpdateOp(const Document& inputDoc) {
+    auto opTypeVal = assertFieldHasType(
+        inputDoc, DocumentSourceChangeStream::kOperationTypeField, BSONType::String);
+    return opTypeVal.getString() == DocumentSourceChangeStream::kUpdateOpType;
+}
 }  // namespace
 
 DocumentSource::GetNextResult DocumentSourceLookupChangePostImage::doGetNext() {
-    auto input = pSource->getNext();
-    if (!input.isAdvanced()) {
-        return input;
+    if (_batch.empty()) {
+        // Whatever ended the previous batch is returned once all of its events have been.
+        if (!_endOfBatchError.isOK()) {
+            uassertStatusOK(std::exchange(_endOfBatchError, Status::OK()));
+        }
+        if (_endOfBatch) {
+            auto endOfBatch = std::move(*_endOfBatch);
+            _endOfBatch = boost::none;
+            return endOfBatch;
+        }
+
+        auto input = pSource->getNext();
+        if (!input.isAdvanced() || !isUpdateOp(input.getDocument())) {
+            return input;
+        }
+        loadBatch(input.releaseDocument());
     }
-    auto opTypeVal = assertFieldHasType(
-        input.getDocument(), DocumentSourceChangeStream::kOperationTypeField, BSONType::String);
-    if (opTypeVal.getString() != DocumentSourceChangeStream::kUpdateOpType) {
-        return input;
+
+    Document next = std::move(_batch.front());
+    _batch.pop_front();
+    return next;
+}
+
+void DocumentSourceLookupChangePostImage::loadBatch(Document updateOp) {
+    _batch.push_back(std::move(updateOp));
+
+    // Like DocumentSourceCursor, we don't read ahead as long as the operation waits for inserts,
+    // since each event must go through the whole pipeline to find out whether to stop waiting. On
+    // mongoS the lookups need a read concern, and are done one at a time.
+    const size_t maxUpdates =
+        pExpCtx->inMongos || awaitDataState(pExpCtx->opCtx).shouldWaitForInserts
+        ? 1
+        : internalChangeStreamPostImageLookupBatchSize.load();
+    size_t numUpdates = 1;
+    try {
+        while (numUpdates < maxUpdates) {
+            auto next = pSource->getNext();
+            if (!next.isAdvanced()) {
+                _endOfBatch = std::move(next);
+                break;
+            }
+            if (isUpdateOp(next.getDocument())) {
+                ++numUpdates;
+            }
+            _batch.push_back(next.releaseDocument());
+        }
+    } catch (const DBException& ex) {
+        // The events which were read before the error are returned first.
+        _endOfBatchError = ex.toStatus();
+    }
+
+    // The updates of the documents of a collection which are identified by their _id alone are
+    // looked up together. Other documents are looked up one at a time.
+    struct CollectionLookup {
+        NamespaceString nss;
+        UUID collectionUUID;
+        std::vector<size_t> positions;
+        std::vector<Value> ids;
+    };
+    std::vector<CollectionLookup> lookups;
+    try {
+        for (size_t pos = 0; pos < _batch.size(); ++pos) {
+            if (!isUpdateOp(_batch[pos])) {
+                continue;
+            }
+
+            auto documentKey = assertFieldHasType(_batch[pos],
+                                                  DocumentSourceChangeStream::kDocumentKeyField,
+                                                  BSONType::Object)
+                                   .getDocument();
+            auto id = documentKey["_id"_sd];
+            if (numUpdates == 1 || id.missing() || documentKey.computeSize() != 1) {
+                MutableDocument output(std::move(_batch[pos]));
+                output[kFullDocumentFieldName] = lookupPostImage(output.peek());
+                _batch[pos] = output.freeze();
+                continue;
+            }
+
+            auto nss = assertValidNamespace(_batch[pos]);
+            auto resumeToken =
+                ResumeToken::parse(_batch[pos][DocumentSourceChangeStream::kIdField].getDocument());
+            invariant(resumeToken.getData().uuid);
+            UUID collectionUUID = *resumeToken.getData().uuid;
+
+            auto lookup = std::find_if(lookups.begin(), lookups.end(), [&](const auto& other) {
+                return other.nss == nss && other.collectionUUID == collectionUUID;
+            });
+            if (lookup == lookups.end()) {
+                lookup =
+                    lookups.insert(lookups.end(), CollectionLookup{nss, collectionUUID, {}, {}});
+            }
+            lookup->positions.push_back(pos);
+            lookup->ids.push_back(id);
+        }
+
+        for (auto&& lookup : lookups) {
+            lookupPostImagesById(lookup.nss, lookup.collectionUUID, lookup.positions, lookup.ids);
+        }
+    } catch (const DBException&) {
+        // None of the events may be returned without their post-images.
+        _batch.clear();
+        throw;
     }
+}
 
-    MutableDocument output(input.releaseDocument());
-    output[kFullDocumentFieldName] = lookupPostImage(output.peek());
-    return output.freeze();
+void DocumentSourceLookupChangePostImage::lookupPostImagesById(
+    const NamespaceString& nss,
+    UUID collectionUUID,
+    const std::vector<size_t>& positions,
+    const std::vector<Value>& ids) {
+    auto lookedUpDocs =
+        pExpCtx->mongoProcessInterface->lookupDocumentsById(pExpCtx, nss, collectionUUID, ids);
+    invariant(lookedUpDocs.size() == positions.size());
+
+    for (size_t i = 0; i < positions.size(); ++i) {
+        MutableDocument output(std::move(_batch[positions[i]]));
+        output[kFullDocumentFieldName] =
+            lookedUpDocs[i] ? Value(*lookedUpDocs[i]) : Value(BSONNULL);
+        _batch[positions[i]] = output.freeze();
+    }
 }
 
 NamespaceString DocumentSourceLookupChangePostImage::assertValidNamespace(
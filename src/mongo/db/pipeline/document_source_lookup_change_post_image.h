@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <deque>
+
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_change_stream.h"
 
@@ -37,6 +39,10 @@ namespace mongo {
 /**
  * Part of the change stream API machinery used to look up the post-image of a document. Uses the
  * "documentKey" field of the input to look up the new version of the document.
+ *
+ * On a mongod, once the operation no longer waits for new events, this stage reads ahead up to
+ * 'internalChangeStreamPostImageLookupBatchSize' update events and looks up the documents of each
+ * collection which are identified by their _id alone in a single query.
  */
 class DocumentSourceLookupChangePostImage final : public DocumentSource {
 public:
@@ -114,6 +120,21 @@ private:
      */
     GetNextResult doGetNext() final;
 
+    /**
+     * Appends the events following the update 'updateOp' to '_batch', and looks up the post-images
+     * of all of the updates in it.
+     */
+    void loadBatch(Document updateOp);
+
+    /**
+     * Sets the "fullDocument" field of the update events in '_batch' at 'positions' to the
+     * documents with the _ids 'ids' in the collection 'nss', looked up at once.
+     */
+    void lookupPostImagesById(const NamespaceString& nss,
+                              UUID collectionUUID,
+                              const std::vector<size_t>& positions,
+                              const std::vector<Value>& ids);
+
     /**
      * Uses the "documentKey" field from 'updateOp' to look up the current version of the document.
      * Returns Value(BSONNULL) if the document couldn't be found.
@@ -126,6 +147,15 @@ private:
      * function verifies that the only the database names match.
      */
     NamespaceString assertValidNamespace(const Document& inputDoc) const;
+
+    // The events which were read ahead, with the post-images of the updates, to be returned in
+    // order.
+    std::deque<Document> _batch;
+
+    // The result which ended the batch, either a pause or an error, returned once '_batch' is
+    // empty.
+    boost::optional<GetNextResult> _endOfBatch;
+    Status _endOfBatchError = Status::OK();
 };
 
 }  // namespace mongo
@@ -334,5 +334,63 @@ TEST_F(DocumentSourceLookupChangePostImageTest, ShouldPropagatePauses) {
     ASSERT_TRUE(lookupChangeStage->getNext().isEOF());
 }
 
+TEST_F(DocumentSourceLookupChangePostImageTest, ShouldLookUpPostImagesOfABatchOfUpdates) {
+    auto expCtx = getExpCtx();
+
+    // Set up the lookup change post image stage.
+    auto lookupChangeStage = DocumentSourceLookupChangePostImage::create(expCtx);
+
+    // Mock its input with updates of the same and of different documents, one of which is not
+    // identified by its _id alone, and an insert in between.
+    auto makeEvent = [&](int tokenId, StringData opType, Document documentKey) {
+        return Document{{"_id", makeResumeToken(tokenId)},
+                        {"documentKey", documentKey},
+                        {"operationType", opType},
+                        {"ns", Document{{"db", expCtx->ns.db()}, {"coll", expCtx->ns.coll()}}}};
+    };
+    auto mockLocalSource = DocumentSourceMock::createForTest(
+        {makeEvent(0, "update"_sd, Document{{"_id", 0}}),
+         makeEvent(1, "insert"_sd, Document{{"_id", 1}}),
+         makeEvent(2, "update"_sd, Document{{"_id", 2}}),
+         makeEvent(3, "update"_sd, Document{{"_id", 0}}),
+         makeEvent(4, "update"_sd, Document{{"x", 1}, {"_id", 1}}),
+         makeEvent(5, "update"_sd, Document{{"_id", 5}}),
+         DocumentSource::GetNextResult::makePauseExecution()},
+        expCtx);
+
+    lookupChangeStage->setSource(mockLocalSource.get());
+
+    // Mock out the foreign collection, in which the document with _id 5 was deleted.
+    deque<DocumentSource::GetNextResult> mockForeignContents{Document{{"_id", 0}, {"x", 0}},
+                                                             Document{{"_id", 1}, {"x", 1}},
+                                                             Document{{"_id", 2}, {"x", 2}}};
+    getExpCtx()->mongoProcessInterface =
+        std::make_unique<MockMongoInterface>(std::move(mockForeignContents));
+
+    auto assertNextIs = [&](Document expected, Value fullDocument) {
+        auto next = lookupChangeStage->getNext();
+        ASSERT_TRUE(next.isAdvanced());
+        if (!fullDocument.missing()) {
+            MutableDocument withFullDocument(std::move(expected));
+            withFullDocument["fullDocument"] = fullDocument;
+            expected = withFullDocument.freeze();
+        }
+        ASSERT_DOCUMENT_EQ(next.releaseDocument(), expected);
+    };
+    assertNextIs(makeEvent(0, "update"_sd, Document{{"_id", 0}}),
+                 Value(Document{{"_id", 0}, {"x", 0}}));
+    assertNextIs(makeEvent(1, "insert"_sd, Document{{"_id", 1}}), Value());
+    assertNextIs(makeEvent(2, "update"_sd, Document{{"_id", 2}}),
+                 Value(Document{{"_id", 2}, {"x", 2}}));
+    assertNextIs(makeEvent(3, "update"_sd, Document{{"_id", 0}}),
+                 Value(Document{{"_id", 0}, {"x", 0}}));
+    assertNextIs(makeEvent(4, "update"_sd, Document{{"x", 1}, {"_id", 1}}),
+                 Value(Document{{"_id", 1}, {"x", 1}}));
+    assertNextIs(makeEvent(5, "update"_sd, Document{{"_id", 5}}), Value(BSONNULL));
+
+    ASSERT_TRUE(lookupChangeStage->getNext().isPaused());
+    ASSERT_TRUE(lookupChangeStage->getNext().isEOF());
+}
+
 }  // namespace
 }  // namespace mongo
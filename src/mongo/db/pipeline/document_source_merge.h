@@ -182,12 +182,19 @@ private:
         return bob.obj();
     }
 
-    void spill(BatchedObjects&& batch) override;
+    void spill(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+               BatchedObjects&& batch) override;
 
     void waitWhileFailPointEnabled() override;
 
     std::pair<BatchObject, int> makeBatchObject(Document&& doc) const override;
 
+    Document getPartitionKey(const BatchObject& obj) const override {
+        // The output is partitioned by the 'on' fields, as the documents with the same values for
+        // them may be merged into the same target document.
+        return Document{std::get<0>(obj)};
+    }
+
     boost::optional<ChunkVersion> _targetCollectionVersion;
 
     // A merge descriptor contains a merge strategy function describing how to merge two
@@ -36,8 +36,10 @@
 #include <fmt/format.h>
 
 #include "mongo/db/curop_failpoint_helpers.h"
+#include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/ops/write_ops.h"
 #include "mongo/db/pipeline/document_path_support.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/get_status_from_command_result.h"
 #include "mongo/util/destructor_guard.h"
@@ -151,10 +153,25 @@ void DocumentSourceOut::initialize() {
         return;
     }
 
-    // Copy the indexes of the output collection to the temp collection.
+    // Copy the indexes of the output collection to the temp collection. When index builds are
+    // deferred, only the _id index is created now. The other indexes are built once the results
+    // have been written, which sorts their keys and bulk loads them instead of inserting them one
+    // document at a time.
+    const bool deferIndexBuilds = internalQueryOutDeferIndexBuilds.load();
+    std::vector<BSONObj> tempNsIndexes;
+    for (auto&& spec : _originalIndexes) {
+        if (deferIndexBuilds &&
+            !IndexDescriptor::isIdIndexPattern(spec[IndexDescriptor::kKeyPatternFieldName].Obj())) {
+            _deferredIndexes.push_back(spec);
+        } else {
+            tempNsIndexes.push_back(spec);
+        }
+    }
+    if (tempNsIndexes.empty()) {
+        return;
+    }
+
     try {
-        std::vector<BSONObj> tempNsIndexes = {std::begin(_originalIndexes),
-                                              std::end(_originalIndexes)};
         pExpCtx->mongoProcessInterface->createIndexesOnEmptyCollection(
             pExpCtx->opCtx, _tempNs, tempNsIndexes);
     } catch (DBException& ex) {
@@ -166,6 +183,16 @@ void DocumentSourceOut::initialize() {
 void DocumentSourceOut::finalize() {
     DocumentSourceWriteBlock writeBlock(pExpCtx->opCtx);
 
+    if (!_deferredIndexes.empty()) {
+        try {
+            pExpCtx->mongoProcessInterface->createIndexes(
+                pExpCtx->opCtx, _tempNs, _deferredIndexes);
+        } catch (DBException& ex) {
+            ex.addContext("Copying indexes for $out failed");
+            throw;
+        }
+    }
+
     const auto& outputNs = getOutputNs();
     auto renameCommandObj =
         BSON("renameCollection" << _tempNs.ns() << "to" << outputNs.ns() << "dropTarget" << true);
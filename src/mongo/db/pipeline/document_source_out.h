@@ -119,12 +119,13 @@ private:
 
     void finalize() override;
 
-    void spill(BatchedObjects&& batch) override {
-        DocumentSourceWriteBlock writeBlock(pExpCtx->opCtx);
+    void spill(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+               BatchedObjects&& batch) override {
+        DocumentSourceWriteBlock writeBlock(expCtx->opCtx);
 
         auto targetEpoch = boost::none;
-        uassertStatusOK(pExpCtx->mongoProcessInterface->insert(
-            pExpCtx, _tempNs, std::move(batch), _writeConcern, targetEpoch));
+        uassertStatusOK(expCtx->mongoProcessInterface->insert(
+            expCtx, _tempNs, std::move(batch), _writeConcern, targetEpoch));
     }
 
     std::pair<BSONObj, int> makeBatchObject(Document&& doc) const override {
@@ -132,6 +133,10 @@ private:
         return {obj, obj.objsize()};
     }
 
+    Document getPartitionKey(const BSONObj& obj) const override {
+        return Document{{"_id"_sd, Value(obj["_id"])}};
+    }
+
     void waitWhileFailPointEnabled() override;
 
     // Holds on to the original collection options and index specs so we can check they didn't
@@ -139,6 +144,10 @@ private:
     BSONObj _originalOutOptions;
     std::list<BSONObj> _originalIndexes;
 
+    // Secondary indexes of the target collection which are only created on the temporary
+    // collection once all of the results have been written to it.
+    std::vector<BSONObj> _deferredIndexes;
+
     // The temporary namespace for the $out writes.
     NamespaceString _tempNs;
 };
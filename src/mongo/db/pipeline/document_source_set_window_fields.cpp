@@ -267,10 +267,23 @@ boost::intrusive_ptr<DocumentSource> DocumentSourceInternalSetWindowFields::crea
 }
 
 void DocumentSourceInternalSetWindowFields::initialize() {
+    // The furthest that any window reaches behind the current document. Documents before this are
+    // released by the iterator, so that only the documents of the widest window are held in memory.
+    int lookBehind = 0;
     for (auto& wfs : _outputFields) {
         uassert(5397900, "Window function must be $sum", wfs.expr->getOpName() == "$sum");
         _executableOutputs[wfs.fieldName] = WindowFunctionExec::create(&_iterator, wfs);
+
+        // A left-unbounded window accumulates each document as it enters the window and never
+        // revisits it. Executors for other window types reject them at creation.
+        auto bounds = wfs.expr->bounds();
+        if (auto docBounds = stdx::get_if<WindowBounds::DocumentBased>(&bounds.bounds)) {
+            if (auto lower = stdx::get_if<int>(&docBounds->lower)) {
+                lookBehind = std::min(lookBehind, *lower);
+            }
+        }
     }
+    _iterator.setLookBehind(lookBehind);
     _init = true;
 }
 
@@ -69,6 +69,7 @@ DocumentSourceSort::DocumentSourceSort(const boost::intrusive_ptr<ExpressionCont
     uassert(15976,
             "$sort stage must have at least one sort key",
             !_sortExecutor->sortPattern().empty());
+    _sortExecutor->attachToOperationContext(pExpCtx->opCtx);
 }
 
 REGISTER_DOCUMENT_SOURCE(sort,
@@ -92,6 +93,14 @@ DocumentSource::GetNextResult DocumentSourceSort::doGetNext() {
     return GetNextResult{_sortExecutor->getNext().second};
 }
 
+void DocumentSourceSort::detachFromOperationContext() {
+    _sortExecutor->detachFromOperationContext();
+}
+
+void DocumentSourceSort::reattachToOperationContext(OperationContext* opCtx) {
+    _sortExecutor->attachToOperationContext(opCtx);
+}
+
 void DocumentSourceSort::serializeToArray(
     std::vector<Value>& array, boost::optional<ExplainOptions::Verbosity> explain) const {
     uint64_t limit = _sortExecutor->getLimit();
@@ -123,6 +132,12 @@ void DocumentSourceSort::serializeToArray(
         mutDoc["totalDataSizeSortedBytesEstimate"] =
             Value(static_cast<long long>(stats.totalDataSizeBytes));
         mutDoc["usedDisk"] = Value(stats.spills > 0 ? true : false);
+        if (stats.spills > 0) {
+            mutDoc["spilledDataSizeBytes"] =
+                Value(static_cast<long long>(stats.spilledDataSizeBytes));
+            mutDoc["spilledStorageSizeBytes"] =
+                Value(static_cast<long long>(stats.spilledStorageSizeBytes));
+        }
     }
 
     array.push_back(Value(mutDoc.freeze()));
@@ -146,6 +146,10 @@ public:
         return &_sortExecutor->stats();
     }
 
+    void detachFromOperationContext() final;
+
+    void reattachToOperationContext(OperationContext* opCtx) final;
+
 protected:
     GetNextResult doGetNext() final;
     /**
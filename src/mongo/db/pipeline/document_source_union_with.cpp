@@ -30,15 +30,24 @@
 
 #include "mongo/platform/basic.h"
 
+#include <deque>
 #include <iterator>
 
+#include "mongo/db/client.h"
 #include "mongo/db/commands/test_commands_enabled.h"
 #include "mongo/db/pipeline/document_source_match.h"
 #include "mongo/db/pipeline/document_source_single_document_transformation.h"
 #include "mongo/db/pipeline/document_source_union_with.h"
 #include "mongo/db/pipeline/document_source_union_with_gen.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/repl/read_concern_args.h"
+#include "mongo/db/server_options.h"
+#include "mongo/db/service_context.h"
 #include "mongo/db/views/resolved_view.h"
 #include "mongo/logv2/log.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/thread.h"
 
 namespace mongo {
 
@@ -83,7 +92,157 @@ std::unique_ptr<Pipeline, PipelineDeleter> buildPipelineFromViewDefinition(
 
 }  // namespace
 
+/**
+ * Runs a sub-pipeline to completion on a thread of its own, with its own Client and
+ * OperationContext, and buffers its documents until they are consumed or until they take up more
+ * than 'maxBufferedBytes'. The sub-pipeline is disposed of on that thread when it is exhausted,
+ * fails, or the prefetcher is stopped.
+ */
+class DocumentSourceUnionWith::SubPipelinePrefetcher {
+    SubPipelinePrefetcher(const SubPipelinePrefetcher&) = delete;
+    SubPipelinePrefetcher& operator=(const SubPipelinePrefetcher&) = delete;
+
+public:
+    SubPipelinePrefetcher(ServiceContext* serviceContext,
+                          std::unique_ptr<Pipeline, PipelineDeleter> pipeline,
+                          size_t maxBufferedBytes)
+        : _pipeline(std::move(pipeline)), _maxBufferedBytes(maxBufferedBytes) {
+        _thread = stdx::thread([this, serviceContext] { _run(serviceContext); });
+    }
+
+    ~SubPipelinePrefetcher() {
+        stop();
+    }
+
+    /**
+     * Returns the next buffered document of the sub-pipeline. If none is buffered, either waits
+     * for one when 'waitForDocument' is true, or returns boost::none right away. Returns
+     * boost::none once the sub-pipeline is exhausted, and throws if it failed or if 'opCtx' is
+     * interrupted.
+     */
+    boost::optional<Document> getNext(OperationContext* opCtx, bool waitForDocument) {
+        stdx::unique_lock<Latch> lk(_mutex);
+        if (waitForDocument) {
+            opCtx->waitForConditionOrInterrupt(
+                _stateChanged, lk, [&] { return _done || !_buffer.empty(); });
+        }
+        if (_buffer.empty()) {
+            if (_done) {
+                uassertStatusOK(_status);
+            }
+            return boost::none;
+        }
+
+        auto [doc, size] = std::move(_buffer.front());
+        _buffer.pop_front();
+        _bufferedBytes -= size;
+        _stateChanged.notify_all();
+        return std::move(doc);
+    }
+
+    /**
+     * Interrupts the thread of the sub-pipeline if it is still running, and waits for it to be
+     * done. The sub-pipeline can only be inspected after this.
+     */
+    void stop() {
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            _inShutdown = true;
+            if (_opCtx) {
+                stdx::lock_guard<Client> clientLock(*_opCtx->getClient());
+                _opCtx->getServiceContext()->killOperation(
+                    clientLock, _opCtx, ErrorCodes::Interrupted);
+            }
+        }
+        if (_thread.joinable()) {
+            _thread.join();
+        }
+    }
+
+    /**
+     * The disposed sub-pipeline, from which the stats of its stages can be gathered, and whether
+     * it used disk. Only valid after stop().
+     */
+    const Pipeline* getPipeline() const {
+        return _pipeline.get();
+    }
+    bool usedDisk() const {
+        return _usedDisk;
+    }
+
+private:
+    void _run(ServiceContext* serviceContext) {
+        ThreadClient tc("UnionWithPrefetcher", serviceContext);
+        auto opCtx = cc().makeOperationContext();
+
+        bool inShutdown;
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            _opCtx = opCtx.get();
+            inShutdown = _inShutdown;
+        }
+
+        Status status = Status::OK();
+        try {
+            _pipeline->reattachToOperationContext(opCtx.get());
+            if (!inShutdown) {
+                auto processInterface = _pipeline->getContext()->mongoProcessInterface;
+                _pipeline = processInterface->attachCursorSourceToPipeline(_pipeline.release());
+                while (auto next = _pipeline->getNext()) {
+                    const auto size = next->getApproximateSize();
+                    stdx::unique_lock<Latch> lk(_mutex);
+                    opCtx->waitForConditionOrInterrupt(_stateChanged, lk, [&] {
+                        return _buffer.empty() || _bufferedBytes + size <= _maxBufferedBytes;
+                    });
+                    _bufferedBytes += size;
+                    _buffer.emplace_back(std::move(*next), size);
+                    _stateChanged.notify_all();
+                }
+            }
+        } catch (const DBException& ex) {
+            status = ex.toStatus();
+        }
+
+        // Attaching the cursor source consumes the pipeline when it fails.
+        if (_pipeline) {
+            _usedDisk = _pipeline->usedDisk();
+            _pipeline->dispose(opCtx.get());
+            _pipeline.get_deleter().dismissDisposal();
+        }
+
+        stdx::lock_guard<Latch> lk(_mutex);
+        _opCtx = nullptr;
+        _done = true;
+        _status = std::move(status);
+        _stateChanged.notify_all();
+    }
+
+    std::unique_ptr<Pipeline, PipelineDeleter> _pipeline;
+    bool _usedDisk = false;
+
+    const size_t _maxBufferedBytes;
+
+    Mutex _mutex = MONGO_MAKE_LATCH("DocumentSourceUnionWith::SubPipelinePrefetcher::_mutex");
+
+    // Signalled when a document is buffered or consumed, and when the sub-pipeline is done.
+    stdx::condition_variable _stateChanged;
+
+    // The buffered documents along with their approximate sizes.
+    std::deque<std::pair<Document, size_t>> _buffer;
+    size_t _bufferedBytes = 0;
+
+    // The OperationContext of the thread, while it runs.
+    OperationContext* _opCtx = nullptr;
+
+    bool _inShutdown = false;
+    bool _done = false;
+    Status _status = Status::OK();
+
+    stdx::thread _thread;
+};
+
 DocumentSourceUnionWith::~DocumentSourceUnionWith() {
+    _prefetcher.reset();
     if (_pipeline && _pipeline->getContext()->explain) {
         _pipeline->dispose(pExpCtx->opCtx);
         _pipeline.reset();
@@ -171,12 +330,43 @@ DocumentSource::GetNextResult DocumentSourceUnionWith::doGetNext() {
         return GetNextResult::makeEOF();
     }
 
+    if (_executionState == ExecutionProgress::kFinished) {
+        return GetNextResult::makeEOF();
+    }
+
     if (_executionState == ExecutionProgress::kIteratingSource) {
+        if (!_prefetchChecked) {
+            _prefetchChecked = true;
+            if (canPrefetchSubPipeline()) {
+                // The prefetched copy of the sub-pipeline gets an ExpressionContext of its own,
+                // since it is attached to the OperationContext of another thread.
+                auto serializedPipe = _pipeline->serializeToBson();
+                LOGV2_DEBUG(5591716,
+                            1,
+                            "$unionWith prefetching sub-pipeline on a separate thread",
+                            "pipeline"_attr = serializedPipe);
+                const auto& subExpCtx = _pipeline->getContext();
+                _prefetcher = std::make_unique<SubPipelinePrefetcher>(
+                    pExpCtx->opCtx->getServiceContext(),
+                    Pipeline::parse(serializedPipe, subExpCtx->copyWith(subExpCtx->ns)),
+                    internalQueryUnionWithPrefetchMaxBufferBytes.load());
+            }
+        }
+
+        // Documents of the sub-pipeline are returned as soon as they are available, so that its
+        // thread can keep going.
+        if (_prefetcher) {
+            if (auto next = _prefetcher->getNext(pExpCtx->opCtx, false /* waitForDocument */)) {
+                return std::move(*next);
+            }
+        }
+
         auto nextInput = pSource->getNext();
         if (!nextInput.isEOF()) {
             return nextInput;
         }
-        _executionState = ExecutionProgress::kStartingSubPipeline;
+        _executionState = _prefetcher ? ExecutionProgress::kIteratingSubPipeline
+                                      : ExecutionProgress::kStartingSubPipeline;
         // All documents from the base collection have been returned, switch to iterating the sub-
         // pipeline by falling through below.
     }
@@ -207,6 +397,15 @@ DocumentSource::GetNextResult DocumentSourceUnionWith::doGetNext() {
         }
     }
 
+    if (_prefetcher) {
+        if (auto next = _prefetcher->getNext(pExpCtx->opCtx, true /* waitForDocument */)) {
+            return std::move(*next);
+        }
+        stopPrefetching();
+        _executionState = ExecutionProgress::kFinished;
+        return GetNextResult::makeEOF();
+    }
+
     auto res = _pipeline->getNext();
     if (res)
         return std::move(*res);
@@ -244,7 +443,37 @@ bool DocumentSourceUnionWith::usedDisk() {
     return _stats.planSummaryStats.usedDisk;
 }
 
+bool DocumentSourceUnionWith::canPrefetchSubPipeline() const {
+    if (!internalQueryUnionWithPrefetchSubPipeline.load() || pExpCtx->explain ||
+        pExpCtx->inMongos || pExpCtx->subPipelineDepth > 0 ||
+        serverGlobalParams.clusterRole == ClusterRole::ShardServer) {
+        return false;
+    }
+
+    // The thread of the sub-pipeline reads outside of the transaction and the read concern of the
+    // operation, which is only equivalent for a plain 'local' read.
+    const auto opCtx = pExpCtx->opCtx;
+    const auto& readConcernArgs = repl::ReadConcernArgs::get(opCtx);
+    return !opCtx->inMultiDocumentTransaction() &&
+        readConcernArgs.getLevel() == repl::ReadConcernLevel::kLocalReadConcern &&
+        !readConcernArgs.getArgsAfterClusterTime() && !readConcernArgs.getArgsAtClusterTime();
+}
+
+void DocumentSourceUnionWith::stopPrefetching() {
+    _prefetcher->stop();
+    if (auto prefetchedPipeline = _prefetcher->getPipeline()) {
+        _stats.planSummaryStats.usedDisk =
+            _stats.planSummaryStats.usedDisk || _prefetcher->usedDisk();
+        recordPlanSummaryStats(*prefetchedPipeline);
+    }
+    _prefetcher.reset();
+}
+
 void DocumentSourceUnionWith::doDispose() {
+    if (_prefetcher) {
+        stopPrefetching();
+    }
+
     if (_pipeline) {
         _stats.planSummaryStats.usedDisk =
             _stats.planSummaryStats.usedDisk || _pipeline->usedDisk();
@@ -166,10 +166,31 @@ private:
 
     void recordPlanSummaryStats(const Pipeline& pipeline);
 
+    /**
+     * Returns true if the sub-pipeline may run on a separate thread, concurrently with the main
+     * pipeline, which is only the case when that has been enabled and the sub-pipeline needs no
+     * state of the operation besides its ExpressionContext.
+     */
+    bool canPrefetchSubPipeline() const;
+
+    /**
+     * Stops the prefetching of the sub-pipeline, and records the stats of the copy of the
+     * sub-pipeline which was prefetched before disposing of it.
+     */
+    void stopPrefetching();
+
+    class SubPipelinePrefetcher;
+
     std::unique_ptr<Pipeline, PipelineDeleter> _pipeline;
     Pipeline::SourceContainer _cachedPipeline;
     ExecutionProgress _executionState = ExecutionProgress::kIteratingSource;
     UnionWithStats _stats;
+
+    // Runs a copy of '_pipeline' on a separate thread, if the sub-pipeline is prefetched. The
+    // buffered documents of the sub-pipeline are then returned as soon as they are available, while
+    // 'pSource' is iterated.
+    std::unique_ptr<SubPipelinePrefetcher> _prefetcher;
+    bool _prefetchChecked = false;
 };
 
 }  // namespace mongo
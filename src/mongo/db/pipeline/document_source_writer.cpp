@@ -0,0 +1,167 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kQuery
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/document_source_writer.h"
+
+#include <algorithm>
+
+#include "mongo/db/client.h"
+#include "mongo/db/operation_time_tracker.h"
+#include "mongo/db/repl/repl_client_info.h"
+#include "mongo/db/service_context.h"
+#include "mongo/logv2/log.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+
+DocumentSourceWriterThreads::DocumentSourceWriterThreads(OperationContext* opCtx,
+                                                         size_t numWriters)
+    : _opCtx(opCtx), _pendingWrites(numWriters), _writerOpCtxs(numWriters, nullptr) {
+    LOGV2_DEBUG(5591715, 2, "Starting writer threads", "numWriters"_attr = numWriters);
+
+    for (size_t i = 0; i < numWriters; ++i) {
+        _threads.emplace_back([this, i] { _runWriter(i); });
+    }
+}
+
+DocumentSourceWriterThreads::~DocumentSourceWriterThreads() {
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _shutdown(lk, ErrorCodes::Interrupted);
+    }
+    for (auto& thread : _threads) {
+        thread.join();
+    }
+}
+
+void DocumentSourceWriterThreads::_shutdown(WithLock, ErrorCodes::Error killCode) {
+    _inShutdown = true;
+    for (auto& pendingWrites : _pendingWrites) {
+        pendingWrites.clear();
+    }
+    for (auto writerOpCtx : _writerOpCtxs) {
+        if (writerOpCtx) {
+            stdx::lock_guard<Client> clientLock(*writerOpCtx->getClient());
+            writerOpCtx->getServiceContext()->killOperation(clientLock, writerOpCtx, killCode);
+        }
+    }
+    _stateChanged.notify_all();
+}
+
+void DocumentSourceWriterThreads::schedule(size_t writerIndex, Write write) {
+    stdx::unique_lock<Latch> lk(_mutex);
+    try {
+        _opCtx->waitForConditionOrInterrupt(_stateChanged, lk, [&] {
+            return !_writeStatus.isOK() ||
+                _pendingWrites[writerIndex].size() < kMaxPendingWritesPerWriter;
+        });
+    } catch (const DBException& ex) {
+        _shutdown(lk, ex.code());
+        throw;
+    }
+    uassertStatusOK(_writeStatus);
+
+    _pendingWrites[writerIndex].push_back(std::move(write));
+    _stateChanged.notify_all();
+}
+
+void DocumentSourceWriterThreads::waitForWrites() {
+    stdx::unique_lock<Latch> lk(_mutex);
+    try {
+        _opCtx->waitForConditionOrInterrupt(_stateChanged, lk, [&] {
+            return !_writeStatus.isOK() ||
+                (_numRunningWrites == 0 &&
+                 std::all_of(_pendingWrites.begin(), _pendingWrites.end(), [](const auto& writes) {
+                     return writes.empty();
+                 }));
+        });
+    } catch (const DBException& ex) {
+        _shutdown(lk, ex.code());
+        throw;
+    }
+    uassertStatusOK(_writeStatus);
+
+    auto& replClientInfo = repl::ReplClientInfo::forClient(_opCtx->getClient());
+    if (_lastOp > replClientInfo.getLastOp()) {
+        replClientInfo.setLastOp(_opCtx, _lastOp);
+    }
+    OperationTimeTracker::get(_opCtx)->updateOperationTime(_maxOperationTime);
+}
+
+void DocumentSourceWriterThreads::_runWriter(size_t writerIndex) {
+    ThreadClient tc("DocumentSourceWriter", _opCtx->getServiceContext());
+    auto writerOpCtx = cc().makeOperationContext();
+
+    stdx::unique_lock<Latch> lk(_mutex);
+    _writerOpCtxs[writerIndex] = writerOpCtx.get();
+    ON_BLOCK_EXIT([&] { _writerOpCtxs[writerIndex] = nullptr; });
+
+    while (true) {
+        _stateChanged.wait(
+            lk, [&] { return _inShutdown || !_pendingWrites[writerIndex].empty(); });
+        if (_inShutdown) {
+            return;
+        }
+
+        auto write = std::move(_pendingWrites[writerIndex].front());
+        _pendingWrites[writerIndex].pop_front();
+        ++_numRunningWrites;
+        _stateChanged.notify_all();
+
+        Status status = Status::OK();
+        lk.unlock();
+        try {
+            write(writerOpCtx.get());
+        } catch (const DBException& ex) {
+            status = ex.toStatus();
+        }
+        const auto lastOp = repl::ReplClientInfo::forClient(cc()).getLastOp();
+        const auto operationTime =
+            OperationTimeTracker::get(writerOpCtx.get())->getMaxOperationTime();
+        lk.lock();
+
+        --_numRunningWrites;
+        _lastOp = std::max(_lastOp, lastOp);
+        _maxOperationTime = std::max(_maxOperationTime, operationTime);
+        if (!status.isOK() && _writeStatus.isOK()) {
+            // The writes which are pending on other writers are abandoned, as the whole write
+            // stage fails.
+            _writeStatus = std::move(status);
+            _shutdown(lk, ErrorCodes::Interrupted);
+        }
+        _stateChanged.notify_all();
+    }
+}
+
+}  // namespace mongo
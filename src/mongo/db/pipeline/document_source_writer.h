@@ -31,13 +31,23 @@
 
 #include "mongo/platform/basic.h"
 
+#include <deque>
 #include <fmt/format.h>
+#include <vector>
 
 #include "mongo/db/db_raii.h"
+#include "mongo/db/logical_time.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/pipeline/document_source.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/read_concern.h"
+#include "mongo/db/repl/optime.h"
 #include "mongo/db/storage/recovery_unit.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/util/concurrency/with_lock.h"
+#include "mongo/util/functional.h"
 
 namespace mongo {
 using namespace fmt::literals;
@@ -80,6 +90,65 @@ public:
     }
 };
 
+/**
+ * Performs the writes of a DocumentSourceWriter on several writer threads, each of which has its
+ * own Client and OperationContext. Each write is scheduled on one writer, which performs its writes
+ * in the order they were scheduled. The writers are interrupted and joined on destruction.
+ */
+class DocumentSourceWriterThreads {
+    DocumentSourceWriterThreads(const DocumentSourceWriterThreads&) = delete;
+    DocumentSourceWriterThreads& operator=(const DocumentSourceWriterThreads&) = delete;
+
+public:
+    using Write = unique_function<void(OperationContext*)>;
+
+    // The number of writes which may wait for each writer, in addition to the one it performs.
+    static constexpr size_t kMaxPendingWritesPerWriter = 1;
+
+    DocumentSourceWriterThreads(OperationContext* opCtx, size_t numWriters);
+
+    ~DocumentSourceWriterThreads();
+
+    /**
+     * Schedules 'write' on the writer 'writerIndex', waiting while that writer has too many writes
+     * pending. Throws if a write failed, or if the OperationContext of the caller is interrupted.
+     */
+    void schedule(size_t writerIndex, Write write);
+
+    /**
+     * Waits for all the scheduled writes to be done, and throws if one of them failed. Advances the
+     * last optime and operation time of the caller's client to those of the writes, so that the
+     * write concern of the caller covers them.
+     */
+    void waitForWrites();
+
+private:
+    void _runWriter(size_t writerIndex);
+
+    void _shutdown(WithLock, ErrorCodes::Error killCode);
+
+    OperationContext* const _opCtx;
+
+    Mutex _mutex = MONGO_MAKE_LATCH("DocumentSourceWriterThreads::_mutex");
+
+    // Signalled when a write is scheduled or done, and on shutdown.
+    stdx::condition_variable _stateChanged;
+
+    // The writes scheduled on each writer, and the OperationContext of each running writer.
+    std::vector<std::deque<Write>> _pendingWrites;
+    std::vector<OperationContext*> _writerOpCtxs;
+    size_t _numRunningWrites = 0;
+
+    bool _inShutdown = false;
+    Status _writeStatus = Status::OK();
+
+    // The greatest optime and operation time of the writes.
+    repl::OpTime _lastOp;
+    LogicalTime _maxOperationTime;
+
+    std::vector<stdx::thread> _threads;
+};
+
 /**
  * This is a base abstract class for all stages performing a write operation into an output
  * collection. The writes are organized in batches in which elements are objects of the templated
@@ -143,9 +212,12 @@ protected:
     virtual void finalize() {}
 
     /**
-     * Writes the documents in 'batch' to the output namespace.
+     * Writes the documents in 'batch' to the output namespace, using 'expCtx', which is either the
+     * ExpressionContext of the stage or a copy of it attached to the OperationContext of a writer
+     * thread.
      */
-    virtual void spill(BatchedObjects&& batch) = 0;
+    virtual void spill(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                       BatchedObjects&& batch) = 0;
 
     /**
      * Creates a batch object from the given document and returns it to the caller along with the
@@ -153,6 +225,12 @@ protected:
      */
     virtual std::pair<B, int> makeBatchObject(Document&& doc) const = 0;
 
+    /**
+     * Returns the fields of 'obj' by which the output is partitioned among writer threads. Batch
+     * objects with equal keys are written in order by the same writer.
+     */
+    virtual Document getPartitionKey(const B& obj) const = 0;
+
     /**
      * A subclass may override this method to enable a fail point right after a next input element
      * has been retrieved, but not processed yet.
@@ -170,6 +248,12 @@ protected:
     WriteConcernOptions _writeConcern;
 
 private:
+    /**
+     * Writes the input documents on 'numWriters' writer threads, partitioning them by their
+     * partition key. Returns the first input which is not a document.
+     */
+    GetNextResult _writeInParallel(size_t numWriters);
+
     bool _initialized{false};
     bool _done{false};
 };
@@ -198,10 +282,12 @@ DocumentSource::GetNextResult DocumentSourceWriter<B>::doGetNext() {
             _initialized = true;
         }
 
+        const auto numWriters =
+            static_cast<size_t>(internalQueryDocumentSourceWriterMaxThreads.load());
+        auto nextInput = numWriters > 1 ? _writeInParallel(numWriters) : pSource->getNext();
+
         BatchedObjects batch;
         int bufferedBytes = 0;
-
-        auto nextInput = pSource->getNext();
         for (; nextInput.isAdvanced(); nextInput = pSource->getNext()) {
             waitWhileFailPointEnabled();
 
@@ -212,14 +298,14 @@ DocumentSource::GetNextResult DocumentSourceWriter<B>::doGetNext() {
             if (!batch.empty() &&
                 (bufferedBytes > BSONObjMaxUserSize ||
                  batch.size() >= write_ops::kMaxWriteBatchSize)) {
-                spill(std::move(batch));
+                spill(pExpCtx, std::move(batch));
                 batch.clear();
                 bufferedBytes = objSize;
             }
             batch.push_back(obj);
         }
         if (!batch.empty()) {
-            spill(std::move(batch));
+            spill(pExpCtx, std::move(batch));
             batch.clear();
         }
 
@@ -240,4 +326,66 @@ DocumentSource::GetNextResult DocumentSourceWriter<B>::doGetNext() {
     MONGO_UNREACHABLE;
 }
 
+template <typename B>
+DocumentSource::GetNextResult DocumentSourceWriter<B>::_writeInParallel(size_t numWriters) {
+    std::vector<BatchedObjects> batches(numWriters);
+    std::vector<int> bufferedBytes(numWriters, 0);
+
+    // The writer threads are only started once a partition has a full batch, so that small outputs
+    // are written by this thread.
+    boost::optional<DocumentSourceWriterThreads> writers;
+    std::vector<boost::intrusive_ptr<ExpressionContext>> writerExpCtxs;
+    auto scheduleBatch = [&](size_t partition) {
+        if (!writers) {
+            writers.emplace(pExpCtx->opCtx, numWriters);
+            for (size_t i = 0; i < numWriters; ++i) {
+                writerExpCtxs.push_back(pExpCtx->copyWith(pExpCtx->ns));
+            }
+        }
+        writers->schedule(partition,
+                          [this,
+                           expCtx = writerExpCtxs[partition],
+                           batch = std::move(batches[partition])](OperationContext* opCtx) mutable {
+                              expCtx->opCtx = opCtx;
+                              spill(expCtx, std::move(batch));
+                          });
+        batches[partition].clear();
+        bufferedBytes[partition] = 0;
+    };
+
+    auto nextInput = pSource->getNext();
+    for (; nextInput.isAdvanced(); nextInput = pSource->getNext()) {
+        waitWhileFailPointEnabled();
+
+        auto doc = nextInput.releaseDocument();
+        auto [obj, objSize] = makeBatchObject(std::move(doc));
+
+        const size_t partition =
+            pExpCtx->getDocumentComparator().hash(getPartitionKey(obj)) % numWriters;
+        bufferedBytes[partition] += objSize;
+        if (!batches[partition].empty() &&
+            (bufferedBytes[partition] > BSONObjMaxUserSize ||
+             batches[partition].size() >= write_ops::kMaxWriteBatchSize)) {
+            scheduleBatch(partition);
+            bufferedBytes[partition] = objSize;
+        }
+        batches[partition].push_back(obj);
+    }
+
+    for (size_t partition = 0; partition < numWriters; ++partition) {
+        if (batches[partition].empty()) {
+            continue;
+        }
+        if (writers) {
+            scheduleBatch(partition);
+        } else {
+            spill(pExpCtx, std::move(batches[partition]));
+        }
+    }
+    if (writers) {
+        writers->waitForWrites();
+    }
+    return nextInput;
+}
+
 }  // namespace mongo
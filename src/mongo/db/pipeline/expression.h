@@ -35,7 +35,6 @@
 #include <boost/intrusive_ptr.hpp>
 #include <functional>
 #include <map>
-#include <pcre.h>
 #include <string>
 #include <utility>
 #include <vector>
@@ -52,7 +51,9 @@
 #include "mongo/db/query/datetime/date_time_support.h"
 #include "mongo/db/server_options.h"
 #include "mongo/util/intrusive_counter.h"
+#include "mongo/util/regex_util.h"
 #include "mongo/util/str.h"
+#include "mongo/util/summation.h"
 
 namespace mongo {
 
@@ -788,6 +789,27 @@ public:
 
 class ExpressionAdd final : public ExpressionVariadic<ExpressionAdd> {
 public:
+    /**
+     * Accumulates the operands of an $add one at a time, returning the narrowest result type
+     * which avoids overflow and loss of precision.
+     */
+    class Sum {
+    public:
+        /**
+         * Adds 'val' to the sum. Returns false if 'val' is nullish, in which case the result of
+         * the $add is null and the remaining operands need not be evaluated.
+         */
+        bool add(const Value& val);
+
+        Value getValue() const;
+
+    private:
+        DoubleDoubleSummation _nonDecimalTotal;
+        Decimal128 _decimalTotal;
+        BSONType _totalType = NumberInt;
+        bool _haveDate = false;
+    };
+
     explicit ExpressionAdd(ExpressionContext* const expCtx)
         : ExpressionVariadic<ExpressionAdd>(expCtx) {}
 
@@ -1461,6 +1483,11 @@ public:
     Value evaluate(const Document& root, Variables* variables) const final;
     const char* getOpName() const final;
 
+    /**
+     * Divides 'lhs' by 'rhs' with the semantics of $divide.
+     */
+    static Value apply(const Value& lhs, const Value& rhs);
+
     void acceptVisitor(ExpressionVisitor* visitor) final {
         return visitor->visit(this);
     }
@@ -1985,6 +2012,28 @@ public:
 
 class ExpressionMultiply final : public ExpressionVariadic<ExpressionMultiply> {
 public:
+    /**
+     * Accumulates the operands of a $multiply one at a time. To return the narrowest possible
+     * result without creating intermediate Values, the arithmetic for double and integral types
+     * is done in parallel, tracking the current narrowest type.
+     */
+    class Product {
+    public:
+        /**
+         * Multiplies the product by 'val'. Returns false if 'val' is nullish, in which case the
+         * result of the $multiply is null and the remaining operands need not be evaluated.
+         */
+        bool multiply(const Value& val);
+
+        Value getValue() const;
+
+    private:
+        double _doubleProduct = 1;
+        long long _longProduct = 1;
+        Decimal128 _decimalProduct;  // This will be initialized on encountering the first decimal.
+        BSONType _productType = NumberInt;
+    };
+
     explicit ExpressionMultiply(ExpressionContext* const expCtx)
         : ExpressionVariadic<ExpressionMultiply>(expCtx) {}
     ExpressionMultiply(ExpressionContext* const expCtx, ExpressionVector&& children)
@@ -2641,6 +2690,11 @@ public:
     Value evaluate(const Document& root, Variables* variables) const final;
     const char* getOpName() const final;
 
+    /**
+     * Subtracts 'rhs' from 'lhs' with the semantics of $subtract.
+     */
+    static Value apply(const Value& lhs, const Value& rhs);
+
     void acceptVisitor(ExpressionVisitor* visitor) final {
         return visitor->visit(this);
     }
@@ -3024,11 +3078,11 @@ public:
         int numCaptures = 0;
 
         /**
-         * If 'regex' is constant, 'pcrePtr' will be shared between the active RegexExecutionState
-         * and '_initialExecStateForConstantRegex'. If not, then the active RegexExecutionState is
-         * the sole owner.
+         * The compiled pattern, shared with the process-wide cache of compiled regular
+         * expressions. It is immutable, so every RegexExecutionState using the same pattern and
+         * options can match with it.
          */
-        std::shared_ptr<pcre> pcrePtr;
+        std::shared_ptr<const regex_util::CompiledRegex> compiledRegex;
 
         /**
          * The input text and starting position for the current execution context.
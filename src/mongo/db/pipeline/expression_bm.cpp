@@ -31,9 +31,11 @@
 
 #include <benchmark/benchmark.h>
 
+#include "mongo/bson/json.h"
 #include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/pipeline/expression_program.h"
 #include "mongo/db/query/query_test_service_context.h"
 
 namespace mongo {
@@ -191,5 +193,48 @@ BENCHMARK(BM_DateAddEvaluate100KSeconds);
 BENCHMARK(BM_DateAddEvaluate100Years);
 BENCHMARK(BM_DateAddEvaluate12HoursWithTimezone);
 
+/**
+ * Tests performance of evaluating a nested arithmetic expression, either directly or through its
+ * compiled ExpressionProgram.
+ */
+void testArithmeticExpression(bool compiled, benchmark::State& state) {
+    QueryTestServiceContext testServiceContext;
+    auto opContext = testServiceContext.makeOperationContext();
+    NamespaceString nss("test.bm");
+    boost::intrusive_ptr<ExpressionContextForTest> exprContext =
+        new ExpressionContextForTest(opContext.get(), nss);
+
+    auto expression = fromjson(
+        "{$add: [{$multiply: ['$a', '$b', 2]}, {$subtract: ['$c', {$divide: ['$a', 4]}]}, 1]}");
+    auto arithmeticExpression = Expression::parseExpression(
+        exprContext.get(), expression, exprContext->variablesParseState);
+    arithmeticExpression = arithmeticExpression->optimize();
+    auto program = ExpressionProgram::compile(arithmeticExpression);
+    invariant(program);
+
+    auto variables = &(exprContext->variables);
+    Document document{{"a", 10}, {"b", 2.5}, {"c", 7LL}};
+
+    for (auto keepRunning : state) {
+        if (compiled) {
+            benchmark::DoNotOptimize(program->evaluate(document, variables));
+        } else {
+            benchmark::DoNotOptimize(arithmeticExpression->evaluate(document, variables));
+        }
+        benchmark::ClobberMemory();
+    }
+}
+
+void BM_ArithmeticEvaluate(benchmark::State& state) {
+    testArithmeticExpression(false, state);
+}
+
+void BM_ArithmeticEvaluateCompiled(benchmark::State& state) {
+    testArithmeticExpression(true, state);
+}
+
+BENCHMARK(BM_ArithmeticEvaluate);
+BENCHMARK(BM_ArithmeticEvaluateCompiled);
+
 }  // namespace
 }  // namespace mongo
@@ -34,6 +34,7 @@
 #include "mongo/db/exec/document_value/document_value_test_util.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
 #include "mongo/db/pipeline/expression_function.h"
+#include "mongo/db/pipeline/javascript_execution.h"
 #include "mongo/db/pipeline/process_interface/standalone_process_interface.h"
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/service_context_d_test_fixture.h"
@@ -274,5 +275,25 @@ TEST_F(MapReduceFixture, ExpressionInternalJsErrorsIfProducesTooManyDocumentsFor
     ASSERT_THROWS_CODE(
         expr->evaluate(Document{BSON("val" << 1)}, getVariables()), AssertionException, 31292);
 }
+
+TEST_F(MapReduceFixture, JsExecutionReusesScopeReleasedToTheSamePoolOnThisThread) {
+    auto opCtx = getExpCtx()->opCtx;
+    {
+        JsExecution jsExec(opCtx, BSONObj(), boost::none, std::string("pool"));
+        jsExec.getScope()->setNumber("marker", 1);
+    }
+    {
+        JsExecution jsExec(opCtx, BSONObj(), boost::none, std::string("pool"));
+        ASSERT_EQ(jsExec.getScope()->getNumber("marker"), 1);
+    }
+    {
+        JsExecution jsExec(opCtx, BSONObj(), boost::none, std::string("otherPool"));
+        ASSERT_EQ(jsExec.getScope()->type("marker"), BSONType::Undefined);
+    }
+    {
+        JsExecution jsExec(opCtx, BSONObj());
+        ASSERT_EQ(jsExec.getScope()->type("marker"), BSONType::Undefined);
+    }
+}
 }  // namespace
 }  // namespace mongo
@@ -0,0 +1,199 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/expression_program.h"
+
+namespace mongo {
+
+boost::optional<ExpressionProgram> ExpressionProgram::compile(
+    const boost::intrusive_ptr<Expression>& expr) {
+    auto raw = expr.get();
+    if (!dynamic_cast<ExpressionAdd*>(raw) && !dynamic_cast<ExpressionSubtract*>(raw) &&
+        !dynamic_cast<ExpressionMultiply*>(raw) && !dynamic_cast<ExpressionDivide*>(raw)) {
+        return boost::none;
+    }
+
+    ExpressionProgram program(expr);
+    program._resultRegister = program.compileNode(raw);
+    return program;
+}
+
+size_t ExpressionProgram::compileNode(Expression* expr) {
+    if (auto constant = dynamic_cast<ExpressionConstant*>(expr)) {
+        return allocateRegister(constant->getValue());
+    }
+
+    if (dynamic_cast<ExpressionAdd*>(expr)) {
+        return compileSum(expr->getChildren());
+    }
+    if (dynamic_cast<ExpressionMultiply*>(expr)) {
+        return compileProduct(expr->getChildren());
+    }
+
+    Instruction instruction;
+    if (dynamic_cast<ExpressionSubtract*>(expr) || dynamic_cast<ExpressionDivide*>(expr)) {
+        const auto& children = expr->getChildren();
+        invariant(children.size() == 2);
+        instruction.op =
+            dynamic_cast<ExpressionSubtract*>(expr) ? OpCode::kSubtract : OpCode::kDivide;
+        instruction.lhs = compileNode(children[0].get());
+        instruction.rhs = compileNode(children[1].get());
+    } else {
+        instruction.op = OpCode::kEvaluate;
+        instruction.expr = expr;
+    }
+    instruction.dst = allocateRegister();
+    _instructions.push_back(instruction);
+    return instruction.dst;
+}
+
+size_t ExpressionProgram::compileSum(
+    const std::vector<boost::intrusive_ptr<Expression>>& operands) {
+    const size_t sum = _sums.size();
+    _sums.emplace_back();
+    const size_t dst = allocateRegister();
+
+    Instruction begin;
+    begin.op = OpCode::kSumBegin;
+    begin.lhs = sum;
+    _instructions.push_back(begin);
+
+    // Each operand is evaluated and added to the sum in turn, so that the operands following a
+    // nullish one are not evaluated at all. The jump targets are filled in once the position of
+    // the end of the sum is known.
+    std::vector<size_t> adds;
+    for (auto&& operand : operands) {
+        Instruction add;
+        add.op = OpCode::kSumAdd;
+        add.dst = dst;
+        add.lhs = sum;
+        add.rhs = compileNode(operand.get());
+        adds.push_back(_instructions.size());
+        _instructions.push_back(add);
+    }
+
+    Instruction end;
+    end.op = OpCode::kSumEnd;
+    end.dst = dst;
+    end.lhs = sum;
+    _instructions.push_back(end);
+
+    for (auto add : adds) {
+        _instructions[add].jump = _instructions.size();
+    }
+    return dst;
+}
+
+size_t ExpressionProgram::compileProduct(
+    const std::vector<boost::intrusive_ptr<Expression>>& operands) {
+    const size_t product = _products.size();
+    _products.emplace_back();
+    const size_t dst = allocateRegister();
+
+    Instruction begin;
+    begin.op = OpCode::kProductBegin;
+    begin.lhs = product;
+    _instructions.push_back(begin);
+
+    // As with a sum, the operands following a nullish one are not evaluated.
+    std::vector<size_t> multiplies;
+    for (auto&& operand : operands) {
+        Instruction multiply;
+        multiply.op = OpCode::kProductMultiply;
+        multiply.dst = dst;
+        multiply.lhs = product;
+        multiply.rhs = compileNode(operand.get());
+        multiplies.push_back(_instructions.size());
+        _instructions.push_back(multiply);
+    }
+
+    Instruction end;
+    end.op = OpCode::kProductEnd;
+    end.dst = dst;
+    end.lhs = product;
+    _instructions.push_back(end);
+
+    for (auto multiply : multiplies) {
+        _instructions[multiply].jump = _instructions.size();
+    }
+    return dst;
+}
+
+Value ExpressionProgram::evaluate(const Document& root, Variables* variables) const {
+    const size_t numInstructions = _instructions.size();
+    size_t pc = 0;
+    while (pc < numInstructions) {
+        const auto& instruction = _instructions[pc];
+        switch (instruction.op) {
+            case OpCode::kEvaluate:
+                _registers[instruction.dst] = instruction.expr->evaluate(root, variables);
+                break;
+            case OpCode::kSubtract:
+                _registers[instruction.dst] = ExpressionSubtract::apply(
+                    _registers[instruction.lhs], _registers[instruction.rhs]);
+                break;
+            case OpCode::kDivide:
+                _registers[instruction.dst] = ExpressionDivide::apply(_registers[instruction.lhs],
+                                                                      _registers[instruction.rhs]);
+                break;
+            case OpCode::kSumBegin:
+                _sums[instruction.lhs] = ExpressionAdd::Sum();
+                break;
+            case OpCode::kSumAdd:
+                if (!_sums[instruction.lhs].add(_registers[instruction.rhs])) {
+                    _registers[instruction.dst] = Value(BSONNULL);
+                    pc = instruction.jump;
+                    continue;
+                }
+                break;
+            case OpCode::kSumEnd:
+                _registers[instruction.dst] = _sums[instruction.lhs].getValue();
+                break;
+            case OpCode::kProductBegin:
+                _products[instruction.lhs] = ExpressionMultiply::Product();
+                break;
+            case OpCode::kProductMultiply:
+                if (!_products[instruction.lhs].multiply(_registers[instruction.rhs])) {
+                    _registers[instruction.dst] = Value(BSONNULL);
+                    pc = instruction.jump;
+                    continue;
+                }
+                break;
+            case OpCode::kProductEnd:
+                _registers[instruction.dst] = _products[instruction.lhs].getValue();
+                break;
+        }
+        ++pc;
+    }
+    return _registers[_resultRegister];
+}
+
+}  // namespace mongo
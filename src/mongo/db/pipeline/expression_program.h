@@ -0,0 +1,133 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/intrusive_ptr.hpp>
+#include <boost/optional.hpp>
+#include <vector>
+
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/pipeline/expression.h"
+
+namespace mongo {
+
+/**
+ * A flattened form of an optimized arithmetic Expression tree. Rather than recursively calling
+ * evaluate() on each node and returning a new Value at every level, the tree is compiled into a
+ * linear sequence of instructions which read and write an array of Value registers. The registers
+ * are reused from one evaluation to the next, and constant subtrees, which have already been
+ * folded by Expression::optimize(), are loaded into their registers once at compile time.
+ *
+ * Only $add, $subtract, $multiply and $divide are compiled into instructions. Any other
+ * subexpression, such as a field path, is evaluated as a single opaque instruction. Evaluating
+ * the program has exactly the same semantics as evaluating the original expression, including the
+ * order in which operands are evaluated and the early return of null from $add and $multiply.
+ *
+ * A program holds scratch state, so it may only be evaluated by one thread at a time.
+ */
+class ExpressionProgram {
+public:
+    /**
+     * Compiles 'expr' into a program. Returns boost::none if 'expr' is not one of the arithmetic
+     * expressions listed above, in which case there is nothing to gain over evaluating it
+     * directly.
+     */
+    static boost::optional<ExpressionProgram> compile(const boost::intrusive_ptr<Expression>& expr);
+
+    /**
+     * Returns the same result as evaluating the compiled expression against 'root'.
+     */
+    Value evaluate(const Document& root, Variables* variables) const;
+
+    size_t numInstructions() const {
+        return _instructions.size();
+    }
+
+private:
+    enum class OpCode {
+        kEvaluate,
+        kSubtract,
+        kDivide,
+        kSumBegin,
+        kSumAdd,
+        kSumEnd,
+        kProductBegin,
+        kProductMultiply,
+        kProductEnd,
+    };
+
+    struct Instruction {
+        OpCode op;
+
+        // The register written by this instruction. The accumulating instructions write null here
+        // if they end the $add or $multiply early.
+        size_t dst = 0;
+
+        // The operand registers of kSubtract and kDivide. For the accumulating instructions,
+        // 'lhs' is the index of the accumulator and 'rhs' is the register holding the operand.
+        size_t lhs = 0;
+        size_t rhs = 0;
+
+        // For kSumAdd and kProductMultiply, the instruction to continue from if the result is null.
+        size_t jump = 0;
+
+        // For kEvaluate, the expression to evaluate. Owned by '_expr'.
+        const Expression* expr = nullptr;
+    };
+
+    explicit ExpressionProgram(boost::intrusive_ptr<Expression> expr) : _expr(std::move(expr)) {}
+
+    /**
+     * Appends the instructions which evaluate 'expr' and returns the register holding its result.
+     */
+    size_t compileNode(Expression* expr);
+
+    size_t compileSum(const std::vector<boost::intrusive_ptr<Expression>>& operands);
+    size_t compileProduct(const std::vector<boost::intrusive_ptr<Expression>>& operands);
+
+    size_t allocateRegister(Value initialValue = Value()) {
+        _registers.push_back(std::move(initialValue));
+        return _registers.size() - 1;
+    }
+
+    // Keeps the compiled tree, and therefore the expressions referenced by kEvaluate, alive.
+    boost::intrusive_ptr<Expression> _expr;
+
+    std::vector<Instruction> _instructions;
+    size_t _resultRegister = 0;
+
+    // Registers holding constants are filled at compile time and never written afterwards.
+    mutable std::vector<Value> _registers;
+    mutable std::vector<ExpressionAdd::Sum> _sums;
+    mutable std::vector<ExpressionMultiply::Product> _products;
+};
+
+}  // namespace mongo
@@ -0,0 +1,144 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/exec/document_value/document_value_test_util.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/db/json.h"
+#include "mongo/db/pipeline/expression.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/pipeline/expression_program.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+boost::intrusive_ptr<Expression> parseAndOptimize(ExpressionContext* expCtx, const BSONObj& spec) {
+    return Expression::parseExpression(expCtx, spec, expCtx->variablesParseState)->optimize();
+}
+
+/**
+ * Asserts that the compiled form of 'spec' produces the same result as the expression itself for
+ * each of 'docs', evaluating the same program repeatedly.
+ */
+void assertProgramMatchesExpression(const BSONObj& spec, const std::vector<Document>& docs) {
+    auto expCtx = ExpressionContextForTest{};
+    auto expr = parseAndOptimize(&expCtx, spec);
+    auto program = ExpressionProgram::compile(expr);
+    ASSERT(program);
+
+    for (auto&& doc : docs) {
+        auto expected = expr->evaluate(doc, &expCtx.variables);
+        auto actual = program->evaluate(doc, &expCtx.variables);
+        ASSERT_VALUE_EQ(expected, actual);
+        ASSERT_EQ(expected.getType(), actual.getType());
+    }
+}
+
+TEST(ExpressionProgramTest, DoesNotCompileNonArithmeticExpressions) {
+    auto expCtx = ExpressionContextForTest{};
+    ASSERT_FALSE(
+        ExpressionProgram::compile(parseAndOptimize(&expCtx, fromjson("{$concat: ['$a']}"))));
+
+    // The sum is folded into a constant by optimize().
+    ASSERT_FALSE(
+        ExpressionProgram::compile(parseAndOptimize(&expCtx, fromjson("{$add: [1, 2]}"))));
+}
+
+TEST(ExpressionProgramTest, FoldsConstantSubtreesIntoRegisters) {
+    auto expCtx = ExpressionContextForTest{};
+    auto program = ExpressionProgram::compile(
+        parseAndOptimize(&expCtx, fromjson("{$subtract: ['$a', {$multiply: [2, 3]}]}")));
+    ASSERT(program);
+
+    // Only the field path and the subtraction itself remain to be evaluated.
+    ASSERT_EQ(2U, program->numInstructions());
+    ASSERT_VALUE_EQ(Value(4), program->evaluate(Document{{"a", 10}}, &expCtx.variables));
+}
+
+TEST(ExpressionProgramTest, MatchesNestedArithmetic) {
+    assertProgramMatchesExpression(
+        fromjson("{$add: [{$multiply: ['$a', 2, '$b']}, {$subtract: ['$b', {$divide: ['$a', 4]}]}, "
+                 "1]}"),
+        {Document{{"a", 1}, {"b", 2}},
+         Document{{"a", 2.5}, {"b", 3LL}},
+         Document{{"a", Decimal128("1.5")}, {"b", 7}},
+         Document{{"a", std::numeric_limits<long long>::max()}, {"b", 2LL}},
+         Document{{"a", 1}},
+         Document{{"a", BSONNULL}, {"b", 2}}});
+}
+
+TEST(ExpressionProgramTest, MatchesDateArithmetic) {
+    assertProgramMatchesExpression(
+        fromjson("{$subtract: [{$add: ['$d', '$ms']}, '$d']}"),
+        {Document{{"d", Date_t::fromMillisSinceEpoch(1000)}, {"ms", 500}},
+         Document{{"d", Date_t::fromMillisSinceEpoch(0)}, {"ms", 1.5}}});
+}
+
+TEST(ExpressionProgramTest, StopsEvaluatingOperandsAfterNull) {
+    auto expCtx = ExpressionContextForTest{};
+    auto doc = Document{{"zero", 0}};
+
+    // Neither the expression nor the program evaluates the division by zero.
+    for (auto&& spec : {fromjson("{$add: ['$missing', {$divide: [1, '$zero']}]}"),
+                        fromjson("{$multiply: [null, '$zero', {$divide: [1, '$zero']}]}")}) {
+        auto expr = parseAndOptimize(&expCtx, spec);
+        auto program = ExpressionProgram::compile(expr);
+        ASSERT(program);
+        ASSERT_VALUE_EQ(Value(BSONNULL), expr->evaluate(doc, &expCtx.variables));
+        ASSERT_VALUE_EQ(Value(BSONNULL), program->evaluate(doc, &expCtx.variables));
+    }
+
+    // A later evaluation starts the sum afresh.
+    auto program = ExpressionProgram::compile(
+        parseAndOptimize(&expCtx, fromjson("{$add: ['$a', {$divide: [1, '$zero']}]}")));
+    ASSERT(program);
+    ASSERT_VALUE_EQ(Value(BSONNULL), program->evaluate(Document{}, &expCtx.variables));
+    ASSERT_VALUE_EQ(Value(1.5),
+                    program->evaluate(Document{{"a", 1}, {"zero", 2}}, &expCtx.variables));
+}
+
+TEST(ExpressionProgramTest, PropagatesErrors) {
+    auto expCtx = ExpressionContextForTest{};
+    auto program = ExpressionProgram::compile(
+        parseAndOptimize(&expCtx, fromjson("{$add: [1, {$divide: ['$a', '$b']}]}")));
+    ASSERT(program);
+    ASSERT_THROWS_CODE(program->evaluate(Document{{"a", 1}, {"b", 0}}, &expCtx.variables),
+                       AssertionException,
+                       16608);
+    ASSERT_THROWS_CODE(program->evaluate(Document{{"a", "str"_sd}, {"b", 1}}, &expCtx.variables),
+                       AssertionException,
+                       16609);
+    ASSERT_VALUE_EQ(Value(3.0), program->evaluate(Document{{"a", 4}, {"b", 2}}, &expCtx.variables));
+}
+
+}  // namespace
+}  // namespace mongo
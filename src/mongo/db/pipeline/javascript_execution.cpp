@@ -34,12 +34,30 @@
 #include <iostream>
 
 #include "mongo/base/status_with.h"
+#include "mongo/db/auth/authorization_session.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
 
 namespace {
 const auto getExec = OperationContext::declareDecoration<std::unique_ptr<JsExecution>>();
+
+// Scopes are only shared between operations on the same database, by the same users, which agree
+// on whether stored procedures are loaded.
+std::string getScopePoolName(Client* client, StringData database, bool loadStoredProcedures) {
+    StringBuilder sb;
+    sb << "jsExecution" << (loadStoredProcedures ? "WithStored" : "") << '\0' << database;
+
+    if (AuthorizationSession::exists(client)) {
+        auto as = AuthorizationSession::get(client);
+        for (auto nameIter = as->getAuthenticatedUserNames(); nameIter.more(); nameIter.next()) {
+            // Using a NUL byte which isn't valid in usernames to separate them.
+            sb << '\0' << nameIter->getUnambiguousName();
+        }
+    }
+
+    return sb.str();
+}
 }  // namespace
 
 JsExecution* JsExecution::get(OperationContext* opCtx,
@@ -49,7 +67,11 @@ JsExecution* JsExecution::get(OperationContext* opCtx,
                               boost::optional<int> jsHeapLimitMB) {
     auto& exec = getExec(opCtx);
     if (!exec) {
-        exec = std::make_unique<JsExecution>(opCtx, scope, jsHeapLimitMB);
+        exec = std::make_unique<JsExecution>(
+            opCtx,
+            scope,
+            jsHeapLimitMB,
+            getScopePoolName(opCtx->getClient(), database, loadStoredProcedures));
         exec->getScope()->setLocalDB(database);
         if (loadStoredProcedures) {
             exec->getScope()->loadStored(opCtx, true);
@@ -59,12 +59,18 @@ public:
                             bool loadStoredProcedures,
                             boost::optional<int> jsHeapLimitMB);
     /**
-     * Construct with a thread-local scope and initialize with the given scope variables.
+     * Construct with a thread-local scope and initialize with the given scope variables. If
+     * 'poolName' is given, the scope is reused from the last operation on this thread which used
+     * the same pool name, and is kept for the next one once this JsExecution is destroyed.
      */
     JsExecution(OperationContext* opCtx,
                 const BSONObj& scopeVars,
-                boost::optional<int> jsHeapLimitMB = boost::none)
-        : _scope(getGlobalScriptEngine()->newScopeForCurrentThread(jsHeapLimitMB)) {
+                boost::optional<int> jsHeapLimitMB = boost::none,
+                boost::optional<std::string> poolName = boost::none)
+        : _scope(poolName ? getGlobalScriptEngine()->getPooledScopeForCurrentThread(
+                                opCtx, *poolName, jsHeapLimitMB)
+                          : std::unique_ptr<Scope>(
+                                getGlobalScriptEngine()->newScopeForCurrentThread(jsHeapLimitMB))) {
         _scopeVars = scopeVars.getOwned();
         _scope->init(&_scopeVars);
         _fnCallTimeoutMillis = internalQueryJavaScriptFnTimeoutMillis.load();
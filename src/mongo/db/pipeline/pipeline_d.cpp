@@ -70,6 +70,8 @@
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/plan_executor_factory.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/query/query_feature_flags_gen.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/sort_pattern.h"
 #include "mongo/db/s/collection_sharding_state.h"
@@ -190,6 +192,51 @@ StatusWith<unique_ptr<PlanExecutor, PlanExecutor::Deleter>> createRandomCursorEx
     return exec;
 }
 
+/**
+ * Returns a description of the $group stage at the front of 'pipeline' if the query which feeds it
+ * may execute it as a part of an SBE plan, or boost::none otherwise. Only a $group with a single
+ * group key expression whose accumulators are all $first, $last, $min, $max or a $sum of a constant
+ * integer is eligible, as these have SBE translations with the same results. SBE compares group
+ * keys without regard to a collation, and a $group which produces partial results for merging is
+ * left to the pipeline.
+ */
+boost::optional<CanonicalQuery::GroupPushdown> getGroupForPushdown(
+    const intrusive_ptr<ExpressionContext>& expCtx,
+    const NamespaceString& nss,
+    Pipeline* pipeline) {
+    if (!feature_flags::gSBE.isEnabledAndIgnoreFCV() ||
+        !internalQuerySlotBasedExecutionPushDownGroup.load() || !expCtx->sbeCompatible ||
+        expCtx->getCollator() || expCtx->needsMerge ||
+        expCtx->tailableMode != TailableModeEnum::kNormal || nss.isOplog()) {
+        return boost::none;
+    }
+
+    auto groupStage = dynamic_cast<DocumentSourceGroup*>(pipeline->peekFront());
+    if (!groupStage || groupStage->doingMerge()) {
+        return boost::none;
+    }
+
+    auto idFields = groupStage->getIdFields();
+    if (idFields.size() != 1 || idFields.begin()->first != "_id") {
+        return boost::none;
+    }
+
+    CanonicalQuery::GroupPushdown group{idFields.begin()->second, {}};
+    for (auto&& accStmt : groupStage->getAccumulatedFields()) {
+        std::string op = accStmt.makeAccumulator()->getOpName();
+        if (op == "$sum") {
+            auto constant = dynamic_cast<ExpressionConstant*>(accStmt.expr.argument.get());
+            if (!constant || constant->getValue().getType() != BSONType::NumberInt) {
+                return boost::none;
+            }
+        } else if (op != "$first" && op != "$last" && op != "$min" && op != "$max") {
+            return boost::none;
+        }
+        group.accumulators.push_back({accStmt.fieldName, std::move(op), accStmt.expr.argument});
+    }
+    return group;
+}
+
 StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> attemptToGetExecutor(
     const intrusive_ptr<ExpressionContext>& expCtx,
     const CollectionPtr& collection,
@@ -202,7 +249,8 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> attemptToGetExe
     boost::optional<std::string> groupIdForDistinctScan,
     const AggregateCommand* aggRequest,
     const size_t plannerOpts,
-    const MatchExpressionParser::AllowedFeatureSet& matcherFeatures) {
+    const MatchExpressionParser::AllowedFeatureSet& matcherFeatures,
+    boost::optional<CanonicalQuery::GroupPushdown> groupPushdown) {
     auto findCommand = std::make_unique<FindCommand>(nss);
     query_request_helper::setTailableMode(expCtx->tailableMode, findCommand.get());
     findCommand->setFilter(queryObj.getOwned());
@@ -247,6 +295,7 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> attemptToGetExe
 
     // Mark the metadata that's requested by the pipeline on the CQ.
     cq.getValue()->requestAdditionalMetadata(metadataRequested);
+    cq.getValue()->setGroupPushdown(std::move(groupPushdown));
 
     if (groupIdForDistinctScan) {
         // When the pipeline includes a $group that groups by a single field
@@ -510,8 +559,13 @@ auto buildProjectionForPushdown(const DepsTracker& deps, Pipeline* pipeline) {
 
     // Depending of whether there is a finite dependency set, either return a projection
     // representing this dependency set, or an empty BSON, meaning no projection push down will
-    // happen. This covers cases 2 and 3.
-    return deps.toProjectionWithoutMetadata();
+    // happen. This covers cases 2 and 3. A projection on top-level fields only is eligible for the
+    // PROJECTION_SIMPLE fast path, which slices the needed elements out of the fetched BSON without
+    // building a Document for the projection.
+    return deps.toProjectionWithoutMetadata(
+        internalQueryTruncateDependencyProjectionToRootLevel.load()
+            ? DepsTracker::TruncateToRootLevel::yes
+            : DepsTracker::TruncateToRootLevel::no);
 }
 }  // namespace
 
@@ -755,7 +809,8 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> PipelineD::prep
                                                       rewrittenGroupStage->groupId(),
                                                       aggRequest,
                                                       plannerOpts,
-                                                      matcherFeatures);
+                                                      matcherFeatures,
+                                                      boost::none /* groupPushdown */);
 
         if (swExecutorGrouped.isOK()) {
             // Any $limit stage before the $group stage should make the pipeline ineligible for this
@@ -784,6 +839,38 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> PipelineD::prep
         }
     }
 
+    if (auto groupPushdown = getGroupForPushdown(expCtx, nss, pipeline)) {
+        // If the query is executed by SBE, it runs the $group as a part of its plan and returns
+        // the groups rather than the documents which are grouped, so it's never a count.
+        auto swExecutorGrouped = attemptToGetExecutor(
+            expCtx,
+            collection,
+            nss,
+            queryObj,
+            projObj,
+            deps.metadataDeps(),
+            sortObj,
+            skipThenLimit,
+            boost::none, /* groupIdForDistinctScan */
+            aggRequest,
+            (plannerOpts & ~QueryPlannerParams::IS_COUNT) | QueryPlannerParams::RETURN_OWNED_DATA,
+            matcherFeatures,
+            std::move(groupPushdown));
+        if (!swExecutorGrouped.isOK()) {
+            return swExecutorGrouped;
+        }
+
+        // The classic engine leaves the $group to the pipeline. Its executor is only kept if it
+        // was built with the same options as it would be without the pushdown.
+        if (swExecutorGrouped.getValue()->getCanonicalQuery()->getGroupPushdown()) {
+            pipeline->popFrontWithName(DocumentSourceGroup::kStageName);
+            *hasNoRequirements = false;
+            return swExecutorGrouped;
+        } else if (!*hasNoRequirements) {
+            return swExecutorGrouped;
+        }
+    }
+
     return attemptToGetExecutor(expCtx,
                                 collection,
                                 nss,
@@ -795,7 +882,8 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> PipelineD::prep
                                 boost::none, /* groupIdForDistinctScan */
                                 aggRequest,
                                 plannerOpts,
-                                matcherFeatures);
+                                matcherFeatures,
+                                boost::none /* groupPushdown */);
 }
 
 Timestamp PipelineD::getLatestOplogTimestamp(const Pipeline* pipeline) {
@@ -750,6 +750,35 @@ TEST(PipelineOptimizationTest, LookupShouldAbsorbUnwindMatch) {
     assertPipelineOptimizesAndSerializesTo(inputPipe, outputPipe, serializedPipe);
 }
 
+TEST(PipelineOptimizationTest, LookupShouldPushDownProjectionOfLaterDependencies) {
+    string inputPipe =
+        "[{$lookup: {from: 'lookupColl', as: 'asField', localField: 'y', foreignField: "
+        "'z'}}, "
+        "{$unwind: '$asField'}, "
+        "{$group: {_id: '$asField.subfield'}}]";
+    string outputPipe =
+        "[{$lookup: {from: 'lookupColl', as: 'asField', localField: 'y', foreignField: 'z', "
+        "            unwinding: {preserveNullAndEmptyArrays: false},"
+        "            projecting: {subfield: 1, z: 1, _id: 0}}}, "
+        "{$group: {_id: '$asField.subfield'}}]";
+    string serializedPipe =
+        "[{$lookup: {from: 'lookupColl', as: 'asField', localField: 'y', foreignField: 'z'}}, "
+        "{$unwind: {path: '$asField'}}, "
+        "{$group: {_id: '$asField.subfield'}}]";
+    assertPipelineOptimizesAndSerializesTo(inputPipe, outputPipe, serializedPipe);
+}
+
+TEST(PipelineOptimizationTest, LookupShouldNotPushDownProjectionIfJoinedDocumentsAreNeeded) {
+    string inputPipe =
+        "[{$lookup: {from: 'lookupColl', as: 'asField', localField: 'y', foreignField: "
+        "'z'}}, "
+        "{$group: {_id: '$asField'}}]";
+    string outputPipe =
+        "[{$lookup: {from: 'lookupColl', as: 'asField', localField: 'y', foreignField: 'z'}}, "
+        "{$group: {_id: '$asField'}}]";
+    assertPipelineOptimizesTo(inputPipe, outputPipe);
+}
+
 TEST(PipelineOptimizationTest, LookupShouldAbsorbUnwindAndTypeMatch) {
     string inputPipe =
         "[{$lookup: {from: 'lookupColl', as: 'asField', localField: 'y', foreignField: "
@@ -2343,6 +2372,38 @@ TEST(PipelineOptimizationTest, UnionWithViewsSampleUseCase) {
         " }}"
         "]");
 }
+
+TEST(PipelineOptimizationTest, CommonPrefixOfFacetsGetsHoisted) {
+    assertPipelineOptimizesTo(
+        "[{$facet: {"
+        "   a: [{$match: {x: {$eq: 1}}}, {$project: {_id: true, y: true}}, {$limit: 1}],"
+        "   b: [{$match: {x: {$eq: 1}}}, {$project: {_id: true, y: true}}, {$skip: 1}]"
+        "}}]",
+        "[{$match: {x: {$eq: 1}}},"
+        " {$project: {_id: true, y: true}},"
+        " {$facet: {a: [{$limit: 1}], b: [{$skip: 1}]}}"
+        "]");
+}
+
+TEST(PipelineOptimizationTest, OnlyIdenticalStagesOfFacetsGetHoisted) {
+    assertPipelineOptimizesTo(
+        "[{$facet: {"
+        "   a: [{$match: {x: {$eq: 1}}}, {$project: {_id: true, y: true}}],"
+        "   b: [{$match: {x: {$eq: 1}}}, {$project: {_id: true, z: true}}],"
+        "   c: [{$match: {x: {$eq: 1}}}]"
+        "}}]",
+        "[{$match: {x: {$eq: 1}}},"
+        " {$facet: {a: [{$project: {_id: true, y: true}}], b: [{$project: {_id: true, z: true}}],"
+        "   c: []}}"
+        "]");
+}
+
+TEST(PipelineOptimizationTest, StatefulStagesOfFacetsDoNotGetHoisted) {
+    assertPipelineOptimizesTo("[{$facet: {a: [{$limit: 1}], b: [{$limit: 1}]}}]",
+                              "[{$facet: {a: [{$limit: 1}], b: [{$limit: 1}]}}]");
+    assertPipelineOptimizesTo("[{$facet: {a: [{$match: {x: {$eq: 1}}}]}}]",
+                              "[{$facet: {a: [{$match: {x: {$eq: 1}}}]}}]");
+}
 }  // namespace Local
 
 namespace Sharded {
@@ -143,6 +143,24 @@ bool supportsUniqueKey(const boost::intrusive_ptr<ExpressionContext>& expCtx,
             CollatorInterface::collatorsMatch(index->getCollator(), expCtx->getCollator()));
 }
 
+void setSpeculativeReadTimestampAfterLookup(OperationContext* opCtx) {
+    // Set the speculative read timestamp appropriately after we do a document lookup locally. We
+    // set the speculative read timestamp based on the timestamp used by the transaction.
+    repl::SpeculativeMajorityReadInfo& speculativeMajorityReadInfo =
+        repl::SpeculativeMajorityReadInfo::get(opCtx);
+    if (speculativeMajorityReadInfo.isSpeculativeRead()) {
+        // Speculative majority reads are required to use the 'kNoOverlap' read source.
+        // Storage engine operations require at least Global IS.
+        Lock::GlobalLock lk(opCtx, MODE_IS);
+        invariant(opCtx->recoveryUnit()->getTimestampReadSource() ==
+                  RecoveryUnit::ReadSource::kNoOverlap);
+        boost::optional<Timestamp> readTs =
+            opCtx->recoveryUnit()->getPointInTimeReadTimestamp(opCtx);
+        invariant(readTs);
+        speculativeMajorityReadInfo.setSpeculativeReadTimestampForward(*readTs);
+    }
+}
+
 }  // namespace
 
 std::unique_ptr<TransactionHistoryIteratorBase>
@@ -205,6 +223,11 @@ std::vector<Document> CommonMongodProcessInterface::getIndexStats(OperationConte
             doc["building"] = Value(true);
         }
 
+        BSONObjBuilder ioStats;
+        if (entry->accessMethod()->appendIOStats(opCtx, &ioStats)) {
+            doc["io"] = Value(ioStats.obj());
+        }
+
         indexStats.push_back(doc.freeze());
     }
     return indexStats;
@@ -230,6 +253,12 @@ Status CommonMongodProcessInterface::appendRecordCount(OperationContext* opCtx,
     return appendCollectionRecordCount(opCtx, nss, builder);
 }
 
+Status CommonMongodProcessInterface::appendIOStats(OperationContext* opCtx,
+                                                   const NamespaceString& nss,
+                                                   BSONObjBuilder* builder) const {
+    return appendCollectionIOStats(opCtx, nss, builder);
+}
+
 Status CommonMongodProcessInterface::appendQueryExecStats(OperationContext* opCtx,
                                                           const NamespaceString& nss,
                                                           BSONObjBuilder* builder) const {
@@ -356,25 +385,56 @@ boost::optional<Document> CommonMongodProcessInterface::lookupSingleDocument(
                                 << ", " << next->toString() << "]");
     }
 
-    // Set the speculative read timestamp appropriately after we do a document lookup locally. We
-    // set the speculative read timestamp based on the timestamp used by the transaction.
-    repl::SpeculativeMajorityReadInfo& speculativeMajorityReadInfo =
-        repl::SpeculativeMajorityReadInfo::get(expCtx->opCtx);
-    if (speculativeMajorityReadInfo.isSpeculativeRead()) {
-        // Speculative majority reads are required to use the 'kNoOverlap' read source.
-        // Storage engine operations require at least Global IS.
-        Lock::GlobalLock lk(expCtx->opCtx, MODE_IS);
-        invariant(expCtx->opCtx->recoveryUnit()->getTimestampReadSource() ==
-                  RecoveryUnit::ReadSource::kNoOverlap);
-        boost::optional<Timestamp> readTs =
-            expCtx->opCtx->recoveryUnit()->getPointInTimeReadTimestamp(expCtx->opCtx);
-        invariant(readTs);
-        speculativeMajorityReadInfo.setSpeculativeReadTimestampForward(*readTs);
+    setSpeculativeReadTimestampAfterLookup(expCtx->opCtx);
+    return lookedUpDocument;
+}
+
+std::vector<boost::optional<Document>> CommonMongodProcessInterface::lookupDocumentsById(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx,
+    const NamespaceString& nss,
+    UUID collectionUUID,
+    const std::vector<Value>& ids) {
+    std::vector<boost::optional<Document>> lookedUpDocs(ids.size());
+
+    std::unique_ptr<Pipeline, PipelineDeleter> pipeline;
+    boost::intrusive_ptr<ExpressionContext> foreignExpCtx;
+    try {
+        // Be sure to do the lookup using the collection default collation, which is also the
+        // collation of the _id index.
+        foreignExpCtx = expCtx->copyWith(
+            nss,
+            collectionUUID,
+            _getCollectionDefaultCollator(expCtx->opCtx, nss.db(), collectionUUID));
+        MakePipelineOptions opts;
+        opts.allowTargetingShards = false;
+        pipeline = Pipeline::makePipeline(
+            {BSON("$match" << BSON("_id" << BSON("$in" << Value(ids))))}, foreignExpCtx, opts);
+    } catch (const ExceptionFor<ErrorCodes::NamespaceNotFound>&) {
+        return lookedUpDocs;
     }
 
-    return lookedUpDocument;
+    // The same _id may be requested more than once, and the collation decides which requested
+    // value a document matches.
+    auto positions =
+        foreignExpCtx->getValueComparator().makeUnorderedValueMap<std::vector<size_t>>();
+    for (size_t i = 0; i < ids.size(); ++i) {
+        positions[ids[i]].push_back(i);
+    }
+    while (auto lookedUpDoc = pipeline->getNext()) {
+        auto it = positions.find(lookedUpDoc->getField("_id"_sd));
+        if (it == positions.end()) {
+            continue;
+        }
+        for (auto pos : it->second) {
+            lookedUpDocs[pos] = *lookedUpDoc;
+        }
+    }
+
+    setSpeculativeReadTimestampAfterLookup(expCtx->opCtx);
+    return lookedUpDocs;
 }
 
+
 BackupCursorState CommonMongodProcessInterface::openBackupCursor(
     OperationContext* opCtx, const StorageEngine::BackupOptions& options) {
     auto backupCursorHooks = BackupCursorHooks::get(opCtx->getServiceContext());
@@ -476,11 +536,22 @@ BSONObj CommonMongodProcessInterface::_reportCurrentOpForClient(
         }
 
         // Append lock stats before returning.
-        if (auto lockerInfo = clientOpCtx->lockState()->getLockerInfo(
-                CurOp::get(*clientOpCtx)->getLockStatsBase())) {
+        auto lockerInfo =
+            clientOpCtx->lockState()->getLockerInfo(CurOp::get(*clientOpCtx)->getLockStatsBase());
+        if (lockerInfo) {
             fillLockerInfo(*lockerInfo, builder);
         }
 
+        {
+            BSONObjBuilder waitTimesBuilder;
+            OpDebug::appendLockWaitTimes(clientOpCtx->lockState(),
+                                         lockerInfo ? &lockerInfo->stats : nullptr,
+                                         &waitTimesBuilder);
+            if (auto waitTimesObj = waitTimesBuilder.obj(); waitTimesObj.nFields() > 0) {
+                builder.append("waitTimesMicros", waitTimesObj);
+            }
+        }
+
         if (auto tcWorkerRepo = getTransactionCoordinatorWorkerCurOpRepository()) {
             tcWorkerRepo->reportState(clientOpCtx, &builder);
         }
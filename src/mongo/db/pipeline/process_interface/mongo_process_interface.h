@@ -214,6 +214,13 @@ public:
                                         const NamespaceString& nss,
                                         BSONObjBuilder* builder) const = 0;
 
+    /**
+     * Appends the cache and disk I/O stats of the collection 'nss' and its indexes to 'builder'.
+     */
+    virtual Status appendIOStats(OperationContext* opCtx,
+                                 const NamespaceString& nss,
+                                 BSONObjBuilder* builder) const = 0;
+
     /**
      * Gets the collection options for the collection given by 'nss'. Throws
      * ErrorCodes::CommandNotSupportedOnView if 'nss' describes a view. Future callers may want to
@@ -250,6 +257,14 @@ public:
                                                 const NamespaceString& ns,
                                                 const std::vector<BSONObj>& indexSpecs) = 0;
 
+    /**
+     * Like createIndexesOnEmptyCollection(), but the collection may already contain documents, in
+     * which case the indexes are built from a scan of the collection with sorted, bulk loaded keys.
+     */
+    virtual void createIndexes(OperationContext* opCtx,
+                               const NamespaceString& ns,
+                               const std::vector<BSONObj>& indexSpecs) = 0;
+
     virtual void dropCollection(OperationContext* opCtx, const NamespaceString& collection) = 0;
 
     /**
@@ -357,6 +372,26 @@ public:
         boost::optional<BSONObj> readConcern,
         bool allowSpeculativeMajorityRead = false) = 0;
 
+    /**
+     * Looks up the documents with the _id values 'ids' in the collection 'nss' without a read
+     * concern, as lookupSingleDocument() does for a document key of {_id: <id>}. Returns one entry
+     * per element of 'ids', in the same order, which is boost::none if the document was not found.
+     * The default implementation looks up each document separately.
+     */
+    virtual std::vector<boost::optional<Document>> lookupDocumentsById(
+        const boost::intrusive_ptr<ExpressionContext>& expCtx,
+        const NamespaceString& nss,
+        UUID collectionUUID,
+        const std::vector<Value>& ids) {
+        std::vector<boost::optional<Document>> lookedUpDocs;
+        lookedUpDocs.reserve(ids.size());
+        for (auto&& id : ids) {
+            lookedUpDocs.push_back(lookupSingleDocument(
+                expCtx, nss, collectionUUID, Document{{"_id"_sd, id}}, boost::none));
+        }
+        return lookedUpDocs;
+    }
+
     /**
      * Returns a vector of all idle (non-pinned) local cursors.
      */
@@ -120,6 +120,12 @@ public:
         MONGO_UNREACHABLE;
     }
 
+    Status appendIOStats(OperationContext* opCtx,
+                         const NamespaceString& nss,
+                         BSONObjBuilder* builder) const final {
+        MONGO_UNREACHABLE;
+    }
+
     BSONObj getCollectionOptions(OperationContext* opCtx, const NamespaceString& nss) final {
         MONGO_UNREACHABLE;
     }
@@ -144,6 +150,12 @@ public:
         MONGO_UNREACHABLE;
     }
 
+    void createIndexes(OperationContext* opCtx,
+                       const NamespaceString& ns,
+                       const std::vector<BSONObj>& indexSpecs) final {
+        MONGO_UNREACHABLE;
+    }
+
     void dropCollection(OperationContext* opCtx, const NamespaceString& collection) final {
         MONGO_UNREACHABLE;
     }
@@ -144,6 +144,49 @@ void NonShardServerProcessInterface::createIndexesOnEmptyCollection(
             wuow.commit();
         });
 }
+
+void NonShardServerProcessInterface::createIndexes(OperationContext* opCtx,
+                                                   const NamespaceString& ns,
+                                                   const std::vector<BSONObj>& indexSpecs) {
+    AutoGetCollection autoColl(opCtx, ns, MODE_X);
+    CollectionWriter collection(autoColl);
+    uassert(ErrorCodes::DatabaseDropPending,
+            str::stream() << "The database is in the process of being dropped " << ns.db(),
+            autoColl.getDb() && !autoColl.getDb()->isDropPending(opCtx));
+
+    uassert(ErrorCodes::NamespaceNotFound,
+            str::stream() << "Failed to create indexes for aggregation because collection "
+                             "does not exist: "
+                          << ns << ": " << BSON("indexes" << indexSpecs),
+            collection.get());
+
+    auto removeIndexBuildsToo = false;
+    auto filteredIndexes = collection->getIndexCatalog()->removeExistingIndexes(
+        opCtx, indexSpecs, removeIndexBuildsToo);
+    if (filteredIndexes.empty()) {
+        return;
+    }
+
+    auto fromMigrate = false;
+    if (collection->isEmpty(opCtx)) {
+        writeConflictRetry(opCtx, "NonShardServerProcessInterface::createIndexes", ns.ns(), [&] {
+            WriteUnitOfWork wuow(opCtx);
+            IndexBuildsCoordinator::get(opCtx)->createIndexesOnEmptyCollection(
+                opCtx, collection, filteredIndexes, fromMigrate);
+            wuow.commit();
+        });
+        return;
+    }
+
+    // Each index is built from a scan of the collection, with its keys sorted and bulk loaded into
+    // the new index while the collection is locked exclusively.
+    auto indexConstraints = IndexBuildsManager::IndexConstraints::kEnforce;
+    for (auto&& spec : filteredIndexes) {
+        IndexBuildsCoordinator::get(opCtx)->createIndex(
+            opCtx, collection->uuid(), spec, indexConstraints, fromMigrate);
+    }
+}
+
 void NonShardServerProcessInterface::renameIfOptionsAndIndexesHaveNotChanged(
     OperationContext* opCtx,
     const BSONObj& renameCommandObj,
@@ -124,6 +124,18 @@ void ReplicaSetNodeProcessInterface::createIndexesOnEmptyCollection(
     uassertStatusOK(_executeCommandOnPrimary(opCtx, ns, cmd.obj()));
 }
 
+void ReplicaSetNodeProcessInterface::createIndexes(OperationContext* opCtx,
+                                                   const NamespaceString& ns,
+                                                   const std::vector<BSONObj>& indexSpecs) {
+    if (_canWriteLocally(opCtx, ns)) {
+        return NonShardServerProcessInterface::createIndexes(opCtx, ns, indexSpecs);
+    }
+    BSONObjBuilder cmd;
+    cmd.append("createIndexes", ns.coll());
+    cmd.append("indexes", indexSpecs);
+    uassertStatusOK(_executeCommandOnPrimary(opCtx, ns, cmd.obj()));
+}
+
 void ReplicaSetNodeProcessInterface::renameIfOptionsAndIndexesHaveNotChanged(
     OperationContext* opCtx,
     const BSONObj& renameCommandObj,
@@ -300,6 +300,13 @@ void ShardServerProcessInterface::createCollection(OperationContext* opCtx,
 
 void ShardServerProcessInterface::createIndexesOnEmptyCollection(
     OperationContext* opCtx, const NamespaceString& ns, const std::vector<BSONObj>& indexSpecs) {
+    // The createIndexes command does the right thing whether or not the collection is empty.
+    createIndexes(opCtx, ns, indexSpecs);
+}
+
+void ShardServerProcessInterface::createIndexes(OperationContext* opCtx,
+                                                const NamespaceString& ns,
+                                                const std::vector<BSONObj>& indexSpecs) {
     auto cachedDbInfo =
         uassertStatusOK(Grid::get(opCtx)->catalogCache()->getDatabase(opCtx, ns.db()));
     BSONObjBuilder newCmdBuilder;
@@ -313,7 +320,7 @@ void ShardServerProcessInterface::createIndexesOnEmptyCollection(
         opCtx,
         Grid::get(opCtx)->catalogCache(),
         ns,
-        "copying index for empty collection {}"_format(ns.ns()),
+        "creating indexes for collection {}"_format(ns.ns()),
         [&] {
             auto response = executeRawCommandAgainstDatabasePrimary(
                 opCtx,
@@ -116,6 +116,12 @@ public:
         MONGO_UNREACHABLE;
     }
 
+    Status appendIOStats(OperationContext* opCtx,
+                         const NamespaceString& nss,
+                         BSONObjBuilder* builder) const override {
+        MONGO_UNREACHABLE;
+    }
+
     BSONObj getCollectionOptions(OperationContext* opCtx, const NamespaceString& nss) override {
         MONGO_UNREACHABLE;
     }
@@ -140,6 +146,11 @@ public:
                                         const std::vector<BSONObj>& indexSpecs) override {
         MONGO_UNREACHABLE;
     }
+    void createIndexes(OperationContext* opCtx,
+                       const NamespaceString& ns,
+                       const std::vector<BSONObj>& indexSpecs) override {
+        MONGO_UNREACHABLE;
+    }
     void dropCollection(OperationContext* opCtx, const NamespaceString& ns) override {
         MONGO_UNREACHABLE;
     }
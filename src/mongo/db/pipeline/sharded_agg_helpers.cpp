@@ -761,6 +761,71 @@ boost::optional<ShardedExchangePolicy> checkIfEligibleForExchange(OperationConte
     return walkPipelineBackwardsTrackingShardKey(opCtx, mergePipeline, cm);
 }
 
+boost::optional<ShardedExchangePolicy> checkIfEligibleForGroupMergeExchange(
+    const Pipeline* mergePipeline, const std::set<ShardId>& targetedShards) {
+    const auto maxConsumers = internalQueryGroupMergeExchangeConsumers.load();
+    if (internalQueryDisableExchange.load() || maxConsumers < 2 || targetedShards.size() < 2) {
+        return boost::none;
+    }
+
+    const auto& sources = mergePipeline->getSources();
+    const auto leadingGroup =
+        sources.empty() ? nullptr : dynamic_cast<DocumentSourceGroup*>(sources.front().get());
+    if (!leadingGroup || !leadingGroup->doingMerge()) {
+        return boost::none;
+    }
+
+    // The partial groups are routed by hashing their _id, which only sends all the partial results
+    // of a group to the same consumer if equal group keys have equal hashes. That is not the case
+    // under a non-simple collation. Writes and stages which must run on the primary shard are left
+    // to the usual merge, or to the exchange set up for a $merge into a sharded collection.
+    const auto& expCtx = mergePipeline->getContext();
+    if (expCtx->getCollator() || expCtx->ns.isCollectionlessAggregateNS() ||
+        mergePipeline->needsPrimaryShardMerger() ||
+        std::any_of(sources.begin(), sources.end(), [](const auto& stage) {
+            return stage->constraints().writesPersistentData();
+        })) {
+        return boost::none;
+    }
+
+    // Every group is merged by exactly one consumer, so the consumers can go on to run any stages
+    // which can run on each shard's stream independently. The first stage which needs the merged
+    // stream of every group, such as a $sort or a $limit, and everything after it runs on the
+    // merger over the union of the consumers' results.
+    size_t numConsumerStages = 1;
+    for (auto it = std::next(sources.begin()); it != sources.end(); ++it, ++numConsumerStages) {
+        const auto hostRequirement = (*it)->constraints().hostRequirement;
+        if ((*it)->distributedPlanLogic() ||
+            (hostRequirement != StageConstraints::HostTypeRequirement::kNone &&
+             hostRequirement != StageConstraints::HostTypeRequirement::kAnyShard)) {
+            break;
+        }
+    }
+
+    // Split the space of 64-bit hashes into equal ranges, one per consumer.
+    const size_t numConsumers = std::min(targetedShards.size(), static_cast<size_t>(maxConsumers));
+    const auto rangeWidth = std::numeric_limits<uint64_t>::max() / numConsumers;
+    std::vector<BSONObj> boundaries{BSON("_id" << MINKEY)};
+    for (size_t i = 1; i < numConsumers; ++i) {
+        boundaries.push_back(BSON("_id" << static_cast<long long>(
+                                      static_cast<uint64_t>(std::numeric_limits<long long>::min()) +
+                                      i * rangeWidth)));
+    }
+    boundaries.push_back(BSON("_id" << MAXKEY));
+
+    ExchangeSpec exchangeSpec;
+    exchangeSpec.setPolicy(ExchangePolicyEnum::kKeyRange);
+    exchangeSpec.setKey(BSON("_id"
+                             << "hashed"));
+    exchangeSpec.setBoundaries(std::move(boundaries));
+    exchangeSpec.setConsumers(numConsumers);
+
+    std::vector<ShardId> consumerShards(targetedShards.begin(),
+                                        std::next(targetedShards.begin(), numConsumers));
+    return ShardedExchangePolicy{
+        std::move(exchangeSpec), std::move(consumerShards), numConsumerStages};
+}
+
 SplitPipeline splitPipeline(std::unique_ptr<Pipeline, PipelineDeleter> pipeline) {
     auto& expCtx = pipeline->getContext();
     // Re-brand 'pipeline' as the merging pipeline. We will move stages one by one from the merging
@@ -907,6 +972,10 @@ DispatchShardPipelineResults dispatchShardPipeline(
         splitPipelines = splitPipeline(std::move(pipeline));
 
         exchangeSpec = checkIfEligibleForExchange(opCtx, splitPipelines->mergePipeline.get());
+        if (!exchangeSpec) {
+            exchangeSpec =
+                checkIfEligibleForGroupMergeExchange(splitPipelines->mergePipeline.get(), shardIds);
+        }
     }
 
     // Generate the command object for the targeted shards.
@@ -67,6 +67,11 @@ struct ShardedExchangePolicy {
 
     // Shards that will run the consumer part of the exchange.
     std::vector<ShardId> consumerShards;
+
+    // If set, the consumers only run this many leading stages of the merging pipeline, and the
+    // remaining stages run on the merger over the union of the consumers' results. Otherwise the
+    // consumers run the entire merging pipeline.
+    boost::optional<size_t> numConsumerStages;
 };
 
 struct DispatchShardPipelineResults {
@@ -105,6 +110,15 @@ struct DispatchShardPipelineResults {
 boost::optional<ShardedExchangePolicy> checkIfEligibleForExchange(OperationContext* opCtx,
                                                                   const Pipeline* mergePipeline);
 
+/**
+ * If the merging pipeline begins by merging the partial results of a $group and
+ * 'internalQueryGroupMergeExchangeConsumers' is greater than one, returns an exchange policy which
+ * hash-partitions the partial groups by their _id among that many of the 'targetedShards', so that
+ * they each merge a share of the groups in parallel.
+ */
+boost::optional<ShardedExchangePolicy> checkIfEligibleForGroupMergeExchange(
+    const Pipeline* mergePipeline, const std::set<ShardId>& targetedShards);
+
 /**
  * Split the current Pipeline into a Pipeline for each shard, and a Pipeline that combines the
  * results within a merging process. This call also performs optimizations with the aim of reducing
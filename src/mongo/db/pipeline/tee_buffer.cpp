@@ -50,6 +50,10 @@ boost::intrusive_ptr<TeeBuffer> TeeBuffer::create(size_t nConsumers, int bufferS
 }
 
 DocumentSource::GetNextResult TeeBuffer::getNext(size_t consumerId) {
+    if (_concurrentConsumers) {
+        return getNextForConcurrentConsumer(consumerId);
+    }
+
     size_t nConsumersStillProcessingThisBatch =
         std::count_if(_consumers.begin(), _consumers.end(), [](const ConsumerInfo& info) {
             return info.nLeftToReturn > 0;
@@ -104,4 +108,49 @@ void TeeBuffer::loadNextBatch() {
     }
 }
 
+DocumentSource::GetNextResult TeeBuffer::getNextForConcurrentConsumer(size_t consumerId) {
+    if (_sharedBuffer.empty()) {
+        return DocumentSource::GetNextResult::makeEOF();
+    }
+
+    auto& consumer = _consumers[consumerId];
+    if (consumer.nLeftToReturn == 0) {
+        // This consumer has reached the end of this batch, and must wait for the caller to load
+        // the next one.
+        return DocumentSource::GetNextResult::makePauseExecution();
+    }
+
+    const size_t bufferIndex = _sharedBuffer.size() - consumer.nLeftToReturn;
+    --consumer.nLeftToReturn;
+
+    return Document::fromBsonWithMetaData(_sharedBuffer[bufferIndex]);
+}
+
+bool TeeBuffer::loadNextBatchForConcurrentConsumers() {
+    invariant(_concurrentConsumers);
+    _sharedBuffer.clear();
+    size_t bytesInBuffer = 0;
+
+    auto input = _source->getNext();
+    for (; input.isAdvanced(); input = _source->getNext()) {
+        auto bson = input.getDocument().toBsonWithMetaData();
+        bytesInBuffer += bson.objsize();
+        _sharedBuffer.push_back(std::move(bson));
+
+        if (bytesInBuffer >= _bufferSizeBytes) {
+            break;  // Need to break here so we don't get the next input and accidentally ignore it.
+        }
+    }
+
+    // See loadNextBatch() for why we never get a paused input.
+    invariant(!input.isPaused());  // NOLINT(bugprone-use-after-move)
+
+    for (auto&& consumer : _consumers) {
+        if (consumer.stillInUse) {
+            consumer.nLeftToReturn = _sharedBuffer.size();
+        }
+    }
+    return !_sharedBuffer.empty();
+}
+
 }  // namespace mongo
@@ -70,6 +70,7 @@ public:
                 return info.stillInUse;
             })) {
             _buffer.clear();
+            _sharedBuffer.clear();
             if (_source) {
                 _source->dispose();
             }
@@ -83,6 +84,27 @@ public:
      */
     DocumentSource::GetNextResult getNext(size_t consumerId);
 
+    /**
+     * Switches this buffer to serve consumers running on different threads. In this mode the
+     * consumers never load a batch themselves; instead, the caller must call
+     * loadNextBatchForConcurrentConsumers() each time every consumer has reached the end of the
+     * current batch, so that the buffer is never modified while consumers are reading it.
+     *
+     * A Document lazily caches its fields when they are accessed, so it cannot be read by several
+     * threads at once. Each buffered input is therefore held as BSON, and every consumer is handed
+     * its own Document view over the same underlying BSON, which is not copied.
+     */
+    void enableConcurrentConsumers() {
+        invariant(_buffer.empty());
+        _concurrentConsumers = true;
+    }
+
+    /**
+     * Loads the next batch of input for consumers running concurrently. Must not be called while
+     * any consumer is calling getNext(). Returns false if the input has been exhausted.
+     */
+    bool loadNextBatchForConcurrentConsumers();
+
 private:
     TeeBuffer(size_t nConsumers, size_t bufferSizeBytes);
 
@@ -93,11 +115,21 @@ private:
      */
     void loadNextBatch();
 
+    /**
+     * Implements getNext() for consumers running concurrently. Only reads shared state, and writes
+     * the state belonging to 'consumerId'.
+     */
+    DocumentSource::GetNextResult getNextForConcurrentConsumer(size_t consumerId);
+
     DocumentSource* _source = nullptr;
 
     const size_t _bufferSizeBytes;
     std::vector<DocumentSource::GetNextResult> _buffer;
 
+    // Used in place of '_buffer' when the consumers run concurrently.
+    bool _concurrentConsumers = false;
+    std::vector<BSONObj> _sharedBuffer;
+
     struct ConsumerInfo {
         bool stillInUse = true;
         int nLeftToReturn = 0;
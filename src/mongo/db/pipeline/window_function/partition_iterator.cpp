@@ -43,9 +43,14 @@ boost::optional<Document> PartitionIterator::operator[](int index) {
     if (desired < 0)
         return boost::none;
 
+    tassert(5501401,
+            "Requested a document which has been released by the PartitionIterator",
+            desired >= _cacheStartIndex);
+    auto cacheEnd = _cacheStartIndex + (int)_cache.size();
+
     // Case 1: Document is in the cache already.
-    if (desired >= 0 && desired < (int)_cache.size())
-        return _cache[desired];
+    if (desired < cacheEnd)
+        return _cache[desired - _cacheStartIndex].doc;
 
     // Case 2: Attempting to access index greater than what the cache currently holds. If we've
     // already exhausted the partition, then early return. Otherwise continue to pull in
@@ -53,7 +58,7 @@ boost::optional<Document> PartitionIterator::operator[](int index) {
     if (_state == IteratorState::kAwaitingAdvanceToNext ||
         _state == IteratorState::kAwaitingAdvanceToEOF)
         return boost::none;
-    for (int i = _cache.size(); i <= desired; i++) {
+    for (int i = cacheEnd; i <= desired; i++) {
         // Pull in document from prior stage.
         getNextDocument();
         // Check for EOF or the next partition.
@@ -62,14 +67,15 @@ boost::optional<Document> PartitionIterator::operator[](int index) {
             return boost::none;
     }
 
-    return _cache[desired];
+    return _cache[desired - _cacheStartIndex].doc;
 }
 
 PartitionIterator::AdvanceResult PartitionIterator::advance() {
     // Check if the next document is in the cache.
-    if ((_currentIndex + 1) < (int)_cache.size()) {
+    if ((_currentIndex + 1) < _cacheStartIndex + (int)_cache.size()) {
         // Same partition, update the current index.
         _currentIndex++;
+        releaseUnreachableDocuments();
         return AdvanceResult::kAdvanced;
     }
 
@@ -81,7 +87,7 @@ PartitionIterator::AdvanceResult PartitionIterator::advance() {
             // Pull in the next document and advance the pointer.
             getNextDocument();
             if (_state == IteratorState::kAwaitingAdvanceToEOF) {
-                _cache.clear();
+                clearCache();
                 _currentIndex = 0;
                 _state = IteratorState::kAdvancedToEOF;
                 return AdvanceResult::kEOF;
@@ -91,6 +97,7 @@ PartitionIterator::AdvanceResult PartitionIterator::advance() {
             } else {
                 // Same partition, update the current index.
                 _currentIndex++;
+                releaseUnreachableDocuments();
                 return AdvanceResult::kAdvanced;
             }
         case IteratorState::kAwaitingAdvanceToNext:
@@ -101,7 +108,7 @@ PartitionIterator::AdvanceResult PartitionIterator::advance() {
         case IteratorState::kAdvancedToEOF:
             // In either of these states, there's no point in reading from the prior document source
             // because we've already hit EOF.
-            _cache.clear();
+            clearCache();
             _currentIndex = 0;
             return AdvanceResult::kEOF;
         default:
@@ -136,11 +143,37 @@ void PartitionIterator::getNextDocument() {
             _nextPartition = NextPartitionState{std::move(doc), std::move(curKey)};
             _state = IteratorState::kAwaitingAdvanceToNext;
         } else
-            _cache.emplace_back(std::move(doc));
+            appendToCache(std::move(doc));
     } else {
-        _cache.emplace_back(std::move(doc));
+        appendToCache(std::move(doc));
         _state = IteratorState::kIntraPartition;
     }
 }
 
+void PartitionIterator::appendToCache(Document doc) {
+    // Remember the size which was accounted for, since the approximate size of a Document may
+    // grow as its fields are accessed.
+    auto sizeBytes = doc.getApproximateSize();
+    _memoryUsageBytes += sizeBytes;
+    uassert(ErrorCodes::ExceededMemoryLimit,
+            str::stream() << "$setWindowFields exceeded the memory limit of " << _maxMemoryBytes
+                          << " bytes for the documents in the window of a partition. Narrow the "
+                             "window or raise internalDocumentSourceSetWindowFieldsMaxMemoryBytes",
+            _memoryUsageBytes <= _maxMemoryBytes);
+    _cache.push_back({std::move(doc), sizeBytes});
+}
+
+void PartitionIterator::releaseUnreachableDocuments() {
+    if (!_lookBehind) {
+        return;
+    }
+
+    auto lowestReachable = _currentIndex + *_lookBehind;
+    while (_cacheStartIndex < lowestReachable && !_cache.empty()) {
+        _memoryUsageBytes -= _cache.front().sizeBytes;
+        _cache.pop_front();
+        ++_cacheStartIndex;
+    }
+}
+
 }  // namespace mongo
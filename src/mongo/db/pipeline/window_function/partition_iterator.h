@@ -29,14 +29,22 @@
 
 #pragma once
 
+#include <deque>
+
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/expression.h"
+#include "mongo/db/query/query_knobs_gen.h"
 
 namespace mongo {
 
 /**
  * This class provides an abstraction for accessing documents in a partition via an interator-type
  * interface. There is always a "current" document with which indexed access is relative to.
+ *
+ * By default every document of the current partition is held in memory until the iterator advances
+ * to the next partition. If the consumers declare how far behind the current document they may
+ * look via setLookBehind(), documents which fall out of reach are released as the iterator
+ * advances, so that memory use is bounded by the size of the window rather than the partition.
  */
 class PartitionIterator {
 public:
@@ -46,6 +54,7 @@ public:
         : _expCtx(expCtx),
           _source(source),
           _partitionExpr(partitionExpr),
+          _maxMemoryBytes(internalDocumentSourceSetWindowFieldsMaxMemoryBytes.load()),
           _state(IteratorState::kNotInitialized) {}
 
     /**
@@ -75,6 +84,24 @@ public:
         return _currentIndex;
     }
 
+    /**
+     * Declares that no consumer will request a document more than 'lookBehind' positions before
+     * the current one, allowing the iterator to release such documents. For example, a
+     * 'lookBehind' of 0 means that only the current document and those after it are accessible.
+     */
+    void setLookBehind(int lookBehind) {
+        tassert(5501400, "Look behind must not be positive", lookBehind <= 0);
+        _lookBehind = lookBehind;
+        releaseUnreachableDocuments();
+    }
+
+    /**
+     * Returns the approximate size in bytes of the documents currently held by the iterator.
+     */
+    auto getMemoryUsageBytes() const {
+        return _memoryUsageBytes;
+    }
+
     /**
      * Sets the input DocumentSource for this iterator to 'source'.
      */
@@ -88,6 +115,27 @@ private:
      */
     void getNextDocument();
 
+    /**
+     * Appends 'doc' to the cache of the current partition, failing if the cache exceeds the memory
+     * limit.
+     */
+    void appendToCache(Document doc);
+
+    /**
+     * Clears the cache, e.g. when moving to a new partition or reaching EOF.
+     */
+    void clearCache() {
+        _cache.clear();
+        _cacheStartIndex = 0;
+        _memoryUsageBytes = 0;
+    }
+
+    /**
+     * Releases the documents at the front of the cache which are before the look behind of the
+     * current document, if one has been set.
+     */
+    void releaseUnreachableDocuments();
+
     /**
      * Resets the state of the iterator with the first document of the new partition.
      */
@@ -95,8 +143,8 @@ private:
         tassert(5340101,
                 "Invalid call to PartitionIterator::advanceToNextPartition",
                 _nextPartition != boost::none);
-        _cache.clear();
-        _cache.emplace_back(std::move(_nextPartition->_doc));
+        clearCache();
+        appendToCache(std::move(_nextPartition->_doc));
         _partitionKey = std::move(_nextPartition->_partitionKey);
         _nextPartition.reset();
         _currentIndex = 0;
@@ -106,8 +154,21 @@ private:
     ExpressionContext* _expCtx;
     DocumentSource* _source;
     boost::optional<boost::intrusive_ptr<Expression>> _partitionExpr;
-    std::vector<Document> _cache;
+    // Holds the documents of the current partition from offset '_cacheStartIndex' onwards. Earlier
+    // documents have been released as no consumer can reach them.
+    struct CachedDocument {
+        Document doc;
+        size_t sizeBytes;
+    };
+    std::deque<CachedDocument> _cache;
+    int _cacheStartIndex = 0;
     int _currentIndex = 0;
+    boost::optional<int> _lookBehind;
+
+    // Tracks the approximate size of the documents in '_cache'.
+    size_t _memoryUsageBytes = 0;
+    const size_t _maxMemoryBytes;
+
     Value _partitionKey;
 
     // When encountering the first document of the next partition, we stash it away until the
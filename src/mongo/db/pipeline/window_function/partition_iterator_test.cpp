@@ -36,6 +36,7 @@
 #include "mongo/db/pipeline/window_function/partition_iterator.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -207,5 +208,49 @@ TEST_F(PartitionIteratorTest, CurrentOffsetIsCorrectAfterDocumentsAreAccessed) {
     ASSERT_EQ(3, partIter.getCurrentOffset());
 }
 
+TEST_F(PartitionIteratorTest, ReleasesDocumentsBeyondLookBehind) {
+    const auto docs = std::deque<DocumentSource::GetNextResult>{
+        Document{{"a", 1}}, Document{{"b", 1}}, Document{{"c", 1}}, Document{{"d", 1}}};
+    const auto mock = DocumentSourceMock::createForTest(docs, getExpCtx());
+    auto partIter = PartitionIterator(getExpCtx().get(), mock.get(), boost::none);
+    partIter.setLookBehind(-1);
+
+    // Pull in the entire partition.
+    ASSERT_DOCUMENT_EQ(docs[3].getDocument(), *partIter[3]);
+    auto fullPartitionBytes = partIter.getMemoryUsageBytes();
+
+    ASSERT_ADVANCE_RESULT(PartitionIterator::AdvanceResult::kAdvanced, partIter.advance());
+    ASSERT_ADVANCE_RESULT(PartitionIterator::AdvanceResult::kAdvanced, partIter.advance());
+    ASSERT_DOCUMENT_EQ(docs[2].getDocument(), *partIter[0]);
+    ASSERT_DOCUMENT_EQ(docs[1].getDocument(), *partIter[-1]);
+    ASSERT_DOCUMENT_EQ(docs[3].getDocument(), *partIter[1]);
+    ASSERT_LT(partIter.getMemoryUsageBytes(), fullPartitionBytes);
+}
+
+TEST_F(PartitionIteratorTest, FailsWhenWindowExceedsMemoryLimit) {
+    const auto originalLimit = internalDocumentSourceSetWindowFieldsMaxMemoryBytes.load();
+    ON_BLOCK_EXIT([&] {
+        internalDocumentSourceSetWindowFieldsMaxMemoryBytes.store(originalLimit);
+    });
+    const auto docs = std::deque<DocumentSource::GetNextResult>{
+        Document{{"a", 1}}, Document{{"b", 1}}, Document{{"c", 1}}, Document{{"d", 1}}};
+    internalDocumentSourceSetWindowFieldsMaxMemoryBytes.store(
+        2 * docs[0].getDocument().getApproximateSize() + 1);
+
+    const auto mock = DocumentSourceMock::createForTest(docs, getExpCtx());
+    auto partIter = PartitionIterator(getExpCtx().get(), mock.get(), boost::none);
+    partIter.setLookBehind(0);
+    ASSERT_DOCUMENT_EQ(docs[0].getDocument(), *partIter[0]);
+
+    // Two documents fit in memory, so the iterator can walk a larger partition as long as
+    // the documents behind the current one are released...
+    ASSERT_ADVANCE_RESULT(PartitionIterator::AdvanceResult::kAdvanced, partIter.advance());
+    ASSERT_DOCUMENT_EQ(docs[1].getDocument(), *partIter[0]);
+    ASSERT_DOCUMENT_EQ(docs[2].getDocument(), *partIter[1]);
+
+    // ...but a window of three documents does not fit.
+    ASSERT_THROWS_CODE(partIter[2], AssertionException, ErrorCodes::ExceededMemoryLimit);
+}
+
 }  // namespace
 }  // namespace mongo
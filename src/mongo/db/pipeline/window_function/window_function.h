@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <deque>
+
 #include "mongo/db/pipeline/accumulator.h"
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/expression.h"
@@ -53,6 +55,14 @@ public:
 };
 
 
+/**
+ * Computes a sliding $min or $max in amortized constant time per add() and remove(), by keeping a
+ * monotonic deque of the values which may yet become the extremum of the window. A value is
+ * dropped from the back of the deque as soon as a later value supersedes it, since it can never
+ * again be the result before that later value is removed. Because removal happens in FIFO order,
+ * the value being removed is always the oldest one in the window, so it is the front of the deque
+ * if it is still present.
+ */
 template <AccumulatorMinMax::Sense sense>
 class WindowFunctionMinMax : public WindowFunctionState {
 public:
@@ -63,41 +73,66 @@ public:
     /**
      * The comparator must outlive the constructed WindowFunctionMinMax.
      */
-    explicit WindowFunctionMinMax(const ValueComparator& cmp)
-        : _values(cmp.makeOrderedValueMultiset()) {}
+    explicit WindowFunctionMinMax(const ValueComparator& cmp) : _cmp(cmp) {}
 
     void add(Value value) final {
-        _values.insert(std::move(value));
+        // Ties are broken to match a sorted multiset: $min returns the oldest of equal values and
+        // $max returns the newest.
+        while (!_candidates.empty() && supersedes(value, _candidates.back().value)) {
+            _candidates.pop_back();
+        }
+        _candidates.push_back({std::move(value), _numAdded++});
     }
 
     void remove(Value value) final {
-        // std::multiset::insert is guaranteed to put the element after any equal elements
-        // already in the container. So find() / erase() will remove the oldest equal element,
-        // which is what we want, to satisfy "remove() undoes add() when called in FIFO order".
-        auto iter = _values.find(std::move(value));
-        tassert(5371400, "Can't remove from an empty WindowFunctionMinMax", iter != _values.end());
-        _values.erase(iter);
+        tassert(5371400, "Can't remove from an empty WindowFunctionMinMax", _numRemoved < _numAdded);
+        if (!_candidates.empty() && _candidates.front().position == _numRemoved) {
+            dassert(_cmp.evaluate(_candidates.front().value == value));
+            _candidates.pop_front();
+        }
+        ++_numRemoved;
     }
 
     void reset() final {
-        _values.clear();
+        _candidates.clear();
+        _numAdded = 0;
+        _numRemoved = 0;
     }
 
     Value getValue() const final {
-        if (_values.empty())
+        if (_candidates.empty())
             return getDefault();
+        return _candidates.front().value;
+    }
+
+protected:
+    /**
+     * Returns true if 'newer' will be the result over 'older' for as long as both are in the
+     * window.
+     */
+    bool supersedes(const Value& newer, const Value& older) const {
         switch (sense) {
             case AccumulatorMinMax::Sense::kMin:
-                return *_values.begin();
+                return _cmp.evaluate(newer < older);
             case AccumulatorMinMax::Sense::kMax:
-                return *_values.rbegin();
+                return _cmp.evaluate(newer >= older);
         }
         MONGO_UNREACHABLE_TASSERT(5371401);
     }
 
-protected:
-    // Holds all the values in the window, in order, with constant-time access to both ends.
-    ValueMultiset _values;
+    struct Candidate {
+        Value value;
+        // The number of values added before this one since the last reset.
+        long long position;
+    };
+
+    const ValueComparator& _cmp;
+
+    // Holds the values in the window which may become the result, in the order they were added.
+    // The result is always at the front.
+    std::deque<Candidate> _candidates;
+    long long _numAdded = 0;
+    long long _numRemoved = 0;
 };
 using WindowFunctionMin = WindowFunctionMinMax<AccumulatorMinMax::Sense::kMin>;
 using WindowFunctionMax = WindowFunctionMinMax<AccumulatorMinMax::Sense::kMax>;
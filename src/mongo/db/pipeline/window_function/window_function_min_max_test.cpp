@@ -132,5 +132,38 @@ TEST_F(WindowFunctionMinMaxTest, Ties) {
     ASSERT_VALUE_EQ(max.getValue(), y);
 }
 
+TEST_F(WindowFunctionMinMaxTest, SlidingWindowMatchesFullRecomputation) {
+    const size_t kWindowSize = 5;
+    std::vector<int> values;
+    for (int i = 0; i < 100; ++i) {
+        values.push_back((i * 37) % 23);
+    }
+
+    for (size_t i = 0; i < values.size(); ++i) {
+        min.add(Value{values[i]});
+        max.add(Value{values[i]});
+        if (i >= kWindowSize) {
+            min.remove(Value{values[i - kWindowSize]});
+            max.remove(Value{values[i - kWindowSize]});
+        }
+
+        auto windowBegin = values.begin() + (i >= kWindowSize ? i - kWindowSize + 1 : 0);
+        auto windowEnd = values.begin() + i + 1;
+        ASSERT_VALUE_EQ(min.getValue(), Value{*std::min_element(windowBegin, windowEnd)});
+        ASSERT_VALUE_EQ(max.getValue(), Value{*std::max_element(windowBegin, windowEnd)});
+    }
+}
+
+TEST_F(WindowFunctionMinMaxTest, ResetClearsWindow) {
+    max.add(Value{3});
+    max.add(Value{1});
+    max.reset();
+    ASSERT_VALUE_EQ(max.getValue(), Value{BSONNULL});
+
+    max.add(Value{2});
+    max.remove(Value{2});
+    ASSERT_VALUE_EQ(max.getValue(), Value{BSONNULL});
+}
+
 }  // namespace
 }  // namespace mongo
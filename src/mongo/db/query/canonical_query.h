@@ -35,6 +35,7 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/matcher/extensions_callback_noop.h"
+#include "mongo/db/pipeline/expression.h"
 #include "mongo/db/query/collation/collator_interface.h"
 #include "mongo/db/query/projection.h"
 #include "mongo/db/query/projection_policies.h"
@@ -51,6 +52,24 @@ public:
     // sort with the values taken out.
     typedef std::string QueryShapeString;
 
+    /**
+     * A $group stage which consumes the results of this query in an aggregation pipeline, and which
+     * has been pushed down into the query so that it's executed as a part of the query plan.
+     */
+    struct GroupPushdown {
+        struct Accumulator {
+            std::string fieldName;
+
+            // The name of the accumulator operator, such as "$min".
+            std::string op;
+
+            boost::intrusive_ptr<Expression> argument;
+        };
+
+        boost::intrusive_ptr<Expression> idExpression;
+        std::vector<Accumulator> accumulators;
+    };
+
     /**
      * If parsing succeeds, returns a std::unique_ptr<CanonicalQuery> representing the parsed
      * query (which will never be NULL).  If parsing fails, returns an error Status.
@@ -224,6 +243,14 @@ public:
         _explain = explain;
     }
 
+    const boost::optional<GroupPushdown>& getGroupPushdown() const {
+        return _groupPushdown;
+    }
+
+    void setGroupPushdown(boost::optional<GroupPushdown> groupPushdown) {
+        _groupPushdown = std::move(groupPushdown);
+    }
+
     auto& getExpCtx() const {
         return _expCtx;
     }
@@ -264,6 +291,8 @@ private:
     bool _canHaveNoopMatchNodes = false;
 
     bool _explain = false;
+
+    boost::optional<GroupPushdown> _groupPushdown;
 };
 
 }  // namespace mongo
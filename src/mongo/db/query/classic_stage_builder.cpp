@@ -56,14 +56,18 @@
 #include "mongo/db/exec/queued_data_stage.h"
 #include "mongo/db/exec/return_key.h"
 #include "mongo/db/exec/shard_filter.h"
+#include "mongo/db/exec/shard_filterer_impl.h"
 #include "mongo/db/exec/skip.h"
 #include "mongo/db/exec/sort.h"
 #include "mongo/db/exec/sort_key_generator.h"
 #include "mongo/db/exec/text.h"
 #include "mongo/db/index/fts_access_method.h"
 #include "mongo/db/matcher/extensions_callback_real.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/query/shard_filter_bounds.h"
 #include "mongo/db/record_id_helpers.h"
 #include "mongo/db/s/collection_sharding_state.h"
+#include "mongo/db/storage/oplog_namespace_index.h"
 #include "mongo/logv2/log.h"
 
 namespace mongo::stage_builder {
@@ -87,6 +91,13 @@ std::unique_ptr<PlanStage> ClassicStageBuilder::build(const QuerySolutionNode* r
             params.requestResumeToken = csn->requestResumeToken;
             params.resumeAfterRecordId = csn->resumeAfterRecordId;
             params.stopApplyingFilterAfterFirstMatch = csn->stopApplyingFilterAfterFirstMatch;
+            // A tailable scan of the oplog on behalf of a change stream on a single collection may
+            // skip the parts of the oplog which hold no entries for that collection.
+            if (OplogNamespaceIndex::isEnabled() && csn->tailable &&
+                csn->assertTsHasNotFallenOffOplog && expCtx->isSingleNamespaceAggregation() &&
+                !expCtx->ns.isOplog()) {
+                params.relevantOplogNamespace = expCtx->ns;
+            }
             return std::make_unique<CollectionScan>(
                 expCtx, _collection, params, _ws, csn->filter.get());
         }
@@ -244,6 +255,7 @@ std::unique_ptr<PlanStage> ClassicStageBuilder::build(const QuerySolutionNode* r
             params.filter = node->filter.get();
             params.addPointMeta = node->addPointMeta;
             params.addDistMeta = node->addDistMeta;
+            params.limit = node->limit;
 
             invariant(_collection);
             const IndexDescriptor* twoDIndex = _collection->getIndexCatalog()->findIndexByName(
@@ -261,6 +273,7 @@ std::unique_ptr<PlanStage> ClassicStageBuilder::build(const QuerySolutionNode* r
             params.filter = node->filter.get();
             params.addPointMeta = node->addPointMeta;
             params.addDistMeta = node->addDistMeta;
+            params.limit = node->limit;
 
             invariant(_collection);
             const IndexDescriptor* s2Index = _collection->getIndexCatalog()->findIndexByName(
@@ -288,6 +301,7 @@ std::unique_ptr<PlanStage> ClassicStageBuilder::build(const QuerySolutionNode* r
             // created by planning a query that contains "no-op" expressions.
             params.query = static_cast<FTSQueryImpl&>(*node->ftsQuery);
             params.wantTextScore = _cq.metadataDeps()[DocumentMetadataFields::kTextScore];
+            params.topK = node->topK;
             return std::make_unique<TextStage>(
                 expCtx, _collection, params, _ws, node->filter.get());
         }
@@ -296,12 +310,17 @@ std::unique_ptr<PlanStage> ClassicStageBuilder::build(const QuerySolutionNode* r
             auto childStage = build(fn->children[0]);
 
             auto css = CollectionShardingState::get(_opCtx, _collection->ns());
+            auto collectionFilter = css->getOwnershipFilter(
+                _opCtx, CollectionShardingState::OrphanCleanupPolicy::kDisallowOrphanCleanup);
+
+            // There is nothing to filter out if the index bounds only cover owned chunks.
+            if (internalQueryElideShardFilterForOwnedIndexBounds.load() &&
+                indexBoundsBelongToShard(fn->children[0], ShardFiltererImpl{collectionFilter})) {
+                return childStage;
+            }
+
             return std::make_unique<ShardFilterStage>(
-                expCtx,
-                css->getOwnershipFilter(
-                    _opCtx, CollectionShardingState::OrphanCleanupPolicy::kDisallowOrphanCleanup),
-                _ws,
-                std::move(childStage));
+                expCtx, std::move(collectionFilter), _ws, std::move(childStage));
         }
         case STAGE_DISTINCT_SCAN: {
             const DistinctNode* dn = static_cast<const DistinctNode*>(root);
@@ -384,7 +403,9 @@ std::unique_ptr<PlanStage> ClassicStageBuilder::build(const QuerySolutionNode* r
         }
         case STAGE_CACHED_PLAN:
         case STAGE_COUNT:
+        case STAGE_CURSOR_SPOOL:
         case STAGE_DELETE:
+        case STAGE_GROUP:
         case STAGE_IDHACK:
         case STAGE_MOCK:
         case STAGE_MULTI_ITERATOR:
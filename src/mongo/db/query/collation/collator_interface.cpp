@@ -41,7 +41,7 @@ void CollatorInterface::hash_combine(size_t& seed, StringData stringToHash) cons
 }
 
 std::string CollatorInterface::getComparisonString(StringData stringData) const {
-    return getComparisonKey(stringData).getKeyData().toString();
+    return std::move(getComparisonKey(stringData)._key);
 }
 
 }  // namespace mongo
@@ -34,7 +34,6 @@
 #include <memory>
 
 #include <unicode/coll.h>
-#include <unicode/sortkey.h>
 
 #include "mongo/util/assert_util.h"
 
@@ -76,26 +75,32 @@ CollatorInterface::ComparisonKey CollatorInterfaceICU::getComparisonKey(
     StringData stringData) const {
     // A StringPiece is ICU's StringData. They are logically the same abstraction.
     const icu::StringPiece stringPiece(stringData.rawData(), stringData.size());
+    const auto unicodeString = icu::UnicodeString::fromUTF8(stringPiece);
 
-    UErrorCode status = U_ZERO_ERROR;
-    icu::CollationKey icuKey;
-    _collator->getCollationKey(icu::UnicodeString::fromUTF8(stringPiece), icuKey, status);
+    // Most sort keys fit in this buffer, which saves building an icu::CollationKey on the heap and
+    // copying the key out of it. Longer keys are written straight into the returned string.
+    uint8_t keyBuffer[kSortKeyBufferSize];
+    const int32_t keyLength = _collator->getSortKey(unicodeString, keyBuffer, kSortKeyBufferSize);
 
     // Any sequence of bytes, even invalid UTF-8, has defined comparison behavior in ICU (invalid
-    // subsequences are weighted as the replacement character, U+FFFD). A non-ok error code is only
+    // subsequences are weighted as the replacement character, U+FFFD). A zero length is only
     // expected when a memory allocation fails inside ICU, which we consider fatal to the process.
-    fassert(34439, U_SUCCESS(status));
-
-    int32_t keyLength;
-    const uint8_t* keyBuffer = icuKey.getByteArray(keyLength);
-    invariant(keyLength > 0);
-    invariant(keyBuffer);
+    fassert(34439, keyLength > 0);
 
     // The last byte of the sort key should always be null. When we construct the comparison key, we
     // omit the trailing null byte.
-    invariant(keyBuffer[keyLength - 1u] == '\0');
-    const char* charBuffer = reinterpret_cast<const char*>(keyBuffer);
-    return makeComparisonKey(std::string(charBuffer, keyLength - 1u));
+    if (keyLength <= kSortKeyBufferSize) {
+        invariant(keyBuffer[keyLength - 1u] == '\0');
+        const char* charBuffer = reinterpret_cast<const char*>(keyBuffer);
+        return makeComparisonKey(std::string(charBuffer, keyLength - 1u));
+    }
+
+    std::string key(keyLength, '\0');
+    invariant(_collator->getSortKey(
+                  unicodeString, reinterpret_cast<uint8_t*>(&key[0]), keyLength) == keyLength);
+    invariant(key.back() == '\0');
+    key.pop_back();
+    return makeComparisonKey(std::move(key));
 }
 
 }  // namespace mongo
@@ -54,6 +54,9 @@ public:
     ComparisonKey getComparisonKey(StringData stringData) const final;
 
 private:
+    // The size of the buffer on the stack which sort keys are first generated into.
+    static constexpr int32_t kSortKeyBufferSize = 256;
+
     // The ICU implementation of the collator to which we delegate interesting work. Const methods
     // on the ICU collator are expected to be thread-safe.
     const std::unique_ptr<icu::Collator> _collator;
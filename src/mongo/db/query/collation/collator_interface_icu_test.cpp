@@ -175,6 +175,16 @@ TEST(CollatorInterfaceICUTest, ASCIIComparisonWorksUsingComparisonKeys) {
     ASSERT_LT(comparisonKeyABB.getKeyData().compare(comparisonKeyBA.getKeyData()), 0);
 }
 
+TEST(CollatorInterfaceICUTest, LongStringsCompareCorrectlyUsingComparisonKeys) {
+    // The comparison keys of these strings are longer than the buffer they are first generated in.
+    const std::string longAB = std::string(1000, 'x') + "ab";
+    const std::string longABB = std::string(1000, 'x') + "abb";
+    const std::string longUpperAB = std::string(1000, 'X') + "AB";
+    assertLessThanEnUS(longAB, longABB);
+    assertLessThanEnUS(longAB, longUpperAB);
+    assertEqualEnUS(longAB, longAB);
+}
+
 TEST(CollatorInterfaceICUTest, ZeroLengthStringsCompareCorrectly) {
     Collation collationSpec;
     collationSpec.setLocale("en_US");
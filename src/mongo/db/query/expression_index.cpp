@@ -30,6 +30,8 @@
 #include "mongo/db/query/expression_index.h"
 
 #include <iostream>
+#include <iterator>
+#include <limits>
 #include <unordered_set>
 
 #include "mongo/db/geo/geoconstants.h"
@@ -37,6 +39,9 @@
 #include "mongo/db/hasher.h"
 #include "mongo/db/index/expression_params.h"
 #include "mongo/db/query/expression_index_knobs_gen.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/concurrency/with_lock.h"
+#include "mongo/util/lru_cache.h"
 #include "third_party/s2/s2cellid.h"
 #include "third_party/s2/s2region.h"
 #include "third_party/s2/s2regioncoverer.h"
@@ -45,9 +50,10 @@ namespace mongo {
 
 using std::set;
 
-BSONObj ExpressionMapping::hash(const BSONElement& value) {
+BSONObj ExpressionMapping::hash(const BSONElement& value, int hashVersion) {
     BSONObjBuilder bob;
-    bob.append("", BSONElementHasher::hash64(value, BSONElementHasher::DEFAULT_HASH_SEED));
+    bob.append("",
+               BSONElementHasher::hash64(value, BSONElementHasher::DEFAULT_HASH_SEED, hashVersion));
     return bob.obj();
 }
 
@@ -107,7 +113,14 @@ void ExpressionMapping::cover2d(const R2Region& region,
     GeoHashsToIntervalsWithParents(unorderedCovering, oilOut);
 }
 
-std::vector<S2CellId> ExpressionMapping::get2dsphereCovering(const S2Region& region) {
+namespace {
+struct S2CovererParams {
+    int minLevel;
+    int maxLevel;
+    int maxCells;
+};
+
+S2CovererParams getS2CovererParams() {
     auto minLevel = gInternalQueryS2GeoCoarsestLevel.load();
     auto maxLevel = gInternalQueryS2GeoFinestLevel.load();
 
@@ -115,16 +128,92 @@ std::vector<S2CellId> ExpressionMapping::get2dsphereCovering(const S2Region& reg
     uassert(28740, "Geo finest level must be in range [0,30]", 0 <= maxLevel && maxLevel <= 30);
     uassert(28741, "Geo coarsest level must be less than or equal to finest", minLevel <= maxLevel);
 
+    return {minLevel, maxLevel, gInternalQueryS2GeoMaxCells.load()};
+}
+
+std::vector<S2CellId> computeS2Covering(const S2Region& region, const S2CovererParams& params) {
     S2RegionCoverer coverer;
-    coverer.set_min_level(minLevel);
-    coverer.set_max_level(maxLevel);
-    coverer.set_max_cells(gInternalQueryS2GeoMaxCells.load());
+    coverer.set_min_level(params.minLevel);
+    coverer.set_max_level(params.maxLevel);
+    coverer.set_max_cells(params.maxCells);
 
     std::vector<S2CellId> cover;
     coverer.GetCovering(region, &cover);
     return cover;
 }
 
+/**
+ * A least recently used cache of 2dsphere query coverings, keyed by the query geometry and the
+ * coverer parameters. Its size is bounded by 'internalQueryS2GeoCoveringCacheSize', which may
+ * change at runtime, so the cache itself is created unbounded and trimmed on every insertion.
+ */
+class S2CoveringCache {
+public:
+    boost::optional<std::vector<S2CellId>> find(const std::string& key) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        auto it = _cache.find(key);
+        if (it == _cache.end()) {
+            return boost::none;
+        }
+        return it->second;
+    }
+
+    void add(std::string key, std::vector<S2CellId> covering, size_t maxEntries) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _cache.add(std::move(key), std::move(covering));
+        _trim(lk, maxEntries);
+    }
+
+    void trim(size_t maxEntries) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _trim(lk, maxEntries);
+    }
+
+private:
+    void _trim(WithLock, size_t maxEntries) {
+        while (_cache.size() > maxEntries) {
+            _cache.erase(std::prev(_cache.end()));
+        }
+    }
+
+    Mutex _mutex = MONGO_MAKE_LATCH("S2CoveringCache::_mutex");
+    LRUCache<std::string, std::vector<S2CellId>> _cache{std::numeric_limits<size_t>::max()};
+};
+
+S2CoveringCache s2CoveringCache;
+}  // namespace
+
+std::vector<S2CellId> ExpressionMapping::get2dsphereCovering(const S2Region& region) {
+    return computeS2Covering(region, getS2CovererParams());
+}
+
+std::vector<S2CellId> ExpressionMapping::get2dsphereCovering(const S2Region& region,
+                                                             const BSONObj& regionSpec) {
+    auto params = getS2CovererParams();
+    auto maxEntries = gInternalQueryS2GeoCoveringCacheSize.load();
+    if (regionSpec.isEmpty() || maxEntries <= 0) {
+        // Drop whatever was cached before the cache was disabled.
+        s2CoveringCache.trim(0);
+        return computeS2Covering(region, params);
+    }
+
+    BSONObjBuilder keyBuilder;
+    keyBuilder.append("spec", regionSpec);
+    keyBuilder.append("minLevel", params.minLevel);
+    keyBuilder.append("maxLevel", params.maxLevel);
+    keyBuilder.append("maxCells", params.maxCells);
+    BSONObj keyObj = keyBuilder.done();
+    std::string key(keyObj.objdata(), keyObj.objsize());
+
+    if (auto cached = s2CoveringCache.find(key)) {
+        return std::move(*cached);
+    }
+
+    auto cover = computeS2Covering(region, params);
+    s2CoveringCache.add(std::move(key), cover, static_cast<size_t>(maxEntries));
+    return cover;
+}
+
 void ExpressionMapping::cover2dsphere(const S2Region& region,
                                       const S2IndexingParams& indexingParams,
                                       OrderedIntervalList* oilOut) {
@@ -132,6 +221,14 @@ void ExpressionMapping::cover2dsphere(const S2Region& region,
     S2CellIdsToIntervalsWithParents(cover, indexingParams, oilOut);
 }
 
+void ExpressionMapping::cover2dsphere(const S2Region& region,
+                                      const BSONObj& regionSpec,
+                                      const S2IndexingParams& indexingParams,
+                                      OrderedIntervalList* oilOut) {
+    std::vector<S2CellId> cover = get2dsphereCovering(region, regionSpec);
+    S2CellIdsToIntervalsWithParents(cover, indexingParams, oilOut);
+}
+
 namespace {
 bool compareIntervals(const Interval& a, const Interval& b) {
     return a.precedes(b);
@@ -33,6 +33,7 @@
 
 #include "mongo/db/geo/hash.h"
 #include "mongo/db/geo/shapes.h"
+#include "mongo/db/hasher.h"
 #include "mongo/db/index/s2_common.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/query/index_bounds_builder.h"  // For OrderedIntervalList
@@ -49,7 +50,8 @@ namespace mongo {
  */
 class ExpressionMapping {
 public:
-    static BSONObj hash(const BSONElement& value);
+    static BSONObj hash(const BSONElement& value,
+                        int hashVersion = BSONElementHasher::kDefaultHashVersion);
 
     static std::vector<GeoHash> get2dCovering(const R2Region& region,
                                               const BSONObj& indexInfoObj,
@@ -65,6 +67,14 @@ public:
 
     static std::vector<S2CellId> get2dsphereCovering(const S2Region& region);
 
+    /**
+     * Like get2dsphereCovering(region), but looks the covering up in a bounded process-wide cache
+     * under 'regionSpec', the user's specification from which 'region' was parsed, and adds it to
+     * the cache on a miss. The cache is bypassed if 'regionSpec' is empty.
+     */
+    static std::vector<S2CellId> get2dsphereCovering(const S2Region& region,
+                                                     const BSONObj& regionSpec);
+
     static void S2CellIdsToIntervals(const std::vector<S2CellId>& intervalSet,
                                      const S2IndexVersion indexVersion,
                                      OrderedIntervalList* oilOut);
@@ -78,6 +88,15 @@ public:
     static void cover2dsphere(const S2Region& region,
                               const S2IndexingParams& indexParams,
                               OrderedIntervalList* oilOut);
+
+    /**
+     * Like cover2dsphere() above, but uses the cached covering of 'regionSpec'. See
+     * get2dsphereCovering(region, regionSpec).
+     */
+    static void cover2dsphere(const S2Region& region,
+                              const BSONObj& regionSpec,
+                              const S2IndexingParams& indexParams,
+                              OrderedIntervalList* oilOut);
 };
 
 }  // namespace mongo
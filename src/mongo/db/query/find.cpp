@@ -142,7 +142,7 @@ void endQueryOp(OperationContext* opCtx,
         CollectionQueryInfo::get(collection).notifyOfQuery(opCtx, collection, summaryStats);
     }
 
-    if (curOp->shouldDBProfile(opCtx)) {
+    if (curOp->shouldCaptureExecStats(opCtx)) {
         auto&& [stats, _] = explainer.getWinningPlanStats(ExplainOptions::Verbosity::kExecStats);
         curOp->debug().execStats = std::move(stats);
     }
@@ -500,7 +500,7 @@ Message getMore(OperationContext* opCtx,
     // need 'execStats' and we do not want to generate the stats eagerly for all operations due to
     // cost.
     if (cursorPin->getExecutor()->lockPolicy() != PlanExecutor::LockPolicy::kLocksInternally &&
-        curOp.shouldDBProfile(opCtx)) {
+        curOp.shouldCaptureExecStats(opCtx)) {
         auto&& [stats, _] = explainer.getWinningPlanStats(ExplainOptions::Verbosity::kExecStats);
 
         curOp.debug().execStats = std::move(stats);
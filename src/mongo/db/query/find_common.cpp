@@ -69,7 +69,23 @@ bool FindCommon::enoughForFirstBatch(const FindCommand& findCommand, long long n
     return numDocs >= effectiveBatchSize.value();
 }
 
-bool FindCommon::haveSpaceForNext(const BSONObj& nextDoc, long long numDocs, int bytesBuffered) {
+std::size_t FindCommon::estimateFirstBatchBytes(const FindCommand& findCommand, int avgObjSize) {
+    long long numDocs = findCommand.getBatchSize().value_or(
+        findCommand.getNtoreturn().value_or(query_request_helper::kDefaultBatchSize));
+    if (auto limit = findCommand.getLimit()) {
+        numDocs = std::min<long long>(numDocs, *limit);
+    }
+
+    // The extra 1K leaves room for the rest of the reply, as for getMore.
+    const long long maxBytes = kMaxBytesToReturnToClientAtOnce + 1024;
+    numDocs = std::min(numDocs, maxBytes);
+    return std::min(numDocs * std::max(avgObjSize, 0), maxBytes);
+}
+
+bool FindCommon::haveSpaceForNext(const BSONObj& nextDoc,
+                                  long long numDocs,
+                                  int bytesBuffered,
+                                  int maxBytes) {
     invariant(numDocs >= 0);
     if (!numDocs) {
         // Allow the first output document to exceed the limit to ensure we can always make
@@ -77,7 +93,7 @@ bool FindCommon::haveSpaceForNext(const BSONObj& nextDoc, long long numDocs, int
         return true;
     }
 
-    return (bytesBuffered + nextDoc.objsize()) <= kMaxBytesToReturnToClientAtOnce;
+    return (bytesBuffered + nextDoc.objsize()) <= maxBytes;
 }
 
 void FindCommon::waitInFindBeforeMakingBatch(OperationContext* opCtx, const CanonicalQuery& cq) {
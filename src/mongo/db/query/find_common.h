@@ -103,6 +103,13 @@ public:
      */
     static bool enoughForFirstBatch(const FindCommand& findCommand, long long numDocs);
 
+    /**
+     * Returns the number of bytes that the first batch for 'findCommand' is expected to take up if
+     * its documents are 'avgObjSize' bytes each, capped at the most that a batch may hold. This is
+     * used to size the reply buffer up front so that a large batch is not copied as it grows.
+     */
+    static std::size_t estimateFirstBatchBytes(const FindCommand& findCommand, int avgObjSize);
+
     /**
      * Returns true if the batchSize for the getMore has been satisfied.
      *
@@ -116,9 +123,12 @@ public:
     /**
      * Given the number of docs ('numDocs') and bytes ('bytesBuffered') currently buffered as a
      * response to a cursor-generating command, returns true if there are enough remaining bytes in
-     * our budget to fit 'nextDoc'.
+     * our budget of 'maxBytes' to fit 'nextDoc'.
      */
-    static bool haveSpaceForNext(const BSONObj& nextDoc, long long numDocs, int bytesBuffered);
+    static bool haveSpaceForNext(const BSONObj& nextDoc,
+                                 long long numDocs,
+                                 int bytesBuffered,
+                                 int maxBytes = kMaxBytesToReturnToClientAtOnce);
 
     /**
      * This function wraps waitWhileFailPointEnabled() on waitInFindBeforeMakingBatch.
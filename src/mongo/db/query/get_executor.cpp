@@ -40,8 +40,10 @@
 #include "mongo/base/error_codes.h"
 #include "mongo/base/parse_number.h"
 #include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/exec/cached_plan.h"
 #include "mongo/db/exec/collection_scan.h"
+#include "mongo/db/exec/column_scan.h"
 #include "mongo/db/exec/count.h"
 #include "mongo/db/exec/delete.h"
 #include "mongo/db/exec/eof.h"
@@ -58,6 +60,7 @@
 #include "mongo/db/exec/subplan.h"
 #include "mongo/db/exec/update_stage.h"
 #include "mongo/db/exec/upsert_stage.h"
+#include "mongo/db/index/column_store_access_method.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/index/wildcard_access_method.h"
 #include "mongo/db/index_names.h"
@@ -72,6 +75,7 @@
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/plan_executor_factory.h"
+#include "mongo/db/query/plan_ranker.h"
 #include "mongo/db/query/planner_access.h"
 #include "mongo/db/query/planner_analysis.h"
 #include "mongo/db/query/planner_ixselect.h"
@@ -154,6 +158,83 @@ bool isIdHackEligibleQuery(const CollectionPtr& collection, const CanonicalQuery
         !findCommand.getTailable() &&
         CollatorInterface::collatorsMatch(query.getCollator(), collection->getDefaultCollator());
 }
+
+/**
+ * Returns the columnstore index from which the documents of 'query' can be reconstructed, and
+ * fills 'columns' with the top-level fields the query needs, or returns nullptr if there is no
+ * such index. The query must project its results, may not need whole documents or metadata, and
+ * may not sort, skip or limit them. Since a column scan reads every document of the collection, it
+ * is only used when none of the indexes in 'plannerParams' could serve the filter.
+ */
+const IndexDescriptor* getColumnScanIndex(OperationContext* opCtx,
+                                          const CollectionPtr& collection,
+                                          const CanonicalQuery& query,
+                                          const QueryPlannerParams& plannerParams,
+                                          std::vector<std::string>* columns) {
+    const auto& findCommand = query.getFindCommand();
+    const auto* proj = query.getProj();
+    if (!internalQueryEnableColumnScan.load() || !proj ||
+        proj->type() != projection_ast::ProjectType::kInclusion || proj->requiresDocument() ||
+        proj->requiresMatchDetails() || proj->metadataDeps().any() ||
+        query.metadataDeps().any() || !findCommand.getSort().isEmpty() ||
+        findCommand.getLimit() || findCommand.getSkip() || findCommand.getNtoreturn() ||
+        !findCommand.getHint().isEmpty() || !findCommand.getMin().isEmpty() ||
+        !findCommand.getMax().isEmpty() || findCommand.getShowRecordId() ||
+        findCommand.getReturnKey() || findCommand.getTailable() ||
+        (plannerParams.options &
+         (QueryPlannerParams::INCLUDE_SHARD_FILTER | QueryPlannerParams::IS_COUNT))) {
+        return nullptr;
+    }
+
+    // The filter is applied to the reconstructed documents, so it must only depend on the fields
+    // it names.
+    const auto* root = query.root();
+    if (QueryPlannerCommon::hasNode(root, MatchExpression::WHERE) ||
+        QueryPlannerCommon::hasNode(root, MatchExpression::TEXT) ||
+        QueryPlannerCommon::hasNode(root, MatchExpression::GEO_NEAR)) {
+        return nullptr;
+    }
+    DepsTracker filterDeps;
+    root->addDependencies(&filterDeps);
+    if (filterDeps.needWholeDocument) {
+        return nullptr;
+    }
+
+    for (auto&& index : plannerParams.indices) {
+        if (index.type == INDEX_WILDCARD ? !filterDeps.fields.empty()
+                                         : filterDeps.fields.count(
+                                               index.keyPattern.firstElementFieldName())) {
+            return nullptr;
+        }
+    }
+
+    std::set<std::string> neededColumns;
+    for (auto&& field : proj->getRequiredFields()) {
+        neededColumns.insert(FieldRef(field).getPart(0).toString());
+    }
+    for (auto&& field : filterDeps.fields) {
+        neededColumns.insert(FieldRef(field).getPart(0).toString());
+    }
+
+    std::unique_ptr<IndexCatalog::IndexIterator> ii =
+        collection->getIndexCatalog()->getIndexIterator(opCtx, false);
+    while (ii->more()) {
+        const IndexCatalogEntry* ice = ii->next();
+        if (ice->descriptor()->getIndexType() != INDEX_COLUMN || ice->descriptor()->hidden()) {
+            continue;
+        }
+        const auto& indexColumns =
+            static_cast<const ColumnStoreAccessMethod*>(ice->accessMethod())->getColumns();
+        if (std::all_of(neededColumns.begin(), neededColumns.end(), [&](const auto& column) {
+                return std::find(indexColumns.begin(), indexColumns.end(), column) !=
+                    indexColumns.end();
+            })) {
+            columns->assign(neededColumns.begin(), neededColumns.end());
+            return ice->descriptor();
+        }
+    }
+    return nullptr;
+}
 }  // namespace
 
 bool isAnyComponentOfPathMultikey(const BSONObj& indexKeyPattern,
@@ -290,6 +371,11 @@ void fillOutPlannerParams(OperationContext* opCtx,
         // Skip the addition of hidden indexes to prevent use in query planning.
         if (ice->descriptor()->hidden())
             continue;
+
+        // Columnstore indexes are not planned like other indexes: they are only used by column
+        // scans, which are chosen ahead of planning.
+        if (indexType == IndexType::INDEX_COLUMN)
+            continue;
         plannerParams->indices.push_back(
             indexEntryFromIndexCatalogEntry(opCtx, *ice, canonicalQuery));
     }
@@ -350,6 +436,10 @@ void fillOutPlannerParams(OperationContext* opCtx,
 
     plannerParams->options |= QueryPlannerParams::SPLIT_LIMITED_SORT;
 
+    if (collection->isClustered()) {
+        plannerParams->options |= QueryPlannerParams::IS_CLUSTERED;
+    }
+
     if (shouldWaitForOplogVisibility(
             opCtx, collection, canonicalQuery->getFindCommand().getTailable())) {
         plannerParams->options |= QueryPlannerParams::OPLOG_SCAN_WAIT_FOR_VISIBLE;
@@ -597,6 +687,20 @@ public:
             }
         }
 
+        // If the query only needs fields stored by a columnstore index, it can reconstruct its
+        // documents from the index columns.
+        std::vector<std::string> columns;
+        if (auto columnIndexDesc =
+                getColumnScanIndex(_opCtx, _collection, *_cq, plannerParams, &columns)) {
+            if (auto result = buildColumnScanPlan(columnIndexDesc, std::move(columns))) {
+                LOGV2_DEBUG(5502111,
+                            2,
+                            "Using column scan",
+                            "canonicalQuery"_attr = redact(_cq->toStringShort()));
+                return std::move(result);
+            }
+        }
+
         // Tailable: If the query requests tailable the collection must be capped.
         if (_cq->getFindCommand().getTailable() && !_collection->isCapped()) {
             return Status(ErrorCodes::BadValue,
@@ -631,8 +735,7 @@ public:
                                     "query"_attr = redact(_cq->toStringShort()));
                     }
 
-                    return buildCachedPlan(
-                        std::move(querySolution), plannerParams, cs->decisionWorks);
+                    return buildCachedPlan(std::move(querySolution), plannerParams, *cs);
                 }
             }
         }
@@ -690,6 +793,23 @@ public:
             return std::move(result);
         }
 
+        if (internalQueryPlannerEnableCostBasedPlanSelection.load() &&
+            !internalQueryForceIntersectionPlans.load()) {
+            if (auto bestIdx = plan_ranker::pickBestPlanByCost(solutions)) {
+                auto result = makeResult();
+                auto root = buildExecutableTree(*solutions[*bestIdx]);
+                result->emplace(std::move(root), std::move(solutions[*bestIdx]));
+
+                LOGV2_DEBUG(5591201,
+                            2,
+                            "Plan picked by cost estimate; it will be run but will not be cached",
+                            "query"_attr = redact(_cq->toStringShort()),
+                            "planSummary"_attr = result->getPlanSummary());
+
+                return std::move(result);
+            }
+        }
+
         return buildMultiPlan(std::move(solutions), plannerParams);
     }
 
@@ -715,6 +835,14 @@ protected:
     virtual std::unique_ptr<ResultType> buildIdHackPlan(const IndexDescriptor* descriptor,
                                                         QueryPlannerParams* plannerParams) = 0;
 
+    /**
+     * If supported, constructs a PlanStage tree which reconstructs the documents of the query from
+     * the 'columns' of the columnstore index 'descriptor'. Otherwise, nullptr should be returned
+     * and this helper will fall back to the normal plan generation.
+     */
+    virtual std::unique_ptr<ResultType> buildColumnScanPlan(const IndexDescriptor* descriptor,
+                                                            std::vector<std::string> columns) = 0;
+
     /**
      * Constructs a PlanStage tree from a cached plan and also:
      *     * Either modifies the constructed tree to run a trial period in order to evaluate the
@@ -725,7 +853,7 @@ protected:
      */
     virtual std::unique_ptr<ResultType> buildCachedPlan(std::unique_ptr<QuerySolution> solution,
                                                         const QueryPlannerParams& plannerParams,
-                                                        size_t decisionWorks) = 0;
+                                                        const CachedSolution& cachedSolution) = 0;
 
     /**
      * Constructs a special PlanStage tree for rooted $or queries. Each clause of the $or is planned
@@ -818,32 +946,26 @@ protected:
             // There might be a projection. The idhack stage will always fetch the full
             // document, so we don't support covered projections. However, we might use the
             // simple inclusion fast path.
-            // Stuff the right data into the params depending on what proj impl we use.
-            if (!cqProjection->isSimple()) {
-                stage =
-                    std::make_unique<ProjectionStageDefault>(_cq->getExpCtxRaw(),
-                                                             _cq->getFindCommand().getProjection(),
-                                                             _cq->getProj(),
-                                                             _ws,
-                                                             std::move(stage));
-            } else {
-                stage =
-                    std::make_unique<ProjectionStageSimple>(_cq->getExpCtxRaw(),
-                                                            _cq->getFindCommand().getProjection(),
-                                                            _cq->getProj(),
-                                                            _ws,
-                                                            std::move(stage));
-            }
+            stage = buildProjectionStage(std::move(stage));
         }
 
         result->emplace(std::move(stage), nullptr);
         return result;
     }
 
+    std::unique_ptr<ClassicPrepareExecutionResult> buildColumnScanPlan(
+        const IndexDescriptor* descriptor, std::vector<std::string> columns) final {
+        auto result = makeResult();
+        std::unique_ptr<PlanStage> stage = std::make_unique<ColumnScanStage>(
+            _cq->getExpCtxRaw(), _ws, _collection, descriptor, std::move(columns), _cq->root());
+        result->emplace(buildProjectionStage(std::move(stage)), nullptr);
+        return result;
+    }
+
     std::unique_ptr<ClassicPrepareExecutionResult> buildCachedPlan(
         std::unique_ptr<QuerySolution> solution,
         const QueryPlannerParams& plannerParams,
-        size_t decisionWorks) final {
+        const CachedSolution& cachedSolution) final {
         auto result = makeResult();
         auto&& root = buildExecutableTree(*solution);
 
@@ -856,7 +978,7 @@ protected:
                                                           _ws,
                                                           _cq,
                                                           plannerParams,
-                                                          decisionWorks,
+                                                          cachedSolution.decisionWorks,
                                                           std::move(root)),
                         std::move(solution));
         return result;
@@ -896,9 +1018,57 @@ protected:
     }
 
 private:
+    /**
+     * Applies the projection of the query to the documents returned by 'stage', using the simple
+     * inclusion fast path when possible. Stuff the right data into the params depending on what
+     * proj impl we use.
+     */
+    std::unique_ptr<PlanStage> buildProjectionStage(std::unique_ptr<PlanStage> stage) const {
+        if (!_cq->getProj()->isSimple()) {
+            return std::make_unique<ProjectionStageDefault>(_cq->getExpCtxRaw(),
+                                                            _cq->getFindCommand().getProjection(),
+                                                            _cq->getProj(),
+                                                            _ws,
+                                                            std::move(stage));
+        }
+        return std::make_unique<ProjectionStageSimple>(_cq->getExpCtxRaw(),
+                                                       _cq->getFindCommand().getProjection(),
+                                                       _cq->getProj(),
+                                                       _ws,
+                                                       std::move(stage));
+    }
+
     WorkingSet* _ws;
 };
 
+/**
+ * The number of SBE plan stage trees which were cloned from a plan cache entry rather than built.
+ */
+Counter64 sbeCachedExecutionTreeHits;
+ServerStatusMetricField<Counter64> sbeCachedExecutionTreeHitsMetric(
+    "query.planCache.sbeExecutionTreeHits", &sbeCachedExecutionTreeHits);
+
+/**
+ * An SBE plan stage tree kept with the plan cache entry it was built for. The constants of the
+ * query are compiled into the tree, so it can only be reused by queries whose parameters and
+ * planner options are identical to those of the query it was built for.
+ */
+struct CachedSbeExecutionTree final : public CachedExecutionTree {
+    CachedSbeExecutionTree(BSONObj parameters,
+                           size_t plannerOptions,
+                           std::unique_ptr<sbe::PlanStage> root,
+                           stage_builder::PlanStageData data)
+        : parameters(std::move(parameters)),
+          plannerOptions(plannerOptions),
+          root(std::move(root)),
+          data(std::move(data)) {}
+
+    const BSONObj parameters;
+    const size_t plannerOptions;
+    const std::unique_ptr<const sbe::PlanStage> root;
+    const stage_builder::PlanStageData data;
+};
+
 /**
  * A helper class to prepare an SBE PlanStage tree for execution.
  */
@@ -922,17 +1092,62 @@ protected:
         return nullptr;
     }
 
+    std::unique_ptr<SlotBasedPrepareExecutionResult> buildColumnScanPlan(
+        const IndexDescriptor* descriptor, std::vector<std::string> columns) final {
+        // Fall back to normal planning.
+        return nullptr;
+    }
+
     std::unique_ptr<SlotBasedPrepareExecutionResult> buildCachedPlan(
         std::unique_ptr<QuerySolution> solution,
         const QueryPlannerParams& plannerParams,
-        size_t decisionWorks) final {
+        const CachedSolution& cachedSolution) final {
         auto result = makeResult();
-        auto execTree = buildExecutableTree(*solution);
+        auto execTree = buildCachedExecutableTree(*solution, plannerParams, cachedSolution);
         result->emplace(std::move(execTree), std::move(solution));
-        result->setDecisionWorks(decisionWorks);
+        result->setDecisionWorks(cachedSolution.decisionWorks);
         return result;
     }
 
+    /**
+     * Clones the execution tree kept with the plan cache entry if it was built for identical
+     * parameters. Otherwise builds a new tree, and keeps a copy of it with the entry if the entry
+     * has none yet.
+     */
+    std::pair<std::unique_ptr<sbe::PlanStage>, stage_builder::PlanStageData>
+    buildCachedExecutableTree(const QuerySolution& solution,
+                              const QueryPlannerParams& plannerParams,
+                              const CachedSolution& cachedSolution) const {
+        // Shard filters hold the routing information of the query they were built for, so trees
+        // containing one are never shared.
+        if (!internalQuerySlotBasedExecutionCacheExecutionTrees.load() ||
+            (plannerParams.options & QueryPlannerParams::INCLUDE_SHARD_FILTER)) {
+            return buildExecutableTree(solution);
+        }
+
+        auto parameters = _cq->getFindCommand().toBSON(BSONObj());
+        auto cachedTree = cachedSolution.executionTree->get();
+        if (cachedTree) {
+            auto sbeTree = std::dynamic_pointer_cast<const CachedSbeExecutionTree>(cachedTree);
+            if (sbeTree && sbeTree->plannerOptions == plannerParams.options &&
+                sbeTree->parameters.binaryEqual(parameters)) {
+                sbeCachedExecutionTreeHits.increment();
+                return stage_builder::cloneSlotBasedExecutableTree(
+                    _opCtx, *_cq, *sbeTree->root, sbeTree->data, _yieldPolicy);
+            }
+        }
+
+        auto execTree = buildExecutableTree(solution);
+        if (!cachedTree) {
+            cachedSolution.executionTree->set(
+                std::make_shared<CachedSbeExecutionTree>(parameters.getOwned(),
+                                                         plannerParams.options,
+                                                         execTree.first->clone(),
+                                                         execTree.second.makeCopy()));
+        }
+        return execTree;
+    }
+
     std::unique_ptr<SlotBasedPrepareExecutionResult> buildSubPlan(
         const QueryPlannerParams& plannerParams) final {
         // Nothing do be done here, all planning and stage building will be done by a SubPlanner.
@@ -1075,6 +1290,8 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getSlotBasedExe
     auto&& roots = result->roots();
     auto&& solutions = result->solutions();
 
+    std::unique_ptr<QuerySolution> solution;
+    std::pair<std::unique_ptr<sbe::PlanStage>, stage_builder::PlanStageData> root;
     if (auto planner = makeRuntimePlannerIfNeeded(opCtx,
                                                   *collection,
                                                   cq.get(),
@@ -1085,20 +1302,40 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getSlotBasedExe
                                                   plannerOptions)) {
         // Do the runtime planning and pick the best candidate plan.
         auto candidates = planner->plan(std::move(solutions), std::move(roots));
-        return plan_executor_factory::make(opCtx,
-                                           std::move(cq),
-                                           std::move(candidates),
-                                           collection,
-                                           plannerOptions,
-                                           std::move(nss),
-                                           std::move(yieldPolicy));
-    }
-    // No need for runtime planning, just use the constructed plan stage tree.
-    invariant(roots.size() == 1);
+        if (!cq->getGroupPushdown()) {
+            return plan_executor_factory::make(opCtx,
+                                               std::move(cq),
+                                               std::move(candidates),
+                                               collection,
+                                               plannerOptions,
+                                               std::move(nss),
+                                               std::move(yieldPolicy));
+        }
+
+        // The candidate plans were run without the pushed down $group, so the results which the
+        // winning plan buffered during the trial period are the input of the $group. They are
+        // discarded, and the winning plan is rebuilt below with the $group on top of it.
+        auto& winner = candidates.winner();
+        winner.root->close();
+        solution = std::move(winner.solution);
+    } else {
+        // No need for runtime planning, just use the constructed plan stage tree.
+        invariant(roots.size() == 1);
+        solution = std::move(solutions[0]);
+        root = std::move(roots[0]);
+    }
+
+    if (auto&& group = cq->getGroupPushdown()) {
+        solution->extendWith(std::make_unique<GroupNode>(
+            group->idExpression, group->accumulators, cq->getExpCtx()->allowDiskUse));
+        root = stage_builder::buildSlotBasedExecutableTree(
+            opCtx, *collection, *cq, *solution, yieldPolicy.get());
+    }
+
     return plan_executor_factory::make(opCtx,
                                        std::move(cq),
-                                       std::move(solutions[0]),
-                                       std::move(roots[0]),
+                                       std::move(solution),
+                                       std::move(root),
                                        collection,
                                        plannerOptions,
                                        std::move(nss),
@@ -1132,12 +1369,16 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutor(
     std::unique_ptr<CanonicalQuery> canonicalQuery,
     PlanYieldPolicy::YieldPolicy yieldPolicy,
     size_t plannerOptions) {
-    return feature_flags::gSBE.isEnabledAndIgnoreFCV() &&
-            isQuerySbeCompatible(opCtx, canonicalQuery.get(), plannerOptions)
-        ? getSlotBasedExecutor(
-              opCtx, collection, std::move(canonicalQuery), yieldPolicy, plannerOptions)
-        : getClassicExecutor(
-              opCtx, collection, std::move(canonicalQuery), yieldPolicy, plannerOptions);
+    if (feature_flags::gSBE.isEnabledAndIgnoreFCV() &&
+        isQuerySbeCompatible(opCtx, canonicalQuery.get(), plannerOptions)) {
+        return getSlotBasedExecutor(
+            opCtx, collection, std::move(canonicalQuery), yieldPolicy, plannerOptions);
+    }
+
+    // Only SBE plans can execute a pushed down $group, so it's left to the pipeline otherwise.
+    canonicalQuery->setGroupPushdown(boost::none);
+    return getClassicExecutor(
+        opCtx, collection, std::move(canonicalQuery), yieldPolicy, plannerOptions);
 }
 
 //
@@ -1271,6 +1512,7 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutorDele
     deleteStageParams->sort = request->getSort();
     deleteStageParams->opDebug = opDebug;
     deleteStageParams->stmtId = request->getStmtId();
+    deleteStageParams->batchDocs = internalBatchedDeletesTargetBatchDocs.load();
 
     std::unique_ptr<WorkingSet> ws = std::make_unique<WorkingSet>();
     const auto policy = parsedDelete->yieldPolicy();
@@ -1452,6 +1694,7 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutorUpda
 
     std::unique_ptr<WorkingSet> ws = std::make_unique<WorkingSet>();
     UpdateStageParams updateStageParams(request, driver, opDebug);
+    updateStageParams.batchDocs = internalBatchedUpdatesTargetBatchDocs.load();
 
     // If the collection doesn't exist, then return a PlanExecutor for a no-op EOF plan. We have
     // should have already enforced upstream that in this case either the upsert flag is false, or
@@ -2009,6 +2252,9 @@ QueryPlannerParams fillOutPlannerParamsForDistinct(OperationContext* opCtx,
         // Skip the addition of hidden indexes to prevent use in query planning.
         if (desc->hidden())
             continue;
+        // Columnstore indexes cannot provide a distinct scan.
+        if (desc->getIndexType() == IndexType::INDEX_COLUMN)
+            continue;
         if (desc->keyPattern().hasField(parsedDistinct.getKey())) {
             if (!mayUnwindArrays &&
                 isAnyComponentOfPathMultikey(desc->keyPattern(),
@@ -39,6 +39,7 @@
 #include "mongo/db/geo/geoconstants.h"
 #include "mongo/db/geo/s2.h"
 #include "mongo/db/index/expression_params.h"
+#include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/index/s2_common.h"
 #include "mongo/db/matcher/expression_geo.h"
 #include "mongo/db/matcher/expression_internal_expr_comparison.h"
@@ -128,12 +129,30 @@ const Interval kHashedUndefinedInterval = IndexBoundsBuilder::makePointInterval(
 const Interval kHashedNullInterval =
     IndexBoundsBuilder::makePointInterval(ExpressionMapping::hash(kNullElementObj.firstElement()));
 
-Interval makeUndefinedPointInterval(bool isHashed) {
-    return isHashed ? kHashedUndefinedInterval
-                    : IndexBoundsBuilder::makePointInterval(kUndefinedElementObj);
+// Returns the version of the hash function of a hashed index.
+int getHashVersion(const IndexEntry& index) {
+    return index.infoObj[IndexDescriptor::kHashVersionFieldName].numberInt();
 }
-Interval makeNullPointInterval(bool isHashed) {
-    return isHashed ? kHashedNullInterval : IndexBoundsBuilder::makePointInterval(kNullElementObj);
+
+Interval makeUndefinedPointInterval(const IndexEntry& index, bool isHashed) {
+    if (!isHashed) {
+        return IndexBoundsBuilder::makePointInterval(kUndefinedElementObj);
+    }
+    const auto hashVersion = getHashVersion(index);
+    return hashVersion == BSONElementHasher::kDefaultHashVersion
+        ? kHashedUndefinedInterval
+        : IndexBoundsBuilder::makePointInterval(
+              ExpressionMapping::hash(kUndefinedElementObj.firstElement(), hashVersion));
+}
+Interval makeNullPointInterval(const IndexEntry& index, bool isHashed) {
+    if (!isHashed) {
+        return IndexBoundsBuilder::makePointInterval(kNullElementObj);
+    }
+    const auto hashVersion = getHashVersion(index);
+    return hashVersion == BSONElementHasher::kDefaultHashVersion
+        ? kHashedNullInterval
+        : IndexBoundsBuilder::makePointInterval(
+              ExpressionMapping::hash(kNullElementObj.firstElement(), hashVersion));
 }
 
 void makeNullEqualityBounds(const IndexEntry& index,
@@ -145,8 +164,8 @@ void makeNullEqualityBounds(const IndexEntry& index,
     *tightnessOut = IndexBoundsBuilder::INEXACT_FETCH;
 
     // There are two values that could possibly be equal to null in an index: undefined and null.
-    oil->intervals.push_back(makeUndefinedPointInterval(isHashed));
-    oil->intervals.push_back(makeNullPointInterval(isHashed));
+    oil->intervals.push_back(makeUndefinedPointInterval(index, isHashed));
+    oil->intervals.push_back(makeNullPointInterval(index, isHashed));
 
     // Just to be sure, make sure the bounds are in the right order if the hash values are opposite.
     IndexBoundsBuilder::unionize(oil);
@@ -257,6 +276,10 @@ string IndexBoundsBuilder::simpleRegex(const char* regex,
                 // slash followed by non-alphanumeric represents the following char
                 ss << c;
             }
+        } else if (c == '.' && (strcmp(regex, "*") == 0 || strcmp(regex, "*?") == 0)) {
+            // A trailing '.*' may match the empty string, so it matches exactly the strings that
+            // begin with the prefix seen so far.
+            regex += strlen(regex);
         } else if (strchr("^$.[()+{", c)) {
             // list of "metacharacters" from man pcrepattern
             r = ss;
@@ -554,7 +577,7 @@ void IndexBoundsBuilder::_translatePredicate(const MatchExpression* expr,
             // We should never try to use a sparse index for $exists:false.
             invariant(!index.sparse);
             // {$exists:false} is a point-interval on [null,null] that requires a fetch.
-            oilOut->intervals.push_back(makeNullPointInterval(isHashed));
+            oilOut->intervals.push_back(makeNullPointInterval(index, isHashed));
             *tightnessOut = IndexBoundsBuilder::INEXACT_FETCH;
             return;
         }
@@ -946,7 +969,9 @@ void IndexBoundsBuilder::_translatePredicate(const MatchExpression* expr,
 
         *tightnessOut = IndexBoundsBuilder::EXACT;
 
-        // Create our various intervals.
+        // Create our various intervals. Large $in lists are common, so size the list up front.
+        oilOut->intervals.reserve(oilOut->intervals.size() + ime->getEqualities().size() +
+                                  ime->getRegexes().size());
 
         IndexBoundsBuilder::BoundsTightness tightness;
         bool arrayOrNullPresent = false;
@@ -995,7 +1020,8 @@ void IndexBoundsBuilder::_translatePredicate(const MatchExpression* expr,
             const S2Region& region = gme->getGeoExpression().getGeometry().getS2Region();
             S2IndexingParams indexParams;
             ExpressionParams::initialize2dsphereParams(index.infoObj, index.collator, &indexParams);
-            ExpressionMapping::cover2dsphere(region, indexParams, oilOut);
+            ExpressionMapping::cover2dsphere(
+                region, gme->getRawObj(), indexParams, oilOut);
             *tightnessOut = IndexBoundsBuilder::INEXACT_FETCH;
         } else if ("2d" == elt.valueStringDataSafe()) {
             verify(gme->getGeoExpression().getGeometry().hasR2Region());
@@ -1099,43 +1125,44 @@ void IndexBoundsBuilder::unionize(OrderedIntervalList* oilOut) {
     // Step 1: sort.
     std::sort(iv.begin(), iv.end(), IntervalComparison);
 
-    // Step 2: Walk through and merge.
-    size_t i = 0;
-    while (i < iv.size() - 1) {
-        // Compare i with i + 1.
-        Interval::IntervalComparison cmp = iv[i].compare(iv[i + 1]);
+    // Step 2: Walk through and merge. Merged intervals are compacted in place towards the front of
+    // the vector so that a long list of intervals is unioned in linear time. 'last' is the index
+    // of the most recently kept interval.
+    size_t last = 0;
+    for (size_t i = 1; i < iv.size(); ++i) {
+        // Compare the last kept interval with i.
+        Interval::IntervalComparison cmp = iv[last].compare(iv[i]);
 
         // This means our sort didn't work.
         verify(Interval::INTERVAL_SUCCEEDS != cmp);
 
         // Intervals are correctly ordered.
         if (Interval::INTERVAL_PRECEDES == cmp) {
-            // We can move to the next pair.
-            ++i;
+            // Keep interval i.
+            ++last;
+            if (last != i) {
+                iv[last] = std::move(iv[i]);
+            }
         } else if (Interval::INTERVAL_EQUALS == cmp || Interval::INTERVAL_WITHIN == cmp) {
-            // Interval 'i' is equal to i+1, or is contained within i+1.
-            // Remove interval i and don't move to the next value of 'i'.
-            iv.erase(iv.begin() + i);
+            // The last kept interval is equal to i, or is contained within i. Keep i instead.
+            iv[last] = std::move(iv[i]);
         } else if (Interval::INTERVAL_CONTAINS == cmp) {
-            // Interval 'i' contains i+1, remove i+1 and don't move to the next value of 'i'.
-            iv.erase(iv.begin() + i + 1);
+            // The last kept interval contains i, drop i.
         } else if (Interval::INTERVAL_OVERLAPS_BEFORE == cmp ||
                    Interval::INTERVAL_PRECEDES_COULD_UNION == cmp) {
-            // We want to merge intervals i and i+1.
-            // Interval 'i' starts before interval 'i+1'.
+            // We want to merge the last kept interval with i. The last kept interval starts before
+            // interval i.
             BSONObjBuilder bob;
-            bob.appendAs(iv[i].start, "");
-            bob.appendAs(iv[i + 1].end, "");
+            bob.appendAs(iv[last].start, "");
+            bob.appendAs(iv[i].end, "");
             BSONObj data = bob.obj();
-            bool startInclusive = iv[i].startInclusive;
-            bool endInclusive = iv[i + 1].endInclusive;
-            iv.erase(iv.begin() + i);
-            // iv[i] is now the former iv[i + 1]
-            iv[i] = makeRangeInterval(
+            bool startInclusive = iv[last].startInclusive;
+            bool endInclusive = iv[i].endInclusive;
+            iv[last] = makeRangeInterval(
                 data, IndexBounds::makeBoundInclusionFromBoundBools(startInclusive, endInclusive));
-            // Don't increment 'i'.
         }
     }
+    iv.resize(last + 1);
 }
 
 // static
@@ -1237,7 +1264,7 @@ void IndexBoundsBuilder::translateEquality(const BSONElement& data,
     if (BSONType::Array != data.type()) {
         BSONObj dataObj = objFromElement(data, index.collator);
         if (isHashed) {
-            dataObj = ExpressionMapping::hash(dataObj.firstElement());
+            dataObj = ExpressionMapping::hash(dataObj.firstElement(), getHashVersion(index));
         }
 
         verify(dataObj.isOwned());
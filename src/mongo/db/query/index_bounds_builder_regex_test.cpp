@@ -115,6 +115,30 @@ TEST_F(IndexBoundsBuilderTest, RootedLiteralWithExtra) {
     std::string prefix =
         IndexBoundsBuilder::simpleRegex("^\\Qasdf\\E.*", "", testIndex, &tightness);
     ASSERT_EQUALS(prefix, "asdf");
+    ASSERT_EQUALS(tightness, IndexBoundsBuilder::EXACT);
+}
+
+TEST_F(IndexBoundsBuilderTest, RootedLiteralWithTrailingLazyDotStar) {
+    auto testIndex = buildSimpleIndexEntry();
+    IndexBoundsBuilder::BoundsTightness tightness;
+    std::string prefix = IndexBoundsBuilder::simpleRegex("^asdf.*?", "", testIndex, &tightness);
+    ASSERT_EQUALS(prefix, "asdf");
+    ASSERT_EQUALS(tightness, IndexBoundsBuilder::EXACT);
+}
+
+TEST_F(IndexBoundsBuilderTest, RootedLiteralWithDotStarInMiddle) {
+    auto testIndex = buildSimpleIndexEntry();
+    IndexBoundsBuilder::BoundsTightness tightness;
+    std::string prefix = IndexBoundsBuilder::simpleRegex("^asdf.*qwer", "", testIndex, &tightness);
+    ASSERT_EQUALS(prefix, "asdf");
+    ASSERT_EQUALS(tightness, IndexBoundsBuilder::INEXACT_COVERED);
+}
+
+TEST_F(IndexBoundsBuilderTest, DotStarOnly) {
+    auto testIndex = buildSimpleIndexEntry();
+    IndexBoundsBuilder::BoundsTightness tightness;
+    std::string prefix = IndexBoundsBuilder::simpleRegex("^.*", "", testIndex, &tightness);
+    ASSERT_EQUALS(prefix, "");
     ASSERT_EQUALS(tightness, IndexBoundsBuilder::INEXACT_COVERED);
 }
 
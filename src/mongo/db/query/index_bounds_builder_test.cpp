@@ -1024,6 +1024,26 @@ TEST_F(IndexBoundsBuilderTest, UnionDupEq) {
     ASSERT_EQUALS(tightness, IndexBoundsBuilder::EXACT);
 }
 
+TEST_F(IndexBoundsBuilderTest, UnionManyOverlappingIntervals) {
+    // Every group of intervals below unions to the single interval [10k, 10k + 8].
+    const int kNumGroups = 1000;
+    OrderedIntervalList oil("a");
+    for (int k = kNumGroups - 1; k >= 0; --k) {
+        oil.intervals.push_back(Interval(BSON("" << 10 * k << "" << 10 * k + 5), true, true));
+        oil.intervals.push_back(Interval(BSON("" << 10 * k + 1 << "" << 10 * k + 2), true, true));
+        oil.intervals.push_back(Interval(BSON("" << 10 * k + 3 << "" << 10 * k + 8), true, true));
+        oil.intervals.push_back(Interval(BSON("" << 10 * k + 4 << "" << 10 * k + 4), true, true));
+        oil.intervals.push_back(Interval(BSON("" << 10 * k + 4 << "" << 10 * k + 4), true, true));
+    }
+    IndexBoundsBuilder::unionize(&oil);
+    ASSERT_EQUALS(oil.intervals.size(), static_cast<size_t>(kNumGroups));
+    for (int k = 0; k < kNumGroups; ++k) {
+        ASSERT_EQUALS(Interval::INTERVAL_EQUALS,
+                      oil.intervals[k].compare(
+                          Interval(BSON("" << 10 * k << "" << 10 * k + 8), true, true)));
+    }
+}
+
 TEST_F(IndexBoundsBuilderTest, UnionGtLt) {
     auto testIndex = buildSimpleIndexEntry();
     std::vector<BSONObj> toUnion;
@@ -263,6 +263,38 @@ struct SolutionCacheData {
 
 class PlanCacheEntry;
 
+/**
+ * An execution tree built from the plan of a cache entry, which later queries answered by the same
+ * entry may reuse instead of building their own. The plan cache treats it as opaque.
+ */
+class CachedExecutionTree {
+public:
+    virtual ~CachedExecutionTree() = default;
+};
+
+/**
+ * Holds the CachedExecutionTree of a PlanCacheEntry. The holder is shared between the entry and
+ * the CachedSolutions returned for it, so that a tree can be attached once the query which looked
+ * up the entry has built one, and so that the tree goes away along with the entry it was built
+ * for.
+ */
+class CachedExecutionTreeHolder {
+public:
+    std::shared_ptr<const CachedExecutionTree> get() const {
+        stdx::lock_guard<Latch> lk(_mutex);
+        return _tree;
+    }
+
+    void set(std::shared_ptr<const CachedExecutionTree> tree) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _tree = std::move(tree);
+    }
+
+private:
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("CachedExecutionTreeHolder::_mutex");
+    std::shared_ptr<const CachedExecutionTree> _tree;
+};
+
 /**
  * Information returned from a get(...) query.
  */
@@ -280,6 +312,9 @@ public:
     // The number of work cycles taken to decide on a winning plan when the plan was first
     // cached.
     const size_t decisionWorks;
+
+    // The execution tree attached to the cache entry this solution was created from, if any.
+    const std::shared_ptr<CachedExecutionTreeHolder> executionTree;
 };
 
 /**
@@ -396,6 +431,12 @@ public:
     // debug info is omitted from new plan cache entries.
     const boost::optional<DebugInfo> debugInfo;
 
+    // An execution tree built for the cached plan, which may be attached by the first query that
+    // runs with this entry. It is not accounted for in 'estimatedEntrySizeBytes', and is not copied
+    // by clone().
+    const std::shared_ptr<CachedExecutionTreeHolder> executionTree =
+        std::make_shared<CachedExecutionTreeHolder>();
+
     // An estimate of the size in bytes of this plan cache entry. This is the "deep size",
     // calculated by recursively incorporating the size of owned objects, the objects that they in
     // turn own, and so on.
@@ -471,11 +512,17 @@ public:
     static bool shouldCacheQuery(const CanonicalQuery& query);
 
     /**
-     * If omitted, namespace set to empty string.
+     * Creates a plan cache whose size and number of partitions are taken from
+     * 'internalQueryCacheMaxEntriesPerCollection' and 'internalQueryCacheNumPartitions'.
      */
     PlanCache();
 
-    PlanCache(size_t size);
+    /**
+     * Creates a plan cache holding at most 'size' entries, split across 'numPartitions'
+     * independently locked partitions. Each partition has its own LRU list, so an entry is evicted
+     * when its partition is full, rather than when the cache as a whole is.
+     */
+    PlanCache(size_t size, size_t numPartitions = 1);
 
     ~PlanCache();
 
@@ -581,7 +628,8 @@ public:
 
     /**
      * Iterates over the plan cache. For each entry, serializes the PlanCacheEntry according to
-     * 'serializationFunc'. Returns a vector of all serialized entries which match 'filterFunc'.
+     * 'serializationFunc' and appends the hit and miss counters of the partition holding the entry.
+     * Returns a vector of all serialized entries which match 'filterFunc'.
      */
     std::vector<BSONObj> getMatchingStats(
         const std::function<BSONObj(const PlanCacheEntry&)>& serializationFunc,
@@ -600,10 +648,28 @@ private:
                                    size_t newWorks,
                                    double growthCoefficient);
 
-    LRUKeyValue<PlanCacheKey, PlanCacheEntry, PlanCacheKeyHasher> _cache;
+    /**
+     * An independently locked subset of the cache entries. Every key maps to exactly one
+     * partition, chosen by its hash.
+     */
+    struct Partition {
+        explicit Partition(size_t size) : cache(size) {}
+
+        LRUKeyValue<PlanCacheKey, PlanCacheEntry, PlanCacheKeyHasher> cache;
+
+        // Protects 'cache'. A lookup moves the entry to the front of the LRU list, so reads need
+        // exclusive access as well.
+        mutable Mutex mutex = MONGO_MAKE_LATCH("PlanCache::Partition::mutex");
+
+        // The number of lookups which found, or did not find, an entry in this partition.
+        mutable AtomicWord<long long> hits;
+        mutable AtomicWord<long long> misses;
+    };
+
+    Partition& getPartition(const PlanCacheKey& key);
+    const Partition& getPartition(const PlanCacheKey& key) const;
 
-    // Protects _cache.
-    mutable Mutex _cacheMutex = MONGO_MAKE_LATCH("PlanCache::_cacheMutex");
+    std::vector<std::unique_ptr<Partition>> _partitions;
 
     // Holds computed information about the collection's indexes.  Used for generating plan
     // cache keys.
@@ -576,6 +576,44 @@ TEST(PlanCacheTest, PlanCacheLRUPolicyRemovesInactiveEntries) {
     ASSERT_EQ(planCache.get(*cqC).state, PlanCache::CacheEntryState::kPresentInactive);
 }
 
+TEST(PlanCacheTest, PartitionedPlanCacheHoldsEntriesAcrossPartitions) {
+    const size_t kNumShapes = 20;
+    PlanCache planCache(100, 4);
+    QueryTestServiceContext serviceContext;
+
+    std::vector<unique_ptr<CanonicalQuery>> queries;
+    for (size_t i = 0; i < kNumShapes; ++i) {
+        const std::string fieldName = str::stream() << "field" << i;
+        queries.push_back(canonicalize(BSON(fieldName << 1)));
+        addCacheEntryForShape(*queries.back(), &planCache);
+    }
+    ASSERT_EQ(planCache.size(), kNumShapes);
+    ASSERT_EQ(planCache.getAllEntries().size(), kNumShapes);
+
+    for (auto&& cq : queries) {
+        ASSERT_EQ(planCache.get(*cq).state, PlanCache::CacheEntryState::kPresentInactive);
+    }
+
+    // Every entry reports the counters of its partition, and each lookup above has been counted
+    // as a hit in exactly one partition.
+    auto stats = planCache.getMatchingStats([](const PlanCacheEntry&) { return BSONObj(); },
+                                            [](const BSONObj&) { return true; });
+    ASSERT_EQ(stats.size(), kNumShapes);
+    std::map<int, long long> hitsByPartition;
+    for (auto&& entryStats : stats) {
+        auto partitionStats = entryStats["cachePartition"].Obj();
+        hitsByPartition[partitionStats["id"].numberInt()] = partitionStats["hits"].numberLong();
+    }
+    long long totalHits = 0;
+    for (auto&& [id, hits] : hitsByPartition) {
+        totalHits += hits;
+    }
+    ASSERT_EQ(totalHits, static_cast<long long>(kNumShapes));
+
+    planCache.clear();
+    ASSERT_EQ(planCache.size(), 0U);
+}
+
 TEST(PlanCacheTest, PlanCacheRemoveDeletesInactiveEntries) {
     PlanCache planCache;
     unique_ptr<CanonicalQuery> cq(canonicalize("{a: 1}"));
@@ -44,7 +44,8 @@ namespace mongo {
 struct PlanEnumeratorParams {
     PlanEnumeratorParams()
         : maxSolutionsPerOr(internalQueryEnumerationMaxOrSolutions.load()),
-          maxIntersectPerAnd(internalQueryEnumerationMaxIntersectPerAnd.load()) {}
+          maxIntersectPerAnd(internalQueryEnumerationMaxIntersectPerAnd.load()),
+          skipScan(internalQueryPlannerEnableSkipScan.load()) {}
 
     // Do we provide solutions that use more indices than the minimum required to provide
     // an indexed solution?
@@ -69,6 +70,11 @@ struct PlanEnumeratorParams {
     // all-pairs approach, we could wind up creating a lot of enumeration possibilities for
     // certain inputs.
     size_t maxIntersectPerAnd;
+
+    // Do we provide solutions that scan a compound index whose leading field has no predicate? The
+    // index scan seeks past each distinct value of the leading field to the bounds of the fields
+    // which do have predicates.
+    bool skipScan;
 };
 
 /**
@@ -594,6 +600,9 @@ private:
 
     // How many things do we want from each AND?
     size_t _intersectLimit;
+
+    // Do we output assignments to indexes from the predicates on their non-leading fields alone?
+    bool _skipScan;
 };
 
 }  // namespace mongo
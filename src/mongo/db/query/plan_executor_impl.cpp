@@ -365,8 +365,11 @@ PlanExecutor::ExecState PlanExecutorImpl::_getNextImpl(Snapshotted<Document>* ob
         WorkingSetID id = WorkingSet::INVALID_ID;
         PlanStage::StageState code = _root->work(&id);
 
-        if (code != PlanStage::NEED_YIELD)
+        if (code != PlanStage::NEED_YIELD) {
             writeConflictsInARow = 0;
+            // Whatever the plan did after yielding for a write conflict, it has stopped retrying.
+            _hotDocumentTurn.release();
+        }
 
         if (PlanStage::ADVANCED == code) {
             WorkingSetMember* member = _workingSet->get(id);
@@ -426,8 +429,12 @@ PlanExecutor::ExecState PlanExecutorImpl::_getNextImpl(Snapshotted<Document>* ob
 
             CurOp::get(_opCtx)->debug().additiveMetrics.incrementWriteConflicts(1);
             writeConflictsInARow++;
-            WriteConflictException::logAndBackoff(
-                writeConflictsInARow, "plan execution", _nss.ns());
+            _hotDocumentTurn = HotDocumentTracker::get().onWriteConflict(
+                _opCtx, _nss.ns(), std::move(_hotDocumentTurn));
+            if (!_hotDocumentTurn) {
+                WriteConflictException::logAndBackoff(
+                    writeConflictsInARow, "plan execution", _nss.ns());
+            }
 
             // If we're allowed to, we will yield next time through the loop.
             if (_yieldPolicy->canAutoYield()) {
@@ -32,6 +32,7 @@
 #include <boost/optional.hpp>
 #include <queue>
 
+#include "mongo/db/concurrency/hot_document_tracker.h"
 #include "mongo/db/exec/multi_plan.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/query/plan_executor.h"
@@ -164,6 +165,9 @@ private:
     // file includes plan_yield_policy.h rather than the other way around.
     const std::unique_ptr<PlanYieldPolicy> _yieldPolicy;
 
+    // Held while retrying a write to a document that kept conflicting, until the retry finishes.
+    HotDocumentTracker::Turn _hotDocumentTurn;
+
     // A stash of results generated by this plan that the user of the PlanExecutor didn't want
     // to consume yet. We empty the queue before retrieving further results from the plan
     // stages.
@@ -93,6 +93,18 @@ void statsToBSON(const QuerySolutionNode* node,
             bob->append("indexVersion", geo2dsphere->index.version);
             break;
         }
+        case STAGE_GROUP: {
+            auto gn = static_cast<const GroupNode*>(node);
+            gn->groupByExpression->serialize(false).addToBsonObj(bob, "groupBy");
+            BSONObjBuilder accumulatorsBob(bob->subobjStart("accumulators"));
+            for (auto&& acc : gn->accumulators) {
+                BSONObjBuilder accBob(accumulatorsBob.subobjStart(acc.fieldName));
+                acc.argument->serialize(false).addToBsonObj(&accBob, acc.op);
+            }
+            accumulatorsBob.doneFast();
+            bob->appendBool("allowDiskUse", gn->allowDiskUse);
+            break;
+        }
         case STAGE_IXSCAN: {
             auto ixn = static_cast<const IndexScanNode*>(node);
 
@@ -33,6 +33,7 @@
 
 #include "mongo/db/query/plan_ranker.h"
 
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/logv2/log.h"
 
 namespace mongo::plan_ranker {
@@ -143,4 +144,97 @@ protected:
 std::unique_ptr<PlanScorer<PlanStageStats>> makePlanScorer() {
     return std::make_unique<DefaultPlanScorer>();
 }
+
+boost::optional<size_t> estimateMaxKeysExamined(const QuerySolutionNode* node) {
+    switch (node->getType()) {
+        case STAGE_IXSCAN: {
+            auto ixn = static_cast<const IndexScanNode*>(node);
+            if (ixn->bounds.isSimpleRange) {
+                return boost::none;
+            }
+
+            // A scan over bounds with an empty field examines no keys, whatever the index.
+            size_t numPoints = 1;
+            bool allPoints = true;
+            for (auto&& oil : ixn->bounds.fields) {
+                if (oil.intervals.empty()) {
+                    return size_t{0};
+                }
+                for (auto&& interval : oil.intervals) {
+                    allPoints = allPoints && interval.isPoint();
+                }
+                numPoints *= oil.intervals.size();
+            }
+
+            // Each point over the full key of a unique index matches at most one key.
+            if (!allPoints || !ixn->index.unique ||
+                ixn->bounds.fields.size() !=
+                    static_cast<size_t>(ixn->index.keyPattern.nFields())) {
+                return boost::none;
+            }
+            return numPoints;
+        }
+        case STAGE_AND_HASH:
+        case STAGE_AND_SORTED:
+        case STAGE_FETCH:
+        case STAGE_LIMIT:
+        case STAGE_OR:
+        case STAGE_PROJECTION_COVERED:
+        case STAGE_PROJECTION_DEFAULT:
+        case STAGE_PROJECTION_SIMPLE:
+        case STAGE_RETURN_KEY:
+        case STAGE_SHARDING_FILTER:
+        case STAGE_SKIP:
+        case STAGE_SORT_DEFAULT:
+        case STAGE_SORT_KEY_GENERATOR:
+        case STAGE_SORT_MERGE:
+        case STAGE_SORT_SIMPLE: {
+            size_t numKeys = 0;
+            for (auto&& child : node->children) {
+                auto childKeys = estimateMaxKeysExamined(child);
+                if (!childKeys) {
+                    return boost::none;
+                }
+                numKeys += *childKeys;
+            }
+            return numKeys;
+        }
+        default:
+            return boost::none;
+    }
+}
+
+boost::optional<size_t> pickBestPlanByCost(
+    const std::vector<std::unique_ptr<QuerySolution>>& solutions) {
+    const size_t maxKeys = internalQueryPlannerCostBasedSelectionMaxKeys.load();
+
+    boost::optional<size_t> bestIdx;
+    boost::optional<size_t> bestKeys;
+    bool tied = false;
+    for (size_t ix = 0; ix < solutions.size(); ++ix) {
+        auto numKeys = estimateMaxKeysExamined(solutions[ix]->root());
+        if (!numKeys) {
+            continue;
+        }
+
+        if (!bestKeys || *numKeys < *bestKeys) {
+            bestIdx = ix;
+            bestKeys = numKeys;
+            tied = false;
+        } else if (*numKeys == *bestKeys) {
+            tied = true;
+        }
+    }
+
+    if (!bestIdx || tied || *bestKeys > maxKeys) {
+        return boost::none;
+    }
+
+    LOGV2_DEBUG(5591200,
+                2,
+                "Picked plan by cost estimate",
+                "planIndex"_attr = *bestIdx,
+                "maxKeysExamined"_attr = *bestKeys);
+    return bestIdx;
+}
 }  // namespace mongo::plan_ranker
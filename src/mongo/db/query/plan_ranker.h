@@ -193,4 +193,23 @@ struct BaseCandidatePlan {
 };
 
 using CandidatePlan = BaseCandidatePlan<PlanStage*, WorkingSetID, WorkingSet*>;
+
+/**
+ * Returns an upper bound on the number of index keys the plan rooted at 'node' can examine, if one
+ * can be derived from the plan's shape and index bounds alone. This is the case when every scan
+ * in the plan is an index scan whose bounds are either empty, or consist of point intervals over
+ * every field of a unique index. Returns boost::none if the number of keys examined depends on
+ * the data.
+ */
+boost::optional<size_t> estimateMaxKeysExamined(const QuerySolutionNode* node);
+
+/**
+ * Attempts to pick the best of the candidate 'solutions' without running them, based on the
+ * estimates returned by estimateMaxKeysExamined(). A plan is chosen only if its estimate does not
+ * exceed 'internalQueryPlannerCostBasedSelectionMaxKeys' and is strictly lower than that of any
+ * other candidate with an estimate. Returns the index of the chosen plan, or boost::none if the
+ * estimates are not conclusive and the candidates should be ranked by a trial run.
+ */
+boost::optional<size_t> pickBestPlanByCost(
+    const std::vector<std::unique_ptr<QuerySolution>>& solutions);
 }  // namespace mongo::plan_ranker
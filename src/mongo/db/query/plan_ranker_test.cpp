@@ -31,8 +31,11 @@
  * This file contains tests for mongo/db/query/plan_ranker.h
  */
 
+#include "mongo/db/query/index_bounds_builder.h"
+#include "mongo/db/query/index_entry.h"
 #include "mongo/db/query/plan_ranker.h"
 #include "mongo/db/query/plan_ranker_util.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/assert_util.h"
 
@@ -77,4 +80,100 @@ TEST(PlanRankerTest, NoFetchBonus) {
     ASSERT_GT(goodScore, badScore);
 }
 
+IndexEntry buildIndexEntry(const BSONObj& kp, bool unique) {
+    return {kp,
+            IndexNames::nameToType(IndexNames::findPluginName(kp)),
+            IndexDescriptor::kLatestIndexVersion,
+            false,
+            {},
+            {},
+            false,
+            unique,
+            CoreIndexInfo::Identifier("test_foo"),
+            nullptr,
+            {},
+            nullptr,
+            nullptr};
+}
+
+/**
+ * Makes a solution which fetches the results of an index scan over 'kp' with the given point
+ * bounds, one vector of points per index field.
+ */
+unique_ptr<QuerySolution> makeIndexScanSolution(const BSONObj& kp,
+                                                bool unique,
+                                                const vector<vector<int>>& points) {
+    auto ixn = make_unique<IndexScanNode>(buildIndexEntry(kp, unique));
+    for (auto&& field : points) {
+        OrderedIntervalList oil;
+        for (auto&& point : field) {
+            oil.intervals.push_back(IndexBoundsBuilder::makePointInterval(point));
+        }
+        ixn->bounds.fields.push_back(std::move(oil));
+    }
+
+    auto fetch = make_unique<FetchNode>();
+    fetch->children.push_back(ixn.release());
+
+    auto solution = make_unique<QuerySolution>(0);
+    solution->setRoot(std::move(fetch));
+    return solution;
+}
+
+unique_ptr<QuerySolution> makeRangeScanSolution(const BSONObj& kp) {
+    auto ixn = make_unique<IndexScanNode>(buildIndexEntry(kp, false));
+    OrderedIntervalList oil;
+    oil.intervals.push_back(IndexBoundsBuilder::allValues());
+    ixn->bounds.fields.push_back(std::move(oil));
+
+    auto solution = make_unique<QuerySolution>(0);
+    solution->setRoot(std::move(ixn));
+    return solution;
+}
+
+TEST(PlanRankerCostTest, PointsOnUniqueIndexAreBounded) {
+    auto solution = makeIndexScanSolution(BSON("a" << 1), true, {{1, 2, 3}});
+    ASSERT_EQ(3U, *plan_ranker::estimateMaxKeysExamined(solution->root()));
+}
+
+TEST(PlanRankerCostTest, PointsOnNonUniqueIndexAreNotBounded) {
+    auto solution = makeIndexScanSolution(BSON("a" << 1), false, {{1}});
+    ASSERT_FALSE(plan_ranker::estimateMaxKeysExamined(solution->root()));
+}
+
+TEST(PlanRankerCostTest, PointsOnPrefixOfUniqueIndexAreNotBounded) {
+    auto solution = makeIndexScanSolution(BSON("a" << 1 << "b" << 1), true, {{1}});
+    ASSERT_FALSE(plan_ranker::estimateMaxKeysExamined(solution->root()));
+}
+
+TEST(PlanRankerCostTest, EmptyBoundsExamineNoKeys) {
+    auto solution = makeIndexScanSolution(BSON("a" << 1 << "b" << 1), false, {{1}, {}});
+    ASSERT_EQ(0U, *plan_ranker::estimateMaxKeysExamined(solution->root()));
+}
+
+TEST(PlanRankerCostTest, PicksBoundedPlanOverUnboundedPlan) {
+    vector<unique_ptr<QuerySolution>> solutions;
+    solutions.push_back(makeRangeScanSolution(BSON("b" << 1)));
+    solutions.push_back(makeIndexScanSolution(BSON("a" << 1), true, {{1}}));
+    ASSERT_EQ(1U, *plan_ranker::pickBestPlanByCost(solutions));
+}
+
+TEST(PlanRankerCostTest, DoesNotPickPlanOnTie) {
+    vector<unique_ptr<QuerySolution>> solutions;
+    solutions.push_back(makeIndexScanSolution(BSON("a" << 1), true, {{1}}));
+    solutions.push_back(makeIndexScanSolution(BSON("b" << 1), true, {{1}}));
+    ASSERT_FALSE(plan_ranker::pickBestPlanByCost(solutions));
+}
+
+TEST(PlanRankerCostTest, DoesNotPickPlanAboveKeysThreshold) {
+    vector<unique_ptr<QuerySolution>> solutions;
+    solutions.push_back(makeRangeScanSolution(BSON("b" << 1)));
+    solutions.push_back(makeIndexScanSolution(BSON("a" << 1), true, {{1, 2, 3}}));
+
+    const auto oldMaxKeys = internalQueryPlannerCostBasedSelectionMaxKeys.load();
+    internalQueryPlannerCostBasedSelectionMaxKeys.store(2);
+    ON_BLOCK_EXIT([&] { internalQueryPlannerCostBasedSelectionMaxKeys.store(oldMaxKeys); });
+    ASSERT_FALSE(plan_ranker::pickBestPlanByCost(solutions));
+}
+
 };  // namespace
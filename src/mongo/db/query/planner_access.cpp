@@ -145,20 +145,26 @@ using std::vector;
 
 namespace {
 /**
- * Extracts the lower and upper bounds on the "ts" field from 'me'. This only examines comparisons
- * of "ts" against a Timestamp at the top level or inside a top-level $and.
+ * Extracts the lower and upper bounds on the field 'path' from 'me'. This only examines
+ * comparisons of 'path' against values of type 'type' at the top level or inside a top-level $and.
+ * 'getValue' converts a matching BSONElement to a bound.
  */
-std::pair<boost::optional<Timestamp>, boost::optional<Timestamp>> extractTsRange(
-    const MatchExpression* me, bool topLevel = true) {
-    boost::optional<Timestamp> min;
-    boost::optional<Timestamp> max;
+template <typename T>
+std::pair<boost::optional<T>, boost::optional<T>> extractRange(const MatchExpression* me,
+                                                               StringData path,
+                                                               BSONType type,
+                                                               T (BSONElement::*getValue)() const,
+                                                               bool topLevel = true) {
+    boost::optional<T> min;
+    boost::optional<T> max;
 
     if (me->matchType() == MatchExpression::AND && topLevel) {
         for (size_t i = 0; i < me->numChildren(); ++i) {
-            boost::optional<Timestamp> childMin;
-            boost::optional<Timestamp> childMax;
-            std::tie(childMin, childMax) = extractTsRange(me->getChild(i), false);
-            if (childMin && (!min || childMin.get() > min.get())) {
+            boost::optional<T> childMin;
+            boost::optional<T> childMax;
+            std::tie(childMin, childMax) =
+                extractRange(me->getChild(i), path, type, getValue, false);
+            if (childMin && (!min || min.get() < childMin.get())) {
                 min = childMin;
             }
             if (childMax && (!max || childMax.get() < max.get())) {
@@ -168,34 +174,49 @@ std::pair<boost::optional<Timestamp>, boost::optional<Timestamp>> extractTsRange
         return {min, max};
     }
 
-    if (!ComparisonMatchExpression::isComparisonMatchExpression(me) ||
-        me->path() != repl::OpTime::kTimestampFieldName) {
+    if (!ComparisonMatchExpression::isComparisonMatchExpression(me) || me->path() != path) {
         return {min, max};
     }
 
     auto rawElem = static_cast<const ComparisonMatchExpression*>(me)->getData();
-    if (rawElem.type() != BSONType::bsonTimestamp) {
+    if (rawElem.type() != type) {
         return {min, max};
     }
 
     switch (me->matchType()) {
         case MatchExpression::EQ:
-            min = rawElem.timestamp();
-            max = rawElem.timestamp();
+            min = (rawElem.*getValue)();
+            max = (rawElem.*getValue)();
             return {min, max};
         case MatchExpression::GT:
         case MatchExpression::GTE:
-            min = rawElem.timestamp();
+            min = (rawElem.*getValue)();
             return {min, max};
         case MatchExpression::LT:
         case MatchExpression::LTE:
-            max = rawElem.timestamp();
+            max = (rawElem.*getValue)();
             return {min, max};
         default:
             MONGO_UNREACHABLE;
     }
 }
 
+/**
+ * Extracts the lower and upper bounds on the "ts" field from 'me'.
+ */
+std::pair<boost::optional<Timestamp>, boost::optional<Timestamp>> extractTsRange(
+    const MatchExpression* me) {
+    return extractRange(
+        me, repl::OpTime::kTimestampFieldName, BSONType::bsonTimestamp, &BSONElement::timestamp);
+}
+
+/**
+ * Extracts the lower and upper bounds on an ObjectId "_id" field from 'me'.
+ */
+std::pair<boost::optional<OID>, boost::optional<OID>> extractIdRange(const MatchExpression* me) {
+    return extractRange(me, "_id"_sd, BSONType::jstOID, &BSONElement::OID);
+}
+
 /**
  * Returns true if 'me' is a GTE or GE predicate over the "ts" field.
  */
@@ -290,6 +311,19 @@ std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::makeCollectionScan(
         }
     }
 
+    if ((params.options & QueryPlannerParams::IS_CLUSTERED) && resumeAfterObj.isEmpty()) {
+        // Collections clustered by _id store their records keyed by the _id ObjectId, so
+        // predicates on _id bound the range of RecordIds the scan needs to visit. The bounds are
+        // inclusive and the filter is still applied to every record within them.
+        auto [minId, maxId] = extractIdRange(query.root());
+        if (minId) {
+            csn->minRecord = record_id_helpers::keyForOID(*minId);
+        }
+        if (maxId) {
+            csn->maxRecord = record_id_helpers::keyForOID(*maxId);
+        }
+    }
+
     // The user may have requested 'assertMinTsHasNotFallenOffOplog' for a query that does not
     // specify a minimum timestamp. This is not a valid request, so we throw InvalidOptions.
     if (assertMinTsHasNotFallenOffOplog) {
@@ -904,6 +904,13 @@ QuerySolutionNode* QueryPlannerAnalysis::analyzeSort(const CanonicalQuery& query
         sortNodeRaw->limit = 0;
     }
 
+    // A TEXT stage whose results are only sorted by text score, with a limit, can leave out all but
+    // the best scored documents.
+    if (sortNodeRaw->limit > 0 && STAGE_TEXT == sortNodeRaw->children[0]->getType() &&
+        sortObj.nFields() == 1 && query_request_helper::isTextScoreMeta(sortObj.firstElement())) {
+        static_cast<TextNode*>(sortNodeRaw->children[0])->topK = sortNodeRaw->limit;
+    }
+
     *blockingSortOut = true;
 
     return solnRoot;
@@ -976,6 +983,27 @@ std::unique_ptr<QuerySolution> QueryPlannerAnalysis::analyzeDataAccess(
 
     const FindCommand& findCommand = query.getFindCommand();
 
+    // A near search whose results are limited only needs the nearest documents, as long as no
+    // stage, such as a sharding filter, can reject documents between it and the limit.
+    if (!hasSortStage &&
+        (STAGE_GEO_NEAR_2D == solnRoot->getType() ||
+         STAGE_GEO_NEAR_2DSPHERE == solnRoot->getType())) {
+        size_t limit = 0;
+        if (findCommand.getLimit()) {
+            limit = static_cast<size_t>(*findCommand.getLimit());
+        } else if (findCommand.getNtoreturn() && findCommand.getSingleBatch()) {
+            limit = static_cast<size_t>(*findCommand.getNtoreturn());
+        }
+        if (limit) {
+            limit += static_cast<size_t>(findCommand.getSkip().value_or(0));
+            if (STAGE_GEO_NEAR_2D == solnRoot->getType()) {
+                static_cast<GeoNear2DNode*>(solnRoot.get())->limit = limit;
+            } else {
+                static_cast<GeoNear2DSphereNode*>(solnRoot.get())->limit = limit;
+            }
+        }
+    }
+
     if (findCommand.getSkip()) {
         auto skip = std::make_unique<SkipNode>();
         skip->skip = *findCommand.getSkip();
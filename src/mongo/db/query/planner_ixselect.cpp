@@ -47,6 +47,7 @@
 #include "mongo/db/query/index_tag.h"
 #include "mongo/db/query/indexability.h"
 #include "mongo/db/query/planner_wildcard_helpers.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner_common.h"
 #include "mongo/logv2/log.h"
 
@@ -314,12 +315,25 @@ std::vector<IndexEntry> QueryPlannerIXSelect::findIndexesByHint(
 std::vector<IndexEntry> QueryPlannerIXSelect::findRelevantIndices(
     const stdx::unordered_set<std::string>& fields, const std::vector<IndexEntry>& allIndices) {
 
+    // A btree index whose leading field the query has no predicate on can still be used with a
+    // skip scan, which seeks past each distinct value of the leading field.
+    const bool skipScan = internalQueryPlannerEnableSkipScan.load();
+
     std::vector<IndexEntry> out;
     for (auto&& entry : allIndices) {
         BSONObjIterator it(entry.keyPattern);
         BSONElement elt = it.next();
         if (fields.end() != fields.find(elt.fieldName())) {
             out.push_back(entry);
+            continue;
+        }
+        if (skipScan && entry.type == IndexType::INDEX_BTREE) {
+            while (it.more()) {
+                if (fields.end() != fields.find(it.next().fieldName())) {
+                    out.push_back(entry);
+                    break;
+                }
+            }
         }
     }
 
@@ -0,0 +1,108 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/query_memory_governor.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "mongo/db/operation_context.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/service_context.h"
+
+namespace mongo {
+namespace {
+
+const auto getQueryMemoryGovernor = ServiceContext::declareDecoration<QueryMemoryGovernor>();
+
+const auto getOperationMemoryUsage = OperationContext::declareDecoration<AtomicWord<long long>>();
+
+}  // namespace
+
+QueryMemoryGovernor* QueryMemoryGovernor::get(ServiceContext* serviceContext) {
+    return &getQueryMemoryGovernor(serviceContext);
+}
+
+long long QueryMemoryGovernor::getOperationMemoryUsageBytes(OperationContext* opCtx) {
+    return getOperationMemoryUsage(opCtx).load();
+}
+
+QueryMemoryGovernor::Reservation::~Reservation() {
+    set(0);
+}
+
+void QueryMemoryGovernor::Reservation::attach(OperationContext* opCtx) {
+    detach();
+    if (!opCtx) {
+        return;
+    }
+
+    if (!_governor) {
+        _governor = get(opCtx->getServiceContext());
+        _governor->_memoryUsageBytes.fetchAndAdd(_bytes);
+    }
+    _operationMemoryUsageBytes = &getOperationMemoryUsage(opCtx);
+    _operationMemoryUsageBytes->fetchAndAdd(_bytes);
+}
+
+void QueryMemoryGovernor::Reservation::detach() {
+    if (_operationMemoryUsageBytes) {
+        _operationMemoryUsageBytes->fetchAndSubtract(_bytes);
+        _operationMemoryUsageBytes = nullptr;
+    }
+}
+
+void QueryMemoryGovernor::Reservation::set(size_t bytes) {
+    const long long delta = static_cast<long long>(bytes) - _bytes;
+    if (delta == 0 || (bytes != 0 && std::abs(delta) < kReportingGranularityBytes)) {
+        return;
+    }
+
+    _bytes += delta;
+    if (_governor) {
+        _governor->_memoryUsageBytes.fetchAndAdd(delta);
+    }
+    if (_operationMemoryUsageBytes) {
+        _operationMemoryUsageBytes->fetchAndAdd(delta);
+    }
+}
+
+bool QueryMemoryGovernor::Reservation::shouldSpill() const {
+    const long long limit = internalQueryMaxServerBlockingMemoryUsageBytes.load();
+    if (!_governor || limit == 0) {
+        return false;
+    }
+    return _bytes >= std::max(limit / kMinSpillFractionOfLimit, kReportingGranularityBytes) &&
+        _governor->getMemoryUsageBytes() > limit;
+}
+
+}  // namespace mongo
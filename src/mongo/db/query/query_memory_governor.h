@@ -0,0 +1,117 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <cstddef>
+
+#include "mongo/platform/atomic_word.h"
+
+namespace mongo {
+
+class OperationContext;
+class ServiceContext;
+
+/**
+ * Keeps track of the memory which the blocking stages (sorts and groups) of all the queries
+ * running on the server hold, so that they are bounded as a whole as well as one by one. When the
+ * total goes over 'internalQueryMaxServerBlockingMemoryUsageBytes', the stages which may spill to
+ * disk are asked to do so before they reach their own memory limit.
+ *
+ * The memory of a stage is also accounted to the operation running it, which currentOp reports.
+ */
+class QueryMemoryGovernor {
+public:
+    static QueryMemoryGovernor* get(ServiceContext* serviceContext);
+
+    /**
+     * Returns the bytes held by the blocking stages which are attached to 'opCtx'.
+     */
+    static long long getOperationMemoryUsageBytes(OperationContext* opCtx);
+
+    /**
+     * Returns the bytes held by the blocking stages of all queries.
+     */
+    long long getMemoryUsageBytes() const {
+        return _memoryUsageBytes.load();
+    }
+
+    /**
+     * The memory held by one blocking stage. A reservation is accounted to the operation which it
+     * is attached to, and must be detached from it whenever the stage is detached from its
+     * operation, such as in between the getMores of a cursor. The governor learns of the
+     * reservation the first time that it is attached.
+     */
+    class Reservation {
+        Reservation(const Reservation&) = delete;
+        Reservation& operator=(const Reservation&) = delete;
+
+    public:
+        Reservation() = default;
+        ~Reservation();
+
+        /**
+         * Accounts the reservation to 'opCtx' instead of the operation it was attached to, if
+         * any. Only detaches the reservation if 'opCtx' is null.
+         */
+        void attach(OperationContext* opCtx);
+
+        void detach();
+
+        /**
+         * Sets the bytes held by the stage. Changes smaller than kReportingGranularityBytes are
+         * not reported, so that a stage does not touch the shared counters for every document.
+         */
+        void set(size_t bytes);
+
+        /**
+         * Returns true if the stage should spill to disk now to relieve the server: the blocking
+         * stages of all queries hold more than the server-wide limit, and this stage holds enough
+         * of it for spilling to make a difference.
+         */
+        bool shouldSpill() const;
+
+    private:
+        static constexpr long long kReportingGranularityBytes = 64 * 1024;
+
+        // A stage holding less than this fraction of the server-wide limit is never asked to
+        // spill, so that a tight limit does not turn every stage into a stream of tiny spills.
+        static constexpr long long kMinSpillFractionOfLimit = 64;
+
+        QueryMemoryGovernor* _governor = nullptr;
+        AtomicWord<long long>* _operationMemoryUsageBytes = nullptr;
+        long long _bytes = 0;
+    };
+
+private:
+    AtomicWord<long long> _memoryUsageBytes{0};
+};
+
+}  // namespace mongo
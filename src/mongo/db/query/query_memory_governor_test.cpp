@@ -0,0 +1,139 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/query_memory_governor.h"
+
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/service_context_test_fixture.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+
+const long long kMB = 1024 * 1024;
+
+class QueryMemoryGovernorTest : public ServiceContextTest {
+protected:
+    QueryMemoryGovernor* governor() {
+        return QueryMemoryGovernor::get(getServiceContext());
+    }
+};
+
+TEST_F(QueryMemoryGovernorTest, ReservationsAreAccountedToTheServerAndTheOperation) {
+    auto opCtx = makeOperationContext();
+    {
+        QueryMemoryGovernor::Reservation first;
+        QueryMemoryGovernor::Reservation second;
+        first.attach(opCtx.get());
+        second.attach(opCtx.get());
+
+        first.set(3 * kMB);
+        second.set(2 * kMB);
+        ASSERT_EQ(5 * kMB, governor()->getMemoryUsageBytes());
+        ASSERT_EQ(5 * kMB, QueryMemoryGovernor::getOperationMemoryUsageBytes(opCtx.get()));
+
+        first.set(kMB);
+        ASSERT_EQ(3 * kMB, governor()->getMemoryUsageBytes());
+        ASSERT_EQ(3 * kMB, QueryMemoryGovernor::getOperationMemoryUsageBytes(opCtx.get()));
+    }
+    ASSERT_EQ(0, governor()->getMemoryUsageBytes());
+    ASSERT_EQ(0, QueryMemoryGovernor::getOperationMemoryUsageBytes(opCtx.get()));
+}
+
+TEST_F(QueryMemoryGovernorTest, SmallChangesAreNotReported) {
+    auto opCtx = makeOperationContext();
+    QueryMemoryGovernor::Reservation reservation;
+    reservation.attach(opCtx.get());
+
+    reservation.set(kMB);
+    reservation.set(kMB + 1024);
+    ASSERT_EQ(kMB, governor()->getMemoryUsageBytes());
+
+    reservation.set(0);
+    ASSERT_EQ(0, governor()->getMemoryUsageBytes());
+}
+
+TEST_F(QueryMemoryGovernorTest, DetachedReservationStaysAccountedToTheServer) {
+    QueryMemoryGovernor::Reservation reservation;
+    {
+        auto opCtx = makeOperationContext();
+        reservation.attach(opCtx.get());
+        reservation.set(2 * kMB);
+        reservation.detach();
+        ASSERT_EQ(0, QueryMemoryGovernor::getOperationMemoryUsageBytes(opCtx.get()));
+    }
+    ASSERT_EQ(2 * kMB, governor()->getMemoryUsageBytes());
+
+    auto opCtx = makeOperationContext();
+    reservation.attach(opCtx.get());
+    ASSERT_EQ(2 * kMB, QueryMemoryGovernor::getOperationMemoryUsageBytes(opCtx.get()));
+    ASSERT_EQ(2 * kMB, governor()->getMemoryUsageBytes());
+    reservation.detach();
+}
+
+TEST_F(QueryMemoryGovernorTest, ShouldSpillOnlyWhenTheServerIsOverItsLimit) {
+    const auto limit = internalQueryMaxServerBlockingMemoryUsageBytes.load();
+    ON_BLOCK_EXIT([limit] { internalQueryMaxServerBlockingMemoryUsageBytes.store(limit); });
+    internalQueryMaxServerBlockingMemoryUsageBytes.store(64 * kMB);
+
+    auto opCtx = makeOperationContext();
+    QueryMemoryGovernor::Reservation large;
+    QueryMemoryGovernor::Reservation small;
+    large.attach(opCtx.get());
+    small.attach(opCtx.get());
+
+    large.set(60 * kMB);
+    small.set(512 * 1024);
+    ASSERT_FALSE(large.shouldSpill());
+
+    large.set(70 * kMB);
+    ASSERT_TRUE(large.shouldSpill());
+
+    // A reservation holding too little of the limit is not asked to spill.
+    ASSERT_FALSE(small.shouldSpill());
+
+    // Without a limit, nothing spills early.
+    internalQueryMaxServerBlockingMemoryUsageBytes.store(0);
+    ASSERT_FALSE(large.shouldSpill());
+}
+
+TEST_F(QueryMemoryGovernorTest, ReservationWithoutOperationIsNotAccounted) {
+    QueryMemoryGovernor::Reservation reservation;
+    reservation.attach(nullptr);
+    reservation.set(2 * kMB);
+    ASSERT_EQ(0, governor()->getMemoryUsageBytes());
+    ASSERT_FALSE(reservation.shouldSpill());
+}
+
+}  // namespace
+}  // namespace mongo
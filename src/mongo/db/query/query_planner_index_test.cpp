@@ -31,9 +31,11 @@
 
 #include "mongo/db/matcher/expression_always_boolean.h"
 #include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/query_planner_test_fixture.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -333,6 +335,36 @@ TEST_F(QueryPlannerTest, CantUseCompound) {
     assertSolutionExists("{cscan: {dir: 1, filter: {y: 10}}}");
 }
 
+TEST_F(QueryPlannerTest, SkipScanUsesCompoundWithoutLeadingFieldPredicate) {
+    bool oldEnableSkipScan = internalQueryPlannerEnableSkipScan.load();
+    ON_BLOCK_EXIT(
+        [oldEnableSkipScan] { internalQueryPlannerEnableSkipScan.store(oldEnableSkipScan); });
+    internalQueryPlannerEnableSkipScan.store(true);
+
+    addIndex(BSON("x" << 1 << "y" << 1));
+    runQuery(fromjson("{y: {$gt: 10}}"));
+
+    assertNumSolutions(2U);
+    assertSolutionExists("{cscan: {dir: 1, filter: {y: {$gt: 10}}}}");
+    assertSolutionExists(
+        "{fetch: {node: {ixscan: {pattern: {x: 1, y: 1}, bounds: "
+        "{x: [['MinKey','MaxKey',true,true]], y: [[10,Infinity,false,true]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, SkipScanDoesNotUseMultikeyCompound) {
+    bool oldEnableSkipScan = internalQueryPlannerEnableSkipScan.load();
+    ON_BLOCK_EXIT(
+        [oldEnableSkipScan] { internalQueryPlannerEnableSkipScan.store(oldEnableSkipScan); });
+    internalQueryPlannerEnableSkipScan.store(true);
+
+    const bool multikey = true;
+    addIndex(BSON("x" << 1 << "y" << 1), multikey);
+    runQuery(fromjson("{y: 10}"));
+
+    ASSERT_EQUALS(getNumSolutions(), 1U);
+    assertSolutionExists("{cscan: {dir: 1, filter: {y: 10}}}");
+}
+
 
 //
 // Multikey indices
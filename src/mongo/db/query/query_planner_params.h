@@ -129,6 +129,10 @@ struct QueryPlannerParams {
         // Ensure that any plan generated returns data that is "owned." That is, all BSONObjs are
         // in an "owned" state and are not pointing to data that belongs to the storage engine.
         RETURN_OWNED_DATA = 1 << 14,
+
+        // Set if the collection is clustered by _id, so that collection scans can be bounded by
+        // predicates on _id.
+        IS_CLUSTERED = 1 << 15,
     };
 
     // See Options enum above.
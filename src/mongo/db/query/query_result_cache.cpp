@@ -0,0 +1,289 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/query_result_cache.h"
+
+#include "mongo/base/counter.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/concurrency/locker.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/service_context.h"
+#include "mongo/util/str.h"
+#include "mongo/util/text.h"
+
+namespace mongo {
+namespace {
+
+const auto getQueryResultCache = ServiceContext::declareDecoration<QueryResultCache>();
+
+Counter64 queryResultCacheHits;
+Counter64 queryResultCacheMisses;
+Counter64 queryResultCacheEvictions;
+
+ServerStatusMetricField<Counter64> queryResultCacheHitsDisplay("queryResultCache.hits",
+                                                               &queryResultCacheHits);
+ServerStatusMetricField<Counter64> queryResultCacheMissesDisplay("queryResultCache.misses",
+                                                                 &queryResultCacheMisses);
+ServerStatusMetricField<Counter64> queryResultCacheEvictionsDisplay("queryResultCache.evictions",
+                                                                    &queryResultCacheEvictions);
+
+// The stages which only depend on the documents they are given.
+const StringSet kDeterministicStages = {"$addFields",
+                                        "$bucket",
+                                        "$bucketAuto",
+                                        "$count",
+                                        "$facet",
+                                        "$group",
+                                        "$limit",
+                                        "$match",
+                                        "$project",
+                                        "$redact",
+                                        "$replaceRoot",
+                                        "$replaceWith",
+                                        "$set",
+                                        "$skip",
+                                        "$sort",
+                                        "$sortByCount",
+                                        "$unset",
+                                        "$unwind"};
+
+// The operators whose results may change from one run to the next.
+const StringSet kNonDeterministicOperators = {
+    "$accumulator", "$function", "$rand", "$sampleRate", "$where"};
+
+bool isDeterministicValue(const BSONElement& elem) {
+    if (kNonDeterministicOperators.count(elem.fieldNameStringData())) {
+        return false;
+    }
+    if (elem.type() == String) {
+        auto str = elem.valueStringData();
+        return !str.startsWith("$$NOW") && !str.startsWith("$$CLUSTER_TIME");
+    }
+    if (elem.isABSONObj()) {
+        for (auto&& child : elem.Obj()) {
+            if (!isDeterministicValue(child)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * Reports the number of results held by the cache and their size.
+ */
+class QueryResultCacheSizeMetric final : public ServerStatusMetric {
+public:
+    QueryResultCacheSizeMetric() : ServerStatusMetric("queryResultCache.size") {}
+
+    void appendAtLeaf(BSONObjBuilder& b) const final {
+        auto cache = QueryResultCache::get(getGlobalServiceContext());
+        BSONObjBuilder sizeBob(b.subobjStart(_leafName));
+        sizeBob.appendNumber("entries", static_cast<long long>(cache->getNumEntries()));
+        sizeBob.appendNumber("bytes", cache->getSizeBytes());
+        sizeBob.done();
+    }
+} queryResultCacheSize;
+
+}  // namespace
+
+QueryResultCache::QueryResultCache() {
+    for (auto&& ns : StringSplitter::split(internalQueryResultCacheNamespaces, ",")) {
+        if (!ns.empty()) {
+            _cachedNamespaces.insert(ns);
+        }
+    }
+}
+
+QueryResultCache* QueryResultCache::get(ServiceContext* serviceContext) {
+    return &getQueryResultCache(serviceContext);
+}
+
+bool QueryResultCache::isDeterministic(const std::vector<BSONObj>& pipeline, const BSONObj& let) {
+    for (auto&& stage : pipeline) {
+        auto stageSpec = stage.firstElement();
+        if (stage.nFields() != 1 || !kDeterministicStages.count(stageSpec.fieldNameStringData())) {
+            return false;
+        }
+        if (stageSpec.fieldNameStringData() == "$facet"_sd) {
+            if (stageSpec.type() != Object) {
+                return false;
+            }
+            for (auto&& facet : stageSpec.Obj()) {
+                if (facet.type() != Array) {
+                    return false;
+                }
+                std::vector<BSONObj> facetPipeline;
+                for (auto&& facetStage : facet.Obj()) {
+                    if (facetStage.type() != Object) {
+                        return false;
+                    }
+                    facetPipeline.push_back(facetStage.Obj());
+                }
+                if (!isDeterministic(facetPipeline, BSONObj())) {
+                    return false;
+                }
+            }
+        } else if (!isDeterministicValue(stageSpec)) {
+            return false;
+        }
+    }
+    for (auto&& variable : let) {
+        if (!isDeterministicValue(variable)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool QueryResultCache::isCachedNamespace(const NamespaceString& nss) const {
+    return !_cachedNamespaces.empty() && _cachedNamespaces.count(nss.ns());
+}
+
+QueryResultCache::Version QueryResultCache::getVersion(const NamespaceString& nss) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _getVersion(lk, nss.ns());
+}
+
+QueryResultCache::Version QueryResultCache::_getVersion(WithLock, StringData ns) const {
+    auto it = _versions.find(ns);
+    return it == _versions.end() ? _allVersion : std::max(it->second, _allVersion);
+}
+
+void QueryResultCache::onWrite(OperationContext* opCtx, const NamespaceString& nss) {
+    if (!isCachedNamespace(nss)) {
+        return;
+    }
+
+    auto bumpVersion = [this, ns = nss.ns()] {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _versions[ns] = ++_lastVersion;
+    };
+    if (!opCtx->lockState()->inAWriteUnitOfWork()) {
+        bumpVersion();
+        return;
+    }
+
+    // Readers which open their snapshot before the write commits see the old version, so the
+    // results they cache are never returned once the version is bumped.
+    opCtx->recoveryUnit()->onCommit(
+        [bumpVersion = std::move(bumpVersion)](boost::optional<Timestamp>) { bumpVersion(); });
+}
+
+void QueryResultCache::invalidateAll() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _allVersion = ++_lastVersion;
+    while (!_entries.empty()) {
+        _erase(lk, _entries.begin());
+    }
+}
+
+std::string QueryResultCache::makeCacheKey(const NamespaceString& nss, const BSONObj& key) {
+    return str::stream() << nss.ns() << '\0' << StringData(key.objdata(), key.objsize());
+}
+
+boost::optional<BSONObj> QueryResultCache::lookup(const NamespaceString& nss,
+                                                  const BSONObj& key) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto it = _entries.find(makeCacheKey(nss, key));
+    if (it == _entries.end()) {
+        queryResultCacheMisses.increment();
+        return boost::none;
+    }
+    if (it->second.version != _getVersion(lk, it->second.ns)) {
+        _erase(lk, it);
+        queryResultCacheMisses.increment();
+        return boost::none;
+    }
+
+    _lru.splice(_lru.begin(), _lru, it->second.lruPosition);
+    queryResultCacheHits.increment();
+    return it->second.result;
+}
+
+void QueryResultCache::insert(const NamespaceString& nss,
+                              const BSONObj& key,
+                              Version version,
+                              BSONObj result) {
+    auto cacheKey = makeCacheKey(nss, key);
+    const long long sizeBytes = cacheKey.size() + result.objsize();
+    const auto maxSizeBytes = internalQueryResultCacheMaxSizeBytes.load();
+    if (sizeBytes > maxSizeBytes) {
+        return;
+    }
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (version != _getVersion(lk, nss.ns())) {
+        // The namespace was written to while the result was computed.
+        return;
+    }
+    if (auto it = _entries.find(cacheKey); it != _entries.end()) {
+        _erase(lk, it);
+    }
+
+    _lru.push_front(cacheKey);
+    _entries.emplace(std::move(cacheKey),
+                     Entry{nss.ns(), version, result.getOwned(), sizeBytes, _lru.begin()});
+    _sizeBytes += sizeBytes;
+
+    while (_sizeBytes > maxSizeBytes) {
+        _erase(lk, _entries.find(_lru.back()));
+        queryResultCacheEvictions.increment();
+    }
+}
+
+void QueryResultCache::_erase(WithLock, stdx::unordered_map<std::string, Entry>::iterator it) {
+    _sizeBytes -= it->second.sizeBytes;
+    _lru.erase(it->second.lruPosition);
+    _entries.erase(it);
+}
+
+size_t QueryResultCache::getNumEntries() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _entries.size();
+}
+
+long long QueryResultCache::getSizeBytes() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _sizeBytes;
+}
+
+void QueryResultCache::setCachedNamespaces_forTest(const std::vector<NamespaceString>& namespaces) {
+    _cachedNamespaces.clear();
+    for (auto&& nss : namespaces) {
+        _cachedNamespaces.insert(nss.ns());
+    }
+}
+
+}  // namespace mongo
@@ -0,0 +1,148 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <list>
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/concurrency/with_lock.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+
+class OperationContext;
+class ServiceContext;
+
+/**
+ * Caches the results of the aggregations on the namespaces listed in
+ * 'internalQueryResultCacheNamespaces', so that repeating an aggregation returns the same reply
+ * without planning or executing it again.
+ *
+ * Every namespace has a version, which every committed write to it bumps. A cached result records
+ * the version of its namespace from before the aggregation read any data, and is only returned
+ * while the namespace is still at that version. The results are held up to a total of
+ * 'internalQueryResultCacheMaxSizeBytes', evicting the least recently used ones first.
+ */
+class QueryResultCache {
+    QueryResultCache(const QueryResultCache&) = delete;
+    QueryResultCache& operator=(const QueryResultCache&) = delete;
+
+public:
+    using Version = unsigned long long;
+
+    QueryResultCache();
+
+    static QueryResultCache* get(ServiceContext* serviceContext);
+
+    /**
+     * Returns true if the pipeline, and the 'let' variables it is run with, return the same results
+     * every time they run on the same data: every stage is one which only depends on its input, and
+     * no expression reads the clock, draws random numbers or runs JavaScript.
+     */
+    static bool isDeterministic(const std::vector<BSONObj>& pipeline, const BSONObj& let);
+
+    /**
+     * Returns true if the results of the aggregations on 'nss' are cached.
+     */
+    bool isCachedNamespace(const NamespaceString& nss) const;
+
+    /**
+     * Returns the current version of 'nss'. Must be called before the aggregation whose results
+     * are to be cached under it opens its storage snapshot.
+     */
+    Version getVersion(const NamespaceString& nss) const;
+
+    /**
+     * Registers a write to 'nss' by 'opCtx', which bumps the version of 'nss' once the write
+     * commits.
+     */
+    void onWrite(OperationContext* opCtx, const NamespaceString& nss);
+
+    /**
+     * Bumps the version of every namespace, for changes to the data which do not go through
+     * onWrite(), such as a rollback.
+     */
+    void invalidateAll();
+
+    /**
+     * Returns the result cached for 'key' on 'nss', if there is one and 'nss' has not been written
+     * to since it was cached.
+     */
+    boost::optional<BSONObj> lookup(const NamespaceString& nss, const BSONObj& key);
+
+    /**
+     * Caches 'result' for 'key' on 'nss', as of 'version' of 'nss'.
+     */
+    void insert(const NamespaceString& nss, const BSONObj& key, Version version, BSONObj result);
+
+    size_t getNumEntries() const;
+    long long getSizeBytes() const;
+
+    void setCachedNamespaces_forTest(const std::vector<NamespaceString>& namespaces);
+
+private:
+    struct Entry {
+        std::string ns;
+        Version version;
+        BSONObj result;
+        long long sizeBytes;
+        std::list<std::string>::iterator lruPosition;
+    };
+
+    static std::string makeCacheKey(const NamespaceString& nss, const BSONObj& key);
+
+    Version _getVersion(WithLock, StringData ns) const;
+    void _erase(WithLock, stdx::unordered_map<std::string, Entry>::iterator it);
+
+    // The namespaces whose results are cached. Only set at startup.
+    StringSet _cachedNamespaces;
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("QueryResultCache::_mutex");
+
+    // The version of each namespace which has been written to, and the version below which every
+    // namespace is out of date. Versions are handed out from '_lastVersion'.
+    StringMap<Version> _versions;
+    Version _allVersion = 0;
+    Version _lastVersion = 0;
+
+    // The cached results, with the most recently used keys at the front of '_lru'.
+    stdx::unordered_map<std::string, Entry> _entries;
+    std::list<std::string> _lru;
+    long long _sizeBytes = 0;
+};
+
+}  // namespace mongo
@@ -0,0 +1,153 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/query_result_cache.h"
+
+#include "mongo/bson/json.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/service_context_test_fixture.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kNss("test.coll");
+const NamespaceString kOtherNss("test.other");
+
+class QueryResultCacheTest : public ServiceContextTest {
+protected:
+    QueryResultCacheTest() {
+        cache()->setCachedNamespaces_forTest({kNss, kOtherNss});
+    }
+
+    QueryResultCache* cache() {
+        return QueryResultCache::get(getServiceContext());
+    }
+
+    std::vector<BSONObj> pipeline(const std::string& json) {
+        std::vector<BSONObj> stages;
+        for (auto&& stage : fromjson("{p: " + json + "}")["p"].Obj()) {
+            stages.push_back(stage.Obj().getOwned());
+        }
+        return stages;
+    }
+};
+
+TEST_F(QueryResultCacheTest, OnlyListedNamespacesAreCached) {
+    ASSERT_TRUE(cache()->isCachedNamespace(kNss));
+    ASSERT_FALSE(cache()->isCachedNamespace(NamespaceString("test.notCached")));
+}
+
+TEST_F(QueryResultCacheTest, CachedResultIsReturnedUntilTheNamespaceIsWrittenTo) {
+    auto opCtx = makeOperationContext();
+    const auto key = BSON("pipeline" << BSONArray());
+
+    ASSERT_FALSE(cache()->lookup(kNss, key));
+    cache()->insert(kNss, key, cache()->getVersion(kNss), BSON("n" << 1));
+    cache()->insert(kOtherNss, key, cache()->getVersion(kOtherNss), BSON("n" << 2));
+    ASSERT_BSONOBJ_EQ(BSON("n" << 1), *cache()->lookup(kNss, key));
+    ASSERT_BSONOBJ_EQ(BSON("n" << 2), *cache()->lookup(kOtherNss, key));
+
+    cache()->onWrite(opCtx.get(), kNss);
+    ASSERT_FALSE(cache()->lookup(kNss, key));
+    ASSERT_BSONOBJ_EQ(BSON("n" << 2), *cache()->lookup(kOtherNss, key));
+    ASSERT_EQ(1U, cache()->getNumEntries());
+
+    cache()->invalidateAll();
+    ASSERT_FALSE(cache()->lookup(kOtherNss, key));
+    ASSERT_EQ(0U, cache()->getNumEntries());
+    ASSERT_EQ(0, cache()->getSizeBytes());
+}
+
+TEST_F(QueryResultCacheTest, ResultComputedAcrossAWriteIsNotCached) {
+    auto opCtx = makeOperationContext();
+    const auto key = BSON("pipeline" << BSONArray());
+
+    const auto version = cache()->getVersion(kNss);
+    cache()->onWrite(opCtx.get(), kNss);
+    cache()->insert(kNss, key, version, BSON("n" << 1));
+    ASSERT_FALSE(cache()->lookup(kNss, key));
+    ASSERT_EQ(0U, cache()->getNumEntries());
+}
+
+TEST_F(QueryResultCacheTest, LeastRecentlyUsedResultsAreEvictedAboveTheMemoryLimit) {
+    const auto result = BSON("s" << std::string(100, 'x'));
+    const auto originalMaxSizeBytes = internalQueryResultCacheMaxSizeBytes.load();
+    ON_BLOCK_EXIT([&] { internalQueryResultCacheMaxSizeBytes.store(originalMaxSizeBytes); });
+    internalQueryResultCacheMaxSizeBytes.store(3 * result.objsize() + 100);
+
+    for (int i = 0; i < 3; ++i) {
+        cache()->insert(kNss, BSON("i" << i), cache()->getVersion(kNss), result);
+    }
+    ASSERT_EQ(3U, cache()->getNumEntries());
+
+    // Using the first result makes the second one the least recently used.
+    ASSERT_TRUE(cache()->lookup(kNss, BSON("i" << 0)));
+    cache()->insert(kNss, BSON("i" << 3), cache()->getVersion(kNss), result);
+    ASSERT_EQ(3U, cache()->getNumEntries());
+    ASSERT_LTE(cache()->getSizeBytes(), internalQueryResultCacheMaxSizeBytes.load());
+    ASSERT_TRUE(cache()->lookup(kNss, BSON("i" << 0)));
+    ASSERT_FALSE(cache()->lookup(kNss, BSON("i" << 1)));
+    ASSERT_TRUE(cache()->lookup(kNss, BSON("i" << 2)));
+    ASSERT_TRUE(cache()->lookup(kNss, BSON("i" << 3)));
+
+    // A result larger than the cache is not cached at all.
+    internalQueryResultCacheMaxSizeBytes.store(result.objsize());
+    cache()->insert(kNss, BSON("i" << 4), cache()->getVersion(kNss), result);
+    ASSERT_FALSE(cache()->lookup(kNss, BSON("i" << 4)));
+}
+
+TEST_F(QueryResultCacheTest, OnlyDeterministicPipelinesAreCached) {
+    ASSERT_TRUE(QueryResultCache::isDeterministic(
+        pipeline("[{$match: {x: 1}}, {$group: {_id: '$y', n: {$sum: 1}}}, {$sort: {n: -1}}]"),
+        BSONObj()));
+    ASSERT_TRUE(QueryResultCache::isDeterministic(
+        pipeline("[{$facet: {a: [{$count: 'n'}], b: [{$limit: 1}]}}]"), fromjson("{v: 1}")));
+
+    ASSERT_FALSE(QueryResultCache::isDeterministic(pipeline("[{$sample: {size: 1}}]"), BSONObj()));
+    ASSERT_FALSE(QueryResultCache::isDeterministic(
+        pipeline("[{$lookup: {from: 'other', as: 'o', pipeline: []}}]"), BSONObj()));
+    ASSERT_FALSE(QueryResultCache::isDeterministic(
+        pipeline("[{$project: {r: {$rand: {}}}}]"), BSONObj()));
+    ASSERT_FALSE(QueryResultCache::isDeterministic(
+        pipeline("[{$addFields: {t: '$$NOW'}}]"), BSONObj()));
+    ASSERT_FALSE(QueryResultCache::isDeterministic(
+        pipeline("[{$match: {$expr: {$lt: ['$t', '$$CLUSTER_TIME']}}}]"), BSONObj()));
+    ASSERT_FALSE(QueryResultCache::isDeterministic(
+        pipeline("[{$facet: {a: [{$sample: {size: 1}}]}}]"), BSONObj()));
+    ASSERT_FALSE(QueryResultCache::isDeterministic(pipeline("[{$match: {x: 1}}]"),
+                                                   fromjson("{t: '$$NOW'}")));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -167,6 +167,14 @@ void QuerySolution::setRoot(std::unique_ptr<QuerySolutionNode> root) {
     assignNodeIds(idGenerator, *_root);
 }
 
+void QuerySolution::extendWith(std::unique_ptr<QuerySolutionNode> extensionRoot) {
+    invariant(_root);
+    invariant(extensionRoot->children.empty());
+
+    extensionRoot->children.push_back(_root.release());
+    setRoot(std::move(extensionRoot));
+}
+
 //
 // TextNode
 //
@@ -188,6 +196,10 @@ void TextNode::appendToString(str::stream* ss, int indent) const {
     *ss << "diacriticSensitive= " << ftsQuery->getDiacriticSensitive() << '\n';
     addIndent(ss, indent + 1);
     *ss << "indexPrefix = " << indexPrefix.toString() << '\n';
+    if (topK) {
+        addIndent(ss, indent + 1);
+        *ss << "topK = " << topK << '\n';
+    }
     if (nullptr != filter) {
         addIndent(ss, indent + 1);
         *ss << " filter = " << filter->debugString();
@@ -201,6 +213,7 @@ QuerySolutionNode* TextNode::clone() const {
 
     copy->ftsQuery = this->ftsQuery->clone();
     copy->indexPrefix = this->indexPrefix;
+    copy->topK = this->topK;
 
     return copy;
 }
@@ -1194,6 +1207,10 @@ void GeoNear2DNode::appendToString(str::stream* ss, int indent) const {
     *ss << "keyPattern = " << index.keyPattern.toString() << '\n';
     addCommon(ss, indent);
     *ss << "nearQuery = " << nq->toString() << '\n';
+    if (limit) {
+        addIndent(ss, indent + 1);
+        *ss << "limit = " << limit << '\n';
+    }
     if (nullptr != filter) {
         addIndent(ss, indent + 1);
         *ss << " filter = " << filter->debugString();
@@ -1208,6 +1225,7 @@ QuerySolutionNode* GeoNear2DNode::clone() const {
     copy->baseBounds = this->baseBounds;
     copy->addPointMeta = this->addPointMeta;
     copy->addDistMeta = this->addDistMeta;
+    copy->limit = this->limit;
 
     return copy;
 }
@@ -1227,6 +1245,10 @@ void GeoNear2DSphereNode::appendToString(str::stream* ss, int indent) const {
     *ss << "baseBounds = " << baseBounds.toString() << '\n';
     addIndent(ss, indent + 1);
     *ss << "nearQuery = " << nq->toString() << '\n';
+    if (limit) {
+        addIndent(ss, indent + 1);
+        *ss << "limit = " << limit << '\n';
+    }
     if (nullptr != filter) {
         addIndent(ss, indent + 1);
         *ss << " filter = " << filter->debugString();
@@ -1241,6 +1263,7 @@ QuerySolutionNode* GeoNear2DSphereNode::clone() const {
     copy->baseBounds = this->baseBounds;
     copy->addPointMeta = this->addPointMeta;
     copy->addDistMeta = this->addDistMeta;
+    copy->limit = this->limit;
 
     return copy;
 }
@@ -1374,4 +1397,30 @@ QuerySolutionNode* EofNode::clone() const {
     return copy;
 }
 
+//
+// GroupNode
+//
+
+void GroupNode::appendToString(str::stream* ss, int indent) const {
+    addIndent(ss, indent);
+    *ss << "GROUP\n";
+    addIndent(ss, indent + 1);
+    *ss << "key = " << groupByExpression->serialize(false).toString() << '\n';
+    for (auto&& acc : accumulators) {
+        addIndent(ss, indent + 1);
+        *ss << acc.fieldName << " = {" << acc.op << ": "
+            << acc.argument->serialize(false).toString() << "}\n";
+    }
+    addCommon(ss, indent);
+    addIndent(ss, indent + 1);
+    *ss << "Child:" << '\n';
+    children[0]->appendToString(ss, indent + 2);
+}
+
+QuerySolutionNode* GroupNode::clone() const {
+    auto copy = new GroupNode(groupByExpression, accumulators, allowDiskUse);
+    cloneBaseData(copy);
+    return copy;
+}
+
 }  // namespace mongo
@@ -36,6 +36,7 @@
 #include "mongo/db/fts/fts_query.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression.h"
+#include "mongo/db/query/canonical_query.h"
 #include "mongo/db/query/index_bounds.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/plan_enumerator_explain_info.h"
@@ -362,6 +363,12 @@ public:
      */
     void setRoot(std::unique_ptr<QuerySolutionNode> root);
 
+    /**
+     * Makes the current root of this QuerySolution the only child of 'extensionRoot', which must
+     * not have any children, and makes 'extensionRoot' the new root of this QuerySolution.
+     */
+    void extendWith(std::unique_ptr<QuerySolutionNode> extensionRoot);
+
     /**
      * Returns true if the execution plan which is constructed from this QuerySolution should check
      * that the node is eligible to serve reads prior to actually performing any reads.
@@ -443,6 +450,10 @@ struct TextNode : public QuerySolutionNodeWithSortSet {
     // text node while creating the text leaf node and convert them into a BSONObj index prefix
     // when we finish the text leaf node.
     BSONObj indexPrefix;
+
+    // When not zero, the results are only sorted by their text score and limited to this many
+    // documents, so the TEXT stage only needs the 'topK' best scored documents.
+    size_t topK = 0;
 };
 
 struct CollectionScanNode : public QuerySolutionNodeWithSortSet {
@@ -1074,6 +1085,10 @@ struct GeoNear2DNode : public QuerySolutionNodeWithSortSet {
     IndexEntry index;
     bool addPointMeta;
     bool addDistMeta;
+
+    // When not zero, the results are limited to this many documents, so only the 'limit' nearest
+    // documents are needed.
+    size_t limit = 0;
 };
 
 struct GeoNear2DSphereNode : public QuerySolutionNodeWithSortSet {
@@ -1106,6 +1121,10 @@ struct GeoNear2DSphereNode : public QuerySolutionNodeWithSortSet {
     IndexEntry index;
     bool addPointMeta;
     bool addDistMeta;
+
+    // When not zero, the results are limited to this many documents, so only the 'limit' nearest
+    // documents are needed.
+    size_t limit = 0;
 };
 
 //
@@ -1278,4 +1297,41 @@ struct EofNode : public QuerySolutionNodeWithSortSet {
 
     QuerySolutionNode* clone() const;
 };
+
+/**
+ * Groups the documents produced by its child according to a $group stage which was pushed down
+ * from an aggregation pipeline. Outputs one document per group, in no particular order.
+ */
+struct GroupNode : public QuerySolutionNodeWithSortSet {
+    GroupNode(boost::intrusive_ptr<Expression> groupByExpression,
+              std::vector<CanonicalQuery::GroupPushdown::Accumulator> accumulators,
+              bool allowDiskUse)
+        : groupByExpression(std::move(groupByExpression)),
+          accumulators(std::move(accumulators)),
+          allowDiskUse(allowDiskUse) {}
+
+    virtual StageType getType() const {
+        return STAGE_GROUP;
+    }
+
+    virtual void appendToString(str::stream* ss, int indent) const;
+
+    bool fetched() const {
+        return true;
+    }
+
+    FieldAvailability getFieldAvailability(const std::string& field) const {
+        return FieldAvailability::kFullyProvided;
+    }
+
+    bool sortedByDiskLoc() const {
+        return false;
+    }
+
+    QuerySolutionNode* clone() const;
+
+    boost::intrusive_ptr<Expression> groupByExpression;
+    std::vector<CanonicalQuery::GroupPushdown::Accumulator> accumulators;
+    bool allowDiskUse;
+};
 }  // namespace mongo
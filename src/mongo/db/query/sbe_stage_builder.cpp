@@ -52,12 +52,17 @@
 #include "mongo/db/fts/fts_query_impl.h"
 #include "mongo/db/fts/fts_spec.h"
 #include "mongo/db/index/fts_access_method.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/query/query_request_helper.h"
 #include "mongo/db/query/sbe_stage_builder_coll_scan.h"
+#include "mongo/db/query/sbe_stage_builder_expression.h"
 #include "mongo/db/query/sbe_stage_builder_filter.h"
 #include "mongo/db/query/sbe_stage_builder_helpers.h"
 #include "mongo/db/query/sbe_stage_builder_index_scan.h"
 #include "mongo/db/query/sbe_stage_builder_projection.h"
+#include "mongo/db/query/shard_filter_bounds.h"
 #include "mongo/db/query/util/make_data_structure.h"
+#include "mongo/db/repl/read_concern_args.h"
 #include "mongo/db/s/collection_sharding_state.h"
 
 namespace mongo::stage_builder {
@@ -216,6 +221,15 @@ PlanStageSlots::PlanStageSlots(const PlanStageReqs& reqs,
     }
 }
 
+PlanStageData PlanStageData::makeCopy() const {
+    PlanStageData copy{env->makeDeepCopy()};
+    copy.outputs = outputs;
+    copy.shouldTrackLatestOplogTimestamp = shouldTrackLatestOplogTimestamp;
+    copy.shouldTrackResumeToken = shouldTrackResumeToken;
+    copy.shouldUseTailableScan = shouldUseTailableScan;
+    return copy;
+}
+
 std::string PlanStageData::debugString() const {
     StringBuilder builder;
 
@@ -249,6 +263,44 @@ const QuerySolutionNode* getNodeByType(const QuerySolutionNode* root, StageType
     return nullptr;
 }
 
+/**
+ * Returns the number of producer threads the collection scan 'csn' should be split across, or 1 if
+ * it must run as a regular scan. A parallel scan returns documents in no particular order, and every
+ * producer reads from its own storage snapshot without yielding, so it's only used for plain
+ * forward scans which don't need to follow the natural order, run with the "local" read concern
+ * and are not a part of a multi-document transaction.
+ */
+size_t getParallelScanDegree(OperationContext* opCtx,
+                             const CanonicalQuery& cq,
+                             const CollectionScanNode* csn,
+                             bool isTailableResumeBranch) {
+    const size_t degree = internalQuerySlotBasedExecutionParallelScanDegree.load();
+    if (degree <= 1) {
+        return 1;
+    }
+
+    if (csn->direction != CollectionScanParams::FORWARD || csn->tailable ||
+        isTailableResumeBranch || csn->resumeAfterRecordId || csn->requestResumeToken ||
+        csn->shouldTrackLatestOplogTimestamp || csn->shouldWaitForOplogVisibility ||
+        csn->minRecord || csn->maxRecord) {
+        return 1;
+    }
+
+    const auto& findCommand = cq.getFindCommand();
+    if (findCommand.getHint()[query_request_helper::kNaturalSortField] ||
+        findCommand.getSort()[query_request_helper::kNaturalSortField]) {
+        return 1;
+    }
+
+    if (opCtx->inMultiDocumentTransaction() ||
+        repl::ReadConcernArgs::get(opCtx).getLevel() !=
+            repl::ReadConcernLevel::kLocalReadConcern) {
+        return 1;
+    }
+
+    return degree;
+}
+
 sbe::LockAcquisitionCallback makeLockAcquisitionCallback(bool checkNodeCanServeReads) {
     if (!checkNodeCanServeReads) {
         return {};
@@ -331,7 +383,12 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
                                              _yieldPolicy,
                                              _data.env,
                                              reqs.getIsTailableCollScanResumeBranch(),
-                                             _lockAcquisitionCallback);
+                                             _lockAcquisitionCallback,
+                                             getParallelScanDegree(
+                                                 _opCtx,
+                                                 _cq,
+                                                 csn,
+                                                 reqs.getIsTailableCollScanResumeBranch()));
 
     if (reqs.has(kReturnKey)) {
         // Assign the 'returnKeySlot' to be the empty object.
@@ -1234,13 +1291,22 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
         outputs.set(kResult, innerResultSlot);
     }
 
+    // The build side of a hash join could previously grow without bounds, so a memory limit is only
+    // imposed when the join can fall back to spilling to disk.
+    const bool allowDiskUse = _cq.getExpCtx()->allowDiskUse;
+    const size_t memoryLimit = allowDiskUse
+        ? static_cast<size_t>(internalQuerySlotBasedExecutionHashJoinMaxMemoryBytes.load())
+        : std::numeric_limits<size_t>::max();
+
     auto hashJoinStage = sbe::makeS<sbe::HashJoinStage>(std::move(outerStage),
                                                         std::move(innerStage),
                                                         outerCondSlots,
                                                         outerProjectSlots,
                                                         innerCondSlots,
                                                         innerProjectSlots,
-                                                        root->nodeId());
+                                                        root->nodeId(),
+                                                        allowDiskUse,
+                                                        memoryLimit);
 
     // If there are more than 2 children, iterate all remaining children and hash
     // join together.
@@ -1259,12 +1325,124 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
                                                        projectSlots,
                                                        innerCondSlots,
                                                        innerProjectSlots,
-                                                       root->nodeId());
+                                                       root->nodeId(),
+                                                       allowDiskUse,
+                                                       memoryLimit);
     }
 
     return {std::move(hashJoinStage), std::move(outputs)};
 }
 
+std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder::buildGroup(
+    const QuerySolutionNode* root, const PlanStageReqs& reqs) {
+    using namespace std::literals;
+    invariant(!reqs.getIndexKeyBitset());
+    tassert(5591710,
+            "A pushed down $group can only produce the result document",
+            !reqs.has(kRecordId) && !reqs.has(kOplogTs));
+
+    const auto gn = static_cast<const GroupNode*>(root);
+    const auto nodeId = root->nodeId();
+
+    // The $group consumes whole documents, so the child only has to produce a 'resultSlot'.
+    PlanStageReqs childReqs;
+    childReqs.set(kResult);
+    auto [childStage, childOutputs] = build(gn->children[0], childReqs);
+    auto stage = std::move(childStage);
+    const auto inputSlot = childOutputs.get(kResult);
+
+    // Evaluates 'expr' against the input document, shapes the result with 'shapeFn' and binds it
+    // to a new slot. The slots bound so far are forwarded through any stage the expression needs.
+    auto relevantSlots = sbe::makeSV(inputSlot);
+    auto projectExpression = [&](Expression* expr, auto&& shapeFn) {
+        auto [_, sbeExpr, exprStage] = generateExpression(_opCtx,
+                                                          expr,
+                                                          std::move(stage),
+                                                          &_slotIdGenerator,
+                                                          &_frameIdGenerator,
+                                                          inputSlot,
+                                                          _data.env,
+                                                          nodeId,
+                                                          &relevantSlots);
+        auto slot = _slotIdGenerator.generate();
+        stage =
+            sbe::makeProjectStage(std::move(exprStage), nodeId, slot, shapeFn(std::move(sbeExpr)));
+        relevantSlots.push_back(slot);
+        return slot;
+    };
+    auto identity = [](std::unique_ptr<sbe::EExpression> expr) { return expr; };
+
+    // A missing group key forms the same group as null, as in DocumentSourceGroup.
+    auto groupBySlot = projectExpression(gn->groupByExpression.get(), makeFillEmptyNull);
+
+    sbe::value::SlotMap<std::unique_ptr<sbe::EExpression>> aggs;
+    std::vector<std::unique_ptr<sbe::EExpression>> finalExprs;
+    for (auto&& acc : gn->accumulators) {
+        auto aggSlot = _slotIdGenerator.generate();
+        if (acc.op == "$first" || acc.op == "$last") {
+            // Unlike the SBE aggregate functions, $first and $last don't skip missing values.
+            auto argSlot = projectExpression(acc.argument.get(), makeFillEmptyNull);
+            auto aggName = acc.op == "$first" ? "first"sv : "last"sv;
+            aggs.emplace(aggSlot, makeFunction(aggName, makeVariable(argSlot)));
+            finalExprs.push_back(makeVariable(aggSlot));
+        } else if (acc.op == "$min" || acc.op == "$max") {
+            // $min and $max ignore null and missing values, and return null if there are no others.
+            auto argSlot = projectExpression(acc.argument.get(), [&](auto expr) {
+                return makeLocalBind(
+                    &_frameIdGenerator,
+                    [](sbe::EVariable arg) {
+                        return sbe::makeE<sbe::EIf>(
+                            generateNullOrMissing(arg),
+                            sbe::makeE<sbe::EConstant>(sbe::value::TypeTags::Nothing, 0),
+                            arg.clone());
+                    },
+                    std::move(expr));
+            });
+            auto aggName = acc.op == "$min" ? "min"sv : "max"sv;
+            aggs.emplace(aggSlot, makeFunction(aggName, makeVariable(argSlot)));
+            finalExprs.push_back(makeFillEmptyNull(makeVariable(aggSlot)));
+        } else {
+            // Only a $sum of a constant integer is pushed down, which sums to an integer like
+            // DocumentSourceGroup does, unless it doesn't fit into one.
+            auto constant = dynamic_cast<ExpressionConstant*>(acc.argument.get());
+            tassert(5591711,
+                    str::stream() << "Unsupported pushed down accumulator: " << acc.op,
+                    acc.op == "$sum" && constant &&
+                        constant->getValue().getType() == BSONType::NumberInt);
+            auto argSlot = projectExpression(acc.argument.get(), identity);
+            aggs.emplace(aggSlot, makeFunction("sum", makeVariable(argSlot)));
+            finalExprs.push_back(makeFunction(
+                "fillEmpty",
+                sbe::makeE<sbe::ENumericConvert>(makeVariable(aggSlot),
+                                                 sbe::value::TypeTags::NumberInt32),
+                makeVariable(aggSlot)));
+        }
+    }
+
+    stage = sbe::makeS<sbe::HashAggStage>(std::move(stage),
+                                          sbe::makeSV(groupBySlot),
+                                          std::move(aggs),
+                                          nodeId,
+                                          gn->allowDiskUse,
+                                          internalDocumentSourceGroupMaxMemoryBytes.load());
+
+    // Assemble the output document of each group from the group key and the accumulated values.
+    auto newObjArgs = sbe::makeEs(makeConstant("_id"), makeVariable(groupBySlot));
+    for (size_t idx = 0; idx < gn->accumulators.size(); ++idx) {
+        newObjArgs.push_back(makeConstant(gn->accumulators[idx].fieldName));
+        newObjArgs.push_back(std::move(finalExprs[idx]));
+    }
+    auto resultSlot = _slotIdGenerator.generate();
+    stage = sbe::makeProjectStage(std::move(stage),
+                                  nodeId,
+                                  resultSlot,
+                                  sbe::makeE<sbe::EFunction>("newObj", std::move(newObjArgs)));
+
+    PlanStageSlots outputs;
+    outputs.set(kResult, resultSlot);
+    return {std::move(stage), std::move(outputs)};
+}
+
 std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots>
 SlotBasedStageBuilder::makeUnionForTailableCollScan(const QuerySolutionNode* root,
                                                     const PlanStageReqs& reqs) {
@@ -1429,6 +1607,13 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
     // the shard, we need to own a 'ShardFilterer', and extract the document's shard key as a
     // BSONObj.
     auto shardFilterer = _shardFiltererFactory->makeShardFilterer(_opCtx);
+
+    // There is nothing to filter out if the index bounds only cover owned chunks.
+    if (internalQueryElideShardFilterForOwnedIndexBounds.load() &&
+        indexBoundsBelongToShard(filterNode->children[0], *shardFilterer)) {
+        return build(filterNode->children[0], reqs);
+    }
+
     auto shardKeyPattern = shardFilterer->getKeyPattern().toBSON();
 
     // Determine if our child is an index scan and extract it's key pattern, or empty BSONObj if our
@@ -1554,6 +1739,7 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
             {STAGE_EOF, &SlotBasedStageBuilder::buildEof},
             {STAGE_AND_HASH, &SlotBasedStageBuilder::buildAndHash},
             {STAGE_SORT_MERGE, &SlotBasedStageBuilder::buildSortMerge},
+            {STAGE_GROUP, &SlotBasedStageBuilder::buildGroup},
             {STAGE_SHARDING_FILTER, &SlotBasedStageBuilder::buildShardFilter}};
 
     tassert(4822884,
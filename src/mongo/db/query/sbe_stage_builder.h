@@ -225,6 +225,12 @@ struct PlanStageData {
 
     std::string debugString() const;
 
+    /**
+     * Makes a copy of this data with its own copy of the runtime environment, to go along with a
+     * clone of the plan stage tree this data was built for.
+     */
+    PlanStageData makeCopy() const;
+
     // This holds the output slots produced by SBE plan (resultSlot, recordIdSlot, etc).
     PlanStageSlots outputs;
 
@@ -316,6 +322,9 @@ private:
     std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> buildAndHash(
         const QuerySolutionNode* root, const PlanStageReqs& reqs);
 
+    std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> buildGroup(
+        const QuerySolutionNode* root, const PlanStageReqs& reqs);
+
     std::tuple<sbe::value::SlotId, sbe::value::SlotId, std::unique_ptr<sbe::PlanStage>>
     makeLoopJoinForFetch(std::unique_ptr<sbe::PlanStage> inputStage,
                          sbe::value::SlotId recordIdSlot,
@@ -42,6 +42,7 @@
 #include "mongo/db/exec/sbe/stages/project.h"
 #include "mongo/db/exec/sbe/stages/scan.h"
 #include "mongo/db/exec/sbe/stages/union.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/sbe_stage_builder.h"
 #include "mongo/db/query/sbe_stage_builder_filter.h"
 #include "mongo/db/query/sbe_stage_builder_helpers.h"
@@ -412,7 +413,8 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateGenericCollSc
     PlanYieldPolicy* yieldPolicy,
     sbe::RuntimeEnvironment* env,
     bool isTailableResumeBranch,
-    sbe::LockAcquisitionCallback lockAcquisitionCallback) {
+    sbe::LockAcquisitionCallback lockAcquisitionCallback,
+    size_t degreeOfParallelism) {
     const auto forward = csn->direction == CollectionScanParams::FORWARD;
 
     invariant(!csn->shouldTrackLatestOplogTimestamp || collection->ns().isOplog());
@@ -436,18 +438,42 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateGenericCollSc
     auto&& [fields, slots, tsSlot] = makeOplogTimestampSlotsIfNeeded(
         collection, slotIdGenerator, csn->shouldTrackLatestOplogTimestamp);
 
+    // Block mode is only available for plain scans which don't need to seek, to observe the cursor
+    // on open, or to tail a capped collection.
+    auto openCallback = makeOpenCallbackIfNeeded(collection, csn);
+    const size_t blockSize = (seekRecordIdSlot || openCallback || csn->tailable)
+        ? 1
+        : internalQuerySlotBasedExecutionScanBlockSize.load();
+
     NamespaceStringOrUUID nss{collection->ns().db().toString(), collection->uuid()};
-    auto stage = sbe::makeS<sbe::ScanStage>(nss,
-                                            resultSlot,
-                                            recordIdSlot,
-                                            std::move(fields),
-                                            std::move(slots),
-                                            seekRecordIdSlot,
-                                            forward,
-                                            yieldPolicy,
-                                            csn->nodeId(),
-                                            lockAcquisitionCallback,
-                                            makeOpenCallbackIfNeeded(collection, csn));
+    std::unique_ptr<sbe::PlanStage> stage;
+    if (degreeOfParallelism > 1) {
+        invariant(forward && !seekRecordIdSlot && !openCallback && !csn->tailable && !tsSlot);
+
+        // The producers run on their own threads and OperationContexts, so they can't share the
+        // yield policy of this plan. The range scans check whether the node can serve reads on
+        // their own.
+        stage = sbe::makeS<sbe::ParallelScanStage>(nss,
+                                                   resultSlot,
+                                                   recordIdSlot,
+                                                   std::move(fields),
+                                                   std::move(slots),
+                                                   nullptr,
+                                                   csn->nodeId());
+    } else {
+        stage = sbe::makeS<sbe::ScanStage>(nss,
+                                           resultSlot,
+                                           recordIdSlot,
+                                           std::move(fields),
+                                           std::move(slots),
+                                           seekRecordIdSlot,
+                                           forward,
+                                           yieldPolicy,
+                                           csn->nodeId(),
+                                           lockAcquisitionCallback,
+                                           std::move(openCallback),
+                                           blockSize);
+    }
 
     // Check if the scan should be started after the provided resume RecordId and construct a nested
     // loop join sub-tree to project out the resume RecordId as a seekRecordIdSlot and feed it to
@@ -541,6 +567,18 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateGenericCollSc
                                                       csn->nodeId());
     }
 
+    if (degreeOfParallelism > 1) {
+        // Gather the documents produced by all range scans, including the filter evaluated on the
+        // producer threads, into the thread running this plan.
+        stage = sbe::makeS<sbe::ExchangeConsumer>(std::move(stage),
+                                                  degreeOfParallelism,
+                                                  sbe::makeSV(resultSlot, recordIdSlot),
+                                                  sbe::ExchangePolicy::roundrobin,
+                                                  nullptr,
+                                                  nullptr,
+                                                  csn->nodeId());
+    }
+
     PlanStageSlots outputs;
     outputs.set(PlanStageSlots::kResult, resultSlot);
     outputs.set(PlanStageSlots::kRecordId, recordIdSlot);
@@ -562,8 +600,11 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateCollScan(
     PlanYieldPolicy* yieldPolicy,
     sbe::RuntimeEnvironment* env,
     bool isTailableResumeBranch,
-    sbe::LockAcquisitionCallback lockAcquisitionCallback) {
-    if (csn->minRecord || csn->maxRecord) {
+    sbe::LockAcquisitionCallback lockAcquisitionCallback,
+    size_t degreeOfParallelism) {
+    // Collection scans over collections clustered by _id may also carry record bounds. They are
+    // only an optimization, so such scans fall back to an unbounded generic scan with the filter.
+    if ((csn->minRecord || csn->maxRecord) && collection->ns().isOplog()) {
         return generateOptimizedOplogScan(opCtx,
                                           collection,
                                           csn,
@@ -582,7 +623,8 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateCollScan(
                                        yieldPolicy,
                                        env,
                                        isTailableResumeBranch,
-                                       std::move(lockAcquisitionCallback));
+                                       std::move(lockAcquisitionCallback),
+                                       degreeOfParallelism);
     }
 }
 }  // namespace mongo::stage_builder
@@ -49,6 +49,10 @@ class PlanStageSlots;
  *     were requested to track this data.
  *   * A generated PlanStage sub-tree.
  *
+ * If 'degreeOfParallelism' is greater than 1, the scan is split into that many parallel scans
+ * running on producer threads, whose results are gathered by an exchange. The caller is responsible
+ * for checking that the scan is eligible for this.
+ *
  * In cases of an error, throws.
  */
 std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateCollScan(
@@ -60,6 +64,7 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateCollScan(
     PlanYieldPolicy* yieldPolicy,
     sbe::RuntimeEnvironment* env,
     bool isTailableResumeBranch,
-    sbe::LockAcquisitionCallback lockAcquisitionCallback);
+    sbe::LockAcquisitionCallback lockAcquisitionCallback,
+    size_t degreeOfParallelism);
 
 }  // namespace mongo::stage_builder
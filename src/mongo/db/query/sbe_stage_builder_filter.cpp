@@ -73,6 +73,7 @@
 #include "mongo/db/matcher/schema/expression_internal_schema_xor.h"
 #include "mongo/db/query/sbe_stage_builder_eval_frame.h"
 #include "mongo/db/query/sbe_stage_builder_expression.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/sbe_stage_builder_helpers.h"
 #include "mongo/util/str.h"
 
@@ -109,6 +110,15 @@ void projectCurrentExprToOutputSlot(MatchExpressionVisitorContext* context);
 using MakePredicateFn =
     std::function<EvalExprStagePair(sbe::value::SlotId inputSlot, EvalStage inputStage)>;
 
+/**
+ * A function of this type can be called to generate an EExpression which applies a predicate both
+ * to the value found in 'inputSlot' and, if it is an array, to each of its elements, and returns
+ * true if any of them matches. Such an expression lets the last level of a path be matched without
+ * a TraverseStage, which runs the predicate once per array element.
+ */
+using MakeArrayPredicateFn =
+    std::function<std::unique_ptr<sbe::EExpression>(sbe::value::SlotId inputSlot)>;
+
 /**
  * A struct for storing context across calls to visit() methods in MatchExpressionVisitor's.
  */
@@ -322,6 +332,7 @@ EvalExprStagePair generatePathTraversal(EvalStage inputStage,
                                         sbe::value::SlotIdGenerator* slotIdGenerator,
                                         sbe::value::FrameIdGenerator* frameIdGenerator,
                                         const MakePredicateFn& makePredicate,
+                                        const MakeArrayPredicateFn& makeArrayPredicate,
                                         LeafTraversalMode mode,
                                         const FilterStateHelper& stateHelper) {
     using namespace std::literals;
@@ -348,6 +359,12 @@ EvalExprStagePair generatePathTraversal(EvalStage inputStage,
         return makePredicate(fieldSlot, std::move(fromBranch));
     }
 
+    if (isLeafField && mode == LeafTraversalMode::kArrayAndItsElements && makeArrayPredicate &&
+        !stateHelper.stateContainsValue()) {
+        // The predicate is applied to the array and its elements in a single expression.
+        return {stateHelper.makeState(makeArrayPredicate(fieldSlot)), std::move(fromBranch)};
+    }
+
     // Generate the 'in' branch for the TraverseStage that we're about to construct.
     auto [innerExpr, innerBranch] = isLeafField
         // Base case: Evaluate the predicate. Predicate returns boolean value, we need to convert it
@@ -362,6 +379,7 @@ EvalExprStagePair generatePathTraversal(EvalStage inputStage,
                                 slotIdGenerator,
                                 frameIdGenerator,
                                 makePredicate,
+                                makeArrayPredicate,
                                 mode,
                                 stateHelper);
 
@@ -450,13 +468,15 @@ EvalExprStagePair generatePathTraversal(EvalStage inputStage,
  * function generates a sequence of nested traverse operators to traverse the field path and it uses
  * 'makePredicate' to generate an SBE expression for evaluating the predicate on individual value.
  * When 'path' is empty, this function simply uses 'makePredicate' to generate an SBE expression for
- * evaluating the predicate on a single value.
+ * evaluating the predicate on a single value. If 'makeArrayPredicate' is given, it is used instead
+ * of the traversal of the last level of the path.
  */
 void generatePredicate(MatchExpressionVisitorContext* context,
                        const FieldRef* path,
                        MakePredicateFn makePredicate,
                        LeafTraversalMode mode = LeafTraversalMode::kArrayAndItsElements,
-                       bool useCombinator = true) {
+                       bool useCombinator = true,
+                       MakeArrayPredicateFn makeArrayPredicate = nullptr) {
     auto& frame = context->evalStack.topFrame();
 
     auto&& [expr, stage] = [&]() {
@@ -470,6 +490,7 @@ void generatePredicate(MatchExpressionVisitorContext* context,
                                              context->slotIdGenerator,
                                              context->frameIdGenerator,
                                              makePredicate,
+                                             makeArrayPredicate,
                                              mode,
                                              context->stateHelper);
             } else {
@@ -585,6 +606,78 @@ void generateArraySize(MatchExpressionVisitorContext* context,
  * Generates a path traversal SBE plan stage sub-tree which implements the comparison match
  * expression 'expr'. The comparison itself executes using the given 'binaryOp'.
  */
+/**
+ * Returns whether the comparison 'expr' can be applied to the elements of an array by the
+ * 'traverseCompare' builtin. Comparisons to MinKey, MaxKey, null and NaN have semantics of their
+ * own, see 'generateComparison'.
+ */
+bool canTraverseInBuiltin(const MatchExpression* expr) {
+    switch (expr->matchType()) {
+        case MatchExpression::EQ:
+        case MatchExpression::LT:
+        case MatchExpression::LTE:
+        case MatchExpression::GT:
+        case MatchExpression::GTE:
+            break;
+        default:
+            return false;
+    }
+    if (!internalQuerySlotBasedExecutionTraverseArraysInBuiltins.load()) {
+        return false;
+    }
+
+    const auto& rhs = static_cast<const ComparisonMatchExpression*>(expr)->getData();
+    auto [tag, val] = sbe::bson::convertFrom(
+        true, rhs.rawdata(), rhs.rawdata() + rhs.size(), rhs.fieldNameSize() - 1);
+    return tag != sbe::value::TypeTags::MinKey && tag != sbe::value::TypeTags::MaxKey &&
+        tag != sbe::value::TypeTags::Null && !sbe::value::isNaN(tag, val);
+}
+
+/**
+ * Generates a call of the 'traverseCompare' builtin, which tests whether the value in 'inputSlot'
+ * or one of its elements satisfies all of 'comparisons'. With 'elementsOnly', only the elements
+ * are tested, as for $elemMatch.
+ */
+std::unique_ptr<sbe::EExpression> makeTraverseCompare(
+    sbe::value::SlotId inputSlot,
+    bool elementsOnly,
+    const std::vector<const ComparisonMatchExpression*>& comparisons,
+    sbe::RuntimeEnvironment* env) {
+    auto collatorSlot = env->getSlotIfExists("collator"_sd);
+
+    auto args = sbe::makeEs(makeVariable(inputSlot),
+                            makeConstant(sbe::value::TypeTags::Boolean, elementsOnly),
+                            collatorSlot ? makeVariable(*collatorSlot)
+                                         : makeConstant(sbe::value::TypeTags::Nothing, 0));
+    for (auto&& comparison : comparisons) {
+        auto op = [&] {
+            switch (comparison->matchType()) {
+                case MatchExpression::EQ:
+                    return sbe::vm::TraverseCompareOp::eq;
+                case MatchExpression::LT:
+                    return sbe::vm::TraverseCompareOp::less;
+                case MatchExpression::LTE:
+                    return sbe::vm::TraverseCompareOp::lessEq;
+                case MatchExpression::GT:
+                    return sbe::vm::TraverseCompareOp::greater;
+                case MatchExpression::GTE:
+                    return sbe::vm::TraverseCompareOp::greaterEq;
+                default:
+                    MONGO_UNREACHABLE;
+            }
+        }();
+        const auto& rhs = comparison->getData();
+        auto [tagView, valView] = sbe::bson::convertFrom(
+            true, rhs.rawdata(), rhs.rawdata() + rhs.size(), rhs.fieldNameSize() - 1);
+        auto [tag, val] = sbe::value::copyValue(tagView, valView);
+
+        args.push_back(makeConstant(sbe::value::TypeTags::NumberInt32,
+                                    sbe::value::bitcastFrom<int32_t>(static_cast<int32_t>(op))));
+        args.push_back(makeConstant(tag, val));
+    }
+    return sbe::makeE<sbe::EFunction>("traverseCompare", std::move(args));
+}
+
 void generateComparison(MatchExpressionVisitorContext* context,
                         const ComparisonMatchExpression* expr,
                         sbe::EPrimBinary::Op binaryOp) {
@@ -694,7 +787,19 @@ void generateComparison(MatchExpressionVisitorContext* context,
                 std::move(inputStage)};
     };
 
-    generatePredicate(context, expr->fieldRef(), std::move(makePredicate));
+    MakeArrayPredicateFn makeArrayPredicate;
+    if (canTraverseInBuiltin(expr)) {
+        makeArrayPredicate = [context, expr](sbe::value::SlotId inputSlot) {
+            return makeTraverseCompare(inputSlot, false /* elementsOnly */, {expr}, context->env);
+        };
+    }
+
+    generatePredicate(context,
+                      expr->fieldRef(),
+                      std::move(makePredicate),
+                      LeafTraversalMode::kArrayAndItsElements,
+                      true /* useCombinator */,
+                      std::move(makeArrayPredicate));
 }
 
 /**
@@ -1186,6 +1291,35 @@ public:
                 static_cast<bool>(_context->evalStack.topFrame().data().inputSlot));
         auto childInputSlot = *_context->evalStack.topFrame().data().inputSlot;
 
+        // When all the children are comparisons, the elements of the array are compared in a
+        // single builtin instead of a TraverseStage, and the children's frames are not needed.
+        std::vector<const ComparisonMatchExpression*> comparisons;
+        for (size_t i = 0; i < numChildren; ++i) {
+            if (!canTraverseInBuiltin(matchExpr->getChild(i))) {
+                comparisons.clear();
+                break;
+            }
+            comparisons.push_back(
+                static_cast<const ComparisonMatchExpression*>(matchExpr->getChild(i)));
+        }
+        if (!comparisons.empty() && !_context->stateHelper.stateContainsValue()) {
+            for (size_t i = 0; i < numChildren; ++i) {
+                _context->evalStack.popFrame();
+            }
+            auto makePredicate = [&](sbe::value::SlotId inputSlot,
+                                     EvalStage inputStage) -> EvalExprStagePair {
+                return {makeTraverseCompare(
+                            inputSlot, true /* elementsOnly */, comparisons, _context->env),
+                        std::move(inputStage)};
+            };
+            generatePredicate(_context,
+                              matchExpr->fieldRef(),
+                              std::move(makePredicate),
+                              LeafTraversalMode::kDoNotTraverseLeaf,
+                              false /* useCombinator */);
+            return;
+        }
+
         // Move the children's outputs off of the evalStack into a vector in preparation for
         // calling generateShortCircuitingLogicalOp().
         std::vector<EvalExprStagePair> childStages;
@@ -1330,7 +1464,27 @@ public:
                         std::move(inputStage)};
             };
 
-            generatePredicate(_context, expr->fieldRef(), std::move(makePredicate));
+            MakeArrayPredicateFn makeArrayPredicate;
+            if (internalQuerySlotBasedExecutionTraverseArraysInBuiltins.load()) {
+                makeArrayPredicate = [&, arrSetTag = arrSetTag, arrSetVal = arrSetVal](
+                                         sbe::value::SlotId inputSlot) {
+                    auto [equalitiesTag, equalitiesVal] =
+                        sbe::value::copyValue(arrSetTag, arrSetVal);
+                    auto args = sbe::makeEs(makeVariable(inputSlot),
+                                            makeConstant(equalitiesTag, equalitiesVal));
+                    if (auto collatorSlot = _context->env->getSlotIfExists("collator"_sd)) {
+                        args.push_back(makeVariable(*collatorSlot));
+                    }
+                    return sbe::makeE<sbe::EFunction>("traverseIsMember", std::move(args));
+                };
+            }
+
+            generatePredicate(_context,
+                              expr->fieldRef(),
+                              std::move(makePredicate),
+                              LeafTraversalMode::kArrayAndItsElements,
+                              true /* useCombinator */,
+                              std::move(makeArrayPredicate));
             return;
         } else {
             // If the InMatchExpression contains regex patterns, then we need to handle a regex-only
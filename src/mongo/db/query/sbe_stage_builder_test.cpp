@@ -29,7 +29,9 @@
 
 #include "mongo/platform/basic.h"
 
+#include "mongo/db/exec/sbe/values/bson.h"
 #include "mongo/db/exec/shard_filterer_mock.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
 #include "mongo/db/query/query_solution.h"
 #include "mongo/db/query/sbe_stage_builder_test_fixture.h"
 #include "mongo/db/query/shard_filterer_factory_mock.h"
@@ -216,4 +218,51 @@ TEST_F(SbeStageBuilderTest, VirtualIndexScanWithoutRecordId) {
     }
     ASSERT_EQ(index, 3);
 }
+
+TEST_F(SbeStageBuilderTest, GroupOverVirtualScan) {
+    auto docs = std::vector<BSONArray>{BSON_ARRAY(BSON("a" << 1 << "b" << 5)),
+                                       BSON_ARRAY(BSON("a" << 2 << "b" << 3)),
+                                       BSON_ARRAY(BSON("a" << 1 << "b" << 2)),
+                                       BSON_ARRAY(BSON("b" << 7))};
+
+    // Group the scanned documents by 'a', computing the minimum and the first 'b' and the number
+    // of documents of each group. The documents without an 'a' form the null group.
+    auto expCtx = make_intrusive<ExpressionContextForTest>();
+    auto vps = expCtx->variablesParseState;
+    auto fieldB = ExpressionFieldPath::parse(expCtx.get(), "$b", vps);
+    std::vector<CanonicalQuery::GroupPushdown::Accumulator> accumulators{
+        {"minB", "$min", fieldB},
+        {"firstB", "$first", fieldB},
+        {"count", "$sum", ExpressionConstant::create(expCtx.get(), Value(1))}};
+    auto groupNode = std::make_unique<GroupNode>(
+        ExpressionFieldPath::parse(expCtx.get(), "$a", vps), std::move(accumulators), false);
+    groupNode->children.push_back(
+        new VirtualScanNode(docs, VirtualScanNode::ScanType::kCollScan, false));
+    auto querySolution = makeQuerySolution(std::move(groupNode));
+
+    // Translate the QuerySolution tree to an sbe::PlanStage.
+    auto shardFiltererInterface = makeAlwaysPassShardFiltererInterface();
+    auto [resultSlots, stage, data] =
+        buildPlanStage(std::move(querySolution), false, std::move(shardFiltererInterface));
+    auto resultAccessors = prepareTree(&data.ctx, stage.get(), resultSlots);
+    ASSERT_EQ(resultAccessors.size(), 1u);
+
+    BSONObjBuilder results;
+    for (auto st = stage->getNext(); st == sbe::PlanState::ADVANCED; st = stage->getNext()) {
+        auto [tag, val] = resultAccessors[0]->copyOrMoveValue();
+        sbe::value::ValueGuard guard{tag, val};
+        BSONObjBuilder bob;
+        sbe::bson::appendValueToBsonObj(bob, "group", tag, val);
+        auto group = bob.obj()["group"].Obj();
+        results.append(group["_id"].toString(false), group);
+    }
+    auto byKey = results.obj();
+    ASSERT_EQ(byKey.nFields(), 3);
+    ASSERT_BSONOBJ_EQ(byKey["1"].Obj(),
+                      BSON("_id" << 1 << "minB" << 2 << "firstB" << 5 << "count" << 2));
+    ASSERT_BSONOBJ_EQ(byKey["2"].Obj(),
+                      BSON("_id" << 2 << "minB" << 3 << "firstB" << 3 << "count" << 1));
+    ASSERT_BSONOBJ_EQ(byKey["null"].Obj(),
+                      BSON("_id" << BSONNULL << "minB" << 7 << "firstB" << 7 << "count" << 1));
+}
 }  // namespace mongo
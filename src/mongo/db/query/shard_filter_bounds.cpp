@@ -0,0 +1,114 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/shard_filter_bounds.h"
+
+namespace mongo::stage_builder {
+namespace {
+/**
+ * Returns true if all the shard keys within 'bounds' of a scan over 'index' belong to the shard.
+ */
+bool scanBoundsBelongToShard(const IndexEntry& index,
+                             const IndexBounds& bounds,
+                             const ShardFilterer& shardFilterer) {
+    const auto& shardKeyPattern = shardFilterer.getKeyPattern();
+    const auto shardKeyField = shardKeyPattern.toBSON().firstElement();
+
+    // The index keys only tell the shard keys of the documents when they hold the values of the
+    // shard key field as they are, rather than hashes or collation keys.
+    if (index.type != INDEX_BTREE || index.collator || bounds.isSimpleRange ||
+        bounds.fields.empty() || !shardKeyField.isNumber() ||
+        index.keyPattern.firstElementFieldNameStringData() !=
+            shardKeyField.fieldNameStringData()) {
+        return false;
+    }
+
+    // The other fields of the shard key may take any value, so each interval of the first field
+    // covers the range of shard keys from {<start>, MinKey, ...} to {<end>, MaxKey, ...}.
+    for (auto&& interval : bounds.fields.front().intervals) {
+        const bool descending =
+            interval.getDirection() == Interval::Direction::kDirectionDescending;
+        const auto& low = descending ? interval.end : interval.start;
+        const auto& high = descending ? interval.start : interval.end;
+
+        const auto min = shardKeyPattern.extendRangeBound(
+            BSONObjBuilder{}.appendAs(low, shardKeyField.fieldNameStringData()).obj(), false);
+        const auto max = shardKeyPattern.extendRangeBound(
+            BSONObjBuilder{}.appendAs(high, shardKeyField.fieldNameStringData()).obj(), true);
+        if (!shardFilterer.rangeBelongsToMe(min, max, true)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+}  // namespace
+
+bool indexBoundsBelongToShard(const QuerySolutionNode* root, const ShardFilterer& shardFilterer) {
+    if (!shardFilterer.isCollectionSharded()) {
+        return false;
+    }
+
+    switch (root->getType()) {
+        case STAGE_IXSCAN: {
+            const auto ixn = static_cast<const IndexScanNode*>(root);
+            return scanBoundsBelongToShard(ixn->index, ixn->bounds, shardFilterer);
+        }
+        case STAGE_DISTINCT_SCAN: {
+            const auto dn = static_cast<const DistinctNode*>(root);
+            return scanBoundsBelongToShard(dn->index, dn->bounds, shardFilterer);
+        }
+        // These stages only return documents which come from their children.
+        case STAGE_AND_HASH:
+        case STAGE_AND_SORTED:
+        case STAGE_FETCH:
+        case STAGE_LIMIT:
+        case STAGE_OR:
+        case STAGE_PROJECTION_COVERED:
+        case STAGE_PROJECTION_DEFAULT:
+        case STAGE_PROJECTION_SIMPLE:
+        case STAGE_SHARDING_FILTER:
+        case STAGE_SKIP:
+        case STAGE_SORT_DEFAULT:
+        case STAGE_SORT_KEY_GENERATOR:
+        case STAGE_SORT_MERGE:
+        case STAGE_SORT_SIMPLE:
+            for (auto&& child : root->children) {
+                if (!indexBoundsBelongToShard(child, shardFilterer)) {
+                    return false;
+                }
+            }
+            return !root->children.empty();
+        default:
+            return false;
+    }
+}
+}  // namespace mongo::stage_builder
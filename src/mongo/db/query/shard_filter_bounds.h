@@ -0,0 +1,44 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/db/exec/shard_filterer.h"
+#include "mongo/db/query/query_solution.h"
+
+namespace mongo::stage_builder {
+/**
+ * Returns true if the bounds of the index scans under 'root' prove that every document the subtree
+ * returns is owned by the shard, according to 'shardFilterer'. This is the case when all of the
+ * documents come from scans of indexes which lead with the first field of the shard key, and the
+ * bounds on that field only cover chunks owned by the shard. A SHARDING_FILTER stage over such a
+ * subtree would never filter out a document, so the stage builders leave it out.
+ */
+bool indexBoundsBelongToShard(const QuerySolutionNode* root, const ShardFilterer& shardFilterer);
+}  // namespace mongo::stage_builder
@@ -0,0 +1,183 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/shard_filter_bounds.h"
+
+#include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/db/query/index_bounds_builder.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo::stage_builder {
+namespace {
+
+/**
+ * A ShardFilterer which owns the shard keys from {a: 0} to {a: 100}, excluding the latter.
+ */
+class OwnedRangeFilterer final : public ShardFilterer {
+public:
+    explicit OwnedRangeFilterer(const BSONObj& pattern) : _pattern(pattern.getOwned()) {}
+
+    std::unique_ptr<ShardFilterer> clone() const override {
+        return std::make_unique<OwnedRangeFilterer>(_pattern.toBSON());
+    }
+
+    bool keyBelongsToMe(const BSONObj& key) const override {
+        return key.woCompare(_min) >= 0 && key.woCompare(_max) < 0;
+    }
+
+    DocumentBelongsResult documentBelongsToMe(const BSONObj& doc) const override {
+        MONGO_UNREACHABLE;
+    }
+
+    bool rangeBelongsToMe(const BSONObj& min,
+                          const BSONObj& max,
+                          bool isMaxInclusive) const override {
+        return min.woCompare(_min) >= 0 &&
+            (isMaxInclusive ? max.woCompare(_max) < 0 : max.woCompare(_max) <= 0);
+    }
+
+    bool isCollectionSharded() const override {
+        return true;
+    }
+
+    const KeyPattern& getKeyPattern() const override {
+        return _pattern;
+    }
+
+private:
+    const KeyPattern _pattern;
+    const BSONObj _min = BSON("a" << 0);
+    const BSONObj _max = BSON("a" << 100);
+};
+
+IndexEntry buildSimpleIndexEntry(const BSONObj& kp) {
+    return {kp,
+            IndexNames::nameToType(IndexNames::findPluginName(kp)),
+            IndexDescriptor::kLatestIndexVersion,
+            false,
+            {},
+            {},
+            false,
+            false,
+            CoreIndexInfo::Identifier("test_foo"),
+            nullptr,
+            {},
+            nullptr,
+            nullptr};
+}
+
+/**
+ * Makes an index scan over 'keyPattern' whose bounds on the first field of the index are given by
+ * 'intervals', and which scans the other fields entirely.
+ */
+std::unique_ptr<IndexScanNode> makeIndexScan(const BSONObj& keyPattern,
+                                             std::vector<Interval> intervals) {
+    auto ixn = std::make_unique<IndexScanNode>(buildSimpleIndexEntry(keyPattern));
+    for (auto&& elem : keyPattern) {
+        OrderedIntervalList oil{elem.fieldName()};
+        if (ixn->bounds.fields.empty()) {
+            oil.intervals = std::move(intervals);
+        } else {
+            oil.intervals.push_back(IndexBoundsBuilder::allValues());
+        }
+        ixn->bounds.fields.push_back(std::move(oil));
+    }
+    return ixn;
+}
+
+Interval makeInterval(int start, int end) {
+    return Interval(BSON("" << start << "" << end), true, true);
+}
+
+TEST(ShardFilterBoundsTest, BoundsWithinOwnedChunks) {
+    OwnedRangeFilterer filterer{BSON("a" << 1)};
+
+    auto ixn =
+        makeIndexScan(BSON("a" << 1 << "b" << 1), {makeInterval(0, 10), makeInterval(50, 99)});
+    ASSERT_TRUE(indexBoundsBelongToShard(ixn.get(), filterer));
+
+    ixn = makeIndexScan(BSON("a" << 1), {IndexBoundsBuilder::makePointInterval(BSON("" << 42))});
+    ASSERT_TRUE(indexBoundsBelongToShard(ixn.get(), filterer));
+
+    // Scanning backwards reverses the intervals.
+    ixn = makeIndexScan(BSON("a" << -1), {makeInterval(99, 50), makeInterval(10, 0)});
+    ASSERT_TRUE(indexBoundsBelongToShard(ixn.get(), filterer));
+}
+
+TEST(ShardFilterBoundsTest, BoundsOutsideOwnedChunks) {
+    OwnedRangeFilterer filterer{BSON("a" << 1)};
+
+    auto ixn = makeIndexScan(BSON("a" << 1), {makeInterval(0, 10), makeInterval(50, 100)});
+    ASSERT_FALSE(indexBoundsBelongToShard(ixn.get(), filterer));
+
+    ixn = makeIndexScan(BSON("a" << 1), {makeInterval(-1, 10)});
+    ASSERT_FALSE(indexBoundsBelongToShard(ixn.get(), filterer));
+
+    ixn = makeIndexScan(BSON("a" << 1), {IndexBoundsBuilder::allValues()});
+    ASSERT_FALSE(indexBoundsBelongToShard(ixn.get(), filterer));
+}
+
+TEST(ShardFilterBoundsTest, IndexMustLeadWithTheShardKeyValues) {
+    OwnedRangeFilterer filterer{BSON("a" << 1)};
+
+    // The bounds on 'b' do not tell anything about the values of 'a'.
+    auto ixn = makeIndexScan(BSON("b" << 1 << "a" << 1), {makeInterval(0, 10)});
+    ASSERT_FALSE(indexBoundsBelongToShard(ixn.get(), filterer));
+
+    // The keys of an index with a collation are not the values of the shard key.
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kReverseString);
+    ixn = makeIndexScan(BSON("a" << 1), {makeInterval(0, 10)});
+    ixn->index.collator = &collator;
+    ASSERT_FALSE(indexBoundsBelongToShard(ixn.get(), filterer));
+
+    // Nor are the keys of a hashed shard key.
+    OwnedRangeFilterer hashedFilterer{BSON("a"
+                                           << "hashed")};
+    ixn = makeIndexScan(BSON("a" << 1), {makeInterval(0, 10)});
+    ASSERT_FALSE(indexBoundsBelongToShard(ixn.get(), hashedFilterer));
+}
+
+TEST(ShardFilterBoundsTest, AllInputsMustComeFromOwnedBounds) {
+    OwnedRangeFilterer filterer{BSON("a" << 1)};
+
+    auto orNode = std::make_unique<OrNode>();
+    orNode->children.push_back(makeIndexScan(BSON("a" << 1), {makeInterval(0, 10)}).release());
+    orNode->children.push_back(makeIndexScan(BSON("a" << 1), {makeInterval(20, 30)}).release());
+    auto fetch = std::make_unique<FetchNode>();
+    fetch->children.push_back(orNode.release());
+    ASSERT_TRUE(indexBoundsBelongToShard(fetch.get(), filterer));
+
+    fetch->children[0]->children.push_back(std::make_unique<CollectionScanNode>().release());
+    ASSERT_FALSE(indexBoundsBelongToShard(fetch.get(), filterer));
+}
+
+}  // namespace
+}  // namespace mongo::stage_builder
@@ -37,6 +37,28 @@
 #include "mongo/db/query/shard_filterer_factory_impl.h"
 
 namespace mongo::stage_builder {
+namespace {
+/**
+ * Attaches a newly built or cloned SBE plan stage tree to the operation executing 'cq' and
+ * registers it with the yield policy.
+ */
+void attachSlotBasedExecutableTree(OperationContext* opCtx,
+                                   const CanonicalQuery& cq,
+                                   sbe::PlanStage* root,
+                                   PlanYieldPolicySBE* yieldPolicy) {
+    root->attachToOperationContext(opCtx);
+
+    auto expCtx = cq.getExpCtxRaw();
+    tassert(5327100, "No expression context", expCtx);
+    if (expCtx->explain || expCtx->mayDbProfile) {
+        root->markShouldCollectTimingInfo();
+    }
+
+    // Register this plan to yield according to the configured policy.
+    yieldPolicy->registerPlan(root);
+}
+}  // namespace
+
 std::unique_ptr<PlanStage> buildClassicExecutableTree(OperationContext* opCtx,
                                                       const CollectionPtr& collection,
                                                       const CanonicalQuery& cq,
@@ -76,17 +98,35 @@ buildSlotBasedExecutableTree(OperationContext* opCtx,
     auto root = builder->build(solution.root());
     auto data = builder->getPlanStageData();
 
-    root->attachToOperationContext(opCtx);
+    attachSlotBasedExecutableTree(opCtx, cq, root.get(), sbeYieldPolicy);
 
-    auto expCtx = cq.getExpCtxRaw();
-    tassert(5327100, "No expression context", expCtx);
-    if (expCtx->explain || expCtx->mayDbProfile) {
-        root->markShouldCollectTimingInfo();
+    return {std::move(root), std::move(data)};
+}
+
+std::pair<std::unique_ptr<sbe::PlanStage>, stage_builder::PlanStageData>
+cloneSlotBasedExecutableTree(OperationContext* opCtx,
+                             const CanonicalQuery& cq,
+                             const sbe::PlanStage& root,
+                             const stage_builder::PlanStageData& data,
+                             PlanYieldPolicy* yieldPolicy) {
+    auto sbeYieldPolicy = dynamic_cast<PlanYieldPolicySBE*>(yieldPolicy);
+    invariant(sbeYieldPolicy);
+
+    auto newRoot = root.clone();
+    auto newData = data.makeCopy();
+
+    // The collator is owned by the query, so the copied environment must point to the one of the
+    // query the tree is cloned for.
+    if (auto collatorSlot = newData.env->getSlotIfExists("collator"_sd); collatorSlot) {
+        newData.env->resetSlot(*collatorSlot,
+                               sbe::value::TypeTags::collator,
+                               sbe::value::bitcastFrom<const CollatorInterface*>(cq.getCollator()),
+                               false);
     }
 
-    // Register this plan to yield according to the configured policy.
-    sbeYieldPolicy->registerPlan(root.get());
+    newRoot->attachNewYieldPolicy(sbeYieldPolicy);
+    attachSlotBasedExecutableTree(opCtx, cq, newRoot.get(), sbeYieldPolicy);
 
-    return {std::move(root), std::move(data)};
+    return {std::move(newRoot), std::move(newData)};
 }
 }  // namespace mongo::stage_builder
@@ -57,4 +57,16 @@ buildSlotBasedExecutableTree(OperationContext* opCtx,
                              const QuerySolution& solution,
                              PlanYieldPolicy* yieldPolicy);
 
+/**
+ * Makes a copy of an executable tree which buildSlotBasedExecutableTree() returned for another
+ * query with identical parameters, and readies it for executing 'cq' under 'yieldPolicy'. The
+ * given tree must not have been prepared.
+ */
+std::pair<std::unique_ptr<sbe::PlanStage>, stage_builder::PlanStageData>
+cloneSlotBasedExecutableTree(OperationContext* opCtx,
+                             const CanonicalQuery& cq,
+                             const sbe::PlanStage& root,
+                             const stage_builder::PlanStageData& data,
+                             PlanYieldPolicy* yieldPolicy);
+
 }  // namespace mongo::stage_builder
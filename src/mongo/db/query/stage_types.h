@@ -52,6 +52,9 @@ enum StageType {
     STAGE_CACHED_PLAN,
     STAGE_COLLSCAN,
 
+    // Reconstructs documents from the columns of a columnstore index.
+    STAGE_COLUMN_SCAN,
+
     // A virtual scan stage that simulates a collection scan and doesn't depend on underlying
     // storage.
     STAGE_VIRTUAL_SCAN,
@@ -65,6 +68,9 @@ enum StageType {
     // them.
     STAGE_COUNT_SCAN,
 
+    // Returns the results of a cursor which were spooled to a temporary record store.
+    STAGE_CURSOR_SPOOL,
+
     STAGE_DELETE,
 
     // If we're running a distinct, we only care about one value for each key.  The distinct
@@ -81,6 +87,10 @@ enum StageType {
     STAGE_GEO_NEAR_2D,
     STAGE_GEO_NEAR_2DSPHERE,
 
+    // Groups the results of its child for a $group stage which was pushed down from an aggregation
+    // pipeline. Only built by the slot-based stage builder.
+    STAGE_GROUP,
+
     STAGE_IDHACK,
 
     STAGE_IXSCAN,
@@ -37,7 +37,9 @@
 #include "mongo/bson/timestamp.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/record_id.h"
+#include "mongo/logv2/redaction.h"
 #include "mongo/util/debug_util.h"
+#include "mongo/util/str.h"
 
 namespace mongo {
 namespace record_id_helpers {
@@ -80,5 +82,24 @@ StatusWith<RecordId> extractKey(const char* data, int len) {
     return keyForOptime(elem.timestamp());
 }
 
+RecordId keyForOID(const OID& oid) {
+    return RecordId(oid.view().view(), OID::kOIDSize);
+}
+
+StatusWith<RecordId> keyForDoc(const BSONObj& doc) {
+    const BSONElement elem = doc["_id"];
+    if (elem.eoo()) {
+        return {ErrorCodes::BadValue,
+                str::stream() << "Document " << redact(doc) << " is missing the '_id' field"};
+    }
+    if (elem.type() != jstOID) {
+        return {ErrorCodes::BadValue,
+                str::stream() << "Collections clustered by _id require ObjectId _id values, "
+                                 "but document "
+                              << redact(doc) << " has an _id of type " << typeName(elem.type())};
+    }
+    return keyForOID(elem.OID());
+}
+
 }  // namespace record_id_helpers
 }  // namespace mongo
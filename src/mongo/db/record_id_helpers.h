@@ -33,6 +33,8 @@
 #include "mongo/base/status_with.h"
 
 namespace mongo {
+class BSONObj;
+class OID;
 class RecordId;
 class Timestamp;
 
@@ -49,5 +51,17 @@ StatusWith<RecordId> keyForOptime(const Timestamp& opTime);
  */
 StatusWith<RecordId> extractKey(const char* data, int len);
 
+/**
+ * Converts an ObjectId to the RecordId used as its key in a collection clustered by _id. The
+ * RecordId holds the big-endian bytes of the ObjectId, so RecordIds sort in _id order.
+ */
+RecordId keyForOID(const OID& oid);
+
+/**
+ * Returns the RecordId of 'doc' in a collection clustered by _id, or an error if 'doc' does not
+ * have an ObjectId _id.
+ */
+StatusWith<RecordId> keyForDoc(const BSONObj& doc);
+
 }  // namespace record_id_helpers
 }  // namespace mongo
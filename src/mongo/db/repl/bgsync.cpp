@@ -53,6 +53,7 @@
 #include "mongo/db/repl/replication_consistency_markers_impl.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/repl/replication_coordinator_impl.h"
+#include "mongo/db/repl/replication_metrics.h"
 #include "mongo/db/repl/replication_process.h"
 #include "mongo/db/repl/rollback_source_impl.h"
 #include "mongo/db/repl/rs_rollback.h"
@@ -65,6 +66,7 @@
 #include "mongo/util/str.h"
 #include "mongo/util/testing_proctor.h"
 #include "mongo/util/time_support.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -656,8 +658,16 @@ Status BackgroundSync::_enqueueDocuments(OplogFetcher::Documents::const_iterator
 
     auto opCtx = cc().makeOperationContext();
 
-    // Wait for enough space.
+    // Wait for enough space, keeping track of how long the applier holds the fetcher up.
+    auto oplogBuffer = _oplogApplier->getBuffer();
+    const bool bufferIsFull =
+        oplogBuffer->getSize() + info.toApplyDocumentBytes > oplogBuffer->getMaxSize();
+    Timer waitTimer;
     _oplogApplier->waitForSpace(opCtx.get(), info.toApplyDocumentBytes);
+    if (bufferIsFull) {
+        ReplicationMetrics::get(opCtx.get())
+            .recordOplogBufferWait(Milliseconds(waitTimer.millis()));
+    }
 
     {
         // Don't add more to the buffer if we are in shutdown. Continue holding the lock until we
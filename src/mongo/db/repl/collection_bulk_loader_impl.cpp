@@ -164,11 +164,9 @@ Status CollectionBulkLoaderImpl::_insertDocumentsForUncappedCollection(
         // record store which can throw a write conflict exception.
         status = writeConflictRetry(_opCtx.get(), "_addDocumentToIndexBlocks", _nss.ns(), [&] {
             WriteUnitOfWork wunit(_opCtx.get());
-            for (size_t index = 0; index < locs.size(); ++index) {
-                status = _addDocumentToIndexBlocks(*iter++, locs.at(index));
-                if (!status.isOK()) {
-                    return status;
-                }
+            auto status = _addDocumentsToIndexBlocks(iter, locs);
+            if (!status.isOK()) {
+                return status;
             }
             wunit.commit();
             return Status::OK();
@@ -177,6 +175,7 @@ Status CollectionBulkLoaderImpl::_insertDocumentsForUncappedCollection(
         if (!status.isOK()) {
             return status;
         }
+        iter += locs.size();
     }
     return Status::OK();
 }
@@ -395,6 +394,39 @@ Status CollectionBulkLoaderImpl::_addDocumentToIndexBlocks(const BSONObj& doc,
     return Status::OK();
 }
 
+Status CollectionBulkLoaderImpl::_addDocumentsToIndexBlocks(
+    std::vector<BSONObj>::const_iterator begin, const std::vector<RecordId>& locs) {
+    const size_t numThreads = collectionBulkLoaderIndexKeyThreads.load();
+    if (numThreads <= 1) {
+        for (const auto& loc : locs) {
+            auto status = _addDocumentToIndexBlocks(*begin++, loc);
+            if (!status.isOK()) {
+                return status;
+            }
+        }
+        return Status::OK();
+    }
+
+    const std::vector<BSONObj> docs(begin, begin + locs.size());
+    if (_idIndexBlock) {
+        auto status = _idIndexBlock->insertDocumentsForInitialSyncOrRecovery(
+            _opCtx.get(), docs, locs, numThreads);
+        if (!status.isOK()) {
+            return status.withContext("failed to add documents to _id index");
+        }
+    }
+
+    if (_secondaryIndexesBlock) {
+        auto status = _secondaryIndexesBlock->insertDocumentsForInitialSyncOrRecovery(
+            _opCtx.get(), docs, locs, numThreads);
+        if (!status.isOK()) {
+            return status.withContext("failed to add documents to secondary indexes");
+        }
+    }
+
+    return Status::OK();
+}
+
 CollectionBulkLoaderImpl::Stats CollectionBulkLoaderImpl::getStats() const {
     return _stats;
 }
@@ -102,6 +102,13 @@ private:
      */
     Status _addDocumentToIndexBlocks(const BSONObj& doc, const RecordId& loc);
 
+    /**
+     * Adds the documents from 'begin', which were inserted at 'locs', to the index blocks,
+     * generating their keys on collectionBulkLoaderIndexKeyThreads threads.
+     */
+    Status _addDocumentsToIndexBlocks(std::vector<BSONObj>::const_iterator begin,
+                                      const std::vector<RecordId>& locs);
+
     ServiceContext::UniqueClient _client;
     ServiceContext::UniqueOperationContext _opCtx;
     std::unique_ptr<AutoGetCollection> _collection;
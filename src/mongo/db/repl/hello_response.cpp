@@ -105,6 +105,12 @@ HelloResponse::HelloResponse()
       _shutdownInProgress(false) {}
 
 void HelloResponse::addToBSON(BSONObjBuilder* builder, bool useLegacyResponseFields) const {
+    if (const auto& serialized =
+            useLegacyResponseFields ? _serializedLegacyResponse : _serializedResponse) {
+        builder->appendElements(*serialized);
+        return;
+    }
+
     if (_topologyVersion) {
         BSONObjBuilder topologyVersionBuilder(builder->subobjStart(kTopologyVersionFieldName));
         _topologyVersion->serialize(&topologyVersionBuilder);
@@ -211,11 +217,25 @@ void HelloResponse::addToBSON(BSONObjBuilder* builder, bool useLegacyResponseFie
 }
 
 BSONObj HelloResponse::toBSON(bool useLegacyResponseFields) const {
+    if (const auto& serialized =
+            useLegacyResponseFields ? _serializedLegacyResponse : _serializedResponse) {
+        return *serialized;
+    }
+
     BSONObjBuilder builder;
     addToBSON(&builder, useLegacyResponseFields);
     return builder.obj();
 }
 
+void HelloResponse::cacheSerializedResponses() {
+    _serializedLegacyResponse = boost::none;
+    _serializedResponse = boost::none;
+    auto legacyResponse = toBSON(true);
+    auto response = toBSON(false);
+    _serializedLegacyResponse = std::move(legacyResponse);
+    _serializedResponse = std::move(response);
+}
+
 Status HelloResponse::initialize(const BSONObj& doc) {
     Status status = bsonExtractBooleanField(doc, kIsMasterFieldName, &_isWritablePrimary);
     if (!status.isOK()) {
@@ -32,6 +32,7 @@
 #include <string>
 #include <vector>
 
+#include "mongo/bson/bsonobj.h"
 #include "mongo/bson/oid.h"
 #include "mongo/db/repl/optime.h"
 #include "mongo/db/repl/optime_with.h"
@@ -42,7 +43,6 @@
 
 namespace mongo {
 
-class BSONObj;
 class BSONObjBuilder;
 class Status;
 
@@ -78,6 +78,13 @@ public:
      */
     BSONObj toBSON(bool useLegacyResponseFields = true) const;
 
+    /**
+     * Serializes the response for both values of "useLegacyResponseFields", so that toBSON returns
+     * these serializations without copying them and addToBSON only appends them. Meant for the
+     * responses which are shared by many waiting hello commands, which then serialize the response
+     * once instead of once per command. The response must not be modified afterwards.
+     */
+    void cacheSerializedResponses();
 
     // ===================== Accessors for member variables ================================= //
 
@@ -295,6 +302,11 @@ private:
     // If _shutdownInProgress is true toBSON will return a set of hardcoded values to indicate
     // that we are mid shutdown
     bool _shutdownInProgress;
+
+    // The serialized responses set by cacheSerializedResponses, with the legacy response fields
+    // and without them.
+    boost::optional<BSONObj> _serializedLegacyResponse;
+    boost::optional<BSONObj> _serializedResponse;
 };
 
 }  // namespace repl
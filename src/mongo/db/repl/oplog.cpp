@@ -1146,6 +1146,35 @@ Status applyOperation_inlock(OperationContext* opCtx,
               str::stream() << "Oplog entry did not have 'ts' field when expected: "
                             << redact(opOrGroupedInserts.toBSON()));
 
+    if (opOrGroupedInserts.isGrouped() && opType != OpTypeEnum::kInsert) {
+        // Grouped updates or deletes. Apply them one at a time in a single WriteUnitOfWork, so
+        // that they share one storage transaction, and timestamp each write with its own optime.
+        uassert(ErrorCodes::OperationFailed,
+                "Cannot apply grouped updates or deletes with replicated writes",
+                !opCtx->writesAreReplicated());
+
+        const auto& groupedOps = opOrGroupedInserts.getGroupedOps();
+        WriteUnitOfWork wuow(opCtx);
+        for (const auto groupedOp : groupedOps) {
+            if (assignOperationTimestamp) {
+                uassertStatusOK(opCtx->recoveryUnit()->setTimestamp(groupedOp->getTimestamp()));
+            }
+            // The wrapping WriteUnitOfWork keeps the write from assigning its own timestamp.
+            auto status = applyOperation_inlock(opCtx, db, groupedOp, alwaysUpsert, mode);
+            if (!status.isOK()) {
+                return status;
+            }
+        }
+        wuow.commit();
+
+        if (incrementOpsAppliedStats) {
+            for (size_t i = 0; i < groupedOps.size(); ++i) {
+                incrementOpsAppliedStats();
+            }
+        }
+        return Status::OK();
+    }
+
     switch (opType) {
         case OpTypeEnum::kInsert: {
             uassert(ErrorCodes::NamespaceNotFound,
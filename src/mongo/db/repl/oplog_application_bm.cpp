@@ -0,0 +1,247 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/db/logical_session_id.h"
+#include "mongo/db/repl/oplog_applier_impl.h"
+#include "mongo/db/repl/oplog_applier_impl_test_fixture.h"
+#include "mongo/db/repl/oplog_entry_test_helpers.h"
+
+namespace mongo {
+namespace repl {
+namespace {
+
+/**
+ * Benchmarks secondary oplog application by driving OplogApplierImpl::applyOplogBatch() over
+ * generated batches. Each benchmark takes the number of writer threads as its argument and reports
+ * the CRUD operations applied per second, including those inside transactions.
+ */
+constexpr int kBatchSize = 5000;           // the default replBatchLimitOperations
+constexpr int kNumDocuments = 10000;       // documents present before updates are applied
+constexpr int kNumNamespaces = 100;        // collections written by the many namespaces workload
+constexpr int kOperationsPerTransaction = 10;
+
+enum class Workload {
+    kInsert,          // inserts into one collection
+    kUpdate,          // updates spread uniformly over the documents of one collection
+    kSkewedUpdate,    // updates of which 90% go to 10 documents of one collection
+    kManyNamespaces,  // inserts spread over kNumNamespaces collections
+    kTransactions,    // inserts committed kOperationsPerTransaction at a time by applyOps
+};
+
+/**
+ * Sets up a storage engine and the replication state the applier needs, reusing the oplog
+ * applier unit test fixture outside of the unit test framework.
+ */
+class OplogApplicationBenchmarkFixture final : public OplogApplierImplTest {
+public:
+    OplogApplicationBenchmarkFixture(std::string storageEngine, int writerThreadCount)
+        : OplogApplierImplTest(std::move(storageEngine)) {
+        setUp();
+        _writerPool = makeReplWriterPool(writerThreadCount);
+        for (int i = 0; i < kNumNamespaces; ++i) {
+            _namespaces.emplace_back("test", "coll" + std::to_string(i));
+            _uuids.push_back(createCollectionWithUuid(_opCtx.get(), _namespaces.back()));
+        }
+        createCollectionWithUuid(_opCtx.get(), NamespaceString::kSessionTransactionsTableNamespace);
+    }
+
+    ~OplogApplicationBenchmarkFixture() {
+        _writerPool->shutdown();
+        _writerPool->join();
+        tearDown();
+    }
+
+    /**
+     * Generates the next batch of the given workload, with optimes following those of the
+     * previous batch.
+     */
+    std::vector<OplogEntry> makeBatch(Workload workload) {
+        std::vector<OplogEntry> batch;
+        const auto& nss = _namespaces.front();
+        switch (workload) {
+            case Workload::kInsert:
+                for (int i = 0; i < kBatchSize; ++i) {
+                    batch.push_back(
+                        makeInsertDocumentOplogEntry(_nextOpTime(), nss, _nextDocument()));
+                }
+                break;
+            case Workload::kUpdate:
+            case Workload::kSkewedUpdate:
+                for (int i = 0; i < kBatchSize; ++i) {
+                    int id = (workload == Workload::kSkewedUpdate && i % 10 != 0)
+                        ? i % 10
+                        : (_nextUpdate * 7919) % kNumDocuments;
+                    batch.push_back(makeUpdateDocumentOplogEntry(
+                        _nextOpTime(),
+                        nss,
+                        BSON("_id" << id),
+                        BSON("$v" << 2 << "diff" << BSON("u" << BSON("x" << _nextUpdate++)))));
+                }
+                break;
+            case Workload::kManyNamespaces:
+                for (int i = 0; i < kBatchSize; ++i) {
+                    batch.push_back(makeInsertDocumentOplogEntry(
+                        _nextOpTime(), _namespaces[i % kNumNamespaces], _nextDocument()));
+                }
+                break;
+            case Workload::kTransactions:
+                for (int i = 0; i < kBatchSize / kOperationsPerTransaction; ++i) {
+                    BSONArrayBuilder applyOps;
+                    for (int j = 0; j < kOperationsPerTransaction; ++j) {
+                        applyOps.append(BSON("op"
+                                             << "i"
+                                             << "ns" << nss.ns() << "ui" << _uuids.front()
+                                             << "o" << _nextDocument()));
+                    }
+                    batch.push_back(makeCommandOplogEntryWithSessionInfoAndStmtId(
+                        _nextOpTime(),
+                        NamespaceString("admin", "$cmd"),
+                        BSON("applyOps" << applyOps.arr()),
+                        makeLogicalSessionIdForTest(),
+                        TxnNumber(1),
+                        StmtId(0)));
+                }
+                break;
+        }
+        return batch;
+    }
+
+    void applyBatch(std::vector<OplogEntry> batch) {
+        NoopOplogApplierObserver observer;
+        OplogApplierImpl oplogApplier(
+            nullptr,  // executor
+            nullptr,  // oplogBuffer
+            &observer,
+            ReplicationCoordinator::get(_opCtx.get()),
+            getConsistencyMarkers(),
+            getStorageInterface(),
+            OplogApplier::Options(OplogApplication::Mode::kSecondary),
+            _writerPool.get());
+        uassertStatusOK(oplogApplier.applyOplogBatch(_opCtx.get(), std::move(batch)));
+    }
+
+private:
+    void _doTest() final {}
+
+    OpTime _nextOpTime() {
+        return OpTime(Timestamp(Seconds(1), ++_lastIncrement), 1LL);
+    }
+
+    BSONObj _nextDocument() {
+        int id = _nextId++;
+        return BSON("_id" << id << "x" << id << "padding" << std::string(100, 'x'));
+    }
+
+    std::unique_ptr<ThreadPool> _writerPool;
+    std::vector<NamespaceString> _namespaces;
+    std::vector<UUID> _uuids;
+    unsigned _lastIncrement = 0;
+    int _nextId = 0;
+    int _nextUpdate = 0;
+};
+
+void testOplogApplication(Workload workload,
+                          const std::string& storageEngine,
+                          benchmark::State& state) {
+    OplogApplicationBenchmarkFixture fixture(storageEngine, state.range(0));
+
+    if (workload == Workload::kUpdate || workload == Workload::kSkewedUpdate) {
+        for (int i = 0; i < kNumDocuments / kBatchSize; ++i) {
+            fixture.applyBatch(fixture.makeBatch(Workload::kInsert));
+        }
+    }
+
+    for (auto keepRunning : state) {
+        state.PauseTiming();
+        auto batch = fixture.makeBatch(workload);
+        state.ResumeTiming();
+
+        fixture.applyBatch(std::move(batch));
+    }
+
+    state.SetItemsProcessed(state.iterations() * kBatchSize);
+}
+
+void BM_ApplyInserts(benchmark::State& state) {
+    testOplogApplication(Workload::kInsert, "wiredTiger", state);
+}
+
+void BM_ApplyUpdates(benchmark::State& state) {
+    testOplogApplication(Workload::kUpdate, "wiredTiger", state);
+}
+
+void BM_ApplySkewedUpdates(benchmark::State& state) {
+    testOplogApplication(Workload::kSkewedUpdate, "wiredTiger", state);
+}
+
+void BM_ApplyInsertsToManyNamespaces(benchmark::State& state) {
+    testOplogApplication(Workload::kManyNamespaces, "wiredTiger", state);
+}
+
+void BM_ApplyTransactions(benchmark::State& state) {
+    testOplogApplication(Workload::kTransactions, "wiredTiger", state);
+}
+
+void BM_ApplyInsertsInMemory(benchmark::State& state) {
+    testOplogApplication(Workload::kInsert, "ephemeralForTest", state);
+}
+
+void BM_ApplyUpdatesInMemory(benchmark::State& state) {
+    testOplogApplication(Workload::kUpdate, "ephemeralForTest", state);
+}
+
+/**
+ * The argument is the number of writer threads, as set by replWriterThreadCount.
+ */
+void writerThreadCounts(benchmark::internal::Benchmark* benchmark) {
+    benchmark->ArgName("replWriterThreadCount");
+    for (int threadCount : {1, 4, 16}) {
+        benchmark->Arg(threadCount);
+    }
+    // Each iteration applies a whole batch, mostly on the writer threads, so measure wall-clock
+    // time rather than the CPU time of the benchmark thread.
+    benchmark->Unit(benchmark::kMillisecond);
+    benchmark->UseRealTime();
+}
+
+BENCHMARK(BM_ApplyInserts)->Apply(writerThreadCounts);
+BENCHMARK(BM_ApplyUpdates)->Apply(writerThreadCounts);
+BENCHMARK(BM_ApplySkewedUpdates)->Apply(writerThreadCounts);
+BENCHMARK(BM_ApplyInsertsToManyNamespaces)->Apply(writerThreadCounts);
+BENCHMARK(BM_ApplyTransactions)->Apply(writerThreadCounts);
+BENCHMARK(BM_ApplyInsertsInMemory)->Apply(writerThreadCounts);
+BENCHMARK(BM_ApplyUpdatesInMemory)->Apply(writerThreadCounts);
+
+}  // namespace
+}  // namespace repl
+}  // namespace mongo
@@ -126,6 +126,10 @@ StatusWith<OpTime> OplogApplier::applyOplogBatch(OperationContext* opCtx,
     return lastApplied;
 }
 
+void OplogApplier::prefetch(const std::vector<OplogEntry>& ops) {
+    _prefetch(ops);
+}
+
 StatusWith<std::vector<OplogEntry>> OplogApplier::getNextApplierBatch(
     OperationContext* opCtx, const BatchLimits& batchLimits) {
     return _oplogBatcher->getNextApplierBatch(opCtx, batchLimits);
@@ -150,6 +154,7 @@ std::unique_ptr<ThreadPool> makeReplWriterPool(int threadCount,
     options.threadNamePrefix = name + "-";
     options.poolName = name + "ThreadPool";
     options.maxThreads = options.minThreads = static_cast<size_t>(threadCount);
+    options.workStealing = replWriterPoolWorkStealing;
     options.onCreateThread = [isKillableByStepdown](const std::string&) {
         Client::initThread(getThreadName());
         auto client = Client::getCurrent();
@@ -156,6 +156,13 @@ public:
      */
     StatusWith<OpTime> applyOplogBatch(OperationContext* opCtx, std::vector<OplogEntry> ops);
 
+    /**
+     * Called by the OplogBatcher with each batch it has built, before the batch is handed to the
+     * applier. Lets the applier warm the cache with the documents the batch will write while the
+     * previous batch is still being applied. Must not block on the application of 'ops'.
+     */
+    void prefetch(const std::vector<OplogEntry>& ops);
+
     /**
      * Calls the OplogBatcher's getNextApplierBatch.
      */
@@ -179,6 +186,11 @@ private:
     virtual StatusWith<OpTime> _applyOplogBatch(OperationContext* opCtx,
                                                 std::vector<OplogEntry> ops) = 0;
 
+    /**
+     * Called from prefetch(). Does nothing unless overridden.
+     */
+    virtual void _prefetch(const std::vector<OplogEntry>& ops) {}
+
     // Used to schedule task for oplog application loop.
     // Not owned by us.
     executor::TaskExecutor* const _executor;
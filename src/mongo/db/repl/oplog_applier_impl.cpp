@@ -31,6 +31,8 @@
 
 #include "mongo/db/repl/oplog_applier_impl.h"
 
+#include <algorithm>
+
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/collection_catalog.h"
 #include "mongo/db/catalog/database.h"
@@ -40,6 +42,7 @@
 #include "mongo/db/client.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/db_raii.h"
+#include "mongo/db/dbhelpers.h"
 #include "mongo/db/logical_session_id.h"
 #include "mongo/db/repl/apply_ops.h"
 #include "mongo/db/repl/oplog_applier_utils.h"
@@ -48,6 +51,7 @@
 #include "mongo/db/stats/counters.h"
 #include "mongo/db/stats/timer_stats.h"
 #include "mongo/db/storage/control/journal_flusher.h"
+#include "mongo/db/transaction_history_iterator.h"
 #include "mongo/logv2/log.h"
 #include "mongo/platform/basic.h"
 #include "mongo/util/fail_point.h"
@@ -73,6 +77,74 @@ ServerStatusMetricField<Counter64> displayOplogApplicationBatchSize("repl.apply.
 TimerStats applyBatchStats;
 ServerStatusMetricField<TimerStats> displayOpBatchesApplied("repl.apply.batches", &applyBatchStats);
 
+// Number of documents read into the cache ahead of the batches updating or deleting them.
+Counter64 prefetchedDocumentsStats;
+ServerStatusMetricField<Counter64> displayPrefetchedDocuments("repl.prefetch.documents",
+                                                              &prefetchedDocumentsStats);
+
+// Number of batches not prefetched because the prefetch of an earlier batch was still running.
+Counter64 prefetchSkippedBatchesStats;
+ServerStatusMetricField<Counter64> displayPrefetchSkippedBatches("repl.prefetch.skippedBatches",
+                                                                 &prefetchSkippedBatchesStats);
+
+// Number of partialTxn oplog entries of large unprepared transactions applied one at a time.
+Counter64 oplogApplicationTransactionChunks;
+ServerStatusMetricField<Counter64> displayOplogApplicationTransactionChunks(
+    "repl.apply.transactionChunks", &oplogApplicationTransactionChunks);
+
+// Returns whether 'ops' is the terminal applyOps entry of a large unprepared transaction whose
+// partialTxn entries should be applied one at a time. Such an entry is always in a batch of its
+// own.
+bool shouldApplyTransactionChainInChunks(const std::vector<OplogEntry>& ops,
+                                         const OpTime& beginApplyingOpTime) {
+    if (!replApplyLargeTransactionsInChunks.load() || ops.size() != 1) {
+        return false;
+    }
+    const auto& op = ops.front();
+    return op.isEndOfLargeTransaction() && !op.shouldPrepare() &&
+        op.getOpTime() > beginApplyingOpTime;
+}
+
+// A document which an update or delete in an upcoming batch will look up by _id.
+struct PrefetchTarget {
+    std::string dbName;
+    UUID uuid;
+    BSONObj id;
+};
+
+// Reads the documents of 'targets' in the range ['begin', 'end') so that they and the _id index
+// entries pointing at them are in the cache by the time their batch is applied. Errors are
+// ignored: a target which cannot be read now will be looked up again by its writer.
+void prefetchDocuments(OperationContext* opCtx,
+                       const std::vector<PrefetchTarget>& targets,
+                       size_t begin,
+                       size_t end) {
+    // Batch application holds the ParallelBatchWriterMode lock exclusively. These reads do not
+    // care which batch they observe, so they do not wait for it.
+    ShouldNotConflictWithSecondaryBatchApplicationBlock shouldNotConflictBlock(opCtx->lockState());
+    opCtx->recoveryUnit()->setPrepareConflictBehavior(PrepareConflictBehavior::kIgnoreConflicts);
+
+    for (size_t i = begin; i < end; ++i) {
+        const auto& target = targets[i];
+        try {
+            AutoGetCollection coll(opCtx, {target.dbName, target.uuid}, MODE_IS);
+            if (coll) {
+                RecordId rid = Helpers::findById(opCtx, coll.getCollection(), target.id);
+                Snapshotted<BSONObj> doc;
+                if (!rid.isNull() && coll->findDoc(opCtx, rid, &doc)) {
+                    prefetchedDocumentsStats.increment();
+                }
+            }
+        } catch (const DBException& ex) {
+            if (ErrorCodes::isShutdownError(ex) || ErrorCodes::isInterruption(ex)) {
+                return;
+            }
+        }
+        // Do not pin the history of the storage engine for the whole range.
+        opCtx->recoveryUnit()->abandonSnapshot();
+    }
+}
+
 /**
  * Used for logging a report of ops that take longer than "slowMS" to apply. This is called
  * right before returning from applyOplogEntryOrGroupedInserts, and it returns the same status.
@@ -120,7 +192,7 @@ void _addOplogChainOpsToWriterVectors(OperationContext* opCtx,
     bool shouldSerialize = false;
     std::tie(txnOps, shouldSerialize) =
         readTransactionOperationsFromOplogChainAndCheckForCommands(opCtx, *op, *partialTxnList);
-    derivedOps->emplace_back(txnOps);
+    derivedOps->emplace_back(std::move(txnOps));
     partialTxnList->clear();
 
     // Transaction entries cannot have different session updates.
@@ -252,6 +324,13 @@ OplogApplierImpl::OplogApplierImpl(executor::TaskExecutor* executor,
 void OplogApplierImpl::_run(OplogBuffer* oplogBuffer) {
     // Start up a thread from the batcher to pull from the oplog buffer into the batcher's oplog
     // batch.
+    // Start the threads which read the documents targeted by each batch into the cache before the
+    // batch is applied. They must outlive the batcher, which hands them the batches.
+    if (replOplogPrefetchThreadCount > 0) {
+        _prefetchPool = makeReplWriterPool(replOplogPrefetchThreadCount, "ReplPrefetch"_sd, true);
+    }
+    ON_BLOCK_EXIT([this] { _prefetchPool.reset(); });
+
     _oplogBatcher->startup(_storageInterface);
 
     ON_BLOCK_EXIT([this] { _oplogBatcher->shutdown(); });
@@ -311,7 +390,7 @@ void OplogApplierImpl::_run(OplogBuffer* oplogBuffer) {
 
         // Extract some info from ops that we'll need after releasing the batch below.
         const auto firstOpTimeInBatch = ops.front().getOpTime();
-        const auto lastOpInBatch = ops.back();
+        const auto& lastOpInBatch = ops.back();
         const auto lastOpTimeInBatch = lastOpInBatch.getOpTime();
         const auto lastWallTimeInBatch = lastOpInBatch.getWallClockTime();
         const auto lastAppliedOpTimeAtStartOfBatch = _replCoord->getMyLastAppliedOpTime();
@@ -422,11 +501,177 @@ void scheduleWritesToOplog(OperationContext* opCtx,
 
     const size_t numOplogThreads = writerPool->getStats().numThreads;
     const size_t numOpsPerThread = ops.size() / numOplogThreads;
+    std::vector<ThreadPool::Task> tasks;
+    tasks.reserve(numOplogThreads);
     for (size_t thread = 0; thread < numOplogThreads; thread++) {
         size_t begin = thread * numOpsPerThread;
         size_t end = (thread == numOplogThreads - 1) ? ops.size() : begin + numOpsPerThread;
-        writerPool->schedule(makeOplogWriterForRange(begin, end));
+        tasks.push_back(makeOplogWriterForRange(begin, end));
+    }
+    writerPool->scheduleBatch(std::move(tasks));
+}
+
+void OplogApplierImpl::_prefetch(const std::vector<OplogEntry>& ops) {
+    if (!_prefetchPool) {
+        return;
+    }
+
+    // Prefetching only helps if it runs ahead of application, so rather than queue up behind an
+    // earlier batch whose documents are still being read, skip this one.
+    const auto stats = _prefetchPool->getStats();
+    if (stats.numPendingTasks > 0 || stats.numIdleThreads < stats.numThreads) {
+        prefetchSkippedBatchesStats.increment();
+        return;
+    }
+
+    auto targets = std::make_shared<std::vector<PrefetchTarget>>();
+    for (const auto& op : ops) {
+        const auto opType = op.getOpType();
+        if ((opType != OpTypeEnum::kUpdate && opType != OpTypeEnum::kDelete) || !op.getUuid()) {
+            continue;
+        }
+        auto idElement = op.getIdElement();
+        if (idElement.eoo()) {
+            continue;
+        }
+        targets->push_back({op.getNss().db().toString(), *op.getUuid(), idElement.wrap()});
+    }
+    if (targets->empty()) {
+        return;
+    }
+
+    // Give each thread enough targets to amortize the cost of setting up its operation context.
+    const size_t kMinTargetsPerThread = 16;
+    const size_t numTasks =
+        std::max<size_t>(1, std::min(stats.numThreads, targets->size() / kMinTargetsPerThread));
+    const size_t numTargetsPerTask = targets->size() / numTasks;
+    for (size_t task = 0; task < numTasks; ++task) {
+        const size_t begin = task * numTargetsPerTask;
+        const size_t end = (task == numTasks - 1) ? targets->size() : begin + numTargetsPerTask;
+        _prefetchPool->schedule([targets, begin, end](auto status) {
+            if (!status.isOK()) {
+                return;
+            }
+            auto opCtx = cc().makeOperationContext();
+            opCtx->setShouldParticipateInFlowControl(false);
+            prefetchDocuments(opCtx.get(), *targets, begin, end);
+        });
+    }
+}
+
+Status OplogApplierImpl::_applyWriterVectors(
+    const std::vector<OplogEntry>& ops,
+    std::vector<std::vector<const OplogEntry*>>* writerVectors,
+    std::vector<WorkerMultikeyPathInfo>* multikeyVector) {
+    std::vector<Status> statusVector(writerVectors->size(), Status::OK());
+    std::vector<WorkerMultikeyPathInfo> workerMultikeyVector(writerVectors->size());
+
+    // Schedule the largest writer vectors first, so that the smaller ones fill in the gaps at the
+    // end of the batch.
+    std::vector<size_t> writerOrder;
+    for (size_t i = 0; i < writerVectors->size(); i++) {
+        if (!(*writerVectors)[i].empty())
+            writerOrder.push_back(i);
+    }
+    std::stable_sort(writerOrder.begin(), writerOrder.end(), [&](size_t lhs, size_t rhs) {
+        return (*writerVectors)[lhs].size() > (*writerVectors)[rhs].size();
+    });
+
+    // Doles out all the work to the writer pool threads. writerVectors is not modified, but
+    // applyOplogBatchPerWorker will modify the vectors that it contains.
+    std::vector<ThreadPool::Task> tasks;
+    tasks.reserve(writerOrder.size());
+    for (auto i : writerOrder) {
+        tasks.push_back(
+            [this,
+             &writer = writerVectors->at(i),
+             &status = statusVector.at(i),
+             &multikeyPathInfo = workerMultikeyVector.at(i)](auto scheduleStatus) {
+                invariant(scheduleStatus);
+
+                auto opCtx = cc().makeOperationContext();
+
+                // This code path is only executed on secondaries and initial syncing nodes, so it
+                // is safe to exclude any writes from Flow Control.
+                opCtx->setShouldParticipateInFlowControl(false);
+
+                status = opCtx->runWithoutInterruptionExceptAtGlobalShutdown([&] {
+                    return applyOplogBatchPerWorker(opCtx.get(), &writer, &multikeyPathInfo);
+                });
+            });
+    }
+    _writerPool->scheduleBatch(std::move(tasks));
+
+    _writerPool->waitForIdle();
+
+    // If any of the statuses is not ok, return error.
+    for (auto it = statusVector.cbegin(); it != statusVector.cend(); ++it) {
+        const auto& status = *it;
+        if (!status.isOK()) {
+            LOGV2_FATAL_CONTINUE(21235,
+                                 "Failed to apply batch of operations. Number of operations in "
+                                 "batch: {numOperationsInBatch}. First operation: "
+                                 "{firstOperation}. Last operation: {lastOperation}. Oplog "
+                                 "application failed in writer thread {failedWriterThread}: "
+                                 "{error}",
+                                 "Failed to apply batch of operations",
+                                 "numOperationsInBatch"_attr = ops.size(),
+                                 "firstOperation"_attr = redact(ops.front().toBSONForLogging()),
+                                 "lastOperation"_attr = redact(ops.back().toBSONForLogging()),
+                                 "failedWriterThread"_attr =
+                                     std::distance(statusVector.cbegin(), it),
+                                 "error"_attr = redact(status));
+            return status;
+        }
     }
+
+    std::move(workerMultikeyVector.begin(),
+              workerMultikeyVector.end(),
+              std::back_inserter(*multikeyVector));
+    return Status::OK();
+}
+
+Status OplogApplierImpl::_applyTransactionChainInChunks(
+    OperationContext* opCtx,
+    const OplogEntry& commitOp,
+    std::vector<WorkerMultikeyPathInfo>* multikeyVector) {
+    // Only the optimes of the chain, which is read newest first, are kept in memory.
+    std::vector<OpTime> chainOpTimes;
+    TransactionHistoryIterator chainIter(commitOp.getPrevWriteOpTimeInTransaction().get());
+    while (chainIter.hasNext()) {
+        chainOpTimes.push_back(chainIter.nextFatalOnErrors(opCtx).getOpTime());
+    }
+
+    // The operations take the fields outside of the DurableReplOperation, such as 'ts', from the
+    // terminal applyOps entry, just as they do when the whole transaction is expanded at once.
+    auto commitObj = commitOp.getEntry().toBSON();
+    const size_t numWriterVectors = _writerPool->getStats().numThreads *
+        static_cast<size_t>(replWriterVectorsPerThread.load());
+    for (auto it = chainOpTimes.rbegin(); it != chainOpTimes.rend(); ++it) {
+        // Each entry is at most 16MB, and its operations are released before the next one is read.
+        // The entries are applied in order, so operations on the same document in different
+        // entries cannot be reordered by the writer threads.
+        const auto partialTxnOp = TransactionHistoryIterator(*it).nextFatalOnErrors(opCtx);
+        invariant(partialTxnOp.isPartialTransaction());
+
+        std::vector<OplogEntry> txnOps;
+        ApplyOps::extractOperationsTo(partialTxnOp, commitObj, &txnOps);
+        const bool shouldSerialize = std::any_of(
+            txnOps.begin(), txnOps.end(), [](const auto& op) { return op.isCommand(); });
+
+        CachedCollectionProperties collPropertiesCache;
+        std::vector<std::vector<const OplogEntry*>> writerVectors(numWriterVectors);
+        OplogApplierUtils::addDerivedOps(
+            opCtx, &txnOps, &writerVectors, &collPropertiesCache, shouldSerialize);
+
+        auto status = _applyWriterVectors({partialTxnOp}, &writerVectors, multikeyVector);
+        if (!status.isOK()) {
+            return status;
+        }
+    }
+
+    oplogApplicationTransactionChunks.increment(chainOpTimes.size());
+    return Status::OK();
 }
 
 StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
@@ -453,7 +698,12 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
     // Increment the batch size stat.
     oplogApplicationBatchSize.increment(ops.size());
 
-    std::vector<WorkerMultikeyPathInfo> multikeyVector(_writerPool->getStats().numThreads);
+    // Spread the ops over several writer vectors per thread. The pool hands each thread its next
+    // writer vector as it finishes the last one, so the threads whose vectors hash to fewer ops
+    // take on more of them instead of idling while the most loaded thread catches up.
+    const size_t numWriterVectors =
+        _writerPool->getStats().numThreads * static_cast<size_t>(replWriterVectorsPerThread.load());
+    std::vector<WorkerMultikeyPathInfo> multikeyVector;
     {
         // Each node records cumulative batch application stats for itself using this timer.
         TimerHolder timer(&applyBatchStats);
@@ -478,9 +728,14 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
         //   and create a pseudo oplog.
         std::vector<std::vector<OplogEntry>> derivedOps;
 
-        std::vector<std::vector<const OplogEntry*>> writerVectors(
-            _writerPool->getStats().numThreads);
-        fillWriterVectors(opCtx, &ops, &writerVectors, &derivedOps);
+        // A large unprepared transaction commits in a batch of its own. Rather than expanding every
+        // operation in the transaction into memory at once, apply the partialTxn entries that
+        // precede its terminal applyOps entry one at a time, ahead of the rest of the batch.
+        const bool applyTransactionChainInChunks =
+            shouldApplyTransactionChainInChunks(ops, getOptions().beginApplyingOpTime);
+
+        std::vector<std::vector<const OplogEntry*>> writerVectors(numWriterVectors);
+        fillWriterVectors(opCtx, &ops, &writerVectors, &derivedOps, applyTransactionChainInChunks);
 
         // Wait for writes to finish before applying ops.
         _writerPool->waitForIdle();
@@ -500,57 +755,16 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
             _consistencyMarkers->setMinValidToAtLeast(opCtx, ops.back().getOpTime());
         }
 
-        {
-            std::vector<Status> statusVector(_writerPool->getStats().numThreads, Status::OK());
-
-            // Doles out all the work to the writer pool threads. writerVectors is not modified,
-            // but  applyOplogBatchPerWorker will modify the vectors that it contains.
-            invariant(writerVectors.size() == statusVector.size());
-            for (size_t i = 0; i < writerVectors.size(); i++) {
-                if (writerVectors[i].empty())
-                    continue;
-
-                _writerPool->schedule(
-                    [this,
-                     &writer = writerVectors.at(i),
-                     &status = statusVector.at(i),
-                     &multikeyVector = multikeyVector.at(i)](auto scheduleStatus) {
-                        invariant(scheduleStatus);
-
-                        auto opCtx = cc().makeOperationContext();
-
-                        // This code path is only executed on secondaries and initial syncing nodes,
-                        // so it is safe to exclude any writes from Flow Control.
-                        opCtx->setShouldParticipateInFlowControl(false);
-
-                        status = opCtx->runWithoutInterruptionExceptAtGlobalShutdown([&] {
-                            return applyOplogBatchPerWorker(opCtx.get(), &writer, &multikeyVector);
-                        });
-                    });
+        if (applyTransactionChainInChunks) {
+            auto status = _applyTransactionChainInChunks(opCtx, ops.front(), &multikeyVector);
+            if (!status.isOK()) {
+                return status;
             }
+        }
 
-            _writerPool->waitForIdle();
-
-            // If any of the statuses is not ok, return error.
-            for (auto it = statusVector.cbegin(); it != statusVector.cend(); ++it) {
-                const auto& status = *it;
-                if (!status.isOK()) {
-                    LOGV2_FATAL_CONTINUE(
-                        21235,
-                        "Failed to apply batch of operations. Number of operations in "
-                        "batch: {numOperationsInBatch}. First operation: {firstOperation}. "
-                        "Last operation: "
-                        "{lastOperation}. Oplog application failed in writer thread "
-                        "{failedWriterThread}: {error}",
-                        "Failed to apply batch of operations",
-                        "numOperationsInBatch"_attr = ops.size(),
-                        "firstOperation"_attr = redact(ops.front().toBSONForLogging()),
-                        "lastOperation"_attr = redact(ops.back().toBSONForLogging()),
-                        "failedWriterThread"_attr = std::distance(statusVector.cbegin(), it),
-                        "error"_attr = redact(status));
-                    return status;
-                }
-            }
+        auto status = _applyWriterVectors(ops, &writerVectors, &multikeyVector);
+        if (!status.isOK()) {
+            return status;
         }
     }
 
@@ -558,8 +772,11 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
     // means that all the writes associated with the oplog entries in the batch are finished and no
     // new writes with timestamps associated with those oplog entries will show up in the future. We
     // want to flush the journal as soon as possible in order to free ops waiting with 'j' write
-    // concern.
-    JournalFlusher::get(opCtx)->triggerJournalFlush();
+    // concern. Nothing waits for the journal during recovery, which replays these batches again if
+    // it is interrupted, so let the storage engine flush it on its own schedule instead.
+    if (getOptions().mode != OplogApplication::Mode::kRecovering) {
+        JournalFlusher::get(opCtx)->triggerJournalFlush();
+    }
 
     // Use this fail point to hold the PBWM lock and prevent the batch from completing.
     if (MONGO_unlikely(pauseBatchApplicationBeforeCompletion.shouldFail())) {
@@ -618,7 +835,8 @@ void OplogApplierImpl::_deriveOpsAndFillWriterVectors(
     std::vector<OplogEntry>* ops,
     std::vector<std::vector<const OplogEntry*>>* writerVectors,
     std::vector<std::vector<OplogEntry>>* derivedOps,
-    SessionUpdateTracker* sessionUpdateTracker) noexcept {
+    SessionUpdateTracker* sessionUpdateTracker,
+    bool transactionChainAppliedInChunks) noexcept {
 
     LogicalSessionIdMap<std::vector<OplogEntry*>> partialTxnOps;
     CachedCollectionProperties collPropertiesCache;
@@ -669,7 +887,20 @@ void OplogApplierImpl::_deriveOpsAndFillWriterVectors(
             auto logicalSessionId = op.getSessionId();
             // applyOps entries generated by a transaction must have a sessionId and a
             // transaction number.
-            if (logicalSessionId && op.getTxnNumber()) {
+            if (logicalSessionId && op.getTxnNumber() && transactionChainAppliedInChunks) {
+                // The rest of the transaction has already been applied, so only the operations
+                // in this entry are left.
+                derivedOps->emplace_back(ApplyOps::extractOperations(op));
+                const bool shouldSerialize =
+                    std::any_of(derivedOps->back().begin(),
+                                derivedOps->back().end(),
+                                [](const auto& txnOp) { return txnOp.isCommand(); });
+                OplogApplierUtils::addDerivedOps(opCtx,
+                                                 &derivedOps->back(),
+                                                 writerVectors,
+                                                 &collPropertiesCache,
+                                                 shouldSerialize);
+            } else if (logicalSessionId && op.getTxnNumber()) {
                 // On commit of unprepared transactions, get transactional operations from the
                 // oplog and fill writers with those operations.
                 // Flush partialTxnList operations for current transaction.
@@ -711,16 +942,22 @@ void OplogApplierImpl::fillWriterVectors(
     OperationContext* opCtx,
     std::vector<OplogEntry>* ops,
     std::vector<std::vector<const OplogEntry*>>* writerVectors,
-    std::vector<std::vector<OplogEntry>>* derivedOps) noexcept {
+    std::vector<std::vector<OplogEntry>>* derivedOps,
+    bool transactionChainAppliedInChunks) noexcept {
 
     SessionUpdateTracker sessionUpdateTracker;
-    _deriveOpsAndFillWriterVectors(opCtx, ops, writerVectors, derivedOps, &sessionUpdateTracker);
+    _deriveOpsAndFillWriterVectors(opCtx,
+                                   ops,
+                                   writerVectors,
+                                   derivedOps,
+                                   &sessionUpdateTracker,
+                                   transactionChainAppliedInChunks);
 
     auto newOplogWrites = sessionUpdateTracker.flushAll();
     if (!newOplogWrites.empty()) {
         derivedOps->emplace_back(std::move(newOplogWrites));
         _deriveOpsAndFillWriterVectors(
-            opCtx, &derivedOps->back(), writerVectors, derivedOps, nullptr);
+            opCtx, &derivedOps->back(), writerVectors, derivedOps, nullptr, false);
     }
 }
 
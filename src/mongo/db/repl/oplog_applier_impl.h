@@ -98,11 +98,38 @@ private:
      */
     StatusWith<OpTime> _applyOplogBatch(OperationContext* opCtx, std::vector<OplogEntry> ops);
 
+    /**
+     * Schedules reads of the documents targeted by the updates and deletes in 'ops' on
+     * '_prefetchPool' and returns without waiting for them. Skips 'ops' if the pool is still
+     * reading the documents of an earlier batch.
+     */
+    void _prefetch(const std::vector<OplogEntry>& ops) override;
+
+    /**
+     * Schedules each of 'writerVectors' on the writer pool and waits for them to be applied,
+     * appending the multikey paths they set to 'multikeyVector'. 'ops' are the oplog entries the
+     * writer vectors were derived from, which are logged if any of them fail.
+     */
+    Status _applyWriterVectors(const std::vector<OplogEntry>& ops,
+                               std::vector<std::vector<const OplogEntry*>>* writerVectors,
+                               std::vector<WorkerMultikeyPathInfo>* multikeyVector);
+
+    /**
+     * Applies the partialTxn oplog entries that precede 'commitOp', the terminal applyOps entry of
+     * a large unprepared transaction, one entry at a time, so that only a single entry's
+     * operations are in memory at once. The operations in 'commitOp' itself are left to the
+     * caller.
+     */
+    Status _applyTransactionChainInChunks(OperationContext* opCtx,
+                                          const OplogEntry& commitOp,
+                                          std::vector<WorkerMultikeyPathInfo>* multikeyVector);
+
     void _deriveOpsAndFillWriterVectors(OperationContext* opCtx,
                                         std::vector<OplogEntry>* ops,
                                         std::vector<std::vector<const OplogEntry*>>* writerVectors,
                                         std::vector<std::vector<OplogEntry>>* derivedOps,
-                                        SessionUpdateTracker* sessionUpdateTracker) noexcept;
+                                        SessionUpdateTracker* sessionUpdateTracker,
+                                        bool transactionChainAppliedInChunks) noexcept;
 
     // Not owned by us.
     ReplicationCoordinator* const _replCoord;
@@ -111,6 +138,10 @@ private:
     // Not owned by us.
     ThreadPool* const _writerPool;
 
+    // Pool of threads reading the documents targeted by upcoming batches into the cache. Only
+    // exists while _run() is running and 'replOplogPrefetchThreadCount' is positive.
+    std::unique_ptr<ThreadPool> _prefetchPool;
+
     StorageInterface* _storageInterface;
 
     ReplicationConsistencyMarkers* const _consistencyMarkers;
@@ -122,7 +153,8 @@ private:
     void fillWriterVectors(OperationContext* opCtx,
                            std::vector<OplogEntry>* ops,
                            std::vector<std::vector<const OplogEntry*>>* writerVectors,
-                           std::vector<std::vector<OplogEntry>>* derivedOps) noexcept;
+                           std::vector<std::vector<OplogEntry>>* derivedOps,
+                           bool transactionChainAppliedInChunks = false) noexcept;
 
 protected:
     // Marked as protected for use in unit tests.
@@ -749,6 +749,71 @@ TEST_F(MultiOplogEntryOplogApplierImplTest, MultiApplyUnpreparedTransactionTwoBa
     ASSERT_BSONOBJ_EQ(insertDocs[3], *(nss1It++));
 }
 
+TEST_F(MultiOplogEntryOplogApplierImplTest, MultiApplyUnpreparedTransactionInChunksKeepsOrder) {
+    // The commit of a large transaction is in a batch of its own, so its partialTxn entries are
+    // applied one at a time. Each entry here replaces the document written by the one before it.
+    std::vector<OplogEntry> partialTxnOps;
+    const NamespaceString cmdNss{"admin", "$cmd"};
+    for (int i = 0; i < 3; i++) {
+        auto op = i == 0 ? BSON("op"
+                                << "i"
+                                << "ns" << _nss1.ns() << "ui" << *_uuid1 << "o" << BSON("_id" << 0))
+                         : BSON("op"
+                                << "u"
+                                << "ns" << _nss1.ns() << "ui" << *_uuid1 << "o"
+                                << BSON("_id" << 0 << "x" << i) << "o2" << BSON("_id" << 0));
+        partialTxnOps.push_back(makeCommandOplogEntryWithSessionInfoAndStmtId(
+            {Timestamp(Seconds(1), i + 1), 1LL},
+            cmdNss,
+            BSON("applyOps" << BSON_ARRAY(op) << "partialTxn" << true),
+            _lsid,
+            _txnNum,
+            StmtId(i),
+            i == 0 ? OpTime() : partialTxnOps.back().getOpTime()));
+    }
+    auto commitOp = makeCommandOplogEntryWithSessionInfoAndStmtId(
+        {Timestamp(Seconds(1), 4), 1LL},
+        cmdNss,
+        BSON("applyOps" << BSON_ARRAY(BSON("op"
+                                           << "i"
+                                           << "ns" << _nss2.ns() << "ui" << *_uuid2 << "o"
+                                           << BSON("_id" << 1)))),
+        _lsid,
+        _txnNum,
+        StmtId(3),
+        partialTxnOps.back().getOpTime());
+
+    NoopOplogApplierObserver observer;
+    OplogApplierImpl oplogApplier(
+        nullptr,  // executor
+        nullptr,  // oplogBuffer
+        &observer,
+        ReplicationCoordinator::get(_opCtx.get()),
+        getConsistencyMarkers(),
+        getStorageInterface(),
+        repl::OplogApplier::Options(repl::OplogApplication::Mode::kSecondary),
+        _writerPool.get());
+
+    ASSERT_OK(oplogApplier.applyOplogBatch(_opCtx.get(), partialTxnOps));
+    ASSERT_EQ(3U, oplogDocs().size());
+    ASSERT_TRUE(_insertedDocs[_nss1].empty());
+
+    ASSERT_OK(oplogApplier.applyOplogBatch(_opCtx.get(), {commitOp}));
+    ASSERT_EQ(4U, oplogDocs().size());
+    ASSERT_EQ(1U, _insertedDocs[_nss1].size());
+    ASSERT_EQ(1U, _insertedDocs[_nss2].size());
+    const auto idKey = BSON("_id" << 0);
+    auto doc = getStorageInterface()->findById(_opCtx.get(), _nss1, idKey.firstElement());
+    ASSERT_OK(doc.getStatus());
+    ASSERT_BSONOBJ_EQ(BSON("_id" << 0 << "x" << 2), doc.getValue());
+    checkTxnTable(_lsid,
+                  _txnNum,
+                  commitOp.getOpTime(),
+                  commitOp.getWallClockTime(),
+                  boost::none,
+                  DurableTxnStateEnum::kCommitted);
+}
+
 TEST_F(MultiOplogEntryOplogApplierImplTest, MultiApplyTwoTransactionsOneBatch) {
     // Tests that two transactions on the same session ID in the same batch both
     // apply correctly.
@@ -1911,6 +1976,32 @@ TEST_F(OplogApplierImplTest, ApplyGroupIgnoresUpdateOperationIfDocumentIsMissing
     ASSERT_FALSE(AutoGetCollectionForReadCommand(_opCtx.get(), nss).getCollection());
 }
 
+TEST_F(OplogApplierImplTest, ApplyGroupAppliesRunsOfUpdatesAndDeletesTogether) {
+    TestApplyOplogGroupApplier oplogApplier(
+        nullptr, nullptr, OplogApplier::Options(OplogApplication::Mode::kSecondary));
+    NamespaceString nss("test." + _agent.getSuiteName() + "_" + _agent.getTestName());
+    auto op0 = makeCreateCollectionOplogEntry({Timestamp(Seconds(1), 0), 1LL}, nss);
+    auto op1 = makeInsertDocumentOplogEntry({Timestamp(Seconds(2), 0), 1LL}, nss, BSON("_id" << 1));
+    auto op2 = makeInsertDocumentOplogEntry({Timestamp(Seconds(3), 0), 1LL}, nss, BSON("_id" << 2));
+    auto op3 = makeInsertDocumentOplogEntry({Timestamp(Seconds(4), 0), 1LL}, nss, BSON("_id" << 3));
+    auto op4 = makeUpdateDocumentOplogEntry(
+        {Timestamp(Seconds(5), 0), 1LL}, nss, BSON("_id" << 1), BSON("_id" << 1 << "x" << 1));
+    auto op5 = makeUpdateDocumentOplogEntry(
+        {Timestamp(Seconds(6), 0), 1LL}, nss, BSON("_id" << 2), BSON("_id" << 2 << "x" << 2));
+    auto op6 = makeUpdateDocumentOplogEntry(
+        {Timestamp(Seconds(7), 0), 1LL}, nss, BSON("_id" << 1), BSON("_id" << 1 << "x" << 3));
+    auto op7 = makeDeleteDocumentOplogEntry({Timestamp(Seconds(8), 0), 1LL}, nss, BSON("_id" << 2));
+    auto op8 = makeDeleteDocumentOplogEntry({Timestamp(Seconds(9), 0), 1LL}, nss, BSON("_id" << 3));
+    std::vector<const OplogEntry*> ops = {&op0, &op1, &op2, &op3, &op4, &op5, &op6, &op7, &op8};
+    WorkerMultikeyPathInfo pathInfo;
+    ASSERT_OK(oplogApplier.applyOplogBatchPerWorker(_opCtx.get(), &ops, &pathInfo));
+
+    // The updates to the same document were applied in order.
+    CollectionReader collectionReader(_opCtx.get(), nss);
+    ASSERT_BSONOBJ_EQ(BSON("_id" << 1 << "x" << 3), unittest::assertGet(collectionReader.next()));
+    ASSERT_EQUALS(ErrorCodes::CollectionIsEmpty, collectionReader.next().getStatus());
+}
+
 TEST_F(OplogApplierImplTest,
        OplogApplicationThreadFuncSkipsDocumentOnNamespaceNotFoundDuringInitialSync) {
     BSONObj emptyDoc;
@@ -39,6 +39,7 @@
 #include "mongo/db/db_raii.h"
 #include "mongo/db/repl/oplog_applier_utils.h"
 #include "mongo/db/repl/repl_server_parameters_gen.h"
+#include "mongo/db/repl/update_or_delete_group.h"
 #include "mongo/db/stats/counters.h"
 
 #include "mongo/logv2/log.h"
@@ -285,6 +286,8 @@ Status OplogApplierUtils::applyOplogBatchCommon(
     // mix up the current order of oplog entries within the same namespace (thus *stable* sort).
     stableSortByNamespace(ops);
     InsertGroup insertGroup(ops, opCtx, oplogApplicationMode, applyOplogEntryOrGroupedInserts);
+    UpdateOrDeleteGroup updateOrDeleteGroup(
+        ops, opCtx, oplogApplicationMode, applyOplogEntryOrGroupedInserts);
 
     for (auto it = ops->cbegin(); it != ops->cend(); ++it) {
         const OplogEntry& entry = **it;
@@ -296,6 +299,11 @@ Status OplogApplierUtils::applyOplogBatchCommon(
             it = groupResult.getValue();
             continue;
         }
+        groupResult = updateOrDeleteGroup.groupAndApplyUpdatesOrDeletes(it);
+        if (groupResult.isOK()) {
+            it = groupResult.getValue();
+            continue;
+        }
 
         // If we didn't create a group, try to apply the op individually.
         try {
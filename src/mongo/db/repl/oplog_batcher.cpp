@@ -282,8 +282,8 @@ void OplogBatcher::_run(StorageInterface* storageInterface) {
 
             auto oplogEntries =
                 fassertNoTrace(31004, getNextApplierBatch(opCtx.get(), batchLimits));
-            for (const auto& oplogEntry : oplogEntries) {
-                ops.emplace_back(oplogEntry);
+            for (auto& oplogEntry : oplogEntries) {
+                ops.emplace_back(std::move(oplogEntry));
             }
 
             // If we don't have anything in the batch, wait a bit for something to appear.
@@ -329,6 +329,12 @@ void OplogBatcher::_run(StorageInterface* storageInterface) {
             }
         }
 
+        // Let the applier start reading the documents this batch targets while it is still
+        // applying the previous batch.
+        if (!ops.empty()) {
+            _oplogApplier->prefetch(ops.getBatch());
+        }
+
         stdx::unique_lock<Latch> lk(_mutex);
         // Block until the previous batch has been taken.
         _cv.wait(lk, [&] { return _ops.empty() && !_ops.termWhenExhausted(); });
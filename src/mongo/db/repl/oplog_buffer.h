@@ -56,6 +56,10 @@ class OplogBuffer {
 public:
     /**
      * Type of item held in the oplog buffer;
+     *
+     * Entries fetched from the sync source share ownership of the reply buffer they arrived in
+     * rather than owning a copy of their bytes. Implementations which hold entries in memory should
+     * store them as they are pushed instead of making them owned.
      */
     using Value = BSONObj;
 
@@ -33,12 +33,13 @@
 namespace mongo {
 namespace repl {
 BSONObj OplogEntryOrGroupedInserts::toBSON() const {
-    if (!isGroupedInserts())
+    if (!isGrouped())
         return getOp().getEntry().toBSON();
 
     // Since we found more than one document, create grouped insert of many docs.
     // We are going to group many 'i' ops into one big 'i' op, with array fields for
-    // 'ts', 't', and 'o', corresponding to each individual op.
+    // 'ts', 't', and 'o', corresponding to each individual op. Grouped updates get an 'o2'
+    // array as well, and grouped deletes are combined the same way as inserts.
     // For example:
     // { ts: Timestamp(1,1), t:1, ns: "test.foo", op:"i", o: {_id:1} }
     // { ts: Timestamp(1,2), t:1, ns: "test.foo", op:"i", o: {_id:2} }
@@ -76,8 +77,15 @@ BSONObj OplogEntryOrGroupedInserts::toBSON() const {
             oArrayBuilder.append(op->getObject());
         }
     }
-    // Generate an op object of all elements except for "ts", "t", and "o", since we
-    // need to make those fields arrays of all the ts's, t's, and o's.
+    // Populate the "o2" field with an array of all the grouped updates' criteria.
+    if (getOp().getOpType() == OpTypeEnum::kUpdate) {
+        BSONArrayBuilder o2ArrayBuilder(groupedInsertBuilder.subarrayStart("o2"));
+        for (auto op : _entryOrGroupedInserts) {
+            o2ArrayBuilder.append(op->getObject2().value_or(BSONObj()));
+        }
+    }
+    // Generate an op object of all elements except for "ts", "t", "o" and "o2", since we
+    // need to make those fields arrays of all the ts's, t's, o's and o2's.
     groupedInsertBuilder.appendElementsUnique(getOp().getEntry().toBSON());
     return groupedInsertBuilder.obj();
 }
@@ -37,7 +37,7 @@ namespace repl {
 /**
  * This is a class for a single oplog entry or grouped inserts to be applied in
  * applyOplogEntryOrGroupedInserts. This class is immutable and can only be initialized using
- * either a single oplog entry or a range of grouped inserts.
+ * either a single oplog entry or a range of grouped inserts, updates or deletes.
  */
 class OplogEntryOrGroupedInserts {
 public:
@@ -48,14 +48,17 @@ public:
     // This initializes it as a single oplog entry.
     OplogEntryOrGroupedInserts(const OplogEntry* op) : _entryOrGroupedInserts({op}) {}
 
-    // This initializes it as grouped inserts.
+    // This initializes it as grouped inserts, updates or deletes.
     OplogEntryOrGroupedInserts(ConstIterator begin, ConstIterator end)
         : _entryOrGroupedInserts(begin, end) {
         // Performs sanity checks to confirm that the batch is valid.
         invariant(!_entryOrGroupedInserts.empty());
+        const auto opType = _entryOrGroupedInserts.front()->getOpType();
+        invariant(opType == OpTypeEnum::kInsert || opType == OpTypeEnum::kUpdate ||
+                  opType == OpTypeEnum::kDelete);
         for (auto op : _entryOrGroupedInserts) {
-            // Every oplog entry must be an insert.
-            invariant(op->getOpType() == OpTypeEnum::kInsert);
+            // Every oplog entry must be of the same type.
+            invariant(op->getOpType() == opType);
             // Every oplog entry must be in the same namespace.
             invariant(op->getNss() == _entryOrGroupedInserts.front()->getNss());
         }
@@ -66,10 +69,19 @@ public:
         return *(_entryOrGroupedInserts.front());
     }
 
-    bool isGroupedInserts() const {
+    bool isGrouped() const {
         return _entryOrGroupedInserts.size() > 1;
     }
 
+    bool isGroupedInserts() const {
+        return isGrouped() && getOp().getOpType() == OpTypeEnum::kInsert;
+    }
+
+    const std::vector<const OplogEntry*>& getGroupedOps() const {
+        invariant(isGrouped());
+        return _entryOrGroupedInserts;
+    }
+
     const std::vector<const OplogEntry*>& getGroupedInserts() const {
         invariant(isGroupedInserts());
         return _entryOrGroupedInserts;
@@ -79,7 +91,7 @@ public:
     BSONObj toBSON() const;
 
 private:
-    // A single oplog entry or a batch of grouped insert oplog entries to be applied.
+    // A single oplog entry or a batch of grouped oplog entries of the same type to be applied.
     std::vector<const OplogEntry*> _entryOrGroupedInserts;
 };
 }  // namespace repl
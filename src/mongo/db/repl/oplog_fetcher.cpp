@@ -38,6 +38,7 @@
 #include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/repl/replication_auth.h"
 #include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/repl/replication_metrics.h"
 #include "mongo/db/stats/timer_stats.h"
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/metadata/oplog_query_metadata.h"
@@ -439,6 +440,12 @@ Status OplogFetcher::_connect() {
                           "error"_attr = connectStatus);
                     _conn->checkConnection();
                 } else {
+                    // Oplog batches are large and compress well, so ask the sync source to use
+                    // the preferred compressor if it has been enabled on both sides.
+                    if (!oplogFetcherPreferredCompressor.empty()) {
+                        _conn->getCompressorManager().setPreferredCompressors(
+                            {oplogFetcherPreferredCompressor});
+                    }
                     uassertStatusOK(_conn->connect(_config.source, "OplogFetcher", boost::none));
                 }
                 uassertStatusOK(replAuthenticate(_conn.get())
@@ -776,6 +783,8 @@ Status OplogFetcher::_onSuccessfulBatch(const Documents& documents) {
     networkByteStats.increment(info.networkDocumentBytes);
 
     oplogBatchStats.recordMillis(_lastBatchElapsedMS, documents.empty());
+    ReplicationMetrics::get(cc().getServiceContext())
+        .recordOplogFetcherBatch(info.networkDocumentBytes, Milliseconds(_lastBatchElapsedMS));
 
     if (_cursor->getPostBatchResumeToken()) {
         auto pbrt = ResumeTokenOplogTimestamp::parse(
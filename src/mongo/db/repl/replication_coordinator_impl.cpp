@@ -3001,6 +3001,8 @@ Status ReplicationCoordinatorImpl::processReplSetGetStatus(
         ReplicationMetrics::get(getServiceContext()).getElectionCandidateMetricsBSON();
     BSONObj electionParticipantMetrics =
         ReplicationMetrics::get(getServiceContext()).getElectionParticipantMetricsBSON();
+    BSONObj oplogFetcherMetrics =
+        ReplicationMetrics::get(getServiceContext()).getOplogFetcherMetricsBSON();
 
     stdx::lock_guard<Latch> lk(_mutex);
     if (_inShutdown) {
@@ -3020,6 +3022,10 @@ Status ReplicationCoordinatorImpl::processReplSetGetStatus(
             _externalState->tooStale()},
         response,
         &result);
+
+    if (result.isOK() && !oplogFetcherMetrics.isEmpty()) {
+        response->append("oplogFetcherMetrics", oplogFetcherMetrics);
+    }
     return result;
 }
 
@@ -3998,6 +4004,8 @@ void ReplicationCoordinatorImpl::_fulfillTopologyChangePromise(WithLock lock) {
         } else {
             StringData horizonString = iter->first;
             auto response = _makeHelloResponse(horizonString, lock, hasValidConfig);
+            // All the waiters of this horizon share the response, so serialize it once for them.
+            response->cacheSerializedResponses();
             // Fulfill the promise and replace with a new one for future waiters.
             iter->second->emplaceValue(response);
             iter->second = std::make_shared<SharedPromise<std::shared_ptr<const HelloResponse>>>();
@@ -4018,6 +4026,7 @@ void ReplicationCoordinatorImpl::_fulfillTopologyChangePromise(WithLock lock) {
             } else {
                 const auto horizon = sni.empty() ? SplitHorizon::kDefaultHorizon : iter->second;
                 const auto response = _makeHelloResponse(horizon, lock, hasValidConfig);
+                response->cacheSerializedResponses();
                 promise->emplaceValue(response);
             }
         }
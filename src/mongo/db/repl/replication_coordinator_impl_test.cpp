@@ -3299,6 +3299,62 @@ TEST_F(ReplCoordTest, AwaitHelloResponseReturnsOnStepDown) {
     getHelloThread.join();
 }
 
+TEST_F(ReplCoordTest, AwaitHelloResponseSharesSerializedResponseOnTopologyChange) {
+    init();
+    assertStartSuccess(BSON("_id"
+                            << "mySet"
+                            << "version" << 2 << "members"
+                            << BSON_ARRAY(BSON("host"
+                                               << "node1:12345"
+                                               << "_id" << 0)
+                                          << BSON("host"
+                                                  << "node2:12345"
+                                                  << "_id" << 1))),
+                       HostAndPort("node1", 12345));
+    ASSERT_OK(getReplCoord()->setFollowerMode(MemberState::RS_SECONDARY));
+
+    auto deadline = getNet()->now() + Milliseconds(5000);
+    auto currentTopologyVersion = getTopoCoord().getTopologyVersion();
+
+    auto waitForHelloFailPoint = globalFailPointRegistry().find("waitForHelloResponse");
+    auto timesEnteredFailPoint = waitForHelloFailPoint->setMode(FailPoint::alwaysOn, 0);
+    ON_BLOCK_EXIT([&] { waitForHelloFailPoint->setMode(FailPoint::off, 0); });
+
+    // Both waiters of the default horizon get the same response, serialized once.
+    std::shared_ptr<const HelloResponse> responses[2];
+    stdx::thread getHelloThreads[2];
+    for (int i = 0; i < 2; ++i) {
+        getHelloThreads[i] = stdx::thread([&, i] {
+            responses[i] =
+                awaitHelloWithNewOpCtx(getReplCoord(), currentTopologyVersion, {}, deadline);
+        });
+    }
+    waitForHelloFailPoint->waitForTimesEntered(timesEnteredFailPoint + 2);
+
+    // Transitioning to RECOVERING is a topology change.
+    ASSERT_OK(getReplCoord()->setFollowerMode(MemberState::RS_RECOVERING));
+    for (auto& getHelloThread : getHelloThreads) {
+        getHelloThread.join();
+    }
+
+    ASSERT_EQUALS(responses[0].get(), responses[1].get());
+    for (bool useLegacyResponseFields : {true, false}) {
+        auto serialized = responses[0]->toBSON(useLegacyResponseFields);
+        ASSERT_EQUALS(serialized.objdata(),
+                      responses[1]->toBSON(useLegacyResponseFields).objdata());
+
+        BSONObjBuilder builder;
+        responses[0]->addToBSON(&builder, useLegacyResponseFields);
+        ASSERT_BSONOBJ_EQ(serialized, builder.obj());
+    }
+    ASSERT_TRUE(responses[0]->toBSON(true).hasField("ismaster"));
+    ASSERT_FALSE(responses[0]->toBSON(true).hasField("isWritablePrimary"));
+    ASSERT_TRUE(responses[0]->toBSON(false).hasField("isWritablePrimary"));
+    ASSERT_FALSE(responses[0]->toBSON(false).getBoolField("secondary"));
+    ASSERT_EQUALS(responses[0]->getTopologyVersion()->getCounter(),
+                  currentTopologyVersion.getCounter() + 1);
+}
+
 TEST_F(ReplCoordTest, HelloReturnsErrorOnEnteringQuiesceMode) {
     init();
     assertStartSuccess(BSON("_id"
@@ -379,6 +379,44 @@ void ReplicationMetrics::clearParticipantNewTermDates() {
     _electionParticipantMetrics.setNewTermAppliedDate(boost::none);
 }
 
+void ReplicationMetrics::recordOplogFetcherBatch(long long numBytes, Milliseconds elapsed) {
+    // The weight given to the newest batch in 'recentBytesPerSecond'.
+    constexpr double kThroughputAlpha = 0.2;
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    _oplogFetcherMetrics.setNumBatches(_oplogFetcherMetrics.getNumBatches() + 1);
+    _oplogFetcherMetrics.setNumBytes(_oplogFetcherMetrics.getNumBytes() + numBytes);
+    _oplogFetcherMetrics.setTotalBatchMillis(_oplogFetcherMetrics.getTotalBatchMillis() +
+                                             durationCount<Milliseconds>(elapsed));
+
+    // Empty batches only say that the sync source had nothing new to send, so they would drag the
+    // throughput down while this node is caught up.
+    if (numBytes > 0) {
+        double bytesPerSecond =
+            numBytes * 1000.0 / std::max<long long>(durationCount<Milliseconds>(elapsed), 1);
+        double previous = _oplogFetcherMetrics.getRecentBytesPerSecond();
+        _oplogFetcherMetrics.setRecentBytesPerSecond(previous == 0.0
+                                                         ? bytesPerSecond
+                                                         : kThroughputAlpha * bytesPerSecond +
+                                                             (1 - kThroughputAlpha) * previous);
+    }
+}
+
+void ReplicationMetrics::recordOplogBufferWait(Milliseconds elapsed) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _oplogFetcherMetrics.setNumBufferWaits(_oplogFetcherMetrics.getNumBufferWaits() + 1);
+    _oplogFetcherMetrics.setTotalBufferWaitMillis(_oplogFetcherMetrics.getTotalBufferWaitMillis() +
+                                                  durationCount<Milliseconds>(elapsed));
+}
+
+BSONObj ReplicationMetrics::getOplogFetcherMetricsBSON() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (_oplogFetcherMetrics.getNumBatches() > 0) {
+        return _oplogFetcherMetrics.toBSON();
+    }
+    return BSONObj();
+}
+
 void ReplicationMetrics::_updateAverageCatchUpOps(WithLock lk) {
     long numCatchUps = _electionMetrics.getNumCatchUps();
     if (numCatchUps > 0) {
@@ -119,6 +119,11 @@ public:
     void setParticipantNewTermDates(Date_t newTermStartDate, Date_t newTermAppliedDate);
     void clearParticipantNewTermDates();
 
+    // Oplog fetcher metrics
+    void recordOplogFetcherBatch(long long numBytes, Milliseconds elapsed);
+    void recordOplogBufferWait(Milliseconds elapsed);
+
+    BSONObj getOplogFetcherMetricsBSON();
 
 private:
     class ElectionMetricsSSS;
@@ -129,6 +134,7 @@ private:
     ElectionMetrics _electionMetrics;
     ElectionCandidateMetrics _electionCandidateMetrics;
     ElectionParticipantMetrics _electionParticipantMetrics;
+    OplogFetcherMetrics _oplogFetcherMetrics;
 
     bool _nodeIsCandidateOrPrimary = false;
     bool _nodeHasVotedInElection = false;
@@ -44,6 +44,7 @@
 #include "mongo/db/repl/oplog_applier_impl.h"
 #include "mongo/db/repl/oplog_buffer.h"
 #include "mongo/db/repl/oplog_interface_local.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/repl/replication_consistency_markers_impl.h"
 #include "mongo/db/repl/storage_interface.h"
 #include "mongo/db/repl/transaction_oplog_application.h"
@@ -64,6 +65,9 @@ namespace {
 const auto kRecoveryBatchLogLevel = logv2::LogSeverity::Debug(2);
 const auto kRecoveryOperationLogLevel = logv2::LogSeverity::Debug(3);
 
+// How often to report the progress of oplog application for recovery.
+const auto kRecoveryProgressLogIntervalSecs = 10;
+
 /**
  * Tracks and logs operations applied during recovery.
  */
@@ -102,7 +106,21 @@ public:
         }
     }
 
-    void onBatchEnd(const StatusWith<OpTime>&, const std::vector<OplogEntry>&) final {}
+    void onBatchEnd(const StatusWith<OpTime>& lastOpApplied,
+                    const std::vector<OplogEntry>&) final {
+        // Replaying a large oplog can take a long time, so report progress periodically.
+        if (!lastOpApplied.isOK() ||
+            _sinceProgressLog.seconds() < kRecoveryProgressLogIntervalSecs) {
+            return;
+        }
+        _sinceProgressLog.reset();
+        LOGV2(5502116,
+              "Oplog application for recovery in progress",
+              "numOpsApplied"_attr = _numOpsApplied,
+              "numBatches"_attr = _numBatches,
+              "opsPerSecond"_attr = _getOpsPerSecond(),
+              "lastOpTimeApplied"_attr = lastOpApplied.getValue());
+    }
 
     void complete(const OpTime& applyThroughOpTime) const {
         LOGV2(21536,
@@ -111,12 +129,22 @@ public:
               "Completed oplog application for recovery",
               "numOpsApplied"_attr = _numOpsApplied,
               "numBatches"_attr = _numBatches,
-              "applyThroughOpTime"_attr = applyThroughOpTime);
+              "applyThroughOpTime"_attr = applyThroughOpTime,
+              "durationMillis"_attr = _sinceStart.millis(),
+              "opsPerSecond"_attr = _getOpsPerSecond());
     }
 
 private:
+    long long _getOpsPerSecond() const {
+        const auto micros = _sinceStart.micros();
+        return micros > 0 ? static_cast<long long>(_numOpsApplied * 1000 * 1000 / micros) : 0;
+    }
+
     std::size_t _numBatches = 0;
     std::size_t _numOpsApplied = 0;
+
+    const Timer _sinceStart;
+    Timer _sinceProgressLog;
 };
 
 /**
@@ -603,7 +631,9 @@ Timestamp ReplicationRecoveryImpl::_applyOplogOperations(OperationContext* opCtx
 
     OplogApplier::BatchLimits batchLimits;
     batchLimits.bytes = getBatchLimitOplogBytes(opCtx, _storageInterface);
-    batchLimits.ops = getBatchLimitOplogEntries();
+    // Nothing else runs while we recover, so use larger batches than steady state replication to
+    // keep the writer threads busy and to pay the per-batch costs less often.
+    batchLimits.ops = std::size_t(replRecoveryBatchLimitOperations.load());
 
     OpTime applyThroughOpTime;
     std::vector<OplogEntry> batch;
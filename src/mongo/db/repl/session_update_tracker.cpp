@@ -73,39 +73,6 @@ OplogEntry createOplogEntryForTransactionTableUpdate(repl::OpTime opTime,
                                     boost::none)};  // _id
 }
 
-/**
- * Constructs a new oplog entry if the given entry has transaction state embedded within in. The new
- * oplog entry will contain the operation needed to replicate the transaction table.
- *
- * Returns boost::none if the given oplog doesn't have any transaction state or does not support
- * update to the transaction table.
- */
-boost::optional<repl::OplogEntry> createMatchingTransactionTableUpdate(
-    const repl::OplogEntry& entry) {
-    auto sessionInfo = entry.getOperationSessionInfo();
-    if (!sessionInfo.getTxnNumber()) {
-        return boost::none;
-    }
-
-    invariant(sessionInfo.getSessionId());
-
-    const auto updateBSON = [&] {
-        SessionTxnRecord newTxnRecord;
-        newTxnRecord.setSessionId(*sessionInfo.getSessionId());
-        newTxnRecord.setTxnNum(*sessionInfo.getTxnNumber());
-        newTxnRecord.setLastWriteOpTime(entry.getOpTime());
-        newTxnRecord.setLastWriteDate(entry.getWallClockTime());
-
-        return newTxnRecord.toBSON();
-    }();
-
-    return createOplogEntryForTransactionTableUpdate(
-        entry.getOpTime(),
-        updateBSON,
-        BSON(SessionTxnRecord::kSessionIdFieldName << sessionInfo.getSessionId()->toBSON()),
-        entry.getWallClockTime());
-}
-
 /**
  * Returns true if the oplog entry represents an operation in a transaction and false otherwise.
  */
@@ -123,6 +90,29 @@ bool isTransactionEntry(OplogEntry entry) {
 
 }  // namespace
 
+/**
+ * Constructs a new oplog entry which replicates the transaction table update of the last retryable
+ * write 'write' of the session 'lsid'.
+ */
+OplogEntry SessionUpdateTracker::_createMatchingTransactionTableUpdate(
+    const LogicalSessionId& lsid, const RetryableWrite& write) {
+    const auto updateBSON = [&] {
+        SessionTxnRecord newTxnRecord;
+        newTxnRecord.setSessionId(lsid);
+        newTxnRecord.setTxnNum(write.txnNumber);
+        newTxnRecord.setLastWriteOpTime(write.opTime);
+        newTxnRecord.setLastWriteDate(write.wallClockTime);
+
+        return newTxnRecord.toBSON();
+    }();
+
+    return createOplogEntryForTransactionTableUpdate(write.opTime,
+                                                     updateBSON,
+                                                     BSON(SessionTxnRecord::kSessionIdFieldName
+                                                          << lsid.toBSON()),
+                                                     write.wallClockTime);
+}
+
 boost::optional<std::vector<OplogEntry>> SessionUpdateTracker::_updateOrFlush(
     const OplogEntry& entry) {
     const auto& ns = entry.getNss();
@@ -179,28 +169,29 @@ void SessionUpdateTracker::_updateSessionInfo(const OplogEntry& entry) {
         }
     }
 
+    // Only the last retryable write of each session in the batch updates the transaction table,
+    // so keep just what that update needs rather than a copy of every entry.
+    RetryableWrite write{*sessionInfo.getTxnNumber(), entry.getOpTime(), entry.getWallClockTime()};
     auto iter = _sessionsToUpdate.find(*lsid);
     if (iter == _sessionsToUpdate.end()) {
-        _sessionsToUpdate.emplace(*lsid, entry);
+        _sessionsToUpdate.emplace(*lsid, std::move(write));
         return;
     }
 
-    const auto& existingSessionInfo = iter->second.getOperationSessionInfo();
-    if (*sessionInfo.getTxnNumber() >= *existingSessionInfo.getTxnNumber()) {
-        iter->second = entry;
+    if (write.txnNumber >= iter->second.txnNumber) {
+        iter->second = std::move(write);
         return;
     }
 
     LOGV2_FATAL_NOTRACE(50843,
                         "Entry for session {lsid} has txnNumber {sessionInfo_getTxnNumber} < "
                         "{existingSessionInfo_getTxnNumber}. New oplog entry: {newEntry}, Existing "
-                        "oplog entry: {existingEntry}",
+                        "oplog entry optime: {existingEntryOpTime}",
                         "lsid"_attr = lsid->toBSON(),
-                        "sessionInfo_getTxnNumber"_attr = *sessionInfo.getTxnNumber(),
-                        "existingSessionInfo_getTxnNumber"_attr =
-                            *existingSessionInfo.getTxnNumber(),
+                        "sessionInfo_getTxnNumber"_attr = write.txnNumber,
+                        "existingSessionInfo_getTxnNumber"_attr = iter->second.txnNumber,
                         "newEntry"_attr = redact(entry.toBSONForLogging()),
-                        "existingEntry"_attr = redact(iter->second.toBSONForLogging()));
+                        "existingEntryOpTime"_attr = iter->second.opTime);
 }
 
 std::vector<OplogEntry> SessionUpdateTracker::_flush(const OplogEntry& entry) {
@@ -228,10 +219,9 @@ std::vector<OplogEntry> SessionUpdateTracker::_flush(const OplogEntry& entry) {
 std::vector<OplogEntry> SessionUpdateTracker::flushAll() {
     std::vector<OplogEntry> opList;
 
+    opList.reserve(_sessionsToUpdate.size());
     for (auto&& entry : _sessionsToUpdate) {
-        auto newUpdate = createMatchingTransactionTableUpdate(entry.second);
-        invariant(newUpdate);
-        opList.push_back(std::move(*newUpdate));
+        opList.push_back(_createMatchingTransactionTableUpdate(entry.first, entry.second));
     }
     _sessionsToUpdate.clear();
 
@@ -249,9 +239,7 @@ std::vector<OplogEntry> SessionUpdateTracker::_flushForQueryPredicate(
     }
 
     std::vector<OplogEntry> opList;
-    auto updateOplog = createMatchingTransactionTableUpdate(iter->second);
-    invariant(updateOplog);
-    opList.push_back(std::move(*updateOplog));
+    opList.push_back(_createMatchingTransactionTableUpdate(iter->first, iter->second));
     _sessionsToUpdate.erase(iter);
 
     return opList;
@@ -97,7 +97,22 @@ private:
     boost::optional<OplogEntry> _createTransactionTableUpdateFromTransactionOp(
         const repl::OplogEntry& entry);
 
-    LogicalSessionIdMap<OplogEntry> _sessionsToUpdate;
+    // What the transaction table update of a retryable write needs from its oplog entry.
+    struct RetryableWrite {
+        TxnNumber txnNumber;
+        OpTime opTime;
+        Date_t wallClockTime;
+    };
+
+    /**
+     * Returns the oplog entry which updates the transaction table for the retryable write 'write'
+     * of the session 'lsid'.
+     */
+    static OplogEntry _createMatchingTransactionTableUpdate(const LogicalSessionId& lsid,
+                                                            const RetryableWrite& write);
+
+    // The last retryable write of each session since the last flush.
+    LogicalSessionIdMap<RetryableWrite> _sessionsToUpdate;
 };
 
 }  // namespace repl
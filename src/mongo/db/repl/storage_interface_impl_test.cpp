@@ -49,6 +49,7 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/oplog_applier_impl_test_fixture.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/repl/replication_coordinator_mock.h"
 #include "mongo/db/repl/storage_interface_impl.h"
 #include "mongo/db/service_context_d_test_fixture.h"
@@ -57,6 +58,7 @@
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
 
 namespace {
@@ -582,6 +584,39 @@ TEST_F(StorageInterfaceImplTest, CreateCollectionWithIDIndexCommits) {
     ASSERT_EQ(count, 2LL);
 }
 
+TEST_F(StorageInterfaceImplTest, BulkLoaderGeneratesSecondaryIndexKeysOnSeveralThreads) {
+    auto opCtx = getOperationContext();
+    StorageInterfaceImpl storage;
+    auto nss = makeNamespace(_agent);
+    const auto originalThreads = collectionBulkLoaderIndexKeyThreads.load();
+    collectionBulkLoaderIndexKeyThreads.store(4);
+    ON_BLOCK_EXIT([&] { collectionBulkLoaderIndexKeyThreads.store(originalThreads); });
+
+    std::vector<BSONObj> indexes = {BSON("v" << static_cast<int>(kIndexVersion) << "key"
+                                             << BSON("x" << 1) << "name"
+                                             << "x_1")};
+    auto loader = unittest::assertGet(storage.createCollectionForBulkLoading(
+        nss, generateOptionsWithUuid(), makeIdIndexSpec(nss), indexes));
+    std::vector<BSONObj> docs;
+    for (int i = 0; i < 1000; ++i) {
+        docs.push_back(BSON("_id" << i << "x" << BSON_ARRAY(i << -i - 1)));
+    }
+    // Duplicate _id values are still skipped when the keys are generated in parallel.
+    docs.push_back(BSON("_id" << 0 << "x" << 0));
+    ASSERT_OK(loader->insertDocuments(docs.begin(), docs.end()));
+    ASSERT_OK(loader->commit());
+
+    AutoGetCollectionForReadCommand coll(opCtx, nss);
+    ASSERT(coll);
+    ASSERT_EQ(coll->getRecordStore()->numRecords(opCtx), 1000LL);
+    auto collIdxCat = coll->getIndexCatalog();
+    ASSERT_EQ(getIndexKeyCount(opCtx, collIdxCat, collIdxCat->findIdIndex(opCtx)), 1000LL);
+    auto xIdxDesc = collIdxCat->findIndexByName(opCtx, "x_1");
+    ASSERT(xIdxDesc);
+    ASSERT_EQ(getIndexKeyCount(opCtx, collIdxCat, xIdxDesc), 2000LL);
+    ASSERT(collIdxCat->getEntry(xIdxDesc)->isMultikey());
+}
+
 void _testDestroyUncommitedCollectionBulkLoader(
     OperationContext* opCtx,
     const NamespaceString& nss,
@@ -31,7 +31,10 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
+
 #include "mongo/base/string_data.h"
+#include "mongo/db/client.h"
 #include "mongo/db/commands/list_collections_filter.h"
 #include "mongo/db/dbdirectclient.h"
 #include "mongo/db/repl/cloner_utils.h"
@@ -40,7 +43,9 @@
 #include "mongo/db/repl/tenant_database_cloner.h"
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/get_status_from_command_result.h"
+#include "mongo/stdx/condition_variable.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/thread_pool.h"
 
 namespace mongo {
 namespace repl {
@@ -212,14 +217,20 @@ BaseCloner::AfterStageBehavior TenantDatabaseCloner::listExistingCollectionsStag
     }
 
     // We are resuming, restart from the collection whose UUID compared greater than or equal to
-    // the last collection we have on disk.
+    // the last collection we have on disk. When collections are cloned concurrently, the
+    // 'concurrency' - 1 collections before it may not have been finished yet, so restart from the
+    // first of them. Collections which were cloned already are resumed where they left off.
     if (!clonedCollectionUUIDs.empty()) {
-        const auto& lastClonedCollectionUUID = clonedCollectionUUIDs.back();
-        const auto& startingCollection = std::lower_bound(
+        const auto& lastClonedCollectionUUID =
+            *std::max_element(clonedCollectionUUIDs.begin(), clonedCollectionUUIDs.end());
+        auto startingCollection = std::lower_bound(
             _collections.begin(),
             _collections.end(),
             lastClonedCollectionUUID,
             [](const auto& collection, const auto& uuid) { return collection.second.uuid < uuid; });
+        const auto concurrency = getSharedData()->getCollectionClonerConcurrency();
+        startingCollection -= std::min<std::ptrdiff_t>(
+            concurrency - 1, std::distance(_collections.begin(), startingCollection));
         _collections.erase(_collections.begin(), startingCollection);
         if (!_collections.empty()) {
             LOGV2(5271601,
@@ -253,6 +264,11 @@ void TenantDatabaseCloner::postStage() {
             _stats.collectionStats.back().ns = coll.first.ns();
         }
     }
+    const auto concurrency = getSharedData()->getCollectionClonerConcurrency();
+    if (concurrency > 1 && _collections.size() > 1) {
+        _cloneCollectionsConcurrently(static_cast<size_t>(concurrency));
+        return;
+    }
     for (const auto& coll : _collections) {
         auto& sourceNss = coll.first;
         auto& collectionOptions = coll.second;
@@ -301,12 +317,156 @@ void TenantDatabaseCloner::postStage() {
     _stats.end = getSharedData()->getClock()->now();
 }
 
+void TenantDatabaseCloner::_cloneCollectionsConcurrently(size_t concurrency) {
+    ThreadPool::Options options;
+    options.poolName = "TenantDatabaseCloner-" + _dbName;
+    options.minThreads = 0;
+    options.maxThreads = concurrency;
+    options.onCreateThread = [](const std::string& name) { Client::initThread(name); };
+    ThreadPool collectionClonerPool(options);
+    collectionClonerPool.startup();
+
+    // Every running collection cloner has a connection to the donor of its own. The connections
+    // beyond our own are made when first needed, and kept until all collections are cloned.
+    std::vector<DBClientConnection*> idleClients{getClient()};
+    std::vector<std::shared_ptr<DBClientConnection>> clonerClients;
+
+    stdx::condition_variable clonerDoneCV;
+    std::vector<bool> cloned(_collections.size(), false);
+    size_t numStarted = 0;
+    size_t numRunning = 0;
+    size_t numPrefixCloned = 0;
+    Status firstError = Status::OK();
+
+    auto onError = [&](WithLock, const Status& status, const NamespaceString& nss) {
+        if (!firstError.isOK()) {
+            return Status::OK();
+        }
+        firstError = status;
+        return Status{status.code(),
+                      status.withContext(str::stream() << "Error cloning collection '"
+                                                       << nss.toString() << "'")
+                          .toString()};
+    };
+
+    stdx::unique_lock<Latch> lk(_mutex);
+    while (true) {
+        // A collection is only started once all the collections 'concurrency' or more before it
+        // are cloned, so that a resumed migration never has to go back further than that.
+        clonerDoneCV.wait(lk, [&] {
+            return !firstError.isOK() || numStarted == _collections.size() ||
+                numStarted < numPrefixCloned + concurrency;
+        });
+        if (!firstError.isOK() || numStarted == _collections.size()) {
+            break;
+        }
+
+        const auto index = numStarted;
+        const auto& sourceNss = _collections[index].first;
+        if (idleClients.empty()) {
+            lk.unlock();
+            auto swClient = [&]() -> StatusWith<std::shared_ptr<DBClientConnection>> {
+                try {
+                    return getSharedData()->makeClonerClient();
+                } catch (const DBException& ex) {
+                    return ex.toStatus();
+                }
+            }();
+            lk.lock();
+            if (!swClient.isOK()) {
+                auto failedStatus = onError(lk, swClient.getStatus(), sourceNss);
+                if (!failedStatus.isOK()) {
+                    lk.unlock();
+                    setSyncFailedStatus(failedStatus);
+                    lk.lock();
+                }
+                break;
+            }
+            clonerClients.push_back(std::move(swClient.getValue()));
+            idleClients.push_back(clonerClients.back().get());
+        }
+        auto client = idleClients.back();
+        idleClients.pop_back();
+
+        auto collectionCloner = std::make_unique<TenantCollectionCloner>(sourceNss,
+                                                                         _collections[index].second,
+                                                                         getSharedData(),
+                                                                         getSource(),
+                                                                         client,
+                                                                         getStorageInterface(),
+                                                                         getDBPool(),
+                                                                         _tenantId);
+        _activeCollectionCloners.emplace(index, collectionCloner.get());
+        ++numStarted;
+        ++numRunning;
+
+        auto task = [&, index, client, collectionCloner = std::move(collectionCloner)](
+                        auto status) {
+            invariant(status);
+            const auto& sourceNss = _collections[index].first;
+            auto collStatus = collectionCloner->run();
+            if (collStatus.isOK()) {
+                LOGV2_DEBUG(4881600,
+                            1,
+                            "Tenant collection clone finished",
+                            "namespace"_attr = sourceNss,
+                            "tenantId"_attr = _tenantId);
+            } else {
+                LOGV2_ERROR(4881601,
+                            "Tenant collection clone failed",
+                            "namespace"_attr = sourceNss,
+                            "error"_attr = collStatus.toString(),
+                            "tenantId"_attr = _tenantId);
+            }
+
+            Status failedStatus = Status::OK();
+            {
+                stdx::lock_guard<Latch> clonerLk(_mutex);
+                _stats.collectionStats[index] = collectionCloner->getStats();
+                _activeCollectionCloners.erase(index);
+                idleClients.push_back(client);
+                if (collStatus.isOK()) {
+                    _stats.clonedCollections++;
+                    cloned[index] = true;
+                    while (numPrefixCloned < cloned.size() && cloned[numPrefixCloned]) {
+                        ++numPrefixCloned;
+                    }
+                } else {
+                    failedStatus = onError(clonerLk, collStatus, sourceNss);
+                }
+                --numRunning;
+                clonerDoneCV.notify_all();
+            }
+            // The pool is joined before this function returns, so this is done by then.
+            if (!failedStatus.isOK()) {
+                setSyncFailedStatus(failedStatus);
+            }
+        };
+        collectionClonerPool.schedule(std::move(task));
+    }
+
+    // Let the collection cloners which are still running finish, even after a failure, since they
+    // use the connections and the state of this function.
+    clonerDoneCV.wait(lk, [&] { return numRunning == 0; });
+    lk.unlock();
+    collectionClonerPool.shutdown();
+    collectionClonerPool.join();
+
+    if (firstError.isOK()) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _stats.end = getSharedData()->getClock()->now();
+    }
+}
+
 TenantDatabaseCloner::Stats TenantDatabaseCloner::getStats() const {
     stdx::lock_guard<Latch> lk(_mutex);
     TenantDatabaseCloner::Stats stats = _stats;
     if (_currentCollectionCloner) {
         stats.collectionStats[_stats.clonedCollections] = _currentCollectionCloner->getStats();
     }
+    for (const auto& [index, collectionCloner] : _activeCollectionCloners) {
+        stats.collectionStats[index] = collectionCloner->getStats();
+    }
     return stats;
 }
 
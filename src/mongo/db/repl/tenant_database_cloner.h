@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <map>
 #include <vector>
 
 #include "mongo/db/repl/base_cloner.h"
@@ -113,6 +114,12 @@ private:
      */
     void postStage() final;
 
+    /**
+     * Runs the TenantCollectionCloners of up to 'concurrency' collections at the same time, each
+     * on its own thread and connection to the donor.
+     */
+    void _cloneCollectionsConcurrently(size_t concurrency);
+
     // All member variables are labeled with one of the following codes indicating the
     // synchronization rules for accessing them.
     //
@@ -125,6 +132,8 @@ private:
     const std::string _dbName;                                                // (R)
     std::vector<std::pair<NamespaceString, CollectionOptions>> _collections;  // (X)
     std::unique_ptr<TenantCollectionCloner> _currentCollectionCloner;         // (MX)
+    // The collection cloners running concurrently, by their index in '_collections'.
+    std::map<size_t, TenantCollectionCloner*> _activeCollectionCloners;  // (M)
 
     TenantDatabaseClonerStage _listCollectionsStage;          // (R)
     TenantDatabaseClonerStage _listExistingCollectionsStage;  // (R)
@@ -701,6 +701,49 @@ TEST_F(TenantDatabaseClonerTest, ResumingFromLastClonedCollection) {
     ASSERT_BSONOBJ_EQ(BSON("uuid" << uuid[1]), collections[0].second.toBSON());
 }
 
+TEST_F(TenantDatabaseClonerTest, ResumingWithConcurrentCollectionCloners) {
+    // Test that database cloner restarts from the collections which may not have been finished
+    // when collections were cloned concurrently.
+    std::vector<UUID> uuid;
+    for (int i = 0; i < 4; i++) {
+        uuid.push_back(UUID::gen());
+    }
+    std::sort(uuid.begin(), uuid.end());
+
+    CollectionOptions options;
+    options.uuid = uuid[2];
+    ASSERT_OK(createCollection(NamespaceString(_dbName, "c"), options));
+    options.uuid = uuid[0];
+    ASSERT_OK(createCollection(NamespaceString(_dbName, "a"), options));
+    options.uuid = uuid[1];
+    ASSERT_OK(createCollection(NamespaceString(_dbName, "b"), options));
+
+    TenantMigrationSharedData resumingSharedData(&_clock, _migrationId, /*resuming=*/true);
+    resumingSharedData.setCollectionClonerConcurrency(2, nullptr);
+    auto cloner = makeDatabaseCloner(&resumingSharedData);
+    cloner->setStopAfterStage_forTest("listExistingCollections");
+
+    std::vector<BSONObj> sourceInfos;
+    for (int i = 0; i < 4; i++) {
+        sourceInfos.push_back(BSON("name" << std::string(1, static_cast<char>('a' + i)) << "type"
+                                          << "collection"
+                                          << "options" << BSONObj() << "info"
+                                          << BSON("readOnly" << false << "uuid" << uuid[i])));
+    }
+    _mockServer->setCommandReply("listCollections", createListCollectionsResponse(sourceInfos));
+    _mockServer->setCommandReply("find", createFindResponse());
+
+    ASSERT_OK(cloner->run());
+    ASSERT_OK(getSharedData()->getStatus(WithLock::withoutLock()));
+    auto collections = getCollectionsFromCloner(cloner.get());
+
+    // The last collection on disk is 'c', and 'b' may still have been cloning alongside it.
+    ASSERT_EQUALS(3U, collections.size());
+    ASSERT_EQ(NamespaceString(_dbName, "b"), collections[0].first);
+    ASSERT_EQ(NamespaceString(_dbName, "c"), collections[1].first);
+    ASSERT_EQ(NamespaceString(_dbName, "d"), collections[2].first);
+}
+
 TEST_F(TenantDatabaseClonerTest, LastClonedCollectionDeleted_AllGreater) {
     // Test that we correctly resume from next collection whose UUID compared greater than the last
     // cloned collection if the last cloned collection is dropped. This tests the case when all
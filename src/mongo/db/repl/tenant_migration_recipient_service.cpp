@@ -813,6 +813,10 @@ void TenantMigrationRecipientService::Instance::_getStartOpTimesFromDonor(WithLo
         }
     }
     _stateDoc.setStartFetchingDonorOpTime(startFetchingDonorOpTime);
+
+    // A resumed migration must clone with the same concurrency as before, to know how far back it
+    // needs to restart.
+    _stateDoc.setCollectionClonerConcurrency(tenantMigrationCollectionClonerConcurrency.load());
 }
 
 AggregateCommand TenantMigrationRecipientService::Instance::_makeCommittedTransactionsAggregation()
@@ -1183,6 +1187,24 @@ Future<void> TenantMigrationRecipientService::Instance::_startTenantAllDatabaseC
         return {Future<void>::makeReady()};
     }
 
+    // The connections for the collection cloners beyond the first are shut down along with the
+    // others when the migration is interrupted.
+    _sharedData->setCollectionClonerConcurrency(
+        _stateDoc.getCollectionClonerConcurrency().value_or(1),
+        [this, serverAddress = _client->getServerHostAndPort()] {
+            auto applicationName = "TenantMigration_" + getTenantId() + "_" +
+                getMigrationUUID().toString() + "_cloner";
+            std::shared_ptr<DBClientConnection> client =
+                _connectAndAuth(serverAddress, applicationName);
+
+            stdx::lock_guard lk(_mutex);
+            if (_taskState.isInterrupted()) {
+                client->shutdownAndDisallowReconnect();
+            }
+            _clonerClients.push_back(client);
+            return client;
+        });
+
     auto opCtx = cc().makeOperationContext();
     _tenantAllDatabaseCloner =
         std::make_unique<TenantAllDatabaseCloner>(_sharedData.get(),
@@ -1378,6 +1400,10 @@ void TenantMigrationRecipientService::Instance::_cancelRemainingWork(WithLock lk
         _client->shutdownAndDisallowReconnect();
     }
 
+    for (auto&& clonerClient : _clonerClients) {
+        clonerClient->shutdownAndDisallowReconnect();
+    }
+
     if (_oplogFetcherClient) {
         // interrupts running tenant oplog fetcher.
         _oplogFetcherClient->shutdownAndDisallowReconnect();
@@ -515,6 +515,9 @@ public:
         // Follow DBClientCursor synchonization rules.
         std::unique_ptr<DBClientConnection> _client;              // (S)
         std::unique_ptr<DBClientConnection> _oplogFetcherClient;  // (S)
+        // Extra connections for the collection cloners which run concurrently, each used by one
+        // cloner at a time.
+        std::vector<std::shared_ptr<DBClientConnection>> _clonerClients;  // (M)
 
         std::unique_ptr<OplogFetcherFactory> _createOplogFetcherFn =
             std::make_unique<CreateOplogFetcherFn>();                               // (M)
@@ -29,13 +29,21 @@
 
 #pragma once
 
+#include <functional>
+#include <memory>
+
 #include "mongo/db/repl/optime.h"
 #include "mongo/db/repl/repl_sync_shared_data.h"
 
 namespace mongo {
+
+class DBClientConnection;
+
 namespace repl {
 class TenantMigrationSharedData final : public ReplSyncSharedData {
 public:
+    using ClientFactory = std::function<std::shared_ptr<DBClientConnection>()>;
+
     TenantMigrationSharedData(ClockSource* clock, const UUID& migrationId)
         : ReplSyncSharedData(clock), _migrationId(migrationId), _resuming(false) {}
     TenantMigrationSharedData(ClockSource* clock, const UUID& migrationId, bool resuming)
@@ -53,6 +61,27 @@ public:
         return _resuming;
     }
 
+    /**
+     * Lets the database cloners clone up to 'concurrency' collections at the same time, each
+     * through its own connection to the donor made by 'clientFactory'. Must be called before the
+     * cloners run.
+     */
+    void setCollectionClonerConcurrency(int concurrency, ClientFactory clientFactory) {
+        _collectionClonerConcurrency = concurrency;
+        _clientFactory = std::move(clientFactory);
+    }
+
+    int getCollectionClonerConcurrency() const {
+        return _collectionClonerConcurrency;
+    }
+
+    /**
+     * Makes a new connection to the donor for a collection cloner.
+     */
+    std::shared_ptr<DBClientConnection> makeClonerClient() const {
+        return _clientFactory();
+    }
+
 private:
     // Must hold mutex (in base class) to access this.
     // Represents last visible majority committed donor opTime.
@@ -63,6 +92,10 @@ private:
 
     // Indicate whether the tenant migration is resuming from a failover.
     const bool _resuming;
+
+    // The number of collections cloned at the same time, and how to connect to the donor for them.
+    int _collectionClonerConcurrency = 1;
+    ClientFactory _clientFactory;
 };
 }  // namespace repl
 }  // namespace mongo
@@ -0,0 +1,155 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kReplication
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/repl/update_or_delete_group.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "mongo/db/ops/write_ops.h"
+#include "mongo/db/repl/oplog_entry.h"
+#include "mongo/logv2/log.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+namespace repl {
+
+namespace {
+
+// The grouped ops are combined into one object for logging, which must not be too large.
+const auto kUpdateOrDeleteGroupMaxGroupSize = write_ops::insertVectorMaxBytes;
+
+// Limit number of ops in a single group, so as not to hold one storage transaction open for long.
+constexpr auto kUpdateOrDeleteGroupMaxOpCount = 64;
+
+size_t getGroupedSize(const OplogEntry& entry) {
+    const auto& o2 = entry.getObject2();
+    return entry.getObject().objsize() + (o2 ? o2->objsize() : 0);
+}
+
+}  // namespace
+
+UpdateOrDeleteGroup::UpdateOrDeleteGroup(std::vector<const OplogEntry*>* ops,
+                                         OperationContext* opCtx,
+                                         UpdateOrDeleteGroup::Mode mode,
+                                         ApplyFunc applyOplogEntryOrGroupedInserts)
+    : _doNotGroupBeforePoint(ops->cbegin()),
+      _end(ops->cend()),
+      _opCtx(opCtx),
+      _mode(mode),
+      _applyOplogEntryOrGroupedInserts(applyOplogEntryOrGroupedInserts) {}
+
+StatusWith<UpdateOrDeleteGroup::ConstIterator> UpdateOrDeleteGroup::groupAndApplyUpdatesOrDeletes(
+    ConstIterator it) noexcept {
+    const auto& entry = **it;
+    const auto opType = entry.getOpType();
+
+    // The following conditions must be met before attempting to group the oplog entries starting
+    // at 'it':
+    // 1) The CRUD operation must be an update or a delete;
+    // 2) We are applying oplog entries in steady state on a secondary. Initial sync and recovery
+    //    routinely replay updates of documents which no longer exist, which would make groups fail
+    //    and be applied a second time one op at a time;
+    // 3) The namespace cannot be a capped collection;
+    // 4) We have not attempted to group this op during a previous call to this function.
+    if (opType != OpTypeEnum::kUpdate && opType != OpTypeEnum::kDelete) {
+        return Status(ErrorCodes::TypeMismatch, "Can only group update or delete operations.");
+    }
+    if (_mode != Mode::kSecondary || _opCtx->writesAreReplicated()) {
+        return Status(ErrorCodes::InvalidOptions,
+                      "Can only group update or delete operations in secondary oplog application.");
+    }
+    if (entry.isForCappedCollection()) {
+        return Status(ErrorCodes::InvalidOptions,
+                      "Cannot group update or delete operations on capped collections.");
+    }
+    if (it <= _doNotGroupBeforePoint) {
+        return Status(ErrorCodes::InvalidPath,
+                      "Cannot group an operation that we previously attempted to group.");
+    }
+
+    // Make sure to include the first op in the group size.
+    size_t groupSize = getGroupedSize(entry);
+    auto opCount = std::vector<const OplogEntry*>::size_type(1);
+    const auto& groupNamespace = entry.getNss();
+
+    // Search for the op that delimits this group, i.e. the first op that *can't* be added to it.
+    auto endOfGroupableOpsIterator =
+        std::find_if(it + 1, _end, [&](const OplogEntry* nextEntry) -> bool {
+            groupSize += getGroupedSize(*nextEntry);
+            opCount += 1;
+
+            // Only add the op to this group if it passes the criteria.
+            return nextEntry->getOpType() != opType               // Must be of the same type.
+                || nextEntry->getNss() != groupNamespace          // Must be in the same namespace.
+                || groupSize > kUpdateOrDeleteGroupMaxGroupSize  // Must not be too large.
+                || opCount > kUpdateOrDeleteGroupMaxOpCount;     // Limit number of ops.
+        });
+
+    // See if we were able to create a group that contains more than a single op.
+    if (std::distance(it, endOfGroupableOpsIterator) == 1) {
+        return Status(ErrorCodes::NoSuchKey,
+                      "Not able to create a group with more than a single operation");
+    }
+
+    OplogEntryOrGroupedInserts groupedOps(it, endOfGroupableOpsIterator);
+    try {
+        uassertStatusOK(_applyOplogEntryOrGroupedInserts(_opCtx, groupedOps, _mode));
+        // It succeeded, advance the iterator to the end of the group.
+        return endOfGroupableOpsIterator - 1;
+    } catch (...) {
+        // The group failed, log it and fall through to the application of an individual op, which
+        // reports the error of the op that caused it.
+        static constexpr char message[] =
+            "Error applying grouped updates or deletes. Trying first operation on its own";
+        auto status = exceptionToStatus().withContext(str::stream()
+                                                      << message << ". First operation: "
+                                                      << redact(entry.toBSONForLogging()));
+        LOGV2_DEBUG(5502115,
+                    1,
+                    message,
+                    "groupedOps"_attr = redact(groupedOps.toBSON()),
+                    "firstOp"_attr = redact(entry.toBSONForLogging()),
+                    "error"_attr = redact(status));
+
+        // Avoid quadratic run time by not retrying until we are beyond this group of ops.
+        _doNotGroupBeforePoint = endOfGroupableOpsIterator - 1;
+
+        return status;
+    }
+
+    MONGO_UNREACHABLE;
+}
+
+}  // namespace repl
+}  // namespace mongo
@@ -73,6 +73,9 @@ MONGO_FAIL_POINT_DEFINE(overrideBalanceRoundInterval);
 
 const Seconds kBalanceRoundDefaultInterval(10);
 
+// Weight of the most recent round in the moving average of the balancer's migration rate
+const double kMigrationRateWeight = 0.2;
+
 // Sleep between balancer rounds in the case where the last round found some chunks which needed to
 // be balanced. This value should be set sufficiently low so that imbalanced clusters will quickly
 // reach balanced state, but setting it too low may cause CRUD operations to start failing due to
@@ -319,6 +322,18 @@ void Balancer::report(OperationContext* opCtx, BSONObjBuilder* builder) {
     builder->append("mode", BalancerSettingsType::kBalancerModes[mode]);
     builder->append("inBalancerRound", _inBalancerRound);
     builder->append("numBalancerRounds", _numBalancerRounds);
+
+    if (_migrationsRemaining) {
+        builder->appendNumber("migrationsRemaining", static_cast<long long>(*_migrationsRemaining));
+        if (_migrationsPerSecond > 0) {
+            const Milliseconds timeRemaining(
+                static_cast<long long>(*_migrationsRemaining * 1000 / _migrationsPerSecond));
+            builder->append("migrationsPerSecond", _migrationsPerSecond);
+            builder->append("projectedCompletion",
+                            opCtx->getServiceContext()->getFastClockSource()->now() +
+                                timeRemaining);
+        }
+    }
 }
 
 void Balancer::_mainThread() {
@@ -429,8 +444,14 @@ void Balancer::_mainThread() {
                 if (candidateChunks.empty()) {
                     LOGV2_DEBUG(21862, 1, "No need to move any chunk");
                     _balancedLastTime = 0;
+
+                    stdx::lock_guard<Latch> scopedLock(_mutex);
+                    _migrationsRemaining = 0;
                 } else {
+                    Timer moveChunksTimer;
                     _balancedLastTime = _moveChunks(opCtx.get(), candidateChunks);
+                    _updateMigrationsRemaining(
+                        opCtx.get(), _balancedLastTime, Milliseconds(moveChunksTimer.millis()));
 
                     roundDetails.setSucceeded(static_cast<int>(candidateChunks.size()),
                                               _balancedLastTime);
@@ -701,6 +722,34 @@ int Balancer::_moveChunks(OperationContext* opCtx,
     return numChunksProcessed;
 }
 
+void Balancer::_updateMigrationsRemaining(OperationContext* opCtx,
+                                          int numChunksMoved,
+                                          Milliseconds roundDuration) {
+    auto migrationsRemainingStatus = _chunkSelectionPolicy->estimateMigrationsToBalance(opCtx);
+
+    stdx::lock_guard<Latch> scopedLock(_mutex);
+
+    if (numChunksMoved > 0) {
+        const double migrationsPerSecond =
+            numChunksMoved * 1000.0 / std::max(durationCount<Milliseconds>(roundDuration), 1LL);
+        _migrationsPerSecond = _migrationsPerSecond > 0
+            ? (1 - kMigrationRateWeight) * _migrationsPerSecond +
+                kMigrationRateWeight * migrationsPerSecond
+            : migrationsPerSecond;
+    }
+
+    if (migrationsRemainingStatus.isOK()) {
+        _migrationsRemaining = migrationsRemainingStatus.getValue();
+    } else {
+        LOGV2_DEBUG(5502119,
+                    1,
+                    "Unable to estimate the number of migrations remaining: {error}",
+                    "Unable to estimate the number of migrations remaining",
+                    "error"_attr = migrationsRemainingStatus.getStatus());
+        _migrationsRemaining = boost::none;
+    }
+}
+
 void Balancer::notifyPersistedBalancerSettingsChanged() {
     stdx::unique_lock<Latch> lock(_mutex);
     _condVar.notify_all();
@@ -220,6 +220,15 @@ private:
     int _moveChunks(OperationContext* opCtx,
                     const BalancerChunkSelectionPolicy::MigrateInfoVector& candidateChunks);
 
+    /**
+     * Folds the rate at which the last round moved chunks into the moving average migration rate
+     * and re-estimates how many migrations are still needed to balance the cluster, for reporting
+     * the projected completion of balancing.
+     */
+    void _updateMigrationsRemaining(OperationContext* opCtx,
+                                    int numChunksMoved,
+                                    Milliseconds roundDuration);
+
     // Protects the state below
     Mutex _mutex = MONGO_MAKE_LATCH("Balancer::_mutex");
 
@@ -258,6 +267,14 @@ private:
     // Number of moved chunks in last round
     int _balancedLastTime;
 
+    // Estimated number of migrations still needed to balance the cluster as of the end of the last
+    // round, which moved chunks, or boost::none if it is not known
+    boost::optional<size_t> _migrationsRemaining;
+
+    // Moving average of how many chunks per second the balancing rounds migrate, or zero until a
+    // round has moved a chunk
+    double _migrationsPerSecond{0};
+
     // Source of randomness when metadata needs to be randomized.
     BalancerRandomSource _random;
 
@@ -109,6 +109,12 @@ public:
     virtual StatusWith<MigrateInfoVector> selectChunksToMove(OperationContext* opCtx,
                                                              const NamespaceString& nss) = 0;
 
+    /**
+     * Potentially blocking method, which estimates how many more migrations are needed across all
+     * the balanced collections before the cluster is balanced.
+     */
+    virtual StatusWith<size_t> estimateMigrationsToBalance(OperationContext* opCtx) = 0;
+
     /**
      * Requests a single chunk to be relocated to a different shard, if possible. If some error
      * occurs while trying to determine the best location for the chunk, a failed status is
@@ -434,6 +434,46 @@ StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::selectChunksToMo
     return candidatesStatus;
 }
 
+StatusWith<size_t> BalancerChunkSelectionPolicyImpl::estimateMigrationsToBalance(
+    OperationContext* opCtx) {
+    auto shardStatsStatus = _clusterStats->getStats(opCtx);
+    if (!shardStatsStatus.isOK()) {
+        return shardStatsStatus.getStatus();
+    }
+
+    const auto& shardStats = shardStatsStatus.getValue();
+
+    if (shardStats.size() < 2) {
+        return 0;
+    }
+
+    size_t numMigrations = 0;
+
+    for (const auto& coll : Grid::get(opCtx)->catalogClient()->getCollections(opCtx, {})) {
+        if (coll.getDropped() || !coll.getAllowBalance() || !coll.getAllowMigrations()) {
+            continue;
+        }
+
+        auto routingInfoStatus =
+            Grid::get(opCtx)->catalogCache()->getShardedCollectionRoutingInfoWithRefresh(
+                opCtx, coll.getNss());
+        if (!routingInfoStatus.isOK()) {
+            continue;
+        }
+
+        const auto collInfoStatus = createCollectionDistributionStatus(
+            opCtx, coll.getNss(), shardStats, routingInfoStatus.getValue());
+        if (!collInfoStatus.isOK()) {
+            continue;
+        }
+
+        numMigrations +=
+            BalancerPolicy::estimateMigrationsToBalance(shardStats, collInfoStatus.getValue());
+    }
+
+    return numMigrations;
+}
+
 StatusWith<boost::optional<MigrateInfo>>
 BalancerChunkSelectionPolicyImpl::selectSpecificChunkToMove(OperationContext* opCtx,
                                                             const ChunkType& chunk) {
@@ -51,6 +51,8 @@ public:
     StatusWith<MigrateInfoVector> selectChunksToMove(OperationContext* opCtx,
                                                      const NamespaceString& ns) override;
 
+    StatusWith<size_t> estimateMigrationsToBalance(OperationContext* opCtx) override;
+
     StatusWith<boost::optional<MigrateInfo>> selectSpecificChunkToMove(
         OperationContext* opCtx, const ChunkType& chunk) override;
 
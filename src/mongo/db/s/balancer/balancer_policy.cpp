@@ -247,6 +247,7 @@ ShardId BalancerPolicy::_getLeastLoadedReceiverShard(const ShardStatisticsVector
                                                      const set<ShardId>& excludedShards) {
     ShardId best;
     unsigned minChunks = numeric_limits<unsigned>::max();
+    uint64_t minSizeMB = numeric_limits<uint64_t>::max();
 
     for (const auto& stat : shardStats) {
         if (excludedShards.count(stat.shardId))
@@ -258,12 +259,13 @@ ShardId BalancerPolicy::_getLeastLoadedReceiverShard(const ShardStatisticsVector
         }
 
         unsigned myChunks = distribution.numberOfChunksInShard(stat.shardId);
-        if (myChunks >= minChunks) {
+        if (myChunks > minChunks || (myChunks == minChunks && stat.currSizeMB >= minSizeMB)) {
             continue;
         }
 
         best = stat.shardId;
         minChunks = myChunks;
+        minSizeMB = stat.currSizeMB;
     }
 
     return best;
@@ -275,6 +277,7 @@ ShardId BalancerPolicy::_getMostOverloadedShard(const ShardStatisticsVector& sha
                                                 const set<ShardId>& excludedShards) {
     ShardId worst;
     unsigned maxChunks = 0;
+    uint64_t maxSizeMB = 0;
 
     for (const auto& stat : shardStats) {
         if (excludedShards.count(stat.shardId))
@@ -282,11 +285,13 @@ ShardId BalancerPolicy::_getMostOverloadedShard(const ShardStatisticsVector& sha
 
         const unsigned shardChunkCount =
             distribution.numberOfChunksInShardWithTag(stat.shardId, chunkTag);
-        if (shardChunkCount <= maxChunks)
+        if (shardChunkCount < maxChunks ||
+            (shardChunkCount == maxChunks && (!worst.isValid() || stat.currSizeMB <= maxSizeMB)))
             continue;
 
         worst = stat.shardId;
         maxChunks = shardChunkCount;
+        maxSizeMB = stat.currSizeMB;
     }
 
     return worst;
@@ -558,6 +563,64 @@ boost::optional<MigrateInfo> BalancerPolicy::balanceSingleChunk(
         newShardId, chunk, MoveChunkRequest::ForceJumbo::kDoNotForce, MigrateInfo::chunksImbalance);
 }
 
+size_t BalancerPolicy::estimateMigrationsToBalance(const ShardStatisticsVector& shardStats,
+                                                   const DistributionStatus& distribution) {
+    size_t numMigrations = 0;
+
+    // Chunks on draining shards and chunks on shards outside of their zone must all be moved
+    for (const auto& stat : shardStats) {
+        for (const auto& chunk : distribution.getChunks(stat.shardId)) {
+            if (chunk.getJumbo())
+                continue;
+
+            const string tag = distribution.getTagForChunk(chunk);
+            if (stat.isDraining || (!tag.empty() && !stat.shardTags.count(tag)))
+                numMigrations++;
+        }
+    }
+
+    vector<string> tagsPlusEmpty(distribution.tags().begin(), distribution.tags().end());
+    tagsPlusEmpty.push_back("");
+
+    for (const auto& tag : tagsPlusEmpty) {
+        const size_t totalNumberOfChunksWithTag =
+            (tag.empty() ? distribution.totalChunks() : distribution.totalChunksWithTag(tag));
+
+        size_t totalNumberOfShardsWithTag = 0;
+
+        for (const auto& stat : shardStats) {
+            if (tag.empty() || stat.shardTags.count(tag)) {
+                totalNumberOfShardsWithTag++;
+            }
+        }
+
+        if (totalNumberOfShardsWithTag == 0)
+            continue;
+
+        const size_t idealNumberOfChunksPerShardForTag =
+            (size_t)std::roundf(totalNumberOfChunksWithTag / (float)totalNumberOfShardsWithTag);
+
+        size_t chunksOverIdeal = 0;
+        size_t chunksUnderIdeal = 0;
+
+        for (const auto& stat : shardStats) {
+            if (stat.isDraining || !(tag.empty() || stat.shardTags.count(tag)))
+                continue;
+
+            const size_t numChunks = distribution.numberOfChunksInShardWithTag(stat.shardId, tag);
+            if (numChunks > idealNumberOfChunksPerShardForTag) {
+                chunksOverIdeal += numChunks - idealNumberOfChunksPerShardForTag;
+            } else {
+                chunksUnderIdeal += idealNumberOfChunksPerShardForTag - numChunks;
+            }
+        }
+
+        numMigrations += std::min(chunksOverIdeal, chunksUnderIdeal);
+    }
+
+    return numMigrations;
+}
+
 bool BalancerPolicy::_singleZoneBalance(const ShardStatisticsVector& shardStats,
                                         const DistributionStatus& distribution,
                                         const string& tag,
@@ -210,10 +210,20 @@ public:
                                                            const ShardStatisticsVector& shardStats,
                                                            const DistributionStatus& distribution);
 
+    /**
+     * Estimates how many more migrations 'balance' would have to suggest for the specified
+     * collection before it is considered balanced, counting every movable chunk on a draining shard
+     * or in violation of its zone and, for each zone, the smaller of how many chunks the shards are
+     * over and under the optimum per-shard chunk count. Used for reporting progress only.
+     */
+    static size_t estimateMigrationsToBalance(const ShardStatisticsVector& shardStats,
+                                              const DistributionStatus& distribution);
+
 private:
     /**
      * Return the shard with the specified tag, which has the least number of chunks. If the tag is
-     * empty, considers all shards.
+     * empty, considers all shards. Between shards with the same number of chunks, prefers the one
+     * which stores the least data.
      */
     static ShardId _getLeastLoadedReceiverShard(const ShardStatisticsVector& shardStats,
                                                 const DistributionStatus& distribution,
@@ -221,8 +231,9 @@ private:
                                                 const std::set<ShardId>& excludedShards);
 
     /**
-     * Return the shard which has the least number of chunks with the specified tag. If the tag is
-     * empty, considers all chunks.
+     * Return the shard which has the most number of chunks with the specified tag. If the tag is
+     * empty, considers all chunks. Between shards with the same number of chunks, prefers the one
+     * which stores the most data.
      */
     static ShardId _getMostOverloadedShard(const ShardStatisticsVector& shardStats,
                                            const DistributionStatus& distribution,
@@ -193,6 +193,15 @@ public:
         return _cm->keyBelongsToShard(key, _thisShardId);
     }
 
+    /**
+     * Returns true if all the shard keys between 'min' and 'max' belong to this chunkset. Whether
+     * 'max' is part of the range is given by 'isMaxInclusive'.
+     */
+    bool rangeBelongsToMe(const BSONObj& min, const BSONObj& max, bool isMaxInclusive) const {
+        invariant(isSharded());
+        return _cm->rangeBelongsToShard(min, max, isMaxInclusive, _thisShardId);
+    }
+
     /**
      * Given a key 'lookupKey' in the shard key range, get the next chunk which overlaps or is
      * greater than this key.  Returns true if a chunk exists, false otherwise.
@@ -139,6 +139,14 @@ TEST_F(CollectionMetadataFilteringTest, FilterDocumentsInTheFuture) {
         ASSERT_TRUE(collectionFilter.keyBelongsToMe(BSON("_id" << 50)));
         ASSERT_FALSE(collectionFilter.keyBelongsToMe(BSON("_id" << -50)));
         ASSERT_FALSE(collectionFilter.keyBelongsToMe(BSON("_id" << 500)));
+
+        ASSERT_TRUE(collectionFilter.rangeBelongsToMe(BSON("_id" << 0), BSON("_id" << 99), true));
+        ASSERT_TRUE(
+            collectionFilter.rangeBelongsToMe(BSON("_id" << 0), BSON("_id" << 100), false));
+        ASSERT_FALSE(
+            collectionFilter.rangeBelongsToMe(BSON("_id" << 0), BSON("_id" << 100), true));
+        ASSERT_FALSE(
+            collectionFilter.rangeBelongsToMe(BSON("_id" << -500), BSON("_id" << 50), true));
     };
 
     BSONObj readConcern = BSON("readConcern" << BSON("level"
@@ -163,6 +171,13 @@ TEST_F(CollectionMetadataFilteringTest, FilterDocumentsInThePast) {
         ASSERT_FALSE(collectionFilter.keyBelongsToMe(BSON("_id" << 50)));
         ASSERT_TRUE(collectionFilter.keyBelongsToMe(BSON("_id" << -50)));
         ASSERT_TRUE(collectionFilter.keyBelongsToMe(BSON("_id" << 500)));
+
+        ASSERT_TRUE(
+            collectionFilter.rangeBelongsToMe(BSON("_id" << -100), BSON("_id" << 0), false));
+        ASSERT_TRUE(
+            collectionFilter.rangeBelongsToMe(BSON("_id" << 100), BSON("_id" << MAXKEY), true));
+        ASSERT_FALSE(
+            collectionFilter.rangeBelongsToMe(BSON("_id" << -100), BSON("_id" << 0), true));
     };
 
     BSONObj readConcern = BSON("readConcern" << BSON("level"
@@ -342,6 +342,11 @@ private:
 
     std::unique_ptr<SessionCatalogMigrationSource> _sessionCatalogSource;
 
+    // Serializes the _migrateClone requests, which scan a jumbo chunk through
+    // '_jumboChunkCloneState'. Always acquired before '_mutex'.
+    Mutex _jumboChunkCloneMutex =
+        MONGO_MAKE_LATCH("MigrationChunkClonerSourceLegacy::_jumboChunkCloneMutex");
+
     // Protects the entries below
     Mutex _mutex = MONGO_MAKE_LATCH("MigrationChunkClonerSourceLegacy::_mutex");
 
@@ -445,12 +445,14 @@ Status MigrationDestinationManager::start(OperationContext* opCtx,
 repl::OpTime MigrationDestinationManager::cloneDocumentsFromDonor(
     OperationContext* opCtx,
     std::function<void(OperationContext*, BSONObj)> insertBatchFn,
-    std::function<BSONObj(OperationContext*)> fetchBatchFn) {
+    std::function<BSONObj(OperationContext*)> fetchBatchFn,
+    int numFetchers) {
+    invariant(numFetchers >= 1);
 
-    SingleProducerSingleConsumerQueue<BSONObj>::Options options;
-    options.maxQueueDepth = 1;
+    MultiProducerSingleConsumerQueue<BSONObj>::Options options;
+    options.maxQueueDepth = numFetchers;
 
-    SingleProducerSingleConsumerQueue<BSONObj> batches(options);
+    MultiProducerSingleConsumerQueue<BSONObj> batches(options);
     repl::OpTime lastOpApplied;
 
     stdx::thread inserterThread{[&] {
@@ -468,11 +470,14 @@ repl::OpTime MigrationDestinationManager::cloneDocumentsFromDonor(
         });
 
         try {
-            while (true) {
+            // Every fetcher pushes an empty batch once the donor has no more documents for it
+            int numFetchersDone = 0;
+            while (numFetchersDone < numFetchers) {
                 auto nextBatch = batches.pop(inserterOpCtx.get());
                 auto arr = nextBatch["objects"].Obj();
                 if (arr.isEmpty()) {
-                    return;
+                    numFetchersDone++;
+                    continue;
                 }
                 insertBatchFn(inserterOpCtx.get(), arr);
             }
@@ -486,17 +491,11 @@ repl::OpTime MigrationDestinationManager::cloneDocumentsFromDonor(
         }
     }};
 
-
-    {
-        auto inserterThreadJoinGuard = makeGuard([&] {
-            batches.closeProducerEnd();
-            inserterThread.join();
-        });
-
+    auto fetchUntilDone = [&](OperationContext* fetcherOpCtx) {
         while (true) {
-            auto res = fetchBatchFn(opCtx);
+            auto res = fetchBatchFn(fetcherOpCtx);
             try {
-                batches.push(res.getOwned(), opCtx);
+                batches.push(res.getOwned(), fetcherOpCtx);
                 auto arr = res["objects"].Obj();
                 if (arr.isEmpty()) {
                     break;
@@ -505,6 +504,75 @@ repl::OpTime MigrationDestinationManager::cloneDocumentsFromDonor(
                 break;
             }
         }
+    };
+
+    // The additional fetchers keep more than one _migrateClone request outstanding against the
+    // donor, so that the next batches are already on their way while the current one is inserted.
+    Mutex fetcherOpCtxsMutex = MONGO_MAKE_LATCH("MigrationDestinationManager::fetcherOpCtxs");
+    std::vector<OperationContext*> fetcherOpCtxs;
+    std::vector<stdx::thread> fetcherThreads;
+
+    {
+        auto fetcherThreadsJoinGuard = makeGuard([&] {
+            {
+                stdx::lock_guard<Latch> lk(fetcherOpCtxsMutex);
+                for (auto fetcherOpCtx : fetcherOpCtxs) {
+                    stdx::lock_guard<Client> clientLock(*fetcherOpCtx->getClient());
+                    fetcherOpCtx->getServiceContext()->killOperation(clientLock, fetcherOpCtx);
+                }
+            }
+            for (auto& fetcherThread : fetcherThreads) {
+                fetcherThread.join();
+            }
+            batches.closeProducerEnd();
+            inserterThread.join();
+        });
+
+        for (int i = 1; i < numFetchers; i++) {
+            fetcherThreads.emplace_back([&] {
+                Client::initThread("chunkFetcher", opCtx->getServiceContext(), nullptr);
+                auto client = Client::getCurrent();
+                {
+                    stdx::lock_guard lk(*client);
+                    client->setSystemOperationKillableByStepdown(lk);
+                }
+
+                auto fetcherOpCtx = client->makeOperationContext();
+                {
+                    stdx::lock_guard<Latch> lk(fetcherOpCtxsMutex);
+                    fetcherOpCtxs.push_back(fetcherOpCtx.get());
+                }
+                ON_BLOCK_EXIT([&] {
+                    stdx::lock_guard<Latch> lk(fetcherOpCtxsMutex);
+                    fetcherOpCtxs.erase(
+                        std::find(fetcherOpCtxs.begin(), fetcherOpCtxs.end(), fetcherOpCtx.get()));
+                });
+
+                try {
+                    fetchUntilDone(fetcherOpCtx.get());
+                } catch (...) {
+                    // Fetchers are only killed once the main thread is already failing
+                    if (fetcherOpCtx->isKillPending()) {
+                        return;
+                    }
+
+                    stdx::lock_guard<Client> lk(*opCtx->getClient());
+                    opCtx->getServiceContext()->killOperation(lk, opCtx, ErrorCodes::Error(5502120));
+                    LOGV2(5502121,
+                          "Batch fetching failed: {error}",
+                          "Batch fetching failed",
+                          "error"_attr = redact(exceptionToStatus()));
+                }
+            });
+        }
+
+        fetchUntilDone(opCtx);
+
+        // Wait for the other fetchers to receive their last batches before closing the queue
+        for (auto& fetcherThread : fetcherThreads) {
+            fetcherThread.join();
+        }
+        fetcherThreads.clear();
     }  // This scope ensures that the guard is destroyed
 
     // This check is necessary because the consumer thread uses killOp to propagate errors to the
@@ -1120,7 +1188,8 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* outerOpCtx) {
 
         // If running on a replicated system, we'll need to flush the docs we cloned to the
         // secondaries
-        lastOpApplied = cloneDocumentsFromDonor(opCtx, insertBatchFn, fetchBatchFn);
+        lastOpApplied = cloneDocumentsFromDonor(
+            opCtx, insertBatchFn, fetchBatchFn, migrateCloneMaxOutstandingRequests.load());
 
         timing.done(3);
         migrateThreadHangAtStep3.pauseWhileSet();
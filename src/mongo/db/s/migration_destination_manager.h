@@ -114,12 +114,15 @@ public:
                  const WriteConcernOptions& writeConcern);
 
     /**
-     * Clones documents from a donor shard.
+     * Clones documents from a donor shard. Batches are fetched by 'numFetchers' threads at once,
+     * each of which calls 'fetchBatchFn' until it returns an empty batch, and are inserted by a
+     * separate thread.
      */
     static repl::OpTime cloneDocumentsFromDonor(
         OperationContext* opCtx,
         std::function<void(OperationContext*, BSONObj)> insertBatchFn,
-        std::function<BSONObj(OperationContext*)> fetchBatchFn);
+        std::function<BSONObj(OperationContext*)> fetchBatchFn,
+        int numFetchers = 1);
 
     /**
      * Idempotent method, which causes the current ongoing migration to abort only if it has the
@@ -105,6 +105,44 @@ TEST_F(MigrationDestinationManagerTest, CloneDocumentsFromDonorWorksCorrectly) {
     }
 }
 
+// Tests that every document is inserted exactly once when several fetchers request batches from
+// the donor at the same time.
+TEST_F(MigrationDestinationManagerTest, CloneDocumentsFromDonorWithSeveralFetchers) {
+    const int kNumBatches = 20;
+
+    auto mutex = MONGO_MAKE_LATCH();
+    int numBatchesFetched = 0;
+
+    auto fetchBatchFn = [&](OperationContext* opCtx) {
+        BSONArrayBuilder arrayBuilder;
+        {
+            stdx::lock_guard<Latch> lk(mutex);
+            if (numBatchesFetched < kNumBatches) {
+                arrayBuilder.append(createDocument(numBatchesFetched++));
+            }
+        }
+
+        BSONObjBuilder fetchBatchResultBuilder;
+        fetchBatchResultBuilder.append("objects", arrayBuilder.arr());
+        return fetchBatchResultBuilder.obj();
+    };
+
+    std::set<int> insertedIds;
+
+    auto insertBatchFn = [&](OperationContext* opCtx, BSONObj docs) {
+        for (auto&& docToClone : docs) {
+            ASSERT(insertedIds.insert(docToClone.Obj()["_id"].numberInt()).second);
+        }
+    };
+
+    MigrationDestinationManager::cloneDocumentsFromDonor(
+        operationContext(), insertBatchFn, fetchBatchFn, 4);
+
+    ASSERT_EQ(static_cast<size_t>(kNumBatches), insertedIds.size());
+    ASSERT_EQ(0, *insertedIds.begin());
+    ASSERT_EQ(kNumBatches - 1, *insertedIds.rbegin());
+}
+
 // Tests that an exception in the fetch logic will successfully throw an exception on the main
 // thread.
 TEST_F(MigrationDestinationManagerTest, CloneDocumentsThrowsFetchErrors) {
@@ -65,6 +65,8 @@
 #include "mongo/logv2/log.h"
 #include "mongo/util/cancelation.h"
 #include "mongo/util/future_util.h"
+#include "mongo/util/scopeguard.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -114,6 +116,20 @@ bool collectionUuidHasChanged(const NamespaceString& nss,
     return false;
 }
 
+/**
+ * Supplies the delays between the batches of a range deletion, which are computed from the
+ * duration of the batch that just completed.
+ */
+struct RangeDeletionBatchDelay {
+    Milliseconds nextSleep() {
+        return getDelayBetweenRangeDeletionBatches(
+            *lastBatchDuration, minDelay, rangeDeleterIOBudgetPercent.load());
+    }
+
+    std::shared_ptr<Milliseconds> lastBatchDuration;
+    Milliseconds minDelay;
+};
+
 /**
  * Performs the deletion of up to numDocsToRemovePerBatch entries within the range in progress. Must
  * be called under the collection lock.
@@ -301,6 +317,8 @@ ExecutorFuture<void> deleteRangeInBatches(const std::shared_ptr<executor::TaskEx
                                           const boost::optional<UUID>& migrationId,
                                           int numDocsToRemovePerBatch,
                                           Milliseconds delayBetweenBatches) {
+    auto lastBatchDuration = std::make_shared<Milliseconds>(0);
+
     return AsyncTry([=] {
                return withTemporaryOperationContext([=](OperationContext* opCtx) {
                    LOGV2_DEBUG(5346200,
@@ -325,6 +343,9 @@ ExecutorFuture<void> deleteRangeInBatches(const std::shared_ptr<executor::TaskEx
                        "deletion task. No need to delete documents.",
                        !collectionUuidHasChanged(nss, collection.getCollection(), collectionUuid));
 
+                   Timer batchTimer;
+                   ON_BLOCK_EXIT([&] { *lastBatchDuration = Milliseconds(batchTimer.millis()); });
+
                    auto numDeleted = uassertStatusOK(deleteNextBatch(opCtx,
                                                                      collection.getCollection(),
                                                                      keyPattern,
@@ -356,7 +377,8 @@ ExecutorFuture<void> deleteRangeInBatches(const std::shared_ptr<executor::TaskEx
                 ErrorCodes::isShutdownError(swNumDeleted.getStatus()) ||
                 ErrorCodes::isNotPrimaryError(swNumDeleted.getStatus());
         })
-        .withDelayBetweenIterations(delayBetweenBatches)
+        .withBackoffBetweenIterations(
+            RangeDeletionBatchDelay{lastBatchDuration, delayBetweenBatches})
         .on(executor, CancelationToken::uncancelable())
         .ignoreValue();
 }
@@ -414,6 +436,14 @@ ExecutorFuture<void> waitForDeletionsToMajorityReplicate(
 
 }  // namespace
 
+Milliseconds getDelayBetweenRangeDeletionBatches(Milliseconds lastBatchDuration,
+                                                 Milliseconds minDelay,
+                                                 int ioBudgetPercent) {
+    invariant(ioBudgetPercent > 0 && ioBudgetPercent <= 100);
+    const Milliseconds budgetDelay = lastBatchDuration * (100 - ioBudgetPercent) / ioBudgetPercent;
+    return std::max(minDelay, budgetDelay);
+}
+
 SharedSemiFuture<void> removeDocumentsInRange(
     const std::shared_ptr<executor::TaskExecutor>& executor,
     SemiFuture<void> waitForActiveQueriesToComplete,
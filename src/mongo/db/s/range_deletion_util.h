@@ -50,6 +50,19 @@ extern AtomicWord<int> rangeDeleterBatchSize;
 // next batch of deletions.
 extern AtomicWord<int> rangeDeleterBatchDelayMS;
 
+// The percentage of time the range deleter may spend deleting documents, which stretches the wait
+// between batches in proportion to how long the previous batch took.
+extern AtomicWord<int> rangeDeleterIOBudgetPercent;
+
+/**
+ * Returns how long to wait before deleting the next batch of documents, given how long the last
+ * batch took, so that the time spent deleting stays within 'ioBudgetPercent' of the total. Never
+ * returns less than 'minDelay'.
+ */
+Milliseconds getDelayBetweenRangeDeletionBatches(Milliseconds lastBatchDuration,
+                                                 Milliseconds minDelay,
+                                                 int ioBudgetPercent);
+
 /**
  * Deletes a range of orphaned documents for the given namespace and collection UUID. Returns a
  * future which will be resolved when the range has finished being deleted. The resulting future
@@ -61,7 +74,8 @@ extern AtomicWord<int> rangeDeleterBatchDelayMS;
  * 2. Waits for delayForActiveQueriesOnSecondariesToComplete seconds before deleting any documents,
  *    to give queries running on secondaries a chance to finish.
  * 3. Delete documents in a series of batches with up to numDocsToRemovePerBatch documents per
- *    batch, with a delay of delayBetweenBatches milliseconds in between batches.
+ *    batch, with a delay of at least delayBetweenBatches milliseconds in between batches, which
+ *    grows with the duration of the batches according to rangeDeleterIOBudgetPercent.
  */
 SharedSemiFuture<void> removeDocumentsInRange(
     const std::shared_ptr<executor::TaskExecutor>& executor,
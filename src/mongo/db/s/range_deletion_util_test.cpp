@@ -917,5 +917,24 @@ TEST_F(RangeDeleterTest, RemoveDocumentsInRangeDoesNotCrashWhenShardKeyIndexDoes
     cleanupComplete.get();
 }
 
+TEST(RangeDeletionBatchDelayTest, FullIOBudgetOnlyWaitsForMinimumDelay) {
+    ASSERT_EQ(Milliseconds(20),
+              getDelayBetweenRangeDeletionBatches(Milliseconds(500), Milliseconds(20), 100));
+    ASSERT_EQ(Milliseconds(0),
+              getDelayBetweenRangeDeletionBatches(Milliseconds(500), Milliseconds(0), 100));
+}
+
+TEST(RangeDeletionBatchDelayTest, DelayGrowsWithBatchDuration) {
+    // With a quarter of the time for deleting, every batch is followed by three times its duration
+    ASSERT_EQ(Milliseconds(300),
+              getDelayBetweenRangeDeletionBatches(Milliseconds(100), Milliseconds(20), 25));
+    ASSERT_EQ(Milliseconds(3000),
+              getDelayBetweenRangeDeletionBatches(Milliseconds(1000), Milliseconds(20), 25));
+
+    // Fast batches still wait for the minimum delay
+    ASSERT_EQ(Milliseconds(20),
+              getDelayBetweenRangeDeletionBatches(Milliseconds(5), Milliseconds(20), 25));
+}
+
 }  // namespace
 }  // namespace mongo
@@ -332,11 +332,15 @@ ExecutorFuture<void> ReshardingCollectionCloner::run(
     struct ChainContext {
         std::unique_ptr<Pipeline, PipelineDeleter> pipeline;
         bool moreToCome = true;
+
+        // The insertion of the previous batch, which runs while the next batch is being fetched
+        // from the donor shards.
+        boost::optional<ExecutorFuture<void>> pendingInsert;
     };
 
     auto chainCtx = std::make_shared<ChainContext>();
 
-    return AsyncTry([this, chainCtx] {
+    return AsyncTry([this, chainCtx, executor] {
                if (!chainCtx->pipeline) {
                    chainCtx->pipeline = _withTemporaryOperationContext([&](auto* opCtx) {
                        auto idToResumeFrom = [&] {
@@ -384,18 +388,44 @@ ExecutorFuture<void> ReshardingCollectionCloner::run(
                    });
                }
 
-               chainCtx->moreToCome = _withTemporaryOperationContext([&](auto* opCtx) {
-                   chainCtx->pipeline->reattachToOperationContext(opCtx);
-                   auto batch = _fillBatch(*chainCtx->pipeline);
-                   chainCtx->pipeline->detachFromOperationContext();
-
-                   if (batch.empty()) {
-                       return false;
+               auto previousInsert = chainCtx->pendingInsert
+                   ? std::move(*chainCtx->pendingInsert)
+                   : ExecutorFuture<void>(executor);
+               chainCtx->pendingInsert.reset();
+
+               auto swBatch = [&]() -> StatusWith<std::vector<InsertStatement>> {
+                   try {
+                       return _withTemporaryOperationContext([&](auto* opCtx) {
+                           chainCtx->pipeline->reattachToOperationContext(opCtx);
+                           auto batch = _fillBatch(*chainCtx->pipeline);
+                           chainCtx->pipeline->detachFromOperationContext();
+                           return batch;
+                       });
+                   } catch (const DBException& ex) {
+                       return ex.toStatus();
                    }
+               }();
+
+               // Always wait for the previous batch to be inserted before returning, even if
+               // fetching the next batch failed, so that resuming from the highest inserted _id
+               // cannot race with it.
+               return std::move(previousInsert)
+                   .onCompletion([this, chainCtx, executor, swBatch = std::move(swBatch)](
+                                     Status insertStatus) mutable {
+                       uassertStatusOK(insertStatus);
+                       auto batch = uassertStatusOK(std::move(swBatch));
+
+                       if (batch.empty()) {
+                           chainCtx->moreToCome = false;
+                           return;
+                       }
 
-                   _insertBatch(opCtx, batch);
-                   return true;
-               });
+                       chainCtx->pendingInsert = ExecutorFuture<void>(executor).then(
+                           [this, batch = std::move(batch)]() mutable {
+                               _withTemporaryOperationContext(
+                                   [&](auto* opCtx) { _insertBatch(opCtx, batch); });
+                           });
+                   });
            })
         .until([this, chainCtx](Status status) {
             if (status.isOK() && chainCtx->moreToCome) {
@@ -442,7 +472,18 @@ ExecutorFuture<void> ReshardingCollectionCloner::run(
 
             return true;
         })
-        .on(std::move(executor), std::move(cancelToken));
+        .on(executor, std::move(cancelToken))
+        .onCompletion([chainCtx, executor](Status status) {
+            // The loop stops without running another iteration when it is canceled, so the
+            // insertion of the last batch may still be running.
+            if (!chainCtx->pendingInsert) {
+                return ExecutorFuture<void>(executor, status);
+            }
+
+            auto pendingInsert = std::move(*chainCtx->pendingInsert);
+            chainCtx->pendingInsert.reset();
+            return std::move(pendingInsert).onCompletion([status](Status) { return status; });
+        });
 }
 
 }  // namespace mongo
@@ -120,6 +120,10 @@ public:
     bool keyBelongsToMe(const BSONObj& key) const {
         return _impl->get().keyBelongsToMe(key);
     }
+
+    bool rangeBelongsToMe(const BSONObj& min, const BSONObj& max, bool isMaxInclusive) const {
+        return _impl->get().rangeBelongsToMe(min, max, isMaxInclusive);
+    }
 };
 
 }  // namespace mongo
@@ -139,6 +139,14 @@ void validateShardKeyIndexExistsOrCreateIfPossible(OperationContext* opCtx,
                                   << idx["seed"].numberInt(),
                     !shardKeyPattern.isHashedPattern() || idx["seed"].eoo() ||
                         idx["seed"].numberInt() == BSONElementHasher::DEFAULT_HASH_SEED);
+            // Hashed shard keys are hashed with the default hash version.
+            uassert(ErrorCodes::InvalidOptions,
+                    str::stream() << "can't shard collection " << nss.ns()
+                                  << " with hashed shard key " << proposedKey
+                                  << " because the hashed index uses hash version "
+                                  << idx["hashVersion"].numberInt(),
+                    !shardKeyPattern.isHashedPattern() ||
+                        idx["hashVersion"].numberInt() == BSONElementHasher::kDefaultHashVersion);
             hasUsefulIndexForKey = true;
         }
     }
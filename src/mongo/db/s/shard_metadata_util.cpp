@@ -225,7 +225,7 @@ Status updateShardCollectionsEntry(OperationContext* opCtx,
             builder.append("$inc", inc);
         }
 
-        auto commandResponse = client.runCommand([&] {
+        auto commandResponse = client.runCommandDirectly([&] {
             write_ops::Update updateOp(NamespaceString::kShardConfigCollectionsNamespace);
             updateOp.setUpdates({[&] {
                 write_ops::UpdateOpEntry entry;
@@ -236,7 +236,7 @@ Status updateShardCollectionsEntry(OperationContext* opCtx,
             }()});
             return updateOp.serialize({});
         }());
-        uassertStatusOK(getStatusFromWriteCommandResponse(commandResponse->getCommandReply()));
+        uassertStatusOK(getStatusFromWriteCommandResponse(commandResponse));
 
         return Status::OK();
     } catch (const DBException& ex) {
@@ -268,7 +268,7 @@ Status updateShardDatabasesEntry(OperationContext* opCtx,
             builder.append("$inc", inc);
         }
 
-        auto commandResponse = client.runCommand([&] {
+        auto commandResponse = client.runCommandDirectly([&] {
             write_ops::Update updateOp(NamespaceString::kShardConfigDatabasesNamespace);
             updateOp.setUpdates({[&] {
                 write_ops::UpdateOpEntry entry;
@@ -279,7 +279,7 @@ Status updateShardDatabasesEntry(OperationContext* opCtx,
             }()});
             return updateOp.serialize({});
         }());
-        uassertStatusOK(getStatusFromWriteCommandResponse(commandResponse->getCommandReply()));
+        uassertStatusOK(getStatusFromWriteCommandResponse(commandResponse));
 
         return Status::OK();
     } catch (const DBException& ex) {
@@ -371,7 +371,7 @@ Status updateShardChunks(OperationContext* opCtx,
             // ("_id") between (chunk.min, chunk.max].
             //
             // query: { "_id" : {"$gte": chunk.min, "$lt": chunk.max}}
-            auto deleteCommandResponse = client.runCommand([&] {
+            auto deleteCommandResponse = client.runCommandDirectly([&] {
                 write_ops::Delete deleteOp(chunkMetadataNss);
                 deleteOp.setDeletes({[&] {
                     write_ops::DeleteOpEntry entry;
@@ -382,17 +382,15 @@ Status updateShardChunks(OperationContext* opCtx,
                 }()});
                 return deleteOp.serialize({});
             }());
-            uassertStatusOK(
-                getStatusFromWriteCommandResponse(deleteCommandResponse->getCommandReply()));
+            uassertStatusOK(getStatusFromWriteCommandResponse(deleteCommandResponse));
 
             // Now the document can be expected to cleanly insert without overlap
-            auto insertCommandResponse = client.runCommand([&] {
+            auto insertCommandResponse = client.runCommandDirectly([&] {
                 write_ops::Insert insertOp(chunkMetadataNss);
                 insertOp.setDocuments({chunk.toShardBSON()});
                 return insertOp.serialize({});
             }());
-            uassertStatusOK(
-                getStatusFromWriteCommandResponse(insertCommandResponse->getCommandReply()));
+            uassertStatusOK(getStatusFromWriteCommandResponse(insertCommandResponse));
         }
 
         return Status::OK();
@@ -416,16 +414,16 @@ void updateTimestampOnShardCollections(OperationContext* opCtx,
     }());
 
     DBDirectClient client(opCtx);
-    const auto commandResult = client.runCommand(clearFields.serialize({}));
+    const auto commandResult = client.runCommandDirectly(clearFields.serialize({}));
 
-    uassertStatusOK(getStatusFromWriteCommandResponse(commandResult->getCommandReply()));
+    uassertStatusOK(getStatusFromWriteCommandResponse(commandResult));
 }
 
 Status dropChunksAndDeleteCollectionsEntry(OperationContext* opCtx, const NamespaceString& nss) {
     try {
         DBDirectClient client(opCtx);
 
-        auto deleteCommandResponse = client.runCommand([&] {
+        auto deleteCommandResponse = client.runCommandDirectly([&] {
             write_ops::Delete deleteOp(NamespaceString::kShardConfigCollectionsNamespace);
             deleteOp.setDeletes({[&] {
                 write_ops::DeleteOpEntry entry;
@@ -435,8 +433,7 @@ Status dropChunksAndDeleteCollectionsEntry(OperationContext* opCtx, const Namesp
             }()});
             return deleteOp.serialize({});
         }());
-        uassertStatusOK(
-            getStatusFromWriteCommandResponse(deleteCommandResponse->getCommandReply()));
+        uassertStatusOK(getStatusFromWriteCommandResponse(deleteCommandResponse));
 
         // Drop the corresponding config.chunks.ns collection
         BSONObj result;
@@ -483,7 +480,7 @@ Status deleteDatabasesEntry(OperationContext* opCtx, StringData dbName) {
     try {
         DBDirectClient client(opCtx);
 
-        auto deleteCommandResponse = client.runCommand([&] {
+        auto deleteCommandResponse = client.runCommandDirectly([&] {
             write_ops::Delete deleteOp(NamespaceString::kShardConfigDatabasesNamespace);
             deleteOp.setDeletes({[&] {
                 write_ops::DeleteOpEntry entry;
@@ -493,8 +490,7 @@ Status deleteDatabasesEntry(OperationContext* opCtx, StringData dbName) {
             }()});
             return deleteOp.serialize({});
         }());
-        uassertStatusOK(
-            getStatusFromWriteCommandResponse(deleteCommandResponse->getCommandReply()));
+        uassertStatusOK(getStatusFromWriteCommandResponse(deleteCommandResponse));
 
         LOGV2_DEBUG(22092,
                     1,
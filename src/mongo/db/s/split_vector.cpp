@@ -45,6 +45,7 @@
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/query/plan_executor.h"
 #include "mongo/logv2/log.h"
+#include "mongo/s/shard_key_pattern.h"
 
 namespace mongo {
 namespace {
@@ -52,6 +53,9 @@ namespace {
 const int kMaxObjectPerChunk{250000};
 const int estimatedAdditionalBytesPerItemInBSONArray{2};
 
+// The number of sampled documents which must fall within the chunk for the sample to be trusted.
+const size_t kMinSamplesInChunk{20};
+
 BSONObj prettyKey(const BSONObj& keyPattern, const BSONObj& key) {
     return key.replaceFieldNames(keyPattern).clientReadable();
 }
@@ -349,4 +353,102 @@ std::vector<BSONObj> splitVector(OperationContext* opCtx,
     return splitKeys;
 }
 
+boost::optional<std::vector<BSONObj>> sampleSplitVector(OperationContext* opCtx,
+                                                        const NamespaceString& nss,
+                                                        const BSONObj& keyPattern,
+                                                        const BSONObj& min,
+                                                        const BSONObj& max,
+                                                        long long numSamples,
+                                                        long long maxChunkSizeBytes) {
+    AutoGetCollection collection(opCtx, nss, MODE_IS);
+    uassert(ErrorCodes::NamespaceNotFound, "ns not found", collection);
+
+    auto cursor = collection->getRecordStore()->getRandomCursor(opCtx);
+    if (!cursor) {
+        return boost::none;
+    }
+
+    // Draw documents from the whole collection and keep those which belong to the chunk. The share
+    // of the sampled bytes which belong to the chunk estimates the size of the chunk.
+    const ShardKeyPattern shardKeyPattern(keyPattern);
+    std::vector<SplitVectorSample> samples;
+    long long sampledBytes = 0;
+    long long sampledBytesInChunk = 0;
+    for (long long i = 0; i < numSamples; ++i) {
+        opCtx->checkForInterrupt();
+
+        auto record = cursor->next();
+        if (!record) {
+            break;
+        }
+
+        const auto doc = record->data.toBson();
+        sampledBytes += doc.objsize();
+
+        auto key = shardKeyPattern.extractShardKeyFromDoc(doc);
+        if (key.isEmpty() || key.woCompare(min) < 0 ||
+            (!max.isEmpty() && key.woCompare(max) >= 0)) {
+            continue;
+        }
+
+        sampledBytesInChunk += doc.objsize();
+        samples.push_back({key.getOwned(), doc.objsize()});
+    }
+
+    if (samples.size() < kMinSamplesInChunk) {
+        return boost::none;
+    }
+
+    const auto chunkSizeBytes = static_cast<long long>(
+        static_cast<double>(collection->dataSize(opCtx)) * sampledBytesInChunk / sampledBytes);
+    return splitVectorFromSamples(std::move(samples), chunkSizeBytes, maxChunkSizeBytes);
+}
+
+boost::optional<std::vector<BSONObj>> splitVectorFromSamples(
+    std::vector<SplitVectorSample> samples, long long chunkSizeBytes, long long maxChunkSizeBytes) {
+    uassert(ErrorCodes::InvalidOptions,
+            "need to specify the desired max chunk size",
+            maxChunkSizeBytes > 0);
+
+    std::vector<BSONObj> splitKeys;
+    if (chunkSizeBytes < maxChunkSizeBytes || samples.empty()) {
+        return splitKeys;
+    }
+
+    std::sort(samples.begin(), samples.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.key.woCompare(rhs.key) < 0;
+    });
+
+    long long totalWeight = 0;
+    for (const auto& sample : samples) {
+        totalWeight += sample.sizeBytes;
+    }
+
+    // Like splitVector, start a new chunk every half 'maxChunkSizeBytes' of data. The boundaries
+    // fall at the same fractions of the total weight of the samples.
+    const double pieceWeight =
+        static_cast<double>(totalWeight) * (maxChunkSizeBytes / 2.0) / chunkSizeBytes;
+    double nextBoundary = pieceWeight;
+    long long cumulativeWeight = 0;
+    for (const auto& sample : samples) {
+        if (cumulativeWeight >= nextBoundary) {
+            // All the documents with the same shard key must stay in the same chunk, and none of
+            // the new chunks may be left without samples.
+            if (sample.key.woCompare(samples.front().key) > 0 &&
+                (splitKeys.empty() || sample.key.woCompare(splitKeys.back()) != 0)) {
+                splitKeys.push_back(sample.key);
+            }
+            while (nextBoundary <= cumulativeWeight) {
+                nextBoundary += pieceWeight;
+            }
+        }
+        cumulativeWeight += sample.sizeBytes;
+    }
+
+    if (splitKeys.empty()) {
+        return boost::none;
+    }
+    return splitKeys;
+}
+
 }  // namespace mongo
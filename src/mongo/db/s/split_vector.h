@@ -32,9 +32,10 @@
 #include <boost/optional.hpp>
 #include <vector>
 
+#include "mongo/bson/bsonobj.h"
+
 namespace mongo {
 
-class BSONObj;
 class NamespaceString;
 class OperationContext;
 template <typename T>
@@ -66,4 +67,39 @@ std::vector<BSONObj> splitVector(OperationContext* opCtx,
                                  boost::optional<long long> maxChunkObjects,
                                  boost::optional<long long> maxChunkSizeBytes);
 
+/**
+ * Estimates the split points of a chunk from 'numSamples' documents drawn at random from the
+ * collection, rather than by scanning the shard key index over the whole chunk. The cost does not
+ * depend on the size of the chunk, which makes it suitable for auto splitting large chunks.
+ *
+ * Returns boost::none if the sample is inconclusive, in which case the caller should fall back to
+ * splitVector. This happens when the storage engine cannot draw random documents, when too few of
+ * the sampled documents fall within the chunk, or when no split point can be told apart.
+ */
+boost::optional<std::vector<BSONObj>> sampleSplitVector(OperationContext* opCtx,
+                                                        const NamespaceString& nss,
+                                                        const BSONObj& keyPattern,
+                                                        const BSONObj& min,
+                                                        const BSONObj& max,
+                                                        long long numSamples,
+                                                        long long maxChunkSizeBytes);
+
+/**
+ * A shard key sampled from a chunk, along with the size of the document it was taken from.
+ */
+struct SplitVectorSample {
+    BSONObj key;
+    int sizeBytes;
+};
+
+/**
+ * Picks the split points which divide a chunk of about 'chunkSizeBytes' into pieces of half
+ * 'maxChunkSizeBytes', like splitVector does. The split points are the quantiles of
+ * 'samples' weighted by the sizes of their documents. Returns no split points if the chunk is
+ * smaller than 'maxChunkSizeBytes', and boost::none if the chunk should be split but the samples do
+ * not hold distinct enough keys.
+ */
+boost::optional<std::vector<BSONObj>> splitVectorFromSamples(
+    std::vector<SplitVectorSample> samples, long long chunkSizeBytes, long long maxChunkSizeBytes);
+
 }  // namespace mongo
@@ -289,6 +289,55 @@ TEST_F(SplitVectorTest, NoMaxChunkSize) {
 const NamespaceString kJumboNss = NamespaceString("foo", "bar2");
 const std::string kJumboPattern = "a";
 
+std::vector<SplitVectorSample> makeSamples(const std::vector<std::pair<int, int>>& keysAndSizes) {
+    std::vector<SplitVectorSample> samples;
+    for (const auto& [key, sizeBytes] : keysAndSizes) {
+        samples.push_back({BSON(kPattern << key), sizeBytes});
+    }
+    return samples;
+}
+
+void assertSplitKeys(const boost::optional<std::vector<BSONObj>>& splitKeys,
+                     const std::vector<BSONObj>& expected) {
+    ASSERT(splitKeys);
+    ASSERT_EQ(splitKeys->size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_BSONOBJ_EQ((*splitKeys)[i], expected[i]);
+    }
+}
+
+TEST(SplitVectorFromSamplesTest, SplitEveryHalfMaxChunkSize) {
+    std::vector<std::pair<int, int>> keysAndSizes;
+    for (int i = 99; i >= 0; i--) {
+        keysAndSizes.push_back({i, 10});
+    }
+
+    // The chunk holds twice the maximum size, so it is split into four pieces.
+    assertSplitKeys(splitVectorFromSamples(makeSamples(keysAndSizes), 4000, 2000),
+                    {BSON(kPattern << 25), BSON(kPattern << 50), BSON(kPattern << 75)});
+}
+
+TEST(SplitVectorFromSamplesTest, SplitPointsAreWeightedBySize) {
+    // The first key holds half of the sampled bytes.
+    std::vector<std::pair<int, int>> keysAndSizes{{0, 450}};
+    for (int i = 1; i < 10; i++) {
+        keysAndSizes.push_back({i, 50});
+    }
+
+    assertSplitKeys(splitVectorFromSamples(makeSamples(keysAndSizes), 2000, 2000),
+                    {BSON(kPattern << 1)});
+}
+
+TEST(SplitVectorFromSamplesTest, NoSplitBelowMaxChunkSize) {
+    assertSplitKeys(splitVectorFromSamples(makeSamples({{1, 10}, {2, 10}, {3, 10}}), 1999, 2000),
+                    {});
+}
+
+TEST(SplitVectorFromSamplesTest, SamplesOfASingleKeyAreInconclusive) {
+    ASSERT_FALSE(
+        splitVectorFromSamples(makeSamples({{7, 10}, {7, 10}, {7, 10}, {7, 10}}), 8000, 2000));
+}
+
 class SplitVectorJumboTest : public ShardServerTestFixture {
 public:
     void setUp() {
@@ -106,6 +106,7 @@
 #include "mongo/util/fail_point.h"
 #include "mongo/util/future_util.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -1167,7 +1168,10 @@ void RunCommandAndWaitForWriteConcern::_waitForWriteConcern(BSONObjBuilder& bb)
         return;
     }
 
-    CurOp::get(opCtx)->debug().writeConcern.emplace(opCtx->getWriteConcern());
+    auto& opDebug = CurOp::get(opCtx)->debug();
+    opDebug.writeConcern.emplace(opCtx->getWriteConcern());
+    Timer waitTimer;
+    ON_BLOCK_EXIT([&] { opDebug.writeConcernWaitTime += Microseconds{waitTimer.micros()}; });
     _execContext->behaviors->waitForWriteConcern(opCtx, invocation, _lastOpBeforeRun.get(), bb);
 }
 
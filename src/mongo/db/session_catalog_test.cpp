@@ -266,6 +266,36 @@ TEST_F(SessionCatalogTestWithDefaultOpCtx, ScanSessionsMarkForReap) {
     });
 }
 
+TEST_F(SessionCatalogTestWithDefaultOpCtx, ScanSessionsVisitsAndReapsSessionsOfAllPartitions) {
+    // Create enough sessions that they are spread over all the partitions of the catalog.
+    const size_t numSessions = 64;
+    LogicalSessionIdSet lsids;
+    stdx::async(stdx::launch::async,
+                [&] {
+                    ThreadClient tc(getServiceContext());
+                    for (size_t i = 0; i < numSessions; ++i) {
+                        auto opCtx = makeOperationContext();
+                        const auto lsid = makeLogicalSessionIdForTest();
+                        lsids.insert(lsid);
+                        opCtx->setLogicalSessionId(lsid);
+                        OperationContextSession ocs(opCtx.get());
+                    }
+                })
+        .get();
+    ASSERT_EQ(numSessions, catalog()->size());
+
+    SessionKiller::Matcher matcherAllSessions(
+        KillAllSessionsByPatternSet{makeKillAllSessionsByPattern(_opCtx)});
+
+    LogicalSessionIdSet lsidsFound;
+    catalog()->scanSessions(matcherAllSessions, [&](ObservableSession& session) {
+        ASSERT(lsidsFound.insert(session.getSessionId()).second);
+        session.markForReap();
+    });
+    ASSERT(lsids == lsidsFound);
+    ASSERT_EQ(0U, catalog()->size());
+}
+
 TEST_F(SessionCatalogTest, KillSessionWhenSessionIsNotCheckedOut) {
     const auto lsid = makeLogicalSessionIdForTest();
 
@@ -55,6 +55,13 @@ namespace {
 // comfortably be able to stay under, even with 10k user names.
 constexpr size_t kMaxBatchSize = 1000;
 
+// Refreshes and removals are instead sent in batches of as many entries as fit in this many bytes,
+// up to kMaxWriteBatchSize entries, so that a refresh sends few large unordered writes to each
+// shard rather than many small ones. A batch may exceed this size by at most one entry, which stays
+// far below the 16mb limit even with 10k user names.
+constexpr int kMaxWriteBatchBytes = 8 * 1024 * 1024;
+constexpr size_t kMaxWriteBatchSize = 10'000;
+
 // Used to refresh or remove items from the session collection with write
 // concern majority
 const WriteConcernOptions kMajorityWriteConcern{WriteConcernOptions::kMajority,
@@ -136,12 +143,26 @@ void runBulkCmd(StringData label,
         return &(entries.get());
     };
 
-    auto sendLocalBatch = [&](BSONArrayBuilder*) {
+    auto sendLocalBatch = [&] {
         entries->done();
         sendBatch(batchBuilder->done());
     };
 
-    runBulkGeneric(makeBatch, addLine, sendLocalBatch, items);
+    size_t i = 0;
+    makeBatch();
+    for (const auto& item : items) {
+        addLine(&(entries.get()), item);
+
+        if (++i >= kMaxWriteBatchSize || buf.len() >= kMaxWriteBatchBytes) {
+            sendLocalBatch();
+            makeBatch();
+            i = 0;
+        }
+    }
+
+    if (i > 0) {
+        sendLocalBatch();
+    }
 }
 
 }  // namespace
@@ -49,18 +49,25 @@
 #include "mongo/db/sorter/sorter.h"
 
 #include <boost/filesystem/operations.hpp>
+#include <deque>
 #include <snappy.h>
 #include <vector>
+#include <zstd.h>
 
 #include "mongo/base/string_data.h"
 #include "mongo/config.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/sorter/sorter_parallel.h"
+#include "mongo/db/sorter/sorter_spill.h"
 #include "mongo/db/storage/encryption_hooks.h"
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
 #include "mongo/platform/overflow_arithmetic.h"
 #include "mongo/s/is_mongos.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/destructor_guard.h"
 #include "mongo/util/str.h"
@@ -142,6 +149,55 @@ void dassertCompIsSane(const Comparator& comp, const Data& lhs, const Data& rhs)
 #endif
 }
 
+/**
+ * Stable sorts [begin, end) on up to 'parallelism' threads: each thread sorts a slice of the range,
+ * then adjacent slices are merged pairwise, with the merges of each round also running in parallel.
+ */
+template <typename RandomIt, typename Less>
+void parallelStableSort(RandomIt begin, RandomIt end, const Less& less, size_t parallelism) {
+    const size_t size = end - begin;
+    std::vector<RandomIt> bounds;
+    for (size_t i = 0; i < parallelism; ++i) {
+        bounds.push_back(begin + size * i / parallelism);
+    }
+    bounds.push_back(end);
+
+    runInParallel(parallelism, [&](size_t slice) {
+        std::stable_sort(bounds[slice], bounds[slice + 1], less);
+    });
+
+    while (bounds.size() > 2) {
+        const size_t numMerges = (bounds.size() - 1) / 2;
+        runInParallel(numMerges, [&](size_t merge) {
+            std::inplace_merge(
+                bounds[2 * merge], bounds[2 * merge + 1], bounds[2 * merge + 2], less);
+        });
+
+        std::vector<RandomIt> mergedBounds;
+        for (size_t i = 0; i < bounds.size(); i += 2) {
+            mergedBounds.push_back(bounds[i]);
+        }
+        if (mergedBounds.back() != end) {
+            mergedBounds.push_back(end);
+        }
+        bounds = std::move(mergedBounds);
+    }
+}
+
+/**
+ * Stable sorts an in-memory run of data which takes up 'memUsageBytes', on several threads if the
+ * run is large enough.
+ */
+template <typename RandomIt, typename Less>
+void stableSortRun(RandomIt begin, RandomIt end, const Less& less, size_t memUsageBytes) {
+    const auto parallelism = getSortParallelism(end - begin, memUsageBytes);
+    if (parallelism > 1) {
+        parallelStableSort(begin, end, less, parallelism);
+    } else {
+        std::stable_sort(begin, end, less);
+    }
+}
+
 /**
  * Returns results from sorted in-memory storage.
  */
@@ -329,6 +385,27 @@ private:
             return;
         }
 
+        // A compressed block is either a zstd frame or snappy data. Snappy data can never start
+        // with the zstd magic number, because the byte after the length of the uncompressed data
+        // would have to be a copy of earlier data that does not exist yet.
+        const auto zstdContentSize = ZSTD_getFrameContentSize(_buffer.get(), blockSize);
+        if (zstdContentSize != ZSTD_CONTENTSIZE_ERROR) {
+            uassert(5502113,
+                    "couldn't get uncompressed length",
+                    zstdContentSize != ZSTD_CONTENTSIZE_UNKNOWN);
+
+            std::unique_ptr<char[]> decompressionBuffer(new char[zstdContentSize]);
+            const size_t decompressedSize = ZSTD_decompress(
+                decompressionBuffer.get(), zstdContentSize, _buffer.get(), blockSize);
+            uassert(5502114,
+                    "decompression failed",
+                    !ZSTD_isError(decompressedSize) && decompressedSize == zstdContentSize);
+
+            _buffer.swap(decompressionBuffer);
+            _bufferReader.reset(new BufReader(_buffer.get(), decompressedSize));
+            return;
+        }
+
         dassert(snappy::IsValidCompressedBuffer(_buffer.get(), blockSize));
 
         size_t uncompressedSize;
@@ -541,6 +618,110 @@ private:
     STLComparator _greater;                      // named so calls make sense
 };
 
+/**
+ * Iterates over another iterator on a thread of its own, which reads ahead into a buffer of
+ * owned data of at most 'maxBufferedBytes'. Lets a merge of several groups of runs merge each
+ * group on its own thread.
+ */
+template <typename Key, typename Value>
+class AsyncIterator : public SortIteratorInterface<Key, Value> {
+public:
+    typedef SortIteratorInterface<Key, Value> Input;
+    typedef std::pair<Key, Value> Data;
+
+    AsyncIterator(std::shared_ptr<Input> source, size_t maxBufferedBytes)
+        : _source(std::move(source)), _maxBufferedBytes(std::max<size_t>(maxBufferedBytes, 1)) {}
+
+    ~AsyncIterator() {
+        closeSource();
+    }
+
+    void openSource() {
+        invariant(!_thread.joinable());
+        _thread = stdx::thread([this] { _produce(); });
+    }
+
+    void closeSource() {
+        if (!_thread.joinable()) {
+            return;
+        }
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            _shutdown = true;
+        }
+        _producerCV.notify_one();
+        _thread.join();
+        _source.reset();
+    }
+
+    bool more() {
+        stdx::unique_lock<Latch> lk(_mutex);
+        _consumerCV.wait(lk, [&] { return !_buffer.empty() || _producerDone; });
+        uassertStatusOK(_producerStatus);
+        return !_buffer.empty();
+    }
+
+    Data next() {
+        stdx::unique_lock<Latch> lk(_mutex);
+        _consumerCV.wait(lk, [&] { return !_buffer.empty() || _producerDone; });
+        uassertStatusOK(_producerStatus);
+        invariant(!_buffer.empty());
+
+        Data data = std::move(_buffer.front());
+        _buffer.pop_front();
+        _bufferedBytes -= data.first.memUsageForSorter() + data.second.memUsageForSorter();
+        lk.unlock();
+
+        _producerCV.notify_one();
+        return data;
+    }
+
+private:
+    void _produce() {
+        try {
+            while (_source->more()) {
+                Data data = _source->next();
+                Data owned(data.first.getOwned(), data.second.getOwned());
+                const size_t bytes =
+                    owned.first.memUsageForSorter() + owned.second.memUsageForSorter();
+
+                stdx::unique_lock<Latch> lk(_mutex);
+                _producerCV.wait(
+                    lk, [&] { return _shutdown || _bufferedBytes < _maxBufferedBytes; });
+                if (_shutdown) {
+                    break;
+                }
+                _buffer.push_back(std::move(owned));
+                _bufferedBytes += bytes;
+                lk.unlock();
+                _consumerCV.notify_one();
+            }
+        } catch (const DBException& ex) {
+            stdx::lock_guard<Latch> lk(_mutex);
+            _producerStatus = ex.toStatus();
+        }
+
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            _producerDone = true;
+        }
+        _consumerCV.notify_one();
+    }
+
+    std::shared_ptr<Input> _source;
+    const size_t _maxBufferedBytes;
+    stdx::thread _thread;
+
+    Mutex _mutex = MONGO_MAKE_LATCH("AsyncIterator::_mutex");
+    stdx::condition_variable _producerCV;  // Signaled when the buffer drains or on shutdown.
+    stdx::condition_variable _consumerCV;  // Signaled when the buffer fills or at the end.
+    std::deque<Data> _buffer;
+    size_t _bufferedBytes = 0;
+    bool _shutdown = false;
+    bool _producerDone = false;
+    Status _producerStatus = Status::OK();
+};
+
 template <typename Key, typename Value, typename Comparator>
 class NoLimitSorter : public Sorter<Key, Value> {
 public:
@@ -584,6 +765,9 @@ public:
     }
 
     ~NoLimitSorter() {
+        // The file may still be written to by a spill in the background.
+        DESTRUCTOR_GUARD(waitForPendingSpill());
+
         // This Sorter is responsible for file deletion, even if done() was called.
         if (!this->_shouldKeepFilesOnDestruction) {
             DESTRUCTOR_GUARD(boost::filesystem::remove(this->_fileFullPath));
@@ -599,8 +783,7 @@ public:
         _memUsed += memUsage;
         this->_totalDataSizeSorted += memUsage;
 
-        if (_memUsed > this->_opts.maxMemoryUsageBytes)
-            spill();
+        spillIfNeeded();
     }
 
     void emplace(Key&& key, Value&& val) override {
@@ -612,13 +795,13 @@ public:
 
         _data.emplace_back(std::move(key), std::move(val));
 
-        if (_memUsed > this->_opts.maxMemoryUsageBytes)
-            spill();
+        spillIfNeeded();
     }
 
     Iterator* done() {
         invariant(!std::exchange(_done, true));
 
+        waitForPendingSpill();
         if (this->_iters.empty()) {
             sort();
             return new InMemIterator<Key, Value>(_data);
@@ -641,16 +824,105 @@ private:
         const Comparator& _comp;
     };
 
+    struct SpilledRun {
+        std::shared_ptr<Iterator> iter;
+        std::streampos fileEndOffset = 0;
+        uint64_t spilledDataSizeBytes = 0;
+        uint64_t spilledStorageSizeBytes = 0;
+    };
+
+    bool needsSpill() const {
+        // The run being written in the background still holds its memory.
+        const size_t memUsed = _memUsed + _pendingSpillMemUsed;
+        if (memUsed > this->_opts.maxMemoryUsageBytes) {
+            return true;
+        }
+
+        // The memory is reported even when the sorter may not spill.
+        const bool spillEarly =
+            this->_opts.shouldSpillEarly && this->_opts.shouldSpillEarly(memUsed);
+        return spillEarly && this->_opts.extSortAllowed;
+    }
+
+    void spillIfNeeded() {
+        if (!needsSpill()) {
+            return;
+        }
+
+        // Once the run being written in the background releases its memory, there may be room
+        // for more data in this one.
+        if (_pendingSpill) {
+            waitForPendingSpill();
+            if (!needsSpill()) {
+                return;
+            }
+        }
+
+        spillRun(sorter::shouldSpillInBackground());
+    }
+
     void sort() {
         STLComparator less(_comp);
-        std::stable_sort(_data.begin(), _data.end(), less);
+        stableSortRun(_data.begin(), _data.end(), less, _memUsed);
         this->_numSorted += _data.size();
     }
 
+    /**
+     * Writes the sorted 'data' to the sorter's file at 'fileStartOffset', and returns the
+     * iterator over it along with the size of what was written.
+     */
+    static SpilledRun writeRun(const SortOptions& opts,
+                               const std::string& fileFullPath,
+                               std::streampos fileStartOffset,
+                               const Settings& settings,
+                               std::deque<Data>* data) {
+        SortedFileWriter<Key, Value> writer(opts, fileFullPath, fileStartOffset, settings);
+        for (; !data->empty(); data->pop_front()) {
+            writer.addAlreadySorted(data->front().first, data->front().second);
+        }
+
+        SpilledRun run;
+        run.iter.reset(writer.done());
+        run.fileEndOffset = writer.getFileEndOffset();
+        run.spilledDataSizeBytes = writer.getSpilledDataSizeBytes();
+        run.spilledStorageSizeBytes = writer.getSpilledStorageSizeBytes();
+        return run;
+    }
+
+    void addSpilledRun(const SpilledRun& run) {
+        _nextSortedFileWriterOffset = run.fileEndOffset;
+        this->_spilledDataSizeBytes += run.spilledDataSizeBytes;
+        this->_spilledStorageSizeBytes += run.spilledStorageSizeBytes;
+        this->_iters.push_back(run.iter);
+    }
+
+    /**
+     * Waits for the run being written in the background, if any, to be written, and adds it to
+     * the spilled runs. Rethrows the error if writing it failed.
+     */
+    void waitForPendingSpill() {
+        if (!_pendingSpill) {
+            return;
+        }
+
+        auto pendingSpill = std::move(*_pendingSpill);
+        _pendingSpill.reset();
+        _pendingSpillMemUsed = 0;
+        pendingSpill.get();
+        addSpilledRun(*_pendingSpillRun);
+        _pendingSpillRun.reset();
+    }
+
     void spill() {
+        spillRun(/*inBackground=*/false);
+    }
+
+    void spillRun(bool inBackground) {
         this->_numSpills++;
-        if (_data.empty())
+        if (_data.empty()) {
+            waitForPendingSpill();
             return;
+        }
 
         if (!this->_opts.extSortAllowed) {
             // This error message only applies to sorts from user queries made through the find or
@@ -663,19 +935,36 @@ private:
                           << " bytes, but did not opt in to external sorting.");
         }
 
+        // This run is sorted while the previous one may still be written in the background, but
+        // the runs share the file, so this one can only be written after it.
         sort();
-
-        SortedFileWriter<Key, Value> writer(
-            this->_opts, this->_fileFullPath, _nextSortedFileWriterOffset, _settings);
-        for (; !_data.empty(); _data.pop_front()) {
-            writer.addAlreadySorted(_data.front().first, _data.front().second);
+        waitForPendingSpill();
+
+        if (inBackground) {
+            auto data = std::make_shared<std::deque<Data>>(std::move(_data));
+            _data.clear();
+            _pendingSpillRun = std::make_shared<SpilledRun>();
+            _pendingSpill = sorter::spillInBackground([opts = this->_opts,
+                                                       fileFullPath = this->_fileFullPath,
+                                                       offset = _nextSortedFileWriterOffset,
+                                                       settings = _settings,
+                                                       data = std::move(data),
+                                                       run = _pendingSpillRun] {
+                *run = writeRun(opts, fileFullPath, offset, settings, data.get());
+            });
+            _pendingSpillMemUsed = _memUsed;
+        } else {
+            addSpilledRun(writeRun(this->_opts,
+                                   this->_fileFullPath,
+                                   _nextSortedFileWriterOffset,
+                                   _settings,
+                                   &_data));
         }
-        Iterator* iteratorPtr = writer.done();
-        _nextSortedFileWriterOffset = writer.getFileEndOffset();
-
-        this->_iters.push_back(std::shared_ptr<Iterator>(iteratorPtr));
 
         _memUsed = 0;
+        if (this->_opts.shouldSpillEarly) {
+            this->_opts.shouldSpillEarly(_pendingSpillMemUsed);
+        }
     }
 
     const Comparator _comp;
@@ -684,6 +973,12 @@ private:
     bool _done = false;
     size_t _memUsed = 0;
     std::deque<Data> _data;  // Data that has not been spilled.
+
+    // The run being written to disk in the background, if any, the memory it holds until it is
+    // written, and where its iterator is stored once it is.
+    boost::optional<Future<void>> _pendingSpill;
+    size_t _pendingSpillMemUsed = 0;
+    std::shared_ptr<SpilledRun> _pendingSpillRun;
 };
 
 template <typename Key, typename Value, typename Comparator>
@@ -850,7 +1145,7 @@ private:
         if (_data.size() == this->_opts.limit) {
             std::sort_heap(_data.begin(), _data.end(), less);
         } else {
-            std::stable_sort(_data.begin(), _data.end(), less);
+            stableSortRun(_data.begin(), _data.end(), less, _memUsed);
         }
     }
 
@@ -967,6 +1262,8 @@ private:
 
         Iterator* iteratorPtr = writer.done();
         _nextSortedFileWriterOffset = writer.getFileEndOffset();
+        this->_spilledDataSizeBytes += writer.getSpilledDataSizeBytes();
+        this->_spilledStorageSizeBytes += writer.getSpilledStorageSizeBytes();
         this->_iters.push_back(std::shared_ptr<Iterator>(iteratorPtr));
 
         _memUsed = 0;
@@ -1088,10 +1385,28 @@ void SortedFileWriter<Key, Value>::spill() {
         return;
 
     std::string compressed;
-    snappy::Compress(outBuffer, size, &compressed);
+    switch (sorter::getSpillCompressor()) {
+        case sorter::SpillCompressor::kNone:
+            break;
+        case sorter::SpillCompressor::kSnappy:
+            snappy::Compress(outBuffer, size, &compressed);
+            break;
+        case sorter::SpillCompressor::kZstd: {
+            compressed.resize(ZSTD_compressBound(size));
+            const size_t compressedSize = ZSTD_compress(
+                &compressed[0], compressed.size(), outBuffer, size, ZSTD_CLEVEL_DEFAULT);
+            uassert(5502112,
+                    str::stream() << "Failed to compress data: "
+                                  << ZSTD_getErrorName(compressedSize),
+                    !ZSTD_isError(compressedSize));
+            compressed.resize(compressedSize);
+            break;
+        }
+    }
     verify(compressed.size() <= size_t(std::numeric_limits<int32_t>::max()));
 
-    const bool shouldCompress = compressed.size() < size_t(_buffer.len() / 10 * 9);
+    const bool shouldCompress =
+        !compressed.empty() && compressed.size() < size_t(_buffer.len() / 10 * 9);
     if (shouldCompress) {
         size = compressed.size();
         outBuffer = const_cast<char*>(compressed.data());
@@ -1126,6 +1441,11 @@ void SortedFileWriter<Key, Value>::spill() {
                                   << "\": " << sorter::myErrnoWithDescription());
     }
 
+    const uint64_t storageSizeBytes = sizeof(size) + std::abs(size);
+    _spilledDataSizeBytes += _buffer.len();
+    _spilledStorageSizeBytes += storageSizeBytes;
+    sorter::recordSpilledBlock(_buffer.len(), storageSizeBytes);
+
     _buffer.reset();
 }
 
@@ -1157,7 +1477,25 @@ SortIteratorInterface<Key, Value>* SortIteratorInterface<Key, Value>::merge(
     const std::vector<std::shared_ptr<SortIteratorInterface>>& iters,
     const SortOptions& opts,
     const Comparator& comp) {
-    return new sorter::MergeIterator<Key, Value, Comparator>(iters, opts, comp);
+    // Split the ranges into contiguous groups, merge each group on its own thread and merge the
+    // outputs of the groups on this one. Contiguous groups return equal keys in the order of their
+    // ranges, as a single merge of all the ranges would.
+    const size_t numGroups = std::min(opts.mergeThreads, iters.size() / 2);
+    if (numGroups <= 1) {
+        return new sorter::MergeIterator<Key, Value, Comparator>(iters, opts, comp);
+    }
+
+    std::vector<std::shared_ptr<SortIteratorInterface>> groups;
+    const size_t maxBufferedBytesPerGroup = opts.maxMemoryUsageBytes / numGroups;
+    for (size_t i = 0; i < numGroups; ++i) {
+        std::vector<std::shared_ptr<SortIteratorInterface>> group(
+            iters.begin() + i * iters.size() / numGroups,
+            iters.begin() + (i + 1) * iters.size() / numGroups);
+        groups.push_back(std::make_shared<sorter::AsyncIterator<Key, Value>>(
+            std::make_shared<sorter::MergeIterator<Key, Value, Comparator>>(group, opts, comp),
+            maxBufferedBytesPerGroup));
+    }
+    return new sorter::MergeIterator<Key, Value, Comparator>(groups, opts, comp);
 }
 
 template <typename Key, typename Value>
@@ -33,6 +33,7 @@
 
 #include <deque>
 #include <fstream>
+#include <functional>
 #include <memory>
 #include <string>
 #include <utility>
@@ -114,6 +115,17 @@ struct SortOptions {
     // extSortAllowed is true.
     std::string tempDir;
 
+    // The number of threads which merge the data spilled to disk. With more than one, the spilled
+    // ranges are split into groups that are each merged on their own thread, and the results of
+    // the groups are merged by the thread reading from the sorter.
+    size_t mergeThreads = 1;
+
+    // If set, an unlimited sorter calls this with the approximate number of bytes that it holds in
+    // memory each time that it grows within maxMemoryUsageBytes, and with 0 after it spills.
+    // Returning true while external sorting is allowed makes the sorter spill before it reaches
+    // maxMemoryUsageBytes.
+    std::function<bool(size_t)> shouldSpillEarly;
+
     SortOptions() : limit(0), maxMemoryUsageBytes(64 * 1024 * 1024), extSortAllowed(false) {}
 
     // Fluent API to support expressions like SortOptions().Limit(1000).ExtSortAllowed(true)
@@ -138,6 +150,16 @@ struct SortOptions {
         return *this;
     }
 
+    SortOptions& MergeThreads(size_t newMergeThreads) {
+        mergeThreads = newMergeThreads;
+        return *this;
+    }
+
+    SortOptions& ShouldSpillEarly(std::function<bool(size_t)> newShouldSpillEarly) {
+        shouldSpillEarly = std::move(newShouldSpillEarly);
+        return *this;
+    }
+
     SortOptions& DBName(std::string newDbName) {
         dbName = std::move(newDbName);
         return *this;
@@ -281,6 +303,14 @@ public:
         return _totalDataSizeSorted;
     }
 
+    uint64_t spilledDataSizeBytes() const {
+        return _spilledDataSizeBytes;
+    }
+
+    uint64_t spilledStorageSizeBytes() const {
+        return _spilledStorageSizeBytes;
+    }
+
     PersistedState persistDataForShutdown();
 
 protected:
@@ -292,6 +322,11 @@ protected:
     size_t _numSorted = 0;  // Keeps track of the number of keys sorted.
     uint64_t _totalDataSizeSorted = 0;  // Keeps track of the total size of data sorted.
 
+    // The size of the data spilled to disk, and the number of bytes that data took up on disk after
+    // compression and encryption.
+    uint64_t _spilledDataSizeBytes = 0;
+    uint64_t _spilledStorageSizeBytes = 0;
+
     // Whether the files written by this Sorter should be kept on destruction.
     bool _shouldKeepFilesOnDestruction = false;
 
@@ -344,6 +379,16 @@ public:
         return _fileEndOffset;
     }
 
+    /**
+     * The size of the data spilled to disk so far, and the number of bytes written to disk for it.
+     */
+    uint64_t getSpilledDataSizeBytes() const {
+        return _spilledDataSizeBytes;
+    }
+    uint64_t getSpilledStorageSizeBytes() const {
+        return _spilledStorageSizeBytes;
+    }
+
 private:
     void spill();
 
@@ -362,6 +407,9 @@ private:
     std::streampos _fileStartOffset;
     std::streampos _fileEndOffset;
 
+    uint64_t _spilledDataSizeBytes = 0;
+    uint64_t _spilledStorageSizeBytes = 0;
+
     boost::optional<std::string> _dbName;
 };
 }  // namespace mongo
@@ -0,0 +1,157 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/sorter/sorter_parallel.h"
+
+#include <algorithm>
+
+#include "mongo/base/counter.h"
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/sorter/sorter_parallel_gen.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/thread_pool.h"
+
+namespace mongo {
+namespace sorter {
+namespace {
+
+// The smallest number of items worth handing to a thread of its own.
+const size_t kMinItemsPerThread = 4 * 1024;
+
+Counter64 parallelSorts;
+Counter64 backgroundSpills;
+
+ServerStatusMetricField<Counter64> displayParallelSorts("sorter.parallelSorts", &parallelSorts);
+ServerStatusMetricField<Counter64> displayBackgroundSpills("sorter.backgroundSpills",
+                                                           &backgroundSpills);
+
+/**
+ * Returns the thread pool shared by every sorter in the process. Its size is fixed at startup by
+ * 'sorterMaxParallelism'.
+ */
+ThreadPool* getSorterThreadPool() {
+    static const auto pool = [] {
+        ThreadPool::Options options;
+        options.poolName = "SorterThreadPool";
+        options.threadNamePrefix = "Sorter";
+        options.minThreads = 0;
+        options.maxThreads = gSorterMaxParallelism.load();
+        auto pool = std::make_unique<ThreadPool>(options);
+        pool->startup();
+        return pool;
+    }();
+    return pool.get();
+}
+
+}  // namespace
+
+size_t getSortParallelism(size_t numItems, size_t memUsageBytes) {
+    const size_t maxParallelism = gSorterMaxParallelism.load();
+    if (maxParallelism <= 1 ||
+        memUsageBytes < static_cast<size_t>(gSorterParallelSortMinBytes.load())) {
+        return 1;
+    }
+    return std::max<size_t>(1, std::min(maxParallelism, numItems / kMinItemsPerThread));
+}
+
+bool shouldSpillInBackground() {
+    return gSorterMaxParallelism.load() > 1;
+}
+
+void runInParallel(size_t numTasks, const std::function<void(size_t)>& task) {
+    invariant(numTasks > 0);
+    if (numTasks > 1) {
+        parallelSorts.increment();
+    }
+
+    auto mutex = MONGO_MAKE_LATCH("sorter::runInParallel::mutex");
+    stdx::condition_variable allTasksDone;
+    size_t numRunning = numTasks - 1;
+    Status status = Status::OK();
+
+    auto pool = getSorterThreadPool();
+    for (size_t taskId = 1; taskId < numTasks; ++taskId) {
+        pool->schedule([&, taskId](Status scheduleStatus) {
+            if (scheduleStatus.isOK()) {
+                try {
+                    task(taskId);
+                } catch (const DBException& ex) {
+                    scheduleStatus = ex.toStatus();
+                }
+            }
+
+            stdx::lock_guard<Latch> lk(mutex);
+            if (!scheduleStatus.isOK() && status.isOK()) {
+                status = scheduleStatus;
+            }
+            if (--numRunning == 0) {
+                allTasksDone.notify_all();
+            }
+        });
+    }
+
+    Status localStatus = Status::OK();
+    try {
+        task(0);
+    } catch (const DBException& ex) {
+        localStatus = ex.toStatus();
+    }
+
+    {
+        // The tasks refer to state on this thread's stack, so we must wait for all of them.
+        stdx::unique_lock<Latch> lk(mutex);
+        allTasksDone.wait(lk, [&] { return numRunning == 0; });
+    }
+    uassertStatusOK(localStatus);
+    uassertStatusOK(status);
+}
+
+Future<void> spillInBackground(unique_function<void()> writeRun) {
+    backgroundSpills.increment();
+
+    auto pf = makePromiseFuture<void>();
+    getSorterThreadPool()->schedule(
+        [writeRun = std::move(writeRun),
+         promise = std::move(pf.promise)](Status scheduleStatus) mutable {
+            if (!scheduleStatus.isOK()) {
+                promise.setError(scheduleStatus);
+                return;
+            }
+            promise.setWith([&] { writeRun(); });
+        });
+    return std::move(pf.future);
+}
+
+}  // namespace sorter
+}  // namespace mongo
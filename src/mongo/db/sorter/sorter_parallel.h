@@ -0,0 +1,69 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+#include "mongo/util/functional.h"
+#include "mongo/util/future.h"
+
+namespace mongo {
+namespace sorter {
+
+/**
+ * Returns the number of threads to sort an in-memory run of 'numItems' items which take up
+ * 'memUsageBytes' with, as allowed by the 'sorterMaxParallelism' and 'sorterParallelSortMinBytes'
+ * server parameters. Returns 1 if the run should be sorted on the calling thread alone.
+ */
+size_t getSortParallelism(size_t numItems, size_t memUsageBytes);
+
+/**
+ * Returns true if a spilled run may be written to disk on the sorter thread pool while the caller
+ * collects the next run.
+ */
+bool shouldSpillInBackground();
+
+/**
+ * Calls 'task' with each index in [0, numTasks), running task 0 on the calling thread and the
+ * others on the sorter thread pool. Waits for every task to complete, even if some of them throw,
+ * then rethrows the first error.
+ */
+void runInParallel(size_t numTasks, const std::function<void(size_t)>& task);
+
+/**
+ * Runs 'writeRun', which writes a spilled run to disk, on the sorter thread pool. The returned
+ * future is ready once the run is written, and holds the error if writing it failed.
+ */
+Future<void> spillInBackground(unique_function<void()> writeRun);
+
+}  // namespace sorter
+}  // namespace mongo
@@ -0,0 +1,83 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/sorter/sorter_spill.h"
+
+#include "mongo/base/counter.h"
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/sorter/sorter_spill_gen.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace sorter {
+namespace {
+
+Counter64 spilledDataSizeBytes;
+Counter64 spilledStorageSizeBytes;
+
+ServerStatusMetricField<Counter64> displaySpilledDataSizeBytes("sorter.spilledDataSizeBytes",
+                                                               &spilledDataSizeBytes);
+ServerStatusMetricField<Counter64> displaySpilledStorageSizeBytes(
+    "sorter.spilledStorageSizeBytes", &spilledStorageSizeBytes);
+
+SpillCompressor parseSpillCompressor(StringData value) {
+    if (value == "snappy"_sd) {
+        return SpillCompressor::kSnappy;
+    } else if (value == "zstd"_sd) {
+        return SpillCompressor::kZstd;
+    }
+    invariant(value == "none"_sd);
+    return SpillCompressor::kNone;
+}
+
+}  // namespace
+
+SpillCompressor getSpillCompressor() {
+    return parseSpillCompressor(gSorterSpillCompressor.get());
+}
+
+Status validateSpillCompressor(const std::string& value) {
+    if (value != "snappy" && value != "zstd" && value != "none") {
+        return {ErrorCodes::BadValue,
+                str::stream() << "Unsupported sorter spill compressor '" << value
+                              << "', expected one of 'snappy', 'zstd' or 'none'"};
+    }
+    return Status::OK();
+}
+
+void recordSpilledBlock(uint64_t dataSizeBytes, uint64_t storageSizeBytes) {
+    spilledDataSizeBytes.increment(dataSizeBytes);
+    spilledStorageSizeBytes.increment(storageSizeBytes);
+}
+
+}  // namespace sorter
+}  // namespace mongo
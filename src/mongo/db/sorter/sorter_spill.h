@@ -0,0 +1,64 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "mongo/base/status.h"
+
+namespace mongo {
+namespace sorter {
+
+/**
+ * The compressors the sorter can apply to the blocks it spills to disk, as chosen by the
+ * 'sorterSpillCompressor' server parameter.
+ */
+enum class SpillCompressor { kNone, kSnappy, kZstd };
+
+/**
+ * Returns the compressor that blocks spilled from now on should be compressed with.
+ */
+SpillCompressor getSpillCompressor();
+
+/**
+ * Validates a value of the 'sorterSpillCompressor' server parameter.
+ */
+Status validateSpillCompressor(const std::string& value);
+
+/**
+ * Adds a spilled block to the process-wide totals reported in serverStatus. 'dataSizeBytes' is the
+ * size of the serialized data in the block and 'storageSizeBytes' the number of bytes written to
+ * disk for it, after compression and encryption.
+ */
+void recordSpilledBlock(uint64_t dataSizeBytes, uint64_t storageSizeBytes);
+
+}  // namespace sorter
+}  // namespace mongo
@@ -32,6 +32,7 @@
 #include "mongo/platform/basic.h"
 
 #include <boost/filesystem.hpp>
+#include <algorithm>
 #include <fstream>
 #include <memory>
 
@@ -39,12 +40,15 @@
 #include "mongo/base/static_assert.h"
 #include "mongo/config.h"
 #include "mongo/db/sorter/sorter.h"
+#include "mongo/db/sorter/sorter_parallel_gen.h"
+#include "mongo/db/sorter/sorter_spill_gen.h"
 #include "mongo/logv2/log.h"
 #include "mongo/platform/random.h"
 #include "mongo/stdx/thread.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 
 namespace mongo {
@@ -305,6 +309,43 @@ public:
 
             ASSERT_TRUE(boost::filesystem::remove(fileName));
         }
+        {  // each spill compressor, and a file whose blocks use different compressors
+            const std::string originalCompressor = gSorterSpillCompressor.get();
+            ON_BLOCK_EXIT([&] { gSorterSpillCompressor = originalCompressor; });
+
+            for (auto compressor : {"none", "snappy", "zstd", "mixed"}) {
+                const bool mixed = compressor == std::string("mixed");
+                gSorterSpillCompressor = mixed ? "zstd" : compressor;
+
+                // Repeat each pair so that the data compresses well.
+                std::vector<IWPair> pairs;
+                std::string fileName = opts.tempDir + "/" + nextFileName();
+                SortedFileWriter<IntWrapper, IntWrapper> sorter(opts, fileName, 0);
+                for (int i = 0; i < 100 * 1000; i++) {
+                    if (mixed && i % 10000 == 0) {
+                        gSorterSpillCompressor = (i / 10000) % 2 ? "snappy" : "zstd";
+                    }
+                    pairs.emplace_back(i / 100, -(i / 100));
+                    sorter.addAlreadySorted(pairs.back().first, pairs.back().second);
+                }
+
+                auto expected =
+                    std::make_shared<sorter::InMemIterator<IntWrapper, IntWrapper>>(pairs);
+                ASSERT_ITERATORS_EQUIVALENT(std::shared_ptr<IWIterator>(sorter.done()), expected);
+                ASSERT_EQ(sorter.getSpilledDataSizeBytes(), 100 * 1000 * 2 * sizeof(int));
+                ASSERT_EQ(sorter.getSpilledStorageSizeBytes(),
+                          boost::filesystem::file_size(fileName));
+                if (compressor == std::string("none")) {
+                    ASSERT_GT(sorter.getSpilledStorageSizeBytes(),
+                              sorter.getSpilledDataSizeBytes());
+                } else {
+                    ASSERT_LT(sorter.getSpilledStorageSizeBytes(),
+                              sorter.getSpilledDataSizeBytes());
+                }
+
+                ASSERT_TRUE(boost::filesystem::remove(fileName));
+            }
+        }
 
         ASSERT(boost::filesystem::is_empty(tempDir.path()));
     }
@@ -649,6 +690,33 @@ class LotsOfDataWithLimit : public LotsOfDataLittleMemory<Random> {
     }
     enum { MEM_LIMIT = 32 * 1024 };
 };
+
+template <bool Random = true>
+class LotsOfDataParallelMerge : public LotsOfDataLittleMemory<Random> {
+    SortOptions adjustSortOptions(SortOptions opts) override {
+        return LotsOfDataLittleMemory<Random>::adjustSortOptions(opts).MergeThreads(4);
+    }
+};
+
+/**
+ * Sorts every run on several threads, and writes every spilled run in the background.
+ */
+template <bool Random = true>
+class LotsOfDataParallelSort : public LotsOfDataLittleMemory<Random> {
+public:
+    void run() {
+        const auto originalMaxParallelism = gSorterMaxParallelism.load();
+        const auto originalMinBytes = gSorterParallelSortMinBytes.load();
+        ON_BLOCK_EXIT([&] {
+            gSorterMaxParallelism.store(originalMaxParallelism);
+            gSorterParallelSortMinBytes.store(originalMinBytes);
+        });
+        gSorterMaxParallelism.store(4);
+        gSorterParallelSortMinBytes.store(0);
+
+        LotsOfDataLittleMemory<Random>::run();
+    }
+};
 }  // namespace SorterTests
 
 class SorterSuite : public mongo::unittest::OldStyleSuiteSpecification {
@@ -673,6 +741,10 @@ public:
         add<SorterTests::LotsOfDataWithLimit<100, /*random=*/true>>();    // fits in mem
         add<SorterTests::LotsOfDataWithLimit<5000, /*random=*/false>>();  // spills
         add<SorterTests::LotsOfDataWithLimit<5000, /*random=*/true>>();   // spills
+        add<SorterTests::LotsOfDataParallelMerge</*random=*/false>>();
+        add<SorterTests::LotsOfDataParallelMerge</*random=*/true>>();
+        add<SorterTests::LotsOfDataParallelSort</*random=*/false>>();
+        add<SorterTests::LotsOfDataParallelSort</*random=*/true>>();
         add<SorterTests::LimitExtreme<kMaxAsU64<uint32_t>>>();
         add<SorterTests::LimitExtreme<kMaxAsU64<uint32_t> - 1>>();
         add<SorterTests::LimitExtreme<kMaxAsU64<uint32_t> + 1>>();
@@ -864,6 +936,73 @@ TEST_F(SorterMakeFromExistingRangesTest, RoundTrip) {
     }
 }
 
+TEST(SorterTest, ShouldSpillEarlyMakesTheSorterSpill) {
+    unittest::TempDir tempDir("sorterTests");
+    std::vector<size_t> reported;
+    auto opts = SortOptions().TempDir(tempDir.path()).ShouldSpillEarly([&](size_t memUsed) {
+        reported.push_back(memUsed);
+        return memUsed >= 3 * 2 * sizeof(IntWrapper);
+    });
+
+    // Without external sorting, the memory is still reported but the sorter does not spill.
+    {
+        auto sorter = std::unique_ptr<IWSorter>(IWSorter::make(opts, IWComparator(ASC)));
+        for (int i = 9; i >= 0; --i) {
+            sorter->add(i, -i);
+        }
+        ASSERT_EQ(10U, reported.size());
+        ASSERT_EQ(0, sorter->numSpills());
+        ASSERT_ITERATORS_EQUIVALENT(std::shared_ptr<IWIterator>(sorter->done()),
+                                    std::make_shared<IntIterator>(0, 10));
+    }
+
+    reported.clear();
+    {
+        auto sorter = std::unique_ptr<IWSorter>(
+            IWSorter::make(SortOptions(opts).ExtSortAllowed(), IWComparator(ASC)));
+        for (int i = 9; i >= 0; --i) {
+            sorter->add(i, -i);
+        }
+        // Every third pair makes the sorter spill, after which it reports that it holds nothing.
+        ASSERT_EQ(3, sorter->numSpills());
+        ASSERT_EQ(3, std::count(reported.begin(), reported.end(), 0U));
+        ASSERT_ITERATORS_EQUIVALENT(std::shared_ptr<IWIterator>(sorter->done()),
+                                    std::make_shared<IntIterator>(0, 10));
+    }
+}
+
+TEST(SorterTest, ParallelSortIsStable) {
+    const auto originalMaxParallelism = gSorterMaxParallelism.load();
+    const auto originalMinBytes = gSorterParallelSortMinBytes.load();
+    ON_BLOCK_EXIT([&] {
+        gSorterMaxParallelism.store(originalMaxParallelism);
+        gSorterParallelSortMinBytes.store(originalMinBytes);
+    });
+    gSorterMaxParallelism.store(3);
+    gSorterParallelSortMinBytes.store(0);
+
+    // The values record the order in which the pairs were added, which pairs with equal keys must
+    // keep. The number of items is not a multiple of the number of threads.
+    const int kNumItems = 100 * 1000 + 1;
+    auto sorter = std::unique_ptr<IWSorter>(IWSorter::make(SortOptions(), IWComparator(ASC)));
+    for (int i = 0; i < kNumItems; ++i) {
+        sorter->add((i * 7919) % 100, i);
+    }
+
+    auto iter = std::unique_ptr<IWIterator>(sorter->done());
+    iter->openSource();
+    IWPair last(-1, -1);
+    for (int i = 0; i < kNumItems; ++i) {
+        ASSERT(iter->more());
+        auto next = iter->next();
+        ASSERT(next.first > last.first || (next.first == last.first && next.second > last.second))
+            << next.first << "/" << next.second << " after " << last.first << "/" << last.second;
+        last = next;
+    }
+    ASSERT_FALSE(iter->more());
+    iter->closeSource();
+}
+
 }  // namespace
 }  // namespace sorter
 }  // namespace mongo
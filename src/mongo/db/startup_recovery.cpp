@@ -34,6 +34,8 @@
 #include "startup_recovery.h"
 
 #include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/collection_catalog.h"
+#include "mongo/db/catalog/collection_lazy_init.h"
 #include "mongo/db/catalog/create_collection.h"
 #include "mongo/db/catalog/database.h"
 #include "mongo/db/catalog/database_holder.h"
@@ -53,12 +55,15 @@
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/repl_set_member_in_standalone_mode.h"
 #include "mongo/db/server_options.h"
+#include "mongo/db/storage/catalog_load_tasks.h"
 #include "mongo/db/storage/durable_catalog.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/db/storage/storage_repair_observer.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/exit.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/quick_exit.h"
+#include "mongo/util/timer.h"
 
 #if !defined(_WIN32)
 #include <sys/file.h>
@@ -240,6 +245,7 @@ Status ensureCollectionProperties(OperationContext* opCtx,
                   "Collection is missing an _id index",
                   logAttrs(*coll));
             if (EnsureIndexPolicy::kBuildMissing == ensureIndexPolicy) {
+                coll->initIfDeferred(opCtx);
                 auto status = buildMissingIdIndex(opCtx, coll);
                 if (!status.isOK()) {
                     LOGV2_ERROR(21021,
@@ -257,6 +263,57 @@ Status ensureCollectionProperties(OperationContext* opCtx,
     return Status::OK();
 }
 
+/**
+ * Initializes the collections of the given databases which are not yet initialized, and their
+ * index catalogs, from a pool of threads which each initialize one database at a time. Defers the
+ * initialization of the collections which are initialized lazily instead.
+ */
+void initializeCollections(OperationContext* opCtx, const std::vector<std::string>& dbNames) {
+    invariant(opCtx->lockState()->isW());
+    Timer timer;
+
+    auto catalog = CollectionCatalog::get(opCtx);
+    std::vector<std::vector<Collection*>> collectionsByDb;
+    size_t numCollections = 0;
+    size_t numDeferred = 0;
+    for (const auto& dbName : dbNames) {
+        std::vector<Collection*> collections;
+        for (const auto& uuid : catalog->getAllCollectionUUIDsFromDb(dbName)) {
+            auto collection = catalog->lookupCollectionByUUIDForMetadataWrite(
+                opCtx, CollectionCatalog::LifetimeMode::kInplace, uuid);
+            invariant(collection);
+            if (collection->isInitialized() || collection->isInitDeferred()) {
+                continue;
+            }
+            if (shouldDeferCollectionInit(opCtx, collection)) {
+                collection->deferInit(opCtx);
+                ++numDeferred;
+            } else {
+                collections.push_back(collection);
+            }
+        }
+        numCollections += collections.size();
+        collectionsByDb.push_back(std::move(collections));
+    }
+
+    runCatalogLoadTasks(opCtx,
+                        "CollectionInitializer",
+                        gCatalogLoadThreads.load(),
+                        collectionsByDb,
+                        [](OperationContext* taskOpCtx, std::vector<Collection*>& collections) {
+                            for (auto collection : collections) {
+                                collection->init(taskOpCtx);
+                            }
+                        });
+
+    LOGV2(5591702,
+          "Initialized collections",
+          "numCollections"_attr = numCollections,
+          "numDeferred"_attr = numDeferred,
+          "numDatabases"_attr = dbNames.size(),
+          "durationMillis"_attr = timer.millis());
+}
+
 /**
  * Opens each database and provides a callback on each one.
  */
@@ -266,6 +323,14 @@ void openDatabases(OperationContext* opCtx, const StorageEngine* storageEngine,
 
     auto databaseHolder = DatabaseHolder::get(opCtx);
     auto dbNames = storageEngine->listDatabases();
+
+    // Record stores are not opened for repair, so its collections are initialized as they are
+    // repaired.
+    if (!storageGlobalParams.repair) {
+        initializeCollections(opCtx, dbNames);
+    }
+
+    Timer timer;
     for (const auto& dbName : dbNames) {
         LOGV2_DEBUG(21010, 1, "    Opening database: {dbName}", "dbName"_attr = dbName);
         auto db = databaseHolder->openDb(opCtx, dbName);
@@ -273,6 +338,10 @@ void openDatabases(OperationContext* opCtx, const StorageEngine* storageEngine,
 
         onDatabase(db);
     }
+    LOGV2(5591703,
+          "Opened databases",
+          "numDatabases"_attr = dbNames.size(),
+          "durationMillis"_attr = timer.millis());
 }
 
 // Check for storage engine file compatibility. Exits the process if there is an incompatibility.
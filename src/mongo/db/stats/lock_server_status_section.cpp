@@ -33,6 +33,7 @@
 
 #include "mongo/db/client.h"
 #include "mongo/db/commands/server_status.h"
+#include "mongo/db/concurrency/hot_document_tracker.h"
 #include "mongo/db/concurrency/lock_stats.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/operation_context.h"
@@ -127,5 +128,35 @@ public:
 
 } lockStatsServerStatusSection;
 
+
+class WriteConflictsServerStatusSection : public ServerStatusSection {
+public:
+    WriteConflictsServerStatusSection() : ServerStatusSection("writeConflicts") {}
+
+    bool includeByDefault() const override {
+        // The namespaces and documents reported change too often for FTDC.
+        return false;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        // The number of documents reported can be chosen with {writeConflicts: {documents: N}}.
+        long long numDocuments = kDefaultNumDocuments;
+        if (configElement.type() == Object) {
+            if (auto documents = configElement.Obj()["documents"]; documents.isNumber()) {
+                numDocuments = std::max(documents.safeNumberLong(), 0LL);
+            }
+        }
+
+        BSONObjBuilder ret;
+        HotDocumentTracker::get().appendStats(&ret, static_cast<size_t>(numDocuments));
+        return ret.obj();
+    }
+
+private:
+    static constexpr long long kDefaultNumDocuments = 10;
+
+} writeConflictsServerStatusSection;
+
 }  // namespace
 }  // namespace mongo
@@ -32,6 +32,7 @@
 #include "mongo/db/stats/operation_latency_histogram.h"
 
 #include <algorithm>
+#include <cmath>
 
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/namespace_string.h"
@@ -92,6 +93,106 @@ const std::array<uint64_t, OperationLatencyHistogram::kMaxBuckets>
                                                549755813888,
                                                1099511627776};
 
+namespace {
+// The percentiles appended along with the histograms, and their field names.
+const std::array<std::pair<const char*, double>, 4> kReportedPercentiles = {
+    {{"p50", 0.5}, {"p90", 0.9}, {"p99", 0.99}, {"p999", 0.999}}};
+}  // namespace
+
+OperationLatencyHistogram::SubBucketCounts::SubBucketCounts(const SubBucketCounts& other) {
+    *this = other;
+}
+
+OperationLatencyHistogram::SubBucketCounts& OperationLatencyHistogram::SubBucketCounts::operator=(
+    const SubBucketCounts& other) {
+    if (this == &other) {
+        return *this;
+    }
+
+    _groups.clear();
+    _groups.reserve(other._groups.size());
+    for (auto&& group : other._groups) {
+        _groups.push_back(group ? std::make_unique<Group>(*group) : nullptr);
+    }
+    return *this;
+}
+
+void OperationLatencyHistogram::SubBucketCounts::increment(uint64_t latency) {
+    size_t groupIndex = 0;
+    size_t subBucket = latency;
+    if (latency >= kSubBucketCount) {
+        // The top kSubBucketBits bits below the highest set bit select the sub-bucket.
+        const int log2 = 63 - countLeadingZeros64(latency);
+        const int shift = log2 - kSubBucketBits;
+        groupIndex = shift + 1;
+        subBucket = (latency >> shift) & (kSubBucketCount - 1);
+    }
+
+    if (_groups.empty()) {
+        _groups.resize(kSubBucketGroups);
+    }
+    auto& group = _groups[groupIndex];
+    if (!group) {
+        group = std::make_unique<Group>();
+    }
+    (*group)[subBucket]++;
+}
+
+uint64_t OperationLatencyHistogram::SubBucketCounts::getValueAtRank(uint64_t rank) const {
+    uint64_t seen = 0;
+    for (size_t groupIndex = 0; groupIndex < _groups.size(); ++groupIndex) {
+        if (!_groups[groupIndex]) {
+            continue;
+        }
+
+        for (size_t subBucket = 0; subBucket < _groups[groupIndex]->size(); ++subBucket) {
+            seen += (*_groups[groupIndex])[subBucket];
+            if (seen < rank) {
+                continue;
+            }
+
+            if (groupIndex == 0) {
+                return subBucket;
+            }
+            const int shift = groupIndex - 1;
+            const uint64_t lowerBound = (kSubBucketCount + subBucket) << shift;
+            return lowerBound + ((1ULL << shift) >> 1);
+        }
+    }
+    return 0;
+}
+
+uint64_t OperationLatencyHistogram::_getPercentile(const HistogramData& data, double percentile) {
+    if (data.entryCount == 0) {
+        return 0;
+    }
+
+    const auto rank = std::max<uint64_t>(
+        1, std::min<uint64_t>(data.entryCount, std::ceil(percentile * data.entryCount)));
+    return data.subBuckets.getValueAtRank(rank);
+}
+
+const OperationLatencyHistogram::HistogramData& OperationLatencyHistogram::_getData(
+    Command::ReadWriteType type) const {
+    switch (type) {
+        case Command::ReadWriteType::kRead:
+            return _reads;
+        case Command::ReadWriteType::kWrite:
+            return _writes;
+        case Command::ReadWriteType::kCommand:
+            return _commands;
+        case Command::ReadWriteType::kTransaction:
+            return _transactions;
+        default:
+            MONGO_UNREACHABLE;
+    }
+}
+
+uint64_t OperationLatencyHistogram::getPercentile(Command::ReadWriteType type,
+                                                  double percentile) const {
+    return _getPercentile(_getData(type), percentile);
+}
+
 void OperationLatencyHistogram::_append(const HistogramData& data,
                                         const char* key,
                                         bool includeHistograms,
@@ -137,6 +238,15 @@ void OperationLatencyHistogram::_append(const HistogramData& data,
         }
 
         arrayBuilder.doneFast();
+
+        // Always report every percentile, even for an empty histogram, so that the shape of the
+        // output does not change as operations are recorded.
+        BSONObjBuilder percentilesBuilder(histogramBuilder.subobjStart("percentiles"));
+        for (auto&& [name, percentile] : kReportedPercentiles) {
+            percentilesBuilder.append(name,
+                                      static_cast<long long>(_getPercentile(data, percentile)));
+        }
+        percentilesBuilder.doneFast();
     }
 
     histogramBuilder.append("latency", static_cast<long long>(data.sum));
@@ -182,6 +292,7 @@ int OperationLatencyHistogram::_getBucket(uint64_t value) {
 
 void OperationLatencyHistogram::_incrementData(uint64_t latency, int bucket, HistogramData* data) {
     data->buckets[bucket]++;
+    data->subBuckets.increment(latency);
     data->entryCount++;
     data->sum += latency;
 }
@@ -29,6 +29,8 @@
 #pragma once
 
 #include <array>
+#include <memory>
+#include <vector>
 
 #include "mongo/db/commands.h"
 
@@ -40,6 +42,11 @@ class BSONObjBuilder;
  * Stores statistics for latencies of read, write, command, and multi-document transaction
  * operations.
  *
+ * Besides the coarse histogram reported to users, each latency is also counted in a log-linear
+ * histogram: values below 2^kSubBucketBits microseconds are counted exactly, and every power of two
+ * above that is split into 2^kSubBucketBits equal buckets. The percentiles derived from it are
+ * within 2^-(kSubBucketBits + 1) of the recorded latencies.
+ *
  * Note: This class is not thread-safe.
  */
 class OperationLatencyHistogram {
@@ -49,6 +56,13 @@ public:
     // Inclusive lower bounds of the histogram buckets.
     static const std::array<uint64_t, kMaxBuckets> kLowerBounds;
 
+    static constexpr int kSubBucketBits = 6;
+    static constexpr int kSubBucketCount = 1 << kSubBucketBits;
+
+    // One group of sub-buckets for the values below 2^kSubBucketBits, and one for each power of two
+    // from there up to 2^64.
+    static constexpr int kSubBucketGroups = 64 - kSubBucketBits + 1;
+
     /**
      * Increments the bucket of the histogram based on the operation type.
      */
@@ -59,13 +73,49 @@ public:
      */
     void append(bool includeHistograms, bool slowMSBucketsOnly, BSONObjBuilder* builder) const;
 
+    /**
+     * Returns the latency which 'percentile' (in [0, 1]) of the recorded operations of the given
+     * type did not exceed, or 0 if none were recorded.
+     */
+    uint64_t getPercentile(Command::ReadWriteType type, double percentile) const;
+
 private:
+    /**
+     * Counts of latencies in the log-linear buckets. Groups of sub-buckets are only allocated once
+     * one of their sub-buckets is incremented, so that histograms which see a narrow range of
+     * latencies stay small.
+     */
+    class SubBucketCounts {
+    public:
+        SubBucketCounts() = default;
+        SubBucketCounts(const SubBucketCounts& other);
+        SubBucketCounts& operator=(const SubBucketCounts& other);
+
+        void increment(uint64_t latency);
+
+        /**
+         * Returns the midpoint of the sub-bucket holding the 'rank'-th smallest latency, counting
+         * from 1.
+         */
+        uint64_t getValueAtRank(uint64_t rank) const;
+
+    private:
+        using Group = std::array<uint64_t, kSubBucketCount>;
+
+        std::vector<std::unique_ptr<Group>> _groups;
+    };
+
     struct HistogramData {
         std::array<uint64_t, kMaxBuckets> buckets{};
         uint64_t entryCount = 0;
         uint64_t sum = 0;
+        SubBucketCounts subBuckets;
     };
 
+    static uint64_t _getPercentile(const HistogramData& data, double percentile);
+
+    const HistogramData& _getData(Command::ReadWriteType type) const;
+
     static int _getBucket(uint64_t latency);
 
     static uint64_t _getBucketMicros(int bucket);
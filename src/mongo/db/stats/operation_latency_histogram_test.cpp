@@ -31,7 +31,9 @@
 
 #include "mongo/db/stats/operation_latency_histogram.h"
 
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <iostream>
 #include <numeric>
 #include <vector>
@@ -134,4 +136,61 @@ TEST(OperationLatencyHistogram, CheckBucketCountsAndTotalLatencySlowBuckets) {
         ASSERT_EQUALS(bucket["count"].Long(), 83);
     }
 }
+TEST(OperationLatencyHistogram, PercentilesOfEmptyHistogramAreZero) {
+    OperationLatencyHistogram hist;
+    ASSERT_EQUALS(hist.getPercentile(Command::ReadWriteType::kRead, 0.99), 0U);
+
+    BSONObjBuilder outBuilder;
+    hist.append(true, false, &outBuilder);
+    BSONObj out = outBuilder.done();
+    ASSERT_BSONOBJ_EQ(out["reads"]["percentiles"].Obj(),
+                      BSON("p50" << 0LL << "p90" << 0LL << "p99" << 0LL << "p999" << 0LL));
+}
+
+TEST(OperationLatencyHistogram, PercentilesOfSmallLatenciesAreExact) {
+    OperationLatencyHistogram hist;
+    for (uint64_t latency = 1; latency <= 50; latency++) {
+        hist.increment(latency, Command::ReadWriteType::kWrite);
+    }
+    ASSERT_EQUALS(hist.getPercentile(Command::ReadWriteType::kWrite, 0.5), 25U);
+    ASSERT_EQUALS(hist.getPercentile(Command::ReadWriteType::kWrite, 0.9), 45U);
+    ASSERT_EQUALS(hist.getPercentile(Command::ReadWriteType::kWrite, 1), 50U);
+    ASSERT_EQUALS(hist.getPercentile(Command::ReadWriteType::kWrite, 0), 1U);
+    ASSERT_EQUALS(hist.getPercentile(Command::ReadWriteType::kRead, 0.5), 0U);
+}
+
+TEST(OperationLatencyHistogram, PercentilesStayWithinRelativeErrorBound) {
+    OperationLatencyHistogram hist;
+    std::vector<uint64_t> latencies;
+    uint64_t latency = 1;
+    for (int i = 0; i < 10000; i++) {
+        latencies.push_back(latency);
+        hist.increment(latency, Command::ReadWriteType::kCommand);
+        // Spread the latencies over many powers of two.
+        latency = (latency * 1103 + 7919) % 100000000;
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    const double maxRelativeError = 1.0 / (2 << OperationLatencyHistogram::kSubBucketBits);
+    for (double percentile : {0.01, 0.25, 0.5, 0.75, 0.9, 0.99, 0.999, 1.0}) {
+        const auto expected = latencies[std::ceil(percentile * latencies.size()) - 1];
+        const auto actual = hist.getPercentile(Command::ReadWriteType::kCommand, percentile);
+        ASSERT_LTE(std::abs(static_cast<double>(actual) - static_cast<double>(expected)),
+                   maxRelativeError * expected)
+            << "percentile: " << percentile << ", expected: " << expected
+            << ", actual: " << actual;
+    }
+}
+
+TEST(OperationLatencyHistogram, CopiesHaveIndependentPercentiles) {
+    OperationLatencyHistogram hist;
+    hist.increment(1000, Command::ReadWriteType::kRead);
+
+    OperationLatencyHistogram copy = hist;
+    copy.increment(5000, Command::ReadWriteType::kRead);
+    copy.increment(5000, Command::ReadWriteType::kRead);
+
+    ASSERT_EQUALS(hist.getPercentile(Command::ReadWriteType::kRead, 1), 1004U);
+    ASSERT_EQUALS(copy.getPercentile(Command::ReadWriteType::kRead, 0.5), 5024U);
+}
 }  // namespace mongo
@@ -0,0 +1,151 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/query_shape_stats.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/service_context.h"
+#include "mongo/platform/bits.h"
+#include "mongo/util/hex.h"
+
+namespace mongo {
+namespace {
+const auto getQueryShapeStatsStore = ServiceContext::declareDecoration<QueryShapeStatsStore>();
+
+size_t getLatencyBucket(Microseconds latency) {
+    const auto micros = durationCount<Microseconds>(latency);
+    if (micros <= 1) {
+        return 0;
+    }
+    return std::min(static_cast<size_t>(63 - countLeadingZeros64(micros)),
+                    QueryShapeStatsStore::kNumLatencyBuckets - 1);
+}
+}  // namespace
+
+QueryShapeStatsStore& QueryShapeStatsStore::get(ServiceContext* svcCtx) {
+    return getQueryShapeStatsStore(svcCtx);
+}
+
+QueryShapeStatsStore& QueryShapeStatsStore::get(OperationContext* opCtx) {
+    return getQueryShapeStatsStore(opCtx->getServiceContext());
+}
+
+std::shared_ptr<QueryShapeStatsStore::Entry> QueryShapeStatsStore::_getOrCreateEntry(Key key) {
+    const size_t maxEntries = internalQueryShapeStatsMaxEntries.load();
+    if (maxEntries == 0) {
+        return nullptr;
+    }
+
+    auto& partition = _partitions[absl::Hash<Key>{}(key) % kNumPartitions];
+    const size_t maxPartitionEntries = std::max(maxEntries / kNumPartitions, size_t{1});
+
+    stdx::lock_guard<Latch> lk(partition.mutex);
+    if (auto it = partition.entries.find(key); it != partition.entries.end()) {
+        return it->second;
+    }
+
+    if (partition.entries.size() >= maxPartitionEntries) {
+        _numDroppedOperations.fetchAndAdd(1);
+        return nullptr;
+    }
+
+    auto entry = std::make_shared<Entry>();
+    partition.entries.emplace(std::move(key), entry);
+    return entry;
+}
+
+void QueryShapeStatsStore::record(const NamespaceString& nss,
+                                  uint32_t queryHash,
+                                  const OperationStats& stats) {
+    auto entry = _getOrCreateEntry({nss.ns(), queryHash});
+    if (!entry) {
+        return;
+    }
+
+    entry->count.fetchAndAdd(1);
+    entry->totalLatencyMicros.fetchAndAdd(durationCount<Microseconds>(stats.latency));
+    entry->keysExamined.fetchAndAdd(stats.keysExamined);
+    entry->docsExamined.fetchAndAdd(stats.docsExamined);
+    entry->nreturned.fetchAndAdd(stats.nreturned);
+    entry->bytesReturned.fetchAndAdd(stats.bytesReturned);
+    entry->latencyBuckets[getLatencyBucket(stats.latency)].fetchAndAdd(1);
+}
+
+std::vector<BSONObj> QueryShapeStatsStore::getStats(const NamespaceString& nss) const {
+    std::vector<std::pair<uint32_t, std::shared_ptr<Entry>>> entries;
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        for (auto&& [key, entry] : partition.entries) {
+            if (key.first == nss.ns()) {
+                entries.emplace_back(key.second, entry);
+            }
+        }
+    }
+
+    std::vector<BSONObj> results;
+    results.reserve(entries.size());
+    for (auto&& [queryHash, entry] : entries) {
+        BSONObjBuilder bob;
+        bob.append("ns", nss.ns());
+        bob.append("queryHash", zeroPaddedHex(queryHash));
+        bob.append("count", entry->count.load());
+        {
+            BSONObjBuilder latencyBuilder(bob.subobjStart("latency"));
+            latencyBuilder.append("totalMicros", entry->totalLatencyMicros.load());
+
+            // Only the non-empty buckets are reported, each with its inclusive lower bound.
+            BSONArrayBuilder histogramBuilder(latencyBuilder.subarrayStart("histogram"));
+            for (size_t i = 0; i < kNumLatencyBuckets; ++i) {
+                if (auto count = entry->latencyBuckets[i].load()) {
+                    histogramBuilder.append(BSON("micros" << (i == 0 ? 0LL : 1LL << i) << "count"
+                                                          << count));
+                }
+            }
+        }
+        bob.append("keysExamined", entry->keysExamined.load());
+        bob.append("docsExamined", entry->docsExamined.load());
+        bob.append("nreturned", entry->nreturned.load());
+        bob.append("bytesReturned", entry->bytesReturned.load());
+        results.push_back(bob.obj());
+    }
+    return results;
+}
+
+void QueryShapeStatsStore::clear() {
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        partition.entries.clear();
+    }
+}
+
+}  // namespace mongo
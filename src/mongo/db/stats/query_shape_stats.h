@@ -0,0 +1,133 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/duration.h"
+
+namespace mongo {
+
+class OperationContext;
+class ServiceContext;
+
+/**
+ * Aggregates the latency and resource usage of completed operations per collection and query
+ * shape, where the shape is identified by the 'queryHash' of the operation.
+ *
+ * The store is split into a fixed number of independently locked partitions. Recording an
+ * operation only locks its partition for the duration of the lookup; the statistics themselves
+ * are updated with atomic increments. The number of shapes is bounded by
+ * 'internalQueryShapeStatsMaxEntries'. Once a partition is full, operations of shapes it does not
+ * hold yet are not recorded, and are only counted as dropped.
+ */
+class QueryShapeStatsStore {
+public:
+    static constexpr size_t kNumPartitions = 16;
+
+    // Bucket 'i' of the latency histogram counts the operations which took [2^i, 2^(i+1))
+    // microseconds. The first bucket also counts operations which took no time at all, and the last
+    // one counts all operations longer than its lower bound.
+    static constexpr size_t kNumLatencyBuckets = 32;
+
+    /**
+     * The statistics of a single completed operation.
+     */
+    struct OperationStats {
+        Microseconds latency{0};
+        long long keysExamined = 0;
+        long long docsExamined = 0;
+        long long nreturned = 0;
+        long long bytesReturned = 0;
+    };
+
+    static QueryShapeStatsStore& get(ServiceContext* svcCtx);
+    static QueryShapeStatsStore& get(OperationContext* opCtx);
+
+    /**
+     * Adds the statistics of an operation of the shape 'queryHash' on 'nss' to the store.
+     */
+    void record(const NamespaceString& nss, uint32_t queryHash, const OperationStats& stats);
+
+    /**
+     * Returns one document per query shape recorded for 'nss'.
+     */
+    std::vector<BSONObj> getStats(const NamespaceString& nss) const;
+
+    /**
+     * Removes all query shapes from the store.
+     */
+    void clear();
+
+    /**
+     * Returns the number of operations which were not recorded because the store was full.
+     */
+    long long getNumDroppedOperations() const {
+        return _numDroppedOperations.load();
+    }
+
+private:
+    struct Entry {
+        AtomicWord<long long> count;
+        AtomicWord<long long> totalLatencyMicros;
+        AtomicWord<long long> keysExamined;
+        AtomicWord<long long> docsExamined;
+        AtomicWord<long long> nreturned;
+        AtomicWord<long long> bytesReturned;
+        std::array<AtomicWord<long long>, kNumLatencyBuckets> latencyBuckets;
+    };
+
+    using Key = std::pair<std::string, uint32_t>;
+
+    struct Partition {
+        mutable Mutex mutex = MONGO_MAKE_LATCH("QueryShapeStatsStore::Partition::mutex");
+
+        // Entries are shared so that they can be updated without holding 'mutex', even if the
+        // store is cleared concurrently.
+        stdx::unordered_map<Key, std::shared_ptr<Entry>> entries;
+    };
+
+    std::shared_ptr<Entry> _getOrCreateEntry(Key key);
+
+    std::array<Partition, kNumPartitions> _partitions;
+
+    AtomicWord<long long> _numDroppedOperations;
+};
+
+}  // namespace mongo
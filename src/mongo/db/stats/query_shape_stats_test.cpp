@@ -0,0 +1,124 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/query_shape_stats.h"
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+
+QueryShapeStatsStore::OperationStats makeStats(long long latencyMicros, long long nreturned) {
+    QueryShapeStatsStore::OperationStats stats;
+    stats.latency = Microseconds(latencyMicros);
+    stats.keysExamined = 2 * nreturned;
+    stats.docsExamined = nreturned;
+    stats.nreturned = nreturned;
+    stats.bytesReturned = 100 * nreturned;
+    return stats;
+}
+
+TEST(QueryShapeStatsStoreTest, AggregatesOperationsOfTheSameShape) {
+    QueryShapeStatsStore store;
+    const NamespaceString nss("test.coll");
+    store.record(nss, 0x1234, makeStats(3, 1));
+    store.record(nss, 0x1234, makeStats(5, 2));
+    store.record(nss, 0x1234, makeStats(2000, 3));
+
+    auto stats = store.getStats(nss);
+    ASSERT_EQ(stats.size(), 1U);
+    ASSERT_BSONOBJ_EQ(stats[0],
+                      BSON("ns"
+                           << "test.coll"
+                           << "queryHash"
+                           << "00001234"
+                           << "count" << 3LL << "latency"
+                           << BSON("totalMicros"
+                                   << 2008LL << "histogram"
+                                   << BSON_ARRAY(BSON("micros" << 2LL << "count" << 1LL)
+                                                 << BSON("micros" << 4LL << "count" << 1LL)
+                                                 << BSON("micros" << 1024LL << "count" << 1LL)))
+                           << "keysExamined" << 12LL << "docsExamined" << 6LL << "nreturned"
+                           << 6LL << "bytesReturned" << 600LL));
+}
+
+TEST(QueryShapeStatsStoreTest, SeparatesShapesAndNamespaces) {
+    QueryShapeStatsStore store;
+    const NamespaceString nss("test.coll");
+    const NamespaceString otherNss("test.other");
+    store.record(nss, 1, makeStats(1, 1));
+    store.record(nss, 2, makeStats(1, 1));
+    store.record(otherNss, 1, makeStats(1, 1));
+
+    ASSERT_EQ(store.getStats(nss).size(), 2U);
+    ASSERT_EQ(store.getStats(otherNss).size(), 1U);
+
+    store.clear();
+    ASSERT_EQ(store.getStats(nss).size(), 0U);
+    ASSERT_EQ(store.getStats(otherNss).size(), 0U);
+}
+
+TEST(QueryShapeStatsStoreTest, DropsOperationsOfNewShapesOnceFull) {
+    const auto oldMaxEntries = internalQueryShapeStatsMaxEntries.load();
+    internalQueryShapeStatsMaxEntries.store(QueryShapeStatsStore::kNumPartitions);
+    ON_BLOCK_EXIT([&] { internalQueryShapeStatsMaxEntries.store(oldMaxEntries); });
+
+    // Each partition holds a single shape, so the store can never hold more shapes than it has
+    // partitions.
+    QueryShapeStatsStore store;
+    const NamespaceString nss("test.coll");
+    const uint32_t kNumShapes = 100;
+    for (uint32_t queryHash = 0; queryHash < kNumShapes; ++queryHash) {
+        store.record(nss, queryHash, makeStats(1, 1));
+    }
+
+    const auto numShapes = store.getStats(nss).size();
+    ASSERT_LTE(numShapes, QueryShapeStatsStore::kNumPartitions);
+    ASSERT_EQ(store.getNumDroppedOperations(), static_cast<long long>(kNumShapes - numShapes));
+}
+
+TEST(QueryShapeStatsStoreTest, RecordsNothingWhenDisabled) {
+    const auto oldMaxEntries = internalQueryShapeStatsMaxEntries.load();
+    internalQueryShapeStatsMaxEntries.store(0);
+    ON_BLOCK_EXIT([&] { internalQueryShapeStatsMaxEntries.store(oldMaxEntries); });
+
+    QueryShapeStatsStore store;
+    const NamespaceString nss("test.coll");
+    store.record(nss, 1, makeStats(1, 1));
+    ASSERT_EQ(store.getStats(nss).size(), 0U);
+    ASSERT_EQ(store.getNumDroppedOperations(), 0);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -52,6 +52,7 @@ static const char kDocBytesWritten[] = "docBytesWritten";
 static const char kDocUnitsRead[] = "docUnitsRead";
 static const char kDocUnitsReturned[] = "docUnitsReturned";
 static const char kDocUnitsWritten[] = "docUnitsWritten";
+static const char kHardwareCounters[] = "hardwareCounters";
 static const char kIdxEntryBytesRead[] = "idxEntryBytesRead";
 static const char kIdxEntryBytesWritten[] = "idxEntryBytesWritten";
 static const char kIdxEntryUnitsRead[] = "idxEntryUnitsRead";
@@ -174,6 +175,10 @@ void ResourceConsumption::OperationMetrics::toBson(BSONObjBuilder* builder) cons
     if (cpuTimer) {
         builder->appendNumber(kCpuNanos, durationCount<Nanoseconds>(cpuTimer->getElapsed()));
     }
+    if (hardwareCounters) {
+        BSONObjBuilder countersBuilder = builder->subobjStart(kHardwareCounters);
+        hardwareCounters->getCounts().appendNonZero(&countersBuilder);
+    }
 }
 
 void ResourceConsumption::OperationMetrics::toBsonNonZeroFields(BSONObjBuilder* builder) const {
@@ -193,6 +198,14 @@ void ResourceConsumption::OperationMetrics::toBsonNonZeroFields(BSONObjBuilder*
     appendNonZeroMetric(builder, kDocUnitsWritten, writeMetrics.docsWritten.units());
     appendNonZeroMetric(builder, kIdxEntryBytesWritten, writeMetrics.idxEntriesWritten.bytes());
     appendNonZeroMetric(builder, kIdxEntryUnitsWritten, writeMetrics.idxEntriesWritten.units());
+
+    if (hardwareCounters) {
+        BSONObjBuilder countersBuilder;
+        hardwareCounters->getCounts().appendNonZero(&countersBuilder);
+        if (auto counts = countersBuilder.obj(); !counts.isEmpty()) {
+            builder->append(kHardwareCounters, counts);
+        }
+    }
 }
 
 template <typename Func>
@@ -244,6 +257,17 @@ void ResourceConsumption::MetricsCollector::beginScopedCollecting(OperationConte
     if (_metrics.cpuTimer) {
         _metrics.cpuTimer->start();
     }
+
+    // Reading the hardware counters costs a system call, so only a sample of the operations count
+    // their hardware events. The counters may be nullptr on unsupported systems.
+    _metrics.hardwareCounters = nullptr;
+    const double sampleRate = gHardwareCountersSampleRate.load();
+    if (sampleRate > 0 && opCtx->getClient()->getPrng().nextCanonicalDouble() < sampleRate) {
+        _metrics.hardwareCounters = OperationHardwareCounters::get(opCtx);
+        if (_metrics.hardwareCounters) {
+            _metrics.hardwareCounters->start();
+        }
+    }
 }
 
 bool ResourceConsumption::MetricsCollector::endScopedCollecting() {
@@ -251,6 +275,9 @@ bool ResourceConsumption::MetricsCollector::endScopedCollecting() {
     if (wasCollecting && _metrics.cpuTimer) {
         _metrics.cpuTimer->stop();
     }
+    if (wasCollecting && _metrics.hardwareCounters) {
+        _metrics.hardwareCounters->stop();
+    }
     _collecting = ScopedCollectionState::kInactive;
     return wasCollecting;
 }
@@ -36,6 +36,7 @@
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/operation_cpu_timer.h"
+#include "mongo/db/operation_hardware_counters.h"
 #include "mongo/platform/mutex.h"
 
 namespace mongo {
@@ -199,6 +200,9 @@ public:
 
         // Records CPU time consumed by this operation.
         OperationCPUTimer* cpuTimer = nullptr;
+
+        // Counts the hardware events caused by this operation, if it was sampled for them.
+        OperationHardwareCounters* hardwareCounters = nullptr;
     };
 
     /**
@@ -0,0 +1,116 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/slow_query_sampler.h"
+
+#include "mongo/db/operation_context.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/service_context.h"
+
+namespace mongo {
+namespace {
+const auto getSlowQuerySampler = ServiceContext::declareDecoration<SlowQuerySampler>();
+
+constexpr Minutes kWindowLength{1};
+}  // namespace
+
+SlowQuerySampler& SlowQuerySampler::get(ServiceContext* svcCtx) {
+    return getSlowQuerySampler(svcCtx);
+}
+
+SlowQuerySampler& SlowQuerySampler::get(OperationContext* opCtx) {
+    return getSlowQuerySampler(opCtx->getServiceContext());
+}
+
+bool SlowQuerySampler::shouldSample(const NamespaceString& nss, uint32_t queryHash, Date_t now) {
+    const int samplesPerShape = internalQuerySlowQuerySamplesPerShapePerMinute.load();
+    if (samplesPerShape == 0) {
+        return false;
+    }
+
+    stdx::unique_lock<Latch> lk(_mutex, stdx::try_to_lock);
+    if (!lk.owns_lock()) {
+        return false;
+    }
+
+    if (now - _windowStart >= kWindowLength) {
+        _windowStart = now;
+        _samplesInWindow.clear();
+    }
+
+    auto it = _samplesInWindow.find({nss.ns(), queryHash});
+    if (it == _samplesInWindow.end()) {
+        if (_samplesInWindow.size() >= kMaxShapesPerWindow) {
+            return false;
+        }
+        it = _samplesInWindow.emplace(Key{nss.ns(), queryHash}, 0).first;
+    }
+
+    if (it->second >= samplesPerShape) {
+        return false;
+    }
+    ++it->second;
+    return true;
+}
+
+void SlowQuerySampler::record(BSONObj sample) {
+    const size_t maxBytes = internalQuerySlowQuerySampleBufferBytes.load();
+    const size_t sampleBytes = sample.objsize();
+    if (sampleBytes > maxBytes) {
+        _numDroppedSamples.fetchAndAdd(1);
+        return;
+    }
+
+    stdx::unique_lock<Latch> lk(_mutex, stdx::try_to_lock);
+    if (!lk.owns_lock()) {
+        _numDroppedSamples.fetchAndAdd(1);
+        return;
+    }
+
+    while (!_samples.empty() && _samplesBytes + sampleBytes > maxBytes) {
+        _samplesBytes -= _samples.front().objsize();
+        _samples.pop_front();
+    }
+    _samplesBytes += sampleBytes;
+    _samples.push_back(sample.getOwned());
+}
+
+std::vector<BSONObj> SlowQuerySampler::getSamples() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return {_samples.begin(), _samples.end()};
+}
+
+void SlowQuerySampler::clear() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _samples.clear();
+    _samplesBytes = 0;
+}
+
+}  // namespace mongo
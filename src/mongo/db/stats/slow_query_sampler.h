@@ -0,0 +1,111 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+
+#pragma once
+
+#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class OperationContext;
+class ServiceContext;
+
+/**
+ * Keeps a bounded, in-memory history of slow operations with their full execution statistics, for
+ * $slowQuerySamples.
+ *
+ * Only a limited number of slow operations of each query shape are sampled per minute, as set by
+ * 'internalQuerySlowQuerySamplesPerShapePerMinute'. The samples are kept in a ring buffer whose
+ * total size is bounded by 'internalQuerySlowQuerySampleBufferBytes', evicting the oldest samples
+ * first. Sampling never blocks the operation: if the sampler is busy, the operation is not
+ * sampled, or its sample is dropped.
+ */
+class SlowQuerySampler {
+public:
+    // The number of query shapes which may be sampled in each minute.
+    static constexpr size_t kMaxShapesPerWindow = 10000;
+
+    static SlowQuerySampler& get(ServiceContext* svcCtx);
+    static SlowQuerySampler& get(OperationContext* opCtx);
+
+    /**
+     * Returns true if a slow operation of the shape 'queryHash' on 'nss' should be sampled, in
+     * which case it counts against the samples of the shape for the minute which includes 'now'.
+     */
+    bool shouldSample(const NamespaceString& nss, uint32_t queryHash, Date_t now);
+
+    /**
+     * Adds 'sample' to the buffer, evicting the oldest samples as needed to stay within its size.
+     */
+    void record(BSONObj sample);
+
+    /**
+     * Returns the samples in the buffer, from the oldest to the newest.
+     */
+    std::vector<BSONObj> getSamples() const;
+
+    /**
+     * Removes all samples from the buffer.
+     */
+    void clear();
+
+    /**
+     * Returns the number of samples which were dropped because the buffer was busy, or because
+     * they were larger than the whole buffer.
+     */
+    long long getNumDroppedSamples() const {
+        return _numDroppedSamples.load();
+    }
+
+private:
+    using Key = std::pair<std::string, uint32_t>;
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("SlowQuerySampler::_mutex");
+
+    // The start of the current one minute sampling window, and the number of operations of each
+    // shape sampled in it.
+    Date_t _windowStart;
+    stdx::unordered_map<Key, int> _samplesInWindow;
+
+    std::deque<BSONObj> _samples;
+    size_t _samplesBytes = 0;
+
+    AtomicWord<long long> _numDroppedSamples;
+};
+
+}  // namespace mongo
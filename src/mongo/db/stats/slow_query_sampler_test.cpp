@@ -0,0 +1,106 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/slow_query_sampler.h"
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+class SlowQuerySamplerTest : public unittest::Test {
+protected:
+    void setUp() final {
+        _oldSamplesPerShape = internalQuerySlowQuerySamplesPerShapePerMinute.load();
+        _oldBufferBytes = internalQuerySlowQuerySampleBufferBytes.load();
+        internalQuerySlowQuerySamplesPerShapePerMinute.store(2);
+    }
+
+    void tearDown() final {
+        internalQuerySlowQuerySamplesPerShapePerMinute.store(_oldSamplesPerShape);
+        internalQuerySlowQuerySampleBufferBytes.store(_oldBufferBytes);
+    }
+
+    const NamespaceString nss{"test.coll"};
+    const Date_t start = Date_t::fromMillisSinceEpoch(1000 * 1000);
+    SlowQuerySampler sampler;
+
+private:
+    int _oldSamplesPerShape;
+    int _oldBufferBytes;
+};
+
+TEST_F(SlowQuerySamplerTest, LimitsSamplesPerShapePerMinute) {
+    ASSERT_TRUE(sampler.shouldSample(nss, 1, start));
+    ASSERT_TRUE(sampler.shouldSample(nss, 1, start + Seconds(10)));
+    ASSERT_FALSE(sampler.shouldSample(nss, 1, start + Seconds(20)));
+
+    // Other shapes, and the same shape on another collection, have samples of their own.
+    ASSERT_TRUE(sampler.shouldSample(nss, 2, start + Seconds(20)));
+    ASSERT_TRUE(sampler.shouldSample(NamespaceString("test.other"), 1, start + Seconds(20)));
+
+    // The samples of the shape are replenished once the minute is over.
+    ASSERT_TRUE(sampler.shouldSample(nss, 1, start + Minutes(1)));
+}
+
+TEST_F(SlowQuerySamplerTest, SamplesNothingWhenDisabled) {
+    internalQuerySlowQuerySamplesPerShapePerMinute.store(0);
+    ASSERT_FALSE(sampler.shouldSample(nss, 1, start));
+}
+
+TEST_F(SlowQuerySamplerTest, EvictsOldestSamplesWhenFull) {
+    const auto sampleBytes = BSON("i" << 0).objsize();
+    internalQuerySlowQuerySampleBufferBytes.store(3 * sampleBytes);
+
+    for (int i = 0; i < 5; ++i) {
+        sampler.record(BSON("i" << i));
+    }
+
+    auto samples = sampler.getSamples();
+    ASSERT_EQ(samples.size(), 3U);
+    ASSERT_BSONOBJ_EQ(samples[0], BSON("i" << 2));
+    ASSERT_BSONOBJ_EQ(samples[2], BSON("i" << 4));
+    ASSERT_EQ(sampler.getNumDroppedSamples(), 0);
+
+    sampler.clear();
+    ASSERT_EQ(sampler.getSamples().size(), 0U);
+}
+
+TEST_F(SlowQuerySamplerTest, DropsSamplesLargerThanTheBuffer) {
+    internalQuerySlowQuerySampleBufferBytes.store(8);
+    sampler.record(BSON("a" << std::string(100, 'x')));
+    ASSERT_EQ(sampler.getSamples().size(), 0U);
+    ASSERT_EQ(sampler.getNumDroppedSamples(), 1);
+}
+
+}  // namespace
+}  // namespace mongo
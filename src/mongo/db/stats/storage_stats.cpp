@@ -188,4 +188,40 @@ Status appendCollectionRecordCount(OperationContext* opCtx,
 
     return Status::OK();
 }
+
+Status appendCollectionIOStats(OperationContext* opCtx,
+                               const NamespaceString& nss,
+                               BSONObjBuilder* result) {
+    AutoGetCollectionForReadCommand collection(opCtx, nss);
+    if (!collection.getDb()) {
+        return {ErrorCodes::NamespaceNotFound,
+                str::stream() << "Database [" << nss.db().toString() << "] not found."};
+    }
+
+    if (!collection) {
+        return {ErrorCodes::NamespaceNotFound,
+                str::stream() << "Collection [" << nss.toString() << "] not found."};
+    }
+
+    BSONObjBuilder ioStats(result->subobjStart("ioStats"));
+    {
+        BSONObjBuilder bob;
+        if (collection->getRecordStore()->appendIOStats(opCtx, &bob)) {
+            ioStats.append("collection", bob.obj());
+        }
+    }
+
+    BSONObjBuilder indexes(ioStats.subobjStart("indexes"));
+    std::unique_ptr<IndexCatalog::IndexIterator> it =
+        collection->getIndexCatalog()->getIndexIterator(opCtx, /*includeUnfinishedIndexes=*/true);
+    while (it->more()) {
+        const IndexCatalogEntry* entry = it->next();
+        BSONObjBuilder bob;
+        if (entry->accessMethod()->appendIOStats(opCtx, &bob)) {
+            indexes.append(entry->descriptor()->indexName(), bob.obj());
+        }
+    }
+
+    return Status::OK();
+}
 }  // namespace mongo
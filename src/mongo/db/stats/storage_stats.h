@@ -60,4 +60,12 @@ Status appendCollectionRecordCount(OperationContext* opCtx,
                                    const NamespaceString& nss,
                                    BSONObjBuilder* builder);
 
+/**
+ * Appends to 'builder' the cache and disk I/O statistics of the collection represented by 'nss'
+ * and of each of its indexes, as an "ioStats" document.
+ */
+Status appendCollectionIOStats(OperationContext* opCtx,
+                               const NamespaceString& nss,
+                               BSONObjBuilder* builder);
+
 };  // namespace mongo
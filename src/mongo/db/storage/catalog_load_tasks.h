@@ -0,0 +1,104 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <exception>
+#include <string>
+#include <vector>
+
+#include "mongo/db/client.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+
+/**
+ * Runs task(opCtx, item) on every element of 'items', from up to 'numThreads' threads which each
+ * have their own Client and OperationContext. With a single thread the tasks run on the calling
+ * thread, with 'opCtx'. Once every thread is done, rethrows the first exception a task threw;
+ * a thread stops taking tasks after one of its tasks throws.
+ *
+ * The tasks run while the caller holds the global lock exclusively, so they must not acquire
+ * locks of their own.
+ */
+template <typename Item, typename Task>
+void runCatalogLoadTasks(OperationContext* opCtx,
+                         StringData threadName,
+                         size_t numThreads,
+                         std::vector<Item>& items,
+                         const Task& task) {
+    numThreads = std::min(numThreads, items.size());
+    if (numThreads <= 1) {
+        for (auto&& item : items) {
+            task(opCtx, item);
+        }
+        return;
+    }
+
+    AtomicWord<size_t> nextItem{0};
+    auto mutex = MONGO_MAKE_LATCH("runCatalogLoadTasks::mutex");
+    std::exception_ptr firstException;
+
+    std::vector<stdx::thread> threads;
+    threads.reserve(numThreads);
+    for (size_t i = 0; i < numThreads; ++i) {
+        threads.emplace_back([&, i] {
+            ThreadClient tc(std::string(str::stream() << threadName << "-" << i),
+                            opCtx->getServiceContext());
+            auto taskOpCtx = tc->makeOperationContext();
+            for (auto index = nextItem.fetchAndAdd(1); index < items.size();
+                 index = nextItem.fetchAndAdd(1)) {
+                try {
+                    task(taskOpCtx.get(), items[index]);
+                    taskOpCtx->recoveryUnit()->abandonSnapshot();
+                } catch (...) {
+                    stdx::lock_guard<Latch> lk(mutex);
+                    if (!firstException) {
+                        firstException = std::current_exception();
+                    }
+                    return;
+                }
+            }
+        });
+    }
+
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+    if (firstException) {
+        std::rethrow_exception(firstException);
+    }
+}
+
+}  // namespace mongo
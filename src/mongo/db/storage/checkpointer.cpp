@@ -33,10 +33,13 @@
 
 #include "mongo/db/storage/checkpointer.h"
 
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/kv/kv_engine.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/logv2/log.h"
+#include "mongo/platform/bits.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
 #include "mongo/util/fail_point.h"
 
@@ -48,6 +51,32 @@ const auto getCheckpointer = ServiceContext::declareDecoration<std::unique_ptr<C
 
 MONGO_FAIL_POINT_DEFINE(pauseCheckpointThread);
 
+// How often the checkpoint thread samples the dirty cache ratio when the dirty cache trigger is
+// enabled.
+const Seconds kDirtyCacheCheckInterval{1};
+
+size_t getBucket(long long value, size_t numBuckets) {
+    if (value <= 1) {
+        return 0;
+    }
+    return std::min(static_cast<size_t>(63 - countLeadingZeros64(value)), numBuckets - 1);
+}
+
+template <size_t N>
+void appendHistogram(StringData fieldName,
+                     StringData boundName,
+                     const std::array<long long, N>& buckets,
+                     BSONObjBuilder* builder) {
+    // Only the non-empty buckets are reported, each with its inclusive lower bound.
+    BSONArrayBuilder histogramBuilder(builder->subarrayStart(fieldName));
+    for (size_t i = 0; i < N; ++i) {
+        if (buckets[i]) {
+            histogramBuilder.append(BSON(boundName << (i == 0 ? 0LL : 1LL << i) << "count"
+                                                   << buckets[i]));
+        }
+    }
+}
+
 }  // namespace
 
 Checkpointer* Checkpointer::get(ServiceContext* serviceCtx) {
@@ -74,16 +103,38 @@ void Checkpointer::run() {
     while (true) {
         auto opCtx = tc->makeOperationContext();
 
+        bool dirtyTriggered = false;
         {
             stdx::unique_lock<Latch> lock(_mutex);
             MONGO_IDLE_THREAD_BLOCK;
 
             // Wait for 'storageGlobalParams.checkpointDelaySecs' seconds; or until either shutdown
-            // is signaled or a checkpoint is triggered.
-            _sleepCV.wait_for(lock,
-                              stdx::chrono::seconds(static_cast<std::int64_t>(
-                                  storageGlobalParams.checkpointDelaySecs)),
-                              [&] { return _shuttingDown || _triggerCheckpoint; });
+            // is signaled, a checkpoint is triggered, or enough of the cache is dirty. The dirty
+            // cache ratio is sampled every 'kDirtyCacheCheckInterval' while the trigger is enabled.
+            const auto deadline = Date_t::now() +
+                Seconds(static_cast<std::int64_t>(storageGlobalParams.checkpointDelaySecs));
+            while (!_shuttingDown && !_triggerCheckpoint) {
+                const auto now = Date_t::now();
+                if (now >= deadline) {
+                    break;
+                }
+                auto waitFor = deadline - now;
+                if (gCheckpointDirtyCacheTriggerPercent.load() > 0) {
+                    waitFor = std::min<Milliseconds>(waitFor, kDirtyCacheCheckInterval);
+                }
+                _sleepCV.wait_for(lock, waitFor.toSystemDuration(), [&] {
+                    return _shuttingDown || _triggerCheckpoint;
+                });
+                if (!_shuttingDown && !_triggerCheckpoint && Date_t::now() < deadline) {
+                    // Sample the storage engine without holding the mutex.
+                    lock.unlock();
+                    dirtyTriggered = _dirtyCacheThresholdReached();
+                    lock.lock();
+                    if (dirtyTriggered) {
+                        break;
+                    }
+                }
+            }
 
             // If the checkpointDelaySecs is set to 0, that means we should skip checkpointing.
             // However, checkpointDelaySecs is adjustable by a runtime server parameter, so we
@@ -112,11 +163,20 @@ void Checkpointer::run() {
         pauseCheckpointThread.pauseWhileSet();
 
         const Date_t startTime = Date_t::now();
+        const auto bytesWrittenBefore = _kvEngine->getCheckpointBytesWritten();
 
         // TODO SERVER-50861: Access the storage engine via the ServiceContext.
         _kvEngine->checkpoint();
 
-        const auto secondsElapsed = durationCount<Seconds>(Date_t::now() - startTime);
+        const auto elapsed = Date_t::now() - startTime;
+        const auto bytesWrittenAfter = _kvEngine->getCheckpointBytesWritten();
+        _recordCheckpoint(elapsed,
+                          bytesWrittenBefore && bytesWrittenAfter
+                              ? boost::make_optional(*bytesWrittenAfter - *bytesWrittenBefore)
+                              : boost::none,
+                          dirtyTriggered);
+
+        const auto secondsElapsed = durationCount<Seconds>(elapsed);
         if (secondsElapsed >= 30) {
             LOGV2_DEBUG(22308,
                         1,
@@ -165,4 +225,35 @@ void Checkpointer::shutdown(const Status& reason) {
     LOGV2(22323, "Finished shutting down checkpoint thread");
 }
 
+void Checkpointer::appendStats(BSONObjBuilder* builder) const {
+    stdx::lock_guard<Latch> lock(_mutex);
+    builder->append("numCheckpoints", _numCheckpoints);
+    builder->append("numDirtyCacheTriggeredCheckpoints", _numDirtyTriggeredCheckpoints);
+    appendHistogram("durationMillis", "millis", _durationBuckets, builder);
+    appendHistogram("bytesWritten", "bytes", _bytesWrittenBuckets, builder);
+}
+
+bool Checkpointer::_dirtyCacheThresholdReached() const {
+    const auto triggerPercent = gCheckpointDirtyCacheTriggerPercent.load();
+    if (triggerPercent <= 0) {
+        return false;
+    }
+    const auto dirtyRatio = _kvEngine->getDirtyCacheRatio();
+    return dirtyRatio && *dirtyRatio * 100 >= triggerPercent;
+}
+
+void Checkpointer::_recordCheckpoint(Milliseconds duration,
+                                     boost::optional<long long> bytesWritten,
+                                     bool dirtyTriggered) {
+    stdx::lock_guard<Latch> lock(_mutex);
+    ++_numCheckpoints;
+    if (dirtyTriggered) {
+        ++_numDirtyTriggeredCheckpoints;
+    }
+    ++_durationBuckets[getBucket(durationCount<Milliseconds>(duration), kNumDurationBuckets)];
+    if (bytesWritten) {
+        ++_bytesWrittenBuckets[getBucket(*bytesWritten, kNumBytesWrittenBuckets)];
+    }
+}
+
 }  // namespace mongo
@@ -29,12 +29,17 @@
 
 #pragma once
 
+#include <array>
+#include <boost/optional.hpp>
+
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/util/background.h"
+#include "mongo/util/duration.h"
 
 namespace mongo {
 
+class BSONObjBuilder;
 class KVEngine;
 class OperationContext;
 class ServiceContext;
@@ -42,6 +47,12 @@ class Timestamp;
 
 class Checkpointer : public BackgroundJob {
 public:
+    // Bucket 'i' of the duration and size histograms counts the checkpoints which took
+    // [2^i, 2^(i+1)) milliseconds or wrote [2^i, 2^(i+1)) bytes respectively. The first bucket
+    // also counts zero, and the last one counts everything above its lower bound.
+    static constexpr size_t kNumDurationBuckets = 24;
+    static constexpr size_t kNumBytesWrittenBuckets = 48;
+
     Checkpointer(KVEngine* kvEngine)
         : BackgroundJob(false /* deleteSelf */),
           _kvEngine(kvEngine),
@@ -60,6 +71,9 @@ public:
 
     /**
      * Starts the checkpoint thread that runs every storageGlobalParams.checkpointDelaySecs seconds.
+     * When 'checkpointDirtyCacheTriggerPercent' is set, the thread also checks the storage engine's
+     * dirty cache ratio every second and checkpoints early once the ratio reaches the threshold,
+     * so that each checkpoint has less data to write.
      */
     void run() override;
 
@@ -87,14 +101,33 @@ public:
      */
     void shutdown(const Status& reason);
 
+    /**
+     * Appends the number of checkpoints taken, how many of them were triggered by the dirty cache
+     * threshold, and histograms of their durations and of the bytes they wrote.
+     */
+    void appendStats(BSONObjBuilder* builder) const;
+
 private:
+    /**
+     * Returns whether the dirty cache ratio reported by the storage engine has reached
+     * 'checkpointDirtyCacheTriggerPercent'. Always false when the trigger is disabled.
+     */
+    bool _dirtyCacheThresholdReached() const;
+
+    /**
+     * Records a completed checkpoint in the statistics.
+     */
+    void _recordCheckpoint(Milliseconds duration,
+                           boost::optional<long long> bytesWritten,
+                           bool dirtyTriggered);
+
     // A pointer to the KVEngine is maintained only due to unit testing limitations that don't fully
     // setup the ServiceContext.
     // TODO SERVER-50861: Remove this pointer.
     KVEngine* const _kvEngine;
 
     // Protects the state below.
-    Mutex _mutex = MONGO_MAKE_LATCH("Checkpointer::_mutex");
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("Checkpointer::_mutex");
 
     // The checkpoint thread idles on this condition variable for a particular time duration between
     // taking checkpoints. It can be triggered early to expedite either: immediate checkpointing if
@@ -109,6 +142,12 @@ private:
 
     // This flag allows the checkpoint thread to wake up early when _sleepCV is signaled.
     bool _triggerCheckpoint;
+
+    // Statistics about the checkpoints taken so far.
+    long long _numCheckpoints = 0;
+    long long _numDirtyTriggeredCheckpoints = 0;
+    std::array<long long, kNumDurationBuckets> _durationBuckets{};
+    std::array<long long, kNumBytesWrittenBuckets> _bytesWrittenBuckets{};
 };
 
 }  // namespace mongo
@@ -33,14 +33,23 @@
 
 #include "mongo/db/storage/control/journal_flusher.h"
 
+#include <algorithm>
+
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/client.h"
+#include "mongo/db/commands/server_status.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/storage/recovery_unit.h"
 #include "mongo/db/storage/storage_options.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/logv2/log.h"
+#include "mongo/platform/bits.h"
 #include "mongo/stdx/future.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/scopeguard.h"
+#include "mongo/util/time_support.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -50,8 +59,49 @@ const auto getJournalFlusher = ServiceContext::declareDecoration<std::unique_ptr
 
 MONGO_FAIL_POINT_DEFINE(pauseJournalFlusherThread);
 
+// Weight of the latest sample in the moving averages of the flush time and of the arrival rate.
+const double kMovingAverageWeight = 0.2;
+
+double updateMovingAverage(double average, double sample) {
+    return average + kMovingAverageWeight * (sample - average);
+}
+
+class JournalFlusherServerStatusSection final : public ServerStatusSection {
+public:
+    JournalFlusherServerStatusSection() : ServerStatusSection("journalFlusher") {}
+
+    bool includeByDefault() const override {
+        return true;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        BSONObjBuilder builder;
+        if (auto& journalFlusher = getJournalFlusher(opCtx->getServiceContext())) {
+            journalFlusher->appendStats(&builder);
+        }
+        return builder.obj();
+    }
+} journalFlusherSection;
+
 }  // namespace
 
+void JournalFlusher::Histogram::increment(uint64_t value) {
+    const int bucket = value == 0 ? 0 : std::min(kNumBuckets - 1, 64 - countLeadingZeros64(value));
+    _counts[bucket].fetchAndAdd(1);
+}
+
+void JournalFlusher::Histogram::append(StringData fieldName,
+                                       StringData boundName,
+                                       BSONObjBuilder* builder) const {
+    BSONArrayBuilder bucketsBuilder(builder->subarrayStart(fieldName));
+    for (int i = 0; i < kNumBuckets; ++i) {
+        BSONObjBuilder bucketBuilder(bucketsBuilder.subobjStart());
+        bucketBuilder.append(boundName, i == 0 ? 0LL : 1LL << (i - 1));
+        bucketBuilder.append("count", _counts[i].load());
+    }
+}
+
 JournalFlusher* JournalFlusher::get(ServiceContext* serviceCtx) {
     auto& journalFlusher = getJournalFlusher(serviceCtx);
     invariant(journalFlusher);
@@ -85,6 +135,7 @@ void JournalFlusher::run() {
     // from Flow Control.
     _uniqueCtx->get()->setShouldParticipateInFlowControl(false);
     while (true) {
+        long long flushMicros = 0;
         try {
             ON_BLOCK_EXIT([&] {
                 // We do not want to miss an interrupt for the next round. Therefore, the opCtx
@@ -100,7 +151,9 @@ void JournalFlusher::run() {
                 _uniqueCtx->get()->setShouldParticipateInFlowControl(false);
             });
 
+            Timer flushTimer;
             _uniqueCtx->get()->recoveryUnit()->waitUntilDurable(_uniqueCtx->get());
+            flushMicros = flushTimer.micros();
 
             // Signal the waiters that a round completed.
             _currentSharedPromise->emplaceValue();
@@ -122,6 +175,10 @@ void JournalFlusher::run() {
 
         stdx::unique_lock<Latch> lk(_stateMutex);
 
+        if (flushMicros > 0) {
+            _avgFlushMicros = updateMovingAverage(_avgFlushMicros, flushMicros);
+        }
+
         MONGO_IDLE_THREAD_BLOCK;
         if (_disablePeriodicFlushes || MONGO_unlikely(pauseJournalFlusherThread.shouldFail())) {
             // This is not an ideal solution for the failpoint usage because turning the failpoint
@@ -145,6 +202,10 @@ void JournalFlusher::run() {
             _stateChangeCV.notify_all();
         }
 
+        if (_flushJournalNow && !_shuttingDown && _waitForGroupCommit(lk)) {
+            _numHeldBackRounds.fetchAndAdd(1);
+        }
+
         _flushJournalNow = false;
 
         if (_shuttingDown) {
@@ -163,6 +224,19 @@ void JournalFlusher::run() {
         // Take the next promise as current and reset the next promise.
         _currentSharedPromise =
             std::exchange(_nextSharedPromise, std::make_unique<SharedPromise<void>>());
+
+        const auto numWaiters = std::exchange(_numNextWaiters, 0);
+        const auto roundStartMicros = curTimeMicros64();
+        if (_lastRoundStartMicros != 0 && roundStartMicros > _lastRoundStartMicros) {
+            const auto roundMicros = roundStartMicros - _lastRoundStartMicros;
+            _avgWaitersPerMicro =
+                updateMovingAverage(_avgWaitersPerMicro, double(numWaiters) / roundMicros);
+        }
+        _lastRoundStartMicros = roundStartMicros;
+
+        _numRounds.fetchAndAdd(1);
+        _numWaiters.fetchAndAdd(numWaiters);
+        _waitersPerRound.increment(numWaiters);
     }
 }
 
@@ -229,17 +303,68 @@ void JournalFlusher::interruptJournalFlusherForReplStateChange() {
     }
 }
 
+void JournalFlusher::appendStats(BSONObjBuilder* builder) const {
+    builder->append("rounds", _numRounds.load());
+    builder->append("waiters", _numWaiters.load());
+    builder->append("heldBackRounds", _numHeldBackRounds.load());
+    {
+        stdx::lock_guard<Latch> lk(_stateMutex);
+        builder->append("averageFlushMicros", static_cast<long long>(_avgFlushMicros));
+        builder->append("averageWaitersPerSecond", _avgWaitersPerMicro * 1000 * 1000);
+    }
+    _waitersPerRound.append("waitersPerRound", "waiters", builder);
+    _waitMicros.append("waitMicros", "micros", builder);
+}
+
+bool JournalFlusher::_waitForGroupCommit(stdx::unique_lock<Latch>& lk) {
+    const long long maxDelayMicros = gJournalFlusherMaxGroupCommitDelayMicros.load();
+    if (maxDelayMicros == 0 || _numNextWaiters == 0) {
+        return false;
+    }
+
+    // Waiters which arrive while a flush runs have to wait for the next flush. Holding the round
+    // back for at most as long as a flush takes groups them into this one instead, which delays the
+    // first waiters by no more than the flush the others would otherwise wait for.
+    const long long delayMicros =
+        std::min(maxDelayMicros, static_cast<long long>(_avgFlushMicros));
+    const double expectedWaiters = 1 + _avgWaitersPerMicro * delayMicros;
+    if (expectedWaiters < 2 || _numNextWaiters >= expectedWaiters) {
+        return false;
+    }
+
+    const auto now = curTimeMicros64();
+    const long long remainingMicros =
+        delayMicros - static_cast<long long>(now - std::min(now, _firstNextWaiterMicros));
+    if (remainingMicros <= 0) {
+        return false;
+    }
+
+    _groupingWaiters = true;
+    ON_BLOCK_EXIT([&] { _groupingWaiters = false; });
+    _flushJournalNowCV.wait_for(lk, stdx::chrono::microseconds(remainingMicros), [&] {
+        return _numNextWaiters >= expectedWaiters || _needToPause || _shuttingDown;
+    });
+    return true;
+}
+
 void JournalFlusher::_waitForJournalFlushNoRetry() {
+    Timer waitTimer;
     auto myFuture = [&]() {
         stdx::unique_lock<Latch> lk(_stateMutex);
+        if (_numNextWaiters++ == 0) {
+            _firstNextWaiterMicros = curTimeMicros64();
+        }
         if (!_flushJournalNow) {
             _flushJournalNow = true;
             _flushJournalNowCV.notify_one();
+        } else if (_groupingWaiters) {
+            _flushJournalNowCV.notify_one();
         }
         return _nextSharedPromise->getFuture();
     }();
     // Throws on error if the flusher round is interrupted or the flusher thread is shutdown.
     myFuture.get();
+    _waitMicros.increment(waitTimer.micros());
 }
 
 }  // namespace mongo
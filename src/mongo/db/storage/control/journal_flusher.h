@@ -29,13 +29,17 @@
 
 #pragma once
 
+#include <array>
+
 #include "mongo/db/service_context.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/util/background.h"
 #include "mongo/util/future.h"
 
 namespace mongo {
 
+class BSONObjBuilder;
 class OperationContext;
 
 /**
@@ -49,6 +53,11 @@ class OperationContext;
  *    reducing i/o load on the system and improving write performance. This thread groups both the
  *    periodic flushes and immediate flush requests from the rest of the system.
  *
+ * When 'journalFlusherMaxGroupCommitDelayMicros' is set, a requested flush may be held back for
+ * the requests which are expected to arrive while it would run, judging by the rate at which
+ * requests arrive and by how long recent flushes took, so that they are grouped into one flush
+ * instead of being flushed right after it.
+ *
  * And incidentally helpful for another reason:
  *  - waitUntilDurable() calls update the replication JournalListener, so more frequent calls may be
  *    helpful to unblock replication related operations more quickly.
@@ -121,6 +130,13 @@ public:
      */
     void interruptJournalFlusherForReplStateChange();
 
+    /**
+     * Appends the number of flushing rounds and of their waiters, histograms of the number of
+     * waiters of each round and of how long waiters waited, and the estimates that rounds are
+     * grouped by.
+     */
+    void appendStats(BSONObjBuilder* builder) const;
+
 private:
     // Journal flusher internal states.
     enum class States {
@@ -137,6 +153,29 @@ private:
      */
     void _waitForJournalFlushNoRetry();
 
+    /**
+     * Holds back the next round while more waiters are expected to join it within the time a flush
+     * takes, up to 'journalFlusherMaxGroupCommitDelayMicros' after its first waiter arrived.
+     * Returns whether the round was held back.
+     */
+    bool _waitForGroupCommit(stdx::unique_lock<Latch>& lk);
+
+    /**
+     * Counts of values in buckets bounded by powers of two: bucket 0 counts zeros and bucket i
+     * counts the values in [2^(i-1), 2^i), with the last bucket also counting all larger values.
+     */
+    class Histogram {
+    public:
+        static constexpr int kNumBuckets = 24;
+
+        void increment(uint64_t value);
+
+        void append(StringData fieldName, StringData boundName, BSONObjBuilder* builder) const;
+
+    private:
+        std::array<AtomicWord<long long>, kNumBuckets> _counts;
+    };
+
     // Serializes setting/resetting _uniqueCtx and marking _uniqueCtx killed.
     mutable Mutex _opCtxMutex = MONGO_MAKE_LATCH("JournalFlusherOpCtxMutex");
 
@@ -162,6 +201,20 @@ private:
     bool _shuttingDown = false;
     Status _shutdownReason = Status::OK();
 
+    // The number of callers waiting on _nextSharedPromise, and when the first of them arrived, in
+    // microseconds.
+    long long _numNextWaiters = 0;
+    unsigned long long _firstNextWaiterMicros = 0;
+
+    // Set while the thread holds back a round, so that arriving waiters wake it up.
+    bool _groupingWaiters = false;
+
+    // Moving averages of how long a flush takes and of the rate at which waiters arrive, and when
+    // the last round started, in microseconds.
+    double _avgFlushMicros = 0;
+    double _avgWaitersPerMicro = 0;
+    unsigned long long _lastRoundStartMicros = 0;
+
     // New callers get a future from nextSharedPromise. The JournalFlusher thread will swap that to
     // currentSharedPromise at the start of every round of flushing, and reset nextSharedPromise
     // with a new shared promise.
@@ -174,6 +227,12 @@ private:
     // data flushes will only be executed upon explicit request, no longer periodically in addition
     // to upon request.
     bool _disablePeriodicFlushes;
+
+    AtomicWord<long long> _numRounds;
+    AtomicWord<long long> _numWaiters;
+    AtomicWord<long long> _numHeldBackRounds;
+    Histogram _waitersPerRound;
+    Histogram _waitMicros;
 };
 
 }  // namespace mongo
@@ -36,6 +36,7 @@
 #include <memory>
 
 #include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/storage/ephemeral_for_test/ephemeral_for_test_parameters_gen.h"
 #include "mongo/db/storage/ephemeral_for_test/ephemeral_for_test_recovery_unit.h"
 #include "mongo/db/storage/key_string.h"
 #include "mongo/db/storage/record_store.h"
@@ -45,12 +46,39 @@ namespace mongo {
 namespace ephemeral_for_test {
 namespace {
 static AtomicWord<bool> shuttingDown{false};
+AtomicWord<int64_t> rejectedWrites{0};
+AtomicWord<int64_t> writeConflicts{0};
 }  // namespace
 
 bool KVEngine::instanceExists() {
     return shuttingDown.load();
 }
 
+Status KVEngine::checkMemoryLimit() {
+    const auto maxMemoryBytes = gMaxMemoryBytes.load();
+    if (maxMemoryBytes == 0 || StringStore::totalMemory() <= maxMemoryBytes) {
+        return Status::OK();
+    }
+    rejectedWrites.fetchAndAdd(1);
+    return Status(ErrorCodes::ExceededMemoryLimit,
+                  str::stream() << "The ephemeralForTest storage engine holds "
+                                << StringStore::totalMemory()
+                                << " bytes, which exceeds ephemeralForTestMaxMemoryBytes of "
+                                << maxMemoryBytes);
+}
+
+void KVEngine::onWriteConflict() {
+    writeConflicts.fetchAndAdd(1);
+}
+
+int64_t KVEngine::numRejectedWrites() {
+    return rejectedWrites.load();
+}
+
+int64_t KVEngine::numWriteConflicts() {
+    return writeConflicts.load();
+}
+
 KVEngine::KVEngine()
     : mongo::KVEngine(), _visibilityManager(std::make_unique<VisibilityManager>()) {
     _master = std::make_shared<StringStore>();
@@ -251,6 +279,11 @@ void KVEngine::setOldestTimestamp(Timestamp newOldestTimestamp, bool force) {
     invariant(_availableHistory.size() >= 1);
 }
 
+size_t KVEngine::getHistorySize() const {
+    stdx::lock_guard<Latch> lock(_masterLock);
+    return _availableHistory.size();
+}
+
 std::map<Timestamp, std::shared_ptr<StringStore>> KVEngine::getHistory_forTest() {
     stdx::lock_guard<Latch> lock(_masterLock);
     return _availableHistory;
@@ -198,6 +198,26 @@ public:
 
     static bool instanceExists();
 
+    /**
+     * Returns ExceededMemoryLimit if the engine holds more memory than 'maxMemoryBytes' allows,
+     * in which case writes which would grow it further must be rejected.
+     */
+    static Status checkMemoryLimit();
+
+    /**
+     * Counts a unit of work which could not be merged into the master tree because of a concurrent
+     * write to the same keys.
+     */
+    static void onWriteConflict();
+
+    static int64_t numRejectedWrites();
+    static int64_t numWriteConflicts();
+
+    /**
+     * Returns the number of versions of the master tree which are kept around for readers.
+     */
+    size_t getHistorySize() const;
+
 private:
     void _cleanHistory(WithLock);
 
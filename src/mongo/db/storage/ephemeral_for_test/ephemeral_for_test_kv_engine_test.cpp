@@ -39,7 +39,9 @@
 #include "mongo/db/service_context.h"
 #include "mongo/db/service_context_test_fixture.h"
 #include "mongo/db/storage/ephemeral_for_test/ephemeral_for_test_kv_engine.h"
+#include "mongo/db/storage/ephemeral_for_test/ephemeral_for_test_parameters_gen.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace ephemeral_for_test {
@@ -127,6 +129,53 @@ TEST_F(EphemeralForTestKVEngineTest, AvailableHistoryUpdate) {
     ASSERT_EQ(_engine->getOldestTimestamp(), currentMaster);
 }
 
+TEST_F(EphemeralForTestKVEngineTest, WritesAreRejectedAboveTheMemoryLimit) {
+    NamespaceString nss("a.b");
+    std::string ident = "collection-1234";
+    std::string record = "abcd";
+    CollectionOptions defaultCollectionOptions;
+
+    std::unique_ptr<mongo::RecordStore> rs;
+    RecordId rid;
+    {
+        OperationContextFromKVEngine opCtx(_engine);
+        ASSERT_OK(_engine->createRecordStore(&opCtx, nss.ns(), ident, defaultCollectionOptions));
+        rs = _engine->getRecordStore(&opCtx, nss.ns(), ident, defaultCollectionOptions);
+        ASSERT(rs);
+
+        WriteUnitOfWork uow(&opCtx);
+        StatusWith<RecordId> res =
+            rs->insertRecord(&opCtx, record.c_str(), record.length() + 1, Timestamp());
+        ASSERT_OK(res.getStatus());
+        rid = res.getValue();
+        uow.commit();
+    }
+
+    ON_BLOCK_EXIT([] { gMaxMemoryBytes.store(0); });
+    gMaxMemoryBytes.store(1);
+    const auto rejectedWrites = KVEngine::numRejectedWrites();
+    {
+        OperationContextFromKVEngine opCtx(_engine);
+        WriteUnitOfWork uow(&opCtx);
+        ASSERT_EQ(ErrorCodes::ExceededMemoryLimit,
+                  rs->insertRecord(&opCtx, record.c_str(), record.length() + 1, Timestamp())
+                      .getStatus()
+                      .code());
+        ASSERT_EQ(ErrorCodes::ExceededMemoryLimit,
+                  rs->updateRecord(&opCtx, rid, record.c_str(), record.length() + 1).code());
+    }
+    ASSERT_EQ(rejectedWrites + 2, KVEngine::numRejectedWrites());
+
+    // Deletes free memory, so they are accepted.
+    {
+        OperationContextFromKVEngine opCtx(_engine);
+        WriteUnitOfWork uow(&opCtx);
+        rs->deleteRecord(&opCtx, rid);
+        uow.commit();
+    }
+    ASSERT_EQ(0, rs->numRecords(nullptr));
+}
+
 TEST_F(EphemeralForTestKVEngineTest, PinningOldestTimestampWithReadTransaction) {
     NamespaceString nss("a.b");
     std::string ident = "collection-1234";
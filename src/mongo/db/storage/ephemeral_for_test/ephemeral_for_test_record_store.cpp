@@ -40,6 +40,7 @@
 #include "mongo/bson/bsonobj.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/record_id_helpers.h"
+#include "mongo/db/storage/ephemeral_for_test/ephemeral_for_test_kv_engine.h"
 #include "mongo/db/storage/ephemeral_for_test/ephemeral_for_test_radix_store.h"
 #include "mongo/db/storage/ephemeral_for_test/ephemeral_for_test_recovery_unit.h"
 #include "mongo/db/storage/ephemeral_for_test/ephemeral_for_test_visibility_manager.h"
@@ -155,6 +156,12 @@ Status RecordStore::insertRecords(OperationContext* opCtx,
     if (_isCapped && totalSize > _cappedMaxSize)
         return Status(ErrorCodes::BadValue, "object to insert exceeds cappedMaxSize");
 
+    if (!_isOplog) {
+        Status status = KVEngine::checkMemoryLimit();
+        if (!status.isOK())
+            return status;
+    }
+
     auto ru = RecoveryUnit::get(opCtx);
     StringStore* workingCopy(ru->getHead());
     {
@@ -186,6 +193,12 @@ Status RecordStore::updateRecord(OperationContext* opCtx,
                                  const RecordId& oldLocation,
                                  const char* data,
                                  int len) {
+    if (!_isOplog) {
+        Status status = KVEngine::checkMemoryLimit();
+        if (!status.isOK())
+            return status;
+    }
+
     StringStore* workingCopy(RecoveryUnit::get(opCtx)->getHead());
     SizeAdjuster adjuster(opCtx, this);
     {
@@ -64,6 +64,7 @@ void RecoveryUnit::doCommitUnitOfWork() {
                 invariant(_mergeBase);
                 _workingCopy.merge3(*_mergeBase, *masterInfo.second);
             } catch (const merge_conflict_exception&) {
+                KVEngine::onWriteConflict();
                 throw WriteConflictException();
             }
 
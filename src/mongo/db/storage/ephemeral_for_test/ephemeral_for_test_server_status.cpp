@@ -36,6 +36,7 @@
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/storage/ephemeral_for_test/ephemeral_for_test_kv_engine.h"
+#include "mongo/db/storage/ephemeral_for_test/ephemeral_for_test_parameters_gen.h"
 #include "mongo/db/storage/ephemeral_for_test/ephemeral_for_test_radix_store.h"
 #include "mongo/db/storage/ephemeral_for_test/ephemeral_for_test_record_store.h"
 #include "mongo/logv2/log.h"
@@ -63,6 +64,10 @@ BSONObj ServerStatusSection::generateSection(OperationContext* opCtx,
     bob.append("totalMemoryUsage", StringStore::totalMemory());
     bob.append("totalNodes", StringStore::totalNodes());
     bob.append("averageChildren", StringStore::averageChildren());
+    bob.append("maxMemoryBytes", gMaxMemoryBytes.load());
+    bob.append("historyVersions", static_cast<long long>(_engine->getHistorySize()));
+    bob.append("rejectedWrites", KVEngine::numRejectedWrites());
+    bob.append("writeConflicts", KVEngine::numWriteConflicts());
 
     return bob.obj();
 }
@@ -34,6 +34,7 @@
 #include "mongo/db/storage/flow_control.h"
 
 #include <algorithm>
+#include <cmath>
 #include <fmt/format.h>
 #include <limits>
 
@@ -44,6 +45,7 @@
 #include "mongo/db/server_options.h"
 #include "mongo/db/storage/flow_control_parameters_gen.h"
 #include "mongo/logv2/log.h"
+#include "mongo/platform/bits.h"
 #include "mongo/util/background.h"
 #include "mongo/util/fail_point.h"
 
@@ -56,6 +58,10 @@ MONGO_FAIL_POINT_DEFINE(flowControlTicketOverride);
 namespace {
 const auto getFlowControl = ServiceContext::declareDecoration<std::unique_ptr<FlowControl>>();
 
+// Bounds the integral of the lag controller, so that a long period spent away from the threshold
+// lag does not keep driving the output once the lag comes back to it.
+constexpr double kMaxLagErrorIntegral = 5.0;
+
 int multiplyWithOverflowCheck(double term1, double term2, int maxValue) {
     if (term1 == 0.0 || term2 == 0.0) {
         // Early return to avoid any divide by zero errors.
@@ -146,12 +152,27 @@ FlowControl::FlowControl(ServiceContext* service, repl::ReplicationCoordinator*
     _jobAnchor = service->getPeriodicRunner()->makeJob(
         {"FlowControlRefresher",
          [this](Client* client) {
-             FlowControlTicketholder::get(client->getServiceContext())->refreshTo(getNumTickets());
+             _refresh(FlowControlTicketholder::get(client->getServiceContext()), Date_t::now());
          },
-         Seconds(1)});
+         kRefreshInterval});
     _jobAnchor.start();
 }
 
+void FlowControl::ThrottlingHistogram::increment(uint64_t value) {
+    const int bucket = value == 0 ? 0 : std::min(kNumBuckets - 1, 64 - countLeadingZeros64(value));
+    _counts[bucket].fetchAndAdd(1);
+}
+
+void FlowControl::ThrottlingHistogram::append(StringData fieldName,
+                                              BSONObjBuilder* builder) const {
+    BSONArrayBuilder bucketsBuilder(builder->subarrayStart(fieldName));
+    for (int i = 0; i < kNumBuckets; ++i) {
+        BSONObjBuilder bucketBuilder(bucketsBuilder.subobjStart());
+        bucketBuilder.append("throttledWrites", i == 0 ? 0LL : 1LL << (i - 1));
+        bucketBuilder.append("count", _counts[i].load());
+    }
+}
+
 FlowControl* FlowControl::get(ServiceContext* service) {
     return getFlowControl(service).get();
 }
@@ -209,11 +230,11 @@ double FlowControl::_getLocksPerOp() {
 BSONObj FlowControl::generateSection(OperationContext* opCtx,
                                      const BSONElement& configElement) const {
     BSONObjBuilder bob;
+    auto ticketholder = FlowControlTicketholder::get(opCtx);
     // Most of these values are only computed and meaningful when flow control is enabled.
     bob.append("enabled", gFlowControlEnabled.load());
     bob.append("targetRateLimit", _lastTargetTicketsPermitted.load());
-    bob.append("timeAcquiringMicros",
-               FlowControlTicketholder::get(opCtx)->totalTimeAcquiringMicros());
+    bob.append("timeAcquiringMicros", ticketholder->totalTimeAcquiringMicros());
     // Ensure sufficient significant figures of locksPerOp are reported in FTDC, which stores data
     // as integers.
     bob.append("locksPerKiloOp", _lastLocksPerOp.load() * 1000);
@@ -221,10 +242,64 @@ BSONObj FlowControl::generateSection(OperationContext* opCtx,
     bob.append("isLagged", _isLagged.load());
     bob.append("isLaggedCount", _isLaggedCount.load());
     bob.append("isLaggedTimeMicros", _isLaggedTimeMicros.load());
+    bob.append("continuousRefill", gFlowControlContinuousRefill.load());
+    bob.append("lagControllerOutput", _lastLagControllerOutput.load());
+    bob.append("throttledAcquisitions", ticketholder->totalThrottledAcquisitions());
+    bob.append("exemptAcquisitions", ticketholder->totalExemptAcquisitions());
+    _throttledPer100ms.append("throttledPer100ms", &bob);
+    _throttledPerSecond.append("throttledPerSecond", &bob);
 
     return bob.obj();
 }
 
+void FlowControl::_refresh(FlowControlTicketholder* ticketholder, Date_t now) {
+    const auto throttledAcquisitions = ticketholder->totalThrottledAcquisitions();
+    const auto throttled = throttledAcquisitions - _lastThrottledAcquisitions;
+    _lastThrottledAcquisitions = throttledAcquisitions;
+    _throttledPer100ms.increment(throttled);
+    _throttledThisPeriod += throttled;
+    if (kRefreshInterval * ++_intervalsThisPeriod >= kTicketsCalculationPeriod) {
+        _throttledPerSecond.increment(_throttledThisPeriod);
+        _throttledThisPeriod = 0;
+        _intervalsThisPeriod = 0;
+    }
+
+    if (now - _lastTicketsCalculation < kTicketsCalculationPeriod) {
+        return;
+    }
+    _lastTicketsCalculation = now;
+
+    const int numTickets = getNumTickets(now);
+    if (gFlowControlContinuousRefill.load()) {
+        // Only throttled rates are worth charging the exempt writes to. This spares them the
+        // ticketholder's mutex when flow control is not engaged.
+        ticketholder->refillAtRate(numTickets,
+                                   Milliseconds(gFlowControlMaxBurstMillis.load()),
+                                   numTickets < kMaxTickets);
+    } else {
+        ticketholder->refreshTo(numTickets);
+    }
+}
+
+double FlowControl::_updateLagController(std::uint64_t lagMillis,
+                                         std::uint64_t thresholdLagMillis) {
+    // The error is how far the lag is from the threshold, relative to the threshold, such that
+    // the gains do not depend on the configured target lag.
+    const double threshold = static_cast<double>(std::max(thresholdLagMillis, std::uint64_t{1}));
+    const double error = (static_cast<double>(lagMillis) - threshold) / threshold;
+
+    _lagErrorIntegral =
+        std::max(-kMaxLagErrorIntegral, std::min(kMaxLagErrorIntegral, _lagErrorIntegral + error));
+    const double derivative = _lastLagError ? error - *_lastLagError : 0.0;
+    _lastLagError = error;
+
+    const double output = gFlowControlLagControllerProportionalGain.load() * error +
+        gFlowControlLagControllerIntegralGain.load() * _lagErrorIntegral +
+        gFlowControlLagControllerDerivativeGain.load() * derivative;
+    _lastLagControllerOutput.store(output);
+    return output;
+}
+
 void FlowControl::disableUntil(Date_t deadline) {
     _disableUntil.store(deadline);
 }
@@ -305,7 +380,12 @@ int FlowControl::_calculateNewTicketsForLag(const std::vector<repl::MemberData>&
         static_cast<double>(std::max(thresholdLagMillis, static_cast<std::uint64_t>(1)));
     invariant(exponent >= 0.0);
 
-    const double reduce = pow(gFlowControlDecayConstant.load(), exponent);
+    // With continuous refill, the lag controller's output takes the place of the exponent. It
+    // also accounts for how long the lag has been above the threshold and how fast it grows, so
+    // that the rate settles instead of oscillating around the threshold.
+    const double reduce = gFlowControlContinuousRefill.load()
+        ? std::exp(-std::max(0.0, _lastLagControllerOutput.load()))
+        : pow(gFlowControlDecayConstant.load(), exponent);
 
     // The fudge factor, by default is 0.95. Keeping this value close to one reduces oscillations in
     // an environment where secondaries consistently process operations slower than the primary.
@@ -375,6 +455,11 @@ int FlowControl::getNumTickets(Date_t now) {
          _approximateOpsBetween(lastCommitted.opTime.getTimestamp(),
                                 myLastApplied.opTime.getTimestamp()) == -1);
 
+    if (gFlowControlContinuousRefill.load() && !ignoreWallTimes) {
+        _updateLagController(getLagMillis(myLastApplied.wallTime, lastCommitted.wallTime),
+                             thresholdLagMillis);
+    }
+
     if (isHealthy) {
         // The add/multiply technique is used to ensure ticket allocation can ramp up quickly,
         // particularly if there were very few tickets to begin with.
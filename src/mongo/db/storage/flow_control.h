@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <array>
+#include <boost/optional.hpp>
 #include <deque>
 
 #include "mongo/db/commands/server_status.h"
@@ -41,6 +43,8 @@
 
 namespace mongo {
 
+class FlowControlTicketholder;
+
 /**
  * This class encapsulates (most) logic relating to throttling incoming writes when a primary
  * discovers the commit point is lagging behind. The only method exposed to the system for
@@ -49,13 +53,19 @@ namespace mongo {
  * answer the question: "How many operations are between two timestamps?"
  *
  * Otherwise this class' only output is to refresh the tickets available in the
- * `FlowControlTicketholder`.
+ * `FlowControlTicketholder`, either once per second or, with `flowControlContinuousRefill`, by
+ * having them refilled continuously at the calculated rate.
  */
 class FlowControl : public ServerStatusSection {
 public:
     class Bypass;
     static constexpr int kMaxTickets = 1000 * 1000 * 1000;
 
+    // How often the periodic job samples the throttled writes. The number of tickets is calculated
+    // once every `kTicketsCalculationPeriod`.
+    static constexpr Milliseconds kRefreshInterval{100};
+    static constexpr Milliseconds kTicketsCalculationPeriod{1000};
+
     FlowControl(ServiceContext* service, repl::ReplicationCoordinator* replCoord);
 
     /**
@@ -134,6 +144,19 @@ public:
                                    std::uint64_t thresholdLagMillis);
     void _trimSamples(const Timestamp trimSamplesTo);
 
+    /**
+     * Updates the output of the lag controller, which drives the commit point lag towards
+     * 'thresholdLagMillis', with the latest lag. Returns the new output. The higher the output,
+     * the more the tickets are reduced relative to the sustainer rate.
+     */
+    double _updateLagController(std::uint64_t lagMillis, std::uint64_t thresholdLagMillis);
+
+    /**
+     * Runs every `kRefreshInterval` in the periodic job. Records the number of throttled writes
+     * and refreshes the tickets every `kTicketsCalculationPeriod`.
+     */
+    void _refresh(FlowControlTicketholder* ticketholder, Date_t now);
+
     // Sample of (timestamp, ops, lock acquisitions) where ops and lock acquisitions are
     // observations of the corresponding counter at (roughly) <timestamp>.
     typedef std::tuple<std::uint64_t, std::uint64_t, std::int64_t> Sample;
@@ -142,6 +165,21 @@ public:
     }
 
 private:
+    /**
+     * Counts intervals by their number of throttled writes, in buckets bounded by powers of two.
+     */
+    class ThrottlingHistogram {
+    public:
+        static constexpr int kNumBuckets = 20;
+
+        void increment(uint64_t value);
+
+        void append(StringData fieldName, BSONObjBuilder* builder) const;
+
+    private:
+        std::array<AtomicWord<long long>, kNumBuckets> _counts;
+    };
+
     repl::ReplicationCoordinator* _replCoord;
 
     // These values are updated with each flow control computation and are also surfaced in server
@@ -154,6 +192,20 @@ private:
     // Use an int64_t as this is serialized to bson which does not support unsigned 64-bit numbers.
     AtomicWord<std::int64_t> _isLaggedTimeMicros{0};
     AtomicWord<Date_t> _disableUntil;
+    AtomicWord<double> _lastLagControllerOutput{0.0};
+
+    // The state of the lag controller, in units of the threshold lag.
+    double _lagErrorIntegral = 0.0;
+    boost::optional<double> _lastLagError;
+
+    // These values are only accessed by the periodic job.
+    Date_t _lastTicketsCalculation;
+    std::int64_t _lastThrottledAcquisitions = 0;
+    std::int64_t _throttledThisPeriod = 0;
+    int _intervalsThisPeriod = 0;
+
+    ThrottlingHistogram _throttledPer100ms;
+    ThrottlingHistogram _throttledPerSecond;
 
     mutable Mutex _sampledOpsMutex = MONGO_MAKE_LATCH("FlowControl::_sampledOpsMutex");
     std::deque<Sample> _sampledOpsApplied;
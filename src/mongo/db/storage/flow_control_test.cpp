@@ -31,6 +31,8 @@
 
 #include "mongo/platform/basic.h"
 
+#include <cmath>
+
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/concurrency/flow_control_ticketholder.h"
 #include "mongo/db/concurrency/lock_manager_defs.h"
@@ -40,6 +42,7 @@
 #include "mongo/db/storage/flow_control_parameters_gen.h"
 #include "mongo/logv2/log_debug.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -266,6 +269,89 @@ TEST_F(FlowControlTest, CalculatingTickets) {
                                                       thresholdLag));
 }
 
+TEST_F(FlowControlTest, LagController) {
+    gFlowControlLagControllerProportionalGain.store(0.7);
+    gFlowControlLagControllerIntegralGain.store(0.1);
+    gFlowControlLagControllerDerivativeGain.store(0.3);
+
+    // At the threshold lag, the controller does not react.
+    ASSERT_EQ(0.0, flowControl->_updateLagController(1000, 1000));
+
+    // When the lag jumps to twice the threshold, each term contributes its full gain.
+    ASSERT_APPROX_EQUAL(1.1, flowControl->_updateLagController(2000, 1000), 1e-9);
+
+    // While the lag stays there, the derivative drops out and the integral keeps growing.
+    ASSERT_APPROX_EQUAL(0.9, flowControl->_updateLagController(2000, 1000), 1e-9);
+    ASSERT_APPROX_EQUAL(1.0, flowControl->_updateLagController(2000, 1000), 1e-9);
+
+    // Once the lag is gone, the output is negative, which lets the rate recover.
+    ASSERT_LT(flowControl->_updateLagController(0, 1000), 0.0);
+
+    BSONElement noopVar;
+    auto serverStatusSection = flowControl->generateSection(opCtx.get(), noopVar);
+    ASSERT_LT(serverStatusSection["lagControllerOutput"].Double(), 0.0);
+}
+
+TEST_F(FlowControlTest, CalculatingTicketsWithContinuousRefill) {
+    gFlowControlContinuousRefill.store(true);
+    ON_BLOCK_EXIT([] { gFlowControlContinuousRefill.store(false); });
+    gFlowControlFudgeFactor.store(0.95);
+
+    auto constructMemberData = [](Timestamp ts) -> repl::MemberData {
+        repl::MemberData ret;
+        ret.setLastAppliedOpTimeAndWallTime({{ts, 1}, Date_t()}, Date_t());
+        return ret;
+    };
+
+    // As in the CalculatingTickets test, the sustainer applied 1,000 operations.
+    std::vector<repl::MemberData> prevMemberData(3, constructMemberData(Timestamp(1000)));
+    std::vector<repl::MemberData> currMemberData(2, constructMemberData(Timestamp(2000)));
+    currMemberData.emplace_back(constructMemberData(Timestamp(3000)));
+    for (int ts = 1; ts <= 3000; ++ts) {
+        flowControl->sample(Timestamp(ts), 1);
+    }
+
+    // The tickets are reduced by the exponential of the controller's output, rather than by
+    // flowControlDecayConstant.
+    const std::uint64_t thresholdLag = 1000;
+    const std::uint64_t currLag = 2 * thresholdLag;
+    const double output = flowControl->_updateLagController(currLag, thresholdLag);
+    ASSERT_GT(output, 0.0);
+    ASSERT_EQ(static_cast<int>(2.0 * (1000 * std::exp(-output) * 0.95)),
+              flowControl->_calculateNewTicketsForLag(
+                  prevMemberData, currMemberData, -1, 2.0, currLag, thresholdLag));
+}
+
+TEST_F(FlowControlTest, RefillingTicketsAtRate) {
+    FlowControlTicketholder ticketholder(0);
+    FlowControlTicketholder::CurOp stats;
+
+    // At a thousand tickets per second, a ticket is refilled every millisecond.
+    ticketholder.refillAtRate(1000, Milliseconds(100), true);
+    for (int i = 0; i < 10; ++i) {
+        ticketholder.getTicket(opCtx.get(), &stats);
+    }
+    ASSERT_EQ(10, stats.ticketsAcquired);
+    ASSERT_GT(ticketholder.totalThrottledAcquisitions(), 0);
+
+    // Exempt writes are only charged while the tickets are refilled at a rate.
+    ticketholder.refreshTo(0);
+    ticketholder.chargeExemptTicket();
+    ASSERT_EQ(0, ticketholder.totalExemptAcquisitions());
+
+    // At one ticket per second, the exempt writes put the tickets in debt, such that a throttled
+    // write has to wait for more than a second.
+    ticketholder.refillAtRate(1, Milliseconds(100), true);
+    ticketholder.chargeExemptTicket();
+    ticketholder.chargeExemptTicket();
+    ASSERT_EQ(2, ticketholder.totalExemptAcquisitions());
+
+    opCtx->setDeadlineAfterNowBy(Milliseconds(50), ErrorCodes::ExceededTimeLimit);
+    ASSERT_THROWS_CODE(ticketholder.getTicket(opCtx.get(), &stats),
+                       DBException,
+                       ErrorCodes::ExceededTimeLimit);
+}
+
 TEST_F(FlowControlTest, DisableUntil) {
     const int ticketOverride = 52319;
 
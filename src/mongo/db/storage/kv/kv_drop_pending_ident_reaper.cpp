@@ -37,8 +37,10 @@
 
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/storage/ident.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/db/storage/write_unit_of_work.h"
 #include "mongo/logv2/log.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -109,57 +111,105 @@ void KVDropPendingIdentReaper::dropIdentsOlderThan(OperationContext* opCtx, cons
         return;
     }
 
-    for (auto& timestampAndIdentInfo : toDrop) {
-        // Guards against catalog changes while dropping idents using KVEngine::dropIdent(). Yields
-        // after dropping each ident.
-        Lock::GlobalLock globalLock(opCtx, MODE_IX);
+    // Drops the idents in batches, each under one acquisition of the global lock, so that a mass
+    // drop neither reacquires the lock for every ident nor holds it for the whole backlog.
+    const auto batchSize = static_cast<size_t>(gDropPendingIdentBatchSize.load());
+    Timer timer;
+    long long numBatches = 0;
+    for (auto batchBegin = toDrop.begin(); batchBegin != toDrop.end(); ++numBatches) {
+        auto batchEnd = batchBegin;
+        for (size_t i = 0; i < batchSize && batchEnd != toDrop.end(); ++i) {
+            ++batchEnd;
+        }
 
-        const auto& dropTimestamp = timestampAndIdentInfo.first;
-        auto& identInfo = timestampAndIdentInfo.second;
-        const auto& nss = identInfo.nss;
-        const auto& identName = identInfo.identName;
-        LOGV2(22237,
-              "Completing drop for ident",
-              "ident"_attr = identName,
-              logAttrs(nss),
-              "dropTimestamp"_attr = dropTimestamp);
-        WriteUnitOfWork wuow(opCtx);
-        auto status =
-            _engine->dropIdent(opCtx->recoveryUnit(), identName, std::move(identInfo.onDrop));
-        if (!status.isOK()) {
-            LOGV2_FATAL_NOTRACE(51022,
-                                "Failed to remove drop-pending ident",
-                                "ident"_attr = identName,
-                                logAttrs(nss),
-                                "dropTimestamp"_attr = dropTimestamp,
-                                "error"_attr = status);
+        {
+            // Guards against catalog changes while dropping idents using KVEngine::dropIdent().
+            // Yields after dropping each batch of idents.
+            Lock::GlobalLock globalLock(opCtx, MODE_IX);
+
+            for (auto it = batchBegin; it != batchEnd; ++it) {
+                const auto& dropTimestamp = it->first;
+                auto& identInfo = it->second;
+                const auto& nss = identInfo.nss;
+                const auto& identName = identInfo.identName;
+                LOGV2_DEBUG(22237,
+                            1,
+                            "Completing drop for ident",
+                            "ident"_attr = identName,
+                            logAttrs(nss),
+                            "dropTimestamp"_attr = dropTimestamp);
+                WriteUnitOfWork wuow(opCtx);
+                auto status = _engine->dropIdent(
+                    opCtx->recoveryUnit(), identName, std::move(identInfo.onDrop));
+                if (!status.isOK()) {
+                    LOGV2_FATAL_NOTRACE(51022,
+                                        "Failed to remove drop-pending ident",
+                                        "ident"_attr = identName,
+                                        logAttrs(nss),
+                                        "dropTimestamp"_attr = dropTimestamp,
+                                        "error"_attr = status);
+                }
+                wuow.commit();
+            }
         }
-        wuow.commit();
-    }
 
-    {
         // Entries must be removed AFTER drops are completed, so that getEarliestDropTimestamp()
         // returns correct results while the success of the drop operations above are uncertain.
+        _removeDroppedIdents(batchBegin, batchEnd);
+        batchBegin = batchEnd;
+    }
 
+    const auto durationMillis = timer.millis();
+    {
         stdx::lock_guard<Latch> lock(_mutex);
-        for (const auto& timestampAndIdentInfo : toDrop) {
-            // Some idents with drop timestamps safe to drop may not have been dropped because they
-            // are still in use by another operation. Therefore, we must iterate the entries in the
-            // multimap matching a particular timestamp and erase only the entry with a match on the
-            // ident as well as the timestamp.
-            auto beginEndPair = _dropPendingIdents.equal_range(timestampAndIdentInfo.first);
-            for (auto it = beginEndPair.first; it != beginEndPair.second;) {
-                if (it->second.identName == timestampAndIdentInfo.second.identName) {
-                    it = _dropPendingIdents.erase(it);
-                    break;
-                } else {
-                    ++it;
-                }
+        _numIdentsDropped += toDrop.size();
+        _numBatches += numBatches;
+        _totalDropMillis += durationMillis;
+    }
+
+    LOGV2(5591707,
+          "Completed drop for idents",
+          "numIdents"_attr = toDrop.size(),
+          "numBatches"_attr = numBatches,
+          "durationMillis"_attr = durationMillis);
+}
+
+void KVDropPendingIdentReaper::_removeDroppedIdents(DropPendingIdents::const_iterator begin,
+                                                    DropPendingIdents::const_iterator end) {
+    stdx::lock_guard<Latch> lock(_mutex);
+    for (auto dropped = begin; dropped != end; ++dropped) {
+        // Some idents with drop timestamps safe to drop may not have been dropped because they are
+        // still in use by another operation. Therefore, we must iterate the entries in the
+        // multimap matching a particular timestamp and erase only the entry with a match on the
+        // ident as well as the timestamp.
+        auto beginEndPair = _dropPendingIdents.equal_range(dropped->first);
+        for (auto it = beginEndPair.first; it != beginEndPair.second;) {
+            if (it->second.identName == dropped->second.identName) {
+                it = _dropPendingIdents.erase(it);
+                break;
+            } else {
+                ++it;
             }
         }
     }
 }
 
+size_t KVDropPendingIdentReaper::getNumDropPendingIdents() const {
+    stdx::lock_guard<Latch> lock(_mutex);
+    return _dropPendingIdents.size();
+}
+
+void KVDropPendingIdentReaper::appendStats(BSONObjBuilder* builder) const {
+    stdx::lock_guard<Latch> lock(_mutex);
+    builder->append("pending", static_cast<long long>(_dropPendingIdents.size()));
+    if (!_dropPendingIdents.empty()) {
+        builder->append("earliestDropTimestamp", _dropPendingIdents.cbegin()->first);
+    }
+    builder->append("dropped", _numIdentsDropped);
+    builder->append("batches", _numBatches);
+    builder->append("dropTimeMillis", _totalDropMillis);
+}
+
 void KVDropPendingIdentReaper::clearDropPendingState() {
     stdx::lock_guard<Latch> lock(_mutex);
     _dropPendingIdents.clear();
@@ -35,6 +35,7 @@
 #include <string>
 
 #include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/bson/timestamp.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/storage/kv/kv_engine.h"
@@ -109,6 +110,17 @@ public:
      */
     void clearDropPendingState();
 
+    /**
+     * Returns the number of drop-pending idents, whether or not they are safe to drop yet.
+     */
+    size_t getNumDropPendingIdents() const;
+
+    /**
+     * Appends the size of the drop-pending backlog and the cumulative statistics of the drops
+     * completed by dropIdentsOlderThan().
+     */
+    void appendStats(BSONObjBuilder* builder) const;
+
 private:
     // Contains information identifying what collection/index data to drop as well as determining
     // when to do so.
@@ -133,6 +145,13 @@ private:
     // the same drop optime.
     using DropPendingIdents = std::multimap<Timestamp, IdentInfo>;
 
+    /**
+     * Removes the entries of the dropped idents in the range ['begin', 'end') from
+     * '_dropPendingIdents'.
+     */
+    void _removeDroppedIdents(DropPendingIdents::const_iterator begin,
+                              DropPendingIdents::const_iterator end);
+
     // Used to access the KV engine for the purposes of dropping the ident.
     KVEngine* const _engine;
 
@@ -141,6 +160,11 @@ private:
 
     // Drop-pending idents. Ordered by drop timestamp.
     DropPendingIdents _dropPendingIdents;
+
+    // Cumulative statistics of the idents dropped by dropIdentsOlderThan().
+    long long _numIdentsDropped = 0;
+    long long _numBatches = 0;
+    long long _totalDropMillis = 0;
 };
 
 }  // namespace mongo
@@ -35,8 +35,10 @@
 #include "mongo/db/service_context_test_fixture.h"
 #include "mongo/db/storage/ident.h"
 #include "mongo/db/storage/kv/kv_drop_pending_ident_reaper.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -375,6 +377,47 @@ TEST_F(KVDropPendingIdentReaperTest, DropIdentsOlderThanSkipsIdentsStillReferenc
     ASSERT_FALSE(reaper.getEarliestDropTimestamp());
 }
 
+TEST_F(KVDropPendingIdentReaperTest, DropIdentsOlderThanDropsIdentsInBatches) {
+    const auto originalBatchSize = gDropPendingIdentBatchSize.load();
+    gDropPendingIdentBatchSize.store(2);
+    ON_BLOCK_EXIT([&] { gDropPendingIdentBatchSize.store(originalBatchSize); });
+
+    auto opCtx = makeOpCtx();
+    auto engine = getEngine();
+    KVDropPendingIdentReaper reaper(engine);
+
+    const int n = 5;
+    {
+        // The reaper must have the only references to the idents before it will drop them.
+        for (int i = 0; i < n; ++i) {
+            std::shared_ptr<Ident> ident =
+                std::make_shared<Ident>(std::string(str::stream() << "ident" << i));
+            reaper.addDropPendingIdent({Seconds(10), 0}, NamespaceString("test.foo"), ident);
+        }
+    }
+    ASSERT_EQUALS(5U, reaper.getNumDropPendingIdents());
+
+    // The entries of each batch are removed once the batch is dropped, before the next batch.
+    std::vector<size_t> numPendingAtDrop;
+    engine->dropIdentFn = [&](RecoveryUnit* ru, StringData identToDropName) {
+        numPendingAtDrop.push_back(reaper.getNumDropPendingIdents());
+        return Status::OK();
+    };
+
+    reaper.dropIdentsOlderThan(opCtx.get(), {Seconds(100), 0});
+    ASSERT_EQUALS(5U, engine->droppedIdents.size());
+    ASSERT_EQUALS(0U, reaper.getNumDropPendingIdents());
+    ASSERT_FALSE(reaper.getEarliestDropTimestamp());
+    ASSERT(numPendingAtDrop == std::vector<size_t>({5, 5, 3, 3, 1}));
+
+    BSONObjBuilder builder;
+    reaper.appendStats(&builder);
+    auto stats = builder.obj();
+    ASSERT_EQUALS(0, stats["pending"].numberLong());
+    ASSERT_EQUALS(5, stats["dropped"].numberLong());
+    ASSERT_EQUALS(3, stats["batches"].numberLong());
+}
+
 DEATH_TEST_F(KVDropPendingIdentReaperTest,
              DropIdentsOlderThanTerminatesIfKVEngineFailsToDropIdent,
              "Failed to remove drop-pending ident") {
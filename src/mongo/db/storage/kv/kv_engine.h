@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
 #include <memory>
 #include <string>
 #include <vector>
@@ -222,6 +223,29 @@ public:
 
     virtual void checkpoint() {}
 
+    /**
+     * Appends statistics about the drops that the engine could not complete immediately and
+     * queued to retry later. Engines which complete every drop immediately append nothing.
+     */
+    virtual void appendDropQueueStats(BSONObjBuilder* builder) const {}
+
+    /**
+     * Returns the fraction of the engine's cache that holds data modified since the last
+     * checkpoint, or boost::none if the engine does not track it. The Checkpointer uses this to
+     * take checkpoints before the dirty data grows large enough to cause a write spike.
+     */
+    virtual boost::optional<double> getDirtyCacheRatio() const {
+        return boost::none;
+    }
+
+    /**
+     * Returns the number of bytes written by checkpoints since startup, or boost::none if the
+     * engine does not track it.
+     */
+    virtual boost::optional<long long> getCheckpointBytesWritten() const {
+        return boost::none;
+    }
+
     virtual bool isDurable() const = 0;
 
     /**
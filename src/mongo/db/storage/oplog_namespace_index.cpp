@@ -0,0 +1,149 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/oplog_namespace_index.h"
+
+#include <algorithm>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/storage/oplog_namespace_index_gen.h"
+
+namespace mongo {
+namespace {
+
+const auto getOplogNamespaceIndex = ServiceContext::declareDecoration<OplogNamespaceIndex>();
+
+}  // namespace
+
+OplogNamespaceIndex& OplogNamespaceIndex::get(ServiceContext* service) {
+    return getOplogNamespaceIndex(service);
+}
+
+bool OplogNamespaceIndex::isEnabled() {
+    return gOplogNamespaceIndexEnabled;
+}
+
+void OplogNamespaceIndex::add(Timestamp ts, const BSONObj& entry) {
+    // Only inserts, updates and deletes are specific to the namespace they name; the namespace of a
+    // command may not be the one it affects, and applyOps and no-ops may carry any change.
+    const auto op = entry["op"].valueStringDataSafe();
+    const bool isCrudOp = op == "i"_sd || op == "u"_sd || op == "d"_sd;
+    add(ts, entry["ns"].valueStringDataSafe(), !isCrudOp);
+}
+
+void OplogNamespaceIndex::add(Timestamp ts, StringData ns, bool isGlobal) {
+    const auto secs = ts.getSecs();
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (!_completeAfterSecs) {
+        // Entries which were written before this one may share its second.
+        _completeAfterSecs = secs;
+    }
+
+    auto* secsSet = &_globalSecs;
+    if (!isGlobal) {
+        auto it = _secsByNamespace.find(ns);
+        if (it == _secsByNamespace.end()) {
+            it = _secsByNamespace.emplace(ns.toString(), std::set<unsigned>{}).first;
+        }
+        secsSet = &it->second;
+    }
+    if (!secsSet->insert(secs).second) {
+        return;
+    }
+    _namespacesBySecs[secs].push_back(isGlobal ? std::string() : ns.toString());
+    ++_numBuckets;
+
+    const auto maxBuckets = static_cast<size_t>(gOplogNamespaceIndexMaxBuckets.load());
+    while (_numBuckets > maxBuckets && _namespacesBySecs.size() > 1) {
+        _evictOldestSecond(lk);
+    }
+}
+
+void OplogNamespaceIndex::_evictOldestSecond(WithLock) {
+    auto oldest = _namespacesBySecs.begin();
+    const auto secs = oldest->first;
+    for (auto&& ns : oldest->second) {
+        if (ns.empty()) {
+            _globalSecs.erase(secs);
+            continue;
+        }
+        auto it = _secsByNamespace.find(ns);
+        it->second.erase(secs);
+        if (it->second.empty()) {
+            _secsByNamespace.erase(it);
+        }
+    }
+    _numBuckets -= oldest->second.size();
+    _namespacesBySecs.erase(oldest);
+
+    // Nothing is known about the forgotten second any more.
+    _completeAfterSecs = std::max(*_completeAfterSecs, secs);
+}
+
+boost::optional<Timestamp> OplogNamespaceIndex::nextRelevantEntryBound(const NamespaceString& nss,
+                                                                       Timestamp ts) const {
+    const auto secs = ts.getSecs();
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (!_completeAfterSecs || secs <= *_completeAfterSecs) {
+        return boost::none;
+    }
+
+    // A later entry of the same second may be relevant.
+    auto nsIt = _secsByNamespace.find(nss.ns());
+    if (_globalSecs.count(secs) || (nsIt != _secsByNamespace.end() && nsIt->second.count(secs))) {
+        return boost::none;
+    }
+
+    boost::optional<unsigned> nextSecs;
+    auto considerNext = [&](const std::set<unsigned>& secsSet) {
+        auto it = secsSet.upper_bound(secs);
+        if (it != secsSet.end() && (!nextSecs || *it < *nextSecs)) {
+            nextSecs = *it;
+        }
+    };
+    considerNext(_globalSecs);
+    if (nsIt != _secsByNamespace.end()) {
+        considerNext(nsIt->second);
+    }
+
+    return nextSecs ? Timestamp(*nextSecs, 0) : Timestamp::max();
+}
+
+size_t OplogNamespaceIndex::numBuckets() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _numBuckets;
+}
+
+}  // namespace mongo
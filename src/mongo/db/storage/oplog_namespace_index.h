@@ -0,0 +1,121 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "mongo/bson/timestamp.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/concurrency/with_lock.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+
+class BSONObj;
+class ServiceContext;
+
+/**
+ * An in-memory side index of the oplog which records, at the granularity of one second, which
+ * namespaces have CRUD entries in the oplog. Commands, applyOps and no-op entries are recorded as
+ * relevant to every namespace, since a change stream on any collection may need to see them.
+ *
+ * Forward scans of the oplog on behalf of a single-collection change stream use it to seek past the
+ * seconds which hold no entry for their collection, rather than reading and filtering every entry.
+ *
+ * The index only knows about the entries inserted since the process started, and forgets the oldest
+ * seconds once it holds more than 'oplogNamespaceIndexMaxBuckets' of them, so it can only tell that
+ * a second holds no relevant entries if the second is after the point from which it is complete.
+ */
+class OplogNamespaceIndex {
+    OplogNamespaceIndex(const OplogNamespaceIndex&) = delete;
+    OplogNamespaceIndex& operator=(const OplogNamespaceIndex&) = delete;
+
+public:
+    OplogNamespaceIndex() = default;
+
+    static OplogNamespaceIndex& get(ServiceContext* service);
+
+    /**
+     * Returns true if the index is maintained by this process, as set by the startup-only
+     * 'oplogNamespaceIndexEnabled' parameter.
+     */
+    static bool isEnabled();
+
+    /**
+     * Records the oplog entry 'entry' with timestamp 'ts'. Must be called before the entry can
+     * become visible to oplog readers.
+     */
+    void add(Timestamp ts, const BSONObj& entry);
+
+    /**
+     * Records an oplog entry with timestamp 'ts' for namespace 'ns', which is relevant to every
+     * namespace if 'isGlobal' is true.
+     */
+    void add(Timestamp ts, StringData ns, bool isGlobal);
+
+    /**
+     * Returns a timestamp greater than 'ts' such that no oplog entry after 'ts' and before it may
+     * be relevant to a change stream on 'nss', or Timestamp::max() if no entry after 'ts' may be.
+     * Returns boost::none if an entry relevant to 'nss' may directly follow 'ts'.
+     */
+    boost::optional<Timestamp> nextRelevantEntryBound(const NamespaceString& nss,
+                                                      Timestamp ts) const;
+
+    /**
+     * Returns the number of (second, namespace) buckets held by the index.
+     */
+    size_t numBuckets() const;
+
+private:
+    void _evictOldestSecond(WithLock);
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("OplogNamespaceIndex::_mutex");
+
+    // The seconds which hold CRUD entries, by namespace, and the seconds which hold entries which
+    // are relevant to every namespace.
+    StringMap<std::set<unsigned>> _secsByNamespace;
+    std::set<unsigned> _globalSecs;
+
+    // The namespaces recorded in each second, with an empty string standing for the global
+    // entries, used to forget the oldest seconds.
+    std::map<unsigned, std::vector<std::string>> _namespacesBySecs;
+    size_t _numBuckets = 0;
+
+    // Every entry in a second after this one has been recorded. Unset until the first entry is.
+    boost::optional<unsigned> _completeAfterSecs;
+};
+
+}  // namespace mongo
@@ -0,0 +1,100 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/storage/oplog_namespace_index.h"
+#include "mongo/db/storage/oplog_namespace_index_gen.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kNss("test.coll");
+
+TEST(OplogNamespaceIndexTest, NothingIsSkippedBeforeTheFirstEntry) {
+    OplogNamespaceIndex index;
+    ASSERT_FALSE(index.nextRelevantEntryBound(kNss, Timestamp(10, 1)));
+
+    // Entries of the first second may have been written before the index was started.
+    index.add(Timestamp(10, 2), "test.other", false);
+    ASSERT_FALSE(index.nextRelevantEntryBound(kNss, Timestamp(10, 2)));
+    ASSERT_EQ(Timestamp::max(), *index.nextRelevantEntryBound(kNss, Timestamp(11, 1)));
+}
+
+TEST(OplogNamespaceIndexTest, SkipsToTheNextSecondWithRelevantEntries) {
+    OplogNamespaceIndex index;
+    index.add(Timestamp(10, 1), BSON("op"
+                                     << "i"
+                                     << "ns" << kNss.ns()));
+    index.add(Timestamp(11, 1), BSON("op"
+                                     << "u"
+                                     << "ns"
+                                     << "test.other"));
+    index.add(Timestamp(15, 1), BSON("op"
+                                     << "d"
+                                     << "ns" << kNss.ns()));
+    index.add(Timestamp(20, 1), BSON("op"
+                                     << "c"
+                                     << "ns"
+                                     << "admin.$cmd"));
+
+    // A later entry of the current second may be relevant.
+    ASSERT_FALSE(index.nextRelevantEntryBound(kNss, Timestamp(15, 1)));
+    ASSERT_EQ(Timestamp(15, 0), *index.nextRelevantEntryBound(kNss, Timestamp(11, 1)));
+
+    // Commands are relevant to every namespace.
+    ASSERT_EQ(Timestamp(20, 0), *index.nextRelevantEntryBound(kNss, Timestamp(16, 1)));
+    ASSERT_EQ(Timestamp(20, 0),
+              *index.nextRelevantEntryBound(NamespaceString("test.other"), Timestamp(11, 1)));
+    ASSERT_FALSE(index.nextRelevantEntryBound(NamespaceString("test.other"), Timestamp(20, 1)));
+    ASSERT_EQ(4U, index.numBuckets());
+}
+
+TEST(OplogNamespaceIndexTest, ForgottenSecondsAreNotSkipped) {
+    const auto maxBuckets = gOplogNamespaceIndexMaxBuckets.load();
+    ON_BLOCK_EXIT([&] { gOplogNamespaceIndexMaxBuckets.store(maxBuckets); });
+    gOplogNamespaceIndexMaxBuckets.store(2);
+
+    OplogNamespaceIndex index;
+    index.add(Timestamp(10, 1), kNss.ns(), false);
+    index.add(Timestamp(12, 1), "test.other", false);
+    index.add(Timestamp(12, 2), kNss.ns(), false);
+    ASSERT_EQ(2U, index.numBuckets());
+
+    // The entry for 'kNss' at second 10 is forgotten, so the seconds up to it are no longer known.
+    ASSERT_FALSE(index.nextRelevantEntryBound(kNss, Timestamp(10, 1)));
+    ASSERT_EQ(Timestamp(12, 0), *index.nextRelevantEntryBound(kNss, Timestamp(11, 1)));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -121,6 +121,28 @@ public:
      */
     virtual boost::optional<Record> next() = 0;
 
+    /**
+     * Moves forward over up to 'n' records, appending them to 'out', and returns how many were
+     * appended. Returning fewer than 'n' means that EOF was reached.
+     *
+     * Unlike the Records returned by next(), the appended Records own their data, so they remain
+     * valid after further calls on this cursor, including save() and restore(). If a
+     * WriteConflictException is thrown, the records appended before it was thrown remain in 'out'
+     * and the cursor is positioned after the last of them.
+     */
+    virtual size_t nextBatch(size_t n, std::vector<Record>* out) {
+        size_t numAppended = 0;
+        for (; numAppended < n; ++numAppended) {
+            auto record = next();
+            if (!record) {
+                break;
+            }
+            record->data.makeOwned();
+            out->push_back(std::move(*record));
+        }
+        return numAppended;
+    }
+
     //
     // Saving and restoring state
     //
@@ -338,6 +360,13 @@ public:
         return true;
     }
 
+    /**
+     * Hints that the records with the given ids are about to be read, so that the storage engine
+     * can start loading them into its cache in the background. The hint may be ignored and never
+     * affects what a later read returns.
+     */
+    virtual void prefetchRecords(OperationContext* opCtx, const std::vector<RecordId>& ids) const {}
+
     virtual void deleteRecord(OperationContext* opCtx, const RecordId& dl) = 0;
 
     /**
@@ -504,6 +533,14 @@ public:
                                    BSONObjBuilder* result,
                                    double scale) const = 0;
 
+    /**
+     * Appends the cache and disk I/O statistics of this RecordStore, if the storage engine tracks
+     * them. Returns true if stats were appended.
+     */
+    virtual bool appendIOStats(OperationContext* opCtx, BSONObjBuilder* result) const {
+        return false;
+    }
+
     /**
      * When we write to an oplog, we call this so that that the storage engine can manage the
      * visibility of oplog entries to ensure they are ordered.
@@ -32,6 +32,7 @@
 #include "mongo/db/storage/record_store_test_harness.h"
 
 
+#include "mongo/db/record_id_helpers.h"
 #include "mongo/db/storage/record_store.h"
 #include "mongo/unittest/unittest.h"
 
@@ -578,5 +579,47 @@ TEST(RecordStoreTestHarness, ClusteredRecordStoreSeekNear) {
         ASSERT_EQ(records[i].id, rec->id);
     }
 }
+
+TEST(RecordStoreTestHarness, ClusteredRecordStoreRejectsDuplicateKeys) {
+    const auto harnessHelper = newRecordStoreHarnessHelper();
+    if (!harnessHelper->getEngine()->supportsClusteredIdIndex()) {
+        // Only WiredTiger supports clustered indexes on _id.
+        return;
+    }
+
+    const std::string ns = "test.a";
+    CollectionOptions options;
+    options.clusteredIndex = ClusteredIndexOptions{};
+    std::unique_ptr<RecordStore> rs = harnessHelper->newNonCappedRecordStore(ns, options);
+    invariant(rs->keyFormat() == KeyFormat::String);
+
+    auto opCtx = harnessHelper->newOperationContext();
+
+    const RecordId id = record_id_helpers::keyForOID(OID::gen());
+    const BSONObj original = BSON("i" << 0);
+    const BSONObj duplicate = BSON("i" << 1);
+    {
+        WriteUnitOfWork wuow(opCtx.get());
+        ASSERT_OK(rs->insertRecord(
+                        opCtx.get(), id, original.objdata(), original.objsize(), Timestamp())
+                      .getStatus());
+        wuow.commit();
+    }
+
+    {
+        WriteUnitOfWork wuow(opCtx.get());
+        ASSERT_EQ(rs->insertRecord(
+                        opCtx.get(), id, duplicate.objdata(), duplicate.objsize(), Timestamp())
+                      .getStatus()
+                      .code(),
+                  ErrorCodes::DuplicateKey);
+    }
+
+    // The original record is left intact.
+    ASSERT_EQ(1, rs->numRecords(opCtx.get()));
+    RecordData rd;
+    ASSERT_TRUE(rs->findRecord(opCtx.get(), id, &rd));
+    ASSERT_BSONOBJ_EQ(original, rd.toBson());
+}
 }  // namespace
 }  // namespace mongo
@@ -32,6 +32,8 @@
 #include "mongo/db/storage/record_store_test_harness.h"
 
 #include <algorithm>
+#include <map>
+#include <vector>
 
 #include "mongo/bson/util/builder.h"
 #include "mongo/db/record_id.h"
@@ -483,5 +485,54 @@ TEST(RecordStoreTestHarness, SeekExactForMissingRecordReturnsNone) {
     ASSERT_FALSE(recordStore->findRecord(opCtx.get(), recordIds[1], &outputData));
 }
 
+// nextBatch() returns owned records in order, in both directions, and across save() and
+// restore(), returning fewer records than requested only at EOF.
+TEST(RecordStoreTestHarness, IterateInBatches) {
+    const auto harnessHelper{newRecordStoreHarnessHelper()};
+    auto recordStore = harnessHelper->newNonCappedRecordStore();
+    ServiceContext::UniqueOperationContext opCtx{harnessHelper->newOperationContext()};
+
+    const int nToInsert = 10;
+    std::vector<RecordId> recordIds;
+    std::map<RecordId, string> datas;
+    for (int i = 0; i < nToInsert; ++i) {
+        StringBuilder sb;
+        sb << "record " << i;
+        string data = sb.str();
+
+        WriteUnitOfWork uow{opCtx.get()};
+        auto res =
+            recordStore->insertRecord(opCtx.get(), data.c_str(), data.size() + 1, Timestamp{});
+        ASSERT_OK(res.getStatus());
+        recordIds.push_back(res.getValue());
+        datas[res.getValue()] = data;
+        uow.commit();
+    }
+    std::sort(recordIds.begin(), recordIds.end());
+
+    for (bool forward : {true, false}) {
+        auto cursor = recordStore->getCursor(opCtx.get(), forward);
+        std::vector<Record> records;
+        ASSERT_EQ(4U, cursor->nextBatch(4, &records));
+
+        cursor->save();
+        ASSERT(cursor->restore());
+        ASSERT_EQ(4U, cursor->nextBatch(4, &records));
+        ASSERT_EQ(2U, cursor->nextBatch(4, &records));
+        ASSERT_EQ(0U, cursor->nextBatch(4, &records));
+        ASSERT(!cursor->next());
+
+        if (!forward) {
+            std::reverse(records.begin(), records.end());
+        }
+        ASSERT_EQ(recordIds.size(), records.size());
+        for (size_t i = 0; i < records.size(); ++i) {
+            ASSERT_EQ(recordIds[i], records[i].id);
+            ASSERT(records[i].data.isOwned());
+            ASSERT_EQ(datas[recordIds[i]], records[i].data.data());
+        }
+    }
+}
+
 }  // namespace
 }  // namespace mongo
@@ -37,6 +37,7 @@
 #include "mongo/bson/timestamp.h"
 #include "mongo/db/repl/read_concern_level.h"
 #include "mongo/db/storage/snapshot.h"
+#include "mongo/util/duration.h"
 
 namespace mongo {
 
@@ -102,6 +103,21 @@ public:
      * layer.
      */
     virtual std::shared_ptr<StorageStats> getCopy() = 0;
+
+    /**
+     * Returns the time spent reading data into the cache, if tracked by the storage engine.
+     */
+    virtual Microseconds getTimeReading() const {
+        return Microseconds{0};
+    }
+
+    /**
+     * Returns the time spent stalled waiting for room in the cache, if tracked by the storage
+     * engine.
+     */
+    virtual Microseconds getTimeWaitingForCache() const {
+        return Microseconds{0};
+    }
 };
 
 
@@ -137,6 +137,13 @@ public:
                                    BSONObjBuilder* output,
                                    double scale) const = 0;
 
+    /**
+     * Appends the cache and disk I/O statistics of this index, if the storage engine tracks them.
+     * Returns true if stats were appended.
+     */
+    virtual bool appendIOStats(OperationContext* opCtx, BSONObjBuilder* output) const {
+        return false;
+    }
 
     /**
      * Return the number of bytes consumed by 'this' index.
@@ -467,6 +467,12 @@ public:
      */
     virtual std::set<std::string> getDropPendingIdents() const = 0;
 
+    /**
+     * Appends the size of the drop-pending ident backlog and the statistics of the drops completed
+     * so far, including the drops the underlying engine queued to retry later.
+     */
+    virtual void appendDropPendingIdentStats(BSONObjBuilder* builder) const = 0;
+
     /**
      * Clears list of drop-pending idents in the storage engine.
      * Used primarily by rollback after recovering to a stable timestamp.
@@ -43,10 +43,12 @@
 #include "mongo/db/index_builds_coordinator.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/server_options.h"
+#include "mongo/db/storage/catalog_load_tasks.h"
 #include "mongo/db/storage/durable_catalog_feature_tracker.h"
 #include "mongo/db/storage/durable_history_pin.h"
 #include "mongo/db/storage/kv/kv_engine.h"
 #include "mongo/db/storage/kv/temporary_kv_record_store.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/db/storage/storage_repair_observer.h"
 #include "mongo/db/storage/storage_util.h"
 #include "mongo/db/storage/two_phase_index_build_knobs_gen.h"
@@ -56,6 +58,7 @@
 #include "mongo/util/fail_point.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
+#include "mongo/util/timer.h"
 
 #define LOGV2_FOR_RECOVERY(ID, DLEVEL, MESSAGE, ...) \
     LOGV2_DEBUG_OPTIONS(ID, DLEVEL, {logv2::LogComponent::kStorageRecovery}, MESSAGE, ##__VA_ARGS__)
@@ -103,6 +106,7 @@ StorageEngineImpl::StorageEngineImpl(OperationContext* opCtx,
 }
 
 void StorageEngineImpl::loadCatalog(OperationContext* opCtx, bool loadingFromUncleanShutdown) {
+    Timer timer;
     bool catalogExists = _engine->hasIdent(opCtx, catalogInfo);
     if (_options.forRepair && catalogExists) {
         auto repairObserver = StorageRepairObserver::get(getGlobalServiceContext());
@@ -232,6 +236,14 @@ void StorageEngineImpl::loadCatalog(OperationContext* opCtx, bool loadingFromUnc
         }
     }
 
+    struct CollectionToLoad {
+        DurableCatalog::Entry entry;
+        Timestamp minVisibleTs;
+        std::shared_ptr<Collection> collection;
+    };
+    std::vector<CollectionToLoad> collectionsToLoad;
+    collectionsToLoad.reserve(catalogEntries.size());
+
     for (DurableCatalog::Entry entry : catalogEntries) {
         if (loadingFromUncleanShutdownOrRepair) {
             // If we are loading the catalog after an unclean shutdown or during repair, it's
@@ -286,24 +298,94 @@ void StorageEngineImpl::loadCatalog(OperationContext* opCtx, bool loadingFromUnc
             }
         }
 
-        _initCollection(opCtx, entry.catalogId, entry.nss, _options.forRepair, minVisibleTs);
+        collectionsToLoad.push_back({std::move(entry), minVisibleTs, nullptr});
+    }
+    const auto readCatalogMillis = timer.millis();
+
+    // Open the record stores of the collections from a pool of threads, one batch of collections
+    // of a single database at a time. The oplog is opened on this thread, since opening it also
+    // sets up its truncation.
+    std::map<std::string, std::vector<CollectionToLoad*>> collectionsByDb;
+    for (auto&& toLoad : collectionsToLoad) {
+        if (toLoad.entry.nss.isOplog()) {
+            toLoad.collection = _makeCollection(opCtx,
+                                                toLoad.entry.catalogId,
+                                                toLoad.entry.nss,
+                                                _options.forRepair,
+                                                toLoad.minVisibleTs);
+        } else {
+            collectionsByDb[toLoad.entry.nss.db().toString()].push_back(&toLoad);
+        }
+    }
+
+    const size_t kCollectionsPerBatch = 100;
+    std::vector<std::vector<CollectionToLoad*>> batches;
+    for (auto&& [dbName, collections] : collectionsByDb) {
+        for (size_t i = 0; i < collections.size(); i += kCollectionsPerBatch) {
+            auto end = std::min(collections.size(), i + kCollectionsPerBatch);
+            batches.emplace_back(collections.begin() + i, collections.begin() + end);
+        }
+    }
+
+    const size_t numThreads = gCatalogLoadThreads.load();
+    runCatalogLoadTasks(
+        opCtx,
+        "CatalogLoader",
+        numThreads,
+        batches,
+        [&](OperationContext* taskOpCtx, std::vector<CollectionToLoad*>& batch) {
+            // The storage engine is not yet installed on the ServiceContext when it loads the
+            // catalog at startup, so operations made since have no recovery unit.
+            if (taskOpCtx->recoveryUnit()->isNoop()) {
+                taskOpCtx->setRecoveryUnit(
+                    std::unique_ptr<RecoveryUnit>(_engine->newRecoveryUnit()),
+                    WriteUnitOfWork::RecoveryUnitState::kNotInUnitOfWork);
+            }
+            for (auto toLoad : batch) {
+                toLoad->collection = _makeCollection(taskOpCtx,
+                                                     toLoad->entry.catalogId,
+                                                     toLoad->entry.nss,
+                                                     _options.forRepair,
+                                                     toLoad->minVisibleTs);
+            }
+        });
+    const auto openCollectionsMillis = timer.millis() - readCatalogMillis;
 
-        if (entry.nss.isOrphanCollection()) {
+    // Register every collection in a single catalog write, rather than copying the catalog once
+    // per collection.
+    CollectionCatalog::write(opCtx, [&](CollectionCatalog& catalog) {
+        for (auto&& toLoad : collectionsToLoad) {
+            auto uuid = toLoad.collection->uuid();
+            catalog.registerCollection(opCtx, uuid, std::move(toLoad.collection));
+        }
+    });
+
+    for (auto&& toLoad : collectionsToLoad) {
+        if (toLoad.entry.nss.isOrphanCollection()) {
             LOGV2(22248,
                   "Orphaned collection found: {namespace}",
                   "Orphaned collection found",
-                  "namespace"_attr = entry.nss);
+                  "namespace"_attr = toLoad.entry.nss);
         }
     }
 
     opCtx->recoveryUnit()->abandonSnapshot();
-}
 
-void StorageEngineImpl::_initCollection(OperationContext* opCtx,
-                                        RecordId catalogId,
-                                        const NamespaceString& nss,
-                                        bool forRepair,
-                                        Timestamp minVisibleTs) {
+    LOGV2(5591701,
+          "Loaded the catalog",
+          "numCollections"_attr = collectionsToLoad.size(),
+          "numThreads"_attr = std::min(numThreads, batches.size()),
+          "readCatalogDurationMillis"_attr = readCatalogMillis,
+          "openCollectionsDurationMillis"_attr = openCollectionsMillis,
+          "registerCollectionsDurationMillis"_attr =
+              timer.millis() - readCatalogMillis - openCollectionsMillis);
+}
+
+std::shared_ptr<Collection> StorageEngineImpl::_makeCollection(OperationContext* opCtx,
+                                                               RecordId catalogId,
+                                                               const NamespaceString& nss,
+                                                               bool forRepair,
+                                                               Timestamp minVisibleTs) {
     BSONCollectionCatalogEntry::MetaData md = _catalog->getMetaData(opCtx, catalogId);
     uassert(ErrorCodes::MustDowngrade,
             str::stream() << "Collection does not have UUID in KVCatalog. Collection: " << nss,
@@ -326,10 +408,7 @@ void StorageEngineImpl::_initCollection(OperationContext* opCtx,
     auto collectionFactory = Collection::Factory::get(getGlobalServiceContext());
     auto collection = collectionFactory->make(opCtx, nss, catalogId, uuid, std::move(rs));
     collection->setMinimumVisibleSnapshot(minVisibleTs);
-
-    CollectionCatalog::write(opCtx, [&](CollectionCatalog& catalog) {
-        catalog.registerCollection(opCtx, uuid, std::move(collection));
-    });
+    return collection;
 }
 
 void StorageEngineImpl::closeCatalog(OperationContext* opCtx) {
@@ -1050,6 +1129,12 @@ void StorageEngineImpl::clearDropPendingState() {
     _dropPendingIdentReaper.clearDropPendingState();
 }
 
+void StorageEngineImpl::appendDropPendingIdentStats(BSONObjBuilder* builder) const {
+    _dropPendingIdentReaper.appendStats(builder);
+    BSONObjBuilder engineBuilder(builder->subobjStart("engineQueue"));
+    _engine->appendDropQueueStats(&engineBuilder);
+}
+
 Timestamp StorageEngineImpl::getAllDurableTimestamp() const {
     return _engine->getAllDurableTimestamp();
 }
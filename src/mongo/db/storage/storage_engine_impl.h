@@ -51,6 +51,7 @@
 
 namespace mongo {
 
+class Collection;
 class DurableCatalogImpl;
 class KVEngine;
 
@@ -354,6 +355,8 @@ public:
         return _dropPendingIdentReaper.getAllIdentNames();
     }
 
+    void appendDropPendingIdentStats(BSONObjBuilder* builder) const override;
+
     Status currentFilesCompatible(OperationContext* opCtx) const override {
         // Delegate to the FeatureTracker as to whether the data files are compatible or not.
         return _catalog->getFeatureTracker()->isCompatibleWithCurrentCode(opCtx);
@@ -375,11 +378,11 @@ public:
 private:
     using CollIter = std::list<std::string>::iterator;
 
-    void _initCollection(OperationContext* opCtx,
-                         RecordId catalogId,
-                         const NamespaceString& nss,
-                         bool forRepair,
-                         Timestamp minVisibleTs);
+    std::shared_ptr<Collection> _makeCollection(OperationContext* opCtx,
+                                                RecordId catalogId,
+                                                const NamespaceString& nss,
+                                                bool forRepair,
+                                                Timestamp minVisibleTs);
 
     Status _dropCollectionsNoTimestamp(OperationContext* opCtx,
                                        std::vector<NamespaceString>& toDrop);
@@ -172,6 +172,7 @@ public:
     std::set<std::string> getDropPendingIdents() const final {
         return {};
     }
+    void appendDropPendingIdentStats(BSONObjBuilder* builder) const final {}
     void addDropPendingIdent(const Timestamp& dropTimestamp,
                              const NamespaceString& nss,
                              std::shared_ptr<Ident> ident,
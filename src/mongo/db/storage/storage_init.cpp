@@ -34,6 +34,7 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/backup_cursor_hooks.h"
+#include "mongo/db/storage/checkpointer.h"
 #include "mongo/db/storage/storage_engine.h"
 #include "mongo/db/storage/storage_options.h"
 
@@ -67,6 +68,10 @@ public:
         bob.append("supportsPendingDrops", engine->supportsPendingDrops());
         bob.append("dropPendingIdents",
                    static_cast<long long>(engine->getDropPendingIdents().size()));
+        {
+            BSONObjBuilder reaperBuilder(bob.subobjStart("dropPendingIdentReaper"));
+            engine->appendDropPendingIdentStats(&reaperBuilder);
+        }
         bob.append("supportsSnapshotReadConcern", engine->supportsReadConcernSnapshot());
         bob.append("readOnly", storageGlobalParams.readOnly);
         bob.append("persistent", !engine->isEphemeral());
@@ -74,6 +79,10 @@ public:
         if (serverGlobalParams.featureCompatibility.isVersionInitialized()) {
             bob.append("supportsResumableIndexBuilds", engine->supportsResumableIndexBuilds());
         }
+        if (auto checkpointer = Checkpointer::get(svcCtx)) {
+            BSONObjBuilder checkpointerBuilder(bob.subobjStart("checkpointer"));
+            checkpointer->appendStats(&checkpointerBuilder);
+        }
 
         return bob.obj();
     }
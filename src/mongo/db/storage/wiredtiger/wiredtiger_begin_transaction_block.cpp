@@ -40,7 +40,83 @@
 #include "mongo/util/errno_util.h"
 
 namespace mongo {
-using namespace fmt::literals;
+namespace {
+
+/**
+ * The begin_transaction configuration strings for every combination of the options of a
+ * WiredTigerBeginTxnBlock. They are built once, at startup, rather than every time a transaction is
+ * opened.
+ */
+class BeginTxnConfigStrings {
+public:
+    BeginTxnConfigStrings() {
+        for (size_t prepare = 0; prepare < kNumPrepareConflictBehaviors; ++prepare) {
+            for (size_t prepared = 0; prepared < kNumRoundUpPreparedTimestamps; ++prepared) {
+                for (size_t read = 0; read < kNumRoundUpReadTimestamps; ++read) {
+                    _configs[prepare][prepared][read] = _build(
+                        static_cast<PrepareConflictBehavior>(prepare),
+                        static_cast<WiredTigerBeginTxnBlock::RoundUpPreparedTimestamps>(prepared),
+                        static_cast<WiredTigerBeginTxnBlock::RoundUpReadTimestamp>(read));
+                }
+            }
+        }
+    }
+
+    const char* get(PrepareConflictBehavior prepareConflictBehavior,
+                    WiredTigerBeginTxnBlock::RoundUpPreparedTimestamps roundUpPreparedTimestamps,
+                    WiredTigerBeginTxnBlock::RoundUpReadTimestamp roundUpReadTimestamp) const {
+        return _configs[static_cast<size_t>(prepareConflictBehavior)]
+                       [static_cast<size_t>(roundUpPreparedTimestamps)]
+                       [static_cast<size_t>(roundUpReadTimestamp)]
+                           .c_str();
+    }
+
+private:
+    static constexpr size_t kNumPrepareConflictBehaviors =
+        static_cast<size_t>(PrepareConflictBehavior::kIgnoreConflictsAllowWrites) + 1;
+    static constexpr size_t kNumRoundUpPreparedTimestamps =
+        static_cast<size_t>(WiredTigerBeginTxnBlock::RoundUpPreparedTimestamps::kRound) + 1;
+    static constexpr size_t kNumRoundUpReadTimestamps =
+        static_cast<size_t>(WiredTigerBeginTxnBlock::RoundUpReadTimestamp::kRound) + 1;
+
+    static std::string _build(
+        PrepareConflictBehavior prepareConflictBehavior,
+        WiredTigerBeginTxnBlock::RoundUpPreparedTimestamps roundUpPreparedTimestamps,
+        WiredTigerBeginTxnBlock::RoundUpReadTimestamp roundUpReadTimestamp) {
+        using RoundUpPreparedTimestamps = WiredTigerBeginTxnBlock::RoundUpPreparedTimestamps;
+        using RoundUpReadTimestamp = WiredTigerBeginTxnBlock::RoundUpReadTimestamp;
+
+        str::stream builder;
+        if (prepareConflictBehavior == PrepareConflictBehavior::kIgnoreConflicts) {
+            builder << "ignore_prepare=true,";
+        } else if (prepareConflictBehavior ==
+                   PrepareConflictBehavior::kIgnoreConflictsAllowWrites) {
+            builder << "ignore_prepare=force,";
+        }
+        if (roundUpPreparedTimestamps == RoundUpPreparedTimestamps::kRound ||
+            roundUpReadTimestamp == RoundUpReadTimestamp::kRound) {
+            builder << "roundup_timestamps=(";
+            if (roundUpPreparedTimestamps == RoundUpPreparedTimestamps::kRound) {
+                builder << "prepared=true,";
+            }
+            if (roundUpReadTimestamp == RoundUpReadTimestamp::kRound) {
+                builder << "read=true";
+            }
+            builder << "),";
+        }
+        if (roundUpReadTimestamp == RoundUpReadTimestamp::kNoRoundForce) {
+            builder << "read_before_oldest=true,";
+        }
+        return builder;
+    }
+
+    std::string _configs[kNumPrepareConflictBehaviors][kNumRoundUpPreparedTimestamps]
+                        [kNumRoundUpReadTimestamps];
+};
+
+const BeginTxnConfigStrings kBeginTxnConfigStrings;
+
+}  // namespace
 
 WiredTigerBeginTxnBlock::WiredTigerBeginTxnBlock(
     WT_SESSION* session,
@@ -49,30 +125,10 @@ WiredTigerBeginTxnBlock::WiredTigerBeginTxnBlock(
     RoundUpReadTimestamp roundUpReadTimestamp)
     : _session(session) {
     invariant(!_rollback);
-
-    str::stream builder;
-    if (prepareConflictBehavior == PrepareConflictBehavior::kIgnoreConflicts) {
-        builder << "ignore_prepare=true,";
-    } else if (prepareConflictBehavior == PrepareConflictBehavior::kIgnoreConflictsAllowWrites) {
-        builder << "ignore_prepare=force,";
-    }
-    if (roundUpPreparedTimestamps == RoundUpPreparedTimestamps::kRound ||
-        roundUpReadTimestamp == RoundUpReadTimestamp::kRound) {
-        builder << "roundup_timestamps=(";
-        if (roundUpPreparedTimestamps == RoundUpPreparedTimestamps::kRound) {
-            builder << "prepared=true,";
-        }
-        if (roundUpReadTimestamp == RoundUpReadTimestamp::kRound) {
-            builder << "read=true";
-        }
-        builder << "),";
-    }
-    if (roundUpReadTimestamp == RoundUpReadTimestamp::kNoRoundForce) {
-        builder << "read_before_oldest=true,";
-    }
-
-    const std::string beginTxnConfigString = builder;
-    invariantWTOK(_session->begin_transaction(_session, beginTxnConfigString.c_str()));
+    invariantWTOK(_session->begin_transaction(
+        _session,
+        kBeginTxnConfigStrings.get(
+            prepareConflictBehavior, roundUpPreparedTimestamps, roundUpReadTimestamp)));
     _rollback = true;
 }
 
@@ -91,9 +147,12 @@ WiredTigerBeginTxnBlock::~WiredTigerBeginTxnBlock() {
 
 Status WiredTigerBeginTxnBlock::setReadSnapshot(Timestamp readTimestamp) {
     invariant(_rollback);
-    std::string readTSConfigString = "read_timestamp={:x}"_format(readTimestamp.asULL());
+    // Formatted in the inline storage of the buffer, without allocating.
+    fmt::memory_buffer readTSConfigString;
+    fmt::format_to(readTSConfigString, "read_timestamp={:x}", readTimestamp.asULL());
+    readTSConfigString.push_back('\0');
 
-    return wtRCToStatus(_session->timestamp_transaction(_session, readTSConfigString.c_str()));
+    return wtRCToStatus(_session->timestamp_transaction(_session, readTSConfigString.data()));
 }
 
 void WiredTigerBeginTxnBlock::done() {
@@ -122,6 +122,8 @@ void BM_WiredTigerBeginTxnBlock(benchmark::State& state) {
 }
 
 using mongo::WiredTigerBeginTxnBlock;
+using RoundUpPreparedTimestamps = WiredTigerBeginTxnBlock::RoundUpPreparedTimestamps;
+using RoundUpReadTimestamp = WiredTigerBeginTxnBlock::RoundUpReadTimestamp;
 
 template <PrepareConflictBehavior behavior, RoundUpPreparedTimestamps round>
 void BM_WiredTigerBeginTxnBlockWithArgs(benchmark::State& state) {
@@ -131,6 +133,15 @@ void BM_WiredTigerBeginTxnBlockWithArgs(benchmark::State& state) {
     }
 }
 
+void BM_WiredTigerBeginTxnBlockRoundUpReadTimestamp(benchmark::State& state) {
+    WiredTigerTestHelper helper;
+    for (auto _ : state) {
+        WiredTigerBeginTxnBlock beginTxn(helper.wtSession(),
+                                         PrepareConflictBehavior::kEnforce,
+                                         RoundUpPreparedTimestamps::kNoRound,
+                                         RoundUpReadTimestamp::kRound);
+    }
+}
 
 void BM_setTimestamp(benchmark::State& state) {
     WiredTigerTestHelper helper;
@@ -160,6 +171,7 @@ BENCHMARK_TEMPLATE(BM_WiredTigerBeginTxnBlockWithArgs,
                    PrepareConflictBehavior::kIgnoreConflictsAllowWrites,
                    RoundUpPreparedTimestamps::kRound);
 
+BENCHMARK(BM_WiredTigerBeginTxnBlockRoundUpReadTimestamp);
 BENCHMARK(BM_setTimestamp);
 
 }  // namespace
@@ -365,6 +365,10 @@ WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
     ss << "file_manager=(close_idle_time=" << gWiredTigerFileHandleCloseIdleTime
        << ",close_scan_interval=" << gWiredTigerFileHandleCloseScanInterval
        << ",close_handle_minimum=" << gWiredTigerFileHandleCloseMinimum << "),";
+    if (gWiredTigerCheckpointIOBudgetMBPerSec > 0) {
+        ss << "io_capacity=(total="
+           << static_cast<long long>(gWiredTigerCheckpointIOBudgetMBPerSec) * 1024 * 1024 << "),";
+    }
     ss << "statistics_log=(wait=" << wiredTigerGlobalOptions.statisticsLogDelaySecs << "),";
 
     if (shouldLog(::mongo::logv2::LogComponent::kStorageRecovery, logv2::LogSeverity::Debug(3))) {
@@ -510,6 +514,16 @@ WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
     _sessionSweeper = std::make_unique<WiredTigerSessionSweeper>(_sessionCache.get());
     _sessionSweeper->go();
 
+    if (!_readOnly && gWiredTigerRecordPrefetchThreads > 0) {
+        ThreadPool::Options options;
+        options.poolName = "WiredTigerRecordPrefetch";
+        options.threadNamePrefix = "WTRecordPrefetch-";
+        options.minThreads = 0;
+        options.maxThreads = gWiredTigerRecordPrefetchThreads;
+        _prefetchThreadPool = std::make_unique<ThreadPool>(options);
+        _prefetchThreadPool->startup();
+    }
+
     // Until the Replication layer installs a real callback, prevent truncating the oplog.
     setOldestActiveTransactionTimestampCallback(
         [](Timestamp) { return StatusWith(boost::make_optional(Timestamp::min())); });
@@ -598,6 +612,7 @@ void WiredTigerKVEngine::appendGlobalStats(BSONObjBuilder& b) {
         bbb.append("out", openWriteTransaction.used());
         bbb.append("available", openWriteTransaction.available());
         bbb.append("totalTickets", openWriteTransaction.outof());
+        openWriteTransaction.appendStats(&bbb);
         bbb.done();
     }
     {
@@ -605,6 +620,7 @@ void WiredTigerKVEngine::appendGlobalStats(BSONObjBuilder& b) {
         bbb.append("out", openReadTransaction.used());
         bbb.append("available", openReadTransaction.available());
         bbb.append("totalTickets", openReadTransaction.outof());
+        openReadTransaction.appendStats(&bbb);
         bbb.done();
     }
     bb.done();
@@ -717,6 +733,10 @@ void WiredTigerKVEngine::cleanShutdown() {
         _sessionSweeper->shutdown();
         LOGV2(22319, "Finished shutting down session sweeper thread");
     }
+    if (_prefetchThreadPool) {
+        _prefetchThreadPool->shutdown();
+        _prefetchThreadPool->join();
+    }
     LOGV2_FOR_RECOVERY(23988,
                        2,
                        "Shutdown timestamps.",
@@ -1313,6 +1333,53 @@ void WiredTigerKVEngine::syncSizeInfo(bool sync) const {
     }
 }
 
+namespace {
+// Bounds the work prefetch requests can queue up when queries issue them faster than the disk
+// serves them. Requests beyond the bound are dropped, which only costs the queries a cache miss.
+const int kMaxQueuedPrefetches = 256;
+}  // namespace
+
+void WiredTigerKVEngine::prefetchRecords(const std::string& uri, std::vector<RecordId> ids) {
+    if (!_prefetchThreadPool || ids.empty()) {
+        return;
+    }
+    if (_numQueuedPrefetches.fetchAndAdd(1) >= kMaxQueuedPrefetches) {
+        _numQueuedPrefetches.fetchAndSubtract(1);
+        return;
+    }
+
+    _prefetchThreadPool->schedule([this, uri, ids = std::move(ids)](Status status) {
+        ON_BLOCK_EXIT([&] { _numQueuedPrefetches.fetchAndSubtract(1); });
+        if (!status.isOK()) {
+            return;
+        }
+
+        UniqueWiredTigerSession session = _sessionCache->getSession();
+        WT_SESSION* wtSession = session->getSession();
+
+        // Open the cursor directly rather than through the session's cursor cache so that it does
+        // not keep the table open, and delay a drop, after the reads are done. The table may have
+        // been dropped since the request was made, in which case there is nothing to read.
+        WT_CURSOR* cursor;
+        if (wtSession->open_cursor(wtSession, uri.c_str(), nullptr, nullptr, &cursor) != 0) {
+            return;
+        }
+        ON_BLOCK_EXIT([&] { cursor->close(cursor); });
+
+        for (const auto& id : ids) {
+            id.withFormat([](RecordId::Null n) { MONGO_UNREACHABLE; },
+                          [&](int64_t rid) { cursor->set_key(cursor, rid); },
+                          [&](const char* str, int size) {
+                              WiredTigerItem item(str, size);
+                              cursor->set_key(cursor, item.Get());
+                          });
+            // The search brings the record into the cache. Whether it finds the record, or hits a
+            // prepare conflict, does not matter to the query that will read it.
+            cursor->search(cursor);
+        }
+    });
+}
+
 void WiredTigerKVEngine::setOldestActiveTransactionTimestampCallback(
     StorageEngine::OldestActiveTransactionTimestampCallback callback) {
     stdx::lock_guard<Latch> lk(_oldestActiveTransactionTimestampCallbackMutex);
@@ -1642,10 +1709,13 @@ Status WiredTigerKVEngine::dropIdent(RecoveryUnit* ru,
     wtRu->getSessionNoTxn()->closeAllCursors(uri);
     _sessionCache->closeAllCursors(uri);
 
-    WiredTigerSession session(_conn);
-
-    int ret = session.getSession()->drop(
-        session.getSession(), uri.c_str(), "force,checkpoint_wait=false");
+    // The drop would fail with EBUSY while a checkpoint runs, so queue it up without trying.
+    int ret = EBUSY;
+    if (!_checkpointInProgress.load()) {
+        WiredTigerSession session(_conn);
+        ret = session.getSession()->drop(
+            session.getSession(), uri.c_str(), "force,checkpoint_wait=false");
+    }
     LOGV2_DEBUG(22338, 1, "WT drop", "uri"_attr = uri, "ret"_attr = ret);
 
     if (ret == EBUSY) {
@@ -1654,6 +1724,7 @@ Status WiredTigerKVEngine::dropIdent(RecoveryUnit* ru,
             stdx::lock_guard<Latch> lk(_identToDropMutex);
             _identToDrop.push_front({std::move(uri), std::move(onDrop)});
         }
+        _numDropsQueued.fetchAndAdd(1);
         _sessionCache->closeCursorsForQueuedDrops();
         return Status::OK();
     }
@@ -1738,8 +1809,13 @@ bool WiredTigerKVEngine::haveDropsQueued() const {
         syncSizeInfo(false);
     }
 
-    // We only want to check the queue max once per second or we'll thrash
-    if (delta < Milliseconds(1000))
+    // Queued drops cannot complete while a checkpoint runs.
+    if (_checkpointInProgress.load())
+        return false;
+
+    // We only want to check the queue max once per second or we'll thrash, unless a checkpoint
+    // just ended and the drops it held up are likely to complete now.
+    if (delta < Milliseconds(1000) && !_retryQueuedDropsAfterCheckpoint.swap(false))
         return false;
 
     _previousCheckedDropsQueued = now;
@@ -1770,6 +1846,10 @@ void WiredTigerKVEngine::dropSomeQueuedIdents() {
                 "numInQueue"_attr = numInQueue,
                 "numToDelete"_attr = numToDelete);
     for (int i = 0; i < numToDelete; i++) {
+        // Leave the remaining drops for after the checkpoint rather than failing each of them.
+        if (_checkpointInProgress.load())
+            break;
+
         IdentToDrop identToDrop;
         {
             stdx::lock_guard<Latch> lk(_identToDropMutex);
@@ -1787,6 +1867,7 @@ void WiredTigerKVEngine::dropSomeQueuedIdents() {
             _identToDrop.push_back(std::move(identToDrop));
         } else {
             invariantWTOK(ret);
+            _numQueuedDropsCompleted.fetchAndAdd(1);
             if (identToDrop.callback) {
                 identToDrop.callback();
             }
@@ -1794,11 +1875,26 @@ void WiredTigerKVEngine::dropSomeQueuedIdents() {
     }
 }
 
+void WiredTigerKVEngine::appendDropQueueStats(BSONObjBuilder* builder) const {
+    {
+        stdx::lock_guard<Latch> lk(_identToDropMutex);
+        builder->append("queued", static_cast<long long>(_identToDrop.size()));
+    }
+    builder->append("totalQueued", _numDropsQueued.load());
+    builder->append("totalQueuedCompleted", _numQueuedDropsCompleted.load());
+}
+
 bool WiredTigerKVEngine::supportsDirectoryPerDB() const {
     return true;
 }
 
 void WiredTigerKVEngine::checkpoint() {
+    _checkpointInProgress.store(true);
+    ON_BLOCK_EXIT([&] {
+        _checkpointInProgress.store(false);
+        _retryQueuedDropsAfterCheckpoint.store(true);
+    });
+
     const Timestamp stableTimestamp = getStableTimestamp();
     const Timestamp initialDataTimestamp = getInitialDataTimestamp();
 
@@ -1866,6 +1962,30 @@ void WiredTigerKVEngine::checkpoint() {
     }
 }
 
+boost::optional<double> WiredTigerKVEngine::getDirtyCacheRatio() const {
+    auto session = _sessionCache->getSession();
+    auto dirty = WiredTigerUtil::getStatisticsValue(
+        session->getSession(), "statistics:", "statistics=(fast)", WT_STAT_CONN_CACHE_BYTES_DIRTY);
+    auto max = WiredTigerUtil::getStatisticsValue(
+        session->getSession(), "statistics:", "statistics=(fast)", WT_STAT_CONN_CACHE_BYTES_MAX);
+    if (!dirty.isOK() || !max.isOK() || max.getValue() <= 0) {
+        return boost::none;
+    }
+    return static_cast<double>(dirty.getValue()) / max.getValue();
+}
+
+boost::optional<long long> WiredTigerKVEngine::getCheckpointBytesWritten() const {
+    auto session = _sessionCache->getSession();
+    auto written = WiredTigerUtil::getStatisticsValue(session->getSession(),
+                                                      "statistics:",
+                                                      "statistics=(fast)",
+                                                      WT_STAT_CONN_BLOCK_BYTE_WRITE_CHECKPOINT);
+    if (!written.isOK()) {
+        return boost::none;
+    }
+    return written.getValue();
+}
+
 bool WiredTigerKVEngine::hasIdent(OperationContext* opCtx, StringData ident) const {
     return _hasUri(WiredTigerRecoveryUnit::get(opCtx)->getSession()->getSession(), _uri(ident));
 }
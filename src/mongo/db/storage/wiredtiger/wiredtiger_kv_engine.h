@@ -45,7 +45,9 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_oplog_manager.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/concurrency/with_lock.h"
 #include "mongo/util/elapsed_tracker.h"
 
@@ -120,6 +122,10 @@ public:
 
     void checkpoint() override;
 
+    boost::optional<double> getDirtyCacheRatio() const override;
+
+    boost::optional<long long> getCheckpointBytesWritten() const override;
+
     bool isDurable() const override {
         return _durable;
     }
@@ -281,8 +287,17 @@ public:
         std::list<WiredTigerCachedCursor>* cache);
     bool haveDropsQueued() const;
 
+    void appendDropQueueStats(BSONObjBuilder* builder) const override;
+
     void syncSizeInfo(bool sync) const;
 
+    /**
+     * Reads the records with the given ids from the table at 'uri' on a background thread, so
+     * that they are in the cache by the time a query reads them. Drops the request if prefetching
+     * is disabled or too many requests are already queued.
+     */
+    void prefetchRecords(const std::string& uri, std::vector<RecordId> ids);
+
     /*
      * The oplog manager is always accessible, but this method will start the background thread to
      * control oplog entry visibility for reads.
@@ -465,6 +480,10 @@ private:
 
     std::unique_ptr<WiredTigerSessionSweeper> _sessionSweeper;
 
+    // Serves prefetchRecords() requests. Null if prefetching is disabled, or in read-only mode.
+    std::unique_ptr<ThreadPool> _prefetchThreadPool;
+    AtomicWord<int> _numQueuedPrefetches{0};
+
     std::string _rsOptions;
     std::string _indexOptions;
 
@@ -473,6 +492,18 @@ private:
 
     mutable Date_t _previousCheckedDropsQueued;
 
+    // Set while checkpoint() runs. A drop cannot complete while a checkpoint runs, so dropIdent()
+    // queues the drop without trying it and dropSomeQueuedIdents() stops until the checkpoint ends.
+    AtomicWord<bool> _checkpointInProgress{false};
+
+    // Set when a checkpoint ends, so that the queued drops are retried at the next session release
+    // rather than at the next once per second check.
+    mutable AtomicWord<bool> _retryQueuedDropsAfterCheckpoint{false};
+
+    // Cumulative number of drops that were queued, and of queued drops that have since completed.
+    AtomicWord<long long> _numDropsQueued{0};
+    AtomicWord<long long> _numQueuedDropsCompleted{0};
+
     std::unique_ptr<WiredTigerSession> _backupSession;
     WiredTigerBackup _wtBackup;
 
@@ -44,6 +44,7 @@
 #include "mongo/db/service_context.h"
 #include "mongo/db/service_context_test_fixture.h"
 #include "mongo/db/storage/checkpointer.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/logv2/log.h"
@@ -51,6 +52,7 @@
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/clock_source_mock.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -349,6 +351,64 @@ TEST_F(WiredTigerKVEngineTest, TestOplogTruncation) {
     checkpointer->shutdown({ErrorCodes::ShutdownInProgress, "Test finished"});
 }
 
+TEST_F(WiredTigerKVEngineTest, DirtyCacheTriggersCheckpoint) {
+    auto opCtxPtr = _makeOperationContext();
+
+    // Only the dirty cache trigger can take a checkpoint within the duration of the test.
+    const auto originalDelaySecs = storageGlobalParams.checkpointDelaySecs;
+    storageGlobalParams.checkpointDelaySecs = 1000;
+    gCheckpointDirtyCacheTriggerPercent.store(0.01);
+    ON_BLOCK_EXIT([&] {
+        gCheckpointDirtyCacheTriggerPercent.store(0);
+        storageGlobalParams.checkpointDelaySecs = originalDelaySecs;
+    });
+
+    NamespaceString nss("a.b");
+    std::string ident = "collection-1234";
+    CollectionOptions defaultCollectionOptions;
+    ASSERT_OK(
+        _engine->createRecordStore(opCtxPtr.get(), nss.ns(), ident, defaultCollectionOptions));
+    auto rs = _engine->getRecordStore(opCtxPtr.get(), nss.ns(), ident, defaultCollectionOptions);
+    ASSERT(rs);
+
+    const std::string record(1024, 'x');
+    {
+        WriteUnitOfWork uow(opCtxPtr.get());
+        for (int i = 0; i < 100; ++i) {
+            StatusWith<RecordId> res =
+                rs->insertRecord(opCtxPtr.get(), record.c_str(), record.length() + 1, Timestamp());
+            ASSERT_OK(res.getStatus());
+        }
+        uow.commit();
+    }
+
+    auto dirtyRatio = _engine->getDirtyCacheRatio();
+    ASSERT(dirtyRatio);
+    ASSERT_GTE(*dirtyRatio, 0);
+    ASSERT_LTE(*dirtyRatio, 1);
+    auto bytesWrittenBefore = _engine->getCheckpointBytesWritten();
+    ASSERT(bytesWrittenBefore);
+
+    auto checkpointer = std::make_unique<Checkpointer>(_engine);
+    checkpointer->go();
+
+    BSONObj stats;
+    for (int i = 0; i < 100; ++i) {
+        BSONObjBuilder builder;
+        checkpointer->appendStats(&builder);
+        stats = builder.obj();
+        if (stats["numDirtyCacheTriggeredCheckpoints"].numberLong() > 0) {
+            break;
+        }
+        sleepmillis(100);
+    }
+    ASSERT_GT(stats["numDirtyCacheTriggeredCheckpoints"].numberLong(), 0) << stats;
+    ASSERT_GT(stats["durationMillis"].Array().size(), 0U) << stats;
+    ASSERT_GT(*_engine->getCheckpointBytesWritten(), *bytesWrittenBefore);
+
+    checkpointer->shutdown({ErrorCodes::ShutdownInProgress, "Test finished"});
+}
+
 TEST_F(WiredTigerKVEngineTest, IdentDrop) {
 #ifdef _WIN32
     // TODO SERVER-51595: to re-enable this test on Windows.
@@ -36,6 +36,7 @@
 #include "mongo/db/concurrency/lock_state.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_oplog_manager.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 #include "mongo/logv2/log.h"
 #include "mongo/platform/mutex.h"
@@ -77,9 +78,11 @@ void WiredTigerOplogManager::startVisibilityThread(OperationContext* opCtx,
     // Need to obtain the mutex before starting the thread, as otherwise it may race ahead
     // see _shuttingDown as true and quit prematurely.
     stdx::lock_guard<Latch> lk(_oplogVisibilityStateMutex);
+    _sessionCache = WiredTigerRecoveryUnit::get(opCtx)->getSessionCache();
+    _oplogRecordStore = oplogRecordStore;
     _oplogVisibilityThread = stdx::thread(&WiredTigerOplogManager::_updateOplogVisibilityLoop,
                                           this,
-                                          WiredTigerRecoveryUnit::get(opCtx)->getSessionCache(),
+                                          _sessionCache,
                                           oplogRecordStore);
 
     _isRunning = true;
@@ -88,7 +91,7 @@ void WiredTigerOplogManager::startVisibilityThread(OperationContext* opCtx,
 
 void WiredTigerOplogManager::haltVisibilityThread() {
     {
-        stdx::lock_guard<Latch> lk(_oplogVisibilityStateMutex);
+        stdx::unique_lock<Latch> lk(_oplogVisibilityStateMutex);
         if (!_isRunning) {
             // This is called from two places; on clean shutdown and when the record store for the
             // oplog is destroyed. We will perform the actual shutdown on the first call and the
@@ -102,6 +105,9 @@ void WiredTigerOplogManager::haltVisibilityThread() {
 
         _shuttingDown = true;
         _isRunning = false;
+
+        // A committing thread may still be using the oplog record store to notify waiters.
+        _updateOnCommitDoneCV.wait(lk, [&] { return !_updatingOnCommit; });
     }
 
     if (_oplogVisibilityThread.joinable()) {
@@ -111,13 +117,71 @@ void WiredTigerOplogManager::haltVisibilityThread() {
 }
 
 void WiredTigerOplogManager::triggerOplogVisibilityUpdate() {
-    stdx::lock_guard<Latch> lk(_oplogVisibilityStateMutex);
+    stdx::unique_lock<Latch> lk(_oplogVisibilityStateMutex);
+    if (_shouldUpdateVisibilityOnCommit(lk)) {
+        if (_updatingOnCommit) {
+            // Another commit is already updating visibility. Have it fetch all_durable again once
+            // it is done, so that this commit is accounted for.
+            _updateOnCommitRequested = true;
+            return;
+        }
+        _updateVisibilityOnCommit(lk);
+        return;
+    }
+
     if (!_triggerOplogVisibilityUpdate) {
         _triggerOplogVisibilityUpdate = true;
         _oplogVisibilityThreadCV.notify_one();
     }
 }
 
+bool WiredTigerOplogManager::_shouldUpdateVisibilityOnCommit(WithLock) const {
+    if (!_isRunning || _shuttingDown || !gWiredTigerOplogVisibilityUpdateOnCommit.load()) {
+        return false;
+    }
+    if (_visibilityWaiters.empty() && !_oplogRecordStore->haveCappedWaiters()) {
+        // Nobody is waiting, so let the visibility thread batch updates to reduce system load.
+        return false;
+    }
+    return !MONGO_unlikely(WTPauseOplogVisibilityUpdateLoop.shouldFail());
+}
+
+void WiredTigerOplogManager::_updateVisibilityOnCommit(stdx::unique_lock<Latch>& lk) {
+    invariant(!_updatingOnCommit);
+    _updatingOnCommit = true;
+    _updateOnCommitRequested = false;
+    lk.unlock();
+
+    // Fetch the all_durable timestamp from the storage engine, which is guaranteed not to have any
+    // holes behind it in-memory.
+    const uint64_t newTimestamp = _sessionCache->getKVEngine()->getAllDurableTimestamp().asULL();
+
+    lk.lock();
+    const bool advanced = newTimestamp > getOplogReadTimestamp();
+    if (advanced) {
+        _setOplogReadTimestamp(lk, newTimestamp);
+    }
+    lk.unlock();
+
+    // Wake up any awaitData cursors and tell them more data might be visible now.
+    if (advanced) {
+        _oplogRecordStore->notifyCappedWaitersIfNeeded();
+    }
+
+    lk.lock();
+    _updatingOnCommit = false;
+    if (_updateOnCommitRequested && !_triggerOplogVisibilityUpdate) {
+        // Commits arrived while all_durable was being fetched. Rather than making this commit
+        // wait for another round, hand them to the visibility thread, which skips its batching
+        // delay while there are waiters.
+        _triggerOplogVisibilityUpdate = true;
+        _oplogVisibilityThreadCV.notify_one();
+    }
+    _updateOnCommitRequested = false;
+    _updateOnCommitDoneCV.notify_all();
+    lk.unlock();
+}
+
 void WiredTigerOplogManager::waitForAllEarlierOplogWritesToBeVisible(
     const WiredTigerRecordStore* oplogRecordStore, OperationContext* opCtx) {
     invariant(opCtx->lockState()->isNoop() || !opCtx->lockState()->inAWriteUnitOfWork());
@@ -142,19 +206,28 @@ void WiredTigerOplogManager::waitForAllEarlierOplogWritesToBeVisible(
     // Close transaction before we wait.
     opCtx->recoveryUnit()->abandonSnapshot();
 
+    // Registering as a waiter prevents any scheduled oplog visibility updates from being delayed
+    // for batching and blocking this wait excessively, and makes the commits that fill oplog holes
+    // update visibility themselves. Only this waiter's condition variable is signaled once
+    // 'waitingFor' becomes visible.
+    stdx::condition_variable becameVisibleCV;
     stdx::unique_lock<Latch> lk(_oplogVisibilityStateMutex);
+    auto waiterIt = _visibilityWaiters.emplace(
+        static_cast<std::uint64_t>(waitingFor.asLong()), &becameVisibleCV);
+    auto exitGuard = makeGuard([&] { _visibilityWaiters.erase(waiterIt); });
 
-    // Prevent any scheduled oplog visibility updates from being delayed for batching and blocking
-    // this wait excessively.
-    ++_opsWaitingForOplogVisibilityUpdate;
-    invariant(_opsWaitingForOplogVisibilityUpdate > 0);
-    auto exitGuard = makeGuard([&] { --_opsWaitingForOplogVisibilityUpdate; });
+    // The holes behind 'waitingFor' may have been filled before this operation registered, in
+    // which case no commit will prompt another update. Update visibility now to cover that.
+    if (RecordId(getOplogReadTimestamp()) < waitingFor) {
+        lk.unlock();
+        triggerOplogVisibilityUpdate();
+        lk.lock();
+    }
 
     // Out of order writes to the oplog always call triggerOplogVisibilityUpdate() on commit to
-    // prompt the OplogVisibilityThread to run and update the oplog visibility. We simply need to
-    // wait until all of the writes behind and including 'waitingFor' commit so there are no oplog
-    // holes.
-    opCtx->waitForConditionOrInterrupt(_oplogEntriesBecameVisibleCV, lk, [&] {
+    // update the oplog visibility. We simply need to wait until all of the writes behind and
+    // including 'waitingFor' commit so there are no oplog holes.
+    opCtx->waitForConditionOrInterrupt(becameVisibleCV, lk, [&] {
         auto newLatestVisibleTimestamp = getOplogReadTimestamp();
         if (newLatestVisibleTimestamp < currentLatestVisibleTimestamp) {
             LOGV2_DEBUG(22370,
@@ -204,7 +277,7 @@ void WiredTigerOplogManager::_updateOplogVisibilityLoop(WiredTigerSessionCache*
             auto deadline = now + Milliseconds(kDelayMillis);
 
             auto wakeUpEarlyForWaitersPredicate = [&] {
-                return _shuttingDown || _opsWaitingForOplogVisibilityUpdate ||
+                return _shuttingDown || !_visibilityWaiters.empty() ||
                     oplogRecordStore->haveCappedWaiters();
             };
 
@@ -275,8 +348,15 @@ void WiredTigerOplogManager::setOplogReadTimestamp(Timestamp ts) {
 }
 
 void WiredTigerOplogManager::_setOplogReadTimestamp(WithLock, uint64_t newTimestamp) {
-    _oplogReadTimestamp.store(newTimestamp);
-    _oplogEntriesBecameVisibleCV.notify_all();
+    const auto oldTimestamp = _oplogReadTimestamp.swap(newTimestamp);
+
+    // Wake the waiters whose entries are now visible. If visibility moved backwards, as it does
+    // around rollback, wake all of them so that they can detect it.
+    const auto end = newTimestamp < oldTimestamp ? _visibilityWaiters.end()
+                                                 : _visibilityWaiters.upper_bound(newTimestamp);
+    for (auto it = _visibilityWaiters.begin(); it != end; ++it) {
+        it->second->notify_one();
+    }
     LOGV2_DEBUG(22374,
                 2,
                 "Updating the oplogReadTimestamp.",
@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <map>
+
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
@@ -44,7 +46,9 @@ class WiredTigerSessionCache;
  * Manages oplog visibility.
  *
  * On demand, queries WiredTiger's all_durable timestamp value and updates the oplog read timestamp.
- * This is done asynchronously on a thread that startVisibilityThread() will set up.
+ * This is done asynchronously on a thread that startVisibilityThread() will set up. While there are
+ * operations waiting for oplog entries to become visible, the commit that prompts the update
+ * performs it instead, and only the waiters whose entries became visible are woken.
  *
  * The WT all_durable timestamp is the in-memory timestamp behind which there are no oplog holes
  * in-memory. Note, all_durable is the timestamp that has no holes in-memory, which may NOT be
@@ -75,7 +79,8 @@ public:
     }
 
     /**
-     * Signals the oplog visibility thread to update the oplog read timestamp.
+     * Updates the oplog read timestamp on the calling thread if there are operations waiting for
+     * oplog visibility, and otherwise signals the oplog visibility thread to update it.
      */
     void triggerOplogVisibilityUpdate();
 
@@ -106,17 +111,33 @@ private:
     void _updateOplogVisibilityLoop(WiredTigerSessionCache* sessionCache,
                                     WiredTigerRecordStore* oplogRecordStore);
 
+    /**
+     * Returns true if triggerOplogVisibilityUpdate() should update the oplog read timestamp on the
+     * calling thread instead of signaling the oplog visibility thread.
+     */
+    bool _shouldUpdateVisibilityOnCommit(WithLock) const;
+
+    /**
+     * Fetches the all_durable timestamp and publishes it as the oplog read timestamp, repeating
+     * while other commits request updates in the meantime. Releases 'lk'.
+     */
+    void _updateVisibilityOnCommit(stdx::unique_lock<Latch>& lk);
+
     void _setOplogReadTimestamp(WithLock, uint64_t newTimestamp);
 
     AtomicWord<unsigned long long> _oplogReadTimestamp{0};
 
     stdx::thread _oplogVisibilityThread;
 
+    // Set by startVisibilityThread(); used to update visibility on commit.
+    WiredTigerSessionCache* _sessionCache = nullptr;
+    WiredTigerRecordStore* _oplogRecordStore = nullptr;
+
     // Signaled to trigger the oplog visibility thread to run.
     mutable stdx::condition_variable _oplogVisibilityThreadCV;
 
-    // Signaled when oplog visibility has been updated.
-    mutable stdx::condition_variable _oplogEntriesBecameVisibleCV;
+    // Signaled when a commit finishes updating oplog visibility.
+    stdx::condition_variable _updateOnCommitDoneCV;
 
     // Protects the state below.
     mutable Mutex _oplogVisibilityStateMutex =
@@ -129,8 +150,14 @@ private:
     // update, per the _opsWaitingForOplogVisibility counter.
     bool _triggerOplogVisibilityUpdate = false;
 
-    // Incremented when a caller is waiting for more of the oplog to become visible, to avoid update
-    // delays for batching.
-    int64_t _opsWaitingForOplogVisibilityUpdate = 0;
+    // Operations waiting for the oplog read timestamp to reach a given timestamp, keyed by that
+    // timestamp. Each waiter's condition variable is signaled once its timestamp becomes visible,
+    // or when visibility moves backwards. A non-empty map also avoids update delays for batching.
+    std::multimap<std::uint64_t, stdx::condition_variable*> _visibilityWaiters;
+
+    // Set while a committing thread is updating oplog visibility. Commits that arrive meanwhile
+    // set '_updateOnCommitRequested' so that the updating thread fetches all_durable again.
+    bool _updatingOnCommit = false;
+    bool _updateOnCommitRequested = false;
 };
 }  // namespace mongo
@@ -55,6 +55,8 @@
 #include "mongo/db/server_recovery.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/stats/resource_consumption_metrics.h"
+#include "mongo/db/storage/index_entry_comparison.h"
+#include "mongo/db/storage/oplog_namespace_index.h"
 #include "mongo/db/storage/wiredtiger/oplog_stone_parameters_gen.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_cursor_helpers.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_customization_hooks.h"
@@ -198,6 +200,7 @@ public:
 
         stdx::lock_guard<Latch> lk(_oplogStones->_mutex);
         _oplogStones->_stones.clear();
+        _oplogStones->_persistStones_inlock();
     }
 
     void rollback() final {}
@@ -231,6 +234,7 @@ WiredTigerRecordStore::OplogStones::OplogStones(OperationContext* opCtx, WiredTi
     invariant(_minBytesPerStone > 0);
 
     _calculateStones(opCtx, numStonesToKeep);
+    _persistStones_inlock();
     _pokeReclaimThreadIfNeeded();  // Reclaim stones if over the limit.
 }
 
@@ -321,6 +325,7 @@ WiredTigerRecordStore::OplogStones::peekOldestStoneIfNeeded() const {
 void WiredTigerRecordStore::OplogStones::popOldestStone() {
     stdx::lock_guard<Latch> lk(_mutex);
     _stones.pop_front();
+    _persistStones_inlock();
 }
 
 void WiredTigerRecordStore::OplogStones::createNewStoneIfNeeded(OperationContext* opCtx,
@@ -362,6 +367,7 @@ void WiredTigerRecordStore::OplogStones::createNewStoneIfNeeded(OperationContext
 
     OplogStones::Stone stone(_currentRecords.swap(0), _currentBytes.swap(0), lastRecord, wallTime);
     _stones.push_back(stone);
+    _persistStones_inlock();
 
     LOGV2_DEBUG(22381,
                 2,
@@ -408,6 +414,7 @@ void WiredTigerRecordStore::OplogStones::updateStonesAfterCappedTruncateAfter(
     // Remove the stones corresponding to the records that were deleted.
     int64_t offset = _stones.size() - numStonesToRemove;
     _stones.erase(_stones.begin() + offset, _stones.end());
+    _persistStones_inlock();
 
     // Account for any remaining records from a partially truncated stone in the stone currently
     // being filled.
@@ -454,15 +461,19 @@ void WiredTigerRecordStore::OplogStones::_calculateStones(OperationContext* opCt
         return;
     }
 
-    // Only use sampling to estimate where to place the oplog stones if the number of samples drawn
-    // is less than 5% of the collection.
-    const uint64_t kMinSampleRatioForRandCursor = 20;
-
     // If the oplog doesn't contain enough records to make sampling more efficient, then scan the
     // oplog to determine where to put down stones.
-    if (numRecords < 0 || dataSize < 0 ||
-        uint64_t(numRecords) <
-            kMinSampleRatioForRandCursor * kRandomSamplesPerStone * numStonesToKeep) {
+    const uint64_t maxRecordsToScan =
+        kMinSampleRatioForRandCursor * kRandomSamplesPerStone * numStonesToKeep;
+
+    // The persisted stones are used as long as scanning the oplog entries which follow them is also
+    // cheaper than sampling.
+    if (gPersistOplogStones &&
+        _loadPersistedStones(opCtx, static_cast<int64_t>(maxRecordsToScan))) {
+        return;
+    }
+
+    if (numRecords < 0 || dataSize < 0 || uint64_t(numRecords) < maxRecordsToScan) {
         _calculateStonesByScanning(opCtx);
         return;
     }
@@ -629,6 +640,149 @@ void WiredTigerRecordStore::OplogStones::_calculateStonesBySampling(OperationCon
     _currentBytes.store(_rs->dataSize(opCtx) - estBytesPerStone * wholeStones);
 }
 
+bool WiredTigerRecordStore::OplogStones::_loadPersistedStones(OperationContext* opCtx,
+                                                              int64_t maxRecordsToScan) {
+    BSONObj persisted = _rs->_sizeInfo->oplogStones();
+    if (persisted.isEmpty()) {
+        return false;
+    }
+
+    if (persisted["minBytesPerStone"].safeNumberLong() != _minBytesPerStone) {
+        LOGV2(5591717,
+              "Not using the persisted oplog truncation markers, which were placed for a different "
+              "oplog size",
+              "persistedMinBytesPerStone"_attr = persisted["minBytesPerStone"].safeNumberLong(),
+              "minBytesPerStone"_attr = _minBytesPerStone);
+        return false;
+    }
+
+    RecordId firstRecordId;
+    RecordId lastRecordId;
+    {
+        auto cursor = _rs->getCursor(opCtx, true /* forward */);
+        auto record = cursor->next();
+        if (!record) {
+            return false;
+        }
+        firstRecordId = record->id;
+    }
+    {
+        auto cursor = _rs->getCursor(opCtx, false /* forward */);
+        auto record = cursor->next();
+        if (!record) {
+            return false;
+        }
+        lastRecordId = record->id;
+    }
+
+    std::deque<OplogStones::Stone> stones;
+    int64_t recordsInStones = 0;
+    int64_t bytesInStones = 0;
+    try {
+        for (auto&& elem : persisted["stones"].Obj()) {
+            BSONObj stoneObj = elem.Obj();
+            RecordId lastRecord(stoneObj["lastRecord"].numberLong());
+
+            // The oldest stones may have been truncated, and the newest ones rolled back, after
+            // they were persisted.
+            if (lastRecord < firstRecordId) {
+                continue;
+            }
+            if (lastRecord > lastRecordId) {
+                break;
+            }
+            uassert(5591718,
+                    "oplog truncation markers are not in increasing order",
+                    stones.empty() || stones.back().lastRecord < lastRecord);
+
+            stones.emplace_back(stoneObj["records"].numberLong(),
+                                stoneObj["bytes"].numberLong(),
+                                lastRecord,
+                                stoneObj["wallTime"].Date());
+            recordsInStones += stones.back().records;
+            bytesInStones += stones.back().bytes;
+        }
+    } catch (const DBException& ex) {
+        LOGV2(5591719,
+              "Not using the persisted oplog truncation markers, which are invalid",
+              "error"_attr = ex.toStatus());
+        return false;
+    }
+
+    if (stones.empty()) {
+        return false;
+    }
+
+    // The size storer keeps the size of the whole oplog, so what is not in the stones follows them.
+    int64_t tailRecords = std::max(_rs->numRecords(opCtx) - recordsInStones, int64_t(0));
+    int64_t tailBytes = std::max(_rs->dataSize(opCtx) - bytesInStones, int64_t(0));
+    int64_t numRecordsScanned = 0;
+    if (tailBytes >= _minBytesPerStone) {
+        // New stones were created after the stones were last persisted, which is only the case
+        // after an unclean shutdown. Place them by scanning the oplog entries which follow.
+        if (tailRecords > maxRecordsToScan) {
+            LOGV2(5591720,
+                  "Not using the persisted oplog truncation markers, as too many oplog entries "
+                  "follow them",
+                  "estimatedRecordsToScan"_attr = tailRecords);
+            return false;
+        }
+
+        auto cursor = _rs->getCursor(opCtx, true /* forward */);
+        if (!cursor->seekExact(stones.back().lastRecord)) {
+            return false;
+        }
+
+        tailRecords = 0;
+        tailBytes = 0;
+        while (auto record = cursor->next()) {
+            ++numRecordsScanned;
+            ++tailRecords;
+            tailBytes += record->data.size();
+            if (tailBytes >= _minBytesPerStone) {
+                BSONObj obj = record->data.toBson();
+                auto wallTime =
+                    obj.hasField("wall") ? obj["wall"].Date() : obj["ts"].timestampTime();
+                stones.emplace_back(tailRecords, tailBytes, record->id, wallTime);
+                tailRecords = 0;
+                tailBytes = 0;
+            }
+        }
+    }
+
+    _processByLoading.store(true);
+    _stones = std::move(stones);
+    _currentRecords.store(tailRecords);
+    _currentBytes.store(tailBytes);
+
+    LOGV2(5591721,
+          "Loaded the persisted oplog truncation markers",
+          "numStones"_attr = _stones.size(),
+          "numRecordsScanned"_attr = numRecordsScanned);
+    return true;
+}
+
+void WiredTigerRecordStore::OplogStones::_persistStones_inlock() {
+    if (!gPersistOplogStones || !_rs->_sizeStorer) {
+        return;
+    }
+
+    BSONObjBuilder builder;
+    builder.append("minBytesPerStone", static_cast<long long>(_minBytesPerStone));
+    {
+        BSONArrayBuilder stonesBuilder(builder.subarrayStart("stones"));
+        for (auto&& stone : _stones) {
+            BSONObjBuilder stoneBuilder(stonesBuilder.subobjStart());
+            stoneBuilder.append("records", static_cast<long long>(stone.records));
+            stoneBuilder.append("bytes", static_cast<long long>(stone.bytes));
+            stoneBuilder.append("lastRecord", static_cast<long long>(stone.lastRecord.asLong()));
+            stoneBuilder.append("wallTime", stone.wallTime);
+        }
+    }
+    _rs->_sizeInfo->setOplogStones(builder.obj());
+    _rs->_sizeStorer->store(_rs->_uri, _rs->_sizeInfo);
+}
+
 void WiredTigerRecordStore::OplogStones::_pokeReclaimThreadIfNeeded() {
     if (hasExcessStones_inlock()) {
         _oplogReclaimCv.notify_one();
@@ -651,6 +805,7 @@ void WiredTigerRecordStore::OplogStones::adjust(int64_t maxSize) {
     size_t numStonesToKeep = std::min(kMaxStonesToKeep, std::max(kMinStonesToKeep, numStones));
     _minBytesPerStone = maxSize / numStonesToKeep;
     invariant(_minBytesPerStone > 0);
+    _persistStones_inlock();
     _pokeReclaimThreadIfNeeded();
 }
 
@@ -909,6 +1064,12 @@ WiredTigerRecordStore::WiredTigerRecordStore(WiredTigerKVEngine* kvEngine,
     // persistent size information, we require it to use a SizeStorer.
     _sizeInfo = _sizeStorer ? _sizeStorer->load(_uri)
                             : std::make_shared<WiredTigerSizeStorer::SizeInfo>(0, 0);
+
+    // Capped collections read their size on every insert, so summing per-CPU counters would cost
+    // more than it saves.
+    if (_isCapped) {
+        _sizeInfo->disableSharding();
+    }
 }
 
 WiredTigerRecordStore::~WiredTigerRecordStore() {
@@ -959,8 +1120,8 @@ void WiredTigerRecordStore::checkSize(OperationContext* opCtx) {
                            "ident"_attr = getIdent());
         sizeRecoveryState(getGlobalServiceContext())
             .markCollectionAsAlwaysNeedsSizeAdjustment(getIdent());
-        _sizeInfo->dataSize.store(0);
-        _sizeInfo->numRecords.store(0);
+        _sizeInfo->setDataSize(0);
+        _sizeInfo->setNumRecords(0);
     }
 
     if (_sizeStorer)
@@ -1007,11 +1168,11 @@ bool WiredTigerRecordStore::inShutdown() const {
 }
 
 long long WiredTigerRecordStore::dataSize(OperationContext* opCtx) const {
-    return _sizeInfo->dataSize.load();
+    return _sizeInfo->dataSize();
 }
 
 long long WiredTigerRecordStore::numRecords(OperationContext* opCtx) const {
-    return _sizeInfo->numRecords.load();
+    return _sizeInfo->numRecords();
 }
 
 bool WiredTigerRecordStore::isCapped() const {
@@ -1092,6 +1253,13 @@ bool WiredTigerRecordStore::findRecord(OperationContext* opCtx,
     return true;
 }
 
+void WiredTigerRecordStore::prefetchRecords(OperationContext* opCtx,
+                                            const std::vector<RecordId>& ids) const {
+    if (_kvEngine) {
+        _kvEngine->prefetchRecords(_uri, ids);
+    }
+}
+
 void WiredTigerRecordStore::deleteRecord(OperationContext* opCtx, const RecordId& id) {
     dassert(opCtx->lockState()->isWriteLocked());
     invariant(opCtx->lockState()->inAWriteUnitOfWork() || opCtx->lockState()->isNoop());
@@ -1135,10 +1303,10 @@ bool WiredTigerRecordStore::cappedAndNeedDelete() const {
     if (!_isCapped)
         return false;
 
-    if (_sizeInfo->dataSize.load() >= _cappedMaxSize)
+    if (_sizeInfo->dataSize() >= _cappedMaxSize)
         return true;
 
-    if ((_cappedMaxDocs != -1) && (_sizeInfo->numRecords.load() > _cappedMaxDocs))
+    if ((_cappedMaxDocs != -1) && (_sizeInfo->numRecords() > _cappedMaxDocs))
         return true;
 
     return false;
@@ -1188,7 +1356,7 @@ int64_t WiredTigerRecordStore::_cappedDeleteAsNeeded(OperationContext* opCtx,
         if (!lock.try_lock()) {
             // Someone else is deleting old records. Apply back-pressure if too far behind,
             // otherwise continue.
-            if ((_sizeInfo->dataSize.load() - _cappedMaxSize) < _cappedMaxSizeSlack)
+            if ((_sizeInfo->dataSize() - _cappedMaxSize) < _cappedMaxSizeSlack)
                 return 0;
 
             // Don't wait forever: we're in a transaction, we could block eviction.
@@ -1203,7 +1371,7 @@ int64_t WiredTigerRecordStore::_cappedDeleteAsNeeded(OperationContext* opCtx,
 
             // If we already waited, let someone else do cleanup unless we are significantly
             // over the limit.
-            if ((_sizeInfo->dataSize.load() - _cappedMaxSize) < (2 * _cappedMaxSizeSlack))
+            if ((_sizeInfo->dataSize() - _cappedMaxSize) < (2 * _cappedMaxSizeSlack))
                 return 0;
         }
     }
@@ -1260,8 +1428,8 @@ int64_t WiredTigerRecordStore::_cappedDeleteAsNeeded_inlock(OperationContext* op
 
     WT_SESSION* session = WiredTigerRecoveryUnit::get(opCtx)->getSession()->getSession();
 
-    int64_t dataSize = _sizeInfo->dataSize.load();
-    int64_t numRecords = _sizeInfo->numRecords.load();
+    int64_t dataSize = _sizeInfo->dataSize();
+    int64_t numRecords = _sizeInfo->numRecords();
 
     int64_t sizeOverCap = (dataSize > _cappedMaxSize) ? dataSize - _cappedMaxSize : 0;
     int64_t sizeSaved = 0;
@@ -1533,8 +1701,8 @@ void WiredTigerRecordStore::reclaimOplog(OperationContext* opCtx, Timestamp mayT
     _truncateCount.fetchAndAdd(1);
     LOGV2(22402,
           "WiredTiger record store oplog truncation finished",
-          "numRecords"_attr = _sizeInfo->numRecords.load(),
-          "dataSize"_attr = _sizeInfo->dataSize.load(),
+          "numRecords"_attr = _sizeInfo->numRecords(),
+          "dataSize"_attr = _sizeInfo->dataSize(),
           "duration"_attr = Milliseconds(elapsedMillis));
 }
 
@@ -1561,7 +1729,9 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
     if (_isCapped && totalLength > _cappedMaxSize)
         return Status(ErrorCodes::BadValue, "object to insert exceeds cappedMaxSize");
 
-    WiredTigerCursor curwrap(_uri, _tableId, true, opCtx);
+    // Records in clustered record stores are keyed by a caller-provided RecordId, so inserting an
+    // existing key must fail rather than silently overwrite the record.
+    WiredTigerCursor curwrap(_uri, _tableId, _keyFormat == KeyFormat::Long, opCtx);
     curwrap.assertInActiveTxn();
     WT_CURSOR* c = curwrap.get();
     invariant(c);
@@ -1613,9 +1783,24 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
         WiredTigerItem value(record.data.data(), record.data.size());
         c->set_value(c, value.Get());
         int ret = WT_OP_CHECK(wiredTigerCursorInsert(opCtx, c));
+        if (ret == WT_DUPLICATE_KEY) {
+            invariant(_keyFormat == KeyFormat::String);
+            return buildDupKeyErrorStatus(BSON("_id" << OID::from(record.id.strData())),
+                                          NamespaceString(ns()),
+                                          "_id_",
+                                          BSON("_id" << 1),
+                                          BSONObj());
+        }
         if (ret)
             return wtRCToStatus(ret, "WiredTigerRecordStore::insertRecord");
 
+        // The entry must be known to the namespace index before it can become visible to readers
+        // which consult the index.
+        if (_isOplog && OplogNamespaceIndex::isEnabled()) {
+            OplogNamespaceIndex::get(opCtx->getServiceContext())
+                .add(Timestamp(record.id.asLong()), record.data.toBson());
+        }
+
         // Increment metrics for each insert separately, as opposed to outside of the loop. The API
         // requires that each record be accounted for separately.
         if (!_isOplog) {
@@ -1995,6 +2180,17 @@ void WiredTigerRecordStore::appendCustomStats(OperationContext* opCtx,
     }
 }
 
+bool WiredTigerRecordStore::appendIOStats(OperationContext* opCtx, BSONObjBuilder* result) const {
+    WiredTigerSession* session = WiredTigerRecoveryUnit::get(opCtx)->getSessionNoTxn();
+    Status status = WiredTigerUtil::appendIOStats(session->getSession(), getURI(), result);
+    if (!status.isOK()) {
+        result->append("error", "unable to retrieve statistics");
+        result->append("code", static_cast<int>(status.code()));
+        result->append("reason", status.reason());
+    }
+    return true;
+}
+
 void WiredTigerRecordStore::waitForAllEarlierOplogWritesToBeVisible(OperationContext* opCtx) const {
     // Make sure that callers do not hold an active snapshot so it will be able to see the oplog
     // entries it waited for afterwards.
@@ -2020,8 +2216,8 @@ void WiredTigerRecordStore::updateStatsAfterRepair(OperationContext* opCtx,
     sizeRecoveryState(getGlobalServiceContext())
         .markCollectionAsAlwaysNeedsSizeAdjustment(getIdent());
 
-    _sizeInfo->numRecords.store(numRecords);
-    _sizeInfo->dataSize.store(dataSize);
+    _sizeInfo->setNumRecords(numRecords);
+    _sizeInfo->setDataSize(dataSize);
 
     // If we have a WiredTigerSizeStorer, but our size info is not currently cached, add it.
     if (_sizeStorer)
@@ -2087,7 +2283,7 @@ public:
                     3,
                     "WiredTigerRecordStore: rolling back NumRecordsChange {diff}",
                     "diff"_attr = -_diff);
-        _rs->_sizeInfo->numRecords.fetchAndAdd(-_diff);
+        _rs->_sizeInfo->changeNumRecords(-_diff);
     }
 
 private:
@@ -2105,8 +2301,7 @@ void WiredTigerRecordStore::_changeNumRecords(OperationContext* opCtx, int64_t d
     }
 
     opCtx->recoveryUnit()->registerChange(std::make_unique<NumRecordsChange>(this, diff));
-    if (_sizeInfo->numRecords.fetchAndAdd(diff) < 0)
-        _sizeInfo->numRecords.store(std::max(diff, int64_t(0)));
+    _sizeInfo->changeNumRecords(diff);
 }
 
 class WiredTigerRecordStore::DataSizeChange : public RecoveryUnit::Change {
@@ -2134,15 +2329,14 @@ void WiredTigerRecordStore::_increaseDataSize(OperationContext* opCtx, int64_t a
     if (opCtx)
         opCtx->recoveryUnit()->registerChange(std::make_unique<DataSizeChange>(this, amount));
 
-    if (_sizeInfo->dataSize.fetchAndAdd(amount) < 0)
-        _sizeInfo->dataSize.store(std::max(amount, int64_t(0)));
+    _sizeInfo->changeDataSize(amount);
 
     if (_sizeStorer)
         _sizeStorer->store(_uri, _sizeInfo);
 }
 
 void WiredTigerRecordStore::setNumRecords(long long numRecords) {
-    _sizeInfo->numRecords.store(numRecords);
+    _sizeInfo->setNumRecords(numRecords);
 
     if (!_sizeStorer) {
         return;
@@ -2155,7 +2349,7 @@ void WiredTigerRecordStore::setNumRecords(long long numRecords) {
 }
 
 void WiredTigerRecordStore::setDataSize(long long dataSize) {
-    _sizeInfo->dataSize.store(dataSize);
+    _sizeInfo->setDataSize(dataSize);
 
     if (!_sizeStorer) {
         return;
@@ -2302,7 +2496,53 @@ boost::optional<Record> WiredTigerRecordStoreCursorBase::next() {
     WiredTigerRecoveryUnit::get(_opCtx)->getSession();
 
     WT_CURSOR* c = _cursor->get();
+    RecordId id = advance(c);
+    if (id.isNull())
+        return {};
+
+    WT_ITEM value;
+    invariantWTOK(c->get_value(c, &value));
+
+    auto& metricsCollector = ResourceConsumption::MetricsCollector::get(_opCtx);
+    metricsCollector.incrementOneDocRead(value.size);
+
+    _lastReturnedId = id;
+    return {{id, {static_cast<const char*>(value.data), static_cast<int>(value.size)}}};
+}
+
+size_t WiredTigerRecordStoreCursorBase::nextBatch(size_t n, std::vector<Record>* out) {
+    invariant(_hasRestored);
+    if (_eof)
+        return 0;
+
+    // As in next(), ensure an active transaction is open, but only once for the whole batch.
+    WiredTigerRecoveryUnit::get(_opCtx)->getSession();
+
+    WT_CURSOR* c = _cursor->get();
+    auto& metricsCollector = ResourceConsumption::MetricsCollector::get(_opCtx);
+
+    size_t numAppended = 0;
+    for (; numAppended < n; ++numAppended) {
+        RecordId id = advance(c);
+        if (id.isNull())
+            break;
+
+        WT_ITEM value;
+        invariantWTOK(c->get_value(c, &value));
+        metricsCollector.incrementOneDocRead(value.size);
+
+        // Copy the value straight out of WiredTiger's buffer, since it is only valid until the
+        // cursor is next advanced.
+        auto buffer = SharedBuffer::allocate(value.size);
+        memcpy(buffer.get(), value.data, value.size);
 
+        _lastReturnedId = id;
+        out->push_back({id, RecordData(std::move(buffer), static_cast<int>(value.size))});
+    }
+    return numAppended;
+}
+
+RecordId WiredTigerRecordStoreCursorBase::advance(WT_CURSOR* c) {
     RecordId id;
     if (!_skipNextAdvance) {
         // Nothing after the next line can throw WCEs.
@@ -2312,7 +2552,7 @@ boost::optional<Record> WiredTigerRecordStoreCursorBase::next() {
             _opCtx, [&] { return _forward ? c->next(c) : c->prev(c); });
         if (advanceRet == WT_NOTFOUND) {
             _eof = true;
-            return {};
+            return RecordId();
         }
         invariantWTOK(advanceRet);
         id = getKey(c);
@@ -2325,7 +2565,7 @@ boost::optional<Record> WiredTigerRecordStoreCursorBase::next() {
 
     if (_forward && _oplogVisibleTs && id.asLong() > *_oplogVisibleTs) {
         _eof = true;
-        return {};
+        return RecordId();
     }
 
     if (_forward && _lastReturnedId >= id) {
@@ -2344,14 +2584,7 @@ boost::optional<Record> WiredTigerRecordStoreCursorBase::next() {
         throw WriteConflictException();
     }
 
-    WT_ITEM value;
-    invariantWTOK(c->get_value(c, &value));
-
-    auto& metricsCollector = ResourceConsumption::MetricsCollector::get(_opCtx);
-    metricsCollector.incrementOneDocRead(value.size);
-
-    _lastReturnedId = id;
-    return {{id, {static_cast<const char*>(value.data), static_cast<int>(value.size)}}};
+    return id;
 }
 
 boost::optional<Record> WiredTigerRecordStoreCursorBase::seekExact(const RecordId& id) {
@@ -143,6 +143,8 @@ public:
 
     virtual bool findRecord(OperationContext* opCtx, const RecordId& id, RecordData* out) const;
 
+    void prefetchRecords(OperationContext* opCtx, const std::vector<RecordId>& ids) const override;
+
     virtual void deleteRecord(OperationContext* opCtx, const RecordId& id);
 
     virtual Status insertRecords(OperationContext* opCtx,
@@ -195,6 +197,8 @@ public:
                                    BSONObjBuilder* result,
                                    double scale) const;
 
+    bool appendIOStats(OperationContext* opCtx, BSONObjBuilder* result) const override;
+
     virtual void cappedTruncateAfter(OperationContext* opCtx, RecordId end, bool inclusive);
 
     virtual Status oplogDiskLocRegister(OperationContext* opCtx,
@@ -421,6 +425,8 @@ public:
 
     boost::optional<Record> next();
 
+    size_t nextBatch(size_t n, std::vector<Record>* out);
+
     boost::optional<Record> seekExact(const RecordId& id);
 
     boost::optional<Record> seekNear(const RecordId& start);
@@ -457,6 +463,13 @@ protected:
 private:
     bool isVisible(const RecordId& id);
 
+    /**
+     * Advances 'c' and returns the id of the record it is then positioned on, or a null RecordId
+     * at EOF. Serves both next() and nextBatch(), which are responsible for checking that the
+     * cursor is usable and that a transaction is open.
+     */
+    RecordId advance(WT_CURSOR* c);
+
     /**
      * This value is used for visibility calculations on what oplog entries can be returned to a
      * client. This value *must* be initialized/updated *before* a WiredTiger snapshot is
@@ -67,7 +67,10 @@ public:
 
     void getOplogStonesStats(BSONObjBuilder& builder) const {
         builder.append("totalTimeProcessingMicros", _totalTimeProcessing.load());
-        builder.append("processingMethod", _processBySampling.load() ? "sampling" : "scanning");
+        builder.append("processingMethod",
+                       _processByLoading.load()
+                           ? "persisted"
+                           : _processBySampling.load() ? "sampling" : "scanning");
         if (auto oplogMinRetentionHours = storageGlobalParams.oplogMinRetentionHours.load()) {
             builder.append("oplogMinRetentionHours", oplogMinRetentionHours);
         }
@@ -127,10 +130,23 @@ private:
                                     int64_t estRecordsPerStone,
                                     int64_t estBytesPerStone);
 
+    // Loads the stones last persisted with the size of the oplog, dropping those which no longer
+    // fit the oplog, and scans the oplog entries which follow them. Returns false, without loading
+    // anything, if the persisted stones cannot be used or if more than 'maxRecordsToScan' entries
+    // are expected to follow them.
+    bool _loadPersistedStones(OperationContext* opCtx, int64_t maxRecordsToScan);
+
+    // Saves the stones along with the size of the oplog, to be written back by the next flush of
+    // the size storer.
+    void _persistStones_inlock();
+
     void _pokeReclaimThreadIfNeeded();
 
     static const uint64_t kRandomSamplesPerStone = 10;
 
+    // The oplog is only sampled if the number of samples drawn is less than 5% of the collection.
+    static const uint64_t kMinSampleRatioForRandCursor = 20;
+
     WiredTigerRecordStore* _rs;
 
     Mutex _oplogReclaimMutex;
@@ -149,6 +165,7 @@ private:
     AtomicWord<int64_t> _totalTimeProcessing;  // Amount of time spent scanning and/or sampling the
                                                // oplog during start up, if any.
     AtomicWord<bool> _processBySampling;       // Whether the oplog was sampled or scanned.
+    AtomicWord<bool> _processByLoading;        // Whether the persisted stones were loaded.
 
     // Protects against concurrent access to the deque of oplog stones.
     mutable Mutex _mutex = MONGO_MAKE_LATCH("OplogStones::_mutex");
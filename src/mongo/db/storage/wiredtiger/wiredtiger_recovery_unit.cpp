@@ -145,6 +145,19 @@ BSONObj WiredTigerOperationStats::toBSON() {
     return bob.obj();
 }
 
+Microseconds WiredTigerOperationStats::getTimeReading() const {
+    return Microseconds{_getStat(WT_STAT_SESSION_READ_TIME)};
+}
+
+Microseconds WiredTigerOperationStats::getTimeWaitingForCache() const {
+    return Microseconds{_getStat(WT_STAT_SESSION_CACHE_TIME)};
+}
+
+long long WiredTigerOperationStats::_getStat(int key) const {
+    auto it = _stats.find(key);
+    return it == _stats.end() ? 0 : it->second;
+}
+
 WiredTigerOperationStats& WiredTigerOperationStats::operator+=(
     const WiredTigerOperationStats& other) {
     for (auto const& otherStat : other._stats) {
@@ -48,6 +48,34 @@ namespace mongo {
 
 using std::string;
 
+namespace {
+
+/**
+ * Returns 'stats' with the cursor cache counters of the WiredTigerSessions added to its "session"
+ * subsection, next to the session statistics reported by WiredTiger itself.
+ */
+BSONObj appendCursorCacheStats(const BSONObj& stats) {
+    BSONObjBuilder bob;
+    bool appended = false;
+    for (auto&& elem : stats) {
+        if (elem.fieldNameStringData() == "session" && elem.type() == Object) {
+            BSONObjBuilder subsection(bob.subobjStart("session"));
+            subsection.appendElements(elem.Obj());
+            WiredTigerSession::appendCursorCacheStats(&subsection);
+            appended = true;
+        } else {
+            bob.append(elem);
+        }
+    }
+    if (!appended) {
+        BSONObjBuilder subsection(bob.subobjStart("session"));
+        WiredTigerSession::appendCursorCacheStats(&subsection);
+    }
+    return appendCursorCacheStats(bob.obj());
+}
+
+}  // namespace
+
 WiredTigerServerStatusSection::WiredTigerServerStatusSection(WiredTigerKVEngine* engine)
     : ServerStatusSection(kWiredTigerEngineName), _engine(engine) {}
 
@@ -33,8 +33,13 @@
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 
+#include <algorithm>
 #include <memory>
 
+#ifdef __linux__
+#include <sched.h>
+#endif
+
 #include "mongo/base/error_codes.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/global_settings.h"
@@ -45,9 +50,46 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 #include "mongo/logv2/log.h"
 #include "mongo/stdx/thread.h"
+#include "mongo/util/processinfo.h"
 #include "mongo/util/scopeguard.h"
 
 namespace mongo {
+namespace {
+
+// Upper bound on the number of idle session partitions, regardless of the number of cores.
+constexpr size_t kMaxSessionCachePartitions = 128;
+
+size_t numSessionCachePartitions() {
+    return std::clamp<size_t>(ProcessInfo::getNumAvailableCores(), 1, kMaxSessionCachePartitions);
+}
+
+// Number of cursor cache lookups after which a session reconsiders its cursor cache capacity.
+constexpr uint32_t kCursorCacheAdaptationWindow = 256;
+
+// Cursor cache counters of all sessions, as reported in serverStatus.wiredTiger.session. Sessions
+// accumulate their counters locally and add them here when they are released, so that cursor
+// lookups do not contend on these.
+struct GlobalCursorCacheCounters {
+    AtomicWord<long long> hits;
+    AtomicWord<long long> misses;
+    AtomicWord<long long> capacityMisses;
+    AtomicWord<long long> evictions;
+    AtomicWord<long long> capacityIncreases;
+    AtomicWord<long long> capacityDecreases;
+} globalCursorCacheCounters;
+
+uint32_t baseCursorCacheCapacity() {
+    // A negative value for wiredTigerCursorCacheSize means to use hybrid caching.
+    return std::abs(gWiredTigerCursorCacheSize.load());
+}
+
+uint32_t maxCursorCacheCapacity() {
+    // A cursor cache size of zero disables caching above the storage engine altogether.
+    const uint32_t base = baseCursorCacheCapacity();
+    return base == 0 ? 0 : std::max<uint32_t>(base, gWiredTigerCursorCacheMaxSize.load());
+}
+
+}  // namespace
 
 WiredTigerSession::WiredTigerSession(WT_CONNECTION* conn, uint64_t epoch, uint64_t cursorEpoch)
     : _epoch(epoch),
@@ -55,7 +97,8 @@ WiredTigerSession::WiredTigerSession(WT_CONNECTION* conn, uint64_t epoch, uint64
       _session(nullptr),
       _cursorGen(0),
       _cursorsOut(0),
-      _idleExpireTime(Date_t::min()) {
+      _idleExpireTime(Date_t::min()),
+      _cursorCacheCapacity(baseCursorCacheCapacity()) {
     invariantWTOK(conn->open_session(conn, nullptr, "isolation=snapshot", &_session));
 }
 
@@ -69,11 +112,13 @@ WiredTigerSession::WiredTigerSession(WT_CONNECTION* conn,
       _session(nullptr),
       _cursorGen(0),
       _cursorsOut(0),
-      _idleExpireTime(Date_t::min()) {
+      _idleExpireTime(Date_t::min()),
+      _cursorCacheCapacity(baseCursorCacheCapacity()) {
     invariantWTOK(conn->open_session(conn, nullptr, "isolation=snapshot", &_session));
 }
 
 WiredTigerSession::~WiredTigerSession() {
+    _flushCursorCacheStats();
     if (_session) {
         invariantWTOK(_session->close(_session, nullptr));
     }
@@ -118,12 +163,69 @@ WT_CURSOR* WiredTigerSession::getCachedCursor(const std::string& uri, uint64_t i
             WT_CURSOR* c = i->_cursor;
             _cursors.erase(i);
             _cursorsOut++;
+            _recordCursorCacheLookup(true, false);
             return c;
         }
     }
+    _recordCursorCacheLookup(false, _evictedCursorIds.erase(id) > 0);
     return nullptr;
 }
 
+void WiredTigerSession::_recordCursorCacheLookup(bool hit, bool capacityMiss) {
+    if (hit) {
+        ++_cursorCacheCounters.hits;
+    } else {
+        ++_cursorCacheCounters.misses;
+    }
+    if (capacityMiss) {
+        ++_cursorCacheCounters.capacityMisses;
+        ++_windowCapacityMisses;
+    }
+
+    if (++_windowLookups < kCursorCacheAdaptationWindow) {
+        return;
+    }
+
+    const uint32_t base = baseCursorCacheCapacity();
+    const uint32_t max = maxCursorCacheCapacity();
+    if (_windowCapacityMisses * 10 > _windowLookups && _cursorCacheCapacity < max) {
+        // More than a tenth of the lookups would have hit with a larger cache.
+        _cursorCacheCapacity = std::min(max, std::max<uint32_t>(1, _cursorCacheCapacity * 2));
+        ++_cursorCacheCounters.capacityIncreases;
+    } else if (_windowCapacityMisses == 0 && _cursorCacheCapacity > base &&
+               _cursors.size() <= _cursorCacheCapacity / 2) {
+        // The working set fits in half of the cache, so give back the unused capacity.
+        _cursorCacheCapacity = std::max(base, _cursorCacheCapacity / 2);
+        ++_cursorCacheCounters.capacityDecreases;
+    }
+
+    _windowLookups = 0;
+    _windowCapacityMisses = 0;
+}
+
+void WiredTigerSession::_flushCursorCacheStats() {
+    auto& counters = _cursorCacheCounters;
+    globalCursorCacheCounters.hits.fetchAndAddRelaxed(counters.hits);
+    globalCursorCacheCounters.misses.fetchAndAddRelaxed(counters.misses);
+    globalCursorCacheCounters.capacityMisses.fetchAndAddRelaxed(counters.capacityMisses);
+    globalCursorCacheCounters.evictions.fetchAndAddRelaxed(counters.evictions);
+    globalCursorCacheCounters.capacityIncreases.fetchAndAddRelaxed(counters.capacityIncreases);
+    globalCursorCacheCounters.capacityDecreases.fetchAndAddRelaxed(counters.capacityDecreases);
+    counters = CursorCacheCounters();
+}
+
+void WiredTigerSession::appendCursorCacheStats(BSONObjBuilder* bob) {
+    bob->append("cursor cache hits", globalCursorCacheCounters.hits.loadRelaxed());
+    bob->append("cursor cache misses", globalCursorCacheCounters.misses.loadRelaxed());
+    bob->append("cursor cache misses on recently evicted cursors",
+                globalCursorCacheCounters.capacityMisses.loadRelaxed());
+    bob->append("cursor cache evictions", globalCursorCacheCounters.evictions.loadRelaxed());
+    bob->append("cursor cache capacity increases",
+                globalCursorCacheCounters.capacityIncreases.loadRelaxed());
+    bob->append("cursor cache capacity decreases",
+                globalCursorCacheCounters.capacityDecreases.loadRelaxed());
+}
+
 WT_CURSOR* WiredTigerSession::getNewCursor(const std::string& uri, const char* config) {
     WT_CURSOR* cursor = nullptr;
     _openCursor(_session, uri, config, &cursor);
@@ -141,10 +243,20 @@ void WiredTigerSession::releaseCursor(uint64_t id, WT_CURSOR* cursor) {
     // Cursors are pushed to the front of the list and removed from the back
     _cursors.push_front(WiredTigerCachedCursor(id, _cursorGen++, cursor));
 
-    // A negative value for wiredTigercursorCacheSize means to use hybrid caching.
-    std::uint32_t cacheSize = abs(gWiredTigerCursorCacheSize.load());
+    // Pick up changes to the cursor cache size parameters.
+    _cursorCacheCapacity =
+        std::clamp(_cursorCacheCapacity, baseCursorCacheCapacity(), maxCursorCacheCapacity());
+
+    while (!_cursors.empty() && _cursorGen - _cursors.back()._gen > _cursorCacheCapacity) {
+        // Remember the evicted table, so that a later miss on it counts towards growing the cache.
+        // Only misses that a cache of the maximum size would have avoided are of interest, so the
+        // set is bounded by that size.
+        if (_evictedCursorIds.size() >= std::max<uint32_t>(1, maxCursorCacheCapacity())) {
+            _evictedCursorIds.clear();
+        }
+        _evictedCursorIds.insert(_cursors.back()._id);
+        ++_cursorCacheCounters.evictions;
 
-    while (!_cursors.empty() && _cursorGen - _cursors.back()._gen > cacheSize) {
         cursor = _cursors.back()._cursor;
         _cursors.pop_back();
         invariantWTOK(cursor->close(cursor));
@@ -202,6 +314,8 @@ WiredTigerSessionCache::WiredTigerSessionCache(WiredTigerKVEngine* engine)
       _conn(engine->getConnection()),
       _clockSource(_engine->getClockSource()),
       _shuttingDown(0),
+      _numPartitions(numSessionCachePartitions()),
+      _partitions(std::make_unique<CacheAligned<Partition>[]>(_numPartitions)),
       _prepareCommitOrAbortCounter(0) {}
 
 WiredTigerSessionCache::WiredTigerSessionCache(WT_CONNECTION* conn, ClockSource* cs)
@@ -209,6 +323,8 @@ WiredTigerSessionCache::WiredTigerSessionCache(WT_CONNECTION* conn, ClockSource*
       _conn(conn),
       _clockSource(cs),
       _shuttingDown(0),
+      _numPartitions(numSessionCachePartitions()),
+      _partitions(std::make_unique<CacheAligned<Partition>[]>(_numPartitions)),
       _prepareCommitOrAbortCounter(0) {}
 
 WiredTigerSessionCache::~WiredTigerSessionCache() {
@@ -374,9 +490,12 @@ void WiredTigerSessionCache::notifyPreparedUnitOfWorkHasCommittedOrAborted() {
 
 
 void WiredTigerSessionCache::closeAllCursors(const std::string& uri) {
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeAllCursors(uri);
+    for (size_t p = 0; p < _numPartitions; ++p) {
+        auto& partition = _partitions[p];
+        stdx::lock_guard<Latch> lock(partition.lock);
+        for (auto&& session : partition.sessions) {
+            session->closeAllCursors(uri);
+        }
     }
 }
 
@@ -384,15 +503,23 @@ void WiredTigerSessionCache::closeCursorsForQueuedDrops() {
     // Increment the cursor epoch so that all cursors from this epoch are closed.
     _cursorEpoch.fetchAndAdd(1);
 
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeCursorsForQueuedDrops(_engine);
+    for (size_t p = 0; p < _numPartitions; ++p) {
+        auto& partition = _partitions[p];
+        stdx::lock_guard<Latch> lock(partition.lock);
+        for (auto&& session : partition.sessions) {
+            session->closeCursorsForQueuedDrops(_engine);
+        }
     }
 }
 
 size_t WiredTigerSessionCache::getIdleSessionsCount() {
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    return _sessions.size();
+    size_t count = 0;
+    for (size_t p = 0; p < _numPartitions; ++p) {
+        auto& partition = _partitions[p];
+        stdx::lock_guard<Latch> lock(partition.lock);
+        count += partition.sessions.size();
+    }
+    return count;
 }
 
 void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
@@ -404,14 +531,15 @@ void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
     auto cutoffTime = _clockSource->now() - Milliseconds(idleTimeMillis);
     SessionCache sessionsToClose;
 
-    {
-        stdx::lock_guard<Latch> lock(_cacheLock);
+    for (size_t p = 0; p < _numPartitions; ++p) {
+        auto& partition = _partitions[p];
+        stdx::lock_guard<Latch> lock(partition.lock);
         // Discard all sessions that became idle before the cutoff time
-        for (auto it = _sessions.begin(); it != _sessions.end();) {
+        for (auto it = partition.sessions.begin(); it != partition.sessions.end();) {
             auto session = *it;
             invariant(session->getIdleExpireTime() != Date_t::min());
             if (session->getIdleExpireTime() < cutoffTime) {
-                it = _sessions.erase(it);
+                it = partition.sessions.erase(it);
                 sessionsToClose.push_back(session);
             } else {
                 ++it;
@@ -427,13 +555,17 @@ void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
 }
 
 void WiredTigerSessionCache::closeAll() {
-    // Increment the epoch as we are now closing all sessions with this epoch.
-    SessionCache swap;
+    // Increment the epoch as we are now closing all sessions with this epoch. This happens before
+    // any partition is emptied, so a session released into a partition after it has been emptied
+    // observes the new epoch under the partition lock and is deleted instead of cached.
+    _epoch.fetchAndAdd(1);
 
-    {
-        stdx::lock_guard<Latch> lock(_cacheLock);
-        _epoch.fetchAndAdd(1);
-        _sessions.swap(swap);
+    SessionCache swap;
+    for (size_t p = 0; p < _numPartitions; ++p) {
+        auto& partition = _partitions[p];
+        stdx::lock_guard<Latch> lock(partition.lock);
+        swap.insert(swap.end(), partition.sessions.begin(), partition.sessions.end());
+        partition.sessions.clear();
     }
 
     for (SessionCache::iterator i = swap.begin(); i != swap.end(); i++) {
@@ -450,13 +582,16 @@ UniqueWiredTigerSession WiredTigerSessionCache::getSession() {
     // operations should be allowed to start.
     invariant(!(_shuttingDown.loadRelaxed() & kShuttingDownMask));
 
-    {
-        stdx::lock_guard<Latch> lock(_cacheLock);
-        if (!_sessions.empty()) {
+    // Look in the partition of the current CPU first, then steal from the others.
+    const size_t homeIndex = _partitionIndexForCurrentThread();
+    for (size_t i = 0; i < _numPartitions; ++i) {
+        auto& partition = _partitions[(homeIndex + i) % _numPartitions];
+        stdx::lock_guard<Latch> lock(partition.lock);
+        if (!partition.sessions.empty()) {
             // Get the most recently used session so that if we discard sessions, we're
             // discarding older ones
-            WiredTigerSession* cachedSession = _sessions.back();
-            _sessions.pop_back();
+            WiredTigerSession* cachedSession = partition.sessions.back();
+            partition.sessions.pop_back();
             // Reset the idle time
             cachedSession->setIdleExpireTime(Date_t::min());
             return UniqueWiredTigerSession(cachedSession);
@@ -503,6 +638,8 @@ void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
         invariantWTOK(ss->reset(ss));
     }
 
+    session->_flushCursorCacheStats();
+
     // If the cursor epoch has moved on, close all cursors in the session.
     uint64_t cursorEpoch = _cursorEpoch.load();
     if (session->_getCursorEpoch() != cursorEpoch)
@@ -518,10 +655,11 @@ void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
     session->setIdleExpireTime(_clockSource->now());
 
     if (session->_getEpoch() == currentEpoch) {  // check outside of lock to reduce contention
-        stdx::lock_guard<Latch> lock(_cacheLock);
+        auto& partition = _partitions[_partitionIndexForCurrentThread()];
+        stdx::lock_guard<Latch> lock(partition.lock);
         if (session->_getEpoch() == _epoch.load()) {  // recheck inside the lock for correctness
             returnedToCache = true;
-            _sessions.push_back(session);
+            partition.sessions.push_back(session);
         }
     } else
         invariant(session->_getEpoch() < currentEpoch);
@@ -534,6 +672,16 @@ void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
 }
 
 
+size_t WiredTigerSessionCache::_partitionIndexForCurrentThread() const {
+#ifdef __linux__
+    int cpu = sched_getcpu();
+    if (cpu >= 0) {
+        return static_cast<size_t>(cpu) % _numPartitions;
+    }
+#endif
+    return std::hash<stdx::thread::id>()(stdx::this_thread::get_id()) % _numPartitions;
+}
+
 void WiredTigerSessionCache::setJournalListener(JournalListener* jl) {
     stdx::unique_lock<Latch> lk(_journalListenerMutex);
 
@@ -30,15 +30,20 @@
 #pragma once
 
 #include <list>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include <wiredtiger.h>
 
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/storage/journal_listener.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_snapshot_manager.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
+#include "mongo/stdx/unordered_set.h"
 #include "mongo/util/concurrency/spin_lock.h"
+#include "mongo/util/with_alignment.h"
 
 namespace mongo {
 
@@ -120,7 +125,8 @@ public:
 
     /**
      * Release a cursor into the cursor cache and close old cursors if the number of cursors in the
-     * cache exceeds wiredTigerCursorCacheSize.
+     * cache exceeds its current capacity. The capacity starts at abs(wiredTigerCursorCacheSize)
+     * and adapts to the number of tables the session uses, up to wiredTigerCursorCacheMaxSize.
      */
     void releaseCursor(uint64_t id, WT_CURSOR* cursor);
 
@@ -145,6 +151,20 @@ public:
         return _cursors.size();
     }
 
+    /**
+     * The number of cursors this session currently keeps in its cursor cache before closing the
+     * least recently released ones.
+     */
+    uint32_t cursorCacheCapacity() const {
+        return _cursorCacheCapacity;
+    }
+
+    /**
+     * Appends the cursor cache counters of all sessions. Counters of a session are only included
+     * once it has been released to the session cache or destroyed.
+     */
+    static void appendCursorCacheStats(BSONObjBuilder* bob);
+
     bool isDropQueuedIdentsAtSessionEndAllowed() const {
         return _dropQueuedIdentsAtSessionEnd;
     }
@@ -192,6 +212,24 @@ private:
         return _cursorEpoch;
     }
 
+    // Used internally by WiredTigerSessionCache to publish the cursor cache counters accumulated
+    // by this session since the last flush.
+    void _flushCursorCacheStats();
+
+    // Counts a cursor cache lookup and adjusts the capacity of the cursor cache once enough
+    // lookups have been seen. A capacity miss is a miss on a table whose cursor this session
+    // evicted recently, which a larger cache would have avoided.
+    void _recordCursorCacheLookup(bool hit, bool capacityMiss);
+
+    struct CursorCacheCounters {
+        long long hits = 0;
+        long long misses = 0;
+        long long capacityMisses = 0;
+        long long evictions = 0;
+        long long capacityIncreases = 0;
+        long long capacityDecreases = 0;
+    };
+
     const uint64_t _epoch;
     uint64_t _cursorEpoch;
     WiredTigerSessionCache* _cache;  // not owned
@@ -201,6 +239,13 @@ private:
     int _cursorsOut;
     bool _dropQueuedIdentsAtSessionEnd = true;
     Date_t _idleExpireTime;
+
+    // State of the adaptive cursor cache.
+    uint32_t _cursorCacheCapacity;
+    stdx::unordered_set<uint64_t> _evictedCursorIds;  // table ids of recently evicted cursors
+    uint32_t _windowLookups = 0;
+    uint32_t _windowCapacityMisses = 0;
+    CursorCacheCounters _cursorCacheCounters;  // not yet flushed to the global counters
 };
 
 /**
@@ -376,9 +421,18 @@ private:
     AtomicWord<unsigned> _shuttingDown;
     static const uint32_t kShuttingDownMask = 1 << 31;
 
-    Mutex _cacheLock = MONGO_MAKE_LATCH("WiredTigerSessionCache::_cacheLock");
     typedef std::vector<WiredTigerSession*> SessionCache;
-    SessionCache _sessions;
+
+    // Idle sessions are kept in one freelist per partition, so that threads running on different
+    // CPUs do not contend on a single mutex. Sessions are released to the partition of the CPU the
+    // releasing thread runs on, and getSession() steals from other partitions when its own is
+    // empty.
+    struct Partition {
+        Mutex lock = MONGO_MAKE_LATCH("WiredTigerSessionCache::Partition::lock");
+        SessionCache sessions;
+    };
+    const size_t _numPartitions;
+    std::unique_ptr<CacheAligned<Partition>[]> _partitions;
 
     // Bumped when all open sessions need to be closed
     AtomicWord<unsigned long long> _epoch;  // atomic so we can check it outside of the lock
@@ -410,6 +464,12 @@ private:
     WT_SESSION* _waitUntilDurableSession = nullptr;  // owned, and never explicitly closed
                                                      // (uses connection close to clean up)
 
+    /**
+     * Returns the index of the partition that the current thread takes idle sessions from first
+     * and releases them to.
+     */
+    size_t _partitionIndexForCurrentThread() const;
+
     /**
      * Returns a session to the cache for later reuse. If closeAll was called between getting this
      * session and releasing it, the session is directly released. This method is thread safe.
@@ -31,12 +31,16 @@
 
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "mongo/base/string_data.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/system_clock_source.h"
 
 namespace mongo {
@@ -113,4 +117,110 @@ TEST(WiredTigerSessionCacheTest, CheckSessionCacheCleanup) {
     ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
 }
 
+TEST(WiredTigerSessionCacheTest, SessionsReleasedOnOtherThreadsAreReused) {
+    WiredTigerSessionCacheHarnessHelper harnessHelper("");
+    WiredTigerSessionCache* sessionCache = harnessHelper.getSessionCache();
+
+    // Release sessions from several threads, which may run on different CPUs and so return the
+    // sessions to different partitions of the cache.
+    const size_t kNumSessions = 8;
+    std::vector<stdx::thread> threads;
+    for (size_t i = 0; i < kNumSessions; ++i) {
+        threads.emplace_back([sessionCache] { sessionCache->getSession(); });
+    }
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+    const size_t numIdle = sessionCache->getIdleSessionsCount();
+    ASSERT_GTE(numIdle, 1U);
+    ASSERT_LTE(numIdle, kNumSessions);
+
+    // Every idle session can be taken from this thread, whichever partition it is in.
+    std::vector<UniqueWiredTigerSession> sessions;
+    for (size_t i = 0; i < numIdle; ++i) {
+        sessions.push_back(sessionCache->getSession());
+    }
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
+
+    sessions.clear();
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), numIdle);
+
+    // Closing all sessions empties every partition.
+    sessionCache->closeAll();
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
+
+    // Sessions acquired before closeAll are not returned to the cache.
+    auto session = sessionCache->getSession();
+    sessionCache->closeAll();
+    session.reset();
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
+}
+
+TEST(WiredTigerSessionCacheTest, CursorCacheAdaptsToWorkingSet) {
+    const auto oldCacheSize = gWiredTigerCursorCacheSize.load();
+    const auto oldMaxSize = gWiredTigerCursorCacheMaxSize.load();
+    gWiredTigerCursorCacheSize.store(4);
+    gWiredTigerCursorCacheMaxSize.store(64);
+    ON_BLOCK_EXIT([&] {
+        gWiredTigerCursorCacheSize.store(oldCacheSize);
+        gWiredTigerCursorCacheMaxSize.store(oldMaxSize);
+    });
+
+    WiredTigerSessionCacheHarnessHelper harnessHelper("");
+    WiredTigerSessionCache* sessionCache = harnessHelper.getSessionCache();
+    const std::string uri = "table:cursor_cache";
+
+    auto hitsBefore = [] {
+        BSONObjBuilder bob;
+        WiredTigerSession::appendCursorCacheStats(&bob);
+        return bob.obj()["cursor cache hits"].numberLong();
+    }();
+
+    {
+        UniqueWiredTigerSession session = sessionCache->getSession();
+        WT_SESSION* s = session->getSession();
+        ASSERT_OK(wtRCToStatus(s->create(s, uri.c_str(), "key_format=q,value_format=u")));
+        ASSERT_EQUALS(session->cursorCacheCapacity(), 4U);
+
+        // Use the cursor cache as if for 'numTables' tables.
+        auto useCursors = [&](uint64_t numTables, int rounds) {
+            int hits = 0;
+            for (int round = 0; round < rounds; ++round) {
+                for (uint64_t id = 0; id < numTables; ++id) {
+                    WT_CURSOR* cursor = session->getCachedCursor(uri, id);
+                    if (cursor) {
+                        ++hits;
+                    } else {
+                        cursor = session->getNewCursor(uri);
+                    }
+                    session->releaseCursor(id, cursor);
+                }
+            }
+            return hits;
+        };
+
+        // Cycling through more tables than the cache holds misses every time, so the cache grows
+        // until the tables fit.
+        useCursors(20, 100);
+        ASSERT_GTE(session->cursorCacheCapacity(), 20U);
+        ASSERT_LTE(session->cursorCacheCapacity(), 64U);
+        ASSERT_EQUALS(useCursors(20, 1), 20);
+
+        // The capacity never grows past wiredTigerCursorCacheMaxSize.
+        useCursors(50, 20);
+        ASSERT_EQUALS(session->cursorCacheCapacity(), 64U);
+
+        // Once the working set shrinks, the cache gives back capacity down to its base size.
+        useCursors(1, 10000);
+        ASSERT_EQUALS(session->cursorCacheCapacity(), 4U);
+
+        session->closeAllCursors("");
+    }
+
+    // The counters of the session are published once it is released.
+    BSONObjBuilder bob;
+    WiredTigerSession::appendCursorCacheStats(&bob);
+    ASSERT_GT(bob.obj()["cursor cache hits"].numberLong(), hitsBefore);
+}
+
 }  // namespace mongo
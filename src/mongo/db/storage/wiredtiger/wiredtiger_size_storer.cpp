@@ -31,6 +31,8 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
+#include <sched.h>
 #include <wiredtiger.h>
 
 #include "mongo/bson/bsonobj.h"
@@ -43,9 +45,108 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_size_storer.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 #include "mongo/logv2/log.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/util/processinfo.h"
 #include "mongo/util/scopeguard.h"
 
 namespace mongo {
+namespace {
+
+// Number of updates a SizeInfo takes on its base counters before switching to per-CPU shards.
+// Collections that are written to rarely never pay for the shards' memory.
+const unsigned kUpdatesBeforeSharding = 1024;
+
+const size_t kMaxShards = 64;
+
+size_t numShards() {
+    static const size_t shards =
+        std::clamp<size_t>(ProcessInfo::getNumAvailableCores(), 1, kMaxShards);
+    return shards;
+}
+
+size_t shardIndexForCurrentThread() {
+#ifdef __linux__
+    int cpu = sched_getcpu();
+    if (cpu >= 0) {
+        return static_cast<size_t>(cpu) % numShards();
+    }
+#endif
+    return std::hash<stdx::thread::id>()(stdx::this_thread::get_id()) % numShards();
+}
+
+}  // namespace
+
+WiredTigerSizeStorer::SizeInfo::~SizeInfo() {
+    invariant(!_dirty.load());
+    delete[] _shards.load();
+}
+
+long long WiredTigerSizeStorer::SizeInfo::numRecords() const {
+    return _sum(&Counters::numRecords);
+}
+
+long long WiredTigerSizeStorer::SizeInfo::dataSize() const {
+    return _sum(&Counters::dataSize);
+}
+
+void WiredTigerSizeStorer::SizeInfo::changeNumRecords(long long diff) {
+    _countersForUpdate().numRecords.fetchAndAdd(diff);
+}
+
+void WiredTigerSizeStorer::SizeInfo::changeDataSize(long long diff) {
+    _countersForUpdate().dataSize.fetchAndAdd(diff);
+}
+
+void WiredTigerSizeStorer::SizeInfo::setNumRecords(long long records) {
+    _set(&Counters::numRecords, records);
+}
+
+void WiredTigerSizeStorer::SizeInfo::setDataSize(long long size) {
+    _set(&Counters::dataSize, size);
+}
+
+WiredTigerSizeStorer::SizeInfo::Counters& WiredTigerSizeStorer::SizeInfo::_countersForUpdate() {
+    if (auto shards = _shards.load()) {
+        return shards[shardIndexForCurrentThread()];
+    }
+
+    if (_shardingDisabled.load() || numShards() == 1 ||
+        _baseUpdates.fetchAndAdd(1) < kUpdatesBeforeSharding) {
+        return _base;
+    }
+
+    // Only one thread installs the shards. The others free their copy and use the winner's.
+    auto newShards = new CacheAligned<Counters>[numShards()];
+    CacheAligned<Counters>* expected = nullptr;
+    if (!_shards.compareAndSwap(&expected, newShards)) {
+        delete[] newShards;
+        return expected[shardIndexForCurrentThread()];
+    }
+    return newShards[shardIndexForCurrentThread()];
+}
+
+long long WiredTigerSizeStorer::SizeInfo::_sum(AtomicWord<long long> Counters::*counter) const {
+    long long sum = (_base.*counter).load();
+    if (auto shards = _shards.load()) {
+        for (size_t i = 0; i < numShards(); ++i) {
+            sum += (shards[i].*counter).load();
+        }
+    }
+
+    // Sizes are only approximate after an unclean shutdown, in which case removals may take them
+    // below zero. Never report negative sizes.
+    return std::max(sum, 0LL);
+}
+
+void WiredTigerSizeStorer::SizeInfo::_set(AtomicWord<long long> Counters::*counter,
+                                          long long value) {
+    (_base.*counter).store(value);
+    if (auto shards = _shards.load()) {
+        for (size_t i = 0; i < numShards(); ++i) {
+            (shards[i].*counter).store(0);
+        }
+    }
+}
 
 WiredTigerSizeStorer::WiredTigerSizeStorer(WT_CONNECTION* conn,
                                            const std::string& storageUri,
@@ -88,8 +189,8 @@ void WiredTigerSizeStorer::store(StringData uri, std::shared_ptr<SizeInfo> sizeI
         "WiredTigerSizeStorer::store Marking {uri} dirty, numRecords: {sizeInfo_numRecords_load}, "
         "dataSize: {sizeInfo_dataSize_load}, use_count: {entry_use_count}",
         "uri"_attr = uri,
-        "sizeInfo_numRecords_load"_attr = sizeInfo->numRecords.load(),
-        "sizeInfo_dataSize_load"_attr = sizeInfo->dataSize.load(),
+        "sizeInfo_numRecords_load"_attr = sizeInfo->numRecords(),
+        "sizeInfo_dataSize_load"_attr = sizeInfo->dataSize(),
         "entry_use_count"_attr = entry.use_count());
 }
 
@@ -126,8 +227,12 @@ std::shared_ptr<WiredTigerSizeStorer::SizeInfo> WiredTigerSizeStorer::load(Strin
                 "WiredTigerSizeStorer::load {uri} -> {data}",
                 "uri"_attr = uri,
                 "data"_attr = redact(data));
+    auto oplogStones = data["oplogStones"];
     return std::make_shared<SizeInfo>(data["numRecords"].safeNumberLong(),
-                                      data["dataSize"].safeNumberLong());
+                                      data["dataSize"].safeNumberLong(),
+                                      oplogStones.type() == BSONType::Object
+                                          ? oplogStones.Obj().getOwned()
+                                          : BSONObj());
 }
 
 void WiredTigerSizeStorer::flush(bool syncToDisk) {
@@ -163,8 +268,14 @@ void WiredTigerSizeStorer::flush(bool syncToDisk) {
             // still be written back. So, the required order is to clear the dirty flag first.
             SizeInfo& sizeInfo = *it->second;
             sizeInfo._dirty.store(false);
-            BSONObj data = BSON("numRecords" << sizeInfo.numRecords.load() << "dataSize"
-                                             << sizeInfo.dataSize.load());
+            BSONObjBuilder dataBuilder;
+            dataBuilder.append("numRecords", sizeInfo.numRecords());
+            dataBuilder.append("dataSize", sizeInfo.dataSize());
+            auto oplogStones = sizeInfo.oplogStones();
+            if (!oplogStones.isEmpty()) {
+                dataBuilder.append("oplogStones", oplogStones);
+            }
+            BSONObj data = dataBuilder.obj();
 
             auto& uri = it->first;
             LOGV2_DEBUG(22425,
@@ -34,17 +34,21 @@
 #include <wiredtiger.h>
 
 #include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobj.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/util/string_map.h"
+#include "mongo/util/synchronized_value.h"
+#include "mongo/util/with_alignment.h"
 
 namespace mongo {
 
 /**
  * The WiredTigerSizeStorer class serves as a write buffer to durably store size information for
  * MongoDB collections. The size storer uses a separate WiredTiger table as key-value store, where
- * the URI serves as key and the value is a BSON document with `numRecords` and `dataSize` fields.
+ * the URI serves as key and the value is a BSON document with `numRecords` and `dataSize` fields,
+ * and for the oplog an `oplogStones` field with its truncation markers.
  * This buffering is neccessary to allow concurrent updates of size information without causing
  * write conflicts. The dirty size information is periodically stored written back to the table,
  * including on clean shutdown and/or catalog reload. Crashes or replica-set fail-overs may result
@@ -60,20 +64,83 @@ public:
      * ownership. The SizeInfo may still be updated after it is stored in the SizeStorer.
      * The 'dirty' field is used by the size storer to cheaply merge duplicate stores of the same
      * SizeInfo.
+     *
+     * Updates to a SizeInfo start out on a single pair of counters. Once a SizeInfo has taken
+     * enough updates to indicate a hot collection, it switches to per-CPU shards of counters, so
+     * that concurrent writers on different CPUs do not contend on the same cache line. Reads sum
+     * the shards and therefore see every update that preceded them.
      */
     struct SizeInfo {
         SizeInfo() = default;
-        SizeInfo(long long records, long long size) : numRecords(records), dataSize(size) {}
+        SizeInfo(long long records, long long size, BSONObj oplogStones = BSONObj())
+            : _oplogStones(std::move(oplogStones)) {
+            _base.numRecords.store(records);
+            _base.dataSize.store(size);
+        }
+
+        ~SizeInfo();
+
+        long long numRecords() const;
+        long long dataSize() const;
+
+        void changeNumRecords(long long diff);
+        void changeDataSize(long long diff);
+
+        /**
+         * Overwrite the counters. Not atomic with respect to concurrent changes, which may or may
+         * not be reflected in the result.
+         */
+        void setNumRecords(long long records);
+        void setDataSize(long long size);
+
+        /**
+         * The truncation markers of the oplog, as last set by its record store, so that they can
+         * be loaded at startup instead of being recomputed. Empty for other collections.
+         */
+        BSONObj oplogStones() const {
+            return _oplogStones.get();
+        }
+        void setOplogStones(BSONObj oplogStones) {
+            _oplogStones = std::move(oplogStones);
+        }
 
-        ~SizeInfo() {
-            invariant(!_dirty.load());
+        /**
+         * Keeps this SizeInfo on a single pair of counters. Used for collections, such as capped
+         * collections, whose sizes are read on every write.
+         */
+        void disableSharding() {
+            _shardingDisabled.store(true);
         }
-        AtomicWord<long long> numRecords;
-        AtomicWord<long long> dataSize;
 
     private:
         friend WiredTigerSizeStorer;
+
+        struct Counters {
+            AtomicWord<long long> numRecords;
+            AtomicWord<long long> dataSize;
+        };
+
+        /**
+         * Returns the counters the current thread should apply an update to, switching to
+         * per-CPU shards once this SizeInfo has taken enough updates.
+         */
+        Counters& _countersForUpdate();
+
+        long long _sum(AtomicWord<long long> Counters::*counter) const;
+        void _set(AtomicWord<long long> Counters::*counter, long long value);
+
+        CacheAligned<Counters> _base;
+
+        // Number of updates applied to '_base', used to decide when to switch to '_shards'.
+        AtomicWord<unsigned> _baseUpdates{0};
+
+        // Array of numShards() per-CPU counters, or null before the switch.
+        AtomicWord<CacheAligned<Counters>*> _shards{nullptr};
+
+        AtomicWord<bool> _shardingDisabled{false};
         AtomicWord<bool> _dirty;
+
+        synchronized_value<BSONObj> _oplogStones;
     };
 
     WiredTigerSizeStorer(WT_CONNECTION* conn,
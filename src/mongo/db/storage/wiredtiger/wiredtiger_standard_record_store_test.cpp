@@ -33,6 +33,7 @@
 #include <sstream>
 #include <string>
 #include <time.h>
+#include <vector>
 
 #include "mongo/base/checked_cast.h"
 #include "mongo/base/init.h"
@@ -53,6 +54,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_size_storer.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/clock_source_mock.h"
@@ -254,7 +256,7 @@ TEST(WiredTigerRecordStoreTest, SizeStorer1) {
 
     {
         auto& info = *ss.load(uri);
-        ASSERT_EQUALS(N, info.numRecords.load());
+        ASSERT_EQUALS(N, info.numRecords());
     }
 
     {
@@ -302,7 +304,7 @@ TEST(WiredTigerRecordStoreTest, SizeStorer1) {
         const bool enableWtLogging = false;
         WiredTigerSizeStorer ss2(harnessHelper->conn(), indexUri, enableWtLogging);
         auto info = ss2.load(uri);
-        ASSERT_EQUALS(N, info->numRecords.load());
+        ASSERT_EQUALS(N, info->numRecords());
     }
 
     rs.reset(nullptr);  // this has to be deleted before ss
@@ -332,11 +334,11 @@ private:
 
 protected:
     long long getNumRecords() const {
-        return sizeStorer->load(uri)->numRecords.load();
+        return sizeStorer->load(uri)->numRecords();
     }
 
     long long getDataSize() const {
-        return sizeStorer->load(uri)->dataSize.load();
+        return sizeStorer->load(uri)->dataSize();
     }
 
     std::unique_ptr<WiredTigerHarnessHelper> harnessHelper;
@@ -355,5 +357,76 @@ TEST_F(SizeStorerUpdateTest, Basic) {
     ASSERT_EQUALS(getDataSize(), val);
 }
 
+// Concurrent size changes are all accounted for once the size info has switched to per-CPU
+// counters, both in memory and once flushed to the size storer.
+TEST_F(SizeStorerUpdateTest, ConcurrentChangesAreExact) {
+    const int kThreads = 8;
+    const int kChangesPerThread = 10000;
+
+    auto info = sizeStorer->load(uri);
+    std::vector<stdx::thread> threads;
+    for (int i = 0; i < kThreads; ++i) {
+        threads.emplace_back([&] {
+            for (int j = 0; j < kChangesPerThread; ++j) {
+                info->changeNumRecords(1);
+                info->changeDataSize(3);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQUALS(kThreads * kChangesPerThread, info->numRecords());
+    ASSERT_EQUALS(3 * kThreads * kChangesPerThread, info->dataSize());
+
+    sizeStorer->store(uri, info);
+    sizeStorer->flush(true);
+    const bool enableWtLogging = false;
+    WiredTigerSizeStorer reopened(
+        harnessHelper->conn(), WiredTigerKVEngine::kTableUriPrefix + "sizeStorer", enableWtLogging);
+    ASSERT_EQUALS(kThreads * kChangesPerThread, reopened.load(uri)->numRecords());
+    ASSERT_EQUALS(3 * kThreads * kChangesPerThread, reopened.load(uri)->dataSize());
+
+    // Overwriting the sizes discards the per-CPU counts.
+    info->setNumRecords(7);
+    info->setDataSize(11);
+    ASSERT_EQUALS(7, info->numRecords());
+    ASSERT_EQUALS(11, info->dataSize());
+}
+
+// The oplog truncation markers are written back along with the sizes, and only when set.
+TEST_F(SizeStorerUpdateTest, OplogStonesAreFlushed) {
+    auto info = sizeStorer->load(uri);
+    ASSERT_BSONOBJ_EQ(BSONObj(), info->oplogStones());
+
+    info->setNumRecords(3);
+    sizeStorer->store(uri, info);
+    sizeStorer->flush(true);
+
+    const bool enableWtLogging = false;
+    {
+        WiredTigerSizeStorer reopened(harnessHelper->conn(),
+                                      WiredTigerKVEngine::kTableUriPrefix + "sizeStorer",
+                                      enableWtLogging);
+        ASSERT_BSONOBJ_EQ(BSONObj(), reopened.load(uri)->oplogStones());
+    }
+
+    const BSONObj oplogStones =
+        BSON("minBytesPerStone" << 100LL << "stones"
+                                << BSON_ARRAY(BSON("records" << 2LL << "bytes" << 120LL
+                                                             << "lastRecord" << 5LL << "wallTime"
+                                                             << Date_t::fromMillisSinceEpoch(1))));
+    info->setOplogStones(oplogStones);
+    sizeStorer->store(uri, info);
+    sizeStorer->flush(true);
+
+    WiredTigerSizeStorer reopened(
+        harnessHelper->conn(), WiredTigerKVEngine::kTableUriPrefix + "sizeStorer", enableWtLogging);
+    auto reloaded = reopened.load(uri);
+    ASSERT_EQUALS(3, reloaded->numRecords());
+    ASSERT_BSONOBJ_EQ(oplogStones, reloaded->oplogStones());
+}
+
 }  // namespace
 }  // namespace mongo
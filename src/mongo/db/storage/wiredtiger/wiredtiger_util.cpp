@@ -33,6 +33,7 @@
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 
+#include <algorithm>
 #include <limits>
 
 #include <boost/filesystem.hpp>
@@ -454,6 +455,68 @@ StatusWith<int64_t> WiredTigerUtil::getStatisticsValue(WT_SESSION* session,
     return StatusWith<int64_t>(value);
 }
 
+Status WiredTigerUtil::appendIOStats(WT_SESSION* session,
+                                     const std::string& uri,
+                                     BSONObjBuilder* bob) {
+    invariant(session);
+    static const std::pair<StringData, int> kIOStatistics[] = {
+        {"bytesInCache"_sd, WT_STAT_DSRC_CACHE_BYTES_INUSE},
+        {"bytesReadFromDisk"_sd, WT_STAT_DSRC_CACHE_BYTES_READ},
+        {"pagesReadFromDisk"_sd, WT_STAT_DSRC_CACHE_READ},
+        {"pagesRequestedFromCache"_sd, WT_STAT_DSRC_CACHE_PAGES_REQUESTED},
+        {"bytesWrittenFromCache"_sd, WT_STAT_DSRC_CACHE_BYTES_WRITE},
+        {"pagesWrittenFromCache"_sd, WT_STAT_DSRC_CACHE_WRITE},
+        {"modifiedPagesEvicted"_sd, WT_STAT_DSRC_CACHE_EVICTION_DIRTY},
+        {"unmodifiedPagesEvicted"_sd, WT_STAT_DSRC_CACHE_EVICTION_CLEAN},
+    };
+
+    const std::string statisticsURI = "statistics:" + uri;
+    WT_CURSOR* cursor = nullptr;
+    int ret =
+        session->open_cursor(session, statisticsURI.c_str(), nullptr, "statistics=(fast)", &cursor);
+    if (ret != 0) {
+        return Status(ErrorCodes::CursorNotFound,
+                      str::stream() << "unable to open cursor at URI " << statisticsURI
+                                    << ". reason: " << wiredtiger_strerror(ret));
+    }
+    invariant(cursor);
+    ON_BLOCK_EXIT([&] { cursor->close(cursor); });
+
+    int64_t pagesRead = 0;
+    int64_t pagesRequested = 0;
+    for (auto&& [name, statisticsKey] : kIOStatistics) {
+        cursor->set_key(cursor, statisticsKey);
+        ret = cursor->search(cursor);
+        if (ret != 0) {
+            return Status(ErrorCodes::NoSuchKey,
+                          str::stream() << "unable to find key " << statisticsKey << " at URI "
+                                        << statisticsURI
+                                        << ". reason: " << wiredtiger_strerror(ret));
+        }
+
+        int64_t value;
+        ret = cursor->get_value(cursor, nullptr, nullptr, &value);
+        if (ret != 0) {
+            return Status(ErrorCodes::BadValue,
+                          str::stream() << "unable to get value for key " << statisticsKey
+                                        << " at URI " << statisticsURI
+                                        << ". reason: " << wiredtiger_strerror(ret));
+        }
+
+        if (statisticsKey == WT_STAT_DSRC_CACHE_READ) {
+            pagesRead = value;
+        } else if (statisticsKey == WT_STAT_DSRC_CACHE_PAGES_REQUESTED) {
+            pagesRequested = value;
+        }
+        bob->append(name, static_cast<long long>(value));
+    }
+
+    // Every page requested from the cache which was not read into it from disk was found in it.
+    bob->append("pagesReadFromCache",
+                static_cast<long long>(std::max<int64_t>(pagesRequested - pagesRead, 0)));
+    return Status::OK();
+}
+
 int64_t WiredTigerUtil::getIdentSize(WT_SESSION* s, const std::string& uri) {
     StatusWith<int64_t> result = WiredTigerUtil::getStatisticsValue(
         s, "statistics:" + uri, "statistics=(size)", WT_STAT_DSRC_BLOCK_SIZE);
@@ -242,6 +242,14 @@ public:
                                                   const std::string& config,
                                                   int statisticsKey);
 
+    /**
+     * Appends the cache and disk I/O statistics of the table at 'uri' to 'bob': the bytes and
+     * pages read into the cache from disk, the pages found in the cache, the bytes and pages
+     * written from the cache, and the pages evicted. WiredTiger counts them from when the data
+     * handle of the table was opened.
+     */
+    static Status appendIOStats(WT_SESSION* session, const std::string& uri, BSONObjBuilder* bob);
+
     static int64_t getIdentSize(WT_SESSION* s, const std::string& uri);
 
     /**
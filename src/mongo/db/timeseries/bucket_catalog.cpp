@@ -301,6 +301,7 @@ BucketCatalog::CommitData BucketCatalog::commit(const BucketId& bucketId,
             _buckets.erase(it);
         } else if (bucket->numWriters == 0) {
             _markBucketIdle(bucketId);
+            bucket->idle = true;
         }
     } else {
         stats->numCommits.fetchAndAddRelaxed(1);
@@ -425,7 +426,7 @@ void BucketCatalog::_removeBucket(const BucketId& bucketId,
     }
 
     if (idleBucketsIt) {
-        _markBucketNotIdle(*idleBucketsIt);
+        _idleBucketsStripe(bucketId).buckets.erase(*idleBucketsIt);
     } else {
         _markBucketNotIdle(it->first);
     }
@@ -434,33 +435,61 @@ void BucketCatalog::_removeBucket(const BucketId& bucketId,
     _buckets.erase(it);
 }
 
+BucketCatalog::IdleBucketsStripe& BucketCatalog::_idleBucketsStripe(const BucketId& bucketId) {
+    return _idleBuckets[absl::Hash<BucketId>{}(bucketId) % _idleBuckets.size()];
+}
+
 void BucketCatalog::_markBucketIdle(const BucketId& bucketId) {
-    stdx::lock_guard lk{_idleBucketsLock};
-    _idleBuckets.insert(bucketId);
+    auto& stripe = _idleBucketsStripe(bucketId);
+    stdx::lock_guard lk{stripe.lock};
+    stripe.buckets.insert(bucketId);
 }
 
-void BucketCatalog::_markBucketNotIdle(const BucketId& bucketId) {
-    stdx::lock_guard lk{_idleBucketsLock};
-    _idleBuckets.erase(bucketId);
+void BucketCatalog::_markBucketNotIdle(const BucketId& bucketId, Bucket* bucket) {
+    if (bucket->idle) {
+        _markBucketNotIdle(bucketId);
+        bucket->idle = false;
+    }
 }
 
-void BucketCatalog::_markBucketNotIdle(const IdleBuckets::iterator& it) {
-    _idleBuckets.erase(it);
+void BucketCatalog::_markBucketNotIdle(const BucketId& bucketId) {
+    auto& stripe = _idleBucketsStripe(bucketId);
+    stdx::lock_guard lk{stripe.lock};
+    stripe.buckets.erase(bucketId);
 }
 
 void BucketCatalog::_expireIdleBuckets(ExecutionStats* stats) {
-    stdx::lock_guard lk{_idleBucketsLock};
-    while (!_idleBuckets.empty() &&
-           _memoryUsage.load() >
-               static_cast<std::uint64_t>(gTimeseriesIdleBucketExpiryMemoryUsageThreshold)) {
-        _removeBucket(*_idleBuckets.begin(), boost::none, _idleBuckets.begin());
-        stats->numBucketsClosedDueToMemoryThreshold.fetchAndAddRelaxed(1);
+    auto overThreshold = [&] {
+        return _memoryUsage.load() >
+            static_cast<std::uint64_t>(gTimeseriesIdleBucketExpiryMemoryUsageThreshold);
+    };
+
+    // Expire the oldest bucket of each stripe in turn until enough memory has been freed.
+    bool expiredAny = true;
+    while (expiredAny && overThreshold()) {
+        expiredAny = false;
+        for (auto& stripe : _idleBuckets) {
+            stdx::lock_guard lk{stripe.lock};
+            if (stripe.buckets.empty()) {
+                continue;
+            }
+            if (!overThreshold()) {
+                return;
+            }
+            _removeBucket(*stripe.buckets.begin(), boost::none, stripe.buckets.begin());
+            stats->numBucketsClosedDueToMemoryThreshold.fetchAndAddRelaxed(1);
+            expiredAny = true;
+        }
     }
 }
 
 std::size_t BucketCatalog::_numberOfIdleBuckets() const {
-    stdx::lock_guard lk{_idleBucketsLock};
-    return _idleBuckets.size();
+    std::size_t numIdleBuckets = 0;
+    for (const auto& stripe : _idleBuckets) {
+        stdx::lock_guard lk{stripe.lock};
+        numIdleBuckets += stripe.buckets.size();
+    }
+    return numIdleBuckets;
 }
 
 BucketCatalog::BucketIdInternal BucketCatalog::_createNewBucketId(const Date_t& time,
@@ -585,7 +614,6 @@ bool BucketCatalog::BucketAccess::_findAndLockExisting(std::size_t hash) {
         _id = it->second;
     }
 
-    _catalog->_markBucketNotIdle(_id);
     auto it = _catalog->_buckets.find(_id);
     if (it == _catalog->_buckets.end()) {
         // Bucket does not exist.
@@ -594,6 +622,7 @@ bool BucketCatalog::BucketAccess::_findAndLockExisting(std::size_t hash) {
     _bucket = it->second;
 
     _acquire();
+    _catalog->_markBucketNotIdle(_id, _bucket.get());
 
     return true;
 }
@@ -612,7 +641,6 @@ void BucketCatalog::BucketAccess::_findOrCreateAndLock(std::size_t hash) {
         _id = it->second;
     }
 
-    _catalog->_markBucketNotIdle(_id);
     auto it = _catalog->_buckets.find(_id);
     if (it != _catalog->_buckets.end()) {
         _bucket = it->second;
@@ -621,6 +649,7 @@ void BucketCatalog::BucketAccess::_findOrCreateAndLock(std::size_t hash) {
         _create(_id);
     }
     _acquire();
+    _catalog->_markBucketNotIdle(_id, _bucket.get());
 }
 
 void BucketCatalog::BucketAccess::_acquire() {
@@ -679,7 +708,6 @@ void BucketCatalog::BucketAccess::rollover(const std::function<bool(BucketAccess
         mappedId = &it->second;
     }
 
-    _catalog->_markBucketNotIdle(_id);
     auto it = _catalog->_buckets.find(_id);
     if (it != _catalog->_buckets.end()) {
         _bucket = it->second;
@@ -687,6 +715,7 @@ void BucketCatalog::BucketAccess::rollover(const std::function<bool(BucketAccess
         _create(_id);
     }
     _acquire();
+    _catalog->_markBucketNotIdle(_id, _bucket.get());
 
     // Recheck if still full now that we've reacquired the bucket.
     bool newBucket = oldId != _id;  // Only record stats if bucket has changed, don't double-count.
@@ -324,6 +324,10 @@ private:
         // range.
         bool full = false;
 
+        // Whether the bucket is in the catalog's idle buckets. This lets BucketAccess skip the idle
+        // buckets lock unless the bucket actually has to be removed from them.
+        bool idle = false;
+
         // Approximate memory usage of this bucket.
         uint64_t memoryUsage = sizeof(*this);
 
@@ -448,7 +452,11 @@ private:
 
     void _markBucketIdle(const BucketId& bucketId);
     void _markBucketNotIdle(const BucketId& bucketId);
-    void _markBucketNotIdle(const IdleBuckets::iterator& it);
+
+    /**
+     * Removes the given bucket from the idle buckets if it is idle. The bucket must be locked.
+     */
+    void _markBucketNotIdle(const BucketId& bucketId, Bucket* bucket);
 
     /**
      * Expires idle buckets until the bucket catalog's memory usage is below the expiry threshold.
@@ -492,11 +500,19 @@ private:
     // All buckets ordered by their namespaces.
     NsBuckets _nsBuckets;
 
-    // This mutex protects access to _idleBuckets
-    mutable Mutex _idleBucketsLock = MONGO_MAKE_LATCH("BucketCatalog::_idleBucketsLock");
+    struct IdleBucketsStripe {
+        // This mutex protects access to 'buckets'.
+        mutable Mutex lock = MONGO_MAKE_LATCH("BucketCatalog::IdleBucketsStripe::lock");
+
+        IdleBuckets buckets;
+    };
+
+    IdleBucketsStripe& _idleBucketsStripe(const BucketId& bucketId);
 
-    // Buckets that do not have any writers.
-    IdleBuckets _idleBuckets;
+    // Buckets that do not have any writers, striped by bucket id so that buckets becoming idle and
+    // not idle on different threads do not contend on a single mutex. Idle buckets are expired
+    // oldest first within each stripe.
+    std::array<IdleBucketsStripe, StripedMutex::kNumStripes> _idleBuckets;
 
     /**
      * This mutex protects access to the _executionStats map. Once you complete your lookup, you
@@ -35,6 +35,7 @@
 #include "mongo/db/views/view_catalog.h"
 #include "mongo/unittest/bson_test_util.h"
 #include "mongo/unittest/death_test.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -212,6 +213,43 @@ TEST_F(BucketCatalogTest, InsertBetweenCommits) {
     ASSERT(result2.getValue().commitInfo->isReady());
 }
 
+TEST_F(BucketCatalogTest, ExpireIdleBucketsOverMemoryThreshold) {
+    // Leave behind idle buckets for a number of different metadata values.
+    constexpr int kNumBuckets = 40;
+    for (int i = 0; i < kNumBuckets; ++i) {
+        auto result = _bucketCatalog->insert(
+            _opCtx, _ns1, BSON(_timeField << Date_t::now() << _metaField << i));
+        _commit(result.getValue().bucketId, 0);
+    }
+
+    // Writing to a bucket again means it is no longer idle.
+    auto result1 =
+        _bucketCatalog->insert(_opCtx, _ns1, BSON(_timeField << Date_t::now() << _metaField << 0));
+    ASSERT(!result1.getValue().commitInfo);
+
+    auto threshold = gTimeseriesIdleBucketExpiryMemoryUsageThreshold;
+    ON_BLOCK_EXIT([&] { gTimeseriesIdleBucketExpiryMemoryUsageThreshold = threshold; });
+    gTimeseriesIdleBucketExpiryMemoryUsageThreshold = 1;
+
+    // Opening a bucket for new metadata expires every idle bucket.
+    _insertOneAndCommit(_ns1, 0);
+
+    BSONObjBuilder builder;
+    _bucketCatalog->appendExecutionStats(_ns1, &builder);
+    ASSERT_EQ(kNumBuckets - 1, builder.obj()["numBucketsClosedDueToMemoryThreshold"].numberLong());
+
+    // The bucket in use was not expired.
+    auto result2 =
+        _bucketCatalog->insert(_opCtx, _ns1, BSON(_timeField << Date_t::now() << _metaField << 0));
+    ASSERT_EQ(*result1.getValue().bucketId, *result2.getValue().bucketId);
+    ASSERT(result2.getValue().commitInfo);
+    auto data = _bucketCatalog->commit(result1.getValue().bucketId);
+    ASSERT_EQ(data.docs.size(), 2);
+    ASSERT_EQ(data.numCommittedMeasurements, 1);
+    _bucketCatalog->commit(result1.getValue().bucketId, _commitInfo);
+    ASSERT(result2.getValue().commitInfo->isReady());
+}
+
 DEATH_TEST_F(BucketCatalogTest, CannotProvideCommitInfoOnFirstCommit, "invariant") {
     auto result = _bucketCatalog->insert(_opCtx, _ns1, BSON(_timeField << Date_t::now()));
     auto& [bucketId, _] = result.getValue();
@@ -0,0 +1,434 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/timeseries/bucket_compression.h"
+
+#include <cstring>
+#include <limits>
+
+#include "mongo/base/data_view.h"
+#include "mongo/bson/bson_validate.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/platform/bits.h"
+#include "mongo/util/decimal_counter.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace timeseries {
+namespace {
+
+constexpr StringData kControlFieldName = "control"_sd;
+constexpr StringData kVersionFieldName = "version"_sd;
+constexpr StringData kDataFieldName = "data"_sd;
+
+// A compressed column is a BSON object holding the values stored verbatim, under empty field
+// names, followed by a stream of records. Each record starts with one of the bytes below, and the
+// stream ends with kEnd.
+enum Op : uint8_t {
+    kEnd = 0,        // The end of the column.
+    kSkip = 1,       // A varint count of rows without a value.
+    kRepeat = 2,     // A varint count of rows whose values are produced by applying the previous
+                     // value record again.
+    kLiteral = 3,    // The next value of the leading object.
+    kDateDelta = 4,  // A zigzag varint change in the delta between consecutive Date values.
+    kDoubleXor = 5,  // A shift byte followed by the varint XOR with the previous double value,
+                     // shifted right by that many bits.
+};
+
+// A kDoubleXor record with more significant bits than this is no smaller than a literal.
+constexpr int kMaxDoubleXorSignificantBits = 56;
+
+void appendVarint(BufBuilder* buf, uint64_t value) {
+    while (value >= 0x80) {
+        buf->appendUChar(static_cast<unsigned char>(value | 0x80));
+        value >>= 7;
+    }
+    buf->appendUChar(static_cast<unsigned char>(value));
+}
+
+uint64_t zigzagEncode(uint64_t value) {
+    return (value << 1) ^ static_cast<uint64_t>(static_cast<int64_t>(value) >> 63);
+}
+
+uint64_t zigzagDecode(uint64_t value) {
+    return (value >> 1) ^ (0 - (value & 1));
+}
+
+uint64_t readBits(const BSONElement& elem) {
+    return ConstDataView(elem.value()).read<LittleEndian<uint64_t>>();
+}
+
+/**
+ * The value most recently produced while compressing or decompressing a column, along with the
+ * value record that produced it so that a kRepeat record can apply that record again. Dates and
+ * doubles are tracked as their bit patterns, so that every value round-trips exactly.
+ */
+class ColumnState {
+public:
+    bool empty() const {
+        return _type == EOO;
+    }
+
+    BSONType type() const {
+        return _type;
+    }
+
+    /**
+     * Returns true if the current value is bitwise identical to the value of 'elem'.
+     */
+    bool equals(const BSONElement& elem) const {
+        if (elem.type() != _type) {
+            return false;
+        }
+        if (_type == Date || _type == NumberDouble) {
+            return readBits(elem) == _bits;
+        }
+        return _literal.binaryEqualValues(elem);
+    }
+
+    void appendTo(BSONObjBuilder* builder, StringData fieldName) const {
+        if (_type == Date) {
+            builder->appendDate(fieldName,
+                                Date_t::fromMillisSinceEpoch(static_cast<long long>(_bits)));
+        } else if (_type == NumberDouble) {
+            double value;
+            std::memcpy(&value, &_bits, sizeof(value));
+            builder->append(fieldName, value);
+        } else {
+            builder->appendAs(_literal, fieldName);
+        }
+    }
+
+    /**
+     * Returns the operand of the kDateDelta record which produces the Date value of 'elem'.
+     */
+    uint64_t deltaOfDeltaTo(const BSONElement& elem) const {
+        return readBits(elem) - _bits - _dateDelta;
+    }
+
+    /**
+     * Returns the operand of the kDoubleXor record which produces the double value of 'elem'.
+     */
+    uint64_t xorTo(const BSONElement& elem) const {
+        return readBits(elem) ^ _bits;
+    }
+
+    void applyLiteral(const BSONElement& elem) {
+        _type = elem.type();
+        _literal = elem;
+        _dateDelta = 0;
+        if (_type == Date || _type == NumberDouble) {
+            _bits = readBits(elem);
+        }
+        _lastOp = kLiteral;
+    }
+
+    void applyDateDelta(uint64_t deltaOfDelta) {
+        _dateDelta += deltaOfDelta;
+        _bits += _dateDelta;
+        _lastOp = kDateDelta;
+        _lastOperand = deltaOfDelta;
+    }
+
+    void applyDoubleXor(uint64_t bits) {
+        _bits ^= bits;
+        _lastOp = kDoubleXor;
+        _lastOperand = bits;
+    }
+
+    /**
+     * Applies the most recent value record again.
+     */
+    void repeat() {
+        switch (_lastOp) {
+            case kLiteral:
+                applyLiteral(_literal);
+                break;
+            case kDateDelta:
+                applyDateDelta(_lastOperand);
+                break;
+            case kDoubleXor:
+                applyDoubleXor(_lastOperand);
+                break;
+            default:
+                MONGO_UNREACHABLE;
+        }
+    }
+
+private:
+    BSONType _type = EOO;
+    BSONElement _literal;
+
+    // The bits of the current Date or double value, and the delta from the previous Date value.
+    uint64_t _bits = 0;
+    uint64_t _dateDelta = 0;
+
+    Op _lastOp = kEnd;
+    uint64_t _lastOperand = 0;
+};
+
+/**
+ * Reads the record stream of a compressed column, throwing if it ends prematurely.
+ */
+class RecordReader {
+public:
+    RecordReader(const char* begin, const char* end) : _pos(begin), _end(end) {}
+
+    uint8_t readByte() {
+        uassert(5502135, "Truncated compressed time-series column", _pos < _end);
+        return static_cast<uint8_t>(*_pos++);
+    }
+
+    uint64_t readVarint() {
+        uint64_t value = 0;
+        for (int shift = 0;; shift += 7) {
+            uassert(5502136, "Invalid varint in compressed time-series column", shift < 64);
+            auto byte = readByte();
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) {
+                return value;
+            }
+        }
+    }
+
+private:
+    const char* _pos;
+    const char* _end;
+};
+
+/**
+ * Returns the row index that 'fieldName' is the canonical decimal representation of, or
+ * boost::none if there is no such index.
+ */
+boost::optional<uint32_t> parseRowIndex(StringData fieldName) {
+    if (fieldName.empty() || fieldName.size() > 10 ||
+        (fieldName[0] == '0' && fieldName.size() > 1)) {
+        return boost::none;
+    }
+    uint64_t index = 0;
+    for (char c : fieldName) {
+        if (c < '0' || c > '9') {
+            return boost::none;
+        }
+        index = index * 10 + (c - '0');
+    }
+    if (index > std::numeric_limits<uint32_t>::max()) {
+        return boost::none;
+    }
+    return static_cast<uint32_t>(index);
+}
+
+/**
+ * Appends the compressed form of the version 1 column 'column' to 'buf'. Returns false if the
+ * column is not keyed by increasing row indexes.
+ */
+bool compressColumn(const BSONObj& column, BufBuilder* buf) {
+    BSONObjBuilder literals;
+    BufBuilder records;
+    ColumnState state;
+    uint64_t nextRow = 0;
+    uint64_t pendingRepeats = 0;
+
+    auto flushRepeats = [&] {
+        if (pendingRepeats) {
+            records.appendUChar(kRepeat);
+            appendVarint(&records, pendingRepeats);
+            pendingRepeats = 0;
+        }
+    };
+
+    for (auto&& elem : column) {
+        auto row = parseRowIndex(elem.fieldNameStringData());
+        if (!row || *row < nextRow) {
+            return false;
+        }
+        if (*row > nextRow) {
+            flushRepeats();
+            records.appendUChar(kSkip);
+            appendVarint(&records, *row - nextRow);
+        }
+        nextRow = *row + 1;
+
+        if (!state.empty()) {
+            ColumnState repeated = state;
+            repeated.repeat();
+            if (repeated.equals(elem)) {
+                state = repeated;
+                ++pendingRepeats;
+                continue;
+            }
+        }
+        flushRepeats();
+
+        if (elem.type() == Date && state.type() == Date) {
+            auto deltaOfDelta = state.deltaOfDeltaTo(elem);
+            records.appendUChar(kDateDelta);
+            appendVarint(&records, zigzagEncode(deltaOfDelta));
+            state.applyDateDelta(deltaOfDelta);
+            continue;
+        }
+
+        if (elem.type() == NumberDouble && state.type() == NumberDouble) {
+            auto bits = state.xorTo(elem);
+            int shift = bits ? countTrailingZeros64(bits) : 0;
+            if (64 - countLeadingZeros64(bits) - shift <= kMaxDoubleXorSignificantBits) {
+                records.appendUChar(kDoubleXor);
+                records.appendUChar(static_cast<unsigned char>(shift));
+                appendVarint(&records, bits >> shift);
+                state.applyDoubleXor(bits);
+                continue;
+            }
+        }
+
+        records.appendUChar(kLiteral);
+        literals.appendAs(elem, ""_sd);
+        state.applyLiteral(elem);
+    }
+    flushRepeats();
+    records.appendUChar(kEnd);
+
+    auto literalsObj = literals.done();
+    buf->appendBuf(literalsObj.objdata(), literalsObj.objsize());
+    buf->appendBuf(records.buf(), records.len());
+    return true;
+}
+
+}  // namespace
+
+boost::optional<BSONObj> compressBucket(const BSONObj& bucketDoc) {
+    auto control = bucketDoc[kControlFieldName];
+    if (control.type() != Object ||
+        control.Obj()[kVersionFieldName].numberInt() != kTimeseriesControlDefaultVersion ||
+        bucketDoc[kDataFieldName].type() != Object) {
+        return boost::none;
+    }
+
+    BSONObjBuilder builder;
+    for (auto&& elem : bucketDoc) {
+        auto fieldName = elem.fieldNameStringData();
+        if (fieldName == kControlFieldName) {
+            BSONObjBuilder controlBuilder(builder.subobjStart(kControlFieldName));
+            for (auto&& controlElem : elem.Obj()) {
+                if (controlElem.fieldNameStringData() == kVersionFieldName) {
+                    controlBuilder.append(kVersionFieldName, kTimeseriesControlCompressedVersion);
+                } else {
+                    controlBuilder.append(controlElem);
+                }
+            }
+        } else if (fieldName == kDataFieldName) {
+            BSONObjBuilder dataBuilder(builder.subobjStart(kDataFieldName));
+            BufBuilder buf;
+            for (auto&& column : elem.Obj()) {
+                buf.reset();
+                if (column.type() != Object || !compressColumn(column.Obj(), &buf)) {
+                    return boost::none;
+                }
+                dataBuilder.appendBinData(
+                    column.fieldNameStringData(), buf.len(), BinDataGeneral, buf.buf());
+            }
+        } else {
+            builder.append(elem);
+        }
+    }
+    return builder.obj();
+}
+
+BSONObj decompressColumn(const BSONElement& column) {
+    uassert(5502137,
+            str::stream() << "Invalid compressed time-series column: " << column,
+            column.type() == BinData && column.binDataType() == BinDataGeneral);
+
+    int len;
+    const char* data = column.binData(len);
+    uassertStatusOK(validateBSON(data, len));
+    BSONObj literals(data);
+    BSONObjIterator literalIt(literals);
+    RecordReader reader(data + literals.objsize(), data + len);
+
+    BSONObjBuilder builder;
+    ColumnState state;
+    DecimalCounter<uint32_t> row;
+    auto appendValue = [&] {
+        state.appendTo(&builder, row);
+        ++row;
+    };
+
+    for (auto op = reader.readByte(); op != kEnd; op = reader.readByte()) {
+        switch (op) {
+            case kSkip: {
+                auto count = reader.readVarint();
+                uassert(5502138,
+                        "Too many rows in compressed time-series column",
+                        count <= std::numeric_limits<uint32_t>::max() - row);
+                row = DecimalCounter<uint32_t>(static_cast<uint32_t>(row + count));
+                break;
+            }
+            case kRepeat: {
+                uassert(5502139, "Repeat without a value in time-series column", !state.empty());
+                for (auto count = reader.readVarint(); count > 0; --count) {
+                    state.repeat();
+                    appendValue();
+                }
+                break;
+            }
+            case kLiteral:
+                uassert(5502140, "Missing literal in time-series column", literalIt.more());
+                state.applyLiteral(literalIt.next());
+                appendValue();
+                break;
+            case kDateDelta:
+                uassert(5502141,
+                        "Date delta without a Date in time-series column",
+                        state.type() == Date);
+                state.applyDateDelta(zigzagDecode(reader.readVarint()));
+                appendValue();
+                break;
+            case kDoubleXor: {
+                uassert(5502142,
+                        "Double XOR without a double in time-series column",
+                        state.type() == NumberDouble);
+                auto shift = reader.readByte();
+                uassert(5502143, "Invalid double XOR in time-series column", shift < 64);
+                state.applyDoubleXor(reader.readVarint() << shift);
+                appendValue();
+                break;
+            }
+            default:
+                uasserted(5502144,
+                          str::stream() << "Invalid record type in time-series column: "
+                                        << static_cast<int>(op));
+        }
+    }
+    return builder.obj();
+}
+
+}  // namespace timeseries
+}  // namespace mongo
@@ -0,0 +1,72 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+
+#include "mongo/bson/bsonobj.h"
+
+namespace mongo {
+namespace timeseries {
+
+// Values of control.version in time-series bucket documents. Version 1 buckets hold each column of
+// the data region as an object keyed by row index. Version 2 buckets hold each column as a
+// compressed BinData value, written by compressBucket() once the bucket has been closed.
+constexpr int kTimeseriesControlDefaultVersion = 1;
+constexpr int kTimeseriesControlCompressedVersion = 2;
+
+/**
+ * Returns a copy of the version 1 bucket 'bucketDoc' in which every column of the data region has
+ * been replaced by its compressed form and control.version has been set to 2. Each column is
+ * encoded as a stream of records: timestamps as delta-of-deltas, doubles as the XOR with the
+ * previous value, and runs of values which the previous record reproduces as a single run length.
+ * All other values are stored verbatim, so decompression is lossless.
+ *
+ * Returns boost::none if the bucket is not a version 1 bucket or a column is not keyed by
+ * increasing row indexes, in which case the bucket should be left as it is.
+ */
+boost::optional<BSONObj> compressBucket(const BSONObj& bucketDoc);
+
+/**
+ * Returns true if 'column', an element of a bucket's data region, is a compressed column.
+ */
+inline bool isCompressedColumn(const BSONElement& column) {
+    return column.type() == BinData;
+}
+
+/**
+ * Returns the uncompressed form of the compressed column 'column', an object mapping each row index
+ * which has a value to that value, exactly as it would appear in a version 1 bucket. Throws if the
+ * column is malformed.
+ */
+BSONObj decompressColumn(const BSONElement& column);
+
+}  // namespace timeseries
+}  // namespace mongo
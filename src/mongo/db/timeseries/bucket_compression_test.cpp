@@ -0,0 +1,166 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <limits>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/json.h"
+#include "mongo/db/timeseries/bucket_compression.h"
+#include "mongo/unittest/bson_test_util.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/decimal_counter.h"
+
+namespace mongo {
+namespace {
+
+BSONObj makeBucket(const BSONObj& data) {
+    return BSON("_id" << OID::gen() << "control"
+                      << BSON("version" << timeseries::kTimeseriesControlDefaultVersion << "min"
+                                        << BSONObj() << "max" << BSONObj())
+                      << "meta"
+                      << "m"
+                      << "data" << data);
+}
+
+/**
+ * Compresses 'data' as the data region of a bucket, and checks that every column decompresses to
+ * exactly the original column. Returns the compressed bucket.
+ */
+BSONObj assertRoundTrips(const BSONObj& data) {
+    auto bucket = makeBucket(data);
+    auto compressed = timeseries::compressBucket(bucket);
+    ASSERT(compressed);
+    ASSERT_EQ(timeseries::kTimeseriesControlCompressedVersion,
+              compressed->getObjectField("control")["version"].numberInt());
+    ASSERT_BSONOBJ_BINARY_EQ(bucket["_id"].wrap(), (*compressed)["_id"].wrap());
+    ASSERT_BSONOBJ_BINARY_EQ(bucket["meta"].wrap(), (*compressed)["meta"].wrap());
+
+    auto compressedData = compressed->getObjectField("data");
+    ASSERT_EQ(data.nFields(), compressedData.nFields());
+    for (auto&& column : compressedData) {
+        ASSERT(timeseries::isCompressedColumn(column));
+        ASSERT_BSONOBJ_BINARY_EQ(data.getObjectField(column.fieldNameStringData()),
+                                 timeseries::decompressColumn(column));
+    }
+    return *compressed;
+}
+
+TEST(BucketCompressionTest, RoundTripsMixedColumns) {
+    assertRoundTrips(fromjson(
+        "{time: {'0': {$date: 1000}, '1': {$date: 2000}, '2': {$date: 3000}, '3': {$date: 3500}},"
+        " a: {'0': 1.5, '1': 1.5, '2': 2.25, '3': -1},"
+        " b: {'0': 'x', '1': 'x', '2': {y: 1}, '3': null},"
+        " c: {'1': 7, '3': 7},"
+        " d: {'2': [1, 2, 3]},"
+        " e: {}}"));
+}
+
+TEST(BucketCompressionTest, RoundTripsTimestampsOutOfOrder) {
+    assertRoundTrips(
+        fromjson("{time: {'0': {$date: 5000}, '1': {$date: 1000}, '2': {$date: -3000}, '3': "
+                 "{$date: 9000}, '4': {$date: 9000}}}"));
+
+    BSONObjBuilder time;
+    time.appendDate("0", Date_t::min());
+    time.appendDate("1", Date_t::max());
+    time.appendDate("2", Date_t::min());
+    assertRoundTrips(BSON("time" << time.obj()));
+}
+
+TEST(BucketCompressionTest, RoundTripsDoublesBitwise) {
+    BSONObjBuilder a;
+    a.append("0", 0.0);
+    a.append("1", -0.0);
+    a.append("2", std::numeric_limits<double>::quiet_NaN());
+    a.append("3", -std::numeric_limits<double>::infinity());
+    a.append("4", std::numeric_limits<double>::denorm_min());
+    a.append("5", 1e300);
+    a.append("6", 1);
+    a.append("7", 1.0);
+    assertRoundTrips(BSON("a" << a.obj()));
+}
+
+TEST(BucketCompressionTest, CompressesRegularMeasurements) {
+    BSONObjBuilder time;
+    BSONObjBuilder value;
+    BSONObjBuilder status;
+    DecimalCounter<uint32_t> count;
+    for (int i = 0; i < 1000; ++i, ++count) {
+        time.appendDate(count, Date_t::fromMillisSinceEpoch(1600000000000LL + i * 1000));
+        value.append(count, 20.0 + (i % 8) * 0.25);
+        status.append(count, "ok");
+    }
+    auto data = BSON("time" << time.obj() << "value" << value.obj() << "status" << status.obj());
+    auto compressed = assertRoundTrips(data);
+
+    // Evenly spaced times and constant values compress to a handful of bytes regardless of the
+    // number of measurements.
+    auto compressedData = compressed.getObjectField("data");
+    ASSERT_LT(compressedData["time"].valuesize(), 40);
+    ASSERT_LT(compressedData["status"].valuesize(), 40);
+    ASSERT_LT(compressedData["value"].valuesize(), data["value"].valuesize() / 3);
+}
+
+TEST(BucketCompressionTest, DoesNotCompressUnexpectedBuckets) {
+    auto data = fromjson("{time: {'0': {$date: 1000}}}");
+    auto compressed = timeseries::compressBucket(makeBucket(data));
+    ASSERT(compressed);
+    ASSERT_FALSE(timeseries::compressBucket(*compressed));
+
+    ASSERT_FALSE(timeseries::compressBucket(BSON("data" << data)));
+    ASSERT_FALSE(timeseries::compressBucket(makeBucket(fromjson("{time: {'0': 1, '00': 2}}"))));
+    ASSERT_FALSE(timeseries::compressBucket(makeBucket(fromjson("{time: {'1': 1, '0': 2}}"))));
+    ASSERT_FALSE(timeseries::compressBucket(makeBucket(fromjson("{time: {a: 1}}"))));
+    ASSERT_FALSE(timeseries::compressBucket(makeBucket(fromjson("{time: 1}"))));
+}
+
+TEST(BucketCompressionTest, RejectsMalformedColumns) {
+    auto decompress = [](StringData bytes) {
+        BSONObjBuilder builder;
+        builder.appendBinData("a", bytes.size(), BinDataGeneral, bytes.rawData());
+        return timeseries::decompressColumn(builder.obj().firstElement());
+    };
+
+    // An empty literal object followed by the end of the column.
+    ASSERT_BSONOBJ_EQ(BSONObj(), decompress(StringData("\x05\0\0\0\0\0", 6)));
+
+    ASSERT_THROWS_CODE(decompress(StringData("\x05\0\0\0\0", 5)), DBException, 5502135);
+    ASSERT_THROWS_CODE(decompress(StringData("\x05\0\0\0\0\x02\x01\0", 8)), DBException, 5502139);
+    ASSERT_THROWS_CODE(decompress(StringData("\x05\0\0\0\0\x03\0", 7)), DBException, 5502140);
+    ASSERT_THROWS_CODE(decompress(StringData("\x05\0\0\0\0\x09\0", 7)), DBException, 5502144);
+    ASSERT_THROWS(decompress(StringData("\x09\0\0\0\0\0", 6)), DBException);
+    ASSERT_THROWS_CODE(timeseries::decompressColumn(BSON("a" << 1).firstElement()),
+                       DBException,
+                       5502137);
+}
+
+}  // namespace
+}  // namespace mongo
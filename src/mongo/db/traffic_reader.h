@@ -27,12 +27,29 @@
  *    it in the license file.
  */
 
+#include <boost/optional.hpp>
+
 #include "mongo/rpc/op_msg.h"
+#include "mongo/util/time_support.h"
 
 #pragma once
 
 namespace mongo {
 
+// A single message of a traffic recording, as written by the TrafficRecorder
+struct TrafficReaderPacket {
+    uint64_t id;
+    StringData local;
+    StringData remote;
+    Date_t date;
+    uint64_t order;
+    MsgData::ConstView message;
+};
+
+// Reads the next packet of a traffic recording into buf, which must hold MaxMessageSizeBytes.
+// Returns boost::none at the end of the recording. The packet points into buf.
+boost::optional<TrafficReaderPacket> readTrafficRecordingPacket(char* buf, int fd);
+
 // Method for testing, takes the recorded traffic and returns a BSONArray
 BSONArray trafficRecordingFileToBSONArr(const std::string& inputFile);
 
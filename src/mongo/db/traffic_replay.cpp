@@ -0,0 +1,378 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/traffic_replay.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/client/dbclient_base.h"
+#include "mongo/client/mongo_uri.h"
+#include "mongo/db/traffic_reader.h"
+#include "mongo/rpc/get_status_from_command_result.h"
+#include "mongo/rpc/message.h"
+#include "mongo/rpc/op_msg.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/producer_consumer_queue.h"
+#include "mongo/util/string_map.h"
+#include "mongo/util/time_support.h"
+#include "mongo/util/timer.h"
+
+namespace mongo {
+
+namespace {
+
+constexpr auto kApplicationName = "mongotrafficreplay"_sd;
+
+// Commands which depend on the state of the recorded connection, and so are not replayed
+const StringDataSet kSkippedCommands = {"authenticate",
+                                        "getnonce",
+                                        "logout",
+                                        "saslContinue",
+                                        "saslStart",
+                                        "startRecordingTraffic",
+                                        "stopRecordingTraffic"};
+
+// Fields of the handshake which may only be sent once on a connection, or belong to the
+// authentication of the recorded connection
+const StringDataSet kHandshakeFields = {"client", "saslSupportedMechs", "speculativeAuthenticate"};
+
+/**
+ * A recorded request to replay, or the recorded reply to the last request of a session.
+ */
+struct ReplayItem {
+    bool isReply = false;
+
+    // For OP_MSG requests, the command to replay
+    boost::optional<OpMsgRequest> request;
+    bool moreToCome = false;
+
+    // For legacy requests, the message to replay as recorded
+    Message legacyMessage;
+
+    // For replies, the id of the cursor the recorded request returned
+    long long cursorId = 0;
+};
+
+struct CommandStats {
+    std::vector<long long> latencies;
+    long long errors = 0;
+};
+
+using CommandStatsMap = std::map<std::string, CommandStats>;
+
+Message copyMessage(const MsgData::ConstView& recorded) {
+    auto data = SharedBuffer::allocate(recorded.getLen());
+    std::memcpy(data.get(), recorded.view2ptr(), recorded.getLen());
+    return Message(std::move(data));
+}
+
+long long getCursorId(const BSONObj& reply) {
+    auto cursor = reply["cursor"];
+    if (cursor.type() != Object) {
+        return 0;
+    }
+    auto id = cursor.Obj()["id"];
+    return id.isNumber() ? id.numberLong() : 0;
+}
+
+/**
+ * Builds the item replaying a recorded request, or returns boost::none if it is not replayed.
+ */
+boost::optional<ReplayItem> makeRequestItem(Message message) {
+    ReplayItem item;
+    if (message.operation() != dbMsg) {
+        item.legacyMessage = std::move(message);
+        return item;
+    }
+
+    // Some header fields like requestId are missing, so the checksum won't match.
+    OpMsg::removeChecksum(&message);
+    item.moreToCome = OpMsg::isFlagSet(message, OpMsg::kMoreToCome);
+    item.request = OpMsgRequest::parseOwned(message);
+    if (kSkippedCommands.contains(item.request->getCommandName())) {
+        return boost::none;
+    }
+
+    // The cluster time is signed by the keys of the recorded cluster.
+    item.request->body = item.request->body.removeField("$clusterTime");
+    if (item.request->getCommandName() == "hello" ||
+        item.request->getCommandName() == "isMaster" ||
+        item.request->getCommandName() == "ismaster") {
+        item.request->body = item.request->body.removeFields(kHandshakeFields);
+    }
+    return item;
+}
+
+/**
+ * Replays the requests of one recorded session on its own connection and thread.
+ */
+class ReplaySession {
+public:
+    explicit ReplaySession(const MongoURI& uri) : _uri(uri) {
+        _thread = stdx::thread([this] { _run(); });
+    }
+
+    void push(ReplayItem item) {
+        _pipe.producer.push(std::move(item));
+    }
+
+    /**
+     * Waits for the session to replay everything pushed to it, and returns its statistics.
+     */
+    const CommandStatsMap& join() {
+        _pipe.producer.close();
+        _thread.join();
+        return _stats;
+    }
+
+private:
+    void _run() {
+        try {
+            while (true) {
+                _replay(_pipe.consumer.pop());
+            }
+        } catch (const ExceptionFor<ErrorCodes::ProducerConsumerQueueConsumed>&) {
+            // Close naturally
+        }
+    }
+
+    void _replay(ReplayItem item) {
+        if (item.isReply) {
+            if (item.cursorId && _lastCursorId) {
+                _cursorIds[item.cursorId] = *_lastCursorId;
+            }
+            _lastCursorId = boost::none;
+            return;
+        }
+
+        Message message;
+        bool expectsReply;
+        std::string commandName;
+        if (item.request) {
+            commandName = item.request->getCommandName().toString();
+            item.request->body = _mapCursorIds(commandName, item.request->body);
+            message = item.request->serialize();
+            expectsReply = !item.moreToCome;
+            if (item.moreToCome) {
+                OpMsg::setFlag(&message, OpMsg::kMoreToCome);
+            }
+        } else {
+            commandName = "legacy";
+            message = std::move(item.legacyMessage);
+            expectsReply = message.operation() == dbQuery || message.operation() == dbGetMore;
+        }
+
+        auto& stats = _stats[commandName];
+        _lastCursorId = boost::none;
+        try {
+            auto conn = _connection();
+            Timer timer;
+            if (!expectsReply) {
+                conn->say(message);
+            } else {
+                Message response;
+                conn->call(message, response);
+                if (item.request) {
+                    auto reply = OpMsg::parse(response).body;
+                    if (!getStatusFromCommandResult(reply).isOK()) {
+                        stats.errors++;
+                    }
+                    _lastCursorId = getCursorId(reply);
+                }
+            }
+            stats.latencies.push_back(timer.micros());
+        } catch (const DBException&) {
+            // Reconnect for the next request of the session.
+            stats.errors++;
+            _conn.reset();
+        }
+    }
+
+    DBClientBase* _connection() {
+        if (!_conn) {
+            std::string errmsg;
+            _conn.reset(_uri.connect(kApplicationName, errmsg));
+            uassert(ErrorCodes::HostUnreachable,
+                    str::stream() << "failed to connect: " << errmsg,
+                    _conn);
+        }
+        return _conn.get();
+    }
+
+    long long _mapCursorId(long long recordedId) const {
+        auto it = _cursorIds.find(recordedId);
+        return it == _cursorIds.end() ? recordedId : it->second;
+    }
+
+    BSONObj _mapCursorIds(StringData commandName, const BSONObj& body) const {
+        if (commandName != "getMore" && commandName != "killCursors") {
+            return body;
+        }
+
+        BSONObjBuilder bob;
+        for (auto&& elem : body) {
+            if (commandName == "getMore" && elem.fieldNameStringData() == "getMore" &&
+                elem.isNumber()) {
+                bob.append("getMore", _mapCursorId(elem.numberLong()));
+            } else if (commandName == "killCursors" && elem.fieldNameStringData() == "cursors" &&
+                       elem.type() == Array) {
+                BSONArrayBuilder cursors(bob.subarrayStart("cursors"));
+                for (auto&& id : elem.Obj()) {
+                    cursors.append(_mapCursorId(id.numberLong()));
+                }
+            } else {
+                bob.append(elem);
+            }
+        }
+        return bob.obj();
+    }
+
+    const MongoURI& _uri;
+
+    SingleProducerSingleConsumerQueue<ReplayItem>::Pipe _pipe;
+    stdx::thread _thread;
+
+    // Only used by the session thread
+    std::unique_ptr<DBClientBase> _conn;
+    boost::optional<long long> _lastCursorId;
+    stdx::unordered_map<long long, long long> _cursorIds;
+    CommandStatsMap _stats;
+};
+
+BSONObj latencyPercentiles(std::vector<long long>* latencies) {
+    BSONObjBuilder bob;
+    if (latencies->empty()) {
+        return bob.obj();
+    }
+
+    std::sort(latencies->begin(), latencies->end());
+    auto percentile = [&](double p) {
+        return (*latencies)[std::min(latencies->size() - 1, size_t(p * latencies->size()))];
+    };
+    bob.append("p50", percentile(0.5));
+    bob.append("p95", percentile(0.95));
+    bob.append("p99", percentile(0.99));
+    bob.append("max", latencies->back());
+    return bob.obj();
+}
+
+}  // namespace
+
+BSONObj replayTrafficRecording(int inputFd, const TrafficReplayOptions& options) {
+    uassert(ErrorCodes::BadValue, "speed must not be negative", options.speed >= 0);
+    auto uri = uassertStatusOK(MongoURI::parse(options.uri));
+
+    stdx::unordered_map<uint64_t, std::unique_ptr<ReplaySession>> sessions;
+    long long requests = 0;
+    long long skipped = 0;
+    boost::optional<Date_t> recordingStart;
+    Date_t replayStart;
+
+    auto buf = SharedBuffer::allocate(MaxMessageSizeBytes);
+    while (auto packet = readTrafficRecordingPacket(buf.get(), inputFd)) {
+        if (packet->message.getResponseToMsgId()) {
+            // Replies only map the cursors of sessions which replayed the request.
+            auto it = sessions.find(packet->id);
+            if (it != sessions.end()) {
+                ReplayItem item;
+                item.isReply = true;
+                if (packet->message.getNetworkOp() == dbMsg) {
+                    auto reply = copyMessage(packet->message);
+                    OpMsg::removeChecksum(&reply);
+                    item.cursorId = getCursorId(OpMsg::parse(reply).body);
+                }
+                it->second->push(std::move(item));
+            }
+            continue;
+        }
+
+        auto item = makeRequestItem(copyMessage(packet->message));
+        if (!item) {
+            skipped++;
+            continue;
+        }
+        requests++;
+
+        if (!recordingStart) {
+            recordingStart = packet->date;
+            replayStart = Date_t::now();
+        }
+        if (options.speed > 0) {
+            auto offset = durationCount<Milliseconds>(packet->date - *recordingStart);
+            auto due = replayStart + Milliseconds(static_cast<long long>(offset / options.speed));
+            auto now = Date_t::now();
+            if (due > now) {
+                sleepFor(due - now);
+            }
+        }
+
+        auto& session = sessions[packet->id];
+        if (!session) {
+            session = std::make_unique<ReplaySession>(uri);
+        }
+        session->push(std::move(*item));
+    }
+
+    CommandStatsMap stats;
+    for (auto&& session : sessions) {
+        for (auto&& [commandName, sessionStats] : session.second->join()) {
+            auto& commandStats = stats[commandName];
+            commandStats.latencies.insert(commandStats.latencies.end(),
+                                          sessionStats.latencies.begin(),
+                                          sessionStats.latencies.end());
+            commandStats.errors += sessionStats.errors;
+        }
+    }
+
+    BSONObjBuilder bob;
+    bob.append("sessions", static_cast<long long>(sessions.size()));
+    bob.append("requests", requests);
+    bob.append("skipped", skipped);
+    {
+        BSONObjBuilder commands(bob.subobjStart("commands"));
+        for (auto&& [commandName, commandStats] : stats) {
+            BSONObjBuilder command(commands.subobjStart(commandName));
+            command.append("count", static_cast<long long>(commandStats.latencies.size()));
+            command.append("errors", commandStats.errors);
+            command.append("latencyMicros", latencyPercentiles(&commandStats.latencies));
+        }
+    }
+    return bob.obj();
+}
+
+}  // namespace mongo
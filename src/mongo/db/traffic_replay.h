@@ -0,0 +1,61 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+
+#include "mongo/bson/bsonobj.h"
+
+namespace mongo {
+
+struct TrafficReplayOptions {
+    // Connection string of the server to replay the recording against
+    std::string uri = "mongodb://localhost:27017";
+
+    // Recorded inter-arrival times are divided by this factor. Zero replays as fast as possible.
+    double speed = 1.0;
+};
+
+/**
+ * Replays the traffic recording read from inputFd against the server in options.uri.
+ *
+ * Every recorded session is replayed on its own connection and thread. Requests are sent at their
+ * recorded offset from the start of the recording, divided by options.speed, and each session
+ * waits for the reply to a request before sending its next one. Authentication commands are
+ * skipped, since the connection authenticates with the credentials of options.uri, and the cursor
+ * ids of getMore and killCursors are mapped to the cursors of the replayed commands.
+ *
+ * Returns the latency distribution of every replayed command:
+ *     {sessions: N, requests: N, skipped: N,
+ *      commands: {<name>: {count: N, errors: N, latencyMicros: {p50, p95, p99, max}}}}
+ */
+BSONObj replayTrafficRecording(int inputFd, const TrafficReplayOptions& options);
+
+}  // namespace mongo
@@ -0,0 +1,157 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#ifdef _WIN32
+#include <io.h>
+#endif
+
+#include "mongo/base/initializer.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/traffic_replay.h"
+#include "mongo/transport/transport_layer_manager.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/signal_handlers.h"
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+using namespace mongo;
+
+int main(int argc, char* argv[]) {
+
+    setupSignalHandlers();
+
+    Status status = mongo::runGlobalInitializers(std::vector<std::string>(argv, argv + argc));
+    if (!status.isOK()) {
+        std::cerr << "Failed global initialization: " << status << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    setGlobalServiceContext(ServiceContext::make());
+    getGlobalServiceContext()->setTransportLayer(
+        transport::TransportLayerManager::makeAndStartDefaultEgressTransportLayer());
+
+    startSignalProcessingThread();
+
+    // Handle program options
+    boost::program_options::variables_map vm;
+
+    // input file of the recording (defaults to stdin), and output file of the latency report
+    int inputFd = 0;
+    std::ofstream outputStream;
+    TrafficReplayOptions options;
+
+    try {
+        // Define the program options
+        auto inputStr = "Path to the traffic recording to replay (defaults to stdin)";
+        auto outputStr = "Path to file that mongotrafficreplay will place its latency report "
+                         "(defaults to stdout)";
+        auto uriStr = "Connection string of the server to replay the recording against";
+        auto speedStr =
+            "Factor by which to speed up the recorded timing, or 0 to replay as fast as possible";
+        boost::program_options::options_description desc{"Options"};
+        desc.add_options()("help,h", "help")(
+            "input,i", boost::program_options::value<std::string>(), inputStr)(
+            "output,o", boost::program_options::value<std::string>(), outputStr)(
+            "uri",
+            boost::program_options::value<std::string>()->default_value(options.uri),
+            uriStr)("speed",
+                    boost::program_options::value<double>()->default_value(options.speed),
+                    speedStr);
+
+        // Parse the program options
+        store(parse_command_line(argc, argv, desc), vm);
+        notify(vm);
+
+        // Handle the help option
+        if (vm.count("help")) {
+            std::cout << "Mongo Traffic Replay Help: \n\n\t./mongotrafficreplay "
+                         "-i trafficinput.txt --uri mongodb://localhost:27017 --speed 2 \n\n"
+                      << desc << std::endl;
+            return EXIT_SUCCESS;
+        }
+
+        options.uri = vm["uri"].as<std::string>();
+        options.speed = vm["speed"].as<double>();
+
+        // User can specify a --input param and it must point to a valid file
+        if (vm.count("input")) {
+            auto inputFile = vm["input"].as<std::string>();
+            if (!boost::filesystem::exists(inputFile.c_str())) {
+                std::cout << "Error: Specified file does not exist (" << inputFile.c_str() << ")"
+                          << std::endl;
+                return EXIT_FAILURE;
+            }
+
+// Open the connection to the input file
+#ifdef _WIN32
+            inputFd = open(inputFile.c_str(), O_RDONLY | O_BINARY);
+#else
+            inputFd = open(inputFile.c_str(), O_RDONLY);
+#endif
+        }
+
+        // User can specify a --output param and it does not need to point to a valid file
+        if (vm.count("output")) {
+            auto outputFile = vm["output"].as<std::string>();
+
+            // Open the connection to the output file
+            outputStream.open(outputFile, std::ios::out | std::ios::trunc);
+            if (!outputStream.is_open()) {
+                std::cerr << "Error writing to file: " << outputFile << std::endl;
+                return EXIT_FAILURE;
+            }
+        } else {
+            // output to std::cout
+            outputStream.copyfmt(std::cout);
+            outputStream.clear(std::cout.rdstate());
+            outputStream.basic_ios<char>::rdbuf(std::cout.rdbuf());
+        }
+    } catch (const boost::program_options::error& ex) {
+        std::cerr << ex.what() << '\n';
+        return EXIT_FAILURE;
+    }
+
+    try {
+        auto report = mongo::replayTrafficRecording(inputFd, options);
+        outputStream << report.jsonString(ExtendedRelaxedV2_0_0) << std::endl;
+    } catch (const DBException& ex) {
+        std::cerr << "Error replaying traffic: " << ex.toStatus() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return 0;
+}
@@ -33,6 +33,8 @@
 
 #include "mongo/db/ttl.h"
 
+#include <map>
+
 #include "mongo/base/counter.h"
 #include "mongo/db/auth/authorization_session.h"
 #include "mongo/db/auth/user_name.h"
@@ -49,6 +51,7 @@
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/ops/insert.h"
 #include "mongo/db/query/internal_plans.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/stats/resource_consumption_metrics.h"
@@ -74,10 +77,55 @@ MONGO_FAIL_POINT_DEFINE(hangTTLMonitorWithLock);
 Counter64 ttlPasses;
 Counter64 ttlDeletedDocuments;
 
+Counter64 ttlSubPasses;
+
 ServerStatusMetricField<Counter64> ttlPassesDisplay("ttl.passes", &ttlPasses);
+ServerStatusMetricField<Counter64> ttlSubPassesDisplay("ttl.subPasses", &ttlSubPasses);
 ServerStatusMetricField<Counter64> ttlDeletedDocumentsDisplay("ttl.deletedDocuments",
                                                               &ttlDeletedDocuments);
 
+namespace {
+
+/**
+ * Reports, for every namespace which still had expired documents left after the latest TTL
+ * sub-pass, the number of consecutive sub-passes that ended with documents left. An empty document
+ * means that the TTL monitor is keeping up.
+ */
+class TTLBacklogMetric final : public ServerStatusMetric {
+public:
+    TTLBacklogMetric() : ServerStatusMetric("ttl.backlog") {}
+
+    void appendAtLeaf(BSONObjBuilder& b) const final {
+        stdx::lock_guard<Latch> lk(_mutex);
+        BSONObjBuilder backlogBob(b.subobjStart(_leafName));
+        for (const auto& [ns, subPasses] : _subPassesBehind) {
+            backlogBob.append(ns, subPasses);
+        }
+        backlogBob.done();
+    }
+
+    /**
+     * Records the namespaces with expired documents left at the end of a sub-pass. Namespaces
+     * which are not in 'behind' have caught up.
+     */
+    void update(const std::vector<std::pair<NamespaceString, BSONObj>>& behind) {
+        std::map<std::string, long long> subPassesBehind;
+        stdx::lock_guard<Latch> lk(_mutex);
+        for (const auto& it : behind) {
+            const auto& ns = it.first.ns();
+            auto previous = _subPassesBehind.find(ns);
+            subPassesBehind[ns] = previous == _subPassesBehind.end() ? 1 : previous->second + 1;
+        }
+        _subPassesBehind = std::move(subPassesBehind);
+    }
+
+private:
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("TTLBacklogMetric::_mutex");
+    std::map<std::string, long long> _subPassesBehind;
+} ttlBacklog;
+
+}  // namespace
+
 class TTLMonitor : public BackgroundJob {
 public:
     explicit TTLMonitor() : BackgroundJob(false /* selfDelete */) {}
@@ -240,35 +288,76 @@ private:
             ttlIndexes.push_back(std::make_pair(*nss, spec.getOwned()));
         }
 
-        for (const auto& it : ttlIndexes) {
-            try {
-                doTTLForIndex(&opCtx, it.first, it.second);
-            } catch (const ExceptionForCat<ErrorCategory::Interruption>&) {
-                LOGV2_WARNING(22537,
-                              "TTLMonitor was interrupted, waiting {ttlMonitorSleepSecs_load} "
-                              "seconds before doing another pass",
-                              "TTLMonitor was interrupted, waiting before doing another pass",
-                              "wait"_attr = Milliseconds(Seconds(ttlMonitorSleepSecs.load())));
-                return;
-            } catch (const DBException& dbex) {
-                LOGV2_ERROR(22538,
-                            "Error processing ttl index: {it_second} -- {dbex}",
-                            "Error processing TTL index",
-                            "index"_attr = it.second,
-                            "error"_attr = dbex);
-                // Continue on to the next index.
-                continue;
+        // Each sub-pass deletes up to 'ttlMonitorSubPassTargetDocs' documents through every TTL
+        // index which had expired documents left after the previous sub-pass.
+        while (!ttlIndexes.empty() && ttlMonitorEnabled.load() && !lockedForWriting()) {
+            ttlSubPasses.increment();
+            std::vector<std::pair<NamespaceString, BSONObj>> ttlIndexesBehind;
+            for (const auto& it : ttlIndexes) {
+                const auto subPassTargetDocs = ttlMonitorSubPassTargetDocs.load();
+                const auto start = Date_t::now();
+                long long numDeleted;
+                try {
+                    numDeleted = doTTLForIndex(&opCtx, it.first, it.second, subPassTargetDocs);
+                } catch (const ExceptionForCat<ErrorCategory::Interruption>&) {
+                    LOGV2_WARNING(22537,
+                                  "TTLMonitor was interrupted, waiting {ttlMonitorSleepSecs_load} "
+                                  "seconds before doing another pass",
+                                  "TTLMonitor was interrupted, waiting before doing another pass",
+                                  "wait"_attr = Milliseconds(Seconds(ttlMonitorSleepSecs.load())));
+                    return;
+                } catch (const DBException& dbex) {
+                    LOGV2_ERROR(22538,
+                                "Error processing ttl index: {it_second} -- {dbex}",
+                                "Error processing TTL index",
+                                "index"_attr = it.second,
+                                "error"_attr = dbex);
+                    // Continue on to the next index.
+                    continue;
+                }
+
+                if (subPassTargetDocs > 0 && numDeleted >= subPassTargetDocs) {
+                    ttlIndexesBehind.push_back(it);
+                }
+
+                // Wait long enough for the deletes to average out to the maximum rate.
+                const auto maxDeletesPerSecond = ttlMonitorMaxDeletesPerSecond.load();
+                if (maxDeletesPerSecond > 0 && numDeleted > 0) {
+                    const auto deadline =
+                        start + Milliseconds(numDeleted * 1000 / maxDeletesPerSecond);
+                    if (_waitUntilUnlessShuttingDown(deadline)) {
+                        return;
+                    }
+                }
             }
+
+            ttlBacklog.update(ttlIndexesBehind);
+            ttlIndexes = std::move(ttlIndexesBehind);
         }
     }
 
+    /**
+     * Waits until 'deadline' passes or a shutdown is requested. Returns true if a shutdown was
+     * requested.
+     */
+    bool _waitUntilUnlessShuttingDown(Date_t deadline) {
+        stdx::unique_lock<Latch> lk(_stateMutex);
+        MONGO_IDLE_THREAD_BLOCK;
+        _shuttingDownCV.wait_until(lk, deadline.toSystemTimePoint(), [&] { return _shuttingDown; });
+        return _shuttingDown;
+    }
+
     /**
      * Removes documents from the collection using the specified TTL index after a sufficient amount
-     * of time has passed according to its expiry specification.
+     * of time has passed according to its expiry specification. Deletes at most 'targetDocs'
+     * documents unless it is 0, and returns the number of documents deleted.
      */
-    void doTTLForIndex(OperationContext* opCtx, NamespaceString collectionNSS, BSONObj idx) {
+    long long doTTLForIndex(OperationContext* opCtx,
+                            NamespaceString collectionNSS,
+                            BSONObj idx,
+                            int targetDocs) {
         if (collectionNSS.isDropPendingNamespace()) {
-            return;
+            return 0;
         }
         if (!userAllowedWriteNS(collectionNSS).isOK()) {
             LOGV2_ERROR(
@@ -277,7 +366,7 @@ private:
                 "Namespace doesn't allow deletes, skipping TTL job",
                 logAttrs(collectionNSS),
                 "index"_attr = idx);
-            return;
+            return 0;
         }
 
         const BSONObj key = idx["key"].Obj();
@@ -287,7 +376,7 @@ private:
                         "key for ttl index can only have 1 field, skipping ttl job for: {index}",
                         "Key for ttl index can only have 1 field, skipping TTL job",
                         "index"_attr = idx);
-            return;
+            return 0;
         }
 
         LOGV2_DEBUG(22533,
@@ -305,11 +394,11 @@ private:
 
         if (!collection) {
             // Collection was dropped.
-            return;
+            return 0;
         }
 
         if (!repl::ReplicationCoordinator::get(opCtx)->canAcceptWritesFor(opCtx, collectionNSS)) {
-            return;
+            return 0;
         }
 
         ResourceConsumption::ScopedMetricsCollector scopedMetrics(opCtx,
@@ -322,7 +411,7 @@ private:
                         "index not found (index build in progress? index dropped?), skipping ttl "
                         "job for: {idx}",
                         "idx"_attr = idx);
-            return;
+            return 0;
         }
 
         // Re-read 'idx' from the descriptor, in case the collection or index definition changed
@@ -334,7 +423,7 @@ private:
                         "special index can't be used as a ttl index, skipping ttl job for: {index}",
                         "Special index can't be used as a TTL index, skipping TTL job",
                         "index"_attr = idx);
-            return;
+            return 0;
         }
 
         BSONElement secondsExpireElt = idx[IndexDescriptor::kExpireAfterSecondsFieldName];
@@ -346,7 +435,7 @@ private:
                         "field"_attr = IndexDescriptor::kExpireAfterSecondsFieldName,
                         "type"_attr = typeName(secondsExpireElt.type()),
                         "index"_attr = idx);
-            return;
+            return 0;
         }
 
         const Date_t kDawnOfTime =
@@ -374,6 +463,8 @@ private:
         auto params = std::make_unique<DeleteStageParams>();
         params->isMulti = true;
         params->canonicalQuery = canonicalQuery.getValue().get();
+        params->batchDocs = internalBatchedDeletesTargetBatchDocs.load();
+        params->limit = targetDocs;
 
         auto exec =
             InternalPlanner::deleteWithIndexScan(opCtx,
@@ -390,17 +481,18 @@ private:
             const auto numDeleted = exec->executeDelete();
             ttlDeletedDocuments.increment(numDeleted);
             LOGV2_DEBUG(22536, 1, "deleted: {numDeleted}", "numDeleted"_attr = numDeleted);
+            return numDeleted;
         } catch (const ExceptionFor<ErrorCodes::QueryPlanKilled>&) {
             // It is expected that a collection drop can kill a query plan while the TTL monitor is
             // deleting an old document, so ignore this error.
-            return;
+            return 0;
         } catch (const DBException& exception) {
             LOGV2_WARNING(22543,
                           "ttl query execution for index {index} failed with status: {error}",
                           "TTL query execution failed",
                           "index"_attr = idx,
                           "error"_attr = redact(exception.toStatus()));
-            return;
+            return 0;
         }
     }
 
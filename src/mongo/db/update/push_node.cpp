@@ -31,6 +31,7 @@
 
 #include "mongo/db/update/push_node.h"
 
+#include <algorithm>
 #include <numeric>
 
 #include "mongo/base/simple_string_data_comparator.h"
@@ -284,6 +285,48 @@ ModifierNode::ModifyResult PushNode::insertElementsWithPosition(
     return result;
 }
 
+boost::optional<ModifierNode::ModifyResult> PushNode::insertElementsIntoSortedArray(
+    mutablebson::Element* array,
+    const PatternElementCmp& sort,
+    const std::vector<BSONElement>& valuesToPush) {
+    invariant(!valuesToPush.empty());
+
+    std::vector<mutablebson::Element> children;
+    for (auto child = array->leftChild(); child.ok(); child = child.rightSibling()) {
+        children.push_back(child);
+    }
+    if (!std::is_sorted(children.begin(), children.end(), sort)) {
+        return boost::none;
+    }
+
+    auto& document = array->getDocument();
+    std::vector<mutablebson::Element> elementsToInsert;
+    elementsToInsert.reserve(valuesToPush.size());
+    for (auto&& value : valuesToPush) {
+        elementsToInsert.push_back(document.makeElementWithNewFieldName(StringData(), value));
+    }
+    std::stable_sort(elementsToInsert.begin(), elementsToInsert.end(), sort);
+
+    // Each new element goes after any existing elements it compares equal to, and since the new
+    // elements are themselves sorted, the search for each one starts where the previous one went.
+    const bool wasEmpty = children.empty();
+    bool appendedOnly = true;
+    auto searchFrom = children.begin();
+    for (auto&& element : elementsToInsert) {
+        auto insertBefore = std::upper_bound(searchFrom, children.end(), element, sort);
+        if (insertBefore == children.end()) {
+            invariant(array->pushBack(element));
+        } else {
+            appendedOnly = false;
+            invariant(insertBefore->addSiblingLeft(element));
+        }
+        searchFrom = std::next(children.insert(insertBefore, element));
+    }
+
+    return appendedOnly && !wasEmpty ? ModifyResult::kArrayAppendUpdate
+                                     : ModifyResult::kNormalUpdate;
+}
+
 ModifierNode::ModifyResult PushNode::performPush(mutablebson::Element* element,
                                                  const FieldRef* elementPath) const {
     if (element->getType() != BSONType::Array) {
@@ -296,11 +339,21 @@ ModifierNode::ModifyResult PushNode::performPush(mutablebson::Element* element,
                                 << (idElem.ok() ? idElem.toString() : "no id") << "}");
     }
 
-    auto result = insertElementsWithPosition(element, _position, _valuesToPush);
+    boost::optional<ModifyResult> sortedInsertResult;
+    if (_sort && !_position && !_valuesToPush.empty()) {
+        sortedInsertResult = insertElementsIntoSortedArray(element, *_sort, _valuesToPush);
+    }
 
-    if (_sort) {
-        result = ModifyResult::kNormalUpdate;
-        sortChildren(*element, *_sort);
+    ModifyResult result;
+    if (sortedInsertResult) {
+        result = *sortedInsertResult;
+    } else {
+        result = insertElementsWithPosition(element, _position, _valuesToPush);
+
+        if (_sort) {
+            result = ModifyResult::kNormalUpdate;
+            sortChildren(*element, *_sort);
+        }
     }
 
     if (_slice) {
@@ -349,7 +402,11 @@ void PushNode::logUpdate(LogBuilderInterface* logBuilder,
         RuntimeUpdatePath pathTakenCopy = pathTaken;
         invariant(arraySize > numAppended);
         auto position = arraySize - numAppended;
-        for (const auto& valueToLog : _valuesToPush) {
+
+        // The appended values are logged from the array itself, since a $sort may have put them in
+        // a different order than '_valuesToPush'.
+        for (auto valueToLog = getNthChild(element, position); valueToLog.ok();
+             valueToLog = valueToLog.rightSibling()) {
             const std::string positionAsString = std::to_string(position);
 
             RuntimeUpdatePathTempAppend tempAppend(
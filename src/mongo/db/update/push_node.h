@@ -86,6 +86,17 @@ private:
                                                    boost::optional<long long> position,
                                                    const std::vector<BSONElement>& valuesToPush);
 
+    /**
+     * A helper for performPush(). If the children of 'array' are already ordered by 'sort', inserts
+     * each of the non-empty 'valuesToPush' at a position which keeps them ordered, and returns the
+     * kind of update performed. Returns boost::none without modifying 'array' if its children are
+     * not ordered by 'sort'.
+     */
+    static boost::optional<ModifyResult> insertElementsIntoSortedArray(
+        mutablebson::Element* array,
+        const PatternElementCmp& sort,
+        const std::vector<BSONElement>& valuesToPush);
+
     /**
      * Inserts the elements from '_valuesToPush' in the 'element' array using '_position' to
      * determine where to insert. This function also applies any '_slice' and or '_sort' that is
@@ -95,10 +106,15 @@ private:
      * Returns:
      *   - ModifyResult::kNoOp if '_valuesToPush' is empty and no slice or sort gets performed;
      *   - ModifyResult::kArrayAppendUpdate if the 'elements' array is initially non-empty, all
-     *     inserted values are appended to the end, and no slice or sort gets performed; or
+     *     inserted values are appended to the end, and no slice or reordering sort gets performed;
+     *     or
      *   - ModifyResult::kNormalUpdate if 'elements' is initially an empty array, values get
-     *     inserted at the beginning or in the middle of the array, or a slice or sort gets
-     *     performed.
+     *     inserted at the beginning or in the middle of the array, or a slice or reordering sort
+     *     gets performed.
+     *
+     * When '_sort' is specified without '_position' and the array is already sorted, the new values
+     * are inserted in order rather than sorting the whole array again, so pushing values which sort
+     * last still produces a kArrayAppendUpdate.
      */
     ModifyResult performPush(mutablebson::Element* element, const FieldRef* elementPath) const;
 
@@ -688,6 +688,66 @@ TEST_F(PushNodeTest, ApplySortAfterSetCollator) {
     ASSERT_EQUALS("{a}", getModifiedPaths());
 }
 
+TEST_F(PushNodeTest, ApplyWithSortToSortedArrayLogsAppendedValues) {
+    auto update = fromjson("{$push: {a: {$each: [4, 3], $sort: 1}}}");
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    PushNode node;
+    ASSERT_OK(node.init(update["$push"]["a"], expCtx));
+
+    mutablebson::Document doc(fromjson("{a: [1, 2]}"));
+    setPathTaken(makeRuntimeUpdatePathForTest("a"));
+    addIndexedPath("a");
+    auto result = node.apply(getApplyParams(doc.root()["a"]), getUpdateNodeApplyParams());
+    ASSERT_FALSE(result.noop);
+    ASSERT_TRUE(result.indexesAffected);
+    ASSERT_EQUALS(fromjson("{a: [1, 2, 3, 4]}"), doc);
+    ASSERT_FALSE(doc.isInPlaceModeEnabled());
+
+    assertOplogEntry(fromjson("{$set: {'a.2': 3, 'a.3': 4}}"),
+                     fromjson("{$v: 2, diff: {sa: {a: true, u2: 3, u3: 4}}}"));
+    ASSERT_EQUALS("{a}", getModifiedPaths());
+}
+
+TEST_F(PushNodeTest, ApplyWithSortToSortedArrayInsertsInOrder) {
+    auto update = fromjson("{$push: {a: {$each: [{t: 5}, {t: 2}], $sort: {t: 1}, $slice: -4}}}");
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    PushNode node;
+    ASSERT_OK(node.init(update["$push"]["a"], expCtx));
+
+    mutablebson::Document doc(fromjson("{a: [{t: 1}, {t: 3}, {t: 4}]}"));
+    setPathTaken(makeRuntimeUpdatePathForTest("a"));
+    addIndexedPath("a");
+    auto result = node.apply(getApplyParams(doc.root()["a"]), getUpdateNodeApplyParams());
+    ASSERT_FALSE(result.noop);
+    ASSERT_TRUE(result.indexesAffected);
+    ASSERT_EQUALS(fromjson("{a: [{t: 2}, {t: 3}, {t: 4}, {t: 5}]}"), doc);
+    ASSERT_FALSE(doc.isInPlaceModeEnabled());
+
+    assertOplogEntry(fromjson("{$set: {a: [{t: 2}, {t: 3}, {t: 4}, {t: 5}]}}"),
+                     fromjson("{$v: 2, diff: {u: {a: [{t: 2}, {t: 3}, {t: 4}, {t: 5}]}}}"));
+    ASSERT_EQUALS("{a}", getModifiedPaths());
+}
+
+TEST_F(PushNodeTest, ApplyWithSortToUnsortedArraySortsWholeArray) {
+    auto update = fromjson("{$push: {a: {$each: [5], $sort: 1}}}");
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    PushNode node;
+    ASSERT_OK(node.init(update["$push"]["a"], expCtx));
+
+    mutablebson::Document doc(fromjson("{a: [3, 1, 2]}"));
+    setPathTaken(makeRuntimeUpdatePathForTest("a"));
+    addIndexedPath("a");
+    auto result = node.apply(getApplyParams(doc.root()["a"]), getUpdateNodeApplyParams());
+    ASSERT_FALSE(result.noop);
+    ASSERT_TRUE(result.indexesAffected);
+    ASSERT_EQUALS(fromjson("{a: [1, 2, 3, 5]}"), doc);
+    ASSERT_FALSE(doc.isInPlaceModeEnabled());
+
+    assertOplogEntry(fromjson("{$set: {a: [1, 2, 3, 5]}}"),
+                     fromjson("{$v: 2, diff: {u: {a: [1, 2, 3, 5]}}}"));
+    ASSERT_EQUALS("{a}", getModifiedPaths());
+}
+
 // Some of the below tests apply multiple different update modifiers. This special check function
 // prints out the modifier when it observes a failure, which will help with diagnosis.
 void checkDocumentAndResult(BSONObj updateModifier,
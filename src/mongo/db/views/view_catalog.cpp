@@ -694,10 +694,40 @@ std::shared_ptr<const ViewDefinition> ViewCatalog::lookupWithoutValidatingDurabl
     return _lookup(opCtx, ns, ViewCatalogLookupBehavior::kAllowInvalidDurableViews);
 }
 
+boost::optional<ResolvedView> ViewCatalog::ResolvedViewCache::find(StringData ns) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto it = _resolvedViews.find(ns);
+    if (it == _resolvedViews.end()) {
+        return boost::none;
+    }
+    return it->second;
+}
+
+void ViewCatalog::ResolvedViewCache::insert(StringData ns, const ResolvedView& resolvedView) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _resolvedViews.emplace(ns, resolvedView);
+}
+
 StatusWith<ResolvedView> ViewCatalog::resolveView(OperationContext* opCtx,
                                                   const NamespaceString& nss) const {
     _requireValidCatalog();
 
+    if (auto cached = _resolvedViewCache.find(nss.ns())) {
+        return std::move(*cached);
+    }
+
+    auto resolvedView = _resolveView(opCtx, nss);
+
+    // Only views are remembered, so that the cache is bounded by the size of the catalog.
+    if (resolvedView.isOK() &&
+        _lookup(opCtx, nss.ns(), ViewCatalogLookupBehavior::kValidateDurableViews)) {
+        _resolvedViewCache.insert(nss.ns(), resolvedView.getValue());
+    }
+    return resolvedView;
+}
+
+StatusWith<ResolvedView> ViewCatalog::_resolveView(OperationContext* opCtx,
+                                                   const NamespaceString& nss) const {
     // Keep looping until the resolution completes. If the catalog is invalidated during the
     // resolution, we start over from the beginning.
     while (true) {
@@ -34,6 +34,7 @@
 #include <memory>
 #include <string>
 #include <tuple>
+#include <boost/optional.hpp>
 #include <vector>
 
 #include "mongo/base/status.h"
@@ -135,7 +136,8 @@ public:
     /**
      * Resolve the views on 'nss', transforming the pipeline appropriately. This function returns a
      * fully-resolved view definition containing the backing namespace, the resolved pipeline and
-     * the collation to use for the operation.
+     * the collation to use for the operation. Views resolved successfully are remembered for the
+     * lifetime of this (immutable) catalog instance.
      */
     StatusWith<ResolvedView> resolveView(OperationContext* opCtx, const NamespaceString& nss) const;
 
@@ -172,6 +174,28 @@ public:
                                            const NamespaceString& name);
 
 private:
+    /**
+     * Remembers the views resolved through this catalog instance. An instance is never modified
+     * once it has been published, so the cached resolutions stay valid for its lifetime. A copy made
+     * to apply a modification starts out empty.
+     */
+    class ResolvedViewCache {
+    public:
+        ResolvedViewCache() = default;
+        ResolvedViewCache(const ResolvedViewCache&) {}
+        ResolvedViewCache& operator=(const ResolvedViewCache&) = delete;
+
+        boost::optional<ResolvedView> find(StringData ns) const;
+        void insert(StringData ns, const ResolvedView& resolvedView) const;
+
+    private:
+        mutable Mutex _mutex = MONGO_MAKE_LATCH("ViewCatalog::ResolvedViewCache::_mutex");
+        mutable StringMap<ResolvedView> _resolvedViews;  // protected by _mutex
+    };
+
+    StatusWith<ResolvedView> _resolveView(OperationContext* opCtx,
+                                          const NamespaceString& nss) const;
+
     Status _createOrUpdateView(OperationContext* opCtx,
                                const NamespaceString& viewName,
                                const NamespaceString& viewOn,
@@ -214,5 +238,6 @@ private:
     bool _valid;
     ViewGraph _viewGraph;
     bool _viewGraphNeedsRefresh;
+    ResolvedViewCache _resolvedViewCache;
 };
 }  // namespace mongo
@@ -693,6 +693,46 @@ TEST_F(ViewCatalogFixture, ResolveViewCorrectPipeline) {
     }
 }
 
+TEST_F(ViewCatalogFixture, ResolveViewAfterModifyReturnsNewPipeline) {
+    const NamespaceString viewName("db.view");
+    const NamespaceString viewOn("db.coll");
+
+    ASSERT_OK(createView(operationContext(),
+                         viewName,
+                         viewOn,
+                         BSON_ARRAY(BSON("$match" << BSON("foo" << 1))),
+                         emptyCollation));
+
+    auto resolveViewPipeline = [&] {
+        Lock::DBLock dbLock(operationContext(), "db", MODE_IS);
+        return uassertStatusOK(getViewCatalog()->resolveView(operationContext(), viewName))
+            .getPipeline();
+    };
+
+    // Resolving the same view twice through one catalog instance gives the same result.
+    auto pipeline = resolveViewPipeline();
+    ASSERT_EQ(pipeline.size(), 1U);
+    ASSERT_BSONOBJ_EQ(pipeline[0], BSON("$match" << BSON("foo" << 1)));
+    pipeline = resolveViewPipeline();
+    ASSERT_EQ(pipeline.size(), 1U);
+    ASSERT_BSONOBJ_EQ(pipeline[0], BSON("$match" << BSON("foo" << 1)));
+
+    ASSERT_OK(modifyView(operationContext(),
+                         viewName,
+                         viewOn,
+                         BSON_ARRAY(BSON("$match" << BSON("foo" << 2)))));
+    pipeline = resolveViewPipeline();
+    ASSERT_EQ(pipeline.size(), 1U);
+    ASSERT_BSONOBJ_EQ(pipeline[0], BSON("$match" << BSON("foo" << 2)));
+
+    ASSERT_OK(dropView(operationContext(), viewName));
+    Lock::DBLock dbLock(operationContext(), "db", MODE_IS);
+    auto resolvedView =
+        uassertStatusOK(getViewCatalog()->resolveView(operationContext(), viewName));
+    ASSERT_EQ(resolvedView.getNamespace(), viewName);
+    ASSERT_EQ(resolvedView.getPipeline().size(), 0U);
+}
+
 TEST_F(ViewCatalogFixture, ResolveViewOnCollectionNamespace) {
     const NamespaceString collectionNamespace("db.coll");
 
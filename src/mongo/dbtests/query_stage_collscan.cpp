@@ -48,10 +48,12 @@
 #include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/query/plan_executor_factory.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/storage/record_store.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/scopeguard.h"
 
 namespace query_stage_collection_scan {
 
@@ -295,6 +297,32 @@ TEST_F(QueryStageCollectionScanTest, QueryStageCollscanObjectsInOrderBackward) {
     ASSERT_EQUALS(numObj(), count);
 }
 
+// Reading the collection in batches returns the same objects as reading it one record at a time.
+TEST_F(QueryStageCollectionScanTest, QueryStageCollscanBatchedObjectsInOrder) {
+    auto oldBatchSize = internalQueryCollectionScanBatchSize.load();
+    internalQueryCollectionScanBatchSize.store(7);
+    ON_BLOCK_EXIT([&] { internalQueryCollectionScanBatchSize.store(oldBatchSize); });
+
+    AutoGetCollectionForReadCommand collection(&_opCtx, nss);
+
+    vector<RecordId> forward;
+    getRecordIds(collection.getCollection(), CollectionScanParams::FORWARD, &forward);
+    ASSERT_EQUALS(static_cast<size_t>(numObj()), forward.size());
+    for (int i = 0; i < numObj(); ++i) {
+        ASSERT_EQUALS(i, collection->docFor(&_opCtx, forward[i]).value()["foo"].numberInt());
+    }
+
+    vector<RecordId> backward;
+    getRecordIds(collection.getCollection(), CollectionScanParams::BACKWARD, &backward);
+    ASSERT_EQUALS(static_cast<size_t>(numObj()), backward.size());
+    for (int i = 0; i < numObj(); ++i) {
+        ASSERT_EQUALS(forward[numObj() - 1 - i], backward[i]);
+    }
+
+    ASSERT_EQUALS(numObj() / 2,
+                  countResults(CollectionScanParams::FORWARD, BSON("foo" << LT << numObj() / 2)));
+}
+
 // Scan through half the objects, delete the one we're about to fetch, then expect to get the "next"
 // object we would have gotten after that.
 TEST_F(QueryStageCollectionScanTest, QueryStageCollscanDeleteUpcomingObject) {
@@ -185,6 +185,70 @@ public:
     }
 };
 
+// Delete the documents in batches, and separately delete a document which was already staged in
+// the current batch. We expect the delete stage to skip over it when the batch is deleted.
+class QueryStageDeleteBatchedStagedObjectWasDeleted : public QueryStageDeleteBase {
+public:
+    void run() {
+        dbtests::WriteContextForTests ctx(&_opCtx, nss.ns());
+
+        const CollectionPtr& coll = ctx.getCollection();
+        ASSERT(coll);
+
+        vector<RecordId> recordIds;
+        getRecordIds(coll, CollectionScanParams::FORWARD, &recordIds);
+
+        CollectionScanParams collScanParams;
+        collScanParams.direction = CollectionScanParams::FORWARD;
+        collScanParams.tailable = false;
+
+        const size_t batchDocs = 8;
+        auto deleteStageParams = std::make_unique<DeleteStageParams>();
+        deleteStageParams->isMulti = true;
+        deleteStageParams->batchDocs = batchDocs;
+
+        WorkingSet ws;
+        DeleteStage deleteStage(
+            _expCtx.get(),
+            std::move(deleteStageParams),
+            &ws,
+            coll,
+            new CollectionScan(_expCtx.get(), coll, collScanParams, &ws, nullptr));
+
+        const DeleteStats* stats = static_cast<const DeleteStats*>(deleteStage.getSpecificStats());
+
+        // Delete the first batch, then stage half of the second one.
+        while (stats->docsDeleted == 0) {
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            ASSERT_EQUALS(PlanStage::NEED_TIME, deleteStage.work(&id));
+        }
+        ASSERT_EQUALS(batchDocs, stats->docsDeleted);
+        for (size_t i = 0; i < batchDocs / 2; ++i) {
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            ASSERT_EQUALS(PlanStage::NEED_TIME, deleteStage.work(&id));
+        }
+        ASSERT_EQUALS(batchDocs, stats->docsDeleted);
+
+        // Remove a document which is staged.
+        const size_t targetDocIndex = batchDocs + 2;
+        static_cast<PlanStage*>(&deleteStage)->saveState();
+        BSONObj targetDoc = coll->docFor(&_opCtx, recordIds[targetDocIndex]).value();
+        ASSERT(!targetDoc.isEmpty());
+        remove(targetDoc);
+        static_cast<PlanStage*>(&deleteStage)->restoreState(&coll);
+
+        // Remove the rest.
+        while (!deleteStage.isEOF()) {
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            PlanStage::StageState state = deleteStage.work(&id);
+            invariant(PlanStage::NEED_TIME == state || PlanStage::IS_EOF == state);
+        }
+
+        ASSERT_EQUALS(numObj() - 1, stats->docsDeleted);
+        ASSERT_EQUALS(0, coll->numRecords(&_opCtx));
+    }
+};
+
 /**
  * Test that the delete stage returns an owned copy of the original document if returnDeleted is
  * specified.
@@ -261,6 +325,7 @@ public:
         // Stage-specific tests below.
         add<QueryStageDeleteUpcomingObjectWasDeleted>();
         add<QueryStageDeleteReturnOldDoc>();
+        add<QueryStageDeleteBatchedStagedObjectWasDeleted>();
     }
 };
 
@@ -113,13 +113,15 @@ public:
     MockNearStage(const boost::intrusive_ptr<ExpressionContext>& expCtx,
                   WorkingSet* workingSet,
                   const CollectionPtr& coll,
-                  const IndexDescriptor* indexDescriptor)
+                  const IndexDescriptor* indexDescriptor,
+                  size_t limit = 0)
         : NearStage(expCtx.get(),
                     "MOCK_DISTANCE_SEARCH_STAGE",
                     STAGE_UNKNOWN,
                     workingSet,
                     coll,
-                    indexDescriptor),
+                    indexDescriptor,
+                    limit),
           _pos(0) {}
 
     void addInterval(vector<BSONObj> data, double min, double max) {
@@ -229,6 +231,40 @@ TEST_F(QueryStageNearTest, Basic) {
     assertAscendingAndValid(results);
 }
 
+TEST_F(QueryStageNearTest, Limit) {
+    vector<BSONObj> mockData;
+    WorkingSet workingSet;
+
+    MockNearStage nearStage(_expCtx.get(), &workingSet, getCollection(), _mockGeoIndex, 3);
+
+    mockData.clear();
+    mockData.push_back(BSON("distance" << 0.5));
+    mockData.push_back(BSON("distance" << 2.0));
+    mockData.push_back(BSON("distance" << 0.0));
+    mockData.push_back(BSON("distance" << 3.5));
+    nearStage.addInterval(mockData, 0.0, 1.0);
+
+    mockData.clear();
+    mockData.push_back(BSON("distance" << 1.5));
+    mockData.push_back(BSON("distance" << 0.5));  // Not included
+    mockData.push_back(BSON("distance" << 1.0));
+    nearStage.addInterval(mockData, 1.0, 2.0);
+
+    // Never searched, since the limit is reached in the previous interval.
+    mockData.clear();
+    mockData.push_back(BSON("distance" << 2.5));
+    nearStage.addInterval(mockData, 2.0, 3.0);
+
+    vector<BSONObj> results = advanceStage(&nearStage, &workingSet);
+    ASSERT_EQUALS(results.size(), 3u);
+    assertAscendingAndValid(results);
+    ASSERT_EQUALS(results.back()["distance"].numberDouble(), 1.0);
+    ASSERT(nearStage.isEOF());
+
+    auto stats = static_cast<const NearStats*>(nearStage.getSpecificStats());
+    ASSERT_EQUALS(stats->intervalStats.size(), 2u);
+}
+
 TEST_F(QueryStageNearTest, EmptyResults) {
     vector<BSONObj> mockData;
     WorkingSet workingSet;
@@ -370,6 +370,128 @@ public:
     }
 };
 
+// Run a batched multi-update, and separately remove a document which was already staged in the
+// current batch. We expect the update stage to skip over it when the batch is updated.
+class QueryStageUpdateBatchedSkipDeletedDoc : public QueryStageUpdateBase {
+public:
+    void run() {
+        const size_t batchDocs = 4;
+
+        // Run the update.
+        {
+            dbtests::WriteContextForTests ctx(&_opCtx, nss.ns());
+
+            // Populate the collection.
+            for (int i = 0; i < 10; ++i) {
+                insert(BSON("_id" << i << "foo" << i));
+            }
+            ASSERT_EQUALS(10U, count(BSONObj()));
+
+            CurOp& curOp = *CurOp::get(_opCtx);
+            OpDebug* opDebug = &curOp.debug();
+            UpdateDriver driver(_expCtx);
+            CollectionPtr coll =
+                CollectionCatalog::get(&_opCtx)->lookupCollectionByNamespace(&_opCtx, nss);
+            ASSERT(coll);
+
+            // Get the RecordIds that would be returned by an in-order scan.
+            vector<RecordId> recordIds;
+            getRecordIds(coll, CollectionScanParams::FORWARD, &recordIds);
+
+            auto request = UpdateRequest();
+            request.setNamespaceString(nss);
+
+            // Update is a multi-update that sets 'bar' to 3 in every document where foo is less
+            // than 8.
+            BSONObj query = fromjson("{foo: {$lt: 8}}");
+            BSONObj updates = fromjson("{$set: {bar: 3}}");
+
+            request.setMulti();
+            request.setQuery(query);
+            request.setUpdateModification(
+                write_ops::UpdateModification::parseFromClassicUpdate(updates));
+
+            const std::map<StringData, std::unique_ptr<ExpressionWithPlaceholder>> arrayFilters;
+            const auto constants = boost::none;
+
+            ASSERT_DOES_NOT_THROW(driver.parse(
+                request.getUpdateModification(), arrayFilters, constants, request.isMulti()));
+
+            // Configure the scan.
+            CollectionScanParams collScanParams;
+            collScanParams.direction = CollectionScanParams::FORWARD;
+            collScanParams.tailable = false;
+
+            // Configure the update.
+            UpdateStageParams updateParams(&request, &driver, opDebug);
+            unique_ptr<CanonicalQuery> cq(canonicalize(query));
+            updateParams.canonicalQuery = cq.get();
+            updateParams.batchDocs = batchDocs;
+
+            auto ws = make_unique<WorkingSet>();
+            auto cs = make_unique<CollectionScan>(
+                _expCtx.get(), coll, collScanParams, ws.get(), cq->root());
+
+            auto updateStage =
+                make_unique<UpdateStage>(_expCtx.get(), updateParams, ws.get(), coll, cs.release());
+
+            const UpdateStats* stats =
+                static_cast<const UpdateStats*>(updateStage->getSpecificStats());
+
+            // Update the first batch, then stage half of the second one.
+            while (stats->nModified == 0) {
+                WorkingSetID id = WorkingSet::INVALID_ID;
+                PlanStage::StageState state = updateStage->work(&id);
+                ASSERT_EQUALS(PlanStage::NEED_TIME, state);
+            }
+            ASSERT_EQUALS(batchDocs, stats->nModified);
+            for (size_t i = 0; i < batchDocs / 2; ++i) {
+                WorkingSetID id = WorkingSet::INVALID_ID;
+                PlanStage::StageState state = updateStage->work(&id);
+                ASSERT_EQUALS(PlanStage::NEED_TIME, state);
+            }
+            ASSERT_EQUALS(batchDocs, stats->nModified);
+
+            // Remove a document which is staged.
+            const size_t targetDocIndex = batchDocs + 1;
+            static_cast<PlanStage*>(updateStage.get())->saveState();
+            BSONObj targetDoc = coll->docFor(&_opCtx, recordIds[targetDocIndex]).value();
+            ASSERT(!targetDoc.isEmpty());
+            remove(targetDoc);
+            static_cast<PlanStage*>(updateStage.get())->restoreState(&coll);
+
+            // Do the remaining updates.
+            while (!updateStage->isEOF()) {
+                WorkingSetID id = WorkingSet::INVALID_ID;
+                PlanStage::StageState state = updateStage->work(&id);
+                ASSERT(PlanStage::NEED_TIME == state || PlanStage::IS_EOF == state);
+            }
+
+            // 7 of the 8 matching documents should have been modified (one was deleted).
+            ASSERT_EQUALS(7U, stats->nModified);
+            ASSERT_EQUALS(7U, stats->nMatched);
+        }
+
+        // Check the contents of the collection.
+        {
+            AutoGetCollectionForReadCommand collection(&_opCtx, nss);
+
+            vector<BSONObj> objs;
+            getCollContents(collection.getCollection(), &objs);
+
+            // Verify that the collection now has 9 docs (one was deleted).
+            ASSERT_EQUALS(9U, objs.size());
+
+            assertHasDoc(objs, fromjson("{_id: 0, foo: 0, bar: 3}"));
+            assertHasDoc(objs, fromjson("{_id: 4, foo: 4, bar: 3}"));
+            assertHasDoc(objs, fromjson("{_id: 6, foo: 6, bar: 3}"));
+            assertHasDoc(objs, fromjson("{_id: 7, foo: 7, bar: 3}"));
+            assertHasDoc(objs, fromjson("{_id: 8, foo: 8}"));
+            assertHasDoc(objs, fromjson("{_id: 9, foo: 9}"));
+        }
+    }
+};
+
 /**
  * Test that the update stage returns an owned copy of the original document if
  * ReturnDocOption::RETURN_OLD is specified.
@@ -564,6 +686,7 @@ public:
         // Stage-specific tests below.
         add<QueryStageUpdateUpsertEmptyColl>();
         add<QueryStageUpdateSkipDeletedDoc>();
+        add<QueryStageUpdateBatchedSkipDeletedDoc>();
         add<QueryStageUpdateReturnOldDoc>();
         add<QueryStageUpdateReturnNewDoc>();
     }
@@ -74,8 +74,10 @@
 #include "mongo/util/background.h"
 #include "mongo/util/exit.h"
 #include "mongo/util/periodic_runner_factory.h"
+#include "mongo/util/processinfo.h"
 #include "mongo/util/quick_exit.h"
 #include "mongo/util/time_support.h"
+#include "mongo/util/timer.h"
 
 #include <boost/filesystem.hpp>
 
@@ -188,6 +190,7 @@ void shutdown(ServiceContext* srvContext) {
 
 
 ServiceContext* initialize(const char* yaml_config) {
+    Timer startupTimer;
     srand(static_cast<unsigned>(curTimeMicros64()));
 
     if (yaml_config)
@@ -334,6 +337,13 @@ ServiceContext* initialize(const char* yaml_config) {
 
     serviceContext->notifyStartupComplete();
 
+    // Report what starting the library cost, to size the devices it runs on.
+    LOGV2_OPTIONS(5591723,
+                  {LogComponent::kControl},
+                  "Embedded library started",
+                  "durationMillis"_attr = startupTimer.millis(),
+                  "residentMB"_attr = ProcessInfo().getResidentSize());
+
     // Init succeeded, no need for global deinit.
     giGuard.dismiss();
 
@@ -31,19 +31,65 @@
 
 #include "mongo/embedded/embedded_options.h"
 
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/server_options_base.h"
 #include "mongo/db/server_options_helpers.h"
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/embedded/embedded_options_gen.h"
+#include "mongo/idl/server_parameter.h"
+#include "mongo/util/str.h"
 
 #include <boost/filesystem.hpp>
+#include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace mongo {
 namespace embedded {
 
 using std::string;
 
+namespace {
+
+// The server parameters the low memory profile lowers, and their values in the profile.
+const std::vector<std::pair<std::string, std::string>> kLowMemoryProfileParameters = {
+    {"internalQueryCacheMaxEntriesPerCollection", "100"},
+    {"internalQueryCacheNumPartitions", "1"},
+    {"maxSessions", "10000"},
+};
+
+// The values the parameters changed by the low memory profile had before, restored when the
+// library is deinitialized so that the next instance starts from the defaults again.
+BSONObj parametersBeforeLowMemoryProfile;
+
+Status applyLowMemoryProfile(const moe::Environment& params) {
+    std::map<std::string, std::string> explicitParameters;
+    if (params.count("setParameter")) {
+        explicitParameters = params["setParameter"].as<std::map<std::string, std::string>>();
+    }
+
+    BSONObjBuilder previousValues;
+    const auto& spMap = ServerParameterSet::getGlobal()->getMap();
+    for (const auto& [name, value] : kLowMemoryProfileParameters) {
+        if (explicitParameters.count(name)) {
+            continue;
+        }
+        auto it = spMap.find(name);
+        invariant(it != spMap.end());
+        it->second->append(nullptr, previousValues, name);
+        Status status = it->second->setFromString(value);
+        if (!status.isOK()) {
+            return status.withContext(str::stream() << "Failed to set '" << name
+                                                    << "' for the low memory profile");
+        }
+    }
+    parametersBeforeLowMemoryProfile = previousValues.obj();
+    return Status::OK();
+}
+
+}  // namespace
+
 Status addOptions(optionenvironment::OptionSection* options) {
     Status ret = addBaseServerOptions(options);
     if (!ret.isOK()) {
@@ -78,6 +124,14 @@ Status storeOptions(const moe::Environment& params) {
         storageGlobalParams.dbpath = params["storage.dbPath"].as<string>();
     }
 
+    if (params.count("embedded.lowMemoryProfile") &&
+        params["embedded.lowMemoryProfile"].as<bool>()) {
+        ret = applyLowMemoryProfile(params);
+        if (!ret.isOK()) {
+            return ret;
+        }
+    }
+
 #ifdef _WIN32
     if (storageGlobalParams.dbpath.size() > 1 &&
         storageGlobalParams.dbpath[storageGlobalParams.dbpath.size() - 1] == '/') {
@@ -102,6 +156,14 @@ Status storeOptions(const moe::Environment& params) {
 
 void resetOptions() {
     storageGlobalParams.reset();
+
+    const auto& spMap = ServerParameterSet::getGlobal()->getMap();
+    for (auto&& previousValue : parametersBeforeLowMemoryProfile) {
+        auto it = spMap.find(previousValue.fieldName());
+        invariant(it != spMap.end());
+        it->second->set(previousValue).ignore();
+    }
+    parametersBeforeLowMemoryProfile = BSONObj();
 }
 
 std::string storageDBPathDescription() {
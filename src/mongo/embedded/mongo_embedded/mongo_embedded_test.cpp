@@ -115,6 +115,8 @@ protected:
         yaml << YAML::Value << globalTempDir->path();
         yaml << YAML::EndMap;  // storage
 
+        appendOptions(yaml);
+
         yaml << YAML::EndMap;
 
         params.yaml_config = yaml.c_str();
@@ -143,6 +145,11 @@ protected:
         mongo_embedded_v1_status_destroy(status);
     }
 
+    /**
+     * Lets a test add its own options to the configuration of the instance.
+     */
+    virtual void appendOptions(YAML::Emitter& yaml) {}
+
     mongo_embedded_v1_instance* getDB() const {
         return db;
     }
@@ -648,6 +655,47 @@ TEST_F(MongodbCAPITest, RunListCommands) {
     ASSERT(unsupported.empty()) << mongo::StringSplitter::join(unsupported, ", ");
 }
 
+class MongodbCAPILowMemoryProfileTest : public MongodbCAPITest {
+protected:
+    void appendOptions(YAML::Emitter& yaml) override {
+        yaml << YAML::Key << "embedded";
+        yaml << YAML::Value << YAML::BeginMap;
+        yaml << YAML::Key << "lowMemoryProfile";
+        yaml << YAML::Value << true;
+        yaml << YAML::EndMap;  // embedded
+    }
+
+    mongo::BSONObj getParameter(MongoDBCAPIClientPtr& client, const std::string& name) {
+        auto request =
+            mongo::OpMsgRequest::fromDBAndBody("admin", BSON("getParameter" << 1 << name << 1));
+        return performRpc(client, request);
+    }
+};
+
+TEST_F(MongodbCAPILowMemoryProfileTest, LowersCacheSizes) {
+    auto client = createClient();
+
+    auto output = getParameter(client, "internalQueryCacheMaxEntriesPerCollection");
+    ASSERT_EQUALS(output.getIntField("internalQueryCacheMaxEntriesPerCollection"), 100) << output;
+    output = getParameter(client, "maxSessions");
+    ASSERT_EQUALS(output.getIntField("maxSessions"), 10000) << output;
+
+    // The instance works as usual.
+    auto insertOpMsg = mongo::OpMsgRequest::fromDBAndBody(
+        "db_name", mongo::fromjson("{insert: 'collection_name', documents: [{a: 1}]}"));
+    output = performRpc(client, insertOpMsg);
+    ASSERT(output.getField("ok").numberDouble() == 1.0) << output;
+}
+
+TEST_F(MongodbCAPITest, DefaultCacheSizes) {
+    // Runs after the low memory profile test, whose values must not leak into later instances.
+    auto client = createClient();
+    auto request = mongo::OpMsgRequest::fromDBAndBody(
+        "admin", BSON("getParameter" << 1 << "internalQueryCacheMaxEntriesPerCollection" << 1));
+    auto output = performRpc(client, request);
+    ASSERT_EQUALS(output.getIntField("internalQueryCacheMaxEntriesPerCollection"), 5000) << output;
+}
+
 // This test is temporary to make sure that only one database can be created
 // This restriction may be relaxed at a later time
 TEST_F(MongodbCAPITest, CreateMultipleDBs) {
@@ -53,6 +53,13 @@ ConnectionStatsPer& ConnectionStatsPer::operator+=(const ConnectionStatsPer& oth
     return *this;
 }
 
+ControllerStatsPer& ControllerStatsPer::operator+=(const ControllerStatsPer& other) {
+    demand += other.demand;
+    target += other.target;
+
+    return *this;
+}
+
 void ConnectionPoolStats::updateStatsForHost(std::string pool,
                                              HostAndPort host,
                                              ConnectionStatsPer newStats) {
@@ -76,6 +83,11 @@ void ConnectionPoolStats::updateStatsForHost(std::string pool,
     totalRefreshing += newStats.refreshing;
 }
 
+void ConnectionPoolStats::updateControllerStatsForHost(HostAndPort host,
+                                                       ControllerStatsPer newStats) {
+    controllerStatsByHost[host] += newStats;
+}
+
 void ConnectionPoolStats::appendToBSON(mongo::BSONObjBuilder& result, bool forFTDC) {
     result.appendNumber("totalInUse", totalInUse);
     result.appendNumber("totalAvailable", totalAvailable);
@@ -130,6 +142,12 @@ void ConnectionPoolStats::appendToBSON(mongo::BSONObjBuilder& result, bool forFT
             hostInfo.appendNumber("available", hostStats.available);
             hostInfo.appendNumber("created", hostStats.created);
             hostInfo.appendNumber("refreshing", hostStats.refreshing);
+
+            auto it = controllerStatsByHost.find(host.first);
+            if (it != controllerStatsByHost.end()) {
+                hostInfo.appendNumber("demand", it->second.demand);
+                hostInfo.appendNumber("targetConnections", it->second.target);
+            }
         }
     }
 }
@@ -53,6 +53,19 @@ struct ConnectionStatsPer {
     size_t refreshing = 0u;
 };
 
+/**
+ * Holds the connection counts that a pool controller chose for a remote host.
+ */
+struct ControllerStatsPer {
+    ControllerStatsPer& operator+=(const ControllerStatsPer& other);
+
+    // The number of requests that were queued or running against the host
+    size_t demand = 0u;
+
+    // The number of connections that the controller asked the pool to maintain
+    size_t target = 0u;
+};
+
 /**
  * Aggregates connection information for the connPoolStats command. Connection pools should
  * use the updateStatsForHost() method to append their host-specific information to this object.
@@ -61,6 +74,8 @@ struct ConnectionStatsPer {
 struct ConnectionPoolStats {
     void updateStatsForHost(std::string pool, HostAndPort host, ConnectionStatsPer newStats);
 
+    void updateControllerStatsForHost(HostAndPort host, ControllerStatsPer newStats);
+
     void appendToBSON(mongo::BSONObjBuilder& result, bool forFTDC = false);
 
     size_t totalInUse = 0u;
@@ -78,6 +93,8 @@ struct ConnectionPoolStats {
 
     StatsByHost statsByHost;
     StatsByPool statsByPool;
+
+    std::map<HostAndPort, ControllerStatsPer> controllerStatsByHost;
 };
 
 }  // namespace executor
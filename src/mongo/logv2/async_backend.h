@@ -0,0 +1,339 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <boost/log/attributes/value_extraction.hpp>
+#include <boost/log/core/record_view.hpp>
+#include <boost/log/detail/locking_ptr.hpp>
+#include <boost/log/sinks/basic_sink_backend.hpp>
+#include <boost/log/sinks/frontend_requirements.hpp>
+#include <chrono>
+#include <memory>
+
+#include "mongo/logv2/attributes.h"
+#include "mongo/logv2/log_severity.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/new.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/util/concurrency/thread_name.h"
+
+namespace mongo::logv2 {
+
+/**
+ * What a thread logging into a full AsyncBackend queue does with its record.
+ */
+enum class AsyncOverflowPolicy {
+    // Wait for the writer thread to make room in the queue.
+    kBlock,
+    // Discard the record. Warnings and errors are never discarded, they wait like kBlock.
+    kDrop,
+};
+
+/**
+ * Counters of the records handled by all AsyncBackend instances of the process.
+ */
+struct AsyncBackendStats {
+    static AsyncBackendStats& get();
+
+    AtomicWord<long long> queued;
+    AtomicWord<long long> written;
+    AtomicWord<long long> dropped;
+    // Records whose thread had to wait for room in the queue.
+    AtomicWord<long long> blocked;
+};
+
+/**
+ * boost::log backend that hands formatted records to a background thread which writes them to the
+ * wrapped backend, so that logging threads do not wait on the log file.
+ *
+ * Records are formatted by the frontend on the logging thread, because their attributes refer to
+ * the stack of the thread that logged them. The formatted strings are queued in a bounded
+ * multi-producer ring buffer that logging threads push into without taking a lock. The writer
+ * thread drains it in batches and flushes the wrapped backend once per batch. Records of Error
+ * severity and above are only returned from once the queue has been written up to them, so they
+ * reach the log before a possible abort.
+ *
+ * With a capacity of zero no thread is started and records are written on the logging thread.
+ *
+ * The wrapped backend must only depend on the formatted string, as it is given an empty
+ * record_view.
+ */
+template <typename Backend>
+class AsyncBackend
+    : public boost::log::sinks::basic_formatted_sink_backend<
+          char,
+          boost::log::sinks::combine_requirements<boost::log::sinks::concurrent_feeding,
+                                                  boost::log::sinks::flushing>::type> {
+public:
+    AsyncBackend(boost::shared_ptr<Backend> backend,
+                 size_t capacity,
+                 AsyncOverflowPolicy policy = AsyncOverflowPolicy::kBlock)
+        : _backend(std::move(backend)), _policy(policy) {
+        if (capacity == 0) {
+            return;
+        }
+
+        size_t roundedCapacity = 2;
+        while (roundedCapacity < capacity) {
+            roundedCapacity *= 2;
+        }
+        _mask = roundedCapacity - 1;
+        _cells = std::make_unique<Cell[]>(roundedCapacity);
+        for (size_t i = 0; i < roundedCapacity; ++i) {
+            _cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        _writer = stdx::thread([this] { _run(); });
+    }
+
+    ~AsyncBackend() {
+        if (!_cells) {
+            return;
+        }
+        {
+            stdx::lock_guard lk(_mutex);
+            _shutdown = true;
+        }
+        _writerCv.notify_one();
+        _writer.join();
+    }
+
+    AsyncBackend(const AsyncBackend&) = delete;
+    AsyncBackend& operator=(const AsyncBackend&) = delete;
+
+    /**
+     * Locking accessor to the wrapped backend, which excludes the writer thread.
+     */
+    auto lockedBackend() {
+        return boost::log::aux::locking_ptr(_backend, _backendMutex);
+    }
+
+    void consume(boost::log::record_view const& rec, string_type const& formatted_string) {
+        if (!_cells) {
+            stdx::lock_guard lk(_backendMutex);
+            _backend->consume(rec, formatted_string);
+            return;
+        }
+
+        auto& stats = AsyncBackendStats::get();
+        auto severity = LogSeverity::Log();
+        if (auto extracted = boost::log::extract<LogSeverity>(attributes::severity(), rec)) {
+            severity = extracted.get();
+        }
+        if (_tryPush(formatted_string)) {
+            _wakeWriter();
+        } else {
+            if (_policy == AsyncOverflowPolicy::kDrop && severity < LogSeverity::Warning()) {
+                stats.dropped.fetchAndAddRelaxed(1);
+                return;
+            }
+            stats.blocked.fetchAndAddRelaxed(1);
+            _pushBlocking(formatted_string);
+            _wakeWriter();
+        }
+        stats.queued.fetchAndAddRelaxed(1);
+
+        if (severity >= LogSeverity::Error()) {
+            _drain();
+        }
+    }
+
+    /**
+     * Waits for the records queued so far to be written, and flushes the wrapped backend.
+     */
+    void flush() {
+        if (_cells) {
+            _drain();
+        }
+        stdx::lock_guard lk(_backendMutex);
+        _flushBackend();
+    }
+
+private:
+    static constexpr size_t kMaxBatchSize = 256;
+    static constexpr auto kWriterIdleWait = std::chrono::milliseconds(100);
+    static constexpr auto kProgressWait = std::chrono::milliseconds(1);
+
+    struct Cell {
+        std::atomic<uint64_t> sequence;  // NOLINT
+        string_type message;
+    };
+
+    /**
+     * Claims the next free cell of the queue and copies the record into it, or returns false if
+     * the queue is full. Cells keep the capacity of their strings, so this only allocates while
+     * the queue warms up or for records longer than the ones before.
+     */
+    bool _tryPush(const string_type& message) {
+        auto pos = _enqueuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &_cells[pos & _mask];
+            auto sequence = cell->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(pos);
+            if (diff == 0) {
+                if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = _enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->message.assign(message);
+        cell->sequence.store(pos + 1, std::memory_order_seq_cst);
+        return true;
+    }
+
+    void _wakeWriter() {
+        // Only the first thread to find the writer idle pays for waking it up.
+        if (_writerIdle.load() && _writerIdle.swap(false)) {
+            stdx::lock_guard lk(_mutex);
+            _writerCv.notify_one();
+        }
+    }
+
+    void _pushBlocking(const string_type& message) {
+        stdx::unique_lock lk(_mutex);
+        _waiters.fetchAndAdd(1);
+        while (!_tryPush(message)) {
+            _progressCv.wait_for(lk, kProgressWait);
+        }
+        _waiters.fetchAndSubtract(1);
+    }
+
+    void _drain() {
+        const auto target = _enqueuePos.load();
+        stdx::unique_lock lk(_mutex);
+        _waiters.fetchAndAdd(1);
+        while (_writtenPos.load() < target) {
+            _progressCv.wait_for(lk, kProgressWait);
+        }
+        _waiters.fetchAndSubtract(1);
+    }
+
+    void _flushBackend() {
+        if constexpr (boost::log::sinks::has_requirement<typename Backend::frontend_requirements,
+                                                         boost::log::sinks::flushing>::value) {
+            _backend->flush();
+        }
+    }
+
+    bool _hasWork() const {
+        return _cells[_dequeuePos & _mask].sequence.load(std::memory_order_seq_cst) ==
+            _dequeuePos + 1;
+    }
+
+    bool _tryPop(string_type& message) {
+        auto& cell = _cells[_dequeuePos & _mask];
+        if (cell.sequence.load(std::memory_order_acquire) != _dequeuePos + 1) {
+            return false;
+        }
+        message.swap(cell.message);
+        cell.sequence.store(_dequeuePos + _mask + 1, std::memory_order_release);
+        ++_dequeuePos;
+        return true;
+    }
+
+    size_t _writeBatch() {
+        size_t written = 0;
+        {
+            stdx::lock_guard lk(_backendMutex);
+            while (written < kMaxBatchSize && _tryPop(_writeBuffer)) {
+                _backend->consume(boost::log::record_view(), _writeBuffer);
+                ++written;
+            }
+            if (written) {
+                _flushBackend();
+            }
+        }
+
+        if (written) {
+            AsyncBackendStats::get().written.fetchAndAddRelaxed(written);
+            _writtenPos.store(_dequeuePos);
+            if (_waiters.load()) {
+                stdx::lock_guard lk(_mutex);
+                _progressCv.notify_all();
+            }
+        }
+        return written;
+    }
+
+    void _run() {
+        setThreadName("LogWriter");
+        while (true) {
+            if (_writeBatch()) {
+                continue;
+            }
+
+            stdx::unique_lock lk(_mutex);
+            if (_shutdown && !_hasWork()) {
+                return;
+            }
+            _writerIdle.store(true);
+            _writerCv.wait_for(lk, kWriterIdleWait, [&] {
+                return _shutdown || !_writerIdle.load() || _hasWork();
+            });
+            _writerIdle.store(false);
+        }
+    }
+
+    const boost::shared_ptr<Backend> _backend;
+    const AsyncOverflowPolicy _policy;
+
+    // Serializes the writer thread with rotation and with synchronous writes.
+    stdx::mutex _backendMutex;  // NOLINT
+
+    std::unique_ptr<Cell[]> _cells;
+    uint64_t _mask = 0;
+    alignas(stdx::hardware_destructive_interference_size)
+        std::atomic<uint64_t> _enqueuePos{0};  // NOLINT
+
+    // Only used by the writer thread.
+    alignas(stdx::hardware_destructive_interference_size) uint64_t _dequeuePos = 0;
+    string_type _writeBuffer;
+    AtomicWord<uint64_t> _writtenPos{0};
+
+    // Guards waiting on the condition variables, the queue itself is lock-free.
+    stdx::mutex _mutex;  // NOLINT
+    stdx::condition_variable _writerCv;
+    stdx::condition_variable _progressCv;
+    AtomicWord<bool> _writerIdle{false};
+    AtomicWord<int> _waiters{0};
+    bool _shutdown = false;
+
+    stdx::thread _writer;
+};
+
+}  // namespace mongo::logv2
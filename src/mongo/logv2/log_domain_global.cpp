@@ -30,6 +30,7 @@
 #include "log_domain_global.h"
 
 #include "mongo/config.h"
+#include "mongo/logv2/async_backend.h"
 #include "mongo/logv2/component_settings_filter.h"
 #include "mongo/logv2/composite_backend.h"
 #include "mongo/logv2/console.h"
@@ -66,7 +67,7 @@ struct LogDomainGlobal::Impl {
                              UserAssertSink>
         SyslogBackend;
 #endif
-    typedef CompositeBackend<FileRotateSink, RamLogSink, RamLogSink, UserAssertSink>
+    typedef CompositeBackend<AsyncBackend<FileRotateSink>, RamLogSink, RamLogSink, UserAssertSink>
         RotatableFileBackend;
 
     Impl(LogDomainGlobal& parent);
@@ -158,17 +159,22 @@ Status LogDomainGlobal::Impl::configure(LogDomainGlobal::ConfigurationOptions co
 #endif
 
     if (options.fileEnabled) {
-        auto backend = boost::make_shared<RotatableFileBackend>(
-            boost::make_shared<FileRotateSink>(options.timestampFormat),
-            boost::make_shared<RamLogSink>(RamLog::get("global")),
-            boost::make_shared<RamLogSink>(RamLog::get("startupWarnings")),
-            boost::make_shared<UserAssertSink>());
-        Status ret = backend->lockedBackend<0>()->addFile(
+        auto fileSink = boost::make_shared<FileRotateSink>(options.timestampFormat);
+        Status ret = fileSink->addFile(
             options.filePath,
             options.fileOpenMode == ConfigurationOptions::OpenMode::kAppend ? true : false);
         if (!ret.isOK())
             return ret;
-        backend->lockedBackend<0>()->auto_flush(true);
+        // The writer thread of an asynchronous sink flushes once per batch instead.
+        fileSink->auto_flush(options.fileAsyncBufferEntries == 0);
+
+        auto backend = boost::make_shared<RotatableFileBackend>(
+            boost::make_shared<AsyncBackend<FileRotateSink>>(std::move(fileSink),
+                                                             options.fileAsyncBufferEntries,
+                                                             options.fileAsyncOverflowPolicy),
+            boost::make_shared<RamLogSink>(RamLog::get("global")),
+            boost::make_shared<RamLogSink>(RamLog::get("startupWarnings")),
+            boost::make_shared<UserAssertSink>());
         backend->setFilter<2>(
             TaggedSeverityFilter(_parent, {LogTag::kStartupWarnings}, LogSeverity::Log()));
 
@@ -224,7 +230,9 @@ const LogDomainGlobal::ConfigurationOptions& LogDomainGlobal::Impl::config() con
 
 Status LogDomainGlobal::Impl::rotate(bool rename, StringData renameSuffix) {
     if (_rotatableFileSink) {
-        auto backend = _rotatableFileSink->locked_backend()->lockedBackend<0>();
+        // Write out the records queued so far, so they end up in the file being rotated.
+        _rotatableFileSink->flush();
+        auto backend = _rotatableFileSink->locked_backend()->lockedBackend<0>()->lockedBackend();
         return backend->rotate(rename, renameSuffix);
     }
     return Status::OK();
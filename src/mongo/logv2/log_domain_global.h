@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include "mongo/logv2/async_backend.h"
 #include "mongo/logv2/constants.h"
 #include "mongo/logv2/log_domain_internal.h"
 #include "mongo/logv2/log_format.h"
@@ -45,6 +46,10 @@ public:
         std::string filePath;
         RotationMode fileRotationMode{RotationMode::kRename};
         OpenMode fileOpenMode{OpenMode::kTruncate};
+        // Number of records queued for a background thread to write to the file, zero writes them
+        // on the logging thread.
+        size_t fileAsyncBufferEntries{0};
+        AsyncOverflowPolicy fileAsyncOverflowPolicy{AsyncOverflowPolicy::kBlock};
         LogTimestampFormat timestampFormat{LogTimestampFormat::kISO8601UTC};
         bool syslogEnabled{false};
         int syslogFacility{-1};  // invalid facility by default, must be set
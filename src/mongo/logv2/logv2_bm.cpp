@@ -29,7 +29,10 @@
 
 #define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kDefault
 
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/logv2/async_backend.h"
 #include "mongo/logv2/component_settings_filter.h"
+#include "mongo/logv2/json_formatter.h"
 #include "mongo/logv2/log.h"
 #include "mongo/logv2/log_domain_global.h"
 #include "mongo/logv2/text_formatter.h"
@@ -40,6 +43,7 @@
 #include <boost/iostreams/stream.hpp>
 #include <boost/log/sinks/sync_frontend.hpp>
 #include <boost/log/sinks/text_ostream_backend.hpp>
+#include <boost/log/sinks/unlocked_frontend.hpp>
 #include <boost/make_shared.hpp>
 #include <iostream>
 
@@ -53,6 +57,7 @@ boost::shared_ptr<std::ostream> makeNullStream() {
 }
 
 // RAII style helper class for init/deinit new log system
+template <typename Formatter = logv2::TextFormatter>
 class ScopedLogV2Bench {
 public:
     ScopedLogV2Bench(benchmark::State& state) {
@@ -83,7 +88,7 @@ private:
         _sink->set_filter(
             logv2::ComponentSettingsFilter(logv2::LogManager::global().getGlobalDomain(),
                                            logv2::LogManager::global().getGlobalSettings()));
-        _sink->set_formatter(logv2::TextFormatter());
+        _sink->set_formatter(Formatter());
         boost::log::core::get()->add_sink(_sink);
     }
 
@@ -97,6 +102,66 @@ private:
     bool _shouldInit;
 };
 
+// Like ScopedLogV2Bench, but writes through an AsyncBackend and reports how many records were
+// dropped or had to wait for room in its queue.
+template <logv2::AsyncOverflowPolicy policy>
+class ScopedAsyncLogV2Bench {
+public:
+    using Backend = logv2::AsyncBackend<boost::log::sinks::text_ostream_backend>;
+
+    static constexpr size_t kCapacity = 64 * 1024;
+
+    ScopedAsyncLogV2Bench(benchmark::State& state) : _state(state) {
+        _shouldInit = state.thread_index == 0;
+        if (_shouldInit) {
+            auto& stats = logv2::AsyncBackendStats::get();
+            _droppedBefore = stats.dropped.load();
+            _blockedBefore = stats.blocked.load();
+            setupAppender();
+        }
+    }
+
+    ~ScopedAsyncLogV2Bench() {
+        if (_shouldInit) {
+            tearDownAppender();
+            auto& stats = logv2::AsyncBackendStats::get();
+            _state.counters["dropped"] = stats.dropped.load() - _droppedBefore;
+            _state.counters["blocked"] = stats.blocked.load() - _blockedBefore;
+        }
+    }
+
+private:
+    void setupAppender() {
+        logv2::LogDomainGlobal::ConfigurationOptions config;
+        config.makeDisabled();
+        invariant(logv2::LogManager::global().getGlobalDomainInternal().configure(config).isOK());
+
+        auto stream = boost::make_shared<boost::log::sinks::text_ostream_backend>();
+        stream->add_stream(makeNullStream());
+
+        _sink = boost::make_shared<boost::log::sinks::unlocked_sink<Backend>>(
+            boost::make_shared<Backend>(std::move(stream), kCapacity, policy));
+        _sink->set_filter(
+            logv2::ComponentSettingsFilter(logv2::LogManager::global().getGlobalDomain(),
+                                           logv2::LogManager::global().getGlobalSettings()));
+        _sink->set_formatter(logv2::TextFormatter());
+        boost::log::core::get()->add_sink(_sink);
+    }
+
+    void tearDownAppender() {
+        boost::log::core::get()->remove_sink(_sink);
+        _sink->flush();
+        _sink.reset();
+        invariant(logv2::LogManager::global().getGlobalDomainInternal().configure({}).isOK());
+    }
+
+    benchmark::State& _state;
+    boost::shared_ptr<boost::log::sinks::unlocked_sink<Backend>> _sink;
+    long long _droppedBefore = 0;
+    long long _blockedBefore = 0;
+    bool _shouldInit;
+};
+
 // "Expensive" way to create a string.
 std::string createLongString() {
     return std::string(1000, 'a') + std::string(1000, 'b') + std::string(1000, 'c') +
@@ -150,17 +215,68 @@ void BM_EnabledLogV2ManySmallArg(benchmark::State& state) {
     }
 }
 
+void BM_EnabledLogV2JSONManyStrings(benchmark::State& state) {
+    ScopedLogV2Bench<logv2::JSONFormatter> init(state);
+
+    BSONObjBuilder builder;
+    for (int i = 0; i < 20; ++i) {
+        builder.append("field" + std::to_string(i),
+                       "a string of printable characters, with the \"occasional\" escape");
+    }
+    BSONObj obj = builder.obj();
+
+    for (auto _ : state)
+        LOGV2(5502134, "enabled log {obj}", "obj"_attr = obj, "str"_attr = createLongString());
+}
+
+template <logv2::AsyncOverflowPolicy policy>
+void BM_EnabledLogV2Async(benchmark::State& state) {
+    ScopedAsyncLogV2Bench<policy> init(state);
+
+    for (auto _ : state)
+        LOGV2(5591600, "enabled log");
+}
+
+template <logv2::AsyncOverflowPolicy policy>
+void BM_EnabledLogV2AsyncExpensiveArg(benchmark::State& state) {
+    ScopedAsyncLogV2Bench<policy> init(state);
+
+    for (auto _ : state)
+        LOGV2(5591601, "enabled log {}", "str"_attr = createLongString());
+}
+
 void ThreadCounts(benchmark::internal::Benchmark* b) {
     int tc[] = {1, 2, 4, 8};
     for (int t : tc)
         b->Threads(t);
 }
 
+// Many more threads than cores, as when connection threads log slow operations during an
+// incident.
+void ContendedThreadCounts(benchmark::internal::Benchmark* b) {
+    int tc[] = {1, 8, 32, 128};
+    for (int t : tc)
+        b->Threads(t);
+    b->UseRealTime();
+}
+
 BENCHMARK(BM_NoopLogV2)->Apply(ThreadCounts);
 BENCHMARK(BM_NoopLogV2Arg)->Apply(ThreadCounts);
 BENCHMARK(BM_EnabledLogV2)->Apply(ThreadCounts);
 BENCHMARK(BM_EnabledLogV2ExpensiveArg)->Apply(ThreadCounts);
 BENCHMARK(BM_EnabledLogV2ManySmallArg)->Apply(ThreadCounts);
+BENCHMARK(BM_EnabledLogV2JSONManyStrings)->Apply(ThreadCounts);
+
+BENCHMARK(BM_EnabledLogV2)->Apply(ContendedThreadCounts);
+BENCHMARK(BM_EnabledLogV2ExpensiveArg)->Apply(ContendedThreadCounts);
+BENCHMARK_TEMPLATE(BM_EnabledLogV2Async, logv2::AsyncOverflowPolicy::kBlock)
+    ->Apply(ContendedThreadCounts);
+BENCHMARK_TEMPLATE(BM_EnabledLogV2Async, logv2::AsyncOverflowPolicy::kDrop)
+    ->Apply(ContendedThreadCounts);
+BENCHMARK_TEMPLATE(BM_EnabledLogV2AsyncExpensiveArg, logv2::AsyncOverflowPolicy::kBlock)
+    ->Apply(ContendedThreadCounts);
+BENCHMARK_TEMPLATE(BM_EnabledLogV2AsyncExpensiveArg, logv2::AsyncOverflowPolicy::kDrop)
+    ->Apply(ContendedThreadCounts);
 
 }  // namespace
 }  // namespace mongo
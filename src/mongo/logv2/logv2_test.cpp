@@ -40,6 +40,7 @@
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/bson/json.h"
 #include "mongo/bson/oid.h"
+#include "mongo/logv2/async_backend.h"
 #include "mongo/logv2/bson_formatter.h"
 #include "mongo/logv2/component_settings_filter.h"
 #include "mongo/logv2/composite_backend.h"
@@ -1358,6 +1359,11 @@ TEST_F(LogV2Test, Unicode) {
         {"\xfc\xa1\xa1\xa1\xa1\xa1"_sd, "\ufffd\ufffd\ufffd\ufffd\ufffd\ufffd"_sd},
         // Invalid 3 Octet sequence, buffer ends prematurely, result is escaped
         {"\xe2\x82"_sd, "\ufffd\ufffd"_sd},
+        // Characters that need escaping within and after long runs of printable characters
+        {"abcdefgh\"ijklmnopq\\rstuvwxyzab\ncdefghij\u00f1klmnopqr\x7f"_sd,
+         "abcdefgh\"ijklmnopq\\rstuvwxyzab\ncdefghij\u00f1klmnopqr\x7f"_sd},
+        {"abcdefghijklmnop\xc3\x28qrstuvwxyzabcdef"_sd,
+         "abcdefghijklmnop\ufffd\x28qrstuvwxyzabcdef"_sd},
     };
 
     auto getLastMongo = [&]() {
@@ -1511,6 +1517,87 @@ TEST_F(LogV2Test, Threads) {
     ASSERT(linesJson.size() == threads.size() * kNumPerThread);
 }
 
+TEST_F(LogV2Test, AsyncThreads) {
+    std::vector<std::string> lines;
+    using Backend = AsyncBackend<LogCaptureBackend>;
+    auto sink = wrapInUnlockedSink(
+        boost::make_shared<Backend>(boost::make_shared<LogCaptureBackend>(lines), 64));
+    applyDefaultFilterToSink(sink);
+    sink->set_formatter(PlainFormatter());
+    attachSink(sink);
+
+    constexpr int kNumThreads = 4;
+    constexpr int kNumPerThread = 1000;
+    std::vector<stdx::thread> threads;
+    for (int t = 0; t < kNumThreads; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < kNumPerThread; ++i)
+                LOGV2(5591602, "{thread} {i}", "thread"_attr = t, "i"_attr = i);
+        });
+    }
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+
+    // Errors are written before the log call returns.
+    LOGV2_ERROR(5591603, "error");
+    ASSERT_EQUALS(lines.size(), size_t(kNumThreads * kNumPerThread + 1));
+    ASSERT_EQUALS(lines.back(), "error");
+
+    // The records of each thread are written in the order they were logged.
+    std::vector<int> next(kNumThreads, 0);
+    for (size_t i = 0; i < lines.size() - 1; ++i) {
+        std::istringstream line(lines[i]);
+        int thread, n;
+        line >> thread >> n;
+        ASSERT_EQUALS(next[thread]++, n);
+    }
+}
+
+TEST_F(LogV2Test, AsyncDropWhenFull) {
+    // Holds up the writer thread while the gate is locked.
+    class GatedCaptureBackend : public LogCaptureBackend {
+    public:
+        GatedCaptureBackend(std::vector<std::string>& lines, stdx::mutex& gate)
+            : LogCaptureBackend(lines), _gate(gate) {}
+
+        void consume(boost::log::record_view const& rec, string_type const& formatted_string) {
+            stdx::lock_guard lk(_gate);
+            LogCaptureBackend::consume(rec, formatted_string);
+        }
+
+    private:
+        stdx::mutex& _gate;  // NOLINT
+    };
+
+    std::vector<std::string> lines;
+    stdx::mutex gate;  // NOLINT
+    using Backend = AsyncBackend<GatedCaptureBackend>;
+    auto sink = wrapInUnlockedSink(
+        boost::make_shared<Backend>(boost::make_shared<GatedCaptureBackend>(lines, gate),
+                                    2,
+                                    AsyncOverflowPolicy::kDrop));
+    applyDefaultFilterToSink(sink);
+    sink->set_formatter(PlainFormatter());
+    attachSink(sink);
+
+    auto& stats = AsyncBackendStats::get();
+    const auto droppedBefore = stats.dropped.load();
+
+    constexpr int kNumLogs = 10;
+    {
+        stdx::unique_lock lk(gate);
+        for (int i = 0; i < kNumLogs; ++i)
+            LOGV2(5591604, "dropped if the queue is full");
+    }
+    sink->flush();
+
+    // At most the two records in the queue and the one held by the writer thread are written.
+    const auto dropped = stats.dropped.load() - droppedBefore;
+    ASSERT_GTE(dropped, kNumLogs - 3);
+    ASSERT_EQUALS(static_cast<long long>(lines.size()) + dropped, kNumLogs);
+}
+
 TEST_F(LogV2Test, Ramlog) {
     RamLog* ramlog = RamLog::get("test_ramlog");
     auto sink = wrapInUnlockedSink(boost::make_shared<RamLogSink>(ramlog));
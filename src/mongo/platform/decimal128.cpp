@@ -731,9 +731,69 @@ Decimal128 Decimal128::add(const Decimal128& other, RoundingMode roundMode) cons
     return add(other, &throwAwayFlag, roundMode);
 }
 
+bool Decimal128::_addWithSameExponent(const Decimal128& other,
+                                      RoundingMode roundMode,
+                                      Decimal128* result) const {
+    constexpr std::uint64_t kSignMask = std::uint64_t{1} << kSignFieldPos;
+    constexpr std::uint64_t kExponentMask = ~kSignMask & ~kCanonicalCoefficientHighFieldMask;
+    // The largest coefficient, 10^34 - 1, that can be represented exactly.
+    constexpr std::uint64_t kMaxCoefficientHigh = 0x1ed09bead87c0;
+    constexpr std::uint64_t kMaxCoefficientLow = 0x378d8e63ffffffff;
+    auto isRepresentable = [](std::uint64_t high, std::uint64_t low) {
+        return high < kMaxCoefficientHigh ||
+            (high == kMaxCoefficientHigh && low <= kMaxCoefficientLow);
+    };
+
+    // In the canonical encoding, the bits between the sign and the coefficient are the exponent.
+    if (_getCombinationField() >= kCombinationNonCanonical ||
+        other._getCombinationField() >= kCombinationNonCanonical ||
+        (_value.high64 & kExponentMask) != (other._value.high64 & kExponentMask)) {
+        return false;
+    }
+
+    std::uint64_t sign = _value.high64 & kSignMask;
+    std::uint64_t high = _value.high64 & kCanonicalCoefficientHighFieldMask;
+    std::uint64_t low = _value.low64;
+    std::uint64_t otherSign = other._value.high64 & kSignMask;
+    std::uint64_t otherHigh = other._value.high64 & kCanonicalCoefficientHighFieldMask;
+    std::uint64_t otherLow = other._value.low64;
+    if (!isRepresentable(high, low) || !isRepresentable(otherHigh, otherLow)) {
+        return false;
+    }
+
+    if (sign == otherSign) {
+        low += otherLow;
+        high += otherHigh + (low < otherLow ? 1 : 0);
+        if (!isRepresentable(high, low)) {
+            return false;
+        }
+    } else {
+        // Subtract the smaller magnitude from the larger, whose sign the difference takes.
+        if (high < otherHigh || (high == otherHigh && low < otherLow)) {
+            std::swap(high, otherHigh);
+            std::swap(low, otherLow);
+            sign = otherSign;
+        }
+        high -= otherHigh + (low < otherLow ? 1 : 0);
+        low -= otherLow;
+        if (high == 0 && low == 0) {
+            // An exact zero difference is negative only when rounding toward negative infinity.
+            sign = roundMode == kRoundTowardNegative ? kSignMask : 0;
+        }
+    }
+
+    *result = Decimal128(Value{low, sign | (_value.high64 & kExponentMask) | high});
+    return true;
+}
+
 Decimal128 Decimal128::add(const Decimal128& other,
                            std::uint32_t* signalingFlags,
                            RoundingMode roundMode) const {
+    Decimal128 sum;
+    if (_addWithSameExponent(other, roundMode, &sum)) {
+        return sum;
+    }
+
     BID_UINT128 current = decimal128ToLibraryType(_value);
     BID_UINT128 addend = decimal128ToLibraryType(other.getValue());
     current = bid128_add(current, addend, roundMode, signalingFlags);
@@ -750,6 +810,11 @@ Decimal128 Decimal128::subtract(const Decimal128& other, RoundingMode roundMode)
 Decimal128 Decimal128::subtract(const Decimal128& other,
                                 std::uint32_t* signalingFlags,
                                 RoundingMode roundMode) const {
+    Decimal128 difference;
+    if (_addWithSameExponent(other.negate(), roundMode, &difference)) {
+        return difference;
+    }
+
     BID_UINT128 current = decimal128ToLibraryType(_value);
     BID_UINT128 sub = decimal128ToLibraryType(other.getValue());
     current = bid128_sub(current, sub, roundMode, signalingFlags);
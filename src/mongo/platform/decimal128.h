@@ -559,6 +559,16 @@ private:
                                       std::uint32_t* signalingFlags,
                                       RoundingMode roundMode = kRoundTiesToEven) const;
 
+    /**
+     * Computes this + 'other' without calling into the decimal library when both are finite
+     * numbers with the same exponent and the sum of their coefficients needs no rounding, which
+     * is the common case when summing amounts of the same scale. The result is then exact, and
+     * is stored in 'result'. Returns false, leaving 'result' unchanged, in all other cases.
+     */
+    bool _addWithSameExponent(const Decimal128& other,
+                              RoundingMode roundMode,
+                              Decimal128* result) const;
+
     constexpr std::uint64_t _getCombinationField() const {
         return (_value.high64 >> kCombinationFieldPos) & kCombinationFieldMask;
     }
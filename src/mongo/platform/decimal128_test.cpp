@@ -1056,6 +1056,34 @@ TEST(Decimal128Test, TestDecimal128SubtractionCase2) {
     ASSERT_EQUALS(result.getValue().high64, expected.getValue().high64);
 }
 
+TEST(Decimal128Test, TestDecimal128AdditionSameExponent) {
+    ASSERT_TRUE(Decimal128("1.25").add(Decimal128("3.50")).isBinaryEqual(Decimal128("4.75")));
+    ASSERT_TRUE(Decimal128("1.25").add(Decimal128("-3.50")).isBinaryEqual(Decimal128("-2.25")));
+    ASSERT_TRUE(
+        Decimal128("-1.25").subtract(Decimal128("-3.50")).isBinaryEqual(Decimal128("2.25")));
+
+    // The sum of the coefficients carries out of their low 64 bits.
+    ASSERT_TRUE(Decimal128("18446744073709551615")
+                    .add(Decimal128("18446744073709551615"))
+                    .isBinaryEqual(Decimal128("36893488147419103230")));
+
+    // A sum with more than 34 digits is rounded.
+    uint32_t sigFlags = Decimal128::SignalingFlag::kNoFlag;
+    Decimal128 result =
+        Decimal128("9999999999999999999999999999999999").add(Decimal128("3"), &sigFlags);
+    ASSERT_TRUE(result.isBinaryEqual(Decimal128("1.000000000000000000000000000000000E+34")));
+    ASSERT_TRUE(Decimal128::hasFlag(sigFlags, Decimal128::SignalingFlag::kInexact));
+}
+
+TEST(Decimal128Test, TestDecimal128AdditionSameExponentZeroSign) {
+    ASSERT_TRUE(Decimal128("1.50").add(Decimal128("-1.50")).isBinaryEqual(Decimal128("0.00")));
+    ASSERT_TRUE(Decimal128("1.50")
+                    .add(Decimal128("-1.50"), Decimal128::kRoundTowardNegative)
+                    .isBinaryEqual(Decimal128("-0.00")));
+    ASSERT_TRUE(Decimal128("-0.00").add(Decimal128("-0.00")).isBinaryEqual(Decimal128("-0.00")));
+    ASSERT_TRUE(Decimal128("-0.00").add(Decimal128("0.00")).isBinaryEqual(Decimal128("0.00")));
+}
+
 TEST(Decimal128Test, TestDecimal128MultiplicationCase1) {
     Decimal128 d1("25.05E20");
     Decimal128 d2("-50.5218E19");
@@ -29,11 +29,44 @@
 
 #include "mongo/platform/mutex.h"
 
+#include <chrono>
+
 #include "mongo/base/init.h"
 #include "mongo/bson/bsonobjbuilder.h"
 
 namespace mongo::latch_detail {
 
+AtomicWord<int> gLatchAnalysisSampleInterval{0};
+
+namespace {
+
+/**
+ * Decide whether this thread should time its current acquisition, counting down from
+ * gLatchAnalysisSampleInterval so that sampling costs a thread-local decrement while enabled.
+ */
+bool shouldSampleAcquisition() noexcept {
+    auto interval = gLatchAnalysisSampleInterval.loadRelaxed();
+    if (MONGO_likely(interval <= 0)) {
+        return false;
+    }
+
+    thread_local int countdown = 0;
+    if (--countdown > 0) {
+        return false;
+    }
+
+    countdown = interval;
+    return true;
+}
+
+long long nowNanos() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+}  // namespace
+
 void Identity::serialize(BSONObjBuilder* bob) const {
     bob->append("name"_sd, name());
 
@@ -64,29 +97,44 @@ Mutex::~Mutex() {
 }
 
 void Mutex::lock() {
+    const bool sampled = shouldSampleAcquisition();
     if (_mutex.try_lock()) {
         _isLocked = true;
+        if (MONGO_unlikely(sampled)) {
+            _onSampledLock(false, 0);
+        }
         _onQuickLock();
         return;
     }
 
     _onContendedLock();
+    const auto waitStartNanos = sampled ? nowNanos() : 0;
     _mutex.lock();
     _isLocked = true;
+    if (MONGO_unlikely(sampled)) {
+        _onSampledLock(true, nowNanos() - waitStartNanos);
+    }
     _onSlowLock();
 }
 
 void Mutex::unlock() {
     _onUnlock();
+    if (MONGO_unlikely(_sampledLockStartNanos)) {
+        _onSampledUnlock();
+    }
     _isLocked = false;
     _mutex.unlock();
 }
 bool Mutex::try_lock() {
+    const bool sampled = shouldSampleAcquisition();
     if (!_mutex.try_lock()) {
         return false;
     }
 
     _isLocked = true;
+    if (MONGO_unlikely(sampled)) {
+        _onSampledLock(false, 0);
+    }
     _onQuickLock();
     return true;
 }
@@ -147,6 +195,23 @@ void Mutex::_onUnlock() noexcept {
     }
 }
 
+void Mutex::_onSampledLock(bool contended, long long waitNanos) noexcept {
+    auto& counts = _data->counts();
+    counts.sampled.fetchAndAddRelaxed(1);
+    if (contended) {
+        counts.sampledContended.fetchAndAddRelaxed(1);
+        counts.sampledWaitNanos.fetchAndAddRelaxed(waitNanos);
+    }
+
+    // Hold time starts once we own _mutex, so it includes the time spent in listeners.
+    _sampledLockStartNanos = nowNanos();
+}
+
+void Mutex::_onSampledUnlock() noexcept {
+    _data->counts().sampledHoldNanos.fetchAndAddRelaxed(nowNanos() - _sampledLockStartNanos);
+    _sampledLockStartNanos = 0;
+}
+
 /**
  * Any MONGO_INITIALIZER that adds a DiagnosticListener will want to list
  * FinalizeDiagnosticListeners as a dependent initializer. This means that all DiagnosticListeners
@@ -207,6 +207,12 @@ void installDiagnosticListener() {
     invariant(!state.isFinalized.load());
 }
 
+/**
+ * Every thread times one out of this many of its Mutex acquisitions, recording how long it waited
+ * for the Mutex and how long it held it. A value of 0 disables sampling.
+ */
+extern AtomicWord<int> gLatchAnalysisSampleInterval;
+
 /**
  * This class holds working data for a latchable resource
  *
@@ -238,6 +244,12 @@ private:
         AtomicWord<int> contended{0};
         AtomicWord<int> acquired{0};
         AtomicWord<int> released{0};
+
+        // Timing for the acquisitions chosen by latchAnalysisSampleInterval.
+        AtomicWord<long long> sampled{0};
+        AtomicWord<long long> sampledContended{0};
+        AtomicWord<long long> sampledWaitNanos{0};
+        AtomicWord<long long> sampledHoldNanos{0};
     };
 
     Counts _counts;
@@ -352,11 +364,16 @@ private:
     void _onQuickLock() noexcept;
     void _onSlowLock() noexcept;
     void _onUnlock() noexcept;
+    void _onSampledLock(bool contended, long long waitNanos) noexcept;
+    void _onSampledUnlock() noexcept;
 
     const std::shared_ptr<Data> _data;
 
     stdx::mutex _mutex;  // NOLINT
     bool _isLocked = false;
+
+    // Set by whichever thread holds _mutex if it sampled that acquisition, otherwise zero.
+    long long _sampledLockStartNanos = 0;
 };
 }  // namespace latch_detail
 
@@ -54,7 +54,9 @@ private:
 class OpMsgReplyBuilder final : public rpc::ReplyBuilderInterface {
 public:
     ReplyBuilderInterface& setRawCommandReply(const BSONObj& reply) override {
-        _builder.beginBody().appendElements(reply);
+        auto bodyBuilder = _builder.beginBody();
+        bodyBuilder.reserveCapacity(reply.objsize());
+        bodyBuilder.appendElements(reply);
         return *this;
     }
     BSONObjBuilder getBodyBuilder() override {
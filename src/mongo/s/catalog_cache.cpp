@@ -351,6 +351,27 @@ void CatalogCache::invalidateShardOrEntireCollectionEntryForShardedCollection(
     }
 }
 
+bool CatalogCache::onRoutingTableChanged(const NamespaceString& nss) {
+    auto collectionEntry = _collectionCache.peekLatestCached(nss);
+    if (!collectionEntry || !collectionEntry->optRt) {
+        return false;
+    }
+
+    if (!_collectionCache.advanceTimeInStore(
+            nss, ComparableChunkVersion::makeComparableChunkVersionForForcedRefresh())) {
+        return false;
+    }
+
+    _stats.countRoutingTableChangeRefreshes.addAndFetch(1);
+
+    // The lookup runs on the cache's executor regardless of whether anyone waits for it and, since
+    // there is a cached entry, only fetches the chunks which changed since its version. Its result
+    // is installed in the cache, so there is nothing left to do with it here.
+    (void)_collectionCache.acquireAsync(nss, CacheCausalConsistency::kLatestKnown);
+
+    return true;
+}
+
 void CatalogCache::checkEpochOrThrow(const NamespaceString& nss,
                                      const ChunkVersion& targetCollectionVersion,
                                      const ShardId& shardId) {
@@ -481,6 +502,8 @@ void CatalogCache::Stats::report(BSONObjBuilder* builder) const {
 
     builder->append("totalRefreshWaitTimeMicros", totalRefreshWaitTimeMicros.load());
 
+    builder->append("countRoutingTableChangeRefreshes", countRoutingTableChangeRefreshes.load());
+
     if (isMongos()) {
         BSONObjBuilder operationsBlockedByRefreshBuilder(
             builder->subobjStart("operationsBlockedByRefresh"));
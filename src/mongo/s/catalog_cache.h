@@ -184,6 +184,15 @@ public:
                            const ChunkVersion& targetCollectionVersion,
                            const ShardId& shardId);
 
+    /**
+     * Non-blocking method, which is called when the routing table of 'nss' is known to have
+     * changed on the config server. If a routing table for 'nss' is cached, marks it as needing an
+     * incremental refresh and starts that refresh in the background, so that it is usually done
+     * before any shard rejects a request with the old version. Returns whether a refresh was
+     * started.
+     */
+    bool onRoutingTableChanged(const NamespaceString& nss);
+
     /**
      * Non-blocking method, which invalidates all namespaces which contain data on the specified
      * shard and all databases which have the shard listed as their primary shard.
@@ -317,6 +326,10 @@ private:
         // combined
         AtomicWord<long long> totalRefreshWaitTimeMicros{0};
 
+        // Counts how many refreshes were started ahead of time because a routing table was known
+        // to have changed on the config server
+        AtomicWord<long long> countRoutingTableChangeRefreshes{0};
+
         // Cumulative, always-increasing counter of how many operations have been blocked by a
         // catalog cache refresh. Broken down by operation type to match the operations tracked
         // by the OpCounters class.
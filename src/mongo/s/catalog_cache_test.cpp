@@ -273,6 +273,34 @@ TEST_F(CatalogCacheTest, OnStaleShardVersionWithGraterVersion) {
     ASSERT(status == ErrorCodes::InternalError);
 }
 
+TEST_F(CatalogCacheTest, OnRoutingTableChangedIgnoresUncachedCollections) {
+    const auto dbVersion = DatabaseVersion(UUID::gen());
+
+    loadDatabases({DatabaseType(kNss.db().toString(), kShards[0], true, dbVersion)});
+    ASSERT_FALSE(_catalogCache->onRoutingTableChanged(kNss));
+
+    loadUnshardedCollection(kNss);
+    ASSERT_FALSE(_catalogCache->onRoutingTableChanged(kNss));
+}
+
+TEST_F(CatalogCacheTest, OnRoutingTableChangedRefreshesCachedCollection) {
+    const auto dbVersion = DatabaseVersion(UUID::gen());
+    const auto cachedCollVersion = ChunkVersion(1, 0, OID::gen(), boost::none /* timestamp */);
+    const auto newCollVersion =
+        ChunkVersion(2, 0, cachedCollVersion.epoch(), cachedCollVersion.getTimestamp());
+
+    loadDatabases({DatabaseType(kNss.db().toString(), kShards[0], true, dbVersion)});
+    loadCollection(cachedCollVersion);
+
+    const auto scopedCollProv = scopedCollectionProvider(makeCollectionType(newCollVersion));
+    const auto scopedChunksProv = scopedChunksProvider(makeChunks(newCollVersion));
+    ASSERT_TRUE(_catalogCache->onRoutingTableChanged(kNss));
+
+    const auto swChunkManager = _catalogCache->getCollectionRoutingInfo(operationContext(), kNss);
+    ASSERT_OK(swChunkManager.getStatus());
+    ASSERT_EQ(newCollVersion, swChunkManager.getValue().getVersion());
+}
+
 TEST_F(CatalogCacheTest, CheckEpochNoDatabase) {
     const auto collVersion = ChunkVersion(1, 0, OID::gen(), boost::none /* timestamp */);
     ASSERT_THROWS_WITH_CHECK(_catalogCache->checkEpochOrThrow(kNss, collVersion, kShards[0]),
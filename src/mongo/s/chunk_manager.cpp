@@ -113,96 +113,165 @@ std::vector<std::shared_ptr<ChunkInfo>> flatten(const std::vector<ChunkType>& ch
 
 }  // namespace
 
-ShardVersionMap ChunkMap::constructShardVersionMap() const {
-    ShardVersionMap shardVersions;
-    ChunkVector::const_iterator current = _chunkMap.cbegin();
-
-    boost::optional<BSONObj> firstMin = boost::none;
-    boost::optional<BSONObj> lastMax = boost::none;
-
-    while (current != _chunkMap.cend()) {
-        const auto& firstChunkInRange = *current;
-        const auto& currentRangeShardId = firstChunkInRange->getShardIdAt(boost::none);
-
-        // Tracks the max shard version for the shard on which the current range will reside
-        auto shardVersionIt = shardVersions.find(currentRangeShardId);
-        if (shardVersionIt == shardVersions.end()) {
-            shardVersionIt = shardVersions
-                                 .emplace(std::piecewise_construct,
-                                          std::forward_as_tuple(currentRangeShardId),
-                                          std::forward_as_tuple(_collectionVersion.epoch(),
-                                                                _collectionVersion.getTimestamp()))
-                                 .first;
-        }
+void ChunkMap::ChunkBlock::append(const std::shared_ptr<ChunkInfo>& chunk) {
+    const auto& shardId = chunk->getShardIdAt(boost::none);
+
+    if (!chunks.empty() && !firstDiscontinuity) {
+        const auto& prev = chunks.back();
+        if (prev->getShardIdAt(boost::none) != shardId &&
+            !SimpleBSONObjComparator::kInstance.evaluate(prev->getMax() == chunk->getMin()))
+            firstDiscontinuity = chunks.size();
+    }
 
-        auto& maxShardVersion = shardVersionIt->second.shardVersion;
+    auto shardVersionIt = shardVersions.find(shardId);
+    if (shardVersionIt == shardVersions.end()) {
+        shardVersions.emplace(shardId, chunk->getLastmod());
+    } else if (shardVersionIt->second.isOlderThan(chunk->getLastmod())) {
+        shardVersionIt->second = chunk->getLastmod();
+    }
 
-        current =
-            std::find_if(current,
-                         _chunkMap.cend(),
-                         [&currentRangeShardId, &maxShardVersion](const auto& currentChunk) {
-                             if (currentChunk->getShardIdAt(boost::none) != currentRangeShardId)
-                                 return true;
+    chunks.push_back(chunk);
+}
 
-                             if (maxShardVersion.isOlderThan(currentChunk->getLastmod()))
-                                 maxShardVersion = currentChunk->getLastmod();
+void ChunkMap::ChunkBlock::replaceLast(const std::shared_ptr<ChunkInfo>& chunk) {
+    // The replaced chunk may have been the one which set its shard's version, so rebuild the
+    // summary from the remaining chunks.
+    ChunkVector remaining(std::move(chunks));
+    remaining.back() = chunk;
 
-                             return false;
-                         });
+    *this = ChunkBlock();
+    chunks.reserve(remaining.size());
+    for (const auto& remainingChunk : remaining) {
+        append(remainingChunk);
+    }
+}
 
-        const auto rangeLast = *std::prev(current);
+ShardVersionMap ChunkMap::constructShardVersionMap() const {
+    ShardVersionMap shardVersions;
 
-        const auto& rangeMin = firstChunkInRange->getMin();
-        const auto& rangeMax = rangeLast->getMax();
+    // Check the continuity of the chunks map where it moves from one shard to another
+    const auto checkContinuity = [](const ChunkInfo& prev, const ChunkInfo& next) {
+        const auto& lastMax = prev.getMax();
+        const auto& rangeMin = next.getMin();
+        if (SimpleBSONObjComparator::kInstance.evaluate(lastMax == rangeMin))
+            return;
 
-        // Check the continuity of the chunks map
-        if (lastMax && !SimpleBSONObjComparator::kInstance.evaluate(*lastMax == rangeMin)) {
-            if (SimpleBSONObjComparator::kInstance.evaluate(*lastMax < rangeMin))
-                uasserted(ErrorCodes::ConflictingOperationInProgress,
-                          str::stream() << "Gap exists in the routing table between chunks "
-                                        << findIntersectingChunk(*lastMax)->getRange().toString()
-                                        << " and " << rangeLast->getRange().toString());
-            else
-                uasserted(ErrorCodes::ConflictingOperationInProgress,
-                          str::stream() << "Overlap exists in the routing table between chunks "
-                                        << findIntersectingChunk(*lastMax)->getRange().toString()
-                                        << " and " << rangeLast->getRange().toString());
+        if (SimpleBSONObjComparator::kInstance.evaluate(lastMax < rangeMin))
+            uasserted(ErrorCodes::ConflictingOperationInProgress,
+                      str::stream() << "Gap exists in the routing table between chunks "
+                                    << prev.getRange().toString() << " and "
+                                    << next.getRange().toString());
+        else
+            uasserted(ErrorCodes::ConflictingOperationInProgress,
+                      str::stream() << "Overlap exists in the routing table between chunks "
+                                    << prev.getRange().toString() << " and "
+                                    << next.getRange().toString());
+    };
+
+    const ChunkInfo* lastChunk = nullptr;
+    for (const auto& block : _blocks) {
+        const auto& firstChunk = *block->chunks.front();
+        if (lastChunk &&
+            lastChunk->getShardIdAt(boost::none) != firstChunk.getShardIdAt(boost::none))
+            checkContinuity(*lastChunk, firstChunk);
+
+        if (block->firstDiscontinuity) {
+            const auto i = *block->firstDiscontinuity;
+            checkContinuity(*block->chunks[i - 1], *block->chunks[i]);
         }
 
-        if (!firstMin)
-            firstMin = rangeMin;
+        // Tracks the max shard version for each shard with chunks in the block
+        for (const auto& [shardId, blockShardVersion] : block->shardVersions) {
+            auto shardVersionIt = shardVersions.find(shardId);
+            if (shardVersionIt == shardVersions.end()) {
+                shardVersionIt = shardVersions
+                                     .emplace(std::piecewise_construct,
+                                              std::forward_as_tuple(shardId),
+                                              std::forward_as_tuple(
+                                                  _collectionVersion.epoch(),
+                                                  _collectionVersion.getTimestamp()))
+                                     .first;
+            }
+
+            auto& maxShardVersion = shardVersionIt->second.shardVersion;
+            if (maxShardVersion.isOlderThan(blockShardVersion))
+                maxShardVersion = blockShardVersion;
+        }
 
-        lastMax = rangeMax;
+        lastChunk = block->chunks.back().get();
+    }
 
-        // If a shard has chunks it must have a shard version, otherwise we have an invalid chunk
-        // somewhere, which should have been caught at chunk load time
-        invariant(maxShardVersion.isSet());
+    // If a shard has chunks it must have a shard version, otherwise we have an invalid chunk
+    // somewhere, which should have been caught at chunk load time
+    for (const auto& [shardId, targetingInfo] : shardVersions) {
+        invariant(targetingInfo.shardVersion.isSet());
     }
 
-    if (!_chunkMap.empty()) {
+    if (!_blocks.empty()) {
         invariant(!shardVersions.empty());
-        invariant(firstMin.is_initialized());
-        invariant(lastMax.is_initialized());
 
-        checkAllElementsAreOfType(MinKey, firstMin.get());
-        checkAllElementsAreOfType(MaxKey, lastMax.get());
+        checkAllElementsAreOfType(MinKey, _blocks.front()->chunks.front()->getMin());
+        checkAllElementsAreOfType(MaxKey, _blocks.back()->chunks.back()->getMax());
     }
 
     return shardVersions;
 }
 
+ChunkMap::ChunkBlock* ChunkMap::_mutableLastBlock() {
+    auto& lastBlock = _blocks.back();
+    if (lastBlock.use_count() > 1)
+        lastBlock = std::make_shared<ChunkBlock>(*lastBlock);
+
+    return lastBlock.get();
+}
+
 void ChunkMap::appendChunk(const std::shared_ptr<ChunkInfo>& chunk) {
-    appendChunkTo(_chunkMap, chunk);
+    if (!_blocks.empty() && chunk->getRange().overlaps(_blocks.back()->chunks.back()->getRange())) {
+        if (_blocks.back()->chunks.back()->getLastmod().isOlderThan(chunk->getLastmod()))
+            _mutableLastBlock()->replaceLast(chunk);
+    } else {
+        // Only start a new block when the last one is full, or is shared and so would have to be
+        // copied to be appended to.
+        if (_blocks.empty() || _blocks.back()->chunks.size() >= kMaxChunksPerBlock ||
+            _blocks.back().use_count() > 1) {
+            _blocks.push_back(std::make_shared<ChunkBlock>());
+            _blocks.back()->chunks.reserve(kMaxChunksPerBlock);
+        }
+
+        _blocks.back()->append(chunk);
+        ++_size;
+    }
 
     if (_collectionVersion.isOlderThan(chunk->getLastmod()))
         _collectionVersion = chunk->getLastmod();
 }
 
+void ChunkMap::_appendBlock(const std::shared_ptr<ChunkBlock>& block) {
+    if (!_blocks.empty() &&
+        _blocks.back()->chunks.size() + block->chunks.size() <= kMaxChunksPerBlock) {
+        // Copying a few chunks keeps the number of blocks proportional to the number of chunks,
+        // however many refreshes have split them up.
+        auto lastBlock = _mutableLastBlock();
+        for (const auto& chunk : block->chunks) {
+            lastBlock->append(chunk);
+        }
+    } else {
+        _blocks.push_back(block);
+    }
+
+    _size += block->chunks.size();
+
+    for (const auto& [shardId, blockShardVersion] : block->shardVersions) {
+        if (_collectionVersion.isOlderThan(blockShardVersion))
+            _collectionVersion = blockShardVersion;
+    }
+}
+
 std::shared_ptr<ChunkInfo> ChunkMap::findIntersectingChunk(const BSONObj& shardKey) const {
     const auto it = _findIntersectingChunk(shardKey);
 
-    if (it != _chunkMap.end())
-        return *it;
+    if (it != _end())
+        return _at(it);
 
     return std::shared_ptr<ChunkInfo>();
 }
@@ -218,41 +287,58 @@ void validateChunk(const std::shared_ptr<ChunkInfo>& chunk, const ChunkVersion&
 
 ChunkMap ChunkMap::createMerged(
     const std::vector<std::shared_ptr<ChunkInfo>>& changedChunks) const {
-    size_t chunkMapIndex = 0;
     size_t changedChunkIndex = 0;
 
     ChunkMap updatedChunkMap(
-        getVersion().epoch(), getVersion().getTimestamp(), _chunkMap.size() + changedChunks.size());
-
-    while (chunkMapIndex < _chunkMap.size() || changedChunkIndex < changedChunks.size()) {
-        if (chunkMapIndex >= _chunkMap.size()) {
-            validateChunk(changedChunks[changedChunkIndex], getVersion());
-            updatedChunkMap.appendChunk(changedChunks[changedChunkIndex++]);
+        getVersion().epoch(), getVersion().getTimestamp(), _size + changedChunks.size());
+
+    for (const auto& block : _blocks) {
+        const auto& blockChunks = block->chunks;
+
+        // A block which neither the next changed chunk nor the last chunk merged so far overlaps
+        // would be copied over unchanged, so share it instead.
+        const bool changedChunkOverlapsBlock = changedChunkIndex < changedChunks.size() &&
+            changedChunks[changedChunkIndex]->getMin().woCompare(blockChunks.back()->getMax()) <
+                0 &&
+            changedChunks[changedChunkIndex]->getMax().woCompare(blockChunks.front()->getMin()) > 0;
+        const bool lastChunkOverlapsBlock = !updatedChunkMap._blocks.empty() &&
+            updatedChunkMap._blocks.back()->chunks.back()->getRange().overlaps(
+                blockChunks.front()->getRange());
+        if (!changedChunkOverlapsBlock && !lastChunkOverlapsBlock) {
+            updatedChunkMap._appendBlock(block);
             continue;
         }
 
-        if (changedChunkIndex >= changedChunks.size()) {
-            updatedChunkMap.appendChunk(_chunkMap[chunkMapIndex++]);
-            continue;
-        }
+        size_t chunkIndex = 0;
+        while (chunkIndex < blockChunks.size()) {
+            if (changedChunkIndex >= changedChunks.size()) {
+                updatedChunkMap.appendChunk(blockChunks[chunkIndex++]);
+                continue;
+            }
 
-        auto overlap = _chunkMap[chunkMapIndex]->getRange().overlaps(
-            changedChunks[changedChunkIndex]->getRange());
+            auto overlap = blockChunks[chunkIndex]->getRange().overlaps(
+                changedChunks[changedChunkIndex]->getRange());
 
-        if (overlap) {
-            auto& changedChunk = changedChunks[changedChunkIndex++];
-            auto& chunkInfo = _chunkMap[chunkMapIndex];
+            if (overlap) {
+                auto& changedChunk = changedChunks[changedChunkIndex++];
+                auto& chunkInfo = blockChunks[chunkIndex];
 
-            auto bytesInReplacedChunk = chunkInfo->getWritesTracker()->getBytesWritten();
-            changedChunk->getWritesTracker()->addBytesWritten(bytesInReplacedChunk);
+                auto bytesInReplacedChunk = chunkInfo->getWritesTracker()->getBytesWritten();
+                changedChunk->getWritesTracker()->addBytesWritten(bytesInReplacedChunk);
 
-            validateChunk(changedChunk, getVersion());
-            updatedChunkMap.appendChunk(changedChunk);
-        } else {
-            updatedChunkMap.appendChunk(_chunkMap[chunkMapIndex++]);
+                validateChunk(changedChunk, getVersion());
+                updatedChunkMap.appendChunk(changedChunk);
+            } else {
+                updatedChunkMap.appendChunk(blockChunks[chunkIndex++]);
+            }
         }
     }
 
+    while (changedChunkIndex < changedChunks.size()) {
+        validateChunk(changedChunks[changedChunkIndex], getVersion());
+        updatedChunkMap.appendChunk(changedChunks[changedChunkIndex++]);
+    }
+
     return updatedChunkMap;
 }
 
@@ -260,45 +346,80 @@ BSONObj ChunkMap::toBSON() const {
     BSONObjBuilder builder;
 
     builder.append("startingVersion"_sd, getVersion().toBSON());
-    builder.append("chunkCount", static_cast<int64_t>(_chunkMap.size()));
+    builder.append("chunkCount", static_cast<int64_t>(_size));
 
     {
         BSONArrayBuilder arrayBuilder(builder.subarrayStart("chunks"_sd));
-        for (const auto& chunk : _chunkMap) {
+        forEach([&](const auto& chunk) {
             arrayBuilder.append(chunk->toString());
-        }
+            return true;
+        });
     }
 
     return builder.obj();
 }
 
-ChunkMap::ChunkVector::const_iterator ChunkMap::_findIntersectingChunk(const BSONObj& shardKey,
-                                                                       bool isMaxInclusive) const {
-    auto shardKeyString = ShardKeyPattern::toKeyString(shardKey);
+std::shared_ptr<ChunkInfo> ChunkMap::findIntersectingChunkByKeyString(
+    const std::string& shardKeyString) const {
+    const auto it = _findIntersectingChunkByKeyString(shardKeyString);
+    return it != _end() ? _at(it) : std::shared_ptr<ChunkInfo>();
+}
 
+ChunkMap::Position ChunkMap::_findIntersectingChunkByKeyString(const std::string& shardKeyString,
+                                                               bool isMaxInclusive) const {
+    // Find the first block, and then the first chunk in it, whose max is greater than (or, if the
+    // max is not inclusive, at least) the shard key.
     if (!isMaxInclusive) {
-        return std::lower_bound(_chunkMap.begin(),
-                                _chunkMap.end(),
-                                shardKey,
-                                [&shardKeyString](const auto& chunkInfo, const BSONObj& shardKey) {
-                                    return chunkInfo->getMaxKeyString() < shardKeyString;
-                                });
+        const auto blockIt = std::lower_bound(
+            _blocks.begin(),
+            _blocks.end(),
+            shardKeyString,
+            [](const auto& block, const std::string& shardKeyString) {
+                return block->chunks.back()->getMaxKeyString() < shardKeyString;
+            });
+        if (blockIt == _blocks.end())
+            return _end();
+
+        const auto& chunks = (*blockIt)->chunks;
+        const auto chunkIt = std::lower_bound(
+            chunks.begin(),
+            chunks.end(),
+            shardKeyString,
+            [](const auto& chunkInfo, const std::string& shardKeyString) {
+                return chunkInfo->getMaxKeyString() < shardKeyString;
+            });
+        return {std::distance(_blocks.begin(), blockIt), std::distance(chunks.begin(), chunkIt)};
     } else {
-        return std::upper_bound(_chunkMap.begin(),
-                                _chunkMap.end(),
-                                shardKey,
-                                [&shardKeyString](const BSONObj& shardKey, const auto& chunkInfo) {
-                                    return shardKeyString < chunkInfo->getMaxKeyString();
-                                });
+        const auto blockIt = std::upper_bound(
+            _blocks.begin(),
+            _blocks.end(),
+            shardKeyString,
+            [](const std::string& shardKeyString, const auto& block) {
+                return shardKeyString < block->chunks.back()->getMaxKeyString();
+            });
+        if (blockIt == _blocks.end())
+            return _end();
+
+        const auto& chunks = (*blockIt)->chunks;
+        const auto chunkIt = std::upper_bound(
+            chunks.begin(),
+            chunks.end(),
+            shardKeyString,
+            [](const std::string& shardKeyString, const auto& chunkInfo) {
+                return shardKeyString < chunkInfo->getMaxKeyString();
+            });
+        return {std::distance(_blocks.begin(), blockIt), std::distance(chunks.begin(), chunkIt)};
     }
 }
 
-std::pair<ChunkMap::ChunkVector::const_iterator, ChunkMap::ChunkVector::const_iterator>
-ChunkMap::_overlappingBounds(const BSONObj& min, const BSONObj& max, bool isMaxInclusive) const {
+std::pair<ChunkMap::Position, ChunkMap::Position> ChunkMap::_overlappingBounds(
+    const BSONObj& min, const BSONObj& max, bool isMaxInclusive) const {
     const auto itMin = _findIntersectingChunk(min);
     const auto itMax = [&]() {
         auto it = _findIntersectingChunk(max, isMaxInclusive);
-        return it == _chunkMap.end() ? it : ++it;
+        if (it != _end())
+            _advance(&it);
+        return it;
     }();
 
     return {itMin, itMax};
@@ -367,6 +488,17 @@ Chunk ChunkManager::findIntersectingChunk(const BSONObj& shardKey, const BSONObj
     return Chunk(*chunkInfo, _clusterTime);
 }
 
+boost::optional<Chunk> ChunkManager::findIntersectingChunkByKeyString(
+    const std::string& shardKeyString) const {
+    // The chunks cover the key space without gaps, as keyBelongsToShard also relies on, so the
+    // first chunk whose max sorts after a complete shard key contains it.
+    auto chunkInfo = _rt->optRt->findIntersectingChunkByKeyString(shardKeyString);
+    if (!chunkInfo) {
+        return boost::none;
+    }
+    return Chunk(*chunkInfo, _clusterTime);
+}
+
 bool ChunkManager::keyBelongsToShard(const BSONObj& shardKey, const ShardId& shardId) const {
     if (shardKey.isEmpty())
         return false;
@@ -502,6 +634,24 @@ bool ChunkManager::rangeOverlapsShard(const ChunkRange& range, const ShardId& sh
     return overlapFound;
 }
 
+bool ChunkManager::rangeBelongsToShard(const BSONObj& min,
+                                       const BSONObj& max,
+                                       bool isMaxInclusive,
+                                       const ShardId& shardId) const {
+    bool belongs = true;
+
+    _rt->optRt->forEachOverlappingChunk(min, max, isMaxInclusive, [&](auto& chunkInfo) {
+        if (chunkInfo->getShardIdAt(_clusterTime) != shardId) {
+            belongs = false;
+            return false;
+        }
+
+        return true;
+    });
+
+    return belongs;
+}
+
 boost::optional<Chunk> ChunkManager::getNextChunkOnShard(const BSONObj& shardKey,
                                                          const ShardId& shardId) const {
     boost::optional<Chunk> chunk;
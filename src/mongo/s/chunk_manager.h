@@ -75,16 +75,50 @@ class ChunkMap {
     // Vector of chunks ordered by max key.
     using ChunkVector = std::vector<std::shared_ptr<ChunkInfo>>;
 
+    // A run of consecutive chunks, ordered by max key, along with what constructShardVersionMap()
+    // needs to know about them. A ChunkMap never modifies a block that another ChunkMap shares, so
+    // createMerged() reuses every block that the changed chunks do not touch and a routing table
+    // refresh copies the touched blocks rather than every chunk in the collection.
+    struct ChunkBlock {
+        void append(const std::shared_ptr<ChunkInfo>& chunk);
+        void replaceLast(const std::shared_ptr<ChunkInfo>& chunk);
+
+        ChunkVector chunks;
+
+        // Max version of the chunks in this block on each shard.
+        stdx::unordered_map<ShardId, ChunkVersion, ShardId::Hasher> shardVersions;
+
+        // Index of the first chunk whose min does not match the max of the chunk before it, when
+        // the two are on different shards.
+        boost::optional<size_t> firstDiscontinuity;
+    };
+
+    using BlockVector = std::vector<std::shared_ptr<ChunkBlock>>;
+
+    // Index of a block in '_blocks' and of a chunk in that block. Blocks are never empty, so the
+    // position past the last chunk is {_blocks.size(), 0}.
+    using Position = std::pair<size_t, size_t>;
+
 public:
+    // Adjacent blocks are combined while they hold no more than this many chunks between them.
+    static constexpr size_t kMaxChunksPerBlock = 1024;
+
     explicit ChunkMap(OID epoch,
                       const boost::optional<Timestamp>& timestamp,
                       size_t initialCapacity = 0)
         : _collectionVersion(0, 0, epoch, timestamp) {
-        _chunkMap.reserve(initialCapacity);
+        _blocks.reserve(initialCapacity / kMaxChunksPerBlock + 1);
     }
 
     size_t size() const {
-        return _chunkMap.size();
+        return _size;
+    }
+
+    /**
+     * Returns the number of blocks the chunks are stored in. Exposed for testing.
+     */
+    size_t numBlocks() const {
+        return _blocks.size();
     }
 
     ChunkVersion getVersion() const {
@@ -93,10 +127,10 @@ public:
 
     template <typename Callable>
     void forEach(Callable&& handler, const BSONObj& shardKey = BSONObj()) const {
-        auto it = shardKey.isEmpty() ? _chunkMap.begin() : _findIntersectingChunk(shardKey);
+        auto it = shardKey.isEmpty() ? Position(0, 0) : _findIntersectingChunk(shardKey);
 
-        for (; it != _chunkMap.end(); ++it) {
-            if (!handler(*it))
+        for (; it != _end(); _advance(&it)) {
+            if (!handler(_at(it)))
                 break;
         }
     }
@@ -108,8 +142,8 @@ public:
                                  Callable&& handler) const {
         const auto bounds = _overlappingBounds(min, max, isMaxInclusive);
 
-        for (auto it = bounds.first; it != bounds.second; ++it) {
-            if (!handler(*it))
+        for (auto it = bounds.first; it != bounds.second; _advance(&it)) {
+            if (!handler(_at(it)))
                 break;
         }
     }
@@ -117,6 +151,13 @@ public:
     ShardVersionMap constructShardVersionMap() const;
     std::shared_ptr<ChunkInfo> findIntersectingChunk(const BSONObj& shardKey) const;
 
+    /**
+     * Same as findIntersectingChunk, but takes the shard key in the format produced by
+     * ShardKeyPattern::toKeyString.
+     */
+    std::shared_ptr<ChunkInfo> findIntersectingChunkByKeyString(
+        const std::string& shardKeyString) const;
+
     void appendChunk(const std::shared_ptr<ChunkInfo>& chunk);
 
     ChunkMap createMerged(const std::vector<std::shared_ptr<ChunkInfo>>& changedChunks) const;
@@ -124,12 +165,46 @@ public:
     BSONObj toBSON() const;
 
 private:
-    ChunkVector::const_iterator _findIntersectingChunk(const BSONObj& shardKey,
-                                                       bool isMaxInclusive = true) const;
-    std::pair<ChunkVector::const_iterator, ChunkVector::const_iterator> _overlappingBounds(
-        const BSONObj& min, const BSONObj& max, bool isMaxInclusive) const;
+    Position _end() const {
+        return {_blocks.size(), 0};
+    }
+
+    const std::shared_ptr<ChunkInfo>& _at(const Position& pos) const {
+        return _blocks[pos.first]->chunks[pos.second];
+    }
 
-    ChunkVector _chunkMap;
+    void _advance(Position* pos) const {
+        if (++pos->second == _blocks[pos->first]->chunks.size()) {
+            ++pos->first;
+            pos->second = 0;
+        }
+    }
+
+    /**
+     * Returns the last block for appending to, copying it first if another ChunkMap shares it.
+     */
+    ChunkBlock* _mutableLastBlock();
+
+    /**
+     * Appends all of the chunks in 'block', which must not overlap the last chunk in this map.
+     * Shares 'block' itself unless it is small enough to be combined with the last block.
+     */
+    void _appendBlock(const std::shared_ptr<ChunkBlock>& block);
+
+    Position _findIntersectingChunk(const BSONObj& shardKey, bool isMaxInclusive = true) const {
+        return _findIntersectingChunkByKeyString(ShardKeyPattern::toKeyString(shardKey),
+                                                 isMaxInclusive);
+    }
+    Position _findIntersectingChunkByKeyString(const std::string& shardKeyString,
+                                               bool isMaxInclusive = true) const;
+    std::pair<Position, Position> _overlappingBounds(const BSONObj& min,
+                                                     const BSONObj& max,
+                                                     bool isMaxInclusive) const;
+
+    BlockVector _blocks;
+
+    // Number of chunks across all of the blocks
+    size_t _size{0};
 
     // Max version across all chunks
     ChunkVersion _collectionVersion;
@@ -264,6 +339,11 @@ public:
         return _chunkMap.findIntersectingChunk(shardKey);
     }
 
+    std::shared_ptr<ChunkInfo> findIntersectingChunkByKeyString(
+        const std::string& shardKeyString) const {
+        return _chunkMap.findIntersectingChunkByKeyString(shardKeyString);
+    }
+
     /**
      * Returns the ids of all shards on which the collection has any chunks.
      */
@@ -580,6 +660,16 @@ public:
      */
     bool rangeOverlapsShard(const ChunkRange& range, const ShardId& shardId) const;
 
+    /**
+     * Returns true if every chunk which overlaps the range between "min" and "max" is owned by the
+     * shard with the given "shardId", that is, if all the shard keys within that range belong to
+     * the shard. Whether "max" is part of the range is given by "isMaxInclusive".
+     */
+    bool rangeBelongsToShard(const BSONObj& min,
+                             const BSONObj& max,
+                             bool isMaxInclusive,
+                             const ShardId& shardId) const;
+
     /**
      * Given a shardKey, returns the first chunk which is owned by shardId and overlaps or sorts
      * after that shardKey. If the return value is empty, this means no such chunk exists.
@@ -608,6 +698,15 @@ public:
         return findIntersectingChunk(shardKey, CollationSpec::kSimpleSpec);
     }
 
+    /**
+     * Same as findIntersectingChunkWithSimpleCollation, but takes a complete shard key in the
+     * format produced by ShardKeyPattern::extractShardKeyStringFromDoc. Returns boost::none rather
+     * than throwing if no chunk contains the key, so that the caller can fall back to
+     * findIntersectingChunk to report the error.
+     */
+    boost::optional<Chunk> findIntersectingChunkByKeyString(
+        const std::string& shardKeyString) const;
+
     /**
      * Finds the shard id of the shard that owns the chunk minKey belongs to, assuming the simple
      * collation because shard keys do not support non-simple collations.
@@ -358,6 +358,15 @@ ShardEndpoint ChunkManagerTargeter::targetInsert(OperationContext* opCtx,
     BSONObj shardKey;
 
     if (_cm->isSharded()) {
+        // Inserts are targeted with the simple collation, so the chunk can be looked up directly
+        // by the KeyString form of the shard key, without materializing it as a BSONObj.
+        if (auto shardKeyString = _cm->getShardKeyPattern().extractShardKeyStringFromDoc(doc)) {
+            if (auto chunk = _cm->findIntersectingChunkByKeyString(*shardKeyString)) {
+                return ShardEndpoint(
+                    chunk->getShardId(), _cm->getVersion(chunk->getShardId()), boost::none);
+            }
+        }
+
         shardKey = _cm->getShardKeyPattern().extractShardKeyFromDoc(doc);
         // The shard key would only be empty after extraction if we encountered an error case, such
         // as the shard key possessing an array value or array descendants. If the shard key
@@ -165,4 +165,76 @@ TEST_F(ChunkMapTest, TestEnumerateOverlappingChunks) {
     ASSERT_EQ(count, 3);
 }
 
-}  // namespace mongo
\ No newline at end of file
+TEST_F(ChunkMapTest, TestMergeAcrossBlocks) {
+    const OID epoch = OID::gen();
+    const ShardId kOtherShard("otherShard");
+    const int numChunks = 5 * ChunkMap::kMaxChunksPerBlock;
+
+    std::vector<std::shared_ptr<ChunkInfo>> chunks;
+    for (int i = 0; i < numChunks; ++i) {
+        chunks.push_back(std::make_shared<ChunkInfo>(
+            ChunkType{kNss,
+                      ChunkRange{i == 0 ? getShardKeyPattern().globalMin() : BSON("a" << i),
+                                 i == numChunks - 1 ? getShardKeyPattern().globalMax()
+                                                    : BSON("a" << i + 1)},
+                      ChunkVersion{1, uint32_t(i), epoch, boost::none /* timestamp */},
+                      i % 2 ? kOtherShard : kThisShard}));
+    }
+    ChunkMap chunkMap{epoch, boost::none /* timestamp */};
+    auto initialChunkMap = chunkMap.createMerged(chunks);
+    ASSERT_EQ(initialChunkMap.size(), numChunks);
+    ASSERT_EQ(initialChunkMap.numBlocks(), 5);
+
+    // Split a chunk in the middle of the map and merge two chunks at a block boundary.
+    const int splitChunk = numChunks / 2 + 1;
+    const int mergedChunk = 2 * ChunkMap::kMaxChunksPerBlock - 1;
+    auto updatedChunkMap = initialChunkMap.createMerged(
+        {std::make_shared<ChunkInfo>(
+             ChunkType{kNss,
+                       ChunkRange{BSON("a" << mergedChunk), BSON("a" << mergedChunk + 2)},
+                       ChunkVersion{2, 0, epoch, boost::none /* timestamp */},
+                       kOtherShard}),
+         std::make_shared<ChunkInfo>(
+             ChunkType{kNss,
+                       ChunkRange{BSON("a" << splitChunk), BSON("a" << splitChunk + 0.5)},
+                       ChunkVersion{2, 1, epoch, boost::none /* timestamp */},
+                       kOtherShard}),
+         std::make_shared<ChunkInfo>(
+             ChunkType{kNss,
+                       ChunkRange{BSON("a" << splitChunk + 0.5), BSON("a" << splitChunk + 1)},
+                       ChunkVersion{2, 2, epoch, boost::none /* timestamp */},
+                       kOtherShard})});
+
+    // The original map is unchanged.
+    ASSERT_EQ(initialChunkMap.size(), numChunks);
+    ASSERT_EQ(initialChunkMap.getVersion(),
+              (ChunkVersion{1, uint32_t(numChunks - 1), epoch, boost::none /* timestamp */}));
+
+    ASSERT_EQ(updatedChunkMap.size(), numChunks);
+    ASSERT_LTE(updatedChunkMap.numBlocks(), 6);
+    ASSERT_EQ(updatedChunkMap.getVersion(),
+              (ChunkVersion{2, 2, epoch, boost::none /* timestamp */}));
+
+    auto lastMax = getShardKeyPattern().globalMin();
+    updatedChunkMap.forEach([&](const auto& chunkInfo) {
+        ASSERT_BSONOBJ_EQ(chunkInfo->getMin(), lastMax);
+        lastMax = chunkInfo->getMax();
+        return true;
+    });
+    ASSERT_BSONOBJ_EQ(lastMax, getShardKeyPattern().globalMax());
+
+    ASSERT_BSONOBJ_EQ(updatedChunkMap.findIntersectingChunk(BSON("a" << mergedChunk + 1))->getMin(),
+                      BSON("a" << mergedChunk));
+    ASSERT_BSONOBJ_EQ(
+        updatedChunkMap.findIntersectingChunk(BSON("a" << splitChunk + 0.75))->getMin(),
+        BSON("a" << splitChunk + 0.5));
+
+    auto shardVersions = updatedChunkMap.constructShardVersionMap();
+    ASSERT_EQ(shardVersions.size(), 2);
+    ASSERT_EQ(shardVersions.at(kOtherShard).shardVersion,
+              (ChunkVersion{2, 2, epoch, boost::none /* timestamp */}));
+    ASSERT_EQ(shardVersions.at(kThisShard).shardVersion,
+              (ChunkVersion{1, uint32_t(numChunks - 2), epoch, boost::none /* timestamp */}));
+}
+
+}  // namespace mongo
@@ -89,6 +89,7 @@
 #include "mongo/s/query/cluster_cursor_cleanup_job.h"
 #include "mongo/s/query/cluster_cursor_manager.h"
 #include "mongo/s/read_write_concern_defaults_cache_lookup_mongos.h"
+#include "mongo/s/routing_table_change_poller.h"
 #include "mongo/s/service_entry_point_mongos.h"
 #include "mongo/s/session_catalog_router.h"
 #include "mongo/s/sessions_collection_sharded.h"
@@ -149,6 +150,7 @@ const ntservice::NtServiceDefaultStrings defaultServiceStrings = {
 constexpr auto kSignKeysRetryInterval = Seconds{1};
 
 boost::optional<ShardingUptimeReporter> shardingUptimeReporter;
+boost::optional<RoutingTableChangePoller> routingTableChangePoller;
 
 Status waitForSigningKeys(OperationContext* opCtx) {
     auto const shardRegistry = Grid::get(opCtx)->shardRegistry();
@@ -760,6 +762,9 @@ ExitCode runMongosServer(ServiceContext* serviceContext) {
     shardingUptimeReporter.emplace();
     shardingUptimeReporter->startPeriodicThread();
 
+    routingTableChangePoller.emplace();
+    routingTableChangePoller->startPeriodicThread();
+
     clusterCursorCleanupJob.go();
 
     UserCacheInvalidator::start(serviceContext, opCtx);
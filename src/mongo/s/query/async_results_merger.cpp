@@ -105,8 +105,8 @@ AsyncResultsMerger::AsyncResultsMerger(OperationContext* opCtx,
       // since that is not supported we treat boost::none (unspecified) to mean 'kNormal'.
       _tailableMode(params.getTailableMode().value_or(TailableModeEnum::kNormal)),
       _params(std::move(params)),
-      _mergeQueue(MergingComparator(
-          _remotes, _params.getSort().value_or(BSONObj()), _params.getCompareWholeSortKey())),
+      _mergeTree(
+          _remotes, _params.getSort().value_or(BSONObj()), _params.getCompareWholeSortKey()),
       _promisedMinSortKeys(PromisedMinSortKeyComparator(_params.getSort().value_or(BSONObj()))) {
     if (params.getTxnNumber()) {
         invariant(params.getSessionId());
@@ -307,11 +307,11 @@ bool AsyncResultsMerger::_readySorted(WithLock lk) {
 }
 
 bool AsyncResultsMerger::_readySortedTailable(WithLock lk) {
-    if (_mergeQueue.empty()) {
+    if (_mergeTree.empty()) {
         return false;
     }
 
-    auto smallestRemote = _mergeQueue.top();
+    auto smallestRemote = _mergeTree.top();
     auto smallestResult = _remotes[smallestRemote].docBuffer.front();
     auto keyWeWantToReturn =
         extractSortKey(*smallestResult.getResult(), _params.getCompareWholeSortKey());
@@ -355,27 +355,34 @@ StatusWith<ClusterQueryResult> AsyncResultsMerger::nextReady() {
     return _params.getSort() ? _nextReadySorted(lk) : _nextReadyUnsorted(lk);
 }
 
-ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
+ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock lk) {
     // Tailable non-awaitData cursors cannot have a sort.
     invariant(_tailableMode != TailableModeEnum::kTailable);
 
-    if (_mergeQueue.empty()) {
+    if (_mergeTree.empty()) {
         return {};
     }
 
-    size_t smallestRemote = _mergeQueue.top();
-    _mergeQueue.pop();
+    size_t smallestRemote = _mergeTree.top();
+    auto& remote = _remotes[smallestRemote];
 
-    invariant(!_remotes[smallestRemote].docBuffer.empty());
-    invariant(_remotes[smallestRemote].status.isOK());
+    invariant(!remote.docBuffer.empty());
+    invariant(remote.status.isOK());
 
-    ClusterQueryResult front = _remotes[smallestRemote].docBuffer.front();
-    _remotes[smallestRemote].docBuffer.pop();
+    ClusterQueryResult front = remote.docBuffer.front();
+    remote.docBuffer.pop();
 
-    // Re-populate the merging queue with the next result from 'smallestRemote', if it has a
-    // next result.
-    if (!_remotes[smallestRemote].docBuffer.empty()) {
-        _mergeQueue.push(smallestRemote);
+    // Replay the merge with the next result from 'smallestRemote', if it has a next result.
+    _mergeTree.replayTop();
+
+    // A sorted merge cannot return anything while any remote has an empty buffer, so ask for the
+    // next batch once the buffer runs low rather than waiting for it to drain. Remotes whose
+    // buffer is already empty are left to _scheduleGetMores().
+    if (_tailableMode == TailableModeEnum::kNormal && remote.hasNext() &&
+        remote.docBuffer.size() <
+            static_cast<size_t>(internalQueryAsyncResultsMergerPrefetchWatermark.load()) &&
+        !remote.exhausted() && !remote.cbHandle.isValid() && _opCtx) {
+        remote.status = _askForNextBatch(lk, smallestRemote);
     }
 
     // For sorted tailable awaitData cursors, update the high water mark to the document's sort key.
@@ -709,6 +716,7 @@ void AsyncResultsMerger::_cleanUpFailedBatch(WithLock lk, Status status, size_t
         remote.partialResultsReturned = (remote.status != ErrorCodes::ExchangePassthrough);
         std::queue<ClusterQueryResult> emptyBuffer;
         std::swap(remote.docBuffer, emptyBuffer);
+        _mergeTree.invalidate();
         remote.status = Status::OK();
         remote.cursorId = 0;
     }
@@ -763,6 +771,7 @@ bool AsyncResultsMerger::_addBatchToBuffer(WithLock lk,
                                            size_t remoteIndex,
                                            const CursorResponse& response) {
     auto& remote = _remotes[remoteIndex];
+    const bool wasBuffering = remote.hasNext();
     _updateRemoteMetadata(lk, remoteIndex, response);
     for (const auto& obj : response.getBatch()) {
         // If there's a sort, we're expecting the remote node to have given us back a sort key.
@@ -788,10 +797,11 @@ bool AsyncResultsMerger::_addBatchToBuffer(WithLock lk,
         ++remote.fetchedCount;
     }
 
-    // If we're doing a sorted merge, then we have to make sure to put this remote onto the merge
-    // queue.
-    if (_params.getSort() && !response.getBatch().empty()) {
-        _mergeQueue.push(remoteIndex);
+    // If we're doing a sorted merge and this remote had nothing buffered, then this batch places
+    // it back into contention in the merge tree. A batch prefetched while the remote still had
+    // results buffered is queued behind them and does not affect the merge.
+    if (_params.getSort() && !wasBuffering && !response.getBatch().empty()) {
+        _mergeTree.invalidate();
     }
     return true;
 }
@@ -894,16 +904,96 @@ bool AsyncResultsMerger::RemoteCursorData::exhausted() const {
 }
 
 //
-// AsyncResultsMerger::MergingComparator
+// AsyncResultsMerger::MergeTree
 //
 
-bool AsyncResultsMerger::MergingComparator::operator()(const size_t& lhs, const size_t& rhs) {
-    const ClusterQueryResult& leftDoc = _remotes[lhs].docBuffer.front();
-    const ClusterQueryResult& rightDoc = _remotes[rhs].docBuffer.front();
+AsyncResultsMerger::MergeTree::MergeTree(const std::vector<RemoteCursorData>& remotes,
+                                         const BSONObj& sort,
+                                         bool compareWholeSortKey)
+    : _remotes(remotes), _sort(sort), _compareWholeSortKey(compareWholeSortKey) {
+    if (static_cast<size_t>(_sort.nFields()) <= Ordering::kMaxCompoundIndexKeys) {
+        _ordering = Ordering::make(_sort);
+    }
+}
 
-    return compareSortKeys(extractSortKey(*leftDoc.getResult(), _compareWholeSortKey),
-                           extractSortKey(*rightDoc.getResult(), _compareWholeSortKey),
-                           _sort) > 0;
+bool AsyncResultsMerger::MergeTree::empty() {
+    if (!_valid || _losers.size() != _remotes.size()) {
+        _rebuild();
+    }
+    return _losers.empty() || _remotes[_losers[0]].docBuffer.empty();
+}
+
+size_t AsyncResultsMerger::MergeTree::top() {
+    invariant(!empty());
+    return _losers[0];
+}
+
+void AsyncResultsMerger::MergeTree::replayTop() {
+    invariant(_valid);
+    size_t winner = _losers[0];
+    _encodeSortKey(winner);
+    for (size_t node = (_losers.size() + winner) / 2; node > 0; node /= 2) {
+        if (_wins(_losers[node], winner)) {
+            std::swap(_losers[node], winner);
+        }
+    }
+    _losers[0] = winner;
+}
+
+bool AsyncResultsMerger::MergeTree::_wins(size_t lhs, size_t rhs) const {
+    const auto& leftBuffer = _remotes[lhs].docBuffer;
+    const auto& rightBuffer = _remotes[rhs].docBuffer;
+    if (leftBuffer.empty() || rightBuffer.empty()) {
+        return !leftBuffer.empty() || (rightBuffer.empty() && lhs < rhs);
+    }
+
+    int cmp = _ordering
+        ? _sortKeys[lhs].compare(_sortKeys[rhs])
+        : compareSortKeys(extractSortKey(*leftBuffer.front().getResult(), _compareWholeSortKey),
+                          extractSortKey(*rightBuffer.front().getResult(), _compareWholeSortKey),
+                          _sort);
+    return cmp < 0 || (cmp == 0 && lhs < rhs);
+}
+
+void AsyncResultsMerger::MergeTree::_encodeSortKey(size_t remoteIndex) {
+    const auto& buffer = _remotes[remoteIndex].docBuffer;
+    if (!_ordering || buffer.empty()) {
+        return;
+    }
+    _sortKeys[remoteIndex] =
+        KeyString::Builder(KeyString::Version::kLatestVersion,
+                           extractSortKey(*buffer.front().getResult(), _compareWholeSortKey),
+                           *_ordering)
+            .getValueCopy();
+}
+
+void AsyncResultsMerger::MergeTree::_rebuild() {
+    const size_t numRemotes = _remotes.size();
+    _sortKeys.resize(_ordering ? numRemotes : 0);
+    _losers.resize(numRemotes);
+    _valid = true;
+    if (numRemotes == 0) {
+        return;
+    }
+
+    // Play every match bottom-up, recording the winner of each subtree so that it can advance.
+    std::vector<size_t> winners(2 * numRemotes);
+    for (size_t i = 0; i < numRemotes; ++i) {
+        _encodeSortKey(i);
+        winners[numRemotes + i] = i;
+    }
+    for (size_t node = numRemotes - 1; node > 0; --node) {
+        size_t left = winners[2 * node];
+        size_t right = winners[2 * node + 1];
+        if (_wins(left, right)) {
+            winners[node] = left;
+            _losers[node] = right;
+        } else {
+            winners[node] = right;
+            _losers[node] = left;
+        }
+    }
+    _losers[0] = winners[1];
 }
 
 bool AsyncResultsMerger::PromisedMinSortKeyComparator::operator()(
@@ -35,7 +35,9 @@
 
 #include "mongo/base/status_with.h"
 #include "mongo/bson/bsonobj.h"
+#include "mongo/bson/ordering.h"
 #include "mongo/db/cursor_id.h"
+#include "mongo/db/storage/key_string.h"
 #include "mongo/executor/task_executor.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/s/query/async_results_merger_params_gen.h"
@@ -90,7 +92,7 @@ public:
      *
      * Additionally copies each remote's first batch of results, if one exists, into that remote's
      * docBuffer. If a sort is specified in the ClusterClientCursorParams, places the remotes with
-     * buffered results onto _mergeQueue.
+     * buffered results into _mergeTree.
      *
      * The TaskExecutor* must remain valid for the lifetime of the ARM.
      *
@@ -318,16 +320,60 @@ private:
         long long fetchedCount = 0;
     };
 
-    class MergingComparator {
+    /**
+     * A tournament tree of losers over the remotes, used to merge their buffered results in sort
+     * order. Each remote is a leaf keyed on the first result in its buffer, and a remote with an
+     * empty buffer sorts after all others. Every internal node holds the remote which lost the
+     * match played there, so once the winner's first result has been consumed the next winner is
+     * found by replaying only the matches on the path from its leaf to the root. When the sort
+     * pattern permits, the sort keys are compared as KeyStrings, so that each is encoded once and
+     * every match is a single memcmp.
+     *
+     * Any change to the buffers other than consuming the winner's first result, such as a batch
+     * arriving for a remote whose buffer was empty, must be reported with invalidate(). The tree is
+     * then rebuilt on next use.
+     */
+    class MergeTree {
     public:
-        MergingComparator(const std::vector<RemoteCursorData>& remotes,
-                          const BSONObj& sort,
-                          bool compareWholeSortKey)
-            : _remotes(remotes), _sort(sort), _compareWholeSortKey(compareWholeSortKey) {}
+        MergeTree(const std::vector<RemoteCursorData>& remotes,
+                  const BSONObj& sort,
+                  bool compareWholeSortKey);
+
+        /**
+         * Returns true if none of the remotes has a buffered result.
+         */
+        bool empty();
+
+        /**
+         * Returns the index of the remote whose first buffered result sorts before those of all
+         * other remotes. Ties are broken in favor of the lower remote index. Must not be called if
+         * the tree is empty.
+         */
+        size_t top();
+
+        /**
+         * Must be called after the first buffered result of the remote returned by top() has been
+         * consumed.
+         */
+        void replayTop();
 
-        bool operator()(const size_t& lhs, const size_t& rhs);
+        void invalidate() {
+            _valid = false;
+        }
 
     private:
+        /**
+         * Returns true if the remote 'lhs' wins its match against the remote 'rhs'.
+         */
+        bool _wins(size_t lhs, size_t rhs) const;
+
+        /**
+         * Encodes the sort key of the first buffered result of the given remote, if any.
+         */
+        void _encodeSortKey(size_t remoteIndex);
+
+        void _rebuild();
+
         const std::vector<RemoteCursorData>& _remotes;
 
         const BSONObj _sort;
@@ -336,6 +382,21 @@ private:
         // We extract the sort key {$sortKey: <value>}. The sort key pattern '_sort' is verified to
         // be {$sortKey: 1}.
         const bool _compareWholeSortKey;
+
+        // Set unless the sort pattern has more fields than an Ordering can describe, in which case
+        // the sort keys are compared as BSON instead.
+        boost::optional<Ordering> _ordering;
+
+        // The KeyString encoding of the first buffered sort key of each remote. Only maintained if
+        // '_ordering' is set.
+        std::vector<KeyString::Value> _sortKeys;
+
+        // Element 0 is the overall winner, and element 'n' for 0 < n < _remotes.size() is the loser
+        // of the match at internal node 'n', whose children are the nodes 2n and 2n + 1. The leaf
+        // for remote 'i' is node _remotes.size() + i.
+        std::vector<size_t> _losers;
+
+        bool _valid = false;
     };
 
     using MinSortKeyRemoteIdPair = std::pair<BSONObj, size_t>;
@@ -484,9 +545,9 @@ private:
     // Data tracking the state of our communication with each of the remote nodes.
     std::vector<RemoteCursorData> _remotes;
 
-    // The top of this priority queue is the index into '_remotes' for the remote host that has the
-    // next document to return, according to the sort order. Used only if there is a sort.
-    std::priority_queue<size_t, std::vector<size_t>, MergingComparator> _mergeQueue;
+    // The top of this tree is the index into '_remotes' for the remote host that has the next
+    // document to return, according to the sort order. Used only if there is a sort.
+    MergeTree _mergeTree;
 
     // The index into '_remotes' for the remote from which we are currently retrieving results.
     // Used only if there is *not* a sort.
@@ -375,6 +375,13 @@ DispatchShardPipelineResults dispatchExchangeConsumerPipeline(
     std::vector<std::pair<ShardId, BSONObj>> requests;
     auto numConsumers = shardDispatchResults->exchangeSpec->consumerShards.size();
     std::vector<SplitPipeline> consumerPipelines;
+
+    // The consumers may run only a prefix of the merging pipeline, leaving the rest to run over the
+    // union of their results.
+    const auto& mergeSources = shardDispatchResults->splitPipeline->mergePipeline->getSources();
+    const auto consumerStagesEnd = std::next(
+        mergeSources.begin(),
+        shardDispatchResults->exchangeSpec->numConsumerStages.value_or(mergeSources.size()));
     for (size_t idx = 0; idx < numConsumers; ++idx) {
         // Pick this consumer's cursors from producers.
         std::vector<OwnedRemoteCursor> producers;
@@ -385,7 +392,7 @@ DispatchShardPipelineResults dispatchExchangeConsumerPipeline(
 
         // Create a pipeline for a consumer and add the merging stage.
         auto consumerPipeline = Pipeline::create(
-            shardDispatchResults->splitPipeline->mergePipeline->getSources(), expCtx);
+            Pipeline::SourceContainer(mergeSources.begin(), consumerStagesEnd), expCtx);
 
         sharded_agg_helpers::addMergeCursorsSource(
             consumerPipeline.get(),
@@ -419,9 +426,10 @@ DispatchShardPipelineResults dispatchExchangeConsumerPipeline(
         ownedCursors.emplace_back(OwnedRemoteCursor(opCtx, std::move(cursor), executionNss));
     }
 
-    // The merging pipeline is just a union of the results from each of the shards involved on the
-    // consumer side of the exchange.
-    auto mergePipeline = Pipeline::create({}, expCtx);
+    // The merging pipeline runs any stages left over by the consumers on the union of the results
+    // from each of the shards involved on the consumer side of the exchange.
+    auto mergePipeline = Pipeline::create(
+        Pipeline::SourceContainer(consumerStagesEnd, mergeSources.end()), expCtx);
     mergePipeline->setSplitState(Pipeline::SplitState::kSplitForMerge);
 
     SplitPipeline splitPipeline{nullptr, std::move(mergePipeline), boost::none};
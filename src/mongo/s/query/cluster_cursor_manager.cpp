@@ -155,42 +155,27 @@ ClusterCursorManager::ClusterCursorManager(ClockSource* clockSource)
 }
 
 ClusterCursorManager::~ClusterCursorManager() {
+    for (const auto& partition : _partitions) {
+        invariant(partition.entryMap.empty());
+    }
     invariant(_cursorIdPrefixToNamespaceMap.empty());
     invariant(_namespaceToContainerMap.empty());
 }
 
 void ClusterCursorManager::shutdown(OperationContext* opCtx) {
-    {
-        stdx::lock_guard<Latch> lk(_mutex);
-        _inShutdown = true;
-    }
+    _inShutdown.store(true);
     killAllCursors(opCtx);
 }
 
-StatusWith<CursorId> ClusterCursorManager::registerCursor(
-    OperationContext* opCtx,
-    std::unique_ptr<ClusterClientCursor> cursor,
-    const NamespaceString& nss,
-    CursorType cursorType,
-    CursorLifetime cursorLifetime,
-    UserNameIterator authenticatedUsers) {
-    // Read the clock out of the lock.
-    const auto now = _clockSource->now();
-
-    stdx::unique_lock<Latch> lk(_mutex);
-    _log.push({LogEvent::Type::kRegisterAttempt, boost::none, now, nss});
-
-    if (_inShutdown) {
-        lk.unlock();
-        cursor->kill(opCtx);
-        return Status(ErrorCodes::ShutdownInProgress,
-                      "Cannot register new cursors as we are in the process of shutting down");
-    }
+auto ClusterCursorManager::_getPartition(CursorId cursorId) -> Partition& {
+    // The low bits of a cursor id are random, so they spread the cursors evenly.
+    return _partitions[static_cast<uint64_t>(cursorId) % kNumPartitions];
+}
 
-    invariant(cursor);
-    cursor->setLeftoverMaxTimeMicros(opCtx->getRemainingMaxTimeMicros());
+CursorId ClusterCursorManager::_acquireCursorId(const NamespaceString& nss) {
+    stdx::lock_guard<Latch> lk(_namespaceMutex);
 
-    // Find the CursorEntryContainer for this namespace.  If none exists, create one.
+    // Find the NamespaceEntry for this namespace.  If none exists, create one.
     auto nsToContainerIt = _namespaceToContainerMap.find(nss);
     if (nsToContainerIt == _namespaceToContainerMap.end()) {
         uint32_t containerPrefix = 0;
@@ -207,39 +192,123 @@ StatusWith<CursorId> ClusterCursorManager::registerCursor(
         } while (_cursorIdPrefixToNamespaceMap.count(containerPrefix) > 0);
         _cursorIdPrefixToNamespaceMap[containerPrefix] = nss;
 
-        auto emplaceResult =
-            _namespaceToContainerMap.emplace(nss, CursorEntryContainer(containerPrefix));
+        auto emplaceResult = _namespaceToContainerMap.emplace(nss, NamespaceEntry(containerPrefix));
         invariant(emplaceResult.second);
         invariant(_namespaceToContainerMap.size() == _cursorIdPrefixToNamespaceMap.size());
 
         nsToContainerIt = emplaceResult.first;
     } else {
-        invariant(!nsToContainerIt->second.entryMap.empty());  // If exists, shouldn't be empty.
+        invariant(nsToContainerIt->second.numCursors > 0);  // If exists, shouldn't be empty.
     }
-    CursorEntryContainer& container = nsToContainerIt->second;
+    NamespaceEntry& container = nsToContainerIt->second;
+    ++container.numCursors;
 
-    // Generate a CursorId (which can't be the invalid value zero).
-    CursorEntryMap& entryMap = container.entryMap;
+    // Generate a CursorId (which can't be the invalid value zero). The caller checks that it is
+    // not already used in its partition.
     CursorId cursorId = 0;
     do {
         const uint32_t cursorSuffix = static_cast<uint32_t>(_pseudoRandom.nextInt32());
         cursorId = createCursorId(container.containerPrefix, cursorSuffix);
-    } while (cursorId == 0 || entryMap.count(cursorId) > 0);
-
-    // Create a new CursorEntry and register it in the CursorEntryContainer's map.
-    auto emplaceResult = entryMap.emplace(cursorId,
-                                          CursorEntry(std::move(cursor),
-                                                      cursorType,
-                                                      cursorLifetime,
-                                                      now,
-                                                      authenticatedUsers,
-                                                      opCtx->getOperationKey()));
-    invariant(emplaceResult.second);
-    _log.push({LogEvent::Type::kRegisterComplete, cursorId, now, nss});
+    } while (cursorId == 0);
 
     return cursorId;
 }
 
+void ClusterCursorManager::_releaseNamespace(WithLock,
+                                             Partition& partition,
+                                             const NamespaceString& nss) {
+    stdx::lock_guard<Latch> lk(_namespaceMutex);
+
+    auto it = _namespaceToContainerMap.find(nss);
+    invariant(it != _namespaceToContainerMap.end());
+    auto&& container = it->second;
+    invariant(container.numCursors > 0);
+    if (--container.numCursors > 0) {
+        return;
+    }
+
+    // This was the last cursor remaining in the given namespace.  Erase all state associated
+    // with this namespace.
+    size_t numDeleted = _cursorIdPrefixToNamespaceMap.erase(container.containerPrefix);
+    if (numDeleted != 1) {
+        LOGV2_ERROR(
+            4786901,
+            "Error attempting to erase CursorEntryContainer for nss {nss} and containerPrefix"
+            "{prefix}. Could not find containerPrefix in map from cursor ID prefix to nss. "
+            "Expected 'numDeleted' to be 1, but got {actualNumDeleted}",
+            "Error attempting to erase CursorEntryContainer. Could not find containerPrefix in map "
+            "from cursor id prefix to namespace string.",
+            "nss"_attr = it->first,
+            "prefix"_attr = container.containerPrefix,
+            "actualNumDeleted"_attr = numDeleted);
+        logCursorManagerInfo(partition);
+        MONGO_UNREACHABLE;
+    }
+    _namespaceToContainerMap.erase(it);
+    partition.log.push({LogEvent::Type::kNamespaceEntryMapErased, boost::none, boost::none, nss});
+
+    invariant(_namespaceToContainerMap.size() == _cursorIdPrefixToNamespaceMap.size());
+}
+
+StatusWith<CursorId> ClusterCursorManager::registerCursor(
+    OperationContext* opCtx,
+    std::unique_ptr<ClusterClientCursor> cursor,
+    const NamespaceString& nss,
+    CursorType cursorType,
+    CursorLifetime cursorLifetime,
+    UserNameIterator authenticatedUsers) {
+    // Read the clock out of the lock.
+    const auto now = _clockSource->now();
+
+    if (_inShutdown.load()) {
+        cursor->kill(opCtx);
+        return Status(ErrorCodes::ShutdownInProgress,
+                      "Cannot register new cursors as we are in the process of shutting down");
+    }
+
+    invariant(cursor);
+    cursor->setLeftoverMaxTimeMicros(opCtx->getRemainingMaxTimeMicros());
+
+    while (true) {
+        const CursorId cursorId = _acquireCursorId(nss);
+        auto& partition = _getPartition(cursorId);
+
+        stdx::unique_lock<Latch> lk(partition.mutex);
+        partition.log.push({LogEvent::Type::kRegisterAttempt, boost::none, now, nss});
+
+        // Checked again under the partition's mutex, so that shutdown() either sees the cursor or
+        // the cursor sees the shutdown.
+        if (_inShutdown.load()) {
+            _releaseNamespace(lk, partition, nss);
+            lk.unlock();
+            cursor->kill(opCtx);
+            return Status(ErrorCodes::ShutdownInProgress,
+                          "Cannot register new cursors as we are in the process of shutting down");
+        }
+
+        CursorEntryMap& entryMap = partition.entryMap;
+        if (entryMap.count(cursorId) > 0) {
+            // The generated cursor id is already taken, try another one.
+            _releaseNamespace(lk, partition, nss);
+            continue;
+        }
+
+        // Create a new CursorEntry and register it in the partition's map.
+        auto emplaceResult = entryMap.emplace(cursorId,
+                                              CursorEntry(std::move(cursor),
+                                                          nss,
+                                                          cursorType,
+                                                          cursorLifetime,
+                                                          now,
+                                                          authenticatedUsers,
+                                                          opCtx->getOperationKey()));
+        invariant(emplaceResult.second);
+        partition.log.push({LogEvent::Type::kRegisterComplete, cursorId, now, nss});
+
+        return cursorId;
+    }
+}
+
 StatusWith<ClusterCursorManager::PinnedCursor> ClusterCursorManager::checkOutCursor(
     const NamespaceString& nss,
     CursorId cursorId,
@@ -248,15 +317,16 @@ StatusWith<ClusterCursorManager::PinnedCursor> ClusterCursorManager::checkOutCur
     AuthCheck checkSessionAuth) {
     const auto now = _clockSource->now();
 
-    stdx::lock_guard<Latch> lk(_mutex);
-    _log.push({LogEvent::Type::kCheckoutAttempt, cursorId, now, nss});
+    auto& partition = _getPartition(cursorId);
+    stdx::lock_guard<Latch> lk(partition.mutex);
+    partition.log.push({LogEvent::Type::kCheckoutAttempt, cursorId, now, nss});
 
-    if (_inShutdown) {
+    if (_inShutdown.load()) {
         return Status(ErrorCodes::ShutdownInProgress,
                       "Cannot check out cursor as we are in the process of shutting down");
     }
 
-    CursorEntry* entry = _getEntry(lk, nss, cursorId);
+    CursorEntry* entry = _getEntry(lk, partition, nss, cursorId);
     if (!entry) {
         return cursorNotFoundStatus(nss, cursorId);
     }
@@ -293,7 +363,7 @@ StatusWith<ClusterCursorManager::PinnedCursor> ClusterCursorManager::checkOutCur
     }
     cursorGuard->reattachToOperationContext(opCtx);
 
-    _log.push({LogEvent::Type::kCheckoutComplete, cursorId, now, nss});
+    partition.log.push({LogEvent::Type::kCheckoutComplete, cursorId, now, nss});
     return PinnedCursor(this, std::move(cursorGuard), nss, cursorId);
 }
 
@@ -311,10 +381,11 @@ void ClusterCursorManager::checkInCursor(std::unique_ptr<ClusterClientCursor> cu
     cursor->detachFromOperationContext();
     cursor->setLastUseDate(now);
 
-    stdx::unique_lock<Latch> lk(_mutex);
-    _log.push({LogEvent::Type::kCheckInAttempt, cursorId, now, nss});
+    auto& partition = _getPartition(cursorId);
+    stdx::unique_lock<Latch> lk(partition.mutex);
+    partition.log.push({LogEvent::Type::kCheckInAttempt, cursorId, now, nss});
 
-    CursorEntry* entry = _getEntry(lk, nss, cursorId);
+    CursorEntry* entry = _getEntry(lk, partition, nss, cursorId);
     invariant(entry);
 
     // killPending will be true if killCursor() was called while the cursor was in use.
@@ -324,22 +395,23 @@ void ClusterCursorManager::checkInCursor(std::unique_ptr<ClusterClientCursor> cu
     entry->returnCursor(std::move(cursor));
 
     if (cursorState == CursorState::NotExhausted && !killPending) {
-        _log.push({LogEvent::Type::kCheckInCompleteCursorSaved, cursorId, now, nss});
+        partition.log.push({LogEvent::Type::kCheckInCompleteCursorSaved, cursorId, now, nss});
         // The caller may need the cursor again.
         return;
     }
 
     // After detaching the cursor, the entry will be destroyed.
     entry = nullptr;
-    detachAndKillCursor(std::move(lk), opCtx, nss, cursorId);
+    detachAndKillCursor(std::move(lk), partition, opCtx, nss, cursorId);
 }
 
 Status ClusterCursorManager::checkAuthForKillCursors(OperationContext* opCtx,
                                                      const NamespaceString& nss,
                                                      CursorId cursorId,
                                                      AuthzCheckFn authChecker) {
-    stdx::lock_guard<Latch> lk(_mutex);
-    auto entry = _getEntry(lk, nss, cursorId);
+    auto& partition = _getPartition(cursorId);
+    stdx::lock_guard<Latch> lk(partition.mutex);
+    auto entry = _getEntry(lk, partition, nss, cursorId);
 
     if (!entry) {
         return cursorNotFoundStatus(nss, cursorId);
@@ -367,11 +439,12 @@ Status ClusterCursorManager::killCursor(OperationContext* opCtx,
     invariant(opCtx);
 
     const auto now = _clockSource->now();
-    stdx::unique_lock<Latch> lk(_mutex);
+    auto& partition = _getPartition(cursorId);
+    stdx::unique_lock<Latch> lk(partition.mutex);
 
-    _log.push({LogEvent::Type::kKillCursorAttempt, cursorId, now, nss});
+    partition.log.push({LogEvent::Type::kKillCursorAttempt, cursorId, now, nss});
 
-    CursorEntry* entry = _getEntry(lk, nss, cursorId);
+    CursorEntry* entry = _getEntry(lk, partition, nss, cursorId);
     if (!entry) {
         return cursorNotFoundStatus(nss, cursorId);
     }
@@ -386,7 +459,7 @@ Status ClusterCursorManager::killCursor(OperationContext* opCtx,
     }
 
     // No one is using the cursor, so we destroy it.
-    detachAndKillCursor(std::move(lk), opCtx, nss, cursorId);
+    detachAndKillCursor(std::move(lk), partition, opCtx, nss, cursorId);
 
     // We no longer hold the lock here.
 
@@ -394,10 +467,11 @@ Status ClusterCursorManager::killCursor(OperationContext* opCtx,
 }
 
 void ClusterCursorManager::detachAndKillCursor(stdx::unique_lock<Latch> lk,
+                                               Partition& partition,
                                                OperationContext* opCtx,
                                                const NamespaceString& nss,
                                                CursorId cursorId) {
-    auto detachedCursorGuard = _detachCursor(lk, opCtx, nss, cursorId);
+    auto detachedCursorGuard = _detachCursor(lk, partition, opCtx, nss, cursorId);
     invariant(detachedCursorGuard.getStatus());
 
     // Deletion of the cursor can happen out of the lock.
@@ -408,7 +482,6 @@ void ClusterCursorManager::detachAndKillCursor(stdx::unique_lock<Latch> lk,
 std::size_t ClusterCursorManager::killMortalCursorsInactiveSince(OperationContext* opCtx,
                                                                  Date_t cutoff) {
     const auto now = _clockSource->now();
-    stdx::unique_lock<Latch> lk(_mutex);
 
     auto pred = [cutoff](CursorId cursorId, const CursorEntry& entry) -> bool {
         bool res = entry.getLifetimeType() == CursorLifetime::Mortal && !entry.getLsid() &&
@@ -424,100 +497,95 @@ std::size_t ClusterCursorManager::killMortalCursorsInactiveSince(OperationContex
         return res;
     };
 
-    return killCursorsSatisfying(std::move(lk), opCtx, std::move(pred), now);
+    return killCursorsSatisfying(opCtx, std::move(pred), now);
 }
 
 void ClusterCursorManager::killAllCursors(OperationContext* opCtx) {
     const auto now = _clockSource->now();
-    stdx::unique_lock<Latch> lk(_mutex);
     auto pred = [](CursorId, const CursorEntry&) -> bool { return true; };
 
-    killCursorsSatisfying(std::move(lk), opCtx, std::move(pred), now);
+    killCursorsSatisfying(opCtx, std::move(pred), now);
 }
 
 std::size_t ClusterCursorManager::killCursorsSatisfying(
-    stdx::unique_lock<Latch> lk,
-    OperationContext* opCtx,
-    std::function<bool(CursorId, const CursorEntry&)> pred,
-    Date_t now) {
+    OperationContext* opCtx, std::function<bool(CursorId, const CursorEntry&)> pred, Date_t now) {
     invariant(opCtx);
-    invariant(lk.owns_lock());
     std::size_t nKilled = 0;
 
-    _log.push(
-        {LogEvent::Type::kRemoveCursorsSatisfyingPredicateAttempt, boost::none, now, boost::none});
+    for (auto& partition : _partitions) {
+        std::vector<ClusterClientCursorGuard> cursorsToDestroy;
+        {
+            stdx::lock_guard<Latch> lk(partition.mutex);
+            partition.log.push({LogEvent::Type::kRemoveCursorsSatisfyingPredicateAttempt,
+                                boost::none,
+                                now,
+                                boost::none});
+
+            auto&& entryMap = partition.entryMap;
+            auto cursorIdEntryIt = entryMap.begin();
+            while (cursorIdEntryIt != entryMap.end()) {
+                auto cursorId = cursorIdEntryIt->first;
+                auto& entry = cursorIdEntryIt->second;
+
+                if (!pred(cursorId, entry)) {
+                    ++cursorIdEntryIt;
+                    continue;
+                }
 
-    std::vector<ClusterClientCursorGuard> cursorsToDestroy;
-    auto nsContainerIt = _namespaceToContainerMap.begin();
-    while (nsContainerIt != _namespaceToContainerMap.end()) {
-        auto&& entryMap = nsContainerIt->second.entryMap;
-        auto cursorIdEntryIt = entryMap.begin();
-        while (cursorIdEntryIt != entryMap.end()) {
-            auto cursorId = cursorIdEntryIt->first;
-            auto& entry = cursorIdEntryIt->second;
+                ++nKilled;
 
-            if (!pred(cursorId, entry)) {
-                ++cursorIdEntryIt;
-                continue;
-            }
-
-            ++nKilled;
+                if (entry.getOperationUsingCursor()) {
+                    // Mark the OperationContext using the cursor as killed, and move on.
+                    killOperationUsingCursor(lk, &entry);
+                    ++cursorIdEntryIt;
+                    continue;
+                }
 
-            if (entry.getOperationUsingCursor()) {
-                // Mark the OperationContext using the cursor as killed, and move on.
-                killOperationUsingCursor(lk, &entry);
-                ++cursorIdEntryIt;
-                continue;
+                const auto nss = entry.getNamespace();
+                partition.log.push(
+                    {LogEvent::Type::kCursorMarkedForDeletionBySatisfyingPredicate,
+                     cursorId,
+                     // While we collected 'now' above, we ran caller-provided predicates which may
+                     // have been expensive. To avoid re-reading from the clock while the lock is
+                     // held, we do not provide a value for 'now' in this log entry.
+                     boost::none,
+                     nss});
+
+                cursorsToDestroy.push_back(entry.releaseCursor(opCtx));
+
+                // Destroy the entry and set the iterator to the next element.
+                entryMap.erase(cursorIdEntryIt++);
+                _releaseNamespace(lk, partition, nss);
             }
 
-            _log.push({LogEvent::Type::kCursorMarkedForDeletionBySatisfyingPredicate,
-                       cursorId,
-                       // While we collected 'now' above, we ran caller-provided predicates which
-                       // may have been expensive. To avoid re-reading from the clock while the
-                       // lock is held, we do not provide a value for 'now' in this log entry.
-                       boost::none,
-                       nsContainerIt->first});
-
-            cursorsToDestroy.push_back(entry.releaseCursor(opCtx));
-
-            // Destroy the entry and set the iterator to the next element.
-            entryMap.erase(cursorIdEntryIt++);
+            partition.log.push({LogEvent::Type::kRemoveCursorsSatisfyingPredicateComplete,
+                                boost::none,
+                                // While we collected 'now' above, we ran caller-provided
+                                // predicates which may have been expensive. To avoid re-reading
+                                // from the clock while the lock is held, we do not provide a value
+                                // for 'now' in this log entry.
+                                boost::none,
+                                boost::none});
         }
 
-        if (entryMap.empty()) {
-            nsContainerIt = eraseContainer(nsContainerIt);
-        } else {
-            ++nsContainerIt;
+        // Ensure cursors are killed outside the lock, as killing may require waiting for callbacks
+        // to finish. They are killed before scanning the next partition, so that a scan over many
+        // cursors does not accumulate all of them first.
+        for (auto&& cursorGuard : cursorsToDestroy) {
+            invariant(cursorGuard);
+            cursorGuard->kill(opCtx);
         }
     }
 
-    _log.push({LogEvent::Type::kRemoveCursorsSatisfyingPredicateComplete,
-               boost::none,
-               // While we collected 'now' above, we ran caller-provided predicates which may have
-               // been expensive. To avoid re-reading from the clock while the lock is held, we do
-               // not provide a value for 'now' in this log entry.
-               boost::none,
-               boost::none});
-
-    // Ensure cursors are killed outside the lock, as killing may require waiting for callbacks to
-    // finish.
-    lk.unlock();
-
-    for (auto&& cursorGuard : cursorsToDestroy) {
-        invariant(cursorGuard);
-        cursorGuard->kill(opCtx);
-    }
-
     return nKilled;
 }
 
 ClusterCursorManager::Stats ClusterCursorManager::stats() const {
-    stdx::lock_guard<Latch> lk(_mutex);
-
     Stats stats;
 
-    for (auto& nsContainerPair : _namespaceToContainerMap) {
-        for (auto& cursorIdEntryPair : nsContainerPair.second.entryMap) {
+    for (auto& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        for (auto& cursorIdEntryPair : partition.entryMap) {
             const CursorEntry& entry = cursorIdEntryPair.second;
 
             if (entry.isKillPending()) {
@@ -545,10 +613,9 @@ ClusterCursorManager::Stats ClusterCursorManager::stats() const {
 }
 
 void ClusterCursorManager::appendActiveSessions(LogicalSessionIdSet* lsids) const {
-    stdx::lock_guard<Latch> lk(_mutex);
-
-    for (const auto& nsContainerPair : _namespaceToContainerMap) {
-        for (const auto& cursorIdEntryPair : nsContainerPair.second.entryMap) {
+    for (const auto& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        for (const auto& cursorIdEntryPair : partition.entryMap) {
             const CursorEntry& entry = cursorIdEntryPair.second;
 
             if (entry.isKillPending()) {
@@ -564,12 +631,11 @@ void ClusterCursorManager::appendActiveSessions(LogicalSessionIdSet* lsids) cons
     }
 }
 
-GenericCursor ClusterCursorManager::CursorEntry::cursorToGenericCursor(
-    CursorId cursorId, const NamespaceString& ns) const {
+GenericCursor ClusterCursorManager::CursorEntry::cursorToGenericCursor(CursorId cursorId) const {
     invariant(_cursor);
     GenericCursor gc;
     gc.setCursorId(cursorId);
-    gc.setNs(ns);
+    gc.setNs(_nss);
     gc.setCreatedDate(_cursor->getCreatedDate());
     gc.setLastAccessDate(_cursor->getLastUseDate());
     gc.setLsid(_cursor->getLsid());
@@ -586,12 +652,11 @@ std::vector<GenericCursor> ClusterCursorManager::getIdleCursors(
     const OperationContext* opCtx, MongoProcessInterface::CurrentOpUserMode userMode) const {
     std::vector<GenericCursor> cursors;
 
-    stdx::lock_guard<Latch> lk(_mutex);
-
     AuthorizationSession* ctxAuth = AuthorizationSession::get(opCtx->getClient());
 
-    for (const auto& nsContainerPair : _namespaceToContainerMap) {
-        for (const auto& cursorIdEntryPair : nsContainerPair.second.entryMap) {
+    for (const auto& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        for (const auto& cursorIdEntryPair : partition.entryMap) {
 
             const CursorEntry& entry = cursorIdEntryPair.second;
             // If auth is enabled, and userMode is allUsers, check if the current user has
@@ -606,8 +671,7 @@ std::vector<GenericCursor> ClusterCursorManager::getIdleCursors(
                 continue;
             }
 
-            cursors.emplace_back(
-                entry.cursorToGenericCursor(cursorIdEntryPair.first, nsContainerPair.first));
+            cursors.emplace_back(entry.cursorToGenericCursor(cursorIdEntryPair.first));
         }
     }
 
@@ -635,12 +699,11 @@ std::pair<Status, int> ClusterCursorManager::killCursorsWithMatchingSessions(
 
 stdx::unordered_set<CursorId> ClusterCursorManager::getCursorsForSession(
     LogicalSessionId lsid) const {
-    stdx::lock_guard<Latch> lk(_mutex);
-
     stdx::unordered_set<CursorId> cursorIds;
 
-    for (auto&& nsContainerPair : _namespaceToContainerMap) {
-        for (auto&& [cursorId, entry] : nsContainerPair.second.entryMap) {
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        for (auto&& [cursorId, entry] : partition.entryMap) {
             if (entry.isKillPending()) {
                 // Don't include sessions for killed cursors.
                 continue;
@@ -658,23 +721,23 @@ stdx::unordered_set<CursorId> ClusterCursorManager::getCursorsForSession(
 
 stdx::unordered_set<CursorId> ClusterCursorManager::getCursorsForOpKeys(
     std::vector<OperationKey> opKeys) const {
-    stdx::lock_guard<Latch> lk(_mutex);
-
     stdx::unordered_set<CursorId> cursorIds;
 
     // While we could maintain a cached mapping of OperationKey to CursorID to increase performance,
     // this approach was chosen given that 1) mongos will not have as many open cursors as a shard
     // and 2) mongos performance has historically not been a bottleneck.
-    for (auto&& opKey : opKeys) {
-        for (auto&& nsContainerPair : _namespaceToContainerMap) {
-            for (auto&& [cursorId, entry] : nsContainerPair.second.entryMap) {
-                if (entry.isKillPending()) {
-                    // Don't include any killed cursors.
-                    continue;
-                }
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        for (auto&& [cursorId, entry] : partition.entryMap) {
+            if (entry.isKillPending()) {
+                // Don't include any killed cursors.
+                continue;
+            }
 
+            for (auto&& opKey : opKeys) {
                 if (opKey == entry.getOperationKey()) {
                     cursorIds.insert(cursorId);
+                    break;
                 }
             }
         }
@@ -685,7 +748,7 @@ stdx::unordered_set<CursorId> ClusterCursorManager::getCursorsForOpKeys(
 
 boost::optional<NamespaceString> ClusterCursorManager::getNamespaceForCursorId(
     CursorId cursorId) const {
-    stdx::lock_guard<Latch> lk(_mutex);
+    stdx::lock_guard<Latch> lk(_namespaceMutex);
 
     const auto it = _cursorIdPrefixToNamespaceMap.find(extractPrefixFromCursorId(cursorId));
     if (it == _cursorIdPrefixToNamespaceMap.end()) {
@@ -694,62 +757,26 @@ boost::optional<NamespaceString> ClusterCursorManager::getNamespaceForCursorId(
     return it->second;
 }
 
-auto ClusterCursorManager::_getEntry(WithLock, NamespaceString const& nss, CursorId cursorId)
-    -> CursorEntry* {
-
-    auto nsToContainerIt = _namespaceToContainerMap.find(nss);
-    if (nsToContainerIt == _namespaceToContainerMap.end()) {
-        return nullptr;
-    }
-    CursorEntryMap& entryMap = nsToContainerIt->second.entryMap;
+auto ClusterCursorManager::_getEntry(WithLock,
+                                     Partition& partition,
+                                     NamespaceString const& nss,
+                                     CursorId cursorId) -> CursorEntry* {
+    CursorEntryMap& entryMap = partition.entryMap;
     auto entryMapIt = entryMap.find(cursorId);
-    if (entryMapIt == entryMap.end()) {
+    if (entryMapIt == entryMap.end() || entryMapIt->second.getNamespace() != nss) {
         return nullptr;
     }
 
     return &entryMapIt->second;
 }
 
-auto ClusterCursorManager::eraseContainer(NssToCursorContainerMap::iterator it)
-    -> NssToCursorContainerMap::iterator {
-    auto&& container = it->second;
-    auto&& entryMap = container.entryMap;
-    invariant(entryMap.empty());
-
-    // This was the last cursor remaining in the given namespace.  Erase all state associated
-    // with this namespace.
-    size_t numDeleted = _cursorIdPrefixToNamespaceMap.erase(container.containerPrefix);
-    if (numDeleted != 1) {
-        LOGV2_ERROR(
-            4786901,
-            "Error attempting to erase CursorEntryContainer for nss {nss} and containerPrefix"
-            "{prefix}. Could not find containerPrefix in map from cursor ID prefix to nss. "
-            "Expected 'numDeleted' to be 1, but got {actualNumDeleted}",
-            "Error attempting to erase CursorEntryContainer. Could not find containerPrefix in map "
-            "from cursor id prefix to namespace string.",
-            "nss"_attr = it->first,
-            "prefix"_attr = container.containerPrefix,
-            "actualNumDeleted"_attr = numDeleted);
-        logCursorManagerInfo();
-        MONGO_UNREACHABLE;
-    }
-    const auto nssRemoved = it->first;
-    _namespaceToContainerMap.erase(it++);
-    _log.push({LogEvent::Type::kNamespaceEntryMapErased,
-               boost::none,
-               boost::none,
-               std::move(nssRemoved)});
-
-    invariant(_namespaceToContainerMap.size() == _cursorIdPrefixToNamespaceMap.size());
-    return it;
-}
-
 StatusWith<ClusterClientCursorGuard> ClusterCursorManager::_detachCursor(WithLock lk,
+                                                                         Partition& partition,
                                                                          OperationContext* opCtx,
                                                                          const NamespaceString& nss,
                                                                          CursorId cursorId) {
-    _log.push({LogEvent::Type::kDetachAttempt, cursorId, boost::none, nss});
-    CursorEntry* entry = _getEntry(lk, nss, cursorId);
+    partition.log.push({LogEvent::Type::kDetachAttempt, cursorId, boost::none, nss});
+    CursorEntry* entry = _getEntry(lk, partition, nss, cursorId);
     if (!entry) {
         return cursorNotFoundStatus(nss, cursorId);
     }
@@ -762,31 +789,26 @@ StatusWith<ClusterClientCursorGuard> ClusterCursorManager::_detachCursor(WithLoc
     ClusterClientCursorGuard cursor = entry->releaseCursor(opCtx);
 
     // Destroy the entry.
-    auto nsToContainerIt = _namespaceToContainerMap.find(nss);
-    invariant(nsToContainerIt != _namespaceToContainerMap.end());
-    CursorEntryMap& entryMap = nsToContainerIt->second.entryMap;
-    size_t eraseResult = entryMap.erase(cursorId);
+    size_t eraseResult = partition.entryMap.erase(cursorId);
     invariant(1 == eraseResult);
-    if (entryMap.empty()) {
-        eraseContainer(nsToContainerIt);
-    }
+    _releaseNamespace(lk, partition, nss);
 
-    _log.push({LogEvent::Type::kDetachComplete, cursorId, boost::none, nss});
+    partition.log.push({LogEvent::Type::kDetachComplete, cursorId, boost::none, nss});
 
     return std::move(cursor);
 }
 
-void ClusterCursorManager::logCursorManagerInfo() const {
+void ClusterCursorManager::logCursorManagerInfo(const Partition& partition) const {
     LOGV2_ERROR_OPTIONS(4786900,
                         logv2::LogTruncation::Disabled,
                         "Dumping cursor manager contents. "
                         "NSS -> Container map: {nssToContainer} "
                         "Cursor ID Prefix -> NSS map: {cursorIdToNss} "
-                        "Internal log: {internalLog}",
+                        "Partition cursors and internal log: {internalLog}",
                         "Dumping cursor manager contents.",
                         "{nssToContainer}"_attr = dumpNssToContainerMap(),
                         "{cursorIdToNss}"_attr = dumpCursorIdToNssMap(),
-                        "{internalLog}"_attr = dumpInternalLog());
+                        "{internalLog}"_attr = dumpPartition(partition));
 }
 
 std::string ClusterCursorManager::LogEvent::typeToString(ClusterCursorManager::LogEvent::Type t) {
@@ -820,12 +842,7 @@ BSONObj ClusterCursorManager::dumpNssToContainerMap() const {
             BSONObjBuilder nssBob(nssToContainer.subobjStart(nss.toString()));
             nssBob.appendIntOrLL("containerPrefix",
                                  static_cast<int64_t>(cursorContainer.containerPrefix));
-            BSONArrayBuilder cursors(nssBob.subarrayStart("cursors"));
-            for (auto&& [cursorId, cursorEntry] : cursorContainer.entryMap) {
-                BSONObjBuilder cursorBob(cursors.subobjStart());
-                cursorBob.appendIntOrLL("id", cursorId);
-                cursorBob.append("lastActive", cursorEntry.getLastActive());
-            }
+            nssBob.appendIntOrLL("numCursors", static_cast<int64_t>(cursorContainer.numCursors));
         }
     }
     return bob.obj();
@@ -847,15 +864,27 @@ BSONObj ClusterCursorManager::dumpCursorIdToNssMap() const {
     return bob.obj();
 }
 
-BSONObj ClusterCursorManager::dumpInternalLog() const {
+BSONObj ClusterCursorManager::dumpPartition(const Partition& partition) const {
     BSONObjBuilder bob;
-    // Dump the internal log maintained by the ClusterCursorManager.
+    // Record an array for the cursors of the partition.
+    {
+        BSONArrayBuilder cursors(bob.subarrayStart("cursors"));
+        for (auto&& [cursorId, cursorEntry] : partition.entryMap) {
+            BSONObjBuilder cursorBob(cursors.subobjStart());
+            cursorBob.appendIntOrLL("id", cursorId);
+            cursorBob.append("nss", cursorEntry.getNamespace().toString());
+            cursorBob.append("lastActive", cursorEntry.getLastActive());
+        }
+    }
+
+    // Dump the internal log maintained by the partition.
     {
+        const auto& log = partition.log;
         BSONArrayBuilder logBuilder(bob.subarrayStart("log"));
-        size_t i = _log.start;
-        while (i != _log.end) {
+        size_t i = log.start;
+        while (i != log.end) {
             BSONObjBuilder bob(logBuilder.subobjStart());
-            const auto& logEntry = _log.events[i];
+            const auto& logEntry = log.events[i];
             if (logEntry.cursorId) {
                 bob.appendIntOrLL("cursorId", *logEntry.cursorId);
             }
@@ -869,7 +898,7 @@ BSONObj ClusterCursorManager::dumpInternalLog() const {
                 bob.append("nss", logEntry.nss->toString());
             }
 
-            i = (i + 1) % _log.events.size();
+            i = (i + 1) % log.events.size();
         }
     }
     return bob.obj();
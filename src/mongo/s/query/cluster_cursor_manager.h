@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -38,6 +39,7 @@
 #include "mongo/db/kill_sessions.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/session_killer.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/platform/random.h"
 #include "mongo/s/query/cluster_client_cursor.h"
@@ -68,6 +70,9 @@ class StatusWith;
  * The manager supports killing of registered cursors, either through the PinnedCursor object or
  * with the kill*() suite of methods.
  *
+ * The registered cursors are spread over partitions by their cursor id, each with its own mutex, so
+ * that checking cursors out and in only contends with the cursors of the same partition.
+ *
  * No public methods throw exceptions, and all public methods are thread-safe.
  */
 class ClusterCursorManager {
@@ -318,6 +323,9 @@ public:
      * Informs the manager that all mortal cursors with a 'last active' time equal to or earlier
      * than 'cutoff' should be killed.  The cursors need not necessarily be in the 'idle' state.
      *
+     * The partitions of the manager are scanned one at a time, so that cursors of the other
+     * partitions can be checked out and in meanwhile.
+     *
      * May block waiting for other threads to finish, but does not block on the network.
      *
      * Returns the number of cursors that were killed due to inactivity.
@@ -388,9 +396,10 @@ public:
 
 private:
     class CursorEntry;
-    struct CursorEntryContainer;
+    struct NamespaceEntry;
+    struct Partition;
     using CursorEntryMap = stdx::unordered_map<CursorId, CursorEntry>;
-    using NssToCursorContainerMap = stdx::unordered_map<NamespaceString, CursorEntryContainer>;
+    using NssToNamespaceEntryMap = stdx::unordered_map<NamespaceString, NamespaceEntry>;
 
     // Internal, fixed size log of events cursor manager. This has been added to help diagnose
     // SERVER-27796.
@@ -480,17 +489,41 @@ private:
      * Will detach a cursor, release the lock and then call kill() on it.
      */
     void detachAndKillCursor(stdx::unique_lock<Latch> lk,
+                             Partition& partition,
                              OperationContext* opCtx,
                              const NamespaceString& nss,
                              CursorId cursorId);
 
+    /**
+     * Returns the partition which owns the cursor 'cursorId'.
+     */
+    Partition& _getPartition(CursorId cursorId);
+
     /**
      * Returns a pointer to the CursorEntry for the given cursor.  If the given cursor is not
      * registered, returns null.
      *
-     * Not thread-safe.
+     * Must be called with the mutex of 'partition' held.
+     */
+    CursorEntry* _getEntry(WithLock,
+                           Partition& partition,
+                           NamespaceString const& nss,
+                           CursorId cursorId);
+
+    /**
+     * Generates a new cursor id for a cursor on 'nss', with the cursor id prefix of the namespace,
+     * and takes a reference on that prefix for the cursor. The caller must register the cursor, or
+     * give the reference back with _releaseNamespace().
+     */
+    CursorId _acquireCursorId(const NamespaceString& nss);
+
+    /**
+     * Gives back the reference on the cursor id prefix of 'nss' which was taken for a cursor of
+     * 'partition', and forgets the prefix once the last cursor on 'nss' is gone.
+     *
+     * Must be called with the mutex of 'partition' held.
      */
-    CursorEntry* _getEntry(WithLock, NamespaceString const& nss, CursorId cursorId);
+    void _releaseNamespace(WithLock, Partition& partition, const NamespaceString& nss);
 
     /**
      * De-registers the given cursor, and returns an owned pointer to the underlying
@@ -502,6 +535,7 @@ private:
      * Not thread-safe.
      */
     StatusWith<ClusterClientCursorGuard> _detachCursor(WithLock,
+                                                       Partition& partition,
                                                        OperationContext* opCtx,
                                                        const NamespaceString& nss,
                                                        CursorId cursorId);
@@ -512,13 +546,13 @@ private:
     void killOperationUsingCursor(WithLock, CursorEntry* entry);
 
     /**
-     * Kill the cursors satisfying the given predicate. Assumes that 'lk' is held upon entry. The
+     * Kill the cursors satisfying the given predicate. Scans one partition at a time, with only
+     * that partition's mutex held, and kills its cursors before moving on to the next one. The
      * 'now' parameter is only used for the internal logging mechansim.
      *
      * Returns the number of cursors killed.
      */
-    std::size_t killCursorsSatisfying(stdx::unique_lock<Latch> lk,
-                                      OperationContext* opCtx,
+    std::size_t killCursorsSatisfying(OperationContext* opCtx,
                                       std::function<bool(CursorId, const CursorEntry&)> pred,
                                       Date_t now);
 
@@ -533,12 +567,14 @@ private:
         CursorEntry() = default;
 
         CursorEntry(std::unique_ptr<ClusterClientCursor> cursor,
+                    NamespaceString nss,
                     CursorType cursorType,
                     CursorLifetime cursorLifetime,
                     Date_t lastActive,
                     UserNameIterator authenticatedUsersIter,
                     boost::optional<OperationKey> opKey)
             : _cursor(std::move(cursor)),
+              _nss(std::move(nss)),
               _cursorType(cursorType),
               _cursorLifetime(cursorLifetime),
               _lastActive(lastActive),
@@ -564,6 +600,10 @@ private:
             return _operationUsingCursor->isKillPending();
         }
 
+        const NamespaceString& getNamespace() const {
+            return _nss;
+        }
+
         CursorType getCursorType() const {
             return _cursorType;
         }
@@ -602,11 +642,11 @@ private:
 
         /**
          * Creates a generic cursor from the cursor inside this entry. Should only be called on
-         * idle cursors. The caller must supply the cursorId and namespace because the CursorEntry
-         * does not have access to them.  Cannot be called if this CursorEntry does not own an
-         * underlying ClusterClientCursor.
+         * idle cursors. The caller must supply the cursorId because the CursorEntry does not have
+         * access to it.  Cannot be called if this CursorEntry does not own an underlying
+         * ClusterClientCursor.
          */
-        GenericCursor cursorToGenericCursor(CursorId cursorId, const NamespaceString& ns) const;
+        GenericCursor cursorToGenericCursor(CursorId cursorId) const;
 
         OperationContext* getOperationUsingCursor() const {
             return _operationUsingCursor;
@@ -635,6 +675,7 @@ private:
 
     private:
         std::unique_ptr<ClusterClientCursor> _cursor;
+        NamespaceString _nss;
         CursorType _cursorType = CursorType::SingleTarget;
         CursorLifetime _cursorLifetime = CursorLifetime::Mortal;
         Date_t _lastActive;
@@ -651,30 +692,32 @@ private:
     };
 
     /**
-     * CursorEntryContainer is a moveable, non-copyable container for a set of cursors, where all
-     * contained cursors share the same 32-bit prefix of their cursor id.
+     * NamespaceEntry holds the 32-bit prefix shared by the cursor ids of all cursors on a
+     * namespace, and the number of such cursors.
      */
-    struct CursorEntryContainer {
-        CursorEntryContainer(const CursorEntryContainer&) = delete;
-        CursorEntryContainer& operator=(const CursorEntryContainer&) = delete;
+    struct NamespaceEntry {
+        NamespaceEntry(uint32_t containerPrefix) : containerPrefix(containerPrefix) {}
 
-        CursorEntryContainer(uint32_t containerPrefix) : containerPrefix(containerPrefix) {}
+        // Common cursor id prefix for all cursors on this namespace.
+        uint32_t containerPrefix;
 
-        CursorEntryContainer(CursorEntryContainer&& other) = default;
-        CursorEntryContainer& operator=(CursorEntryContainer&& other) = default;
+        // Number of cursors registered on this namespace, across all partitions.
+        size_t numCursors = 0;
+    };
 
-        // Common cursor id prefix for all cursors in this container.
-        uint32_t containerPrefix;
+    // The cursors are spread over this many partitions by their cursor id, so that checking out
+    // and checking in cursors only contends with the cursors of the same partition.
+    static constexpr size_t kNumPartitions = 16;
+
+    struct Partition {
+        // Synchronizes access to the cursors of this partition and its log.
+        mutable Mutex mutex = MONGO_MAKE_LATCH("ClusterCursorManager::Partition::mutex");
 
-        // Map from cursor id to cursor entry.
+        // Map from cursor id to cursor entry, for the cursors owned by this partition.
         CursorEntryMap entryMap;
-    };
 
-    /**
-     * Erase the container that 'it' points to and return an iterator to the next one. Assumes 'it'
-     * is an iterator in '_namespaceToContainerMap'.
-     */
-    NssToCursorContainerMap::iterator eraseContainer(NssToCursorContainerMap::iterator it);
+        CircularLogQueue log;
+    };
 
     /**
      * Functions which dump the state/history of the cursor manager into a BSONObj for debug
@@ -682,22 +725,28 @@ private:
      */
     BSONObj dumpCursorIdToNssMap() const;
     BSONObj dumpNssToContainerMap() const;
-    BSONObj dumpInternalLog() const;
+    BSONObj dumpPartition(const Partition& partition) const;
 
     /**
-     * Logs objects which summarize the current state of the cursor manager as well as its recent
-     * history.
+     * Logs objects which summarize the current state of the cursor manager as well as the recent
+     * history of 'partition'. Must be called with the mutexes of 'partition' and of the namespaces
+     * held.
      */
-    void logCursorManagerInfo() const;
+    void logCursorManagerInfo(const Partition& partition) const;
 
     // Clock source.  Used when the 'last active' time for a cursor needs to be set/updated.  May be
     // concurrently accessed by multiple threads.
     ClockSource* _clockSource;
 
-    // Synchronizes access to all private state variables below.
-    mutable Mutex _mutex = MONGO_MAKE_LATCH("ClusterCursorManager::_mutex");
+    // Checked under the mutex of a partition before registering or checking out one of its
+    // cursors, so that a kill of all cursors which starts after it is set sees every cursor.
+    AtomicWord<bool> _inShutdown{false};
+
+    std::array<Partition, kNumPartitions> _partitions;
 
-    bool _inShutdown{false};
+    // Synchronizes access to the namespace state variables below. May be acquired while the mutex
+    // of a partition is held, but not the other way around.
+    mutable Mutex _namespaceMutex = MONGO_MAKE_LATCH("ClusterCursorManager::_namespaceMutex");
 
     // Randomness source.  Used for cursor id generation.
     const int64_t _randomSeed;
@@ -715,15 +764,13 @@ private:
     // when the last cursor on the given namespace is destroyed.
     stdx::unordered_map<uint32_t, NamespaceString> _cursorIdPrefixToNamespaceMap;
 
-    // Map from namespace to the CursorEntryContainer for that namespace.
+    // Map from namespace to the NamespaceEntry for that namespace.
     //
     // Entries are added when the first cursor on the given namespace is registered, and removed
     // when the last cursor on the given namespace is destroyed.
-    NssToCursorContainerMap _namespaceToContainerMap;
+    NssToNamespaceEntryMap _namespaceToContainerMap;
 
     size_t _cursorsTimedOut = 0;
-
-    CircularLogQueue _log;
 };
 
 }  // namespace mongo
@@ -795,6 +795,35 @@ TEST_F(ClusterCursorManagerTest, GetNamespaceForCursorIdMultipleCursorsDifferent
     }
 }
 
+// Test that the namespace of a cursor id prefix is kept until the last cursor on the namespace is
+// killed, even though the cursors of a namespace are spread over several partitions.
+TEST_F(ClusterCursorManagerTest, GetNamespaceForCursorIdAfterKillingAllButOneCursor) {
+    const size_t numCursors = 50;
+    std::vector<CursorId> cursorIds(numCursors);
+    for (size_t i = 0; i < numCursors; ++i) {
+        cursorIds[i] =
+            assertGet(getManager()->registerCursor(_opCtx.get(),
+                                                   allocateMockCursor(),
+                                                   nss,
+                                                   ClusterCursorManager::CursorType::SingleTarget,
+                                                   ClusterCursorManager::CursorLifetime::Mortal,
+                                                   UserNameIterator()));
+    }
+    for (size_t i = 1; i < numCursors; ++i) {
+        ASSERT_OK(getManager()->killCursor(_opCtx.get(), nss, cursorIds[i]));
+        ASSERT(isMockCursorKilled(i));
+    }
+    ASSERT_EQ(1U, getManager()->stats().cursorsSingleTarget);
+
+    boost::optional<NamespaceString> cursorNamespace =
+        getManager()->getNamespaceForCursorId(cursorIds[0]);
+    ASSERT(cursorNamespace);
+    ASSERT_EQ(nss.ns(), cursorNamespace->ns());
+
+    ASSERT_OK(getManager()->killCursor(_opCtx.get(), nss, cursorIds[0]));
+    ASSERT_FALSE(getManager()->getNamespaceForCursorId(cursorIds[0]));
+}
+
 // Test that getting the namespace for an unknown cursor returns boost::none.
 TEST_F(ClusterCursorManagerTest, GetNamespaceForCursorIdUnknown) {
     boost::optional<NamespaceString> cursorNamespace = getManager()->getNamespaceForCursorId(5);
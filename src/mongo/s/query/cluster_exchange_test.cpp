@@ -39,6 +39,7 @@
 #include "mongo/db/pipeline/document_source_sort.h"
 #include "mongo/db/pipeline/sharded_agg_helpers.h"
 #include "mongo/s/catalog/type_shard.h"
+#include "mongo/s/query/cluster_query_knobs_gen.h"
 #include "mongo/s/query/sharded_agg_test_fixture.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/scopeguard.h"
@@ -609,5 +610,69 @@ TEST_F(ClusterExchangeTest, CompoundShardKeyThreeShards) {
     future.default_timed_get();
 }
 
+TEST_F(ClusterExchangeTest, GroupMergeIsEligibleForHashExchangeAmongConsumers) {
+    const auto originalConsumers = internalQueryGroupMergeExchangeConsumers.load();
+    ON_BLOCK_EXIT([&] { internalQueryGroupMergeExchangeConsumers.store(originalConsumers); });
+    internalQueryGroupMergeExchangeConsumers.store(2);
+
+    const std::set<ShardId> targetedShards{ShardId("0"), ShardId("1"), ShardId("2")};
+    auto mergePipe = Pipeline::create(
+        {parseStage("{$group: {_id: '$x', count: {$sum: '$count'}, $doingMerge: true}}"),
+         parseStage("{$match: {count: {$gte: 2}}}"),
+         parseStage("{$project: {count: 1}}"),
+         parseStage("{$sort: {count: -1}}"),
+         parseStage("{$project: {_id: 1}}")},
+        expCtx());
+
+    auto exchangeSpec =
+        sharded_agg_helpers::checkIfEligibleForGroupMergeExchange(mergePipe.get(), targetedShards);
+    ASSERT_TRUE(exchangeSpec);
+    ASSERT(exchangeSpec->exchangeSpec.getPolicy() == ExchangePolicyEnum::kKeyRange);
+    ASSERT_BSONOBJ_EQ(exchangeSpec->exchangeSpec.getKey(),
+                      BSON("_id"
+                           << "hashed"));
+    ASSERT_EQ(exchangeSpec->exchangeSpec.getConsumers(), 2);
+    ASSERT_EQ(exchangeSpec->consumerShards.size(), 2UL);
+    ASSERT_EQ(exchangeSpec->consumerShards[0], ShardId("0"));
+    ASSERT_EQ(exchangeSpec->consumerShards[1], ShardId("1"));
+
+    // The hash space is split in half.
+    const auto& boundaries = exchangeSpec->exchangeSpec.getBoundaries().get();
+    ASSERT_EQ(boundaries.size(), 3UL);
+    ASSERT_BSONOBJ_EQ(boundaries[0], BSON("_id" << MINKEY));
+    ASSERT_BSONOBJ_EQ(boundaries[1], BSON("_id" << -1LL));
+    ASSERT_BSONOBJ_EQ(boundaries[2], BSON("_id" << MAXKEY));
+
+    // The consumers stop short of the $sort, which needs to see every group.
+    ASSERT_TRUE(exchangeSpec->numConsumerStages);
+    ASSERT_EQ(*exchangeSpec->numConsumerStages, 3UL);
+}
+
+TEST_F(ClusterExchangeTest, GroupMergeIsNotEligibleForHashExchangeUnlessEnabled) {
+    const auto originalConsumers = internalQueryGroupMergeExchangeConsumers.load();
+    ON_BLOCK_EXIT([&] { internalQueryGroupMergeExchangeConsumers.store(originalConsumers); });
+
+    const std::set<ShardId> targetedShards{ShardId("0"), ShardId("1")};
+    auto mergePipe = Pipeline::create(
+        {parseStage("{$group: {_id: '$x', $doingMerge: true}}")}, expCtx());
+
+    internalQueryGroupMergeExchangeConsumers.store(0);
+    ASSERT_FALSE(
+        sharded_agg_helpers::checkIfEligibleForGroupMergeExchange(mergePipe.get(), targetedShards));
+
+    // A single targeted shard leaves nothing to parallelize.
+    internalQueryGroupMergeExchangeConsumers.store(4);
+    ASSERT_FALSE(sharded_agg_helpers::checkIfEligibleForGroupMergeExchange(mergePipe.get(),
+                                                                           {ShardId("0")}));
+
+    // The merging pipeline must begin by merging partial groups.
+    mergePipe = Pipeline::create({parseStage("{$group: {_id: '$x'}}")}, expCtx());
+    ASSERT_FALSE(
+        sharded_agg_helpers::checkIfEligibleForGroupMergeExchange(mergePipe.get(), targetedShards));
+    mergePipe = Pipeline::create({parseStage("{$sort: {x: 1}}")}, expCtx());
+    ASSERT_FALSE(
+        sharded_agg_helpers::checkIfEligibleForGroupMergeExchange(mergePipe.get(), targetedShards));
+}
+
 }  // namespace
 }  // namespace mongo
@@ -60,6 +60,8 @@
 #include "mongo/s/query/async_results_merger.h"
 #include "mongo/s/query/cluster_client_cursor_impl.h"
 #include "mongo/s/query/cluster_cursor_manager.h"
+#include "mongo/s/query/cluster_find_coalescer.h"
+#include "mongo/s/query/cluster_query_knobs_gen.h"
 #include "mongo/s/query/establish_cursors.h"
 #include "mongo/s/query/store_possible_cursor.h"
 #include "mongo/s/stale_exception.h"
@@ -477,6 +479,36 @@ Status setUpOperationContextStateForGetMore(OperationContext* opCtx,
     return Status::OK();
 }
 
+/**
+ * Returns whether the query may share the results of an identical query which is running at the
+ * same time. Only plain reads outside of transactions take part.
+ */
+bool canCoalesce(OperationContext* opCtx, const CanonicalQuery& query) {
+    if (!internalQueryCoalesceIdenticalFinds.load()) {
+        return false;
+    }
+    const auto& findCommand = query.getFindCommand();
+    return !TransactionRouter::get(opCtx) && !findCommand.getTailable() &&
+        !findCommand.getAwaitData() && !findCommand.getNoCursorTimeout() &&
+        ReadConcernArgs::get(opCtx).getLevel() != repl::ReadConcernLevel::kSnapshotReadConcern;
+}
+
+/**
+ * Identifies the queries which return the same results: the same namespace, find command, read
+ * preference and read concern.
+ */
+std::string makeCoalescingKey(OperationContext* opCtx,
+                              const CanonicalQuery& query,
+                              const ReadPreferenceSetting& readPref) {
+    BSONObjBuilder bob;
+    bob.append("ns", query.nss().ns());
+    bob.append("find", query.getFindCommand().toBSON(BSONObj()));
+    bob.append("readPreference", readPref.toInnerBSON());
+    bob.append("readConcern", ReadConcernArgs::get(opCtx).toBSONInner());
+    auto key = bob.done();
+    return std::string(key.objdata(), key.objsize());
+}
+
 }  // namespace
 
 const size_t ClusterFind::kMaxRetries = 10;
@@ -508,6 +540,35 @@ CursorId ClusterFind::runQuery(OperationContext* opCtx,
             "Queries on mongoS may not request or provide a resume token",
             !findCommand.getRequestResumeToken() && findCommand.getResumeAfter().isEmpty());
 
+    if (!canCoalesce(opCtx, query)) {
+        return runQueryWithRetries(opCtx, query, readPref, results, partialResultsReturned);
+    }
+
+    // Identical queries which run at the same time share the results of a single one of them.
+    auto result = ClusterFindCoalescer::get(opCtx)->run(
+        opCtx, makeCoalescingKey(opCtx, query, readPref), [&] {
+            ClusterFindCoalescer::Result result;
+            result.cursorId = runQueryWithRetries(
+                opCtx, query, readPref, &result.batch, &result.partialResultsReturned);
+            return result;
+        });
+
+    CurOp::get(opCtx)->debug().nreturned = result.batch.size();
+    if (result.cursorId == 0) {
+        CurOp::get(opCtx)->debug().cursorExhausted = true;
+    }
+    if (partialResultsReturned) {
+        *partialResultsReturned = result.partialResultsReturned;
+    }
+    *results = std::move(result.batch);
+    return result.cursorId;
+}
+
+CursorId ClusterFind::runQueryWithRetries(OperationContext* opCtx,
+                                          const CanonicalQuery& query,
+                                          const ReadPreferenceSetting& readPref,
+                                          std::vector<BSONObj>* results,
+                                          bool* partialResultsReturned) {
     auto const catalogCache = Grid::get(opCtx)->catalogCache();
 
     // Re-target and re-send the initial find command to the shards until we have established the
@@ -60,6 +60,9 @@ public:
      * On success, fills out 'results' with the first batch of query results and returns the cursor
      * id which the caller can use on subsequent getMore operations. If no cursor needed to be saved
      * (e.g. the cursor was exhausted without need for a getMore), returns a cursor id of 0.
+     *
+     * If internalQueryCoalesceIdenticalFinds is enabled, an identical query which is running at
+     * the same time may provide the results instead.
      */
     static CursorId runQuery(OperationContext* opCtx,
                              const CanonicalQuery& query,
@@ -72,6 +75,17 @@ public:
      */
     static StatusWith<CursorResponse> runGetMore(OperationContext* opCtx,
                                                  const GetMoreRequest& request);
+
+private:
+    /**
+     * Runs query 'query', re-targeting and re-sending the initial find command to the shards until
+     * the shard version has been established.
+     */
+    static CursorId runQueryWithRetries(OperationContext* opCtx,
+                                        const CanonicalQuery& query,
+                                        const ReadPreferenceSetting& readPref,
+                                        std::vector<BSONObj>* results,
+                                        bool* partialResultsReturned);
 };
 
 }  // namespace mongo
@@ -0,0 +1,121 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/query/cluster_find_coalescer.h"
+
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/service_context.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+
+const auto getClusterFindCoalescer = ServiceContext::declareDecoration<ClusterFindCoalescer>();
+
+Counter64 coalescedFinds;
+ServerStatusMetricField<Counter64> displayCoalescedFinds("mongos.find.coalesced",
+                                                         &coalescedFinds);
+
+}  // namespace
+
+ClusterFindCoalescer* ClusterFindCoalescer::get(ServiceContext* serviceContext) {
+    return &getClusterFindCoalescer(serviceContext);
+}
+
+ClusterFindCoalescer* ClusterFindCoalescer::get(OperationContext* opCtx) {
+    return get(opCtx->getServiceContext());
+}
+
+ClusterFindCoalescer::Result ClusterFindCoalescer::run(OperationContext* opCtx,
+                                                       const std::string& key,
+                                                       std::function<Result()> runFn) {
+    std::shared_ptr<InFlight> inFlight;
+    boost::optional<SharedSemiFuture<std::shared_ptr<const Result>>> otherQuery;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        auto& entry = _inFlight[key];
+        if (entry) {
+            otherQuery = entry->getFuture();
+            ++_numWaiting;
+        } else {
+            entry = std::make_shared<InFlight>();
+            inFlight = entry;
+        }
+    }
+
+    if (otherQuery) {
+        auto result = [&] {
+            ON_BLOCK_EXIT([&] {
+                stdx::lock_guard<Latch> lk(_mutex);
+                --_numWaiting;
+            });
+            return otherQuery->get(opCtx);
+        }();
+        if (!result) {
+            return runFn();
+        }
+
+        stdx::lock_guard<Latch> lk(_mutex);
+        ++_numCoalesced;
+        coalescedFinds.increment();
+        return *result;
+    }
+
+    // Later queries with the same key run on their own once this one has completed, so that they
+    // see the writes which happened in the meantime.
+    auto complete = [&](std::shared_ptr<const Result> result) {
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            _inFlight.erase(key);
+        }
+        inFlight->emplaceValue(std::move(result));
+    };
+    auto failGuard = makeGuard([&] { complete(nullptr); });
+
+    auto result = runFn();
+
+    failGuard.dismiss();
+    complete(result.cursorId == 0 ? std::make_shared<const Result>(result) : nullptr);
+    return result;
+}
+
+long long ClusterFindCoalescer::getNumCoalesced() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _numCoalesced;
+}
+
+long long ClusterFindCoalescer::getNumWaiting() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _numWaiting;
+}
+
+}  // namespace mongo
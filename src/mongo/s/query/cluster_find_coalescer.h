@@ -0,0 +1,105 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/cursor_id.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/future.h"
+
+namespace mongo {
+
+class OperationContext;
+class ServiceContext;
+
+/**
+ * Lets identical read-only queries which run at the same time on a mongos share a single round of
+ * requests to the shards. The first query for a given key runs, and the queries with the same key
+ * which arrive while it is running wait for it and return a copy of its results instead of running.
+ *
+ * Only results which the caller can return in full are shared: if the running query fails or
+ * leaves a cursor open on the shards, each waiting query runs on its own.
+ */
+class ClusterFindCoalescer {
+    ClusterFindCoalescer(const ClusterFindCoalescer&) = delete;
+    ClusterFindCoalescer& operator=(const ClusterFindCoalescer&) = delete;
+
+public:
+    /**
+     * The results of a query: the first batch, and whether some shards were unavailable.
+     */
+    struct Result {
+        CursorId cursorId = 0;
+        std::vector<BSONObj> batch;
+        bool partialResultsReturned = false;
+    };
+
+    ClusterFindCoalescer() = default;
+
+    static ClusterFindCoalescer* get(ServiceContext* serviceContext);
+    static ClusterFindCoalescer* get(OperationContext* opCtx);
+
+    /**
+     * Runs 'runFn' unless a query with the same 'key' is already running, in which case waits for
+     * that query and returns its results. Runs 'runFn' after all if the other query fails or
+     * leaves a cursor open. Waiting is interruptible.
+     */
+    Result run(OperationContext* opCtx, const std::string& key, std::function<Result()> runFn);
+
+    /**
+     * Returns the number of queries which returned the results of another query.
+     */
+    long long getNumCoalesced() const;
+
+    /**
+     * Returns the number of queries which are waiting for another query.
+     */
+    long long getNumWaiting() const;
+
+private:
+    // A null result means that the query did not produce results which can be shared.
+    using InFlight = SharedPromise<std::shared_ptr<const Result>>;
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("ClusterFindCoalescer::_mutex");
+
+    // The queries which are running, by key.
+    stdx::unordered_map<std::string, std::shared_ptr<InFlight>> _inFlight;
+
+    long long _numCoalesced = 0;
+    long long _numWaiting = 0;
+};
+
+}  // namespace mongo
@@ -0,0 +1,203 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/query/cluster_find_coalescer.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/client.h"
+#include "mongo/db/service_context_test_fixture.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/concurrency/notification.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+namespace {
+
+using Result = ClusterFindCoalescer::Result;
+
+Result makeResult(CursorId cursorId, int numDocs) {
+    Result result;
+    result.cursorId = cursorId;
+    for (int i = 0; i < numDocs; ++i) {
+        result.batch.push_back(BSON("_id" << i));
+    }
+    return result;
+}
+
+class ClusterFindCoalescerTest : public ServiceContextTest {
+protected:
+    ClusterFindCoalescerTest() : _opCtx(makeOperationContext()) {}
+
+    /**
+     * Starts running a query with the given key on another thread, which returns 'result', or
+     * throws if 'result' is none, once 'release()' is called.
+     */
+    void startBlockedQuery(const std::string& key, boost::optional<Result> result) {
+        _blockedQuery = stdx::thread([this, key, result] {
+            ThreadClient tc("ClusterFindCoalescerTest", getServiceContext());
+            auto opCtx = tc->makeOperationContext();
+            try {
+                _coalescer.run(opCtx.get(), key, [&] {
+                    _blockedQueryStarted.set();
+                    _releaseBlockedQuery.get();
+                    uassert(ErrorCodes::InternalError, "query failed", result);
+                    return *result;
+                });
+            } catch (const ExceptionFor<ErrorCodes::InternalError>&) {
+            }
+        });
+        _blockedQueryStarted.get();
+    }
+
+    /**
+     * Starts running a query with the given key on another thread, and waits until it waits for
+     * the blocked query.
+     */
+    void startWaitingQuery(const std::string& key, int* numRuns, Result* out) {
+        _waitingQuery = stdx::thread([this, key, numRuns, out] {
+            ThreadClient tc("ClusterFindCoalescerTest", getServiceContext());
+            auto opCtx = tc->makeOperationContext();
+            *out = _coalescer.run(opCtx.get(), key, [&] {
+                ++*numRuns;
+                return makeResult(0, 1);
+            });
+        });
+        while (_coalescer.getNumWaiting() == 0) {
+            sleepmillis(1);
+        }
+    }
+
+    void release() {
+        _releaseBlockedQuery.set();
+        _blockedQuery.join();
+        _waitingQuery.join();
+    }
+
+    ServiceContext::UniqueOperationContext _opCtx;
+    ClusterFindCoalescer _coalescer;
+
+private:
+    Notification<void> _blockedQueryStarted;
+    Notification<void> _releaseBlockedQuery;
+    stdx::thread _blockedQuery;
+    stdx::thread _waitingQuery;
+};
+
+TEST_F(ClusterFindCoalescerTest, QueryRunsWhenNoIdenticalQueryIsRunning) {
+    int numRuns = 0;
+    auto runFn = [&] {
+        ++numRuns;
+        return makeResult(0, 3);
+    };
+    ASSERT_EQ(3U, _coalescer.run(_opCtx.get(), "a", runFn).batch.size());
+    ASSERT_EQ(3U, _coalescer.run(_opCtx.get(), "a", runFn).batch.size());
+    ASSERT_EQ(2, numRuns);
+    ASSERT_EQ(0, _coalescer.getNumCoalesced());
+}
+
+TEST_F(ClusterFindCoalescerTest, WaitingQueryReturnsTheResultsOfTheRunningQuery) {
+    startBlockedQuery("a", makeResult(0, 5));
+
+    int numRuns = 0;
+    Result result;
+    startWaitingQuery("a", &numRuns, &result);
+    release();
+
+    ASSERT_EQ(0, numRuns);
+    ASSERT_EQ(0, result.cursorId);
+    ASSERT_EQ(5U, result.batch.size());
+    ASSERT_BSONOBJ_EQ(BSON("_id" << 4), result.batch.back());
+    ASSERT_EQ(1, _coalescer.getNumCoalesced());
+    ASSERT_EQ(0, _coalescer.getNumWaiting());
+}
+
+TEST_F(ClusterFindCoalescerTest, WaitingQueryRunsIfTheRunningQueryLeavesACursorOpen) {
+    startBlockedQuery("a", makeResult(1234, 5));
+
+    int numRuns = 0;
+    Result result;
+    startWaitingQuery("a", &numRuns, &result);
+    release();
+
+    ASSERT_EQ(1, numRuns);
+    ASSERT_EQ(1U, result.batch.size());
+    ASSERT_EQ(0, _coalescer.getNumCoalesced());
+}
+
+TEST_F(ClusterFindCoalescerTest, WaitingQueryRunsIfTheRunningQueryFails) {
+    startBlockedQuery("a", boost::none);
+
+    int numRuns = 0;
+    Result result;
+    startWaitingQuery("a", &numRuns, &result);
+    release();
+
+    ASSERT_EQ(1, numRuns);
+    ASSERT_EQ(1U, result.batch.size());
+    ASSERT_EQ(0, _coalescer.getNumCoalesced());
+}
+
+TEST_F(ClusterFindCoalescerTest, QueriesWithDifferentKeysDoNotWait) {
+    startBlockedQuery("a", makeResult(0, 5));
+
+    int numRuns = 0;
+    auto result = _coalescer.run(_opCtx.get(), "b", [&] {
+        ++numRuns;
+        return makeResult(0, 1);
+    });
+    ASSERT_EQ(1, numRuns);
+    ASSERT_EQ(1U, result.batch.size());
+
+    int numWaitingRuns = 0;
+    startWaitingQuery("a", &numWaitingRuns, &result);
+    release();
+    ASSERT_EQ(0, numWaitingRuns);
+}
+
+TEST_F(ClusterFindCoalescerTest, WaitingIsInterruptible) {
+    startBlockedQuery("a", makeResult(0, 5));
+
+    _opCtx->markKilled(ErrorCodes::Interrupted);
+    ASSERT_THROWS_CODE(_coalescer.run(_opCtx.get(), "a", [] { return makeResult(0, 1); }),
+                       DBException,
+                       ErrorCodes::Interrupted);
+    ASSERT_EQ(0, _coalescer.getNumWaiting());
+
+    int numRuns = 0;
+    Result result;
+    startWaitingQuery("a", &numRuns, &result);
+    release();
+    ASSERT_EQ(0, numRuns);
+}
+
+}  // namespace
+}  // namespace mongo
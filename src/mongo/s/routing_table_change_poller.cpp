@@ -0,0 +1,160 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kSharding
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/routing_table_change_poller.h"
+
+#include <set>
+
+#include "mongo/db/client.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/logv2/log.h"
+#include "mongo/s/catalog/type_changelog.h"
+#include "mongo/s/catalog_cache.h"
+#include "mongo/s/client/shard_registry.h"
+#include "mongo/s/grid.h"
+#include "mongo/s/mongos_server_parameters_gen.h"
+#include "mongo/util/concurrency/idle_thread_block.h"
+#include "mongo/util/exit.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kChangeLogNamespace("config", "changelog");
+
+// The most changelog entries read by one poll. Changes older than those are left to be noticed
+// through stale version errors, as without polling.
+const long long kMaxChangeLogEntriesPerPoll = 50;
+
+// How often to check whether polling has been enabled, while it is disabled
+const Milliseconds kDisabledPollInterval(1000);
+
+/**
+ * Returns whether a changelog entry of the given kind records a change to the routing table of its
+ * namespace.
+ */
+bool isRoutingTableChange(StringData what) {
+    return what == "moveChunk.commit"_sd || what == "split"_sd || what == "multi-split"_sd ||
+        what == "merge"_sd || what == "refineCollectionShardKey.end"_sd;
+}
+
+}  // namespace
+
+RoutingTableChangePoller::RoutingTableChangePoller() = default;
+
+RoutingTableChangePoller::~RoutingTableChangePoller() {
+    // The thread must not be running when this object is destroyed
+    invariant(!_thread.joinable());
+}
+
+void RoutingTableChangePoller::startPeriodicThread() {
+    invariant(!_thread.joinable());
+
+    _thread = stdx::thread([this] {
+        Client::initThread("RoutingTableChangePoller");
+
+        while (!globalInShutdownDeprecated()) {
+            const auto pollIntervalMS = gRoutingTableChangePollIntervalMS.load();
+            if (pollIntervalMS > 0) {
+                auto opCtx = cc().makeOperationContext();
+                try {
+                    poll(opCtx.get());
+                } catch (const DBException& ex) {
+                    LOGV2_DEBUG(5502117,
+                                1,
+                                "Failed to read routing table changes from the config server",
+                                "error"_attr = redact(ex));
+                }
+            } else {
+                // Once polling is enabled again, start from the end of the changelog rather than
+                // refreshing everything which changed in the meantime.
+                _lastSeenChangeId.reset();
+            }
+
+            MONGO_IDLE_THREAD_BLOCK;
+            sleepFor(pollIntervalMS > 0 ? Milliseconds(pollIntervalMS) : kDisabledPollInterval);
+        }
+    });
+}
+
+int RoutingTableChangePoller::poll(OperationContext* opCtx) {
+    const auto configShard = Grid::get(opCtx)->shardRegistry()->getConfigShard();
+    const auto entries =
+        uassertStatusOK(configShard->exhaustiveFindOnConfig(
+                            opCtx,
+                            ReadPreferenceSetting{ReadPreference::Nearest},
+                            repl::ReadConcernLevel::kMajorityReadConcern,
+                            kChangeLogNamespace,
+                            BSONObj(),
+                            BSON("$natural" << -1),
+                            kMaxChangeLogEntriesPerPoll))
+            .docs;
+
+    if (entries.empty()) {
+        return 0;
+    }
+
+    auto newestChangeId = entries.front()[ChangeLogType::changeId.name()].str();
+    if (!_lastSeenChangeId) {
+        _lastSeenChangeId = std::move(newestChangeId);
+        return 0;
+    }
+
+    // Reading the capped changelog in reverse natural order returns the newest entries first, so
+    // only those up to the one which the previous poll ended at are new.
+    std::set<NamespaceString> changedNamespaces;
+    for (const auto& entry : entries) {
+        if (entry[ChangeLogType::changeId.name()].str() == *_lastSeenChangeId) {
+            break;
+        }
+
+        if (isRoutingTableChange(entry[ChangeLogType::what.name()].valueStringData())) {
+            changedNamespaces.emplace(entry[ChangeLogType::ns.name()].str());
+        }
+    }
+    _lastSeenChangeId = std::move(newestChangeId);
+
+    int numRefreshes = 0;
+    for (const auto& nss : changedNamespaces) {
+        if (Grid::get(opCtx)->catalogCache()->onRoutingTableChanged(nss)) {
+            LOGV2_DEBUG(5502118,
+                        2,
+                        "Refreshing routing table after it changed on the config server",
+                        "namespace"_attr = nss);
+            ++numRefreshes;
+        }
+    }
+
+    return numRefreshes;
+}
+
+}  // namespace mongo
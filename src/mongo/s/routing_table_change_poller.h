@@ -0,0 +1,80 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <string>
+
+#include "mongo/stdx/thread.h"
+
+namespace mongo {
+
+class OperationContext;
+
+/**
+ * Utility class, which is used to periodically read the chunk migrations, splits and merges
+ * recorded in the config server's changelog and to refresh the routing tables cached on this node
+ * for the collections they affect. Those refreshes would otherwise only happen once a shard rejects
+ * a request with a stale version.
+ *
+ * The changelog is best-effort, so this only makes stale version errors less likely and never
+ * replaces their handling.
+ *
+ * NOTE: Not thread-safe, so it should not be used from more than one thread at a time.
+ */
+class RoutingTableChangePoller {
+    RoutingTableChangePoller(const RoutingTableChangePoller&) = delete;
+    RoutingTableChangePoller& operator=(const RoutingTableChangePoller&) = delete;
+
+public:
+    RoutingTableChangePoller();
+    ~RoutingTableChangePoller();
+
+    /**
+     * Optional call, which would start a thread to periodically invoke poll.
+     */
+    void startPeriodicThread();
+
+    /**
+     * Reads the changelog entries added since the previous call and starts a refresh of each
+     * cached routing table they changed. The first call only finds where the changelog ends.
+     * Returns the number of refreshes started.
+     */
+    int poll(OperationContext* opCtx);
+
+private:
+    // The id of the newest changelog entry seen by the previous poll, if any
+    boost::optional<std::string> _lastSeenChangeId;
+
+    // The background poller thread (if started)
+    stdx::thread _thread;
+};
+
+}  // namespace mongo
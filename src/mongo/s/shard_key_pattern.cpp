@@ -371,6 +371,33 @@ BSONObj ShardKeyPattern::extractShardKeyFromDoc(const BSONObj& doc) const {
     return keyBuilder.obj();
 }
 
+boost::optional<std::string> ShardKeyPattern::extractShardKeyStringFromDoc(
+    const BSONObj& doc) const {
+    KeyString::Builder ks(KeyString::Version::V1, Ordering::allAscending());
+    for (auto&& patternEl : _keyPattern.toBSON()) {
+        BSONElement matchEl = extractKeyElementFromDoc(doc, patternEl.fieldNameStringData());
+
+        if (matchEl.eoo()) {
+            matchEl = kNullObj.firstElement();
+        }
+
+        if (!isValidShardKeyElementForExtractionFromDocument(matchEl)) {
+            return boost::none;
+        }
+
+        if (isHashedPatternEl(patternEl)) {
+            ks.appendNumberLong(
+                BSONElementHasher::hash64(matchEl, BSONElementHasher::DEFAULT_HASH_SEED));
+        } else {
+            ks.appendBSONElement(matchEl);
+        }
+    }
+
+    std::string shardKeyString{ks.getBuffer(), ks.getSize()};
+    dassert(shardKeyString == toKeyString(extractShardKeyFromDoc(doc)));
+    return shardKeyString;
+}
+
 BSONObj ShardKeyPattern::emplaceMissingShardKeyValuesForDocument(const BSONObj doc) const {
     BSONObjBuilder fullDocBuilder(doc);
     for (const auto& skField : _keyPattern.toBSON()) {
@@ -186,6 +186,13 @@ public:
      */
     BSONObj extractShardKeyFromDoc(const BSONObj& doc) const;
 
+    /**
+     * Same as extractShardKeyFromDoc, but returns the shard key in the format produced by
+     * toKeyString, without building it as a BSONObj first. Returns boost::none where
+     * extractShardKeyFromDoc would return an empty BSONObj.
+     */
+    boost::optional<std::string> extractShardKeyStringFromDoc(const BSONObj& doc) const;
+
     /**
      * Returns the document with missing shard key values set to null.
      */
@@ -301,6 +301,43 @@ TEST_F(ShardKeyPatternTest, ExtractDocShardKeyHashed) {
     ASSERT_BSONOBJ_EQ(docKey(pattern, BSON("a" << BSON_ARRAY(BSON("b" << value)))), BSONObj());
 }
 
+static void assertDocKeyString(const ShardKeyPattern& pattern, const BSONObj& doc) {
+    const auto shardKey = pattern.extractShardKeyFromDoc(doc);
+    const auto shardKeyString = pattern.extractShardKeyStringFromDoc(doc);
+    if (shardKey.isEmpty()) {
+        ASSERT_FALSE(shardKeyString);
+    } else {
+        ASSERT_TRUE(shardKeyString);
+        ASSERT_EQ(*shardKeyString, ShardKeyPattern::toKeyString(shardKey));
+    }
+}
+
+TEST_F(ShardKeyPatternTest, ExtractDocShardKeyString) {
+    ShardKeyPattern single(BSON("a" << 1));
+    assertDocKeyString(single, BSON("a" << 10));
+    assertDocKeyString(single, BSON("a" << 10.5 << "b" << 20));
+    assertDocKeyString(single, BSON("a" << MINKEY));
+    assertDocKeyString(single, BSON("b" << 20));
+    assertDocKeyString(single, BSON("a" << BSON_ARRAY(1 << 2)));
+
+    ShardKeyPattern compound(BSON("a" << 1 << "b.c" << 1));
+    assertDocKeyString(compound,
+                       BSON("a"
+                            << "str"
+                            << "b" << BSON("c" << 20)));
+    assertDocKeyString(compound, BSON("b" << BSON("c" << BSON("d" << 1)) << "a" << 10));
+    assertDocKeyString(compound, BSON("a" << 10));
+    assertDocKeyString(compound, BSON("a" << 10 << "b" << BSON("c" << BSON_ARRAY(1))));
+
+    ShardKeyPattern hashed(BSON("a" << 1 << "b"
+                                    << "hashed"));
+    assertDocKeyString(hashed,
+                       BSON("a" << 10 << "b"
+                                << "12345"));
+    assertDocKeyString(hashed, BSON("a" << 10));
+    assertDocKeyString(hashed, BSON("a" << 10 << "b" << BSON_ARRAY("12345")));
+}
+
 TEST_F(ShardKeyPatternTest, ExtractQueryShardKeySingle) {
     //
     // Single field ShardKeyPatterns
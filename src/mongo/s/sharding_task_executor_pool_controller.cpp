@@ -54,6 +54,14 @@ void emplaceOrInvariant(Map&& map, Args&&... args) noexcept {
     invariant(ret.second, "Element already existed in map/set");
 }
 
+/**
+ * Returns percent% of value, rounded up so that any non-zero percentage of a non-zero value is at
+ * least one.
+ */
+size_t percentRoundedUp(size_t value, size_t percent) {
+    return (value * percent + 99) / 100;
+}
+
 }  // namespace
 
 Status ShardingTaskExecutorPoolController::validateHostTimeout(const int& hostTimeoutMS) {
@@ -224,7 +232,19 @@ auto ShardingTaskExecutorPoolController::updateHost(PoolId id, const HostState&
     const size_t maxConns = gParameters.maxConnections.load();
 
     // Update the target for just the pool first
-    poolData.target = stats.requests + stats.active;
+    poolData.demand = stats.requests + stats.active;
+    const size_t headroomPercent = gParameters.targetHeadroomPercent.load();
+    const size_t desired =
+        poolData.demand + percentRoundedUp(poolData.demand, headroomPercent);
+    if (desired >= poolData.target) {
+        poolData.target = desired;
+    } else {
+        // Release only part of the excess connections, rounding up so the target reaches the
+        // desired count eventually.
+        const size_t decayPercent = gParameters.targetDecayPercent.load();
+        const size_t excess = poolData.target - desired;
+        poolData.target -= percentRoundedUp(excess, decayPercent);
+    }
 
     if (poolData.target < minConns) {
         poolData.target = minConns;
@@ -294,8 +314,11 @@ void ShardingTaskExecutorPoolController::removeHost(PoolId id) {
 
 auto ShardingTaskExecutorPoolController::getControls(PoolId id) -> ConnectionControls {
     stdx::lock_guard lk(_mutex);
-    auto& poolData = getOrInvariant(_poolDatas, id);
+    return _getControls(lk, getOrInvariant(_poolDatas, id));
+}
 
+auto ShardingTaskExecutorPoolController::_getControls(WithLock, const PoolData& poolData) const
+    -> ConnectionControls {
     const size_t maxPending = gParameters.maxConnecting.load();
 
     auto groupData = poolData.groupData.lock();
@@ -322,6 +345,12 @@ Milliseconds ShardingTaskExecutorPoolController::toRefreshTimeout() const {
 void ShardingTaskExecutorPoolController::updateConnectionPoolStats(
     executor::ConnectionPoolStats* cps) const {
     cps->strategy = gParameters.matchingStrategy.load();
+
+    stdx::lock_guard lk(_mutex);
+    for (auto&& [id, poolData] : _poolDatas) {
+        cps->updateControllerStatsForHost(
+            poolData.host, {poolData.demand, _getControls(lk, poolData).targetConnections});
+    }
 }
 
 }  // namespace mongo
@@ -59,6 +59,13 @@ namespace mongo {
  * When the MatchingStrategy is kMatchBusiestNode, it operates like kMatchPrimaryNode, but any pool
  * can be responsible for increasing the targetConnections of each member of its set.
  *
+ * The target for each pool follows its demand, the number of requests that are either queued or
+ * running against the host. By Little's law this is the product of the request rate and latency to
+ * the host, so the target grows when either goes up. The target is raised by targetHeadroomPercent
+ * above the demand as soon as the demand grows, and releases targetDecayPercent of its excess over
+ * the demand on each update once the demand drops, so that a pool does not drop and then have to
+ * re-establish its connections while the load to a host fluctuates.
+ *
  * Note that, in essence, there are three outside elements that can mutate the state of this class:
  * * The ReplicaSetChangeNotifier can notify the listener which updates the host groups
  * * The ServerParameters can update the Parameters which will used in the next update
@@ -96,6 +103,9 @@ public:
         AtomicWord<int> maxConnections;
         AtomicWord<int> maxConnecting;
 
+        AtomicWord<int> targetHeadroomPercent;
+        AtomicWord<int> targetDecayPercent;
+
         AtomicWord<int> hostTimeoutMS;
         AtomicWord<int> pendingTimeoutMS;
         AtomicWord<int> toRefreshTimeoutMS;
@@ -189,6 +199,9 @@ private:
         // Note that this will be invalid if there was a replica set change
         std::weak_ptr<GroupData> groupData;
 
+        // The number of requests queued or running against the host at the last update
+        size_t demand = 0;
+
         // The number of connections the host should maintain
         size_t target = 0;
 
@@ -208,9 +221,11 @@ private:
         boost::optional<PoolId> maybeId;
     };
 
+    ConnectionControls _getControls(WithLock, const PoolData& poolData) const;
+
     std::shared_ptr<ReplicaSetChangeNotifier::Listener> _listener;
 
-    Mutex _mutex = MONGO_MAKE_LATCH("ShardingTaskExecutorPoolController::_mutex");
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("ShardingTaskExecutorPoolController::_mutex");
 
     // Entires to _poolDatas are added by addHost() and removed by removeHost()
     stdx::unordered_map<PoolId, PoolData> _poolDatas;
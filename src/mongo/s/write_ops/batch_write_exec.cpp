@@ -33,6 +33,8 @@
 
 #include "mongo/s/write_ops/batch_write_exec.h"
 
+#include <deque>
+
 #include "mongo/base/error_codes.h"
 #include "mongo/base/owned_pointer_map.h"
 #include "mongo/base/status.h"
@@ -45,6 +47,7 @@
 #include "mongo/logv2/log.h"
 #include "mongo/s/client/shard_registry.h"
 #include "mongo/s/grid.h"
+#include "mongo/s/mongos_server_parameters_gen.h"
 #include "mongo/s/multi_statement_transaction_requests_sender.h"
 #include "mongo/s/transaction_router.h"
 #include "mongo/s/write_ops/batch_write_op.h"
@@ -111,6 +114,93 @@ bool hasTransientTransactionError(const BatchedCommandResponse& response) {
 // applies when no writes are occurring and metadata is not changing on reload.
 const int kMaxRoundsWithoutProgress(5);
 
+/**
+ * The child batches of a round which are out on the network, along with the sender collecting
+ * their responses.
+ */
+struct ChildBatchesInFlight {
+    // Batches out on the network, mapped by endpoint. The receive side is responsible for cleaning
+    // them up once their responses are noted.
+    OwnedPointerMap<ShardId, TargetedWriteBatch> ownedPendingBatches;
+
+    boost::optional<MultiStatementTransactionRequestsSender> ars;
+};
+
+/**
+ * Sends as many of the not yet sent 'childBatches' as possible at once, which is at most one per
+ * shard, and marks them as sent by setting them to nullptr.
+ */
+std::unique_ptr<ChildBatchesInFlight> sendChildBatches(
+    OperationContext* opCtx,
+    const BatchedCommandRequest& clientRequest,
+    const BatchWriteOp& batchOp,
+    std::map<ShardId, TargetedWriteBatch*>& childBatches,
+    BatchWriteExecStats* stats) {
+    auto inFlight = std::make_unique<ChildBatchesInFlight>();
+    auto& pendingBatches = inFlight->ownedPendingBatches.mutableMap();
+
+    //
+    // Construct the requests.
+    //
+
+    std::vector<AsyncRequestsSender::Request> requests;
+
+    // Get as many batches as we can at once
+    for (auto& childBatch : childBatches) {
+        TargetedWriteBatch* const nextBatch = childBatch.second;
+
+        // If the batch is nullptr, we sent it previously, so skip
+        if (!nextBatch)
+            continue;
+
+        // If we already have a batch for this shard, wait until the next time
+        const auto& targetShardId = nextBatch->getEndpoint().shardName;
+        if (pendingBatches.count(targetShardId))
+            continue;
+
+        stats->noteTargetedShard(targetShardId);
+
+        const auto request = [&] {
+            const auto shardBatchRequest(batchOp.buildBatchRequest(*nextBatch));
+
+            BSONObjBuilder requestBuilder;
+            shardBatchRequest.serialize(&requestBuilder);
+            logical_session_id_helpers::serializeLsidAndTxnNumber(opCtx, &requestBuilder);
+
+            return requestBuilder.obj();
+        }();
+
+        LOGV2_DEBUG(22905,
+                    4,
+                    "Sending write batch to {shardId}: {request}",
+                    "Sending write batch",
+                    "shardId"_attr = targetShardId,
+                    "request"_attr = redact(request));
+
+        requests.emplace_back(targetShardId, request);
+
+        // Indicate we're done by setting the batch to nullptr. We'll only get duplicate
+        // hostEndpoints if we have broadcast and non-broadcast endpoints for the same host, so this
+        // should be pretty efficient without moving stuff around.
+        childBatch.second = nullptr;
+
+        // Recv-side is responsible for cleaning up the nextBatch when used
+        pendingBatches.emplace(targetShardId, nextBatch);
+    }
+
+    bool isRetryableWrite = opCtx->getTxnNumber() && !TransactionRouter::get(opCtx);
+
+    inFlight->ars.emplace(
+        opCtx,
+        Grid::get(opCtx)->getExecutorPool()->getArbitraryExecutor(),
+        clientRequest.getNS().db().toString(),
+        requests,
+        kPrimaryOnlyReadPreference,
+        isRetryableWrite ? Shard::RetryPolicy::kIdempotent : Shard::RetryPolicy::kNoRetry);
+
+    return inFlight;
+}
+
 }  // namespace
 
 void BatchWriteExec::executeBatch(OperationContext* opCtx,
@@ -196,80 +286,35 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
         size_t numSent = 0;
 
         while (numSent != numToSend) {
-            // Collect batches out on the network, mapped by endpoint
-            OwnedPointerMap<ShardId, TargetedWriteBatch> ownedPendingBatches;
-            OwnedPointerMap<ShardId, TargetedWriteBatch>::MapType& pendingBatches =
-                ownedPendingBatches.mutableMap();
+            // Rounds of batches out on the network, in the order they were sent. Responses are
+            // received from the oldest round first.
+            std::deque<std::unique_ptr<ChildBatchesInFlight>> roundsInFlight;
+            roundsInFlight.push_back(
+                sendChildBatches(opCtx, clientRequest, batchOp, childBatches, stats));
+            numSent += roundsInFlight.back()->ownedPendingBatches.map().size();
+
+            // Unordered writes outside of a transaction can target and send the writes which are
+            // left over from this round as soon as a shard responds, as long as nothing indicates
+            // that the routing information is stale.
+            bool canSendAhead = !clientRequest.getWriteCommandBase().getOrdered() &&
+                !TransactionRouter::get(opCtx);
 
             //
-            // Construct the requests.
+            // Receive the responses.
             //
 
-            std::vector<AsyncRequestsSender::Request> requests;
-
-            // Get as many batches as we can at once
-            for (auto& childBatch : childBatches) {
-                TargetedWriteBatch* const nextBatch = childBatch.second;
-
-                // If the batch is nullptr, we sent it previously, so skip
-                if (!nextBatch)
-                    continue;
-
-                // If we already have a batch for this shard, wait until the next time
-                const auto& targetShardId = nextBatch->getEndpoint().shardName;
-                if (pendingBatches.count(targetShardId))
+            while (!roundsInFlight.empty()) {
+                auto& inFlight = *roundsInFlight.front();
+                if (inFlight.ars->done()) {
+                    roundsInFlight.pop_front();
                     continue;
+                }
 
-                stats->noteTargetedShard(targetShardId);
-
-                const auto request = [&] {
-                    const auto shardBatchRequest(batchOp.buildBatchRequest(*nextBatch));
-
-                    BSONObjBuilder requestBuilder;
-                    shardBatchRequest.serialize(&requestBuilder);
-                    logical_session_id_helpers::serializeLsidAndTxnNumber(opCtx, &requestBuilder);
-
-                    return requestBuilder.obj();
-                }();
-
-                LOGV2_DEBUG(22905,
-                            4,
-                            "Sending write batch to {shardId}: {request}",
-                            "Sending write batch",
-                            "shardId"_attr = targetShardId,
-                            "request"_attr = redact(request));
-
-                requests.emplace_back(targetShardId, request);
-
-                // Indicate we're done by setting the batch to nullptr. We'll only get duplicate
-                // hostEndpoints if we have broadcast and non-broadcast endpoints for the same host,
-                // so this should be pretty efficient without moving stuff around.
-                childBatch.second = nullptr;
-
-                // Recv-side is responsible for cleaning up the nextBatch when used
-                pendingBatches.emplace(targetShardId, nextBatch);
-            }
-
-            bool isRetryableWrite = opCtx->getTxnNumber() && !TransactionRouter::get(opCtx);
-
-            MultiStatementTransactionRequestsSender ars(
-                opCtx,
-                Grid::get(opCtx)->getExecutorPool()->getArbitraryExecutor(),
-                clientRequest.getNS().db().toString(),
-                requests,
-                kPrimaryOnlyReadPreference,
-                isRetryableWrite ? Shard::RetryPolicy::kIdempotent : Shard::RetryPolicy::kNoRetry);
-            numSent += pendingBatches.size();
-
-            //
-            // Receive the responses.
-            //
-
-            while (!ars.done()) {
                 // Block until a response is available.
-                auto response = ars.next();
+                auto response = inFlight.ars->next();
 
                 // Get the TargetedWriteBatch to find where to put the response
+                const auto& pendingBatches = inFlight.ownedPendingBatches.map();
                 dassert(pendingBatches.find(response.shardId) != pendingBatches.end());
                 TargetedWriteBatch* batch = pendingBatches.find(response.shardId)->second;
 
@@ -335,12 +380,14 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
                     if (!staleShardErrors.empty()) {
                         invariant(staleDbErrors.empty());
                         noteStaleShardResponses(staleShardErrors, &targeter);
+                        canSendAhead = false;
                         ++stats->numStaleShardBatches;
                     }
 
                     if (!staleDbErrors.empty()) {
                         invariant(staleShardErrors.empty());
                         noteStaleDbResponses(staleDbErrors, &targeter);
+                        canSendAhead = false;
                         ++stats->numStaleDbBatches;
                     }
 
@@ -366,6 +413,7 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
                                       << shardInfo);
 
                     batchOp.noteBatchError(*batch, errorFromStatus(status));
+                    canSendAhead = false;
 
                     LOGV2_DEBUG(22908,
                                 4,
@@ -388,6 +436,30 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
                         break;
                     }
                 }
+
+                if (!canSendAhead ||
+                    roundsInFlight.size() >=
+                        static_cast<size_t>(gBatchWriteMaxRoundsInFlight.load()) ||
+                    batchOp.numWriteOpsIn(WriteOpState_Ready) == 0) {
+                    continue;
+                }
+
+                OwnedPointerMap<ShardId, TargetedWriteBatch> nextChildBatchesOwned;
+                std::map<ShardId, TargetedWriteBatch*>& nextChildBatches =
+                    nextChildBatchesOwned.mutableMap();
+
+                // Targeting errors are dealt with by the next round, which refreshes the targeter
+                // first.
+                if (!batchOp.targetBatch(targeter, recordTargetErrors, &nextChildBatches).isOK()) {
+                    canSendAhead = false;
+                    continue;
+                }
+
+                if (!nextChildBatches.empty()) {
+                    roundsInFlight.push_back(sendChildBatches(
+                        opCtx, clientRequest, batchOp, nextChildBatches, stats));
+                    ++stats->numRounds;
+                }
             }
         }
 
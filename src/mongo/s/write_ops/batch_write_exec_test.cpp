@@ -613,6 +613,69 @@ TEST_F(BatchWriteExecTest, MultiOpLargeUnorderedWithStaleShardVersionError) {
     future.default_timed_get();
 }
 
+TEST_F(BatchWriteExecTest, MultiOpLargeUnorderedSendsNextRoundAheadOfSlowerShard) {
+    // The batch for the first shard only fits the first 63791 of its writes, so the rest of them
+    // are sent as soon as the first shard responds, before the second shard has responded.
+    const int kNumDocsToShard1 = 63791 + 10;
+
+    std::vector<BSONObj> docsToShard1;
+    docsToShard1.reserve(kNumDocsToShard1);
+    for (int i = 0; i < kNumDocsToShard1; i++) {
+        docsToShard1.push_back(BSON("x" << -1 - i));
+    }
+    const std::vector<BSONObj> docsToShard2{BSON("x" << 1)};
+
+    BatchedCommandRequest request([&] {
+        write_ops::Insert insertOp(nss);
+        insertOp.setWriteCommandBase([] {
+            write_ops::WriteCommandBase writeCommandBase;
+            writeCommandBase.setOrdered(false);
+            return writeCommandBase;
+        }());
+        std::vector<BSONObj> docsToInsert(docsToShard2);
+        docsToInsert.insert(docsToInsert.end(), docsToShard1.begin(), docsToShard1.end());
+        insertOp.setDocuments(docsToInsert);
+        return insertOp;
+    }());
+    request.setWriteConcern(BSONObj());
+
+    const static auto epoch = OID::gen();
+
+    MockNSTargeter multiShardNSTargeter(
+        nss,
+        {MockRange(ShardEndpoint(kShardName1,
+                                 ChunkVersion(100, 200, epoch, boost::none /* timestamp */),
+                                 boost::none),
+                   BSON("x" << MINKEY),
+                   BSON("x" << 0)),
+         MockRange(ShardEndpoint(kShardName2,
+                                 ChunkVersion(101, 200, epoch, boost::none /* timestamp */),
+                                 boost::none),
+                   BSON("x" << 0),
+                   BSON("x" << MAXKEY))});
+
+    auto future = launchAsync([&] {
+        BatchedCommandResponse response;
+        BatchWriteExecStats stats;
+        BatchWriteExec::executeBatch(
+            operationContext(), multiShardNSTargeter, request, &response, &stats);
+
+        ASSERT(response.getOk());
+        ASSERT_EQ(kNumDocsToShard1 + 1, response.getN());
+
+        // The stale response from the second shard only arrives after the rest of the writes for
+        // the first shard were sent ahead, so it is retried in a round of its own.
+        ASSERT_EQ(3, stats.numRounds);
+    });
+
+    expectInsertsReturnSuccess(docsToShard1.begin(), docsToShard1.begin() + 63791);
+    expectInsertsReturnStaleVersionErrors(docsToShard2);
+    expectInsertsReturnSuccess(docsToShard1.begin() + 63791, docsToShard1.end());
+    expectInsertsReturnSuccess(docsToShard2);
+
+    future.default_timed_get();
+}
+
 TEST_F(BatchWriteExecTest, StaleShardVersionReturnedFromBatchWithSingleMultiWrite) {
     BatchedCommandRequest request([&] {
         write_ops::Update updateOp(nss);
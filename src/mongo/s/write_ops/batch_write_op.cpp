@@ -292,6 +292,7 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
 
     TargetedBatchMap batchMap;
     std::set<ShardId> targetedShards;
+    std::set<ShardId> fullShards;
 
     const size_t numWriteOps = _clientRequest.sizeWriteOps();
 
@@ -387,8 +388,27 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
         if (wouldMakeBatchesTooBig(
                 writes, std::max(writeSizeBytes, errorResponsePotentialSizeBytes), batchMap)) {
             invariant(!batchMap.empty());
+
+            if (ordered) {
+                writeOp.cancelWrites(nullptr);
+                break;
+            }
+
+            // Unordered writes may be sent in any order, so leave this one for the next round and
+            // keep filling the batches of the other shards, until every shard owning chunks has a
+            // full batch.
+            for (const auto write : writes) {
+                if (batchMap.count(&write->endpoint)) {
+                    fullShards.insert(write->endpoint.shardName);
+                }
+            }
             writeOp.cancelWrites(nullptr);
-            break;
+
+            if (fullShards.size() >=
+                static_cast<size_t>(std::max(targeter.getNShardsOwningChunks(), 1))) {
+                break;
+            }
+            continue;
         }
 
         if (!ordered && !batchMap.empty() &&
@@ -1537,6 +1537,72 @@ TEST_F(BatchWriteOpLimitTests, OneBigOneSmall) {
     ASSERT(batchOp.isFinished());
 }
 
+// Unordered writes past a full batch for one shard still fill the batches of the other shards
+TEST_F(BatchWriteOpLimitTests, UnorderedBigDocFillsOtherShards) {
+    NamespaceString nss("foo.bar");
+    ShardEndpoint endpointA(ShardId("shardA"), ChunkVersion::IGNORED(), boost::none);
+    ShardEndpoint endpointB(ShardId("shardB"), ChunkVersion::IGNORED(), boost::none);
+
+    class TwoShardTargeter : public MockNSTargeter {
+    public:
+        using MockNSTargeter::MockNSTargeter;
+
+        int getNShardsOwningChunks() const override {
+            return 2;
+        }
+    };
+
+    TwoShardTargeter targeter(nss,
+                              {MockRange(endpointA, BSON("x" << MINKEY), BSON("x" << 0)),
+                               MockRange(endpointB, BSON("x" << 0), BSON("x" << MAXKEY))});
+
+    const std::string bigString(BSONObjMaxUserSize / 2, 'x');
+
+    BatchedCommandRequest request([&] {
+        write_ops::Insert insertOp(nss);
+        insertOp.setWriteCommandBase([] {
+            write_ops::WriteCommandBase wcb;
+            wcb.setOrdered(false);
+            return wcb;
+        }());
+        insertOp.setDocuments({BSON("x" << -1 << "data" << bigString),
+                               BSON("x" << -2 << "data" << bigString),
+                               BSON("x" << 1),
+                               BSON("x" << -3),
+                               BSON("x" << 2)});
+        return insertOp;
+    }());
+
+    BatchWriteOp batchOp(_opCtx, request);
+
+    OwnedPointerMap<ShardId, TargetedWriteBatch> targetedOwned;
+    std::map<ShardId, TargetedWriteBatch*>& targeted = targetedOwned.mutableMap();
+    ASSERT_OK(batchOp.targetBatch(targeter, false, &targeted));
+    ASSERT_EQUALS(targeted.size(), 2u);
+    // The second big doc does not fit in the batch for shardA, but the small doc after it does.
+    ASSERT_EQUALS(targeted[endpointA.shardName]->getWrites().size(), 2u);
+    ASSERT_EQUALS(targeted[endpointB.shardName]->getWrites().size(), 2u);
+
+    BatchedCommandResponse response;
+    buildResponse(2, &response);
+    batchOp.noteBatchResponse(*targeted[endpointA.shardName], response, nullptr);
+    batchOp.noteBatchResponse(*targeted[endpointB.shardName], response, nullptr);
+    ASSERT(!batchOp.isFinished());
+
+    targetedOwned.clear();
+    ASSERT_OK(batchOp.targetBatch(targeter, false, &targeted));
+    ASSERT_EQUALS(targeted.size(), 1u);
+    ASSERT_EQUALS(targeted[endpointA.shardName]->getWrites().size(), 1u);
+
+    buildResponse(1, &response);
+    batchOp.noteBatchResponse(*targeted[endpointA.shardName], response, nullptr);
+    ASSERT(batchOp.isFinished());
+
+    BatchedCommandResponse clientResponse;
+    batchOp.buildClientResponse(&clientResponse);
+    ASSERT_EQUALS(clientResponse.getN(), 5);
+}
+
 class BatchWriteOpTransactionTest : public ShardingTestFixture {
 public:
     const TxnNumber kTxnNumber = 5;
@@ -351,6 +351,9 @@ void Scope::execCoreFiles() {
 }
 
 namespace {
+// Scopes older than this are not returned to a cache, so that garbage they leak is eventually freed.
+constexpr Seconds kMaxScopeReuseTime = Seconds(10);
+
 class ScopeCache {
 public:
     void release(const string& poolName, const std::shared_ptr<Scope>& scope) {
@@ -411,7 +414,6 @@ private:
 
     // Note: if these numbers change, reconsider choice of datastructure for _pools
     static const unsigned kMaxPoolSize = 10;
-    constexpr static inline Seconds kMaxScopeReuseTime = Seconds(10);
 
     typedef std::deque<ScopeAndPool> Pools;  // More-recently used Scopes are kept at the front.
     Pools _pools;                            // protected by _mutex
@@ -419,23 +421,88 @@ private:
 };
 
 ScopeCache scopeCache;
+
+// Bumped by dropScopeCache() so that every thread discards its cached scope on next use.
+AtomicWord<long long> threadScopeCacheGeneration;
+
+/**
+ * Keeps the scope released by the last operation which ran JavaScript on the current thread, along
+ * with the functions it has already compiled. A scope created for the current thread can't be used
+ * from any other thread, and only one of them may exist on a thread at a time, so each thread
+ * keeps at most one.
+ */
+class ThreadScopeCache {
+public:
+    void release(const string& poolName, const std::shared_ptr<Scope>& scope) {
+        _scope.reset();
+
+        if (scope->hasOutOfMemoryException() || !scope->getError().empty() ||
+            Date_t::now() - scope->getCreateTime() > kMaxScopeReuseTime) {
+            return;
+        }
+
+        scope->reset();
+        _scope = scope;
+        _poolName = poolName;
+        _generation = threadScopeCacheGeneration.load();
+    }
+
+    std::shared_ptr<Scope> tryAcquire(OperationContext* opCtx, const string& poolName) {
+        // A scope which can't be reused is destroyed on the way out, before the caller makes a new
+        // one for this thread.
+        std::shared_ptr<Scope> scope = std::move(_scope);
+        if (!scope || _poolName != poolName ||
+            _generation != threadScopeCacheGeneration.load()) {
+            return std::shared_ptr<Scope>();
+        }
+
+        scope->reset();
+        scope->registerOperation(opCtx);
+        return scope;
+    }
+
+    void clear() {
+        _scope.reset();
+    }
+
+private:
+    std::shared_ptr<Scope> _scope;
+    string _poolName;
+    long long _generation = 0;
+};
+
+thread_local ThreadScopeCache threadScopeCache;  // NOLINT
 }  // anonymous namespace
 
 void ScriptEngine::dropScopeCache() {
     scopeCache.clear();
+    threadScopeCacheGeneration.fetchAndAdd(1);
+    threadScopeCache.clear();
+}
+
+Scope* ScriptEngine::newScopeForCurrentThread(boost::optional<int> jsHeapLimitMB) {
+    // Only one scope may exist on a thread at a time.
+    threadScopeCache.clear();
+    return createScopeForCurrentThread(jsHeapLimitMB);
 }
 
 class PooledScope : public Scope {
 public:
-    PooledScope(const std::string& pool, const std::shared_ptr<Scope>& real)
-        : _pool(pool), _real(real) {}
+    PooledScope(const std::string& pool,
+                const std::shared_ptr<Scope>& real,
+                bool boundToCurrentThread = false)
+        : _pool(pool), _real(real), _boundToCurrentThread(boundToCurrentThread) {}
 
     virtual ~PooledScope() {
         // SERVER-53671: Sometimes, ScopeCache::release() will generate an 'InterruptedAtShutdown'
         // exception. We catch and ignore such exceptions here to prevent them from crashing the
         // server while it is shutting down.
         try {
-            scopeCache.release(_pool, _real);
+            if (_boundToCurrentThread) {
+                threadScopeCache.release(_pool, _real);
+            } else {
+                scopeCache.release(_pool, _real);
+            }
         } catch (const ExceptionFor<ErrorCodes::InterruptedAtShutdown>&) {
             LOGV2(5367100, "Interrupted at shutdown during ~PooledScope()");
         }
@@ -571,6 +638,7 @@ protected:
 private:
     string _pool;
     std::shared_ptr<Scope> _real;
+    bool _boundToCurrentThread;
 };
 
 /** Get a scope from the pool of scopes matching the supplied pool name */
@@ -591,6 +659,22 @@ unique_ptr<Scope> ScriptEngine::getPooledScope(OperationContext* opCtx,
     return p;
 }
 
+unique_ptr<Scope> ScriptEngine::getPooledScopeForCurrentThread(
+    OperationContext* opCtx, const string& poolName, boost::optional<int> jsHeapLimitMB) {
+    // A scope's heap limit is fixed when it is created, so only share scopes created with the same
+    // limit.
+    const int heapLimitMB =
+        jsHeapLimitMB ? std::min(*jsHeapLimitMB, getJSHeapLimitMB()) : getJSHeapLimitMB();
+    const string fullPoolName = str::stream() << poolName << '\0' << heapLimitMB;
+    std::shared_ptr<Scope> s = threadScopeCache.tryAcquire(opCtx, fullPoolName);
+    if (!s) {
+        s.reset(newScopeForCurrentThread(jsHeapLimitMB));
+        s->registerOperation(opCtx);
+    }
+
+    return std::make_unique<PooledScope>(fullPoolName, s, true);
+}
+
 void (*ScriptEngine::_connectCallback)(DBClientBase&, StringData) = nullptr;
 
 ScriptEngine* getGlobalScriptEngine() {
@@ -217,9 +217,7 @@ public:
         return createScope();
     }
 
-    virtual Scope* newScopeForCurrentThread(boost::optional<int> jsHeapLimitMB) {
-        return createScopeForCurrentThread(jsHeapLimitMB);
-    }
+    virtual Scope* newScopeForCurrentThread(boost::optional<int> jsHeapLimitMB);
 
     Scope* newScopeForCurrentThread() {
         return newScopeForCurrentThread(boost::none);
@@ -256,6 +254,16 @@ public:
                                           const std::string& db,
                                           const std::string& scopeType);
 
+    /** gets a scope bound to the current thread, reusing the one released by the last operation
+     * which ran on this thread if it was released to the same pool
+     * @param poolName A unique id to limit scope sharing.
+     *                 This must include the db name and authenticated users.
+     * @return the scope, which goes back to the current thread's cache when destroyed
+     */
+    std::unique_ptr<Scope> getPooledScopeForCurrentThread(OperationContext* opCtx,
+                                                          const std::string& poolName,
+                                                          boost::optional<int> jsHeapLimitMB);
+
     void setScopeInitCallback(void (*func)(Scope&)) {
         _scopeInitCallback = func;
     }
@@ -70,6 +70,8 @@ MozJSScriptEngine::MozJSScriptEngine(bool disableLoadStored) : ScriptEngine(disa
 }
 
 MozJSScriptEngine::~MozJSScriptEngine() {
+    // Idle scopes kept for reuse must not outlive the engine which created them.
+    dropScopeCache();
     JS_ShutDown();
 }
 
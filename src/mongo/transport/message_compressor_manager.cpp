@@ -213,8 +213,23 @@ void MessageCompressorManager::clientBegin(BSONObjBuilder* output) {
     if (compressorList.size() == 0)
         return;
 
+    // The server picks the first compressor in our list that it supports, so offer the preferred
+    // compressors ahead of the rest.
+    std::vector<std::string> offered;
+    for (const auto& e : _preferred) {
+        if (std::find(compressorList.begin(), compressorList.end(), e) != compressorList.end() &&
+            std::find(offered.begin(), offered.end(), e) == offered.end()) {
+            offered.push_back(e);
+        }
+    }
+    for (const auto& e : compressorList) {
+        if (std::find(offered.begin(), offered.end(), e) == offered.end()) {
+            offered.push_back(e);
+        }
+    }
+
     BSONArrayBuilder sub(output->subarrayStart("compression"));
-    for (const auto& e : _registry->getCompressorNames()) {
+    for (const auto& e : offered) {
         LOGV2_DEBUG(22929,
                     3,
                     "Offering {compressor} compressor to server",
@@ -225,6 +240,10 @@ void MessageCompressorManager::clientBegin(BSONObjBuilder* output) {
     sub.doneFast();
 }
 
+void MessageCompressorManager::setPreferredCompressors(std::vector<std::string> names) {
+    _preferred = std::move(names);
+}
+
 void MessageCompressorManager::clientFinish(const BSONObj& input) {
     auto elem = input.getField("compression");
     LOGV2_DEBUG(22930, 3, "Finishing client-side compression negotiation");
@@ -33,6 +33,7 @@
 #include "mongo/transport/message_compressor_base.h"
 #include "mongo/transport/session.h"
 
+#include <string>
 #include <vector>
 
 namespace mongo {
@@ -68,6 +69,13 @@ public:
      */
     void clientBegin(BSONObjBuilder* output);
 
+    /*
+     * Sets the compressors this client would rather use, most preferred first. clientBegin offers
+     * any of them that are enabled in the registry ahead of the registry's other compressors, so
+     * a server that supports one of them picks it. Names that aren't enabled are ignored.
+     */
+    void setPreferredCompressors(std::vector<std::string> names);
+
     /*
      * Called by a client that has received an isMaster response (received after calling
      * clientBegin) and wants to finish negotiating compression.
@@ -125,6 +133,7 @@ public:
 
 private:
     std::vector<MessageCompressorBase*> _negotiated;
+    std::vector<std::string> _preferred;
     MessageCompressorRegistry* _registry;
 };
 
@@ -273,6 +273,55 @@ TEST(ZstdMessageCompressor, Overflow) {
     checkOverflow(std::make_unique<ZstdMessageCompressor>());
 }
 
+const std::string kZstdDictionary = "{ isMaster: 1, hello: 1, $db: \"admin\" } Hello, world!";
+
+TEST(ZstdDictMessageCompressor, Fidelity) {
+    auto testMessage = buildMessage();
+    checkFidelity(testMessage, std::make_unique<ZstdDictMessageCompressor>(kZstdDictionary));
+}
+
+TEST(ZstdDictMessageCompressor, Overflow) {
+    checkOverflow(std::make_unique<ZstdDictMessageCompressor>(kZstdDictionary));
+}
+
+TEST(ZstdDictMessageCompressor, DictionaryShrinksSmallMessages) {
+    const std::string data = "{ hello: 1, $db: \"admin\" }";
+    ConstDataRange input(data.data(), data.size());
+
+    auto compressedSize = [&](MessageCompressorBase& compressor) {
+        std::vector<char> buffer(compressor.getMaxCompressedSize(data.size()));
+        auto sws = compressor.compressData(input, DataRange(buffer.data(), buffer.size()));
+        ASSERT_OK(sws);
+        return sws.getValue();
+    };
+
+    ZstdMessageCompressor plain;
+    ZstdDictMessageCompressor withDictionary(kZstdDictionary);
+    ASSERT_LT(compressedSize(withDictionary), compressedSize(plain));
+}
+
+TEST(ZstdDictMessageCompressor, DecompressFailsWithDifferentDictionary) {
+    const std::string data = "Hello, world! Hello, world! Hello, world!";
+    ConstDataRange input(data.data(), data.size());
+
+    ZstdDictMessageCompressor compressor(kZstdDictionary);
+    ZstdDictMessageCompressor otherCompressor(kZstdDictionary + " and more");
+    ASSERT_NE(compressor.getDictionaryVersion(), otherCompressor.getDictionaryVersion());
+
+    std::vector<char> compressed(compressor.getMaxCompressedSize(data.size()));
+    auto sws = compressor.compressData(input, DataRange(compressed.data(), compressed.size()));
+    ASSERT_OK(sws);
+    ConstDataRange compressedRange(compressed.data(), sws.getValue());
+
+    std::vector<char> output(data.size());
+    ASSERT_NOT_OK(
+        otherCompressor.decompressData(compressedRange, DataRange(output.data(), output.size())));
+
+    sws = compressor.decompressData(compressedRange, DataRange(output.data(), output.size()));
+    ASSERT_OK(sws);
+    ASSERT_EQ(std::string(output.data(), sws.getValue()), data);
+}
+
 TEST(MessageCompressorManager, SERVER_28008) {
 
     // Create a client and server that will negotiate the same compressors,
@@ -343,6 +392,41 @@ TEST(MessageCompressorManager, SERVER_28008) {
     ASSERT_EQ(compressorId, zstdId);
 }
 
+TEST(MessageCompressorManager, PreferredCompressorsAreOfferedFirst) {
+    auto zstdCompressor = std::make_unique<ZstdMessageCompressor>();
+    const auto zstdId = zstdCompressor->getId();
+    auto snappyCompressor = std::make_unique<SnappyMessageCompressor>();
+    const auto zstdName = zstdCompressor->getName();
+    const auto snappyName = snappyCompressor->getName();
+
+    MessageCompressorRegistry registry;
+    registry.setSupportedCompressors({snappyName, zstdName});
+    registry.registerImplementation(std::move(zstdCompressor));
+    registry.registerImplementation(std::move(snappyCompressor));
+    ASSERT_OK(registry.finalizeSupportedCompressors());
+
+    MessageCompressorManager clientManager(&registry);
+    MessageCompressorManager serverManager(&registry);
+
+    // Compressors that aren't enabled are skipped, and the rest keep the registry's order.
+    clientManager.setPreferredCompressors({"zlib", zstdName});
+
+    BSONObjBuilder clientOutput;
+    clientManager.clientBegin(&clientOutput);
+    auto clientObj = clientOutput.done();
+    checkNegotiationResult(clientObj, {zstdName, snappyName});
+
+    BSONObjBuilder serverOutput;
+    serverManager.serverNegotiate(parseBSON(clientObj), &serverOutput);
+    auto serverObj = serverOutput.done();
+    clientManager.clientFinish(serverObj);
+
+    auto toSend = assertOk(clientManager.compressMessage(buildMessage(), nullptr));
+    MessageCompressorId compressorId;
+    assertOk(serverManager.decompressMessage(toSend, &compressorId));
+    ASSERT_EQ(compressorId, zstdId);
+}
+
 TEST(MessageCompressorManager, MessageSizeTooLarge) {
     auto registry = buildRegistry();
     MessageCompressorManager compManager(&registry);
@@ -29,13 +29,18 @@
 
 #include "mongo/platform/basic.h"
 
+#include <fstream>
 #include <memory>
+#include <sstream>
 
 #include <zstd.h>
 
+#include "mongo/base/data_type_endian.h"
 #include "mongo/base/init.h"
 #include "mongo/transport/message_compressor_registry.h"
 #include "mongo/transport/message_compressor_zstd.h"
+#include "mongo/util/md5.hpp"
+#include "mongo/util/options_parser/startup_options.h"
 
 namespace mongo {
 
@@ -75,6 +80,114 @@ StatusWith<std::size_t> ZstdMessageCompressor::decompressData(ConstDataRange inp
     return {ret};
 }
 
+namespace {
+constexpr auto kDictionaryVersionSize = sizeof(uint32_t);
+
+uint32_t getDictionaryVersion(const std::string& dictionary) {
+    if (auto dictId = ZSTD_getDictID_fromDict(dictionary.data(), dictionary.size())) {
+        return dictId;
+    }
+
+    // A raw content dictionary has no ID, so it is versioned by a digest of its contents.
+    md5digest digest;
+    md5(dictionary.data(), dictionary.size(), digest);
+    return ConstDataView(reinterpret_cast<const char*>(digest)).read<LittleEndian<uint32_t>>();
+}
+
+struct ZstdContextDeleter {
+    void operator()(ZSTD_CCtx* cctx) const {
+        ZSTD_freeCCtx(cctx);
+    }
+    void operator()(ZSTD_DCtx* dctx) const {
+        ZSTD_freeDCtx(dctx);
+    }
+};
+
+// Compression contexts are reused by each thread so that they are not allocated for every message.
+thread_local std::unique_ptr<ZSTD_CCtx, ZstdContextDeleter> zstdDictCCtx;
+thread_local std::unique_ptr<ZSTD_DCtx, ZstdContextDeleter> zstdDictDCtx;
+}  // namespace
+
+ZstdDictMessageCompressor::ZstdDictMessageCompressor(std::string dictionary)
+    : MessageCompressorBase(MessageCompressor::kZstdDict),
+      _dictionary(std::move(dictionary)),
+      _dictionaryVersion(mongo::getDictionaryVersion(_dictionary)),
+      _cdict(ZSTD_createCDict(_dictionary.data(), _dictionary.size(), ZSTD_CLEVEL_DEFAULT)),
+      _ddict(ZSTD_createDDict(_dictionary.data(), _dictionary.size())) {
+    uassert(5502125, "Could not load zstd message compression dictionary", _cdict && _ddict);
+}
+
+ZstdDictMessageCompressor::~ZstdDictMessageCompressor() {
+    ZSTD_freeCDict(_cdict);
+    ZSTD_freeDDict(_ddict);
+}
+
+std::size_t ZstdDictMessageCompressor::getMaxCompressedSize(size_t inputSize) {
+    return kDictionaryVersionSize + ZSTD_compressBound(inputSize);
+}
+
+StatusWith<std::size_t> ZstdDictMessageCompressor::compressData(ConstDataRange input,
+                                                                DataRange output) {
+    if (output.length() < kDictionaryVersionSize) {
+        return Status{ErrorCodes::BadValue, "Output buffer is too small to compress into"};
+    }
+
+    if (!zstdDictCCtx) {
+        zstdDictCCtx.reset(ZSTD_createCCtx());
+    }
+
+    size_t ret = ZSTD_compress_usingCDict(zstdDictCCtx.get(),
+                                          const_cast<char*>(output.data()) + kDictionaryVersionSize,
+                                          output.length() - kDictionaryVersionSize,
+                                          input.data(),
+                                          input.length(),
+                                          _cdict);
+
+    if (ZSTD_isError(ret)) {
+        return Status{ErrorCodes::BadValue,
+                      str::stream() << "Could not compress input: " << ZSTD_getErrorName(ret)};
+    }
+
+    DataView(const_cast<char*>(output.data()))
+        .write<LittleEndian<uint32_t>>(_dictionaryVersion);
+    ret += kDictionaryVersionSize;
+    counterHitCompress(input.length(), ret);
+    return {ret};
+}
+
+StatusWith<std::size_t> ZstdDictMessageCompressor::decompressData(ConstDataRange input,
+                                                                  DataRange output) {
+    if (input.length() < kDictionaryVersionSize) {
+        return Status{ErrorCodes::BadValue, "Compressed message is too short"};
+    }
+
+    auto version = ConstDataView(input.data()).read<LittleEndian<uint32_t>>();
+    if (version != _dictionaryVersion) {
+        return Status{ErrorCodes::BadValue,
+                      str::stream()
+                          << "Message was compressed with zstd dictionary version " << version
+                          << " but this node has version " << _dictionaryVersion};
+    }
+
+    if (!zstdDictDCtx) {
+        zstdDictDCtx.reset(ZSTD_createDCtx());
+    }
+
+    size_t ret = ZSTD_decompress_usingDDict(zstdDictDCtx.get(),
+                                            const_cast<char*>(output.data()),
+                                            output.length(),
+                                            input.data() + kDictionaryVersionSize,
+                                            input.length() - kDictionaryVersionSize,
+                                            _ddict);
+
+    if (ZSTD_isError(ret)) {
+        return Status{ErrorCodes::BadValue,
+                      str::stream() << "Could not decompress message: " << ZSTD_getErrorName(ret)};
+    }
+
+    counterHitDecompress(input.length(), ret);
+    return {ret};
+}
 
 MONGO_INITIALIZER_GENERAL(ZstdMessageCompressorInit,
                           ("EndStartupOptionHandling"),
@@ -82,5 +195,20 @@ MONGO_INITIALIZER_GENERAL(ZstdMessageCompressorInit,
 (InitializerContext* context) {
     auto& compressorRegistry = MessageCompressorRegistry::get();
     compressorRegistry.registerImplementation(std::make_unique<ZstdMessageCompressor>());
+
+    const auto& params = optionenvironment::startupOptionsParsed;
+    if (!params.count("net.compression.zstdDictionaryPath")) {
+        return;
+    }
+
+    const auto path = params["net.compression.zstdDictionaryPath"].as<std::string>();
+    std::ifstream file(path, std::ios::binary);
+    uassert(5502126,
+            str::stream() << "Could not open zstd message compression dictionary " << path,
+            file);
+    std::ostringstream dictionary;
+    dictionary << file.rdbuf();
+    compressorRegistry.registerImplementation(
+        std::make_unique<ZstdDictMessageCompressor>(dictionary.str()));
 }
 }  // namespace mongo
@@ -27,8 +27,15 @@
  *    it in the license file.
  */
 
+#include <string>
+
 #include "mongo/transport/message_compressor_base.h"
 
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+using ZSTD_CDict = ZSTD_CDict_s;
+using ZSTD_DDict = ZSTD_DDict_s;
+
 namespace mongo {
 class ZstdMessageCompressor final : public MessageCompressorBase {
 public:
@@ -41,5 +48,37 @@ public:
     StatusWith<std::size_t> decompressData(ConstDataRange input, DataRange output) override;
 };
 
+/**
+ * A zstd compressor that primes every message with a shared dictionary. Small messages otherwise
+ * compress poorly with zstd because each of them repeats the same field names.
+ *
+ * Both peers must load the same dictionary, which is typically trained offline with
+ * `zstd --train` over a sample of messages. Every compressed message starts with the version of the
+ * dictionary that compressed it, which is the dictionary ID for a trained dictionary and a digest
+ * of its contents for a raw one, so that a peer with a different dictionary fails to decompress it
+ * rather than producing garbage.
+ */
+class ZstdDictMessageCompressor final : public MessageCompressorBase {
+public:
+    explicit ZstdDictMessageCompressor(std::string dictionary);
+    ~ZstdDictMessageCompressor();
+
+    std::size_t getMaxCompressedSize(size_t inputSize) override;
+
+    StatusWith<std::size_t> compressData(ConstDataRange input, DataRange output) override;
+
+    StatusWith<std::size_t> decompressData(ConstDataRange input, DataRange output) override;
+
+    uint32_t getDictionaryVersion() const {
+        return _dictionaryVersion;
+    }
+
+private:
+    const std::string _dictionary;
+    const uint32_t _dictionaryVersion;
+    ZSTD_CDict* const _cdict;
+    ZSTD_DDict* const _ddict;
+};
+
 
 }  // namespace mongo
@@ -31,12 +31,18 @@
 
 #include "mongo/transport/service_executor_fixed.h"
 
+#include <fmt/format.h>
+#ifdef __linux__
+#include <sched.h>
+#endif
+
 #include "mongo/base/error_codes.h"
 #include "mongo/logv2/log.h"
 #include "mongo/transport/service_executor_gen.h"
 #include "mongo/transport/session.h"
 #include "mongo/transport/transport_layer.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/errno_util.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/testing_proctor.h"
 #include "mongo/util/thread_safety_context.h"
@@ -49,12 +55,15 @@ MONGO_FAIL_POINT_DEFINE(hangBeforeServiceExecutorFixedLastExecutorThreadReturns)
 
 namespace transport {
 namespace {
+using namespace fmt::literals;
+
 constexpr auto kExecutorName = "fixed"_sd;
 
 constexpr auto kThreadsRunning = "threadsRunning"_sd;
 constexpr auto kClientsInTotal = "clientsInTotal"_sd;
 constexpr auto kClientsRunning = "clientsRunning"_sd;
 constexpr auto kClientsWaiting = "clientsWaitingForData"_sd;
+constexpr auto kRunQueues = "runQueues"_sd;
 
 struct Handle {
     ~Handle() {
@@ -72,13 +81,54 @@ const auto serviceExecutorFixedRegisterer = ServiceContext::ConstructorActionReg
         auto limits = ThreadPool::Limits{};
         limits.minThreads = 0;
         limits.maxThreads = fixedServiceExecutorThreadLimit;
-        getHandle(ctx).ptr = std::make_shared<ServiceExecutorFixed>(ctx, std::move(limits));
+        getHandle(ctx).ptr = std::make_shared<ServiceExecutorFixed>(
+            ctx, std::move(limits), fixedServiceExecutorRunQueues, fixedServiceExecutorPinThreads);
     }};
+
+#ifdef __linux__
+/**
+ * Splits the CPUs this process may run on into numRunQueues contiguous slices, which keeps the
+ * threads of each queue on neighbouring cores and so, on most hosts, on the same NUMA node.
+ */
+std::vector<cpu_set_t> getRunQueueCpuSets(size_t numRunQueues) {
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        LOGV2_WARNING(5502122,
+                      "Failed to get the CPU affinity of the process, not pinning service executor "
+                      "threads",
+                      "error"_attr = errnoWithDescription());
+        return {};
+    }
+
+    std::vector<int> cpus;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &allowed)) {
+            cpus.push_back(cpu);
+        }
+    }
+
+    std::vector<cpu_set_t> cpuSets(numRunQueues);
+    for (size_t i = 0; i < numRunQueues; ++i) {
+        CPU_ZERO(&cpuSets[i]);
+    }
+    for (size_t i = 0; i < cpus.size(); ++i) {
+        CPU_SET(cpus[i], &cpuSets[i * numRunQueues / cpus.size()]);
+    }
+    for (size_t i = 0; i < numRunQueues; ++i) {
+        if (CPU_COUNT(&cpuSets[i]) == 0) {
+            // There are more queues than CPUs, so share them out in turn.
+            CPU_SET(cpus[i % cpus.size()], &cpuSets[i]);
+        }
+    }
+    return cpuSets;
+}
+#endif
 }  // namespace
 
 class ServiceExecutorFixed::ExecutorThreadContext {
 public:
-    ExecutorThreadContext(ServiceExecutorFixed* serviceExecutor);
+    ExecutorThreadContext(ServiceExecutorFixed* serviceExecutor, size_t runQueue);
     ~ExecutorThreadContext();
 
     ExecutorThreadContext(ExecutorThreadContext&&) = delete;
@@ -107,14 +157,23 @@ public:
         return _recursionDepth;
     }
 
+    const ServiceExecutorFixed* getExecutor() const {
+        return _executor;
+    }
+
+    size_t getRunQueue() const {
+        return _runQueue;
+    }
+
 private:
     ServiceExecutorFixed* const _executor;
+    const size_t _runQueue;
     int _recursionDepth = 0;
 };
 
 ServiceExecutorFixed::ExecutorThreadContext::ExecutorThreadContext(
-    ServiceExecutorFixed* serviceExecutor)
-    : _executor(serviceExecutor) {
+    ServiceExecutorFixed* serviceExecutor, size_t runQueue)
+    : _executor(serviceExecutor), _runQueue(runQueue) {
     _executor->_stats.threadsStarted.fetchAndAdd(1);
     hangAfterServiceExecutorFixedExecutorThreadsStart.pauseWhileSet();
 }
@@ -130,14 +189,55 @@ ServiceExecutorFixed::ExecutorThreadContext::~ExecutorThreadContext() {
 thread_local std::unique_ptr<ServiceExecutorFixed::ExecutorThreadContext>
     ServiceExecutorFixed::_executorContext;
 
-ServiceExecutorFixed::ServiceExecutorFixed(ServiceContext* ctx, ThreadPool::Limits limits)
+ServiceExecutorFixed::ServiceExecutorFixed(ServiceContext* ctx,
+                                           ThreadPool::Limits limits,
+                                           size_t numRunQueues,
+                                           bool pinThreads)
     : _svcCtx{ctx}, _options(std::move(limits)) {
     _options.poolName = "ServiceExecutorFixed";
-    _options.onCreateThread = [this](const auto&) {
-        _executorContext = std::make_unique<ExecutorThreadContext>(this);
-    };
+    invariant(numRunQueues > 0);
+
+#ifdef __linux__
+    auto cpuSets = pinThreads ? getRunQueueCpuSets(numRunQueues) : std::vector<cpu_set_t>{};
+#else
+    if (pinThreads) {
+        LOGV2_WARNING(5502123, "Pinning service executor threads is only supported on Linux");
+    }
+#endif
+
+    for (size_t i = 0; i < numRunQueues; ++i) {
+        // Every queue gets an even share of the threads. Note that the first queue also runs the
+        // ingress reactor on one of its threads.
+        auto options = _options;
+        if (numRunQueues > 1) {
+            options.poolName = "{}-{}"_format(_options.poolName, i);
+            options.minThreads = _options.minThreads / numRunQueues;
+            options.maxThreads = std::max<size_t>(_options.maxThreads / numRunQueues, 2);
+        }
 
-    _threadPool = std::make_shared<ThreadPool>(_options);
+        std::function<void()> pinThread;
+#ifdef __linux__
+        if (i < cpuSets.size()) {
+            pinThread = [i, cpuSet = cpuSets[i]] {
+                if (sched_setaffinity(0, sizeof(cpuSet), &cpuSet) != 0) {
+                    LOGV2_WARNING(5502124,
+                                  "Failed to pin service executor thread",
+                                  "runQueue"_attr = i,
+                                  "error"_attr = errnoWithDescription());
+                }
+            };
+        }
+#endif
+        options.onCreateThread = [this, i, pinThread](const auto&) {
+            _executorContext = std::make_unique<ExecutorThreadContext>(this, i);
+            if (pinThread) {
+                pinThread();
+            }
+        };
+
+        _runQueues.push_back(std::make_unique<RunQueue>());
+        _runQueues.back()->threadPool = std::make_shared<ThreadPool>(std::move(options));
+    }
 }
 
 ServiceExecutorFixed::~ServiceExecutorFixed() {
@@ -163,8 +263,12 @@ void ServiceExecutorFixed::join() noexcept {
     // We only can join when we have joined all of our tasks and canceled all of our sessions.  This
     // thread pool doesn't get to refuse work over its lifetime. It's possible that tasks are stiil
     // blocking. If so, we block until they finish here.
-    _threadPool->shutdown();
-    _threadPool->join();
+    for (auto& runQueue : _runQueues) {
+        runQueue->threadPool->shutdown();
+    }
+    for (auto& runQueue : _runQueues) {
+        runQueue->threadPool->join();
+    }
 
     invariant(_threadsRunning() == 0);
     invariant(_tasksRunning() == 0);
@@ -196,7 +300,9 @@ Status ServiceExecutorFixed::start() {
                 "Starting fixed thread-pool service executor",
                 "name"_attr = _options.poolName);
 
-    _threadPool->startup();
+    for (auto& runQueue : _runQueues) {
+        runQueue->threadPool->startup();
+    }
 
     if (!_svcCtx) {
         // For some tests, we do not have a ServiceContext.
@@ -213,7 +319,7 @@ Status ServiceExecutorFixed::start() {
 
     auto reactor = tl->getReactor(TransportLayer::WhichReactor::kIngress);
     invariant(reactor);
-    _threadPool->schedule([this, reactor](Status) {
+    _runQueues.front()->threadPool->schedule([this, reactor](Status) {
         {
             // Check to make sure we haven't been shutdown already. Note that there is still a brief
             // race that immediately follows this check. ASIOReactor::stop() is not permanent, thus
@@ -373,7 +479,8 @@ Status ServiceExecutorFixed::scheduleTask(Task task, ScheduleFlags flags) try {
 
     hangBeforeSchedulingServiceExecutorFixedTask.pauseWhileSet();
 
-    _threadPool->schedule([this, task = std::move(task)](Status status) mutable {
+    auto& runQueue = *_runQueues[_chooseRunQueue(_currentRunQueue())];
+    runQueue.threadPool->schedule([this, task = std::move(task)](Status status) mutable {
         invariant(status);
 
         _executorContext->run([&] { task(); });
@@ -385,6 +492,10 @@ Status ServiceExecutorFixed::scheduleTask(Task task, ScheduleFlags flags) try {
 }
 
 void ServiceExecutorFixed::_schedule(OutOfLineExecutor::Task task) noexcept {
+    _scheduleOn(_currentRunQueue(), std::move(task));
+}
+
+void ServiceExecutorFixed::_scheduleOn(size_t homeQueue, OutOfLineExecutor::Task task) noexcept {
     {
         auto lk = stdx::unique_lock(_mutex);
         if (_state != State::kRunning) {
@@ -397,11 +508,49 @@ void ServiceExecutorFixed::_schedule(OutOfLineExecutor::Task task) noexcept {
         _stats.tasksScheduled.fetchAndAdd(1);
     }
 
-    _threadPool->schedule([this, task = std::move(task)](Status status) mutable {
+    auto& runQueue = *_runQueues[_chooseRunQueue(homeQueue)];
+    runQueue.threadPool->schedule([this, task = std::move(task)](Status status) mutable {
         _executorContext->run([&] { task(std::move(status)); });
     });
 }
 
+size_t ServiceExecutorFixed::_currentRunQueue() {
+    if (_runQueues.size() == 1) {
+        return 0;
+    }
+
+    if (_executorContext && _executorContext->getExecutor() == this) {
+        return _executorContext->getRunQueue();
+    }
+
+    return _nextRunQueue.fetchAndAddRelaxed(1) % _runQueues.size();
+}
+
+size_t ServiceExecutorFixed::_chooseRunQueue(size_t homeQueue) {
+    auto& home = *_runQueues[homeQueue];
+    if (_runQueues.size() > 1 && home.threadPool->getStats().numPendingTasks > 0) {
+        auto leastLoaded = homeQueue;
+        size_t leastPending = std::numeric_limits<size_t>::max();
+        for (size_t i = 0; i < _runQueues.size(); ++i) {
+            auto pending = _runQueues[i]->threadPool->getStats().numPendingTasks;
+            if (pending < leastPending) {
+                leastLoaded = i;
+                leastPending = pending;
+            }
+        }
+
+        if (leastPending == 0) {
+            auto& thief = *_runQueues[leastLoaded];
+            thief.tasksScheduled.fetchAndAddRelaxed(1);
+            thief.tasksStolen.fetchAndAddRelaxed(1);
+            return leastLoaded;
+        }
+    }
+
+    home.tasksScheduled.fetchAndAddRelaxed(1);
+    return homeQueue;
+}
+
 size_t ServiceExecutorFixed::getRunningThreads() const {
     return _threadsRunning();
 }
@@ -429,21 +578,31 @@ void ServiceExecutorFixed::runOnDataAvailable(const SessionHandle& session,
         _stats.waitersStarted.fetchAndAdd(1);
     }
 
-    session->asyncWaitForData()
-        .thenRunOn(shared_from_this())
-        .getAsync([this, anchor = shared_from_this(), it](Status status) mutable {
-            Waiter waiter;
-            {
-                // Remove our waiter from the list.
-                auto lk = stdx::unique_lock(_mutex);
-                waiter = std::exchange(*it, {});
-                _waiters.erase(it);
+    // Wake the session up on its home queue so that its tasks keep running on the same threads.
+    const auto homeQueue = session->id() % _runQueues.size();
+    auto onDataAvailable = [this, anchor = shared_from_this(), it](Status status) mutable {
+        Waiter waiter;
+        {
+            // Remove our waiter from the list.
+            auto lk = stdx::unique_lock(_mutex);
+            waiter = std::exchange(*it, {});
+            _waiters.erase(it);
 
-                _stats.waitersEnded.fetchAndAdd(1);
-            }
+            _stats.waitersEnded.fetchAndAdd(1);
+        }
+
+        waiter.session.reset();
+        waiter.onCompletionCallback(std::move(status));
+    };
 
-            waiter.session.reset();
-            waiter.onCompletionCallback(std::move(status));
+    session->asyncWaitForData().getAsync(
+        [this, homeQueue, onDataAvailable = std::move(onDataAvailable)](Status status) mutable {
+            _scheduleOn(homeQueue,
+                        [status = std::move(status), onDataAvailable = std::move(onDataAvailable)](
+                            Status scheduleStatus) mutable {
+                            onDataAvailable(scheduleStatus.isOK() ? std::move(status)
+                                                                  : std::move(scheduleStatus));
+                        });
         });
 }
 
@@ -455,6 +614,20 @@ void ServiceExecutorFixed::appendStats(BSONObjBuilder* bob) const {
     subbob.append(kClientsInTotal, static_cast<int>(_tasksTotal()));
     subbob.append(kClientsRunning, static_cast<int>(_tasksRunning()));
     subbob.append(kClientsWaiting, static_cast<int>(_tasksWaiting()));
+
+    if (_runQueues.size() > 1) {
+        BSONArrayBuilder runQueues(subbob.subarrayStart(kRunQueues));
+        for (auto& runQueue : _runQueues) {
+            auto stats = runQueue->threadPool->getStats();
+            BSONObjBuilder runQueueBob(runQueues.subobjStart());
+            runQueueBob.append(kThreadsRunning, static_cast<int>(stats.numThreads));
+            runQueueBob.append("depth", static_cast<int>(stats.numPendingTasks));
+            runQueueBob.append("tasksScheduled",
+                               static_cast<long long>(runQueue->tasksScheduled.loadRelaxed()));
+            runQueueBob.append("tasksStolen",
+                               static_cast<long long>(runQueue->tasksStolen.loadRelaxed()));
+        }
+    }
 }
 
 int ServiceExecutorFixed::getRecursionDepthForExecutorThread() const {
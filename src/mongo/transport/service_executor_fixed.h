@@ -31,6 +31,7 @@
 
 #include <boost/optional.hpp>
 #include <memory>
+#include <vector>
 
 #include "mongo/base/status.h"
 #include "mongo/db/service_context.h"
@@ -52,6 +53,12 @@ namespace transport {
  * A service executor that uses a fixed (configurable) number of threads to execute tasks.
  * This executor always yields before executing scheduled tasks, and never yields before scheduling
  * new tasks (i.e., `ScheduleFlags::kMayYieldBeforeSchedule` is a no-op for this executor).
+ *
+ * The threads may be split across several run queues, each with its own thread pool. A task
+ * scheduled from an executor thread stays on that thread's queue, and a session that wakes up with
+ * data to read goes back to its home queue, so that the work for a client tends to stay on the same
+ * threads (and, when they are pinned, the same cores). A task is given to the least loaded queue
+ * instead when its own queue already has a backlog, which is counted as a steal.
  */
 class ServiceExecutorFixed final : public ServiceExecutor,
                                    public std::enable_shared_from_this<ServiceExecutorFixed> {
@@ -61,9 +68,12 @@ class ServiceExecutorFixed final : public ServiceExecutor,
         Status(ErrorCodes::ServiceExecutorInShutdown, "ServiceExecutorFixed is not running");
 
 public:
-    explicit ServiceExecutorFixed(ServiceContext* ctx, ThreadPool::Limits limits);
-    explicit ServiceExecutorFixed(ThreadPool::Limits limits)
-        : ServiceExecutorFixed(nullptr, std::move(limits)) {}
+    explicit ServiceExecutorFixed(ServiceContext* ctx,
+                                  ThreadPool::Limits limits,
+                                  size_t numRunQueues = 1,
+                                  bool pinThreads = false);
+    explicit ServiceExecutorFixed(ThreadPool::Limits limits, size_t numRunQueues = 1)
+        : ServiceExecutorFixed(nullptr, std::move(limits), numRunQueues) {}
     virtual ~ServiceExecutorFixed();
 
     static ServiceExecutorFixed* get(ServiceContext* ctx);
@@ -101,6 +111,19 @@ private:
     void _checkForShutdown(WithLock);
     void _beginShutdown(WithLock);
     void _schedule(OutOfLineExecutor::Task task) noexcept;
+    void _scheduleOn(size_t homeQueue, OutOfLineExecutor::Task task) noexcept;
+
+    /**
+     * Returns the queue that a task should be given to by the current thread: its own queue for an
+     * executor thread and the next one in turn for any other thread.
+     */
+    size_t _currentRunQueue();
+
+    /**
+     * Returns homeQueue, or the least loaded queue if homeQueue has pending tasks and that queue
+     * has none.
+     */
+    size_t _chooseRunQueue(size_t homeQueue);
 
     auto _threadsRunning() const {
         auto ended = _stats.threadsEnded.load();
@@ -157,7 +180,16 @@ private:
     bool _isJoined = false;
 
     ThreadPool::Options _options;
-    std::shared_ptr<ThreadPool> _threadPool;
+
+    struct RunQueue {
+        std::shared_ptr<ThreadPool> threadPool;
+
+        // The tasks given to this queue, and how many of those had another home queue
+        AtomicWord<size_t> tasksScheduled{0};
+        AtomicWord<size_t> tasksStolen{0};
+    };
+    std::vector<std::unique_ptr<RunQueue>> _runQueues;
+    AtomicWord<size_t> _nextRunQueue{0};
 
     struct Waiter {
         SessionHandle session;
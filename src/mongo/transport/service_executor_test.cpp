@@ -47,6 +47,7 @@
 #include "mongo/unittest/barrier.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/concurrency/notification.h"
 #include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/future.h"
@@ -177,10 +178,10 @@ public:
     public:
         ServiceExecutorHandle(const ServiceExecutorHandle&) = delete;
         ServiceExecutorHandle(ServiceExecutorHandle&&) = delete;
-        ServiceExecutorHandle() {
+        explicit ServiceExecutorHandle(size_t numRunQueues = 1) {
             ThreadPool::Limits limits;
-            limits.minThreads = limits.maxThreads = kNumExecutorThreads;
-            _executor = std::make_shared<ServiceExecutorFixed>(std::move(limits));
+            limits.minThreads = limits.maxThreads = kNumExecutorThreads * numRunQueues;
+            _executor = std::make_shared<ServiceExecutorFixed>(std::move(limits), numRunQueues);
         }
 
         ~ServiceExecutorHandle() {
@@ -249,6 +250,37 @@ TEST_F(ServiceExecutorFixedFixture, BasicTaskRuns) {
     barrier->countDownAndWait();
 }
 
+TEST_F(ServiceExecutorFixedFixture, TasksRunOnSeveralRunQueues) {
+    constexpr size_t kNumRunQueues = 3;
+    constexpr int kNumTasks = 100;
+    auto executorHandle = ServiceExecutorHandle(kNumRunQueues);
+    executorHandle.start();
+
+    AtomicWord<int> tasksRun{0};
+    Notification<void> allTasksRun;
+    for (int i = 0; i < kNumTasks; ++i) {
+        ASSERT_OK(executorHandle->scheduleTask(
+            [&] {
+                if (tasksRun.addAndFetch(1) == kNumTasks) {
+                    allTasksRun.set();
+                }
+            },
+            ServiceExecutor::kEmptyFlags));
+    }
+    allTasksRun.get();
+
+    BSONObjBuilder bob;
+    executorHandle->appendStats(&bob);
+    auto runQueues = bob.obj()["fixed"]["runQueues"].Array();
+    ASSERT_EQ(runQueues.size(), kNumRunQueues);
+
+    long long tasksScheduled = 0;
+    for (auto&& runQueue : runQueues) {
+        tasksScheduled += runQueue["tasksScheduled"].numberLong();
+    }
+    ASSERT_EQ(tasksScheduled, kNumTasks);
+}
+
 TEST_F(ServiceExecutorFixedFixture, RecursiveTask) {
     auto executorHandle = ServiceExecutorHandle();
     executorHandle.start();
@@ -38,6 +38,7 @@
 #include "mongo/transport/baton.h"
 #include "mongo/transport/ssl_connection_context.h"
 #include "mongo/transport/transport_layer_asio.h"
+#include "mongo/transport/transport_options_gen.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/net/socket_utils.h"
 #ifdef MONGO_CONFIG_SSL
@@ -79,6 +80,8 @@ class TransportLayerASIO::ASIOSession final : public Session {
     ASIOSession(const ASIOSession&) = delete;
     ASIOSession& operator=(const ASIOSession&) = delete;
 
+    static constexpr auto kHeaderSize = sizeof(MSGHEADER::Value);
+
 public:
     using Endpoint = asio::generic::stream_protocol::endpoint;
 
@@ -186,6 +189,10 @@ public:
 
     Status waitForData() noexcept override try {
         ensureSync();
+        if (_readAheadBegin != _readAheadEnd) {
+            return Status::OK();
+        }
+
         asio::error_code ec;
         getSocket().wait(asio::ip::tcp::socket::wait_read, ec);
         return errorCodeToStatus(ec);
@@ -195,6 +202,10 @@ public:
 
     Future<void> asyncWaitForData() noexcept override try {
         ensureAsync();
+        if (_readAheadBegin != _readAheadEnd) {
+            return Future<void>::makeReady();
+        }
+
         return getSocket().async_wait(asio::ip::tcp::socket::wait_read, UseFuture{});
     } catch (const DBException& ex) {
         return ex.toStatus();
@@ -437,9 +448,44 @@ private:
         return _socket;
     }
 
+    Status validateMessageLength(size_t msgLen) {
+        if (msgLen < kHeaderSize || msgLen > MaxMessageSizeBytes) {
+            StringBuilder sb;
+            sb << "recv(): message msgLen " << msgLen << " is invalid. "
+               << "Min " << kHeaderSize << " Max: " << MaxMessageSizeBytes;
+            const auto str = sb.str();
+            LOGV2(4615638,
+                  "recv(): message msgLen {msgLen} is invalid. Min: {min} Max: {max}",
+                  "recv(): message mstLen is invalid.",
+                  "msgLen"_attr = msgLen,
+                  "min"_attr = kHeaderSize,
+                  "max"_attr = MaxMessageSizeBytes);
+
+            return Status(ErrorCodes::ProtocolError, str);
+        }
+
+        return Status::OK();
+    }
+
     Future<Message> sourceMessageImpl(const BatonHandle& baton = nullptr) {
-        static constexpr auto kHeaderSize = sizeof(MSGHEADER::Value);
+        if (_readAheadBuffer) {
+            return sourceMessageFromReadAhead(baton);
+        }
+
+        return sourceMessageDirect(baton).then([this](Message message) {
+            // The first message takes care of any ingress TLS handshake and HTTP detection, after
+            // which the rest can be read ahead.
+            if (auto readAheadBytes = size_t(gTransportLayerReadAheadBytes); readAheadBytes > 0) {
+                _readAheadBuffer = SharedBuffer::allocate(std::max(readAheadBytes, kHeaderSize));
+            }
+            return message;
+        });
+    }
 
+    /**
+     * Sources a message with one read for its header and one for its body.
+     */
+    Future<Message> sourceMessageDirect(const BatonHandle& baton) {
         auto headerBuffer = SharedBuffer::allocate(kHeaderSize);
         auto ptr = headerBuffer.get();
         return read(asio::buffer(ptr, kHeaderSize), baton)
@@ -449,19 +495,8 @@ private:
                 }
 
                 const auto msgLen = size_t(MSGHEADER::View(headerBuffer.get()).getMessageLength());
-                if (msgLen < kHeaderSize || msgLen > MaxMessageSizeBytes) {
-                    StringBuilder sb;
-                    sb << "recv(): message msgLen " << msgLen << " is invalid. "
-                       << "Min " << kHeaderSize << " Max: " << MaxMessageSizeBytes;
-                    const auto str = sb.str();
-                    LOGV2(4615638,
-                          "recv(): message msgLen {msgLen} is invalid. Min: {min} Max: {max}",
-                          "recv(): message mstLen is invalid.",
-                          "msgLen"_attr = msgLen,
-                          "min"_attr = kHeaderSize,
-                          "max"_attr = MaxMessageSizeBytes);
-
-                    return Future<Message>::makeReady(Status(ErrorCodes::ProtocolError, str));
+                if (auto status = validateMessageLength(msgLen); !status.isOK()) {
+                    return Future<Message>::makeReady(std::move(status));
                 }
 
                 if (msgLen == kHeaderSize) {
@@ -486,6 +521,113 @@ private:
             });
     }
 
+    /**
+     * Sources a message out of _readAheadBuffer, refilling it with as many bytes as the socket has
+     * available so that a small message, and any pipelined behind it, usually costs a single read.
+     * The remainder of a message that does not fit in the buffer is read directly into the message.
+     */
+    Future<Message> sourceMessageFromReadAhead(const BatonHandle& baton) {
+        auto buffered = _readAheadEnd - _readAheadBegin;
+        auto haveHeader = buffered >= kHeaderSize
+            ? Future<void>::makeReady()
+            : fillReadAheadBuffer(kHeaderSize - buffered, baton);
+
+        return std::move(haveHeader).then([this, baton]() -> Future<Message> {
+            const char* header = _readAheadBuffer.get() + _readAheadBegin;
+            const auto msgLen = size_t(MSGHEADER::ConstView(header).getMessageLength());
+            if (auto status = validateMessageLength(msgLen); !status.isOK()) {
+                return std::move(status);
+            }
+
+            auto buffer = SharedBuffer::allocate(msgLen);
+            const auto fromReadAhead = std::min(msgLen, _readAheadEnd - _readAheadBegin);
+            memcpy(buffer.get(), header, fromReadAhead);
+            _readAheadBegin += fromReadAhead;
+
+            auto haveMessage = fromReadAhead == msgLen
+                ? Future<void>::makeReady()
+                : read(asio::buffer(buffer.get() + fromReadAhead, msgLen - fromReadAhead), baton);
+            return std::move(haveMessage)
+                .then([this, buffer = std::move(buffer), msgLen]() mutable {
+                    if (_isIngressSession) {
+                        networkCounter.hitPhysicalIn(msgLen);
+                    }
+                    return Message(std::move(buffer));
+                });
+        });
+    }
+
+    /**
+     * Moves the unread bytes in _readAheadBuffer to its front and then reads at least minBytes,
+     * and as many more as fit and are available, in after them.
+     */
+    Future<void> fillReadAheadBuffer(size_t minBytes, const BatonHandle& baton) {
+        const auto buffered = _readAheadEnd - _readAheadBegin;
+        if (_readAheadBegin > 0) {
+            memmove(_readAheadBuffer.get(), _readAheadBuffer.get() + _readAheadBegin, buffered);
+            _readAheadBegin = 0;
+            _readAheadEnd = buffered;
+        }
+
+        auto buffer = asio::buffer(_readAheadBuffer.get() + _readAheadEnd,
+                                   _readAheadBuffer.capacity() - _readAheadEnd);
+        auto doRead = [&](auto& stream) {
+            return opportunisticReadAtLeast(stream, buffer, minBytes, baton);
+        };
+#ifdef MONGO_CONFIG_SSL
+        auto bytesRead = _sslSocket ? doRead(*_sslSocket) : doRead(_socket);
+#else
+        auto bytesRead = doRead(_socket);
+#endif
+        return std::move(bytesRead).then([this](size_t size) { _readAheadEnd += size; });
+    }
+
+    /**
+     * Like opportunisticRead(), but completes as soon as minBytes have been read into buffer and
+     * returns the number of bytes read, which may take up all of buffer.
+     */
+    template <typename Stream>
+    Future<size_t> opportunisticReadAtLeast(Stream& stream,
+                                            asio::mutable_buffer buffer,
+                                            size_t minBytes,
+                                            const BatonHandle& baton) {
+        std::error_code ec;
+        size_t size = 0;
+        do {
+            size += asio::read(stream, buffer + size, asio::transfer_at_least(minBytes - size), ec);
+        } while (ec == asio::error::interrupted);  // retry syscall EINTR
+
+        if (((ec == asio::error::would_block) || (ec == asio::error::try_again)) &&
+            (_blockingMode == Async)) {
+            auto addSize = [size](size_t more) { return size + more; };
+            auto asyncBuffer = buffer + size;
+            auto asyncMinBytes = minBytes - size;
+
+            if (auto networkingBaton = baton ? baton->networking() : nullptr;
+                networkingBaton && networkingBaton->canWait()) {
+                return networkingBaton->addSession(*this, NetworkingBaton::Type::In)
+                    .onError([](Status error) {
+                        if (ErrorCodes::isShutdownError(error)) {
+                            // As in opportunisticRead(), fall back to asio::async_read() below.
+                            return Status::OK();
+                        }
+
+                        return error;
+                    })
+                    .then([&stream, asyncBuffer, asyncMinBytes, baton, this] {
+                        return opportunisticReadAtLeast(stream, asyncBuffer, asyncMinBytes, baton);
+                    })
+                    .then(addSize);
+            }
+
+            return asio::async_read(
+                       stream, asyncBuffer, asio::transfer_at_least(asyncMinBytes), UseFuture{})
+                .then(addSize);
+        } else {
+            return futurize(ec, size);
+        }
+    }
+
     template <typename MutableBufferSequence>
     Future<void> read(const MutableBufferSequence& buffers, const BatonHandle& baton = nullptr) {
         // TODO SERVER-47229 Guard active ops for cancelation here.
@@ -854,6 +996,12 @@ private:
 
     TransportLayerASIO* const _tl;
     bool _isIngressSession;
+
+    // Holds the bytes in [_readAheadBegin, _readAheadEnd) that were read off the socket but not yet
+    // sourced as a message. It is only allocated when transportLayerReadAheadBytes is set.
+    SharedBuffer _readAheadBuffer;
+    size_t _readAheadBegin = 0;
+    size_t _readAheadEnd = 0;
 };
 
 }  // namespace transport
@@ -94,23 +94,34 @@ ThreadPool::Options cleanUpOptions(ThreadPool::Options&& options) {
                     "minThreads"_attr = options.minThreads,
                     "maxThreads"_attr = options.maxThreads);
     }
+    if (options.workStealing && options.minThreads != options.maxThreads) {
+        LOGV2_FATAL(5502127,
+                    "Cannot create work-stealing pool {poolName} with a minimum number of threads "
+                    "of {minThreads} which differs from the maximum of {maxThreads}",
+                    "Cannot create work-stealing pool with a minimum number of threads which "
+                    "differs from the maximum",
+                    "poolName"_attr = options.poolName,
+                    "minThreads"_attr = options.minThreads,
+                    "maxThreads"_attr = options.maxThreads);
+    }
     return {std::move(options)};
 }
 
 }  // namespace
 
 
-// Public functions forwarded from ThreadPool.
-class ThreadPool::Impl {
+// Implementation of ThreadPool in which all of the threads take tasks from one shared queue.
+class ThreadPool::SharedQueueImpl final : public ThreadPool::Impl {
 public:
-    explicit Impl(Options options);
-    ~Impl();
-    void startup();
-    void shutdown();
-    void join();
-    void schedule(Task task);
-    void waitForIdle();
-    Stats getStats() const;
+    explicit SharedQueueImpl(Options options);
+    ~SharedQueueImpl() override;
+    void startup() override;
+    void shutdown() override;
+    void join() override;
+    void schedule(Task task) override;
+    void scheduleBatch(std::vector<Task> tasks) override;
+    void waitForIdle() override;
+    Stats getStats() const override;
 
 private:
     /**
@@ -220,9 +231,9 @@ private:
     Date_t _lastFullUtilizationDate;
 };
 
-ThreadPool::Impl::Impl(Options options) : _options(cleanUpOptions(std::move(options))) {}
+ThreadPool::SharedQueueImpl::SharedQueueImpl(Options options) : _options(std::move(options)) {}
 
-ThreadPool::Impl::~Impl() {
+ThreadPool::SharedQueueImpl::~SharedQueueImpl() {
     stdx::unique_lock<Latch> lk(_mutex);
     _shutdown_inlock();
     if (_state != shutdownComplete) {
@@ -236,7 +247,7 @@ ThreadPool::Impl::~Impl() {
     invariant(_pendingTasks.empty());
 }
 
-void ThreadPool::Impl::startup() {
+void ThreadPool::SharedQueueImpl::startup() {
     stdx::lock_guard<Latch> lk(_mutex);
     if (_state != preStart) {
         LOGV2_FATAL(28698,
@@ -252,12 +263,12 @@ void ThreadPool::Impl::startup() {
     }
 }
 
-void ThreadPool::Impl::shutdown() {
+void ThreadPool::SharedQueueImpl::shutdown() {
     stdx::lock_guard<Latch> lk(_mutex);
     _shutdown_inlock();
 }
 
-void ThreadPool::Impl::_shutdown_inlock() {
+void ThreadPool::SharedQueueImpl::_shutdown_inlock() {
     switch (_state) {
         case preStart:
         case running:
@@ -272,12 +283,12 @@ void ThreadPool::Impl::_shutdown_inlock() {
     MONGO_UNREACHABLE;
 }
 
-void ThreadPool::Impl::join() {
+void ThreadPool::SharedQueueImpl::join() {
     stdx::unique_lock<Latch> lk(_mutex);
     _join_inlock(&lk);
 }
 
-void ThreadPool::Impl::_joinRetired_inlock() {
+void ThreadPool::SharedQueueImpl::_joinRetired_inlock() {
     while (!_retiredThreads.empty()) {
         auto& t = _retiredThreads.front();
         t.join();
@@ -287,7 +298,7 @@ void ThreadPool::Impl::_joinRetired_inlock() {
     }
 }
 
-void ThreadPool::Impl::_join_inlock(stdx::unique_lock<Latch>* lk) {
+void ThreadPool::SharedQueueImpl::_join_inlock(stdx::unique_lock<Latch>* lk) {
     _stateChange.wait(*lk, [this] { return _state != preStart && _state != running; });
     if (_state != joinRequired) {
         LOGV2_FATAL(28700,
@@ -315,7 +326,7 @@ void ThreadPool::Impl::_join_inlock(stdx::unique_lock<Latch>* lk) {
     _setState_inlock(shutdownComplete);
 }
 
-void ThreadPool::Impl::_drainPendingTasks() {
+void ThreadPool::SharedQueueImpl::_drainPendingTasks() {
     // Tasks cannot be run inline because they can create OperationContexts and the join() caller
     // may already have one associated with the thread.
     stdx::thread cleanThread = stdx::thread([&] {
@@ -331,7 +342,7 @@ void ThreadPool::Impl::_drainPendingTasks() {
     cleanThread.join();
 }
 
-void ThreadPool::Impl::schedule(Task task) {
+void ThreadPool::SharedQueueImpl::schedule(Task task) {
     stdx::unique_lock<Latch> lk(_mutex);
 
     switch (_state) {
@@ -366,14 +377,58 @@ void ThreadPool::Impl::schedule(Task task) {
     _workAvailable.notify_one();
 }
 
-void ThreadPool::Impl::waitForIdle() {
+void ThreadPool::SharedQueueImpl::scheduleBatch(std::vector<Task> tasks) {
+    stdx::unique_lock<Latch> lk(_mutex);
+
+    switch (_state) {
+        case joinRequired:
+        case joining:
+        case shutdownComplete: {
+            auto status =
+                Status(ErrorCodes::ShutdownInProgress,
+                       "Shutdown of thread pool {} in progress"_format(_options.poolName));
+
+            lk.unlock();
+            for (auto& task : tasks) {
+                task(status);
+            }
+            return;
+        } break;
+
+        case preStart:
+        case running:
+            break;
+        default:
+            MONGO_UNREACHABLE;
+    }
+    const auto numTasks = tasks.size();
+    for (auto& task : tasks) {
+        _pendingTasks.emplace_back(std::move(task));
+    }
+    if (_state == preStart || numTasks == 0) {
+        return;
+    }
+    for (size_t i = 0; i < numTasks && _numIdleThreads < _pendingTasks.size(); ++i) {
+        _startWorkerThread_inlock();
+    }
+    if (_numIdleThreads <= _pendingTasks.size()) {
+        _lastFullUtilizationDate = Date_t::now();
+    }
+    if (numTasks == 1) {
+        _workAvailable.notify_one();
+    } else {
+        _workAvailable.notify_all();
+    }
+}
+
+void ThreadPool::SharedQueueImpl::waitForIdle() {
     stdx::unique_lock<Latch> lk(_mutex);
     // True when there are no `_pendingTasks` and all `_threads` are idle.
     auto isIdle = [this] { return _pendingTasks.empty() && _numIdleThreads >= _threads.size(); };
     _poolIsIdle.wait(lk, isIdle);
 }
 
-ThreadPool::Stats ThreadPool::Impl::getStats() const {
+ThreadPool::Stats ThreadPool::SharedQueueImpl::getStats() const {
     stdx::lock_guard<Latch> lk(_mutex);
     Stats result;
     result.options = _options;
@@ -384,7 +439,7 @@ ThreadPool::Stats ThreadPool::Impl::getStats() const {
     return result;
 }
 
-void ThreadPool::Impl::_workerThreadBody(const std::string& threadName) noexcept {
+void ThreadPool::SharedQueueImpl::_workerThreadBody(const std::string& threadName) noexcept {
     setThreadName(threadName);
     if (_options.onCreateThread)
         _options.onCreateThread(threadName);
@@ -403,7 +458,7 @@ void ThreadPool::Impl::_workerThreadBody(const std::string& threadName) noexcept
                 "poolName"_attr = _options.poolName);
 }
 
-void ThreadPool::Impl::_consumeTasks() {
+void ThreadPool::SharedQueueImpl::_consumeTasks() {
     stdx::unique_lock<Latch> lk(_mutex);
     while (_state == running) {
         if (!_pendingTasks.empty()) {
@@ -505,7 +560,7 @@ void ThreadPool::Impl::_consumeTasks() {
     _retiredThreads.splice(_retiredThreads.end(), _threads, pos);
 }
 
-void ThreadPool::Impl::_doOneTask(stdx::unique_lock<Latch>* lk) noexcept {
+void ThreadPool::SharedQueueImpl::_doOneTask(stdx::unique_lock<Latch>* lk) noexcept {
     invariant(!_pendingTasks.empty());
     LOGV2_DEBUG(23109,
                 3,
@@ -531,7 +586,7 @@ void ThreadPool::Impl::_doOneTask(stdx::unique_lock<Latch>* lk) noexcept {
     }
 }
 
-void ThreadPool::Impl::_startWorkerThread_inlock() {
+void ThreadPool::SharedQueueImpl::_startWorkerThread_inlock() {
     switch (_state) {
         case preStart:
             LOGV2_DEBUG(
@@ -583,7 +638,7 @@ void ThreadPool::Impl::_startWorkerThread_inlock() {
     }
 }
 
-void ThreadPool::Impl::_setState_inlock(const LifecycleState newState) {
+void ThreadPool::SharedQueueImpl::_setState_inlock(const LifecycleState newState) {
     if (newState == _state) {
         return;
     }
@@ -594,7 +649,14 @@ void ThreadPool::Impl::_setState_inlock(const LifecycleState newState) {
 // ========================================
 // ThreadPool public functions that simply forward to the `_impl`.
 
-ThreadPool::ThreadPool(Options options) : _impl{std::make_unique<Impl>(std::move(options))} {}
+ThreadPool::ThreadPool(Options options) {
+    options = cleanUpOptions(std::move(options));
+    if (options.workStealing) {
+        _impl = _makeWorkStealingImpl(std::move(options));
+    } else {
+        _impl = std::make_unique<SharedQueueImpl>(std::move(options));
+    }
+}
 
 ThreadPool::~ThreadPool() = default;
 
@@ -614,6 +676,10 @@ void ThreadPool::schedule(Task task) {
     _impl->schedule(std::move(task));
 }
 
+void ThreadPool::scheduleBatch(std::vector<Task> tasks) {
+    _impl->scheduleBatch(std::move(tasks));
+}
+
 void ThreadPool::waitForIdle() {
     _impl->waitForIdle();
 }
@@ -32,6 +32,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "mongo/stdx/thread.h"
 #include "mongo/util/concurrency/thread_pool_interface.h"
@@ -100,6 +101,16 @@ public:
         // a thread.
         Milliseconds maxIdleThreadAge = Seconds{30};
 
+        // If true, each thread in the pool takes its tasks from its own queue and steals from the
+        // queues of the other threads once its own is empty, rather than every thread taking
+        // tasks from one queue shared by the whole pool. This reduces contention when tasks are
+        // short and scheduled by many threads at once. Tasks scheduled by a thread of the pool
+        // go to that thread's queue, and tasks scheduled from elsewhere are spread round-robin.
+        //
+        // A work-stealing pool has a fixed number of threads, all started by startup(), so
+        // minThreads must equal maxThreads, and maxIdleThreadAge is ignored.
+        bool workStealing = false;
+
         /** If callable, called before each worker thread begins consuming tasks. */
         std::function<void(const std::string&)> onCreateThread;
 
@@ -144,6 +155,12 @@ public:
     // from OutOfLineExecutor (base of ThreadPoolInterface)
     void schedule(Task task) override;
 
+    /**
+     * Schedules all of "tasks" as if by calling schedule() on each of them in order, but waking
+     * the threads of the pool only once.
+     */
+    void scheduleBatch(std::vector<Task> tasks);
+
     // from ThreadPoolInterface
     void startup() override;
     void shutdown() override;
@@ -167,7 +184,27 @@ public:
     Stats getStats() const;
 
 private:
-    class Impl;
+    /**
+     * The public functions of ThreadPool forward to one of the implementations of this interface,
+     * chosen by Options::workStealing.
+     */
+    class Impl {
+    public:
+        virtual ~Impl() = default;
+        virtual void startup() = 0;
+        virtual void shutdown() = 0;
+        virtual void join() = 0;
+        virtual void schedule(Task task) = 0;
+        virtual void scheduleBatch(std::vector<Task> tasks) = 0;
+        virtual void waitForIdle() = 0;
+        virtual Stats getStats() const = 0;
+    };
+
+    class SharedQueueImpl;
+    class WorkStealingImpl;
+
+    static std::unique_ptr<Impl> _makeWorkStealingImpl(Options options);
+
     std::unique_ptr<Impl> _impl;
 };
 
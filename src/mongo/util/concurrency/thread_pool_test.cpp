@@ -55,6 +55,12 @@ using namespace fmt::literals;
 MONGO_INITIALIZER(ThreadPoolCommonTests)(InitializerContext*) {
     addTestsForThreadPool("ThreadPoolCommon",
                           []() { return std::make_unique<ThreadPool>(ThreadPool::Options()); });
+    addTestsForThreadPool("ThreadPoolWorkStealingCommon", []() {
+        ThreadPool::Options options;
+        options.minThreads = options.maxThreads = 4;
+        options.workStealing = true;
+        return std::make_unique<ThreadPool>(options);
+    });
 }
 
 class ThreadPoolTest : public unittest::Test {
@@ -308,4 +314,74 @@ TEST(ThreadPoolTest, JoinAllRetiredThreads) {
     ASSERT_EQ(pool.getStats().numIdleThreads, 0);
 }
 
+TEST(ThreadPoolTest, ScheduleBatchRunsEveryTask) {
+    for (bool workStealing : {false, true}) {
+        ThreadPool::Options options;
+        options.minThreads = options.maxThreads = 4;
+        options.workStealing = workStealing;
+        ThreadPool pool(options);
+        pool.startup();
+
+        AtomicWord<int> numRun{0};
+        std::vector<ThreadPool::Task> tasks;
+        for (int i = 0; i < 100; ++i) {
+            tasks.push_back([&](auto status) {
+                ASSERT_OK(status);
+                numRun.addAndFetch(1);
+            });
+        }
+        pool.scheduleBatch(std::move(tasks));
+        pool.waitForIdle();
+        ASSERT_EQ(100, numRun.load()) << "workStealing: " << workStealing;
+
+        pool.shutdown();
+        pool.join();
+
+        bool rejected = false;
+        tasks.clear();
+        tasks.push_back([&](auto status) {
+            ASSERT_EQ(ErrorCodes::ShutdownInProgress, status);
+            rejected = true;
+        });
+        pool.scheduleBatch(std::move(tasks));
+        ASSERT(rejected) << "workStealing: " << workStealing;
+    }
+}
+
+TEST(ThreadPoolTest, WorkStealingThreadsStealFromBusyThreads) {
+    ThreadPool::Options options;
+    options.minThreads = options.maxThreads = 2;
+    options.workStealing = true;
+    ThreadPool pool(options);
+    pool.startup();
+
+    // A task scheduled by a thread of the pool goes to that thread's own queue, so it can only run
+    // while the thread is blocked if the other thread steals it.
+    unittest::Barrier barrier(2U);
+    pool.schedule([&](auto status) {
+        ASSERT_OK(status);
+        pool.schedule([&](auto status) {
+            ASSERT_OK(status);
+            barrier.countDownAndWait();
+        });
+        barrier.countDownAndWait();
+    });
+    pool.waitForIdle();
+
+    auto stats = pool.getStats();
+    ASSERT_EQ(2U, stats.numThreads);
+    ASSERT_EQ(2U, stats.numIdleThreads);
+    ASSERT_EQ(0U, stats.numPendingTasks);
+}
+
+DEATH_TEST_REGEX(ThreadPoolTest,
+                 WorkStealingWithVaryingNumberOfThreadsDies,
+                 "Cannot create work-stealing pool.*which differs from the maximum") {
+    ThreadPool::Options options;
+    options.minThreads = 1;
+    options.maxThreads = 2;
+    options.workStealing = true;
+    ThreadPool pool(options);
+}
+
 }  // namespace
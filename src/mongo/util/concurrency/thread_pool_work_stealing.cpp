@@ -0,0 +1,520 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kExecutor
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/concurrency/thread_pool.h"
+
+#include <deque>
+#include <fmt/format.h>
+#include <list>
+#include <vector>
+
+#include "mongo/base/status.h"
+#include "mongo/logv2/log.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/idle_thread_block.h"
+#include "mongo/util/concurrency/thread_name.h"
+#include "mongo/util/hierarchical_acquisition.h"
+
+namespace mongo {
+
+using namespace fmt::literals;
+
+// Implementation of ThreadPool in which each thread has its own queue of tasks and steals from the
+// queues of the other threads when its own is empty.
+//
+// The queues are guarded by their own mutexes, so scheduling a task and taking one only contend
+// with the threads using the same queue. The pool's _mutex is only taken to start and stop the
+// pool, and to wake sleeping threads, which is skipped while every thread is busy.
+class ThreadPool::WorkStealingImpl final : public ThreadPool::Impl {
+public:
+    explicit WorkStealingImpl(Options options);
+    ~WorkStealingImpl() override;
+    void startup() override;
+    void shutdown() override;
+    void join() override;
+    void schedule(Task task) override;
+    void scheduleBatch(std::vector<Task> tasks) override;
+    void waitForIdle() override;
+    Stats getStats() const override;
+
+private:
+    /**
+     * Representation of the stage of life of a thread pool. The legal transitions are the same as
+     * for the SharedQueueImpl.
+     */
+    enum LifecycleState { preStart, running, joinRequired, joining, shutdownComplete };
+
+    /**
+     * The queue of tasks of one thread of the pool. The thread takes tasks from the front, and
+     * other threads steal from the back.
+     */
+    struct TaskQueue {
+        Mutex mutex = MONGO_MAKE_LATCH("ThreadPool::WorkStealingImpl::TaskQueue::mutex");
+        std::deque<Task> tasks;
+    };
+
+    /** The thread body for the worker thread which owns _queues[queueIndex]. */
+    void _workerThreadBody(size_t queueIndex, const std::string& threadName) noexcept;
+
+    /**
+     * Runs tasks, preferring those of _queues[queueIndex], until the pool is shut down and has no
+     * unfinished tasks.
+     */
+    void _consumeTasks(size_t queueIndex);
+
+    /**
+     * Removes and returns a task from _queues[queueIndex], or one stolen from another queue if
+     * that one is empty. Returns an empty task if there are no queued tasks.
+     */
+    Task _takeTask(size_t queueIndex);
+
+    /**
+     * Returns the index of the queue to which the calling thread should add tasks: its own queue
+     * if it is a thread of this pool, or the next queue round-robin otherwise.
+     */
+    size_t _chooseQueue();
+
+    /**
+     * Accounts for "numTasks" newly scheduled tasks as unfinished and returns true, unless the pool
+     * is shutting down, in which case the tasks must be rejected and this returns false.
+     */
+    bool _admitTasks(size_t numTasks);
+
+    /** Returns the status with which tasks scheduled after shutdown() are rejected. */
+    Status _shutdownInProgressStatus() const;
+
+    /** Wakes up to "numTasks" sleeping threads to run newly queued tasks. */
+    void _wakeThreads(size_t numTasks);
+
+    /** Accounts for "numTasks" tasks that have completed or been rejected. */
+    void _finishTasks(size_t numTasks);
+
+    /**
+     * Implementation of shutdown once _mutex is locked.
+     */
+    void _shutdown_inlock();
+
+    /**
+     * Implementation of join once _mutex is owned by "lk".
+     */
+    void _join_inlock(stdx::unique_lock<Latch>* lk);
+
+    /**
+     * Runs the remaining tasks on a new thread as part of the join process of a pool which was
+     * never started, blocking until complete. Caller must not hold the mutex!
+     */
+    void _drainPendingTasks();
+
+    /**
+     * Changes the lifecycle state (_state) of the pool and wakes up any threads waiting for a state
+     * change. Has no effect if _state == newState.
+     */
+    void _setState_inlock(LifecycleState newState);
+
+    // The pool whose thread is running on this thread, and the index of that thread's queue.
+    static thread_local WorkStealingImpl* _currentPool;
+    static thread_local size_t _currentQueueIndex;
+
+    // These are the options with which the pool was configured at construction time.
+    const Options _options;
+
+    // One queue per thread, created at construction so that tasks can be scheduled before
+    // startup().
+    std::vector<std::unique_ptr<TaskQueue>> _queues;
+
+    // Mutex guarding _state and _threads, and the condition variables below.
+    mutable Mutex _mutex =
+        MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0), "ThreadPool::WorkStealingImpl::_mutex");
+
+    // This variable represents the lifecycle state of the pool.
+    LifecycleState _state = preStart;
+
+    // Set when shutdown() is first called. Read without _mutex by schedule().
+    AtomicWord<bool> _shutdownRequested{false};
+
+    // Condition signaled to indicate that there are queued tasks, or that the pool has shut down
+    // and has no unfinished tasks.
+    stdx::condition_variable _workAvailable;
+
+    // Condition signaled to indicate that there are no unfinished tasks.
+    stdx::condition_variable _poolIsIdle;
+
+    // Condition variable signaled whenever _state changes.
+    stdx::condition_variable _stateChange;
+
+    // The worker threads, one per queue.
+    std::list<stdx::thread> _threads;
+
+    // The number of tasks in the queues. Incremented before a task is added to a queue and
+    // decremented after it is removed, so it is never less than the true number.
+    AtomicWord<size_t> _numQueuedTasks{0};
+
+    // The number of tasks which have been scheduled and have not yet finished running.
+    AtomicWord<size_t> _numUnfinishedTasks{0};
+
+    // The number of threads waiting on _workAvailable.
+    AtomicWord<size_t> _numSleepingThreads{0};
+
+    // Used to spread the tasks scheduled from outside of the pool across the queues.
+    AtomicWord<size_t> _nextQueueIndex{0};
+};
+
+thread_local ThreadPool::WorkStealingImpl* ThreadPool::WorkStealingImpl::_currentPool = nullptr;
+thread_local size_t ThreadPool::WorkStealingImpl::_currentQueueIndex = 0;
+
+ThreadPool::WorkStealingImpl::WorkStealingImpl(Options options) : _options(std::move(options)) {
+    for (size_t i = 0; i < _options.maxThreads; ++i) {
+        _queues.push_back(std::make_unique<TaskQueue>());
+    }
+}
+
+ThreadPool::WorkStealingImpl::~WorkStealingImpl() {
+    stdx::unique_lock<Latch> lk(_mutex);
+    _shutdown_inlock();
+    if (_state != shutdownComplete) {
+        _join_inlock(&lk);
+    }
+
+    if (_state != shutdownComplete) {
+        LOGV2_FATAL(5502130, "Failed to shutdown pool during destruction");
+    }
+    invariant(_threads.empty());
+    invariant(_numQueuedTasks.load() == 0);
+}
+
+void ThreadPool::WorkStealingImpl::startup() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (_state != preStart) {
+        LOGV2_FATAL(5502128,
+                    "Attempted to start pool {poolName}, but it has already started",
+                    "Attempted to start pool that has already started",
+                    "poolName"_attr = _options.poolName);
+    }
+    _setState_inlock(running);
+    invariant(_threads.empty());
+    for (size_t i = 0; i < _queues.size(); ++i) {
+        std::string threadName = "{}{}"_format(_options.threadNamePrefix, i);
+        try {
+            _threads.emplace_back([this, i, threadName] { _workerThreadBody(i, threadName); });
+        } catch (const std::exception& ex) {
+            // The tasks of this thread's queue are stolen by the others.
+            LOGV2_ERROR(5502131,
+                        "Failed to start {threadName}; {numThreads} other thread(s) running in "
+                        "pool {poolName}; caught exception: {error}",
+                        "Failed to start thread",
+                        "threadName"_attr = threadName,
+                        "numThreads"_attr = _threads.size(),
+                        "poolName"_attr = _options.poolName,
+                        "error"_attr = redact(ex.what()));
+        }
+    }
+}
+
+void ThreadPool::WorkStealingImpl::shutdown() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _shutdown_inlock();
+}
+
+void ThreadPool::WorkStealingImpl::_shutdown_inlock() {
+    switch (_state) {
+        case preStart:
+        case running:
+            _shutdownRequested.store(true);
+            _setState_inlock(joinRequired);
+            _workAvailable.notify_all();
+            return;
+        case joinRequired:
+        case joining:
+        case shutdownComplete:
+            return;
+    }
+    MONGO_UNREACHABLE;
+}
+
+void ThreadPool::WorkStealingImpl::join() {
+    stdx::unique_lock<Latch> lk(_mutex);
+    _join_inlock(&lk);
+}
+
+void ThreadPool::WorkStealingImpl::_join_inlock(stdx::unique_lock<Latch>* lk) {
+    _stateChange.wait(*lk, [this] { return _state != preStart && _state != running; });
+    if (_state != joinRequired) {
+        LOGV2_FATAL(5502129,
+                    "Attempted to join pool {poolName} more than once",
+                    "Attempted to join pool more than once",
+                    "poolName"_attr = _options.poolName);
+    }
+
+    _setState_inlock(joining);
+    auto threadsToJoin = std::exchange(_threads, {});
+    lk->unlock();
+    if (threadsToJoin.empty()) {
+        _drainPendingTasks();
+    }
+    for (auto& t : threadsToJoin) {
+        t.join();
+    }
+    lk->lock();
+    invariant(_state == joining);
+    _setState_inlock(shutdownComplete);
+}
+
+void ThreadPool::WorkStealingImpl::_drainPendingTasks() {
+    // Tasks cannot be run inline because they can create OperationContexts and the join() caller
+    // may already have one associated with the thread.
+    stdx::thread cleanThread = stdx::thread(
+        [&] { _workerThreadBody(0, "{}{}"_format(_options.threadNamePrefix, _queues.size())); });
+    cleanThread.join();
+}
+
+void ThreadPool::WorkStealingImpl::schedule(Task task) {
+    if (!_admitTasks(1)) {
+        task(_shutdownInProgressStatus());
+        return;
+    }
+
+    auto& queue = *_queues[_chooseQueue()];
+    _numQueuedTasks.fetchAndAdd(1);
+    {
+        stdx::lock_guard<Latch> lk(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+    _wakeThreads(1);
+}
+
+void ThreadPool::WorkStealingImpl::scheduleBatch(std::vector<Task> tasks) {
+    if (tasks.empty()) {
+        return;
+    }
+    if (!_admitTasks(tasks.size())) {
+        auto status = _shutdownInProgressStatus();
+        for (auto& task : tasks) {
+            task(status);
+        }
+        return;
+    }
+
+    const auto numTasks = tasks.size();
+    _numQueuedTasks.fetchAndAdd(numTasks);
+    if (_currentPool == this) {
+        // The other threads steal from the back of this thread's queue if they are idle.
+        auto& queue = *_queues[_currentQueueIndex];
+        stdx::lock_guard<Latch> lk(queue.mutex);
+        for (auto& task : tasks) {
+            queue.tasks.push_back(std::move(task));
+        }
+    } else {
+        // Deal the tasks out round-robin, locking each queue once.
+        const auto numQueues = _queues.size();
+        const auto firstQueue = _nextQueueIndex.fetchAndAdd(numTasks);
+        for (size_t i = 0; i < std::min(numTasks, numQueues); ++i) {
+            auto& queue = *_queues[(firstQueue + i) % numQueues];
+            stdx::lock_guard<Latch> lk(queue.mutex);
+            for (size_t j = i; j < numTasks; j += numQueues) {
+                queue.tasks.push_back(std::move(tasks[j]));
+            }
+        }
+    }
+    _wakeThreads(numTasks);
+}
+
+bool ThreadPool::WorkStealingImpl::_admitTasks(size_t numTasks) {
+    // The tasks count as unfinished before _shutdownRequested is checked, so that a thread which
+    // sees that the pool has shut down and has no unfinished tasks cannot miss them.
+    _numUnfinishedTasks.fetchAndAdd(numTasks);
+    if (!_shutdownRequested.load()) {
+        return true;
+    }
+    _finishTasks(numTasks);
+    return false;
+}
+
+Status ThreadPool::WorkStealingImpl::_shutdownInProgressStatus() const {
+    return Status(ErrorCodes::ShutdownInProgress,
+                  "Shutdown of thread pool {} in progress"_format(_options.poolName));
+}
+
+size_t ThreadPool::WorkStealingImpl::_chooseQueue() {
+    if (_currentPool == this) {
+        return _currentQueueIndex;
+    }
+    return _nextQueueIndex.fetchAndAdd(1) % _queues.size();
+}
+
+void ThreadPool::WorkStealingImpl::_wakeThreads(size_t numTasks) {
+    // A thread increments _numSleepingThreads before it checks _numQueuedTasks, and schedule()
+    // does the opposite, so at least one of them sees the other's increment.
+    if (_numSleepingThreads.load() == 0) {
+        return;
+    }
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (numTasks == 1) {
+        _workAvailable.notify_one();
+    } else {
+        _workAvailable.notify_all();
+    }
+}
+
+void ThreadPool::WorkStealingImpl::_finishTasks(size_t numTasks) {
+    if (_numUnfinishedTasks.subtractAndFetch(numTasks) != 0) {
+        return;
+    }
+    stdx::lock_guard<Latch> lk(_mutex);
+    _poolIsIdle.notify_all();
+    if (_shutdownRequested.load()) {
+        _workAvailable.notify_all();
+    }
+}
+
+void ThreadPool::WorkStealingImpl::waitForIdle() {
+    stdx::unique_lock<Latch> lk(_mutex);
+    _poolIsIdle.wait(lk, [this] { return _numUnfinishedTasks.load() == 0; });
+}
+
+ThreadPool::Stats ThreadPool::WorkStealingImpl::getStats() const {
+    Stats result;
+    result.options = _options;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        result.numThreads = _threads.size();
+    }
+    const auto numQueued = _numQueuedTasks.load();
+    const auto numUnfinished = _numUnfinishedTasks.load();
+    const auto numRunning = numUnfinished > numQueued ? numUnfinished - numQueued : 0;
+    result.numIdleThreads = result.numThreads - std::min(result.numThreads, numRunning);
+    result.numPendingTasks = numQueued;
+    return result;
+}
+
+void ThreadPool::WorkStealingImpl::_workerThreadBody(size_t queueIndex,
+                                                     const std::string& threadName) noexcept {
+    setThreadName(threadName);
+    if (_options.onCreateThread)
+        _options.onCreateThread(threadName);
+    LOGV2_DEBUG(5502132,
+                1,
+                "Starting thread {threadName} in pool {poolName}",
+                "Starting thread",
+                "threadName"_attr = threadName,
+                "poolName"_attr = _options.poolName);
+    _currentPool = this;
+    _currentQueueIndex = queueIndex;
+    _consumeTasks(queueIndex);
+    _currentPool = nullptr;
+    LOGV2_DEBUG(5502133,
+                1,
+                "Shutting down thread {threadName} in pool {poolName}",
+                "Shutting down thread",
+                "threadName"_attr = threadName,
+                "poolName"_attr = _options.poolName);
+}
+
+void ThreadPool::WorkStealingImpl::_consumeTasks(size_t queueIndex) {
+    auto isDone = [this] {
+        return _shutdownRequested.load() && _numUnfinishedTasks.load() == 0;
+    };
+
+    while (true) {
+        if (auto task = _takeTask(queueIndex)) {
+            // Note that if the task throws, the task destructor will run before the exception hits
+            // the noexcept boundary.
+            task(Status::OK());
+
+            // Reset the task and run the dtor before the task counts as finished.
+            task = {};
+            _finishTasks(1);
+            continue;
+        }
+
+        stdx::unique_lock<Latch> lk(_mutex);
+        if (isDone()) {
+            return;
+        }
+        _numSleepingThreads.fetchAndAdd(1);
+        {
+            MONGO_IDLE_THREAD_BLOCK;
+            _workAvailable.wait(lk, [&] { return _numQueuedTasks.load() > 0 || isDone(); });
+        }
+        _numSleepingThreads.fetchAndSubtract(1);
+    }
+}
+
+ThreadPool::Task ThreadPool::WorkStealingImpl::_takeTask(size_t queueIndex) {
+    if (_numQueuedTasks.load() == 0) {
+        return {};
+    }
+
+    auto takeFrom = [this](TaskQueue& queue, bool fromFront) -> Task {
+        stdx::lock_guard<Latch> lk(queue.mutex);
+        if (queue.tasks.empty()) {
+            return {};
+        }
+        Task task;
+        if (fromFront) {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        } else {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        }
+        _numQueuedTasks.fetchAndSubtract(1);
+        return task;
+    };
+
+    if (auto task = takeFrom(*_queues[queueIndex], true)) {
+        return task;
+    }
+    for (size_t i = 1; i < _queues.size(); ++i) {
+        if (auto task = takeFrom(*_queues[(queueIndex + i) % _queues.size()], false)) {
+            return task;
+        }
+    }
+    return {};
+}
+
+void ThreadPool::WorkStealingImpl::_setState_inlock(const LifecycleState newState) {
+    if (newState == _state) {
+        return;
+    }
+    _state = newState;
+    _stateChange.notify_all();
+}
+
+std::unique_ptr<ThreadPool::Impl> ThreadPool::_makeWorkStealingImpl(Options options) {
+    return std::make_unique<WorkStealingImpl>(std::move(options));
+}
+
+}  // namespace mongo
@@ -33,104 +33,110 @@
 
 #include "mongo/util/concurrency/ticketholder.h"
 
-#include <iostream>
+#include <algorithm>
 
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
 
-#if defined(__linux__)
 namespace {
 
-/**
- * Accepts an errno code, prints its error message, and exits.
- */
-void failWithErrno(int err) {
-    LOGV2_FATAL(28604,
-                "error in Ticketholder: {errnoWithDescription_err}",
-                "errnoWithDescription_err"_attr = errnoWithDescription(err));
-}
-
-/*
- * Checks the return value from a Linux semaphore function call, and fails with the set errno if the
- * call was unsucessful.
- */
-void check(int ret) {
-    if (ret == 0)
-        return;
-    failWithErrno(errno);
+StringData toString(TicketPriority priority) {
+    switch (priority) {
+        case TicketPriority::kInternal:
+            return "internal"_sd;
+        case TicketPriority::kInteractive:
+            return "interactive"_sd;
+        case TicketPriority::kBatch:
+            return "batch"_sd;
+    }
+    MONGO_UNREACHABLE;
 }
 
-/**
- * Takes a Date_t deadline and sets the appropriate values in a timespec structure.
- */
-void tsFromDate(const Date_t& deadline, struct timespec& ts) {
-    ts.tv_sec = deadline.toTimeT();
-    ts.tv_nsec = (deadline.toMillisSinceEpoch() % 1000) * 1'000'000;
-}
 }  // namespace
 
-TicketHolder::TicketHolder(int num) : _outof(num) {
-    check(sem_init(&_sem, 0, num));
-}
+TicketHolder::TicketHolder(int num) : _available(num), _outof(num) {}
 
-TicketHolder::~TicketHolder() {
-    check(sem_destroy(&_sem));
-}
+TicketHolder::~TicketHolder() = default;
 
 bool TicketHolder::tryAcquire() {
-    while (0 != sem_trywait(&_sem)) {
-        if (errno == EAGAIN)
-            return false;
-        if (errno != EINTR)
-            failWithErrno(errno);
-    }
-    return true;
+    return _tryAcquire(TicketPriority::kInteractive);
 }
 
-void TicketHolder::waitForTicket(OperationContext* opCtx) {
-    waitForTicketUntil(opCtx, Date_t::max());
+void TicketHolder::waitForTicket(OperationContext* opCtx, TicketPriority priority) {
+    invariant(waitForTicketUntil(opCtx, Date_t::max(), priority));
 }
 
-bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
-    // Attempt to get a ticket without waiting in order to avoid expensive time calculations.
-    if (sem_trywait(&_sem) == 0) {
+bool TicketHolder::waitForTicketUntil(OperationContext* opCtx,
+                                      Date_t until,
+                                      TicketPriority priority) {
+    // Attempt to get a ticket without waiting in order to avoid taking the mutex.
+    if (_tryAcquire(priority)) {
         return true;
     }
 
-    const Milliseconds intervalMs(500);
-    struct timespec ts;
-
-    // To support interrupting ticket acquisition while still benefiting from semaphores, we do a
-    // timed wait on an interval to periodically check for interrupts.
-    // The wait period interval is the smaller of the default interval and the provided
-    // deadline.
-    Date_t deadline = std::min(until, Date_t::now() + intervalMs);
-    tsFromDate(deadline, ts);
-
-    while (0 != sem_timedwait(&_sem, &ts)) {
-        if (errno == ETIMEDOUT) {
-            // If we reached the deadline without being interrupted, we have completely timed out.
-            if (deadline == until)
-                return false;
-
-            deadline = std::min(until, Date_t::now() + intervalMs);
-            tsFromDate(deadline, ts);
-        } else if (errno != EINTR) {
-            failWithErrno(errno);
+    stdx::unique_lock<Latch> lk(_queueMutex);
+    Waiter waiter(priority);
+    auto& queue = _queues[static_cast<size_t>(priority)];
+    auto it = queue.insert(queue.end(), &waiter);
+    _numQueued.fetchAndAdd(1);
+
+    // A ticket may have been released after the attempt above without seeing this operation in
+    // the queue, so hand out any available ticket before waiting.
+    _grantQueuedTickets(lk);
+
+    auto dequeue = [&] {
+        queue.erase(it);
+        _numQueued.fetchAndSubtract(1);
+    };
+    auto isGranted = [&] { return waiter.granted; };
+
+    bool granted;
+    try {
+        if (opCtx && until == Date_t::max()) {
+            opCtx->waitForConditionOrInterrupt(waiter.cv, lk, isGranted);
+            granted = true;
+        } else if (opCtx) {
+            granted = opCtx->waitForConditionOrInterruptUntil(waiter.cv, lk, until, isGranted);
+        } else if (until == Date_t::max()) {
+            waiter.cv.wait(lk, isGranted);
+            granted = true;
+        } else {
+            granted = waiter.cv.wait_until(lk, until.toSystemTimePoint(), isGranted);
         }
+    } catch (...) {
+        // The ticket may have been handed to this operation just as it was interrupted, in which
+        // case it has to be passed on.
+        if (waiter.granted) {
+            lk.unlock();
+            release();
+        } else {
+            dequeue();
+        }
+        throw;
+    }
 
-        // To correctly handle errors from sem_timedwait, we should check for interrupts last.
-        // It is possible to unset 'errno' after a call to checkForInterrupt().
-        if (opCtx)
-            opCtx->checkForInterrupt();
+    if (!granted) {
+        dequeue();
+        return false;
     }
+
+    lk.unlock();
+    _recordAdmission(priority, waiter.queued.micros());
     return true;
 }
 
 void TicketHolder::release() {
-    check(sem_post(&_sem));
+    _available.fetchAndAdd(1);
+
+    // An operation which is being queued either sees this ticket when it checks for available
+    // tickets after joining the queue, or is seen here.
+    if (_numQueued.load() > 0) {
+        stdx::lock_guard<Latch> lk(_queueMutex);
+        _grantQueuedTickets(lk);
+    }
 }
 
 Status TicketHolder::resize(int newSize) {
@@ -140,18 +146,13 @@ Status TicketHolder::resize(int newSize) {
         return Status(ErrorCodes::BadValue,
                       str::stream() << "Minimum value for semaphore is 5; given " << newSize);
 
-    if (newSize > SEM_VALUE_MAX)
-        return Status(ErrorCodes::BadValue,
-                      str::stream() << "Maximum value for semaphore is " << SEM_VALUE_MAX
-                                    << "; given " << newSize);
-
     while (_outof.load() < newSize) {
         release();
         _outof.fetchAndAdd(1);
     }
 
     while (_outof.load() > newSize) {
-        waitForTicket();
+        waitForTicket(nullptr, TicketPriority::kInternal);
         _outof.subtractAndFetch(1);
     }
 
@@ -160,9 +161,7 @@ Status TicketHolder::resize(int newSize) {
 }
 
 int TicketHolder::available() const {
-    int val = 0;
-    check(sem_getvalue(&_sem, &val));
-    return val;
+    return _available.load();
 }
 
 int TicketHolder::used() const {
@@ -173,90 +172,104 @@ int TicketHolder::outof() const {
     return _outof.load();
 }
 
-#else
-
-TicketHolder::TicketHolder(int num) : _outof(num), _num(num) {}
-
-TicketHolder::~TicketHolder() = default;
+void TicketHolder::appendStats(BSONObjBuilder* builder) const {
+    std::array<size_t, kNumPriorities> currentlyQueued;
+    {
+        stdx::lock_guard<Latch> lk(_queueMutex);
+        for (size_t i = 0; i < kNumPriorities; ++i) {
+            currentlyQueued[i] = _queues[i].size();
+        }
+    }
 
-bool TicketHolder::tryAcquire() {
-    stdx::lock_guard<Latch> lk(_mutex);
-    return _tryAcquire();
+    BSONObjBuilder queuesBuilder(builder->subobjStart("queues"));
+    for (size_t i = 0; i < kNumPriorities; ++i) {
+        const auto& stats = _stats[i];
+        BSONObjBuilder priorityBuilder(
+            queuesBuilder.subobjStart(toString(static_cast<TicketPriority>(i))));
+        priorityBuilder.appendNumber("currentlyQueued", static_cast<long long>(currentlyQueued[i]));
+        priorityBuilder.appendNumber("admitted", stats.admitted.load());
+        priorityBuilder.appendNumber("queued", stats.queued.load());
+        priorityBuilder.appendNumber("totalQueueTimeMicros", stats.totalQueueTimeMicros.load());
+
+        BSONObjBuilder histogramBuilder(priorityBuilder.subobjStart("queueTimeHistogramMicros"));
+        for (size_t bucket = 0; bucket < stats.queueTimeHistogram.size(); ++bucket) {
+            const std::string name = bucket < kQueueTimeBucketBoundsMicros.size()
+                ? str::stream() << "lt" << kQueueTimeBucketBoundsMicros[bucket]
+                : str::stream() << "gte" << kQueueTimeBucketBoundsMicros.back();
+            histogramBuilder.appendNumber(name, stats.queueTimeHistogram[bucket].load());
+        }
+    }
 }
 
-void TicketHolder::waitForTicket(OperationContext* opCtx) {
-    stdx::unique_lock<Latch> lk(_mutex);
-
-    if (opCtx) {
-        opCtx->waitForConditionOrInterrupt(_newTicket, lk, [this] { return _tryAcquire(); });
-    } else {
-        _newTicket.wait(lk, [this] { return _tryAcquire(); });
+bool TicketHolder::_tryAcquire(TicketPriority priority) {
+    // Operations are admitted in the order they arrived, so an operation may not take a ticket
+    // ahead of the queued ones.
+    if (_numQueued.load() > 0 || !_tryAcquireAvailable()) {
+        return false;
     }
+    _recordAdmission(priority, boost::none);
+    return true;
 }
 
-bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
-    stdx::unique_lock<Latch> lk(_mutex);
-
-    if (opCtx) {
-        return opCtx->waitForConditionOrInterruptUntil(
-            _newTicket, lk, until, [this] { return _tryAcquire(); });
-    } else {
-        return _newTicket.wait_until(
-            lk, until.toSystemTimePoint(), [this] { return _tryAcquire(); });
+bool TicketHolder::_tryAcquireAvailable() {
+    auto available = _available.load();
+    while (available > 0) {
+        if (_available.compareAndSwap(&available, available - 1)) {
+            return true;
+        }
     }
+    return false;
 }
 
-void TicketHolder::release() {
-    {
-        stdx::lock_guard<Latch> lk(_mutex);
-        _num++;
+void TicketHolder::_grantQueuedTickets(WithLock lk) {
+    while (_numQueued.load() > 0 && _tryAcquireAvailable()) {
+        Waiter* waiter = _popNextWaiter(lk);
+        waiter->granted = true;
+        waiter->cv.notify_one();
     }
-    _newTicket.notify_one();
 }
 
-Status TicketHolder::resize(int newSize) {
-    stdx::lock_guard<Latch> lk(_mutex);
-
-    int used = _outof.load() - _num;
-    if (used > newSize) {
-        std::stringstream ss;
-        ss << "can't resize since we're using (" << used << ") "
-           << "more than newSize(" << newSize << ")";
-
-        std::string errmsg = ss.str();
-        LOGV2(23120, "{errmsg}", "errmsg"_attr = errmsg);
-        return Status(ErrorCodes::BadValue, errmsg);
+TicketHolder::Waiter* TicketHolder::_popNextWaiter(WithLock) {
+    auto next = std::find_if(
+        _queues.begin(), _queues.end(), [](const auto& queue) { return !queue.empty(); });
+    invariant(next != _queues.end());
+
+    if (++_grantsSinceFairGrant >= kFairnessInterval) {
+        _grantsSinceFairGrant = 0;
+        auto longestQueuedMicros = next->front()->queued.micros();
+        for (auto queue = next + 1; queue != _queues.end(); ++queue) {
+            if (queue->empty()) {
+                continue;
+            }
+            if (auto queuedMicros = queue->front()->queued.micros();
+                queuedMicros > longestQueuedMicros) {
+                next = queue;
+                longestQueuedMicros = queuedMicros;
+            }
+        }
     }
 
-    _outof.store(newSize);
-    _num = _outof.load() - used;
-
-    // Potentially wasteful, but easier to see is correct
-    _newTicket.notify_all();
-    return Status::OK();
+    Waiter* waiter = next->front();
+    next->pop_front();
+    _numQueued.fetchAndSubtract(1);
+    return waiter;
 }
 
-int TicketHolder::available() const {
-    return _num;
-}
-
-int TicketHolder::used() const {
-    return outof() - _num;
-}
+void TicketHolder::_recordAdmission(TicketPriority priority,
+                                    boost::optional<long long> queueTimeMicros) {
+    auto& stats = _stats[static_cast<size_t>(priority)];
+    stats.admitted.fetchAndAddRelaxed(1);
+    if (!queueTimeMicros) {
+        return;
+    }
 
-int TicketHolder::outof() const {
-    return _outof.load();
+    stats.queued.fetchAndAddRelaxed(1);
+    stats.totalQueueTimeMicros.fetchAndAddRelaxed(*queueTimeMicros);
+    const auto bucket = std::upper_bound(kQueueTimeBucketBoundsMicros.begin(),
+                                         kQueueTimeBucketBoundsMicros.end(),
+                                         *queueTimeMicros) -
+        kQueueTimeBucketBoundsMicros.begin();
+    stats.queueTimeHistogram[bucket].fetchAndAddRelaxed(1);
 }
 
-bool TicketHolder::_tryAcquire() {
-    if (_num <= 0) {
-        if (_num < 0) {
-            std::cerr << "DISASTER! in TicketHolder" << std::endl;
-        }
-        return false;
-    }
-    _num--;
-    return true;
-}
-#endif
 }  // namespace mongo
@@ -28,19 +28,35 @@
  */
 #pragma once
 
-#if defined(__linux__)
-#include <semaphore.h>
-#endif
+#include <array>
+#include <list>
 
 #include "mongo/db/operation_context.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/util/concurrency/mutex.h"
+#include "mongo/util/concurrency/with_lock.h"
 #include "mongo/util/hierarchical_acquisition.h"
 #include "mongo/util/time_support.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
+class BSONObjBuilder;
+
+/**
+ * The classes of operations competing for tickets, from the highest priority to the lowest.
+ * Internal operations, such as replication, are admitted ahead of user operations, and short
+ * interactive operations ahead of long-running batch ones.
+ */
+enum class TicketPriority { kInternal, kInteractive, kBatch };
+
+/**
+ * Limits the number of operations that may run at once. Operations which cannot be admitted right
+ * away wait in a first-in-first-out queue per priority class, and released tickets are handed to
+ * the queued operations in priority order.
+ */
 class TicketHolder {
     TicketHolder(const TicketHolder&) = delete;
     TicketHolder& operator=(const TicketHolder&) = delete;
@@ -56,7 +72,8 @@ public:
      * 'opCtx' is killed, throwing an AssertionException.
      * If 'opCtx' is not provided or equal to nullptr, the wait is not interruptible.
      */
-    void waitForTicket(OperationContext* opCtx);
+    void waitForTicket(OperationContext* opCtx,
+                       TicketPriority priority = TicketPriority::kInteractive);
     void waitForTicket() {
         waitForTicket(nullptr);
     }
@@ -68,7 +85,9 @@ public:
      * proceed.
      * If 'opCtx' is not provided or equal to nullptr, the wait is not interruptible.
      */
-    bool waitForTicketUntil(OperationContext* opCtx, Date_t until);
+    bool waitForTicketUntil(OperationContext* opCtx,
+                            Date_t until,
+                            TicketPriority priority = TicketPriority::kInteractive);
     bool waitForTicketUntil(Date_t until) {
         return waitForTicketUntil(nullptr, until);
     }
@@ -82,22 +101,80 @@ public:
 
     int outof() const;
 
+    /**
+     * Appends the number of queued operations and the queue time statistics of each priority
+     * class.
+     */
+    void appendStats(BSONObjBuilder* builder) const;
+
 private:
-#if defined(__linux__)
-    mutable sem_t _sem;
+    static constexpr size_t kNumPriorities = 3;
+
+    // Every this many tickets handed to queued operations, the ticket goes to the operation which
+    // has been queued the longest instead of the one with the highest priority, so that a steady
+    // stream of higher priority operations cannot starve the lower priority ones.
+    static constexpr int kFairnessInterval = 8;
+
+    // The upper bounds of the buckets of the queue time histograms, in microseconds. The last
+    // bucket holds the queue times above the last bound.
+    static constexpr std::array<long long, 5> kQueueTimeBucketBoundsMicros{
+        100, 1000, 10 * 1000, 100 * 1000, 1000 * 1000};
+
+    struct Waiter {
+        explicit Waiter(TicketPriority priority) : priority(priority) {}
+
+        const TicketPriority priority;
+        stdx::condition_variable cv;
+        bool granted = false;
+        Timer queued;
+    };
+
+    struct QueueStats {
+        AtomicWord<long long> admitted;
+        AtomicWord<long long> queued;
+        AtomicWord<long long> totalQueueTimeMicros;
+        std::array<AtomicWord<long long>, kQueueTimeBucketBoundsMicros.size() + 1>
+            queueTimeHistogram;
+    };
+
+    /**
+     * Takes an available ticket without waiting, if no operation is queued ahead of the caller.
+     */
+    bool _tryAcquire(TicketPriority priority);
+
+    /**
+     * Takes an available ticket, regardless of the queued operations.
+     */
+    bool _tryAcquireAvailable();
+
+    /**
+     * Hands the available tickets to the queued operations.
+     */
+    void _grantQueuedTickets(WithLock);
+
+    /**
+     * Removes the next operation to admit from the queues.
+     */
+    Waiter* _popNextWaiter(WithLock);
+
+    void _recordAdmission(TicketPriority priority, boost::optional<long long> queueTimeMicros);
+
+    AtomicWord<int> _available;
 
     // You can read _outof without a lock, but have to hold _resizeMutex to change.
     AtomicWord<int> _outof;
     Mutex _resizeMutex =
-        MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0), "TicketHolder::_resizeMutex");
-#else
-    bool _tryAcquire();
+        MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(1), "TicketHolder::_resizeMutex");
 
-    AtomicWord<int> _outof;
-    int _num;
-    Mutex _mutex = MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0), "TicketHolder::_mutex");
-    stdx::condition_variable _newTicket;
-#endif
+    // Protects the queues. The number of queued operations may be read without it, so that
+    // releasing a ticket only takes the mutex when some operation is waiting for one.
+    mutable Mutex _queueMutex =
+        MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0), "TicketHolder::_queueMutex");
+    std::array<std::list<Waiter*>, kNumPriorities> _queues;
+    AtomicWord<int> _numQueued;
+    int _grantsSinceFairGrant = 0;
+
+    std::array<QueueStats, kNumPriorities> _stats;
 };
 
 class ScopedTicket {
@@ -32,12 +32,30 @@
 
 #include "mongo/platform/basic.h"
 
+#include <vector>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/concurrency/ticketholder.h"
+#include "mongo/util/time_support.h"
 
 namespace {
 using namespace mongo;
 
+BSONObj queueStats(const TicketHolder& holder, StringData priority) {
+    BSONObjBuilder builder;
+    holder.appendStats(&builder);
+    return builder.obj()["queues"].Obj()[priority].Obj().getOwned();
+}
+
+void waitForQueued(const TicketHolder& holder, StringData priority, int numQueued) {
+    while (queueStats(holder, priority)["currentlyQueued"].numberInt() < numQueued) {
+        sleepmillis(1);
+    }
+}
+
 TEST(TicketholderTest, BasicTimeout) {
     TicketHolder holder(1);
     ASSERT_EQ(holder.used(), 0);
@@ -72,4 +90,81 @@ TEST(TicketholderTest, BasicTimeout) {
     holder.release();
     ASSERT_EQ(holder.used(), 0);
 }
+TEST(TicketholderTest, QueuedOperationsAreAdmittedByPriorityThenInOrder) {
+    TicketHolder holder(1);
+    ASSERT(holder.tryAcquire());
+
+    auto mutex = MONGO_MAKE_LATCH();
+    std::vector<int> admitted;
+    std::vector<stdx::thread> threads;
+    auto queue = [&](int id, TicketPriority priority, StringData priorityName, int numQueued) {
+        threads.emplace_back([&, id, priority] {
+            holder.waitForTicket(nullptr, priority);
+            {
+                stdx::lock_guard<Latch> lk(mutex);
+                admitted.push_back(id);
+            }
+            holder.release();
+        });
+        waitForQueued(holder, priorityName, numQueued);
+    };
+    queue(0, TicketPriority::kBatch, "batch", 1);
+    queue(1, TicketPriority::kInteractive, "interactive", 1);
+    queue(2, TicketPriority::kInteractive, "interactive", 2);
+    queue(3, TicketPriority::kInternal, "internal", 1);
+
+    // Operations arriving while others are queued wait behind them.
+    ASSERT_FALSE(holder.tryAcquire());
+
+    holder.release();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT(admitted == (std::vector<int>{3, 1, 2, 0}));
+    ASSERT_EQ(holder.available(), 1);
+}
+
+TEST(TicketholderTest, TimedOutOperationsLeaveTheQueue) {
+    TicketHolder holder(1);
+    ASSERT(holder.tryAcquire());
+
+    ASSERT_FALSE(holder.waitForTicketUntil(
+        nullptr, Date_t::now() + Milliseconds(5), TicketPriority::kBatch));
+    ASSERT_EQ(0, queueStats(holder, "batch")["currentlyQueued"].numberInt());
+
+    holder.release();
+    ASSERT(holder.tryAcquire());
+    holder.release();
+}
+
+TEST(TicketholderTest, QueueTimesAreRecordedPerPriority) {
+    TicketHolder holder(1);
+    holder.waitForTicket(nullptr, TicketPriority::kInternal);
+
+    stdx::thread waiter([&] {
+        holder.waitForTicket(nullptr, TicketPriority::kBatch);
+        holder.release();
+    });
+    waitForQueued(holder, "batch", 1);
+    sleepmillis(2);
+    holder.release();
+    waiter.join();
+
+    auto internalStats = queueStats(holder, "internal");
+    ASSERT_EQ(1, internalStats["admitted"].numberLong());
+    ASSERT_EQ(0, internalStats["queued"].numberLong());
+
+    auto batchStats = queueStats(holder, "batch");
+    ASSERT_EQ(1, batchStats["admitted"].numberLong());
+    ASSERT_EQ(1, batchStats["queued"].numberLong());
+    ASSERT_GTE(batchStats["totalQueueTimeMicros"].numberLong(), 2000);
+
+    long long histogramTotal = 0;
+    for (auto&& bucket : batchStats["queueTimeHistogramMicros"].Obj()) {
+        histogramTotal += bucket.numberLong();
+    }
+    ASSERT_EQ(1, histogramTotal);
+    ASSERT_EQ(0, batchStats["queueTimeHistogramMicros"]["lt100"].numberLong());
+}
 }  // namespace
@@ -0,0 +1,420 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kDefault
+
+#include "mongo/platform/basic.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <csignal>
+#include <cstring>
+#include <cxxabi.h>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+#include <sys/prctl.h>
+#include <sys/time.h>
+#include <vector>
+
+#include "mongo/base/init.h"
+#include "mongo/config.h"
+#include "mongo/db/commands/server_status.h"
+#include "mongo/logv2/log.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/concurrency/with_lock.h"
+#include "mongo/util/cpu_profiler_gen.h"
+#include "mongo/util/scopeguard.h"
+#include "mongo/util/stacktrace.h"
+
+#if defined(__linux__) && \
+    (defined(MONGO_CONFIG_HAVE_EXECINFO_BACKTRACE) || defined(MONGO_CONFIG_USE_LIBUNWIND))
+
+//
+// Sampling CPU profiler
+//
+// An interval timer (ITIMER_PROF) delivers SIGPROF to the process every
+// cpuProfilingSampleIntervalMicros of CPU time consumed by the process as a whole. The kernel
+// delivers the signal to a thread that is running at that moment, so each signal samples what
+// some thread is spending CPU on.
+//
+// The signal handler only records the raw backtrace and the name of the interrupted thread into
+// a free slot of a fixed, pre-allocated buffer. It takes no locks and does not allocate. If no
+// free slot is found the sample is counted as dropped.
+//
+// Generating the serverStatus section drains the buffer, charging each sample to its call stack
+// and to its thread role. The role is the thread name with any trailing connection or worker
+// number removed, e.g. "conn" or "ReplWriterWorker".
+//
+// Enable at startup time (only) with
+//     mongod --setParameter cpuProfilingEnabled=true
+//
+// If enabled, adds a cpuProfile section to serverStatus as follows:
+//
+// cpuProfile: {
+//     stats: {
+//         // internal stats related to the profiler (samples taken, samples dropped, etc.)
+//     }
+//     roles: {
+//         conn: ...,              // number of samples taken in threads of each role
+//         ...
+//     }
+//     stacks: {
+//         stack_n_: {             // one for each stack _n_
+//             samples: ...,       // number of samples taken in this stack
+//         }
+//     }
+// }
+//
+// All counts are cumulative since startup, so the profile for any window of time is the
+// difference between two FTDC samples. As with the heap profiler, FTDC does not capture strings:
+// each new stack is logged once, with its role and symbolized frames, so that stack_n_ can be
+// mapped back to the actual stack. The set of emitted stacks is sticky and emitted in stack
+// number order to keep the FTDC schema stable.
+//
+
+namespace mongo {
+namespace {
+
+// Simple wrapper for the demangler, particularly its buffer space.
+class Demangler {
+public:
+    Demangler() = default;
+
+    Demangler(const Demangler&) = delete;
+
+    ~Demangler() {
+        free(_buf);
+    }
+
+    char* operator()(const char* sym) {
+        char* dm = abi::__cxa_demangle(sym, _buf, &_bufSize, &_status);
+        if (dm)
+            _buf = dm;
+        return dm;
+    }
+
+private:
+    size_t _bufSize = 0;
+    char* _buf = nullptr;
+    int _status = 0;
+};
+
+class CpuProfiler {
+private:
+    static constexpr size_t kMaxFramesPerSample = 64;
+    static constexpr size_t kThreadNameSize = 16;  // including the null terminator
+    static constexpr size_t kSampleSlots = 8192;   // samples buffered between two drains
+    static constexpr size_t kMaxSlotProbes = 16;   // slots tried before dropping a sample
+
+    // Frames at the top of each backtrace that belong to the profiler: rawBacktrace, the signal
+    // handler, and the kernel's signal trampoline.
+    static constexpr size_t kSkipStartFrames = 3;
+
+    //
+    // Sample buffer, written by the signal handler.
+    //
+
+    enum SlotState : int { kEmpty, kWriting, kFull };
+
+    struct SampleSlot {
+        std::atomic<int> state{kEmpty};  // NOLINT
+        size_t numFrames = 0;
+        std::array<void*, kMaxFramesPerSample> frames;
+        std::array<char, kThreadNameSize> threadName;
+    };
+
+    std::unique_ptr<SampleSlot[]> _slots{new SampleSlot[kSampleSlots]};
+    std::atomic_size_t _nextSlot{0};         // NOLINT
+    std::atomic_size_t _droppedSamples{0};  // NOLINT
+
+    //
+    // Aggregated samples, guarded by _mutex.
+    //
+
+    struct StackInfo {
+        int stackNum = 0;
+        size_t samples = 0;
+    };
+
+    Mutex _mutex = MONGO_MAKE_LATCH("CpuProfiler::_mutex");
+
+    // Keyed by the thread role followed by the raw frame addresses, so the same code running in
+    // threads of different roles is reported as different stacks.
+    stdx::unordered_map<std::string, StackInfo> _stacks;
+    std::map<std::string, size_t> _roleSamples;
+    size_t _totalSamples = 0;
+
+    // As in the heap profiler, the stacks we emit are those that have ever been needed to
+    // account for most of the samples. They are emitted in stackNum order.
+    std::set<StackInfo*, bool (*)(StackInfo*, StackInfo*)> _importantStacks{
+        [](StackInfo* a, StackInfo* b) -> bool { return a->stackNum < b->stackNum; }};
+
+    int _numImportantSamples = 0;                // sections generated since the last reset
+    const int kMaxImportantSamples = 4 * 3600;  // reset every 4 hours at default 1 sample / sec
+
+    static StringData threadRole(StringData threadName) {
+        size_t end = threadName.size();
+        while (end > 0 &&
+               (isdigit(static_cast<unsigned char>(threadName[end - 1])) ||
+                threadName[end - 1] == '-'))
+            --end;
+        return end ? threadName.substr(0, end) : "unknown"_sd;
+    }
+
+    //
+    // Log the symbolized representation of a new stack.
+    //
+    void logStack(StackTraceAddressMetadataGenerator& metaGen,
+                  Demangler& demangler,
+                  StringData role,
+                  void* const* frames,
+                  size_t numFrames,
+                  const StackInfo& stackInfo) {
+        BSONArrayBuilder builder;
+        std::string frameString;
+        for (size_t j = std::min(numFrames, kSkipStartFrames); j != numFrames; ++j) {
+            frameString.clear();
+            void* addr = frames[j];
+            const auto& meta = metaGen.load(addr);
+            if (meta.symbol()) {
+                if (StringData name = meta.symbol().name(); !name.empty()) {
+                    frameString.assign(name.begin(), name.end());
+                    if (char* dm = demangler(frameString.c_str())) {
+                        frameString = dm;
+                        if (auto paren = frameString.find('('); paren != std::string::npos)
+                            frameString.erase(paren);
+                    }
+                }
+            }
+            if (frameString.empty()) {
+                std::ostringstream s;
+                s << addr;
+                frameString = s.str();
+            }
+            builder.append(frameString);
+        }
+        LOGV2(5591400,
+              "cpuProfile stack {stackNum} in {role}: {stackObj}",
+              "cpuProfile stack",
+              "stackNum"_attr = stackInfo.stackNum,
+              "role"_attr = role,
+              "stackObj"_attr = builder.arr());
+    }
+
+    //
+    // Move the buffered samples into the aggregated counts.
+    //
+    void drain(WithLock) {
+        StackTraceAddressMetadataGenerator metaGen;
+        Demangler demangler;
+        std::string key;
+        for (size_t i = 0; i != kSampleSlots; ++i) {
+            SampleSlot& slot = _slots[i];
+            if (slot.state.load(std::memory_order_acquire) != kFull)
+                continue;
+
+            StringData role = threadRole(StringData(slot.threadName.data()));
+            key.assign(role.rawData(), role.size());
+            key.push_back('\0');
+            key.append(reinterpret_cast<const char*>(slot.frames.data()),
+                       slot.numFrames * sizeof(void*));
+
+            auto [it, inserted] = _stacks.try_emplace(key);
+            if (inserted) {
+                it->second.stackNum = _stacks.size() - 1;
+                logStack(metaGen, demangler, role, slot.frames.data(), slot.numFrames, it->second);
+            }
+            ++it->second.samples;
+            ++_roleSamples[role.toString()];
+            ++_totalSamples;
+
+            slot.state.store(kEmpty, std::memory_order_release);
+        }
+    }
+
+    void _generateServerStatusSection(BSONObjBuilder& builder) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        drain(lk);
+
+        BSONObjBuilder statsBuilder(builder.subobjStart("stats"));
+        statsBuilder.appendNumber("samples", static_cast<long long>(_totalSamples));
+        statsBuilder.appendNumber("droppedSamples", static_cast<long long>(_droppedSamples.load()));
+        statsBuilder.appendNumber("numStacks", static_cast<long long>(_stacks.size()));
+        statsBuilder.doneFast();
+
+        BSONObjBuilder rolesBuilder(builder.subobjStart("roles"));
+        for (const auto& [role, samples] : _roleSamples)
+            rolesBuilder.appendNumber(role, static_cast<long long>(samples));
+        rolesBuilder.doneFast();
+
+        // Find enough stacks to account for at least 95% of the samples and deem any stack that
+        // has ever met this criterion "important".
+        std::vector<StackInfo*> stackInfos;
+        stackInfos.reserve(_stacks.size());
+        for (auto& [key, stackInfo] : _stacks)
+            stackInfos.push_back(&stackInfo);
+        std::sort(stackInfos.begin(), stackInfos.end(), [](StackInfo* a, StackInfo* b) {
+            return a->samples > b->samples ||
+                (a->samples == b->samples && a->stackNum < b->stackNum);
+        });
+        size_t threshold = _totalSamples * 0.95;
+        size_t cumulative = 0;
+        for (StackInfo* stackInfo : stackInfos) {
+            _importantStacks.insert(stackInfo);
+            cumulative += stackInfo->samples;
+            if (cumulative > threshold)
+                break;
+        }
+
+        BSONObjBuilder stacksBuilder(builder.subobjStart("stacks"));
+        for (StackInfo* stackInfo : _importantStacks) {
+            BSONObjBuilder stackBuilder(
+                stacksBuilder.subobjStart("stack" + std::to_string(stackInfo->stackNum)));
+            stackBuilder.appendNumber("samples", static_cast<long long>(stackInfo->samples));
+        }
+        stacksBuilder.doneFast();
+
+        // _importantStacks grows monotonically, so it can accumulate unneeded stacks,
+        // so we clear it periodically.
+        if (++_numImportantSamples >= kMaxImportantSamples) {
+            LOGV2(5591401, "Clearing important CPU profiler stacks");
+            _importantStacks.clear();
+            _numImportantSamples = 0;
+        }
+    }
+
+public:
+    static CpuProfiler* cpuProfiler;
+
+    //
+    // Record a sample of the current thread. Called from the SIGPROF handler, so this must
+    // remain async-signal-safe.
+    //
+    MONGO_COMPILER_ALWAYS_INLINE void recordSample() {
+        const size_t start = _nextSlot.fetch_add(1, std::memory_order_relaxed);
+        for (size_t probe = 0; probe != kMaxSlotProbes; ++probe) {
+            SampleSlot& slot = _slots[(start + probe) % kSampleSlots];
+            int expected = kEmpty;
+            if (!slot.state.compare_exchange_strong(expected, kWriting, std::memory_order_acquire))
+                continue;
+            slot.numFrames = rawBacktrace(slot.frames.data(), slot.frames.size());
+            // PR_GET_NAME is a plain system call for the calling thread, unlike
+            // pthread_getname_np, so it is safe to use here.
+            if (prctl(PR_GET_NAME, slot.threadName.data()) != 0)
+                slot.threadName[0] = '\0';
+            slot.threadName.back() = '\0';
+            slot.state.store(kFull, std::memory_order_release);
+            return;
+        }
+        _droppedSamples.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static void generateServerStatusSection(BSONObjBuilder& builder) {
+        if (cpuProfiler)
+            cpuProfiler->_generateServerStatusSection(builder);
+    }
+};
+
+CpuProfiler* CpuProfiler::cpuProfiler;
+
+extern "C" void cpuProfilerSignalAction(int, siginfo_t*, void*) {
+    const auto errnoGuard = makeGuard([e = errno] { errno = e; });
+    CpuProfiler::cpuProfiler->recordSample();
+}
+
+//
+// serverStatus section
+//
+
+class CpuProfilerServerStatusSection final : public ServerStatusSection {
+public:
+    CpuProfilerServerStatusSection() : ServerStatusSection("cpuProfile") {}
+
+    bool includeByDefault() const override {
+        return CpuProfilingEnabled;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        BSONObjBuilder builder;
+        CpuProfiler::generateServerStatusSection(builder);
+        return builder.obj();
+    }
+} cpuProfilerServerStatusSection;
+
+//
+// startup
+//
+
+MONGO_INITIALIZER_GENERAL(StartCpuProfiling, ("EndStartupOptionHandling"), ("default"))
+(InitializerContext* context) {
+    if (!CpuProfilingEnabled)
+        return;
+
+    CpuProfiler::cpuProfiler = new CpuProfiler();
+
+    // The first backtrace may load the unwinder, which is not safe to do in a signal handler.
+    std::array<void*, 1> warmup;
+    rawBacktrace(warmup.data(), warmup.size());
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sigemptyset(&sa.sa_mask);
+    sa.sa_sigaction = cpuProfilerSignalAction;
+    sa.sa_flags = SA_SIGINFO | SA_RESTART;
+    if (sigaction(SIGPROF, &sa, nullptr) != 0) {
+        int savedErr = errno;
+        LOGV2_FATAL(5591402,
+                    "Failed to install sigaction for SIGPROF: {error}",
+                    "Failed to install sigaction for SIGPROF",
+                    "error"_attr = strerror(savedErr));
+    }
+
+    struct itimerval timer;
+    timer.it_interval.tv_sec = CpuProfilingSampleIntervalMicros / 1000000;
+    timer.it_interval.tv_usec = CpuProfilingSampleIntervalMicros % 1000000;
+    timer.it_value = timer.it_interval;
+    if (setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+        int savedErr = errno;
+        LOGV2_FATAL(5591403,
+                    "Failed to start the CPU profiling timer: {error}",
+                    "Failed to start the CPU profiling timer",
+                    "error"_attr = strerror(savedErr));
+    }
+}
+
+}  // namespace
+}  // namespace mongo
+
+#endif
@@ -33,6 +33,7 @@
 
 #include "mongo/util/exit.h"
 
+#include <boost/log/core/core.hpp>
 #include <boost/optional.hpp>
 #include <functional>
 #include <stack>
@@ -69,6 +70,8 @@ void runTasks(decltype(shutdownTasks) tasks, const ShutdownTaskArgs& shutdownArg
 MONGO_COMPILER_NORETURN void logAndQuickExit_inlock() {
     ExitCode code = shutdownExitCode.get();
     LOGV2(23138, "Shutting down with code: {exitCode}", "Shutting down", "exitCode"_attr = code);
+    // Write out records still queued for an asynchronous log sink, quickExit skips destructors.
+    boost::log::core::get()->flush();
     quickExit(code);
 }
 
@@ -29,7 +29,9 @@
 
 #pragma once
 
+#include <cstddef>
 #include <functional>
+#include <new>
 #include <type_traits>
 
 #include "mongo/stdx/type_traits.h"
@@ -45,6 +47,9 @@ class unique_function;
  * it is incapable of being copied.  Often this happens with C++14 or later lambdas which capture a
  * `std::unique_ptr` by move.  The interface of `unique_function` is nearly identical to
  * `std::function`, except that it is not copyable.
+ *
+ * Small functors whose move constructor cannot throw are stored inline rather than on the heap, so
+ * that wrapping something like a lambda capturing a couple of pointers does not allocate.
  */
 template <typename RetType, typename... Args>
 class unique_function<RetType(Args...)> {
@@ -65,18 +70,29 @@ private:
 public:
     using result_type = RetType;
 
-    ~unique_function() noexcept = default;
+    ~unique_function() noexcept {
+        reset();
+    }
     unique_function() = default;
 
     unique_function(const unique_function&) = delete;
     unique_function& operator=(const unique_function&) = delete;
 
-    unique_function(unique_function&&) noexcept = default;
-    unique_function& operator=(unique_function&&) noexcept = default;
+    unique_function(unique_function&& that) noexcept {
+        takeFrom(that);
+    }
+    unique_function& operator=(unique_function&& that) noexcept {
+        if (this != &that) {
+            reset();
+            takeFrom(that);
+        }
+        return *this;
+    }
 
     void swap(unique_function& that) noexcept {
-        using std::swap;
-        swap(this->impl, that.impl);
+        unique_function tmp(std::move(that));
+        that = std::move(*this);
+        *this = std::move(tmp);
     }
 
     friend void swap(unique_function& a, unique_function& b) noexcept {
@@ -99,8 +115,9 @@ public:
             makeTag(),
         std::enable_if_t<std::is_move_constructible<Functor>::value, TagType> = makeTag(),
         std::enable_if_t<!std::is_same<std::decay_t<Functor>, unique_function>::value, TagType> =
-            makeTag())
-        : impl(makeImpl(std::forward<Functor>(functor))) {}
+            makeTag()) {
+        emplace(std::forward<Functor>(functor));
+    }
 
     unique_function(std::nullptr_t) noexcept {}
 
@@ -135,8 +152,19 @@ private:
     struct Impl {
         virtual ~Impl() noexcept = default;
         virtual RetType call(Args&&... args) = 0;
+
+        /**
+         * Moves this into the inline storage at 'buffer' and destroys this. Only called on an Impl
+         * that is itself stored inline.
+         */
+        virtual Impl* relocateTo(void* buffer) noexcept = 0;
     };
 
+    struct RelocateTag {};
+
+    // Room for the vtable pointer of an Impl and a functor the size of two pointers.
+    using InlineStorage = std::aligned_storage_t<3 * sizeof(void*), alignof(void*)>;
+
     // These overload helpers are needed to squelch problems in the `T ()` -> `void ()` case.
     template <typename Functor>
     static void callRegularVoid(const std::true_type isVoid, Functor& f, Args&&... args) {
@@ -151,21 +179,64 @@ private:
     }
 
     template <typename Functor>
-    static auto makeImpl(Functor&& functor) {
+    void emplace(Functor&& functor) {
+        using Decayed = std::decay_t<Functor>;
         struct SpecificImpl : Impl {
             explicit SpecificImpl(Functor&& func) : f(std::forward<Functor>(func)) {}
+            SpecificImpl(Decayed&& func, RelocateTag) : f(std::move(func)) {}
 
             RetType call(Args&&... args) override {
                 return callRegularVoid(std::is_void<RetType>(), f, std::forward<Args>(args)...);
             }
 
-            std::decay_t<Functor> f;
+            Impl* relocateTo(void* buffer) noexcept override {
+                auto relocated = new (buffer) SpecificImpl(std::move(f), RelocateTag{});
+                this->~SpecificImpl();
+                return relocated;
+            }
+
+            Decayed f;
         };
 
-        return std::make_unique<SpecificImpl>(std::forward<Functor>(functor));
+        if constexpr (sizeof(SpecificImpl) <= sizeof(InlineStorage) &&
+                      alignof(SpecificImpl) <= alignof(InlineStorage) &&
+                      std::is_nothrow_move_constructible_v<Decayed>) {
+            impl = new (&storage) SpecificImpl(std::forward<Functor>(functor));
+        } else {
+            impl = new SpecificImpl(std::forward<Functor>(functor));
+        }
+    }
+
+    bool isInline() const noexcept {
+        auto implStart = reinterpret_cast<const char*>(impl);
+        auto storageStart = reinterpret_cast<const char*>(&storage);
+        return implStart >= storageStart && implStart < storageStart + sizeof(storage);
+    }
+
+    void reset() noexcept {
+        if (!impl) {
+            return;
+        }
+
+        if (isInline()) {
+            impl->~Impl();
+        } else {
+            delete impl;
+        }
+        impl = nullptr;
+    }
+
+    void takeFrom(unique_function& that) noexcept {
+        if (!that.impl) {
+            return;
+        }
+
+        impl = that.isInline() ? that.impl->relocateTo(&storage) : that.impl;
+        that.impl = nullptr;
     }
 
-    std::unique_ptr<Impl> impl;
+    Impl* impl = nullptr;
+    InlineStorage storage;
 };
 
 /**
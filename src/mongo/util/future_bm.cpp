@@ -29,6 +29,7 @@
 
 #include "mongo/platform/basic.h"
 
+#include <array>
 #include <benchmark/benchmark.h>
 
 #include "mongo/util/future.h"
@@ -198,6 +199,18 @@ void BM_futureInt4xDeferredThenChained(benchmark::State& state) {
     }
 }
 
+// Constructing and moving a unique_function, as a continuation does when it is attached to a
+// future, for a functor that is stored inline and for one that must be allocated.
+template <size_t bytesCaptured>
+void BM_uniqueFunctionMoveAndCall(benchmark::State& state) {
+    std::array<char, bytesCaptured> captured{};
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        unique_function<int()> func = [captured] { return captured[0] + 1; };
+        auto moved = std::move(func);
+        benchmark::DoNotOptimize(moved());
+    }
+}
 
 BENCHMARK(BM_plainIntReady);
 BENCHMARK(BM_futureIntReady);
@@ -212,5 +225,7 @@ BENCHMARK(BM_futureInt3xDeferredThenNested);
 BENCHMARK(BM_futureInt3xDeferredThenChained);
 BENCHMARK(BM_futureInt4xDeferredThenNested);
 BENCHMARK(BM_futureInt4xDeferredThenChained);
+BENCHMARK_TEMPLATE(BM_uniqueFunctionMoveAndCall, 8);
+BENCHMARK_TEMPLATE(BM_uniqueFunctionMoveAndCall, 64);
 
 }  // namespace mongo
@@ -57,6 +57,7 @@ namespace {
 
 auto kLatchAnalysisName = "latchAnalysis"_sd;
 auto kLatchViolationKey = "hierarchicalAcquisitionLevelViolations"_sd;
+auto kLatchSampledKey = "sampled"_sd;
 
 // LatchAnalyzer Decoration getter
 const auto getLatchAnalyzer = ServiceContext::declareDecoration<LatchAnalyzer>();
@@ -144,6 +145,27 @@ struct LatchSetState {
 };
 
 const auto getLatchSetState = Client::declareDecoration<LatchSetState>();
+
+// Append the timings of the acquisitions sampled by latchAnalysisSampleInterval, along with where
+// the latch was defined so that latches sharing a name can be told apart.
+void appendSampledTimings(const latch_detail::Data& data, BSONObjBuilder& latchObj) {
+    auto& counts = data.counts();
+    auto sampled = counts.sampled.loadRelaxed();
+    if (sampled == 0) {
+        return;
+    }
+
+    BSONObjBuilder sampledObj = latchObj.subobjStart(kLatchSampledKey);
+    sampledObj.append("acquired", sampled);
+    sampledObj.append("contended", counts.sampledContended.loadRelaxed());
+    sampledObj.append("totalWaitMicros", counts.sampledWaitNanos.loadRelaxed() / 1000);
+    sampledObj.append("totalHoldMicros", counts.sampledHoldNanos.loadRelaxed() / 1000);
+
+    if (auto& loc = data.identity().sourceLocation()) {
+        sampledObj.append("file", loc->file_name());
+        sampledObj.append("line", static_cast<long long>(loc->line()));
+    }
+}
 }  // namespace
 
 void LatchAnalyzer::setAllowExitOnViolation(bool allowExitOnViolation) {
@@ -355,6 +377,8 @@ void LatchAnalyzer::appendToBSON(mongo::BSONObjBuilder& result) const {
         latchObj.append("released", data->counts().released.loadRelaxed());
         latchObj.append("contended", data->counts().contended.loadRelaxed());
 
+        appendSampledTimings(*data, latchObj);
+
         auto appendViolations = [&] {
             stdx::lock_guard lk(_mutex);
             auto it = _violations.find(identity.index());
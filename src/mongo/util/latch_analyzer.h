@@ -49,6 +49,9 @@ namespace mongo {
  * each event when the enableLatchAnalysis failpoint is set to "alwaysOn". This failpoint provides a
  * wealth of data for future analysis, but involves additional mutexes and mapping structures that
  * may prove too costly for production usage at the least.
+ *
+ * For production use, the latchAnalysisSampleInterval server parameter has each Mutex time a
+ * sample of its acquisitions instead. appendToBSON() reports those wait and hold times per latch.
  */
 class LatchAnalyzer {
 public:
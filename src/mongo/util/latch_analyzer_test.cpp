@@ -34,6 +34,8 @@
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/hierarchical_acquisition.h"
 #include "mongo/util/latch_analyzer.h"
+#include "mongo/util/scopeguard.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 namespace {
@@ -103,5 +105,32 @@ TEST_F(LatchAnalyzerTest, RemoveValidWasPresent) {
     higherLevel.unlock();
 }
 
+TEST_F(LatchAnalyzerTest, SampledAcquisitionsAreTimed) {
+    Mutex m = MONGO_MAKE_LATCH("SampledAcquisitionsAreTimed::m");
+
+    auto sampledSection = [&] {
+        BSONObjBuilder bob;
+        LatchAnalyzer::get().appendToBSON(bob);
+        return bob.obj()["SampledAcquisitionsAreTimed::m"]["sampled"];
+    };
+
+    m.lock();
+    m.unlock();
+    ASSERT_TRUE(sampledSection().eoo());
+
+    latch_detail::gLatchAnalysisSampleInterval.store(2);
+    ON_BLOCK_EXIT([] { latch_detail::gLatchAnalysisSampleInterval.store(0); });
+    for (int i = 0; i < 10; ++i) {
+        stdx::lock_guard lk(m);
+        sleepmillis(1);
+    }
+
+    auto sampled = sampledSection();
+    ASSERT_EQ(sampled["acquired"].numberLong(), 5);
+    ASSERT_EQ(sampled["contended"].numberLong(), 0);
+    ASSERT_GTE(sampled["totalHoldMicros"].numberLong(), 5 * 1000);
+    ASSERT_EQ(sampled["file"].str(), __FILE__);
+}
+
 }  // namespace
 }  // namespace mongo
@@ -30,11 +30,126 @@
 
 #include "mongo/util/regex_util.h"
 
+#include <iterator>
+#include <limits>
+
 #include "mongo/base/error_codes.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/with_lock.h"
+#include "mongo/util/lru_cache.h"
+#include "mongo/util/regex_util_gen.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
 namespace regex_util {
+namespace {
+/**
+ * A least recently used cache of compiled regular expressions, keyed by the pattern and the PCRE
+ * options. Its size is bounded by 'internalQueryRegexCacheSize', which may change at runtime, so
+ * the cache itself is created unbounded and trimmed on every insertion.
+ */
+class CompiledRegexCache {
+public:
+    std::shared_ptr<const CompiledRegex> find(const std::string& key) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        auto it = _cache.find(key);
+        if (it == _cache.end()) {
+            return nullptr;
+        }
+        return it->second;
+    }
+
+    void add(std::string key, std::shared_ptr<const CompiledRegex> regex, size_t maxEntries) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _cache.add(std::move(key), std::move(regex));
+        _trim(lk, maxEntries);
+    }
+
+    void trim(size_t maxEntries) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _trim(lk, maxEntries);
+    }
+
+private:
+    void _trim(WithLock, size_t maxEntries) {
+        while (_cache.size() > maxEntries) {
+            _cache.erase(std::prev(_cache.end()));
+        }
+    }
+
+    Mutex _mutex = MONGO_MAKE_LATCH("CompiledRegexCache::_mutex");
+    LRUCache<std::string, std::shared_ptr<const CompiledRegex>> _cache{
+        std::numeric_limits<size_t>::max()};
+};
+
+CompiledRegexCache compiledRegexCache;
+}  // namespace
+
+CompiledRegex::CompiledRegex(const std::string& pattern, int pcreOptions) {
+    const char* compileError;
+    int errorOffset;
+    _re = pcre_compile(pattern.c_str(), pcreOptions, &compileError, &errorOffset, nullptr);
+    if (!_re) {
+        _error = compileError;
+        return;
+    }
+
+    // Studying is only an optimization, so the pattern is still usable if it fails.
+    const char* studyError;
+    _extra = pcre_study(_re, PCRE_STUDY_JIT_COMPILE, &studyError);
+}
+
+CompiledRegex::~CompiledRegex() {
+    if (_extra) {
+        pcre_free_study(_extra);
+    }
+    if (_re) {
+        (*pcre_free)(_re);
+    }
+}
+
+int CompiledRegex::numCaptures() const {
+    int numCaptures;
+    invariant(pcre_fullinfo(_re, _extra, PCRE_INFO_CAPTURECOUNT, &numCaptures) == 0);
+    return numCaptures;
+}
+
+int CompiledRegex::exec(StringData input, int startPos, int* ovector, int ovecSize) const {
+    invariant(_re);
+    int result =
+        pcre_exec(_re, _extra, input.rawData(), input.size(), startPos, 0, ovector, ovecSize);
+    if (result == PCRE_ERROR_JIT_STACKLIMIT) {
+        // The match needs a larger stack than the JIT compiled code has, so run it again with the
+        // interpreter, which is not limited that way.
+        pcre_extra interpretedExtra = *_extra;
+        interpretedExtra.flags &= ~PCRE_EXTRA_EXECUTABLE_JIT;
+        result = pcre_exec(
+            _re, &interpretedExtra, input.rawData(), input.size(), startPos, 0, ovector, ovecSize);
+    }
+    return result;
+}
+
+std::shared_ptr<const CompiledRegex> getCompiledRegex(const std::string& pattern, int pcreOptions) {
+    const auto maxEntries = gInternalQueryRegexCacheSize.load();
+    if (maxEntries <= 0) {
+        // Drop whatever was cached before the cache was disabled.
+        compiledRegexCache.trim(0);
+        return std::make_shared<CompiledRegex>(pattern, pcreOptions);
+    }
+
+    std::string key = std::to_string(pcreOptions) + '/' + pattern;
+    if (auto cached = compiledRegexCache.find(key)) {
+        return cached;
+    }
+
+    auto regex = std::make_shared<CompiledRegex>(pattern, pcreOptions);
+    if (regex->error().empty()) {
+        compiledRegexCache.add(std::move(key), regex, static_cast<size_t>(maxEntries));
+    }
+    return regex;
+}
+
 pcrecpp::RE_Options flagsToPcreOptions(StringData optionFlags,
                                        bool ignoreInvalidFlags,
                                        StringData opName) {
@@ -29,12 +29,68 @@
 
 #pragma once
 
+#include <memory>
+#include <pcre.h>
 #include <pcrecpp.h>
+#include <string>
 
 #include "mongo/base/string_data.h"
 
 namespace mongo {
 namespace regex_util {
+/**
+ * A regular expression compiled and studied by PCRE. The study uses the PCRE JIT compiler when the
+ * PCRE library supports it. Instances are immutable and may be shared between threads.
+ */
+class CompiledRegex {
+    CompiledRegex(const CompiledRegex&) = delete;
+    CompiledRegex& operator=(const CompiledRegex&) = delete;
+
+public:
+    CompiledRegex(const std::string& pattern, int pcreOptions);
+
+    ~CompiledRegex();
+
+    /**
+     * Returns the error reported by PCRE when compiling the pattern, or an empty string if the
+     * pattern compiled.
+     */
+    const std::string& error() const {
+        return _error;
+    }
+
+    /**
+     * Returns the number of capture groups in the pattern.
+     */
+    int numCaptures() const;
+
+    /**
+     * Wrapper for pcre_exec(). Matches 'input' from byte 'startPos' on, and fills 'ovector' with up
+     * to 'ovecSize' / 3 pairs of match and capture group offsets. Returns the number of pairs
+     * filled, 0 if 'ovector' is too small, -1 if there is no match, or another PCRE error code.
+     */
+    int exec(StringData input, int startPos, int* ovector, int ovecSize) const;
+
+    /**
+     * Returns whether the pattern matches any part of 'input'.
+     */
+    bool partialMatch(StringData input) const {
+        return exec(input, 0, nullptr, 0) >= 0;
+    }
+
+private:
+    pcre* _re = nullptr;
+    pcre_extra* _extra = nullptr;
+    std::string _error;
+};
+
+/**
+ * Returns 'pattern' compiled with 'pcreOptions'. Compiled patterns are shared through a
+ * process-wide cache, whose size is bounded by 'internalQueryRegexCacheSize'. A pattern which
+ * fails to compile is returned with its error, but is not cached.
+ */
+std::shared_ptr<const CompiledRegex> getCompiledRegex(const std::string& pattern, int pcreOptions);
+
 /**
  * Builds PCRE regex options from the input options string. If 'ignoreInvalidOptions' is disabled,
  * throws uassert on invalid flags.
@@ -31,12 +31,30 @@
 
 #include <algorithm>
 #include <array>
+#include <cstdint>
+#include <cstring>
 #include <iterator>
 
 namespace mongo::str {
 namespace {
 constexpr char kHexChar[] = "0123456789abcdef";
 
+constexpr uint64_t kEveryByte = 0x0101010101010101ULL;
+constexpr uint64_t kEveryHighBit = 0x8080808080808080ULL;
+
+// Returns true if any of the 8 bytes at 'pos' might have to be escaped: control characters, any
+// byte that is not printable ASCII, a backslash or a double quote. This is a superset of what
+// every escaper below handles, so blocks for which this returns false can be copied unmodified.
+bool mayNeedEscaping(const char* pos) {
+    uint64_t word;
+    std::memcpy(&word, pos, sizeof(word));
+    auto hasZeroByte = [](uint64_t v) { return (v - kEveryByte) & ~v & kEveryHighBit; };
+    uint64_t lessThanSpace = (word - kEveryByte * 0x20) & ~word & kEveryHighBit;
+    uint64_t atLeastDel = ((word + kEveryByte) | word) & kEveryHighBit;
+    return lessThanSpace | atLeastDel | hasZeroByte(word ^ (kEveryByte * '\\')) |
+        hasZeroByte(word ^ (kEveryByte * '"'));
+}
+
 // 'singleHandler' Function to write a valid single byte UTF-8 sequence with desired escaping.
 // 'invalidByteHandler' Function to write a byte of invalid UTF-8 encoding
 // 'twoEscaper' Function to write a valid two byte UTF-8 sequence with desired escaping, for C1
@@ -99,6 +117,12 @@ void escape(fmt::memory_buffer& buffer,
 
 
     while (it != end) {
+        // Most strings are mostly printable ASCII, so skip over blocks of those 8 at a time.
+        if (std::distance(it, end) >= 8 && !mayNeedEscaping(it)) {
+            it += 8;
+            continue;
+        }
+
         uint8_t c = *it;
         bool bit7 = (c >> 7) & 1;
         if (MONGO_likely(!bit7)) {
@@ -29,6 +29,9 @@
 
 #include "mongo/util/functional.h"
 
+#include <array>
+#include <vector>
+
 #include "mongo/unittest/unittest.h"
 
 /**
@@ -171,6 +174,78 @@ TEST(UniqueFunctionTest, dtor_releases_functor_object_and_does_not_call_function
     ASSERT_FALSE(runDetection1.itRan);
 }
 
+// Counts the live instances of a functor with 'padding' bytes of state, so that both inline and
+// heap allocated functors can be checked for leaks and double destruction.
+template <size_t padding>
+struct CountedFunctor {
+    CountedFunctor(int* live, int value) : live(live), value(value) {
+        ++*live;
+    }
+    CountedFunctor(CountedFunctor&& other) noexcept : live(other.live), value(other.value) {
+        ++*live;
+    }
+    ~CountedFunctor() {
+        --*live;
+    }
+
+    int operator()() const {
+        return value;
+    }
+
+    int* live;
+    int value;
+    std::array<char, padding> pad = {};
+};
+
+template <size_t padding>
+void checkMovesAndSwaps() {
+    int live = 0;
+    {
+        mongo::unique_function<int()> a = CountedFunctor<padding>(&live, 1);
+        mongo::unique_function<int()> b = CountedFunctor<padding>(&live, 2);
+        mongo::unique_function<int()> small = [] { return 3; };
+        ASSERT_EQ(live, 2);
+
+        mongo::unique_function<int()> c = std::move(a);
+        ASSERT_FALSE(a);
+        ASSERT_EQ(c(), 1);
+        ASSERT_EQ(live, 2);
+
+        c.swap(b);
+        ASSERT_EQ(c(), 2);
+        ASSERT_EQ(b(), 1);
+
+        small.swap(b);
+        ASSERT_EQ(small(), 1);
+        ASSERT_EQ(b(), 3);
+
+        c = std::move(small);
+        ASSERT_EQ(c(), 1);
+        ASSERT_EQ(live, 1);
+
+        c = nullptr;
+        ASSERT_EQ(live, 0);
+
+        std::vector<mongo::unique_function<int()>> functions;
+        for (int i = 0; i < 100; ++i) {
+            functions.push_back(CountedFunctor<padding>(&live, i));
+        }
+        for (int i = 0; i < 100; ++i) {
+            ASSERT_EQ(functions[i](), i);
+        }
+        ASSERT_EQ(live, 100);
+    }
+    ASSERT_EQ(live, 0);
+}
+
+TEST(UniqueFunctionTest, inline_functor_moves_and_swaps) {
+    checkMovesAndSwaps<0>();
+}
+
+TEST(UniqueFunctionTest, heap_functor_moves_and_swaps) {
+    checkMovesAndSwaps<64>();
+}
+
 TEST(UniqueFunctionTest, comparison_checks) {
     mongo::unique_function<void()> uf;
 